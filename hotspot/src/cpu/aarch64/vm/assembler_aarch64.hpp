@@ -1981,7 +1981,7 @@ public:
  public:
 
   enum SIMD_Arrangement {
-       T8B, T16B, T4H, T8H, T2S, T4S, T1D, T2D
+       T8B, T16B, T4H, T8H, T2S, T4S, T1D, T2D, T1Q
   };
 
   enum SIMD_RegVariant {
@@ -2144,6 +2144,8 @@ public:
   INSN(negr,  1, 0b100000101110);
   INSN(notr,  1, 0b100000010110);
   INSN(addv,  0, 0b110001101110);
+  INSN(smaxv, 0, 0b110000101010);
+  INSN(sminv, 0, 0b110001101010);
   INSN(cls,   0, 0b100000010010);
   INSN(clz,   1, 0b100000010010);
   INSN(cnt,   0, 0b100000010110);
@@ -2222,6 +2224,25 @@ public:
 
 #undef INSN
 
+#define INSN(NAME, opc)                                                                 \
+  void NAME(FloatRegister Vd, SIMD_Arrangement T, FloatRegister Vn, FloatRegister Vm) { \
+    starti;                                                                             \
+    assert(T == T2D, "arrangement must be T2D");                                        \
+    f(0b11001110011, 31, 21), rf(Vm, 16), f(opc, 15, 10), rf(Vn, 5), rf(Vd, 0);         \
+  }
+
+  INSN(sha512h,   0b100000);
+  INSN(sha512h2,  0b100001);
+  INSN(sha512su1, 0b100010);
+
+#undef INSN
+
+  void sha512su0(FloatRegister Vd, SIMD_Arrangement T, FloatRegister Vn) {
+    starti;
+    assert(T == T2D, "arrangement must be T2D");
+    f(0b1100111011000000100000, 31, 10), rf(Vn, 5), rf(Vd, 0);
+  }
+
 #define INSN(NAME, opc)                           \
   void NAME(FloatRegister Vd, FloatRegister Vn) { \
     starti;                                       \
@@ -2312,14 +2333,17 @@ public:
     f(0b001111, 15, 10), rf(Vn, 5), rf(Xd, 0);
   }
 
-  // We do not handle the 1Q arrangement.
+  // The 1Q arrangement (64x64->128 bit) needs the PMULL crypto extension.
   void pmull(FloatRegister Vd, SIMD_Arrangement Ta, FloatRegister Vn, FloatRegister Vm, SIMD_Arrangement Tb) {
     starti;
-    assert(Ta == T8H && (Tb == T8B || Tb == T16B), "Invalid Size specifier");
-    f(0, 31), f(Tb & 1, 30), f(0b001110001, 29, 21), rf(Vm, 16), f(0b111000, 15, 10);
-    rf(Vn, 5), rf(Vd, 0);
+    assert((Ta == T8H && (Tb == T8B || Tb == T16B)) ||
+           (Ta == T1Q && (Tb == T1D || Tb == T2D)), "Invalid Size specifier");
+    int size = (Ta == T1Q) ? 0b11 : 0b00;
+    f(0, 31), f(Tb & 1, 30), f(0b001110, 29, 24), f(size, 23, 22);
+    f(1, 21), rf(Vm, 16), f(0b111000, 15, 10), rf(Vn, 5), rf(Vd, 0);
   }
   void pmull2(FloatRegister Vd, SIMD_Arrangement Ta, FloatRegister Vn, FloatRegister Vm, SIMD_Arrangement Tb) {
+    assert(Tb == T16B || Tb == T2D, "pmull2 uses the upper halves");
     pmull(Vd, Ta, Vn, Vm, Tb);
   }
 
@@ -2341,6 +2365,55 @@ public:
     rf(Vn, 5), rf(Vd, 0);
   }
 
+  void rev64(FloatRegister Vd, SIMD_Arrangement T, FloatRegister Vn)
+  {
+    starti;
+    assert(T <= T4S, "must be one of T8B, T16B, T4H, T8H, T2S, T4S");
+    f(0, 31), f((int)T & 1, 30), f(0b001110, 29, 24);
+    f((int)T >> 1, 23, 22), f(0b100000000010, 21, 10);
+    rf(Vn, 5), rf(Vd, 0);
+  }
+
+  void rbit(FloatRegister Vd, SIMD_Arrangement T, FloatRegister Vn)
+  {
+    starti;
+    assert(T == T8B || T == T16B, "must be T8B or T16B");
+    f(0, 31), f((int)T & 1, 30), f(0b101110, 29, 24);
+    f(0b01, 23, 22), f(0b100000010110, 21, 10);
+    rf(Vn, 5), rf(Vd, 0);
+  }
+
+  // Signed integer to floating-point, each lane
+  void scvtfv(FloatRegister Vd, SIMD_Arrangement T, FloatRegister Vn)
+  {
+    starti;
+    assert(T == T2S || T == T4S || T == T2D, "invalid arrangement");
+    f(0, 31), f((int)T & 1, 30), f(0b001110, 29, 24);
+    f(0, 23), f(T == T2D ? 1 : 0, 22), f(0b100001110110, 21, 10);
+    rf(Vn, 5), rf(Vd, 0);
+  }
+
+  // Floating-point to signed integer rounding toward zero, each lane
+  void fcvtzsv(FloatRegister Vd, SIMD_Arrangement T, FloatRegister Vn)
+  {
+    starti;
+    assert(T == T2S || T == T4S || T == T2D, "invalid arrangement");
+    f(0, 31), f((int)T & 1, 30), f(0b001110, 29, 24);
+    f(1, 23), f(T == T2D ? 1 : 0, 22), f(0b100001101110, 21, 10);
+    rf(Vn, 5), rf(Vd, 0);
+  }
+
+  // Extract a vector from the pair Vm:Vn starting at byte index
+  void ext(FloatRegister Vd, SIMD_Arrangement T, FloatRegister Vn, FloatRegister Vm, int index)
+  {
+    starti;
+    assert(T == T8B || T == T16B, "invalid arrangement");
+    assert((T == T8B && index <= 0b0111) || (T == T16B && index <= 0b1111), "Invalid index value");
+    f(0, 31), f((int)T & 1, 30), f(0b101110000, 29, 21);
+    rf(Vm, 16), f(0, 15), f(index, 14, 11);
+    f(0, 10), rf(Vn, 5), rf(Vd, 0);
+  }
+
   void dup(FloatRegister Vd, SIMD_Arrangement T, Register Xs)
   {
     starti;
@@ -1318,7 +1318,8 @@ void LIR_Assembler::emit_alloc_array(LIR_OpAllocArray* op) {
 
 void LIR_Assembler::type_profile_helper(Register mdo,
                                         ciMethodData *md, ciProfileData *data,
-                                        Register recv, Label* update_done) {
+                                        Register recv, Label* update_done,
+                                        int increment) {
   for (uint i = 0; i < ReceiverTypeData::row_limit(); i++) {
     Label next_test;
     // See if the receiver is receiver[n].
@@ -1327,7 +1328,7 @@ void LIR_Assembler::type_profile_helper(Register mdo,
     __ cmp(recv, rscratch1);
     __ br(Assembler::NE, next_test);
     Address data_addr(mdo, md->byte_offset_of_slot(data, ReceiverTypeData::receiver_count_offset(i)));
-    __ addptr(data_addr, DataLayout::counter_increment);
+    __ addptr(data_addr, increment);
     __ b(*update_done);
     __ bind(next_test);
   }
@@ -1341,7 +1342,7 @@ void LIR_Assembler::type_profile_helper(Register mdo,
     __ ldr(rscratch1, recv_addr);
     __ cbnz(rscratch1, next_test);
     __ str(recv, recv_addr);
-    __ mov(rscratch1, DataLayout::counter_increment);
+    __ mov(rscratch1, increment);
     __ lea(rscratch2, Address(mdo, md->byte_offset_of_slot(data, ReceiverTypeData::receiver_count_offset(i))));
     __ str(rscratch1, Address(rscratch2));
     __ b(*update_done);
@@ -1471,7 +1472,7 @@ void LIR_Assembler::emit_typecheck_helper(LIR_OpTypeCheck *op, Label* success, L
     __ mov_metadata(mdo, md->constant_encoding());
     __ load_klass(recv, obj);
     Label update_done;
-    type_profile_helper(mdo, md, data, recv, success);
+    type_profile_helper(mdo, md, data, recv, success, DataLayout::counter_increment);
     __ b(*success);
 
     __ bind(profile_cast_failure);
@@ -1560,7 +1561,7 @@ void LIR_Assembler::emit_opTypeCheck(LIR_OpTypeCheck* op) {
       __ mov_metadata(mdo, md->constant_encoding());
       __ load_klass(recv, value);
       Label update_done;
-      type_profile_helper(mdo, md, data, recv, &done);
+      type_profile_helper(mdo, md, data, recv, &done, DataLayout::counter_increment);
       __ b(done);
 
       __ bind(profile_cast_failure);
@@ -2603,6 +2604,23 @@ void LIR_Assembler::emit_profile_call(LIR_OpProfileCall* op) {
   assert(data->is_CounterData(), "need CounterData for calls");
   assert(op->mdo()->is_single_cpu(),  "mdo must be allocated");
   Register mdo  = op->mdo()->as_register();
+
+  // With C1ProfileCallSampleLog, advance the thread's xorshift state and
+  // record only one in 2^n calls, with the counts scaled to match.
+  int sample_log = profile_call_sample_log();
+  int increment = DataLayout::counter_increment << sample_log;
+  Label skip_profile;
+  if (sample_log > 0) {
+    Address seed_addr(rthread, Thread::profile_sample_seed_offset());
+    __ ldrw(rscratch1, seed_addr);
+    __ eorw(rscratch1, rscratch1, rscratch1, Assembler::LSL, 13);
+    __ eorw(rscratch1, rscratch1, rscratch1, Assembler::LSR, 17);
+    __ eorw(rscratch1, rscratch1, rscratch1, Assembler::LSL, 5);
+    __ strw(rscratch1, seed_addr);
+    __ tstw(rscratch1, (1 << sample_log) - 1);
+    __ br(Assembler::NE, skip_profile);
+  }
+
   __ mov_metadata(mdo, md->constant_encoding());
   Address counter_addr(mdo, md->byte_offset_of_slot(data, CounterData::count_offset()));
   Bytecodes::Code bc = method->java_code_at_bci(bci);
@@ -2630,7 +2648,8 @@ void LIR_Assembler::emit_profile_call(LIR_OpProfileCall* op) {
         ciKlass* receiver = vc_data->receiver(i);
         if (known_klass->equals(receiver)) {
           Address data_addr(mdo, md->byte_offset_of_slot(data, VirtualCallData::receiver_count_offset(i)));
-          __ addptr(data_addr, DataLayout::counter_increment);
+          __ addptr(data_addr, increment);
+          __ bind(skip_profile);
           return;
         }
       }
@@ -2648,24 +2667,26 @@ void LIR_Assembler::emit_profile_call(LIR_OpProfileCall* op) {
           __ lea(rscratch2, recv_addr);
           __ str(rscratch1, Address(rscratch2));
           Address data_addr(mdo, md->byte_offset_of_slot(data, VirtualCallData::receiver_count_offset(i)));
-          __ addptr(data_addr, DataLayout::counter_increment);
+          __ addptr(data_addr, increment);
+          __ bind(skip_profile);
           return;
         }
       }
     } else {
       __ load_klass(recv, recv);
       Label update_done;
-      type_profile_helper(mdo, md, data, recv, &update_done);
+      type_profile_helper(mdo, md, data, recv, &update_done, increment);
       // Receiver did not match any saved receiver and there is no empty row for it.
       // Increment total counter to indicate polymorphic case.
-      __ addptr(counter_addr, DataLayout::counter_increment);
+      __ addptr(counter_addr, increment);
 
       __ bind(update_done);
     }
   } else {
     // Static call
-    __ addptr(counter_addr, DataLayout::counter_increment);
+    __ addptr(counter_addr, increment);
   }
+  __ bind(skip_profile);
 }
 
 
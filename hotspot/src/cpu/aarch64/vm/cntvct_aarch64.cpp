@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "cntvct_aarch64.hpp"
+#include "runtime/globals.hpp"
+#include "runtime/orderAccess.inline.hpp"
+#include "runtime/os.hpp"
+#include "runtime/thread.inline.hpp"
+
+static jlong _epoch = 0;
+static bool cntvct_elapsed_counter_enabled = false;
+static jlong cntvct_frequency = 0;
+
+static inline jlong read_cntvct() {
+  jlong value;
+  __asm__ __volatile__ ("mrs %0, cntvct_el0" : "=r"(value));
+  return value;
+}
+
+static inline jlong read_cntfrq() {
+  jlong value;
+  __asm__ __volatile__ ("mrs %0, cntfrq_el0" : "=r"(value));
+  return value;
+}
+
+// Estimates the counter frequency against the os provided timer,
+// as Rdtsc does for a tsc without a known frequency.
+static jlong measure_frequency() {
+  static const unsigned int FT_SLEEP_MILLISECS = 1;
+  const unsigned int loopcount = 3;
+  jlong time_base = 0;
+  jlong time_fast = 0;
+  for (unsigned int times = 0; times < loopcount; times++) {
+    const jlong start = os::elapsed_counter();
+    OrderAccess::fence();
+    const jlong fstart = read_cntvct();
+
+    os::sleep(Thread::current(), FT_SLEEP_MILLISECS, true);
+
+    const jlong end = os::elapsed_counter();
+    OrderAccess::fence();
+    const jlong fend = read_cntvct();
+
+    time_base += end - start;
+    time_fast += fend - fstart;
+  }
+  if (time_base <= 0 || time_fast <= 0) {
+    return 0;
+  }
+  return (jlong)((double)time_fast / (double)time_base * (double)os::elapsed_frequency());
+}
+
+// CNTFRQ_EL0 is programmed by the firmware and is occasionally wrong,
+// only trust it if it agrees with a measurement.
+static jlong initialize_frequency() {
+  assert(0 == cntvct_frequency, "invariant");
+  assert(0 == _epoch, "invariant");
+  _epoch = read_cntvct();
+  const jlong reported = read_cntfrq();
+  const jlong measured = measure_frequency();
+  if (measured <= 0) {
+    return 0;
+  }
+  if (reported > 0 && reported >= measured - measured / 10 && reported <= measured + measured / 10) {
+    return reported;
+  }
+  if (UseFastUnorderedTimeStamps) {
+    warning("CNTFRQ_EL0 reports " JLONG_FORMAT " Hz, using the measured frequency of " JLONG_FORMAT " Hz",
+            reported, measured);
+  }
+  return measured;
+}
+
+static bool ergonomics() {
+  if (FLAG_IS_DEFAULT(UseFastUnorderedTimeStamps)) {
+    FLAG_SET_ERGO(bool, UseFastUnorderedTimeStamps, true);
+  }
+  return UseFastUnorderedTimeStamps;
+}
+
+bool Cntvct::is_supported() {
+  // the virtual counter is part of the base architecture
+  return true;
+}
+
+bool Cntvct::is_elapsed_counter_enabled() {
+  return cntvct_elapsed_counter_enabled;
+}
+
+jlong Cntvct::frequency() {
+  return cntvct_frequency;
+}
+
+jlong Cntvct::elapsed_counter() {
+  return read_cntvct() - _epoch;
+}
+
+jlong Cntvct::epoch() {
+  return _epoch;
+}
+
+jlong Cntvct::raw() {
+  return read_cntvct();
+}
+
+bool Cntvct::initialize() {
+  static bool initialized = false;
+  if (!initialized) {
+    assert(!cntvct_elapsed_counter_enabled, "invariant");
+    // skip the calibration if turned off on the command line
+    bool result = FLAG_IS_DEFAULT(UseFastUnorderedTimeStamps) || UseFastUnorderedTimeStamps;
+    if (result) {
+      cntvct_frequency = initialize_frequency();
+      result = cntvct_frequency > 0;
+    }
+    if (result) {
+      result = ergonomics(); // check logical state
+    }
+    cntvct_elapsed_counter_enabled = result;
+    initialized = true;
+  }
+  return cntvct_elapsed_counter_enabled;
+}
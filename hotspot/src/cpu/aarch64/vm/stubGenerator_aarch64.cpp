@@ -3120,6 +3120,337 @@ class StubGenerator: public StubCodeGenerator {
     return start;
   }
 
+  // Arguments:
+  //
+  // Inputs:
+  //   c_rarg0   - byte[]  source+offset
+  //   c_rarg1   - long[]  SHA.state
+  //   c_rarg2   - int     offset
+  //   c_rarg3   - int     limit
+  //
+  address generate_sha512_implCompress(bool multi_block, const char *name) {
+    static const uint64_t round_consts[80] = {
+      0x428a2f98d728ae22UL, 0x7137449123ef65cdUL,
+      0xb5c0fbcfec4d3b2fUL, 0xe9b5dba58189dbbcUL,
+      0x3956c25bf348b538UL, 0x59f111f1b605d019UL,
+      0x923f82a4af194f9bUL, 0xab1c5ed5da6d8118UL,
+      0xd807aa98a3030242UL, 0x12835b0145706fbeUL,
+      0x243185be4ee4b28cUL, 0x550c7dc3d5ffb4e2UL,
+      0x72be5d74f27b896fUL, 0x80deb1fe3b1696b1UL,
+      0x9bdc06a725c71235UL, 0xc19bf174cf692694UL,
+      0xe49b69c19ef14ad2UL, 0xefbe4786384f25e3UL,
+      0x0fc19dc68b8cd5b5UL, 0x240ca1cc77ac9c65UL,
+      0x2de92c6f592b0275UL, 0x4a7484aa6ea6e483UL,
+      0x5cb0a9dcbd41fbd4UL, 0x76f988da831153b5UL,
+      0x983e5152ee66dfabUL, 0xa831c66d2db43210UL,
+      0xb00327c898fb213fUL, 0xbf597fc7beef0ee4UL,
+      0xc6e00bf33da88fc2UL, 0xd5a79147930aa725UL,
+      0x06ca6351e003826fUL, 0x142929670a0e6e70UL,
+      0x27b70a8546d22ffcUL, 0x2e1b21385c26c926UL,
+      0x4d2c6dfc5ac42aedUL, 0x53380d139d95b3dfUL,
+      0x650a73548baf63deUL, 0x766a0abb3c77b2a8UL,
+      0x81c2c92e47edaee6UL, 0x92722c851482353bUL,
+      0xa2bfe8a14cf10364UL, 0xa81a664bbc423001UL,
+      0xc24b8b70d0f89791UL, 0xc76c51a30654be30UL,
+      0xd192e819d6ef5218UL, 0xd69906245565a910UL,
+      0xf40e35855771202aUL, 0x106aa07032bbd1b8UL,
+      0x19a4c116b8d2d0c8UL, 0x1e376c085141ab53UL,
+      0x2748774cdf8eeb99UL, 0x34b0bcb5e19b48a8UL,
+      0x391c0cb3c5c95a63UL, 0x4ed8aa4ae3418acbUL,
+      0x5b9cca4f7763e373UL, 0x682e6ff3d6b2b8a3UL,
+      0x748f82ee5defb2fcUL, 0x78a5636f43172f60UL,
+      0x84c87814a1f0ab72UL, 0x8cc702081a6439ecUL,
+      0x90befffa23631e28UL, 0xa4506cebde82bde9UL,
+      0xbef9a3f7b2c67915UL, 0xc67178f2e372532bUL,
+      0xca273eceea26619cUL, 0xd186b8c721c0c207UL,
+      0xeada7dd6cde0eb1eUL, 0xf57d4f7fee6ed178UL,
+      0x06f067aa72176fbaUL, 0x0a637dc5a2c898a6UL,
+      0x113f9804bef90daeUL, 0x1b710b35131c471bUL,
+      0x28db77f523047d84UL, 0x32caab7b40c72493UL,
+      0x3c9ebe0a15c9bebcUL, 0x431d67c49c100d4cUL,
+      0x4cc5d4becb3e42b6UL, 0x597f299cfc657e2aUL,
+      0x5fcb6fab3ad6faecUL, 0x6c44198c4a475817UL,
+    };
+
+    // Double rounds for sha512.
+    #define sha512_dround(dr, i0, i1, i2, i3, i4, rc0, rc1, in0, in1, in2, in3, in4) \
+      if (dr < 36)                                                                   \
+        __ ld1(v##rc1, __ T2D, __ post(rscratch2, 16));                              \
+      __ addv(v5, __ T2D, v##rc0, v##in0);                                           \
+      __ ext(v6, __ T16B, v##i2, v##i3, 8);                                          \
+      __ ext(v5, __ T16B, v5, v5, 8);                                                \
+      __ ext(v7, __ T16B, v##i1, v##i2, 8);                                          \
+      __ addv(v##i3, __ T2D, v##i3, v5);                                             \
+      if (dr < 32) {                                                                 \
+        __ ext(v5, __ T16B, v##in3, v##in4, 8);                                      \
+        __ sha512su0(v##in0, __ T2D, v##in1);                                        \
+      }                                                                              \
+      __ sha512h(v##i3, __ T2D, v6, v7);                                             \
+      if (dr < 32)                                                                   \
+        __ sha512su1(v##in0, __ T2D, v##in2, v5);                                    \
+      __ addv(v##i4, __ T2D, v##i1, v##i3);                                          \
+      __ sha512h2(v##i3, __ T2D, v##i1, v##i0);                                      \
+
+    assert(UseSHA512Intrinsics, "need SHA512 instructions");
+
+    __ align(CodeEntryAlignment);
+    StubCodeMark mark(this, "StubRoutines", name);
+    address start = __ pc();
+
+    Register buf   = c_rarg0;
+    Register state = c_rarg1;
+    Register ofs   = c_rarg2;
+    Register limit = c_rarg3;
+
+    __ stpd(v8, v9, __ pre(sp, -64));
+    __ stpd(v10, v11, Address(sp, 16));
+    __ stpd(v12, v13, Address(sp, 32));
+    __ stpd(v14, v15, Address(sp, 48));
+
+    Label sha512_loop;
+
+    // load state
+    __ ld1(v8, v9, v10, v11, __ T2D, state);
+
+    // load first 4 round constants
+    __ lea(rscratch1, ExternalAddress((address)round_consts));
+    __ ld1(v20, v21, v22, v23, __ T2D, __ post(rscratch1, 64));
+
+    __ BIND(sha512_loop);
+    // load 128B of data into v12..v19
+    __ ld1(v12, v13, v14, v15, __ T2D, __ post(buf, 64));
+    __ ld1(v16, v17, v18, v19, __ T2D, __ post(buf, 64));
+    __ rev64(v12, __ T16B, v12);
+    __ rev64(v13, __ T16B, v13);
+    __ rev64(v14, __ T16B, v14);
+    __ rev64(v15, __ T16B, v15);
+    __ rev64(v16, __ T16B, v16);
+    __ rev64(v17, __ T16B, v17);
+    __ rev64(v18, __ T16B, v18);
+    __ rev64(v19, __ T16B, v19);
+
+    __ mov(rscratch2, rscratch1);
+
+    __ mov(v0, __ T16B, v8);
+    __ mov(v1, __ T16B, v9);
+    __ mov(v2, __ T16B, v10);
+    __ mov(v3, __ T16B, v11);
+
+    sha512_dround( 0, 0, 1, 2, 3, 4, 20, 24, 12, 13, 19, 16, 17);
+    sha512_dround( 1, 3, 0, 4, 2, 1, 21, 25, 13, 14, 12, 17, 18);
+    sha512_dround( 2, 2, 3, 1, 4, 0, 22, 26, 14, 15, 13, 18, 19);
+    sha512_dround( 3, 4, 2, 0, 1, 3, 23, 27, 15, 16, 14, 19, 12);
+    sha512_dround( 4, 1, 4, 3, 0, 2, 24, 28, 16, 17, 15, 12, 13);
+    sha512_dround( 5, 0, 1, 2, 3, 4, 25, 29, 17, 18, 16, 13, 14);
+    sha512_dround( 6, 3, 0, 4, 2, 1, 26, 30, 18, 19, 17, 14, 15);
+    sha512_dround( 7, 2, 3, 1, 4, 0, 27, 31, 19, 12, 18, 15, 16);
+    sha512_dround( 8, 4, 2, 0, 1, 3, 28, 24, 12, 13, 19, 16, 17);
+    sha512_dround( 9, 1, 4, 3, 0, 2, 29, 25, 13, 14, 12, 17, 18);
+    sha512_dround(10, 0, 1, 2, 3, 4, 30, 26, 14, 15, 13, 18, 19);
+    sha512_dround(11, 3, 0, 4, 2, 1, 31, 27, 15, 16, 14, 19, 12);
+    sha512_dround(12, 2, 3, 1, 4, 0, 24, 28, 16, 17, 15, 12, 13);
+    sha512_dround(13, 4, 2, 0, 1, 3, 25, 29, 17, 18, 16, 13, 14);
+    sha512_dround(14, 1, 4, 3, 0, 2, 26, 30, 18, 19, 17, 14, 15);
+    sha512_dround(15, 0, 1, 2, 3, 4, 27, 31, 19, 12, 18, 15, 16);
+    sha512_dround(16, 3, 0, 4, 2, 1, 28, 24, 12, 13, 19, 16, 17);
+    sha512_dround(17, 2, 3, 1, 4, 0, 29, 25, 13, 14, 12, 17, 18);
+    sha512_dround(18, 4, 2, 0, 1, 3, 30, 26, 14, 15, 13, 18, 19);
+    sha512_dround(19, 1, 4, 3, 0, 2, 31, 27, 15, 16, 14, 19, 12);
+    sha512_dround(20, 0, 1, 2, 3, 4, 24, 28, 16, 17, 15, 12, 13);
+    sha512_dround(21, 3, 0, 4, 2, 1, 25, 29, 17, 18, 16, 13, 14);
+    sha512_dround(22, 2, 3, 1, 4, 0, 26, 30, 18, 19, 17, 14, 15);
+    sha512_dround(23, 4, 2, 0, 1, 3, 27, 31, 19, 12, 18, 15, 16);
+    sha512_dround(24, 1, 4, 3, 0, 2, 28, 24, 12, 13, 19, 16, 17);
+    sha512_dround(25, 0, 1, 2, 3, 4, 29, 25, 13, 14, 12, 17, 18);
+    sha512_dround(26, 3, 0, 4, 2, 1, 30, 26, 14, 15, 13, 18, 19);
+    sha512_dround(27, 2, 3, 1, 4, 0, 31, 27, 15, 16, 14, 19, 12);
+    sha512_dround(28, 4, 2, 0, 1, 3, 24, 28, 16, 17, 15, 12, 13);
+    sha512_dround(29, 1, 4, 3, 0, 2, 25, 29, 17, 18, 16, 13, 14);
+    sha512_dround(30, 0, 1, 2, 3, 4, 26, 30, 18, 19, 17, 14, 15);
+    sha512_dround(31, 3, 0, 4, 2, 1, 27, 31, 19, 12, 18, 15, 16);
+    sha512_dround(32, 2, 3, 1, 4, 0, 28, 24, 12,  0,  0,  0,  0);
+    sha512_dround(33, 4, 2, 0, 1, 3, 29, 25, 13,  0,  0,  0,  0);
+    sha512_dround(34, 1, 4, 3, 0, 2, 30, 26, 14,  0,  0,  0,  0);
+    sha512_dround(35, 0, 1, 2, 3, 4, 31, 27, 15,  0,  0,  0,  0);
+    sha512_dround(36, 3, 0, 4, 2, 1, 24,  0, 16,  0,  0,  0,  0);
+    sha512_dround(37, 2, 3, 1, 4, 0, 25,  0, 17,  0,  0,  0,  0);
+    sha512_dround(38, 4, 2, 0, 1, 3, 26,  0, 18,  0,  0,  0,  0);
+    sha512_dround(39, 1, 4, 3, 0, 2, 27,  0, 19,  0,  0,  0,  0);
+
+    __ addv(v8, __ T2D, v8, v0);
+    __ addv(v9, __ T2D, v9, v1);
+    __ addv(v10, __ T2D, v10, v2);
+    __ addv(v11, __ T2D, v11, v3);
+
+    if (multi_block) {
+      __ add(ofs, ofs, 128);
+      __ cmp(ofs, limit);
+      __ br(Assembler::LE, sha512_loop);
+      __ mov(c_rarg0, ofs); // return ofs
+    }
+
+    __ st1(v8, v9, v10, v11, __ T2D, state);
+
+    __ ldpd(v14, v15, Address(sp, 48));
+    __ ldpd(v12, v13, Address(sp, 32));
+    __ ldpd(v10, v11, Address(sp, 16));
+    __ ldpd(v8, v9, __ post(sp, 64));
+
+    __ ret(lr);
+
+    #undef sha512_dround
+
+    return start;
+  }
+
+  // Karatsuba multiplication performs a 128*128 -> 256-bit
+  // multiplication in three 128-bit multiplications and a few
+  // additions.
+  //
+  // (C1:C0) = A1*B1, (D1:D0) = A0*B0, (E1:E0) = (A0+A1)(B0+B1)
+  // (A1:A0)(B1:B0) = C1:(C0+C1+D1+E1):(D1+C0+D0+E0):D0
+  //
+  // Inputs:
+  //
+  // A0 in a.d[0]     (subkey)
+  // A1 in a.d[1]
+  // (A1+A0) in a1_xor_a0.d[0]
+  //
+  // B0 in b.d[0]     (state)
+  // B1 in b.d[1]
+  void ghash_multiply(FloatRegister result_hi, FloatRegister result_lo,
+                      FloatRegister a, FloatRegister b, FloatRegister a1_xor_a0,
+                      FloatRegister tmp1, FloatRegister tmp2, FloatRegister tmp3) {
+    __ ext(tmp1, __ T16B, b, b, 0x08);
+    __ pmull2(result_hi, __ T1Q, b, a, __ T2D);      // A1*B1
+    __ eor(tmp1, __ T16B, tmp1, b);                  // (B1+B0)
+    __ pmull(result_lo, __ T1Q, b, a, __ T1D);       // A0*B0
+    __ pmull(tmp2, __ T1Q, tmp1, a1_xor_a0, __ T1D); // (A1+A0)(B1+B0)
+
+    __ ext(tmp1, __ T16B, result_lo, result_hi, 0x08);
+    __ eor(tmp3, __ T16B, result_hi, result_lo);     // A1*B1+A0*B0
+    __ eor(tmp2, __ T16B, tmp2, tmp1);
+    __ eor(tmp2, __ T16B, tmp2, tmp3);
+
+    // Register pair <result_hi:result_lo> holds the result of carry-less multiplication
+    __ ins(result_hi, __ D, tmp2, 0, 1);
+    __ ins(result_lo, __ D, tmp2, 1, 0);
+  }
+
+  // The GCM field polynomial f is z^128 + p(z), where p =
+  // z^7+z^2+z+1.
+  //
+  //    z^128 === -p(z)  (mod (z^128 + p(z)))
+  //
+  // so, given that the product we're reducing is
+  //    a == lo + hi * z^128
+  // substituting,
+  //      === lo - hi * p(z)  (mod (z^128 + p(z)))
+  //
+  // we reduce by multiplying hi by p(z) and subtracting the result
+  // from (i.e. XORing it with) lo.  Because p has no nonzero high
+  // bits we can do this with two 64-bit multiplications, lo*p and
+  // hi*p.
+  void ghash_reduce(FloatRegister result, FloatRegister lo, FloatRegister hi,
+                    FloatRegister p, FloatRegister z, FloatRegister t1) {
+    const FloatRegister t0 = result;
+
+    __ pmull2(t0, __ T1Q, hi, p, __ T2D);
+    __ ext(t1, __ T16B, t0, z, 8);
+    __ eor(hi, __ T16B, hi, t1);
+    __ ext(t1, __ T16B, z, t0, 8);
+    __ eor(lo, __ T16B, lo, t1);
+    __ pmull(t0, __ T1Q, hi, p, __ T1D);
+    __ eor(result, __ T16B, lo, t0);
+  }
+
+  /**
+   *  Arguments:
+   *
+   *  Input:
+   *  c_rarg0   - current state address
+   *  c_rarg1   - H key address
+   *  c_rarg2   - data address
+   *  c_rarg3   - number of blocks
+   *
+   *  Output:
+   *  Updated state at c_rarg0
+   */
+  address generate_ghash_processBlocks() {
+    // GCM uses little-endian for the byte order, but big-endian for
+    // the bit order.  For example, the polynomial 1 is represented as
+    // the 16-byte string 80 00 00 00 | 12 bytes of 00.
+    //
+    // So, we must either reverse the bytes in each word and do
+    // everything big-endian or reverse the bits in each byte and do
+    // it little-endian.  On AArch64 it's more idiomatic to reverse
+    // the bits in each byte (we have an instruction, RBIT, to do
+    // that) and keep the data in little-endian bit order throughout
+    // the calculation, bit-reversing the inputs and outputs.
+
+    StubCodeMark mark(this, "StubRoutines", "ghash_processBlocks");
+    __ align(wordSize * 2);
+    address p = __ pc();
+    __ emit_int64(0x87);  // The low-order bits of the field
+                          // polynomial (i.e. p = z^7+z^2+z+1)
+                          // repeated in the low and high parts of a
+                          // 128-bit vector
+    __ emit_int64(0x87);
+
+    __ align(CodeEntryAlignment);
+    address start = __ pc();
+
+    Register state   = c_rarg0;
+    Register subkeyH = c_rarg1;
+    Register data    = c_rarg2;
+    Register blocks  = c_rarg3;
+
+    FloatRegister vzr = v30;
+    __ eor(vzr, __ T16B, vzr, vzr); // zero register
+
+    __ ldrq(v0, Address(state));
+    __ ldrq(v1, Address(subkeyH));
+
+    __ rev64(v0, __ T16B, v0);          // Bit-reverse words in state and subkeyH
+    __ rbit(v0, __ T16B, v0);
+    __ rev64(v1, __ T16B, v1);
+    __ rbit(v1, __ T16B, v1);
+
+    __ ldrq(v26, p);
+
+    __ ext(v16, __ T16B, v1, v1, 0x08); // long-swap subkeyH into v16
+    __ eor(v16, __ T16B, v16, v1);      // xor subkeyH into subkeyL (Karatsuba: (A1+A0))
+
+    {
+      Label L_ghash_loop;
+      __ bind(L_ghash_loop);
+
+      __ ldrq(v2, Address(__ post(data, 0x10))); // Load the data, bit
+                                                 // reversing each byte
+      __ rbit(v2, __ T16B, v2);
+      __ eor(v2, __ T16B, v0, v2);   // bit-swapped data ^ bit-swapped state
+
+      // Multiply state in v2 by subkey in v1
+      ghash_multiply(/*result_hi*/v7, /*result_lo*/v5,
+                     /*a*/v1, /*b*/v2, /*a1_xor_a0*/v16,
+                     /*temps*/v6, v20, v18);
+      // Reduce v7:v5 by the field polynomial
+      ghash_reduce(v0, v5, v7, v26, vzr, v20);
+
+      __ sub(blocks, blocks, 1);
+      __ cbnz(blocks, L_ghash_loop);
+    }
+
+    // The bit-reversed result is at this point in v0
+    __ rev64(v1, __ T16B, v0);
+    __ rbit(v1, __ T16B, v1);
+
+    __ st1(v1, __ T16B, state);
+    __ ret(lr);
+
+    return start;
+  }
+
   // Safefetch stubs.
   void generate_safefetch(const char* name, int size, address* entry,
                           address* fault_pc, address* continuation_pc) {
@@ -3204,6 +3535,118 @@ class StubGenerator: public StubCodeGenerator {
     return start;
   }
 
+  /**
+   *  Arguments:
+   *
+   * Inputs:
+   *   c_rarg0   - int   adler
+   *   c_rarg1   - byte* buff
+   *   c_rarg2   - int   len
+   *
+   * Output:
+   *   c_rarg0   - int adler result
+   */
+  address generate_updateBytesAdler32() {
+    __ align(CodeEntryAlignment);
+    StubCodeMark mark(this, "StubRoutines", "updateBytesAdler32");
+    address start = __ pc();
+
+    Label L_nmax, L_nmax_loop, L_by16, L_by16_loop, L_by1_loop, L_do_mod;
+
+    // Aliases
+    Register adler  = c_rarg0;
+    Register s1     = c_rarg0;
+    Register s2     = c_rarg3;
+    Register buff   = c_rarg1;
+    Register len    = c_rarg2;
+    Register nmax   = r4;
+    Register base   = r5;
+    Register count  = r6;
+    Register temp0  = rscratch1;
+    Register temp1  = rscratch2;
+
+    // Max number of bytes we can process before having to take the mod
+    // 0x15B0 is 5552 in decimal, the largest n such that 255n(n+1)/2 + (n+1)(BASE-1) <= 2^32-1
+    unsigned long BASE = 0xfff1;
+    unsigned long NMAX = 0x15B0;
+
+    __ mov(base, BASE);
+    __ mov(nmax, NMAX);
+
+    // s1 is initialized to the lower 16 bits of adler
+    // s2 is initialized to the upper 16 bits of adler
+    __ ubfx(s2, adler, 16, 16);  // s2 = ((adler >> 16) & 0xffff)
+    __ uxth(s1, adler);          // s1 = (adler & 0xffff)
+
+#define ADLER32_STEP()                                  \
+    __ ldrb(temp0, Address(__ post(buff, 1)));          \
+    __ ldrb(temp1, Address(__ post(buff, 1)));          \
+    __ add(s1, s1, temp0);                              \
+    __ add(s2, s2, s1);                                 \
+    __ add(s1, s1, temp1);                              \
+    __ add(s2, s2, s1);
+
+    // Whole NMAX blocks, each followed by a reduction modulo BASE
+    __ bind(L_nmax);
+    __ cmpw(len, nmax);
+    __ br(Assembler::LO, L_by16);
+    __ subw(len, len, nmax);
+    __ movw(count, nmax);
+
+    __ bind(L_nmax_loop);
+    for (int i = 0; i < 8; i++) {
+      ADLER32_STEP();
+    }
+    __ subsw(count, count, 16);
+    __ br(Assembler::NE, L_nmax_loop);
+
+    __ udiv(temp0, s1, base);
+    __ msub(s1, temp0, base, s1);
+    __ udiv(temp0, s2, base);
+    __ msub(s2, temp0, base, s2);
+    __ b(L_nmax);
+
+    // Remaining 16-byte chunks
+    __ bind(L_by16);
+    __ subsw(len, len, 16);
+    __ br(Assembler::LT, L_do_mod);
+
+    __ bind(L_by16_loop);
+    for (int i = 0; i < 8; i++) {
+      ADLER32_STEP();
+    }
+    __ subsw(len, len, 16);
+    __ br(Assembler::GE, L_by16_loop);
+
+#undef ADLER32_STEP
+
+    // Fewer than 16 bytes left
+    __ bind(L_do_mod);
+    __ addsw(len, len, 16);
+    Label L_mod;
+    __ br(Assembler::EQ, L_mod);
+
+    __ bind(L_by1_loop);
+    __ ldrb(temp0, Address(__ post(buff, 1)));
+    __ add(s1, s1, temp0);
+    __ add(s2, s2, s1);
+    __ subsw(len, len, 1);
+    __ br(Assembler::NE, L_by1_loop);
+
+    __ bind(L_mod);
+    __ udiv(temp0, s1, base);
+    __ msub(s1, temp0, base, s1);
+    __ udiv(temp0, s2, base);
+    __ msub(s2, temp0, base, s2);
+
+    // Combine lower bits and higher bits
+    __ orr(s1, s1, s2, Assembler::LSL, 16); // adler = s1 | (s2 << 16)
+
+    __ ret(lr);
+
+    return start;
+  }
+
   /**
    *  Arguments:
    *
@@ -3244,6 +3687,104 @@ class StubGenerator: public StubCodeGenerator {
     return start;
   }
 
+  /**
+   *  Arguments:
+   *
+   *  Input:
+   *    c_rarg0   - a address
+   *    c_rarg1   - b address
+   *    c_rarg2   - length in elements
+   *    c_rarg3   - log2 of the element size
+   *
+   *  Output:
+   *    r0        - index of the first mismatching element, or -1
+   */
+  address generate_vectorizedMismatch() {
+    __ align(CodeEntryAlignment);
+    StubCodeMark mark(this, "StubRoutines", "vectorizedMismatch");
+
+    address start = __ pc();
+    const Register obja  = r0;
+    const Register objb  = r1;
+    const Register len   = r2;
+    const Register scale = r3;
+    const Register limit = r4;    // length in bytes
+    const Register index = r5;    // byte offset of the current chunk
+
+    const Register tmp1  = r10;
+    const Register tmp2  = r11;
+    const Register tmp3  = r12;
+    const Register tmp4  = r13;
+
+    Label L_loop_16, L_rescan_16, L_loop_8, L_found_8, L_loop_byte, L_found, L_no_mismatch;
+
+    BLOCK_COMMENT("Entry:");
+    __ enter(); // required for proper stackwalking of RuntimeStub frame
+
+    __ sxtw(limit, len);
+    __ lslv(limit, limit, scale); // elements -> bytes
+    __ mov(index, zr);
+
+    // Compare 16 bytes at a time. A differing chunk is rescanned by the
+    // 8-byte loop below, which finds the exact byte.
+    __ bind(L_loop_16);
+    __ sub(tmp1, limit, index);
+    __ cmp(tmp1, 16u);
+    __ br(Assembler::LT, L_loop_8);
+    __ ldp(tmp1, tmp2, Address(__ post(obja, 16)));
+    __ ldp(tmp3, tmp4, Address(__ post(objb, 16)));
+    __ eor(tmp1, tmp1, tmp3);
+    __ eor(tmp2, tmp2, tmp4);
+    __ orr(tmp1, tmp1, tmp2);
+    __ cbnz(tmp1, L_rescan_16);
+    __ add(index, index, 16);
+    __ b(L_loop_16);
+
+    __ bind(L_rescan_16);
+    __ sub(obja, obja, 16);
+    __ sub(objb, objb, 16);
+
+    __ bind(L_loop_8);
+    __ sub(tmp1, limit, index);
+    __ cmp(tmp1, 8u);
+    __ br(Assembler::LT, L_loop_byte);
+    __ ldr(tmp1, Address(__ post(obja, 8)));
+    __ ldr(tmp2, Address(__ post(objb, 8)));
+    __ eor(tmp1, tmp1, tmp2);
+    __ cbnz(tmp1, L_found_8);
+    __ add(index, index, 8);
+    __ b(L_loop_8);
+
+    __ bind(L_found_8);
+    // Lowest set bit of the difference is in the first differing byte.
+    __ rbit(tmp1, tmp1);
+    __ clz(tmp1, tmp1);
+    __ add(index, index, tmp1, Assembler::LSR, LogBitsPerByte);
+    __ b(L_found);
+
+    __ bind(L_loop_byte);
+    __ cmp(index, limit);
+    __ br(Assembler::GE, L_no_mismatch);
+    __ ldrb(tmp1, Address(__ post(obja, 1)));
+    __ ldrb(tmp2, Address(__ post(objb, 1)));
+    __ cmpw(tmp1, tmp2);
+    __ br(Assembler::NE, L_found);
+    __ add(index, index, 1);
+    __ b(L_loop_byte);
+
+    __ bind(L_found);
+    __ lsrv(r0, index, scale);    // bytes -> elements
+    __ leave(); // required for proper stackwalking of RuntimeStub frame
+    __ ret(lr);
+
+    __ bind(L_no_mismatch);
+    __ mov(r0, -1);
+    __ leave(); // required for proper stackwalking of RuntimeStub frame
+    __ ret(lr);
+
+    return start;
+  }
+
   // Continuation point for throwing of implicit exceptions that are
   // not handled in the current activation. Fabricates an exception
   // oop and initiates normal exception dispatching in this
@@ -4238,10 +4779,18 @@ class StubGenerator: public StubCodeGenerator {
     // arraycopy stubs used by compilers
     generate_arraycopy_stubs();
 
+    if (UseAdler32Intrinsics) {
+      StubRoutines::_updateBytesAdler32 = generate_updateBytesAdler32();
+    }
+
     if (UseMultiplyToLenIntrinsic) {
       StubRoutines::_multiplyToLen = generate_multiplyToLen();
     }
 
+    if (UseVectorizedMismatchIntrinsic) {
+      StubRoutines::_vectorizedMismatch = generate_vectorizedMismatch();
+    }
+
     if (UseMontgomeryMultiplyIntrinsic) {
       StubCodeMark mark(this, "StubRoutines", "montgomeryMultiply");
       MontgomeryMultiplyGenerator g(_masm, /*squaring*/false);
@@ -4263,6 +4812,10 @@ class StubGenerator: public StubCodeGenerator {
       StubRoutines::_cipherBlockChaining_decryptAESCrypt = generate_cipherBlockChaining_decryptAESCrypt();
     }
 
+    if (UseGHASHIntrinsics) {
+      StubRoutines::_ghash_processBlocks = generate_ghash_processBlocks();
+    }
+
     if (UseSHA1Intrinsics) {
       StubRoutines::_sha1_implCompress     = generate_sha1_implCompress(false,   "sha1_implCompress");
       StubRoutines::_sha1_implCompressMB   = generate_sha1_implCompress(true,    "sha1_implCompressMB");
@@ -4271,6 +4824,10 @@ class StubGenerator: public StubCodeGenerator {
       StubRoutines::_sha256_implCompress   = generate_sha256_implCompress(false, "sha256_implCompress");
       StubRoutines::_sha256_implCompressMB = generate_sha256_implCompress(true,  "sha256_implCompressMB");
     }
+    if (UseSHA512Intrinsics) {
+      StubRoutines::_sha512_implCompress   = generate_sha512_implCompress(false, "sha512_implCompress");
+      StubRoutines::_sha512_implCompressMB = generate_sha512_implCompress(true,  "sha512_implCompressMB");
+    }
 
     // Safefetch stubs.
     generate_safefetch("SafeFetch32", sizeof(int),     &StubRoutines::_safefetch32_entry,
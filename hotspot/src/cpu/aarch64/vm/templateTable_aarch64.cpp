@@ -1469,6 +1469,22 @@ void TemplateTable::iinc()
   __ str(r0, iaddress(r2));
 }
 
+// iinc followed by goto: do the increment, then enter the goto template
+// directly instead of dispatching on the next bytecode.
+void TemplateTable::fast_iinc_goto()
+{
+  transition(vtos, vtos);
+  address goto_entry = Interpreter::normal_table(vtos)[Bytecodes::_goto];
+  assert(goto_entry != NULL, "goto must be generated before fast_iinc_goto");
+  __ load_signed_byte(r1, at_bcp(2)); // get constant
+  locals_index(r2);
+  __ ldr(r0, iaddress(r2));
+  __ addw(r0, r0, r1);
+  __ str(r0, iaddress(r2));
+  __ add(rbcp, rbcp, Bytecodes::length_for(Bytecodes::_iinc));
+  __ b(goto_entry);
+}
+
 void TemplateTable::wide_iinc()
 {
   transition(vtos, vtos);
@@ -3496,6 +3512,13 @@ void TemplateTable::_new() {
   if (allow_shared_alloc) {
     __ bind(allocate_shared);
 
+    if (UseTLAB) {
+      // If the heap sampler moved the end of the tlab, the allocation
+      // reached the sample point: the runtime takes the sample.
+      __ ldr(rscratch1, Address(rthread, in_bytes(JavaThread::tlab_allocation_end_offset())));
+      __ cbnz(rscratch1, slow_case);
+    }
+
     __ eden_allocate(r0, r3, 0, r10, slow_case);
     __ incr_allocated_bytes(rthread, r3, 0, rscratch1);
   }
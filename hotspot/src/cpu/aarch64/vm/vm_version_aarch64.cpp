@@ -89,6 +89,14 @@ void VM_Version::initialize() {
       FLAG_SET_DEFAULT(UseSIMDForMemoryOps, (_variant > 0));
     }
   }
+  // Neoverse N1, V1 and N2 and the Apple cores sustain 128-bit load/store
+  // pairs at full bandwidth, so use the SIMD registers for copying.
+  if ((_cpu == CPU_ARM && (_model == 0xd0c || _model == 0xd40 || _model == 0xd49)) ||
+      _cpu == CPU_APPLE) {
+    if (FLAG_IS_DEFAULT(UseSIMDForMemoryOps)) {
+      FLAG_SET_DEFAULT(UseSIMDForMemoryOps, true);
+    }
+  }
   if (_cpu == CPU_ARM && (_model == 0xd03 || _model2 == 0xd03)) _cpuFeatures |= CPU_A53MAC;
   if (_cpu == CPU_ARM && (_model == 0xd07 || _model2 == 0xd07)) _cpuFeatures |= CPU_STXR_PREFETCH;
   // If an olde style /proc/cpuinfo (cores == 1) then if _model is an A57 (0xd07)
@@ -105,9 +113,20 @@ void VM_Version::initialize() {
   if (_cpuFeatures & CPU_SHA1)  strcat(buf, ", sha1");
   if (_cpuFeatures & CPU_SHA2)  strcat(buf, ", sha256");
   if (_cpuFeatures & CPU_SHA512) strcat(buf, ", sha512");
+  if (_cpuFeatures & CPU_SHA3)  strcat(buf, ", sha3");
+  if (_cpuFeatures & CPU_ASIMDDP) strcat(buf, ", dotprod");
+  if (_cpuFeatures & CPU_ASIMDHP) strcat(buf, ", fphp");
   if (_cpuFeatures & CPU_LSE) strcat(buf, ", lse");
-  if (_cpuFeatures & CPU_SVE) strcat(buf, ", sve");
+  if (_cpuFeatures & CPU_DCPOP) strcat(buf, ", dcpop");
+  if (_cpuFeatures & CPU_SVE) {
+    strcat(buf, ", sve");
+    if (_initial_sve_vector_length > 0) {
+      sprintf(buf+strlen(buf), "(%d)", _initial_sve_vector_length * 8);
+    }
+  }
   if (_cpuFeatures & CPU_SVE2) strcat(buf, ", sve2");
+  if (_zva_length > 0) sprintf(buf+strlen(buf), ", zva(%d)", _zva_length);
+  sprintf(buf+strlen(buf), ", dcache(%d)", _dcache_line_size);
 
   _features_str = os::strdup(buf);
 
@@ -144,7 +163,11 @@ void VM_Version::initialize() {
     }
   }
 
-  if (UseGHASHIntrinsics) {
+  if (_cpuFeatures & CPU_PMULL) {
+    if (FLAG_IS_DEFAULT(UseGHASHIntrinsics)) {
+      FLAG_SET_DEFAULT(UseGHASHIntrinsics, true);
+    }
+  } else if (UseGHASHIntrinsics) {
     warning("GHASH intrinsics are not available on this CPU");
     FLAG_SET_DEFAULT(UseGHASHIntrinsics, false);
   }
@@ -153,7 +176,11 @@ void VM_Version::initialize() {
     UseCRC32Intrinsics = true;
   }
 
-  if (_cpuFeatures & (CPU_SHA1 | CPU_SHA2)) {
+  if (FLAG_IS_DEFAULT(UseAdler32Intrinsics)) {
+    FLAG_SET_DEFAULT(UseAdler32Intrinsics, true);
+  }
+
+  if (_cpuFeatures & (CPU_SHA1 | CPU_SHA2 | CPU_SHA512)) {
     if (FLAG_IS_DEFAULT(UseSHA)) {
       FLAG_SET_DEFAULT(UseSHA, true);
     }
@@ -183,7 +210,11 @@ void VM_Version::initialize() {
       warning("SHA256 instruction (for SHA-224 and SHA-256) is not available on this CPU.");
       FLAG_SET_DEFAULT(UseSHA256Intrinsics, false);
     }
-    if (UseSHA512Intrinsics) {
+    if (_cpuFeatures & CPU_SHA512) {
+      if (FLAG_IS_DEFAULT(UseSHA512Intrinsics)) {
+        FLAG_SET_DEFAULT(UseSHA512Intrinsics, true);
+      }
+    } else if (UseSHA512Intrinsics) {
       warning("SHA512 instruction (for SHA-384 and SHA-512) is not available on this CPU.");
       FLAG_SET_DEFAULT(UseSHA512Intrinsics, false);
     }
@@ -205,6 +236,10 @@ void VM_Version::initialize() {
     UseMultiplyToLenIntrinsic = true;
   }
 
+  if (FLAG_IS_DEFAULT(UseVectorizedMismatchIntrinsic)) {
+    UseVectorizedMismatchIntrinsic = true;
+  }
+
   if (FLAG_IS_DEFAULT(UseBarriersForVolatile)) {
     UseBarriersForVolatile = (_cpuFeatures & CPU_DMB_ATOMICS) != 0;
   }
@@ -90,7 +90,11 @@ public:
     CPU_SHA2         = (1<<6),
     CPU_CRC32        = (1<<7),
     CPU_LSE          = (1<<8),
+    CPU_FPHP         = (1<<9),
+    CPU_ASIMDHP      = (1<<10),
     CPU_DCPOP        = (1<<16),
+    CPU_SHA3         = (1<<17),
+    CPU_ASIMDDP      = (1<<20),
     CPU_SHA512       = (1<<21),
     CPU_SVE          = (1<<22),
     // flags above must follow Linux HWCAP
@@ -892,6 +892,10 @@ class StubGenerator: public StubCodeGenerator {
     const Register value = R4_ARG2;   // fill value
     const Register count = R5_ARG3;   // elements count
     const Register temp  = R6_ARG4;   // temp register
+    const Register off16 = R7_ARG5;   // offset of the second vector store
+
+    // C2 does not allocate vector registers on PPC64, so VR0 is free here.
+    const VectorSRegister value_vsr = VR0->to_vsr();
 
     //assert_clean_int(count, O3);    // Make sure 'count' is clean int.
 
@@ -963,17 +967,40 @@ class StubGenerator: public StubCodeGenerator {
     __ blt(CCR0, L_check_fill_8_bytes);
 
     Label L_fill_32_bytes_loop;
-    __ align(32);
-    __ bind(L_fill_32_bytes_loop);
+    if (!VM_Version::has_vsx()) {
+      __ align(32);
+      __ bind(L_fill_32_bytes_loop);
+
+      __ std(value, 0, to);
+      __ std(value, 8, to);
+      __ subf_(count, temp, count);         // Update count.
+      __ std(value, 16, to);
+      __ std(value, 24, to);
+
+      __ addi(to, to, 32);
+      __ bge(CCR0, L_fill_32_bytes_loop);
+    } else { // Processor supports VSX, so use it to mass fill.
+      // Get the 8 byte pattern into both doublewords by going through the
+      // first 16 bytes of the destination, which are filled anyway (mtvsrd
+      // needs Power8). The doubleword order does not matter, so stxvd2x
+      // needs no swap on little endian either.
+      __ std(value, 0, to);
+      __ std(value, 8, to);
+      __ lxvd2x(value_vsr, to);
+      __ li(off16, 16);
+
+      // Backbranch target aligned to 32-byte. The loop fits inside
+      // a single i-cache sector.
+      __ align(32);
+      __ bind(L_fill_32_bytes_loop);
 
-    __ std(value, 0, to);
-    __ std(value, 8, to);
-    __ subf_(count, temp, count);           // Update count.
-    __ std(value, 16, to);
-    __ std(value, 24, to);
+      __ stxvd2x(value_vsr, to);            // Store to dst
+      __ subf_(count, temp, count);         // Update count.
+      __ stxvd2x(value_vsr, off16, to);     // Store to dst + 16
 
-    __ addi(to, to, 32);
-    __ bge(CCR0, L_fill_32_bytes_loop);
+      __ addi(to, to, 32);
+      __ bge(CCR0, L_fill_32_bytes_loop);
+    }
 
     __ bind(L_check_fill_8_bytes);
     __ add_(count, temp, count);
@@ -1032,7 +1059,7 @@ class StubGenerator: public StubCodeGenerator {
       __ andi_(temp, count, 2);
       __ beq(CCR0, L_fill_4);
       __ stb(value, 0, to);
-      __ stb(value, 0, to);
+      __ stb(value, 1, to);
       __ addi(to, to, 2);
       __ bind(L_fill_4);
       __ andi_(temp, count, 4);
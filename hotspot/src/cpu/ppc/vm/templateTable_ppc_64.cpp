@@ -3673,6 +3673,12 @@ void TemplateTable::_new() {
       Register RfreeValue = RnewTopValue;
 
       __ bind(Lallocate_shared);
+      // If the heap sampler moved the end of the tlab, the allocation
+      // reached the sample point: the runtime takes the sample.
+      __ ld(RtlabWasteLimitValue, in_bytes(JavaThread::tlab_allocation_end_offset()), R16_thread);
+      __ cmpdi(CCR0, RtlabWasteLimitValue, 0);
+      __ bne(CCR0, Lslow_case);
+
       // Check if tlab should be discarded (refill_waste_limit >= free).
       __ ld(RtlabWasteLimitValue, in_bytes(JavaThread::tlab_refill_waste_limit_offset()), R16_thread);
       __ subf(RfreeValue, RoldTopValue, RendValue);
@@ -3394,6 +3394,11 @@ void TemplateTable::_new() {
     __ delayed()->st_ptr(RnewTopValue, G2_thread, in_bytes(JavaThread::tlab_top_offset()));
 
     if (allow_shared_alloc) {
+      // If the heap sampler moved the end of the tlab, the allocation
+      // reached the sample point: the runtime takes the sample.
+      __ ld_ptr(G2_thread, in_bytes(JavaThread::tlab_allocation_end_offset()), RtlabWasteLimitValue);
+      __ br_notnull_short(RtlabWasteLimitValue, Assembler::pn, slow_case);
+
       // Check if tlab should be discarded (refill_waste_limit >= free)
       __ ld_ptr(G2_thread, in_bytes(JavaThread::tlab_refill_waste_limit_offset()), RtlabWasteLimitValue);
       __ sub(RendValue, RoldTopValue, RfreeValue);
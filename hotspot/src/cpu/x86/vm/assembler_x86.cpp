@@ -285,6 +285,15 @@ void Assembler::emit_operand(Register reg, Register base, Register index,
   int indexenc = index->is_valid() ? encode(index) << 3 : 0;
   int baseenc = base->is_valid() ? encode(base) : 0;
 
+  // Under EVEX a disp8 is implicitly multiplied by the operand size,
+  // so only displacements that are a multiple of it can be compressed.
+  int disp8 = disp;
+  bool use_disp8 = is8bit(disp);
+  if (_evex_disp8_scale > 1) {
+    use_disp8 = (disp % _evex_disp8_scale) == 0 && is8bit(disp / _evex_disp8_scale);
+    disp8 = disp / _evex_disp8_scale;
+  }
+
   if (base->is_valid()) {
     if (index->is_valid()) {
       assert(scale != Address::no_scale, "inconsistent address");
@@ -296,13 +305,13 @@ void Assembler::emit_operand(Register reg, Register base, Register index,
         assert(index != rsp, "illegal addressing mode");
         emit_int8(0x04 | regenc);
         emit_int8(scale << 6 | indexenc | baseenc);
-      } else if (is8bit(disp) && rtype == relocInfo::none) {
+      } else if (use_disp8 && rtype == relocInfo::none) {
         // [base + index*scale + imm8]
         // [01 reg 100][ss index base] imm8
         assert(index != rsp, "illegal addressing mode");
         emit_int8(0x44 | regenc);
         emit_int8(scale << 6 | indexenc | baseenc);
-        emit_int8(disp & 0xFF);
+        emit_int8(disp8 & 0xFF);
       } else {
         // [base + index*scale + disp32]
         // [10 reg 100][ss index base] disp32
@@ -318,12 +327,12 @@ void Assembler::emit_operand(Register reg, Register base, Register index,
         // [00 reg 100][00 100 100]
         emit_int8(0x04 | regenc);
         emit_int8(0x24);
-      } else if (is8bit(disp) && rtype == relocInfo::none) {
+      } else if (use_disp8 && rtype == relocInfo::none) {
         // [rsp + imm8]
         // [01 reg 100][00 100 100] disp8
         emit_int8(0x44 | regenc);
         emit_int8(0x24);
-        emit_int8(disp & 0xFF);
+        emit_int8(disp8 & 0xFF);
       } else {
         // [rsp + imm32]
         // [10 reg 100][00 100 100] disp32
@@ -339,11 +348,11 @@ void Assembler::emit_operand(Register reg, Register base, Register index,
         // [base]
         // [00 reg base]
         emit_int8(0x00 | regenc | baseenc);
-      } else if (is8bit(disp) && rtype == relocInfo::none) {
+      } else if (use_disp8 && rtype == relocInfo::none) {
         // [base + disp8]
         // [01 reg base] disp8
         emit_int8(0x40 | regenc | baseenc);
-        emit_int8(disp & 0xFF);
+        emit_int8(disp8 & 0xFF);
       } else {
         // [base + disp32]
         // [10 reg base] disp32
@@ -1334,6 +1343,13 @@ void Assembler::cvtdq2ps(XMMRegister dst, XMMRegister src) {
   emit_simd_arith_nonds(0x5B, dst, src, VEX_SIMD_NONE);
 }
 
+void Assembler::vcvtdq2ps(XMMRegister dst, XMMRegister src, bool vector256) {
+  assert(VM_Version::supports_avx(), "");
+  int encode = vex_prefix_and_encode(dst, xnoreg, src, VEX_SIMD_NONE, vector256);
+  emit_int8(0x5B);
+  emit_int8((unsigned char)(0xC0 | encode));
+}
+
 void Assembler::cvtsd2ss(XMMRegister dst, XMMRegister src) {
   NOT_LP64(assert(VM_Version::supports_sse2(), ""));
   emit_simd_arith(0x5A, dst, src, VEX_SIMD_F2);
@@ -1793,6 +1809,37 @@ void Assembler::vmovdqu(Address dst, XMMRegister src) {
   emit_operand(src, dst);
 }
 
+// Move Unaligned EVEX enabled Vector (programmable : 8,16,32,64)
+void Assembler::evmovdquq(XMMRegister dst, XMMRegister src, int vector_len) {
+  assert(UseAVX > 2, "");
+  int encode = evex_prefix_and_encode(dst->encoding(), 0, src->encoding(),
+                                      VEX_SIMD_F3, VEX_OPCODE_0F, true, vector_len);
+  emit_int8(0x6F);
+  emit_int8((unsigned char)(0xC0 | encode));
+}
+
+void Assembler::evmovdquq(XMMRegister dst, Address src, int vector_len) {
+  assert(UseAVX > 2, "");
+  InstructionMark im(this);
+  evex_prefix(src, 0, dst->encoding(), VEX_SIMD_F3, VEX_OPCODE_0F, true, vector_len);
+  emit_int8(0x6F);
+  _evex_disp8_scale = 16 << vector_len;
+  emit_operand(dst, src);
+  _evex_disp8_scale = 1;
+}
+
+void Assembler::evmovdquq(Address dst, XMMRegister src, int vector_len) {
+  assert(UseAVX > 2, "");
+  InstructionMark im(this);
+  // swap src<->dst for encoding
+  assert(src != xnoreg, "sanity");
+  evex_prefix(dst, 0, src->encoding(), VEX_SIMD_F3, VEX_OPCODE_0F, true, vector_len);
+  emit_int8(0x7F);
+  _evex_disp8_scale = 16 << vector_len;
+  emit_operand(src, dst);
+  _evex_disp8_scale = 1;
+}
+
 // Uses zero extension on 64bit
 
 void Assembler::movl(Register dst, int32_t imm32) {
@@ -3000,6 +3047,14 @@ void Assembler::testb(Register dst, int imm8) {
   emit_arith_b(0xF6, 0xC0, dst, imm8);
 }
 
+void Assembler::testb(Address dst, int imm8) {
+  InstructionMark im(this);
+  prefix(dst);
+  emit_int8((unsigned char)0xF6);
+  emit_operand(rax, dst, 1);
+  emit_int8(imm8);
+}
+
 void Assembler::testl(Register dst, int32_t imm32) {
   // not using emit_arith because test
   // doesn't support sign-extension of
@@ -3566,6 +3621,20 @@ void Assembler::pmulld(XMMRegister dst, XMMRegister src) {
   emit_int8((unsigned char)(0xC0 | encode));
 }
 
+void Assembler::pminsd(XMMRegister dst, XMMRegister src) {
+  assert(VM_Version::supports_sse4_1(), "");
+  int encode = simd_prefix_and_encode(dst, dst, src, VEX_SIMD_66, VEX_OPCODE_0F_38);
+  emit_int8(0x39);
+  emit_int8((unsigned char)(0xC0 | encode));
+}
+
+void Assembler::pmaxsd(XMMRegister dst, XMMRegister src) {
+  assert(VM_Version::supports_sse4_1(), "");
+  int encode = simd_prefix_and_encode(dst, dst, src, VEX_SIMD_66, VEX_OPCODE_0F_38);
+  emit_int8(0x3D);
+  emit_int8((unsigned char)(0xC0 | encode));
+}
+
 void Assembler::vpmullw(XMMRegister dst, XMMRegister nds, XMMRegister src, bool vector256) {
   assert(VM_Version::supports_avx() && !vector256 || VM_Version::supports_avx2(), "256 bit integer vectors requires AVX2");
   emit_vex_arith(0xD5, dst, nds, src, VEX_SIMD_66, vector256);
@@ -3848,6 +3917,14 @@ void Assembler::vpxor(XMMRegister dst, XMMRegister nds, XMMRegister src, bool ve
   emit_vex_arith(0xEF, dst, nds, src, VEX_SIMD_66, vector256);
 }
 
+void Assembler::evpxorq(XMMRegister dst, XMMRegister nds, XMMRegister src, int vector_len) {
+  assert(UseAVX > 2, "requires some form of AVX-512");
+  int encode = evex_prefix_and_encode(dst->encoding(), nds->encoding(), src->encoding(),
+                                      VEX_SIMD_66, VEX_OPCODE_0F, true, vector_len);
+  emit_int8((unsigned char)0xEF);
+  emit_int8((unsigned char)(0xC0 | encode));
+}
+
 void Assembler::vpxor(XMMRegister dst, XMMRegister nds, Address src, bool vector256) {
   assert(VM_Version::supports_avx() && !vector256 || VM_Version::supports_avx2(), "256 bit integer vectors requires AVX2");
   emit_vex_arith(0xEF, dst, nds, src, VEX_SIMD_66, vector256);
@@ -3892,6 +3969,17 @@ void Assembler::vextractf128h(Address dst, XMMRegister src) {
   emit_int8(0x01);
 }
 
+void Assembler::vextractf128h(XMMRegister dst, XMMRegister src) {
+  assert(VM_Version::supports_avx(), "");
+  bool vector256 = true;
+  // swap src<->dst for encoding
+  int encode = vex_prefix_and_encode(src, xnoreg, dst, VEX_SIMD_66, vector256, VEX_OPCODE_0F_3A);
+  emit_int8(0x19);
+  emit_int8((unsigned char)(0xC0 | encode));
+  // 0x01 - extract from upper 128 bits
+  emit_int8(0x01);
+}
+
 void Assembler::vinserti128h(XMMRegister dst, XMMRegister nds, XMMRegister src) {
   assert(VM_Version::supports_avx2(), "");
   bool vector256 = true;
@@ -3930,6 +4018,17 @@ void Assembler::vextracti128h(Address dst, XMMRegister src) {
   emit_int8(0x01);
 }
 
+void Assembler::vextracti128h(XMMRegister dst, XMMRegister src) {
+  assert(VM_Version::supports_avx2(), "");
+  bool vector256 = true;
+  // swap src<->dst for encoding
+  int encode = vex_prefix_and_encode(src, xnoreg, dst, VEX_SIMD_66, vector256, VEX_OPCODE_0F_3A);
+  emit_int8(0x39);
+  emit_int8((unsigned char)(0xC0 | encode));
+  // 0x01 - extract from upper 128 bits
+  emit_int8(0x01);
+}
+
 // duplicate 4-bytes integer data from src into 8 locations in dest
 void Assembler::vpbroadcastd(XMMRegister dst, XMMRegister src) {
   assert(VM_Version::supports_avx2(), "");
@@ -4516,6 +4615,45 @@ int Assembler::vex_prefix_and_encode(int dst_enc, int nds_enc, int src_enc, VexS
   return (((dst_enc & 7) << 3) | (src_enc & 7));
 }
 
+void Assembler::evex_prefix(bool vex_r, bool vex_b, bool vex_x, bool vex_w, int nds_enc, VexSimdPrefix pre, VexOpcode opc, int vector_len) {
+  assert(VM_Version::supports_evex(), "requires AVX-512");
+  assert(vector_len >= AVX_128bit && vector_len <= AVX_512bit, "bad vector length");
+  prefix(EVEX_4bytes);
+
+  // P0: R X B R' 0 0 m m, with the register extension bits inverted.
+  // Only xmm0-15 are allocated, so R' stays set.
+  int byte1 = (vex_r ? VEX_R : 0) | (vex_x ? VEX_X : 0) | (vex_b ? VEX_B : 0);
+  byte1 = (~byte1) & 0xF0;
+  byte1 |= opc;
+  emit_int8(byte1);
+
+  // P1: W vvvv 1 pp
+  int byte2 = ((~nds_enc) & 0xf) << 3;
+  byte2 |= (vex_w ? VEX_W : 0) | 0x04 | pre;
+  emit_int8(byte2);
+
+  // P2: z L'L b V' aaa, no zeroing, no broadcast, V' set, opmask k0.
+  int byte3 = ((vector_len & 0x3) << 5) | 0x08;
+  emit_int8(byte3);
+}
+
+void Assembler::evex_prefix(Address adr, int nds_enc, int xreg_enc, VexSimdPrefix pre, VexOpcode opc, bool vex_w, int vector_len) {
+  bool vex_r = (xreg_enc >= 8);
+  bool vex_b = adr.base_needs_rex();
+  bool vex_x = adr.index_needs_rex();
+  evex_prefix(vex_r, vex_b, vex_x, vex_w, nds_enc, pre, opc, vector_len);
+}
+
+int Assembler::evex_prefix_and_encode(int dst_enc, int nds_enc, int src_enc, VexSimdPrefix pre, VexOpcode opc, bool vex_w, int vector_len) {
+  bool vex_r = (dst_enc >= 8);
+  bool vex_b = (src_enc >= 8);
+  // In register-direct form EVEX.X extends the rm register beyond xmm15;
+  // leaving it clear keeps it set once inverted.
+  bool vex_x = false;
+  evex_prefix(vex_r, vex_b, vex_x, vex_w, nds_enc, pre, opc, vector_len);
+  return (((dst_enc & 7) << 3) | (src_enc & 7));
+}
+
 
 void Assembler::simd_prefix(XMMRegister xreg, XMMRegister nds, Address adr, VexSimdPrefix pre, VexOpcode opc, bool rex_w, bool vector256) {
   if (UseAVX > 0) {
@@ -502,7 +502,8 @@ class Assembler : public AbstractAssembler  {
     REX_WRXB   = 0x4F,
 
     VEX_3bytes = 0xC4,
-    VEX_2bytes = 0xC5
+    VEX_2bytes = 0xC5,
+    EVEX_4bytes = 0x62
   };
 
   enum VexPrefix {
@@ -526,6 +527,12 @@ class Assembler : public AbstractAssembler  {
     VEX_OPCODE_0F_3A = 0x3
   };
 
+  enum AvxVectorLen {
+    AVX_128bit = 0x0,
+    AVX_256bit = 0x1,
+    AVX_512bit = 0x2
+  };
+
   enum WhichOperand {
     // input to locate_operand, and format code for relocations
     imm_operand  = 0,            // embedded 32-bit|64-bit immediate operand
@@ -609,6 +616,19 @@ private:
                              VexSimdPrefix pre, VexOpcode opc,
                              bool vex_w, bool vector256);
 
+  // EVEX prefix without opmask (k0) or embedded broadcast/rounding.
+  void evex_prefix(bool vex_r, bool vex_b, bool vex_x, bool vex_w,
+                   int nds_enc, VexSimdPrefix pre, VexOpcode opc,
+                   int vector_len);
+
+  void evex_prefix(Address adr, int nds_enc, int xreg_enc,
+                   VexSimdPrefix pre, VexOpcode opc,
+                   bool vex_w, int vector_len);
+
+  int  evex_prefix_and_encode(int dst_enc, int nds_enc, int src_enc,
+                              VexSimdPrefix pre, VexOpcode opc,
+                              bool vex_w, int vector_len);
+
   int  vex_prefix_0F38_and_encode(Register dst, Register nds, Register src) {
     bool vex_w = false;
     bool vector256 = false;
@@ -821,10 +841,14 @@ private:
   // Instruction prefixes
   void prefix(Prefix p);
 
+  // EVEX instructions scale an 8-bit displacement by the size of the
+  // memory operand (disp8*N); emit_operand() honours this while it is > 1.
+  int _evex_disp8_scale;
+
   public:
 
   // Creation
-  Assembler(CodeBuffer* code) : AbstractAssembler(code) {}
+  Assembler(CodeBuffer* code) : AbstractAssembler(code), _evex_disp8_scale(1) {}
 
   // Decoding
   static address locate_operand(address inst, WhichOperand which);
@@ -1043,6 +1067,7 @@ private:
 
   // Convert Packed Signed Doubleword Integers to Packed Single-Precision Floating-Point Value
   void cvtdq2ps(XMMRegister dst, XMMRegister src);
+  void vcvtdq2ps(XMMRegister dst, XMMRegister src, bool vector256);
 
   // Convert Scalar Single-Precision Floating-Point Value to Scalar Double-Precision Floating-Point Value
   void cvtss2sd(XMMRegister dst, XMMRegister src);
@@ -1339,6 +1364,11 @@ private:
   void vmovdqu(XMMRegister dst, Address src);
   void vmovdqu(XMMRegister dst, XMMRegister src);
 
+  // Move Unaligned 128/256/512bit Vector (EVEX encoded)
+  void evmovdquq(Address dst, XMMRegister src, int vector_len);
+  void evmovdquq(XMMRegister dst, Address src, int vector_len);
+  void evmovdquq(XMMRegister dst, XMMRegister src, int vector_len);
+
   // Move lower 64bit to high 64bit in 128bit register
   void movlhps(XMMRegister dst, XMMRegister src);
 
@@ -1654,6 +1684,7 @@ private:
   void subss(XMMRegister dst, XMMRegister src);
 
   void testb(Register dst, int imm8);
+  void testb(Address dst, int imm8);
 
   void testl(Register dst, int32_t imm32);
   void testl(Register dst, Register src);
@@ -1810,6 +1841,10 @@ private:
   void vpmullw(XMMRegister dst, XMMRegister nds, Address src, bool vector256);
   void vpmulld(XMMRegister dst, XMMRegister nds, Address src, bool vector256);
 
+  // Minimum and maximum of packed signed ints
+  void pminsd(XMMRegister dst, XMMRegister src);
+  void pmaxsd(XMMRegister dst, XMMRegister src);
+
   // Shift left packed integers
   void psllw(XMMRegister dst, int shift);
   void pslld(XMMRegister dst, int shift);
@@ -1862,6 +1897,7 @@ private:
   void pxor(XMMRegister dst, XMMRegister src);
   void vpxor(XMMRegister dst, XMMRegister nds, XMMRegister src, bool vector256);
   void vpxor(XMMRegister dst, XMMRegister nds, Address src, bool vector256);
+  void evpxorq(XMMRegister dst, XMMRegister nds, XMMRegister src, int vector_len);
 
   // Copy low 128bit into high 128bit of YMM registers.
   void vinsertf128h(XMMRegister dst, XMMRegister nds, XMMRegister src);
@@ -1873,6 +1909,10 @@ private:
   void vextractf128h(Address dst, XMMRegister src);
   void vextracti128h(Address dst, XMMRegister src);
 
+  // Copy high 128bit of YMM registers into low 128bit of XMM registers.
+  void vextractf128h(XMMRegister dst, XMMRegister src);
+  void vextracti128h(XMMRegister dst, XMMRegister src);
+
   // duplicate 4-bytes integer data from src into 8 locations in dest
   void vpbroadcastd(XMMRegister dst, XMMRegister src);
 
@@ -37,6 +37,7 @@
 #include "memory/cardTableModRefBS.hpp"
 #include "nativeInst_x86.hpp"
 #include "oops/objArrayKlass.hpp"
+#include "runtime/safepointMechanism.hpp"
 #include "runtime/sharedRuntime.hpp"
 #include "vmreg_x86.inline.hpp"
 
@@ -608,6 +609,15 @@ void LIR_Assembler::return_op(LIR_Opr result) {
 
   // Note: we do not need to round double result; float result has the right precision
   // the poll sets the condition code, but no data registers
+#ifdef _LP64
+  if (SafepointMechanism::uses_thread_local_poll()) {
+    __ movptr(rscratch1, Address(r15_thread, Thread::polling_page_offset()));
+    __ relocate(relocInfo::poll_return_type);
+    __ testl(rax, Address(rscratch1, 0));
+    __ ret(0);
+    return;
+  }
+#endif
   AddressLiteral polling_page(os::get_polling_page() + (SafepointPollOffset % os::vm_page_size()),
                               relocInfo::poll_return_type);
 
@@ -623,9 +633,19 @@ void LIR_Assembler::return_op(LIR_Opr result) {
 
 
 int LIR_Assembler::safepoint_poll(LIR_Opr tmp, CodeEmitInfo* info) {
+  guarantee(info != NULL, "Shouldn't be NULL");
+#ifdef _LP64
+  if (SafepointMechanism::uses_thread_local_poll()) {
+    __ movptr(rscratch1, Address(r15_thread, Thread::polling_page_offset()));
+    add_debug_info_for_branch(info);
+    __ relocate(relocInfo::poll_type);
+    int offset = __ offset();
+    __ testl(rax, Address(rscratch1, 0));
+    return offset;
+  }
+#endif
   AddressLiteral polling_page(os::get_polling_page() + (SafepointPollOffset % os::vm_page_size()),
                               relocInfo::poll_type);
-  guarantee(info != NULL, "Shouldn't be NULL");
   int offset = __ offset();
   if (Assembler::is_polling_page_far()) {
     __ lea(rscratch1, polling_page);
@@ -1682,14 +1702,15 @@ void LIR_Assembler::emit_alloc_array(LIR_OpAllocArray* op) {
 
 void LIR_Assembler::type_profile_helper(Register mdo,
                                         ciMethodData *md, ciProfileData *data,
-                                        Register recv, Label* update_done) {
+                                        Register recv, Label* update_done,
+                                        int increment) {
   for (uint i = 0; i < ReceiverTypeData::row_limit(); i++) {
     Label next_test;
     // See if the receiver is receiver[n].
     __ cmpptr(recv, Address(mdo, md->byte_offset_of_slot(data, ReceiverTypeData::receiver_offset(i))));
     __ jccb(Assembler::notEqual, next_test);
     Address data_addr(mdo, md->byte_offset_of_slot(data, ReceiverTypeData::receiver_count_offset(i)));
-    __ addptr(data_addr, DataLayout::counter_increment);
+    __ addptr(data_addr, increment);
     __ jmp(*update_done);
     __ bind(next_test);
   }
@@ -1701,7 +1722,7 @@ void LIR_Assembler::type_profile_helper(Register mdo,
     __ cmpptr(recv_addr, (intptr_t)NULL_WORD);
     __ jccb(Assembler::notEqual, next_test);
     __ movptr(recv_addr, recv);
-    __ movptr(Address(mdo, md->byte_offset_of_slot(data, ReceiverTypeData::receiver_count_offset(i))), DataLayout::counter_increment);
+    __ movptr(Address(mdo, md->byte_offset_of_slot(data, ReceiverTypeData::receiver_count_offset(i))), increment);
     __ jmp(*update_done);
     __ bind(next_test);
   }
@@ -1853,7 +1874,7 @@ void LIR_Assembler::emit_typecheck_helper(LIR_OpTypeCheck *op, Label* success, L
     __ mov_metadata(mdo, md->constant_encoding());
     __ load_klass(recv, obj);
     Label update_done;
-    type_profile_helper(mdo, md, data, recv, success);
+    type_profile_helper(mdo, md, data, recv, success, DataLayout::counter_increment);
     __ jmp(*success);
 
     __ bind(profile_cast_failure);
@@ -1936,7 +1957,7 @@ void LIR_Assembler::emit_opTypeCheck(LIR_OpTypeCheck* op) {
       __ mov_metadata(mdo, md->constant_encoding());
       __ load_klass(recv, value);
       Label update_done;
-      type_profile_helper(mdo, md, data, recv, &done);
+      type_profile_helper(mdo, md, data, recv, &done, DataLayout::counter_increment);
       __ jmpb(done);
 
       __ bind(profile_cast_failure);
@@ -3607,6 +3628,34 @@ void LIR_Assembler::emit_profile_call(LIR_OpProfileCall* op) {
   assert(data->is_CounterData(), "need CounterData for calls");
   assert(op->mdo()->is_single_cpu(),  "mdo must be allocated");
   Register mdo  = op->mdo()->as_register();
+
+  // With C1ProfileCallSampleLog, advance the thread's xorshift state and
+  // record only one in 2^n calls, with the counts scaled to match. This
+  // keeps most calls from writing to the shared MDO.
+  int sample_log = profile_call_sample_log();
+  int increment = DataLayout::counter_increment << sample_log;
+  Label skip_profile;
+#ifdef _LP64
+  if (sample_log > 0) {
+    Register seed = op->tmp1()->as_pointer_register();
+    Address seed_addr(r15_thread, Thread::profile_sample_seed_offset());
+    assert_different_registers(seed, mdo);
+    __ movl(seed, seed_addr);
+    __ movl(mdo, seed);
+    __ shll(mdo, 13);
+    __ xorl(seed, mdo);
+    __ movl(mdo, seed);
+    __ shrl(mdo, 17);
+    __ xorl(seed, mdo);
+    __ movl(mdo, seed);
+    __ shll(mdo, 5);
+    __ xorl(seed, mdo);
+    __ movl(seed_addr, seed);
+    __ testl(seed, (1 << sample_log) - 1);
+    __ jcc(Assembler::notZero, skip_profile);
+  }
+#endif
+
   __ mov_metadata(mdo, md->constant_encoding());
   Address counter_addr(mdo, md->byte_offset_of_slot(data, CounterData::count_offset()));
   Bytecodes::Code bc = method->java_code_at_bci(bci);
@@ -3634,7 +3683,8 @@ void LIR_Assembler::emit_profile_call(LIR_OpProfileCall* op) {
         ciKlass* receiver = vc_data->receiver(i);
         if (known_klass->equals(receiver)) {
           Address data_addr(mdo, md->byte_offset_of_slot(data, VirtualCallData::receiver_count_offset(i)));
-          __ addptr(data_addr, DataLayout::counter_increment);
+          __ addptr(data_addr, increment);
+          __ bind(skip_profile);
           return;
         }
       }
@@ -3650,24 +3700,26 @@ void LIR_Assembler::emit_profile_call(LIR_OpProfileCall* op) {
           Address recv_addr(mdo, md->byte_offset_of_slot(data, VirtualCallData::receiver_offset(i)));
           __ mov_metadata(recv_addr, known_klass->constant_encoding());
           Address data_addr(mdo, md->byte_offset_of_slot(data, VirtualCallData::receiver_count_offset(i)));
-          __ addptr(data_addr, DataLayout::counter_increment);
+          __ addptr(data_addr, increment);
+          __ bind(skip_profile);
           return;
         }
       }
     } else {
       __ load_klass(recv, recv);
       Label update_done;
-      type_profile_helper(mdo, md, data, recv, &update_done);
+      type_profile_helper(mdo, md, data, recv, &update_done, increment);
       // Receiver did not match any saved receiver and there is no empty row for it.
       // Increment total counter to indicate polymorphic case.
-      __ addptr(counter_addr, DataLayout::counter_increment);
+      __ addptr(counter_addr, increment);
 
       __ bind(update_done);
     }
   } else {
     // Static call
-    __ addptr(counter_addr, DataLayout::counter_increment);
+    __ addptr(counter_addr, increment);
   }
+  __ bind(skip_profile);
 }
 
 void LIR_Assembler::emit_profile_type(LIR_OpProfileType* op) {
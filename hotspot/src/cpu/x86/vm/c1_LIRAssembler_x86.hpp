@@ -46,7 +46,8 @@
   // Record the type of the receiver in ReceiverTypeData
   void type_profile_helper(Register mdo,
                            ciMethodData *md, ciProfileData *data,
-                           Register recv, Label* update_done);
+                           Register recv, Label* update_done,
+                           int increment);
 public:
 
   void store_parameter(Register r, int offset_from_esp_in_words);
@@ -66,7 +66,25 @@ static void pd_fill_to_bytes(void* to, size_t count, jubyte value) {
   (void)memset(to, value, count);
 }
 
+#if defined(AMD64) && defined(TARGET_COMPILER_gcc)
+// Stores that bypass the caches, so that clearing a large block does not
+// evict the working set. They are weakly ordered, hence the sfence.
+static void pd_zero_to_words_nontemporal(HeapWord* tohw, size_t count) {
+  long long* to = (long long*) tohw;
+  while (count-- > 0) {
+    __builtin_ia32_movnti64(to++, 0);
+  }
+  __builtin_ia32_sfence();
+}
+#endif // AMD64 && TARGET_COMPILER_gcc
+
 static void pd_zero_to_words(HeapWord* tohw, size_t count) {
+#if defined(AMD64) && defined(TARGET_COMPILER_gcc)
+  if (NonTemporalZeroingThreshold != 0 && count >= NonTemporalZeroingThreshold / HeapWordSize) {
+    pd_zero_to_words_nontemporal(tohw, count);
+    return;
+  }
+#endif // AMD64 && TARGET_COMPILER_gcc
   pd_fill_to_words(tohw, count, 0);
 }
 
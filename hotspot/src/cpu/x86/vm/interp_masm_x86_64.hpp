@@ -39,7 +39,7 @@
   virtual void check_and_handle_earlyret(Register java_thread);
 
   // base routine for all dispatches
-  void dispatch_base(TosState state, address* table, bool verifyoop = true);
+  void dispatch_base(TosState state, address* table, bool verifyoop = true, bool generate_poll = false);
 #endif // CC_INTERP
 
  public:
@@ -141,7 +141,7 @@
   void dispatch_prolog(TosState state, int step = 0);
   void dispatch_epilog(TosState state, int step = 0);
   // dispatch via ebx (assume ebx is loaded already)
-  void dispatch_only(TosState state);
+  void dispatch_only(TosState state, bool generate_poll = false);
   // dispatch normal table via ebx (assume ebx is loaded already)
   void dispatch_only_normal(TosState state);
   void dispatch_only_noverify(TosState state);
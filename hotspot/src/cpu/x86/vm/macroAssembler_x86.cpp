@@ -36,6 +36,8 @@
 #include "runtime/interfaceSupport.hpp"
 #include "runtime/objectMonitor.hpp"
 #include "runtime/os.hpp"
+#include "runtime/safepoint.hpp"
+#include "runtime/safepointMechanism.hpp"
 #include "runtime/sharedRuntime.hpp"
 #include "runtime/stubRoutines.hpp"
 #include "utilities/macros.hpp"
@@ -3822,6 +3824,18 @@ void MacroAssembler::push_IU_state() {
   pusha();
 }
 
+void MacroAssembler::safepoint_poll(Label& slow_path, Register thread_reg) {
+  cmp32(ExternalAddress(SafepointSynchronize::address_of_state()),
+        SafepointSynchronize::_not_synchronized);
+  jcc(Assembler::notEqual, slow_path);
+#ifdef _LP64
+  if (SafepointMechanism::uses_thread_local_poll()) {
+    testb(Address(thread_reg, Thread::polling_page_offset()), SafepointMechanism::poll_bit());
+    jcc(Assembler::notZero, slow_path); // handshake bit set implies poll
+  }
+#endif
+}
+
 void MacroAssembler::reset_last_Java_frame(Register java_thread, bool clear_fp) {
   // determine java_thread register
   if (!java_thread->is_valid()) {
@@ -294,6 +294,10 @@ class MacroAssembler: public Assembler {
   // thread in the default location (r15_thread on 64bit)
   void reset_last_Java_frame(bool clear_fp);
 
+  // Jumps to slow_path if a safepoint is in progress or, with
+  // ThreadLocalHandshakes, if the thread's polling word is armed.
+  void safepoint_poll(Label& slow_path, Register thread_reg);
+
   // Stores
   void store_check(Register obj);                // store check for obj - register is destroyed afterwards
   void store_check(Register obj, Address dst);   // same as above, dst is exact store location (reg. is destroyed)
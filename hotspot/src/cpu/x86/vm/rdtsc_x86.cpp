@@ -118,7 +118,10 @@ static jlong initialize_frequency() {
     // for invariant tsc platforms, take the maximum qualified cpu frequency
     tsc_freq = (double)VM_Version_Ext::maximum_qualified_cpu_frequency();
     os_to_tsc_conv_factor = tsc_freq / os_freq;
-  } else {
+  }
+  if (tsc_freq == .0) {
+    // not invariant, or the brand string does not tell the frequency
+    // of the invariant tsc as on most AMD parts:
     // use measurements to estimate
     // a conversion factor and the tsc frequency
 
@@ -157,8 +160,27 @@ static bool initialize_elapsed_counter() {
   return tsc_frequency != 0 && _epoch != 0;
 }
 
+// The kernel verifies at boot, and keeps watching, that the tsc is
+// synchronized across cpus. When it is not, the kernel falls back on
+// one of the slow platform timers as its clocksource. Guests commonly
+// use a paravirtualized clocksource, which says nothing about the tsc.
+static bool is_tsc_unsynchronized() {
+#ifdef TARGET_OS_FAMILY_linux
+  FILE* f = fopen("/sys/devices/system/clocksource/clocksource0/current_clocksource", "r");
+  if (f == NULL) {
+    return false;
+  }
+  char clocksource[32] = "";
+  const bool found = fgets(clocksource, sizeof(clocksource), f) != NULL;
+  fclose(f);
+  return found && (strncmp(clocksource, "hpet", 4) == 0 || strncmp(clocksource, "acpi_pm", 7) == 0);
+#else
+  return false;
+#endif
+}
+
 static bool ergonomics() {
-  const bool invtsc_support = Rdtsc::is_supported();
+  const bool invtsc_support = Rdtsc::is_supported() && !is_tsc_unsynchronized();
   if (FLAG_IS_DEFAULT(UseFastUnorderedTimeStamps) && invtsc_support) {
     FLAG_SET_ERGO(bool, UseFastUnorderedTimeStamps, true);
   }
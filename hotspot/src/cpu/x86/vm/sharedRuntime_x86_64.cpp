@@ -1796,6 +1796,10 @@ nmethod* SharedRuntime::generate_native_wrapper(MacroAssembler* masm,
 
   const int total_in_args = method->size_of_parameters();
   int total_c_args = total_in_args;
+  // A critical native without array arguments is a leaf: it pins nothing,
+  // so it needs neither the GC_locker check on entry nor the lazy
+  // critical region at safepoints.
+  bool is_leaf_critical_native = is_critical_native;
   if (!is_critical_native) {
     total_c_args += 1;
     if (method->is_static()) {
@@ -1805,6 +1809,7 @@ nmethod* SharedRuntime::generate_native_wrapper(MacroAssembler* masm,
     for (int i = 0; i < total_in_args; i++) {
       if (in_sig_bt[i] == T_ARRAY) {
         total_c_args++;
+        is_leaf_critical_native = false;
       }
     }
   }
@@ -2040,7 +2045,7 @@ nmethod* SharedRuntime::generate_native_wrapper(MacroAssembler* masm,
 
   const Register oop_handle_reg = r14;
 
-  if (is_critical_native) {
+  if (is_critical_native && !is_leaf_critical_native) {
     check_needs_gc_for_critical_native(masm, stack_slots, total_c_args, total_in_args,
                                        oop_handle_offset, oop_maps, in_regs, in_sig_bt);
   }
@@ -2389,12 +2394,9 @@ nmethod* SharedRuntime::generate_native_wrapper(MacroAssembler* masm,
   // check for safepoint operation in progress and/or pending suspend requests
   {
     Label Continue;
-
-    __ cmp32(ExternalAddress((address)SafepointSynchronize::address_of_state()),
-             SafepointSynchronize::_not_synchronized);
-
     Label L;
-    __ jcc(Assembler::notEqual, L);
+
+    __ safepoint_poll(L, r15_thread);
     __ cmpl(Address(r15_thread, JavaThread::suspend_flags_offset()), 0);
     __ jcc(Assembler::equal, Continue);
     __ bind(L);
@@ -2642,7 +2644,7 @@ nmethod* SharedRuntime::generate_native_wrapper(MacroAssembler* masm,
                                             in_ByteSize(lock_slot_offset*VMRegImpl::stack_slot_size),
                                             oop_maps);
 
-  if (is_critical_native) {
+  if (is_critical_native && !is_leaf_critical_native) {
     nm->set_lazy_critical_native(true);
   }
 
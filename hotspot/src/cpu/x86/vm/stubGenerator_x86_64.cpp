@@ -1294,7 +1294,10 @@ class StubGenerator: public StubCodeGenerator {
       Label L_end;
       // Copy 64-bytes per iteration
       __ BIND(L_loop);
-      if (UseAVX >= 2) {
+      if (UseAVX > 2) {
+        __ evmovdquq(xmm0, Address(end_from, qword_count, Address::times_8, -56), Assembler::AVX_512bit);
+        __ evmovdquq(Address(end_to, qword_count, Address::times_8, -56), xmm0, Assembler::AVX_512bit);
+      } else if (UseAVX == 2) {
         __ vmovdqu(xmm0, Address(end_from, qword_count, Address::times_8, -56));
         __ vmovdqu(Address(end_to, qword_count, Address::times_8, -56), xmm0);
         __ vmovdqu(xmm1, Address(end_from, qword_count, Address::times_8, -24));
@@ -1327,7 +1330,7 @@ class StubGenerator: public StubCodeGenerator {
       __ addptr(qword_count, 4);
       __ BIND(L_end);
       if (UseAVX >= 2) {
-        // clean upper bits of YMM registers
+        // clean upper bits of YMM/ZMM registers
         __ vpxor(xmm0, xmm0);
         __ vpxor(xmm1, xmm1);
       }
@@ -1371,7 +1374,10 @@ class StubGenerator: public StubCodeGenerator {
       Label L_end;
       // Copy 64-bytes per iteration
       __ BIND(L_loop);
-      if (UseAVX >= 2) {
+      if (UseAVX > 2) {
+        __ evmovdquq(xmm0, Address(from, qword_count, Address::times_8, 0), Assembler::AVX_512bit);
+        __ evmovdquq(Address(dest, qword_count, Address::times_8, 0), xmm0, Assembler::AVX_512bit);
+      } else if (UseAVX == 2) {
         __ vmovdqu(xmm0, Address(from, qword_count, Address::times_8, 32));
         __ vmovdqu(Address(dest, qword_count, Address::times_8, 32), xmm0);
         __ vmovdqu(xmm1, Address(from, qword_count, Address::times_8,  0));
@@ -1405,7 +1411,7 @@ class StubGenerator: public StubCodeGenerator {
       __ subptr(qword_count, 4);
       __ BIND(L_end);
       if (UseAVX >= 2) {
-        // clean upper bits of YMM registers
+        // clean upper bits of YMM/ZMM registers
         __ vpxor(xmm0, xmm0);
         __ vpxor(xmm1, xmm1);
       }
@@ -4351,6 +4357,115 @@ class StubGenerator: public StubCodeGenerator {
     return start;
   }
 
+  /**
+   *  Arguments:
+   *
+   *  Input:
+   *    c_rarg0   - a address
+   *    c_rarg1   - b address
+   *    c_rarg2   - length in elements
+   *    c_rarg3   - log2 of the element size
+   *
+   *  Output:
+   *    rax       - index of the first mismatching element, or -1
+   */
+  address generate_vectorizedMismatch() {
+    __ align(CodeEntryAlignment);
+    StubCodeMark mark(this, "StubRoutines", "vectorizedMismatch");
+
+    address start = __ pc();
+    // Win64: rcx, rdx, r8, r9 (c_rarg0, c_rarg1, ...)
+    // Unix:  rdi, rsi, rdx, rcx (c_rarg0, c_rarg1, ...)
+    const Register obja  = r10;
+    const Register objb  = r11;
+    const Register limit = rax;   // length in bytes
+    const Register scale = rcx;   // shift count must be in cl
+    const Register index = r8;    // byte offset of the current chunk
+    const Register tmp1  = r9;
+    const Register tmp2  = rdx;
+
+    Label L_loop_vector, L_loop_8, L_found_8, L_loop_byte, L_found, L_no_mismatch, L_exit;
+
+    BLOCK_COMMENT("Entry:");
+    __ enter(); // required for proper stackwalking of RuntimeStub frame
+
+    // Save the arguments before any of their registers is reused.
+    __ movptr(obja, c_rarg0);
+    __ movptr(objb, c_rarg1);
+    __ movslq(limit, c_rarg2);
+    __ movl(scale, c_rarg3);
+    __ shlq(limit);               // elements -> bytes
+    __ xorl(index, index);
+
+    // Compare 32 (AVX2) or 16 (SSE4.1) bytes at a time. A differing chunk
+    // is rescanned by the 8-byte loop below, which finds the exact byte.
+    if (UseAVX >= 2 || UseSSE >= 4) {
+      const int chunk = (UseAVX >= 2) ? 32 : 16;
+      __ bind(L_loop_vector);
+      __ leaq(tmp1, Address(index, chunk));
+      __ cmpq(tmp1, limit);
+      __ jcc(Assembler::greater, L_loop_8);
+      if (UseAVX >= 2) {
+        __ vmovdqu(xmm0, Address(obja, index, Address::times_1));
+        __ vmovdqu(xmm1, Address(objb, index, Address::times_1));
+        __ vpxor(xmm0, xmm0, xmm1, true /* vector256 */);
+        __ vptest(xmm0, xmm0);
+      } else {
+        __ movdqu(xmm0, Address(obja, index, Address::times_1));
+        __ movdqu(xmm1, Address(objb, index, Address::times_1));
+        __ pxor(xmm0, xmm1);
+        __ ptest(xmm0, xmm0);
+      }
+      __ jcc(Assembler::notZero, L_loop_8);
+      __ movq(index, tmp1);
+      __ jmp(L_loop_vector);
+    }
+
+    __ bind(L_loop_8);
+    __ leaq(tmp1, Address(index, 8));
+    __ cmpq(tmp1, limit);
+    __ jccb(Assembler::greater, L_loop_byte);
+    __ movq(tmp1, Address(obja, index, Address::times_1));
+    __ xorq(tmp1, Address(objb, index, Address::times_1));
+    __ jccb(Assembler::notZero, L_found_8);
+    __ addq(index, 8);
+    __ jmpb(L_loop_8);
+
+    __ bind(L_found_8);
+    // Lowest set bit of the difference is in the first differing byte.
+    __ bsfq(tmp1, tmp1);
+    __ shrq(tmp1, LogBitsPerByte);
+    __ addq(index, tmp1);
+    __ jmpb(L_found);
+
+    __ bind(L_loop_byte);
+    __ cmpq(index, limit);
+    __ jccb(Assembler::greaterEqual, L_no_mismatch);
+    __ movzbl(tmp1, Address(obja, index, Address::times_1));
+    __ movzbl(tmp2, Address(objb, index, Address::times_1));
+    __ cmpl(tmp1, tmp2);
+    __ jccb(Assembler::notEqual, L_found);
+    __ incrementq(index);
+    __ jmpb(L_loop_byte);
+
+    __ bind(L_found);
+    __ movq(rax, index);
+    __ shrq(rax);                 // bytes -> elements
+    __ jmpb(L_exit);
+
+    __ bind(L_no_mismatch);
+    __ movl(rax, -1);
+
+    __ bind(L_exit);
+    if (UseAVX >= 2) {
+      __ vzeroupper();
+    }
+    __ leave(); // required for proper stackwalking of RuntimeStub frame
+    __ ret(0);
+
+    return start;
+  }
+
 
 #undef __
 #define __ masm->
@@ -4617,6 +4732,9 @@ class StubGenerator: public StubCodeGenerator {
     if (UseMulAddIntrinsic) {
       StubRoutines::_mulAdd = generate_mulAdd();
     }
+    if (UseVectorizedMismatchIntrinsic) {
+      StubRoutines::_vectorizedMismatch = generate_vectorizedMismatch();
+    }
 
 #ifndef _WINDOWS
     if (UseMontgomeryMultiplyIntrinsic) {
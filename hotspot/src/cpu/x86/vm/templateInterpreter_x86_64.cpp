@@ -317,6 +317,19 @@ void InterpreterGenerator::generate_counter_incr(
                   MethodCounters::invocation_counter_offset() +
                   InvocationCounter::counter_offset());
     __ get_method_counters(rbx, rax, done);
+    if (UseStripedInvocationCounters) {
+      // Once the method has stripes, count in this thread's one
+      Label no_stripes;
+      __ movptr(rcx, Address(rax, MethodCounters::invocation_stripes_offset()));
+      __ testptr(rcx, rcx);
+      __ jccb(Assembler::zero, no_stripes);
+      __ movptr(rax, Address(r15_thread, Thread::invocation_counter_stripe_offset()));
+      __ addptr(rax, rcx);
+      __ increment_mask_and_jump(Address(rax, 0), increment, mask, rcx,
+                                 false, Assembler::zero, overflow);
+      __ jmp(done);
+      __ bind(no_stripes);
+    }
     __ increment_mask_and_jump(invocation_counter, increment, mask, rcx,
                                false, Assembler::zero, overflow);
     __ bind(done);
@@ -1232,11 +1245,8 @@ address InterpreterGenerator::generate_native_entry(bool synchronized) {
   // check for safepoint operation in progress and/or pending suspend requests
   {
     Label Continue;
-    __ cmp32(ExternalAddress(SafepointSynchronize::address_of_state()),
-             SafepointSynchronize::_not_synchronized);
-
     Label L;
-    __ jcc(Assembler::notEqual, L);
+    __ safepoint_poll(L, r15_thread);
     __ cmpl(Address(r15_thread, JavaThread::suspend_flags_offset()), 0);
     __ jcc(Assembler::equal, Continue);
     __ bind(L);
@@ -3336,6 +3336,13 @@ void TemplateTable::_new() {
   if (allow_shared_alloc) {
     __ bind(allocate_shared);
 
+    if (UseTLAB) {
+      // If the heap sampler moved the end of the tlab, the allocation
+      // reached the sample point: the runtime takes the sample.
+      __ cmpptr(Address(thread, in_bytes(JavaThread::tlab_allocation_end_offset())), (int32_t)NULL_WORD);
+      __ jcc(Assembler::notEqual, slow_case);
+    }
+
     ExternalAddress heap_top((address)Universe::heap()->top_addr());
 
     Label retry;
@@ -32,6 +32,7 @@
 #include "oops/objArrayKlass.hpp"
 #include "oops/oop.inline.hpp"
 #include "prims/methodHandles.hpp"
+#include "runtime/safepointMechanism.hpp"
 #include "runtime/sharedRuntime.hpp"
 #include "runtime/stubRoutines.hpp"
 #include "runtime/synchronizer.hpp"
@@ -1397,6 +1398,19 @@ void TemplateTable::iinc() {
   __ addl(iaddress(rbx), rdx);
 }
 
+// iinc followed by goto: do the increment, then enter the goto template
+// directly instead of dispatching on the next bytecode.
+void TemplateTable::fast_iinc_goto() {
+  transition(vtos, vtos);
+  address goto_entry = Interpreter::normal_table(vtos)[Bytecodes::_goto];
+  assert(goto_entry != NULL, "goto must be generated before fast_iinc_goto");
+  __ load_signed_byte(rdx, at_bcp(2)); // get constant
+  locals_index(rbx);
+  __ addl(iaddress(rbx), rdx);
+  __ addptr(r13, Bytecodes::length_for(Bytecodes::_iinc));
+  __ jump(ExternalAddress(goto_entry));
+}
+
 void TemplateTable::wide_iinc() {
   transition(vtos, vtos);
   __ movl(rdx, at_bcp(4)); // get constant
@@ -1737,7 +1751,7 @@ void TemplateTable::branch(bool is_jsr, bool is_wide) {
   // eax: return bci for jsr's, unused otherwise
   // ebx: target bytecode
   // r13: target bcp
-  __ dispatch_only(vtos);
+  __ dispatch_only(vtos, true);
 
   if (UseLoopCounter) {
     if (ProfileInterpreter) {
@@ -2086,6 +2100,17 @@ void TemplateTable::_return(TosState state) {
     __ bind(skip_register_finalizer);
   }
 
+  if (SafepointMechanism::uses_thread_local_poll() && _desc->bytecode() != Bytecodes::_return_register_finalizer) {
+    Label no_safepoint;
+    NOT_PRODUCT(__ block_comment("Thread-local Safepoint poll"));
+    __ testb(Address(r15_thread, Thread::polling_page_offset()), SafepointMechanism::poll_bit());
+    __ jcc(Assembler::zero, no_safepoint);
+    __ push(state);
+    __ call_VM(noreg, CAST_FROM_FN_PTR(address, InterpreterRuntime::at_safepoint));
+    __ pop(state);
+    __ bind(no_safepoint);
+  }
+
   // Narrow result if state is itos but result type is smaller.
   // Need to narrow in the return bytecode rather than in generate_return_entry
   // since compiled code callers expect the result to already be narrowed.
@@ -3388,6 +3413,13 @@ void TemplateTable::_new() {
   if (allow_shared_alloc) {
     __ bind(allocate_shared);
 
+    if (UseTLAB) {
+      // If the heap sampler moved the end of the tlab, the allocation
+      // reached the sample point: the runtime takes the sample.
+      __ cmpptr(Address(r15_thread, in_bytes(JavaThread::tlab_allocation_end_offset())), (int32_t)NULL_WORD);
+      __ jcc(Assembler::notEqual, slow_case);
+    }
+
     ExternalAddress top((address)Universe::heap()->top_addr());
     ExternalAddress end((address)Universe::heap()->end_addr());
 
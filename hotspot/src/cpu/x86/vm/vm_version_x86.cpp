@@ -481,6 +481,10 @@ void VM_Version::get_processor_features() {
   if (UseSSE < 1)
     _cpuFeatures &= ~CPU_SSE;
 
+  if (UseAVX < 3)
+    _cpuFeatures &= ~(CPU_AVX512F | CPU_AVX512DQ | CPU_AVX512CD |
+                      CPU_AVX512BW | CPU_AVX512VL);
+
   if (UseAVX < 2)
     _cpuFeatures &= ~CPU_AVX2;
 
@@ -495,8 +499,8 @@ void VM_Version::get_processor_features() {
     _cpuFeatures &= ~CPU_HT;
   }
 
-  char buf[256];
-  jio_snprintf(buf, sizeof(buf), "(%u cores per cpu, %u threads per core) family %d model %d stepping %d%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s",
+  char buf[512];
+  jio_snprintf(buf, sizeof(buf), "(%u cores per cpu, %u threads per core) family %d model %d stepping %d%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s",
                cores_per_cpu(), threads_per_core(),
                cpu_family(), _model, _stepping,
                (supports_cmov() ? ", cmov" : ""),
@@ -512,6 +516,11 @@ void VM_Version::get_processor_features() {
                (supports_popcnt() ? ", popcnt" : ""),
                (supports_avx()    ? ", avx" : ""),
                (supports_avx2()   ? ", avx2" : ""),
+               (supports_evex()   ? ", avx512f" : ""),
+               (supports_avx512dq() ? ", avx512dq" : ""),
+               (supports_avx512cd() ? ", avx512cd" : ""),
+               (supports_avx512bw() ? ", avx512bw" : ""),
+               (supports_avx512vl() ? ", avx512vl" : ""),
                (supports_aes()    ? ", aes" : ""),
                (supports_clmul()  ? ", clmul" : ""),
                (supports_erms()   ? ", erms" : ""),
@@ -543,8 +552,21 @@ void VM_Version::get_processor_features() {
   if (!supports_sse ()) // Drop to 0 if no SSE  support
     UseSSE = 0;
 
-  if (UseAVX > 2) UseAVX=2;
+  if (UseAVX > 3) UseAVX=3;
   if (UseAVX < 0) UseAVX=0;
+  if (!supports_evex()) // Drop to 2 if no AVX-512 support
+    UseAVX = MIN2((intx)2,UseAVX);
+  if (FLAG_IS_DEFAULT(UseAVX) && UseAVX > 2 &&
+      is_intel_family_core() && extended_cpu_model() == CPU_MODEL_SKYLAKE_SP) {
+    // Heavy 512-bit instructions lower the core frequency on these
+    // parts for much longer than the work they save, so use them only
+    // when asked for explicitly.
+    UseAVX = 2;
+  }
+  if (UseAVX < 3) {
+    _cpuFeatures &= ~(CPU_AVX512F | CPU_AVX512DQ | CPU_AVX512CD |
+                      CPU_AVX512BW | CPU_AVX512VL);
+  }
   if (!supports_avx2()) // Drop to 1 if no AVX2 support
     UseAVX = MIN2((intx)1,UseAVX);
   if (!supports_avx ()) // Drop to 0 if no AVX  support
@@ -767,6 +789,9 @@ void VM_Version::get_processor_features() {
   if (FLAG_IS_DEFAULT(UseMontgomerySquareIntrinsic)) {
     UseMontgomerySquareIntrinsic = true;
   }
+  if (FLAG_IS_DEFAULT(UseVectorizedMismatchIntrinsic)) {
+    UseVectorizedMismatchIntrinsic = true;
+  }
 #else
   if (UseMultiplyToLenIntrinsic) {
     if (!FLAG_IS_DEFAULT(UseMultiplyToLenIntrinsic)) {
@@ -798,6 +823,12 @@ void VM_Version::get_processor_features() {
     }
     FLAG_SET_DEFAULT(UseMontgomerySquareIntrinsic, false);
   }
+  if (UseVectorizedMismatchIntrinsic) {
+    if (!FLAG_IS_DEFAULT(UseVectorizedMismatchIntrinsic)) {
+      warning("vectorizedMismatch intrinsic is not available in 32-bit VM");
+    }
+    FLAG_SET_DEFAULT(UseVectorizedMismatchIntrinsic, false);
+  }
 #endif
 #endif // COMPILER2
 
@@ -209,9 +209,16 @@ public:
                    erms : 1,
                         : 1,
                    rtm  : 1,
-                        : 7,
+                        : 4,
+                avx512f : 1,
+               avx512dq : 1,
+                        : 1,
                    adx  : 1,
-                        : 12;
+                        : 8,
+               avx512cd : 1,
+                        : 1,
+               avx512bw : 1,
+               avx512vl : 1;
     } bits;
   };
 
@@ -221,7 +228,11 @@ public:
       uint32_t x87 : 1,
                sse : 1,
                ymm : 1,
-                   : 29;
+                   : 2,
+            opmask : 1,
+            zmm512 : 1,
+             zmm32 : 1,
+                   : 24;
     } bits;
   };
 
@@ -263,7 +274,12 @@ protected:
     CPU_BMI1   = (1 << 22),
     CPU_BMI2   = (1 << 23),
     CPU_RTM    = (1 << 24),  // Restricted Transactional Memory instructions
-    CPU_ADX    = (1 << 25)
+    CPU_ADX    = (1 << 25),
+    CPU_AVX512F  = (1 << 26), // AVX-512 foundation, EVEX encoded
+    CPU_AVX512DQ = (1 << 27),
+    CPU_AVX512CD = (1 << 28),
+    CPU_AVX512BW = (1 << 29),
+    CPU_AVX512VL = (1 << 30)
   } cpuFeatureFlags;
 
   enum {
@@ -282,7 +298,8 @@ protected:
     CPU_MODEL_IVYBRIDGE_EP   = 0x3a,
     CPU_MODEL_HASWELL_E3     = 0x3c,
     CPU_MODEL_HASWELL_E7     = 0x3f,
-    CPU_MODEL_BROADWELL      = 0x3d
+    CPU_MODEL_BROADWELL      = 0x3d,
+    CPU_MODEL_SKYLAKE_SP     = 0x55  // also Cascade Lake
   } cpuExtendedFamily;
 
   // cpuid information block.  All info derived from executing cpuid with
@@ -440,6 +457,21 @@ protected:
       result |= CPU_AVX;
       if (_cpuid_info.sef_cpuid7_ebx.bits.avx2 != 0)
         result |= CPU_AVX2;
+      // The OS must also save the opmask and full zmm state.
+      if (_cpuid_info.sef_cpuid7_ebx.bits.avx512f != 0 &&
+          _cpuid_info.xem_xcr0_eax.bits.opmask != 0 &&
+          _cpuid_info.xem_xcr0_eax.bits.zmm512 != 0 &&
+          _cpuid_info.xem_xcr0_eax.bits.zmm32 != 0) {
+        result |= CPU_AVX512F;
+        if (_cpuid_info.sef_cpuid7_ebx.bits.avx512dq != 0)
+          result |= CPU_AVX512DQ;
+        if (_cpuid_info.sef_cpuid7_ebx.bits.avx512cd != 0)
+          result |= CPU_AVX512CD;
+        if (_cpuid_info.sef_cpuid7_ebx.bits.avx512bw != 0)
+          result |= CPU_AVX512BW;
+        if (_cpuid_info.sef_cpuid7_ebx.bits.avx512vl != 0)
+          result |= CPU_AVX512VL;
+      }
     }
     if(_cpuid_info.sef_cpuid7_ebx.bits.bmi1 != 0)
       result |= CPU_BMI1;
@@ -632,6 +664,11 @@ public:
   static bool supports_popcnt()   { return (_cpuFeatures & CPU_POPCNT) != 0; }
   static bool supports_avx()      { return (_cpuFeatures & CPU_AVX) != 0; }
   static bool supports_avx2()     { return (_cpuFeatures & CPU_AVX2) != 0; }
+  static bool supports_evex()     { return (_cpuFeatures & CPU_AVX512F) != 0; }
+  static bool supports_avx512dq() { return (_cpuFeatures & CPU_AVX512DQ) != 0; }
+  static bool supports_avx512cd() { return (_cpuFeatures & CPU_AVX512CD) != 0; }
+  static bool supports_avx512bw() { return (_cpuFeatures & CPU_AVX512BW) != 0; }
+  static bool supports_avx512vl() { return (_cpuFeatures & CPU_AVX512VL) != 0; }
   static bool supports_tsc()      { return (_cpuFeatures & CPU_TSC)    != 0; }
   static bool supports_aes()      { return (_cpuFeatures & CPU_AES) != 0; }
   static bool supports_erms()     { return (_cpuFeatures & CPU_ERMS) != 0; }
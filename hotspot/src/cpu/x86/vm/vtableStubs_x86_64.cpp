@@ -171,6 +171,38 @@ VtableStub* VtableStubs::create_itable_stub(int itable_index) {
   address npe_addr = __ pc();
   __ load_klass(recv_klass_reg, j_rarg0);
 
+  const Register method = rbx;
+  Label L_cache_hit;
+  if (UseItableCache) {
+    // The receiver class remembers the itable entry found by the last
+    // lookup. When REFC is DECC a matching entry proves the subtype
+    // check as well, so both itable scans are skipped. Only instance
+    // klasses have the cache; array receivers always take the scans.
+    Label L_cache_miss;
+    __ cmpptr(resolved_klass_reg, holder_klass_reg);
+    __ jcc(Assembler::notEqual, L_cache_miss);
+    __ cmpl(Address(recv_klass_reg, Klass::layout_helper_offset()), Klass::_lh_neutral_value);
+    __ jcc(Assembler::lessEqual, L_cache_miss);
+    __ movptr(temp_reg, Address(recv_klass_reg, InstanceKlass::itable_cache_offset()));
+    __ testptr(temp_reg, temp_reg);
+    __ jcc(Assembler::zero, L_cache_miss);
+    __ cmpptr(holder_klass_reg, Address(temp_reg, itableOffsetEntry::interface_offset_in_bytes()));
+    __ jcc(Assembler::notEqual, L_cache_miss);
+#ifndef PRODUCT
+    if (CountCompiledCalls) {
+      __ incrementl(ExternalAddress((address) SharedRuntime::nof_itable_cache_hits_addr()));
+    }
+#endif
+    __ jmp(L_cache_hit);
+
+    __ bind(L_cache_miss);
+#ifndef PRODUCT
+    if (CountCompiledCalls) {
+      __ incrementl(ExternalAddress((address) SharedRuntime::nof_itable_cache_misses_addr()));
+    }
+#endif
+  }
+
   // Receiver subtype check against REFC.
   // Destroys recv_klass_reg value.
   __ lookup_interface_method(// inputs: rec. class, interface
@@ -181,13 +213,39 @@ VtableStub* VtableStubs::create_itable_stub(int itable_index) {
                              /*return_method=*/false);
 
   // Get selected method from declaring class and itable index
-  const Register method = rbx;
   __ load_klass(recv_klass_reg, j_rarg0);   // restore recv_klass_reg
-  __ lookup_interface_method(// inputs: rec. class, interface, itable index
-                       recv_klass_reg, holder_klass_reg, itable_index,
-                       // outputs: method, scan temp. reg
-                       method, temp_reg,
-                       L_no_such_interface);
+  if (UseItableCache) {
+    // Find the itable entry of DECC, leaving it in temp_reg
+    __ lookup_interface_method(// inputs: rec. class, interface
+                         recv_klass_reg, holder_klass_reg, noreg,
+                         // outputs: scan temp. reg1, itable entry
+                         method, temp_reg,
+                         L_no_such_interface,
+                         /*return_method=*/false);
+
+    // Only write the cache when it changes, to keep the class shared.
+    // Arrays implement Cloneable and Serializable but have no cache.
+    Label L_cached;
+    __ cmpl(Address(recv_klass_reg, Klass::layout_helper_offset()), Klass::_lh_neutral_value);
+    __ jcc(Assembler::lessEqual, L_cached);
+    __ cmpptr(temp_reg, Address(recv_klass_reg, InstanceKlass::itable_cache_offset()));
+    __ jcc(Assembler::equal, L_cached);
+    __ movptr(Address(recv_klass_reg, InstanceKlass::itable_cache_offset()), temp_reg);
+    __ bind(L_cached);
+
+    // recv_klass_reg: receiver klass, temp_reg: itable entry of DECC
+    __ bind(L_cache_hit);
+    __ movl(temp_reg, Address(temp_reg, itableOffsetEntry::offset_offset_in_bytes()));
+    __ movptr(method, Address(recv_klass_reg, temp_reg, Address::times_1,
+                              itable_index * itableMethodEntry::size() * wordSize +
+                              itableMethodEntry::method_offset_in_bytes()));
+  } else {
+    __ lookup_interface_method(// inputs: rec. class, interface, itable index
+                         recv_klass_reg, holder_klass_reg, itable_index,
+                         // outputs: method, scan temp. reg
+                         method, temp_reg,
+                         L_no_such_interface);
+  }
 
   // If we take a trap while this arg is on the stack we will not
   // be able to walk the stack properly. This is not an issue except
@@ -242,6 +300,7 @@ int VtableStub::pd_code_size_limit(bool is_vtable_stub) {
   } else {
     // Itable stub size
     return (DebugVtables ? 512 : 140) + (CountCompiledCalls ? 13 : 0) +
+           (UseItableCache ? 96 + (CountCompiledCalls ? 26 : 0) : 0) +
            (UseCompressedClassPointers ? 2 * MacroAssembler::instr_size_for_decode_klass_not_null() : 0);
   }
   // In order to tune these parameters, run the JVM with VM options
@@ -4041,6 +4041,17 @@ void os::SuspendedThreadTask::internal_do_task() {
   }
 }
 
+// Not supported, see the Linux implementation.
+bool os::init_thread_cpu_timers(ThreadCPUTimerHandler handler) {
+  return false;
+}
+
+bool os::create_thread_cpu_timer(Thread* thread, jlong interval_nanos) {
+  return false;
+}
+
+void os::delete_thread_cpu_timer(Thread* thread) {}
+
 class PcFetcher : public os::SuspendedThreadTask {
 public:
   PcFetcher(Thread* thread) : os::SuspendedThreadTask(thread) {}
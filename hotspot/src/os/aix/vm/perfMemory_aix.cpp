@@ -1048,7 +1048,7 @@ static char* mmap_create_shared(size_t size) {
   (void)::memset((void*) mapAddress, 0, size);
 
   // It does not go through os api, the operation has to record from here.
-  MemTracker::record_virtual_memory_reserve((address)mapAddress, size, CURRENT_PC, mtInternal);
+  MemTracker::record_virtual_memory_reserve((address)mapAddress, size, UNSAMPLED_CURRENT_PC, mtInternal);
 
   return mapAddress;
 }
@@ -1225,7 +1225,7 @@ static void mmap_attach_shared(const char* user, int vmid, PerfMemory::PerfMemor
   }
 
   // It does not go through os api, the operation has to record from here.
-  MemTracker::record_virtual_memory_reserve((address)mapAddress, size, CURRENT_PC, mtInternal);
+  MemTracker::record_virtual_memory_reserve((address)mapAddress, size, UNSAMPLED_CURRENT_PC, mtInternal);
 
   *addr = mapAddress;
   *sizep = size;
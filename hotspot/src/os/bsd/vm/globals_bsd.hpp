@@ -41,7 +41,15 @@
           "Use MAP_HUGETLB for large pages")                            \
                                                                         \
   product(bool, UseSHM, false,                                          \
-          "Use SYSV shared memory for large pages")
+          "Use SYSV shared memory for large pages")                     \
+                                                                        \
+  product(bool, UseLazyWX, false,                                       \
+          "Stay in W^X execute mode and switch to write mode only on "  \
+          "a fault writing the code cache (AArch64 only)")              \
+                                                                        \
+  product(bool, PrintWXStatistics, false,                               \
+          "Print W^X mode switch and fault counts at exit "             \
+          "(AArch64 only)")
 
 //
 // Defines Bsd-specific default values. The flags are available on all
@@ -2518,7 +2518,7 @@ char* os::reserve_memory_special(size_t bytes, size_t alignment, char* req_addr,
   }
 
   // The memory is committed
-  MemTracker::record_virtual_memory_reserve_and_commit((address)addr, bytes, CALLER_PC);
+  MemTracker::record_virtual_memory_reserve_and_commit((address)addr, bytes, UNSAMPLED_CALLER_PC);
 
   return addr;
 }
@@ -3882,6 +3882,17 @@ void os::SuspendedThreadTask::internal_do_task() {
   }
 }
 
+// Not supported, see the Linux implementation.
+bool os::init_thread_cpu_timers(ThreadCPUTimerHandler handler) {
+  return false;
+}
+
+bool os::create_thread_cpu_timer(Thread* thread, jlong interval_nanos) {
+  return false;
+}
+
+void os::delete_thread_cpu_timer(Thread* thread) {}
+
 ///
 class PcFetcher : public os::SuspendedThreadTask {
 public:
@@ -3981,6 +3992,9 @@ os::os_exception_wrapper(java_call_t f, JavaValue* value, methodHandle* method,
 }
 
 void os::print_statistics() {
+#ifdef AARCH64
+  print_wx_statistics(tty);
+#endif
 }
 
 int os::message_box(const char* title, const char* message) {
@@ -968,7 +968,7 @@ static char* mmap_create_shared(size_t size) {
   (void)::memset((void*) mapAddress, 0, size);
 
   // it does not go through os api, the operation has to record from here
-  MemTracker::record_virtual_memory_reserve_and_commit((address)mapAddress, size, CURRENT_PC, mtInternal);
+  MemTracker::record_virtual_memory_reserve_and_commit((address)mapAddress, size, UNSAMPLED_CURRENT_PC, mtInternal);
 
   return mapAddress;
 }
@@ -1133,7 +1133,7 @@ static void mmap_attach_shared(const char* user, int vmid, PerfMemory::PerfMemor
   }
 
   // it does not go through os api, the operation has to record from here
-  MemTracker::record_virtual_memory_reserve_and_commit((address)mapAddress, size, CURRENT_PC, mtInternal);
+  MemTracker::record_virtual_memory_reserve_and_commit((address)mapAddress, size, UNSAMPLED_CURRENT_PC, mtInternal);
 
   *addr = mapAddress;
   *sizep = size;
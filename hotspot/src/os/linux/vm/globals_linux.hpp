@@ -55,7 +55,30 @@
   product(bool, PreferContainerQuotaForCPUCount, true,                  \
           "Calculate the container CPU availability based on the value" \
           " of quotas (if set), when true. Otherwise, use the CPU"      \
-          " shares value, provided it is less than quota.")
+          " shares value, provided it is less than quota.")             \
+                                                                        \
+  product(bool, UseFutexParker, true,                                   \
+          "Implement Parker and PlatformEvent with futexes instead of"  \
+          " pthread mutexes and condition variables")                   \
+                                                                        \
+  product(intx, FutexParkSpins, 0,                                      \
+          "Number of times Parker::park polls for a permit before"      \
+          " blocking in the kernel, when more than one CPU is"          \
+          " available. Requires UseFutexParker")                        \
+                                                                        \
+  product(bool, PerfDataMemoryBackedStore, false,                       \
+          "Create the hsperfdata backing store under /dev/shm when the" \
+          " temporary directory is not on a memory file system. Tools"  \
+          " must then look for it in the same place")                   \
+                                                                        \
+  product(uintx, NativeThreadPoolSize, 0,                               \
+          "Maximum number of native threads of terminated Java threads" \
+          " kept, with their stacks, to run Java threads started later."\
+          " 0 disables the pool")                                       \
+                                                                        \
+  product(uintx, NativeThreadPoolIdleTimeout, 60000,                    \
+          "Milliseconds a pooled native thread waits for a Java thread" \
+          " to run before it exits")
 
 //
 // Defines Linux-specific default values. The flags are available on all
@@ -34,6 +34,7 @@
 
 bool  OSContainer::_is_initialized   = false;
 bool  OSContainer::_is_containerized = false;
+bool  OSContainer::_is_cgroup_v2     = false;
 int   OSContainer::_active_processor_count = 1;
 julong _unlimited_memory;
 
@@ -274,6 +275,36 @@ PRAGMA_DIAG_POP
     tty->print_cr(logstring, variable);                                   \
 }
 
+/* limit_from_file
+ *
+ * Read a cgroup v2 limit, which is either a number or the
+ * string "max". The number is the first field of the file.
+ *
+ * return:
+ *    the limit or
+ *    -1 for unlimited
+ *    OSCONTAINER_ERROR for not supported
+ */
+static jlong limit_from_file(CgroupSubsystem* c, const char* filename) {
+  char limit_str[1024];
+  julong limit;
+  if (subsystem_file_line_contents(c, filename, NULL, "%1023s", limit_str) != 0) {
+    return OSCONTAINER_ERROR;
+  }
+  if (PrintContainerInfo) {
+    tty->print_cr("Limit in %s is: %s", filename, limit_str);
+  }
+  if (strcmp(limit_str, "max") == 0) {
+    return (jlong)-1;
+  }
+  if (sscanf(limit_str, JULONG_FORMAT, &limit) != 1) {
+    return OSCONTAINER_ERROR;
+  }
+  if (limit >= _unlimited_memory) {
+    return (jlong)-1;
+  }
+  return (jlong)limit;
+}
 
 /* init
  *
@@ -288,6 +319,9 @@ void OSContainer::init() {
   char tmpmount[MAXPATHLEN+1];
   char *p;
   jlong mem_limit;
+  char unified_root[MAXPATHLEN+1];
+  char unified_mount[MAXPATHLEN+1];
+  bool has_unified = false;
 
   assert(!_is_initialized, "Initializing OSContainer more than once");
 
@@ -315,6 +349,9 @@ void OSContainer::init() {
    *
    * Example for host:
    * 34 28 0:29 / /sys/fs/cgroup/memory rw,nosuid,nodev,noexec,relatime shared:16 - cgroup cgroup rw,memory
+   *
+   * Example for the cgroup v2 unified hierarchy:
+   * 31 23 0:26 / /sys/fs/cgroup rw,nosuid,nodev,noexec,relatime shared:4 - cgroup2 cgroup2 rw,nsdelegate
    */
   mntinfo = fopen("/proc/self/mountinfo", "r");
   if (mntinfo == NULL) {
@@ -331,6 +368,16 @@ void OSContainer::init() {
     char *token;
 
     // mountinfo format is documented at https://www.kernel.org/doc/Documentation/filesystems/proc.txt
+    char tmpfstype[MAXPATHLEN+1];
+    if (sscanf(p, "%*d %*d %*d:%*d %s %s %*[^-]- %s", tmproot, tmpmount, tmpfstype) == 3 &&
+        strcmp(tmpfstype, "cgroup2") == 0) {
+      if (!has_unified) {
+        strcpy(unified_root, tmproot);
+        strcpy(unified_mount, tmpmount);
+        has_unified = true;
+      }
+      continue;
+    }
     if (sscanf(p, "%*d %*d %*d:%*d %s %s %*[^-]- cgroup %*s %s", tmproot, tmpmount, tmpcgroups) != 3) {
       continue;
     }
@@ -348,6 +395,20 @@ void OSContainer::init() {
   }
   fclose(mntinfo);
 
+  // Without any cgroup v1 memory controller, use the unified (v2)
+  // hierarchy if it is mounted. All controllers then share the same
+  // directory. A hybrid setup with v1 controllers keeps using v1.
+  if (memory == NULL && has_unified) {
+    if (PrintContainerInfo) {
+      tty->print_cr("Using cgroup v2 unified hierarchy at %s", unified_mount);
+    }
+    _is_cgroup_v2 = true;
+    memory = new CgroupMemorySubsystem(unified_root, unified_mount);
+    cpuset = new CgroupSubsystem(unified_root, unified_mount);
+    cpu = new CgroupSubsystem(unified_root, unified_mount);
+    cpuacct = new CgroupSubsystem(unified_root, unified_mount);
+  }
+
   if (memory == NULL) {
     if (PrintContainerInfo) {
       tty->print_cr("Required cgroup memory subsystem not found");
@@ -395,6 +456,9 @@ void OSContainer::init() {
    *
    * /sys/fs/cgroup/memory/user.slice
    *
+   * With cgroup v2 there is a single "0::<path>" line that applies
+   * to all controllers.
+   *
    */
   cgroup = fopen("/proc/self/cgroup", "r");
   if (cgroup == NULL) {
@@ -420,6 +484,16 @@ void OSContainer::init() {
       continue;
     }
 
+    if (_is_cgroup_v2) {
+      if (*controllers == '\0') {
+        memory->set_subsystem_path(base);
+        cpuset->set_subsystem_path(base);
+        cpu->set_subsystem_path(base);
+        cpuacct->set_subsystem_path(base);
+      }
+      continue;
+    }
+
     while ((token = strsep(&controllers, ",")) != NULL) {
       if (strcmp(token, "memory") == 0) {
         memory->set_subsystem_path(base);
@@ -454,7 +528,7 @@ void OSContainer::init() {
 
 const char * OSContainer::container_type() {
   if (is_containerized()) {
-    return "cgroupv1";
+    return _is_cgroup_v2 ? "cgroupv2" : "cgroupv1";
   } else {
     return NULL;
   }
@@ -486,6 +560,9 @@ jlong OSContainer::uses_mem_hierarchy() {
  *    OSCONTAINER_ERROR for not supported
  */
 jlong OSContainer::memory_limit_in_bytes() {
+  if (_is_cgroup_v2) {
+    return limit_from_file(memory, "/memory.max");
+  }
   GET_CONTAINER_INFO(julong, memory, "/memory.limit_in_bytes",
                      "Memory Limit is: " JULONG_FORMAT, JULONG_FORMAT, memlimit);
 
@@ -514,6 +591,18 @@ jlong OSContainer::memory_limit_in_bytes() {
 }
 
 jlong OSContainer::memory_and_swap_limit_in_bytes() {
+  if (_is_cgroup_v2) {
+    // cgroup v2 limits swap separately from memory.
+    jlong mem_limit = memory_limit_in_bytes();
+    if (mem_limit <= 0) {
+      return mem_limit;
+    }
+    jlong swap_limit = limit_from_file(memory, "/memory.swap.max");
+    if (swap_limit < 0) {
+      return swap_limit;
+    }
+    return mem_limit + swap_limit;
+  }
   GET_CONTAINER_INFO(julong, memory, "/memory.memsw.limit_in_bytes",
                      "Memory and Swap Limit is: " JULONG_FORMAT, JULONG_FORMAT, memswlimit);
   if (memswlimit >= _unlimited_memory) {
@@ -540,6 +629,11 @@ jlong OSContainer::memory_and_swap_limit_in_bytes() {
 }
 
 jlong OSContainer::memory_soft_limit_in_bytes() {
+  if (_is_cgroup_v2) {
+    jlong mem_soft_limit = limit_from_file(memory, "/memory.low");
+    // memory.low defaults to 0, which means no soft limit.
+    return mem_soft_limit == 0 ? (jlong)-1 : mem_soft_limit;
+  }
   GET_CONTAINER_INFO(julong, memory, "/memory.soft_limit_in_bytes",
                      "Memory Soft Limit is: " JULONG_FORMAT, JULONG_FORMAT, memsoftlimit);
   if (memsoftlimit >= _unlimited_memory) {
@@ -562,6 +656,11 @@ jlong OSContainer::memory_soft_limit_in_bytes() {
  *    OSCONTAINER_ERROR for not supported
  */
 jlong OSContainer::memory_usage_in_bytes() {
+  if (_is_cgroup_v2) {
+    GET_CONTAINER_INFO(jlong, memory, "/memory.current",
+                       "Memory Usage is: " JLONG_FORMAT, JLONG_FORMAT, memcurrent);
+    return memcurrent;
+  }
   GET_CONTAINER_INFO(jlong, memory, "/memory.usage_in_bytes",
                      "Memory Usage is: " JLONG_FORMAT, JLONG_FORMAT, memusage);
   return memusage;
@@ -576,6 +675,12 @@ jlong OSContainer::memory_usage_in_bytes() {
  *    OSCONTAINER_ERROR for not supported
  */
 jlong OSContainer::memory_max_usage_in_bytes() {
+  if (_is_cgroup_v2) {
+    // memory.peak only exists on newer kernels.
+    GET_CONTAINER_INFO(jlong, memory, "/memory.peak",
+                       "Maximum Memory Usage is: " JLONG_FORMAT, JLONG_FORMAT, mempeak);
+    return mempeak;
+  }
   GET_CONTAINER_INFO(jlong, memory, "/memory.max_usage_in_bytes",
                      "Maximum Memory Usage is: " JLONG_FORMAT, JLONG_FORMAT, memmaxusage);
   return memmaxusage;
@@ -680,12 +785,22 @@ int OSContainer::active_processor_count() {
 }
 
 char * OSContainer::cpu_cpuset_cpus() {
+  if (_is_cgroup_v2) {
+    GET_CONTAINER_INFO_CPTR(cptr, cpuset, "/cpuset.cpus.effective",
+                       "cpuset.cpus.effective is: %s", "%1023s", cpus, 1024);
+    return os::strdup(cpus);
+  }
   GET_CONTAINER_INFO_CPTR(cptr, cpuset, "/cpuset.cpus",
                      "cpuset.cpus is: %s", "%1023s", cpus, 1024);
   return os::strdup(cpus);
 }
 
 char * OSContainer::cpu_cpuset_memory_nodes() {
+  if (_is_cgroup_v2) {
+    GET_CONTAINER_INFO_CPTR(cptr, cpuset, "/cpuset.mems.effective",
+                       "cpuset.mems.effective is: %s", "%1023s", mems, 1024);
+    return os::strdup(mems);
+  }
   GET_CONTAINER_INFO_CPTR(cptr, cpuset, "/cpuset.mems",
                      "cpuset.mems is: %s", "%1023s", mems, 1024);
   return os::strdup(mems);
@@ -702,12 +817,21 @@ char * OSContainer::cpu_cpuset_memory_nodes() {
  *    OSCONTAINER_ERROR for not supported
  */
 int OSContainer::cpu_quota() {
+  if (_is_cgroup_v2) {
+    // cpu.max holds "<quota> <period>", where quota may be "max".
+    return (int)limit_from_file(cpu, "/cpu.max");
+  }
   GET_CONTAINER_INFO(int, cpu, "/cpu.cfs_quota_us",
                      "CPU Quota is: %d", "%d", quota);
   return quota;
 }
 
 int OSContainer::cpu_period() {
+  if (_is_cgroup_v2) {
+    GET_CONTAINER_INFO(int, cpu, "/cpu.max",
+                       "CPU Period is: %d", "%*s %d", period);
+    return period;
+  }
   GET_CONTAINER_INFO(int, cpu, "/cpu.cfs_period_us",
                      "CPU Period is: %d", "%d", period);
   return period;
@@ -724,6 +848,24 @@ int OSContainer::cpu_period() {
  *    OSCONTAINER_ERROR for not supported
  */
 int OSContainer::cpu_shares() {
+  if (_is_cgroup_v2) {
+    GET_CONTAINER_INFO(int, cpu, "/cpu.weight",
+                       "CPU Weight is: %d", "%d", weight);
+    // Convert the default weight to no shares setup
+    if (weight == 100) return -1;
+
+    // Container runtimes map shares x to weight y with
+    // y = 1 + ((x - 2) * 9999) / 262142. Invert that, and round
+    // to the nearest multiple of PER_CPU_SHARES so that the share
+    // based CPU count matches the one seen with cgroup v1.
+    int shares = (int)((262142.0 * weight - 1) / 9999.0) + 2;
+    if (shares <= PER_CPU_SHARES) {
+      return shares;
+    }
+    int lower = (shares / PER_CPU_SHARES) * PER_CPU_SHARES;
+    int upper = lower + PER_CPU_SHARES;
+    return (shares - lower <= upper - shares) ? lower : upper;
+  }
   GET_CONTAINER_INFO(int, cpu, "/cpu.shares",
                      "CPU Shares is: %d", "%d", shares);
   // Convert 1024 to no shares setup
@@ -39,6 +39,7 @@ class OSContainer: AllStatic {
  private:
   static bool   _is_initialized;
   static bool   _is_containerized;
+  static bool   _is_cgroup_v2;
   static int    _active_processor_count;
 
  public:
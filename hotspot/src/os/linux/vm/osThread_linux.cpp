@@ -36,6 +36,8 @@ void OSThread::pd_initialize() {
   _ucontext = NULL;
   _expanding_stack = 0;
   _alt_sig_stack = NULL;
+  _cpu_timer_id = -1;
+  _stack_size = 0;
 
   sigemptyset(&_caller_sigmask);
 
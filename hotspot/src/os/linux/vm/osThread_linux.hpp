@@ -45,8 +45,14 @@
 
   sigset_t _caller_sigmask; // Caller's signal mask
 
+  // Stack size the native thread was created with
+  size_t _stack_size;
+
  public:
 
+  size_t stack_size() const              { return _stack_size; }
+  void set_stack_size(size_t stack_size) { _stack_size = stack_size; }
+
   // Methods to save/restore caller's signal mask
   sigset_t  caller_sigmask() const       { return _caller_sigmask; }
   void    set_caller_sigmask(sigset_t sigmask)  { _caller_sigmask = sigmask; }
@@ -110,6 +116,13 @@ public:
   void set_alt_sig_stack(address val)     { _alt_sig_stack = val; }
   address alt_sig_stack(void)             { return _alt_sig_stack; }
 
+private:
+  int _cpu_timer_id;              // kernel timer id, -1 if none, see os::create_thread_cpu_timer
+
+public:
+  int cpu_timer_id() const                { return _cpu_timer_id; }
+  void set_cpu_timer_id(int id)           { _cpu_timer_id = id; }
+
 private:
   Monitor* _startThread_lock;     // sync parent and child in thread creation
 
@@ -102,6 +102,7 @@
 # include <stdint.h>
 # include <inttypes.h>
 # include <sys/ioctl.h>
+# include <linux/futex.h>
 
 PRAGMA_FORMAT_MUTE_WARNINGS_FOR_GCC
 
@@ -783,17 +784,105 @@ static bool _thread_safety_check(Thread* thread) {
   }
 }
 
-// Thread start routine for all newly created threads
-static void *java_start(Thread *thread) {
-  // Try to randomize the cache line index of hot stack frames.
-  // This helps when threads of the same stack traces evict each other's
-  // cache lines. The threads can be either from the same JVM instance, or
-  // from different JVM instances. The benefit is especially true for
-  // processors with hyperthreading technology.
-  static int counter = 0;
-  int pid = os::current_process_id();
-  alloca(((pid ^ counter++) & 7) * 128);
+static struct timespec* compute_abstime(timespec* abstime, jlong millis);
 
+// Native threads of terminated Java threads, waiting for os::create_thread()
+// to hand them the next Java thread to run. Starting a Java thread then
+// takes a condition variable signal instead of pthread_create() and
+// mapping and faulting in a fresh stack, which shows in servers that
+// start a thread per request. Only threads with the same stack size are
+// reused, and the glibc guard page stays in place; the HotSpot guard
+// zones are created and removed by each Java thread as usual.
+//
+// Native thread local storage set up by JNI code is not reset, which is
+// why the pool is off unless NativeThreadPoolSize is set.
+class NativeThreadPool : AllStatic {
+ private:
+  struct Waiter {
+    size_t          _stack_size;
+    pthread_t       _tid;
+    Thread*         _thread;      // handed over, or NULL
+    pthread_cond_t  _cond;
+    Waiter*         _next;
+  };
+
+  static pthread_mutex_t _lock;
+  static Waiter*         _waiters;
+  static uintx           _num_waiters;
+
+ public:
+  // Waits for a thread to run on the calling native thread, which was
+  // created with the given stack size. Returns NULL if the pool is full or
+  // none came within NativeThreadPoolIdleTimeout.
+  static Thread* wait_for_thread(size_t stack_size);
+
+  // Hands the thread to a waiting native thread with the given stack size,
+  // whose pthread id is returned in tid. Returns false if there is none.
+  static bool hand_over(Thread* thread, size_t stack_size, pthread_t* tid);
+};
+
+pthread_mutex_t          NativeThreadPool::_lock        = PTHREAD_MUTEX_INITIALIZER;
+NativeThreadPool::Waiter* NativeThreadPool::_waiters    = NULL;
+uintx                    NativeThreadPool::_num_waiters = 0;
+
+Thread* NativeThreadPool::wait_for_thread(size_t stack_size) {
+  Waiter w;
+  w._stack_size = stack_size;
+  w._tid = pthread_self();
+  w._thread = NULL;
+  pthread_cond_init(&w._cond, os::Linux::condAttr());
+
+  pthread_mutex_lock(&_lock);
+  if (_num_waiters < NativeThreadPoolSize) {
+    w._next = _waiters;
+    _waiters = &w;
+    _num_waiters++;
+
+    struct timespec abstime;
+    compute_abstime(&abstime, (jlong) NativeThreadPoolIdleTimeout);
+    while (w._thread == NULL) {
+      int status = pthread_cond_timedwait(&w._cond, &_lock, &abstime);
+      if (status == ETIMEDOUT && w._thread == NULL) {
+        // Still queued, since handing over dequeues
+        Waiter** p = &_waiters;
+        while (*p != &w) {
+          p = &(*p)->_next;
+        }
+        *p = w._next;
+        _num_waiters--;
+        break;
+      }
+    }
+  }
+  pthread_mutex_unlock(&_lock);
+
+  pthread_cond_destroy(&w._cond);
+  return w._thread;
+}
+
+bool NativeThreadPool::hand_over(Thread* thread, size_t stack_size, pthread_t* tid) {
+  bool found = false;
+  pthread_mutex_lock(&_lock);
+  for (Waiter** p = &_waiters; *p != NULL; p = &(*p)->_next) {
+    Waiter* w = *p;
+    if (w->_stack_size == stack_size) {
+      *p = w->_next;
+      _num_waiters--;
+      *tid = w->_tid;
+      w->_thread = thread;
+      // The waiter cannot leave before we unlock
+      pthread_cond_signal(&w->_cond);
+      found = true;
+      break;
+    }
+  }
+  pthread_mutex_unlock(&_lock);
+  return found;
+}
+
+// Sets up the native thread for thread and runs it. Returns false if the
+// thread was aborted before it ran.
+static bool run_thread(Thread* thread) {
   ThreadLocalStorage::set_thread(thread);
 
   OSThread* osthread = thread->osthread();
@@ -805,7 +894,7 @@ static void *java_start(Thread *thread) {
     MutexLockerEx ml(sync, Mutex::_no_safepoint_check_flag);
     osthread->set_state(ZOMBIE);
     sync->notify_all();
-    return NULL;
+    return false;
   }
 
   // thread_id is kernel thread id (similar to Solaris LWP id)
@@ -840,6 +929,32 @@ static void *java_start(Thread *thread) {
   // call one more level start routine
   thread->run();
 
+  return true;
+}
+
+// Thread start routine for all newly created threads
+static void *java_start(Thread *thread) {
+  // Try to randomize the cache line index of hot stack frames.
+  // This helps when threads of the same stack traces evict each other's
+  // cache lines. The threads can be either from the same JVM instance, or
+  // from different JVM instances. The benefit is especially true for
+  // processors with hyperthreading technology.
+  static int counter = 0;
+  int pid = os::current_process_id();
+  alloca(((pid ^ counter++) & 7) * 128);
+
+  // The thread and its OSThread are deleted by the time run() returns
+  bool poolable = NativeThreadPoolSize > 0 &&
+                  thread->osthread()->thread_type() == os::java_thread;
+  size_t stack_size = thread->osthread()->stack_size();
+
+  while (run_thread(thread) && poolable) {
+    thread = NativeThreadPool::wait_for_thread(stack_size);
+    if (thread == NULL) {
+      break;
+    }
+  }
+
   return 0;
 }
 
@@ -902,6 +1017,8 @@ bool os::create_thread(Thread* thread, ThreadType thr_type, size_t stack_size) {
   // glibc guard page
   pthread_attr_setguardsize(&attr, os::Linux::default_guard_size(thr_type));
 
+  osthread->set_stack_size(stack_size);
+
   ThreadState state;
 
   {
@@ -912,7 +1029,11 @@ bool os::create_thread(Thread* thread, ThreadType thr_type, size_t stack_size) {
     }
 
     pthread_t tid;
-    int ret = pthread_create(&tid, &attr, (void* (*)(void*)) java_start, thread);
+    int ret = 0;
+    if (NativeThreadPoolSize == 0 || thr_type != os::java_thread ||
+        !NativeThreadPool::hand_over(thread, stack_size, &tid)) {
+      ret = pthread_create(&tid, &attr, (void* (*)(void*)) java_start, thread);
+    }
 
     pthread_attr_destroy(&attr);
 
@@ -3933,7 +4054,7 @@ char* os::reserve_memory_special(size_t bytes, size_t alignment, char* req_addr,
     }
 
     // The memory is committed
-    MemTracker::record_virtual_memory_reserve_and_commit((address)addr, bytes, CALLER_PC);
+    MemTracker::record_virtual_memory_reserve_and_commit((address)addr, bytes, UNSAMPLED_CALLER_PC);
   }
 
   return addr;
@@ -5453,6 +5574,97 @@ void os::SuspendedThreadTask::internal_do_task() {
   }
 }
 
+// Thread CPU time timers
+//
+// A POSIX timer on the CPU time clock of the thread, delivering its signal
+// to that thread only (SIGEV_THREAD_ID). The timer system calls are used
+// directly so that libjvm does not need librt.
+
+#ifndef SIGEV_THREAD_ID
+#define SIGEV_THREAD_ID 4
+#endif
+#ifndef sigev_notify_thread_id
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+
+static const int cpu_timer_signum = SIGPROF;
+static os::ThreadCPUTimerHandler cpu_timer_handler = NULL;
+
+static void cpu_timer_signal_handler(int sig, siginfo_t* info, void* ucontext) {
+  // Save and restore errno, the handler may interrupt a system call
+  const int old_errno = errno;
+  Thread* const thread = ThreadLocalStorage::get_thread_slow();
+  if (thread != NULL) {
+    cpu_timer_handler(thread, ucontext);
+  }
+  errno = old_errno;
+}
+
+bool os::init_thread_cpu_timers(ThreadCPUTimerHandler handler) {
+  assert(handler != NULL, "invariant");
+  if (cpu_timer_handler != NULL) {
+    return cpu_timer_handler == handler;
+  }
+  struct sigaction oldact;
+  if (sigaction(cpu_timer_signum, NULL, &oldact) != 0) {
+    return false;
+  }
+  if ((oldact.sa_flags & SA_SIGINFO) != 0 ||
+      (oldact.sa_handler != SIG_DFL && oldact.sa_handler != SIG_IGN)) {
+    // SIGPROF is in use, e.g. by a profiling agent
+    return false;
+  }
+  cpu_timer_handler = handler;
+  struct sigaction act;
+  sigemptyset(&act.sa_mask);
+  act.sa_sigaction = cpu_timer_signal_handler;
+  act.sa_flags = SA_SIGINFO | SA_RESTART;
+  if (sigaction(cpu_timer_signum, &act, NULL) != 0) {
+    cpu_timer_handler = NULL;
+    return false;
+  }
+  return true;
+}
+
+bool os::create_thread_cpu_timer(Thread* thread, jlong interval_nanos) {
+  assert(cpu_timer_handler != NULL, "not initialized");
+  assert(interval_nanos > 0, "invariant");
+  OSThread* const osthread = thread->osthread();
+  assert(osthread->cpu_timer_id() == -1, "already has a timer");
+  clockid_t clock;
+  if (pthread_getcpuclockid(osthread->pthread_id(), &clock) != 0) {
+    return false;
+  }
+  struct sigevent sev;
+  memset(&sev, 0, sizeof(sev));
+  sev.sigev_notify = SIGEV_THREAD_ID;
+  sev.sigev_signo = cpu_timer_signum;
+  sev.sigev_notify_thread_id = osthread->thread_id();
+  int timer_id;
+  if (syscall(SYS_timer_create, clock, &sev, &timer_id) != 0) {
+    return false;
+  }
+  struct itimerspec spec;
+  spec.it_interval.tv_sec = (time_t)(interval_nanos / NANOSECS_PER_SEC);
+  spec.it_interval.tv_nsec = (long)(interval_nanos % NANOSECS_PER_SEC);
+  spec.it_value = spec.it_interval;
+  if (syscall(SYS_timer_settime, timer_id, 0, &spec, NULL) != 0) {
+    syscall(SYS_timer_delete, timer_id);
+    return false;
+  }
+  osthread->set_cpu_timer_id(timer_id);
+  return true;
+}
+
+void os::delete_thread_cpu_timer(Thread* thread) {
+  OSThread* const osthread = thread->osthread();
+  const int timer_id = osthread->cpu_timer_id();
+  if (timer_id != -1) {
+    osthread->set_cpu_timer_id(-1);
+    syscall(SYS_timer_delete, timer_id);
+  }
+}
+
 class PcFetcher : public os::SuspendedThreadTask {
 public:
   PcFetcher(Thread* thread) : os::SuspendedThreadTask(thread) {}
@@ -6055,6 +6267,43 @@ static struct timespec* compute_abstime(timespec* abstime, jlong millis) {
 }
 
 
+// Futex based parking, used when UseFutexParker is set.
+//
+// The word that PlatformEvent::_Event or Parker::_counter already keeps is
+// used as the futex itself: -1 means the owning thread is (about to be)
+// blocked, so an unpark only enters the kernel to wake a thread that has
+// announced that it blocks. Unpark-before-park never makes a system call.
+
+static int futex_wait(volatile int* addr, int expected, const struct timespec* rel_timeout) {
+  // A relative FUTEX_WAIT timeout is measured against CLOCK_MONOTONIC.
+  int ret = syscall(SYS_futex, (int*)addr, FUTEX_WAIT | FUTEX_PRIVATE_FLAG,
+                    expected, rel_timeout, NULL, 0);
+  return ret == 0 ? 0 : errno;
+}
+
+static void futex_wake(volatile int* addr) {
+  syscall(SYS_futex, (int*)addr, FUTEX_WAKE | FUTEX_PRIVATE_FLAG, 1, NULL, NULL, 0);
+}
+
+// The javaTimeNanos() deadline that many nanoseconds from now. Like
+// compute_abstime() and unpackTime(), waits are capped at MAX_SECS, so
+// that very long timeouts do not overflow.
+static jlong futex_deadline(jlong nanos) {
+  return os::javaTimeNanos() + MIN2(MAX2(nanos, (jlong)0), (jlong)MAX_SECS * NANOSECS_PER_SEC);
+}
+
+// Relative timeout until the given javaTimeNanos() deadline, or false if
+// the deadline has passed.
+static bool futex_timeout(struct timespec* ts, jlong deadline) {
+  jlong remaining = deadline - os::javaTimeNanos();
+  if (remaining <= 0) {
+    return false;
+  }
+  ts->tv_sec  = (time_t)(remaining / NANOSECS_PER_SEC);
+  ts->tv_nsec = (long)(remaining % NANOSECS_PER_SEC);
+  return true;
+}
+
 // Test-and-clear _Event, always leaves _Event set to 0, returns immediately.
 // Conceptually TryPark() should be equivalent to park(0).
 
@@ -6076,7 +6325,15 @@ void os::PlatformEvent::park() {       // AKA "down()"
       if (Atomic::cmpxchg (v-1, &_Event, v) == v) break ;
   }
   guarantee (v >= 0, "invariant") ;
-  if (v == 0) {
+  if (v == 0 && UseFutexParker) {
+    // Block until unpark() moves _Event from -1 to 1.
+    while (_Event < 0) {
+      int status = futex_wait(&_Event, -1, NULL);
+      assert_status(status == 0 || status == EAGAIN || status == EINTR, status, "futex_wait");
+    }
+    _Event = 0 ;
+    OrderAccess::fence();
+  } else if (v == 0) {
      // Do this the hard way by blocking ...
      int status = pthread_mutex_lock(_mutex);
      assert_status(status == 0, status, "mutex_lock");
@@ -6112,6 +6369,21 @@ int os::PlatformEvent::park(jlong millis) {
   guarantee (v >= 0, "invariant") ;
   if (v != 0) return OS_OK ;
 
+  if (UseFutexParker) {
+    jlong deadline = futex_deadline(MIN2(millis, (jlong)MAX_SECS * MILLIUNITS) * NANOSECS_PER_MILLISEC);
+    struct timespec ts;
+    while (_Event < 0 && futex_timeout(&ts, deadline)) {
+      int status = futex_wait(&_Event, -1, &ts);
+      assert_status(status == 0 || status == EAGAIN || status == EINTR ||
+                    status == ETIMEDOUT, status, "futex_wait");
+      if (!FilterSpuriousWakeups) break ;               // previous semantics
+    }
+    // Consume a racing unpark() rather than losing it.
+    int ret = Atomic::xchg(0, &_Event) >= 0 ? OS_OK : OS_TIMEOUT;
+    OrderAccess::fence();
+    return ret;
+  }
+
   // We do this the hard way, by blocking the thread.
   // Consider enforcing a minimum timeout value.
   struct timespec abst;
@@ -6183,6 +6455,11 @@ void os::PlatformEvent::unpark() {
 
   if (Atomic::xchg(1, &_Event) >= 0) return;
 
+  if (UseFutexParker) {
+    futex_wake(&_Event);
+    return;
+  }
+
   // Wait for the thread associated with the event to vacate
   int status = pthread_mutex_lock(_mutex);
   assert_status(status == 0, status, "mutex_lock");
@@ -6298,6 +6575,66 @@ static void unpackTime(timespec* absTime, bool isAbsolute, jlong time) {
   assert(absTime->tv_nsec < NANOSECS_PER_SEC, "tv_nsec >= nanos_per_sec");
 }
 
+// Parks on Parker::_counter itself: 1 is an available permit, 0 none, and -1
+// announces that this thread is blocked in the kernel.
+static void park_futex(volatile int* counter, JavaThread* jt, bool isAbsolute, jlong time) {
+  // Brief spinning catches the unpark of a handoff that is already on
+  // its way, without blocking and being woken in the kernel.
+  if (FutexParkSpins > 0 && os::active_processor_count() > 1) {
+    for (intx i = 0; i < FutexParkSpins; i++) {
+      if (*counter > 0 && Atomic::xchg(0, counter) > 0) return;
+      SpinPause();
+    }
+  }
+
+  // Compute the deadline before blocking, on the clock of the request.
+  jlong deadline = 0;
+  if (time > 0) {
+    if (isAbsolute) {
+      jlong remaining_millis = time - os::javaTimeMillis();
+      if (remaining_millis <= 0) return;
+      deadline = futex_deadline(MIN2(remaining_millis, (jlong)MAX_SECS * MILLIUNITS) * NANOSECS_PER_MILLISEC);
+    } else {
+      deadline = futex_deadline(time);
+    }
+  }
+
+  ThreadBlockInVM tbivm(jt);
+
+  if (Thread::is_interrupted(jt, false)) {
+    return;
+  }
+  // Announce that we are about to block. Failure means a permit arrived.
+  if (Atomic::cmpxchg(-1, counter, 0) != 0) {
+    *counter = 0;
+    OrderAccess::fence();
+    return;
+  }
+
+  OSThreadWaitState osts(jt->osthread(), false /* not Object.wait() */);
+  jt->set_suspend_equivalent();
+  // cleared by handle_special_suspend_equivalent_condition() or java_suspend_self()
+
+  int status;
+  if (time == 0) {
+    status = futex_wait(counter, -1, NULL);
+  } else {
+    struct timespec ts;
+    status = futex_timeout(&ts, deadline) ? futex_wait(counter, -1, &ts) : ETIMEDOUT;
+  }
+  assert_status(status == 0 || status == EAGAIN || status == EINTR ||
+                status == ETIMEDOUT, status, "futex_wait");
+
+  // Reset -1, or consume a permit granted after we woke up.
+  Atomic::xchg(0, counter);
+  OrderAccess::fence();
+
+  // If externally suspended while waiting, re-suspend
+  if (jt->handle_special_suspend_equivalent_condition()) {
+    jt->java_suspend_self();
+  }
+}
+
 void Parker::park(bool isAbsolute, jlong time) {
   // Ideally we'd do something useful while spinning, such
   // as calling unpackTime().
@@ -6323,6 +6660,10 @@ void Parker::park(bool isAbsolute, jlong time) {
   if (time < 0 || (isAbsolute && time == 0) ) { // don't wait at all
     return;
   }
+  if (UseFutexParker) {
+    park_futex(&_counter, jt, isAbsolute, time);
+    return;
+  }
   if (time > 0) {
     unpackTime(&absTime, isAbsolute, time);
   }
@@ -6400,6 +6741,12 @@ void Parker::park(bool isAbsolute, jlong time) {
 }
 
 void Parker::unpark() {
+  if (UseFutexParker) {
+    if (Atomic::xchg(1, &_counter) < 0) {
+      futex_wake(&_counter);
+    }
+    return;
+  }
   int s, status ;
   status = pthread_mutex_lock(_mutex);
   assert (status == 0, "invariant") ;
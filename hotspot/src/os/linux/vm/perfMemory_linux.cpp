@@ -42,6 +42,11 @@
 # include <sys/stat.h>
 # include <signal.h>
 # include <pwd.h>
+# include <sys/vfs.h>
+
+#ifndef TMPFS_MAGIC
+#define TMPFS_MAGIC 0x01021994
+#endif
 
 static char* backing_store_file_name = NULL;  // name of the backing store
                                               // file, if successfully created.
@@ -145,13 +150,38 @@ static void save_memory_to_file(char* addr, size_t size) {
 // which is always a local file system and is sometimes a RAM based file
 // system.
 
+// return the directory holding the user specific temporary directories.
+//
+// The counters in the backing store are updated every few milliseconds.
+// When the store lives on a disk backed file system those updates keep
+// its pages dirty and subject to writeback, which can stall the threads
+// that touch them. With PerfDataMemoryBackedStore the store is moved to
+// /dev/shm in that case.
+//
+static const char* get_perf_tmp_directory() {
+  static const char* perf_tmp_dir = NULL;
+  if (perf_tmp_dir == NULL) {
+    const char* tmpdir = os::get_temp_directory();
+    if (PerfDataMemoryBackedStore) {
+      struct statfs tmpfs_buf;
+      struct statfs shmfs_buf;
+      if (::statfs(tmpdir, &tmpfs_buf) == 0 && tmpfs_buf.f_type != TMPFS_MAGIC &&
+          ::statfs("/dev/shm", &shmfs_buf) == 0 && shmfs_buf.f_type == TMPFS_MAGIC) {
+        tmpdir = "/dev/shm";
+      }
+    }
+    perf_tmp_dir = tmpdir;
+  }
+  return perf_tmp_dir;
+}
+
 // return the user specific temporary directory name.
 //
 // the caller is expected to free the allocated memory.
 //
 static char* get_user_tmp_dir(const char* user) {
 
-  const char* tmpdir = os::get_temp_directory();
+  const char* tmpdir = get_perf_tmp_directory();
   const char* perfdir = PERFDATA_NAME;
   size_t nbytes = strlen(tmpdir) + strlen(perfdir) + strlen(user) + 3;
   char* dirname = NEW_C_HEAP_ARRAY(char, nbytes, mtInternal);
@@ -516,7 +546,7 @@ static char* get_user_name_slow(int vmid, TRAPS) {
   char* oldest_user = NULL;
   time_t oldest_ctime = 0;
 
-  const char* tmpdirname = os::get_temp_directory();
+  const char* tmpdirname = get_perf_tmp_directory();
 
   // open the temp directory
   DIR* tmpdirp = os::opendir(tmpdirname);
@@ -975,7 +1005,7 @@ static char* mmap_create_shared(size_t size) {
   (void)::memset((void*) mapAddress, 0, size);
 
   // it does not go through os api, the operation has to record from here
-  MemTracker::record_virtual_memory_reserve_and_commit((address)mapAddress, size, CURRENT_PC, mtInternal);
+  MemTracker::record_virtual_memory_reserve_and_commit((address)mapAddress, size, UNSAMPLED_CURRENT_PC, mtInternal);
 
   return mapAddress;
 }
@@ -1146,7 +1176,7 @@ static void mmap_attach_shared(const char* user, int vmid, PerfMemory::PerfMemor
   }
 
   // it does not go through os api, the operation has to record from here
-  MemTracker::record_virtual_memory_reserve_and_commit((address)mapAddress, size, CURRENT_PC, mtInternal);
+  MemTracker::record_virtual_memory_reserve_and_commit((address)mapAddress, size, UNSAMPLED_CURRENT_PC, mtInternal);
 
   *addr = mapAddress;
   *sizep = size;
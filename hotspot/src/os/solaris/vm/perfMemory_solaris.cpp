@@ -998,7 +998,7 @@ static char* mmap_create_shared(size_t size) {
 
   // it does not go through os api, the operation has to record from here
   MemTracker::record_virtual_memory_reserve_and_commit((address)mapAddress,
-    size, CURRENT_PC, mtInternal);
+    size, UNSAMPLED_CURRENT_PC, mtInternal);
 
   return mapAddress;
 }
@@ -1170,7 +1170,7 @@ static void mmap_attach_shared(const char* user, int vmid, PerfMemory::PerfMemor
 
   // it does not go through os api, the operation has to record from here
   MemTracker::record_virtual_memory_reserve_and_commit((address)mapAddress,
-    size, CURRENT_PC, mtInternal);
+    size, UNSAMPLED_CURRENT_PC, mtInternal);
 
   *addr = mapAddress;
   *sizep = size;
@@ -1493,7 +1493,7 @@ static char* mapping_create_shared(size_t size) {
 
   // it does not go through os api, the operation has to record from here
   MemTracker::record_virtual_memory_reserve_and_commit((address)mapAddress,
-    size, CURRENT_PC, mtInternal);
+    size, UNSAMPLED_CURRENT_PC, mtInternal);
 
   return (char*) mapAddress;
 }
@@ -1676,7 +1676,7 @@ static void open_file_mapping(const char* user, int vmid,
 
   // it does not go through os api, the operation has to record from here
   MemTracker::record_virtual_memory_reserve_and_commit((address)mapAddress, size,
-    CURRENT_PC, mtInternal);
+    UNSAMPLED_CURRENT_PC, mtInternal);
 
 
   *addrp = (char*)mapAddress;
@@ -27,6 +27,7 @@
 #include "classfile/classLoader.hpp"
 #include "classfile/systemDictionary.hpp"
 #include "classfile/vmSymbols.hpp"
+#include "code/codeCache.hpp"
 #include "code/icBuffer.hpp"
 #include "code/vtableStubs.hpp"
 #include "interpreter/interpreter.hpp"
@@ -36,6 +37,7 @@
 #include "prims/jvm.h"
 #include "prims/jvm_misc.hpp"
 #include "runtime/arguments.hpp"
+#include "runtime/atomic.inline.hpp"
 #include "runtime/frame.inline.hpp"
 #include "runtime/interfaceSupport.hpp"
 #include "runtime/java.hpp"
@@ -207,6 +209,87 @@ static address handle_unsafe_access(JavaThread* thread, address pc) {
   return npc;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// W^X mode switching
+//
+// Without UseLazyWX every switch requested by the shared code toggles the
+// thread's JIT write protection. With UseLazyWX a thread only switches to
+// write mode when it actually faults writing to the code cache, and then
+// stays there for all further code writes until it next asks for execute
+// mode. Most VM transitions never write code and so never toggle.
+
+enum {
+  wx_hw_unknown,
+  wx_hw_write,
+  wx_hw_exec
+};
+
+static __thread int wx_hw_mode = wx_hw_unknown;
+
+static volatile intptr_t wx_switch_count = 0;
+static volatile intptr_t wx_write_fault_count = 0;
+static volatile intptr_t wx_exec_fault_count = 0;
+
+static void set_wx_hw_mode(int mode) {
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunguarded-availability-new"
+  // pthread_jit_write_protect_np(mode == wx_hw_exec ? true : false);
+  jit_write_protect(mode == wx_hw_exec);
+#pragma clang diagnostic pop
+  wx_hw_mode = mode;
+  if (PrintWXStatistics) {
+    Atomic::add_ptr(1, &wx_switch_count);
+  }
+}
+
+void os::current_thread_enable_wx_impl(WXMode mode) {
+  if (!UseLazyWX) {
+    set_wx_hw_mode(mode == WXExec ? wx_hw_exec : wx_hw_write);
+  } else if (mode == WXExec || wx_hw_mode == wx_hw_unknown) {
+    // Write mode is deferred until the first fault on a code write.
+    if (wx_hw_mode != wx_hw_exec) {
+      set_wx_hw_mode(wx_hw_exec);
+    }
+  }
+}
+
+bool os::handle_lazy_wx_fault(address addr, address pc) {
+  if (!UseLazyWX || !CodeCache::contains(addr)) {
+    return false;
+  }
+  if (addr != pc && wx_hw_mode != wx_hw_write) {
+    // A code write in execute mode
+    set_wx_hw_mode(wx_hw_write);
+    if (PrintWXStatistics) {
+      Atomic::add_ptr(1, &wx_write_fault_count);
+    }
+    return true;
+  }
+  if (addr == pc && wx_hw_mode == wx_hw_write) {
+    // Running code in write mode, e.g. after a write fault outside the VM
+    set_wx_hw_mode(wx_hw_exec);
+    if (PrintWXStatistics) {
+      Atomic::add_ptr(1, &wx_exec_fault_count);
+    }
+    return true;
+  }
+  return false;
+}
+
+void os::print_wx_statistics(outputStream* st) {
+  if (!PrintWXStatistics) {
+    return;
+  }
+  double secs = MAX2(os::elapsedTime(), 0.001);
+  st->print_cr("W^X statistics (%s):", UseLazyWX ? "lazy" : "eager");
+  st->print_cr("  mode switches: " INTX_FORMAT_W(10) " (%.0f/s)",
+               wx_switch_count, wx_switch_count / secs);
+  st->print_cr("  write faults:  " INTX_FORMAT_W(10) " (%.0f/s)",
+               wx_write_fault_count, wx_write_fault_count / secs);
+  st->print_cr("  exec faults:   " INTX_FORMAT_W(10) " (%.0f/s)",
+               wx_exec_fault_count, wx_exec_fault_count / secs);
+}
+
 extern "C" JNIEXPORT int
 JVM_handle_bsd_signal(int sig,
                         siginfo_t* info,
@@ -243,6 +326,13 @@ JVM_handle_bsd_signal(int sig,
     }
   }
 
+  // A deferred W^X switch only needs the mode changed and a retry.
+  if ((sig == SIGSEGV || sig == SIGBUS) && info != NULL && uc != NULL &&
+      os::handle_lazy_wx_fault((address) info->si_addr,
+                               (address) os::Bsd::ucontext_get_pc(uc))) {
+    return 1;
+  }
+
   JavaThread* thread = NULL;
   VMThread* vmthread = NULL;
   if (os::Bsd::signal_handlers_are_installed) {
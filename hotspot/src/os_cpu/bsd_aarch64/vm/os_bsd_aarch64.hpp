@@ -56,14 +56,12 @@
 
 private:
 
-  static void current_thread_enable_wx_impl(WXMode mode) {
-#pragma clang diagnostic push
-#pragma clang diagnostic ignored "-Wunguarded-availability-new"
-    // pthread_jit_write_protect_np(mode == WXExec ? true : false);
-    jit_write_protect(mode == WXExec);
-#pragma clang diagnostic pop
-  }
+  static void current_thread_enable_wx_impl(WXMode mode);
 
 public:
 
+  // Handle a fault caused by a deferred W^X switch (UseLazyWX)
+  static bool handle_lazy_wx_fault(address addr, address pc);
+  static void print_wx_statistics(outputStream* st);
+
 #endif // OS_CPU_BSD_AARCH64_VM_OS_BSD_AARCH64_HPP
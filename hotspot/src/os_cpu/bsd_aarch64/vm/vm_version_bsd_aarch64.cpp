@@ -57,8 +57,23 @@ void VM_Version::get_os_cpu_info() {
 
   // Only few features are available via sysctl, see line 614
   // https://opensource.apple.com/source/xnu/xnu-6153.141.1/bsd/kern/kern_mib.c.auto.html
-  if (cpu_has("hw.optional.armv8_crc32"))     _cpuFeatures |= CPU_CRC32;
-  if (cpu_has("hw.optional.armv8_1_atomics")) _cpuFeatures |= CPU_LSE;
+  // Newer kernels also report hw.optional.arm.FEAT_* names.
+  if (cpu_has("hw.optional.armv8_crc32") ||
+      cpu_has("hw.optional.arm.FEAT_CRC32"))     _cpuFeatures |= CPU_CRC32;
+  if (cpu_has("hw.optional.armv8_1_atomics") ||
+      cpu_has("hw.optional.arm.FEAT_LSE"))       _cpuFeatures |= CPU_LSE;
+  if (cpu_has("hw.optional.arm.FEAT_AES"))       _cpuFeatures |= CPU_AES;
+  if (cpu_has("hw.optional.arm.FEAT_PMULL"))     _cpuFeatures |= CPU_PMULL;
+  if (cpu_has("hw.optional.arm.FEAT_SHA1"))      _cpuFeatures |= CPU_SHA1;
+  if (cpu_has("hw.optional.arm.FEAT_SHA256"))    _cpuFeatures |= CPU_SHA2;
+  if (cpu_has("hw.optional.armv8_2_sha512") ||
+      cpu_has("hw.optional.arm.FEAT_SHA512"))    _cpuFeatures |= CPU_SHA512;
+  if (cpu_has("hw.optional.armv8_2_sha3") ||
+      cpu_has("hw.optional.arm.FEAT_SHA3"))      _cpuFeatures |= CPU_SHA3;
+  if (cpu_has("hw.optional.arm.FEAT_DotProd"))   _cpuFeatures |= CPU_ASIMDDP;
+  if (cpu_has("hw.optional.neon_fp16") ||
+      cpu_has("hw.optional.arm.FEAT_FP16"))      _cpuFeatures |= CPU_FPHP | CPU_ASIMDHP;
+  if (cpu_has("hw.optional.arm.FEAT_DPB"))       _cpuFeatures |= CPU_DCPOP;
 
   int cache_line_size;
   int hw_conf_cache_line[] = { CTL_HW, HW_CACHELINE };
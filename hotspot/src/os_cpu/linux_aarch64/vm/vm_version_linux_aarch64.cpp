@@ -54,6 +54,14 @@
 #define HWCAP_ATOMICS (1<<8)
 #endif
 
+#ifndef HWCAP_FPHP
+#define HWCAP_FPHP (1<<9)
+#endif
+
+#ifndef HWCAP_ASIMDHP
+#define HWCAP_ASIMDHP (1<<10)
+#endif
+
 #ifndef HWCAP_DCPOP
 #define HWCAP_DCPOP (1<<16)
 #endif
@@ -62,6 +70,10 @@
 #define HWCAP_SHA3 (1 << 17)
 #endif
 
+#ifndef HWCAP_ASIMDDP
+#define HWCAP_ASIMDDP (1 << 20)
+#endif
+
 #ifndef HWCAP_SHA512
 #define HWCAP_SHA512 (1 << 21)
 #endif
@@ -80,9 +92,14 @@
 #define PR_SVE_GET_VL   51
 #endif
 
+#ifndef PR_SVE_VL_LEN_MASK
+#define PR_SVE_VL_LEN_MASK  0xffff
+#endif
+
 int VM_Version::get_current_sve_vector_length() {
   assert(_cpuFeatures & CPU_SVE, "should not call this");
-  return prctl(PR_SVE_GET_VL);
+  int result = prctl(PR_SVE_GET_VL);
+  return result < 0 ? result : (result & PR_SVE_VL_LEN_MASK);
 }
 
 int VM_Version::set_and_get_current_sve_vector_lenght(int length) {
@@ -105,7 +122,11 @@ void VM_Version::get_os_cpu_info() {
   STATIC_ASSERT(CPU_SHA2    == HWCAP_SHA2);
   STATIC_ASSERT(CPU_CRC32   == HWCAP_CRC32);
   STATIC_ASSERT(CPU_LSE     == HWCAP_ATOMICS);
+  STATIC_ASSERT(CPU_FPHP    == HWCAP_FPHP);
+  STATIC_ASSERT(CPU_ASIMDHP == HWCAP_ASIMDHP);
   STATIC_ASSERT(CPU_DCPOP   == HWCAP_DCPOP);
+  STATIC_ASSERT(CPU_SHA3    == HWCAP_SHA3);
+  STATIC_ASSERT(CPU_ASIMDDP == HWCAP_ASIMDDP);
   STATIC_ASSERT(CPU_SHA512  == HWCAP_SHA512);
   STATIC_ASSERT(CPU_SVE     == HWCAP_SVE);
   _cpuFeatures = auxv & (
@@ -118,12 +139,20 @@ void VM_Version::get_os_cpu_info() {
       HWCAP_SHA2    |
       HWCAP_CRC32   |
       HWCAP_ATOMICS |
+      HWCAP_FPHP    |
+      HWCAP_ASIMDHP |
       HWCAP_DCPOP   |
+      HWCAP_SHA3    |
+      HWCAP_ASIMDDP |
       HWCAP_SHA512  |
       HWCAP_SVE);
 
   if (auxv2 & HWCAP2_SVE2) _cpuFeatures |= CPU_SVE2;
 
+  if (_cpuFeatures & CPU_SVE) {
+    _initial_sve_vector_length = get_current_sve_vector_length();
+  }
+
   uint64_t ctr_el0;
   uint64_t dczid_el0;
   __asm__ (
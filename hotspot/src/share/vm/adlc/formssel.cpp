@@ -4141,6 +4141,10 @@ bool MatchRule::is_vector() const {
     "MulVS","MulVI","MulVF","MulVD",
     "DivVF","DivVD",
     "AndV" ,"XorV" ,"OrV",
+    "VectorCastI2F","VectorCastF2I",
+    "AddReductionVI", "AddReductionVL", "AddReductionVF", "AddReductionVD",
+    "MulReductionVI", "MulReductionVF", "MulReductionVD",
+    "AndReductionV", "OrReductionV", "XorReductionV", "MinReductionV", "MaxReductionV",
     "LShiftCntV","RShiftCntV",
     "LShiftVB","LShiftVS","LShiftVI","LShiftVL",
     "RShiftVB","RShiftVS","RShiftVI","RShiftVL",
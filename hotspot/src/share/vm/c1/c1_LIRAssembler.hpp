@@ -138,6 +138,15 @@ class LIR_Assembler: public CompilationResourceObj {
   // test for constants which can be encoded directly in instructions
   static bool is_small_constant(LIR_Opr opr);
 
+  // Log2 of the call profile sampling rate, 0 if every call is recorded.
+  static int profile_call_sample_log() {
+#if defined(AMD64) || defined(AARCH64)
+    return (int) MIN2(MAX2(C1ProfileCallSampleLog, (intx) 0), (intx) 10);
+#else
+    return 0;
+#endif
+  }
+
   static LIR_Opr receiverOpr();
   static LIR_Opr osrBufferPointer();
 
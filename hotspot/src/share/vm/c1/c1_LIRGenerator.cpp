@@ -3354,7 +3354,8 @@ void LIRGenerator::do_ProfileCall(ProfileCall* x) {
   // Need recv in a temporary register so it interferes with the other temporaries
   LIR_Opr recv = LIR_OprFact::illegalOpr;
   LIR_Opr mdo = new_register(T_METADATA);
-  // tmp is used to hold the counters on SPARC
+  // tmp is used to hold the counters on SPARC and the call profile
+  // sampling state on x86_64
   LIR_Opr tmp = new_pointer_register();
 
   if (x->nb_profiled_args() > 0) {
@@ -3435,6 +3436,7 @@ void LIRGenerator::increment_event_counter_impl(CodeEmitInfo* info,
 
   int offset = -1;
   LIR_Opr counter_holder = NULL;
+  LIR_Opr stripe = LIR_OprFact::illegalOpr;
   if (level == CompLevel_limited_profile) {
     MethodCounters* counters_adr = method->ensure_method_counters();
     if (counters_adr == NULL) {
@@ -3442,9 +3444,21 @@ void LIRGenerator::increment_event_counter_impl(CodeEmitInfo* info,
       return;
     }
     counter_holder = new_pointer_register();
-    __ move(LIR_OprFact::intptrConst(counters_adr), counter_holder);
-    offset = in_bytes(backedge ? MethodCounters::backedge_counter_offset() :
-                                 MethodCounters::invocation_counter_offset());
+    address stripes = NULL;
+    if (!backedge && UseStripedInvocationCounters) {
+      stripes = counters_adr->ensure_invocation_stripes();
+    }
+    if (stripes != NULL) {
+      // Count in the running thread's stripe, see MethodCounters
+      __ move(LIR_OprFact::intptrConst(stripes), counter_holder);
+      stripe = new_pointer_register();
+      __ move(new LIR_Address(getThreadPointer(), in_bytes(Thread::invocation_counter_stripe_offset()),
+                              stripe->type()), stripe);
+    } else {
+      __ move(LIR_OprFact::intptrConst(counters_adr), counter_holder);
+      offset = in_bytes(backedge ? MethodCounters::backedge_counter_offset() :
+                                   MethodCounters::invocation_counter_offset());
+    }
   } else if (level == CompLevel_full_profile) {
     counter_holder = new_register(T_METADATA);
     offset = in_bytes(backedge ? MethodData::backedge_counter_offset() :
@@ -3455,7 +3469,8 @@ void LIRGenerator::increment_event_counter_impl(CodeEmitInfo* info,
   } else {
     ShouldNotReachHere();
   }
-  LIR_Address* counter = new LIR_Address(counter_holder, offset, T_INT);
+  LIR_Address* counter = stripe->is_valid() ? new LIR_Address(counter_holder, stripe, T_INT)
+                                             : new LIR_Address(counter_holder, offset, T_INT);
   LIR_Opr result = new_register(T_INT);
   __ load(counter, result);
   __ add(result, LIR_OprFact::intConst(InvocationCounter::count_increment), result);
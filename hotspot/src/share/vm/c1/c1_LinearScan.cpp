@@ -52,17 +52,17 @@
 #endif
 
 
+static LinearScanTimers _total_timer;
+
+// helper macro for short definition of timer
+#define TIME_LINEAR_SCAN(timer_name)  TraceTime _block_timer("", _total_timer.timer(LinearScanTimers::timer_name), TimeLinearScan || TimeEachLinearScan || CITime, Verbose);
+
 #ifndef PRODUCT
 
   static LinearScanStatistic _stat_before_alloc;
   static LinearScanStatistic _stat_after_asign;
   static LinearScanStatistic _stat_final;
 
-  static LinearScanTimers _total_timer;
-
-  // helper macro for short definition of timer
-  #define TIME_LINEAR_SCAN(timer_name)  TraceTime _block_timer("", _total_timer.timer(LinearScanTimers::timer_name), TimeLinearScan || TimeEachLinearScan, Verbose);
-
   // helper macro for short definition of trace-output inside code
   #define TRACE_LINEAR_SCAN(level, code)       \
     if (TraceLinearScanLevel >= level) {       \
@@ -71,7 +71,6 @@
 
 #else
 
-  #define TIME_LINEAR_SCAN(timer_name)
   #define TRACE_LINEAR_SCAN(level, code)
 
 #endif
@@ -3032,7 +3031,7 @@ void LinearScan::assign_reg_num() {
 
 
 void LinearScan::do_linear_scan() {
-  NOT_PRODUCT(_total_timer.begin_method());
+  _total_timer.begin_method();
 
   number_instructions();
 
@@ -3092,18 +3091,18 @@ void LinearScan::do_linear_scan() {
 
   NOT_PRODUCT(print_lir(1, "Before Code Generation", false));
   NOT_PRODUCT(LinearScanStatistic::compute(this, _stat_final));
-  NOT_PRODUCT(_total_timer.end_method(this));
+  _total_timer.end_method(this);
 }
 
 
 // ********** Printing functions
 
-#ifndef PRODUCT
-
 void LinearScan::print_timers(double total) {
   _total_timer.print(total);
 }
 
+#ifndef PRODUCT
+
 void LinearScan::print_statistics() {
   _stat_before_alloc.print("before allocation");
   _stat_after_asign.print("after assignment of register");
@@ -6647,6 +6646,9 @@ void LinearScanStatistic::compute(LinearScan* allocator, LinearScanStatistic &gl
 }
 
 
+#endif // #ifndef PRODUCT
+
+
 // Implementation of LinearTimers
 
 LinearScanTimers::LinearScanTimers() {
@@ -6714,7 +6716,7 @@ void LinearScanTimers::end_method(LinearScan* allocator) {
 }
 
 void LinearScanTimers::print(double total_time) {
-  if (TimeLinearScan) {
+  if (TimeLinearScan || CITime) {
     // correction value: sum of dummy-timer that only measures the time that
     // is necesary to start and stop itself
     double c = timer(timer_do_nothing)->seconds();
@@ -6725,5 +6727,3 @@ void LinearScanTimers::print(double total_time) {
     }
   }
 }
-
-#endif // #ifndef PRODUCT
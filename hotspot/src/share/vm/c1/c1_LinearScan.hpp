@@ -407,8 +407,8 @@ class LinearScan : public CompilationResourceObj {
   // entry functions for printing
 #ifndef PRODUCT
   static void print_statistics();
-  static void print_timers(double total);
 #endif
+  static void print_timers(double total);
 };
 
 
@@ -932,6 +932,8 @@ class LinearScanStatistic : public StackObj {
   static void compute(LinearScan* allocator, LinearScanStatistic &global_statistic);
 };
 
+#endif // ifndef PRODUCT
+
 
 // Helper class for collecting compilation time of LinearScan
 class LinearScanTimers : public StackObj {
@@ -969,9 +971,6 @@ class LinearScanTimers : public StackObj {
 };
 
 
-#endif // ifndef PRODUCT
-
-
 // Pick up platform-dependent implementation details
 #ifdef TARGET_ARCH_x86
 # include "c1_LinearScan_x86.hpp"
@@ -320,6 +320,10 @@
   product(bool, C1ProfileVirtualCalls, true,                                \
           "Profile virtual calls when generating code for updating MDOs")   \
                                                                             \
+  product(intx, C1ProfileCallSampleLog, 0,                                  \
+          "Update call profiles for one in 2^n calls only, scaling the "    \
+          "counts (0 = every call, max 10, x86_64 and AArch64 only)")       \
+                                                                            \
   product(bool, C1ProfileInlinedCalls, true,                                \
           "Profile inlined calls when generating code for updating MDOs")   \
                                                                             \
@@ -38,7 +38,7 @@ private:
   friend class ciMethod;
   friend class ciMethodHandle;
 
-  enum { MorphismLimit = 2 }; // Max call site's morphism we care about
+  enum { MorphismLimit = 4 }; // Max call site's morphism we care about
   int  _limit;                // number of receivers have been determined
   int  _morphism;             // determined call site's morphism
   int  _count;                // # times has this call been executed
@@ -85,7 +85,7 @@ public:
     assert(scale >= 0 && scale <= 1.0, "out of range");
     ciCallProfile call = *this;
     call._count = (int)(call._count * scale);
-    for (int i = 0; i < _morphism; i++) {
+    for (int i = 0; i < _limit; i++) {
       call._receiver_count[i] = (int)(call._receiver_count[i] * scale);
     }
     return call;
@@ -523,10 +523,12 @@ ciCallProfile ciMethod::call_profile_at_bci(int bci) {
         // The call site count is 0 with known morphism (onlt 1 or 2 receivers)
         // or < 0 in the case of a type check failured for checkcast, aastore, instanceof.
         // The call site count is > 0 in the case of a polymorphic virtual call.
+        // Only a full profile with no further receivers counted is exact.
+        int morphism_limit = MIN2((int)ciCallProfile::MorphismLimit, (int)call->row_limit());
         if (morphism > 0 && morphism == result._limit) {
            // The morphism <= MorphismLimit.
-           if ((morphism <  ciCallProfile::MorphismLimit) ||
-               (morphism == ciCallProfile::MorphismLimit && count == 0)) {
+           if ((morphism <  morphism_limit) ||
+               (morphism == morphism_limit && count == 0)) {
 #ifdef ASSERT
              if (count > 0) {
                this->print_short_name(tty);
@@ -34,12 +34,14 @@
 #if INCLUDE_CDS
 #include "classfile/systemDictionaryShared.hpp"
 #endif
+#include "classfile/verificationCache.hpp"
 #include "classfile/verificationType.hpp"
 #include "classfile/verifier.hpp"
 #include "classfile/vmSymbols.hpp"
 #include "memory/allocation.hpp"
 #include "memory/gcLocker.hpp"
 #include "memory/metadataFactory.hpp"
+#include "memory/metaspaceAllocationBuffer.hpp"
 #include "memory/oopFactory.hpp"
 #include "memory/referenceType.hpp"
 #include "memory/universe.inline.hpp"
@@ -3286,6 +3288,150 @@ class FieldLayoutInfo : public StackObj {
 };
 
 // Layout fields and fill in FieldLayoutInfo.  Could use more refactoring!
+// A range of bytes in an instance, used by the dense field layout.
+class FieldGap VALUE_OBJ_CLASS_SPEC {
+ public:
+  int _start;
+  int _end;
+
+  FieldGap() : _start(0), _end(0) { }
+  FieldGap(int start, int end) : _start(start), _end(end) { }
+};
+
+static int compare_field_gaps(FieldGap* a, FieldGap* b) {
+  return a->_start - b->_start;
+}
+
+static int compare_offsets(int* a, int* b) {
+  return *a - *b;
+}
+
+static int nonstatic_field_size_in_bytes(BasicType type) {
+  return (type == T_OBJECT || type == T_ARRAY) ? heapOopSize : type2aelembytes(type);
+}
+
+static bool has_contended_layout(InstanceKlass* klass) {
+  for (InstanceKlass* k = klass; k != NULL; k = k->superklass()) {
+    if (k->is_contended()) {
+      return true;
+    }
+    for (AllFieldStream fs(k); !fs.done(); fs.next()) {
+      if (fs.is_contended()) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+// Returns the offset for a field of the given size, aligned to its size:
+// the first gap it fits in, or else the end of the fields, recording the
+// alignment gap that leaves.
+static int allocate_dense_field(GrowableArray<FieldGap>* gaps, int* fields_end, int size) {
+  for (int i = 0; i < gaps->length(); i++) {
+    const int start = gaps->at(i)._start;
+    const int end = gaps->at(i)._end;
+    const int offset = align_size_up(start, size);
+    if (offset + size <= end) {
+      if (offset > start) {
+        gaps->at_put(i, FieldGap(start, offset));
+        if (offset + size < end) {
+          gaps->insert_before(i + 1, FieldGap(offset + size, end));
+        }
+      } else if (offset + size < end) {
+        gaps->at_put(i, FieldGap(offset + size, end));
+      } else {
+        gaps->remove_at(i);
+      }
+      return offset;
+    }
+  }
+  const int offset = align_size_up(*fields_end, size);
+  if (offset > *fields_end) {
+    gaps->append(FieldGap(*fields_end, offset));
+  }
+  *fields_end = offset + size;
+  return offset;
+}
+
+int ClassFileParser::layout_dense_fields(int nonstatic_fields_start,
+                                         int* nonstatic_oop_offsets,
+                                         unsigned int* nonstatic_oop_counts,
+                                         unsigned int* nonstatic_oop_map_count,
+                                         int* first_nonstatic_oop_offset) {
+  // Find the gaps between the header and the end of the superclass
+  // fields from the offsets of the inherited fields.
+  GrowableArray<FieldGap>* used = new GrowableArray<FieldGap>(16);
+  for (InstanceKlass* k = _super_klass(); k != NULL; k = k->superklass()) {
+    for (AllFieldStream fs(k); !fs.done(); fs.next()) {
+      if (!fs.access_flags().is_static()) {
+        int size = nonstatic_field_size_in_bytes(FieldType::basic_type(fs.signature()));
+        used->append(FieldGap(fs.offset(), fs.offset() + size));
+      }
+    }
+  }
+  used->sort(compare_field_gaps);
+
+  GrowableArray<FieldGap>* gaps = new GrowableArray<FieldGap>(16);
+  int pos = instanceOopDesc::base_offset_in_bytes();
+  for (int i = 0; i < used->length(); i++) {
+    if (used->at(i)._start > pos) {
+      gaps->append(FieldGap(pos, used->at(i)._start));
+    }
+    pos = MAX2(pos, used->at(i)._end);
+  }
+  if (pos < nonstatic_fields_start) {
+    gaps->append(FieldGap(pos, nonstatic_fields_start));
+  }
+
+  // Allocate the primitive fields largest first, so that the smaller
+  // ones fill what the larger ones leave, then the oops. The oops that
+  // do not fit into a gap end up next to each other at the end.
+  static const FieldAllocationType order[] = {
+    NONSTATIC_DOUBLE, NONSTATIC_WORD, NONSTATIC_SHORT, NONSTATIC_BYTE, NONSTATIC_OOP
+  };
+  static const BasicType types[] = {
+    T_LONG, T_INT, T_SHORT, T_BYTE, T_OBJECT
+  };
+  GrowableArray<int>* oop_offsets = new GrowableArray<int>(8);
+  int fields_end = nonstatic_fields_start;
+  for (size_t i = 0; i < ARRAY_SIZE(order); i++) {
+    const int size = nonstatic_field_size_in_bytes(types[i]);
+    for (AllFieldStream fs(_fields, _cp); !fs.done(); fs.next()) {
+      if (fs.access_flags().is_static() || fs.is_offset_set() ||
+          (FieldAllocationType) fs.allocation_type() != order[i]) {
+        continue;
+      }
+      int offset = allocate_dense_field(gaps, &fields_end, size);
+      fs.set_offset(offset);
+      if (order[i] == NONSTATIC_OOP) {
+        oop_offsets->append(offset);
+      }
+    }
+  }
+
+  // Build the oop maps from the sorted oop offsets.
+  oop_offsets->sort(compare_offsets);
+  unsigned int map_count = 0;
+  for (int i = 0; i < oop_offsets->length(); i++) {
+    int offset = oop_offsets->at(i);
+    if (map_count > 0 &&
+        nonstatic_oop_offsets[map_count - 1] +
+        int(nonstatic_oop_counts[map_count - 1]) * heapOopSize == offset) {
+      nonstatic_oop_counts[map_count - 1] += 1;
+    } else {
+      nonstatic_oop_offsets[map_count] = offset;
+      nonstatic_oop_counts[map_count] = 1;
+      map_count++;
+    }
+  }
+  *nonstatic_oop_map_count = map_count;
+  if (map_count > 0) {
+    *first_nonstatic_oop_offset = nonstatic_oop_offsets[0];
+  }
+  return fields_end;
+}
+
 void ClassFileParser::layout_fields(Handle class_loader,
                                     FieldAllocationCount* fac,
                                     ClassAnnotationCollector* parsed_annotations,
@@ -3427,6 +3573,25 @@ void ClassFileParser::layout_fields(Handle class_loader,
     compact_fields   = false; // Don't compact fields
   }
 
+  // The dense layout places all nonstatic fields here, unless the
+  // padding for @Contended must be kept.
+  bool dense_layout = DenseFieldLayout && compact_fields &&
+                      nonstatic_contended_count == 0 && !is_contended_class &&
+                      !has_contended_layout(_super_klass());
+  int dense_fields_end = 0;
+  if (dense_layout) {
+    dense_fields_end = layout_dense_fields(next_nonstatic_field_offset,
+                                           nonstatic_oop_offsets,
+                                           nonstatic_oop_counts,
+                                           &nonstatic_oop_map_count,
+                                           &first_nonstatic_oop_offset);
+    nonstatic_double_count = 0;
+    nonstatic_word_count   = 0;
+    nonstatic_short_count  = 0;
+    nonstatic_byte_count   = 0;
+    nonstatic_oop_count    = 0;
+  }
+
   // Rearrange fields for a given allocation style
   if( allocation_style == 0 ) {
     // Fields order: oops, longs/doubles, ints, shorts/chars, bytes, padded fields
@@ -3527,6 +3692,10 @@ void ClassFileParser::layout_fields(Handle class_loader,
     next_nonstatic_padded_offset = next_nonstatic_oop_offset + (nonstatic_oop_count * heapOopSize);
   }
 
+  if (dense_layout) {
+    next_nonstatic_padded_offset = dense_fields_end;
+  }
+
   // Iterate over fields again and compute correct offsets.
   // The field allocation type was temporarily stored in the offset slot.
   // oop fields are located before non-oop fields (static and non-static).
@@ -3851,6 +4020,10 @@ instanceKlassHandle ClassFileParser::parseClassFile(Symbol* name,
                             jt->get_thread_stat()->perf_timers_addr(),
                             PerfClassTraceTime::PARSE_CLASS);
 
+  // Allocate this class's metadata from a thread-local buffer; the unused
+  // remainder goes back to the loader's metaspace when parsing is done.
+  MetaspaceAllocationBufferMark mabm(THREAD, loader_data);
+
   init_parsed_class_attributes(loader_data);
 
   if (JvmtiExport::should_post_class_file_load_hook()) {
@@ -4045,8 +4218,13 @@ instanceKlassHandle ClassFileParser::parseClassFile(Symbol* name,
     }
 #if INCLUDE_CDS
     if (DumpLoadedClassList != NULL && cfs->source() != NULL && classlist_file->is_open()) {
-      // Only dump the classes that can be stored into CDS archive
-      if (SystemDictionaryShared::is_sharing_possible(loader_data)) {
+      // Only dump the classes that can be stored into CDS archive, and
+      // the application's classes if they are wanted for preloading.
+      // -Xshare:dump skips the names it cannot find on the boot class path.
+      oop loader = loader_data->class_loader();
+      if (SystemDictionaryShared::is_sharing_possible(loader_data) ||
+          (DumpLoadedAppClasses && loader != NULL &&
+           loader == SystemDictionary::java_system_loader())) {
         if (name != NULL) {
           ResourceMark rm(THREAD);
           classlist_file->print_cr("%s", name->as_C_string());
@@ -4206,6 +4384,11 @@ instanceKlassHandle ClassFileParser::parseClassFile(Symbol* name,
 
     // Fill in information already parsed
     this_klass->set_should_verify_class(verify);
+    if (UseVerificationCache && _need_verify && !DumpSharedSpaces &&
+        host_klass.is_null()) {
+      this_klass->set_verification_cache_entry(
+        VerificationCache::lookup_or_add(stream()->buffer(), stream()->length()));
+    }
     jint lh = Klass::instance_layout_helper(info.instance_size, false);
     this_klass->set_layout_helper(lh);
     assert(this_klass->oop_is_instance(), "layout is correct");
@@ -4487,7 +4670,8 @@ ClassFileParser::compute_oop_map_count(instanceKlassHandle super,
         nonstatic_oop_map_count -= 1;
       } else {
         // Superklass didn't end with a oop field, add extra maps
-        assert(next_offset < first_nonstatic_oop_offset, "just checking");
+        assert(next_offset < first_nonstatic_oop_offset || DenseFieldLayout,
+               "just checking");
       }
       map_count += nonstatic_oop_map_count;
     }
@@ -4962,23 +5146,8 @@ void ClassFileParser::verify_legal_method_modifiers(
 
 void ClassFileParser::verify_legal_utf8(const unsigned char* buffer, int length, TRAPS) {
   assert(_need_verify, "only called when _need_verify is true");
-  int i = 0;
-  int count = length >> 2;
-  for (int k=0; k<count; k++) {
-    unsigned char b0 = buffer[i];
-    unsigned char b1 = buffer[i+1];
-    unsigned char b2 = buffer[i+2];
-    unsigned char b3 = buffer[i+3];
-    // For an unsigned char v,
-    // (v | v - 1) is < 128 (highest bit 0) for 0 < v < 128;
-    // (v | v - 1) is >= 128 (highest bit 1) for v == 0 or v >= 128.
-    unsigned char res = b0 | b0 - 1 |
-                        b1 | b1 - 1 |
-                        b2 | b2 - 1 |
-                        b3 | b3 - 1;
-    if (res >= 128) break;
-    i += 4;
-  }
+  // Most names are plain ascii, which is checked a word at a time.
+  int i = UTF8::ascii_prefix_length(buffer, length);
   for(; i < length; i++) {
     unsigned short c;
     // no embedded zeros
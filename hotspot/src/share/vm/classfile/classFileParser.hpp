@@ -467,6 +467,14 @@ PRAGMA_DIAG_POP
                      ClassAnnotationCollector* parsed_annotations,
                      FieldLayoutInfo* info, TRAPS);
 
+  // lays out the nonstatic fields for DenseFieldLayout and returns the
+  // end of the fields
+  int layout_dense_fields(int nonstatic_fields_start,
+                          int* nonstatic_oop_offsets,
+                          unsigned int* nonstatic_oop_counts,
+                          unsigned int* nonstatic_oop_map_count,
+                          int* first_nonstatic_oop_offset);
+
  public:
   // Constructor
   ClassFileParser(ClassFileStream* st)
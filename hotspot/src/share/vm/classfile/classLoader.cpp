@@ -50,6 +50,7 @@
 #include "oops/symbol.hpp"
 #include "prims/jvm_misc.hpp"
 #include "runtime/arguments.hpp"
+#include "runtime/atomic.inline.hpp"
 #include "runtime/compilationPolicy.hpp"
 #include "runtime/fprofiler.hpp"
 #include "runtime/handles.hpp"
@@ -92,6 +93,7 @@ typedef jzentry* (JNICALL *FindEntry_t)(jzfile *zip, const char *name, jint *siz
 typedef jboolean (JNICALL *ReadEntry_t)(jzfile *zip, jzentry *entry, unsigned char *buf, char *namebuf);
 typedef jboolean (JNICALL *ReadMappedEntry_t)(jzfile *zip, jzentry *entry, unsigned char **buf, char *namebuf);
 typedef jzentry* (JNICALL *GetNextEntry_t)(jzfile *zip, jint n);
+typedef jint     (JNICALL *ForEachEntryName_t)(jzfile *zip, void (*f)(const char *name, jint nlen, void *context), void *context);
 typedef jint     (JNICALL *Crc32_t)(jint crc, const jbyte *buf, jint len);
 
 static ZipOpen_t         ZipOpen            = NULL;
@@ -100,6 +102,7 @@ static FindEntry_t       FindEntry          = NULL;
 static ReadEntry_t       ReadEntry          = NULL;
 static ReadMappedEntry_t ReadMappedEntry    = NULL;
 static GetNextEntry_t    GetNextEntry       = NULL;
+static ForEachEntryName_t ForEachEntryName  = NULL;
 static canonicalize_fn_t CanonicalizeEntry  = NULL;
 static Crc32_t           Crc32              = NULL;
 
@@ -311,11 +314,118 @@ ClassFileStream* ClassPathDirEntry::open_stream(const char* name, TRAPS) {
 }
 
 
+// Set of hashes of the package names that occur in a jar file. It is used
+// to skip the jar file, without a call into the zip library, when looking
+// up a class in a package the jar file has no entries in. Hash collisions
+// only cause a lookup that would have happened anyway.
+class ClassPathPackageIndex: public CHeapObj<mtClass> {
+ private:
+  juint* _slots;             // Open-addressed hashes, 0 marks a free slot
+  juint  _mask;              // Number of slots - 1
+  juint  _count;             // Number of distinct hashes
+  bool   _failed;            // Out of memory while adding
+
+  // Hash of the package part (up to the last '/') of an entry name
+  static juint package_hash(const char* name, int len) {
+    int plen = 0;
+    for (int i = 0; i < len; i++) {
+      if (name[i] == '/') {
+        plen = i;
+      }
+    }
+    juint h = 0;
+    for (int i = 0; i < plen; i++) {
+      h = 31 * h + (unsigned char)name[i];
+    }
+    h ^= h >> 16;
+    h *= 0x85ebca6b;
+    h ^= h >> 13;
+    return h == 0 ? 1 : h;
+  }
+
+  void insert(juint h) {
+    juint i = h & _mask;
+    while (_slots[i] != 0) {
+      if (_slots[i] == h) {
+        return;
+      }
+      i = (i + 1) & _mask;
+    }
+    _slots[i] = h;
+    _count++;
+  }
+
+  bool grow() {
+    juint old_size = _mask + 1;
+    juint* old_slots = _slots;
+    juint* new_slots = NEW_C_HEAP_ARRAY_RETURN_NULL(juint, old_size * 2, mtClass);
+    if (new_slots == NULL) {
+      return false;
+    }
+    memset(new_slots, 0, old_size * 2 * sizeof(juint));
+    _slots = new_slots;
+    _mask = old_size * 2 - 1;
+    _count = 0;
+    for (juint i = 0; i < old_size; i++) {
+      if (old_slots[i] != 0) {
+        insert(old_slots[i]);
+      }
+    }
+    FREE_C_HEAP_ARRAY(juint, old_slots, mtClass);
+    return true;
+  }
+
+ public:
+  enum { initial_size = 64 };
+
+  ClassPathPackageIndex() : _mask(initial_size - 1), _count(0), _failed(false) {
+    _slots = NEW_C_HEAP_ARRAY_RETURN_NULL(juint, initial_size, mtClass);
+    if (_slots == NULL) {
+      _failed = true;
+    } else {
+      memset(_slots, 0, initial_size * sizeof(juint));
+    }
+  }
+
+  ~ClassPathPackageIndex() {
+    if (_slots != NULL) {
+      FREE_C_HEAP_ARRAY(juint, _slots, mtClass);
+    }
+  }
+
+  bool failed() const { return _failed; }
+
+  // Called from the zip library, in native state, for every entry name
+  static void add_entry_name(const char* name, jint len, void* context) {
+    ClassPathPackageIndex* index = (ClassPathPackageIndex*)context;
+    if (index->_failed) {
+      return;
+    }
+    if (index->_count * 2 >= index->_mask && !index->grow()) {
+      index->_failed = true;
+      return;
+    }
+    index->insert(package_hash(name, len));
+  }
+
+  bool contains_package_of(const char* name) const {
+    juint h = package_hash(name, (int)strlen(name));
+    for (juint i = h & _mask; _slots[i] != 0; i = (i + 1) & _mask) {
+      if (_slots[i] == h) {
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
 ClassPathZipEntry::ClassPathZipEntry(jzfile* zip, const char* zip_name) : ClassPathEntry() {
   _zip = zip;
   char *copy = NEW_C_HEAP_ARRAY(char, strlen(zip_name)+1, mtClass);
   strcpy(copy, zip_name);
   _zip_name = copy;
+  _package_index = NULL;
+  _no_package_index = false;
 }
 
 ClassPathZipEntry::~ClassPathZipEntry() {
@@ -323,6 +433,48 @@ ClassPathZipEntry::~ClassPathZipEntry() {
     (*ZipClose)(_zip);
   }
   FREE_C_HEAP_ARRAY(char, _zip_name, mtClass);
+  delete _package_index;
+}
+
+ClassPathPackageIndex* ClassPathZipEntry::package_index() {
+  ClassPathPackageIndex* index =
+    (ClassPathPackageIndex*)OrderAccess::load_ptr_acquire(&_package_index);
+  if (index != NULL || _no_package_index) {
+    return index;
+  }
+  if (ForEachEntryName == NULL) {
+    _no_package_index = true;
+    return NULL;
+  }
+
+  index = new ClassPathPackageIndex();
+  jint count = -1;
+  if (!index->failed()) {
+    // enable call to C land
+    JavaThread* thread = JavaThread::current();
+    ThreadToNativeFromVM ttn(thread);
+    Thread::WXExecFromWriteSetter wx_exec;
+    count = (*ForEachEntryName)(_zip, ClassPathPackageIndex::add_entry_name, index);
+  }
+  if (count < 0 || index->failed()) {
+    delete index;
+    _no_package_index = true;
+    return NULL;
+  }
+
+  // Racing threads build identical indexes; keep the first one published
+  ClassPathPackageIndex* prev =
+    (ClassPathPackageIndex*)Atomic::cmpxchg_ptr(index, &_package_index, NULL);
+  if (prev != NULL) {
+    delete index;
+    return prev;
+  }
+  return index;
+}
+
+bool ClassPathZipEntry::may_contain(const char* name) {
+  ClassPathPackageIndex* index = package_index();
+  return index == NULL || index->contains_package_of(name);
 }
 
 u1* ClassPathZipEntry::open_entry(const char* name, jint* filesize, bool nul_terminate, TRAPS) {
@@ -361,6 +513,9 @@ u1* ClassPathZipEntry::open_entry(const char* name, jint* filesize, bool nul_ter
 }
 
 ClassFileStream* ClassPathZipEntry::open_stream(const char* name, TRAPS) {
+  if (UseClassPathPackageIndex && !may_contain(name)) {
+    return NULL;
+  }
   jint filesize;
   u1* buffer = open_entry(name, &filesize, false, CHECK_NULL);
   if (buffer == NULL) {
@@ -882,6 +1037,7 @@ void ClassLoader::load_zip_library() {
   ReadEntry    = CAST_TO_FN_PTR(ReadEntry_t, os::dll_lookup(handle, "ZIP_ReadEntry"));
   ReadMappedEntry = CAST_TO_FN_PTR(ReadMappedEntry_t, os::dll_lookup(handle, "ZIP_ReadMappedEntry"));
   GetNextEntry = CAST_TO_FN_PTR(GetNextEntry_t, os::dll_lookup(handle, "ZIP_GetNextEntry"));
+  ForEachEntryName = CAST_TO_FN_PTR(ForEachEntryName_t, os::dll_lookup(handle, "ZIP_ForEachEntryName"));
   Crc32        = CAST_TO_FN_PTR(Crc32_t, os::dll_lookup(handle, "ZIP_CRC32"));
 
   // ZIP_Close is not exported on Windows in JDK5.0 so don't abort if ZIP_Close is NULL
@@ -100,10 +100,16 @@ typedef struct {
 } jzentry;
 
 
+class ClassPathPackageIndex;
+
 class ClassPathZipEntry: public ClassPathEntry {
  private:
   jzfile* _zip;              // The zip archive
   const char*   _zip_name;   // Name of zip archive
+  // Packages with entries in the archive, built on the first lookup
+  ClassPathPackageIndex* volatile _package_index;
+  bool _no_package_index;    // The index could not be built
+  ClassPathPackageIndex* package_index();
  public:
   bool is_jar_file()  { return true;  }
   const char* name()  { return _zip_name; }
@@ -111,6 +117,8 @@ class ClassPathZipEntry: public ClassPathEntry {
   virtual ~ClassPathZipEntry();
   u1* open_entry(const char* name, jint* filesize, bool nul_terminate, TRAPS);
   ClassFileStream* open_stream(const char* name, TRAPS);
+  // False only if the archive has no entry in the package of name
+  bool may_contain(const char* name);
   void contents_do(void f(const char* name, void* context), void* context);
   // Debugging
   NOT_PRODUCT(void compile_the_world(Handle loader, TRAPS);)
@@ -59,6 +59,7 @@
 #include "memory/oopFactory.hpp"
 #include "runtime/jniHandles.hpp"
 #include "runtime/mutex.hpp"
+#include "runtime/mutexLocker.hpp"
 #include "runtime/safepoint.hpp"
 #include "runtime/synchronizer.hpp"
 #include "utilities/growableArray.hpp"
@@ -78,6 +79,7 @@ ClassLoaderData::ClassLoaderData(Handle h_class_loader, bool is_anonymous, Depen
   // The null-class-loader should always be kept alive.
   _keep_alive(is_anonymous || h_class_loader.is_null()),
   _metaspace(NULL), _unloading(false), _klasses(NULL),
+  _locked_lookups(0), _contended_lookups(0), _dictionary_entries(NULL),
   _claimed(0), _jmethod_ids(NULL), _handles(), _deallocate_list(NULL),
   _next(NULL), _dependencies(dependencies),
   _metaspace_lock(new Mutex(Monitor::leaf+1, "Metaspace allocation lock", true)) {
@@ -86,6 +88,14 @@ ClassLoaderData::ClassLoaderData(Handle h_class_loader, bool is_anonymous, Depen
   CRS_ONLY(CRS_INIT_ID(this);)
 }
 
+void ClassLoaderData::record_locked_lookup(bool contended) {
+  assert_lock_strong(SystemDictionary_lock);
+  _locked_lookups++;
+  if (contended) {
+    _contended_lookups++;
+  }
+}
+
 void ClassLoaderData::init_dependencies(TRAPS) {
   assert(!Universe::is_fully_initialized(), "should only be called when initializing");
   assert(is_the_null_class_loader_data(), "should only call this for the null class loader");
@@ -571,6 +581,7 @@ ClassLoaderData* ClassLoaderDataGraph::_saved_unloading = NULL;
 ClassLoaderData* ClassLoaderDataGraph::_saved_head = NULL;
 
 bool ClassLoaderDataGraph::_should_purge = false;
+volatile bool ClassLoaderDataGraph::_should_purge_metaspace = false;
 
 // Add a new class loader data node to the list.  Assign the newly created
 // ClassLoaderData into the java/lang/ClassLoader object as a hidden field
@@ -825,6 +836,34 @@ void ClassLoaderDataGraph::purge() {
     next = purge_me->next();
     delete purge_me;
   }
+  _should_purge_metaspace = false;
+  Metaspace::purge();
+}
+
+ClassLoaderData* ClassLoaderDataGraph::detach_unloading() {
+  ClassLoaderData* list = _unloading;
+  _unloading = NULL;
+  _saved_unloading = NULL;
+  return list;
+}
+
+void ClassLoaderDataGraph::purge_detached(ClassLoaderData* list) {
+  assert(!SafepointSynchronize::is_at_safepoint(), "use purge() at a safepoint");
+  if (list == NULL) {
+    return;
+  }
+  ClassLoaderData* next = list;
+  while (next != NULL) {
+    ClassLoaderData* purge_me = next;
+    next = purge_me->next();
+    delete purge_me;
+  }
+  _should_purge_metaspace = true;
+}
+
+void ClassLoaderDataGraph::purge_metaspace() {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint!");
+  _should_purge_metaspace = false;
   Metaspace::purge();
 }
 
@@ -53,6 +53,7 @@
 // for root tracing and other GC operations.
 
 class ClassLoaderData;
+class DictionaryEntry;
 class JNIMethodBlock;
 class Metadebug;
 
@@ -71,6 +72,9 @@ class ClassLoaderDataGraph : public AllStatic {
   static ClassLoaderData* _saved_head;
   static ClassLoaderData* _saved_unloading;
   static bool _should_purge;
+  // Set when CLDs have been deleted outside of a safepoint and the
+  // metaspace still needs to release the virtual space they left empty.
+  static volatile bool _should_purge_metaspace;
 
   static ClassLoaderData* add(Handle class_loader, bool anonymous, TRAPS);
   static void clean_metaspaces();
@@ -106,9 +110,23 @@ class ClassLoaderDataGraph : public AllStatic {
       purge();
       // reset for next time.
       set_should_purge(false);
+    } else if (_should_purge_metaspace) {
+      purge_metaspace();
     }
   }
 
+  // Support for ConcurrentClassLoaderDataPurge.
+  // Take the CLDs off the unloading list so that purge_detached() can
+  // delete them outside of a safepoint.  The caller must keep safepoints
+  // from running concurrently, e.g. by being at one or by holding the
+  // CMS token.
+  static ClassLoaderData* detach_unloading();
+  // Delete the detached CLDs and their metaspaces.  Nothing can reach
+  // them any more, so no safepoint is needed.  Releasing the virtual
+  // space left empty is done at the next safepoint.
+  static void purge_detached(ClassLoaderData* list);
+  static void purge_metaspace();
+
   static void free_deallocate_lists();
 
   static void dump_on(outputStream * const out) PRODUCT_RETURN;
@@ -190,6 +208,19 @@ class ClassLoaderData : public CHeapObj<mtClass> {
                            // Has to be an int because we cas it.
   Klass* _klasses;         // The classes defined by the class loader.
 
+  // Dictionary lookups for this loader that had to take
+  // SystemDictionary_lock, and how many of them found it taken.
+  // Updated under that lock.
+  uintx _locked_lookups;
+  uintx _contended_lookups;
+
+  // The system dictionary entries with this class loader as the initiating
+  // loader, linked through DictionaryEntry::next_in_loader(), so that they
+  // can be purged without walking the whole dictionary when the loader
+  // dies. Not kept for the null class loader. Updated under
+  // SystemDictionary_lock or at a safepoint.
+  DictionaryEntry* _dictionary_entries;
+
   ChunkedHandleList _handles; // Handles to constant pool arrays, etc, which
                               // have the same life cycle of the corresponding ClassLoader.
 
@@ -298,6 +329,14 @@ class ClassLoaderData : public CHeapObj<mtClass> {
 
   void classes_do(KlassClosure* klass_closure);
 
+  DictionaryEntry* dictionary_entries() const           { return _dictionary_entries; }
+  DictionaryEntry** dictionary_entries_addr()           { return &_dictionary_entries; }
+  void set_dictionary_entries(DictionaryEntry* entries) { _dictionary_entries = entries; }
+
+  uintx locked_lookups() const     { return _locked_lookups; }
+  uintx contended_lookups() const  { return _contended_lookups; }
+  void record_locked_lookup(bool contended);
+
   JNIMethodBlock* jmethod_ids() const              { return _jmethod_ids; }
   void set_jmethod_ids(JNIMethodBlock* new_block)  { _jmethod_ids = new_block; }
 
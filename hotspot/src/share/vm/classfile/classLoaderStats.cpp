@@ -75,6 +75,11 @@ void ClassLoaderStatsClosure::do_cld(ClassLoaderData* cld) {
   }
   _total_classes += csc._num_classes;
 
+  cls->_locked_lookups += cld->locked_lookups();
+  cls->_contended_lookups += cld->contended_lookups();
+  _total_locked_lookups += cld->locked_lookups();
+  _total_contended_lookups += cld->contended_lookups();
+
   Metaspace* ms = cld->metaspace_or_null();
   if (ms != NULL) {
     if(cld->is_anonymous()) {
@@ -102,10 +107,12 @@ bool ClassLoaderStatsClosure::do_entry(oop const& key, ClassLoaderStats* const&
   Klass* class_loader_klass = (cls->_class_loader == NULL ? NULL : cls->_class_loader->klass());
   Klass* parent_klass = (cls->_parent == NULL ? NULL : cls->_parent->klass());
 
-  _out->print(INTPTR_FORMAT "  " INTPTR_FORMAT "  " INTPTR_FORMAT "  " UINTX_FORMAT_W(6) "  " SIZE_FORMAT_W(8) "  " SIZE_FORMAT_W(8) "  ",
+  _out->print(INTPTR_FORMAT "  " INTPTR_FORMAT "  " INTPTR_FORMAT "  " UINTX_FORMAT_W(6) "  " SIZE_FORMAT_W(8) "  " SIZE_FORMAT_W(8) "  "
+              UINTX_FORMAT_W(8) "  " UINTX_FORMAT_W(9) "  ",
       p2i(class_loader_klass), p2i(parent_klass), p2i(cls->_cld),
       cls->_classes_count,
-      cls->_chunk_sz, cls->_block_sz);
+      cls->_chunk_sz, cls->_block_sz,
+      cls->_locked_lookups, cls->_contended_lookups);
   if (class_loader_klass != NULL) {
     _out->print("%s", class_loader_klass->external_name());
   } else {
@@ -123,16 +130,20 @@ bool ClassLoaderStatsClosure::do_entry(oop const& key, ClassLoaderStats* const&
 
 
 void ClassLoaderStatsClosure::print() {
-  _out->print_cr("ClassLoader" SPACE " Parent" SPACE "      CLD*" SPACE "       Classes   ChunkSz   BlockSz  Type", "", "", "");
+  _out->print_cr("ClassLoader" SPACE " Parent" SPACE "      CLD*" SPACE "       Classes   ChunkSz   BlockSz    Locked  Contended  Type", "", "", "");
   _stats->iterate(this);
   _out->print("Total = " UINTX_FORMAT_W(-6), _total_loaders);
   _out->print(SPACE SPACE SPACE "                      ", "", "", "");
-  _out->print_cr(UINTX_FORMAT_W(6) "  " SIZE_FORMAT_W(8) "  " SIZE_FORMAT_W(8) "  ",
+  _out->print_cr(UINTX_FORMAT_W(6) "  " SIZE_FORMAT_W(8) "  " SIZE_FORMAT_W(8) "  " UINTX_FORMAT_W(8) "  " UINTX_FORMAT_W(9) "  ",
       _total_classes,
       _total_chunk_sz,
-      _total_block_sz);
+      _total_block_sz,
+      _total_locked_lookups,
+      _total_contended_lookups);
   _out->print_cr("ChunkSz: Total size of all allocated metaspace chunks");
   _out->print_cr("BlockSz: Total size of all allocated metaspace blocks (each chunk has several blocks)");
+  _out->print_cr("Locked: Class lookups that had to take the SystemDictionary_lock");
+  _out->print_cr("Contended: Locked lookups that found the lock taken");
 }
 
 
@@ -80,6 +80,9 @@ public:
   size_t            _anon_block_sz;
   uintx             _anon_classes_count;
 
+  uintx             _locked_lookups;
+  uintx             _contended_lookups;
+
   ClassLoaderStats() :
     _cld(0),
     _class_loader(0),
@@ -89,7 +92,9 @@ public:
     _classes_count(0),
     _anon_block_sz(0),
     _anon_chunk_sz(0),
-    _anon_classes_count(0) {
+    _anon_classes_count(0),
+    _locked_lookups(0),
+    _contended_lookups(0) {
   }
 };
 
@@ -123,6 +128,8 @@ protected:
   uintx   _total_classes;
   size_t  _total_chunk_sz;
   size_t  _total_block_sz;
+  uintx   _total_locked_lookups;
+  uintx   _total_contended_lookups;
 
 public:
   ClassLoaderStatsClosure(outputStream* out) :
@@ -131,6 +138,8 @@ public:
     _total_block_sz(0),
     _total_chunk_sz(0),
     _total_classes(0),
+    _total_locked_lookups(0),
+    _total_contended_lookups(0),
     _stats(new StatsTable()) {
   }
 
@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "classfile/classPreloader.hpp"
+#include "classfile/javaClasses.hpp"
+#include "classfile/symbolTable.hpp"
+#include "classfile/systemDictionary.hpp"
+#include "classfile/vmSymbols.hpp"
+#include "memory/resourceArea.hpp"
+#include "memory/universe.inline.hpp"
+#include "oops/instanceKlass.hpp"
+#include "runtime/atomic.inline.hpp"
+#include "runtime/handles.inline.hpp"
+#include "runtime/java.hpp"
+#include "runtime/javaCalls.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/os.hpp"
+#include "runtime/thread.inline.hpp"
+
+GrowableArray<Symbol*>* ClassPreloader::_class_names = NULL;
+volatile jint ClassPreloader::_next = 0;
+volatile jint ClassPreloader::_running_threads = 0;
+volatile jint ClassPreloader::_loaded = 0;
+jlong ClassPreloader::_start_millis = 0;
+
+bool ClassPreloader::read_class_list(const char* path, TRAPS) {
+  FILE* file = fopen(path, "r");
+  if (file == NULL) {
+    char errmsg[JVM_MAXPATHLEN];
+    os::lasterror(errmsg, JVM_MAXPATHLEN);
+    warning("Could not open PreloadClassList %s: %s", path, errmsg);
+    return false;
+  }
+
+  _class_names = new (ResourceObj::C_HEAP, mtClass) GrowableArray<Symbol*>(1024, true, mtClass);
+  char class_name[256];
+  while (fgets(class_name, sizeof class_name, file) != NULL) {
+    // Remove trailing newline
+    size_t name_len = strlen(class_name);
+    if (name_len > 0 && class_name[name_len-1] == '\n') {
+      class_name[--name_len] = '\0';
+    }
+    // Skip comments, blank lines and array classes, which are created
+    // on demand from their element class.
+    if (name_len == 0 || *class_name == '#' || *class_name == '[') {
+      continue;
+    }
+    // The symbol's reference is dropped by the thread that preloads it.
+    Symbol* sym = SymbolTable::new_symbol(class_name, (int)name_len, THREAD);
+    if (HAS_PENDING_EXCEPTION) {
+      break;
+    }
+    _class_names->append(sym);
+  }
+  fclose(file);
+  return true;
+}
+
+void ClassPreloader::initialize(TRAPS) {
+  assert(PreloadClassList != NULL, "should not be called otherwise");
+  if (!read_class_list(PreloadClassList, THREAD)) {
+    return;
+  }
+
+  _start_millis = os::javaTimeMillis();
+  int threads = (int)MIN2(PreloadClassThreads, (uintx)_class_names->length());
+  // The list is shared by the preloader threads and this thread, and
+  // released by whichever is done with it last.
+  _running_threads = threads + 1;
+  for (int i = 0; i < threads && !HAS_PENDING_EXCEPTION; i++) {
+    start_thread(i, THREAD);
+  }
+  release();
+}
+
+void ClassPreloader::release() {
+  if (Atomic::add(-1, &_running_threads) > 0) {
+    return;
+  }
+  const int length = _class_names->length();
+  // Drop the references to the names that no thread got to.
+  for (int i = _next; i < length; i++) {
+    _class_names->at(i)->decrement_refcount();
+  }
+  if (TraceClassLoading) {
+    tty->print_cr("[Preloaded %d of %d classes from %s in " JLONG_FORMAT " ms]",
+                  _loaded, length, PreloadClassList,
+                  os::javaTimeMillis() - _start_millis);
+  }
+  delete _class_names;
+  _class_names = NULL;
+}
+
+void ClassPreloader::start_thread(int id, TRAPS) {
+  instanceKlassHandle klass (THREAD, SystemDictionary::Thread_klass());
+  instanceHandle thread_oop = klass->allocate_instance_handle(CHECK);
+
+  char name[64];
+  jio_snprintf(name, sizeof(name), "Class Preloader %d", id);
+  Handle string = java_lang_String::create_from_str(name, CHECK);
+
+  // Initialize thread_oop to put it into the system threadGroup
+  Handle thread_group (THREAD, Universe::system_thread_group());
+  JavaValue result(T_VOID);
+  JavaCalls::call_special(&result, thread_oop,
+                          klass,
+                          vmSymbols::object_initializer_name(),
+                          vmSymbols::threadgroup_string_void_signature(),
+                          thread_group,
+                          string,
+                          CHECK);
+
+  {
+    MutexLocker mu(Threads_lock);
+    ClassPreloaderThread* thread = new ClassPreloaderThread(&preloader_thread_entry);
+
+    // Preloading is only an optimization, so do without the thread if
+    // no osthread could be created for it.
+    if (thread == NULL || thread->osthread() == NULL) {
+      Atomic::dec(&_running_threads);
+      return;
+    }
+
+    java_lang_Thread::set_thread(thread_oop(), thread);
+    java_lang_Thread::set_priority(thread_oop(), NormPriority);
+    java_lang_Thread::set_daemon(thread_oop());
+    thread->set_threadObj(thread_oop());
+
+    Threads::add(thread);
+    Thread::start(thread);
+  }
+}
+
+void ClassPreloader::preload(Symbol* name, Handle loader, TRAPS) {
+  Klass* k = SystemDictionary::resolve_or_null(name, loader, Handle(), THREAD);
+  if (HAS_PENDING_EXCEPTION || k == NULL || !k->oop_is_instance()) {
+    return;
+  }
+  // Verify and rewrite the class now.  A failure is not reported here:
+  // the class stays unlinked and the error is raised again when the
+  // class is linked by its first real use.
+  InstanceKlass::cast(k)->link_class_or_fail(THREAD);
+  if (!HAS_PENDING_EXCEPTION) {
+    Atomic::inc(&_loaded);
+  }
+}
+
+void ClassPreloader::preloader_thread_entry(JavaThread* thread, TRAPS) {
+  Handle loader(THREAD, SystemDictionary::java_system_loader());
+  const int length = _class_names->length();
+  for (;;) {
+    const int i = Atomic::add(1, &_next) - 1;
+    if (i >= length) {
+      break;
+    }
+    Symbol* name = _class_names->at(i);
+    {
+      HandleMark hm(THREAD);
+      ResourceMark rm(THREAD);
+      preload(name, loader, THREAD);
+      CLEAR_PENDING_EXCEPTION;
+    }
+    name->decrement_refcount();
+  }
+
+  release();
+}
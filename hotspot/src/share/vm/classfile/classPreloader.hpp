@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_CLASSFILE_CLASSPRELOADER_HPP
+#define SHARE_VM_CLASSFILE_CLASSPRELOADER_HPP
+
+#include "memory/allocation.hpp"
+#include "runtime/thread.hpp"
+#include "utilities/growableArray.hpp"
+
+// ClassPreloader loads and links the classes named in PreloadClassList
+// ahead of their first use.  The list is read once at startup and its
+// entries are claimed by PreloadClassThreads background JavaThreads.
+// Each class is resolved through the system class loader, which
+// delegates to the boot loader, and then linked (verified and rewritten)
+// without posting verification errors.  A class is published in the
+// Dictionary by the ordinary loading protocol, so a thread requesting it
+// later either finds it loaded or waits on its placeholder; failures are
+// dropped and reported again when the class is really used.
+
+class ClassPreloaderThread : public JavaThread {
+  friend class ClassPreloader;
+ private:
+  ClassPreloaderThread(ThreadFunction entry_point) : JavaThread(entry_point) {};
+};
+
+class ClassPreloader : AllStatic {
+ private:
+  static GrowableArray<Symbol*>* _class_names;
+  static volatile jint _next;
+  static volatile jint _running_threads;
+  static volatile jint _loaded;
+  static jlong _start_millis;
+
+  static bool read_class_list(const char* path, TRAPS);
+  static void release();
+  static void start_thread(int id, TRAPS);
+  static void preloader_thread_entry(JavaThread* thread, TRAPS);
+  static void preload(Symbol* name, Handle loader, TRAPS);
+
+ public:
+  // Called once the system class loader has been computed.
+  static void initialize(TRAPS);
+};
+
+#endif // SHARE_VM_CLASSFILE_CLASSPRELOADER_HPP
@@ -70,6 +70,7 @@ DictionaryEntry* Dictionary::new_entry(unsigned int hash, Klass* klass,
   DictionaryEntry* entry = (DictionaryEntry*)Hashtable<Klass*, mtClass>::new_entry(hash, klass);
   entry->set_loader_data(loader_data);
   entry->set_pd_set(NULL);
+  entry->set_next_in_loader(NULL);
   assert(klass->oop_is_instance(), "Must be");
   if (DumpSharedSpaces) {
     SystemDictionaryShared::init_shared_dictionary_entry(klass, entry);
@@ -141,38 +142,63 @@ void DictionaryEntry::add_protection_domain(Dictionary* dict, oop protection_dom
 }
 
 
+void Dictionary::remove_entry(DictionaryEntry* entry) {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
+  int index = hash_to_index(entry->hash());
+  DictionaryEntry** p = bucket_addr(index);
+  while (*p != entry) {
+    assert(*p != NULL, "entry must be in its bucket");
+    p = (*p)->next_addr();
+  }
+  *p = entry->next();
+
+  ClassLoaderData* loader_data = entry->loader_data();
+  if (loader_data != NULL && !loader_data->is_the_null_class_loader_data()) {
+    DictionaryEntry** q = loader_data->dictionary_entries_addr();
+    while (*q != entry) {
+      assert(*q != NULL, "entry must be in its loader's list");
+      q = (*q)->next_in_loader_addr();
+    }
+    *q = entry->next_in_loader();
+  }
+
+  if (entry == _current_class_entry) {
+    _current_class_entry = NULL;
+  }
+  free_entry(entry);
+}
+
+// Removes the entries of the dead initiating loaders. They are the only
+// ones that go away, and every loader but the null one, which never
+// dies, keeps a list of its own, so only those entries are visited
+// instead of the whole table.
+class DictionaryUnloadingClosure : public CLDClosure {
+  Dictionary* _dictionary;
+ public:
+  DictionaryUnloadingClosure(Dictionary* dictionary) : _dictionary(dictionary) {}
+
+  void do_cld(ClassLoaderData* loader_data) {
+    DictionaryEntry* probe = loader_data->dictionary_entries();
+    loader_data->set_dictionary_entries(NULL);
+    while (probe != NULL) {
+      DictionaryEntry* next = probe->next_in_loader();
+      assert(!Dictionary::is_strongly_reachable(loader_data, probe->klass()),
+             "unloading strongly reachable entry");
+      // Already off the loader's list
+      probe->set_loader_data(NULL);
+      _dictionary->remove_entry(probe);
+      probe = next;
+    }
+  }
+};
+
 void Dictionary::do_unloading() {
   assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
 
   // Remove unloadable entries and classes from system dictionary
   // The placeholder array has been handled in always_strong_oops_do.
-  DictionaryEntry* probe = NULL;
-  for (int index = 0; index < table_size(); index++) {
-    for (DictionaryEntry** p = bucket_addr(index); *p != NULL; ) {
-      probe = *p;
-      Klass* e = probe->klass();
-      ClassLoaderData* loader_data = probe->loader_data();
-
-      InstanceKlass* ik = InstanceKlass::cast(e);
-
-      // Non-unloadable classes were handled in always_strong_oops_do
-      if (!is_strongly_reachable(loader_data, e)) {
-        // Entry was not visited in phase1 (negated test from phase1)
-        assert(!loader_data->is_the_null_class_loader_data(), "unloading entry with null class loader");
-
-        // Do we need to delete this system dictionary entry?
-        if (loader_data->is_unloading()) {
-          *p = probe->next();
-          if (probe == _current_class_entry) {
-            _current_class_entry = NULL;
-          }
-          free_entry(probe);
-          continue;
-        }
-      }
-      p = probe->next_addr();
-    }
-  }
+  DictionaryUnloadingClosure cl(this);
+  ClassLoaderDataGraph::cld_unloading_do(&cl);
 }
 
 void Dictionary::roots_oops_do(OopClosure* strong, OopClosure* weak) {
@@ -204,11 +230,7 @@ void Dictionary::remove_classes_in_error_state() {
       probe = *p;
       InstanceKlass* ik = InstanceKlass::cast(probe->klass());
       if (ik->is_in_error_state()) { // purge this entry
-        *p = probe->next();
-        if (probe == _current_class_entry) {
-          _current_class_entry = NULL;
-        }
-        free_entry(probe);
+        remove_entry(probe);
         ResourceMark rm;
         tty->print_cr("Preload Warning: Removed error class: %s", ik->external_name());
         continue;
@@ -354,6 +376,10 @@ void Dictionary::add_klass(Symbol* class_name, ClassLoaderData* loader_data,
   unsigned int hash = compute_hash(class_name, loader_data);
   int index = hash_to_index(hash);
   DictionaryEntry* entry = new_entry(hash, obj(), loader_data);
+  if (!loader_data->is_the_null_class_loader_data()) {
+    entry->set_next_in_loader(loader_data->dictionary_entries());
+    loader_data->set_dictionary_entries(entry);
+  }
   add_entry(index, entry);
 }
 
@@ -472,6 +498,7 @@ void Dictionary::reorder_dictionary() {
     int index = hash_to_index(hash);
     p->set_hash(hash);
     p->set_loader_data(NULL);   // loader_data isn't copied to CDS
+    p->set_next_in_loader(NULL);
     p->set_next(bucket(index));
     set_entry(index, p);
   }
@@ -675,6 +702,12 @@ void SymbolPropertyTable::oops_do(OopClosure* f) {
       if (p->method_type() != NULL) {
         f->do_oop(p->method_type_addr());
       }
+      if (p->member_name() != NULL) {
+        f->do_oop(p->member_name_addr());
+        if (p->appendix() != NULL) {
+          f->do_oop(p->appendix_addr());
+        }
+      }
     }
   }
 }
@@ -79,6 +79,10 @@ public:
 
   void free_entry(DictionaryEntry* entry);
 
+  // Takes entry out of its bucket and its loader's list and frees it.
+  // Only at a safepoint, since readers are not locked.
+  void remove_entry(DictionaryEntry* entry);
+
   void add_klass(Symbol* class_name, ClassLoaderData* loader_data,KlassHandle obj);
 
   Klass* find_class(int index, unsigned int hash,
@@ -273,6 +277,9 @@ class DictionaryEntry : public HashtableEntry<Klass*, mtClass> {
   //
   ProtectionDomainEntry* _pd_set;
   ClassLoaderData*       _loader_data;
+  // Next entry with the same initiating loader, see
+  // ClassLoaderData::dictionary_entries()
+  DictionaryEntry*       _next_in_loader;
 
  public:
   // Tells whether a protection is in the approved set.
@@ -294,6 +301,10 @@ class DictionaryEntry : public HashtableEntry<Klass*, mtClass> {
   ClassLoaderData* loader_data() const { return _loader_data; }
   void set_loader_data(ClassLoaderData* loader_data) { _loader_data = loader_data; }
 
+  DictionaryEntry* next_in_loader() const { return _next_in_loader; }
+  void set_next_in_loader(DictionaryEntry* next) { _next_in_loader = next; }
+  DictionaryEntry** next_in_loader_addr() { return &_next_in_loader; }
+
   ProtectionDomainEntry* pd_set() const { return _pd_set; }
   void set_pd_set(ProtectionDomainEntry* pd_set) { _pd_set = pd_set; }
 
@@ -350,6 +361,8 @@ class SymbolPropertyEntry : public HashtableEntry<Symbol*, mtSymbol> {
   intptr_t _symbol_mode;  // secondary key
   Method*   _method;
   oop       _method_type;
+  oop       _member_name;   // linked invoker, for cached invokehandle linkage
+  oop       _appendix;      // and its appendix
 
  public:
   Symbol* symbol() const            { return literal(); }
@@ -364,6 +377,15 @@ class SymbolPropertyEntry : public HashtableEntry<Symbol*, mtSymbol> {
   oop*     method_type_addr()       { return &_method_type; }
   void set_method_type(oop p)       { _method_type = p; }
 
+  oop      member_name() const      { return _member_name; }
+  oop*     member_name_addr()       { return &_member_name; }
+  oop      appendix() const         { return _appendix; }
+  oop*     appendix_addr()          { return &_appendix; }
+  void set_linkage(oop member_name, oop appendix) {
+    _appendix = appendix;
+    _member_name = member_name;
+  }
+
   SymbolPropertyEntry* next() const {
     return (SymbolPropertyEntry*)HashtableEntry<Symbol*, mtSymbol>::next();
   }
@@ -386,6 +408,11 @@ class SymbolPropertyEntry : public HashtableEntry<Symbol*, mtSymbol> {
       st->print(INTPTR_FORMAT, p2i((void *)method_type()));
       printed = true;
     }
+    if (member_name() != NULL) {
+      if (printed)  st->print(" and ");
+      st->print("linked " INTPTR_FORMAT, p2i((void *)member_name()));
+      printed = true;
+    }
     st->print_cr(printed ? "" : "(empty)");
   }
 };
@@ -419,6 +446,7 @@ private:
     entry->set_symbol_mode(symbol_mode);
     entry->set_method(NULL);
     entry->set_method_type(NULL);
+    entry->set_linkage(NULL, NULL);
     return entry;
   }
 
@@ -146,6 +146,7 @@ int java_lang_String::value_offset  = 0;
 int java_lang_String::offset_offset = 0;
 int java_lang_String::count_offset  = 0;
 int java_lang_String::hash_offset   = 0;
+int java_lang_String::coder_offset  = 0;
 
 bool java_lang_String::initialized  = false;
 
@@ -153,15 +154,31 @@ void java_lang_String::compute_offsets() {
   assert(!initialized, "offsets should be initialized only once");
 
   Klass* k = SystemDictionary::String_klass();
-  compute_offset(value_offset,           k, vmSymbols::value_name(),  vmSymbols::char_array_signature());
+  if (CompactStrings) {
+    // Compact strings need a String with a byte[] value and a coder field
+    compute_optional_offset(coder_offset, k, vmSymbols::coder_name(), vmSymbols::byte_signature());
+    if (coder_offset == 0) {
+      if (!FLAG_IS_DEFAULT(CompactStrings)) {
+        warning("CompactStrings is not supported by this java.lang.String and has been disabled");
+      }
+      FLAG_SET_DEFAULT(CompactStrings, false);
+    }
+  }
+  if (coder_offset > 0) {
+    compute_offset(value_offset,         k, vmSymbols::value_name(),  vmSymbols::byte_array_signature());
+  } else {
+    compute_offset(value_offset,         k, vmSymbols::value_name(),  vmSymbols::char_array_signature());
+  }
   compute_optional_offset(offset_offset, k, vmSymbols::offset_name(), vmSymbols::int_signature());
   compute_optional_offset(count_offset,  k, vmSymbols::count_name(),  vmSymbols::int_signature());
   compute_optional_offset(hash_offset,   k, vmSymbols::hash_name(),   vmSymbols::int_signature());
 
+  assert(coder_offset == 0 || offset_offset == 0, "coder implies a zero-based value array");
+
   initialized = true;
 }
 
-Handle java_lang_String::basic_create(int length, TRAPS) {
+Handle java_lang_String::basic_create(int length, bool is_latin1, TRAPS) {
   assert(initialized, "Must be initialized");
   // Create the String object first, so there's a chance that the String
   // and the char array it points to end up in the same cache line.
@@ -172,11 +189,16 @@ Handle java_lang_String::basic_create(int length, TRAPS) {
   // because GC can happen as a result of the allocation attempt.
   Handle h_obj(THREAD, obj);
   typeArrayOop buffer;
+  if (has_coder_field()) {
+    buffer = oopFactory::new_byteArray(is_latin1 ? length : length << 1, CHECK_NH);
+  } else {
     buffer = oopFactory::new_charArray(length, CHECK_NH);
+  }
 
   // Point the String at the char array
   obj = h_obj();
   set_value(obj, buffer);
+  set_coder(obj, is_latin1 ? CODER_LATIN1 : CODER_UTF16);
   // No need to zero the offset, allocation zero'ed the entire String object
   assert(offset(obj) == 0, "initial String offset should be zero");
 //set_offset(obj, 0);
@@ -186,10 +208,17 @@ Handle java_lang_String::basic_create(int length, TRAPS) {
 }
 
 Handle java_lang_String::create_from_unicode(jchar* unicode, int length, TRAPS) {
-  Handle h_obj = basic_create(length, CHECK_NH);
+  bool is_latin1 = CompactStrings && UNICODE::is_latin1(unicode, length);
+  Handle h_obj = basic_create(length, is_latin1, CHECK_NH);
   typeArrayOop buffer = value(h_obj());
-  for (int index = 0; index < length; index++) {
-    buffer->char_at_put(index, unicode[index]);
+  if (is_latin1) {
+    for (int index = 0; index < length; index++) {
+      buffer->byte_at_put(index, (jbyte) unicode[index]);
+    }
+  } else {
+    for (int index = 0; index < length; index++) {
+      buffer->char_at_put(index, unicode[index]);
+    }
   }
   return h_obj;
 }
@@ -203,8 +232,30 @@ Handle java_lang_String::create_from_str(const char* utf8_str, TRAPS) {
   if (utf8_str == NULL) {
     return Handle();
   }
-  int length = UTF8::unicode_length(utf8_str);
-  Handle h_obj = basic_create(length, CHECK_NH);
+  int utf8_len = (int) strlen(utf8_str);
+  if (UTF8::ascii_prefix_length((const unsigned char*) utf8_str, utf8_len) == utf8_len) {
+    // Plain ASCII, as most strings from native code are: one character
+    // per byte, which Latin-1 can hold as is.
+    bool is_latin1 = CompactStrings;
+    Handle h_obj = basic_create(utf8_len, is_latin1, CHECK_NH);
+    if (utf8_len > 0) {
+      typeArrayOop buffer = value(h_obj());
+      if (is_latin1) {
+        memcpy(buffer->byte_at_addr(0), utf8_str, utf8_len);
+      } else {
+        UTF8::convert_to_unicode(utf8_str, buffer->char_at_addr(0), utf8_len);
+      }
+    }
+    return h_obj;
+  }
+  int length = UTF8::unicode_length(utf8_str, utf8_len);
+  if (CompactStrings) {
+    ResourceMark rm(THREAD);
+    jchar* unicode = NEW_RESOURCE_ARRAY(jchar, length);
+    UTF8::convert_to_unicode(utf8_str, unicode, length);
+    return create_from_unicode(unicode, length, THREAD);
+  }
+  Handle h_obj = basic_create(length, false, CHECK_NH);
   if (length > 0) {
     UTF8::convert_to_unicode(utf8_str, value(h_obj())->char_at_addr(0), length);
   }
@@ -218,7 +269,13 @@ oop java_lang_String::create_oop_from_str(const char* utf8_str, TRAPS) {
 
 Handle java_lang_String::create_from_symbol(Symbol* symbol, TRAPS) {
   int length = UTF8::unicode_length((char*)symbol->bytes(), symbol->utf8_length());
-  Handle h_obj = basic_create(length, CHECK_NH);
+  if (CompactStrings) {
+    ResourceMark rm(THREAD);
+    jchar* unicode = NEW_RESOURCE_ARRAY(jchar, length);
+    UTF8::convert_to_unicode((char*)symbol->bytes(), unicode, length);
+    return create_from_unicode(unicode, length, THREAD);
+  }
+  Handle h_obj = basic_create(length, false, CHECK_NH);
   if (length > 0) {
     UTF8::convert_to_unicode((char*)symbol->bytes(), value(h_obj())->char_at_addr(0), length);
   }
@@ -288,11 +345,12 @@ Handle java_lang_String::char_converter(Handle java_string, jchar from_char, jch
   typeArrayOop value  = java_lang_String::value(obj);
   int          offset = java_lang_String::offset(obj);
   int          length = java_lang_String::length(obj);
+  bool      is_latin1 = java_lang_String::is_latin1(obj);
 
   // First check if any from_char exist
   int index; // Declared outside, used later
   for (index = 0; index < length; index++) {
-    if (value->char_at(index + offset) == from_char) {
+    if (char_at(value, is_latin1, index + offset) == from_char) {
       break;
     }
   }
@@ -303,19 +361,25 @@ Handle java_lang_String::char_converter(Handle java_string, jchar from_char, jch
 
   // Create new UNICODE buffer. Must handlize value because GC
   // may happen during String and char array creation.
+  // Both characters are ASCII in practice; fall back to UTF-16 otherwise.
   typeArrayHandle h_value(THREAD, value);
-  Handle string = basic_create(length, CHECK_NH);
+  bool to_latin1 = is_latin1 && to_char <= 0xff;
+  Handle string = basic_create(length, to_latin1, CHECK_NH);
 
   typeArrayOop from_buffer = h_value();
   typeArrayOop to_buffer   = java_lang_String::value(string());
 
   // Copy contents
   for (index = 0; index < length; index++) {
-    jchar c = from_buffer->char_at(index + offset);
+    jchar c = char_at(from_buffer, is_latin1, index + offset);
     if (c == from_char) {
       c = to_char;
     }
-    to_buffer->char_at_put(index, c);
+    if (to_latin1) {
+      to_buffer->byte_at_put(index, (jbyte) c);
+    } else {
+      to_buffer->char_at_put(index, c);
+    }
   }
   return string;
 }
@@ -325,10 +389,12 @@ jchar* java_lang_String::as_unicode_string(oop java_string, int& length, TRAPS)
   int          offset = java_lang_String::offset(java_string);
                length = java_lang_String::length(java_string);
 
+  bool      is_latin1 = java_lang_String::is_latin1(java_string);
+
   jchar* result = NEW_RESOURCE_ARRAY_RETURN_NULL(jchar, length);
   if (result != NULL) {
     for (int index = 0; index < length; index++) {
-      result[index] = value->char_at(index + offset);
+      result[index] = char_at(value, is_latin1, index + offset);
     }
   } else {
     THROW_MSG_0(vmSymbols::java_lang_OutOfMemoryError(), "could not allocate Unicode string");
@@ -343,15 +409,32 @@ unsigned int java_lang_String::hash_code(oop java_string) {
 
   typeArrayOop value  = java_lang_String::value(java_string);
   int          offset = java_lang_String::offset(java_string);
+  if (java_lang_String::is_latin1(java_string)) {
+    return java_lang_String::hash_code((jubyte*) value->byte_at_addr(offset), length);
+  }
   return java_lang_String::hash_code(value->char_at_addr(offset), length);
 }
 
-char* java_lang_String::as_quoted_ascii(oop java_string) {
+jchar* java_lang_String::unicode_at(oop java_string, int start, int len) {
   typeArrayOop value  = java_lang_String::value(java_string);
   int          offset = java_lang_String::offset(java_string);
+  if (len == 0) {
+    return NULL;
+  }
+  if (!java_lang_String::is_latin1(java_string)) {
+    return value->char_at_addr(offset + start);
+  }
+  jchar* result = NEW_RESOURCE_ARRAY(jchar, len);
+  for (int index = 0; index < len; index++) {
+    result[index] = char_at(value, true, offset + start + index);
+  }
+  return result;
+}
+
+char* java_lang_String::as_quoted_ascii(oop java_string) {
   int          length = java_lang_String::length(java_string);
 
-  jchar* base = (length == 0) ? NULL : value->char_at_addr(offset);
+  jchar* base = unicode_at(java_string, 0, length);
   if (base == NULL) return NULL;
 
   int result_length = UNICODE::quoted_ascii_length(base, length) + 1;
@@ -369,6 +452,10 @@ unsigned int java_lang_String::hash_string(oop java_string) {
     return StringTable::hash_string(NULL, 0);
   }
 
+  if (java_lang_String::is_latin1(java_string)) {
+    ResourceMark rm;
+    return StringTable::hash_string(unicode_at(java_string, 0, length), length);
+  }
   typeArrayOop value  = java_lang_String::value(java_string);
   int          offset = java_lang_String::offset(java_string);
   return StringTable::hash_string(value->char_at_addr(offset), length);
@@ -376,53 +463,63 @@ unsigned int java_lang_String::hash_string(oop java_string) {
 
 Symbol* java_lang_String::as_symbol(Handle java_string, TRAPS) {
   oop          obj    = java_string();
-  typeArrayOop value  = java_lang_String::value(obj);
-  int          offset = java_lang_String::offset(obj);
   int          length = java_lang_String::length(obj);
-  jchar* base = (length == 0) ? NULL : value->char_at_addr(offset);
+  jchar* base = unicode_at(obj, 0, length);
   Symbol* sym = SymbolTable::lookup_unicode(base, length, THREAD);
   return sym;
 }
 
 Symbol* java_lang_String::as_symbol_or_null(oop java_string) {
-  typeArrayOop value  = java_lang_String::value(java_string);
-  int          offset = java_lang_String::offset(java_string);
   int          length = java_lang_String::length(java_string);
-  jchar* base = (length == 0) ? NULL : value->char_at_addr(offset);
+  jchar* base = unicode_at(java_string, 0, length);
   return SymbolTable::probe_unicode(base, length);
 }
 
 
-int java_lang_String::utf8_length(oop java_string) {
+// The number of leading characters of a Latin-1 string that are ASCII
+// other than 0, and so stay one byte each in utf8.
+static int latin1_ascii_prefix_length(oop java_string, int length) {
   typeArrayOop value  = java_lang_String::value(java_string);
   int          offset = java_lang_String::offset(java_string);
+  if (length == 0) {
+    return 0;
+  }
+  return UTF8::ascii_prefix_length((const unsigned char*) value->byte_at_addr(offset), length);
+}
+
+int java_lang_String::utf8_length(oop java_string) {
   int          length = java_lang_String::length(java_string);
-  jchar* position = (length == 0) ? NULL : value->char_at_addr(offset);
+  if (is_latin1(java_string) && latin1_ascii_prefix_length(java_string, length) == length) {
+    return length;
+  }
+  jchar* position = unicode_at(java_string, 0, length);
   return UNICODE::utf8_length(position, length);
 }
 
 char* java_lang_String::as_utf8_string(oop java_string) {
-  typeArrayOop value  = java_lang_String::value(java_string);
-  int          offset = java_lang_String::offset(java_string);
   int          length = java_lang_String::length(java_string);
-  jchar* position = (length == 0) ? NULL : value->char_at_addr(offset);
+  jchar* position = unicode_at(java_string, 0, length);
   return UNICODE::as_utf8(position, length);
 }
 
 char* java_lang_String::as_utf8_string(oop java_string, char* buf, int buflen) {
-  typeArrayOop value  = java_lang_String::value(java_string);
-  int          offset = java_lang_String::offset(java_string);
   int          length = java_lang_String::length(java_string);
-  jchar* position = (length == 0) ? NULL : value->char_at_addr(offset);
+  if (is_latin1(java_string) && length < buflen &&
+      latin1_ascii_prefix_length(java_string, length) == length) {
+    if (length > 0) {
+      memcpy(buf, value(java_string)->byte_at_addr(offset(java_string)), length);
+    }
+    buf[length] = '\0';
+    return buf;
+  }
+  jchar* position = unicode_at(java_string, 0, length);
   return UNICODE::as_utf8(position, length, buf, buflen);
 }
 
 char* java_lang_String::as_utf8_string(oop java_string, int start, int len) {
-  typeArrayOop value  = java_lang_String::value(java_string);
-  int          offset = java_lang_String::offset(java_string);
   int          length = java_lang_String::length(java_string);
   assert(start + len <= length, "just checking");
-  jchar* position = value->char_at_addr(offset + start);
+  jchar* position = unicode_at(java_string, start, len);
   return UNICODE::as_utf8(position, len);
 }
 
@@ -432,11 +529,12 @@ bool java_lang_String::equals(oop java_string, jchar* chars, int len) {
   typeArrayOop value  = java_lang_String::value(java_string);
   int          offset = java_lang_String::offset(java_string);
   int          length = java_lang_String::length(java_string);
+  bool      is_latin1 = java_lang_String::is_latin1(java_string);
   if (length != len) {
     return false;
   }
   for (int i = 0; i < len; i++) {
-    if (value->char_at(i + offset) != chars[i]) {
+    if (char_at(value, is_latin1, i + offset) != chars[i]) {
       return false;
     }
   }
@@ -454,12 +552,14 @@ bool java_lang_String::equals(oop str1, oop str2) {
   typeArrayOop value2  = java_lang_String::value(str2);
   int          offset2 = java_lang_String::offset(str2);
   int          length2 = java_lang_String::length(str2);
+  bool      is_latin1_1 = java_lang_String::is_latin1(str1);
+  bool      is_latin1_2 = java_lang_String::is_latin1(str2);
 
   if (length1 != length2) {
     return false;
   }
   for (int i = 0; i < length1; i++) {
-    if (value1->char_at(i + offset1) != value2->char_at(i + offset2)) {
+    if (char_at(value1, is_latin1_1, i + offset1) != char_at(value2, is_latin1_2, i + offset2)) {
       return false;
     }
   }
@@ -478,9 +578,10 @@ void java_lang_String::print(oop java_string, outputStream* st) {
     // object before its initializer has been called
     st->print_cr("NULL");
   } else {
+    bool is_latin1 = java_lang_String::is_latin1(java_string);
     st->print("\"");
     for (int index = 0; index < length; index++) {
-      st->print("%c", value->char_at(index + offset));
+      st->print("%c", char_at(value, is_latin1, index + offset));
     }
     st->print("\"");
   }
@@ -1600,6 +1701,86 @@ void java_lang_Throwable::print_stack_trace(oop throwable, outputStream* st) {
   }
 }
 
+BacktraceCache::BacktraceCache(int size) : _size(size), _next(0) {
+  _entries = NEW_C_HEAP_ARRAY(Entry, size, mtInternal);
+  for (int i = 0; i < size; i++) {
+    _entries[i]._backtrace = NULL;
+  }
+}
+
+BacktraceCache::~BacktraceCache() {
+  FREE_C_HEAP_ARRAY(Entry, _entries, mtInternal);
+}
+
+BacktraceCache* BacktraceCache::for_thread(JavaThread* thread) {
+  BacktraceCache* cache = thread->backtrace_cache();
+  if (cache == NULL) {
+    cache = new BacktraceCache((int)BacktraceCacheSize);
+    thread->set_backtrace_cache(cache);
+  }
+  return cache;
+}
+
+int BacktraceCache::record_frames(JavaThread* thread, intptr_t* raw) {
+  RegisterMap map(thread, false);
+  int length = 0;
+  for (frame fr = thread->last_frame(); !fr.is_first_frame(); fr = fr.sender(&map)) {
+    if (fr.is_interpreted_frame()) {
+      if (length + 2 > max_raw_words) return -1;
+      Method* method = fr.interpreter_frame_method();
+      intptr_t bcx = fr.interpreter_frame_bcx();
+      raw[length++] = (intptr_t)method;
+      raw[length++] = fr.is_bci(bcx) ? bcx : method->bci_from((address)bcx);
+    } else {
+      CodeBlob* cb = fr.cb();
+      if (cb == NULL || !cb->is_nmethod()) continue;
+      if (length + 2 > max_raw_words) return -1;
+      // The compile id tells apart nmethods that reuse freed code space.
+      raw[length++] = (intptr_t)fr.pc();
+      raw[length++] = ((nmethod*)cb)->compile_id();
+    }
+  }
+  return length;
+}
+
+unsigned BacktraceCache::hash(const intptr_t* raw, int length) {
+  unsigned h = (unsigned)length;
+  for (int i = 0; i < length; i++) {
+    h = 31 * h + (unsigned)(raw[i] ^ (raw[i] >> 16));
+  }
+  return h;
+}
+
+oop BacktraceCache::lookup(Klass* throwable_klass, const intptr_t* raw, int length, unsigned hash) {
+  int safepoint_id = SafepointSynchronize::safepoint_counter();
+  for (int i = 0; i < _size; i++) {
+    Entry* e = &_entries[i];
+    if (e->_backtrace != NULL &&
+        e->_safepoint_id == safepoint_id &&
+        e->_hash == hash &&
+        e->_throwable_klass == throwable_klass &&
+        e->_length == length &&
+        memcmp(e->_raw, raw, length * sizeof(intptr_t)) == 0) {
+      return e->_backtrace;
+    }
+  }
+  return NULL;
+}
+
+void BacktraceCache::insert(Klass* throwable_klass, const intptr_t* raw, int length, unsigned hash,
+                            oop backtrace, int safepoint_id) {
+  // A safepoint may have deoptimized frames or freed the recorded metadata.
+  if (SafepointSynchronize::safepoint_counter() != safepoint_id) return;
+  Entry* e = &_entries[_next];
+  _next = (_next + 1) % _size;
+  e->_safepoint_id = safepoint_id;
+  e->_hash = hash;
+  e->_throwable_klass = throwable_klass;
+  e->_length = length;
+  memcpy(e->_raw, raw, length * sizeof(intptr_t));
+  e->_backtrace = backtrace;
+}
+
 void java_lang_Throwable::fill_in_stack_trace(Handle throwable, methodHandle method, TRAPS) {
   if (!StackTraceInThrowable) return;
   ResourceMark rm(THREAD);
@@ -1616,6 +1797,29 @@ void java_lang_Throwable::fill_in_stack_trace(Handle throwable, methodHandle met
 
   int max_depth = MaxJavaStackTraceDepth;
   JavaThread* thread = (JavaThread*)THREAD;
+
+  // Share the backtrace of an exception of the same class recently thrown
+  // from an identical stack.
+  BacktraceCache* cache = NULL;
+  intptr_t* raw = NULL;
+  int raw_length = -1;
+  unsigned raw_hash = 0;
+  int safepoint_id = 0;
+  if (BacktraceCacheSize > 0 && thread->has_last_Java_frame()) {
+    cache = BacktraceCache::for_thread(thread);
+    safepoint_id = SafepointSynchronize::safepoint_counter();
+    raw = NEW_RESOURCE_ARRAY(intptr_t, BacktraceCache::max_raw_words);
+    raw_length = BacktraceCache::record_frames(thread, raw);
+    if (raw_length >= 0) {
+      raw_hash = BacktraceCache::hash(raw, raw_length);
+      oop backtrace = cache->lookup(throwable->klass(), raw, raw_length, raw_hash);
+      if (backtrace != NULL) {
+        set_backtrace(throwable(), backtrace);
+        return;
+      }
+    }
+  }
+
   BacktraceBuilder bt(CHECK);
 
   // If there is no Java frame just return the method that was being called
@@ -1733,6 +1937,9 @@ void java_lang_Throwable::fill_in_stack_trace(Handle throwable, methodHandle met
 
   // Put completed stack trace into throwable object
   set_backtrace(throwable(), bt.backtrace());
+  if (raw_length >= 0) {
+    cache->insert(throwable->klass(), raw, raw_length, raw_hash, bt.backtrace(), safepoint_id);
+  }
 }
 
 void java_lang_Throwable::fill_in_stack_trace(Handle throwable, methodHandle method) {
@@ -56,10 +56,11 @@ class java_lang_String : AllStatic {
   static int offset_offset;
   static int count_offset;
   static int hash_offset;
+  static int coder_offset;
 
   static bool initialized;
 
-  static Handle basic_create(int length, TRAPS);
+  static Handle basic_create(int length, bool is_latin1, TRAPS);
 
   static void set_offset(oop string, int offset) {
     assert(initialized, "Must be initialized");
@@ -73,8 +74,25 @@ class java_lang_String : AllStatic {
       string->int_field_put(count_offset,  count);
     }
   }
+  static void set_coder(oop string, jbyte coder) {
+    assert(initialized, "Must be initialized");
+    if (coder_offset > 0) {
+      string->byte_field_put(coder_offset, coder);
+    }
+  }
+
+  // Pointer to len characters of java_string starting at start. Latin-1
+  // strings have no jchar storage to point into and are inflated into a
+  // resource-allocated copy.
+  static jchar* unicode_at(oop java_string, int start, int len);
 
  public:
+  // Values of the coder field, matching String.LATIN1 and String.UTF16.
+  enum {
+    CODER_LATIN1 = 0,
+    CODER_UTF16  = 1
+  };
+
   static void compute_offsets();
 
   // Instance creation
@@ -101,6 +119,13 @@ class java_lang_String : AllStatic {
     return (hash_offset > 0);
   }
 
+  // True if the class library stores String contents in a byte[] tagged
+  // with a coder, and CompactStrings is enabled.
+  static bool has_coder_field()  {
+    assert(initialized, "Must be initialized");
+    return (coder_offset > 0);
+  }
+
   static int value_offset_in_bytes()  {
     assert(initialized && (value_offset > 0), "Must be initialized");
     return value_offset;
@@ -147,15 +172,36 @@ class java_lang_String : AllStatic {
       return 0;
     }
   }
+  static jbyte coder(oop java_string) {
+    assert(initialized, "Must be initialized");
+    assert(is_instance(java_string), "must be java_string");
+    if (coder_offset > 0) {
+      return java_string->byte_field(coder_offset);
+    } else {
+      return CODER_UTF16;
+    }
+  }
+  static bool is_latin1(oop java_string) {
+    return coder(java_string) == CODER_LATIN1;
+  }
   static int length(oop java_string) {
     assert(initialized, "Must be initialized");
     assert(is_instance(java_string), "must be java_string");
     if (count_offset > 0) {
       return java_string->int_field(count_offset);
     } else {
-      return ((typeArrayOop)java_string->obj_field(value_offset))->length();
+      int array_length = ((typeArrayOop)java_string->obj_field(value_offset))->length();
+      if (coder_offset > 0 && !is_latin1(java_string)) {
+        // UTF-16 contents in a byte[], two bytes per character
+        return array_length >> 1;
+      }
+      return array_length;
     }
   }
+  // Character at index of a value array of the given coder
+  static jchar char_at(typeArrayOop value, bool is_latin1, int index) {
+    return is_latin1 ? (jchar)(value->byte_at(index) & 0xff) : value->char_at(index);
+  }
   static int utf8_length(oop java_string);
 
   // String converters
@@ -542,6 +588,55 @@ class java_lang_Throwable: AllStatic {
   friend class JavaClasses;
 };
 
+// A small per-thread cache of recently filled in backtraces.
+//
+// Filling in a backtrace decodes the scopes of every compiled frame and
+// allocates the backtrace chunks, while exceptions used for control flow
+// are typically thrown from the same few stacks over and over.  The
+// physical frames are cheap to record: (Method*, bci) for interpreted
+// frames and (pc, compile id) for compiled ones.  An exception of the
+// same class thrown from an identical physical stack gets the same
+// backtrace, which is never modified once filled in, so it is shared.
+//
+// Entries hold raw oops and metadata and are not GC roots.  They are only
+// valid until the next safepoint, which is checked through the safepoint
+// counter, so the cache needs no GC or class unloading support.
+class BacktraceCache : public CHeapObj<mtInternal> {
+ public:
+  enum { max_raw_words = 128 };         // two words per physical frame
+
+ private:
+  struct Entry {
+    int       _safepoint_id;            // safepoint counter when recorded
+    unsigned  _hash;
+    Klass*    _throwable_klass;
+    int       _length;
+    intptr_t  _raw[max_raw_words];
+    oop       _backtrace;
+  };
+  Entry* _entries;
+  int    _size;
+  int    _next;                         // round-robin replacement
+
+  BacktraceCache(int size);
+
+ public:
+  ~BacktraceCache();
+
+  // The cache of the given thread, created on first use.
+  static BacktraceCache* for_thread(JavaThread* thread);
+
+  // Records the physical frames of the thread's stack into raw and
+  // returns the number of words used, or -1 if the stack is too deep.
+  static int record_frames(JavaThread* thread, intptr_t* raw);
+  static unsigned hash(const intptr_t* raw, int length);
+
+  oop  lookup(Klass* throwable_klass, const intptr_t* raw, int length, unsigned hash);
+  // Records a backtrace unless a safepoint happened since safepoint_id.
+  void insert(Klass* throwable_klass, const intptr_t* raw, int length, unsigned hash,
+              oop backtrace, int safepoint_id);
+};
+
 
 // Interface to java.lang.reflect.AccessibleObject objects
 
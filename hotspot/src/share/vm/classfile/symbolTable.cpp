@@ -51,6 +51,7 @@ SymbolTable* SymbolTable::_the_table = NULL;
 // Static arena for symbols that are not deallocated
 Arena* SymbolTable::_arena = NULL;
 bool SymbolTable::_needs_rehashing = false;
+volatile bool SymbolTable::_needs_resizing = false;
 
 Symbol* SymbolTable::allocate_symbol(const u1* name, int len, bool c_heap, TRAPS) {
   assert (len <= Symbol::max_length(), "should be checked by caller");
@@ -185,8 +186,8 @@ void SymbolTable::rehash_table() {
   assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
   // This should never happen with -Xshare:dump but it might in testing mode.
   if (DumpSharedSpaces) return;
-  // Create a new symbol table
-  SymbolTable* new_table = new SymbolTable();
+  // Create a new symbol table of the same size
+  SymbolTable* new_table = new SymbolTable(the_table()->table_size());
 
   the_table()->move_to(new_table);
 
@@ -198,6 +199,27 @@ void SymbolTable::rehash_table() {
   _the_table = new_table;
 }
 
+// Request a resize at the next safepoint once the buckets are longer than
+// SymbolAndStringTableLoadFactor on average.  Readers walk the buckets
+// without a lock, so they can only be relinked with all threads stopped.
+void SymbolTable::check_resize_needed() {
+  assert_locked_or_safepoint(SymbolTable_lock);
+  if (ResizeSymbolAndStringTables && !_needs_resizing && !DumpSharedSpaces &&
+      table_size() < maximumSymbolTableSize &&
+      (uintx)number_of_entries() > (uintx)table_size() * SymbolAndStringTableLoadFactor) {
+    _needs_resizing = true;
+  }
+}
+
+void SymbolTable::resize_table() {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
+  _needs_resizing = false;
+  int new_size = MIN2(the_table()->table_size() * 2, maximumSymbolTableSize);
+  if (!the_table()->resize(new_size) && PrintStringTableStatistics) {
+    warning("Could not grow the symbol table to %d buckets", new_size);
+  }
+}
+
 // Lookup a symbol in a bucket.
 
 Symbol* SymbolTable::lookup(int index, const char* name,
@@ -249,7 +271,7 @@ Symbol* SymbolTable::lookup(const char* name, int len, TRAPS) {
   MutexLocker ml(SymbolTable_lock, THREAD);
 
   // Otherwise, add to symbol to table
-  return the_table()->basic_add(index, (u1*)name, len, hashValue, true, THREAD);
+  return the_table()->basic_add((u1*)name, len, hashValue, true, THREAD);
 }
 
 Symbol* SymbolTable::lookup(const Symbol* sym, int begin, int end, TRAPS) {
@@ -288,7 +310,7 @@ Symbol* SymbolTable::lookup(const Symbol* sym, int begin, int end, TRAPS) {
   // Grab SymbolTable_lock first.
   MutexLocker ml(SymbolTable_lock, THREAD);
 
-  return the_table()->basic_add(index, (u1*)buffer, len, hashValue, true, THREAD);
+  return the_table()->basic_add((u1*)buffer, len, hashValue, true, THREAD);
 }
 
 Symbol* SymbolTable::lookup_only(const char* name, int len,
@@ -365,9 +387,8 @@ void SymbolTable::add(ClassLoaderData* loader_data, constantPoolHandle cp,
   if (!added) {
     // do it the hard way
     for (int i=0; i<names_count; i++) {
-      int index = table->hash_to_index(hashValues[i]);
       bool c_heap = !loader_data->is_the_null_class_loader_data();
-      Symbol* sym = table->basic_add(index, (u1*)names[i], lengths[i], hashValues[i], c_heap, CHECK);
+      Symbol* sym = table->basic_add((u1*)names[i], lengths[i], hashValues[i], c_heap, CHECK);
       cp->symbol_at_put(cp_indices[i], sym);
     }
   }
@@ -383,11 +404,10 @@ Symbol* SymbolTable::new_permanent_symbol(const char* name, TRAPS) {
   MutexLocker ml(SymbolTable_lock, THREAD);
 
   SymbolTable* table = the_table();
-  int index = table->hash_to_index(hash);
-  return table->basic_add(index, (u1*)name, (int)strlen(name), hash, false, THREAD);
+  return table->basic_add((u1*)name, (int)strlen(name), hash, false, THREAD);
 }
 
-Symbol* SymbolTable::basic_add(int index_arg, u1 *name, int len,
+Symbol* SymbolTable::basic_add(u1 *name, int len,
                                unsigned int hashValue_arg, bool c_heap, TRAPS) {
   assert(!Universe::heap()->is_in_reserved(name),
          "proposed name of symbol must be stable");
@@ -402,16 +422,15 @@ Symbol* SymbolTable::basic_add(int index_arg, u1 *name, int len,
   No_Safepoint_Verifier nsv;
 
   // Check if the symbol table has been rehashed, if so, need to recalculate
-  // the hash value and index.
+  // the hash value.  The index is always recalculated, since the table may
+  // have been resized at a safepoint after the caller's lookup.
   unsigned int hashValue;
-  int index;
   if (use_alternate_hashcode()) {
     hashValue = hash_symbol((const char*)name, len);
-    index = hash_to_index(hashValue);
   } else {
     hashValue = hashValue_arg;
-    index = index_arg;
   }
+  int index = hash_to_index(hashValue);
 
   // Since look-up was done lock-free, we need to check if another
   // thread beat us in the race to insert the symbol.
@@ -428,6 +447,7 @@ Symbol* SymbolTable::basic_add(int index_arg, u1 *name, int len,
 
   HashtableEntry<Symbol*, mtSymbol>* entry = new_entry(hashValue, sym);
   add_entry(index, entry);
+  check_resize_needed();
   return sym;
 }
 
@@ -479,6 +499,7 @@ bool SymbolTable::basic_add(ClassLoaderData* loader_data, constantPoolHandle cp,
       cp->symbol_at_put(cp_indices[i], sym);
     }
   }
+  check_resize_needed();
   return true;
 }
 
@@ -648,6 +669,7 @@ class StableMemoryChecker : public StackObj {
 StringTable* StringTable::_the_table = NULL;
 
 bool StringTable::_needs_rehashing = false;
+volatile bool StringTable::_needs_resizing = false;
 
 volatile int StringTable::_parallel_claimed_idx = 0;
 
@@ -676,7 +698,7 @@ oop StringTable::lookup(int index, jchar* name,
 }
 
 
-oop StringTable::basic_add(int index_arg, Handle string, jchar* name,
+oop StringTable::basic_add(Handle string, jchar* name,
                            int len, unsigned int hashValue_arg, TRAPS) {
 
   assert(java_lang_String::equals(string(), name, len),
@@ -684,17 +706,17 @@ oop StringTable::basic_add(int index_arg, Handle string, jchar* name,
   // Cannot hit a safepoint in this function because the "this" pointer can move.
   No_Safepoint_Verifier nsv;
 
-  // Check if the symbol table has been rehashed, if so, need to recalculate
-  // the hash value and index before second lookup.
+  // Check if the string table has been rehashed, if so, need to recalculate
+  // the hash value before second lookup.  The index is always recalculated,
+  // since the table may have been resized at a safepoint after the caller's
+  // lookup.
   unsigned int hashValue;
-  int index;
   if (use_alternate_hashcode()) {
     hashValue = hash_string(name, len);
-    index = hash_to_index(hashValue);
   } else {
     hashValue = hashValue_arg;
-    index = index_arg;
   }
+  int index = hash_to_index(hashValue);
 
   // Since look-up was done lock-free, we need to check if another
   // thread beat us in the race to insert the symbol.
@@ -707,9 +729,29 @@ oop StringTable::basic_add(int index_arg, Handle string, jchar* name,
 
   HashtableEntry<oop, mtSymbol>* entry = new_entry(hashValue, string());
   add_entry(index, entry);
+  check_resize_needed();
   return string();
 }
 
+// See SymbolTable::check_resize_needed().
+void StringTable::check_resize_needed() {
+  assert_locked_or_safepoint(StringTable_lock);
+  if (ResizeSymbolAndStringTables && !_needs_resizing && !DumpSharedSpaces &&
+      table_size() < maximumStringTableSize &&
+      (uintx)number_of_entries() > (uintx)table_size() * SymbolAndStringTableLoadFactor) {
+    _needs_resizing = true;
+  }
+}
+
+void StringTable::resize_table() {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
+  _needs_resizing = false;
+  int new_size = MIN2(the_table()->table_size() * 2, maximumStringTableSize);
+  if (!the_table()->resize(new_size) && PrintStringTableStatistics) {
+    warning("Could not grow the string table to %d buckets", new_size);
+  }
+}
+
 
 oop StringTable::lookup(Symbol* symbol) {
   ResourceMark rm;
@@ -780,7 +822,7 @@ oop StringTable::intern(Handle string_or_null, jchar* name,
   {
     MutexLocker ml(StringTable_lock, THREAD);
     // Otherwise, add to symbol to table
-    added_or_found = the_table()->basic_add(index, string, name, len,
+    added_or_found = the_table()->basic_add(string, name, len,
                                   hashValue, CHECK_NULL);
   }
 
@@ -1116,7 +1158,7 @@ void StringTable::rehash_table() {
   assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
   // This should never happen with -Xshare:dump but it might in testing mode.
   if (DumpSharedSpaces) return;
-  StringTable* new_table = new StringTable();
+  StringTable* new_table = new StringTable(the_table()->table_size());
 
   // Rehash the table
   the_table()->move_to(new_table);
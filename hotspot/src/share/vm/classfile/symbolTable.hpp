@@ -34,7 +34,9 @@
 //
 // The interned strings are created lazily.
 //
-// It is implemented as an open hash table with a fixed number of buckets.
+// It is implemented as an open hash table with lock-free lookup.  The number
+// of buckets starts at SymbolTableSize/StringTableSize and is grown at a
+// safepoint once the buckets get too long (see ResizeSymbolAndStringTables).
 //
 // %note:
 //  - symbolTableEntrys are allocated in blocks to reduce the space overhead.
@@ -85,6 +87,9 @@ private:
   // Set if one bucket is out of balance due to hash algorithm deficiency
   static bool _needs_rehashing;
 
+  // Set if the buckets are too long on average
+  static volatile bool _needs_resizing;
+
   // For statistics
   static int _symbols_removed;
   static int _symbols_counted;
@@ -92,7 +97,7 @@ private:
   Symbol* allocate_symbol(const u1* name, int len, bool c_heap, TRAPS); // Assumes no characters larger than 0x7F
 
   // Adding elements
-  Symbol* basic_add(int index, u1* name, int len, unsigned int hashValue,
+  Symbol* basic_add(u1* name, int len, unsigned int hashValue,
                     bool c_heap, TRAPS);
   bool basic_add(ClassLoaderData* loader_data,
                  constantPoolHandle cp, int names_count,
@@ -109,8 +114,11 @@ private:
 
   Symbol* lookup(int index, const char* name, int len, unsigned int hash);
 
-  SymbolTable()
-    : RehashableHashtable<Symbol*, mtSymbol>(SymbolTableSize, sizeof (HashtableEntry<Symbol*, mtSymbol>)) {}
+  // Called with SymbolTable_lock held after an entry was added
+  void check_resize_needed();
+
+  SymbolTable(int table_size)
+    : RehashableHashtable<Symbol*, mtSymbol>(table_size, sizeof (HashtableEntry<Symbol*, mtSymbol>)) {}
 
   SymbolTable(HashtableBucket<mtSymbol>* t, int number_of_entries)
     : RehashableHashtable<Symbol*, mtSymbol>(SymbolTableSize, sizeof (HashtableEntry<Symbol*, mtSymbol>), t,
@@ -131,7 +139,7 @@ private:
   static void buckets_unlink(int start_idx, int end_idx, BucketUnlinkContext* context, size_t* memory_total);
 public:
   enum {
-    symbol_alloc_batch_size = 8,
+    symbol_alloc_batch_size = 32,
     // Pick initial size based on java -version size measurements
     symbol_alloc_arena_size = 360*K
   };
@@ -146,7 +154,7 @@ public:
 
   static void create_table() {
     assert(_the_table == NULL, "One symbol table allowed.");
-    _the_table = new SymbolTable();
+    _the_table = new SymbolTable((int)SymbolTableSize);
     initialize_symbols(symbol_alloc_arena_size);
   }
 
@@ -252,6 +260,11 @@ public:
   // Rehash the symbol table if it gets out of balance
   static void rehash_table();
   static bool needs_rehashing()         { return _needs_rehashing; }
+
+  // Grow the symbol table if its buckets are too long
+  static void resize_table();
+  static bool needs_resizing()          { return _needs_resizing; }
+
   // Parallel chunked scanning
   static void clear_parallel_claimed_index() { _parallel_claimed_idx = 0; }
   static int parallel_claimed_index()        { return _parallel_claimed_idx; }
@@ -267,15 +280,21 @@ private:
   // Set if one bucket is out of balance due to hash algorithm deficiency
   static bool _needs_rehashing;
 
+  // Set if the buckets are too long on average
+  static volatile bool _needs_resizing;
+
   // Claimed high water mark for parallel chunked scanning
   static volatile int _parallel_claimed_idx;
 
   static oop intern(Handle string_or_null, jchar* chars, int length, TRAPS);
-  oop basic_add(int index, Handle string_or_null, jchar* name, int len,
+  oop basic_add(Handle string_or_null, jchar* name, int len,
                 unsigned int hashValue, TRAPS);
 
   oop lookup(int index, jchar* chars, int length, unsigned int hashValue);
 
+  // Called with StringTable_lock held after an entry was added
+  void check_resize_needed();
+
   // Apply the give oop closure to the entries to the buckets
   // in the range [start_idx, end_idx).
   static void buckets_oops_do(OopClosure* f, int start_idx, int end_idx);
@@ -287,7 +306,7 @@ private:
   // This allows multiple threads to work on the table at once.
   static void buckets_unlink_or_oops_do(BoolObjectClosure* is_alive, OopClosure* f, int start_idx, int end_idx, BucketUnlinkContext* context);
 
-  StringTable() : RehashableHashtable<oop, mtSymbol>((int)StringTableSize,
+  StringTable(int table_size) : RehashableHashtable<oop, mtSymbol>(table_size,
                               sizeof (HashtableEntry<oop, mtSymbol>)) {}
 
   StringTable(HashtableBucket<mtSymbol>* t, int number_of_entries)
@@ -303,7 +322,7 @@ public:
 
   static void create_table() {
     assert(_the_table == NULL, "One string table allowed.");
-    _the_table = new StringTable();
+    _the_table = new StringTable((int)StringTableSize);
   }
 
   // GC support
@@ -388,6 +407,10 @@ public:
   static void rehash_table();
   static bool needs_rehashing() { return _needs_rehashing; }
 
+  // Grow the string table if its buckets are too long
+  static void resize_table();
+  static bool needs_resizing()  { return _needs_resizing; }
+
   // Parallel chunked scanning
   static void clear_parallel_claimed_index() { _parallel_claimed_idx = 0; }
   static int parallel_claimed_index() { return _parallel_claimed_idx; }
@@ -625,6 +625,24 @@ static void post_class_load_event(EventClassLoad &event,
 #endif
 }
 
+// Takes SystemDictionary_lock to look up a class of the given loader,
+// counting for ClassLoaderStats how often lookups need the lock and how
+// often they find it taken.
+class DictionaryLookupLocker : public StackObj {
+ public:
+  DictionaryLookupLocker(ClassLoaderData* loader_data, Thread* thread) {
+    bool contended = !SystemDictionary_lock->try_lock();
+    if (contended) {
+      SystemDictionary_lock->lock(thread);
+    }
+    loader_data->record_locked_lookup(contended);
+  }
+
+  ~DictionaryLookupLocker() {
+    SystemDictionary_lock->unlock();
+  }
+};
+
 Klass* SystemDictionary::resolve_instance_class_or_null(Symbol* name,
                                                         Handle class_loader,
                                                         Handle protection_domain,
@@ -651,6 +669,20 @@ Klass* SystemDictionary::resolve_instance_class_or_null(Symbol* name,
                                       protection_domain, THREAD);
   if (probe != NULL) return probe;
 
+  // The class may be loaded already, just not yet checked against this
+  // protection domain. That needs neither the class loader lock nor
+  // SystemDictionary_lock, so look for it without them as well.
+  if (protection_domain() != NULL) {
+    Handle no_protection_domain;
+    probe = dictionary()->find(d_index, d_hash, name, loader_data,
+                               no_protection_domain, THREAD);
+    if (probe != NULL) {
+      instanceKlassHandle k(THREAD, probe);
+      validate_protection_domain(k, class_loader, protection_domain, CHECK_NULL);
+      return k();
+    }
+  }
+
 
   // Non-bootstrap class loaders will call out to class loader and
   // define via jvm/jni_DefineClass which will acquire the
@@ -684,7 +716,7 @@ Klass* SystemDictionary::resolve_instance_class_or_null(Symbol* name,
   Symbol* superclassname = NULL;
 
   {
-    MutexLocker mu(SystemDictionary_lock, THREAD);
+    DictionaryLookupLocker mu(loader_data, THREAD);
     Klass* check = find_class(d_index, d_hash, name, loader_data);
     if (check != NULL) {
       // Klass is already loaded, so just return it
@@ -897,9 +929,9 @@ Klass* SystemDictionary::resolve_instance_class_or_null(Symbol* name,
   // return if the protection domain in NULL
   if (protection_domain() == NULL) return k();
 
-  // Check the protection domain has the right access
+  // Check the protection domain has the right access. Like find(), this
+  // does not need SystemDictionary_lock.
   {
-    MutexLocker mu(SystemDictionary_lock, THREAD);
     // Note that we have an entry, and entries can be deleted only during GC,
     // so we cannot allow GC to occur while we're holding this entry.
     // We're using a No_Safepoint_Verifier to catch any place where we
@@ -2474,6 +2506,13 @@ static methodHandle unpack_method_and_appendix(Handle mname,
   return empty;
 }
 
+// Secondary key of the invoke_method_table entries that cache the linkage of
+// invokehandle call sites. Intrinsic and method type entries use vmIntrinsics
+// IDs, which are never negative.
+static intptr_t invoker_linkage_mode(Symbol* name) {
+  return -1 - (intptr_t)vmSymbols::find_sid(name);
+}
+
 methodHandle SystemDictionary::find_method_handle_invoker(Symbol* name,
                                                           Symbol* signature,
                                                           KlassHandle accessing_klass,
@@ -2486,6 +2525,34 @@ methodHandle SystemDictionary::find_method_handle_invoker(Symbol* name,
   Handle method_type =
     SystemDictionary::find_method_handle_type(signature, accessing_klass, CHECK_(empty));
 
+  // MethodHandleNatives.linkMethod builds the invoker of a MethodHandle
+  // from the name and the method type alone. If the method type is cached
+  // globally, so that every caller resolves the signature to the same
+  // classes, the linkage is too and later call sites skip the upcall.
+  bool can_be_cached = false;
+  unsigned int hash = 0;
+  int index = 0;
+  if (CacheMethodHandleInvokers && method_type.not_null()) {
+    unsigned int type_hash = invoke_method_table()->compute_hash(signature, vmIntrinsics::_none);
+    SymbolPropertyEntry* type_spe =
+      invoke_method_table()->find_entry(invoke_method_table()->hash_to_index(type_hash),
+                                        type_hash, signature, vmIntrinsics::_none);
+    can_be_cached = type_spe != NULL && type_spe->method_type() == method_type();
+  }
+  if (can_be_cached) {
+    intptr_t mode = invoker_linkage_mode(name);
+    hash  = invoke_method_table()->compute_hash(signature, mode);
+    index = invoke_method_table()->hash_to_index(hash);
+    SymbolPropertyEntry* spe = invoke_method_table()->find_entry(index, hash, signature, mode);
+    if (spe != NULL && spe->member_name() != NULL) {
+      objArrayHandle appendix_box = oopFactory::new_objArray(SystemDictionary::Object_klass(), 1, CHECK_(empty));
+      appendix_box->obj_at_put(0, spe->appendix());
+      Handle mname(THREAD, spe->member_name());
+      (*method_type_result) = method_type;
+      return unpack_method_and_appendix(mname, accessing_klass, appendix_box, appendix_result, THREAD);
+    }
+  }
+
   KlassHandle  mh_klass = SystemDictionary::MethodHandle_klass();
   int ref_kind = JVM_REF_invokeVirtual;
   Handle name_str = StringTable::intern(name, CHECK_(empty));
@@ -2513,7 +2580,20 @@ methodHandle SystemDictionary::find_method_handle_invoker(Symbol* name,
                          &args, CHECK_(empty));
   Handle mname(THREAD, (oop) result.get_jobject());
   (*method_type_result) = method_type;
-  return unpack_method_and_appendix(mname, accessing_klass, appendix_box, appendix_result, THREAD);
+  methodHandle m = unpack_method_and_appendix(mname, accessing_klass, appendix_box, appendix_result, CHECK_(empty));
+
+  if (can_be_cached) {
+    // The cache holds the MemberName, which keeps the invoker's class alive.
+    intptr_t mode = invoker_linkage_mode(name);
+    MutexLocker ml(SystemDictionary_lock, THREAD);
+    SymbolPropertyEntry* spe = invoke_method_table()->find_entry(index, hash, signature, mode);
+    if (spe == NULL)
+      spe = invoke_method_table()->add_entry(index, hash, signature, mode);
+    if (spe->member_name() == NULL) {
+      spe->set_linkage(mname(), (*appendix_result)());
+    }
+  }
+  return m;
 }
 
 // Decide if we can globally cache a lookup of this class, to be returned to any client that asks.
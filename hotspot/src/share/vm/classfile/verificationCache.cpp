@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "classfile/verificationCache.hpp"
+#include "classfile/verifier.hpp"
+#include "oops/instanceKlass.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/orderAccess.inline.hpp"
+#include "utilities/openAddressingHashtable.hpp"
+
+void VerificationDependency::increment_refcounts() {
+  _name->increment_refcount();
+  if (_other_name != NULL) {
+    _other_name->increment_refcount();
+  }
+  if (_signature != NULL) {
+    _signature->increment_refcount();
+  }
+}
+
+void VerificationDependency::decrement_refcounts() {
+  _name->decrement_refcount();
+  if (_other_name != NULL) {
+    _other_name->decrement_refcount();
+  }
+  if (_signature != NULL) {
+    _signature->decrement_refcount();
+  }
+}
+
+bool VerificationDependency::equals(VerificationDependency const& a,
+                                    VerificationDependency const& b) {
+  return a._kind == b._kind && a._flag == b._flag &&
+         a._other_is_object == b._other_is_object &&
+         a._name == b._name && a._other_name == b._other_name &&
+         a._signature == b._signature;
+}
+
+unsigned VerificationDependency::hash(VerificationDependency const& d) {
+  unsigned hash = d._kind;
+  hash = 31 * hash + d._name->identity_hash();
+  if (d._other_name != NULL) {
+    hash = 31 * hash + d._other_name->identity_hash();
+  }
+  if (d._signature != NULL) {
+    hash = 31 * hash + d._signature->identity_hash();
+  }
+  return hash;
+}
+
+// Entries by the first four bytes of their digest; entries with the same
+// ones are chained
+typedef OpenAddressingHashtable<juint, VerificationCacheEntry*,
+                                primitive_hash<juint>, primitive_equals<juint>,
+                                mtClass> VerificationCacheTable;
+
+static VerificationCacheTable* _table = NULL;
+
+size_t VerificationCache::_number_of_entries = 0;
+
+VerificationCacheEntry* VerificationCache::lookup_or_add(u1* bytes, int length) {
+  assert(UseVerificationCache, "why are we here?");
+  u1 digest[DL_SHA256];
+  sha256(bytes, (uint32_t) length, digest);
+  juint key;
+  memcpy(&key, digest, sizeof(key));
+
+  MutexLockerEx ml(VerificationCache_lock, Mutex::_no_safepoint_check_flag);
+  if (_table == NULL) {
+    _table = new VerificationCacheTable(1024);
+  }
+  VerificationCacheEntry** head = _table->get(key);
+  VerificationCacheEntry* first = head != NULL ? *head : NULL;
+  for (VerificationCacheEntry* e = first; e != NULL; e = e->_next) {
+    if (memcmp(e->_digest, digest, DL_SHA256) == 0) {
+      return e;
+    }
+  }
+  if (_number_of_entries >= VerificationCacheSize) {
+    return NULL;
+  }
+  VerificationCacheEntry* e = new VerificationCacheEntry(digest, first);
+  _table->put(key, e);
+  _number_of_entries++;
+  return e;
+}
+
+bool VerificationCache::dependencies_hold(instanceKlassHandle klass, TRAPS) {
+  VerificationCacheEntry* e = klass->verification_cache_entry();
+  if (e == NULL) {
+    return false;
+  }
+  int n = OrderAccess::load_acquire(&e->_num_dependencies);
+  if (n < 0) {
+    return false;
+  }
+  // The recorded dependencies never change once published, and the
+  // symbols in them are kept alive by the entry.
+  for (int i = 0; i < n; i++) {
+    const VerificationDependency& d = e->_dependencies[i];
+    bool answer = ClassVerifier::answer(klass, d, CHECK_false);
+    if (answer != d.answer()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool VerificationCache::should_record(instanceKlassHandle klass) {
+  VerificationCacheEntry* e = klass->verification_cache_entry();
+  return e != NULL && OrderAccess::load_acquire(&e->_num_dependencies) < 0;
+}
+
+void VerificationCache::record(instanceKlassHandle klass,
+                               GrowableArray<VerificationDependency>* dependencies) {
+  VerificationCacheEntry* e = klass->verification_cache_entry();
+  assert(e != NULL, "only record with an entry");
+  int n = dependencies->length();
+  VerificationDependency* array = NULL;
+  if (n > 0) {
+    array = NEW_C_HEAP_ARRAY(VerificationDependency, n, mtClass);
+    for (int i = 0; i < n; i++) {
+      array[i] = dependencies->at(i);
+      array[i].increment_refcounts();
+    }
+  }
+
+  {
+    MutexLockerEx ml(VerificationCache_lock, Mutex::_no_safepoint_check_flag);
+    if (e->_num_dependencies < 0) {
+      e->_dependencies = array;
+      OrderAccess::release_store(&e->_num_dependencies, n);
+      return;
+    }
+  }
+
+  // Another class with the same bytes got there first
+  for (int i = 0; i < n; i++) {
+    array[i].decrement_refcounts();
+  }
+  if (array != NULL) {
+    FREE_C_HEAP_ARRAY(VerificationDependency, array, mtClass);
+  }
+}
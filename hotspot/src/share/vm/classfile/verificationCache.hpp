@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_CLASSFILE_VERIFICATIONCACHE_HPP
+#define SHARE_VM_CLASSFILE_VERIFICATIONCACHE_HPP
+
+#include "memory/allocation.hpp"
+#include "oops/symbol.hpp"
+#include "runtime/handles.hpp"
+#include "utilities/growableArray.hpp"
+#include "utilities/hash.hpp"
+
+// A question about other classes that the split verifier asked while
+// verifying a class, and the answer it got. Everything else the verifier
+// looks at comes from the class file itself.
+class VerificationDependency VALUE_OBJ_CLASS_SPEC {
+ public:
+  enum Kind {
+    assignable,        // is _name assignable from _other_name?
+    protected_member,  // is the member _other_name _signature of _name protected
+                       // and in another package? (_flag: it is a method)
+    protected_init,    // is the <init> _signature of _name protected and
+                       // in another package?
+    in_supers          // is _name the name of a superclass?
+  };
+
+ private:
+  u1      _kind;
+  bool    _flag;
+  bool    _other_is_object;
+  bool    _answer;
+  Symbol* _name;
+  Symbol* _other_name;
+  Symbol* _signature;
+
+  VerificationDependency(Kind kind, Symbol* name, Symbol* other_name,
+                         Symbol* signature, bool flag, bool other_is_object) :
+    _kind(kind), _flag(flag), _other_is_object(other_is_object), _answer(false),
+    _name(name), _other_name(other_name), _signature(signature) {}
+
+ public:
+  VerificationDependency() :
+    _kind(in_supers), _flag(false), _other_is_object(false), _answer(false),
+    _name(NULL), _other_name(NULL), _signature(NULL) {}
+
+  static VerificationDependency is_assignable(Symbol* name, Symbol* from_name,
+                                              bool from_field_is_protected,
+                                              bool from_is_object) {
+    return VerificationDependency(assignable, name, from_name, NULL,
+                                  from_field_is_protected, from_is_object);
+  }
+  static VerificationDependency is_protected_member(Symbol* class_name, Symbol* name,
+                                                    Symbol* signature, bool is_method) {
+    return VerificationDependency(protected_member, class_name, name, signature,
+                                  is_method, false);
+  }
+  static VerificationDependency is_protected_init(Symbol* class_name, Symbol* signature) {
+    return VerificationDependency(protected_init, class_name, NULL, signature,
+                                  false, false);
+  }
+  static VerificationDependency is_in_supers(Symbol* name) {
+    return VerificationDependency(in_supers, name, NULL, NULL, false, false);
+  }
+
+  Kind    kind() const            { return (Kind) _kind; }
+  bool    flag() const            { return _flag; }
+  bool    other_is_object() const { return _other_is_object; }
+  Symbol* name() const            { return _name; }
+  Symbol* other_name() const      { return _other_name; }
+  Symbol* signature() const       { return _signature; }
+
+  bool answer() const             { return _answer; }
+  void set_answer(bool answer)    { _answer = answer; }
+
+  void increment_refcounts();
+  void decrement_refcounts();
+
+  // Same question, whatever the answer
+  static bool equals(VerificationDependency const& a, VerificationDependency const& b);
+  static unsigned hash(VerificationDependency const& d);
+};
+
+class VerificationCacheEntry : public CHeapObj<mtClass> {
+  friend class VerificationCache;
+ private:
+  VerificationCacheEntry*          _next;              // with the same hash
+  u1                               _digest[DL_SHA256];
+  VerificationDependency*          _dependencies;
+  volatile int                     _num_dependencies;  // -1 until verified
+
+  VerificationCacheEntry(const u1* digest, VerificationCacheEntry* next) :
+    _next(next), _dependencies(NULL), _num_dependencies(-1) {
+    memcpy(_digest, digest, DL_SHA256);
+  }
+};
+
+// Remembers which class files passed the split verifier and which
+// questions about other classes that took, so that the same bytes defined
+// again by another class loader, as application servers and plugin
+// frameworks do all the time, need not be verified again. Class files are
+// told apart by their SHA-256 digest.
+//
+// The verifier asks its questions in the same order every time it sees
+// the same bytes, so if they all get the recorded answers for the new
+// class, verifying it would take the same path and succeed as well.
+// Asking them again loads the same classes in the same order as
+// verification would, and throws the same exceptions.
+//
+// Entries are never freed; VerificationCacheSize bounds their number.
+class VerificationCache : AllStatic {
+ private:
+  static size_t _number_of_entries;
+
+ public:
+  // The entry for a class file that is going to be verified, or NULL if
+  // the cache is full. Called by the class file parser.
+  static VerificationCacheEntry* lookup_or_add(u1* bytes, int length);
+
+  // Whether klass verified before and all the questions its verification
+  // asked still get the same answers.
+  static bool dependencies_hold(instanceKlassHandle klass, TRAPS);
+
+  // Whether the questions asked verifying klass should be recorded
+  static bool should_record(instanceKlassHandle klass);
+
+  // Records that klass passed verification after asking these questions
+  static void record(instanceKlassHandle klass,
+                     GrowableArray<VerificationDependency>* dependencies);
+};
+
+#endif // SHARE_VM_CLASSFILE_VERIFICATIONCACHE_HPP
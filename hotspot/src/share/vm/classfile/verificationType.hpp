@@ -308,6 +308,12 @@ class VerificationType VALUE_OBJ_CLASS_SPEC {
 
   void print_on(outputStream* st) const;
 
+  // Whether the class name, as seen from klass, is assignable from the
+  // class or array from_name
+  static bool resolve_and_check_assignability(instanceKlassHandle klass, Symbol* name,
+                                              Symbol* from_name, bool from_field_is_protected,
+                                              bool from_is_object, TRAPS);
+
  private:
 
   bool is_reference_assignable_from(
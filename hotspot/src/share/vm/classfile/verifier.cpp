@@ -131,7 +131,18 @@ bool Verifier::verify(instanceKlassHandle klass, Verifier::Mode mode, bool shoul
     if (TraceClassInitialization) {
       tty->print_cr("Start class verification for: %s", klassName);
     }
-    if (klass->major_version() >= STACKMAP_ATTRIBUTE_MAJOR_VERSION) {
+    bool verified_before = false;
+    if (UseVerificationCache &&
+        klass->major_version() >= STACKMAP_ATTRIBUTE_MAJOR_VERSION) {
+      // Any exception is one the split verifier would have thrown too
+      verified_before = VerificationCache::dependencies_hold(klass, THREAD);
+      if (verified_before && (TraceClassInitialization || VerboseVerification)) {
+        tty->print_cr("Same class file verified before for: %s", klassName);
+      }
+    }
+    if (verified_before || HAS_PENDING_EXCEPTION) {
+      // Nothing more to do
+    } else if (klass->major_version() >= STACKMAP_ATTRIBUTE_MAJOR_VERSION) {
       ClassVerifier split_verifier(klass, THREAD);
       split_verifier.verify_class(THREAD);
       exception_name = split_verifier.result();
@@ -527,10 +538,17 @@ void ErrorContext::stackmap_details(outputStream* ss, const Method* method) cons
 
 ClassVerifier::ClassVerifier(
     instanceKlassHandle klass, TRAPS)
-    : _thread(THREAD), _exception_type(NULL), _message(NULL), _klass(klass) {
+    : _thread(THREAD), _exception_type(NULL), _message(NULL),
+      _dependencies(NULL), _asked(NULL), _klass(klass) {
   _this_type = VerificationType::reference_type(klass->name());
   // Create list to hold symbols in reference area.
   _symbols = new GrowableArray<Symbol*>(100, 0, NULL);
+  if (UseVerificationCache && VerificationCache::should_record(klass)) {
+    _dependencies = new GrowableArray<VerificationDependency>(32);
+    _asked = new ResourceHashtable<VerificationDependency, bool,
+                                   VerificationDependency::hash,
+                                   VerificationDependency::equals>();
+  }
 }
 
 ClassVerifier::~ClassVerifier() {
@@ -579,6 +597,45 @@ void ClassVerifier::verify_class(TRAPS) {
       tty->print_cr("Recursive verification detected for: %s",
           _klass->external_name());
   }
+
+  // A recursive verification cut this one short, so not all questions
+  // were asked
+  if (_dependencies != NULL && !was_recursively_verified()) {
+    VerificationCache::record(_klass, _dependencies);
+  }
+}
+
+bool ClassVerifier::ask(const VerificationDependency& question, TRAPS) {
+  bool result = answer(current_class(), question, CHECK_false);
+  // The same question always gets the same answer during one verification
+  if (_dependencies != NULL && _asked->put(question, true)) {
+    VerificationDependency d = question;
+    d.set_answer(result);
+    _dependencies->append(d);
+  }
+  return result;
+}
+
+bool ClassVerifier::answer(instanceKlassHandle klass,
+                           const VerificationDependency& question, TRAPS) {
+  switch (question.kind()) {
+    case VerificationDependency::assignable:
+      return VerificationType::resolve_and_check_assignability(
+        klass, question.name(), question.other_name(), question.flag(),
+        question.other_is_object(), THREAD);
+    case VerificationDependency::protected_member: {
+      Klass* target = load_class(klass, question.name(), CHECK_false);
+      return is_protected_access(klass, target, question.other_name(),
+                                 question.signature(), question.flag());
+    }
+    case VerificationDependency::protected_init:
+      return is_protected_init(klass, question.name(), question.signature(), THREAD);
+    case VerificationDependency::in_supers:
+      return name_in_supers(question.name(), klass);
+    default:
+      ShouldNotReachHere();
+      return false;
+  }
 }
 
 void ClassVerifier::verify_method(methodHandle m, TRAPS) {
@@ -1948,10 +2005,10 @@ void ClassVerifier::class_format_error(const char* msg, ...) {
   _message = ss.as_string();
 }
 
-Klass* ClassVerifier::load_class(Symbol* name, TRAPS) {
+Klass* ClassVerifier::load_class(instanceKlassHandle klass, Symbol* name, TRAPS) {
   // Get current loader and protection domain first.
-  oop loader = current_class()->class_loader();
-  oop protection_domain = current_class()->protection_domain();
+  oop loader = klass->class_loader();
+  oop protection_domain = klass->protection_domain();
 
   return SystemDictionary::resolve_or_fail(
     name, Handle(THREAD, loader), Handle(THREAD, protection_domain),
@@ -1990,6 +2047,17 @@ bool ClassVerifier::is_protected_access(instanceKlassHandle this_class,
   return false;
 }
 
+bool ClassVerifier::is_protected_init(instanceKlassHandle this_class,
+                                      Symbol* ref_class_name,
+                                      Symbol* init_sig, TRAPS) {
+  Klass* ref_klass = load_class(this_class, ref_class_name, CHECK_false);
+  Method* m = InstanceKlass::cast(ref_klass)->uncached_lookup_method(
+    vmSymbols::object_initializer_name(), init_sig, Klass::find_overpass);
+  // Do nothing if method is not found.  Let resolution detect the error.
+  return m != NULL && m->is_protected() &&
+         !m->method_holder()->is_same_class_package(this_class());
+}
+
 void ClassVerifier::verify_ldc(
     int opcode, u2 index, StackMapFrame* current_frame,
     constantPoolHandle cp, u2 bci, TRAPS) {
@@ -2229,16 +2297,17 @@ void ClassVerifier::verify_field_instructions(RawBytecodeStream* bcs,
         break; // stack_object_type must be assignable to _current_class_type
       Symbol* ref_class_name =
         cp->klass_name_at(cp->klass_ref_index_at(index));
-      if (!name_in_supers(ref_class_name, current_class()))
+      bool in_supers = ask(VerificationDependency::is_in_supers(ref_class_name), CHECK);
+      if (!in_supers)
         // stack_object_type must be assignable to _current_class_type since:
         // 1. stack_object_type must be assignable to ref_class.
         // 2. ref_class must be _current_class or a subclass of it. It can't
         //    be a superclass of it. See revised JVMS 5.4.4.
         break;
 
-      Klass* ref_class_oop = load_class(ref_class_name, CHECK);
-      if (is_protected_access(current_class(), ref_class_oop, field_name,
-                              field_sig, false)) {
+      bool is_protected = ask(VerificationDependency::is_protected_member(
+        ref_class_name, field_name, field_sig, false), CHECK);
+      if (is_protected) {
         // It's protected access, check if stack object is assignable to
         // current class.
         is_assignable = current_type().is_assignable_from(
@@ -2539,25 +2608,21 @@ void ClassVerifier::verify_invoke_init(
     // protected, then the objectref must be the current class or a subclass
     // of the current class.
     VerificationType objectref_type = new_class_type;
-    if (name_in_supers(ref_class_type.name(), current_class())) {
-      Klass* ref_klass = load_class(ref_class_type.name(), CHECK);
-      Method* m = InstanceKlass::cast(ref_klass)->uncached_lookup_method(
-        vmSymbols::object_initializer_name(),
-        cp->signature_ref_at(bcs->get_index_u2()), Klass::find_overpass);
-      // Do nothing if method is not found.  Let resolution detect the error.
-      if (m != NULL) {
-        instanceKlassHandle mh(THREAD, m->method_holder());
-        if (m->is_protected() && !mh->is_same_class_package(_klass())) {
-          bool assignable = current_type().is_assignable_from(
-            objectref_type, this, true, CHECK_VERIFY(this));
-          if (!assignable) {
-            verify_error(ErrorContext::bad_type(bci,
-                TypeOrigin::cp(new_class_index, objectref_type),
-                TypeOrigin::implicit(current_type())),
-                "Bad access to protected <init> method");
-            return;
-          }
-        }
+    bool is_protected = false;
+    bool in_supers = ask(VerificationDependency::is_in_supers(ref_class_type.name()), CHECK);
+    if (in_supers) {
+      is_protected = ask(VerificationDependency::is_protected_init(ref_class_type.name(),
+        cp->signature_ref_at(bcs->get_index_u2())), CHECK);
+    }
+    if (is_protected) {
+      bool assignable = current_type().is_assignable_from(
+        objectref_type, this, true, CHECK_VERIFY(this));
+      if (!assignable) {
+        verify_error(ErrorContext::bad_type(bci,
+            TypeOrigin::cp(new_class_index, objectref_type),
+            TypeOrigin::implicit(current_type())),
+            "Bad access to protected <init> method");
+        return;
       }
     }
     // Check the exception handler target stackmaps with the locals from the
@@ -2798,10 +2863,11 @@ void ClassVerifier::verify_invoke_instructions(
             cp->klass_name_at(cp->klass_ref_index_at(index));
           // See the comments in verify_field_instructions() for
           // the rationale behind this.
-          if (name_in_supers(ref_class_name, current_class())) {
-            Klass* ref_class = load_class(ref_class_name, CHECK);
-            if (is_protected_access(
-                  _klass, ref_class, method_name, method_sig, true)) {
+          bool in_supers = ask(VerificationDependency::is_in_supers(ref_class_name), CHECK);
+          if (in_supers) {
+            bool is_protected = ask(VerificationDependency::is_protected_member(
+              ref_class_name, method_name, method_sig, true), CHECK);
+            if (is_protected) {
               // It's protected access, check if stack object is
               // assignable to current class.
               bool is_assignable = current_type().is_assignable_from(
@@ -25,6 +25,7 @@
 #ifndef SHARE_VM_CLASSFILE_VERIFIER_HPP
 #define SHARE_VM_CLASSFILE_VERIFIER_HPP
 
+#include "classfile/verificationCache.hpp"
 #include "classfile/verificationType.hpp"
 #include "memory/gcLocker.hpp"
 #include "oops/klass.hpp"
@@ -32,6 +33,7 @@
 #include "runtime/handles.hpp"
 #include "utilities/growableArray.hpp"
 #include "utilities/exceptions.hpp"
+#include "utilities/resourceHash.hpp"
 
 // The verifier class
 class Verifier : AllStatic {
@@ -259,6 +261,13 @@ class ClassVerifier : public StackObj {
 
   ErrorContext _error_context;  // contains information about an error
 
+  // The questions asked about other classes, for the verification cache,
+  // or NULL if they are not recorded
+  GrowableArray<VerificationDependency>* _dependencies;
+  ResourceHashtable<VerificationDependency, bool,
+                    VerificationDependency::hash,
+                    VerificationDependency::equals>* _asked;
+
   void verify_method(methodHandle method, TRAPS);
   char* generate_code_data(methodHandle m, u4 code_length, TRAPS);
   void verify_exception_handler_table(u4 code_length, char* code_data,
@@ -270,10 +279,14 @@ class ClassVerifier : public StackObj {
     return cp_index_to_type(cp->klass_ref_index_at(index), cp, THREAD);
   }
 
-  bool is_protected_access(
+  static bool is_protected_access(
     instanceKlassHandle this_class, Klass* target_class,
     Symbol* field_name, Symbol* field_sig, bool is_method);
 
+  static bool is_protected_init(
+    instanceKlassHandle this_class, Symbol* ref_class_name,
+    Symbol* init_sig, TRAPS);
+
   void verify_cp_index(u2 bci, constantPoolHandle cp, int index, TRAPS);
   void verify_cp_type(u2 bci, int index, constantPoolHandle cp,
       unsigned int types, TRAPS);
@@ -340,7 +353,7 @@ class ClassVerifier : public StackObj {
   void verify_astore(u2 index, StackMapFrame* current_frame, TRAPS);
   void verify_iinc  (u2 index, StackMapFrame* current_frame, TRAPS);
 
-  bool name_in_supers(Symbol* ref_name, instanceKlassHandle current);
+  static bool name_in_supers(Symbol* ref_name, instanceKlassHandle current);
 
   VerificationType object_type() const;
 
@@ -398,7 +411,18 @@ class ClassVerifier : public StackObj {
   void verify_error(ErrorContext ctx, const char* fmt, ...) ATTRIBUTE_PRINTF(3, 4);
   void class_format_error(const char* fmt, ...) ATTRIBUTE_PRINTF(2, 3);
 
-  Klass* load_class(Symbol* name, TRAPS);
+  Klass* load_class(Symbol* name, TRAPS) {
+    return load_class(current_class(), name, THREAD);
+  }
+  static Klass* load_class(instanceKlassHandle klass, Symbol* name, TRAPS);
+
+  // Answers a question about other classes for the class being verified,
+  // recording it if needed
+  bool ask(const VerificationDependency& question, TRAPS);
+
+  // Answers a question about other classes as seen from klass
+  static bool answer(instanceKlassHandle klass,
+                     const VerificationDependency& question, TRAPS);
 
   int change_sig_to_verificationType(
     SignatureStream* sig_type, VerificationType* inference_type, TRAPS);
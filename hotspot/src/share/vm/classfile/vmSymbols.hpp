@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 1997, 2018, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 1997, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -383,6 +383,7 @@
   template(offset_name,                               "offset")                                   \
   template(count_name,                                "count")                                    \
   template(hash_name,                                 "hash")                                     \
+  template(coder_name,                                "coder")                                    \
   template(numberOfLeadingZeros_name,                 "numberOfLeadingZeros")                     \
   template(numberOfTrailingZeros_name,                "numberOfTrailingZeros")                    \
   template(bitCount_name,                             "bitCount")                                 \
@@ -522,9 +523,15 @@
   template(String_StringBuilder_signature,            "(Ljava/lang/String;)Ljava/lang/StringBuilder;")            \
   template(int_StringBuilder_signature,               "(I)Ljava/lang/StringBuilder;")                             \
   template(char_StringBuilder_signature,              "(C)Ljava/lang/StringBuilder;")                             \
+  template(long_StringBuilder_signature,              "(J)Ljava/lang/StringBuilder;")                             \
+  template(boolean_StringBuilder_signature,           "(Z)Ljava/lang/StringBuilder;")                             \
+  template(char_array_StringBuilder_signature,        "([C)Ljava/lang/StringBuilder;")                            \
   template(String_StringBuffer_signature,             "(Ljava/lang/String;)Ljava/lang/StringBuffer;")             \
   template(int_StringBuffer_signature,                "(I)Ljava/lang/StringBuffer;")                              \
   template(char_StringBuffer_signature,               "(C)Ljava/lang/StringBuffer;")                              \
+  template(long_StringBuffer_signature,               "(J)Ljava/lang/StringBuffer;")                              \
+  template(boolean_StringBuffer_signature,            "(Z)Ljava/lang/StringBuffer;")                              \
+  template(char_array_StringBuffer_signature,         "([C)Ljava/lang/StringBuffer;")                             \
   template(int_String_signature,                      "(I)Ljava/lang/String;")                                    \
   template(codesource_permissioncollection_signature, "(Ljava/security/CodeSource;Ljava/security/PermissionCollection;)V") \
   /* signature symbols needed by intrinsics */                                                                    \
@@ -691,6 +698,13 @@
   do_intrinsic(_dlog10,                   java_lang_Math,         log10_name, double_double_signature,           F_S)   \
   do_intrinsic(_dpow,                     java_lang_Math,         pow_name,   double2_double_signature,          F_S)   \
   do_intrinsic(_dexp,                     java_lang_Math,         exp_name,   double_double_signature,           F_S)   \
+  do_intrinsic(_strict_dsin,              java_lang_StrictMath,   sin_name,   double_double_signature,           F_SN)  \
+  do_intrinsic(_strict_dcos,              java_lang_StrictMath,   cos_name,   double_double_signature,           F_SN)  \
+  do_intrinsic(_strict_dtan,              java_lang_StrictMath,   tan_name,   double_double_signature,           F_SN)  \
+  do_intrinsic(_strict_dlog,              java_lang_StrictMath,   log_name,   double_double_signature,           F_SN)  \
+  do_intrinsic(_strict_dlog10,            java_lang_StrictMath,   log10_name, double_double_signature,           F_SN)  \
+  do_intrinsic(_strict_dpow,              java_lang_StrictMath,   pow_name,   double2_double_signature,          F_SN)  \
+  do_intrinsic(_strict_dexp,              java_lang_StrictMath,   exp_name,   double_double_signature,           F_SN)  \
   do_intrinsic(_min,                      java_lang_Math,         min_name,   int2_int_signature,                F_S)   \
   do_intrinsic(_max,                      java_lang_Math,         max_name,   int2_int_signature,                F_S)   \
   do_intrinsic(_addExactI,                java_lang_Math,         addExact_name, int2_int_signature,             F_S)   \
@@ -797,6 +811,14 @@
                                                                                                                         \
   do_intrinsic(_equalsC,                  java_util_Arrays,       equals_name,    equalsC_signature,             F_S)   \
    do_signature(equalsC_signature,                               "([C[C)Z")                                             \
+  do_intrinsic(_equalsB,                  java_util_Arrays,       equals_name,    equalsB_signature,             F_S)   \
+   do_signature(equalsB_signature,                               "([B[B)Z")                                             \
+  do_intrinsic(_equalsS,                  java_util_Arrays,       equals_name,    equalsS_signature,             F_S)   \
+   do_signature(equalsS_signature,                               "([S[S)Z")                                             \
+  do_intrinsic(_equalsI,                  java_util_Arrays,       equals_name,    equalsI_signature,             F_S)   \
+   do_signature(equalsI_signature,                               "([I[I)Z")                                             \
+  do_intrinsic(_equalsJ,                  java_util_Arrays,       equals_name,    equalsJ_signature,             F_S)   \
+   do_signature(equalsJ_signature,                               "([J[J)Z")                                             \
                                                                                                                         \
   do_intrinsic(_compareTo,                java_lang_String,       compareTo_name, string_int_signature,          F_R)   \
    do_name(     compareTo_name,                                  "compareTo")                                           \
@@ -893,6 +915,10 @@
    do_name(     updateByteBuffer_name,                           "updateByteBuffer")                                    \
    do_signature(updateByteBuffer_signature,                      "(IJII)I")                                             \
                                                                                                                         \
+  do_class(java_util_zip_Adler32,         "java/util/zip/Adler32")                                                      \
+  do_intrinsic(_updateBytesAdler32,        java_util_zip_Adler32, updateBytes_name, updateBytes_signature,       F_SN)  \
+  do_intrinsic(_updateByteBufferAdler32,   java_util_zip_Adler32, updateByteBuffer_name, updateByteBuffer_signature, F_SN) \
+                                                                                                                        \
   /* support for sun.misc.Unsafe */                                                                                     \
   do_class(sun_misc_Unsafe,               "sun/misc/Unsafe")                                                            \
                                                                                                                         \
@@ -1097,6 +1123,9 @@
   do_intrinsic(_StringBuilder_append_char,   java_lang_StringBuilder, append_name, char_StringBuilder_signature,   F_R)   \
   do_intrinsic(_StringBuilder_append_int,    java_lang_StringBuilder, append_name, int_StringBuilder_signature,    F_R)   \
   do_intrinsic(_StringBuilder_append_String, java_lang_StringBuilder, append_name, String_StringBuilder_signature, F_R)   \
+  do_intrinsic(_StringBuilder_append_long,   java_lang_StringBuilder, append_name, long_StringBuilder_signature,   F_R)   \
+  do_intrinsic(_StringBuilder_append_boolean, java_lang_StringBuilder, append_name, boolean_StringBuilder_signature, F_R) \
+  do_intrinsic(_StringBuilder_append_char_array, java_lang_StringBuilder, append_name, char_array_StringBuilder_signature, F_R) \
                                                                                                                           \
   do_intrinsic(_StringBuilder_toString, java_lang_StringBuilder, toString_name, void_string_signature,             F_R)   \
                                                                                                                           \
@@ -1107,6 +1136,9 @@
   do_intrinsic(_StringBuffer_append_char,   java_lang_StringBuffer, append_name, char_StringBuffer_signature,      F_Y)   \
   do_intrinsic(_StringBuffer_append_int,    java_lang_StringBuffer, append_name, int_StringBuffer_signature,       F_Y)   \
   do_intrinsic(_StringBuffer_append_String, java_lang_StringBuffer, append_name, String_StringBuffer_signature,    F_Y)   \
+  do_intrinsic(_StringBuffer_append_long,   java_lang_StringBuffer, append_name, long_StringBuffer_signature,      F_Y)   \
+  do_intrinsic(_StringBuffer_append_boolean, java_lang_StringBuffer, append_name, boolean_StringBuffer_signature,  F_Y)   \
+  do_intrinsic(_StringBuffer_append_char_array, java_lang_StringBuffer, append_name, char_array_StringBuffer_signature, F_Y) \
                                                                                                                           \
   do_intrinsic(_StringBuffer_toString,  java_lang_StringBuffer, toString_name, void_string_signature,              F_Y)   \
                                                                                                                           \
@@ -34,8 +34,12 @@
 // Used in the CodeCache to assign CodeBlobs to different CodeHeaps
 struct CodeBlobType {
   enum {
-    All                 = 0,    // All types (No code cache segmentation)
-    NumTypes            = 1     // Number of CodeBlobTypes
+    MethodNonProfiled   = 0,    // Execution level 0, 1 and 4 (non-profiled) nmethods (including native nmethods)
+    MethodProfiled      = 1,    // Execution level 2 and 3 (profiled) nmethods
+    NonNMethod          = 2,    // Non-nmethods like Buffers, Adapters and Runtime Stubs
+    MethodHot           = 3,    // Execution level 4 nmethods of hot methods
+    All                 = 4,    // All types (No code cache segmentation)
+    NumTypes            = 5     // Number of CodeBlobTypes
   };
 };
 
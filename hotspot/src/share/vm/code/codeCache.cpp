@@ -119,7 +119,12 @@ class CodeBlob_sizes {
 
 // CodeCache implementation
 
-CodeHeap * CodeCache::_heap = new CodeHeap();
+CodeHeap * CodeCache::_heap = new CodeHeap("Code Cache");
+CodeHeap * CodeCache::_heaps[CodeBlobType::NumTypes] = { NULL };
+int CodeCache::_heap_types[CodeBlobType::NumTypes] = { 0 };
+int CodeCache::_number_of_heaps = 0;
+address CodeCache::_low_bound = NULL;
+address CodeCache::_high_bound = NULL;
 int CodeCache::_number_of_blobs = 0;
 int CodeCache::_number_of_adapters = 0;
 int CodeCache::_number_of_nmethods = 0;
@@ -129,15 +134,98 @@ nmethod* CodeCache::_scavenge_root_nmethods = NULL;
 
 int CodeCache::_codemem_full_count = 0;
 
+// Iteration runs over the code heaps in address order.
 CodeBlob* CodeCache::first() {
   assert_locked_or_safepoint(CodeCache_lock);
-  return (CodeBlob*)_heap->first();
+  for (int i = 0; i < _number_of_heaps; i++) {
+    CodeBlob* cb = (CodeBlob*)_heaps[i]->first();
+    if (cb != NULL) {
+      return cb;
+    }
+  }
+  return NULL;
 }
 
 
 CodeBlob* CodeCache::next(CodeBlob* cb) {
   assert_locked_or_safepoint(CodeCache_lock);
-  return (CodeBlob*)_heap->next(cb);
+  int i = 0;
+  while (!_heaps[i]->contains(cb)) {
+    i++;
+    assert(i < _number_of_heaps, "blob must be in a code heap");
+  }
+  CodeBlob* next = (CodeBlob*)_heaps[i]->next(cb);
+  while (next == NULL && ++i < _number_of_heaps) {
+    next = (CodeBlob*)_heaps[i]->first();
+  }
+  return next;
+}
+
+bool CodeCache::heap_available(int code_blob_type) {
+  return get_code_heap_for_type(code_blob_type) != NULL;
+}
+
+CodeHeap* CodeCache::get_code_heap_for_type(int code_blob_type) {
+  for (int i = 0; i < _number_of_heaps; i++) {
+    if (_heap_types[i] == code_blob_type || _heap_types[i] == CodeBlobType::All) {
+      return _heaps[i];
+    }
+  }
+  return NULL;
+}
+
+int CodeCache::get_code_blob_type(int comp_level) {
+  if (!SegmentedCodeCache) {
+    return CodeBlobType::All;
+  }
+  if ((comp_level == CompLevel_limited_profile || comp_level == CompLevel_full_profile) &&
+      heap_available(CodeBlobType::MethodProfiled)) {
+    return CodeBlobType::MethodProfiled;
+  }
+  return CodeBlobType::MethodNonProfiled;
+}
+
+// Fully optimized code of methods whose counters show they are hot goes
+// to the hot code heap, if there is one, to keep the hottest code dense.
+int CodeCache::get_code_blob_type(int comp_level, Method* method) {
+  int code_blob_type = get_code_blob_type(comp_level);
+  if (code_blob_type == CodeBlobType::MethodNonProfiled &&
+      comp_level == CompLevel_full_optimization &&
+      heap_available(CodeBlobType::MethodHot)) {
+    jlong count = (jlong)method->invocation_count() + method->backedge_count();
+    if (count >= HotCodeThreshold) {
+      return CodeBlobType::MethodHot;
+    }
+  }
+  return code_blob_type;
+}
+
+int CodeCache::get_code_blob_type(const CodeBlob* cb) {
+  for (int i = 0; i < _number_of_heaps; i++) {
+    if (_heaps[i]->contains(cb)) {
+      return _heap_types[i];
+    }
+  }
+  ShouldNotReachHere();
+  return CodeBlobType::All;
+}
+
+// The code heap to try when the heap for code_blob_type is full, or -1.
+// Non-method code and non-profiled methods may spill into the heaps of
+// less valuable code, but profiled methods never take up the room of
+// non-profiled ones: they are short-lived and get flushed first instead.
+int CodeCache::fallback_code_blob_type(int code_blob_type) {
+  int type = -1;
+  switch (code_blob_type) {
+    case CodeBlobType::NonNMethod:        type = CodeBlobType::MethodNonProfiled; break;
+    case CodeBlobType::MethodHot:         type = CodeBlobType::MethodNonProfiled; break;
+    case CodeBlobType::MethodNonProfiled: type = CodeBlobType::MethodProfiled;    break;
+    default:                              break;
+  }
+  if (type != -1 && !heap_available(type)) {
+    type = fallback_code_blob_type(type);
+  }
+  return type;
 }
 
 
@@ -174,7 +262,7 @@ nmethod* CodeCache::next_nmethod (CodeBlob* cb) {
 
 static size_t maxCodeCacheUsed = 0;
 
-CodeBlob* CodeCache::allocate(int size, bool is_critical) {
+CodeBlob* CodeCache::allocate(int size, int code_blob_type, bool is_critical) {
   // Do not seize the CodeCache lock here--if the caller has not
   // already done so, we are going to lose bigtime, since the code
   // cache will contain a garbage CodeBlob until the caller can
@@ -183,29 +271,34 @@ CodeBlob* CodeCache::allocate(int size, bool is_critical) {
   guarantee(size >= 0, "allocation request must be reasonable");
   assert_locked_or_safepoint(CodeCache_lock);
   CodeBlob* cb = NULL;
-  _number_of_blobs++;
+  CodeHeap* heap = get_code_heap_for_type(code_blob_type);
+  assert(heap != NULL, err_msg("no code heap for type %d", code_blob_type));
   while (true) {
-    cb = (CodeBlob*)_heap->allocate(size, is_critical);
+    cb = (CodeBlob*)heap->allocate(size, is_critical);
     if (cb != NULL) break;
-    if (!_heap->expand_by(CodeCacheExpansionSize)) {
+    if (!heap->expand_by(CodeCacheExpansionSize)) {
       // Expansion failed
+      int fallback_type = SegmentedCodeCache ? fallback_code_blob_type(code_blob_type) : -1;
+      if (fallback_type != -1) {
+        return allocate(size, fallback_type, is_critical);
+      }
       if (CodeCache_lock->owned_by_self()) {
         MutexUnlockerEx mu(CodeCache_lock, Mutex::_no_safepoint_check_flag);
-        report_codemem_full();
+        report_codemem_full(code_blob_type);
       } else {
-        report_codemem_full();
+        report_codemem_full(code_blob_type);
       }
       return NULL;
     }
     if (PrintCodeCacheExtension) {
       ResourceMark rm;
-      tty->print_cr("code cache extended to [" INTPTR_FORMAT ", " INTPTR_FORMAT "] (" SSIZE_FORMAT " bytes)",
-                    (intptr_t)_heap->low_boundary(), (intptr_t)_heap->high(),
-                    (address)_heap->high() - (address)_heap->low_boundary());
+      tty->print_cr("%s extended to [" INTPTR_FORMAT ", " INTPTR_FORMAT "] (" SSIZE_FORMAT " bytes)",
+                    heap->name(), (intptr_t)heap->low_boundary(), (intptr_t)heap->high(),
+                    (address)heap->high() - (address)heap->low_boundary());
     }
   }
-  maxCodeCacheUsed = MAX2(maxCodeCacheUsed, ((address)_heap->high_boundary() -
-                          (address)_heap->low_boundary()) - unallocated_capacity());
+  _number_of_blobs++;
+  maxCodeCacheUsed = MAX2(maxCodeCacheUsed, max_capacity() - unallocated_capacity());
   verify_if_often();
   print_trace("allocation", cb, size);
   return cb;
@@ -227,7 +320,9 @@ void CodeCache::free(CodeBlob* cb) {
   }
   _number_of_blobs--;
 
-  _heap->deallocate(cb);
+  CodeHeap* heap = get_code_heap(cb);
+  assert(heap != NULL, "blob must be in a code heap");
+  heap->deallocate(cb);
 
   verify_if_often();
   assert(_number_of_blobs >= 0, "sanity check");
@@ -267,7 +362,7 @@ void CodeCache::flush() {
 
 bool CodeCache::contains(void *p) {
   // It should be ok to call contains without holding a lock
-  return _heap->contains(p);
+  return get_code_heap(p) != NULL;
 }
 
 
@@ -585,13 +680,46 @@ void CodeCache::verify_oops() {
 
 address CodeCache::first_address() {
   assert_locked_or_safepoint(CodeCache_lock);
-  return (address)_heap->low_boundary();
+  return (address)_heaps[0]->low_boundary();
 }
 
 
 address CodeCache::last_address() {
   assert_locked_or_safepoint(CodeCache_lock);
-  return (address)_heap->high();
+  return high();
+}
+
+address CodeCache::high() {
+  return (address)_heaps[_number_of_heaps - 1]->high();
+}
+
+size_t CodeCache::capacity() {
+  size_t cap = 0;
+  for (int i = 0; i < _number_of_heaps; i++) {
+    cap += _heaps[i]->capacity();
+  }
+  return cap;
+}
+
+size_t CodeCache::max_capacity() {
+  size_t max_cap = 0;
+  for (int i = 0; i < _number_of_heaps; i++) {
+    max_cap += _heaps[i]->max_capacity();
+  }
+  return max_cap;
+}
+
+size_t CodeCache::unallocated_capacity() {
+  size_t unallocated_cap = 0;
+  for (int i = 0; i < _number_of_heaps; i++) {
+    unallocated_cap += _heaps[i]->unallocated_capacity();
+  }
+  return unallocated_cap;
+}
+
+size_t CodeCache::unallocated_capacity(int code_blob_type) {
+  CodeHeap* heap = get_code_heap_for_type(code_blob_type);
+  return (heap != NULL) ? heap->unallocated_capacity() : 0;
 }
 
 /**
@@ -604,6 +732,17 @@ double CodeCache::reverse_free_ratio() {
   return max_capacity / unallocated_capacity;
 }
 
+// Same as above, but for the code heap holding code_blob_type.
+double CodeCache::reverse_free_ratio(int code_blob_type) {
+  CodeHeap* heap = get_code_heap_for_type(code_blob_type);
+  if (heap == NULL) {
+    return 0;
+  }
+  double unallocated_capacity = (double)(heap->unallocated_capacity() - CodeCacheMinimumFreeSpace);
+  double max_capacity = (double)heap->max_capacity();
+  return max_capacity / unallocated_capacity;
+}
+
 void icache_init();
 
 void CodeCache::initialize() {
@@ -618,11 +757,16 @@ void CodeCache::initialize() {
   CodeCacheExpansionSize = round_to(CodeCacheExpansionSize, os::vm_page_size());
   InitialCodeCacheSize = round_to(InitialCodeCacheSize, os::vm_page_size());
   ReservedCodeCacheSize = round_to(ReservedCodeCacheSize, os::vm_page_size());
-  if (!_heap->reserve(ReservedCodeCacheSize, InitialCodeCacheSize, CodeCacheSegmentSize)) {
-    vm_exit_during_initialization("Could not reserve enough space for code cache");
+  if (SegmentedCodeCache) {
+    initialize_heaps();
+  } else {
+    if (!_heap->reserve(ReservedCodeCacheSize, InitialCodeCacheSize, CodeCacheSegmentSize)) {
+      vm_exit_during_initialization("Could not reserve enough space for code cache");
+    }
+    add_heap(_heap, CodeBlobType::All);
   }
-
-  MemoryService::add_code_heap_memory_pool(_heap);
+  _low_bound  = (address)_heaps[0]->low_boundary();
+  _high_bound = (address)_heaps[_number_of_heaps - 1]->high_boundary();
 
   // Initialize ICache flush mechanism
   // This service is needed for os::register_code_area
@@ -631,7 +775,87 @@ void CodeCache::initialize() {
   // Give OS a chance to register generated code area.
   // This is used on Windows 64 bit platforms to register
   // Structured Exception Handlers for our generated code.
-  os::register_code_area(_heap->low_boundary(), _heap->high_boundary());
+  os::register_code_area((char*)low_bound(), (char*)high_bound());
+}
+
+void CodeCache::add_heap(CodeHeap* heap, int code_blob_type) {
+  assert(_number_of_heaps < CodeBlobType::NumTypes, "too many code heaps");
+  _heaps[_number_of_heaps] = heap;
+  _heap_types[_number_of_heaps] = code_blob_type;
+  _number_of_heaps++;
+  MemoryService::add_code_heap_memory_pool(heap, heap->name());
+}
+
+void CodeCache::add_heap(ReservedSpace rs, const char* name, int code_blob_type) {
+  CodeHeap* heap = new CodeHeap(name);
+  if (!heap->reserve(rs, MIN2((size_t)InitialCodeCacheSize, rs.size()), CodeCacheSegmentSize)) {
+    vm_exit_during_initialization("Could not reserve enough space for code cache");
+  }
+  if (_number_of_heaps == 0) {
+    _heap = heap;
+  }
+  add_heap(heap, code_blob_type);
+}
+
+// Sizes the code heaps and carves them out of a single reservation, in
+// the order non-method, hot, profiled, non-profiled.
+void CodeCache::initialize_heaps() {
+  size_t page_size = os::vm_page_size();
+  if (UseLargePagesInCodeCache && os::can_execute_large_page_memory()) {
+    page_size = os::page_size_for_region_unaligned(ReservedCodeCacheSize, 8);
+  }
+  const size_t granularity = os::vm_allocation_granularity();
+  const size_t alignment = MAX2(page_size, granularity);
+
+  // Profiled code only exists with tiered compilation.
+  const bool has_profiled = TieredCompilation;
+  size_t non_nmethod_size  = NonNMethodCodeHeapSize;
+  size_t profiled_size     = has_profiled ? ProfiledCodeHeapSize : 0;
+  size_t non_profiled_size = NonProfiledCodeHeapSize;
+  const size_t hot_size    = align_size_up(HotCodeHeapSize, alignment);
+  if (non_nmethod_size == 0) {
+    non_nmethod_size = MIN2((size_t)8*M, ReservedCodeCacheSize / 8);
+  }
+  non_nmethod_size = align_size_up(MAX2(non_nmethod_size, (size_t)CodeCacheMinimumUseSpace), alignment);
+  if (non_nmethod_size + hot_size + profiled_size + non_profiled_size > ReservedCodeCacheSize) {
+    vm_exit_during_initialization(err_msg("Code heap sizes add up to more than "
+                                          "ReservedCodeCacheSize (" SIZE_FORMAT "K)",
+                                          ReservedCodeCacheSize/K));
+  }
+  // Whatever is left goes to the method heaps that were not sized.
+  size_t left = ReservedCodeCacheSize - non_nmethod_size - hot_size - profiled_size - non_profiled_size;
+  if (has_profiled && profiled_size == 0) {
+    profiled_size = (non_profiled_size == 0) ? left / 2 : left;
+    left -= profiled_size;
+  }
+  non_profiled_size += left;
+  profiled_size     = align_size_down(profiled_size, alignment);
+  non_profiled_size = align_size_down(non_profiled_size, alignment);
+  if (non_profiled_size == 0 || (has_profiled && profiled_size == 0)) {
+    vm_exit_during_initialization("Not enough space for the code heaps, "
+                                  "increase ReservedCodeCacheSize");
+  }
+
+  const size_t total_size = non_nmethod_size + hot_size + profiled_size + non_profiled_size;
+  const size_t rs_align = page_size == (size_t) os::vm_page_size() ? 0 : alignment;
+  ReservedCodeSpace rs(total_size, rs_align, rs_align > 0);
+  if (!rs.is_reserved()) {
+    vm_exit_during_initialization("Could not reserve enough space for code cache");
+  }
+
+  ReservedSpace rest = rs;
+  add_heap(rest.first_part(non_nmethod_size), "CodeHeap 'non-nmethods'", CodeBlobType::NonNMethod);
+  rest = rest.last_part(non_nmethod_size);
+  if (hot_size > 0) {
+    // The hot heap is next to the stubs the hot code calls most.
+    add_heap(rest.first_part(hot_size), "CodeHeap 'hot nmethods'", CodeBlobType::MethodHot);
+    rest = rest.last_part(hot_size);
+  }
+  if (has_profiled) {
+    add_heap(rest.first_part(profiled_size), "CodeHeap 'profiled nmethods'", CodeBlobType::MethodProfiled);
+    rest = rest.last_part(profiled_size);
+  }
+  add_heap(rest, "CodeHeap 'non-profiled nmethods'", CodeBlobType::MethodNonProfiled);
 }
 
 
@@ -776,24 +1000,27 @@ void CodeCache::make_marked_nmethods_not_entrant() {
 }
 
 void CodeCache::verify() {
-  _heap->verify();
+  for (int i = 0; i < _number_of_heaps; i++) {
+    _heaps[i]->verify();
+  }
   FOR_ALL_ALIVE_BLOBS(p) {
     p->verify();
   }
 }
 
-void CodeCache::report_codemem_full() {
+void CodeCache::report_codemem_full(int code_blob_type) {
   _codemem_full_count++;
   EventCodeCacheFull event;
   if (event.should_commit()) {
-    event.set_codeBlobType((u1)CodeBlobType::All);
-    event.set_startAddress((u8)low_bound());
-    event.set_commitedTopAddress((u8)high());
-    event.set_reservedTopAddress((u8)high_bound());
+    CodeHeap* heap = (code_blob_type == CodeBlobType::All) ? NULL : get_code_heap_for_type(code_blob_type);
+    event.set_codeBlobType((u1)code_blob_type);
+    event.set_startAddress((u8)(heap != NULL ? (address)heap->low_boundary() : low_bound()));
+    event.set_commitedTopAddress((u8)(heap != NULL ? (address)heap->high() : high()));
+    event.set_reservedTopAddress((u8)(heap != NULL ? (address)heap->high_boundary() : high_bound()));
     event.set_entryCount(nof_blobs());
     event.set_methodCount(nof_nmethods());
     event.set_adaptorCount(nof_adapters());
-    event.set_unallocatedCapacity(unallocated_capacity()/K);
+    event.set_unallocatedCapacity((heap != NULL ? heap->unallocated_capacity() : unallocated_capacity())/K);
     event.set_fullCount(_codemem_full_count);
     event.commit();
   }
@@ -806,7 +1033,9 @@ void CodeCache::report_codemem_full() {
 
 void CodeCache::verify_if_often() {
   if (VerifyCodeCacheOften) {
-    _heap->verify();
+    for (int i = 0; i < _number_of_heaps; i++) {
+      _heaps[i]->verify();
+    }
   }
 }
 
@@ -978,17 +1207,26 @@ void CodeCache::print() {
 }
 
 void CodeCache::print_summary(outputStream* st, bool detailed) {
-  size_t total = (_heap->high_boundary() - _heap->low_boundary());
+  size_t total = max_capacity();
   st->print_cr("CodeCache: size=" SIZE_FORMAT "Kb used=" SIZE_FORMAT
                "Kb max_used=" SIZE_FORMAT "Kb free=" SIZE_FORMAT "Kb",
                total/K, (total - unallocated_capacity())/K,
                maxCodeCacheUsed/K, unallocated_capacity()/K);
 
   if (detailed) {
-    st->print_cr(" bounds [" INTPTR_FORMAT ", " INTPTR_FORMAT ", " INTPTR_FORMAT "]",
-                 p2i(_heap->low_boundary()),
-                 p2i(_heap->high()),
-                 p2i(_heap->high_boundary()));
+    for (int i = 0; i < _number_of_heaps; i++) {
+      CodeHeap* heap = _heaps[i];
+      if (SegmentedCodeCache) {
+        st->print_cr(" %s: size=" SIZE_FORMAT "Kb used=" SIZE_FORMAT "Kb free=" SIZE_FORMAT "Kb",
+                     heap->name(), heap->max_capacity()/K,
+                     (heap->max_capacity() - heap->unallocated_capacity())/K,
+                     heap->unallocated_capacity()/K);
+      }
+      st->print_cr(" bounds [" INTPTR_FORMAT ", " INTPTR_FORMAT ", " INTPTR_FORMAT "]",
+                   p2i(heap->low_boundary()),
+                   p2i(heap->high()),
+                   p2i(heap->high_boundary()));
+    }
     st->print_cr(" total_blobs=" UINT32_FORMAT " nmethods=" UINT32_FORMAT
                  " adapters=" UINT32_FORMAT,
                  nof_blobs(), nof_nmethods(), nof_adapters());
@@ -39,6 +39,13 @@
 //   - Each CodeBlob occupies one chunk of memory.
 //   - Like the offset table in oldspace the zone has at table for
 //     locating a method given a addess of an instruction.
+//
+// With SegmentedCodeCache the code cache is divided into code heaps that
+// each hold one CodeBlobType: non-method code (stubs, adapters, buffers),
+// profiled nmethods (tiers 2 and 3) and non-profiled nmethods (tiers 0, 1
+// and 4).  The heaps are carved out of one contiguous reservation, so
+// low_bound() and high_bound() still bound all generated code.  Without
+// it there is a single heap of type CodeBlobType::All.
 
 class OopClosure;
 class DepChange;
@@ -50,7 +57,12 @@ class CodeCache : AllStatic {
   // so that the generated assembly code is always there when it's needed.
   // This may cause memory leak, but is necessary, for now. See 4423824,
   // 4422213 or 4436291 for details.
-  static CodeHeap * _heap;
+  static CodeHeap * _heap;                  // the first (lowest) code heap
+  static CodeHeap * _heaps[CodeBlobType::NumTypes]; // code heaps in address order
+  static int _heap_types[CodeBlobType::NumTypes];   // CodeBlobType of each heap
+  static int _number_of_heaps;
+  static address _low_bound;                // bounds of the code cache reservation
+  static address _high_bound;
   static int _number_of_blobs;
   static int _number_of_adapters;
   static int _number_of_nmethods;
@@ -69,15 +81,38 @@ class CodeCache : AllStatic {
   static void prune_scavenge_root_nmethods();
   static void unlink_scavenge_root_nmethod(nmethod* nm, nmethod* prev);
 
+  // Code heap management
+  static void initialize_heaps();
+  static void add_heap(CodeHeap* heap, int code_blob_type);
+  static void add_heap(ReservedSpace rs, const char* name, int code_blob_type);
+  static int fallback_code_blob_type(int code_blob_type);
+
+  // Returns the code heap containing p or NULL
+  static CodeHeap* get_code_heap(const void* p) {
+    for (int i = 0; i < _number_of_heaps; i++) {
+      if (_heaps[i]->contains(p)) {
+        return _heaps[i];
+      }
+    }
+    return NULL;
+  }
+
  public:
 
   // Initialization
   static void initialize();
 
-  static void report_codemem_full();
+  static void report_codemem_full(int code_blob_type = CodeBlobType::All);
+
+  // Code heap selection
+  static bool heap_available(int code_blob_type);
+  static CodeHeap* get_code_heap_for_type(int code_blob_type); // NULL if there is none
+  static int  get_code_blob_type(int comp_level);      // heap for an nmethod of the level
+  static int  get_code_blob_type(int comp_level, Method* method);
+  static int  get_code_blob_type(const CodeBlob* cb);  // heap holding the blob
 
   // Allocation/administration
-  static CodeBlob* allocate(int size, bool is_critical = false); // allocates a new CodeBlob
+  static CodeBlob* allocate(int size, int code_blob_type, bool is_critical = false); // allocates a new CodeBlob
   static void commit(CodeBlob* cb);                 // called when the allocated CodeBlob has been filled
   static int alignment_unit();                      // guaranteed alignment of all CodeBlobs
   static int alignment_offset();                    // guaranteed offset of first CodeBlob byte within alignment unit (i.e., allocation header)
@@ -97,9 +132,10 @@ class CodeCache : AllStatic {
   // what you are doing)
   static CodeBlob* find_blob_unsafe(void* start) {
     // NMT can walk the stack before code cache is created
-    if (_heap == NULL) return NULL;
+    CodeHeap* heap = get_code_heap(start);
+    if (heap == NULL) return NULL;
 
-    CodeBlob* result = (CodeBlob*)_heap->find_start(start);
+    CodeBlob* result = (CodeBlob*)heap->find_start(start);
     // this assert is too strong because the heap code will return the
     // heapblock containing start. That block can often be larger than
     // the codeBlob itself. If you look up an address that is within
@@ -160,17 +196,19 @@ class CodeCache : AllStatic {
   static void log_state(outputStream* st);
 
   // The full limits of the codeCache
-  static address  low_bound()                    { return (address) _heap->low_boundary(); }
-  static address  high_bound()                   { return (address) _heap->high_boundary(); }
-  static address  high()                         { return (address) _heap->high(); }
+  static address  low_bound()                    { return _low_bound; }
+  static address  high_bound()                   { return _high_bound; }
+  static address  high();
 
   // Profiling
   static address first_address();                // first address used for CodeBlobs
   static address last_address();                 // last  address used for CodeBlobs
-  static size_t  capacity()                      { return _heap->capacity(); }
-  static size_t  max_capacity()                  { return _heap->max_capacity(); }
-  static size_t  unallocated_capacity()          { return _heap->unallocated_capacity(); }
+  static size_t  capacity();
+  static size_t  max_capacity();
+  static size_t  unallocated_capacity();
+  static size_t  unallocated_capacity(int code_blob_type);
   static double  reverse_free_ratio();
+  static double  reverse_free_ratio(int code_blob_type);
 
   static bool needs_cache_clean()                { return _needs_cache_clean; }
   static void set_needs_cache_clean(bool v)      { _needs_cache_clean = v;    }
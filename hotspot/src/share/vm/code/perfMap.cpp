@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "code/codeBlob.hpp"
+#include "code/codeCache.hpp"
+#include "code/nmethod.hpp"
+#include "code/perfMap.hpp"
+#include "memory/resourceArea.hpp"
+#include "runtime/atomic.inline.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/os.hpp"
+#include "runtime/task.hpp"
+#include "utilities/ostream.hpp"
+
+#include <fcntl.h>
+
+// Records are flushed early when the buffer is this full
+static const size_t perf_map_buffer_size = 64 * K;
+static const size_t perf_map_max_record  = 1 * K;
+
+class PerfMapFlushTask : public PeriodicTask {
+ public:
+  PerfMapFlushTask(int interval_time) : PeriodicTask(interval_time) {}
+  void task() { PerfMap::flush(); }
+};
+
+int               PerfMap::_fd            = -1;
+char*             PerfMap::_buffer        = NULL;
+size_t            PerfMap::_buffer_used   = 0;
+volatile jint     PerfMap::_stale_entries = 0;
+PerfMapFlushTask* PerfMap::_task          = NULL;
+
+const char* PerfMap::path() {
+  static char buf[64];
+  jio_snprintf(buf, sizeof(buf), "/tmp/perf-%d.map", os::current_process_id());
+  return buf;
+}
+
+void PerfMap::initialize() {
+  assert(UsePerfMap, "why are we here?");
+  _fd = os::open(path(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, 0644);
+  if (_fd < 0) {
+    warning("Could not open %s, the perf map is disabled", path());
+    return;
+  }
+  _buffer = NEW_C_HEAP_ARRAY(char, perf_map_buffer_size, mtInternal);
+
+  // Code installed from now on is recorded, so what is in the code cache
+  // already is all that needs to be written. Some code may end up in the
+  // file twice, which does not matter.
+  rewrite(NULL);
+
+  intx interval = MIN2(MAX2(PerfMapFlushInterval, (intx) PeriodicTask::min_interval),
+                       (intx) PeriodicTask::max_interval);
+  _task = new PerfMapFlushTask((int) align_size_down(interval, PeriodicTask::interval_gran));
+  _task->enroll();
+}
+
+void PerfMap::record(address begin, size_t size, const char* name) {
+  MutexLockerEx ml(PerfMap_lock, Mutex::_no_safepoint_check_flag);
+  if (_buffer_used + perf_map_max_record > perf_map_buffer_size) {
+    flush_locked();
+  }
+  int n = jio_snprintf(_buffer + _buffer_used, perf_map_max_record,
+                       INTPTR_FORMAT " " INTPTR_FORMAT " %s\n",
+                       (intptr_t) begin, (intptr_t) size, name);
+  if (n < 0) {
+    // Too long, cut the name short
+    n = (int) strlen(_buffer + _buffer_used);
+    _buffer[_buffer_used + n - 1] = '\n';
+  }
+  _buffer_used += n;
+}
+
+void PerfMap::record_nmethod(nmethod* nm) {
+  if (!is_enabled()) {
+    return;
+  }
+  ResourceMark rm;
+  record(nm->insts_begin(), nm->insts_size(), nm->method()->name_and_sig_as_C_string());
+}
+
+void PerfMap::record_stub(const char* name, address begin, address end) {
+  if (!is_enabled()) {
+    return;
+  }
+  record(begin, pointer_delta(end, begin, sizeof(u1)), name);
+}
+
+void PerfMap::record_flush() {
+  if (is_enabled()) {
+    Atomic::inc(&_stale_entries);
+  }
+}
+
+void PerfMap::flush_locked() {
+  assert_lock_strong(PerfMap_lock);
+  size_t written = 0;
+  while (written < _buffer_used) {
+    size_t n = os::write(_fd, _buffer + written, (unsigned int) (_buffer_used - written));
+    if (n == 0 || n == (size_t) -1) {
+      break;
+    }
+    written += n;
+  }
+  _buffer_used = 0;
+}
+
+void PerfMap::flush() {
+  if (!is_enabled()) {
+    return;
+  }
+  MutexLockerEx ml(PerfMap_lock, Mutex::_no_safepoint_check_flag);
+  if (_fd >= 0) {
+    flush_locked();
+  }
+}
+
+class PerfMapWriter : public CodeBlobClosure {
+ private:
+  fileStream* _out;
+  int         _count;
+
+ public:
+  PerfMapWriter(fileStream* out) : _out(out), _count(0) {}
+
+  void do_code_blob(CodeBlob* cb) {
+    address begin = cb->code_begin();
+    size_t size = cb->code_size();
+    const char* name = cb->name();
+    if (cb->is_nmethod()) {
+      nmethod* nm = (nmethod*) cb;
+      if (!nm->is_alive()) {
+        return;
+      }
+      begin = nm->insts_begin();
+      size = nm->insts_size();
+      name = nm->method()->name_and_sig_as_C_string();
+    }
+    _out->print_cr(INTPTR_FORMAT " " INTPTR_FORMAT " %s", (intptr_t) begin, (intptr_t) size, name);
+    _count++;
+  }
+
+  int count() const { return _count; }
+};
+
+void PerfMap::rewrite(outputStream* out) {
+  if (!is_enabled()) {
+    if (out != NULL) {
+      out->print_cr("The perf map is disabled, see -XX:+UsePerfMap");
+    }
+    return;
+  }
+
+  char tmp_path[80];
+  jio_snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path());
+
+  ResourceMark rm;
+  MutexLockerEx ml(PerfMap_lock, Mutex::_no_safepoint_check_flag);
+  int count;
+  {
+    fileStream fs(tmp_path, "w");
+    if (!fs.is_open()) {
+      if (out != NULL) {
+        out->print_cr("Could not open %s", tmp_path);
+      }
+      return;
+    }
+    PerfMapWriter writer(&fs);
+    MutexLockerEx mu(CodeCache_lock, Mutex::_no_safepoint_check_flag);
+    CodeCache::blobs_do(&writer);
+    count = writer.count();
+  }
+
+  // Everything recorded so far is in the new file
+  _buffer_used = 0;
+  int stale = Atomic::xchg(0, &_stale_entries);
+  if (::rename(tmp_path, path()) != 0) {
+    if (out != NULL) {
+      out->print_cr("Could not rename %s to %s", tmp_path, path());
+    }
+    return;
+  }
+  os::close(_fd);
+  _fd = os::open(path(), O_WRONLY | O_APPEND, 0);
+  if (_fd < 0) {
+    // Records are dropped until the next successful rewrite
+    warning("Could not open %s", path());
+    return;
+  }
+
+  if (out != NULL) {
+    out->print_cr("Wrote %d entries to %s, dropping %d flushed methods", count, path(), stale);
+  }
+}
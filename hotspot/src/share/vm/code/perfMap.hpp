@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_CODE_PERFMAP_HPP
+#define SHARE_VM_CODE_PERFMAP_HPP
+
+#include "memory/allocation.hpp"
+
+class nmethod;
+class outputStream;
+class PerfMapFlushTask;
+
+// Keeps /tmp/perf-<pid>.map up to date with the code in the code cache,
+// so that perf and other profilers that read it can name the frames of
+// JIT compiled code. Each line gives the start address, size and name of
+// a method or stub.
+//
+// Code is recorded as it is installed into a buffer that a periodic task
+// appends to the file every PerfMapFlushInterval milliseconds, so that
+// compiler threads do no file I/O. The format has no way to say that code
+// was flushed, so entries for flushed code stay in the file until it is
+// rewritten from the code cache with the Compiler.perfmap diagnostic
+// command.
+class PerfMap : AllStatic {
+  friend class PerfMapFlushTask;
+ private:
+  static int               _fd;
+  static char*             _buffer;
+  static size_t            _buffer_used;
+  static volatile jint     _stale_entries;    // code flushed since the last rewrite
+  static PerfMapFlushTask* _task;
+
+  static const char* path();
+  static void record(address begin, size_t size, const char* name);
+  static void flush_locked();
+
+ public:
+  static bool is_enabled() { return _buffer != NULL; }
+
+  // Starts recording code and writes the code installed so far
+  static void initialize();
+
+  // Records newly installed code
+  static void record_nmethod(nmethod* nm);
+  static void record_stub(const char* name, address begin, address end);
+
+  // Notes that an nmethod was flushed
+  static void record_flush();
+
+  // Writes out what has been recorded
+  static void flush();
+
+  // Rewrites the file from the code cache, dropping flushed code
+  static void rewrite(outputStream* out);
+};
+
+#endif // SHARE_VM_CODE_PERFMAP_HPP
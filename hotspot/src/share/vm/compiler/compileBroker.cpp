@@ -188,6 +188,13 @@ CompileQueue* CompileBroker::_c1_compile_queue   = NULL;
 
 GrowableArray<CompilerThread*>* CompileBroker::_compiler_threads = NULL;
 
+int                CompileBroker::_c1_count           = 0;
+int                CompileBroker::_c2_count           = 0;
+jobject*           CompileBroker::_compiler1_objects  = NULL;
+jobject*           CompileBroker::_compiler2_objects  = NULL;
+CompilerCounters** CompileBroker::_compiler1_counters = NULL;
+CompilerCounters** CompileBroker::_compiler2_counters = NULL;
+
 
 class CompilationLog : public StringEventLog {
  public:
@@ -327,12 +334,14 @@ void CompileTask::initialize(int compile_id,
   _hot_method = NULL;
   _hot_method_holder = NULL;
   _hot_count = hot_count;
-  _time_queued = 0;  // tidy
   _comment = comment;
   _failure_reason = NULL;
+  _priority_level = 0;
+  _priority_weight = 0;
+  _heap_index = -1;
+  _time_queued = Ticks::now();
 
   if (LogCompilation) {
-    _time_queued = os::elapsed_counter();
     if (hot_method.not_null()) {
       if (hot_method == method) {
         _hot_method = _method;
@@ -651,6 +660,13 @@ void CompileQueue::add(CompileTask* task) {
   }
   ++_size;
 
+  // Rank the new task above everything else until the compilation
+  // policy has computed its actual priority.
+  task->set_priority(max_jint, 0);
+  _heap->append(task);
+  heap_set(_heap->length() - 1, task);
+  heap_sift_up(_heap->length() - 1);
+
   // Mark the method as being in the compile queue.
   task->method()->set_queued_for_compilation();
 
@@ -687,6 +703,7 @@ void CompileQueue::free_all() {
     CompileTask::free(current);
   }
   _first = NULL;
+  _heap->clear();
 
   // Wake up all threads that block on the queue.
   lock()->notify_all();
@@ -739,6 +756,13 @@ CompileTask* CompileQueue::get() {
       // is disabled forever. We use 5 seconds wait time; the exiting of compiler threads
       // is not critical and we do not want idle compiler threads to wake up too often.
       lock()->wait(!Mutex::_no_safepoint_check_flag, 5*1000);
+
+      if (UseDynamicNumberOfCompilerThreads && _first == NULL) {
+        // Still nothing to compile. Give the caller a chance to stop this thread.
+        if (CompileBroker::can_remove(CompilerThread::current(), false)) {
+          return NULL;
+        }
+      }
     }
   }
 
@@ -749,15 +773,42 @@ CompileTask* CompileQueue::get() {
   CompileTask* task;
   {
     No_Safepoint_Verifier nsv;
+    if (CITime) _t_select.start();
     task = CompilationPolicy::policy()->select_task(this);
+    if (CITime) {
+      _t_select.stop();
+      _select_count++;
+    }
   }
   if (task != NULL) {
     remove(task);
+    record_wait(task);
   }
   purge_stale_tasks(); // may temporarily release MCQ lock
   return task;
 }
 
+void CompileQueue::record_wait(CompileTask* task) {
+  assert(lock()->owned_by_self(), "must own lock");
+  int level = task->comp_level();
+  assert(level >= 0 && level <= CompLevel_full_optimization, "invalid compilation level");
+  const Tickspan wait = Ticks::now() - task->time_queued();
+  _wait_count[level]++;
+  _total_wait_time[level] += wait;
+  _peak_wait_time[level] = MAX2(_peak_wait_time[level], wait);
+}
+
+int CompileQueue::queued_count(int comp_level) const {
+  assert(lock()->owned_by_self(), "must own lock");
+  int count = 0;
+  for (CompileTask* task = _first; task != NULL; task = task->next()) {
+    if (task->comp_level() == comp_level) {
+      count++;
+    }
+  }
+  return count;
+}
+
 // Clean & deallocate stale compile tasks.
 // Temporarily releases MethodCompileQueue lock.
 void CompileQueue::purge_stale_tasks() {
@@ -799,6 +850,85 @@ void CompileQueue::remove(CompileTask* task) {
     _last = task->prev();
   }
   --_size;
+
+  // Move the last heap element into the vacated slot and restore the heap order.
+  int i = task->heap_index();
+  assert(i >= 0 && i < _heap->length() && _heap->at(i) == task, "task must be in the priority heap");
+  CompileTask* last = _heap->pop();
+  task->set_heap_index(-1);
+  if (last != task) {
+    heap_set(i, last);
+    heap_sift_up(i);
+    heap_sift_down(last->heap_index());
+  }
+}
+
+// Returns true if task x should be compiled before task y: a higher
+// priority level (e.g. a recompilation after deoptimization) wins,
+// then a higher weight.
+bool CompileQueue::has_higher_priority(CompileTask* x, CompileTask* y) {
+  if (x->priority_level() != y->priority_level()) {
+    return x->priority_level() > y->priority_level();
+  }
+  return x->priority_weight() > y->priority_weight();
+}
+
+void CompileQueue::heap_set(int i, CompileTask* task) {
+  _heap->at_put(i, task);
+  task->set_heap_index(i);
+}
+
+void CompileQueue::heap_sift_up(int i) {
+  CompileTask* task = _heap->at(i);
+  while (i > 0) {
+    int parent = (i - 1) / 2;
+    CompileTask* p = _heap->at(parent);
+    if (!has_higher_priority(task, p)) {
+      break;
+    }
+    heap_set(i, p);
+    i = parent;
+  }
+  heap_set(i, task);
+}
+
+void CompileQueue::heap_sift_down(int i) {
+  CompileTask* task = _heap->at(i);
+  int len = _heap->length();
+  while (true) {
+    int child = 2 * i + 1;
+    if (child >= len) {
+      break;
+    }
+    if (child + 1 < len && has_higher_priority(_heap->at(child + 1), _heap->at(child))) {
+      child++;
+    }
+    CompileTask* c = _heap->at(child);
+    if (!has_higher_priority(c, task)) {
+      break;
+    }
+    heap_set(i, c);
+    i = child;
+  }
+  heap_set(i, task);
+}
+
+/**
+ * Set the priority of a queued task and move it to its place in the heap.
+ */
+void CompileQueue::update_priority(CompileTask* task, int level, double weight) {
+  assert(lock()->owned_by_self(), "must own lock");
+  int i = task->heap_index();
+  assert(i >= 0 && _heap->at(i) == task, "task must be in the priority heap");
+  task->set_priority(level, weight);
+  heap_sift_up(i);
+  heap_sift_down(task->heap_index());
+}
+
+void CompileQueue::print_select_times() {
+  tty->print_cr("  %-25s: %6.3f s, %6d selections, Average : %2.3f ms", _name,
+                _t_select.seconds(), _select_count,
+                _select_count == 0 ? 0.0 : _t_select.seconds() * 1000.0 / _select_count);
 }
 
 void CompileQueue::remove_and_mark_stale(CompileTask* task) {
@@ -1016,16 +1146,13 @@ void CompileBroker::compilation_init() {
 }
 
 
-CompilerThread* CompileBroker::make_compiler_thread(const char* name, CompileQueue* queue, CompilerCounters* counters,
-                                                    AbstractCompiler* comp, TRAPS) {
-  CompilerThread* compiler_thread = NULL;
-
+Handle CompileBroker::create_thread_oop(const char* name, TRAPS) {
   Klass* k =
     SystemDictionary::resolve_or_fail(vmSymbols::java_lang_Thread(),
-                                      true, CHECK_0);
+                                      true, CHECK_NH);
   instanceKlassHandle klass (THREAD, k);
-  instanceHandle thread_oop = klass->allocate_instance_handle(CHECK_0);
-  Handle string = java_lang_String::create_from_str(name, CHECK_0);
+  instanceHandle thread_oop = klass->allocate_instance_handle(CHECK_NH);
+  Handle string = java_lang_String::create_from_str(name, CHECK_NH);
 
   // Initialize thread_oop to put it into the system threadGroup
   Handle thread_group (THREAD,  Universe::system_thread_group());
@@ -1036,7 +1163,14 @@ CompilerThread* CompileBroker::make_compiler_thread(const char* name, CompileQue
                        vmSymbols::threadgroup_string_void_signature(),
                        thread_group,
                        string,
-                       CHECK_0);
+                       CHECK_NH);
+  return thread_oop;
+}
+
+CompilerThread* CompileBroker::make_compiler_thread(jobject thread_handle, CompileQueue* queue, CompilerCounters* counters,
+                                                    AbstractCompiler* comp, TRAPS) {
+  CompilerThread* compiler_thread = NULL;
+  Handle thread_oop(THREAD, JNIHandles::resolve_non_null(thread_handle));
 
   {
     MutexLocker mu(Threads_lock, THREAD);
@@ -1054,6 +1188,13 @@ CompilerThread* CompileBroker::make_compiler_thread(const char* name, CompileQue
     // exceptions anyway, check and abort if this fails.
 
     if (compiler_thread == NULL || compiler_thread->osthread() == NULL){
+      if (UseDynamicNumberOfCompilerThreads && comp->num_compiler_threads() > 0) {
+        // An additional thread is not essential, keep going with the ones we have.
+        if (compiler_thread != NULL) {
+          delete compiler_thread;
+        }
+        return NULL;
+      }
       vm_exit_during_initialization("java.lang.OutOfMemoryError",
                                     "unable to create new native thread");
     }
@@ -1101,14 +1242,22 @@ void CompileBroker::init_compiler_threads(int c1_compiler_count, int c2_compiler
 #if !defined(ZERO) && !defined(SHARK)
   assert(c2_compiler_count > 0 || c1_compiler_count > 0, "No compilers?");
 #endif // !ZERO && !SHARK
-  // Initialize the compilation queue
+  _c1_count = c1_compiler_count;
+  _c2_count = c2_compiler_count;
+
+  // Initialize the compilation queue. With UseDynamicNumberOfCompilerThreads
+  // only one thread per compiler is started here.
   if (c2_compiler_count > 0) {
     _c2_compile_queue  = new CompileQueue("C2 CompileQueue",  MethodCompileQueue_lock);
-    _compilers[1]->set_num_compiler_threads(c2_compiler_count);
+    _compilers[1]->set_num_compiler_threads(UseDynamicNumberOfCompilerThreads ? 1 : c2_compiler_count);
+    _compiler2_objects = NEW_C_HEAP_ARRAY(jobject, c2_compiler_count, mtCompiler);
+    _compiler2_counters = NEW_C_HEAP_ARRAY(CompilerCounters*, c2_compiler_count, mtCompiler);
   }
   if (c1_compiler_count > 0) {
     _c1_compile_queue  = new CompileQueue("C1 CompileQueue",  MethodCompileQueue_lock);
-    _compilers[0]->set_num_compiler_threads(c1_compiler_count);
+    _compilers[0]->set_num_compiler_threads(UseDynamicNumberOfCompilerThreads ? 1 : c1_compiler_count);
+    _compiler1_objects = NEW_C_HEAP_ARRAY(jobject, c1_compiler_count, mtCompiler);
+    _compiler1_counters = NEW_C_HEAP_ARRAY(CompilerCounters*, c1_compiler_count, mtCompiler);
   }
 
   int compiler_count = c1_compiler_count + c2_compiler_count;
@@ -1120,19 +1269,28 @@ void CompileBroker::init_compiler_threads(int c1_compiler_count, int c2_compiler
   for (int i = 0; i < c2_compiler_count; i++) {
     // Create a name for our thread.
     sprintf(name_buffer, "C2 CompilerThread%d", i);
-    CompilerCounters* counters = new CompilerCounters("compilerThread", i, CHECK);
-    // Shark and C2
-    CompilerThread* new_thread = make_compiler_thread(name_buffer, _c2_compile_queue, counters, _compilers[1], CHECK);
-    _compiler_threads->append(new_thread);
+    Handle thread_oop = create_thread_oop(name_buffer, CHECK);
+    _compiler2_objects[i] = JNIHandles::make_global(thread_oop);
+    _compiler2_counters[i] = new CompilerCounters("compilerThread", i, CHECK);
+    if (!UseDynamicNumberOfCompilerThreads || i == 0) {
+      // Shark and C2
+      CompilerThread* new_thread = make_compiler_thread(_compiler2_objects[i], _c2_compile_queue, _compiler2_counters[i], _compilers[1], CHECK);
+      _compiler_threads->append(new_thread);
+    }
   }
 
-  for (int i = c2_compiler_count; i < compiler_count; i++) {
+  for (int i = 0; i < c1_compiler_count; i++) {
     // Create a name for our thread.
-    sprintf(name_buffer, "C1 CompilerThread%d", i);
-    CompilerCounters* counters = new CompilerCounters("compilerThread", i, CHECK);
-    // C1
-    CompilerThread* new_thread = make_compiler_thread(name_buffer, _c1_compile_queue, counters, _compilers[0], CHECK);
-    _compiler_threads->append(new_thread);
+    int id = c2_compiler_count + i;
+    sprintf(name_buffer, "C1 CompilerThread%d", id);
+    Handle thread_oop = create_thread_oop(name_buffer, CHECK);
+    _compiler1_objects[i] = JNIHandles::make_global(thread_oop);
+    _compiler1_counters[i] = new CompilerCounters("compilerThread", id, CHECK);
+    if (!UseDynamicNumberOfCompilerThreads || i == 0) {
+      // C1
+      CompilerThread* new_thread = make_compiler_thread(_compiler1_objects[i], _c1_compile_queue, _compiler1_counters[i], _compilers[0], CHECK);
+      _compiler_threads->append(new_thread);
+    }
   }
 
   if (UsePerfData) {
@@ -1141,6 +1299,92 @@ void CompileBroker::init_compiler_threads(int c1_compiler_count, int c2_compiler
 }
 
 
+/**
+ * Start additional compiler threads if the compile queues have grown and
+ * there is enough free memory and code cache for them to work with. A C2
+ * thread is started for every two queued tasks and a C1 thread for every
+ * four, up to the CICompilerCount split.
+ */
+void CompileBroker::possibly_add_compiler_threads() {
+  EXCEPTION_MARK;
+
+  julong available_memory = os::available_memory();
+  size_t available_cc = CodeCache::unallocated_capacity();
+
+  // Only attempt to start additional threads if the lock is free.
+  if (!CompileThread_lock->try_lock()) return;
+
+  if (_c2_compile_queue != NULL) {
+    int old_c2_count = _compilers[1]->num_compiler_threads();
+    int new_c2_count = MIN4(_c2_count,
+                            _c2_compile_queue->size() / 2,
+                            (int)MIN2(available_memory / (200*M), (julong)max_jint),
+                            (int)(available_cc / (128*K)));
+
+    for (int i = old_c2_count; i < new_c2_count; i++) {
+      CompilerThread* ct = make_compiler_thread(_compiler2_objects[i], _c2_compile_queue, _compiler2_counters[i], _compilers[1], THREAD);
+      if (ct == NULL) break;
+      _compilers[1]->set_num_compiler_threads(i + 1);
+      _compiler_threads->append(ct);
+      if (TraceCompilerThreads) {
+        ResourceMark rm;
+        tty->print_cr("Added compiler thread %s (available memory: " JULONG_FORMAT "MB, available code cache: " SIZE_FORMAT "KB)",
+                      ct->get_thread_name(), available_memory / M, available_cc / K);
+      }
+    }
+  }
+
+  if (_c1_compile_queue != NULL) {
+    int old_c1_count = _compilers[0]->num_compiler_threads();
+    int new_c1_count = MIN4(_c1_count,
+                            _c1_compile_queue->size() / 4,
+                            (int)MIN2(available_memory / (100*M), (julong)max_jint),
+                            (int)(available_cc / (128*K)));
+
+    for (int i = old_c1_count; i < new_c1_count; i++) {
+      CompilerThread* ct = make_compiler_thread(_compiler1_objects[i], _c1_compile_queue, _compiler1_counters[i], _compilers[0], THREAD);
+      if (ct == NULL) break;
+      _compilers[0]->set_num_compiler_threads(i + 1);
+      _compiler_threads->append(ct);
+      if (TraceCompilerThreads) {
+        ResourceMark rm;
+        tty->print_cr("Added compiler thread %s (available memory: " JULONG_FORMAT "MB, available code cache: " SIZE_FORMAT "KB)",
+                      ct->get_thread_name(), available_memory / M, available_cc / K);
+      }
+    }
+  }
+
+  CompileThread_lock->unlock();
+}
+
+bool CompileBroker::can_remove(CompilerThread* ct, bool do_it) {
+  assert(UseDynamicNumberOfCompilerThreads, "or shouldn't be here");
+  if (!ReduceNumberOfCompilerThreads) return false;
+
+  AbstractCompiler* compiler = ct->compiler();
+  int compiler_count = compiler->num_compiler_threads();
+  bool c1 = compiler->is_c1();
+
+  // Keep at least one compiler thread of each type.
+  if (compiler_count < 2) return false;
+
+  // Keep the thread alive for at least some time.
+  if (ct->idle_time_millis() < (c1 ? 500 : 100)) return false;
+
+  // Only the most recently started thread of each type may terminate, so
+  // that the running threads always use the slots 0 to n-1.
+  jobject last_compiler = c1 ? _compiler1_objects[compiler_count - 1]
+                             : _compiler2_objects[compiler_count - 1];
+  if (ct->threadObj() == JNIHandles::resolve_non_null(last_compiler)) {
+    if (do_it) {
+      assert_locked_or_safepoint(CompileThread_lock); // Update must be consistent.
+      compiler->set_num_compiler_threads(--compiler_count);
+    }
+    return true;
+  }
+  return false;
+}
+
 /**
  * Set the methods on the stack as on_stack so that redefine classes doesn't
  * reclaim them. This method is executed at a safepoint.
@@ -1776,6 +2020,8 @@ void CompileBroker::compiler_thread_loop() {
     return;
   }
 
+  thread->start_idle_timer();
+
   // Poll for new compilation tasks as long as the JVM runs. Compilation
   // should only be disabled if something went wrong while initializing the
   // compiler runtimes. This, in turn, should not happen. The only known case
@@ -1792,9 +2038,33 @@ void CompileBroker::compiler_thread_loop() {
 
     CompileTask* task = queue->get();
     if (task == NULL) {
+      if (UseDynamicNumberOfCompilerThreads) {
+        // Access the compiler thread count under the lock to keep it consistent.
+        MutexLocker only_one(CompileThread_lock);
+        if (can_remove(thread, true)) {
+          if (TraceCompilerThreads) {
+            tty->print_cr("Removing compiler thread %s after " JLONG_FORMAT " ms idle time",
+                          thread->get_thread_name(), thread->idle_time_millis());
+          }
+          _compiler_threads->remove(thread);
+          // Free buffer blob, if allocated. The resource area of the thread
+          // goes back to the chunk pool when the thread is destroyed, from
+          // where the chunk pool cleaner returns it to the OS.
+          if (thread->get_buffer_blob() != NULL) {
+            MutexLockerEx mu(CodeCache_lock, Mutex::_no_safepoint_check_flag);
+            CodeCache::free(thread->get_buffer_blob());
+            thread->set_buffer_blob(NULL);
+          }
+          return; // Stop this thread.
+        }
+      }
       continue;
     }
 
+    if (UseDynamicNumberOfCompilerThreads) {
+      possibly_add_compiler_threads();
+    }
+
     // Give compiler threads an extra quanta.  They tend to be bursty and
     // this helps the compiler to finish up the job.
     if( CompilerThreadHintNoPreempt )
@@ -1822,6 +2092,10 @@ void CompileBroker::compiler_thread_loop() {
         task->set_failure_reason("compilation is disabled");
       }
     }
+
+    if (UseDynamicNumberOfCompilerThreads) {
+      thread->start_idle_timer();
+    }
   }
 
   // Shut down compiler runtime
@@ -2396,6 +2670,13 @@ void CompileBroker::print_times() {
                 CompileBroker::_t_standard_compilation.seconds(),
                 CompileBroker::_t_standard_compilation.seconds() / CompileBroker::_total_standard_compile_count);
   tty->print_cr("    On stack replacement   : %6.3f s, Average : %2.3f", CompileBroker::_t_osr_compilation.seconds(), CompileBroker::_t_osr_compilation.seconds() / CompileBroker::_total_osr_compile_count);
+  tty->print_cr("  Task selection time");
+  if (_c1_compile_queue != NULL) {
+    _c1_compile_queue->print_select_times();
+  }
+  if (_c2_compile_queue != NULL) {
+    _c2_compile_queue->print_select_times();
+  }
 
   AbstractCompiler *comp = compiler(CompLevel_simple);
   if (comp != NULL) {
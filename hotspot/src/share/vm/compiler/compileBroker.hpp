@@ -28,6 +28,8 @@
 #include "ci/compilerInterface.hpp"
 #include "compiler/abstractCompiler.hpp"
 #include "runtime/perfData.hpp"
+#include "utilities/growableArray.hpp"
+#include "utilities/ticks.hpp"
 
 class nmethod;
 class nmethodLocker;
@@ -58,8 +60,12 @@ class CompileTask : public CHeapObj<mtCompiler> {
   nmethodLocker* _code_handle;  // holder of eventual result
   CompileTask* _next, *_prev;
   bool         _is_free;
+  // Scheduling priority used by the compile queue heap (see CompileQueue).
+  int          _priority_level;
+  double       _priority_weight;
+  int          _heap_index;
+  Ticks        _time_queued;
   // Fields used for logging why the compilation was initiated:
-  jlong        _time_queued;  // in units of os::elapsed_counter()
   Method*      _hot_method;   // which method actually triggered this task
   jobject      _hot_method_holder;
   int          _hot_count;    // information about its invocation counter
@@ -96,6 +102,7 @@ class CompileTask : public CHeapObj<mtCompiler> {
   void         mark_success()                    { _is_success = true; }
 
   int          comp_level()                      { return _comp_level;}
+  const Ticks& time_queued() const               { return _time_queued; }
   void         set_comp_level(int comp_level)    { _comp_level = comp_level;}
 
   int          num_inlined_bytecodes() const     { return _num_inlined_bytecodes; }
@@ -108,6 +115,12 @@ class CompileTask : public CHeapObj<mtCompiler> {
   bool         is_free() const                   { return _is_free; }
   void         set_is_free(bool val)             { _is_free = val; }
 
+  int          priority_level() const            { return _priority_level; }
+  double       priority_weight() const           { return _priority_weight; }
+  void         set_priority(int level, double weight) { _priority_level = level; _priority_weight = weight; }
+  int          heap_index() const                { return _heap_index; }
+  void         set_heap_index(int i)             { _heap_index = i; }
+
 private:
   static void  print_compilation_impl(outputStream* st, Method* method, int compile_id, int comp_level,
                                       bool is_osr_method = false, int osr_bci = -1, bool is_blocking = false,
@@ -193,7 +206,12 @@ class CompilerCounters : public CHeapObj<mtCompiler> {
 
 // CompileQueue
 //
-// A list of CompileTasks.
+// A list of CompileTasks. In addition to the FIFO list the queue keeps
+// its tasks in a binary max-heap ordered by the priority the compilation
+// policy last assigned to them, so that a policy selecting by hotness
+// does not have to scan the whole queue for every task it hands out.
+// Newly added tasks get the highest priority until the policy has
+// looked at them.
 class CompileQueue : public CHeapObj<mtCompiler> {
  private:
   const char* _name;
@@ -206,7 +224,26 @@ class CompileQueue : public CHeapObj<mtCompiler> {
 
   int _size;
 
+  GrowableArray<CompileTask*>* _heap;
+  jlong        _last_priority_refresh;   // in milliseconds, see AdvancedThresholdPolicy::select_task()
+
+  // Task selection statistics (for CITime)
+  elapsedTimer _t_select;
+  int          _select_count;
+
+  // Queue wait statistics per compilation level, updated when a task
+  // is handed out to a compiler thread.
+  jlong        _wait_count[CompLevel_full_optimization + 1];
+  Tickspan     _total_wait_time[CompLevel_full_optimization + 1];
+  Tickspan     _peak_wait_time[CompLevel_full_optimization + 1];
+
   void purge_stale_tasks();
+  void record_wait(CompileTask* task);
+
+  static bool has_higher_priority(CompileTask* x, CompileTask* y);
+  void heap_set(int i, CompileTask* task);
+  void heap_sift_up(int i);
+  void heap_sift_down(int i);
  public:
   CompileQueue(const char* name, Monitor* lock) {
     _name = name;
@@ -215,6 +252,12 @@ class CompileQueue : public CHeapObj<mtCompiler> {
     _last = NULL;
     _size = 0;
     _first_stale = NULL;
+    _heap = new (ResourceObj::C_HEAP, mtCompiler) GrowableArray<CompileTask*>(16, true, mtCompiler);
+    _last_priority_refresh = 0;
+    _select_count = 0;
+    for (int i = 0; i <= CompLevel_full_optimization; i++) {
+      _wait_count[i] = 0;
+    }
   }
 
   const char*  name() const                      { return _name; }
@@ -231,6 +274,20 @@ class CompileQueue : public CHeapObj<mtCompiler> {
   bool         is_empty() const                  { return _first == NULL; }
   int          size()     const                  { return _size;          }
 
+  // Priority order support
+  CompileTask* highest_priority() const          { return _heap->is_empty() ? NULL : _heap->at(0); }
+  void         update_priority(CompileTask* task, int level, double weight);
+  jlong        last_priority_refresh() const     { return _last_priority_refresh; }
+  void         set_last_priority_refresh(jlong t) { _last_priority_refresh = t; }
+
+  void         print_select_times();
+
+  // Number of queued tasks for comp_level and the wait statistics of the
+  // tasks already handed out for it (caller must hold the queue lock)
+  int          queued_count(int comp_level) const;
+  jlong        wait_count(int comp_level) const        { return _wait_count[comp_level]; }
+  const Tickspan& total_wait_time(int comp_level) const { return _total_wait_time[comp_level]; }
+  const Tickspan& peak_wait_time(int comp_level) const  { return _peak_wait_time[comp_level]; }
 
   // Redefine Classes support
   void mark_on_stack();
@@ -239,6 +296,7 @@ class CompileQueue : public CHeapObj<mtCompiler> {
 
   ~CompileQueue() {
     assert (is_empty(), " Compile Queue must be empty");
+    delete _heap;
   }
 };
 
@@ -293,6 +351,16 @@ class CompileBroker: AllStatic {
 
   static GrowableArray<CompilerThread*>* _compiler_threads;
 
+  // With UseDynamicNumberOfCompilerThreads compiler threads are started on
+  // demand (see possibly_add_compiler_threads()) and retired when idle. The
+  // java.lang.Thread objects and the performance counters of all possible
+  // threads are created at startup and reused when a thread is restarted.
+  static int                _c1_count, _c2_count;  // maximum number of threads
+  static jobject*           _compiler1_objects;
+  static jobject*           _compiler2_objects;
+  static CompilerCounters** _compiler1_counters;
+  static CompilerCounters** _compiler2_counters;
+
   // performance counters
   static PerfCounter* _perf_total_compilation;
   static PerfCounter* _perf_native_compilation;
@@ -338,8 +406,10 @@ class CompileBroker: AllStatic {
 
   static volatile jint _print_compilation_warning;
 
-  static CompilerThread* make_compiler_thread(const char* name, CompileQueue* queue, CompilerCounters* counters, AbstractCompiler* comp, TRAPS);
+  static Handle create_thread_oop(const char* name, TRAPS);
+  static CompilerThread* make_compiler_thread(jobject thread_handle, CompileQueue* queue, CompilerCounters* counters, AbstractCompiler* comp, TRAPS);
   static void init_compiler_threads(int c1_compiler_count, int c2_compiler_count);
+  static void possibly_add_compiler_threads();
   static bool compilation_is_prohibited(methodHandle method, int osr_bci, int comp_level);
   static bool is_compile_blocking      ();
   static void preload_classes          (methodHandle method, TRAPS);
@@ -369,11 +439,6 @@ class CompileBroker: AllStatic {
                                   int hot_count,
                                   const char* comment,
                                   Thread* thread);
-  static CompileQueue* compile_queue(int comp_level) {
-    if (is_c2_compile(comp_level)) return _c2_compile_queue;
-    if (is_c1_compile(comp_level)) return _c1_compile_queue;
-    return NULL;
-  }
   static bool init_compiler_runtime();
   static void shutdown_compiler_runtime(AbstractCompiler* comp, CompilerThread* thread);
 
@@ -389,6 +454,12 @@ class CompileBroker: AllStatic {
     return NULL;
   }
 
+  static CompileQueue* compile_queue(int comp_level) {
+    if (is_c2_compile(comp_level)) return _c2_compile_queue;
+    if (is_c1_compile(comp_level)) return _c1_compile_queue;
+    return NULL;
+  }
+
   static bool compilation_is_complete(methodHandle method, int osr_bci, int comp_level);
   static bool compilation_is_in_queue(methodHandle method);
   static int queue_size(int comp_level) {
@@ -405,6 +476,9 @@ class CompileBroker: AllStatic {
                                  const char* comment, Thread* thread);
 
   static void compiler_thread_loop();
+  // Can the compiler thread ct retire? If do_it is set the thread is
+  // also no longer counted as running (requires CompileThread_lock).
+  static bool can_remove(CompilerThread* ct, bool do_it);
   static uint get_compilation_id() { return _compilation_id; }
 
   // Set _should_block.
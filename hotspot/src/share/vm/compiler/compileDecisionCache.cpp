@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "classfile/symbolTable.hpp"
+#include "classfile/systemDictionary.hpp"
+#include "code/codeCache.hpp"
+#include "code/nmethod.hpp"
+#include "compiler/compileBroker.hpp"
+#include "compiler/compileDecisionCache.hpp"
+#include "memory/resourceArea.hpp"
+#include "oops/instanceKlass.hpp"
+#include "oops/method.hpp"
+#include "runtime/atomic.inline.hpp"
+#include "runtime/handles.inline.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/os.hpp"
+#include "utilities/ostream.hpp"
+
+bool                                          CompileDecisionCache::_enabled     = false;
+GrowableArray<CompileDecisionCache::Decision>* CompileDecisionCache::_decisions  = NULL;
+CompileDecisionCache::DecisionTable*          CompileDecisionCache::_by_klass    = NULL;
+fileStream*                                   CompileDecisionCache::_dump_stream = NULL;
+volatile jint                                 CompileDecisionCache::_submitted   = 0;
+
+// Returns the next blank separated token of a line and advances past it.
+static char* next_token(char** line) {
+  char* p = *line;
+  while (*p == ' ' || *p == '\t') p++;
+  if (*p == '\0' || *p == '\n' || *p == '\r') {
+    return NULL;
+  }
+  char* token = p;
+  while (*p != '\0' && *p != ' ' && *p != '\t' && *p != '\n' && *p != '\r') p++;
+  if (*p != '\0') {
+    *p++ = '\0';
+  }
+  *line = p;
+  return token;
+}
+
+bool CompileDecisionCache::read_decisions(const char* path, TRAPS) {
+  FILE* file = fopen(path, "r");
+  if (file == NULL) {
+    char errmsg[JVM_MAXPATHLEN];
+    os::lasterror(errmsg, JVM_MAXPATHLEN);
+    warning("Could not open CompileDecisionFile %s: %s", path, errmsg);
+    return false;
+  }
+
+  _decisions = new (ResourceObj::C_HEAP, mtCompiler) GrowableArray<Decision>(256, true, mtCompiler);
+  _by_klass = new (ResourceObj::C_HEAP, mtCompiler) DecisionTable();
+
+  char buffer[4*K];
+  while (fgets(buffer, sizeof buffer, file) != NULL) {
+    size_t len = strlen(buffer);
+    if (len > 0 && buffer[len-1] != '\n' && !feof(file)) {
+      // Skip the rest of an overlong line.
+      int c;
+      while ((c = fgetc(file)) != EOF && c != '\n') ;
+      continue;
+    }
+    // Only compile lines are used, other ciReplay records are ignored.
+    char* line = buffer;
+    char* tag = next_token(&line);
+    if (tag == NULL || strcmp(tag, "compile") != 0) {
+      continue;
+    }
+    char* klass     = next_token(&line);
+    char* name      = next_token(&line);
+    char* signature = next_token(&line);
+    char* bci       = next_token(&line);
+    char* level     = next_token(&line);
+    if (level == NULL) {
+      continue;
+    }
+    // OSR compilations are not replayed, and names with non-ASCII
+    // characters are quoted in the file and not worth unquoting.
+    int comp_level = atoi(level);
+    if (atoi(bci) != InvocationEntryBci ||
+        comp_level <= CompLevel_none || comp_level > CompLevel_full_optimization ||
+        strchr(klass, '\\') != NULL || strchr(name, '\\') != NULL || strchr(signature, '\\') != NULL) {
+      continue;
+    }
+
+    // The symbols are kept for the lifetime of the VM.
+    Decision d;
+    d._klass     = SymbolTable::new_symbol(klass, (int)strlen(klass), CHECK_false);
+    d._name      = SymbolTable::new_symbol(name, (int)strlen(name), CHECK_false);
+    d._signature = SymbolTable::new_symbol(signature, (int)strlen(signature), CHECK_false);
+    d._comp_level = comp_level;
+    int* head = _by_klass->get(d._klass);
+    d._next = (head == NULL) ? -1 : *head;
+    _decisions->append(d);
+    _by_klass->put(d._klass, _decisions->length() - 1);
+  }
+  fclose(file);
+  return true;
+}
+
+void CompileDecisionCache::initialize(TRAPS) {
+  assert(CompileDecisionFile != NULL, "should not be called otherwise");
+  if (!read_decisions(CompileDecisionFile, THREAD) || HAS_PENDING_EXCEPTION) {
+    return;
+  }
+  _enabled = true;
+
+  // Classes that were initialized while the VM started, before the
+  // compilers were available, are all defined by the boot loader.
+  for (int i = 0; i < _decisions->length(); i++) {
+    Symbol* name = _decisions->at(i)._klass;
+    Klass* k = SystemDictionary::find(name, Handle(), Handle(), THREAD);
+    if (k != NULL && k->oop_is_instance() && InstanceKlass::cast(k)->is_initialized()) {
+      class_initialized(InstanceKlass::cast(k), THREAD);
+    }
+  }
+
+  if (PrintCompilation) {
+    tty->print_cr("[Read %d compile decisions from %s]", _decisions->length(), CompileDecisionFile);
+  }
+}
+
+void CompileDecisionCache::class_initialized(InstanceKlass* ik, TRAPS) {
+  assert(_enabled, "should not be called otherwise");
+  int first;
+  {
+    // Take the decisions of the class out of the table, so that they are
+    // submitted only once even if another loader defines the same name.
+    MutexLocker ml(CompileDecision_lock, THREAD);
+    int* head = _by_klass->get(ik->name());
+    if (head == NULL || *head == -1) {
+      return;
+    }
+    first = *head;
+    *head = -1;
+  }
+  submit(ik, first, THREAD);
+}
+
+void CompileDecisionCache::submit(InstanceKlass* ik, int first, TRAPS) {
+  for (int i = first; i != -1; i = _decisions->at(i)._next) {
+    const Decision& d = _decisions->at(i);
+    Method* m = ik->find_method(d._name, d._signature);
+    if (m == NULL || m->is_abstract() || m->is_native()) {
+      continue;
+    }
+    int comp_level = TieredCompilation ? MIN2(d._comp_level, (int)TieredStopAtLevel)
+                                       : (int)CompLevel_highest_tier;
+    HandleMark hm(THREAD);
+    methodHandle mh(THREAD, m);
+    CompileBroker::compile_method(mh, InvocationEntryBci, comp_level, mh, 0, "compile decision", THREAD);
+    if (HAS_PENDING_EXCEPTION) {
+      CLEAR_PENDING_EXCEPTION;
+      continue;
+    }
+    Atomic::inc(&_submitted);
+  }
+}
+
+void CompileDecisionCache::dump_nmethod(nmethod* nm) {
+  if (!nm->is_in_use() || nm->is_osr_method() || nm->comp_level() != CompLevel_full_optimization) {
+    return;
+  }
+  Method* m = nm->method();
+  // Anonymous classes get a new name in every run.
+  if (m == NULL || m->method_holder()->is_anonymous()) {
+    return;
+  }
+  _dump_stream->print_cr("compile %s %s %s %d %d",
+                         m->klass_name()->as_quoted_ascii(),
+                         m->name()->as_quoted_ascii(),
+                         m->signature()->as_quoted_ascii(),
+                         InvocationEntryBci, nm->comp_level());
+}
+
+void CompileDecisionCache::dump() {
+  assert(DumpCompileDecisionFile != NULL, "should not be called otherwise");
+  fileStream stream(DumpCompileDecisionFile, "w");
+  if (!stream.is_open()) {
+    warning("Could not open DumpCompileDecisionFile %s", DumpCompileDecisionFile);
+    return;
+  }
+  ResourceMark rm;
+  _dump_stream = &stream;
+  {
+    MutexLockerEx mu(CodeCache_lock, Mutex::_no_safepoint_check_flag);
+    CodeCache::alive_nmethods_do(dump_nmethod);
+  }
+  _dump_stream = NULL;
+  if (PrintCompilation && _enabled) {
+    tty->print_cr("[Submitted %d compile decisions from %s]", _submitted, CompileDecisionFile);
+  }
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_COMPILER_COMPILEDECISIONCACHE_HPP
+#define SHARE_VM_COMPILER_COMPILEDECISIONCACHE_HPP
+
+#include "memory/allocation.hpp"
+#include "oops/symbol.hpp"
+#include "utilities/growableArray.hpp"
+#include "utilities/resourceHash.hpp"
+
+class InstanceKlass;
+class nmethod;
+
+// CompileDecisionCache carries the set of methods compiled at the highest
+// tier from one run of an application to the next.
+//
+// With DumpCompileDecisionFile the VM writes one line per method that has
+// in-use top tier code at exit, in the ciReplay "compile" line format:
+//
+//   compile <klass> <method> <signature> <entry_bci> <comp_level>
+//
+// With CompileDecisionFile the lines are read back at startup and the
+// methods of a class are submitted for background compilation at their
+// recorded level as soon as the class is initialized. Classes that were
+// initialized before the compilers came up are handled at startup.
+class CompileDecisionCache : AllStatic {
+ private:
+  struct Decision {
+    Symbol* _klass;
+    Symbol* _name;
+    Symbol* _signature;
+    int     _comp_level;
+    int     _next;        // index of the next decision for the same class, or -1
+  };
+
+  // Symbols are unique, so the table is keyed on their address.
+  typedef ResourceHashtable<Symbol*, int, primitive_hash<Symbol*>, primitive_equals<Symbol*>,
+                            1031, ResourceObj::C_HEAP, mtCompiler> DecisionTable;
+
+  static bool                     _enabled;
+  static GrowableArray<Decision>* _decisions;
+  static DecisionTable*           _by_klass;    // class name -> first decision
+  static fileStream*              _dump_stream;
+  static volatile jint            _submitted;
+
+  static bool read_decisions(const char* path, TRAPS);
+  static void submit(InstanceKlass* ik, int first, TRAPS);
+  static void dump_nmethod(nmethod* nm);
+
+ public:
+  static bool is_enabled()                      { return _enabled; }
+
+  // Load CompileDecisionFile. Called once the compilers are initialized.
+  static void initialize(TRAPS);
+
+  // Submit the recorded compilations of a class that has just been initialized.
+  static void class_initialized(InstanceKlass* ik, TRAPS);
+
+  // Write DumpCompileDecisionFile. Called at VM exit.
+  static void dump();
+};
+
+#endif // SHARE_VM_COMPILER_COMPILEDECISIONCACHE_HPP
@@ -58,15 +58,15 @@ size_t CompactibleFreeListSpace::IndexSetStride = 0;
 size_t MinChunkSize = 0;
 
 void CompactibleFreeListSpace::set_cms_values() {
-  // Set CMS global values
-  assert(MinChunkSize == 0, "already set");
+  // Set CMS global values. They are recomputed if ergonomics raises
+  // ObjectAlignmentInBytes, which happens before any space is created.
+  assert(!is_init_completed(), "object alignment is fixed once the VM is up");
 
   // MinChunkSize should be a multiple of MinObjAlignment and be large enough
   // for chunks to contain a FreeChunk.
   size_t min_chunk_size_in_bytes = align_size_up(sizeof(FreeChunk), MinObjAlignmentInBytes);
   MinChunkSize = min_chunk_size_in_bytes / BytesPerWord;
 
-  assert(IndexSetStart == 0 && IndexSetStride == 0, "already set");
   IndexSetStart  = MinChunkSize;
   IndexSetStride = MinObjAlignment;
 }
@@ -2601,7 +2601,8 @@ size_t CFLS_LAB::_global_num_blocks[]  = VECTOR_257(0);
 uint   CFLS_LAB::_global_num_workers[] = VECTOR_257(0);
 
 CFLS_LAB::CFLS_LAB(CompactibleFreeListSpace* cfls) :
-  _cfls(cfls)
+  _cfls(cfls),
+  _large_lab(NULL)
 {
   assert(CompactibleFreeListSpace::IndexSetSize == 257, "Modify VECTOR_257() macro above");
   for (size_t i = CompactibleFreeListSpace::IndexSetStart;
@@ -2628,11 +2629,17 @@ HeapWord* CFLS_LAB::alloc(size_t word_sz) {
   FreeChunk* res;
   assert(word_sz == _cfls->adjustObjectSize(word_sz), "Error");
   if (word_sz >=  CompactibleFreeListSpace::IndexSetSize) {
-    // This locking manages sync with other large object allocations.
-    MutexLockerEx x(_cfls->parDictionaryAllocLock(),
-                    Mutex::_no_safepoint_check_flag);
-    res = _cfls->getChunkFromDictionaryExact(word_sz);
-    if (res == NULL) return NULL;
+    res = NULL;
+    if (word_sz <= CMSLargeOldPLABSize / 8) {
+      res = alloc_from_large_lab(word_sz);
+    }
+    if (res == NULL) {
+      // This locking manages sync with other large object allocations.
+      MutexLockerEx x(_cfls->parDictionaryAllocLock(),
+                      Mutex::_no_safepoint_check_flag);
+      res = _cfls->getChunkFromDictionaryExact(word_sz);
+      if (res == NULL) return NULL;
+    }
   } else {
     AdaptiveFreeList<FreeChunk>* fl = &_indexedFreeList[word_sz];
     if (fl->count() == 0) {
@@ -2652,6 +2659,63 @@ HeapWord* CFLS_LAB::alloc(size_t word_sz) {
   return (HeapWord*)res;
 }
 
+FreeChunk* CFLS_LAB::alloc_from_large_lab(size_t word_sz) {
+  if (_large_lab != NULL &&
+      _large_lab->size() != word_sz &&
+      _large_lab->size() < word_sz + MinChunkSize) {
+    retire_large_lab();
+  }
+  if (_large_lab == NULL) {
+    MutexLockerEx x(_cfls->parDictionaryAllocLock(),
+                    Mutex::_no_safepoint_check_flag);
+    _large_lab = _cfls->getChunkFromDictionaryExact(
+                   _cfls->adjustObjectSize(CMSLargeOldPLABSize));
+    if (_large_lab == NULL) {
+      return NULL;
+    }
+  }
+  assert(_large_lab->is_free(), "Buffer must look free to other GC threads");
+  FreeChunk* res = _large_lab;
+  size_t rem = res->size() - word_sz;
+  if (rem == 0) {
+    _large_lab = NULL;
+    return res;
+  }
+  assert(rem >= MinChunkSize, "Free chunk smaller than minimum");
+  // As in par_get_chunk_of_blocks_dictionary(), make the remainder a
+  // free block before shrinking res, so that other GC threads parsing
+  // the space always see well-formed blocks.
+  FreeChunk* ffc = (FreeChunk*)((HeapWord*)res + word_sz);
+  ffc->set_size(rem);
+  ffc->link_prev(NULL); // Mark as a free block for other (parallel) GC threads.
+  ffc->link_next(NULL);
+  // Above must occur before BOT is updated below.
+  OrderAccess::storestore();
+  _cfls->_bt.mark_block((HeapWord*)ffc, rem, true /* reducing */);
+  res->set_size(word_sz);
+  _large_lab = ffc;
+  return res;
+}
+
+void CFLS_LAB::retire_large_lab() {
+  assert(_large_lab != NULL, "No buffer to retire");
+  size_t size = _large_lab->size();
+  // As for the remainder in get_n_way_chunk_to_split().
+  if (size < CompactibleFreeListSpace::IndexSetSize) {
+    MutexLockerEx x(_cfls->_indexedFreeListParLocks[size],
+                    Mutex::_no_safepoint_check_flag);
+    _cfls->_bt.verify_not_unallocated((HeapWord*)_large_lab, size);
+    _cfls->_indexedFreeList[size].return_chunk_at_head(_large_lab);
+    _cfls->smallSplitBirth(size);
+  } else {
+    MutexLockerEx x(_cfls->parDictionaryAllocLock(),
+                    Mutex::_no_safepoint_check_flag);
+    _cfls->returnChunkToDictionary(_large_lab);
+    _cfls->dictionary()->dict_census_update(size, true /*split*/, true /*birth*/);
+  }
+  _large_lab = NULL;
+}
+
 // Get a chunk of blocks of the right size and update related
 // book-keeping stats
 void CFLS_LAB::get_from_global_pool(size_t word_sz, AdaptiveFreeList<FreeChunk>* fl) {
@@ -2717,6 +2781,9 @@ void CFLS_LAB::retire(int tid) {
   // so no need for locks and such.
   NOT_PRODUCT(Thread* t = Thread::current();)
   assert(Thread::current()->is_VM_thread(), "Error");
+  if (_large_lab != NULL) {
+    retire_large_lab();
+  }
   for (size_t i =  CompactibleFreeListSpace::IndexSetStart;
        i < CompactibleFreeListSpace::IndexSetSize;
        i += CompactibleFreeListSpace::IndexSetStride) {
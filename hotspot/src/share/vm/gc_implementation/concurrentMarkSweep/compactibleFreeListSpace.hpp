@@ -650,6 +650,11 @@ class CFLS_LAB : public CHeapObj<mtGC> {
   // Our local free lists.
   AdaptiveFreeList<FreeChunk> _indexedFreeList[CompactibleFreeListSpace::IndexSetSize];
 
+  // A free chunk of about CMSLargeOldPLABSize words, on none of the
+  // space's free lists, that blocks too large for the indexed free lists
+  // are carved from without locking; NULL if there is none.
+  FreeChunk* _large_lab;
+
   // Initialized from a command-line arg.
 
   // Allocation statistics in support of dynamic adjustment of
@@ -663,6 +668,12 @@ class CFLS_LAB : public CHeapObj<mtGC> {
   // Internal work method
   void get_from_global_pool(size_t word_sz, AdaptiveFreeList<FreeChunk>* fl);
 
+  // Allocate a block from _large_lab, refilling it from the dictionary if
+  // needed; returns NULL if the dictionary cannot supply a new one.
+  FreeChunk* alloc_from_large_lab(size_t word_sz);
+  // Return the unused part of _large_lab to the space's free lists.
+  void retire_large_lab();
+
 public:
   CFLS_LAB(CompactibleFreeListSpace* cfls);
 
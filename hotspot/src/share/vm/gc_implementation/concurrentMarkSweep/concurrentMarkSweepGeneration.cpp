@@ -35,6 +35,7 @@
 #include "gc_implementation/concurrentMarkSweep/concurrentMarkSweepGeneration.inline.hpp"
 #include "gc_implementation/concurrentMarkSweep/concurrentMarkSweepThread.hpp"
 #include "gc_implementation/concurrentMarkSweep/vmCMSOperations.hpp"
+#include "gc_implementation/g1/g1StringDedup.hpp"
 #include "gc_implementation/parNew/parNewGeneration.hpp"
 #include "gc_implementation/shared/collectorCounters.hpp"
 #include "gc_implementation/shared/gcTimer.hpp"
@@ -63,6 +64,7 @@
 #include "runtime/vmThread.hpp"
 #include "services/memoryService.hpp"
 #include "services/runtimeService.hpp"
+#include "utilities/quickSort.hpp"
 
 PRAGMA_FORMAT_MUTE_WARNINGS_FOR_GCC
 
@@ -576,6 +578,7 @@ CMSCollector::CMSCollector(ConcurrentMarkSweepGeneration* cmsGen,
   _eden_chunk_array(NULL),     // may be set in ctor body
   _eden_chunk_capacity(0),     // -- ditto --
   _eden_chunk_index(0),        // -- ditto --
+  _eden_chunk_last_step(0),    // -- ditto --
   _survivor_plab_array(NULL),  // -- ditto --
   _survivor_chunk_array(NULL), // -- ditto --
   _survivor_chunk_capacity(0), // -- ditto --
@@ -2839,7 +2842,7 @@ void CMSCollector::gc_epilogue(bool full) {
     _start_sampling = true;
   }
   // reset _eden_chunk_array so sampling starts afresh
-  _eden_chunk_index = 0;
+  reset_eden_chunk_array();
 
   size_t cms_used   = _cmsGen->cmsSpace()->used();
   _cmsGen->cmsSpace()->recalculate_used_stable();
@@ -4527,7 +4530,7 @@ void CMSCollector::preclean() {
   _abort_preclean = false;
   if (CMSPrecleaningEnabled) {
     if (!CMSEdenChunksRecordAlways) {
-      _eden_chunk_index = 0;
+      reset_eden_chunk_array();
     }
     size_t used = get_eden_used();
     size_t capacity = get_eden_capacity();
@@ -4582,11 +4585,24 @@ void CMSCollector::abortable_preclean() {
     // this smarter in the next iteration.
     // XXX FIX ME!!! YSR
     size_t loops = 0, workdone = 0, cumworkdone = 0, waited = 0;
+    double cumworktime = 0.0;
     while (!(should_abort_preclean() ||
              ConcurrentMarkSweepThread::should_terminate())) {
+      double start = os::elapsedTime();
       workdone = preclean_work(CMSPrecleanRefLists2, CMSPrecleanSurvivors2);
+      cumworktime += os::elapsedTime() - start;
       cumworkdone += workdone;
       loops++;
+      // The cards dirtied while we did the last pass are about as many
+      // as it found, and are what the remark will have to rescan.
+      if (CMSPrecleanRemarkTargetMillis != 0 &&
+          predicted_remark_rescan_millis(workdone, cumworkdone, cumworktime) <
+            (double) CMSPrecleanRemarkTargetMillis) {
+        if (PrintGCDetails) {
+          gclog_or_tty->print(" CMS: abort preclean due to remark estimate ");
+        }
+        break;
+      }
       // Voluntarily terminate abortable preclean phase if we have
       // been at it for too long.
       if ((CMSMaxAbortablePrecleanLoops != 0) &&
@@ -4626,6 +4642,22 @@ void CMSCollector::abortable_preclean() {
   return;
 }
 
+// The time the remark would take to rescan the given number of dirty
+// cards, at the cost per card precleaning has seen so far.
+double CMSCollector::predicted_remark_rescan_millis(size_t cards,
+                                                    size_t cumcards,
+                                                    double cumtime) const {
+  if (cumcards == 0) {
+    return 0.0;
+  }
+  uint workers = 1;
+  if (CMSParallelRemarkEnabled && CollectedHeap::use_parallel_gc_threads()) {
+    workers = MAX2((uint) ParallelGCThreads, 1U);
+  }
+  double millis_per_card = cumtime * MILLIUNITS / (double) cumcards;
+  return (double) cards * millis_per_card / workers;
+}
+
 // Respond to an Eden sampling opportunity
 void CMSCollector::sample_eden() {
   // Make sure a young gc cannot sneak in between our
@@ -5700,6 +5732,31 @@ CMSParRemarkTask::do_work_steal(int i, Par_MarkRefsIntoAndScanClosure* cl,
 // preclean phase.
 void CMSCollector::sample_eden_chunk() {
   if (CMSEdenChunksRecordAlways && _eden_chunk_array != NULL) {
+    if (CMSBalancedEdenChunks) {
+      // Take at most one sample per CMSSamplingGrain step of eden, and
+      // never fail to take one because of contention: whoever first moves
+      // _eden_chunk_last_step past a step records the sample.
+      // balance_eden_chunk_array() puts them in address order.
+      HeapWord* top = *_top_addr;
+      HeapWord* bottom = _young_gen->as_DefNewGeneration()->eden()->bottom();
+      if (top <= bottom) {
+        return;
+      }
+      size_t step = pointer_delta(top, bottom) / CMSSamplingGrain;
+      size_t last_step = _eden_chunk_last_step;
+      if (step > last_step &&
+          (size_t)Atomic::cmpxchg_ptr((intptr_t)step,
+                                      (volatile intptr_t*)&_eden_chunk_last_step,
+                                      (intptr_t)last_step) == last_step) {
+        size_t index = (size_t)Atomic::add_ptr(1, (volatile intptr_t*)&_eden_chunk_index) - 1;
+        if (index < _eden_chunk_capacity) {
+          _eden_chunk_array[index] = top;
+        } else {
+          Atomic::add_ptr(-1, (volatile intptr_t*)&_eden_chunk_index);
+        }
+      }
+      return;
+    }
     if (_eden_chunk_lock->try_lock()) {
       // Record a sample. This is the critical section. The contents
       // of the _eden_chunk_array have to be non-decreasing in the
@@ -5739,6 +5796,35 @@ void CMSCollector::reset_survivor_plab_arrays() {
   }
 }
 
+static int compare_eden_chunks(HeapWord* a, HeapWord* b) {
+  if (a < b) {
+    return -1;
+  } else if (a > b) {
+    return 1;
+  }
+  return 0;
+}
+
+void CMSCollector::balance_eden_chunk_array() {
+  assert(SafepointSynchronize::is_at_safepoint(), "Must be at a safepoint");
+  EdenSpace* eden = _young_gen->as_DefNewGeneration()->eden();
+  size_t n = MIN2(_eden_chunk_index, _eden_chunk_capacity);
+  QuickSort::sort<HeapWord*>(_eden_chunk_array, (int)n, compare_eden_chunks, false);
+  // Keep the samples strictly inside eden that are at least
+  // CMSSamplingGrain apart, so that each task is of useful size.
+  HeapWord* prev = eden->bottom();
+  size_t kept = 0;
+  for (size_t i = 0; i < n; i++) {
+    HeapWord* cur = _eden_chunk_array[i];
+    if (cur > prev && cur < eden->top() &&
+        pointer_delta(cur, prev) >= CMSSamplingGrain) {
+      _eden_chunk_array[kept++] = cur;
+      prev = cur;
+    }
+  }
+  _eden_chunk_index = kept;
+}
+
 // Merge the per-thread plab arrays into the global survivor chunk
 // array which will provide the partitioning of the survivor space
 // for CMS initial scan and rescan.
@@ -5820,6 +5906,9 @@ initialize_sequential_subtasks_for_young_gen_rescan(int n_threads) {
 
   // Eden space
   if (!dng->eden()->is_empty()) {
+    if (CMSBalancedEdenChunks && _eden_chunk_array != NULL) {
+      balance_eden_chunk_array();
+    }
     SequentialSubTasksDone* pst = dng->eden()->par_seq_tasks();
     assert(!pst->valid(), "Clobbering existing data?");
     // Each valid entry in [0, _eden_chunk_index) represents a task.
@@ -6297,6 +6386,13 @@ void CMSCollector::refProcessingWork(bool asynch, bool clear_all_soft_refs) {
     }
   }
 
+  // The string deduplication queue and table are weak roots. They must be
+  // scrubbed in every cycle, since the sweeper frees unmarked objects.
+  if (G1StringDedup::is_enabled()) {
+    GCTraceTime t("scrub string deduplication table", PrintGCDetails, false, _gc_timer_cm, _gc_tracer_cm->gc_id());
+    G1StringDedup::unlink(&_is_alive_closure);
+  }
+
 
   // Restore any preserved marks as a result of mark stack or
   // work queue overflow
@@ -6395,9 +6491,22 @@ void CMSCollector::sweep(bool asynch) {
   verify_overflow_empty();
 
   if (should_unload_classes()) {
-    // Delay purge to the beginning of the next safepoint.  Metaspace::contains
-    // requires that the virtual spaces are stable and not deleted.
-    ClassLoaderDataGraph::set_should_purge(true);
+    if (ConcurrentClassLoaderDataPurge && asynch) {
+      // The sweep is done, so nothing reads the klasses of dead objects
+      // any more and the class loader data can be deleted right away.
+      // The unloading list is only changed at safepoints, which the CMS
+      // token keeps out while it is detached.
+      ClassLoaderData* unloaded;
+      {
+        CMSTokenSync ts(true);
+        unloaded = ClassLoaderDataGraph::detach_unloading();
+      }
+      ClassLoaderDataGraph::purge_detached(unloaded);
+    } else {
+      // Delay purge to the beginning of the next safepoint.  Metaspace::contains
+      // requires that the virtual spaces are stable and not deleted.
+      ClassLoaderDataGraph::set_should_purge(true);
+    }
   }
 
   _intra_sweep_timer.stop();
@@ -756,6 +756,10 @@ class CMSCollector: public CHeapObj<mtGC> {
   HeapWord** _eden_chunk_array; // ... Eden partitioning array
   size_t     _eden_chunk_index; // ... top (exclusive) of array
   size_t     _eden_chunk_capacity;  // ... max entries in array
+  // With CMSBalancedEdenChunks, the CMSSamplingGrain sized step of eden
+  // above which the last sample was taken; samples are taken lock-free,
+  // in no particular address order.
+  volatile size_t _eden_chunk_last_step;
 
   // Support for parallelizing survivor space rescan
   HeapWord** _survivor_chunk_array;
@@ -810,9 +814,19 @@ class CMSCollector: public CHeapObj<mtGC> {
   size_t preclean_work(bool clean_refs, bool clean_survivors);
   void preclean_klasses(MarkRefsIntoAndScanClosure* cl, Mutex* freelistLock);
   void abortable_preclean(); // Preclean while looking for possible abort
+  // Remark time for rescanning cards, estimated from precleaning so far
+  double predicted_remark_rescan_millis(size_t cards, size_t cumcards,
+                                        double cumtime) const;
   void initialize_sequential_subtasks_for_young_gen_rescan(int i);
   // Helper function for above; merge-sorts the per-thread plab samples
   void merge_survivor_plab_arrays(ContiguousSpace* surv, int no_of_gc_threads);
+  // Helper function for above; sorts the lock-free eden samples and drops
+  // those closer than CMSSamplingGrain to their predecessor
+  void balance_eden_chunk_array();
+  void reset_eden_chunk_array() {
+    _eden_chunk_index = 0;
+    _eden_chunk_last_step = 0;
+  }
   // Resets (i.e. clears) the per-thread plab sample vectors
   void reset_survivor_plab_arrays();
 
@@ -83,9 +83,11 @@ CollectionSetChooser::CollectionSetChooser() :
                                              ResourceObj::C_HEAP),
                   100), true /* C_Heap */),
     _curr_index(0), _length(0), _first_par_unreserved_idx(0),
-    _region_live_threshold_bytes(0), _remaining_reclaimable_bytes(0) {
-  _region_live_threshold_bytes =
-    HeapRegion::GrainBytes * (size_t) G1MixedGCLiveThresholdPercent / 100;
+    _remaining_reclaimable_bytes(0) {
+}
+
+bool CollectionSetChooser::region_occupancy_low_enough_for_evac(size_t live_bytes) {
+  return live_bytes < HeapRegion::GrainBytes * (size_t) G1MixedGCLiveThresholdPercent / 100;
 }
 
 #ifndef PRODUCT
@@ -26,6 +26,7 @@
 #define SHARE_VM_GC_IMPLEMENTATION_G1_COLLECTIONSETCHOOSER_HPP
 
 #include "gc_implementation/g1/heapRegion.hpp"
+#include "gc_implementation/g1/heapRegionRemSet.hpp"
 #include "utilities/growableArray.hpp"
 
 class CollectionSetChooser: public CHeapObj<mtGC> {
@@ -59,11 +60,6 @@ class CollectionSetChooser: public CHeapObj<mtGC> {
   // parallel GC workers.
   uint _first_par_unreserved_idx;
 
-  // If a region has more live bytes than this threshold, it will not
-  // be added to the CSet chooser and will not be a candidate for
-  // collection.
-  size_t _region_live_threshold_bytes;
-
   // The sum of reclaimable bytes over all the regions in the CSet chooser.
   size_t _remaining_reclaimable_bytes;
 
@@ -98,19 +94,40 @@ public:
     _curr_index += 1;
   }
 
+  // Return the given region to the CSet chooser, making it the current
+  // candidate region again. The given region should be the one most
+  // recently removed with remove_and_move_to_next().
+  void push(HeapRegion* hr) {
+    assert(hr != NULL, "pre-condition");
+    assert(_curr_index > 0, "pre-condition");
+    _curr_index -= 1;
+    assert(regions_at(_curr_index) == NULL, "pre-condition");
+    regions_at_put(_curr_index, hr);
+    _remaining_reclaimable_bytes += hr->reclaimable_bytes();
+  }
+
   CollectionSetChooser();
 
   void sort_regions();
 
+  // Returns whether a region with the given amount of live bytes is
+  // empty enough to be evacuated by a mixed collection. If a region has
+  // more live bytes than G1MixedGCLiveThresholdPercent of the region
+  // size, it will not be added to the CSet chooser and will not be a
+  // candidate for collection.
+  static bool region_occupancy_low_enough_for_evac(size_t live_bytes);
+
   // Determine whether to add the given region to the CSet chooser or
   // not. Currently, we skip humongous regions (we never add them to
-  // the CSet, we only reclaim them during cleanup) and regions whose
-  // live bytes are over the threshold.
+  // the CSet, we only reclaim them during cleanup), regions whose
+  // live bytes are over the threshold and regions without a complete
+  // remembered set.
   bool should_add(HeapRegion* hr) {
     assert(hr->is_marked(), "pre-condition");
     assert(!hr->is_young(), "should never consider young regions");
     return !hr->isHumongous() &&
-            hr->live_bytes() < _region_live_threshold_bytes;
+            region_occupancy_low_enough_for_evac(hr->live_bytes()) &&
+            hr->rem_set()->is_complete();
   }
 
   // Returns the number candidate old regions added
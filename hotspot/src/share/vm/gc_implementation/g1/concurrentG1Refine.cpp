@@ -82,7 +82,7 @@ void ConcurrentG1Refine::reset_threshold_step() {
 }
 
 void ConcurrentG1Refine::init(G1RegionToSpaceMapper* card_counts_storage) {
-  _hot_card_cache.initialize(card_counts_storage);
+  _hot_card_cache.initialize(card_counts_storage, worker_thread_num());
 }
 
 void ConcurrentG1Refine::stop() {
@@ -101,10 +101,21 @@ void ConcurrentG1RefineThread::sample_young_list_rs_lengths() {
   }
 }
 
+void ConcurrentG1RefineThread::filter_satb_buffers() {
+  SuspendibleThreadSetJoiner sts;
+  size_t n = JavaThread::satb_mark_queue_set().filter_unfiltered_buffers();
+  if (G1TraceConcRefinement && n > 0) {
+    gclog_or_tty->print_cr("G1-Refine-filtered " SIZE_FORMAT " SATB buffers", n);
+  }
+}
+
 void ConcurrentG1RefineThread::run_young_rs_sampling() {
   DirtyCardQueueSet& dcqs = JavaThread::dirty_card_queue_set();
   _vtime_start = os::elapsedVTime();
   while(!_should_terminate) {
+    if (G1SATBFilterInRefinement) {
+      filter_satb_buffers();
+    }
     sample_young_list_rs_lengths();
 
     if (os::supports_vtime()) {
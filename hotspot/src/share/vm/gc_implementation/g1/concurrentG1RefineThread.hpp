@@ -60,6 +60,8 @@ class ConcurrentG1RefineThread: public ConcurrentGCThread {
   int _deactivation_threshold;
 
   void sample_young_list_rs_lengths();
+  // Filters the SATB buffers mutators left unfiltered
+  void filter_satb_buffers();
   void run_young_rs_sampling();
   void wait_for_completed_buffers();
 
@@ -534,6 +534,7 @@ ConcurrentMark::ConcurrentMark(G1CollectedHeap* g1h, G1RegionToSpaceMapper* prev
   _cleanup_sleep_factor(0.0),
   _cleanup_task_overhead(1.0),
   _cleanup_list("Cleanup List"),
+  _unloaded_clds(NULL),
   _region_bm((BitMap::idx_t)(g1h->max_regions()), false /* in_resource_area*/),
   _card_bm((g1h->reserved_region().byte_size() + CardTableModRefBS::card_size - 1) >>
             CardTableModRefBS::card_shift,
@@ -567,6 +568,7 @@ ConcurrentMark::ConcurrentMark(G1CollectedHeap* g1h, G1RegionToSpaceMapper* prev
   _total_rs_scrub_time(0.0),
 
   _parallel_workers(NULL),
+  _num_regions_selected_for_rebuild(0),
 
   _count_card_bitmaps(NULL),
   _count_marked_bytes(NULL),
@@ -855,6 +857,61 @@ ConcurrentMark::~ConcurrentMark() {
   ShouldNotReachHere();
 }
 
+// Clears the next mark bitmap with the marking threads. Workers claim
+// regions and clear them in chunks, joining the suspendible thread set so
+// that a pause only waits for the current chunk.
+class G1ClearNextBitmapTask : public AbstractGangTask {
+  ConcurrentMark* _cm;
+  CMBitMap* _bitmap;
+  G1CollectedHeap* _g1h;
+  // The index of the next region to be claimed.
+  volatile jint _next_region;
+
+  // Clears the bitmap of the given region, returning false if marking was
+  // aborted while yielding.
+  bool clear_region(HeapRegion* r, uint worker_id) {
+    size_t const chunk_size_in_words = M / HeapWordSize;
+
+    HeapWord* cur = r->bottom();
+    HeapWord* const end = r->end();
+
+    while (cur < end) {
+      MemRegion mr(cur, MIN2(cur + chunk_size_in_words, end));
+      _bitmap->clearRange(mr);
+
+      cur += chunk_size_in_words;
+
+      if (_cm->do_yield_check(worker_id) && _cm->has_aborted()) {
+        return false;
+      }
+      assert(_cm->cmThread()->during_cycle(), "invariant");
+      assert(!_g1h->mark_in_progress(), "invariant");
+    }
+    return true;
+  }
+
+public:
+  G1ClearNextBitmapTask(ConcurrentMark* cm, CMBitMap* bitmap) :
+    AbstractGangTask("G1 Clear Next Bitmap"),
+    _cm(cm), _bitmap(bitmap), _g1h(G1CollectedHeap::heap()), _next_region(0) { }
+
+  void work(uint worker_id) {
+    SuspendibleThreadSet::join();
+
+    jint max_regions = (jint)_g1h->max_regions();
+    jint region_idx = Atomic::add(1, &_next_region) - 1;
+    while (region_idx < max_regions && !_cm->has_aborted()) {
+      HeapRegion* hr = _g1h->region_at_or_null((uint)region_idx);
+      if (hr != NULL && !clear_region(hr, worker_id)) {
+        break;
+      }
+      region_idx = Atomic::add(1, &_next_region) - 1;
+    }
+
+    SuspendibleThreadSet::leave();
+  }
+};
+
 void ConcurrentMark::clearNextBitmap() {
   G1CollectedHeap* g1h = G1CollectedHeap::heap();
 
@@ -868,12 +925,19 @@ void ConcurrentMark::clearNextBitmap() {
   // is the case.
   guarantee(!g1h->mark_in_progress(), "invariant");
 
-  ClearBitmapHRClosure cl(this, _nextMarkBitMap, true /* may_yield */);
-  g1h->heap_region_iterate(&cl);
+  uint active_workers = MAX2(1U, calc_parallel_marking_threads());
+  G1ClearNextBitmapTask task(this, _nextMarkBitMap);
+  if (use_parallel_marking_threads()) {
+    _parallel_workers->set_active_workers((int)active_workers);
+    _parallel_workers->run_task(&task);
+  } else {
+    task.work(0);
+  }
 
   // Clear the liveness counting data. If the marking has been aborted, the abort()
   // call already did that.
-  if (cl.complete()) {
+  if (!has_aborted()) {
+    SuspendibleThreadSetJoiner sts;
     clear_all_count_data();
   }
 
@@ -1290,6 +1354,160 @@ void ConcurrentMark::markFromRoots() {
   print_stats();
 }
 
+// Closure for the concurrent remembered set rebuild. Adds the references
+// into regions whose remembered set is being rebuilt.
+class G1RebuildRemSetClosure : public ExtendedOopClosure {
+  G1CollectedHeap* _g1h;
+  HeapRegion* _from;
+  uint _rs_id;
+
+public:
+  G1RebuildRemSetClosure(G1CollectedHeap* g1h, uint worker_id) :
+    _g1h(g1h), _from(NULL),
+    _rs_id(HeapRegionRemSet::rebuild_rem_set_worker_id_offset() + worker_id) { }
+
+  void set_from(HeapRegion* from) { _from = from; }
+
+  template <class T> void do_oop_work(T* p) {
+    T heap_oop = oopDesc::load_heap_oop(p);
+    if (oopDesc::is_null(heap_oop)) {
+      return;
+    }
+    oop obj = oopDesc::decode_heap_oop_not_null(heap_oop);
+    HeapRegion* to = _g1h->heap_region_containing_raw(obj);
+    if (to == _from) {
+      return;
+    }
+    HeapRegionRemSet* rem_set = to->rem_set();
+    if (rem_set->is_updating()) {
+      rem_set->add_reference(p, _rs_id);
+    }
+  }
+
+  virtual void do_oop(oop* p)       { do_oop_work(p); }
+  virtual void do_oop(narrowOop* p) { do_oop_work(p); }
+};
+
+class G1RebuildRemSetTask: public AbstractGangTask {
+  ConcurrentMark* _cm;
+  G1CollectedHeap* _g1h;
+  // The index of the next region to be claimed.
+  volatile jint _next_region;
+
+  // Returns whether the scan of the given region should stop, either
+  // because marking has been aborted or because the region changed
+  // while we yielded.
+  bool should_stop(HeapRegion* hr, HeapWord* tars) {
+    return _cm->has_aborted() || hr->top_at_rebuild_start() != tars;
+  }
+
+  // Scans the live objects of the given region below the top at rebuild
+  // start. Live objects below NTAMS are those marked on the next bitmap;
+  // all objects in [NTAMS, TARS) have been allocated during marking.
+  void rebuild_rem_set_in_region(HeapRegion* hr, HeapWord* tars,
+                                 G1RebuildRemSetClosure* cl, uint worker_id) {
+    CMBitMapRO* bitmap = _cm->nextMarkBitMap();
+    HeapWord* ntams = hr->next_top_at_mark_start();
+    cl->set_from(hr);
+
+    if (hr->startsHumongous()) {
+      oop obj = oop(hr->bottom());
+      if (hr->bottom() >= ntams || bitmap->isMarked(hr->bottom())) {
+        obj->oop_iterate(cl);
+      }
+      return;
+    }
+
+    HeapWord* limit = MIN2(ntams, tars);
+    HeapWord* cur = bitmap->getNextMarkedWordAddress(hr->bottom(), limit);
+    while (cur < limit) {
+      oop obj = oop(cur);
+      size_t size = obj->oop_iterate(cl);
+      if (_cm->do_yield_check(worker_id) && should_stop(hr, tars)) {
+        return;
+      }
+      cur = bitmap->getNextMarkedWordAddress(cur + size, limit);
+    }
+
+    cur = limit;
+    while (cur < tars) {
+      oop obj = oop(cur);
+      size_t size = obj->oop_iterate(cl);
+      if (_cm->do_yield_check(worker_id) && should_stop(hr, tars)) {
+        return;
+      }
+      cur += size;
+    }
+  }
+
+public:
+  G1RebuildRemSetTask(ConcurrentMark* cm) :
+    AbstractGangTask("G1 Rebuild Remembered Set"),
+    _cm(cm), _g1h(G1CollectedHeap::heap()), _next_region(0) { }
+
+  void work(uint worker_id) {
+    SuspendibleThreadSet::join();
+
+    G1RebuildRemSetClosure cl(_g1h, worker_id);
+    jint max_regions = (jint)_g1h->max_regions();
+    jint region_idx = Atomic::add(1, &_next_region) - 1;
+    while (region_idx < max_regions && !_cm->has_aborted()) {
+      HeapRegion* hr = _g1h->region_at_or_null((uint)region_idx);
+      if (hr != NULL && !hr->continuesHumongous()) {
+        HeapWord* tars = hr->top_at_rebuild_start();
+        if (tars != NULL) {
+          rebuild_rem_set_in_region(hr, tars, &cl, worker_id);
+        }
+      }
+      _cm->do_yield_check(worker_id);
+      region_idx = Atomic::add(1, &_next_region) - 1;
+    }
+
+    SuspendibleThreadSet::leave();
+  }
+};
+
+void ConcurrentMark::rebuild_rem_set_concurrently() {
+  if (_num_regions_selected_for_rebuild == 0) {
+    return;
+  }
+
+  uint active_workers = MAX2(1U, calc_parallel_marking_threads());
+  G1RebuildRemSetTask task(this);
+  if (use_parallel_marking_threads()) {
+    _parallel_workers->set_active_workers((int)active_workers);
+    _parallel_workers->run_task(&task);
+  } else {
+    task.work(0);
+  }
+}
+
+// Selects the old regions whose remembered set is rebuilt before cleanup
+// and records the top at rebuild start of all regions that the rebuild
+// scans for references into them.
+class G1UpdateRemSetTrackingBeforeRebuild : public HeapRegionClosure {
+  G1CollectedHeap* _g1h;
+  uint _num_selected_for_rebuild;
+
+public:
+  G1UpdateRemSetTrackingBeforeRebuild(G1CollectedHeap* g1h) :
+    _g1h(g1h), _num_selected_for_rebuild(0) { }
+
+  bool doHeapRegion(HeapRegion* r) {
+    if (_g1h->g1_policy()->remset_tracker()->update_before_rebuild(r, r->next_live_bytes())) {
+      _num_selected_for_rebuild++;
+    }
+    if (r->is_old() || r->startsHumongous()) {
+      r->set_top_at_rebuild_start(r->top());
+    } else {
+      r->set_top_at_rebuild_start(NULL);
+    }
+    return false;
+  }
+
+  uint num_selected_for_rebuild() const { return _num_selected_for_rebuild; }
+};
+
 void ConcurrentMark::checkpointRootsFinal(bool clear_all_soft_refs) {
   // world is stopped at this checkpoint
   assert(SafepointSynchronize::is_at_safepoint(),
@@ -1347,6 +1565,12 @@ void ConcurrentMark::checkpointRootsFinal(bool clear_all_soft_refs) {
     // while marking.
     aggregate_count_data();
 
+    {
+      G1UpdateRemSetTrackingBeforeRebuild cl(g1h);
+      g1h->heap_region_iterate(&cl);
+      _num_regions_selected_for_rebuild = cl.num_selected_for_rebuild();
+    }
+
     SATBMarkQueueSet& satb_mq_set = JavaThread::satb_mark_queue_set();
     // We're done with marking.
     // This is the end of  the marking cycle, we're expected all
@@ -1874,7 +2098,8 @@ public:
     hr->note_end_of_marking();
     _max_live_bytes += hr->max_live_bytes();
 
-    if (hr->used() > 0 && hr->max_live_bytes() == 0 && !hr->is_young()) {
+    if (hr->used() > 0 && hr->max_live_bytes() == 0 && !hr->is_young() &&
+        !hr->has_pinned_objects()) {
       _freed_bytes += hr->used();
       hr->set_containing_set(NULL);
       if (hr->isHumongous()) {
@@ -1886,6 +2111,7 @@ public:
         _g1->free_region(hr, _local_cleanup_list, true);
       }
     } else {
+      _g1->g1_policy()->remset_tracker()->update_after_rebuild(hr);
       hr->rem_set()->do_cleanup_work(_hrrs_cleanup_task);
     }
 
@@ -2167,7 +2393,13 @@ void ConcurrentMark::cleanup() {
 
   // Clean out dead classes and update Metaspace sizes.
   if (ClassUnloadingWithConcurrentMark) {
-    ClassLoaderDataGraph::purge();
+    if (ConcurrentClassLoaderDataPurge) {
+      // The concurrent mark thread deletes them after the pause.
+      assert(_unloaded_clds == NULL, "previous cycle did not purge");
+      _unloaded_clds = ClassLoaderDataGraph::detach_unloading();
+    } else {
+      ClassLoaderDataGraph::purge();
+    }
   }
   MetaspaceGC::compute_new_size();
 
@@ -2179,6 +2411,12 @@ void ConcurrentMark::cleanup() {
   g1h->trace_heap_after_concurrent_cycle();
 }
 
+void ConcurrentMark::purge_unloaded_class_loader_data() {
+  ClassLoaderData* list = _unloaded_clds;
+  _unloaded_clds = NULL;
+  ClassLoaderDataGraph::purge_detached(list);
+}
+
 void ConcurrentMark::completeCleanup() {
   if (has_aborted()) return;
 
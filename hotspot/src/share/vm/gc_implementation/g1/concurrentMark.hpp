@@ -32,6 +32,7 @@
 #include "gc_implementation/shared/gcId.hpp"
 #include "utilities/taskqueue.hpp"
 
+class ClassLoaderData;
 class G1CollectedHeap;
 class CMBitMap;
 class CMTask;
@@ -402,6 +403,11 @@ protected:
 
   FreeRegionList        _cleanup_list;
 
+  // Class loader data unloaded by this cycle, taken off the unloading
+  // list in the cleanup pause and deleted concurrently afterwards
+  // (ConcurrentClassLoaderDataPurge).
+  ClassLoaderData*      _unloaded_clds;
+
   // Concurrent marking support structures
   CMBitMap                _markBitMap1;
   CMBitMap                _markBitMap2;
@@ -478,6 +484,10 @@ protected:
 
   FlexibleWorkGang* _parallel_workers;
 
+  // The number of old regions whose remembered set was selected for
+  // rebuild at the last remark.
+  uint _num_regions_selected_for_rebuild;
+
   ForceOverflowSettings _force_overflow_conc;
   ForceOverflowSettings _force_overflow_stw;
 
@@ -770,9 +780,17 @@ public:
 
   void checkpointRootsFinal(bool clear_all_soft_refs);
   void checkpointRootsFinalWork();
+
+  // Rebuild the remembered sets of the regions selected at remark by
+  // scanning the live objects of all old and humongous regions.
+  void rebuild_rem_set_concurrently();
+
   void cleanup();
   void completeCleanup();
 
+  // Delete the class loader data detached in the cleanup pause, if any.
+  void purge_unloaded_class_loader_data();
+
   // Mark in the previous bitmap.  NB: this is usually read-only, so use
   // this carefully!
   inline void markPrev(oop p);
@@ -28,6 +28,7 @@
 #include "gc_implementation/g1/g1CollectorPolicy.hpp"
 #include "gc_implementation/g1/g1Log.hpp"
 #include "gc_implementation/g1/g1MMUTracker.hpp"
+#include "gc_implementation/g1/g1PeriodicGC.hpp"
 #include "gc_implementation/g1/vm_operations_g1.hpp"
 #include "gc_implementation/shared/gcTrace.hpp"
 #include "memory/resourceArea.hpp"
@@ -76,6 +77,18 @@ public:
   }
 };
 
+class CMShrinkHeapClosure: public VoidClosure {
+  G1CollectedHeap* _g1h;
+public:
+
+  CMShrinkHeapClosure(G1CollectedHeap* g1h) :
+    _g1h(g1h) {}
+
+  void do_void(){
+    _g1h->shrink_after_concurrent_cycle();
+  }
+};
+
 
 
 void ConcurrentMarkThread::run() {
@@ -171,6 +184,23 @@ void ConcurrentMarkThread::run() {
         }
       } while (cm()->restart_for_overflow());
 
+      if (!cm()->has_aborted() && G1RebuildRemSetsConcurrently) {
+        double rebuild_start_sec = os::elapsedTime();
+        if (G1Log::fine()) {
+          gclog_or_tty->gclog_stamp(cm()->concurrent_gc_id());
+          gclog_or_tty->print_cr("[GC concurrent-rebuild-remembered-sets-start]");
+        }
+
+        _cm->rebuild_rem_set_concurrently();
+
+        double rebuild_end_sec = os::elapsedTime();
+        if (G1Log::fine()) {
+          gclog_or_tty->gclog_stamp(cm()->concurrent_gc_id());
+          gclog_or_tty->print_cr("[GC concurrent-rebuild-remembered-sets-end, %1.7lf secs]",
+                                 rebuild_end_sec - rebuild_start_sec);
+        }
+      }
+
       double end_time = os::elapsedVTime();
       // Update the total virtual time before doing this, since it will try
       // to measure it to get the vtime for this marking.  We purposely
@@ -236,6 +266,10 @@ void ConcurrentMarkThread::run() {
       guarantee(cm()->cleanup_list_is_empty(),
                 "at this point there should be no regions on the cleanup list");
 
+      // Delete the class loader data unloaded by this cycle. This needs
+      // no synchronization with pauses, nothing can reach it any more.
+      cm()->purge_unloaded_class_loader_data();
+
       // There is a tricky race before recording that the concurrent
       // cleanup has completed and a potential Full GC starting around
       // the same time. We want to make sure that the Full GC calls
@@ -278,12 +312,21 @@ void ConcurrentMarkThread::run() {
       // suspended by a collection pause.
       // We may have aborted just before the remark. Do not bother clearing the
       // bitmap then, as it has been done during mark abort.
+      // The clearing workers join the suspendible thread set themselves.
       if (!cm()->has_aborted()) {
-        SuspendibleThreadSetJoiner sts;
         _cm->clearNextBitmap();
       } else {
         assert(!G1VerifyBitmaps || _cm->nextMarkBitmapIsClear(), "Next mark bitmap must be clear");
       }
+
+      // With periodic collections enabled give the regions that are
+      // now free back to the operating system. This has to wait until
+      // the next bitmap is cleared as it uncommits that too.
+      if (G1PeriodicGCInterval > 0 && !cm()->has_aborted()) {
+        CMShrinkHeapClosure shrink_cl(g1h);
+        VM_CGC_Operation op(&shrink_cl, "GC uncommit", false /* needs_pll */);
+        VMThread::execute(&op);
+      }
     }
 
     // Update the number of full collections that have been
@@ -327,7 +370,18 @@ void ConcurrentMarkThread::sleepBeforeNextCycle() {
 
   MutexLockerEx x(CGC_lock, Mutex::_no_safepoint_check_flag);
   while (!started() && !_should_terminate) {
-    CGC_lock->wait(Mutex::_no_safepoint_check_flag);
+    if (G1PeriodicGCInterval == 0) {
+      CGC_lock->wait(Mutex::_no_safepoint_check_flag);
+    } else {
+      // Wake up in time to check whether the heap has been idle for
+      // long enough to request a periodic collection.
+      bool timed_out = CGC_lock->wait(Mutex::_no_safepoint_check_flag,
+                                      G1PeriodicGC::wait_time_ms());
+      if (timed_out && !started() && !_should_terminate) {
+        MutexUnlockerEx ul(CGC_lock, Mutex::_no_safepoint_check_flag);
+        G1PeriodicGC::check_for_periodic_gc();
+      }
+    }
   }
 
   if (started()) {
@@ -243,7 +243,7 @@ G1AllocRegion::G1AllocRegion(const char* name,
 
 HeapRegion* MutatorAllocRegion::allocate_new_region(size_t word_size,
                                                     bool force) {
-  return _g1h->new_mutator_alloc_region(word_size, force);
+  return _g1h->new_mutator_alloc_region(word_size, force, _node_index);
 }
 
 void MutatorAllocRegion::retire_region(HeapRegion* alloc_region,
@@ -254,7 +254,10 @@ void MutatorAllocRegion::retire_region(HeapRegion* alloc_region,
 HeapRegion* SurvivorGCAllocRegion::allocate_new_region(size_t word_size,
                                                        bool force) {
   assert(!force, "not supported for GC alloc regions");
-  return _g1h->new_gc_alloc_region(word_size, count(), InCSetState::Young);
+  // With NUMA there is one survivor alloc region per node, so the limit on
+  // the number of survivor regions applies to all of them together.
+  uint count = _g1h->allocator()->survivor_gc_alloc_regions_count(allocation_context());
+  return _g1h->new_gc_alloc_region(word_size, count, InCSetState::Young, _node_index);
 }
 
 void SurvivorGCAllocRegion::retire_region(HeapRegion* alloc_region,
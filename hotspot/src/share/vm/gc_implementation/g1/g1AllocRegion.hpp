@@ -193,21 +193,33 @@ public:
 };
 
 class MutatorAllocRegion : public G1AllocRegion {
+private:
+  // The NUMA node new regions for this alloc region are preferably taken from.
+  const uint _node_index;
 protected:
   virtual HeapRegion* allocate_new_region(size_t word_size, bool force);
   virtual void retire_region(HeapRegion* alloc_region, size_t allocated_bytes);
 public:
-  MutatorAllocRegion()
-    : G1AllocRegion("Mutator Alloc Region", false /* bot_updates */) { }
+  MutatorAllocRegion(uint node_index = 0)
+    : G1AllocRegion("Mutator Alloc Region", false /* bot_updates */),
+      _node_index(node_index) { }
+
+  uint node_index() const { return _node_index; }
 };
 
 class SurvivorGCAllocRegion : public G1AllocRegion {
+private:
+  // The NUMA node new regions for this alloc region are preferably taken from.
+  const uint _node_index;
 protected:
   virtual HeapRegion* allocate_new_region(size_t word_size, bool force);
   virtual void retire_region(HeapRegion* alloc_region, size_t allocated_bytes);
 public:
-  SurvivorGCAllocRegion()
-  : G1AllocRegion("Survivor GC Alloc Region", false /* bot_updates */) { }
+  SurvivorGCAllocRegion(uint node_index = 0)
+  : G1AllocRegion("Survivor GC Alloc Region", false /* bot_updates */),
+    _node_index(node_index) { }
+
+  uint node_index() const { return _node_index; }
 };
 
 class OldGCAllocRegion : public G1AllocRegion {
@@ -28,6 +28,7 @@
 #include "gc_implementation/g1/g1AllocationContext.hpp"
 #include "gc_implementation/g1/g1AllocRegion.hpp"
 #include "gc_implementation/g1/g1InCSetState.hpp"
+#include "gc_implementation/g1/g1NUMA.hpp"
 #include "gc_implementation/shared/parGCAllocBuffer.hpp"
 
 // Base class for G1 allocators.
@@ -53,8 +54,11 @@ public:
    virtual void release_gc_alloc_regions(uint no_of_gc_workers, EvacuationInfo& evacuation_info) = 0;
    virtual void abandon_gc_alloc_regions() = 0;
 
+   // Returns the mutator alloc region for the NUMA node of the current thread.
    virtual MutatorAllocRegion*    mutator_alloc_region(AllocationContext_t context) = 0;
-   virtual SurvivorGCAllocRegion* survivor_gc_alloc_region(AllocationContext_t context) = 0;
+   virtual SurvivorGCAllocRegion* survivor_gc_alloc_region(AllocationContext_t context, uint node_index) = 0;
+   // The number of regions used by all survivor GC alloc regions in this GC.
+   virtual uint                   survivor_gc_alloc_regions_count(AllocationContext_t context) = 0;
    virtual OldGCAllocRegion*      old_gc_alloc_region(AllocationContext_t context) = 0;
    virtual size_t                 used() = 0;
    virtual bool                   is_retained_old_region(HeapRegion* hr) = 0;
@@ -92,12 +96,17 @@ public:
 // The default allocator for G1.
 class G1DefaultAllocator : public G1Allocator {
 protected:
-  // Alloc region used to satisfy mutator allocation requests.
-  MutatorAllocRegion _mutator_alloc_region;
+  G1NUMA* _numa;
 
-  // Alloc region used to satisfy allocation requests by the GC for
+  // The number of mutator and survivor alloc regions, one per active NUMA node.
+  uint _num_alloc_regions;
+
+  // Alloc regions used to satisfy mutator allocation requests.
+  MutatorAllocRegion* _mutator_alloc_regions;
+
+  // Alloc regions used to satisfy allocation requests by the GC for
   // survivor objects.
-  SurvivorGCAllocRegion _survivor_gc_alloc_region;
+  SurvivorGCAllocRegion* _survivor_gc_alloc_regions;
 
   // Alloc region used to satisfy allocation requests by the GC for
   // old objects.
@@ -105,7 +114,8 @@ protected:
 
   HeapRegion* _retained_old_gc_alloc_region;
 public:
-  G1DefaultAllocator(G1CollectedHeap* heap) : G1Allocator(heap), _retained_old_gc_alloc_region(NULL) { }
+  G1DefaultAllocator(G1CollectedHeap* heap);
+  ~G1DefaultAllocator();
 
   virtual void init_mutator_alloc_region();
   virtual void release_mutator_alloc_region();
@@ -119,11 +129,24 @@ public:
   }
 
   virtual MutatorAllocRegion* mutator_alloc_region(AllocationContext_t context) {
-    return &_mutator_alloc_region;
+    uint node_index = _numa->index_of_current_thread();
+    assert(node_index < _num_alloc_regions,
+           err_msg("Invalid node index %u", node_index));
+    return &_mutator_alloc_regions[node_index];
+  }
+
+  virtual SurvivorGCAllocRegion* survivor_gc_alloc_region(AllocationContext_t context, uint node_index) {
+    assert(node_index < _num_alloc_regions,
+           err_msg("Invalid node index %u", node_index));
+    return &_survivor_gc_alloc_regions[node_index];
   }
 
-  virtual SurvivorGCAllocRegion* survivor_gc_alloc_region(AllocationContext_t context) {
-    return &_survivor_gc_alloc_region;
+  virtual uint survivor_gc_alloc_regions_count(AllocationContext_t context) {
+    uint count = 0;
+    for (uint i = 0; i < _num_alloc_regions; i++) {
+      count += _survivor_gc_alloc_regions[i].count();
+    }
+    return count;
   }
 
   virtual OldGCAllocRegion* old_gc_alloc_region(AllocationContext_t context) {
@@ -135,10 +158,12 @@ public:
            "Should be owned on this thread's behalf.");
     size_t result = _summary_bytes_used;
 
-    // Read only once in case it is set to NULL concurrently
-    HeapRegion* hr = mutator_alloc_region(AllocationContext::current())->get();
-    if (hr != NULL) {
-      result += hr->used();
+    for (uint i = 0; i < _num_alloc_regions; i++) {
+      // Read only once in case it is set to NULL concurrently
+      HeapRegion* hr = _mutator_alloc_regions[i].get();
+      if (hr != NULL) {
+        result += hr->used();
+      }
     }
     return result;
   }
@@ -183,9 +208,18 @@ protected:
   size_t _alloc_buffer_waste;
   size_t _undo_waste;
 
+  // Per-worker PLAB sizing, indexed by destination state.
+  PLABWorkerStats _plab_worker_stats[InCSetState::Num];
+
+  // The NUMA node of the GC worker owning this allocator. Survivors
+  // are preferably copied to regions on that node.
+  const uint _node_index;
+
   void add_to_alloc_buffer_waste(size_t waste) { _alloc_buffer_waste += waste; }
   void add_to_undo_waste(size_t waste)         { _undo_waste += waste; }
 
+  void initialize_plab_worker_stats();
+
   virtual void retire_alloc_buffers() = 0;
   virtual G1ParGCAllocBuffer* alloc_buffer(InCSetState dest, AllocationContext_t context) = 0;
 
@@ -206,7 +240,9 @@ protected:
 public:
   G1ParGCAllocator(G1CollectedHeap* g1h) :
     _g1h(g1h), _survivor_alignment_bytes(calc_survivor_alignment_bytes()),
-    _alloc_buffer_waste(0), _undo_waste(0) {
+    _alloc_buffer_waste(0), _undo_waste(0),
+    _node_index(G1NUMA::numa()->index_of_current_thread()) {
+    initialize_plab_worker_stats();
   }
 
   static G1ParGCAllocator* create_allocator(G1CollectedHeap* g1h);
@@ -214,6 +250,9 @@ public:
   size_t alloc_buffer_waste() { return _alloc_buffer_waste; }
   size_t undo_waste() {return _undo_waste; }
 
+  // Print and trace the PLAB statistics of the owning worker.
+  void report_plab_worker_stats(uint worker_id) const;
+
   // Allocate word_sz words in dest, either directly into the regions or by
   // allocating a new PLAB. Returns the address of the allocated memory, NULL if
   // not successful.
@@ -51,7 +51,8 @@ void G1CardCounts::clear_range(size_t from_card_num, size_t to_card_num) {
 }
 
 G1CardCounts::G1CardCounts(G1CollectedHeap *g1h):
-  _listener(), _g1h(g1h), _card_counts(NULL), _reserved_max_card_num(0) {
+  _listener(), _g1h(g1h), _epoch(0), _pauses_in_epoch(0),
+  _card_counts(NULL), _reserved_max_card_num(0) {
   _listener.set_cardcounts(this);
 }
 
@@ -64,6 +65,7 @@ void G1CardCounts::initialize(G1RegionToSpaceMapper* mapper) {
     // max_jubyte. Guarantee the value of the hot
     // threshold limit is no more than this.
     guarantee(G1ConcRSHotCardLimit <= max_jubyte, "sanity");
+    guarantee(G1ConcRSHotCardAgingInterval == 0 || G1ConcRSHotCardLimit <= max_aged_count, "sanity");
 
     _ct_bs = _g1h->g1_barrier_set();
     _ct_bot = _ct_bs->byte_for_const(_g1h->reserved_region().start());
@@ -89,6 +91,9 @@ uint G1CardCounts::add_card_count(jbyte* card_ptr) {
     assert(card_num < _reserved_max_card_num,
            err_msg("Card " SIZE_FORMAT " outside of card counts table (max size " SIZE_FORMAT ")",
                    card_num, _reserved_max_card_num));
+    if (G1ConcRSHotCardAgingInterval > 0) {
+      return add_aged_card_count(card_num);
+    }
     count = (uint) _card_counts[card_num];
     if (count < G1ConcRSHotCardLimit) {
       _card_counts[card_num] =
@@ -98,6 +103,30 @@ uint G1CardCounts::add_card_count(jbyte* card_ptr) {
   return count;
 }
 
+uint G1CardCounts::add_aged_card_count(size_t card_num) {
+  // Like the plain counts, racing updates may get lost
+  jubyte value = _card_counts[card_num];
+  uint count = value & count_mask;
+  uint epoch = _epoch;
+  uint epochs_passed = (epoch - (value >> epoch_shift)) & epoch_mask;
+  // Epochs wrap around; a count last updated that long ago would have
+  // been halved to almost nothing anyway.
+  count >>= epochs_passed;
+  uint new_count = (uint)MIN2((uintx)(count + 1), G1ConcRSHotCardLimit);
+  if (new_count != count || epochs_passed > 0) {
+    _card_counts[card_num] = (jubyte)((epoch << epoch_shift) | new_count);
+  }
+  return count;
+}
+
+void G1CardCounts::note_pause() {
+  assert(SafepointSynchronize::is_at_safepoint(), "don't call this otherwise");
+  if (G1ConcRSHotCardAgingInterval > 0 && ++_pauses_in_epoch >= G1ConcRSHotCardAgingInterval) {
+    _pauses_in_epoch = 0;
+    _epoch = (_epoch + 1) & epoch_mask;
+  }
+}
+
 bool G1CardCounts::is_hot(uint count) {
   return (count >= G1ConcRSHotCardLimit);
 }
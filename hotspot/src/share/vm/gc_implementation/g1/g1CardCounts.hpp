@@ -51,12 +51,34 @@ class G1CardCountsMappingChangedListener : public G1MappingChangedListener {
 // card into the hot card cache. The card will then be refined when
 // it is evicted from the hot card cache, or when the hot card cache
 // is 'drained' during the next evacuation pause.
+//
+// The counts are kept across evacuation pauses. With
+// G1ConcRSHotCardAgingInterval they age instead of staying hot forever:
+// every that many pauses a new epoch starts, and a count is halved for
+// each epoch that started since it was last updated. Each count carries
+// the epoch in its top bits, so the aging happens lazily when the card
+// is refined again rather than in a pass over the whole table.
 
 class G1CardCounts: public CHeapObj<mtGC> {
   G1CardCountsMappingChangedListener _listener;
 
   G1CollectedHeap* _g1h;
 
+ public:
+  enum {
+    epoch_bits  = 2,
+    epoch_shift = BitsPerByte - epoch_bits,
+    epoch_mask  = right_n_bits(epoch_bits),
+    count_mask  = right_n_bits(epoch_shift),
+    // The highest G1ConcRSHotCardLimit with aging
+    max_aged_count = count_mask
+  };
+
+ private:
+  // The current epoch, and the pauses since it started
+  uint _epoch;
+  uint _pauses_in_epoch;
+
   // The table of counts
   jubyte* _card_counts;
 
@@ -98,6 +120,9 @@ class G1CardCounts: public CHeapObj<mtGC> {
   // Clear the counts table for the given (exclusive) index range.
   void clear_range(size_t from_card_num, size_t to_card_num);
 
+  // add_card_count() with aging
+  uint add_aged_card_count(size_t card_num);
+
  public:
   G1CardCounts(G1CollectedHeap* g1h);
 
@@ -119,6 +144,10 @@ class G1CardCounts: public CHeapObj<mtGC> {
 
   // Clear the entire card counts table during GC.
   void clear_all();
+
+  // Called at the end of every evacuation pause; starts a new epoch
+  // every G1ConcRSHotCardAgingInterval pauses.
+  void note_pause();
 };
 
 #endif // SHARE_VM_GC_IMPLEMENTATION_G1_G1CARDCOUNTS_HPP
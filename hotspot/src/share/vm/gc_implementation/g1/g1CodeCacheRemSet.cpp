@@ -66,6 +66,7 @@ class CodeRootSetTable : public Hashtable<nmethod*, mtGC> {
 
   void copy_to(CodeRootSetTable* new_table);
   void nmethods_do(CodeBlobClosure* blk);
+  void nmethods_do(CodeBlobClosure* blk, int from, int to);
 
   template<typename CB>
   int remove_if(CB& should_remove);
@@ -169,7 +170,12 @@ void CodeRootSetTable::copy_to(CodeRootSetTable* new_table) {
 }
 
 void CodeRootSetTable::nmethods_do(CodeBlobClosure* blk) {
-  for (int index = 0; index < table_size(); ++index) {
+  nmethods_do(blk, 0, table_size());
+}
+
+void CodeRootSetTable::nmethods_do(CodeBlobClosure* blk, int from, int to) {
+  assert(0 <= from && to <= table_size(), "bucket range out of bounds");
+  for (int index = from; index < to; ++index) {
     for (Entry* e = bucket(index); e != NULL; e = e->next()) {
       blk->do_code_blob(e->literal());
     }
@@ -303,6 +309,16 @@ void G1CodeRootSet::nmethods_do(CodeBlobClosure* blk) const {
   }
 }
 
+int G1CodeRootSet::table_size() const {
+  return _table != NULL ? _table->table_size() : 0;
+}
+
+void G1CodeRootSet::nmethods_do(CodeBlobClosure* blk, int from, int to) const {
+  if (_table != NULL) {
+    _table->nmethods_do(blk, from, MIN2(to, _table->table_size()));
+  }
+}
+
 class CleanCallback : public StackObj {
   class PointsIntoHRDetectionClosure : public OopClosure {
     HeapRegion* _hr;
@@ -69,6 +69,11 @@ class G1CodeRootSet VALUE_OBJ_CLASS_SPEC {
 
   void nmethods_do(CodeBlobClosure* blk) const;
 
+  // Number of buckets, and iteration over the buckets in [from, to), so
+  // that several threads can share the iteration over one set.
+  int table_size() const;
+  void nmethods_do(CodeBlobClosure* blk, int from, int to) const;
+
   // Remove all nmethods which no longer contain pointers into our "owner" region
   void clean(HeapRegion* owner);
 
@@ -42,7 +42,9 @@
 #include "gc_implementation/g1/g1GCPhaseTimes.hpp"
 #include "gc_implementation/g1/g1Log.hpp"
 #include "gc_implementation/g1/g1MarkSweep.hpp"
+#include "gc_implementation/g1/g1ParMarkSweep.hpp"
 #include "gc_implementation/g1/g1OopClosures.inline.hpp"
+#include "gc_implementation/g1/g1OptionalCSetRefs.hpp"
 #include "gc_implementation/g1/g1ParScanThreadState.inline.hpp"
 #include "gc_implementation/g1/g1RegionToSpaceMapper.hpp"
 #include "gc_implementation/g1/g1RemSet.inline.hpp"
@@ -509,7 +511,7 @@ G1CollectedHeap* G1CollectedHeap::_g1h;
 // Private methods.
 
 HeapRegion*
-G1CollectedHeap::new_region_try_secondary_free_list(bool is_old) {
+G1CollectedHeap::new_region_try_secondary_free_list(bool is_old, uint node_index) {
   MutexLockerEx x(SecondaryFreeList_lock, Mutex::_no_safepoint_check_flag);
   while (!_secondary_free_list.is_empty() || free_regions_coming()) {
     if (!_secondary_free_list.is_empty()) {
@@ -525,7 +527,7 @@ G1CollectedHeap::new_region_try_secondary_free_list(bool is_old) {
 
       assert(_hrm.num_free_regions() > 0, "if the secondary_free_list was not "
              "empty we should have moved at least one entry to the free_list");
-      HeapRegion* res = _hrm.allocate_free_region(is_old);
+      HeapRegion* res = _hrm.allocate_free_region(is_old, node_index);
       if (G1ConcRegionFreeingVerbose) {
         gclog_or_tty->print_cr("G1ConcRegionFreeing [region alloc] : "
                                "allocated " HR_FORMAT " from secondary_free_list",
@@ -547,7 +549,7 @@ G1CollectedHeap::new_region_try_secondary_free_list(bool is_old) {
   return NULL;
 }
 
-HeapRegion* G1CollectedHeap::new_region(size_t word_size, bool is_old, bool do_expand) {
+HeapRegion* G1CollectedHeap::new_region(size_t word_size, bool is_old, bool do_expand, uint node_index) {
   assert(!isHumongous(word_size) || word_size <= HeapRegion::GrainWords,
          "the only time we use this to allocate a humongous region is "
          "when we are allocating a single humongous region");
@@ -559,21 +561,21 @@ HeapRegion* G1CollectedHeap::new_region(size_t word_size, bool is_old, bool do_e
         gclog_or_tty->print_cr("G1ConcRegionFreeing [region alloc] : "
                                "forced to look at the secondary_free_list");
       }
-      res = new_region_try_secondary_free_list(is_old);
+      res = new_region_try_secondary_free_list(is_old, node_index);
       if (res != NULL) {
         return res;
       }
     }
   }
 
-  res = _hrm.allocate_free_region(is_old);
+  res = _hrm.allocate_free_region(is_old, node_index);
 
   if (res == NULL) {
     if (G1ConcRegionFreeingVerbose) {
       gclog_or_tty->print_cr("G1ConcRegionFreeing [region alloc] : "
                              "res == NULL, trying the secondary_free_list");
     }
-    res = new_region_try_secondary_free_list(is_old);
+    res = new_region_try_secondary_free_list(is_old, node_index);
   }
   if (res == NULL && do_expand && _expand_heap_after_alloc_failure) {
     // Currently, only attempts to allocate GC alloc regions set
@@ -592,7 +594,7 @@ HeapRegion* G1CollectedHeap::new_region(size_t word_size, bool is_old, bool do_e
       // always expand the heap by an amount aligned to the heap
       // region size, the free list should in theory not be empty.
       // In either case allocate_free_region() will check for NULL.
-      res = _hrm.allocate_free_region(is_old);
+      res = _hrm.allocate_free_region(is_old, node_index);
     } else {
       _expand_heap_after_alloc_failure = false;
     }
@@ -913,22 +915,25 @@ HeapWord* G1CollectedHeap::attempt_allocation_slow(size_t word_size,
 
     {
       MutexLockerEx x(Heap_lock);
-      result = _allocator->mutator_alloc_region(context)->attempt_allocation_locked(word_size,
-                                                                                    false /* bot_updates */);
+      // Look up the alloc region once: the thread may move to another
+      // NUMA node between calls, but must keep using the same region here.
+      MutatorAllocRegion* alloc_region = _allocator->mutator_alloc_region(context);
+      result = alloc_region->attempt_allocation_locked(word_size,
+                                                       false /* bot_updates */);
       if (result != NULL) {
         return result;
       }
 
       // If we reach here, attempt_allocation_locked() above failed to
       // allocate a new region. So the mutator alloc region should be NULL.
-      assert(_allocator->mutator_alloc_region(context)->get() == NULL, "only way to get here");
+      assert(alloc_region->get() == NULL, "only way to get here");
 
       if (GC_locker::is_active_and_needs_gc()) {
         if (g1_policy()->can_expand_young_list()) {
           // No need for an ergo verbose message here,
           // can_expand_young_list() does this when it returns true.
-          result = _allocator->mutator_alloc_region(context)->attempt_allocation_force(word_size,
-                                                                                       false /* bot_updates */);
+          result = alloc_region->attempt_allocation_force(word_size,
+                                                          false /* bot_updates */);
           if (result != NULL) {
             return result;
           }
@@ -1165,6 +1170,9 @@ public:
 
     _g1h->reset_gc_time_stamps(r);
     hrrs->clear();
+    // Any remembered set rebuild in progress has been aborted.
+    r->set_top_at_rebuild_start(NULL);
+    _g1h->g1_policy()->remset_tracker()->update_after_full_gc(r);
     // You might think here that we could clear just the cards
     // corresponding to the used region.  But no: if we leave a dirty card
     // in a region we might allocate into, then it would prevent that card
@@ -1359,8 +1367,11 @@ bool G1CollectedHeap::do_collection(bool explicit_gc,
       // G1CollectedHeap::ref_processing_init() about
       // how reference processing currently works in G1.
 
-      // Temporarily make discovery by the STW ref processor single threaded (non-MT).
-      ReferenceProcessorMTDiscoveryMutator stw_rp_disc_ser(ref_processor_stw(), false);
+      // The parallel full GC discovers references on its worker threads;
+      // otherwise temporarily make discovery by the STW ref processor
+      // single threaded (non-MT).
+      bool use_par_mark_sweep = G1ParMarkSweep::should_be_used();
+      ReferenceProcessorMTDiscoveryMutator stw_rp_disc_ser(ref_processor_stw(), use_par_mark_sweep);
 
       // Temporarily clear the STW ref processor's _is_alive_non_header field.
       ReferenceProcessorIsAliveMutator stw_rp_is_alive_null(ref_processor_stw(), NULL);
@@ -1371,7 +1382,11 @@ bool G1CollectedHeap::do_collection(bool explicit_gc,
       // Do collection work
       {
         HandleMark hm;  // Discard invalid handles created during gc
-        G1MarkSweep::invoke_at_safepoint(ref_processor_stw(), do_clear_all_soft_refs);
+        if (use_par_mark_sweep) {
+          G1ParMarkSweep::invoke_at_safepoint(ref_processor_stw(), do_clear_all_soft_refs);
+        } else {
+          G1MarkSweep::invoke_at_safepoint(ref_processor_stw(), do_clear_all_soft_refs);
+        }
       }
 
       assert(num_free_regions() == 0, "we should not have added any free regions");
@@ -1556,16 +1571,9 @@ void G1CollectedHeap::do_full_collection(bool clear_all_soft_refs) {
                              0                    /* word_size */);
 }
 
-// This code is mostly copied from TenuredGeneration.
-void
-G1CollectedHeap::
-resize_if_necessary_after_full_collection(size_t word_size) {
-  // Include the current allocation, if any, and bytes that will be
-  // pre-allocated to support collections, as "used".
-  const size_t used_after_gc = used();
-  const size_t capacity_after_gc = capacity();
-  const size_t free_after_gc = capacity_after_gc - used_after_gc;
-
+void G1CollectedHeap::desired_capacity_bounds(size_t used_bytes,
+                                              size_t* minimum_desired_capacity,
+                                              size_t* maximum_desired_capacity) {
   // This is enforced in arguments.cpp.
   assert(MinHeapFreeRatio <= MaxHeapFreeRatio,
          "otherwise the code below doesn't make sense");
@@ -1581,9 +1589,9 @@ resize_if_necessary_after_full_collection(size_t word_size) {
 
   // We have to be careful here as these two calculations can overflow
   // 32-bit size_t's.
-  double used_after_gc_d = (double) used_after_gc;
-  double minimum_desired_capacity_d = used_after_gc_d / maximum_used_percentage;
-  double maximum_desired_capacity_d = used_after_gc_d / minimum_used_percentage;
+  double used_d = (double) used_bytes;
+  double minimum_desired_capacity_d = used_d / maximum_used_percentage;
+  double maximum_desired_capacity_d = used_d / minimum_used_percentage;
 
   // Let's make sure that they are both under the max heap size, which
   // by default will make them fit into a size_t.
@@ -1594,24 +1602,41 @@ resize_if_necessary_after_full_collection(size_t word_size) {
                                     desired_capacity_upper_bound);
 
   // We can now safely turn them into size_t's.
-  size_t minimum_desired_capacity = (size_t) minimum_desired_capacity_d;
-  size_t maximum_desired_capacity = (size_t) maximum_desired_capacity_d;
+  size_t minimum_desired = (size_t) minimum_desired_capacity_d;
+  size_t maximum_desired = (size_t) maximum_desired_capacity_d;
 
   // This assert only makes sense here, before we adjust them
   // with respect to the min and max heap size.
-  assert(minimum_desired_capacity <= maximum_desired_capacity,
+  assert(minimum_desired <= maximum_desired,
          err_msg("minimum_desired_capacity = " SIZE_FORMAT ", "
                  "maximum_desired_capacity = " SIZE_FORMAT,
-                 minimum_desired_capacity, maximum_desired_capacity));
+                 minimum_desired, maximum_desired));
 
   // Should not be greater than the heap max size. No need to adjust
   // it with respect to the heap min size as it's a lower bound (i.e.,
   // we'll try to make the capacity larger than it, not smaller).
-  minimum_desired_capacity = MIN2(minimum_desired_capacity, max_heap_size);
+  *minimum_desired_capacity = MIN2(minimum_desired, max_heap_size);
   // Should not be less than the heap min size. No need to adjust it
   // with respect to the heap max size as it's an upper bound (i.e.,
   // we'll try to make the capacity smaller than it, not greater).
-  maximum_desired_capacity =  MAX2(maximum_desired_capacity, min_heap_size);
+  *maximum_desired_capacity =  MAX2(maximum_desired, min_heap_size);
+}
+
+// This code is mostly copied from TenuredGeneration.
+void
+G1CollectedHeap::
+resize_if_necessary_after_full_collection(size_t word_size) {
+  // Include the current allocation, if any, and bytes that will be
+  // pre-allocated to support collections, as "used".
+  const size_t used_after_gc = used();
+  const size_t capacity_after_gc = capacity();
+  const size_t free_after_gc = capacity_after_gc - used_after_gc;
+
+  size_t minimum_desired_capacity;
+  size_t maximum_desired_capacity;
+  desired_capacity_bounds(used_after_gc,
+                          &minimum_desired_capacity,
+                          &maximum_desired_capacity);
 
   if (capacity_after_gc < minimum_desired_capacity) {
     // Don't expand unless it's significant
@@ -1811,12 +1836,54 @@ void G1CollectedHeap::shrink_helper(size_t shrink_bytes) {
   }
 }
 
+void G1CollectedHeap::shrink_after_concurrent_cycle() {
+  assert_at_safepoint(true /* should_be_vm_thread */);
+  assert(!free_regions_coming(), "cleanup must have completed");
+
+  // The regions reclaimed by the cleanup pause may still be on the
+  // secondary free list. Move them to the master free list so that
+  // they can be uncommitted too.
+  append_secondary_free_list_if_not_empty_with_lock();
+
+  const size_t used_after_cycle = used();
+  const size_t capacity_after_cycle = capacity();
+
+  size_t minimum_desired_capacity;
+  size_t maximum_desired_capacity;
+  desired_capacity_bounds(used_after_cycle,
+                          &minimum_desired_capacity,
+                          &maximum_desired_capacity);
+
+  if (capacity_after_cycle <= maximum_desired_capacity) {
+    return;
+  }
+
+  size_t shrink_bytes = capacity_after_cycle - maximum_desired_capacity;
+  ergo_verbose4(ErgoHeapSizing,
+                "attempt heap shrinking",
+                ergo_format_reason("capacity higher than "
+                                   "max desired capacity after concurrent cycle")
+                ergo_format_byte("capacity")
+                ergo_format_byte("occupancy")
+                ergo_format_byte_perc("max desired capacity"),
+                capacity_after_cycle, used_after_cycle,
+                maximum_desired_capacity, (double) MaxHeapFreeRatio);
+
+  // Unlike at the end of a Full GC the mutator alloc regions are still
+  // active here. Retire them first so that shrink() does not mistake an
+  // empty one for a free region.
+  _allocator->release_mutator_alloc_region();
+  shrink(shrink_bytes);
+  _allocator->init_mutator_alloc_region();
+}
+
 void G1CollectedHeap::shrink(size_t shrink_bytes) {
   verify_region_sets_optional();
 
-  // We should only reach here at the end of a Full GC which means we
-  // should not not be holding to any GC alloc regions. The method
-  // below will make sure of that and do any remaining clean up.
+  // We should only reach here at the end of a Full GC or of a
+  // concurrent cycle which means we should not not be holding to any
+  // GC alloc regions. The method below will make sure of that and do
+  // any remaining clean up.
   _allocator->abandon_gc_alloc_regions();
 
   // Instead of tearing down / rebuilding the free lists here, we
@@ -1873,6 +1940,7 @@ G1CollectedHeap::G1CollectedHeap(G1CollectorPolicy* policy_) :
   _dirty_cards_region_list(NULL),
   _worker_cset_start_region(NULL),
   _worker_cset_start_region_time_stamp(NULL),
+  _optional_cset_refs(NULL),
   _gc_timer_stw(new (ResourceObj::C_HEAP, mtGC) STWGCTimer()),
   _gc_timer_cm(new (ResourceObj::C_HEAP, mtGC) ConcurrentGCTimer()),
   _gc_tracer_stw(new (ResourceObj::C_HEAP, mtGC) G1NewTracer()),
@@ -1880,6 +1948,9 @@ G1CollectedHeap::G1CollectedHeap(G1CollectorPolicy* policy_) :
 
   _g1h = this;
 
+  // The NUMA information must be available before the allocator
+  // sets up its per-node alloc regions.
+  _numa = G1NUMA::create();
   _allocator = G1Allocator::create_allocator(_g1h);
   _humongous_object_threshold_in_words = HeapRegion::GrainWords / 2;
 
@@ -1892,15 +1963,21 @@ G1CollectedHeap::G1CollectedHeap(G1CollectorPolicy* policy_) :
   _worker_cset_start_region = NEW_C_HEAP_ARRAY(HeapRegion*, n_queues, mtGC);
   _worker_cset_start_region_time_stamp = NEW_C_HEAP_ARRAY(uint, n_queues, mtGC);
   _evacuation_failed_info_array = NEW_C_HEAP_ARRAY(EvacuationFailedInfo, n_queues, mtGC);
+  _objs_with_preserved_marks = NEW_C_HEAP_ARRAY(PreservedObjStack, n_queues, mtGC);
+  _preserved_marks_of_objs = NEW_C_HEAP_ARRAY(PreservedMarkStack, n_queues, mtGC);
 
   for (int i = 0; i < n_queues; i++) {
     RefToScanQueue* q = new RefToScanQueue();
     q->initialize();
     _task_queues->register_queue(i, q);
     ::new (&_evacuation_failed_info_array[i]) EvacuationFailedInfo();
+    ::new (&_objs_with_preserved_marks[i]) PreservedObjStack();
+    ::new (&_preserved_marks_of_objs[i]) PreservedMarkStack();
   }
   clear_cset_start_regions();
 
+  _optional_cset_refs = new G1OptionalCSetRefs((uint)n_queues);
+
   // Initialize the G1EvacuationFailureALot counters and flags.
   NOT_PRODUCT(reset_evacuation_should_fail();)
 
@@ -2006,6 +2083,9 @@ jint G1CollectedHeap::initialize() {
                                          1,
                                          mtJavaHeap);
   heap_storage->set_mapping_changed_listener(&_listener);
+  heap_storage->set_pretouch_workers(workers());
+  _numa->set_region_info(HeapRegion::GrainBytes,
+                         UseLargePages ? os::large_page_size() : os::vm_page_size());
 
   // Create storage for the BOT, card table, card counts table (hot card cache) and the bitmaps.
   G1RegionToSpaceMapper* bot_storage =
@@ -2335,6 +2415,7 @@ bool G1CollectedHeap::should_do_concurrent_full_gc(GCCause::Cause cause) {
     case GCCause::_g1_humongous_allocation: return true;
     case GCCause::_update_allocation_context_stats_inc: return true;
     case GCCause::_wb_conc_mark:            return true;
+    case GCCause::_g1_periodic_collection:  return G1PeriodicGCInvokesConcurrent;
     default:                                return false;
   }
 }
@@ -2612,6 +2693,16 @@ void G1CollectedHeap::object_iterate(ObjectClosure* cl) {
   heap_region_iterate(&blk);
 }
 
+void G1CollectedHeap::object_iterate_parallel(ObjectClosure* cl, uint worker_id, uint num_workers) {
+  IterateObjectClosureRegionClosure blk(cl);
+  heap_region_par_iterate_chunked(&blk, worker_id, num_workers,
+                                  HeapRegion::ParObjectIterateClaimValue);
+}
+
+void G1CollectedHeap::object_iterate_parallel_done() {
+  reset_heap_region_claim_values();
+}
+
 // Calls a SpaceClosure on a HeapRegion.
 
 class SpaceClosureRegionClosure: public HeapRegionClosure {
@@ -2860,7 +2951,7 @@ void G1CollectedHeap::collection_set_iterate_from(HeapRegion* r,
 
 HeapRegion* G1CollectedHeap::next_compaction_region(const HeapRegion* from) const {
   HeapRegion* result = _hrm.next_region_in_heap(from);
-  while (result != NULL && result->isHumongous()) {
+  while (result != NULL && (result->isHumongous() || result->has_pinned_objects())) {
     result = _hrm.next_region_in_heap(result);
   }
   return result;
@@ -3463,6 +3554,10 @@ void G1CollectedHeap::print_on(outputStream* st) const {
   st->print("%u survivors (" SIZE_FORMAT "K)", survivor_regions,
             (size_t) survivor_regions * HeapRegion::GrainBytes / K);
   st->cr();
+  if (_numa->is_enabled()) {
+    st->print("  ");
+    _numa->print_on(st);
+  }
   MetaspaceAux::print_on(st);
 }
 
@@ -3721,6 +3816,17 @@ class RegisterHumongousWithInCSetFastTestClosure : public HeapRegionClosure {
     return oop(region->bottom())->is_typeArray();
   }
 
+  // An object array may only be nominated if marking cannot need its
+  // references: either no marking is in progress, or the array was
+  // allocated after marking started and is thus implicitly live and never
+  // pushed on the mark stack.
+  bool is_objArray_candidate_region(G1CollectedHeap* heap, HeapRegion* region) const {
+    return G1EagerReclaimHumongousObjectArrays &&
+           oop(region->bottom())->is_objArray() &&
+           (!heap->mark_in_progress() ||
+            region->next_top_at_mark_start() == region->bottom());
+  }
+
   bool humongous_region_is_candidate(G1CollectedHeap* heap, HeapRegion* region) const {
     assert(region->startsHumongous(), "Must start a humongous object");
 
@@ -3745,10 +3851,11 @@ class RegisterHumongousWithInCSetFastTestClosure : public HeapRegionClosure {
     // structures don't support efficiently performing the needed
     // additional tests or scrubbing of the mark stack.
     //
-    // However, we presently only nominate is_typeArray() objects.
+    // Object arrays are nominated under exactly these constraints.
     // A humongous object containing references induces remembered
-    // set entries on other regions.  In order to reclaim such an
-    // object, those remembered sets would need to be cleaned up.
+    // set entries on other regions. Those entries are not removed when
+    // the object is reclaimed; remembered set scanning tolerates stale
+    // cards (see G1FreeHumongousRegionClosure).
     //
     // We also treat is_typeArray() objects specially, allowing them
     // to be reclaimed even if allocated before the start of
@@ -3760,7 +3867,10 @@ class RegisterHumongousWithInCSetFastTestClosure : public HeapRegionClosure {
     // important use case for eager reclaim, and this special handling
     // may reduce needed headroom.
 
-    return is_typeArray_region(region) && is_remset_small(region);
+    // A pinned object is in use by a JNI critical section.
+    return (is_typeArray_region(region) || is_objArray_candidate_region(heap, region)) &&
+           is_remset_small(region) &&
+           !region->has_pinned_objects();
   }
 
  public:
@@ -3953,7 +4063,7 @@ void G1CollectedHeap::log_gc_footer(double pause_time_sec) {
   }
 
   if (G1Log::finer()) {
-    if (evacuation_failed()) {
+    if (to_space_exhausted()) {
       gclog_or_tty->print(" (to-space exhausted)");
     }
     gclog_or_tty->print_cr(", %3.7f secs]", pause_time_sec);
@@ -3961,7 +4071,7 @@ void G1CollectedHeap::log_gc_footer(double pause_time_sec) {
     g1_policy()->phase_times()->print(pause_time_sec);
     g1_policy()->print_detailed_heap_transition();
   } else {
-    if (evacuation_failed()) {
+    if (to_space_exhausted()) {
       gclog_or_tty->print("--");
     }
     g1_policy()->print_heap_transition();
@@ -4027,11 +4137,20 @@ G1CollectedHeap::do_collection_pause_at_safepoint(double target_pause_time_ms) {
     uint active_workers = AdaptiveSizePolicy::calc_active_workers(workers()->total_workers(),
                                                                   workers()->active_workers(),
                                                                   Threads::number_of_non_daemon_threads());
+    if (g1_policy()->has_pause_work_history()) {
+      // Do not wake more workers than the copying and the remembered set
+      // cards of this pause are expected to keep busy.
+      active_workers =
+        AdaptiveSizePolicy::calc_active_workers_by_work(active_workers,
+                                                        g1_policy()->predict_bytes_copied(),
+                                                        pending_card_num() + g1_policy()->predict_rs_lengths());
+    }
     assert(UseDynamicNumberOfGCThreads ||
            active_workers == workers()->total_workers(),
            "If not dynamic should be using all the  workers");
     workers()->set_active_workers(active_workers);
-
+    // The gang may have started fewer workers than asked for
+    active_workers = workers()->active_workers();
 
     double pause_start_sec = os::elapsedTime();
     g1_policy()->phase_times()->note_gc_start(active_workers, mark_in_progress());
@@ -4418,20 +4537,34 @@ void G1CollectedHeap::remove_self_forwarding_pointers() {
 
   assert(check_cset_heap_region_claim_values(HeapRegion::InitialClaimValue), "sanity");
 
-  // Now restore saved marks, if any.
-  assert(_objs_with_preserved_marks.size() ==
-            _preserved_marks_of_objs.size(), "Both or none.");
-  while (!_objs_with_preserved_marks.is_empty()) {
-    oop obj = _objs_with_preserved_marks.pop();
-    markOop m = _preserved_marks_of_objs.pop();
-    obj->set_mark(m);
+  // Now restore saved marks, if any. This must not overlap with the
+  // removal of the self-forwarding pointers, which resets the same marks.
+  if (G1CollectedHeap::use_parallel_gc_threads()) {
+    G1ParRestorePreservedMarksTask rpm_task(this, workers()->active_workers());
+    set_par_threads();
+    workers()->run_task(&rpm_task);
+    set_par_threads(0);
+  } else {
+    G1ParRestorePreservedMarksTask rpm_task(this, 1);
+    rpm_task.work(0);
   }
-  _objs_with_preserved_marks.clear(true);
-  _preserved_marks_of_objs.clear(true);
 
   g1_policy()->phase_times()->record_evac_fail_remove_self_forwards((os::elapsedTime() - remove_self_forwards_start) * 1000.0);
 }
 
+void G1CollectedHeap::restore_preserved_marks(uint queue_num) {
+  PreservedObjStack& objs = _objs_with_preserved_marks[queue_num];
+  PreservedMarkStack& marks = _preserved_marks_of_objs[queue_num];
+  assert(objs.size() == marks.size(), "Both or none.");
+  while (!objs.is_empty()) {
+    oop obj = objs.pop();
+    markOop m = marks.pop();
+    obj->set_mark(m);
+  }
+  objs.clear(true);
+  marks.clear(true);
+}
+
 void G1CollectedHeap::push_on_evac_failure_scan_stack(oop obj) {
   _evac_failure_scan_stack->push(obj);
 }
@@ -4448,7 +4581,7 @@ void G1CollectedHeap::drain_evac_failure_scan_stack() {
 
 oop
 G1CollectedHeap::handle_evacuation_failure_par(G1ParScanThreadState* _par_scan_state,
-                                               oop old) {
+                                               oop old, bool pinned) {
   assert(obj_in_cs(old),
          err_msg("obj: " PTR_FORMAT " should still be in the CSet",
                  (HeapWord*) old));
@@ -4461,7 +4594,10 @@ G1CollectedHeap::handle_evacuation_failure_par(G1ParScanThreadState* _par_scan_s
     uint queue_num = _par_scan_state->queue_num();
 
     _evacuation_failed = true;
-    _evacuation_failed_info_array[queue_num].register_copy_failure(old->size());
+    if (!pinned) {
+      _to_space_exhausted = true;
+      _evacuation_failed_info_array[queue_num].register_copy_failure(old->size());
+    }
     if (_evac_failure_closure != cl) {
       MutexLockerEx x(EvacFailureStack_lock, Mutex::_no_safepoint_check_flag);
       assert(!_drain_in_progress,
@@ -4470,13 +4606,13 @@ G1CollectedHeap::handle_evacuation_failure_par(G1ParScanThreadState* _par_scan_s
       assert(_evac_failure_closure == NULL, "Or locking has failed.");
       set_evac_failure_closure(cl);
       // Now do the common part.
-      handle_evacuation_failure_common(old, m);
+      handle_evacuation_failure_common(old, m, queue_num);
       // Reset to NULL.
       set_evac_failure_closure(NULL);
     } else {
       // The lock is already held, and this is recursive.
       assert(_drain_in_progress, "This should only be the recursive case.");
-      handle_evacuation_failure_common(old, m);
+      handle_evacuation_failure_common(old, m, queue_num);
     }
     return old;
   } else {
@@ -4491,8 +4627,8 @@ G1CollectedHeap::handle_evacuation_failure_par(G1ParScanThreadState* _par_scan_s
   }
 }
 
-void G1CollectedHeap::handle_evacuation_failure_common(oop old, markOop m) {
-  preserve_mark_if_necessary(old, m);
+void G1CollectedHeap::handle_evacuation_failure_common(oop old, markOop m, uint queue_num) {
+  preserve_mark_if_necessary(old, m, queue_num);
 
   HeapRegion* r = heap_region_containing(old);
   if (!r->evacuation_failed()) {
@@ -4510,13 +4646,13 @@ void G1CollectedHeap::handle_evacuation_failure_common(oop old, markOop m) {
   }
 }
 
-void G1CollectedHeap::preserve_mark_if_necessary(oop obj, markOop m) {
+void G1CollectedHeap::preserve_mark_if_necessary(oop obj, markOop m, uint queue_num) {
   assert(evacuation_failed(), "Oversaving!");
   // We want to call the "for_promotion_failure" version only in the
   // case of a promotion failure.
   if (m->must_be_preserved_for_promotion_failure(obj)) {
-    _objs_with_preserved_marks.push(obj);
-    _preserved_marks_of_objs.push(m);
+    _objs_with_preserved_marks[queue_num].push(obj);
+    _preserved_marks_of_objs[queue_num].push(m);
   }
 }
 
@@ -4585,6 +4721,8 @@ void G1ParCopyClosure<barrier, do_mark_object>::do_oop_work(T* p) {
   } else {
     if (state.is_humongous()) {
       _g1->set_humongous_is_live(obj);
+    } else if (state.is_optional()) {
+      _par_scan_state->record_optional_ref(p);
     }
     // The object is not in collection set. If we're a root scanning
     // closure during an initial mark pause then attempt to mark the object.
@@ -4825,6 +4963,7 @@ public:
         MutexLocker x(stats_lock());
         pss.print_termination_stats(worker_id);
       }
+      pss.report_plab_worker_stats();
 
       assert(pss.queue_is_empty(), "should be empty");
 
@@ -4836,6 +4975,66 @@ public:
   }
 };
 
+// Evacuates optional collection set regions that have been added to the
+// collection set after the initial evacuation. Each worker first processes
+// the references into these regions it recorded earlier in the pause, then
+// the remembered sets and strong code roots of the regions are scanned.
+class G1ParOptionalEvacTask : public AbstractGangTask {
+  G1CollectedHeap*            _g1h;
+  RefToScanQueueSet*          _queues;
+  GrowableArray<HeapRegion*>* _regions;
+  ParallelTaskTerminator      _terminator;
+  uint                        _n_workers;
+
+public:
+  G1ParOptionalEvacTask(G1CollectedHeap* g1h,
+                        RefToScanQueueSet* task_queues,
+                        GrowableArray<HeapRegion*>* regions)
+    : AbstractGangTask("G1 optional collection"),
+      _g1h(g1h),
+      _queues(task_queues),
+      _regions(regions),
+      _terminator(0, _queues),
+      _n_workers(0)
+  {}
+
+  virtual void set_for_termination(int active_workers) {
+    _terminator.reset_for_reuse(active_workers);
+    _n_workers = active_workers;
+  }
+
+  void work(uint worker_id) {
+    if (worker_id >= _n_workers) return;  // no work needed this round
+
+    ResourceMark rm;
+    HandleMark   hm;
+
+    ReferenceProcessor*             rp = _g1h->ref_processor_stw();
+
+    G1ParScanThreadState            pss(_g1h, worker_id, rp);
+    G1ParScanHeapEvacFailureClosure evac_failure_cl(_g1h, &pss, rp);
+
+    pss.set_evac_failure_closure(&evac_failure_cl);
+
+    // Optional regions are never chosen during an initial mark pause, so
+    // there is no need to mark objects reachable from roots.
+    G1ParCopyClosure<G1BarrierNone, G1MarkNone> scan_only_root_cl(_g1h, &pss, rp);
+
+    _g1h->optional_cset_refs()->process(worker_id, &pss, &scan_only_root_cl);
+
+    G1ParPushHeapRSClosure push_heap_rs_cl(_g1h, &pss);
+    G1RootProcessor::scan_optional_remembered_sets(&push_heap_rs_cl,
+                                                   &scan_only_root_cl,
+                                                   _regions,
+                                                   worker_id);
+
+    G1ParEvacuateFollowersClosure evac(_g1h, &pss, _queues, &_terminator);
+    evac.do_void();
+
+    assert(pss.queue_is_empty(), "should be empty");
+  }
+};
+
 class G1StringSymbolTableUnlinkTask : public AbstractGangTask {
 private:
   BoolObjectClosure* _is_alive;
@@ -5791,6 +5990,18 @@ void G1CollectedHeap::enqueue_discovered_references(uint no_of_gc_workers) {
 void G1CollectedHeap::evacuate_collection_set(EvacuationInfo& evacuation_info) {
   _expand_heap_after_alloc_failure = true;
   _evacuation_failed = false;
+  _to_space_exhausted = false;
+
+  // A region with pinned objects keeps all of them, also dead ones that a
+  // JNI critical section may still be reading, so it is handled like a
+  // region that failed evacuation even if none of its objects is reached.
+  for (HeapRegion* r = g1_policy()->collection_set(); r != NULL; r = r->next_in_collection_set()) {
+    if (r->has_pinned_objects()) {
+      r->set_evacuation_failed(true);
+      _hr_printer.evac_failure(r);
+      _evacuation_failed = true;
+    }
+  }
 
   // Should G1EvacuationFailureALot be in effect for this GC?
   NOT_PRODUCT(set_evacuation_failure_alot_for_current_gc();)
@@ -5854,6 +6065,8 @@ void G1CollectedHeap::evacuate_collection_set(EvacuationInfo& evacuation_info) {
         (os::elapsedTime() - end_par_time_sec) * 1000.0;
   phase_times->record_code_root_fixup_time(code_root_fixup_time_ms);
 
+  evacuate_optional_collection_set(evacuation_info);
+
   set_par_threads(0);
 
   // Process any discovered reference objects - we have
@@ -5880,7 +6093,7 @@ void G1CollectedHeap::evacuate_collection_set(EvacuationInfo& evacuation_info) {
   // Reset and re-enable the hot card cache.
   // Note the counts for the cards in the regions in the
   // collection set are reset when the collection set is freed.
-  hot_card_cache->reset_hot_cache();
+  hot_card_cache->reset_hot_cache_after_evacuation();
   hot_card_cache->set_use_cache(true);
 
   purge_code_root_memory();
@@ -5914,6 +6127,54 @@ void G1CollectedHeap::evacuate_collection_set(EvacuationInfo& evacuation_info) {
   COMPILER2_PRESENT(DerivedPointerTable::update_pointers());
 }
 
+void G1CollectedHeap::evacuate_optional_collection_set(EvacuationInfo& evacuation_info) {
+  G1CollectorPolicy* policy = g1_policy();
+  G1GCPhaseTimes* phase_times = policy->phase_times();
+  double start_sec = os::elapsedTime();
+  size_t num_evacuated = 0;
+
+  // Add optional regions to the collection set in increments, as long as
+  // the remaining pause time allows. Running out of to-space makes further
+  // evacuation pointless, as the rest of the pause will be expensive anyway.
+  while (!to_space_exhausted() && policy->optional_cset_region_length() > 0) {
+    double pause_time_ms = (os::elapsedTime() - phase_times->cur_collection_start_sec()) * 1000.0;
+    double time_remaining_ms = policy->max_pause_time_ms() - pause_time_ms -
+                               policy->predict_constant_other_time_ms();
+    if (time_remaining_ms <= 0.0) {
+      break;
+    }
+
+    ResourceMark rm;
+    GrowableArray<HeapRegion*> regions(policy->optional_cset_region_length());
+    uint num_added = policy->add_optional_regions_to_cset(time_remaining_ms, &regions);
+    if (num_added == 0) {
+      break;
+    }
+    if (_hr_printer.is_active()) {
+      for (int i = 0; i < regions.length(); i++) {
+        _hr_printer.cset(regions.at(i));
+      }
+    }
+
+    G1ParOptionalEvacTask optional_task(this, _task_queues, &regions);
+    if (G1CollectedHeap::use_parallel_gc_threads()) {
+      workers()->run_task(&optional_task);
+    } else {
+      optional_task.set_for_termination(workers()->active_workers());
+      optional_task.work(0);
+    }
+    num_evacuated += num_added;
+  }
+
+  size_t num_abandoned = policy->optional_cset_region_length();
+  policy->abandon_optional_cset_regions();
+  _optional_cset_refs->clear();
+  evacuation_info.set_collectionset_regions(policy->cset_region_length());
+
+  double optional_time_ms = (os::elapsedTime() - start_sec) * 1000.0;
+  phase_times->record_optional_evacuation(optional_time_ms, num_evacuated, num_abandoned);
+}
+
 void G1CollectedHeap::free_region(HeapRegion* hr,
                                   FreeRegionList* free_list,
                                   bool par,
@@ -6398,10 +6659,11 @@ class G1FreeHumongousRegionClosure : public HeapRegionClosure {
     // are completely up-to-date wrt to references to the humongous object.
     //
     // Other implementation considerations:
-    // - never consider object arrays at this time because they would pose
-    // considerable effort for cleaning up the the remembered sets. This is
-    // required because stale remembered sets might reference locations that
-    // are currently allocated into.
+    // - object arrays induce remembered set entries on the regions they
+    // reference. These are left in place: once the regions are reused the
+    // stale cards only make the collector scan parseable objects below
+    // scan_top(), like any other card whose reference has since been
+    // overwritten.
     uint region_idx = r->hrm_index();
     if (!g1h->is_humongous_reclaim_candidate(region_idx) ||
         !r->rem_set()->is_empty()) {
@@ -6423,8 +6685,8 @@ class G1FreeHumongousRegionClosure : public HeapRegionClosure {
       return false;
     }
 
-    guarantee(obj->is_typeArray(),
-              err_msg("Only eagerly reclaiming type arrays is supported, but the object "
+    guarantee(obj->is_typeArray() || obj->is_objArray(),
+              err_msg("Only eagerly reclaiming arrays is supported, but the object "
                       PTR_FORMAT " is not.",
                       r->bottom()));
 
@@ -6730,7 +6992,8 @@ bool G1CollectedHeap::is_in_closed_subset(const void* p) const {
 // Methods for the mutator alloc region
 
 HeapRegion* G1CollectedHeap::new_mutator_alloc_region(size_t word_size,
-                                                      bool force) {
+                                                      bool force,
+                                                      uint node_index) {
   assert_heap_locked_or_at_safepoint(true /* should_be_vm_thread */);
   assert(!force || g1_policy()->can_expand_young_list(),
          "if force is true we should be able to expand the young list");
@@ -6738,7 +7001,8 @@ HeapRegion* G1CollectedHeap::new_mutator_alloc_region(size_t word_size,
   if (force || !young_list_full) {
     HeapRegion* new_alloc_region = new_region(word_size,
                                               false /* is_old */,
-                                              false /* do_expand */);
+                                              false /* do_expand */,
+                                              node_index);
     if (new_alloc_region != NULL) {
       set_region_short_lived_locked(new_alloc_region);
       _hr_printer.alloc(new_alloc_region, G1HRPrinter::Eden, young_list_full);
@@ -6783,14 +7047,16 @@ void G1CollectedHeap::set_par_threads() {
 
 HeapRegion* G1CollectedHeap::new_gc_alloc_region(size_t word_size,
                                                  uint count,
-                                                 InCSetState dest) {
+                                                 InCSetState dest,
+                                                 uint node_index) {
   assert(FreeList_lock->owned_by_self(), "pre-condition");
 
   if (count < g1_policy()->max_regions(dest)) {
     const bool is_survivor = (dest.is_young());
     HeapRegion* new_alloc_region = new_region(word_size,
                                               !is_survivor,
-                                              true /* do_expand */);
+                                              true /* do_expand */,
+                                              node_index);
     if (new_alloc_region != NULL) {
       // We really only need to do this for old regions given that we
       // should never scan survivors. But it doesn't hurt to do it
@@ -6805,6 +7071,7 @@ HeapRegion* G1CollectedHeap::new_gc_alloc_region(size_t word_size,
         _hr_printer.alloc(new_alloc_region, G1HRPrinter::Old);
         check_bitmaps("Old Region Allocation", new_alloc_region);
       }
+      g1_policy()->remset_tracker()->update_at_allocate(new_alloc_region);
       bool during_im = g1_policy()->during_initial_mark_pause();
       new_alloc_region->note_start_of_copying(during_im);
       return new_alloc_region;
@@ -6994,6 +7261,21 @@ void G1CollectedHeap::unregister_nmethod(nmethod* nm) {
   nm->oops_do(&reg_cl, true);
 }
 
+bool G1CollectedHeap::supports_object_pinning() const {
+  return G1PinCriticalRegions;
+}
+
+oop G1CollectedHeap::pin_object(JavaThread* thread, oop obj) {
+  assert(thread->thread_state() == _thread_in_vm, "pins may not race with a GC");
+  heap_region_containing(obj)->increment_pinned_object_count();
+  return obj;
+}
+
+void G1CollectedHeap::unpin_object(JavaThread* thread, oop obj) {
+  assert(thread->thread_state() == _thread_in_vm, "pins may not race with a GC");
+  heap_region_containing(obj)->decrement_pinned_object_count();
+}
+
 void G1CollectedHeap::purge_code_root_memory() {
   double purge_start = os::elapsedTime();
   G1CodeRootSet::purge();
@@ -34,6 +34,7 @@
 #include "gc_implementation/g1/g1HRPrinter.hpp"
 #include "gc_implementation/g1/g1InCSetState.hpp"
 #include "gc_implementation/g1/g1MonitoringSupport.hpp"
+#include "gc_implementation/g1/g1NUMA.hpp"
 #include "gc_implementation/g1/g1SATBCardTableModRefBS.hpp"
 #include "gc_implementation/g1/g1YCTypes.hpp"
 #include "gc_implementation/g1/heapRegionManager.hpp"
@@ -75,6 +76,7 @@ class GenerationCounters;
 class STWGCTimer;
 class G1NewTracer;
 class G1OldTracer;
+class G1OptionalCSetRefs;
 class EvacuationFailedInfo;
 class nmethod;
 
@@ -182,6 +184,7 @@ class G1CollectedHeap : public SharedHeap {
   friend class VM_G1CollectForAllocation;
   friend class VM_G1CollectFull;
   friend class VM_G1IncCollectionPause;
+  friend class CMShrinkHeapClosure;
   friend class VMStructs;
   friend class MutatorAllocRegion;
   friend class SurvivorGCAllocRegion;
@@ -267,6 +270,9 @@ private:
   // Class that handles the different kinds of allocations.
   G1Allocator* _allocator;
 
+  // Information about the NUMA nodes the heap is placed on.
+  G1NUMA* _numa;
+
   // Statistics for each allocation context
   AllocationContextStats _allocation_context_stats;
 
@@ -343,6 +349,7 @@ private:
   // (a) cause == _gc_locker and +GCLockerInvokesConcurrent, or
   // (b) cause == _java_lang_system_gc and +ExplicitGCInvokesConcurrent.
   // (c) cause == _g1_humongous_allocation
+  // (d) cause == _g1_periodic_collection and +G1PeriodicGCInvokesConcurrent.
   bool should_do_concurrent_full_gc(GCCause::Cause cause);
 
   // Keeps track of how many "old marking cycles" (i.e., Full GCs or
@@ -459,14 +466,16 @@ protected:
   // check whether there's anything available on the
   // secondary_free_list and/or wait for more regions to appear on
   // that list, if _free_regions_coming is set.
-  HeapRegion* new_region_try_secondary_free_list(bool is_old);
+  HeapRegion* new_region_try_secondary_free_list(bool is_old, uint node_index);
 
   // Try to allocate a single non-humongous HeapRegion sufficient for
   // an allocation of the given word_size. If do_expand is true,
   // attempt to expand the heap if necessary to satisfy the allocation
   // request. If the region is to be used as an old region or for a
-  // humongous object, set is_old to true. If not, to false.
-  HeapRegion* new_region(size_t word_size, bool is_old, bool do_expand);
+  // humongous object, set is_old to true. If not, to false. If NUMA is
+  // enabled, a region on the node given by node_index is preferred.
+  HeapRegion* new_region(size_t word_size, bool is_old, bool do_expand,
+                         uint node_index = G1NUMA::AnyNodeIndex);
 
   // Initialize a contiguous set of free regions of length num_regions
   // and starting at index first so that they appear as a single
@@ -564,14 +573,16 @@ protected:
   // may not be a humongous - it must fit into a single heap region.
   inline HeapWord* par_allocate_during_gc(InCSetState dest,
                                           size_t word_size,
-                                          AllocationContext_t context);
+                                          AllocationContext_t context,
+                                          uint node_index);
   // Ensure that no further allocations can happen in "r", bearing in mind
   // that parallel threads might be attempting allocations.
   void par_allocate_remaining_space(HeapRegion* r);
 
   // Allocation attempt during GC for a survivor object / PLAB.
   inline HeapWord* survivor_attempt_allocation(size_t word_size,
-                                               AllocationContext_t context);
+                                               AllocationContext_t context,
+                                               uint node_index);
 
   // Allocation attempt during GC for an old object / PLAB.
   inline HeapWord* old_attempt_allocation(size_t word_size,
@@ -580,13 +591,14 @@ protected:
   // These methods are the "callbacks" from the G1AllocRegion class.
 
   // For mutator alloc regions.
-  HeapRegion* new_mutator_alloc_region(size_t word_size, bool force);
+  HeapRegion* new_mutator_alloc_region(size_t word_size, bool force, uint node_index);
   void retire_mutator_alloc_region(HeapRegion* alloc_region,
                                    size_t allocated_bytes);
 
   // For GC alloc regions.
   HeapRegion* new_gc_alloc_region(size_t word_size, uint count,
-                                  InCSetState dest);
+                                  InCSetState dest,
+                                  uint node_index = G1NUMA::AnyNodeIndex);
   void retire_gc_alloc_region(HeapRegion* alloc_region,
                               size_t allocated_bytes, InCSetState dest);
 
@@ -611,6 +623,18 @@ protected:
   // and will be considered part of the used portion of the heap.
   void resize_if_necessary_after_full_collection(size_t word_size);
 
+  // Computes the range of heap capacities that keeps the free part of
+  // the heap between MinHeapFreeRatio and MaxHeapFreeRatio when
+  // "used_bytes" of it are occupied.
+  void desired_capacity_bounds(size_t used_bytes,
+                               size_t* minimum_desired_capacity,
+                               size_t* maximum_desired_capacity);
+
+  // Shrink the heap, if necessary, at the end of a concurrent cycle by
+  // uncommitting free regions beyond MaxHeapFreeRatio. Only done when
+  // periodic collections (G1PeriodicGCInterval) are enabled.
+  void shrink_after_concurrent_cycle();
+
   // Callback from VM_G1CollectForAllocation operation.
   // This function does everything necessary/possible to satisfy a
   // failed allocation request (including collection, expansion, etc.)
@@ -638,6 +662,10 @@ public:
     return _allocator;
   }
 
+  G1NUMA* numa() const {
+    return _numa;
+  }
+
   G1MonitoringSupport* g1mm() {
     assert(_g1mm != NULL, "should have been initialized");
     return _g1mm;
@@ -683,6 +711,12 @@ public:
   void register_old_region_with_in_cset_fast_test(HeapRegion* r) {
     _in_cset_fast_test.set_in_old(r->hrm_index());
   }
+  void register_optional_region_with_in_cset_fast_test(HeapRegion* r) {
+    _in_cset_fast_test.set_optional(r->hrm_index());
+  }
+  void clear_optional_region_in_cset_fast_test(HeapRegion* r) {
+    _in_cset_fast_test.clear_optional(r->hrm_index());
+  }
 
   // This is a fast test on whether a reference points into the
   // collection set or not. Assume that the reference
@@ -784,6 +818,16 @@ protected:
   // Actually do the work of evacuating the collection set.
   void evacuate_collection_set(EvacuationInfo& evacuation_info);
 
+  // Evacuate as many of the optional collection set regions as the
+  // remaining pause time allows, after the initial collection set has
+  // been evacuated. Any remaining optional regions are returned to the
+  // collection set chooser.
+  void evacuate_optional_collection_set(EvacuationInfo& evacuation_info);
+
+  // Locations found during evacuation that refer into optional collection
+  // set regions.
+  G1OptionalCSetRefs* _optional_cset_refs;
+
   // The g1 remembered set of the heap.
   G1RemSet* _g1_rem_set;
 
@@ -825,6 +869,11 @@ protected:
   // True iff a evacuation has failed in the current collection.
   bool _evacuation_failed;
 
+  // True iff an evacuation failed for lack of space in the current
+  // collection, as opposed to objects of pinned regions having been
+  // kept in place.
+  bool _to_space_exhausted;
+
   EvacuationFailedInfo* _evacuation_failed_info_array;
 
   // Failed evacuations cause some logical from-space objects to have
@@ -832,12 +881,16 @@ protected:
   void remove_self_forwarding_pointers();
 
   // Together, these store an object with a preserved mark, and its mark value.
-  Stack<oop, mtGC>     _objs_with_preserved_marks;
-  Stack<markOop, mtGC> _preserved_marks_of_objs;
+  // There is one pair of stacks per worker, so that the marks can be
+  // restored in parallel.
+  typedef Stack<oop, mtGC>     PreservedObjStack;
+  typedef Stack<markOop, mtGC> PreservedMarkStack;
+  PreservedObjStack*  _objs_with_preserved_marks;
+  PreservedMarkStack* _preserved_marks_of_objs;
 
   // Preserve the mark of "obj", if necessary, in preparation for its mark
   // word being overwritten with a self-forwarding-pointer.
-  void preserve_mark_if_necessary(oop obj, markOop m);
+  void preserve_mark_if_necessary(oop obj, markOop m, uint queue_num);
 
   // The stack of evac-failure objects left to be scanned.
   GrowableArray<oop>*    _evac_failure_scan_stack;
@@ -866,9 +919,17 @@ protected:
   // structures.
   void finalize_for_evac_failure();
 
-  // An attempt to evacuate "obj" has failed; take necessary steps.
-  oop handle_evacuation_failure_par(G1ParScanThreadState* _par_scan_state, oop obj);
-  void handle_evacuation_failure_common(oop obj, markOop m);
+  // An attempt to evacuate "obj" has failed, or "obj" is in a pinned
+  // region and must not move; take necessary steps.
+  oop handle_evacuation_failure_par(G1ParScanThreadState* _par_scan_state, oop obj,
+                                    bool pinned = false);
+  void handle_evacuation_failure_common(oop obj, markOop m, uint queue_num);
+
+public:
+  // Restore the marks preserved by worker queue_num during the pause.
+  void restore_preserved_marks(uint queue_num);
+
+protected:
 
 #ifndef PRODUCT
   // Support for forcing evacuation failures. Analogous to
@@ -1005,6 +1066,8 @@ public:
 
   RefToScanQueue *task_queue(int i) const;
 
+  G1OptionalCSetRefs* optional_cset_refs() const { return _optional_cset_refs; }
+
   // A set of cards where updates happened during the GC
   DirtyCardQueueSet& dirty_card_queue_set() { return _dirty_card_queue_set; }
 
@@ -1089,6 +1152,7 @@ public:
 
   ConcurrentGCTimer* gc_timer_cm() const { return _gc_timer_cm; }
   G1OldTracer* gc_tracer_cm() const { return _gc_tracer_cm; }
+  G1NewTracer* gc_tracer_stw() const { return _gc_tracer_stw; }
 
   virtual size_t capacity() const;
   virtual size_t used() const;
@@ -1220,6 +1284,10 @@ public:
   // True iff an evacuation has failed in the most-recent collection.
   bool evacuation_failed() { return _evacuation_failed; }
 
+  // True iff an evacuation has failed in the most-recent collection
+  // because no space was left to copy an object to.
+  bool to_space_exhausted() { return _to_space_exhausted; }
+
   void remove_from_old_sets(const HeapRegionSetCount& old_regions_removed, const HeapRegionSetCount& humongous_regions_removed);
   void prepend_to_freelist(FreeRegionList* list);
   void decrement_summary_bytes(size_t bytes);
@@ -1281,6 +1349,10 @@ public:
   // Iterate over all objects, calling "cl.do_object" on each.
   virtual void object_iterate(ObjectClosure* cl);
 
+  virtual bool supports_object_iterate_parallel() const { return true; }
+  virtual void object_iterate_parallel(ObjectClosure* cl, uint worker_id, uint num_workers);
+  virtual void object_iterate_parallel_done();
+
   virtual void safe_object_iterate(ObjectClosure* cl) {
     object_iterate(cl);
   }
@@ -1294,6 +1366,7 @@ public:
 
   // Return the region with the given index. It assumes the index is valid.
   inline HeapRegion* region_at(uint index) const;
+  inline HeapRegion* region_at_or_null(uint index) const;
 
   // Calculate the region index of the given address. Given address must be
   // within the heap.
@@ -1558,6 +1631,15 @@ public:
   // Unregister the given nmethod from the G1 heap
   virtual void unregister_nmethod(nmethod* nm);
 
+  // JNI critical sections pin the region of their object instead of
+  // locking out GCs. A young collection keeps a pinned region as an old
+  // region in place through the evacuation failure mechanism, mixed
+  // collections do not choose pinned old regions, and full collections
+  // do not compact pinned regions.
+  virtual bool supports_object_pinning() const;
+  virtual oop pin_object(JavaThread* thread, oop obj);
+  virtual void unpin_object(JavaThread* thread, oop obj);
+
   // Free up superfluous code root memory.
   void purge_code_root_memory();
 
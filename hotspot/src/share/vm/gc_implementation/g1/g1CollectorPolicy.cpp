@@ -33,6 +33,7 @@
 #include "gc_implementation/g1/g1CollectedHeap.inline.hpp"
 #include "gc_implementation/g1/g1CollectorPolicy.hpp"
 #include "gc_implementation/g1/g1ErgoVerbose.hpp"
+#include "gc_implementation/g1/g1IHOPControl.hpp"
 #include "gc_implementation/g1/g1GCPhaseTimes.hpp"
 #include "gc_implementation/g1/g1Log.hpp"
 #include "gc_implementation/g1/heapRegionRemSet.hpp"
@@ -101,6 +102,7 @@ G1CollectorPolicy::G1CollectorPolicy() :
   _cost_per_entry_ms_seq(new TruncatedSeq(TruncatedSeqLength)),
   _mixed_cost_per_entry_ms_seq(new TruncatedSeq(TruncatedSeqLength)),
   _cost_per_byte_ms_seq(new TruncatedSeq(TruncatedSeqLength)),
+  _old_cost_per_byte_ms_seq(new TruncatedSeq(TruncatedSeqLength)),
   _cost_per_byte_ms_during_cm_seq(new TruncatedSeq(TruncatedSeqLength)),
   _constant_other_time_ms_seq(new TruncatedSeq(TruncatedSeqLength)),
   _young_other_cost_per_region_ms_seq(new TruncatedSeq(TruncatedSeqLength)),
@@ -109,6 +111,7 @@ G1CollectorPolicy::G1CollectorPolicy() :
 
   _pending_cards_seq(new TruncatedSeq(TruncatedSeqLength)),
   _rs_lengths_seq(new TruncatedSeq(TruncatedSeqLength)),
+  _bytes_copied_seq(new TruncatedSeq(TruncatedSeqLength)),
 
   _pause_time_target_ms((double) MaxGCPauseMillis),
 
@@ -128,6 +131,11 @@ G1CollectorPolicy::G1CollectorPolicy() :
   _last_young_gc(false),
   _last_gc_was_young(false),
 
+  _ihop_control(NULL),
+  _initial_mark_end_sec(0.0),
+  _ihop_last_pause_end_sec(0.0),
+  _ihop_last_non_young_bytes(0),
+
   _eden_used_bytes_before_gc(0),
   _survivor_used_bytes_before_gc(0),
   _heap_used_bytes_before_gc(0),
@@ -141,12 +149,17 @@ G1CollectorPolicy::G1CollectorPolicy() :
 
   _collection_set(NULL),
   _collection_set_bytes_used_before(0),
+  _optional_cset_regions(NULL),
+  _optional_cset_regions_added(0),
 
   // Incremental CSet attributes
   _inc_cset_build_state(Inactive),
   _inc_cset_head(NULL),
   _inc_cset_tail(NULL),
   _inc_cset_bytes_used_before(0),
+  _old_cset_bytes_to_copy(0),
+  _predicted_pause_time_ms(0.0),
+  _predicted_pause_target_ms(0.0),
   _inc_cset_max_finger(NULL),
   _inc_cset_recorded_rs_lengths(0),
   _inc_cset_recorded_rs_lengths_diffs(0),
@@ -292,6 +305,8 @@ G1CollectorPolicy::G1CollectorPolicy() :
   }
   _sigma = (double) confidence_perc / 100.0;
 
+  _ihop_control = G1IHOPControl::create_ihop_control(_sigma);
+
   // start conservatively (around 50ms is about right)
   _concurrent_mark_remark_times_ms->add(0.05);
   _concurrent_mark_cleanup_times_ms->add(0.20);
@@ -318,6 +333,7 @@ G1CollectorPolicy::G1CollectorPolicy() :
   _reserve_regions = 0;
 
   _collectionSetChooser = new CollectionSetChooser();
+  _optional_cset_regions = new (ResourceObj::C_HEAP, mtGC) GrowableArray<HeapRegion*>(8, true, mtGC);
 }
 
 void G1CollectorPolicy::initialize_alignments() {
@@ -458,6 +474,9 @@ void G1CollectorPolicy::init() {
   _free_regions_at_end_of_collection = _g1->num_free_regions();
   update_young_list_target_length();
 
+  _ihop_control->update_target_occupancy(_g1->capacity());
+  _ihop_last_pause_end_sec = os::elapsedTime();
+
   // We may immediately start allocating regions and placing them on the
   // collection set list. Initialize the per-collection set info
   start_incremental_cset_building();
@@ -818,6 +837,11 @@ void G1CollectorPolicy::record_full_collection_end() {
   // transitions and make sure we start with young GCs after the Full GC.
   set_gcs_are_young(true);
   _last_young_gc = false;
+  // Any marking in progress has been aborted, so there is no marking
+  // length to record, and the old gen occupancy changed arbitrarily.
+  _initial_mark_end_sec = 0.0;
+  _ihop_last_pause_end_sec = end_sec;
+  _ihop_last_non_young_bytes = _g1->non_young_capacity_bytes();
   clear_initiate_conc_mark_if_possible();
   clear_during_initial_mark_pause();
   _in_marking_window = false;
@@ -859,6 +883,8 @@ void G1CollectorPolicy::record_collection_pause_start(double start_time_sec, GCT
   _pending_cards = _g1->pending_card_num();
 
   _collection_set_bytes_used_before = 0;
+  _old_cset_bytes_to_copy = 0;
+  _predicted_pause_time_ms = 0.0;
   _bytes_copied_during_gc = 0;
 
   _last_gc_was_young = false;
@@ -914,8 +940,11 @@ bool G1CollectorPolicy::need_to_start_conc_mark(const char* source, size_t alloc
     return false;
   }
 
+  _ihop_control->update_target_occupancy(_g1->capacity());
   size_t marking_initiating_used_threshold =
-    (_g1->capacity() / 100) * InitiatingHeapOccupancyPercent;
+    _ihop_control->get_conc_mark_start_threshold();
+  double threshold_percent = _g1->capacity() > 0 ?
+    (double) marking_initiating_used_threshold * 100.0 / _g1->capacity() : 0.0;
   size_t cur_used_bytes = _g1->non_young_capacity_bytes();
   size_t alloc_byte_size = alloc_word_size * HeapWordSize;
 
@@ -931,7 +960,7 @@ bool G1CollectorPolicy::need_to_start_conc_mark(const char* source, size_t alloc
         cur_used_bytes,
         alloc_byte_size,
         marking_initiating_used_threshold,
-        (double) InitiatingHeapOccupancyPercent,
+        threshold_percent,
         source);
       return true;
     } else {
@@ -945,7 +974,7 @@ bool G1CollectorPolicy::need_to_start_conc_mark(const char* source, size_t alloc
         cur_used_bytes,
         alloc_byte_size,
         marking_initiating_used_threshold,
-        (double) InitiatingHeapOccupancyPercent,
+        threshold_percent,
         source);
     }
   }
@@ -965,7 +994,7 @@ void G1CollectorPolicy::record_collection_pause_end(double pause_time_ms, Evacua
   size_t cur_used_bytes = _g1->used();
   assert(cur_used_bytes == _g1->recalculate_used(), "It should!");
   bool last_pause_included_initial_mark = false;
-  bool update_stats = !_g1->evacuation_failed();
+  bool update_stats = !_g1->to_space_exhausted();
 
 #ifndef PRODUCT
   if (G1YoungSurvRateVerbose) {
@@ -978,6 +1007,7 @@ void G1CollectorPolicy::record_collection_pause_end(double pause_time_ms, Evacua
   last_pause_included_initial_mark = during_initial_mark_pause();
   if (last_pause_included_initial_mark) {
     record_concurrent_mark_init_end(0.0);
+    _initial_mark_end_sec = end_time_sec;
   } else if (need_to_start_conc_mark("end of GC")) {
     // Note: this might have already been set, if during the last
     // pause we decided to start a cycle but at the beginning of
@@ -1051,6 +1081,8 @@ void G1CollectorPolicy::record_collection_pause_end(double pause_time_ms, Evacua
     new_in_marking_window_im = true;
   }
 
+  bool this_gc_was_young_only = _last_gc_was_young;
+
   if (_last_young_gc) {
     // This is supposed to to be the "last young GC" before we start
     // doing mixed GCs. Here we decide whether to start mixed GCs or not.
@@ -1059,6 +1091,17 @@ void G1CollectorPolicy::record_collection_pause_end(double pause_time_ms, Evacua
       if (next_gc_should_be_mixed("start mixed GCs",
                                   "do not start mixed GCs")) {
         set_gcs_are_young(false);
+      } else {
+        abandon_collection_set_candidates();
+      }
+      // The marking cycle started by the last initial-mark pause is
+      // complete now; whether or not it is followed by mixed GCs, the
+      // mutator time since then is the length of this marking cycle.
+      if (_initial_mark_end_sec > 0.0) {
+        double marking_length_s =
+          phase_times()->cur_collection_start_sec() - _initial_mark_end_sec;
+        _ihop_control->update_marking_length(MAX2(marking_length_s, 0.0));
+        _initial_mark_end_sec = 0.0;
       }
     } else {
       ergo_verbose0(ErgoMixedGCs,
@@ -1075,6 +1118,7 @@ void G1CollectorPolicy::record_collection_pause_end(double pause_time_ms, Evacua
     if (!next_gc_should_be_mixed("continue mixed GCs",
                                  "do not continue mixed GCs")) {
       set_gcs_are_young(true);
+      abandon_collection_set_candidates();
     }
   }
 
@@ -1134,14 +1178,33 @@ void G1CollectorPolicy::record_collection_pause_end(double pause_time_ms, Evacua
     if (_collection_set_bytes_used_before > freed_bytes) {
       size_t copied_bytes = _collection_set_bytes_used_before - freed_bytes;
       double average_copy_time = phase_times()->average_time_ms(G1GCPhaseTimes::ObjCopy);
-      double cost_per_byte_ms = average_copy_time / (double) copied_bytes;
-      if (_in_marking_window) {
-        _cost_per_byte_ms_during_cm_seq->add(cost_per_byte_ms);
+      size_t old_copied_bytes = MIN2(_old_cset_bytes_to_copy, copied_bytes);
+      if (old_copied_bytes == 0) {
+        double cost_per_byte_ms = average_copy_time / (double) copied_bytes;
+        if (_in_marking_window) {
+          _cost_per_byte_ms_during_cm_seq->add(cost_per_byte_ms);
+        } else {
+          _cost_per_byte_ms_seq->add(cost_per_byte_ms);
+        }
       } else {
-        _cost_per_byte_ms_seq->add(cost_per_byte_ms);
+        // Take the young regions' share of the copy time out at their
+        // predicted cost; the rest is what the old regions cost.
+        double young_copy_time =
+          predict_object_copy_time_ms(copied_bytes - old_copied_bytes);
+        double old_copy_time = average_copy_time - young_copy_time;
+        if (old_copy_time > 0.0) {
+          _old_cost_per_byte_ms_seq->add(old_copy_time / (double) old_copied_bytes);
+        }
       }
     }
 
+    if (_predicted_pause_time_ms > 0.0) {
+      _g1->gc_tracer_stw()->report_pause_prediction(old_cset_region_length() > 0,
+                                                    _predicted_pause_time_ms,
+                                                    pause_time_ms,
+                                                    _predicted_pause_target_ms);
+    }
+
     double all_other_time_ms = pause_time_ms -
       (phase_times()->average_time_ms(G1GCPhaseTimes::UpdateRS) + phase_times()->average_time_ms(G1GCPhaseTimes::ScanRS) +
           phase_times()->average_time_ms(G1GCPhaseTimes::ObjCopy) + phase_times()->average_time_ms(G1GCPhaseTimes::Termination));
@@ -1176,12 +1239,14 @@ void G1CollectorPolicy::record_collection_pause_end(double pause_time_ms, Evacua
 
     _pending_cards_seq->add((double) _pending_cards);
     _rs_lengths_seq->add((double) _max_rs_lengths);
+    _bytes_copied_seq->add((double) _bytes_copied_during_gc);
   }
 
   _in_marking_window = new_in_marking_window;
   _in_marking_window_im = new_in_marking_window_im;
   _free_regions_at_end_of_collection = _g1->num_free_regions();
   update_young_list_target_length();
+  update_ihop_prediction(end_time_sec, this_gc_was_young_only);
 
   // Note that _mmu_tracker->max_gc_time() returns the time in seconds.
   double update_rs_time_goal_ms = _mmu_tracker->max_gc_time() * MILLIUNITS * G1RSetUpdatingPauseTimePercent / 100.0;
@@ -1191,6 +1256,36 @@ void G1CollectorPolicy::record_collection_pause_end(double pause_time_ms, Evacua
   _collectionSetChooser->verify();
 }
 
+void G1CollectorPolicy::update_ihop_prediction(double end_time_sec,
+                                               bool this_gc_was_young_only) {
+  size_t cur_non_young_bytes = _g1->non_young_capacity_bytes();
+
+  // Only young-only pauses give a clean picture of how fast the old gen
+  // fills up: mixed GCs reclaim old regions and would hide the
+  // promotions and humongous allocations that happened since the last
+  // pause.
+  if (this_gc_was_young_only && _ihop_last_pause_end_sec > 0.0) {
+    double allocation_time_s = end_time_sec - _ihop_last_pause_end_sec;
+    size_t allocated_bytes = 0;
+    if (cur_non_young_bytes > _ihop_last_non_young_bytes) {
+      allocated_bytes = cur_non_young_bytes - _ihop_last_non_young_bytes;
+    }
+    _ihop_control->update_allocation_info(allocation_time_s,
+                                          allocated_bytes,
+                                          young_list_target_length() * HeapRegion::GrainBytes);
+  }
+  _ihop_last_pause_end_sec = end_time_sec;
+  _ihop_last_non_young_bytes = cur_non_young_bytes;
+
+  _ihop_control->update_target_occupancy(_g1->capacity());
+  report_ihop_statistics();
+}
+
+void G1CollectorPolicy::report_ihop_statistics() {
+  _ihop_control->print();
+  _ihop_control->send_to_monitoring(_g1->g1mm());
+}
+
 #define EXT_SIZE_FORMAT "%.1f%s"
 #define EXT_SIZE_PARAMS(bytes)                                  \
   byte_size_in_proper_unit((double)(bytes)),                    \
@@ -1343,9 +1438,12 @@ G1CollectorPolicy::predict_region_elapsed_time_ms(HeapRegion* hr,
   }
   size_t bytes_to_copy = predict_bytes_to_copy(hr);
 
-  double region_elapsed_time_ms =
-    predict_rs_scan_time_ms(card_num) +
-    predict_object_copy_time_ms(bytes_to_copy);
+  double region_elapsed_time_ms = predict_rs_scan_time_ms(card_num);
+  if (hr->is_young()) {
+    region_elapsed_time_ms += predict_object_copy_time_ms(bytes_to_copy);
+  } else {
+    region_elapsed_time_ms += predict_old_object_copy_time_ms(bytes_to_copy);
+  }
 
   // The prediction of the "other" time for this region is based
   // upon the region type and NOT the GC type.
@@ -1563,8 +1661,11 @@ public:
       // before we fill them up).
       if (_hrSorted->should_add(r) && !_g1h->is_old_gc_alloc_region(r)) {
         _hrSorted->add_region(r);
+        return false;
       }
     }
+    // The region will not be collected during this cycle.
+    _g1h->g1_policy()->remset_tracker()->drop_rem_set(r);
     return false;
   }
 };
@@ -1587,8 +1688,11 @@ public:
       // before we fill them up).
       if (_cset_updater.should_add(r) && !_g1h->is_old_gc_alloc_region(r)) {
         _cset_updater.add_region(r);
+        return false;
       }
     }
+    // The region will not be collected during this cycle.
+    _g1h->g1_policy()->remset_tracker()->drop_rem_set(r);
     return false;
   }
 };
@@ -1663,7 +1767,9 @@ G1CollectorPolicy::record_concurrent_mark_cleanup_end(int no_of_gc_threads) {
 
 // Add the heap region at the head of the non-incremental collection set
 void G1CollectorPolicy::add_old_region_to_cset(HeapRegion* hr) {
-  assert(_inc_cset_build_state == Active, "Precondition");
+  assert(_inc_cset_build_state == Active ||
+         (_inc_cset_build_state == Inactive && hr == _optional_cset_regions->at(_optional_cset_regions_added)),
+         "Precondition");
   assert(hr->is_old(), "the region should be old");
 
   assert(!hr->in_collection_set(), "should not already be in the CSet");
@@ -1671,12 +1777,63 @@ void G1CollectorPolicy::add_old_region_to_cset(HeapRegion* hr) {
   hr->set_next_in_collection_set(_collection_set);
   _collection_set = hr;
   _collection_set_bytes_used_before += hr->used();
+  _old_cset_bytes_to_copy += predict_bytes_to_copy(hr);
   _g1->register_old_region_with_in_cset_fast_test(hr);
   size_t rs_length = hr->rem_set()->occupied();
   _recorded_rs_lengths += rs_length;
   _old_cset_region_length += 1;
 }
 
+void G1CollectorPolicy::add_optional_region(HeapRegion* hr) {
+  assert(_inc_cset_build_state == Active, "Precondition");
+  assert(hr->is_old(), "the region should be old");
+  assert(!hr->in_collection_set(), "should not already be in the CSet");
+
+  _optional_cset_regions->append(hr);
+  _g1->register_optional_region_with_in_cset_fast_test(hr);
+}
+
+uint G1CollectorPolicy::add_optional_regions_to_cset(double time_remaining_ms,
+                                                     GrowableArray<HeapRegion*>* selected_regions) {
+  assert(_inc_cset_build_state == Inactive, "Precondition");
+
+  uint num_added = 0;
+  while (_optional_cset_regions_added < _optional_cset_regions->length()) {
+    HeapRegion* hr = _optional_cset_regions->at(_optional_cset_regions_added);
+    double predicted_time_ms = predict_region_elapsed_time_ms(hr, false /* for_young_gc */);
+    if (predicted_time_ms > time_remaining_ms) {
+      break;
+    }
+    time_remaining_ms -= predicted_time_ms;
+    _predicted_pause_time_ms += predicted_time_ms;
+    _g1->old_set_remove(hr);
+    add_old_region_to_cset(hr);
+    _optional_cset_regions_added += 1;
+    selected_regions->append(hr);
+    num_added += 1;
+  }
+
+  ergo_verbose3(ErgoCSetConstruction,
+                "add optional regions to CSet",
+                ergo_format_region("added")
+                ergo_format_region("remaining")
+                ergo_format_ms("remaining time"),
+                num_added, optional_cset_region_length(), time_remaining_ms);
+  return num_added;
+}
+
+void G1CollectorPolicy::abandon_optional_cset_regions() {
+  // Return the remaining regions in the reverse order in which they were
+  // taken from the CSet chooser.
+  for (int i = _optional_cset_regions->length() - 1; i >= _optional_cset_regions_added; i--) {
+    HeapRegion* hr = _optional_cset_regions->at(i);
+    _g1->clear_optional_region_in_cset_fast_test(hr);
+    _collectionSetChooser->push(hr);
+  }
+  _optional_cset_regions->clear();
+  _optional_cset_regions_added = 0;
+}
+
 // Initialize the per-collection-set information
 void G1CollectorPolicy::start_incremental_cset_building() {
   assert(_inc_cset_build_state == Inactive, "Precondition");
@@ -1868,6 +2025,16 @@ double G1CollectorPolicy::reclaimable_bytes_perc(size_t reclaimable_bytes) {
   return (double) reclaimable_bytes * 100.0 / (double) capacity_bytes;
 }
 
+void G1CollectorPolicy::abandon_collection_set_candidates() {
+  CollectionSetChooser* cset_chooser = _collectionSetChooser;
+  while (!cset_chooser->is_empty()) {
+    HeapRegion* hr = cset_chooser->peek();
+    _remset_tracker.drop_rem_set(hr);
+    cset_chooser->remove_and_move_to_next(hr);
+  }
+  cset_chooser->clear();
+}
+
 bool G1CollectorPolicy::next_gc_should_be_mixed(const char* true_action_str,
                                                 const char* false_action_str) {
   CollectionSetChooser* cset_chooser = _collectionSetChooser;
@@ -2030,10 +2197,26 @@ void G1CollectorPolicy::finalize_cset(double target_pause_time_ms, EvacuationInf
 
     uint expensive_region_num = 0;
     bool check_time_remaining = adaptive_young_list_length();
+    // Once the predicted time of the next region no longer fits, further
+    // regions may still be chosen as optional regions, to be evacuated only
+    // if the pause turns out to have time left.
+    bool use_optional_regions = G1UseOptionalCSetRegions &&
+                                check_time_remaining &&
+                                !during_initial_mark_pause();
+    bool add_as_optional = false;
 
     HeapRegion* hr = cset_chooser->peek();
     while (hr != NULL) {
-      if (old_cset_region_length() >= max_old_cset_length) {
+      if (hr->has_pinned_objects()) {
+        // Its objects may not move; drop it from the candidates until the
+        // next marking cycle finds it again, without counting it against
+        // any of the limits below.
+        cset_chooser->remove_and_move_to_next(hr);
+        _remset_tracker.drop_rem_set(hr);
+        hr = cset_chooser->peek();
+        continue;
+      }
+      if (old_cset_region_length() + optional_cset_region_length() >= max_old_cset_length) {
         // Added maximum number of old regions to the CSet.
         ergo_verbose2(ErgoCSetConstruction,
                       "finish adding old regions to CSet",
@@ -2069,15 +2252,16 @@ void G1CollectorPolicy::finalize_cset(double target_pause_time_ms, EvacuationInf
       }
 
       double predicted_time_ms = predict_region_elapsed_time_ms(hr, gcs_are_young());
-      if (check_time_remaining) {
+      if (check_time_remaining && !add_as_optional) {
         if (predicted_time_ms > time_remaining_ms) {
           // Too expensive for the current CSet.
 
           if (old_cset_region_length() >= min_old_cset_length) {
             // We have added the minimum number of old regions to the CSet,
-            // we are done with this CSet.
+            // we are done with this CSet apart from optional regions.
             ergo_verbose4(ErgoCSetConstruction,
-                          "finish adding old regions to CSet",
+                          use_optional_regions ? "start adding optional regions to CSet"
+                                               : "finish adding old regions to CSet",
                           ergo_format_reason("predicted time is too high")
                           ergo_format_ms("predicted time")
                           ergo_format_ms("remaining time")
@@ -2085,14 +2269,17 @@ void G1CollectorPolicy::finalize_cset(double target_pause_time_ms, EvacuationInf
                           ergo_format_region("min"),
                           predicted_time_ms, time_remaining_ms,
                           old_cset_region_length(), min_old_cset_length);
-            break;
+            if (!use_optional_regions) {
+              break;
+            }
+            add_as_optional = true;
+          } else {
+            // We'll add it anyway given that we haven't reached the
+            // minimum number of old regions.
+            expensive_region_num += 1;
           }
-
-          // We'll add it anyway given that we haven't reached the
-          // minimum number of old regions.
-          expensive_region_num += 1;
         }
-      } else {
+      } else if (!check_time_remaining) {
         if (old_cset_region_length() >= min_old_cset_length) {
           // In the non-auto-tuning case, we'll finish adding regions
           // to the CSet if we reach the minimum.
@@ -2107,11 +2294,15 @@ void G1CollectorPolicy::finalize_cset(double target_pause_time_ms, EvacuationInf
       }
 
       // We will add this region to the CSet.
-      time_remaining_ms = MAX2(time_remaining_ms - predicted_time_ms, 0.0);
-      predicted_pause_time_ms += predicted_time_ms;
       cset_chooser->remove_and_move_to_next(hr);
-      _g1->old_set_remove(hr);
-      add_old_region_to_cset(hr);
+      if (add_as_optional) {
+        add_optional_region(hr);
+      } else {
+        time_remaining_ms = MAX2(time_remaining_ms - predicted_time_ms, 0.0);
+        predicted_pause_time_ms += predicted_time_ms;
+        _g1->old_set_remove(hr);
+        add_old_region_to_cset(hr);
+      }
 
       hr = cset_chooser->peek();
     }
@@ -2143,16 +2334,19 @@ void G1CollectorPolicy::finalize_cset(double target_pause_time_ms, EvacuationInf
 
   stop_incremental_cset_building();
 
-  ergo_verbose5(ErgoCSetConstruction,
+  ergo_verbose6(ErgoCSetConstruction,
                 "finish choosing CSet",
                 ergo_format_region("eden")
                 ergo_format_region("survivors")
                 ergo_format_region("old")
+                ergo_format_region("optional")
                 ergo_format_ms("predicted pause time")
                 ergo_format_ms("target pause time"),
                 eden_region_length, survivor_region_length,
-                old_cset_region_length(),
+                old_cset_region_length(), optional_cset_region_length(),
                 predicted_pause_time_ms, target_pause_time_ms);
+  _predicted_pause_time_ms = predicted_pause_time_ms;
+  _predicted_pause_target_ms = target_pause_time_ms;
 
   double non_young_end_time_sec = os::elapsedTime();
   phase_times()->record_non_young_cset_choice_time_ms((non_young_end_time_sec - non_young_start_time_sec) * 1000.0);
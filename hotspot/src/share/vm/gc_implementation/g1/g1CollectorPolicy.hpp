@@ -28,6 +28,7 @@
 #include "gc_implementation/g1/collectionSetChooser.hpp"
 #include "gc_implementation/g1/g1Allocator.hpp"
 #include "gc_implementation/g1/g1MMUTracker.hpp"
+#include "gc_implementation/g1/g1RemSetTrackingPolicy.hpp"
 #include "memory/collectorPolicy.hpp"
 
 // A G1CollectorPolicy makes policy decisions that determine the
@@ -38,6 +39,7 @@
 class HeapRegion;
 class CollectionSetChooser;
 class G1GCPhaseTimes;
+class G1IHOPControl;
 
 // TraceGen0Time collects data on _both_ young and mixed evacuation pauses
 // (the latter may contain non-young regions - i.e. regions that are
@@ -183,6 +185,8 @@ private:
 
   CollectionSetChooser* _collectionSetChooser;
 
+  G1RemSetTrackingPolicy _remset_tracker;
+
   double _full_collection_start_sec;
   uint   _cur_collection_pause_used_regions_at_start;
 
@@ -240,12 +244,16 @@ private:
   TruncatedSeq* _cost_per_entry_ms_seq;
   TruncatedSeq* _mixed_cost_per_entry_ms_seq;
   TruncatedSeq* _cost_per_byte_ms_seq;
+  // Copy cost of the live data of old regions, which tends to be denser
+  // in references than that of young regions
+  TruncatedSeq* _old_cost_per_byte_ms_seq;
   TruncatedSeq* _constant_other_time_ms_seq;
   TruncatedSeq* _young_other_cost_per_region_ms_seq;
   TruncatedSeq* _non_young_other_cost_per_region_ms_seq;
 
   TruncatedSeq* _pending_cards_seq;
   TruncatedSeq* _rs_lengths_seq;
+  TruncatedSeq* _bytes_copied_seq;
 
   TruncatedSeq* _cost_per_byte_ms_during_cm_seq;
 
@@ -332,6 +340,20 @@ public:
     return (size_t) get_new_prediction(_rs_length_diff_seq);
   }
 
+  // Predictions of the work of the next pause used to size the set of
+  // active GC workers; only meaningful once a pause has been recorded.
+  bool has_pause_work_history() {
+    return _bytes_copied_seq->num() > 0;
+  }
+
+  size_t predict_bytes_copied() {
+    return (size_t) get_new_prediction(_bytes_copied_seq);
+  }
+
+  size_t predict_rs_lengths() {
+    return (size_t) get_new_prediction(_rs_lengths_seq);
+  }
+
   double predict_alloc_rate_ms() {
     return get_new_prediction(_alloc_rate_ms_seq);
   }
@@ -402,6 +424,15 @@ public:
     }
   }
 
+  double predict_old_object_copy_time_ms(size_t bytes_to_copy) {
+    if (_old_cost_per_byte_ms_seq->num() < 3) {
+      return predict_object_copy_time_ms(bytes_to_copy);
+    } else {
+      return (double) bytes_to_copy *
+             get_new_prediction(_old_cost_per_byte_ms_seq);
+    }
+  }
+
   double predict_constant_other_time_ms() {
     return get_new_prediction(_constant_other_time_ms_seq);
   }
@@ -442,6 +473,10 @@ public:
     return _mmu_tracker;
   }
 
+  G1RemSetTrackingPolicy* remset_tracker() {
+    return &_remset_tracker;
+  }
+
   double max_pause_time_ms() {
     return _mmu_tracker->max_gc_time() * 1000.0;
   }
@@ -482,6 +517,14 @@ private:
   // Add a new GC of the given duration and end time to the record.
   void update_recent_gc_times(double end_time_sec, double elapsed_ms);
 
+public:
+  // The end time of the most recent young or full collection pause.
+  double last_gc_end_sec() const {
+    return _recent_prev_end_times_for_all_gcs_sec->last();
+  }
+
+private:
+
   // The head of the list (via "next_in_collection_set()") representing the
   // current collection set. Set from the incrementally built collection
   // set at the start of the pause.
@@ -493,6 +536,17 @@ private:
   // (if any) to the collection set.
   size_t _collection_set_bytes_used_before;
 
+  // Old regions that were chosen for the collection set but will only be
+  // evacuated if there is time left in the pause after evacuating the
+  // collection set proper. They are kept in the order they were taken from
+  // the CSet chooser; the first _optional_cset_regions_added of them have
+  // been moved into the collection set so far.
+  GrowableArray<HeapRegion*>* _optional_cset_regions;
+  int _optional_cset_regions_added;
+
+  // Record hr as an optional collection set region.
+  void add_optional_region(HeapRegion* hr);
+
   // The number of bytes copied during the GC.
   size_t _bytes_copied_during_gc;
 
@@ -518,6 +572,14 @@ private:
   // an evacuation pause.
   size_t _inc_cset_bytes_used_before;
 
+  // The live bytes of the old regions in the collection set
+  size_t _old_cset_bytes_to_copy;
+
+  // The pause time predicted for the current collection set, and the
+  // target it was chosen for
+  double _predicted_pause_time_ms;
+  double _predicted_pause_target_ms;
+
   // Used to record the highest end of heap region in collection set
   HeapWord* _inc_cset_max_finger;
 
@@ -583,6 +645,23 @@ private:
 
   bool _last_young_gc;
 
+  // Decides the occupancy at which concurrent marking is started.
+  G1IHOPControl* _ihop_control;
+  // Time stamp of the end of the last initial-mark pause, in seconds, or
+  // zero if there is no completed initial-mark pause whose marking cycle
+  // has not yet led to a mixed GC.
+  double _initial_mark_end_sec;
+  // Time stamp of the end of the last evacuation pause and the old gen
+  // occupancy at that time; used to feed old gen allocation rates into
+  // the IHOP calculation.
+  double _ihop_last_pause_end_sec;
+  size_t _ihop_last_non_young_bytes;
+
+  // Pass the old gen allocation information since the last pause and any
+  // marking length to the IHOP control.
+  void update_ihop_prediction(double end_time_sec, bool this_gc_was_young_only);
+  void report_ihop_statistics();
+
   // This set of variables tracks the collector efficiency, in order to
   // determine whether we should initiate a new marking.
   double _cur_mark_stop_world_time_ms;
@@ -723,6 +802,10 @@ public:
   bool next_gc_should_be_mixed(const char* true_action_str,
                                const char* false_action_str);
 
+  // Drops the remembered sets of the remaining candidate old regions
+  // once we decided not to do (any more) mixed GCs in this cycle.
+  void abandon_collection_set_candidates();
+
   // Choose a new collection set.  Marks the chosen regions as being
   // "in_collection_set", and links them together.  The head and number of
   // the collection set are available via access methods.
@@ -737,6 +820,23 @@ public:
   // Add old region "hr" to the CSet.
   void add_old_region_to_cset(HeapRegion* hr);
 
+  // The number of optional collection set regions that have not been
+  // added to the collection set yet.
+  uint optional_cset_region_length() const {
+    return (uint)(_optional_cset_regions->length() - _optional_cset_regions_added);
+  }
+
+  // Move the next optional regions into the collection set, as many as the
+  // predicted evacuation times fit into time_remaining_ms. The added
+  // regions are appended to selected_regions. Returns the number of regions
+  // added.
+  uint add_optional_regions_to_cset(double time_remaining_ms,
+                                    GrowableArray<HeapRegion*>* selected_regions);
+
+  // Return the optional regions that have not been added to the collection
+  // set to the CSet chooser, so that later mixed GCs may still collect them.
+  void abandon_optional_cset_regions();
+
   // Incremental CSet Support
 
   // The head of the incrementally built collection set.
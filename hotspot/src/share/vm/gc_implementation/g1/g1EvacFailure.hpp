@@ -161,9 +161,10 @@ public:
     } else {
 
       // The object has been either evacuated or is dead. Fill it with a
-      // dummy object.
+      // dummy object. In a pinned region only the header is overwritten,
+      // see HeapRegion::prepare_pinned_for_compaction().
       MemRegion mr(obj_addr, obj_size);
-      CollectedHeap::fill_with_object(mr);
+      CollectedHeap::fill_with_object(mr, !_hr->has_pinned_objects() /* zap */);
 
       // must nuke all dead objects which we skipped when iterating over the region
       _cm->clearRangePrevBitmap(MemRegion(_end_of_last_gap, obj_end));
@@ -247,4 +248,25 @@ public:
   }
 };
 
+// Restores the marks the workers preserved before installing
+// self-forwarding pointers. Each worker restores its own stacks, and
+// those of any worker beyond the number of active workers.
+class G1ParRestorePreservedMarksTask: public AbstractGangTask {
+protected:
+  G1CollectedHeap* _g1h;
+  uint _n_workers;
+
+public:
+  G1ParRestorePreservedMarksTask(G1CollectedHeap* g1h, uint n_workers) :
+    AbstractGangTask("G1 Restore Preserved Marks"),
+    _g1h(g1h), _n_workers(MAX2(n_workers, 1U)) { }
+
+  void work(uint worker_id) {
+    uint n_queues = MAX2((uint)ParallelGCThreads, 1U);
+    for (uint i = worker_id; i < n_queues; i += _n_workers) {
+      _g1h->restore_preserved_marks(i);
+    }
+  }
+};
+
 #endif // SHARE_VM_GC_IMPLEMENTATION_G1_G1EVACFAILURE_HPP
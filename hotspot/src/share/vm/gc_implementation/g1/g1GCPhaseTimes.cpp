@@ -352,6 +352,9 @@ double G1GCPhaseTimes::accounted_time_ms() {
     // Strong code root purge time
     misc_time_ms += _cur_strong_code_root_purge_time_ms;
 
+    // Optional collection set evacuation time
+    misc_time_ms += _cur_optional_evac_time_ms;
+
     if (G1StringDedup::is_enabled()) {
       // String dedup fixup time
       misc_time_ms += _cur_string_dedup_fixup_time_ms;
@@ -525,6 +528,13 @@ void G1GCPhaseTimes::print(double pause_time_sec) {
     par_phase_printer.print((GCParPhases) i);
   }
 
+  if (_cur_optional_regions_evacuated + _cur_optional_regions_abandoned > 0) {
+    print_stats(1, "Optional Evacuation", _cur_optional_evac_time_ms);
+    if (G1Log::finest()) {
+      print_stats(2, "Optional Regions Evacuated", _cur_optional_regions_evacuated);
+      print_stats(2, "Optional Regions Abandoned", _cur_optional_regions_abandoned);
+    }
+  }
   print_stats(1, "Code Root Fixup", _cur_collection_code_root_fixup_time_ms);
   print_stats(1, "Code Root Purge", _cur_strong_code_root_purge_time_ms);
   if (G1StringDedup::is_enabled()) {
@@ -85,6 +85,10 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
   double _cur_collection_code_root_fixup_time_ms;
   double _cur_strong_code_root_purge_time_ms;
 
+  double _cur_optional_evac_time_ms;
+  size_t _cur_optional_regions_evacuated;
+  size_t _cur_optional_regions_abandoned;
+
   double _cur_evac_fail_recalc_used;
   double _cur_evac_fail_restore_remsets;
   double _cur_evac_fail_remove_self_forwards;
@@ -167,6 +171,12 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
     _cur_strong_code_root_purge_time_ms = ms;
   }
 
+  void record_optional_evacuation(double ms, size_t evacuated, size_t abandoned) {
+    _cur_optional_evac_time_ms = ms;
+    _cur_optional_regions_evacuated = evacuated;
+    _cur_optional_regions_abandoned = abandoned;
+  }
+
   void record_evac_fail_recalc_used_time(double ms) {
     _cur_evac_fail_recalc_used = ms;
   }
@@ -30,19 +30,41 @@
 #include "runtime/atomic.hpp"
 
 G1HotCardCache::G1HotCardCache(G1CollectedHeap *g1h):
-  _g1h(g1h), _hot_cache(NULL), _use_cache(false), _card_counts(g1h) {}
+  _g1h(g1h), _hot_cache(NULL), _use_cache(false), _card_counts(g1h),
+  _stripes(NULL), _num_stripes(0) {}
 
-void G1HotCardCache::initialize(G1RegionToSpaceMapper* card_counts_storage) {
+void G1HotCardCache::initialize(G1RegionToSpaceMapper* card_counts_storage,
+                                uint num_refinement_threads) {
   if (default_use_cache()) {
     _use_cache = true;
 
-    _hot_cache_size = (size_t)1 << G1ConcRSLogCacheSize;
+    size_t initial_size = (size_t)1 << G1ConcRSLogCacheSize;
+    _num_stripes = 1;
+    if (num_refinement_threads > 1 && initial_size >= 2 * ClaimChunkSize) {
+      _num_stripes = MIN2((uint)1 << log2_intptr((intptr_t)num_refinement_threads),
+                          (uint)(initial_size / ClaimChunkSize));
+    }
+    size_t initial_stripe_size = initial_size / _num_stripes;
+    _stripe_capacity = initial_stripe_size;
+    _min_stripe_size = initial_stripe_size;
+    if (G1UseAdaptiveHotCardCacheSize) {
+      _stripe_capacity = initial_stripe_size * MaxGrowthFactor;
+      _min_stripe_size = MIN2(initial_stripe_size, (size_t)ClaimChunkSize);
+    }
+
+    _hot_cache_size = _stripe_capacity * _num_stripes;
     _hot_cache = NEW_C_HEAP_ARRAY(jbyte*, _hot_cache_size, mtGC);
+    _stripes = NEW_C_HEAP_ARRAY(Stripe, _num_stripes, mtGC);
+    for (uint i = 0; i < _num_stripes; i++) {
+      _stripes[i]._cache = _hot_cache + i * _stripe_capacity;
+      _stripes[i]._size = initial_stripe_size;
+    }
 
     reset_hot_cache_internal();
 
-    // For refining the cards in the hot cache in parallel
-    _hot_cache_par_chunk_size = (int)(ParallelGCThreads > 0 ? ClaimChunkSize : _hot_cache_size);
+    // For refining the cards in the hot cache in parallel. The chunks
+    // do not span stripes, which each fill up from their start.
+    _hot_cache_par_chunk_size = (int)(ParallelGCThreads > 0 || _num_stripes > 1 ? ClaimChunkSize : _hot_cache_size);
     _hot_cache_par_claimed_idx = 0;
 
     _card_counts.initialize(card_counts_storage);
@@ -53,10 +75,20 @@ G1HotCardCache::~G1HotCardCache() {
   if (default_use_cache()) {
     assert(_hot_cache != NULL, "Logic");
     FREE_C_HEAP_ARRAY(jbyte*, _hot_cache, mtGC);
+    FREE_C_HEAP_ARRAY(Stripe, _stripes, mtGC);
+  }
+}
+
+void G1HotCardCache::resize_stripe(Stripe* stripe) {
+  size_t inserted = stripe->_index;
+  if (inserted > stripe->_size && stripe->_size < _stripe_capacity) {
+    stripe->_size *= 2;
+  } else if (inserted < stripe->_size / 4 && stripe->_size > _min_stripe_size) {
+    stripe->_size /= 2;
   }
 }
 
-jbyte* G1HotCardCache::insert(jbyte* card_ptr) {
+jbyte* G1HotCardCache::insert(jbyte* card_ptr, uint worker_i) {
   uint count = _card_counts.add_card_count(card_ptr);
   if (!_card_counts.is_hot(count)) {
     // The card is not hot so do not store it in the cache;
@@ -64,9 +96,10 @@ jbyte* G1HotCardCache::insert(jbyte* card_ptr) {
     return card_ptr;
   }
   // Otherwise, the card is hot.
-  size_t index = Atomic::add_ptr((intptr_t)1, (volatile intptr_t*)&_hot_cache_idx) - 1;
-  size_t masked_index = index & (_hot_cache_size - 1);
-  jbyte* current_ptr = _hot_cache[masked_index];
+  Stripe* stripe = &_stripes[worker_i & (_num_stripes - 1)];
+  size_t index = Atomic::add_ptr((intptr_t)1, (volatile intptr_t*)&stripe->_index) - 1;
+  size_t masked_index = index & (stripe->_size - 1);
+  jbyte* current_ptr = stripe->_cache[masked_index];
 
   // Try to store the new card pointer into the cache. Compare-and-swap to guard
   // against the unlikely event of a race resulting in another card pointer to
@@ -75,7 +108,7 @@ jbyte* G1HotCardCache::insert(jbyte* card_ptr) {
   // should be OK since card_ptr will likely be the older card already when/if
   // this ever happens.
   jbyte* previous_ptr = (jbyte*)Atomic::cmpxchg_ptr(card_ptr,
-                                                    &_hot_cache[masked_index],
+                                                    &stripe->_cache[masked_index],
                                                     current_ptr);
   return (previous_ptr == current_ptr) ? previous_ptr : card_ptr;
 }
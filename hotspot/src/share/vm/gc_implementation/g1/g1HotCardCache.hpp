@@ -52,29 +52,56 @@ class HeapRegion;
 //
 // This can significantly reduce the overhead of the write barrier
 // code, increasing throughput.
+//
+// The cache is split into stripes, one per refinement thread rounded
+// down to a power of two, so that the threads do not all contend on one
+// insertion index. A thread inserts into the stripe its worker id maps
+// to. With G1UseAdaptiveHotCardCacheSize, the part of each stripe in use
+// is resized at every pause from the number of hot cards inserted into
+// it since the previous one.
 
 class G1HotCardCache: public CHeapObj<mtGC> {
 
+  // The part of the cache the threads with the worker ids mapping to it
+  // insert into
+  class Stripe VALUE_OBJ_CLASS_SPEC {
+   public:
+    jbyte**         _cache;        // _stripe_capacity slots in _hot_cache
+    size_t          _size;         // slots in use, a power of two
+
+    // Avoids false sharing between the indexes of the stripes
+    char            _pad_before[DEFAULT_CACHE_LINE_SIZE];
+
+    volatile size_t _index;        // hot cards inserted since the last pause
+
+    char            _pad_after[DEFAULT_CACHE_LINE_SIZE];
+  };
+
   G1CollectedHeap*  _g1h;
 
   bool              _use_cache;
 
   G1CardCounts      _card_counts;
 
-  // The card cache table
+  // The card cache table, the stripes one after the other
   jbyte**           _hot_cache;
 
   size_t            _hot_cache_size;
 
+  Stripe*           _stripes;
+
+  uint              _num_stripes;       // a power of two
+
+  size_t            _stripe_capacity;
+
+  size_t            _min_stripe_size;
+
   int               _hot_cache_par_chunk_size;
 
-  // Avoids false sharing when concurrently updating _hot_cache_idx or
-  // _hot_cache_par_claimed_idx. These are never updated at the same time
-  // thus it's not necessary to separate them as well
+  // Avoids false sharing with the last stripe when concurrently
+  // updating _hot_cache_par_claimed_idx.
   char _pad_before[DEFAULT_CACHE_LINE_SIZE];
 
-  volatile size_t _hot_cache_idx;
-
   volatile size_t _hot_cache_par_claimed_idx;
 
   char _pad_after[DEFAULT_CACHE_LINE_SIZE];
@@ -82,15 +109,24 @@ class G1HotCardCache: public CHeapObj<mtGC> {
   // The number of cached cards a thread claims when flushing the cache
   static const int ClaimChunkSize = 32;
 
+  // How many times the initial size an adaptively sized stripe can grow to
+  static const int MaxGrowthFactor = 4;
+
   bool default_use_cache() const {
     return (G1ConcRSLogCacheSize > 0);
   }
 
+  // Grows the stripe if it had to evict hot cards since the last pause,
+  // which were then refined over and over, and shrinks it if most of it
+  // stayed empty.
+  void resize_stripe(Stripe* stripe);
+
  public:
   G1HotCardCache(G1CollectedHeap* g1h);
   ~G1HotCardCache();
 
-  void initialize(G1RegionToSpaceMapper* card_counts_storage);
+  // num_refinement_threads decides the number of stripes
+  void initialize(G1RegionToSpaceMapper* card_counts_storage, uint num_refinement_threads);
 
   bool use_cache() { return _use_cache; }
 
@@ -107,7 +143,7 @@ class G1HotCardCache: public CHeapObj<mtGC> {
   // adding, NULL is returned and no further action in needed.
   // If we evict a card from the cache to make room for the new card,
   // the evicted card is then returned for refinement.
-  jbyte* insert(jbyte* card_ptr);
+  jbyte* insert(jbyte* card_ptr, uint worker_i);
 
   // Refine the cards that have delayed as a result of
   // being in the cache.
@@ -123,10 +159,26 @@ class G1HotCardCache: public CHeapObj<mtGC> {
     assert(SafepointSynchronize::is_at_safepoint(), "Should be at a safepoint");
     assert(Thread::current()->is_VM_thread(), "Current thread should be the VMthread");
     if (default_use_cache()) {
-        reset_hot_cache_internal();
+      reset_hot_cache_internal();
     }
   }
 
+  // Resizes the stripes and ages the card counts, then resets the hot
+  // card cache. Called at the end of every evacuation pause; a full GC
+  // only resets the cache, as it says nothing about refinement.
+  void reset_hot_cache_after_evacuation() {
+    assert(SafepointSynchronize::is_at_safepoint(), "Should be at a safepoint");
+    if (default_use_cache()) {
+      if (G1UseAdaptiveHotCardCacheSize) {
+        for (uint i = 0; i < _num_stripes; i++) {
+          resize_stripe(&_stripes[i]);
+        }
+      }
+      _card_counts.note_pause();
+    }
+    reset_hot_cache();
+  }
+
   // Zeros the values in the card counts table for entire committed heap
   void reset_card_counts();
 
@@ -136,7 +188,9 @@ class G1HotCardCache: public CHeapObj<mtGC> {
  private:
   void reset_hot_cache_internal() {
     assert(_hot_cache != NULL, "Logic");
-    _hot_cache_idx = 0;
+    for (uint i = 0; i < _num_stripes; i++) {
+      _stripes[i]._index = 0;
+    }
     for (size_t i = 0; i < _hot_cache_size; i++) {
       _hot_cache[i] = NULL;
     }
@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "gc_implementation/g1/g1CollectedHeap.inline.hpp"
+#include "gc_implementation/g1/g1ErgoVerbose.hpp"
+#include "gc_implementation/g1/g1IHOPControl.hpp"
+#include "gc_implementation/g1/g1MonitoringSupport.hpp"
+#include "gc_implementation/g1/g1_globals.hpp"
+
+G1IHOPControl::G1IHOPControl(double initial_ihop_percent) :
+  _initial_ihop_percent(initial_ihop_percent),
+  _target_occupancy(0),
+  _last_allocation_time_s(0.0),
+  _last_allocated_bytes(0)
+{
+  assert(_initial_ihop_percent >= 0.0 && _initial_ihop_percent <= 100.0,
+         err_msg("Initial IHOP value must be between 0 and 100 but is %.3f", initial_ihop_percent));
+}
+
+G1IHOPControl* G1IHOPControl::create_ihop_control(double sigma) {
+  if (G1UseAdaptiveIHOP) {
+    return new G1AdaptiveIHOPControl(InitiatingHeapOccupancyPercent,
+                                     sigma,
+                                     G1ReservePercent,
+                                     G1HeapWastePercent);
+  } else {
+    return new G1StaticIHOPControl(InitiatingHeapOccupancyPercent);
+  }
+}
+
+void G1IHOPControl::update_target_occupancy(size_t new_target_occupancy) {
+  _target_occupancy = new_target_occupancy;
+}
+
+void G1IHOPControl::update_allocation_info(double allocation_time_s, size_t allocated_bytes, size_t additional_buffer_size) {
+  assert(allocation_time_s >= 0.0, err_msg("Allocation time must be positive but is %.3f", allocation_time_s));
+
+  _last_allocation_time_s = allocation_time_s;
+  _last_allocated_bytes = allocated_bytes;
+}
+
+void G1IHOPControl::print() {
+  assert(_target_occupancy > 0, "Target occupancy still not updated yet.");
+  size_t cur_conc_mark_start_threshold = get_conc_mark_start_threshold();
+  ergo_verbose6(ErgoIHOP,
+                "basic information",
+                ergo_format_byte_perc("threshold")
+                ergo_format_byte("target occupancy")
+                ergo_format_byte("recent allocation size")
+                ergo_format_ms("recent allocation duration")
+                ergo_format_ms("recent marking duration"),
+                cur_conc_mark_start_threshold,
+                cur_conc_mark_start_threshold * 100.0 / _target_occupancy,
+                _target_occupancy,
+                _last_allocated_bytes,
+                _last_allocation_time_s * 1000.0,
+                last_marking_length_s() * 1000.0);
+}
+
+void G1IHOPControl::send_to_monitoring(G1MonitoringSupport* g1mm) {
+  g1mm->update_ihop_stats(get_conc_mark_start_threshold(),
+                          _target_occupancy,
+                          last_marking_length_s() * 1000.0,
+                          _last_allocation_time_s > 0.0 ? _last_allocated_bytes / _last_allocation_time_s : 0.0);
+}
+
+G1StaticIHOPControl::G1StaticIHOPControl(double ihop_percent) :
+  G1IHOPControl(ihop_percent),
+  _last_marking_length_s(0.0) {
+}
+
+G1AdaptiveIHOPControl::G1AdaptiveIHOPControl(double ihop_percent,
+                                             double sigma,
+                                             size_t heap_reserve_percent,
+                                             size_t heap_waste_percent) :
+  G1IHOPControl(ihop_percent),
+  _heap_reserve_percent(heap_reserve_percent),
+  _heap_waste_percent(heap_waste_percent),
+  _sigma(sigma),
+  _marking_times_s(10, 0.95),
+  _allocation_rate_s(10, 0.95),
+  _last_unrestrained_young_size(0)
+{
+}
+
+double G1AdaptiveIHOPControl::predict(const TruncatedSeq* seq) const {
+  return seq->davg() + _sigma * seq->dsd();
+}
+
+bool G1AdaptiveIHOPControl::have_enough_data_for_prediction() const {
+  return ((size_t)_marking_times_s.num() >= G1AdaptiveIHOPNumInitialSamples) &&
+         ((size_t)_allocation_rate_s.num() >= G1AdaptiveIHOPNumInitialSamples);
+}
+
+size_t G1AdaptiveIHOPControl::actual_target_threshold() const {
+  guarantee(_target_occupancy > 0, "Target occupancy still not updated yet.");
+  // The actual target threshold takes the heap reserve and the expected waste in
+  // free space into account.
+  // _heap_reserve is that part of the total heap capacity that is reserved for
+  // eventual promotion failure.
+  // _heap_waste is the amount of space will never be reclaimed in any
+  // heap, so can not be used for allocation during marking and must always be
+  // considered.
+
+  double safe_total_heap_percentage = MIN2((double)(_heap_reserve_percent + _heap_waste_percent), 100.0);
+
+  return (size_t)MIN2(
+    G1CollectedHeap::heap()->max_capacity() * (100.0 - safe_total_heap_percentage) / 100.0,
+    _target_occupancy * (100.0 - _heap_waste_percent) / 100.0
+    );
+}
+
+size_t G1AdaptiveIHOPControl::get_conc_mark_start_threshold() {
+  if (have_enough_data_for_prediction()) {
+    double pred_marking_time = predicted_marking_time_s();
+    double pred_promotion_rate = predicted_allocation_rate();
+    double pred_promotion_size = pred_marking_time * pred_promotion_rate;
+
+    size_t predicted_needed_bytes_during_marking =
+      (size_t)(pred_promotion_size + _last_unrestrained_young_size);
+
+    size_t internal_threshold = actual_target_threshold();
+    size_t predicted_initiating_threshold = predicted_needed_bytes_during_marking < internal_threshold ?
+                                            internal_threshold - predicted_needed_bytes_during_marking :
+                                            0;
+    return predicted_initiating_threshold;
+  } else {
+    // Use the initial value.
+    return (size_t)(_initial_ihop_percent * _target_occupancy / 100.0);
+  }
+}
+
+void G1AdaptiveIHOPControl::update_allocation_info(double allocation_time_s, size_t allocated_bytes, size_t additional_buffer_size) {
+  G1IHOPControl::update_allocation_info(allocation_time_s, allocated_bytes, additional_buffer_size);
+
+  if (allocation_time_s > 0.0) {
+    double allocation_rate = (double) allocated_bytes / allocation_time_s;
+    _allocation_rate_s.add(allocation_rate);
+  }
+
+  _last_unrestrained_young_size = additional_buffer_size;
+}
+
+void G1AdaptiveIHOPControl::update_marking_length(double marking_length_s) {
+  assert(marking_length_s >= 0.0, err_msg("Marking length must be larger than zero but is %.3f", marking_length_s));
+  _marking_times_s.add(marking_length_s);
+}
+
+double G1AdaptiveIHOPControl::predicted_marking_time_s() const {
+  return predict(&_marking_times_s);
+}
+
+double G1AdaptiveIHOPControl::predicted_allocation_rate() const {
+  return predict(&_allocation_rate_s);
+}
+
+void G1AdaptiveIHOPControl::print() {
+  G1IHOPControl::print();
+  size_t actual_target = actual_target_threshold();
+  ergo_verbose6(ErgoIHOP,
+                "adaptive IHOP information",
+                ergo_format_byte_perc("threshold")
+                ergo_format_byte("internal target occupancy")
+                ergo_format_double("predicted old gen allocation rate")
+                ergo_format_ms("predicted marking duration")
+                ergo_format_str("prediction active"),
+                get_conc_mark_start_threshold(),
+                actual_target > 0 ? get_conc_mark_start_threshold() * 100.0 / actual_target : 0.0,
+                actual_target,
+                predicted_allocation_rate(),
+                predicted_marking_time_s() * 1000.0,
+                have_enough_data_for_prediction() ? "true" : "false");
+}
+
+void G1AdaptiveIHOPControl::send_to_monitoring(G1MonitoringSupport* g1mm) {
+  g1mm->update_ihop_stats(get_conc_mark_start_threshold(),
+                          actual_target_threshold(),
+                          predicted_marking_time_s() * 1000.0,
+                          predicted_allocation_rate());
+}
@@ -54,11 +54,13 @@ struct InCSetState {
     // This encoding allows us to use an != 0 check which in some architectures
     // (x86*) can be encoded slightly more efficently than a normal comparison
     // against zero.
-    // The same situation occurs when checking whether the region is humongous
-    // or not, which is encoded by values < 0.
+    // Values < 0 are used for regions that are not evacuated by the current
+    // phase of the pause but where references into them need special
+    // treatment: humongous regions and optional collection set regions.
     // The other values are simply encoded in increasing generation order, which
     // makes getting the next generation fast by a simple increment.
-    Humongous    = -1,    // The region is humongous - note that actually any value < 0 would be possible here.
+    Optional     = -2,    // The region is an optional collection set region, evacuated only if time permits.
+    Humongous    = -1,    // The region is humongous.
     NotInCSet    =  0,    // The region is not in the collection set.
     Young        =  1,    // The region is in the collection set and a young region.
     Old          =  2,    // The region is in the collection set and an old region.
@@ -75,13 +77,14 @@ struct InCSetState {
 
   bool is_in_cset_or_humongous() const { return _value != NotInCSet; }
   bool is_in_cset() const              { return _value > NotInCSet; }
-  bool is_humongous() const            { return _value < NotInCSet; }
+  bool is_humongous() const            { return _value == Humongous; }
+  bool is_optional() const             { return _value == Optional; }
   bool is_young() const                { return _value == Young; }
   bool is_old() const                  { return _value == Old; }
 
 #ifdef ASSERT
   bool is_default() const              { return !is_in_cset_or_humongous(); }
-  bool is_valid() const                { return (_value >= Humongous) && (_value < Num); }
+  bool is_valid() const                { return (_value >= Optional) && (_value < Num); }
   bool is_valid_gen() const            { return (_value >= Young && _value <= Old); }
 #endif
 };
@@ -96,7 +99,9 @@ struct InCSetState {
 // quickly reclaim humongous objects. For the latter, by making a humongous region
 // succeed this test, we sort-of add it to the collection set. During the reference
 // iteration closures, when we see a humongous region, we then simply mark it as
-// referenced, i.e. live.
+// referenced, i.e. live. Optional collection set regions succeed this test too,
+// so that references into them found while evacuating the rest of the
+// collection set can be recorded for a later optional evacuation phase.
 class G1InCSetStateFastTestBiasedMappedArray : public G1BiasedMappedArray<InCSetState> {
  protected:
   InCSetState default_value() const { return InCSetState::NotInCSet; }
@@ -118,9 +123,21 @@ class G1InCSetStateFastTestBiasedMappedArray : public G1BiasedMappedArray<InCSet
   }
 
   void set_in_old(uintptr_t index) {
+    assert(get_by_index(index).is_default() || get_by_index(index).is_optional(),
+           err_msg("State at index " INTPTR_FORMAT " should be default or optional but is " CSETSTATE_FORMAT, index, get_by_index(index).value()));
+    set_by_index(index, InCSetState::Old);
+  }
+
+  void set_optional(uintptr_t index) {
     assert(get_by_index(index).is_default(),
            err_msg("State at index " INTPTR_FORMAT " should be default but is " CSETSTATE_FORMAT, index, get_by_index(index).value()));
-    set_by_index(index, InCSetState::Old);
+    set_by_index(index, InCSetState::Optional);
+  }
+
+  void clear_optional(uintptr_t index) {
+    assert(get_by_index(index).is_optional(),
+           err_msg("State at index " INTPTR_FORMAT " should be optional but is " CSETSTATE_FORMAT, index, get_by_index(index).value()));
+    set_by_index(index, InCSetState::NotInCSet);
   }
 
   bool is_in_cset_or_humongous(HeapWord* addr) const { return at(addr).is_in_cset_or_humongous(); }
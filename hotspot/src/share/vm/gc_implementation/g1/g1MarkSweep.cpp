@@ -232,6 +232,8 @@ class G1AdjustPointersClosure: public HeapRegionClosure {
         // point all the oops to the new location
         obj->adjust_pointers();
       }
+    } else if (r->has_pinned_objects()) {
+      r->adjust_pinned_pointers();
     } else {
       // This really ought to be "as_CompactibleSpace"...
       r->adjust_pointers();
@@ -291,6 +293,8 @@ public:
         }
         hr->reset_during_compaction();
       }
+    } else if (hr->has_pinned_objects()) {
+      hr->reset_pinned_after_compaction();
     } else {
       hr->compact();
     }
@@ -374,6 +378,11 @@ bool G1PrepareCompactClosure::doHeapRegion(HeapRegion* hr) {
     } else {
       assert(hr->continuesHumongous(), "Invalid humongous.");
     }
+  } else if (hr->has_pinned_objects()) {
+    // Objects of other regions are not compacted into this one either,
+    // see G1CollectedHeap::next_compaction_region().
+    hr->prepare_pinned_for_compaction();
+    _mrbs->clear(MemRegion(hr->top(), hr->end()));
   } else {
     prepare_for_compaction(hr, hr->end());
   }
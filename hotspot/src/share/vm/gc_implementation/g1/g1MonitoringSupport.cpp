@@ -26,6 +26,7 @@
 #include "gc_implementation/g1/g1MonitoringSupport.hpp"
 #include "gc_implementation/g1/g1CollectedHeap.inline.hpp"
 #include "gc_implementation/g1/g1CollectorPolicy.hpp"
+#include "runtime/orderAccess.inline.hpp"
 
 G1GenerationCounters::G1GenerationCounters(G1MonitoringSupport* g1mm,
                                            const char* name,
@@ -82,6 +83,10 @@ G1MonitoringSupport::G1MonitoringSupport(G1CollectedHeap* g1h) :
   _eden_counters(NULL),
   _from_counters(NULL),
   _to_counters(NULL),
+  _ihop_threshold(NULL),
+  _ihop_target_occupancy(NULL),
+  _ihop_predicted_marking_time_ms(NULL),
+  _ihop_predicted_allocation_rate(NULL),
 
   _overall_reserved(0),
   _overall_committed(0),    _overall_used(0),
@@ -89,7 +94,8 @@ G1MonitoringSupport::G1MonitoringSupport(G1CollectedHeap* g1h) :
   _young_gen_committed(0),
   _eden_committed(0),       _eden_used(0),
   _survivor_committed(0),   _survivor_used(0),
-  _old_committed(0),        _old_used(0) {
+  _old_committed(0),        _old_used(0),
+  _update_count(0) {
 
   _overall_reserved = g1h->max_capacity();
   recalculate_sizes();
@@ -166,12 +172,59 @@ G1MonitoringSupport::G1MonitoringSupport(G1CollectedHeap* g1h) :
     // once to reflect that its used space is 0 so that we don't have to
     // worry about updating it again later.
     _from_counters->update_used(0);
+
+    EXCEPTION_MARK;
+    const char* cname = PerfDataManager::counter_name("g1.ihop", "threshold");
+    _ihop_threshold =
+      PerfDataManager::create_variable(SUN_GC, cname, PerfData::U_Bytes, CHECK);
+
+    cname = PerfDataManager::counter_name("g1.ihop", "targetOccupancy");
+    _ihop_target_occupancy =
+      PerfDataManager::create_variable(SUN_GC, cname, PerfData::U_Bytes, CHECK);
+
+    cname = PerfDataManager::counter_name("g1.ihop", "predictedMarkingTime");
+    _ihop_predicted_marking_time_ms =
+      PerfDataManager::create_variable(SUN_GC, cname, PerfData::U_Ticks, CHECK);
+
+    cname = PerfDataManager::counter_name("g1.ihop", "predictedAllocationRate");
+    _ihop_predicted_allocation_rate =
+      PerfDataManager::create_variable(SUN_GC, cname, PerfData::U_Bytes, CHECK);
+  }
+}
+
+void G1MonitoringSupport::begin_update() {
+  assert_lock_strong(MonitoringSupport_lock);
+  assert((_update_count & 1) == 0, "updates do not nest");
+  OrderAccess::release_store(&_update_count, _update_count + 1);
+  OrderAccess::storestore();
+}
+
+void G1MonitoringSupport::end_update() {
+  OrderAccess::release_store(&_update_count, _update_count + 1);
+}
+
+jint G1MonitoringSupport::begin_read() {
+  jint count;
+  while (((count = OrderAccess::load_acquire(&_update_count)) & 1) != 0) {
+    SpinPause();
   }
+  return count;
+}
+
+bool G1MonitoringSupport::end_read(jint count) {
+  OrderAccess::loadload();
+  return _update_count == count;
 }
 
 MemoryUsage G1MonitoringSupport::memory_usage() {
-  MutexLockerEx x(MonitoringSupport_lock, Mutex::_no_safepoint_check_flag);
-  return MemoryUsage(InitialHeapSize, _overall_used, _overall_committed, _g1h->max_capacity());
+  size_t used, committed;
+  jint count;
+  do {
+    count = begin_read();
+    used = _overall_used;
+    committed = _overall_committed;
+  } while (!end_read(count));
+  return MemoryUsage(InitialHeapSize, used, committed, _g1h->max_capacity());
 }
 
 void G1MonitoringSupport::recalculate_sizes() {
@@ -182,6 +235,7 @@ void G1MonitoringSupport::recalculate_sizes() {
   // called at a point where no concurrent updates to the various
   // values we read here are possible (i.e., at a STW phase at the end
   // of a GC).
+  begin_update();
 
   uint young_list_length = g1->young_list()->length();
   uint survivor_list_length = g1->g1_policy()->recorded_survivor_regions();
@@ -235,6 +289,7 @@ void G1MonitoringSupport::recalculate_sizes() {
   // should hold.
   assert(_survivor_used <= _survivor_committed, "post-condition");
   assert(_old_used <= _old_committed, "post-condition");
+  end_update();
 }
 
 void G1MonitoringSupport::recalculate_eden_size() {
@@ -245,12 +300,15 @@ void G1MonitoringSupport::recalculate_eden_size() {
 
   uint young_region_num = g1h()->young_list()->length();
   if (young_region_num > _young_region_num) {
+    MutexLockerEx x(MonitoringSupport_lock, Mutex::_no_safepoint_check_flag);
+    begin_update();
     uint diff = young_region_num - _young_region_num;
     _eden_used += (size_t) diff * HeapRegion::GrainBytes;
     // Somewhat defensive: cap the eden used size to make sure it
     // never exceeds the committed size.
     _eden_used = MIN2(_eden_used, _eden_committed);
     _young_region_num = young_region_num;
+    end_update();
   }
 }
 
@@ -279,29 +337,51 @@ void G1MonitoringSupport::update_eden_size() {
   }
 }
 
-MemoryUsage G1MonitoringSupport::eden_space_memory_usage(size_t initial_size, size_t max_size) {
-  MutexLockerEx x(MonitoringSupport_lock, Mutex::_no_safepoint_check_flag);
+void G1MonitoringSupport::update_ihop_stats(size_t threshold,
+                                            size_t target_occupancy,
+                                            double predicted_marking_time_ms,
+                                            double predicted_allocation_rate) {
+  if (UsePerfData) {
+    _ihop_threshold->set_value((jlong) threshold);
+    _ihop_target_occupancy->set_value((jlong) target_occupancy);
+    _ihop_predicted_marking_time_ms->set_value((jlong) predicted_marking_time_ms);
+    // The allocation rate is exported in bytes per second.
+    _ihop_predicted_allocation_rate->set_value((jlong) predicted_allocation_rate);
+  }
+}
 
-  return MemoryUsage(initial_size,
-                     _eden_used,
-                     _eden_committed,
-                     max_size);
+MemoryUsage G1MonitoringSupport::eden_space_memory_usage(size_t initial_size, size_t max_size) {
+  size_t used, committed;
+  jint count;
+  do {
+    count = begin_read();
+    used = _eden_used;
+    committed = _eden_committed;
+  } while (!end_read(count));
+
+  return MemoryUsage(initial_size, used, committed, max_size);
 }
 
 MemoryUsage G1MonitoringSupport::survivor_space_memory_usage(size_t initial_size, size_t max_size) {
-  MutexLockerEx x(MonitoringSupport_lock, Mutex::_no_safepoint_check_flag);
-
-  return MemoryUsage(initial_size,
-                     _survivor_used,
-                     _survivor_committed,
-                     max_size);
+  size_t used, committed;
+  jint count;
+  do {
+    count = begin_read();
+    used = _survivor_used;
+    committed = _survivor_committed;
+  } while (!end_read(count));
+
+  return MemoryUsage(initial_size, used, committed, max_size);
 }
 
 MemoryUsage G1MonitoringSupport::old_gen_memory_usage(size_t initial_size, size_t max_size) {
-  MutexLockerEx x(MonitoringSupport_lock, Mutex::_no_safepoint_check_flag);
-
-  return MemoryUsage(initial_size,
-                     _old_used,
-                     _old_committed,
-                     max_size);
+  size_t used, committed;
+  jint count;
+  do {
+    count = begin_read();
+    used = _old_used;
+    committed = _old_committed;
+  } while (!end_read(count));
+
+  return MemoryUsage(initial_size, used, committed, max_size);
 }
@@ -139,6 +139,11 @@ class G1MonitoringSupport : public CHeapObj<mtGC> {
   //   the survivor collection (only one, _to_counters, is actively used)
   HSpaceCounters*      _from_counters;
   HSpaceCounters*      _to_counters;
+  // Current state of the concurrent mark start (IHOP) calculation
+  PerfVariable*        _ihop_threshold;
+  PerfVariable*        _ihop_target_occupancy;
+  PerfVariable*        _ihop_predicted_marking_time_ms;
+  PerfVariable*        _ihop_predicted_allocation_rate;
 
   // When it's appropriate to recalculate the various sizes (at the
   // end of a GC, when a new eden region is allocated, etc.) we store
@@ -159,8 +164,20 @@ class G1MonitoringSupport : public CHeapObj<mtGC> {
   size_t _old_committed;
   size_t _old_used;
 
+  // Bumped before and after each update of the sizes above, so it is odd
+  // while one is under way. The MemoryUsage getters read the sizes without
+  // taking MonitoringSupport_lock and retry if it changed meanwhile.
+  volatile jint _update_count;
+
   G1CollectedHeap* g1h() { return _g1h; }
 
+  // Bracket updates of the sizes; MonitoringSupport_lock must be held
+  void begin_update();
+  void end_update();
+  // Bracket reads of the sizes; retry while end_read() returns false
+  jint begin_read();
+  bool end_read(jint count);
+
   // It returns x - y if x > y, 0 otherwise.
   // As described in the comment above, some of the inputs to the
   // calculations we have to do are obtained concurrently and hence
@@ -206,6 +223,12 @@ class G1MonitoringSupport : public CHeapObj<mtGC> {
   // Recalculate only what's necessary when a new eden region is
   // allocated and update any jstat counters that need to be updated.
   void update_eden_size();
+  // Update the jstat counters describing the concurrent mark start
+  // (IHOP) calculation.
+  void update_ihop_stats(size_t threshold,
+                         size_t target_occupancy,
+                         double predicted_marking_time_ms,
+                         double predicted_allocation_rate);
 
   CollectorCounters* incremental_collection_counters() {
     return _incremental_collection_counters;
@@ -246,7 +269,8 @@ class G1MonitoringSupport : public CHeapObj<mtGC> {
   size_t old_space_used()             { return _old_used;             }
 
   // Monitoring support for MemoryPools. Values in the returned MemoryUsage are
-  // guaranteed to be consistent with each other.
+  // guaranteed to be consistent with each other. These do not lock, so
+  // polling them does not contend with allocation or GC.
   MemoryUsage eden_space_memory_usage(size_t initial_size, size_t max_size);
   MemoryUsage survivor_space_memory_usage(size_t initial_size, size_t max_size);
 
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "gc_implementation/g1/g1NUMA.hpp"
+#include "memory/allocation.inline.hpp"
+#include "runtime/globals.hpp"
+#include "runtime/os.hpp"
+#include "utilities/ostream.hpp"
+
+G1NUMA* G1NUMA::_inst = NULL;
+
+size_t G1NUMA::region_size() const {
+  assert(_region_size > 0, "Heap region size is not yet set");
+  return _region_size;
+}
+
+size_t G1NUMA::page_size() const {
+  assert(_page_size > 0, "Page size is not yet set");
+  return _page_size;
+}
+
+G1NUMA* G1NUMA::create() {
+  guarantee(_inst == NULL, "Should be called once.");
+  _inst = new G1NUMA();
+
+  // NUMA only supported on Linux.
+#ifdef LINUX
+  _inst->initialize(UseNUMA);
+#else
+  _inst->initialize(false);
+#endif /* LINUX */
+
+  return _inst;
+}
+
+uint G1NUMA::index_of_node_id(int node_id) const {
+  assert(node_id >= 0 && node_id < _len_node_id_to_index_map,
+         err_msg("invalid node id %d", node_id));
+  uint node_index = _node_id_to_index_map[node_id];
+  assert(node_index != G1NUMA::UnknownNodeIndex,
+         err_msg("invalid node id %d", node_id));
+  return node_index;
+}
+
+G1NUMA::G1NUMA() :
+  _node_ids(NULL), _num_active_node_ids(0),
+  _node_id_to_index_map(NULL), _len_node_id_to_index_map(0),
+  _region_size(0), _page_size(0) {
+}
+
+void G1NUMA::initialize(bool use_numa) {
+  if (use_numa) {
+    size_t num_node_ids = os::numa_get_groups_num();
+    _node_ids = NEW_C_HEAP_ARRAY(int, num_node_ids, mtGC);
+    _num_active_node_ids = (uint)os::numa_get_leaf_groups(_node_ids, num_node_ids);
+  }
+
+  if (_num_active_node_ids <= 1) {
+    // Either NUMA is off or there is only a single node with memory.
+    // Fall back to a single, dummy node.
+    if (_node_ids == NULL) {
+      _node_ids = NEW_C_HEAP_ARRAY(int, 1, mtGC);
+    }
+    _node_ids[0] = 0;
+    _num_active_node_ids = 1;
+  }
+
+  int max_node_id = 0;
+  for (uint i = 0; i < _num_active_node_ids; i++) {
+    max_node_id = MAX2(max_node_id, _node_ids[i]);
+  }
+
+  // Create a mapping between node_id and index.
+  _len_node_id_to_index_map = max_node_id + 1;
+  _node_id_to_index_map = NEW_C_HEAP_ARRAY(uint, _len_node_id_to_index_map, mtGC);
+
+  // Set all indices with unknown node id.
+  for (int i = 0; i < _len_node_id_to_index_map; i++) {
+    _node_id_to_index_map[i] = G1NUMA::UnknownNodeIndex;
+  }
+
+  // Set the indices for the actually retrieved node ids.
+  for (uint i = 0; i < _num_active_node_ids; i++) {
+    _node_id_to_index_map[_node_ids[i]] = i;
+  }
+}
+
+G1NUMA::~G1NUMA() {
+  FREE_C_HEAP_ARRAY(uint, _node_id_to_index_map, mtGC);
+  FREE_C_HEAP_ARRAY(int, _node_ids, mtGC);
+}
+
+void G1NUMA::set_region_info(size_t region_size, size_t page_size) {
+  _region_size = region_size;
+  _page_size = page_size;
+}
+
+uint G1NUMA::index_of_current_thread() const {
+  if (!is_enabled()) {
+    return 0;
+  }
+  int node_id = os::numa_get_group_id();
+  if (node_id < 0 || node_id >= _len_node_id_to_index_map ||
+      _node_id_to_index_map[node_id] == G1NUMA::UnknownNodeIndex) {
+    // The thread runs on a node without memory (or the OS reported an
+    // unexpected id). Any node will do.
+    return 0;
+  }
+  return _node_id_to_index_map[node_id];
+}
+
+uint G1NUMA::preferred_node_index_for_index(uint region_index) const {
+  if (region_size() >= page_size()) {
+    // Simple case, pages are smaller than the region so we
+    // can just alternate over the nodes.
+    return region_index % _num_active_node_ids;
+  } else {
+    // Multiple regions in one page, so we need to make sure the
+    // regions within a page are preferred on the same node.
+    size_t regions_per_page = page_size() / region_size();
+    return (uint)((region_index / regions_per_page) % _num_active_node_ids);
+  }
+}
+
+void G1NUMA::request_memory_on_node(void* base, size_t size, uint region_index) {
+  if (!is_enabled()) {
+    return;
+  }
+
+  if (size == 0) {
+    return;
+  }
+
+  uint node_index = preferred_node_index_for_index(region_index);
+
+  // If several regions share a page, they all share the preferred node
+  // of that page, so binding the whole page is fine.
+  char* start = (char*)align_ptr_down(base, page_size());
+  char* end = (char*)align_ptr_up((char*)base + size, page_size());
+  base = start;
+  size = pointer_delta(end, start, sizeof(char));
+
+  if (G1TraceNUMA) {
+    gclog_or_tty->print_cr("Request memory [" PTR_FORMAT ", " PTR_FORMAT ") to be NUMA id (%d)",
+                           p2i(base), p2i((char*)base + size), _node_ids[node_index]);
+  }
+
+  os::numa_make_local((char*)base, size, _node_ids[node_index]);
+}
+
+void G1NUMA::print_on(outputStream* st) const {
+  st->print("NUMA node ids:");
+  for (uint i = 0; i < _num_active_node_ids; i++) {
+    st->print(" %d", _node_ids[i]);
+  }
+  st->cr();
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_GC_IMPLEMENTATION_G1_G1NUMA_HPP
+#define SHARE_VM_GC_IMPLEMENTATION_G1_G1NUMA_HPP
+
+#include "memory/allocation.hpp"
+#include "runtime/os.hpp"
+
+// Keeps track of the NUMA nodes the G1 heap is spread across and
+// the mapping of heap regions to those nodes.
+//
+// Nodes are identified by a dense "node index" in [0, num_active_nodes())
+// which is translated to the OS node id only when talking to the OS.
+// When UseNUMA is off there is exactly one active node (index 0) and all
+// queries degenerate to cheap constant answers.
+//
+// The preferred node of a region is decided when the region is committed:
+// if a region is at least as large as a page, consecutive regions are
+// assigned round-robin to the active nodes; otherwise all the regions
+// sharing a page are assigned to the same node.
+class G1NUMA: public CHeapObj<mtGC> {
+  // OS node ids of the active nodes, indexed by node index.
+  int* _node_ids;
+  uint _num_active_node_ids;
+
+  // Reverse mapping from OS node id to node index.
+  uint* _node_id_to_index_map;
+  int _len_node_id_to_index_map;
+
+  size_t _region_size;
+  size_t _page_size;
+
+  static G1NUMA* _inst;
+
+  G1NUMA();
+  void initialize(bool use_numa);
+
+  size_t region_size() const;
+  size_t page_size() const;
+
+  uint index_of_node_id(int node_id) const;
+
+ public:
+  static const uint UnknownNodeIndex = UINT_MAX;
+  static const uint AnyNodeIndex = UnknownNodeIndex - 1;
+
+  static G1NUMA* numa() { return _inst; }
+
+  static G1NUMA* create();
+
+  ~G1NUMA();
+
+  // Whether regions are actually placed on and allocated from specific nodes.
+  bool is_enabled() const { return num_active_nodes() > 1; }
+
+  // Set the heap region size and page size after the heap has been reserved.
+  void set_region_info(size_t region_size, size_t page_size);
+
+  uint num_active_nodes() const { return _num_active_node_ids; }
+
+  const int* node_ids() const { return _node_ids; }
+
+  // Returns the node index of the node the current thread is running on,
+  // or 0 if NUMA is not enabled.
+  uint index_of_current_thread() const;
+
+  // Returns the node index the region at the given index should be
+  // placed on.
+  uint preferred_node_index_for_index(uint region_index) const;
+
+  // Returns whether the given node index is a valid, specific node.
+  bool is_valid_node_index(uint node_index) const { return node_index < num_active_nodes(); }
+
+  // Requests that the memory [base, base + size) of the region at
+  // region_index is backed by memory local to its preferred node.
+  // Must be called after the memory has been committed and before it
+  // has been touched.
+  void request_memory_on_node(void* base, size_t size, uint region_index);
+
+  void print_on(outputStream* st) const;
+};
+
+#endif // SHARE_VM_GC_IMPLEMENTATION_G1_G1NUMA_HPP
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "gc_implementation/g1/g1CollectedHeap.inline.hpp"
+#include "gc_implementation/g1/g1OptionalCSetRefs.hpp"
+#include "gc_implementation/g1/g1ParScanThreadState.inline.hpp"
+
+G1OptionalCSetRefs::G1OptionalCSetRefs(uint num_workers) :
+  _num_workers(num_workers),
+  _refs(NEW_C_HEAP_ARRAY(GrowableArray<StarTask>*, num_workers, mtGC)) {
+  for (uint i = 0; i < _num_workers; i++) {
+    _refs[i] = new (ResourceObj::C_HEAP, mtGC) GrowableArray<StarTask>(64, true, mtGC);
+  }
+}
+
+G1OptionalCSetRefs::~G1OptionalCSetRefs() {
+  for (uint i = 0; i < _num_workers; i++) {
+    delete _refs[i];
+  }
+  FREE_C_HEAP_ARRAY(GrowableArray<StarTask>*, _refs, mtGC);
+}
+
+template <class T>
+void G1OptionalCSetRefs::process_ref(T* p, G1ParScanThreadState* pss, OopClosure* root_cl) {
+  if (G1CollectedHeap::heap()->is_in_reserved(p)) {
+    pss->push_on_queue(p);
+  } else {
+    root_cl->do_oop(p);
+  }
+}
+
+void G1OptionalCSetRefs::process(uint worker_id, G1ParScanThreadState* pss, OopClosure* root_cl) {
+  assert(worker_id < _num_workers,
+         err_msg("Worker id %u out of range %u", worker_id, _num_workers));
+  GrowableArray<StarTask>* refs = _refs[worker_id];
+  // Only process the entries recorded before this call; root_cl may add
+  // new entries to the end of the list while we iterate.
+  int num_processed = refs->length();
+  for (int i = 0; i < num_processed; i++) {
+    StarTask ref = refs->at(i);
+    if (ref.is_narrow()) {
+      process_ref((narrowOop*)ref, pss, root_cl);
+    } else {
+      process_ref((oop*)ref, pss, root_cl);
+    }
+  }
+  int num_remaining = refs->length() - num_processed;
+  for (int i = 0; i < num_remaining; i++) {
+    refs->at_put(i, refs->at(num_processed + i));
+  }
+  refs->trunc_to(num_remaining);
+}
+
+void G1OptionalCSetRefs::clear() {
+  for (uint i = 0; i < _num_workers; i++) {
+    _refs[i]->clear();
+  }
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_GC_IMPLEMENTATION_G1_G1OPTIONALCSETREFS_HPP
+#define SHARE_VM_GC_IMPLEMENTATION_G1_G1OPTIONALCSETREFS_HPP
+
+#include "memory/allocation.hpp"
+#include "utilities/growableArray.hpp"
+#include "utilities/taskqueue.hpp"
+
+class G1ParScanThreadState;
+class OopClosure;
+
+// Per-worker lists of locations that refer into optional collection set
+// regions. While evacuating the collection set these references can not be
+// updated, as the optional regions may or may not be evacuated later in the
+// pause. Locations are recorded in the list of the worker that found them, so
+// no synchronization is needed.
+class G1OptionalCSetRefs : public CHeapObj<mtGC> {
+  uint _num_workers;
+  GrowableArray<StarTask>** _refs;
+
+  template <class T> void process_ref(T* p, G1ParScanThreadState* pss, OopClosure* root_cl);
+
+ public:
+  G1OptionalCSetRefs(uint num_workers);
+  ~G1OptionalCSetRefs();
+
+  template <class T> void add(uint worker_id, T* p) {
+    assert(worker_id < _num_workers,
+           err_msg("Worker id %u out of range %u", worker_id, _num_workers));
+    _refs[worker_id]->push(StarTask(p));
+  }
+
+  // Apply all references recorded by the given worker so far. Locations in
+  // the heap are pushed onto the task queue of the given scan state, other
+  // locations are passed to root_cl. References found during processing that
+  // still point into optional regions are recorded again.
+  void process(uint worker_id, G1ParScanThreadState* pss, OopClosure* root_cl);
+
+  void clear();
+};
+
+#endif // SHARE_VM_GC_IMPLEMENTATION_G1_G1OPTIONALCSETREFS_HPP
@@ -26,6 +26,9 @@
 #include "gc_implementation/g1/g1PageBasedVirtualSpace.hpp"
 #include "oops/markOop.hpp"
 #include "oops/oop.inline.hpp"
+#include "runtime/init.hpp"
+#include "runtime/safepoint.hpp"
+#include "runtime/thread.inline.hpp"
 #include "services/memTracker.hpp"
 #ifdef TARGET_OS_FAMILY_linux
 # include "os_linux.inline.hpp"
@@ -43,10 +46,11 @@
 # include "os_bsd.inline.hpp"
 #endif
 #include "utilities/bitMap.inline.hpp"
+#include "utilities/workgroup.hpp"
 
 G1PageBasedVirtualSpace::G1PageBasedVirtualSpace(ReservedSpace rs, size_t used_size, size_t page_size) :
   _low_boundary(NULL), _high_boundary(NULL), _committed(), _page_size(0), _special(false),
-  _dirty(), _executable(false) {
+  _dirty(), _executable(false), _pretouch_workers(NULL) {
   initialize_with_page_size(rs, used_size, page_size);
 }
 
@@ -193,11 +197,47 @@ char* G1PageBasedVirtualSpace::bounded_end_addr(size_t end_page) const {
   return MIN2(_high_boundary, page_start(end_page));
 }
 
+// Pretouches a range in chunks claimed by the workers.
+class G1PretouchTask : public AbstractGangTask {
+ private:
+  char* volatile _cur_addr;
+  char* const    _end_addr;
+  const size_t   _chunk_size;
+
+ public:
+  G1PretouchTask(char* start_address, char* end_address, size_t chunk_size) :
+    AbstractGangTask("G1 PreTouch"),
+    _cur_addr(start_address), _end_addr(end_address), _chunk_size(chunk_size) {}
+
+  void work(uint worker_id) {
+    while (true) {
+      char* touch_addr = (char*)Atomic::add_ptr((intptr_t)_chunk_size, (volatile void*)&_cur_addr) - _chunk_size;
+      if (touch_addr >= _end_addr) {
+        break;
+      }
+      char* end_addr = touch_addr + MIN2(_chunk_size, pointer_delta(_end_addr, touch_addr, sizeof(char)));
+      os::pretouch_memory(touch_addr, end_addr);
+    }
+  }
+};
+
 void G1PageBasedVirtualSpace::pretouch_internal(size_t start_page, size_t end_page) {
   guarantee(start_page < end_page,
             err_msg("Given start page " SIZE_FORMAT " is larger or equal to end page " SIZE_FORMAT, start_page, end_page));
 
-  os::pretouch_memory(page_start(start_page), bounded_end_addr(end_page));
+  char* start = page_start(start_page);
+  char* end = bounded_end_addr(end_page);
+  // The workers can be borrowed while the VM starts up, which is when the
+  // bulk of the heap is committed, and by the VM thread at a safepoint.
+  const size_t chunk_size = MAX2((size_t)4 * M, _page_size);
+  if (_pretouch_workers != NULL && pointer_delta(end, start, sizeof(char)) > chunk_size &&
+      (!is_init_completed() ||
+       (SafepointSynchronize::is_at_safepoint() && Thread::current()->is_VM_thread()))) {
+    G1PretouchTask task(start, end, chunk_size);
+    _pretouch_workers->run_task(&task);
+  } else {
+    os::pretouch_memory(start, end);
+  }
 }
 
 bool G1PageBasedVirtualSpace::commit(size_t start_page, size_t size_in_pages) {
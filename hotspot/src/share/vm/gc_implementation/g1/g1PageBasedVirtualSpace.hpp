@@ -30,6 +30,8 @@
 #include "runtime/virtualspace.hpp"
 #include "utilities/bitMap.hpp"
 
+class FlexibleWorkGang;
+
 // Virtual space management helper for a virtual space with an OS page allocation
 // granularity.
 // (De-)Allocation requests are always OS page aligned by passing a page index
@@ -72,6 +74,9 @@ class G1PageBasedVirtualSpace VALUE_OBJ_CLASS_SPEC {
   // Indicates whether the committed space should be executable.
   bool _executable;
 
+  // Workers that pretouch large commits in parallel, if any.
+  FlexibleWorkGang* _pretouch_workers;
+
   // Helper function for committing memory. Commit the given memory range by using
   // _page_size pages as much as possible and the remainder with small sized pages.
   void commit_internal(size_t start_page, size_t end_page);
@@ -109,6 +114,8 @@ class G1PageBasedVirtualSpace VALUE_OBJ_CLASS_SPEC {
 
   void initialize_with_page_size(ReservedSpace rs, size_t used_size, size_t page_size);
  public:
+  // Workers to pretouch large commits with, or NULL.
+  void set_pretouch_workers(FlexibleWorkGang* workers) { _pretouch_workers = workers; }
 
   // Commit the given area of pages starting at start being size_in_pages large.
   // Returns true if the given area is zero filled upon completion.
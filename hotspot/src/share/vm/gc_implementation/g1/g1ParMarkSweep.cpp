@@ -0,0 +1,734 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "classfile/symbolTable.hpp"
+#include "classfile/systemDictionary.hpp"
+#include "code/codeCache.hpp"
+#include "gc_implementation/g1/g1CollectedHeap.inline.hpp"
+#include "gc_implementation/g1/g1Log.hpp"
+#include "gc_implementation/g1/g1ParMarkSweep.hpp"
+#include "gc_implementation/g1/g1RootProcessor.hpp"
+#include "gc_implementation/g1/g1StringDedup.hpp"
+#include "gc_implementation/shared/adaptiveSizePolicy.hpp"
+#include "gc_implementation/shared/gcHeapSummary.hpp"
+#include "gc_implementation/shared/gcTimer.hpp"
+#include "gc_implementation/shared/gcTrace.hpp"
+#include "gc_implementation/shared/gcTraceTime.hpp"
+#include "gc_implementation/shared/markSweep.inline.hpp"
+#include "memory/genMarkSweep.hpp"
+#include "memory/modRefBarrierSet.hpp"
+#include "memory/referenceProcessor.hpp"
+#include "oops/objArrayOop.hpp"
+#include "oops/oop.inline.hpp"
+#include "prims/jvmtiExport.hpp"
+#include "runtime/biasedLocking.hpp"
+#include "runtime/thread.hpp"
+#include "utilities/stack.inline.hpp"
+#include "utilities/workgroup.hpp"
+#if INCLUDE_JFR
+#include "jfr/jfr.hpp"
+#endif // INCLUDE_JFR
+
+G1ParMarkSweepMarker**  G1ParMarkSweep::_markers = NULL;
+G1ParMarkSweepQueueSet* G1ParMarkSweep::_queues = NULL;
+uint                    G1ParMarkSweep::_num_workers = 0;
+
+#ifdef _MSC_VER // the use of 'this' below gets a warning, make it go away
+#pragma warning( disable:4355 ) // 'this' : used in base member initializer list
+#endif // _MSC_VER
+
+G1ParMarkSweepMarker::G1ParMarkSweepMarker(uint worker_id, ReferenceProcessor* rp) :
+  _worker_id(worker_id),
+  _queue(),
+  _mark_closure(this, rp),
+  _preserved_oop_stack(),
+  _preserved_mark_stack(),
+  _compaction_regions(new (ResourceObj::C_HEAP, mtGC) GrowableArray<HeapRegion*>(32, true, mtGC)),
+  _cp() {
+  _queue.initialize();
+}
+
+G1ParMarkSweepMarker::~G1ParMarkSweepMarker() {
+  assert(_queue.is_empty(), "marking should have completed");
+  assert(_preserved_oop_stack.is_empty(), "preserved marks should have been restored");
+  delete _compaction_regions;
+}
+
+inline bool G1ParMarkSweepMarker::par_mark(oop obj) {
+  markOop mark = obj->mark();
+  if (mark->is_marked()) {
+    return false;
+  }
+  if (G1StringDedup::is_enabled()) {
+    // As in MarkSweep::mark_object() the string must be enqueued before it
+    // is marked, since the candidate check reads its age. A string that two
+    // workers race to mark may be enqueued twice; deduplicating a string a
+    // second time is harmless.
+    G1StringDedup::enqueue_from_mark(obj, _worker_id);
+  }
+  if (obj->cas_set_mark(markOopDesc::prototype()->set_marked(), mark) != mark) {
+    // Another worker marked the object first.
+    return false;
+  }
+  // Some marks may contain information we need to preserve so we store
+  // them away and overwrite the mark. We'll restore it at the end of the
+  // collection.
+  if (mark->must_be_preserved(obj)) {
+    _preserved_mark_stack.push(mark);
+    _preserved_oop_stack.push(obj);
+  }
+  return true;
+}
+
+inline void G1ParMarkSweepMarker::push(oop obj, int index) {
+  ObjArrayTask task(obj, index);
+  _queue.push(task);
+}
+
+template <class T> inline void G1ParMarkSweepMarker::mark_and_push(T* p) {
+  T heap_oop = oopDesc::load_heap_oop(p);
+  if (!oopDesc::is_null(heap_oop)) {
+    oop obj = oopDesc::decode_heap_oop_not_null(heap_oop);
+    if (par_mark(obj)) {
+      push(obj, 0);
+    }
+  }
+}
+
+template <class T>
+inline void G1ParMarkSweepMarker::follow_array_chunk(objArrayOop array, int index) {
+  const size_t len = size_t(array->length());
+  const size_t beg_index = size_t(index);
+  assert(beg_index < len || len == 0, "index too large");
+
+  const size_t stride = MIN2(len - beg_index, ObjArrayMarkingStride);
+  const size_t end_index = beg_index + stride;
+
+  // Push the continuation first so that other workers can steal it while
+  // this one scans the current stride.
+  if (end_index < len) {
+    push(array, (int) end_index);
+  }
+
+  T* const base = (T*) array->base();
+  T* const end = base + end_index;
+  for (T* e = base + beg_index; e < end; e++) {
+    mark_and_push(e);
+  }
+}
+
+inline void G1ParMarkSweepMarker::follow(const ObjArrayTask& task) {
+  oop obj = task.obj();
+  if (obj->is_objArray()) {
+    if (task.index() == 0) {
+      // Follow the klass of the array once, not once per stride.
+      _mark_closure.do_klass(obj->klass());
+    }
+    if (UseCompressedOops) {
+      follow_array_chunk<narrowOop>(objArrayOop(obj), task.index());
+    } else {
+      follow_array_chunk<oop>(objArrayOop(obj), task.index());
+    }
+  } else {
+    obj->oop_iterate(&_mark_closure);
+  }
+}
+
+void G1ParMarkSweepMarker::drain_stack() {
+  ObjArrayTask task;
+  do {
+    // Drain the overflow stack first, so other workers can steal.
+    while (_queue.pop_overflow(task)) {
+      if (!_queue.try_push_to_taskqueue(task)) {
+        follow(task);
+      }
+    }
+    while (_queue.pop_local(task)) {
+      follow(task);
+    }
+  } while (!_queue.is_empty());
+}
+
+void G1ParMarkSweepMarker::complete_marking(G1ParMarkSweepQueueSet* queues,
+                                            ParallelTaskTerminator* terminator) {
+  int seed = 17;
+  ObjArrayTask task;
+  do {
+    drain_stack();
+    while (queues->steal(_worker_id, &seed, task)) {
+      follow(task);
+      drain_stack();
+    }
+  } while (!terminator->offer_termination());
+  assert(_queue.is_empty(), "should be empty");
+}
+
+void G1ParMarkSweepMarker::adjust_preserved_marks() {
+  StackIterator<oop, mtGC> iter(_preserved_oop_stack);
+  while (!iter.is_empty()) {
+    oop* p = iter.next_addr();
+    MarkSweep::adjust_pointer(p);
+  }
+}
+
+void G1ParMarkSweepMarker::restore_preserved_marks() {
+  assert(_preserved_oop_stack.size() == _preserved_mark_stack.size(),
+         "inconsistent preserved oop stacks");
+  while (!_preserved_oop_stack.is_empty()) {
+    oop obj = _preserved_oop_stack.pop();
+    markOop mark = _preserved_mark_stack.pop();
+    obj->set_mark(mark);
+  }
+  _preserved_oop_stack.clear(true);
+  _preserved_mark_stack.clear(true);
+}
+
+void G1ParMarkSweepMarker::prepare_for_compaction(HeapRegion* hr) {
+  assert(!hr->isHumongous(), "humongous regions are not compacted");
+  if (_compaction_regions->is_empty()) {
+    // First region of this worker: start compacting into it.
+    _cp.space = hr;
+    _cp.threshold = hr->initialize_threshold();
+  } else {
+    // Once the previous regions are full, CompactibleSpace::forward()
+    // continues with hr. Since objects never move to a later region of
+    // this list, the chain always extends far enough.
+    _compaction_regions->top()->set_next_compaction_space(hr);
+  }
+  _compaction_regions->append(hr);
+
+  hr->prepare_for_compaction(&_cp);
+  // Also clear the part of the card table that will be unused after
+  // compaction.
+  G1CollectedHeap::heap()->g1_barrier_set()->clear(MemRegion(hr->compaction_top(), hr->end()));
+}
+
+void G1ParMarkSweepMarker::compact() {
+  for (int i = 0; i < _compaction_regions->length(); i++) {
+    HeapRegion* hr = _compaction_regions->at(i);
+    hr->compact();
+    // Break the chain so that later serial full GCs compact in heap order.
+    hr->set_next_compaction_space(NULL);
+  }
+  _compaction_regions->clear();
+}
+
+template <class T>
+inline void G1ParMarkSweepMarkClosure::do_oop_work(T* p) {
+  _marker->mark_and_push(p);
+}
+
+void G1ParMarkSweepMarkClosure::do_oop(oop* p)       { do_oop_work(p); }
+void G1ParMarkSweepMarkClosure::do_oop(narrowOop* p) { do_oop_work(p); }
+
+void G1ParMarkSweepFollowStackClosure::do_void() {
+  if (_terminator != NULL) {
+    _marker->complete_marking(G1ParMarkSweep::queues(), _terminator);
+  } else {
+    _marker->drain_stack();
+  }
+}
+
+class G1ParMarkSweepMarkTask : public AbstractGangTask {
+  G1RootProcessor*       _root_processor;
+  ParallelTaskTerminator _terminator;
+
+ public:
+  G1ParMarkSweepMarkTask(G1RootProcessor* root_processor, uint n_workers) :
+    AbstractGangTask("G1 Parallel Full GC Mark"),
+    _root_processor(root_processor),
+    _terminator(n_workers, G1ParMarkSweep::queues()) { }
+
+  void work(uint worker_id) {
+    ResourceMark rm;
+    HandleMark   hm;
+
+    G1ParMarkSweepMarker* marker = G1ParMarkSweep::marker(worker_id);
+    OopClosure* mark_cl = marker->mark_closure();
+    CLDToOopClosure mark_cld_cl(mark_cl);
+    MarkingCodeBlobClosure mark_code_cl(mark_cl, !CodeBlobToOopClosure::FixRelocations);
+
+    if (ClassUnloading) {
+      _root_processor->process_strong_roots(mark_cl, &mark_cld_cl, &mark_code_cl);
+    } else {
+      _root_processor->process_all_roots_no_string_table(mark_cl, &mark_cld_cl, &mark_code_cl);
+    }
+
+    marker->complete_marking(G1ParMarkSweep::queues(), &_terminator);
+  }
+};
+
+// Implementation of AbstractRefProcTaskExecutor for parallel reference
+// processing during the parallel full GC.
+
+class G1ParMarkSweepRefProcTaskExecutor : public AbstractRefProcTaskExecutor {
+ public:
+  virtual void execute(ProcessTask& task);
+  virtual void execute(EnqueueTask& task);
+};
+
+class G1ParMarkSweepRefProcTaskProxy : public AbstractGangTask {
+  typedef AbstractRefProcTaskExecutor::ProcessTask ProcessTask;
+  ProcessTask&           _proc_task;
+  ParallelTaskTerminator _terminator;
+
+ public:
+  G1ParMarkSweepRefProcTaskProxy(ProcessTask& proc_task, uint n_workers) :
+    AbstractGangTask("G1 Parallel Full GC Process References"),
+    _proc_task(proc_task),
+    _terminator(n_workers, G1ParMarkSweep::queues()) { }
+
+  void work(uint worker_id) {
+    ResourceMark rm;
+    HandleMark   hm;
+
+    G1ParMarkSweepMarker* marker = G1ParMarkSweep::marker(worker_id);
+    G1ParMarkSweepFollowStackClosure complete_gc(marker, &_terminator);
+    _proc_task.work(worker_id, GenMarkSweep::is_alive, *marker->mark_closure(), complete_gc);
+  }
+};
+
+class G1ParMarkSweepRefEnqueueTaskProxy : public AbstractGangTask {
+  typedef AbstractRefProcTaskExecutor::EnqueueTask EnqueueTask;
+  EnqueueTask& _enq_task;
+
+ public:
+  G1ParMarkSweepRefEnqueueTaskProxy(EnqueueTask& enq_task) :
+    AbstractGangTask("G1 Parallel Full GC Enqueue References"),
+    _enq_task(enq_task) { }
+
+  void work(uint worker_id) {
+    _enq_task.work(worker_id);
+  }
+};
+
+void G1ParMarkSweepRefProcTaskExecutor::execute(ProcessTask& proc_task) {
+  G1ParMarkSweepRefProcTaskProxy proc_task_proxy(proc_task, G1ParMarkSweep::num_workers());
+  G1ParMarkSweep::run_task(&proc_task_proxy);
+}
+
+void G1ParMarkSweepRefProcTaskExecutor::execute(EnqueueTask& enq_task) {
+  G1ParMarkSweepRefEnqueueTaskProxy enq_task_proxy(enq_task);
+  G1ParMarkSweep::run_task(&enq_task_proxy);
+}
+
+// Frees dead humongous objects and forwards live ones to themselves.
+// Done serially before the regions are handed out to the workers, as
+// freeing a humongous object changes the type of all its regions.
+class G1ParMarkSweepPrepareHumongousClosure : public HeapRegionClosure {
+  G1CollectedHeap*   _g1h;
+  HeapRegionSetCount _humongous_regions_removed;
+
+  void free_humongous_region(HeapRegion* hr) {
+    FreeRegionList dummy_free_list("Dummy Free List for G1ParMarkSweep");
+
+    hr->set_containing_set(NULL);
+    _humongous_regions_removed.increment(1u, hr->capacity());
+
+    _g1h->free_humongous_region(hr, &dummy_free_list, false /* par */);
+    dummy_free_list.remove_all();
+  }
+
+ public:
+  G1ParMarkSweepPrepareHumongousClosure() :
+    _g1h(G1CollectedHeap::heap()), _humongous_regions_removed() { }
+
+  bool doHeapRegion(HeapRegion* hr) {
+    if (hr->startsHumongous()) {
+      oop obj = oop(hr->bottom());
+      if (obj->is_gc_marked()) {
+        obj->forward_to(obj);
+      } else {
+        free_humongous_region(hr);
+      }
+    }
+    return false;
+  }
+
+  void update_sets() {
+    // We'll recalculate total used bytes and recreate the free list
+    // at the end of the GC, so no point in updating those values here.
+    HeapRegionSetCount empty_set;
+    _g1h->remove_from_old_sets(empty_set, _humongous_regions_removed);
+  }
+};
+
+class G1ParMarkSweepPrepareCompactClosure : public HeapRegionClosure {
+  G1ParMarkSweepMarker* _marker;
+ public:
+  G1ParMarkSweepPrepareCompactClosure(G1ParMarkSweepMarker* marker) : _marker(marker) { }
+
+  bool doHeapRegion(HeapRegion* hr) {
+    if (hr->isHumongous()) {
+      return false;
+    }
+    if (hr->has_pinned_objects()) {
+      // Left in place, and not used as a compaction target either.
+      hr->prepare_pinned_for_compaction();
+      G1CollectedHeap::heap()->g1_barrier_set()->clear(MemRegion(hr->top(), hr->end()));
+    } else {
+      _marker->prepare_for_compaction(hr);
+    }
+    return false;
+  }
+};
+
+class G1ParMarkSweepPrepareCompactTask : public AbstractGangTask {
+ public:
+  G1ParMarkSweepPrepareCompactTask() :
+    AbstractGangTask("G1 Parallel Full GC Prepare Compaction") { }
+
+  void work(uint worker_id) {
+    G1ParMarkSweepPrepareCompactClosure cl(G1ParMarkSweep::marker(worker_id));
+    G1CollectedHeap::heap()->heap_region_par_iterate_chunked(&cl, worker_id,
+                                                             G1ParMarkSweep::num_workers(),
+                                                             HeapRegion::ParPrepareCompactClaimValue);
+  }
+};
+
+class G1ParMarkSweepAdjustRegionClosure : public HeapRegionClosure {
+ public:
+  bool doHeapRegion(HeapRegion* r) {
+    if (r->isHumongous()) {
+      if (r->startsHumongous()) {
+        // We must adjust the pointers on the single H object.
+        oop obj = oop(r->bottom());
+        // point all the oops to the new location
+        obj->adjust_pointers();
+      }
+    } else if (r->has_pinned_objects()) {
+      r->adjust_pinned_pointers();
+    } else {
+      r->adjust_pointers();
+    }
+    return false;
+  }
+};
+
+class G1ParMarkSweepAdjustPointersTask : public AbstractGangTask {
+  G1RootProcessor* _root_processor;
+
+ public:
+  G1ParMarkSweepAdjustPointersTask(G1RootProcessor* root_processor) :
+    AbstractGangTask("G1 Parallel Full GC Adjust Pointers"),
+    _root_processor(root_processor) { }
+
+  void work(uint worker_id) {
+    ResourceMark rm;
+    HandleMark   hm;
+
+    CodeBlobToOopClosure adjust_code_closure(&GenMarkSweep::adjust_pointer_closure, CodeBlobToOopClosure::FixRelocations);
+    _root_processor->process_all_roots(&GenMarkSweep::adjust_pointer_closure,
+                                       &GenMarkSweep::adjust_cld_closure,
+                                       &adjust_code_closure);
+
+    G1ParMarkSweep::marker(worker_id)->adjust_preserved_marks();
+
+    G1ParMarkSweepAdjustRegionClosure cl;
+    G1CollectedHeap::heap()->heap_region_par_iterate_chunked(&cl, worker_id,
+                                                             G1ParMarkSweep::num_workers(),
+                                                             HeapRegion::ParAdjustPointersClaimValue);
+  }
+};
+
+class G1ParMarkSweepCompactTask : public AbstractGangTask {
+ public:
+  G1ParMarkSweepCompactTask() :
+    AbstractGangTask("G1 Parallel Full GC Compact") { }
+
+  void work(uint worker_id) {
+    G1ParMarkSweep::marker(worker_id)->compact();
+  }
+};
+
+class G1ParMarkSweepRestoreMarksTask : public AbstractGangTask {
+ public:
+  G1ParMarkSweepRestoreMarksTask() :
+    AbstractGangTask("G1 Parallel Full GC Restore Marks") { }
+
+  void work(uint worker_id) {
+    G1ParMarkSweep::marker(worker_id)->restore_preserved_marks();
+  }
+};
+
+// Resets the regions whose objects were not moved: humongous regions and
+// regions with pinned objects.
+class G1ParMarkSweepResetHumongousClosure : public HeapRegionClosure {
+ public:
+  bool doHeapRegion(HeapRegion* hr) {
+    if (hr->startsHumongous()) {
+      oop obj = oop(hr->bottom());
+      assert(obj->is_gc_marked(), "dead humongous objects were freed in phase 2");
+      obj->init_mark();
+      hr->reset_during_compaction();
+    } else if (!hr->isHumongous() && hr->has_pinned_objects()) {
+      hr->reset_pinned_after_compaction();
+    }
+    return false;
+  }
+};
+
+bool G1ParMarkSweep::should_be_used() {
+  return G1ParallelFullGC && G1CollectedHeap::use_parallel_gc_threads();
+}
+
+FlexibleWorkGang* G1ParMarkSweep::workers() {
+  return G1CollectedHeap::heap()->workers();
+}
+
+void G1ParMarkSweep::run_task(AbstractGangTask* task) {
+  G1CollectedHeap* g1h = G1CollectedHeap::heap();
+  assert(workers()->active_workers() == _num_workers, "inconsistent number of workers");
+  // Set parallel threads in the heap (_n_par_threads) only before a
+  // parallel phase and always reset it to 0 after the phase.
+  g1h->set_par_threads(_num_workers);
+  workers()->run_task(task);
+  g1h->set_par_threads(0);
+}
+
+void G1ParMarkSweep::allocate_markers(uint num_workers, ReferenceProcessor* rp) {
+  assert(_markers == NULL && _queues == NULL, "no stomping");
+  _num_workers = num_workers;
+  _markers = NEW_C_HEAP_ARRAY(G1ParMarkSweepMarker*, num_workers, mtGC);
+  _queues = new G1ParMarkSweepQueueSet(num_workers);
+  for (uint i = 0; i < num_workers; i++) {
+    _markers[i] = new G1ParMarkSweepMarker(i, rp);
+    _queues->register_queue(i, _markers[i]->queue());
+  }
+}
+
+void G1ParMarkSweep::deallocate_markers() {
+  for (uint i = 0; i < _num_workers; i++) {
+    delete _markers[i];
+  }
+  FREE_C_HEAP_ARRAY(G1ParMarkSweepMarker*, _markers, mtGC);
+  delete _queues;
+  _markers = NULL;
+  _queues = NULL;
+  _num_workers = 0;
+}
+
+void G1ParMarkSweep::invoke_at_safepoint(ReferenceProcessor* rp,
+                                         bool clear_all_softrefs) {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at a safepoint");
+  assert(should_be_used(), "should not be called otherwise");
+
+  G1CollectedHeap* g1h = G1CollectedHeap::heap();
+#ifdef ASSERT
+  if (g1h->collector_policy()->should_clear_all_soft_refs()) {
+    assert(clear_all_softrefs, "Policy should have been checked earler");
+  }
+#endif
+  assert(rp == g1h->ref_processor_stw(), "Precondition");
+  assert(rp->discovery_is_mt(), "references are discovered by the workers");
+
+  uint n_workers =
+    AdaptiveSizePolicy::calc_active_workers(workers()->total_workers(),
+                                            workers()->active_workers(),
+                                            Threads::number_of_non_daemon_threads());
+  assert(UseDynamicNumberOfGCThreads ||
+         n_workers == workers()->total_workers(),
+         "If not dynamic should be using all the  workers");
+  workers()->set_active_workers(n_workers);
+
+  rp->set_active_mt_degree(n_workers);
+  rp->setup_policy(clear_all_softrefs);
+
+  // When collecting the permanent generation Method*s may be moving,
+  // so we either have to flush all bcp data or convert it into bci.
+  CodeCache::gc_prologue();
+  Threads::gc_prologue();
+
+  allocate_markers(n_workers, rp);
+
+  // We should save the marks of the currently locked biased monitors.
+  // The marking doesn't preserve the marks of biased objects.
+  BiasedLocking::preserve_marks();
+
+  mark_sweep_phase1(clear_all_softrefs);
+
+  mark_sweep_phase2();
+
+  // Don't add any more derived pointers during phase3
+  COMPILER2_PRESENT(DerivedPointerTable::set_active(false));
+
+  mark_sweep_phase3();
+
+  mark_sweep_phase4();
+
+  G1ParMarkSweepRestoreMarksTask restore_marks_task;
+  run_task(&restore_marks_task);
+  BiasedLocking::restore_marks();
+  deallocate_markers();
+
+  Threads::gc_epilogue();
+  CodeCache::gc_epilogue();
+  JvmtiExport::gc_epilogue();
+}
+
+void G1ParMarkSweep::mark_sweep_phase1(bool clear_all_softrefs) {
+  // Recursively traverse all live objects and mark them
+  GCTraceTime tm("phase 1", G1Log::fine() && Verbose, true, gc_timer(), gc_tracer()->gc_id());
+
+  G1CollectedHeap* g1h = G1CollectedHeap::heap();
+
+  // Need cleared claim bits for the roots processing
+  ClassLoaderDataGraph::clear_claimed_marks();
+
+  g1h->set_par_threads(_num_workers);
+  {
+    G1RootProcessor root_processor(g1h);
+    root_processor.set_num_workers(_num_workers);
+    G1ParMarkSweepMarkTask mark_task(&root_processor, _num_workers);
+    workers()->run_task(&mark_task);
+  }
+  g1h->set_par_threads(0);
+
+  // Process reference objects found during marking. The serial parts
+  // of reference processing run on the VM thread using the closures of
+  // the first worker.
+  ReferenceProcessor* rp = g1h->ref_processor_stw();
+  rp->setup_policy(clear_all_softrefs);
+
+  G1ParMarkSweepMarker* serial_marker = marker(0);
+  G1ParMarkSweepFollowStackClosure serial_complete_gc(serial_marker, NULL);
+  ReferenceProcessorStats stats;
+  if (!rp->processing_is_mt()) {
+    stats = rp->process_discovered_references(&GenMarkSweep::is_alive,
+                                              serial_marker->mark_closure(),
+                                              &serial_complete_gc,
+                                              NULL,
+                                              gc_timer(),
+                                              gc_tracer()->gc_id());
+  } else {
+    G1ParMarkSweepRefProcTaskExecutor par_task_executor;
+    stats = rp->process_discovered_references(&GenMarkSweep::is_alive,
+                                              serial_marker->mark_closure(),
+                                              &serial_complete_gc,
+                                              &par_task_executor,
+                                              gc_timer(),
+                                              gc_tracer()->gc_id());
+  }
+  gc_tracer()->report_gc_reference_stats(stats);
+
+  // This is the point where the entire marking should have completed.
+  for (uint i = 0; i < _num_workers; i++) {
+    assert(marker(i)->queue()->is_empty(), "Marking should have completed");
+  }
+
+  if (ClassUnloading) {
+
+     // Unload classes and purge the SystemDictionary.
+     bool purged_class = SystemDictionary::do_unloading(&GenMarkSweep::is_alive);
+
+     // Unload nmethods.
+     CodeCache::do_unloading(&GenMarkSweep::is_alive, purged_class);
+
+     // Prune dead klasses from subklass/sibling/implementor lists.
+     Klass::clean_weak_klass_links(&GenMarkSweep::is_alive);
+  }
+  // Delete entries for dead interned string and clean up unreferenced symbols in symbol table.
+  g1h->unlink_string_and_symbol_table(&GenMarkSweep::is_alive);
+
+  if (VerifyDuringGC) {
+    HandleMark hm;  // handle scope
+    COMPILER2_PRESENT(DerivedPointerTableDeactivate dpt_deact);
+    Universe::heap()->prepare_for_verify();
+    // Note: we can verify only the heap here. See the comment in
+    // G1MarkSweep::mark_sweep_phase1() about why the dictionaries
+    // cannot be verified while the mark words are overwritten.
+    if (!VerifySilently) {
+      gclog_or_tty->print(" VerifyDuringGC:(full)[Verifying ");
+    }
+    Universe::heap()->verify(VerifySilently, VerifyOption_G1UseMarkWord);
+    if (!VerifySilently) {
+      gclog_or_tty->print_cr("]");
+    }
+  }
+
+  gc_tracer()->report_object_count_after_gc(&GenMarkSweep::is_alive);
+}
+
+void G1ParMarkSweep::mark_sweep_phase2() {
+  // Now all live objects are marked, compute the new object addresses.
+  GCTraceTime tm("phase 2", G1Log::fine() && Verbose, true, gc_timer(), gc_tracer()->gc_id());
+
+  G1CollectedHeap* g1h = G1CollectedHeap::heap();
+
+  G1ParMarkSweepPrepareHumongousClosure humongous_cl;
+  g1h->heap_region_iterate(&humongous_cl);
+  humongous_cl.update_sets();
+
+  assert(g1h->check_heap_region_claim_values(HeapRegion::InitialClaimValue),
+         "sanity check");
+  G1ParMarkSweepPrepareCompactTask prepare_task;
+  run_task(&prepare_task);
+  assert(g1h->check_heap_region_claim_values(HeapRegion::ParPrepareCompactClaimValue),
+         "sanity check");
+}
+
+void G1ParMarkSweep::mark_sweep_phase3() {
+  G1CollectedHeap* g1h = G1CollectedHeap::heap();
+
+  // Adjust the pointers to reflect the new locations
+  GCTraceTime tm("phase 3", G1Log::fine() && Verbose, true, gc_timer(), gc_tracer()->gc_id());
+
+  // Need cleared claim bits for the roots processing
+  ClassLoaderDataGraph::clear_claimed_marks();
+
+  // Adjust the weak roots serially; all of them should have been cleared
+  // if they pointed to non-surviving objects.
+  g1h->ref_processor_stw()->weak_oops_do(&GenMarkSweep::adjust_pointer_closure);
+  JNIHandles::weak_oops_do(&GenMarkSweep::adjust_pointer_closure);
+  JFR_ONLY(Jfr::weak_oops_do(&GenMarkSweep::adjust_pointer_closure));
+
+  if (G1StringDedup::is_enabled()) {
+    G1StringDedup::oops_do(&GenMarkSweep::adjust_pointer_closure);
+  }
+
+  g1h->set_par_threads(_num_workers);
+  {
+    G1RootProcessor root_processor(g1h);
+    root_processor.set_num_workers(_num_workers);
+    G1ParMarkSweepAdjustPointersTask adjust_task(&root_processor);
+    workers()->run_task(&adjust_task);
+  }
+  g1h->set_par_threads(0);
+
+  assert(g1h->check_heap_region_claim_values(HeapRegion::ParAdjustPointersClaimValue),
+         "sanity check");
+  g1h->reset_heap_region_claim_values();
+}
+
+void G1ParMarkSweep::mark_sweep_phase4() {
+  // All pointers are now adjusted, move objects accordingly
+  GCTraceTime tm("phase 4", G1Log::fine() && Verbose, true, gc_timer(), gc_tracer()->gc_id());
+
+  G1ParMarkSweepCompactTask compact_task;
+  run_task(&compact_task);
+
+  G1ParMarkSweepResetHumongousClosure humongous_cl;
+  G1CollectedHeap::heap()->heap_region_iterate(&humongous_cl);
+}
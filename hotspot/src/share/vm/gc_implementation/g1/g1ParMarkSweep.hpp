@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_GC_IMPLEMENTATION_G1_G1PARMARKSWEEP_HPP
+#define SHARE_VM_GC_IMPLEMENTATION_G1_G1PARMARKSWEEP_HPP
+
+#include "gc_implementation/g1/g1MarkSweep.hpp"
+#include "memory/allocation.hpp"
+#include "memory/iterator.hpp"
+#include "utilities/growableArray.hpp"
+#include "utilities/stack.hpp"
+#include "utilities/taskqueue.hpp"
+
+class FlexibleWorkGang;
+class G1ParMarkSweepMarker;
+class HeapRegion;
+class ReferenceProcessor;
+
+// Entries on the marking queues. A task carries an object and the index
+// from which its contents still have to be followed; that index is only
+// ever non-zero for the continuation of a partially scanned object array.
+typedef OverflowTaskQueue<ObjArrayTask, mtGC>            G1ParMarkSweepQueue;
+typedef GenericTaskQueueSet<G1ParMarkSweepQueue, mtGC>   G1ParMarkSweepQueueSet;
+
+// Marks the object referenced by the visited location and pushes it onto
+// the marking queue of the owning worker. Reference objects found during
+// marking are handed to the given reference processor for discovery.
+class G1ParMarkSweepMarkClosure : public MetadataAwareOopClosure {
+  G1ParMarkSweepMarker* _marker;
+
+  template <class T> void do_oop_work(T* p);
+ public:
+  G1ParMarkSweepMarkClosure(G1ParMarkSweepMarker* marker, ReferenceProcessor* rp) :
+    MetadataAwareOopClosure(rp), _marker(marker) { }
+
+  virtual void do_oop(oop* p);
+  virtual void do_oop(narrowOop* p);
+};
+
+// Drains the marking queue of a worker. If a terminator is given, the
+// worker also steals from the other workers' queues until all of them
+// agree that marking has completed.
+class G1ParMarkSweepFollowStackClosure : public VoidClosure {
+  G1ParMarkSweepMarker*   _marker;
+  ParallelTaskTerminator* _terminator;
+ public:
+  G1ParMarkSweepFollowStackClosure(G1ParMarkSweepMarker* marker,
+                                   ParallelTaskTerminator* terminator) :
+    _marker(marker), _terminator(terminator) { }
+
+  virtual void do_void();
+};
+
+// Per-worker state of the parallel full GC: the marking queue, the mark
+// words that have to be restored at the end of the collection, and the
+// regions this worker compacts. Objects are only ever compacted into
+// regions of the same worker, and each worker moves its regions in the
+// order in which it computed their new addresses, so during compaction
+// the workers never touch each other's regions.
+class G1ParMarkSweepMarker : public CHeapObj<mtGC> {
+  uint                      _worker_id;
+  G1ParMarkSweepQueue       _queue;
+  G1ParMarkSweepMarkClosure _mark_closure;
+
+  Stack<oop, mtGC>          _preserved_oop_stack;
+  Stack<markOop, mtGC>      _preserved_mark_stack;
+
+  // The regions this worker compacts, in the order they were prepared,
+  // and the current compaction point into them.
+  GrowableArray<HeapRegion*>* _compaction_regions;
+  CompactPoint              _cp;
+
+  // Set the mark bit of obj in its mark word; returns true if this worker
+  // marked it, false if it had been marked already.
+  inline bool par_mark(oop obj);
+  inline void push(oop obj, int index);
+  template <class T> inline void follow_array_chunk(objArrayOop array, int index);
+  inline void follow(const ObjArrayTask& task);
+
+ public:
+  G1ParMarkSweepMarker(uint worker_id, ReferenceProcessor* rp);
+  ~G1ParMarkSweepMarker();
+
+  uint worker_id() const              { return _worker_id; }
+  G1ParMarkSweepQueue* queue()        { return &_queue; }
+  OopClosure* mark_closure()          { return &_mark_closure; }
+
+  template <class T> inline void mark_and_push(T* p);
+
+  // Empty the local marking queue, including its overflow stack.
+  void drain_stack();
+  // Drain the local queue, then steal from the other workers until the
+  // terminator agrees that all queues are empty.
+  void complete_marking(G1ParMarkSweepQueueSet* queues,
+                        ParallelTaskTerminator* terminator);
+
+  // Preserved mark words.
+  void adjust_preserved_marks();
+  void restore_preserved_marks();
+
+  // Compute new addresses for the live objects of hr, compacting them
+  // into the regions already added to this worker.
+  void prepare_for_compaction(HeapRegion* hr);
+  // Move the objects of this worker's regions to their new addresses.
+  void compact();
+};
+
+// G1ParMarkSweep does the same four-phase mark-compact collection as
+// G1MarkSweep, but every phase is executed by the parallel worker gang:
+// marking uses per-worker queues with work stealing, new addresses are
+// computed per region claimed by a worker, and pointer adjustment and
+// compaction run on regions in parallel.
+//
+// Freeing of dead humongous objects and the restoration of humongous
+// regions after compaction are done serially; they are local to a
+// handful of regions.
+class G1ParMarkSweep : AllStatic {
+  static G1ParMarkSweepMarker** _markers;
+  static G1ParMarkSweepQueueSet* _queues;
+  static uint _num_workers;
+
+  static void allocate_markers(uint num_workers, ReferenceProcessor* rp);
+  static void deallocate_markers();
+
+  // Mark live objects
+  static void mark_sweep_phase1(bool clear_all_softrefs);
+  // Calculate new addresses
+  static void mark_sweep_phase2();
+  // Update pointers
+  static void mark_sweep_phase3();
+  // Move objects to new positions
+  static void mark_sweep_phase4();
+
+  static FlexibleWorkGang* workers();
+
+ public:
+  // Whether full collections should use G1ParMarkSweep instead of
+  // G1MarkSweep.
+  static bool should_be_used();
+
+  static void invoke_at_safepoint(ReferenceProcessor* rp,
+                                  bool clear_all_softrefs);
+
+  static uint num_workers() { return _num_workers; }
+  static G1ParMarkSweepMarker* marker(uint worker_id) {
+    assert(worker_id < _num_workers, "worker id out of range");
+    return _markers[worker_id];
+  }
+  static G1ParMarkSweepQueueSet* queues() { return _queues; }
+
+  // Run task on all workers taking part in the current collection.
+  static void run_task(AbstractGangTask* task);
+
+  static STWGCTimer* gc_timer() { return G1MarkSweep::gc_timer(); }
+  static SerialOldTracer* gc_tracer() { return G1MarkSweep::gc_tracer(); }
+};
+
+#endif // SHARE_VM_GC_IMPLEMENTATION_G1_G1PARMARKSWEEP_HPP
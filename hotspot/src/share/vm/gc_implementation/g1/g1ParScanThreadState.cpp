@@ -224,6 +224,12 @@ oop G1ParScanThreadState::copy_to_survivor_space(InCSetState const state,
          (!from_region->is_young() && young_index == 0), "invariant" );
   const AllocationContext_t context = from_region->allocation_context();
 
+  if (from_region->has_pinned_objects()) {
+    // A JNI critical section uses an object of the region, so all its
+    // objects stay where they are and the region becomes an old region.
+    return _g1h->handle_evacuation_failure_par(this, old, true /* pinned */);
+  }
+
   uint age = 0;
   InCSetState dest_state = next_state(state, old_mark, age);
   HeapWord* obj_ptr = _g1_par_allocator->plab_allocate(dest_state, word_sz, context);
@@ -111,6 +111,10 @@ class G1ParScanThreadState : public StackObj {
     _refs->push(ref);
   }
 
+  // Remember the given location for the optional evacuation phase; the
+  // referenced object is in an optional collection set region.
+  template <class T> inline void record_optional_ref(T* p);
+
   template <class T> void update_rs(HeapRegion* from, T* p, int tid) {
     // If the new value of the field points to the same region or
     // is the to-space, we don't need to include it in the Rset updates.
@@ -159,6 +163,13 @@ class G1ParScanThreadState : public StackObj {
   static void print_termination_stats_hdr(outputStream* const st = gclog_or_tty);
   void print_termination_stats(int i, outputStream* const st = gclog_or_tty) const;
 
+  // Print and trace the PLAB statistics of this worker. Only done for the
+  // main evacuation state of each worker, so that a worker is reported
+  // once per pause.
+  void report_plab_worker_stats() const {
+    _g1_par_allocator->report_plab_worker_stats(_queue_num);
+  }
+
   size_t* surviving_young_words() {
     // We add on to hide entry 0 which accumulates surviving words for
     // age -1 regions (i.e. non-young ones)
@@ -25,10 +25,15 @@
 #ifndef SHARE_VM_GC_IMPLEMENTATION_G1_G1PARSCANTHREADSTATE_INLINE_HPP
 #define SHARE_VM_GC_IMPLEMENTATION_G1_G1PARSCANTHREADSTATE_INLINE_HPP
 
+#include "gc_implementation/g1/g1OptionalCSetRefs.hpp"
 #include "gc_implementation/g1/g1ParScanThreadState.hpp"
 #include "gc_implementation/g1/g1RemSet.inline.hpp"
 #include "oops/oop.inline.hpp"
 
+template <class T> void G1ParScanThreadState::record_optional_ref(T* p) {
+  _g1h->optional_cset_refs()->add(queue_num(), p);
+}
+
 template <class T> void G1ParScanThreadState::do_oop_evac(T* p, HeapRegion* from) {
   assert(!oopDesc::is_null(oopDesc::load_decode_heap_oop(p)),
          "Reference should not be NULL here as such are never pushed to the task queue.");
@@ -50,6 +55,8 @@ template <class T> void G1ParScanThreadState::do_oop_evac(T* p, HeapRegion* from
     oopDesc::encode_store_heap_oop(p, forwardee);
   } else if (in_cset_state.is_humongous()) {
     _g1h->set_humongous_is_live(obj);
+  } else if (in_cset_state.is_optional()) {
+    record_optional_ref(p);
   } else {
     assert(!in_cset_state.is_in_cset_or_humongous(),
            err_msg("In_cset_state must be NotInCSet here, but is " CSETSTATE_FORMAT, in_cset_state.value()));
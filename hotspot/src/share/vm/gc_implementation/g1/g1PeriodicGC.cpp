@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "gc_implementation/g1/g1CollectedHeap.inline.hpp"
+#include "gc_implementation/g1/g1CollectorPolicy.hpp"
+#include "gc_implementation/g1/g1ErgoVerbose.hpp"
+#include "gc_implementation/g1/g1PeriodicGC.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/os.hpp"
+
+volatile jint G1PeriodicGC::_request_pending = 0;
+
+jlong G1PeriodicGC::time_since_last_gc_ms() {
+  G1CollectorPolicy* g1p = G1CollectedHeap::heap()->g1_policy();
+  double idle_sec = os::elapsedTime() - g1p->last_gc_end_sec();
+  return (jlong) (idle_sec * MILLIUNITS);
+}
+
+bool G1PeriodicGC::should_request_periodic_gc() {
+  jlong idle_ms = time_since_last_gc_ms();
+  if (idle_ms < (jlong) G1PeriodicGCInterval) {
+    return false;
+  }
+
+  if (G1PeriodicGCSystemLoadThreshold > 0.0) {
+    double recent_load = 0.0;
+    if (os::loadavg(&recent_load, 1) == -1) {
+      ergo_verbose0(ErgoConcCycles,
+                    "do not request periodic collection",
+                    ergo_format_reason("system load not available"));
+      return false;
+    }
+    if (recent_load > G1PeriodicGCSystemLoadThreshold) {
+      ergo_verbose2(ErgoConcCycles,
+                    "do not request periodic collection",
+                    ergo_format_reason("system load higher than threshold")
+                    ergo_format_double("recent load")
+                    ergo_format_double("threshold"),
+                    recent_load, G1PeriodicGCSystemLoadThreshold);
+      return false;
+    }
+  }
+
+  ergo_verbose2(ErgoConcCycles,
+                "request periodic collection",
+                ergo_format_reason("no collection for longer than interval")
+                ergo_format_ms("time since last collection")
+                ergo_format_ms("interval"),
+                (double) idle_ms, (double) G1PeriodicGCInterval);
+  return true;
+}
+
+jlong G1PeriodicGC::wait_time_ms() {
+  assert(G1PeriodicGCInterval > 0, "periodic collections must be enabled");
+
+  // If a collection is already due but was not started (it is still
+  // pending or the system was too busy) wait for a whole interval
+  // before checking again.
+  jlong remaining_ms = (jlong) G1PeriodicGCInterval - time_since_last_gc_ms();
+  if (has_pending_request() || remaining_ms <= 0) {
+    return (jlong) G1PeriodicGCInterval;
+  }
+  return remaining_ms;
+}
+
+void G1PeriodicGC::check_for_periodic_gc() {
+  if (has_pending_request() || !should_request_periodic_gc()) {
+    return;
+  }
+
+  MutexLockerEx ml(Service_lock, Mutex::_no_safepoint_check_flag);
+  _request_pending = 1;
+  Service_lock->notify_all();
+}
+
+void G1PeriodicGC::do_pending_request() {
+  assert(Thread::current()->is_Java_thread(),
+         "collections must be requested by a JavaThread");
+
+  _request_pending = 0;
+  Universe::heap()->collect(GCCause::_g1_periodic_collection);
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_GC_IMPLEMENTATION_G1_G1PERIODICGC_HPP
+#define SHARE_VM_GC_IMPLEMENTATION_G1_G1PERIODICGC_HPP
+
+#include "memory/allocation.hpp"
+
+// Periodic collections give unused heap memory back to the operating
+// system when the application has been idle for G1PeriodicGCInterval
+// milliseconds.
+//
+// The concurrent mark thread checks whether a periodic collection is
+// due while it waits for the next concurrent cycle. Collections have
+// to be scheduled by a JavaThread, so the check only posts a request
+// which the ServiceThread then carries out. Free regions are uncommitted
+// at the end of the concurrent cycle (or by the full collection) that
+// the request starts.
+class G1PeriodicGC : AllStatic {
+  static volatile jint _request_pending;
+
+  // Time in milliseconds since the end of the last young or full
+  // collection pause.
+  static jlong time_since_last_gc_ms();
+
+  static bool should_request_periodic_gc();
+
+public:
+  // The number of milliseconds the concurrent mark thread should wait
+  // before calling check_for_periodic_gc() again.
+  static jlong wait_time_ms();
+
+  // Posts a request to the ServiceThread if a periodic collection is
+  // due. Called by the concurrent mark thread while it is idle.
+  static void check_for_periodic_gc();
+
+  static bool has_pending_request() { return _request_pending != 0; }
+
+  // Carries out a pending request. Called by the ServiceThread.
+  static void do_pending_request();
+};
+
+#endif // SHARE_VM_GC_IMPLEMENTATION_G1_G1PERIODICGC_HPP
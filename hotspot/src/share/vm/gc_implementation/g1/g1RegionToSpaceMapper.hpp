@@ -62,6 +62,9 @@ class G1RegionToSpaceMapper : public CHeapObj<mtGC> {
 
   void set_mapping_changed_listener(G1MappingChangedListener* listener) { _listener = listener; }
 
+  // Use these workers to pretouch large commits with AlwaysPreTouch.
+  void set_pretouch_workers(FlexibleWorkGang* workers) { _storage.set_pretouch_workers(workers); }
+
   virtual ~G1RegionToSpaceMapper() {
     _commit_map.resize(0, /* in_resource_area */ false);
   }
@@ -75,6 +75,7 @@ G1RemSet::G1RemSet(G1CollectedHeap* g1, CardTableModRefBS* ct_bs)
     _ct_bs(ct_bs), _g1p(_g1->g1_policy()),
     _cg1r(g1->concurrent_g1_refine()),
     _cset_rs_update_cl(NULL),
+    _card_table_scan_next_region(0),
     _cards_scanned(NULL), _total_cards_scanned(0),
     _prev_period_summary()
 {
@@ -168,9 +169,18 @@ public:
                            card_start, card_start + G1BlockOffsetSharedArray::N_words);
   }
 
+  // The code roots are claimed in blocks of buckets, like the cards, so
+  // that the workers share regions with large code root lists instead
+  // of leaving them to the worker that claimed the region.
   void scan_strong_code_roots(HeapRegion* r) {
+    const int block_size = 4;
     double scan_start = os::elapsedTime();
-    r->strong_code_roots_do(_code_root_cl);
+    HeapRegionRemSet* hrrs = r->rem_set();
+    int table_size = hrrs->strong_code_roots_table_size();
+    int from;
+    while ((from = hrrs->code_roots_claimed_next(block_size)) < table_size) {
+      hrrs->strong_code_roots_do(_code_root_cl, from, MIN2(from + block_size, table_size));
+    }
     _strong_code_root_scan_time_sec += (os::elapsedTime() - scan_start);
   }
 
@@ -218,10 +228,10 @@ public:
         scanCard(card_index, card_region);
       }
     }
-    if (!_try_claimed) {
-      // Scan the strong code root list attached to the current region
-      scan_strong_code_roots(r);
+    // Scan the strong code root list attached to the current region
+    scan_strong_code_roots(r);
 
+    if (!_try_claimed) {
       hrrs->set_iter_complete();
     }
     return false;
@@ -257,6 +267,27 @@ void G1RemSet::scanRS(G1ParPushHeapRSClosure* oc,
   _g1p->phase_times()->record_time_secs(G1GCPhaseTimes::CodeRoots, worker_i, scanRScl.strong_code_root_scan_time_sec());
 }
 
+void G1RemSet::scan_optional_rem_sets(G1ParPushHeapRSClosure* oc,
+                                      CodeBlobClosure* code_root_cl,
+                                      GrowableArray<HeapRegion*>* regions,
+                                      uint worker_i) {
+  ScanRSClosure scanRScl(oc, code_root_cl, worker_i);
+
+  // Start at a different region for each worker to reduce contention on
+  // the remembered set iteration claims, then help with any regions that
+  // others have claimed but not yet completed.
+  int num_regions = regions->length();
+  for (int pass = 0; pass < 2; pass++) {
+    for (int i = 0; i < num_regions; i++) {
+      scanRScl.doHeapRegion(regions->at((int)((worker_i + i) % num_regions)));
+    }
+    scanRScl.set_try_claimed();
+  }
+
+  assert(_cards_scanned != NULL, "invariant");
+  _cards_scanned[worker_i] += scanRScl.cards_done();
+}
+
 // Closure used for updating RSets and recording references that
 // point into the collection set. Only called during an
 // evacuation pause.
@@ -290,12 +321,62 @@ public:
   }
 };
 
+size_t G1RemSet::iterate_dirty_cards_in_card_table(CardTableEntryClosure* cl, uint worker_i) {
+  const jbyte dirty_card = (jbyte)CardTableModRefBS::dirty_card_val();
+  // A word of the card table consisting of clean cards only.
+  const intptr_t clean_word = ~(intptr_t)0;
+  assert(CardTableModRefBS::clean_card_val() == -1, "clean cards must be all ones");
+
+  size_t num_dirty = 0;
+  uint max_regions = _g1->max_regions();
+  while (true) {
+    uint index = (uint)(Atomic::add(1, &_card_table_scan_next_region) - 1);
+    if (index >= max_regions) {
+      break;
+    }
+    HeapRegion* r = _g1->region_at_or_null(index);
+    // Young regions never have dirty cards that need refinement, and
+    // cards in the collection set are not refined during the pause.
+    if (r == NULL || r->is_free() || r->is_young() || r->in_collection_set()) {
+      continue;
+    }
+
+    jbyte* cur = (jbyte*)_ct_bs->byte_for_index(_ct_bs->index_for(r->bottom()));
+    jbyte* const end = cur + HeapRegion::CardsPerRegion;
+    while (cur < end) {
+      // Regions are card table word aligned, so we can skip clean
+      // cards a word at a time.
+      if (is_ptr_aligned(cur, sizeof(intptr_t)) && *(intptr_t*)cur == clean_word) {
+        cur += sizeof(intptr_t);
+        continue;
+      }
+      if (*cur == dirty_card) {
+        num_dirty++;
+        cl->do_card_ptr(cur, worker_i);
+      }
+      cur++;
+    }
+  }
+  return num_dirty;
+}
+
 void G1RemSet::updateRS(DirtyCardQueue* into_cset_dcq, uint worker_i) {
   G1GCParPhaseTimesTracker x(_g1p->phase_times(), G1GCPhaseTimes::UpdateRS, worker_i);
   // Apply the given closure to all remaining log entries.
   RefineRecordRefsIntoCSCardTableEntryClosure into_cset_update_rs_cl(_g1, into_cset_dcq);
 
-  _g1->iterate_dirty_card_closure(&into_cset_update_rs_cl, into_cset_dcq, false, worker_i);
+  if (G1UpdateRSFromCardTable) {
+    // The dirty card logs have been abandoned at the start of the pause;
+    // the card table itself tells us which cards still need refinement.
+    // Refine the cards in the hot card cache first, they are no longer
+    // dirty afterwards and will be skipped by the card table scan.
+    _cg1r->hot_card_cache()->drain(worker_i, this, into_cset_dcq);
+    // There are no buffers; report the dirty cards found instead
+    size_t num_dirty = iterate_dirty_cards_in_card_table(&into_cset_update_rs_cl, worker_i);
+    _g1p->phase_times()->record_thread_work_item(G1GCPhaseTimes::UpdateRS, worker_i, num_dirty);
+  } else {
+    _g1->iterate_dirty_card_closure(&into_cset_update_rs_cl, into_cset_dcq, false, worker_i);
+  }
 }
 
 void G1RemSet::cleanupHRRS() {
@@ -337,7 +418,14 @@ void G1RemSet::oops_into_collection_set_do(G1ParPushHeapRSClosure* oc,
 void G1RemSet::prepare_for_oops_into_collection_set_do() {
   _g1->set_refine_cte_cl_concurrency(false);
   DirtyCardQueueSet& dcqs = JavaThread::dirty_card_queue_set();
-  dcqs.concatenate_logs();
+  if (G1UpdateRSFromCardTable) {
+    // Every logged card is still dirty in the card table, which is
+    // scanned instead during the pause, so the logs can be dropped.
+    dcqs.abandon_logs();
+    _card_table_scan_next_region = 0;
+  } else {
+    dcqs.concatenate_logs();
+  }
 
   guarantee( _cards_scanned == NULL, "invariant" );
   _cards_scanned = NEW_C_HEAP_ARRAY(size_t, n_workers(), mtGC);
@@ -503,7 +591,7 @@ bool G1RemSet::refine_card(jbyte* card_ptr, uint worker_i,
     assert(!check_for_refs_into_cset, "sanity");
     assert(!SafepointSynchronize::is_at_safepoint(), "sanity");
 
-    card_ptr = hot_card_cache->insert(card_ptr);
+    card_ptr = hot_card_cache->insert(card_ptr, worker_i);
     if (card_ptr == NULL) {
       // There was no eviction. Nothing to do.
       return false;
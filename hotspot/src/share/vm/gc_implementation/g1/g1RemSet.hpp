@@ -26,6 +26,7 @@
 #define SHARE_VM_GC_IMPLEMENTATION_G1_G1REMSET_HPP
 
 #include "gc_implementation/g1/g1RemSetSummary.hpp"
+#include "utilities/growableArray.hpp"
 
 // A G1RemSet provides ways of iterating over pointers into a selected
 // collection set.
@@ -33,6 +34,7 @@
 class G1CollectedHeap;
 class CardTableModRefBarrierSet;
 class ConcurrentG1Refine;
+class CardTableEntryClosure;
 class G1ParPushHeapRSClosure;
 
 // A G1RemSet in which each heap region has a rem set that records the
@@ -70,6 +72,15 @@ protected:
   // references into the collection set.
   G1ParPushHeapRSClosure** _cset_rs_update_cl;
 
+  // The index of the next region to be claimed when updating remembered
+  // sets by scanning the card table (G1UpdateRSFromCardTable).
+  volatile jint _card_table_scan_next_region;
+
+  // Apply cl to all dirty cards in the card table, claiming regions in
+  // parallel with other workers. Returns the number of dirty cards found
+  // by this worker.
+  size_t iterate_dirty_cards_in_card_table(CardTableEntryClosure* cl, uint worker_i);
+
   // Print the given summary info
   virtual void print_summary_info(G1RemSetSummary * summary, const char * header = NULL);
 public:
@@ -111,6 +122,18 @@ public:
               CodeBlobClosure* code_root_cl,
               uint worker_i);
 
+  // Scan the remembered sets and strong code roots of the given optional
+  // collection set regions that have just been added to the collection set.
+  // Cards already scanned earlier in the pause are skipped, as they are
+  // still claimed; references from them into the optional regions have
+  // been recorded instead. Must be called between
+  // prepare_for_oops_into_collection_set_do and
+  // cleanup_after_oops_into_collection_set_do.
+  void scan_optional_rem_sets(G1ParPushHeapRSClosure* oc,
+                              CodeBlobClosure* code_root_cl,
+                              GrowableArray<HeapRegion*>* regions,
+                              uint worker_i);
+
   void updateRS(DirtyCardQueue* into_cset_dcq, uint worker_i);
 
   CardTableModRefBS* ct_bs() { return _ct_bs; }
@@ -160,9 +160,8 @@ private:
     return percent_of(_code_root_elems, total);
   }
 
-  size_t amount() const { return _amount; }
-
 public:
+  size_t amount() const { return _amount; }
 
   RegionTypeCounter(const char* name) : _name(name), _rs_mem_size(0), _cards_occupied(0),
     _amount(0), _code_root_mem_size(0), _code_root_elems(0) { }
@@ -216,6 +215,9 @@ private:
   RegionTypeCounter _old;
   RegionTypeCounter _all;
 
+  // Old regions whose remembered set is not maintained.
+  size_t _untracked_old;
+
   size_t _max_rs_mem_sz;
   HeapRegion* _max_rs_mem_sz_region;
 
@@ -236,7 +238,8 @@ private:
 
 public:
   HRRSStatsIter() : _all("All"), _young("Young"), _humonguous("Humonguous"),
-    _free("Free"), _old("Old"), _max_code_root_mem_sz_region(NULL), _max_rs_mem_sz_region(NULL),
+    _free("Free"), _old("Old"), _untracked_old(0),
+    _max_code_root_mem_sz_region(NULL), _max_rs_mem_sz_region(NULL),
     _max_rs_mem_sz(0), _max_code_root_mem_sz(0)
   {}
 
@@ -267,6 +270,9 @@ public:
       current = &_humonguous;
     } else if (r->is_old()) {
       current = &_old;
+      if (!hrrs->is_tracked()) {
+        _untracked_old++;
+      }
     } else {
       ShouldNotReachHere();
     }
@@ -290,6 +296,8 @@ public:
     for (RegionTypeCounter** current = &counters[0]; *current != NULL; current++) {
       (*current)->print_rs_mem_info_on(out, total_rs_mem_sz());
     }
+    out->print_cr("    " SIZE_FORMAT " of " SIZE_FORMAT " old regions without rem set.",
+                  _untracked_old, _old.amount());
 
     out->print_cr("   Static structures = " SIZE_FORMAT "%s,"
                   " free_lists = " SIZE_FORMAT "%s.",
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "gc_implementation/g1/collectionSetChooser.hpp"
+#include "gc_implementation/g1/g1RemSetTrackingPolicy.hpp"
+#include "gc_implementation/g1/g1_globals.hpp"
+#include "gc_implementation/g1/heapRegion.hpp"
+#include "gc_implementation/g1/heapRegionRemSet.hpp"
+#include "runtime/safepoint.hpp"
+
+void G1RemSetTrackingPolicy::update_at_allocate(HeapRegion* r) {
+  if (G1RebuildRemSetsConcurrently && r->is_old()) {
+    // Old regions only get a remembered set when they are selected as
+    // collection set candidates.
+    r->rem_set()->set_state_untracked();
+  } else {
+    r->rem_set()->set_state_complete();
+  }
+}
+
+bool G1RemSetTrackingPolicy::update_before_rebuild(HeapRegion* r, size_t live_bytes) {
+  assert(SafepointSynchronize::is_at_safepoint(), "should be at safepoint");
+
+  if (!r->is_old()) {
+    return false;
+  }
+  HeapRegionRemSet* hrrs = r->rem_set();
+  if (hrrs->is_tracked()) {
+    // Nothing to rebuild.
+    return false;
+  }
+  // Completely empty regions are freed at cleanup, and regions that are
+  // too full are never added to the collection set.
+  if (live_bytes == 0 ||
+      !CollectionSetChooser::region_occupancy_low_enough_for_evac(live_bytes)) {
+    return false;
+  }
+  hrrs->set_state_updating();
+  return true;
+}
+
+void G1RemSetTrackingPolicy::update_after_rebuild(HeapRegion* r) {
+  assert(SafepointSynchronize::is_at_safepoint(), "should be at safepoint");
+
+  if (r->rem_set()->is_updating()) {
+    r->rem_set()->set_state_complete();
+  }
+}
+
+void G1RemSetTrackingPolicy::drop_rem_set(HeapRegion* r) {
+  assert(SafepointSynchronize::is_at_safepoint(), "should be at safepoint");
+
+  if (!G1RebuildRemSetsConcurrently || !r->is_old()) {
+    return;
+  }
+  // Keep the strong code roots: they are not rebuilt by marking.
+  r->rem_set()->clear(true /* only_cardset */);
+  r->rem_set()->set_state_untracked();
+}
+
+void G1RemSetTrackingPolicy::update_after_full_gc(HeapRegion* r) {
+  assert(SafepointSynchronize::is_at_safepoint(), "should be at safepoint");
+
+  if (G1RebuildRemSetsConcurrently && r->is_old()) {
+    r->rem_set()->set_state_untracked();
+  } else {
+    r->rem_set()->set_state_complete();
+  }
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_GC_IMPLEMENTATION_G1_G1REMSETTRACKINGPOLICY_HPP
+#define SHARE_VM_GC_IMPLEMENTATION_G1_G1REMSETTRACKINGPOLICY_HPP
+
+#include "memory/allocation.hpp"
+
+class HeapRegion;
+
+// Decides which regions maintain a remembered set.
+//
+// Young and humongous regions always have a complete remembered set.
+// With G1RebuildRemSetsConcurrently, old regions start out without a
+// remembered set. Remark selects the old regions that are going to be
+// collection set candidates, and concurrent marking rebuilds their
+// remembered sets before they may be added to the collection set. Old
+// regions that do not become candidates, or that are not collected by
+// the following mixed collections, drop their remembered set again.
+class G1RemSetTrackingPolicy VALUE_OBJ_CLASS_SPEC {
+public:
+  // Called when the region is allocated as an old gc alloc region.
+  void update_at_allocate(HeapRegion* r);
+
+  // Called at remark for every region. Returns whether the remembered set
+  // of the region should be rebuilt, and if so moves it to the Updating
+  // state.
+  bool update_before_rebuild(HeapRegion* r, size_t live_bytes);
+
+  // Called at cleanup for every region that survived marking. Completes
+  // a remembered set that has been rebuilt.
+  void update_after_rebuild(HeapRegion* r);
+
+  // Drops the remembered set of an old region that is not going to be
+  // evacuated in the current cycle.
+  void drop_rem_set(HeapRegion* r);
+
+  // Called for every region after a full collection.
+  void update_after_full_gc(HeapRegion* r);
+};
+
+#endif // SHARE_VM_GC_IMPLEMENTATION_G1_G1REMSETTRACKINGPOLICY_HPP
@@ -359,6 +359,15 @@ void G1RootProcessor::scan_remembered_sets(G1ParPushHeapRSClosure* scan_rs,
   _g1h->g1_rem_set()->oops_into_collection_set_do(scan_rs, &scavenge_cs_nmethods, worker_i);
 }
 
+void G1RootProcessor::scan_optional_remembered_sets(G1ParPushHeapRSClosure* scan_rs,
+                                                    OopClosure* scan_non_heap_weak_roots,
+                                                    GrowableArray<HeapRegion*>* regions,
+                                                    uint worker_i) {
+  G1CodeBlobClosure scavenge_cs_nmethods(scan_non_heap_weak_roots);
+
+  G1CollectedHeap::heap()->g1_rem_set()->scan_optional_rem_sets(scan_rs, &scavenge_cs_nmethods, regions, worker_i);
+}
+
 void G1RootProcessor::set_num_workers(int active_workers) {
   _process_strong_tasks.set_n_threads(active_workers);
 }
@@ -28,6 +28,7 @@
 #include "memory/allocation.hpp"
 #include "memory/sharedHeap.hpp"
 #include "runtime/mutex.hpp"
+#include "utilities/growableArray.hpp"
 
 class CLDClosure;
 class CodeBlobClosure;
@@ -35,6 +36,7 @@ class G1CollectedHeap;
 class G1GCPhaseTimes;
 class G1ParPushHeapRSClosure;
 class G1RootClosures;
+class HeapRegion;
 class Monitor;
 class OopClosure;
 class SubTasksDone;
@@ -128,6 +130,14 @@ public:
                             OopClosure* scan_non_heap_weak_roots,
                             uint worker_i);
 
+  // Apply scan_rs to all locations in the remembered sets of the given optional
+  // collection set regions, and scan_non_heap_weak_roots to their strong code
+  // roots. Does not depend on any root processing state of the pause.
+  static void scan_optional_remembered_sets(G1ParPushHeapRSClosure* scan_rs,
+                                            OopClosure* scan_non_heap_weak_roots,
+                                            GrowableArray<HeapRegion*>* regions,
+                                            uint worker_i);
+
   // Apply oops, clds and blobs to strongly and weakly reachable roots in the system,
   // the only thing different from process_all_roots is that we skip the string table
   // to avoid keeping every string live when doing class unloading.
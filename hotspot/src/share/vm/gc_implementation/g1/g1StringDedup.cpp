@@ -33,11 +33,16 @@
 #include "gc_implementation/g1/g1StringDedupThread.hpp"
 
 bool G1StringDedup::_enabled = false;
+uint G1StringDedup::_num_threads = 0;
 
 void G1StringDedup::initialize() {
-  assert(UseG1GC, "String deduplication only available with G1");
+  assert(UseG1GC || UseParallelGC || UseConcMarkSweepGC,
+         "String deduplication only available with G1, ParallelGC and CMS");
   if (UseStringDeduplication) {
     _enabled = true;
+    // Each deduplication thread owns at least one GC worker queue
+    _num_threads = (uint)MIN2(MAX2(StringDeduplicationThreads, (uintx)1),
+                              MAX2(ParallelGCThreads, (uintx)1));
     G1StringDedupQueue::create();
     G1StringDedupTable::create();
     G1StringDedupThread::create();
@@ -49,9 +54,17 @@ void G1StringDedup::stop() {
   G1StringDedupThread::stop();
 }
 
+bool G1StringDedup::is_in_young(oop obj) {
+  if (UseG1GC) {
+    return G1CollectedHeap::heap()->heap_region_containing_raw(obj)->is_young();
+  }
+  // For the generational collectors only the young generation is scavengable
+  return Universe::heap()->is_scavengable(obj);
+}
+
 bool G1StringDedup::is_candidate_from_mark(oop obj) {
   if (java_lang_String::is_instance(obj)) {
-    bool from_young = G1CollectedHeap::heap()->heap_region_containing_raw(obj)->is_young();
+    bool from_young = is_in_young(obj);
     if (from_young && obj->age() < StringDeduplicationAgeThreshold) {
       // Candidate found. String is being evacuated from young to old but has not
       // reached the deduplication age threshold, i.e. has not previously been a
@@ -64,10 +77,10 @@ bool G1StringDedup::is_candidate_from_mark(oop obj) {
   return false;
 }
 
-void G1StringDedup::enqueue_from_mark(oop java_string) {
+void G1StringDedup::enqueue_from_mark(oop java_string, uint worker_id) {
   assert(is_enabled(), "String deduplication not enabled");
   if (is_candidate_from_mark(java_string)) {
-    G1StringDedupQueue::push(0 /* worker_id */, java_string);
+    G1StringDedupQueue::push(worker_id, java_string);
   }
 }
 
@@ -151,7 +164,7 @@ void G1StringDedup::unlink_or_oops_do(BoolObjectClosure* is_alive,
   assert(is_enabled(), "String deduplication not enabled");
 
   G1StringDedupUnlinkOrOopsDoTask task(is_alive, keep_alive, allow_resize_and_rehash, phase_times);
-  if (G1CollectedHeap::use_parallel_gc_threads()) {
+  if (UseG1GC && G1CollectedHeap::use_parallel_gc_threads()) {
     G1CollectedHeap* g1h = G1CollectedHeap::heap();
     g1h->set_par_threads();
     g1h->workers()->run_task(&task);
@@ -163,13 +176,17 @@ void G1StringDedup::unlink_or_oops_do(BoolObjectClosure* is_alive,
 
 void G1StringDedup::threads_do(ThreadClosure* tc) {
   assert(is_enabled(), "String deduplication not enabled");
-  tc->do_thread(G1StringDedupThread::thread());
+  for (uint i = 0; i < _num_threads; i++) {
+    tc->do_thread(G1StringDedupThread::thread(i));
+  }
 }
 
 void G1StringDedup::print_worker_threads_on(outputStream* st) {
   assert(is_enabled(), "String deduplication not enabled");
-  G1StringDedupThread::thread()->print_on(st);
-  st->cr();
+  for (uint i = 0; i < _num_threads; i++) {
+    G1StringDedupThread::thread(i)->print_on(st);
+    st->cr();
+  }
 }
 
 void G1StringDedup::verify() {
@@ -38,8 +38,9 @@
 // object is placed on the deduplication queue for later processing. The second part,
 // processing the objects on the deduplication queue, is a concurrent phase which
 // starts right after the stop-the-wold marking/evacuation phase. This phase is
-// executed by the deduplication thread, which pulls deduplication candidates of the
-// deduplication queue and tries to deduplicate them.
+// executed by one or more deduplication threads (see StringDeduplicationThreads),
+// which pull deduplication candidates of the deduplication queue and try to
+// deduplicate them.
 //
 // A deduplication hashtable is used to keep track of all unique character arrays
 // used by String objects. When deduplicating, a lookup is made in this table to see
@@ -78,6 +79,16 @@
 // filtering them out. This has not shown to be a problem, as the number of interned
 // strings is usually dwarfed by the number of normal (non-interned) strings.
 //
+// Collector support
+//
+// Although implemented as part of G1, the deduplication queue, table and threads
+// do not depend on G1 and are also used by ParallelGC and CMS. With those collectors
+// candidates are enqueued by the young collector (PSPromotionManager and ParNew)
+// when strings are copied, and the queue and table are processed as weak roots by
+// the young and full collections (PSMarkSweep, PSParallelCompact, GenMarkSweep and
+// CMS remark). For these collectors, "young heap region" above means the young
+// generation and "old heap region" means the old generation.
+//
 // For additional information on string deduplication, please see JEP 192,
 // http://openjdk.java.net/jeps/192
 //
@@ -100,6 +111,9 @@ private:
   // Single state for checking if both G1 and string deduplication is enabled.
   static bool _enabled;
 
+  // Number of concurrent deduplication threads.
+  static uint _num_threads;
+
   // Candidate selection policies, returns true if the given object is
   // candidate for string deduplication.
   static bool is_candidate_from_mark(oop obj);
@@ -114,9 +128,18 @@ public:
   // Initialize string deduplication.
   static void initialize();
 
-  // Stop the deduplication thread.
+  // Stop the deduplication threads.
   static void stop();
 
+  // Returns the number of concurrent deduplication threads.
+  static uint num_threads() {
+    return _num_threads;
+  }
+
+  // Returns true if the given object is in the young generation
+  // of the current collector.
+  static bool is_in_young(oop obj);
+
   // Immediately deduplicates the given String object, bypassing the
   // the deduplication queue.
   static void deduplicate(oop java_string);
@@ -124,7 +147,7 @@ public:
   // Enqueues a deduplication candidate for later processing by the deduplication
   // thread. Before enqueuing, these functions apply the appropriate candidate
   // selection policy to filters out non-candidates.
-  static void enqueue_from_mark(oop java_string);
+  static void enqueue_from_mark(oop java_string, uint worker_id);
   static void enqueue_from_evacuation(bool from_young, bool to_young,
                                       unsigned int queue, oop java_string);
 
@@ -24,6 +24,7 @@
 
 #include "precompiled.hpp"
 #include "classfile/javaClasses.hpp"
+#include "gc_implementation/g1/g1StringDedup.hpp"
 #include "gc_implementation/g1/g1StringDedupQueue.hpp"
 #include "memory/gcLocker.hpp"
 #include "runtime/mutexLocker.hpp"
@@ -34,15 +35,23 @@ const size_t        G1StringDedupQueue::_max_size = 1000000; // Max number of el
 const size_t        G1StringDedupQueue::_max_cache_size = 0; // Max cache size per queue
 
 G1StringDedupQueue::G1StringDedupQueue() :
-  _cursor(0),
   _cancel(false),
-  _empty(true),
   _dropped(0) {
   _nqueues = MAX2(ParallelGCThreads, (size_t)1);
   _queues = NEW_C_HEAP_ARRAY(G1StringDedupWorkerQueue, _nqueues, mtGC);
   for (size_t i = 0; i < _nqueues; i++) {
     new (_queues + i) G1StringDedupWorkerQueue(G1StringDedupWorkerQueue::default_segment_size(), _max_cache_size, _max_size);
   }
+
+  // Each deduplication worker starts with the first queue it owns
+  _nworkers = G1StringDedup::num_threads();
+  assert(_nworkers >= 1 && _nworkers <= _nqueues, "Invalid number of deduplication workers");
+  _cursors = NEW_C_HEAP_ARRAY(size_t, _nworkers, mtGC);
+  _empty = NEW_C_HEAP_ARRAY(volatile bool, _nworkers, mtGC);
+  for (size_t i = 0; i < _nworkers; i++) {
+    _cursors[i] = i;
+    _empty[i] = true;
+  }
 }
 
 G1StringDedupQueue::~G1StringDedupQueue() {
@@ -54,9 +63,10 @@ void G1StringDedupQueue::create() {
   _queue = new G1StringDedupQueue();
 }
 
-void G1StringDedupQueue::wait() {
+void G1StringDedupQueue::wait(uint dedup_worker_id) {
+  assert(dedup_worker_id < _queue->_nworkers, "Invalid deduplication worker");
   MonitorLockerEx ml(StringDedupQueue_lock, Mutex::_no_safepoint_check_flag);
-  while (_queue->_empty && !_queue->_cancel) {
+  while (_queue->_empty[dedup_worker_id] && !_queue->_cancel) {
     ml.wait(Mutex::_no_safepoint_check_flag);
   }
 }
@@ -64,7 +74,7 @@ void G1StringDedupQueue::wait() {
 void G1StringDedupQueue::cancel_wait() {
   MonitorLockerEx ml(StringDedupQueue_lock, Mutex::_no_safepoint_check_flag);
   _queue->_cancel = true;
-  ml.notify();
+  ml.notify_all();
 }
 
 void G1StringDedupQueue::push(uint worker_id, oop java_string) {
@@ -75,12 +85,14 @@ void G1StringDedupQueue::push(uint worker_id, oop java_string) {
   G1StringDedupWorkerQueue& worker_queue = _queue->_queues[worker_id];
   if (!worker_queue.is_full()) {
     worker_queue.push(java_string);
-    if (_queue->_empty) {
+    size_t dedup_worker_id = _queue->queue_to_worker(worker_id);
+    if (_queue->_empty[dedup_worker_id]) {
       MonitorLockerEx ml(StringDedupQueue_lock, Mutex::_no_safepoint_check_flag);
-      if (_queue->_empty) {
-        // Mark non-empty and notify waiter
-        _queue->_empty = false;
-        ml.notify();
+      if (_queue->_empty[dedup_worker_id]) {
+        // Mark non-empty and notify waiter. All deduplication workers
+        // wait on the same monitor, so we need to wake up all of them.
+        _queue->_empty[dedup_worker_id] = false;
+        ml.notify_all();
       }
     }
   } else {
@@ -89,14 +101,16 @@ void G1StringDedupQueue::push(uint worker_id, oop java_string) {
   }
 }
 
-oop G1StringDedupQueue::pop() {
+oop G1StringDedupQueue::pop(uint dedup_worker_id) {
   assert(!SafepointSynchronize::is_at_safepoint(), "Must not be at safepoint");
+  assert(dedup_worker_id < _queue->_nworkers, "Invalid deduplication worker");
   No_Safepoint_Verifier nsv;
 
-  // Try all queues before giving up
-  for (size_t tries = 0; tries < _queue->_nqueues; tries++) {
+  // Try all queues owned by this worker before giving up
+  size_t& cursor = _queue->_cursors[dedup_worker_id];
+  for (size_t tries = dedup_worker_id; tries < _queue->_nqueues; tries += _queue->_nworkers) {
     // The cursor indicates where we left of last time
-    G1StringDedupWorkerQueue* queue = &_queue->_queues[_queue->_cursor];
+    G1StringDedupWorkerQueue* queue = &_queue->_queues[cursor];
     while (!queue->is_empty()) {
       oop obj = queue->pop();
       // The oop we pop can be NULL if it was marked
@@ -106,12 +120,15 @@ oop G1StringDedupQueue::pop() {
       }
     }
 
-    // Try next queue
-    _queue->_cursor = (_queue->_cursor + 1) % _queue->_nqueues;
+    // Try next queue owned by this worker
+    cursor += _queue->_nworkers;
+    if (cursor >= _queue->_nqueues) {
+      cursor = dedup_worker_id;
+    }
   }
 
   // Mark empty
-  _queue->_empty = true;
+  _queue->_empty[dedup_worker_id] = true;
 
   return NULL;
 }
@@ -47,12 +47,15 @@ class G1StringDedupUnlinkOrOopsDoClosure;
 // thread.
 //
 // Pushing to the queue is thread safe (this relies on each thread using a unique worker
-// id), but only allowed during a safepoint. Popping from the queue is NOT thread safe
-// and can only be done by the deduplication thread outside a safepoint.
+// id), but only allowed during a safepoint. Popping from the queue is done outside a
+// safepoint by the deduplication threads. Each deduplication thread owns a fixed subset
+// of the GC worker queues (every n:th queue, where n is the number of deduplication
+// threads), so popping is thread safe as long as each deduplication thread uses its
+// own deduplication worker id.
 //
 // The StringDedupQueue_lock is only used for blocking and waking up the deduplication
-// thread in case the queue is empty or becomes non-empty, respectively. This lock does
-// not otherwise protect the queue content.
+// threads in case their queues are empty or become non-empty, respectively. This lock
+// does not otherwise protect the queue content.
 //
 class G1StringDedupQueue : public CHeapObj<mtGC> {
 private:
@@ -64,9 +67,10 @@ private:
 
   G1StringDedupWorkerQueue*  _queues;
   size_t                     _nqueues;
-  size_t                     _cursor;
+  size_t                     _nworkers;
+  size_t*                    _cursors;
   bool                       _cancel;
-  volatile bool              _empty;
+  volatile bool*             _empty;
 
   // Statistics counter, only used for logging.
   uintx                      _dropped;
@@ -76,21 +80,27 @@ private:
 
   static void unlink_or_oops_do(G1StringDedupUnlinkOrOopsDoClosure* cl, size_t queue);
 
+  // Returns the deduplication worker owning the given GC worker queue.
+  size_t queue_to_worker(size_t queue) const {
+    return queue % _nworkers;
+  }
+
 public:
   static void create();
 
-  // Blocks and waits for the queue to become non-empty.
-  static void wait();
+  // Blocks and waits for the queues owned by the given deduplication
+  // worker to become non-empty.
+  static void wait(uint dedup_worker_id);
 
-  // Wakes up any thread blocked waiting for the queue to become non-empty.
+  // Wakes up all threads blocked waiting for the queue to become non-empty.
   static void cancel_wait();
 
   // Pushes a deduplication candidate onto a specific GC worker queue.
   static void push(uint worker_id, oop java_string);
 
-  // Pops a deduplication candidate from any queue, returns NULL if
-  // all queues are empty.
-  static oop pop();
+  // Pops a deduplication candidate from any queue owned by the given
+  // deduplication worker, returns NULL if all those queues are empty.
+  static oop pop(uint dedup_worker_id);
 
   static void unlink_or_oops_do(G1StringDedupUnlinkOrOopsDoClosure* cl);
 
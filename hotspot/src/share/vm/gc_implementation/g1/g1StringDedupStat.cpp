@@ -68,7 +68,8 @@ void G1StringDedupStat::add(const G1StringDedupStat& stat) {
   _block_elapsed       += stat._block_elapsed;
 }
 
-void G1StringDedupStat::print_summary(outputStream* st, const G1StringDedupStat& last_stat, const G1StringDedupStat& total_stat) {
+void G1StringDedupStat::print_summary(outputStream* st, const G1StringDedupStat& last_stat, const G1StringDedupStat& total_stat,
+                                      uint worker_id, uint num_workers) {
   double total_deduped_bytes_percent = 0.0;
 
   if (total_stat._new_bytes > 0) {
@@ -78,8 +79,11 @@ void G1StringDedupStat::print_summary(outputStream* st, const G1StringDedupStat&
 
   st->date_stamp(PrintGCDateStamps);
   st->stamp(PrintGCTimeStamps);
+  st->print("[GC concurrent-string-deduplication, ");
+  if (num_workers > 1) {
+    st->print("worker %u, ", worker_id);
+  }
   st->print_cr(
-    "[GC concurrent-string-deduplication, "
     G1_STRDEDUP_BYTES_FORMAT_NS "->" G1_STRDEDUP_BYTES_FORMAT_NS "(" G1_STRDEDUP_BYTES_FORMAT_NS "), avg "
     G1_STRDEDUP_PERCENT_FORMAT_NS ", " G1_STRDEDUP_TIME_FORMAT "]",
     G1_STRDEDUP_BYTES_PARAM(last_stat._new_bytes),
@@ -135,7 +135,9 @@ public:
 
   void add(const G1StringDedupStat& stat);
 
-  static void print_summary(outputStream* st, const G1StringDedupStat& last_stat, const G1StringDedupStat& total_stat);
+  // The worker id is only included in the summary if there is more than one worker.
+  static void print_summary(outputStream* st, const G1StringDedupStat& last_stat, const G1StringDedupStat& total_stat,
+                            uint worker_id, uint num_workers);
   static void print_statistics(outputStream* st, const G1StringDedupStat& stat, bool total);
 };
 
@@ -27,12 +27,15 @@
 #include "classfile/javaClasses.hpp"
 #include "gc_implementation/g1/g1CollectedHeap.inline.hpp"
 #include "gc_implementation/g1/g1SATBCardTableModRefBS.hpp"
+#include "gc_implementation/g1/g1StringDedup.hpp"
 #include "gc_implementation/g1/g1StringDedupTable.hpp"
 #include "gc_implementation/shared/concurrentGCThread.hpp"
 #include "memory/gcLocker.hpp"
 #include "memory/padded.inline.hpp"
 #include "oops/typeArrayOop.hpp"
+#include "runtime/atomic.inline.hpp"
 #include "runtime/mutexLocker.hpp"
+#include "runtime/orderAccess.inline.hpp"
 
 //
 // List of deduplication table entries. Links table
@@ -85,9 +88,10 @@ public:
 // the cache. The deduplication thread, which executes in a concurrent phase, will
 // later reuse or free the underlying memory for these entries.
 //
-// The cache allows for single-threaded allocations and multi-threaded frees.
-// Allocations are synchronized by StringDedupTable_lock as part of a table
-// modification.
+// The cache allows for multi-threaded allocations and frees. Allocations are
+// synchronized by StringDedupTable_lock, since several deduplication threads
+// can add table entries at the same time. Frees are done during safepoints
+// using one list per GC worker.
 //
 class G1StringDedupEntryCache : public CHeapObj<mtGC> {
 private:
@@ -136,6 +140,7 @@ void G1StringDedupEntryCache::set_max_size(size_t size) {
 }
 
 G1StringDedupEntry* G1StringDedupEntryCache::alloc() {
+  MutexLockerEx ml(StringDedupTable_lock, Mutex::_no_safepoint_check_flag);
   for (size_t i = 0; i < _nlists; i++) {
     G1StringDedupEntry* entry = _cached[i].remove();
     if (entry != NULL) {
@@ -179,8 +184,10 @@ void G1StringDedupEntryCache::delete_overflowed() {
     {
       // The overflow list can be modified during safepoints, therefore
       // we temporarily join the suspendible thread set while removing
-      // all entries from the list.
+      // all entries from the list. The lock protects against other
+      // deduplication threads cleaning the cache at the same time.
       SuspendibleThreadSetJoiner sts_join;
+      MutexLockerEx ml(StringDedupTable_lock, Mutex::_no_safepoint_check_flag);
       entry = _overflowed[i].remove_all();
     }
 
@@ -201,6 +208,8 @@ void G1StringDedupEntryCache::delete_overflowed() {
 
 G1StringDedupTable*      G1StringDedupTable::_table = NULL;
 G1StringDedupEntryCache* G1StringDedupTable::_entry_cache = NULL;
+Mutex**                  G1StringDedupTable::_partition_locks = NULL;
+size_t                   G1StringDedupTable::_npartition_locks = 0;
 
 const size_t             G1StringDedupTable::_min_size = (1 << 10);   // 1024
 const size_t             G1StringDedupTable::_max_size = (1 << 24);   // 16777216
@@ -235,6 +244,18 @@ void G1StringDedupTable::create() {
   assert(_table == NULL, "One string deduplication table allowed");
   _entry_cache = new G1StringDedupEntryCache((size_t)(_min_size * _max_cache_factor));
   _table = new G1StringDedupTable(_min_size);
+
+  // One partition lock per deduplication thread, rounded up to a power of
+  // two. The partition locks have a higher rank than StringDedupTable_lock,
+  // which is acquired when allocating a new entry.
+  _npartition_locks = 1;
+  while (_npartition_locks < G1StringDedup::num_threads()) {
+    _npartition_locks *= 2;
+  }
+  _partition_locks = NEW_C_HEAP_ARRAY(Mutex*, _npartition_locks, mtGC);
+  for (size_t i = 0; i < _npartition_locks; i++) {
+    _partition_locks[i] = new Mutex(Mutex::leaf + 1, "StringDedupTable partition lock", true);
+  }
 }
 
 void G1StringDedupTable::add(typeArrayOop value, unsigned int hash, G1StringDedupEntry** list) {
@@ -242,8 +263,9 @@ void G1StringDedupTable::add(typeArrayOop value, unsigned int hash, G1StringDedu
   entry->set_obj(value);
   entry->set_hash(hash);
   entry->set_next(*list);
-  *list = entry;
-  _entries++;
+  // Publish the fully initialized entry to lock-free readers
+  OrderAccess::release_store_ptr(list, entry);
+  Atomic::inc_ptr(&_entries);
 }
 
 void G1StringDedupTable::remove(G1StringDedupEntry** pentry, uint worker_id) {
@@ -263,16 +285,21 @@ void G1StringDedupTable::transfer(G1StringDedupEntry** pentry, G1StringDedupTabl
 }
 
 bool G1StringDedupTable::equals(typeArrayOop value1, typeArrayOop value2) {
+  // With compact strings the value arrays are byte[] of either coder. Equal
+  // bytes are all that sharing an array requires, since each String keeps
+  // its own coder.
+  size_t elem_size = java_lang_String::has_coder_field() ? sizeof(jbyte) : sizeof(jchar);
   return (value1 == value2 ||
           (value1->length() == value2->length() &&
            (!memcmp(value1->base(T_CHAR),
                     value2->base(T_CHAR),
-                    value1->length() * sizeof(jchar)))));
+                    value1->length() * elem_size))));
 }
 
 typeArrayOop G1StringDedupTable::lookup(typeArrayOop value, unsigned int hash,
                                         G1StringDedupEntry** list, uintx &count) {
-  for (G1StringDedupEntry* entry = *list; entry != NULL; entry = entry->next()) {
+  G1StringDedupEntry* head = (G1StringDedupEntry*)OrderAccess::load_ptr_acquire(list);
+  for (G1StringDedupEntry* entry = head; entry != NULL; entry = entry->next()) {
     if (entry->hash() == hash) {
       typeArrayOop existing_value = entry->obj();
       if (equals(value, existing_value)) {
@@ -292,28 +319,46 @@ typeArrayOop G1StringDedupTable::lookup_or_add_inner(typeArrayOop value, unsigne
   G1StringDedupEntry** list = bucket(index);
   uintx count = 0;
 
-  // Lookup in list
+  // Lock-free lookup in list
   typeArrayOop existing_value = lookup(value, hash, list, count);
 
+  if (existing_value == NULL) {
+    // Not found, retry the lookup under the partition lock since another
+    // thread could have added the same value since the first lookup
+    MutexLockerEx ml(partition_lock(index), Mutex::_no_safepoint_check_flag);
+    count = 0;
+    existing_value = lookup(value, hash, list, count);
+    if (existing_value == NULL) {
+      // Still not found, add new entry
+      add(value, hash, list);
+
+      // Update statistics
+      Atomic::inc_ptr(&_entries_added);
+    }
+  }
+
   // Check if rehash is needed
   if (count > _rehash_threshold) {
     _rehash_needed = true;
   }
 
-  if (existing_value == NULL) {
-    // Not found, add new entry
-    add(value, hash, list);
-
-    // Update statistics
-    _entries_added++;
-  }
-
   return existing_value;
 }
 
 unsigned int G1StringDedupTable::hash_code(typeArrayOop value) {
   unsigned int hash;
   int length = value->length();
+
+  if (java_lang_String::has_coder_field()) {
+    const jubyte* data = (jubyte*)value->base(T_BYTE);
+    if (use_java_hash()) {
+      hash = java_lang_String::hash_code(data, length);
+    } else {
+      hash = AltHashing::halfsiphash_32(_table->_hash_seed, (const uint8_t*)data, length);
+    }
+    return hash;
+  }
+
   const jchar* data = (jchar*)value->base(T_CHAR);
 
   if (use_java_hash()) {
@@ -367,14 +412,17 @@ void G1StringDedupTable::deduplicate(oop java_string, G1StringDedupStat& stat) {
   stat.inc_new(size_in_bytes);
 
   if (existing_value != NULL) {
-    // Enqueue the reference to make sure it is kept alive. Concurrent mark might
-    // otherwise declare it dead if there are no other strong references to this object.
-    G1SATBCardTableModRefBS::enqueue(existing_value);
+    if (UseG1GC) {
+      // Enqueue the reference to make sure it is kept alive. Concurrent mark might
+      // otherwise declare it dead if there are no other strong references to this object.
+      // With CMS the card mark done when updating the value field serves the same purpose.
+      G1SATBCardTableModRefBS::enqueue(existing_value);
+    }
 
     // Existing value found, deduplicate string
     java_lang_String::set_value(java_string, existing_value);
 
-    if (G1CollectedHeap::heap()->is_in_young(value)) {
+    if (G1StringDedup::is_in_young(value)) {
       stat.inc_deduped_young(size_in_bytes);
     } else {
       stat.inc_deduped_old(size_in_bytes);
@@ -94,10 +94,17 @@ public:
 // The table is also dynamically rehashed (using a new hash seed) if it becomes severely
 // unbalanced, i.e., a hash chain is significantly longer than average.
 //
-// All access to the table is protected by the StringDedupTable_lock, except under
-// safepoints in which case GC workers are allowed to access a table partitions they
-// have claimed without first acquiring the lock. Note however, that this applies only
-// the table partition (i.e. a range of elements in _buckets), not other parts of the
+// Outside of safepoints, lookups in the table are lock-free. Entries are only ever
+// prepended to a hash chain (and published with release semantics), and entries are
+// only unlinked from the table, and the table itself only resized or rehashed, during
+// safepoints when no deduplication thread is accessing the table. Adding a new entry
+// requires holding the partition lock covering the hash bucket, which allows multiple
+// deduplication threads to add entries to different parts of the table in parallel.
+// The lookup is repeated under the partition lock to avoid adding duplicates.
+//
+// Under safepoints GC workers are allowed to access a table partitions they have
+// claimed without first acquiring any lock. Note however, that this applies only the
+// table partition (i.e. a range of elements in _buckets), not other parts of the
 // table such as the _entries field, statistics counters, etc.
 //
 class G1StringDedupTable : public CHeapObj<mtGC> {
@@ -109,6 +116,11 @@ private:
   // Cache for reuse and fast alloc/free of table entries.
   static G1StringDedupEntryCache* _entry_cache;
 
+  // Locks protecting additions to the table. Hash buckets are mapped
+  // to locks using the low bits of the bucket index.
+  static Mutex**                  _partition_locks;
+  static size_t                   _npartition_locks;
+
   G1StringDedupEntry**            _buckets;
   size_t                          _size;
   uintx                           _entries;
@@ -150,6 +162,11 @@ private:
     return (size_t)hash & (_size - 1);
   }
 
+  // Returns the lock protecting additions to the given hash bucket.
+  static Mutex* partition_lock(size_t index) {
+    return _partition_locks[index & (_npartition_locks - 1)];
+  }
+
   // Adds a new table entry to the given hash bucket.
   void add(typeArrayOop value, unsigned int hash, G1StringDedupEntry** list);
 
@@ -168,12 +185,10 @@ private:
   // table entry if no matching character array exists.
   typeArrayOop lookup_or_add_inner(typeArrayOop value, unsigned int hash);
 
-  // Thread safe lookup or add of table entry
+  // Thread safe lookup or add of table entry. The table can only be replaced
+  // by a new instance (if resized or rehashed) during a safepoint, which can
+  // not occur while this lookup is in progress.
   static typeArrayOop lookup_or_add(typeArrayOop value, unsigned int hash) {
-    // Protect the table from concurrent access. Also note that this lock
-    // acts as a fence for _table, which could have been replaced by a new
-    // instance if the table was resized or rehashed.
-    MutexLockerEx ml(StringDedupTable_lock, Mutex::_no_safepoint_check_flag);
     return _table->lookup_or_add_inner(value, hash);
   }
 
@@ -29,11 +29,16 @@
 #include "gc_implementation/g1/g1StringDedupThread.hpp"
 #include "gc_implementation/g1/g1StringDedupQueue.hpp"
 
-G1StringDedupThread* G1StringDedupThread::_thread = NULL;
-
-G1StringDedupThread::G1StringDedupThread() :
-  ConcurrentGCThread() {
-  set_name("G1 StrDedup");
+G1StringDedupThread** G1StringDedupThread::_threads = NULL;
+
+G1StringDedupThread::G1StringDedupThread(uint worker_id) :
+  ConcurrentGCThread(),
+  _worker_id(worker_id) {
+  if (G1StringDedup::num_threads() > 1) {
+    set_name("G1 StrDedup#%u", worker_id);
+  } else {
+    set_name("G1 StrDedup");
+  }
   create_and_start();
 }
 
@@ -43,14 +48,19 @@ G1StringDedupThread::~G1StringDedupThread() {
 
 void G1StringDedupThread::create() {
   assert(G1StringDedup::is_enabled(), "String deduplication not enabled");
-  assert(_thread == NULL, "One string deduplication thread allowed");
-  _thread = new G1StringDedupThread();
+  assert(_threads == NULL, "String deduplication threads already created");
+  uint num_threads = G1StringDedup::num_threads();
+  _threads = NEW_C_HEAP_ARRAY(G1StringDedupThread*, num_threads, mtGC);
+  for (uint i = 0; i < num_threads; i++) {
+    _threads[i] = new G1StringDedupThread(i);
+  }
 }
 
-G1StringDedupThread* G1StringDedupThread::thread() {
+G1StringDedupThread* G1StringDedupThread::thread(uint worker_id) {
   assert(G1StringDedup::is_enabled(), "String deduplication not enabled");
-  assert(_thread != NULL, "String deduplication thread not created");
-  return _thread;
+  assert(_threads != NULL, "String deduplication threads not created");
+  assert(worker_id < G1StringDedup::num_threads(), "Invalid worker id");
+  return _threads[worker_id];
 }
 
 void G1StringDedupThread::run() {
@@ -66,7 +76,7 @@ void G1StringDedupThread::run() {
     stat.mark_idle();
 
     // Wait for the queue to become non-empty
-    G1StringDedupQueue::wait();
+    G1StringDedupQueue::wait(_worker_id);
     if (_should_terminate) {
       break;
     }
@@ -79,7 +89,7 @@ void G1StringDedupThread::run() {
 
       // Process the queue
       for (;;) {
-        oop java_string = G1StringDedupQueue::pop();
+        oop java_string = G1StringDedupQueue::pop(_worker_id);
         if (java_string == NULL) {
           break;
         }
@@ -108,24 +118,32 @@ void G1StringDedupThread::run() {
 }
 
 void G1StringDedupThread::stop() {
+  uint num_threads = G1StringDedup::num_threads();
+
   {
     MonitorLockerEx ml(Terminator_lock);
-    _thread->_should_terminate = true;
+    for (uint i = 0; i < num_threads; i++) {
+      _threads[i]->_should_terminate = true;
+    }
   }
 
   G1StringDedupQueue::cancel_wait();
 
   {
     MonitorLockerEx ml(Terminator_lock);
-    while (!_thread->_has_terminated) {
-      ml.wait();
+    for (uint i = 0; i < num_threads; i++) {
+      while (!_threads[i]->_has_terminated) {
+        ml.wait();
+      }
     }
   }
 }
 
 void G1StringDedupThread::print(outputStream* st, const G1StringDedupStat& last_stat, const G1StringDedupStat& total_stat) {
   if (G1Log::fine() || PrintStringDeduplicationStatistics) {
-    G1StringDedupStat::print_summary(st, last_stat, total_stat);
+    // Keep the output from concurrently printing threads apart
+    ttyLocker ttyl;
+    G1StringDedupStat::print_summary(st, last_stat, total_stat, _worker_id, G1StringDedup::num_threads());
     if (PrintStringDeduplicationStatistics) {
       G1StringDedupStat::print_statistics(st, last_stat, false);
       G1StringDedupStat::print_statistics(st, total_stat, true);
@@ -36,11 +36,17 @@
 // concurrently with the Java application but participates in safepoints to allow
 // the GC to adjust and unlink oops from the deduplication queue and table.
 //
+// There can be more than one deduplication thread (see StringDeduplicationThreads).
+// Each thread has a unique worker id, which selects the part of the deduplication
+// queue it drains. All threads share the deduplication hashtable.
+//
 class G1StringDedupThread: public ConcurrentGCThread {
 private:
-  static G1StringDedupThread* _thread;
+  static G1StringDedupThread** _threads;
+
+  uint _worker_id;
 
-  G1StringDedupThread();
+  G1StringDedupThread(uint worker_id);
   ~G1StringDedupThread();
 
   void print(outputStream* st, const G1StringDedupStat& last_stat, const G1StringDedupStat& total_stat);
@@ -49,7 +55,7 @@ public:
   static void create();
   static void stop();
 
-  static G1StringDedupThread* thread();
+  static G1StringDedupThread* thread(uint worker_id);
 
   virtual void run();
 };
@@ -99,6 +99,11 @@
           "the buffer will be enqueued for processing. A value of 0 "       \
           "specifies that mutator threads should not do such filtering.")   \
                                                                             \
+  product(bool, G1SATBFilterInRefinement, false,                            \
+          "Mutator threads enqueue full SATB buffers without filtering "    \
+          "them, and the concurrent refinement threads filter them in "     \
+          "batches instead")                                                \
+                                                                            \
   develop(bool, G1SATBPrintStubs, false,                                    \
           "If true, print generated stubs for the SATB barrier")            \
                                                                             \
@@ -158,6 +163,16 @@
   product(uintx, G1ConcRSHotCardLimit, 4,                                   \
           "The threshold that defines (>=) a hot card.")                    \
                                                                             \
+  product(bool, G1UseAdaptiveHotCardCacheSize, false,                       \
+          "Resize the parts of the conc RS hot-card cache at every pause "  \
+          "from the number of hot cards inserted, between a fraction and "  \
+          "four times the size given by G1ConcRSLogCacheSize.")             \
+                                                                            \
+  product(uintx, G1ConcRSHotCardAgingInterval, 0,                           \
+          "Halve the refinement counts of cards every this many "           \
+          "evacuation pauses, so that cards no longer modified stop being " \
+          "hot. At most 63 for G1ConcRSHotCardLimit then. 0 means never.")  \
+                                                                            \
   develop(intx, G1RSetRegionEntriesBase, 256,                               \
           "Max number of regions in a fine-grain table per MB.")            \
                                                                             \
@@ -217,6 +232,12 @@
   product(uintx, G1HeapRegionSize, 0,                                       \
           "Size of the G1 regions.")                                        \
                                                                             \
+  product(uintx, G1HumongousObjectSizeHint, 0,                              \
+          "Size in bytes of large objects the application allocates "       \
+          "often, e.g. as reported by G1 humongous allocation events. "     \
+          "If non-zero and G1HeapRegionSize is not set, regions are made "  \
+          "large enough for such objects not to be humongous")              \
+                                                                            \
   product(uintx, G1ConcRefinementThreads, 0,                                \
           "If non-0 is the number of parallel rem set update threads, "     \
           "otherwise the value is determined ergonomically.")               \
@@ -281,6 +302,10 @@
           "Try to reclaim dead large objects that have a few stale "        \
           "references at every young GC.")                                  \
                                                                             \
+  experimental(bool, G1EagerReclaimHumongousObjectArrays, true,            \
+          "Also try to reclaim dead large object arrays at every young "    \
+          "GC, not only large primitive arrays.")                           \
+                                                                            \
   experimental(bool, G1TraceEagerReclaimHumongousObjects, false,            \
           "Print some information about large object liveness "             \
           "at every young GC.")                                             \
@@ -320,6 +345,66 @@
           "Force use of evacuation failure handling during mixed "          \
           "evacuation pauses")                                              \
                                                                             \
+  product(bool, G1UseAdaptiveIHOP, false,                                   \
+          "Adaptively adjust the initiating heap occupancy from the "       \
+          "initial value of InitiatingHeapOccupancyPercent. The policy "    \
+          "attempts to start marking in time based on application "         \
+          "behavior.")                                                      \
+                                                                            \
+  experimental(uintx, G1AdaptiveIHOPNumInitialSamples, 3,                   \
+          "How many completed time periods from initial mark to first "     \
+          "mixed gc are required to use the input values for prediction "   \
+          "of the optimal occupancy to start marking.")                     \
+                                                                            \
+  diagnostic(bool, G1TraceNUMA, false,                                      \
+          "Print NUMA node placement of heap regions when UseNUMA "         \
+          "is enabled.")                                                    \
+                                                                            \
+  product(bool, G1ParallelFullGC, true,                                     \
+          "Use the parallel GC worker threads for all phases of a full "    \
+          "collection instead of doing it on the VM thread alone.")         \
+                                                                            \
+  product(uintx, G1PeriodicGCInterval, 0,                                   \
+          "Number of milliseconds after the last young or full "            \
+          "collection after which G1 starts a collection to give unused "   \
+          "heap memory back to the operating system. A value of 0 "         \
+          "disables periodic collections.")                                 \
+                                                                            \
+  product(bool, G1PeriodicGCInvokesConcurrent, true,                        \
+          "Make periodic collections concurrent cycles instead of full "    \
+          "collections.")                                                   \
+                                                                            \
+  product(double, G1PeriodicGCSystemLoadThreshold, 0.0,                     \
+          "Do not start a periodic collection while the recent system "     \
+          "load average is above this value. A value of 0.0 disables "      \
+          "this check.")                                                    \
+                                                                            \
+  product(bool, G1RebuildRemSetsConcurrently, true,                         \
+          "Only maintain remembered sets of old regions that are "          \
+          "collection set candidates, rebuilding them during concurrent "   \
+          "marking. Otherwise all remembered sets are kept up to date at "  \
+          "all times.")                                                     \
+                                                                            \
+  product(bool, G1PinCriticalRegions, true,                                 \
+          "Pin the regions holding the objects of JNI critical sections "  \
+          "instead of blocking garbage collection with the GC locker. "    \
+          "Young collections keep the objects of pinned regions in "       \
+          "place, mixed collections skip pinned old regions and full "     \
+          "collections do not compact pinned regions.")                    \
+                                                                            \
+  product(bool, G1UseOptionalCSetRegions, true,                             \
+          "Choose old regions that do not fit into the pause time goal "    \
+          "as optional collection set regions during mixed collections. "   \
+          "These are evacuated only if there is time left in the pause "    \
+          "after evacuating the rest of the collection set.")               \
+                                                                            \
+  experimental(bool, G1UpdateRSFromCardTable, false,                        \
+          "During evacuation pauses, find the cards that need refinement "  \
+          "by scanning the card table in parallel instead of processing "   \
+          "the dirty card logs. Makes the pause cost of pending cards "     \
+          "independent of their number, which allows much higher "          \
+          "concurrent refinement thresholds.")                              \
+                                                                            \
   diagnostic(bool, G1VerifyRSetsDuringFullGC, false,                        \
           "If true, perform verification of each heap region's "            \
           "remembered set when verifying the heap during a full GC.")       \
@@ -26,6 +26,7 @@
 #include "code/nmethod.hpp"
 #include "gc_implementation/g1/g1BlockOffsetTable.inline.hpp"
 #include "gc_implementation/g1/g1CollectedHeap.inline.hpp"
+#include "gc_implementation/g1/g1NUMA.hpp"
 #include "gc_implementation/g1/g1OopClosures.inline.hpp"
 #include "gc_implementation/g1/heapRegion.inline.hpp"
 #include "gc_implementation/g1/heapRegionBounds.inline.hpp"
@@ -36,6 +37,7 @@
 #include "memory/iterator.hpp"
 #include "memory/space.inline.hpp"
 #include "oops/oop.inline.hpp"
+#include "runtime/atomic.inline.hpp"
 #include "runtime/orderAccess.inline.hpp"
 #include "gc_implementation/g1/heapRegionTracer.hpp"
 
@@ -111,6 +113,17 @@ void HeapRegion::setup_heap_region_size(size_t initial_heap_size, size_t max_hea
     size_t average_heap_size = (initial_heap_size + max_heap_size) / 2;
     region_size = MAX2(average_heap_size / HeapRegionBounds::target_number(),
                        (uintx) HeapRegionBounds::min_size());
+    region_size = MIN2(region_size, (uintx) HeapRegionBounds::max_ergonomics_size());
+    if (G1HumongousObjectSizeHint > 0) {
+      // Objects larger than half a region are humongous, so make regions
+      // more than twice as large as the hinted object size.
+      int hint_log = log2_long((jlong) G1HumongousObjectSizeHint);
+      if (hint_log + 2 < BitsPerWord) {
+        region_size = MAX2(region_size, (uintx)1 << (hint_log + 2));
+      } else {
+        region_size = HeapRegionBounds::max_size();
+      }
+    }
   }
 
   int region_size_log = log2_long((jlong) region_size);
@@ -137,8 +150,6 @@ void HeapRegion::setup_heap_region_size(size_t initial_heap_size, size_t max_hea
   LogOfHRGrainWords = LogOfHRGrainBytes - LogHeapWordSize;
 
   guarantee(GrainBytes == 0, "we should only set it once");
-  // The cast to int is safe, given that we've bounded region_size by
-  // MIN_REGION_SIZE and MAX_REGION_SIZE.
   GrainBytes = (size_t)region_size;
 
   guarantee(GrainWords == 0, "we should only set it once");
@@ -162,6 +173,7 @@ void HeapRegion::hr_clear(bool par, bool clear_space, bool locked) {
          "we should have already filtered out humongous regions");
   assert(_end == _orig_end,
          "we should have already filtered out humongous regions");
+  assert(!has_pinned_objects(), "a region with pinned objects is never freed");
 
   _in_collection_set = false;
 
@@ -185,6 +197,7 @@ void HeapRegion::hr_clear(bool par, bool clear_space, bool locked) {
 
   _offsets.resize(HeapRegion::GrainWords);
   init_top_at_mark_start();
+  _top_at_rebuild_start = NULL;
   if (clear_space) clear(SpaceDecorator::Mangle);
 }
 
@@ -304,15 +317,16 @@ HeapRegion::HeapRegion(uint hrm_index,
     _in_collection_set(false),
     _next_in_special_set(NULL), _orig_end(NULL),
     _claimed(InitialClaimValue), _evacuation_failed(false),
+    _pinned_object_count(0),
     _prev_marked_bytes(0), _next_marked_bytes(0), _gc_efficiency(0.0),
-    _next_young_region(NULL),
+    _top_at_rebuild_start(NULL), _next_young_region(NULL),
     _next_dirty_cards_region(NULL), _next(NULL), _prev(NULL),
 #ifdef ASSERT
     _containing_set(NULL),
 #endif // ASSERT
      _young_index_in_cset(-1), _surv_rate_group(NULL), _age_index(-1),
     _rem_set(NULL), _recorded_rs_length(0), _predicted_elapsed_time_ms(0),
-    _predicted_bytes_to_copy(0)
+    _predicted_bytes_to_copy(0), _node_index(G1NUMA::UnknownNodeIndex)
 {
   _rem_set = new HeapRegionRemSet(sharedOffsetArray, this);
   assert(HeapRegionRemSet::num_par_rem_sets() > 0, "Invariant.");
@@ -339,7 +353,85 @@ void HeapRegion::report_region_type_change(G1HeapRegionTraceType::Type to) {
                                             used());
 }
 
+void HeapRegion::increment_pinned_object_count() {
+  Atomic::inc(&_pinned_object_count);
+}
+
+void HeapRegion::decrement_pinned_object_count() {
+  assert(_pinned_object_count > 0, "unbalanced unpin");
+  Atomic::dec(&_pinned_object_count);
+}
+
+static void fill_dead_range(HeapWord* start, HeapWord* end) {
+  // Only the headers are overwritten: a string whose value array was
+  // replaced by deduplication may still be read by a critical section.
+  CollectedHeap::fill_with_objects(start, pointer_delta(end, start), false /* zap */);
+}
+
+void HeapRegion::prepare_pinned_for_compaction() {
+  assert(!isHumongous(), "humongous objects are never moved");
+  assert(has_pinned_objects(), "only for regions with pinned objects");
+
+  // The dead ranges become filler objects, so the block offset table
+  // is rebuilt for the new set of blocks as the region is walked.
+  initialize_threshold();
+  HeapWord* const t = top();
+  HeapWord* dead_start = NULL;
+  HeapWord* p = bottom();
+  while (p < t) {
+    oop obj = oop(p);
+    size_t size = obj->size();
+    if (obj->is_gc_marked()) {
+      if (dead_start != NULL) {
+        fill_dead_range(dead_start, p);
+        cross_threshold(dead_start, p);
+        dead_start = NULL;
+      }
+      obj->forward_to(obj);
+      cross_threshold(p, p + size);
+    } else if (dead_start == NULL) {
+      dead_start = p;
+    }
+    p += size;
+  }
+  if (dead_start != NULL) {
+    fill_dead_range(dead_start, t);
+    cross_threshold(dead_start, t);
+  }
+  set_compaction_top(t);
+}
+
+void HeapRegion::adjust_pinned_pointers() {
+  assert(has_pinned_objects(), "only for regions with pinned objects");
+  HeapWord* const t = top();
+  HeapWord* p = bottom();
+  while (p < t) {
+    // Fillers hold no references, so all objects can be adjusted.
+    p += oop(p)->adjust_pointers();
+  }
+}
+
+void HeapRegion::reset_pinned_after_compaction() {
+  assert(has_pinned_objects(), "only for regions with pinned objects");
+  HeapWord* const t = top();
+  HeapWord* p = bottom();
+  while (p < t) {
+    oop obj = oop(p);
+    if (obj->is_gc_marked()) {
+      obj->init_mark();
+    }
+    p += obj->size();
+  }
+  reset_after_compaction();
+}
+
 CompactibleSpace* HeapRegion::next_compaction_space() const {
+  // The parallel full GC explicitly chains the regions each of its
+  // workers compacts into; otherwise compact in heap order.
+  CompactibleSpace* next = CompactibleSpace::next_compaction_space();
+  if (next != NULL) {
+    return next;
+  }
   return G1CollectedHeap::heap()->next_compaction_region(this);
 }
 
@@ -701,6 +793,9 @@ void HeapRegion::print_on(outputStream* st) const {
   else
     st->print("   ");
   st->print(" TS %5d", _gc_time_stamp);
+  if (G1NUMA::numa()->is_enabled()) {
+    st->print(" N%2u", _node_index);
+  }
   st->print(" PTAMS " PTR_FORMAT " NTAMS " PTR_FORMAT,
             prev_top_at_mark_start(), next_top_at_mark_start());
   G1OffsetTableContigSpace::print_on(st);
@@ -831,7 +926,8 @@ public:
       HeapRegion* to   = _g1h->heap_region_containing(obj);
       if (from != NULL && to != NULL &&
           from != to &&
-          !to->isHumongous()) {
+          !to->isHumongous() &&
+          to->rem_set()->is_complete()) {
         jbyte cv_obj = *_bs->byte_for_const(_containing_obj);
         jbyte cv_field = *_bs->byte_for_const(p);
         const jbyte dirty = CardTableModRefBS::dirty_card_val();
@@ -233,6 +233,10 @@ class HeapRegion: public G1OffsetTableContigSpace {
   // True iff an attempt to evacuate an object in the region failed.
   bool _evacuation_failed;
 
+  // The number of JNI critical sections currently using an object in
+  // the region. Collections leave the objects of such a region in place.
+  volatile jint _pinned_object_count;
+
   // A heap region may be a member one of a number of special subsets, each
   // represented as linked lists through the field below.  Currently, there
   // is only one set:
@@ -275,6 +279,11 @@ class HeapRegion: public G1OffsetTableContigSpace {
   // "next" is the top at the start of the in-progress marking (if any.)
   HeapWord* _prev_top_at_mark_start;
   HeapWord* _next_top_at_mark_start;
+  // The top of an old or humongous region at the last remark, or NULL.
+  // The concurrent remembered set rebuild scans the live objects below
+  // it; references from objects allocated above it are recorded by the
+  // regular remembered set maintenance.
+  HeapWord* _top_at_rebuild_start;
   // If a collection pause is in progress, this is the top at the start
   // of that pause.
 
@@ -301,6 +310,9 @@ class HeapRegion: public G1OffsetTableContigSpace {
   // the total value for the collection set.
   size_t _predicted_bytes_to_copy;
 
+  // The index of the NUMA node this region's memory is preferably placed on.
+  uint _node_index;
+
  public:
   HeapRegion(uint hrm_index,
              G1BlockOffsetSharedArray* sharedOffsetArray,
@@ -321,7 +333,7 @@ class HeapRegion: public G1OffsetTableContigSpace {
 
   static size_t align_up_to_region_byte_size(size_t sz) {
     return (sz + (size_t) GrainBytes - 1) &
-                                      ~((1 << (size_t) LogOfHRGrainBytes) - 1);
+                                      ~(((size_t) 1 << LogOfHRGrainBytes) - 1);
   }
 
   static size_t max_region_size();
@@ -344,7 +356,10 @@ class HeapRegion: public G1OffsetTableContigSpace {
     ParEvacFailureClaimValue   = 6,
     AggregateCountClaimValue   = 7,
     VerifyCountClaimValue      = 8,
-    ParMarkRootClaimValue      = 9
+    ParMarkRootClaimValue      = 9,
+    ParPrepareCompactClaimValue = 10,
+    ParAdjustPointersClaimValue = 11,
+    ParObjectIterateClaimValue = 12
   };
 
   // All allocated blocks are occupied by objects in a HeapRegion
@@ -361,6 +376,10 @@ class HeapRegion: public G1OffsetTableContigSpace {
   // sequence, otherwise -1.
   uint hrm_index() const { return _hrm_index; }
 
+  // The NUMA node index (see G1NUMA) this region's memory prefers to be on.
+  uint node_index() const { return _node_index; }
+  void set_node_index(uint node_index) { _node_index = node_index; }
+
   // The number of bytes marked live in the region in the last marking phase.
   size_t marked_bytes()    { return _prev_marked_bytes; }
   size_t live_bytes() {
@@ -573,6 +592,9 @@ class HeapRegion: public G1OffsetTableContigSpace {
   HeapWord* prev_top_at_mark_start() const { return _prev_top_at_mark_start; }
   HeapWord* next_top_at_mark_start() const { return _next_top_at_mark_start; }
 
+  HeapWord* top_at_rebuild_start() const { return _top_at_rebuild_start; }
+  void set_top_at_rebuild_start(HeapWord* tars) { _top_at_rebuild_start = tars; }
+
   // Note the start or end of marking. This tells the heap region
   // that the collector is about to start or has finished (concurrently)
   // marking the heap.
@@ -707,6 +729,20 @@ class HeapRegion: public G1OffsetTableContigSpace {
     }
   }
 
+  // Pinning support for JNI critical sections; see
+  // G1CollectedHeap::pin_object().
+  void increment_pinned_object_count();
+  void decrement_pinned_object_count();
+  bool has_pinned_objects() const { return _pinned_object_count > 0; }
+
+  // Full GC support for a region with pinned objects, which is left
+  // in place instead of being compacted. Phase 2 forwards the live
+  // objects to themselves and fills the dead ones, phase 3 adjusts
+  // the pointers of the live objects and phase 4 resets their marks.
+  void prepare_pinned_for_compaction();
+  void adjust_pinned_pointers();
+  void reset_pinned_after_compaction();
+
   // Requires that "mr" be entirely within the region.
   // Apply "cl->do_object" to all objects that intersect with "mr".
   // If the iteration encounters an unparseable portion of the region,
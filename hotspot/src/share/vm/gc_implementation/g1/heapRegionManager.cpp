@@ -48,6 +48,8 @@ void HeapRegionManager::initialize(G1RegionToSpaceMapper* heap_storage,
 
   _card_counts_mapper = card_counts;
 
+  _numa = G1NUMA::numa();
+
   MemRegion reserved = heap_storage->reserved();
   _regions.initialize(reserved.start(), reserved.end(), HeapRegion::GrainBytes);
 
@@ -55,6 +57,26 @@ void HeapRegionManager::initialize(G1RegionToSpaceMapper* heap_storage,
   _available_map.clear();
 }
 
+HeapRegion* HeapRegionManager::allocate_free_region(bool is_old, uint node_index) {
+  HeapRegion* hr = NULL;
+  // Mutator (young) regions are taken from the head of the list and old
+  // regions from the tail, in both the NUMA and the non-NUMA case.
+  bool from_head = !is_old;
+
+  if (_numa->is_enabled() && _numa->is_valid_node_index(node_index)) {
+    hr = _free_list.remove_region_with_node_index(from_head, node_index);
+  }
+  if (hr == NULL) {
+    hr = _free_list.remove_region(from_head);
+  }
+
+  if (hr != NULL) {
+    assert(hr->next() == NULL, "Single region should not have next");
+    assert(is_available(hr->hrm_index()), "Must be committed");
+  }
+  return hr;
+}
+
 bool HeapRegionManager::is_available(uint region) const {
   return _available_map.at(region);
 }
@@ -81,6 +103,15 @@ void HeapRegionManager::commit_regions(uint index, size_t num_regions) {
 
   _heap_mapper->commit_regions(index, num_regions);
 
+  // With NUMA, bind the freshly committed (and not yet touched) memory of
+  // each region to its preferred node.
+  if (_numa->is_enabled()) {
+    for (uint i = index; i < index + num_regions; i++) {
+      HeapWord* bottom = G1CollectedHeap::heap()->bottom_addr_for_region(i);
+      _numa->request_memory_on_node(bottom, HeapRegion::GrainBytes, i);
+    }
+  }
+
   // Also commit auxiliary data
   _prev_bitmap_mapper->commit_regions(index, num_regions);
   _next_bitmap_mapper->commit_regions(index, num_regions);
@@ -141,6 +172,7 @@ void HeapRegionManager::make_regions_available(uint start, uint num_regions) {
     MemRegion mr(bottom, bottom + HeapRegion::GrainWords);
 
     hr->initialize(mr);
+    hr->set_node_index(_numa->preferred_node_index_for_index(i));
     insert_into_free_list(at(i));
   }
 }
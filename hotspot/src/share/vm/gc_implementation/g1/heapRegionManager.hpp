@@ -26,6 +26,7 @@
 #define SHARE_VM_GC_IMPLEMENTATION_G1_HEAPREGIONMANAGER_HPP
 
 #include "gc_implementation/g1/g1BiasedArray.hpp"
+#include "gc_implementation/g1/g1NUMA.hpp"
 #include "gc_implementation/g1/g1RegionToSpaceMapper.hpp"
 #include "gc_implementation/g1/heapRegionSet.hpp"
 #include "services/memoryUsage.hpp"
@@ -79,6 +80,8 @@ class HeapRegionManager: public CHeapObj<mtGC> {
 
   FreeRegionList _free_list;
 
+  G1NUMA* _numa;
+
   // Each bit in this bitmap indicates that the corresponding region is available
   // for allocation.
   BitMap _available_map;
@@ -130,7 +133,7 @@ public:
   // Empty constructor, we'll initialize it with the initialize() method.
   HeapRegionManager() : _regions(), _heap_mapper(NULL), _num_committed(0),
                     _next_bitmap_mapper(NULL), _prev_bitmap_mapper(NULL), _bot_mapper(NULL),
-                    _allocated_heapregions_length(0), _available_map(),
+                    _allocated_heapregions_length(0), _available_map(), _numa(NULL),
                     _free_list("Free list", new MasterFreeRegionListMtSafeChecker())
   { }
 
@@ -151,6 +154,10 @@ public:
   // is valid.
   inline HeapRegion* at(uint index) const;
 
+  // Return the HeapRegion at the given index, or NULL if the region is
+  // not available.
+  inline HeapRegion* at_or_null(uint index) const;
+
   // If addr is within the committed space return its corresponding
   // HeapRegion, otherwise return NULL.
   inline HeapRegion* addr_to_region(HeapWord* addr) const;
@@ -163,15 +170,10 @@ public:
     _free_list.add_ordered(list);
   }
 
-  HeapRegion* allocate_free_region(bool is_old) {
-    HeapRegion* hr = _free_list.remove_region(is_old);
-
-    if (hr != NULL) {
-      assert(hr->next() == NULL, "Single region should not have next");
-      assert(is_available(hr->hrm_index()), "Must be committed");
-    }
-    return hr;
-  }
+  // Allocate a free region. If NUMA is enabled and node_index denotes a
+  // specific node, prefer a region placed on that node, but fall back to
+  // any free region.
+  HeapRegion* allocate_free_region(bool is_old, uint node_index = G1NUMA::AnyNodeIndex);
 
   inline void allocate_free_regions_starting_at(uint first, uint num_regions);
 
@@ -858,14 +858,23 @@ OtherRegionsTable::do_cleanup_work(HRRSCleanupTask* hrrs_cleanup_task) {
 // This can be done by either mutator threads together with the
 // concurrent refinement threads or GC threads.
 uint HeapRegionRemSet::num_par_rem_sets() {
-  return MAX2(DirtyCardQueueSet::num_par_ids() + ConcurrentG1Refine::thread_num(), (uint)ParallelGCThreads);
+  // Mutator and refinement threads use disjoint ids, followed by the ids of
+  // the concurrent remembered set rebuild workers. The GC worker threads
+  // only run at safepoints and share the ids with the threads above.
+  return MAX2(rebuild_rem_set_worker_id_offset() + MAX2((uint)ConcGCThreads, 1U),
+              (uint)ParallelGCThreads);
+}
+
+uint HeapRegionRemSet::rebuild_rem_set_worker_id_offset() {
+  return DirtyCardQueueSet::num_par_ids() + ConcurrentG1Refine::thread_num();
 }
 
 HeapRegionRemSet::HeapRegionRemSet(G1BlockOffsetSharedArray* bosa,
                                    HeapRegion* hr)
   : _bosa(bosa),
     _m(Mutex::leaf, FormatBuffer<128>("HeapRegionRemSet lock #%u", hr->hrm_index()), true),
-    _code_roots(), _other_regions(hr, &_m), _iter_state(Unclaimed), _iter_claimed(0) {
+    _code_roots(), _other_regions(hr, &_m), _state(State_Complete),
+    _iter_state(Unclaimed), _iter_claimed(0), _code_roots_claimed(0) {
   reset_for_par_iteration();
 }
 
@@ -878,7 +887,12 @@ void HeapRegionRemSet::setup_remset_size() {
     G1RSetSparseRegionEntries = G1RSetSparseRegionEntriesBase * (region_size_log_mb + 1);
   }
   if (FLAG_IS_DEFAULT(G1RSetRegionEntries)) {
-    G1RSetRegionEntries = G1RSetRegionEntriesBase * (region_size_log_mb + 1);
+    // Each fine-grain table holds a bitmap of CardsPerRegion bits, so stop
+    // growing their number beyond 32M regions to keep the worst case
+    // footprint of a remembered set from growing with the square of the
+    // region size.
+    const int LOG_32M = 5;
+    G1RSetRegionEntries = G1RSetRegionEntriesBase * (MIN2(region_size_log_mb, LOG_32M) + 1);
   }
   guarantee(G1RSetSparseRegionEntries > 0 && G1RSetRegionEntries > 0 , "Sanity");
 }
@@ -923,21 +937,34 @@ void HeapRegionRemSet::cleanup() {
   SparsePRT::cleanup_all();
 }
 
-void HeapRegionRemSet::clear() {
+void HeapRegionRemSet::clear(bool only_cardset) {
   MutexLockerEx x(&_m, Mutex::_no_safepoint_check_flag);
-  clear_locked();
+  clear_locked(only_cardset);
 }
 
-void HeapRegionRemSet::clear_locked() {
-  _code_roots.clear();
+void HeapRegionRemSet::clear_locked(bool only_cardset) {
+  if (!only_cardset) {
+    _code_roots.clear();
+  }
   _other_regions.clear();
+  set_state_complete();
   assert(occupied_locked() == 0, "Should be clear.");
   reset_for_par_iteration();
 }
 
+const char* HeapRegionRemSet::get_state_str() const {
+  switch (_state) {
+    case State_Untracked: return "Untracked";
+    case State_Updating:  return "Updating";
+    case State_Complete:  return "Complete";
+    default: ShouldNotReachHere(); return NULL;
+  }
+}
+
 void HeapRegionRemSet::reset_for_par_iteration() {
   _iter_state = Unclaimed;
   _iter_claimed = 0;
+  _code_roots_claimed = 0;
   // It's good to check this to make sure that the two methods are in sync.
   assert(verify_ready_for_par_iteration(), "post-condition");
 }
@@ -994,6 +1021,10 @@ void HeapRegionRemSet::strong_code_roots_do(CodeBlobClosure* blk) const {
   _code_roots.nmethods_do(blk);
 }
 
+void HeapRegionRemSet::strong_code_roots_do(CodeBlobClosure* blk, int from, int to) const {
+  _code_roots.nmethods_do(blk, from, to);
+}
+
 void HeapRegionRemSet::clean_strong_code_roots(HeapRegion* hr) {
   _code_roots.clean(hr);
 }
@@ -235,6 +235,15 @@ public:
     Event_EvacStart, Event_EvacEnd, Event_RSUpdateEnd, Event_illegal
   };
 
+  // Whether the remembered set currently records incoming references.
+  // Untracked remembered sets drop all card set updates; Updating ones
+  // are being rebuilt by concurrent marking and are not yet usable for
+  // evacuation; only Complete remembered sets describe all incoming
+  // references. Strong code roots are always maintained.
+  enum RemSetState {
+    State_Untracked, State_Updating, State_Complete
+  };
+
 private:
   G1BlockOffsetSharedArray* _bosa;
   G1BlockOffsetSharedArray* bosa() const { return _bosa; }
@@ -247,9 +256,12 @@ private:
 
   OtherRegionsTable _other_regions;
 
+  RemSetState _state;
+
   enum ParIterState { Unclaimed, Claimed, Complete };
   volatile ParIterState _iter_state;
   volatile jlong _iter_claimed;
+  volatile jint _code_roots_claimed;
 
   // Unused unless G1RecordHRRSOops is true.
 
@@ -270,6 +282,8 @@ public:
   HeapRegionRemSet(G1BlockOffsetSharedArray* bosa, HeapRegion* hr);
 
   static uint num_par_rem_sets();
+  // The first rem set id used by concurrent remembered set rebuild workers.
+  static uint rebuild_rem_set_worker_id_offset();
   static void setup_remset_size();
 
   HeapRegion* hr() const {
@@ -303,13 +317,31 @@ public:
 
   static jint n_coarsenings() { return OtherRegionsTable::n_coarsenings(); }
 
+  RemSetState state() const { return _state; }
+  bool is_tracked() const   { return _state != State_Untracked; }
+  bool is_updating() const  { return _state == State_Updating; }
+  bool is_complete() const  { return _state == State_Complete; }
+
+  void set_state_untracked() { _state = State_Untracked; }
+  void set_state_updating() {
+    assert(_state == State_Untracked,
+           err_msg("Only untracked remembered sets can start updating, state %d", _state));
+    _state = State_Updating;
+  }
+  void set_state_complete() { _state = State_Complete; }
+
+  const char* get_state_str() const;
+
   // Used in the sequential case.
   void add_reference(OopOrNarrowOopStar from) {
-    _other_regions.add_reference(from, 0);
+    add_reference(from, 0);
   }
 
   // Used in the parallel case.
   void add_reference(OopOrNarrowOopStar from, int tid) {
+    if (!is_tracked()) {
+      return;
+    }
     _other_regions.add_reference(from, tid);
   }
 
@@ -318,9 +350,11 @@ public:
   void scrub(CardTableModRefBS* ctbs, BitMap* region_bm, BitMap* card_bm);
 
   // The region is being reclaimed; clear its remset, and any mention of
-  // entries for this region in other remsets.
-  void clear();
-  void clear_locked();
+  // entries for this region in other remsets. An empty remembered set
+  // is trivially complete. If only_cardset is true, the strong code roots
+  // are kept.
+  void clear(bool only_cardset = false);
+  void clear_locked(bool only_cardset = false);
 
   // Attempt to claim the region.  Returns true iff this call caused an
   // atomic transition from Unclaimed to Claimed.
@@ -341,10 +375,14 @@ public:
     } while (Atomic::cmpxchg((jlong)next, &_iter_claimed, (jlong)current) != (jlong)current);
     return current;
   }
+  // Claim the next block of buckets of the strong code roots list
+  int code_roots_claimed_next(int step) {
+    return Atomic::add(step, &_code_roots_claimed) - step;
+  }
   void reset_for_par_iteration();
 
   bool verify_ready_for_par_iteration() {
-    return (_iter_state == Unclaimed) && (_iter_claimed == 0);
+    return (_iter_state == Unclaimed) && (_iter_claimed == 0) && (_code_roots_claimed == 0);
   }
 
   // The actual # of bytes this hr_remset takes up.
@@ -383,6 +421,9 @@ public:
   // Applies blk->do_code_blob() to each of the entries in
   // the strong code roots list
   void strong_code_roots_do(CodeBlobClosure* blk) const;
+  // Same, for the entries in buckets [from, to) of the list
+  void strong_code_roots_do(CodeBlobClosure* blk, int from, int to) const;
+  int strong_code_roots_table_size() const { return _code_roots.table_size(); }
 
   void clean_strong_code_roots(HeapRegion* hr);
 
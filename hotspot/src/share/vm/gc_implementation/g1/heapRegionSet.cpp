@@ -197,6 +197,52 @@ void FreeRegionList::add_ordered(FreeRegionList* from_list) {
   from_list->verify_optional();
 }
 
+HeapRegion* FreeRegionList::remove_region_with_node_index(bool from_head,
+                                                          uint requested_node_index) {
+  check_mt_safety();
+  verify_optional();
+
+  if (is_empty()) {
+    return NULL;
+  }
+  assert(length() > 0 && _head != NULL && _tail != NULL,
+         hrs_ext_msg(this, "invariant"));
+
+  HeapRegion* cur = from_head ? _head : _tail;
+  while (cur != NULL && cur->node_index() != requested_node_index) {
+    cur = from_head ? cur->next() : cur->prev();
+  }
+
+  if (cur == NULL) {
+    return NULL;
+  }
+
+  // Unlink cur from the list.
+  HeapRegion* next = cur->next();
+  HeapRegion* prev = cur->prev();
+  if (prev == NULL) {
+    assert(_head == cur, hrs_ext_msg(this, "invariant"));
+    _head = next;
+  } else {
+    prev->set_next(next);
+  }
+  if (next == NULL) {
+    assert(_tail == cur, hrs_ext_msg(this, "invariant"));
+    _tail = prev;
+  } else {
+    next->set_prev(prev);
+  }
+  if (_last == cur) {
+    _last = NULL;
+  }
+
+  cur->set_next(NULL);
+  cur->set_prev(NULL);
+  // remove() will verify the region and check mt safety.
+  remove(cur);
+  return cur;
+}
+
 void FreeRegionList::remove_starting_at(HeapRegion* first, uint num_regions) {
   check_mt_safety();
   assert(num_regions >= 1, hrs_ext_msg(this, "pre-condition"));
@@ -99,14 +99,15 @@ inline bool requires_marking(const void* entry, G1CollectedHeap* heap) {
 // are compacted toward the top of the buffer.
 
 void ObjPtrQueue::filter() {
-  G1CollectedHeap* g1h = G1CollectedHeap::heap();
-  void** buf = _buf;
-  size_t sz = _sz;
-
-  if (buf == NULL) {
+  if (_buf == NULL) {
     // nothing to do
     return;
   }
+  _index = filter_buffer(_buf, _index, _sz);
+}
+
+size_t ObjPtrQueue::filter_buffer(void** buf, size_t index, size_t sz) {
+  G1CollectedHeap* g1h = G1CollectedHeap::heap();
 
   // Used for sanity checking at the end of the loop.
   debug_only(size_t entries = 0; size_t retained = 0;)
@@ -114,7 +115,7 @@ void ObjPtrQueue::filter() {
   size_t i = sz;
   size_t new_index = sz;
 
-  while (i > _index) {
+  while (i > index) {
     assert(i > 0, "we should have at least one more entry to process");
     i -= oopSize;
     debug_only(entries += 1;)
@@ -142,7 +143,7 @@ void ObjPtrQueue::filter() {
   }
 
 #ifdef ASSERT
-  size_t entries_calc = (sz - _index) / oopSize;
+  size_t entries_calc = (sz - index) / oopSize;
   assert(entries == entries_calc, "the number of entries we counted "
          "should match the number of entries we calculated");
   size_t retained_calc = (sz - new_index) / oopSize;
@@ -150,7 +151,7 @@ void ObjPtrQueue::filter() {
          "should match the number of retained entries we calculated");
 #endif // ASSERT
 
-  _index = new_index;
+  return new_index;
 }
 
 // This method will first apply the above filtering to the buffer. If
@@ -170,6 +171,17 @@ bool ObjPtrQueue::should_enqueue_buffer() {
   assert(_index == 0, "pre-condition");
   assert(_buf != NULL, "pre-condition");
 
+  if (G1SATBFilterInRefinement && _lock == NULL) {
+    // Leave the filtering to the refinement threads and carry on with
+    // a new buffer.
+    SATBMarkQueueSet* satb_qset = (SATBMarkQueueSet*) qset();
+    satb_qset->enqueue_unfiltered_buffer(_buf);
+    _buf = satb_qset->allocate_buffer();
+    _sz = satb_qset->buffer_size();
+    _index = _sz;
+    return false;
+  }
+
   filter();
 
   size_t sz = _sz;
@@ -214,7 +226,10 @@ void ObjPtrQueue::print(const char* name,
 
 SATBMarkQueueSet::SATBMarkQueueSet() :
   PtrQueueSet(),
-  _shared_satb_queue(this, true /*perm*/) { }
+  _shared_satb_queue(this, true /*perm*/),
+  _unfiltered_buffers_head(NULL),
+  _unfiltered_buffers_tail(NULL),
+  _n_unfiltered_buffers(0) { }
 
 void SATBMarkQueueSet::initialize(Monitor* cbl_mon, Mutex* fl_lock,
                                   int process_completed_threshold,
@@ -283,6 +298,55 @@ void SATBMarkQueueSet::filter_thread_buffers() {
   shared_satb_queue()->filter();
 }
 
+// The refinement thread is not notified: taking its monitor here, on the
+// mutator slow path, would nest it inside the callers' locks. It picks the
+// buffers up on its periodic wakeup, and marking takes them directly if it
+// runs out of filtered ones before that.
+void SATBMarkQueueSet::enqueue_unfiltered_buffer(void** buf) {
+  MutexLockerEx x(_cbl_mon, Mutex::_no_safepoint_check_flag);
+  BufferNode* nd = BufferNode::new_from_buffer(buf);
+  if (_unfiltered_buffers_tail == NULL) {
+    _unfiltered_buffers_head = nd;
+  } else {
+    _unfiltered_buffers_tail->set_next(nd);
+  }
+  _unfiltered_buffers_tail = nd;
+  _n_unfiltered_buffers++;
+}
+
+BufferNode* SATBMarkQueueSet::take_unfiltered_buffer() {
+  assert_lock_strong(_cbl_mon);
+  BufferNode* nd = _unfiltered_buffers_head;
+  if (nd != NULL) {
+    _unfiltered_buffers_head = nd->next();
+    if (_unfiltered_buffers_head == NULL) _unfiltered_buffers_tail = NULL;
+    _n_unfiltered_buffers--;
+    nd->set_next(NULL);
+  }
+  return nd;
+}
+
+size_t SATBMarkQueueSet::filter_unfiltered_buffers() {
+  size_t n = 0;
+  while (true) {
+    BufferNode* nd;
+    {
+      MutexLockerEx x(_cbl_mon, Mutex::_no_safepoint_check_flag);
+      nd = take_unfiltered_buffer();
+    }
+    if (nd == NULL) {
+      return n;
+    }
+    void** buf = BufferNode::make_buffer_from_node(nd);
+    if (ObjPtrQueue::filter_buffer(buf, 0, _sz) == _sz) {
+      deallocate_buffer(buf);
+    } else {
+      enqueue_complete_buffer(buf);
+    }
+    n++;
+  }
+}
+
 bool SATBMarkQueueSet::apply_closure_to_completed_buffer(SATBBufferClosure* cl) {
   BufferNode* nd = NULL;
   {
@@ -293,6 +357,9 @@ bool SATBMarkQueueSet::apply_closure_to_completed_buffer(SATBBufferClosure* cl)
       if (_completed_buffers_head == NULL) _completed_buffers_tail = NULL;
       _n_completed_buffers--;
       if (_n_completed_buffers == 0) _process_completed = false;
+    } else {
+      // The closure copes with the entries filtering would remove
+      nd = take_unfiltered_buffer();
     }
   }
   if (nd != NULL) {
@@ -361,6 +428,11 @@ void SATBMarkQueueSet::abandon_partial_marking() {
     }
     _completed_buffers_tail = NULL;
     _n_completed_buffers = 0;
+    BufferNode* nd;
+    while ((nd = take_unfiltered_buffer()) != NULL) {
+      nd->set_next(buffers_to_delete);
+      buffers_to_delete = nd;
+    }
     DEBUG_ONLY(assert_completed_buffer_list_len_correct_locked());
   }
   while (buffers_to_delete != NULL) {
@@ -49,6 +49,10 @@ private:
   // Filter out unwanted entries from the buffer.
   void filter();
 
+  // Filter out unwanted entries from the part of buf above index,
+  // returning the new index.
+  static size_t filter_buffer(void** buf, size_t index, size_t sz);
+
 public:
   ObjPtrQueue(PtrQueueSet* qset, bool perm = false) :
     // SATB queues are only active during marking cycles. We create
@@ -79,6 +83,15 @@ public:
 class SATBMarkQueueSet: public PtrQueueSet {
   ObjPtrQueue _shared_satb_queue;
 
+  // Full buffers mutators handed over without filtering them, with
+  // G1SATBFilterInRefinement. Protected by _cbl_mon, like the completed
+  // buffers.
+  BufferNode* _unfiltered_buffers_head;
+  BufferNode* _unfiltered_buffers_tail;
+  int         _n_unfiltered_buffers;
+
+  BufferNode* take_unfiltered_buffer();
+
 #ifdef ASSERT
   void dump_active_states(bool expected_active);
   void verify_active_states(bool expected_active);
@@ -102,11 +115,23 @@ public:
   // Filter all the currently-active SATB buffers.
   void filter_thread_buffers();
 
+  // Takes a full buffer from a mutator, to be filtered by
+  // filter_unfiltered_buffers().
+  void enqueue_unfiltered_buffer(void** buf);
+
+  // Filters the buffers mutators handed over and moves those with entries
+  // left to the completed buffers, freeing the others. Returns the number
+  // of buffers filtered. Called by the concurrent refinement threads.
+  size_t filter_unfiltered_buffers();
+
+  int unfiltered_buffers_num() const { return _n_unfiltered_buffers; }
+
   // If there exists some completed buffer, pop and process it, and
   // return true.  Otherwise return false.  Processing a buffer
   // consists of applying the closure to the buffer range starting
   // with the first non-NULL entry to the end of the buffer; the
-  // leading entries may be NULL due to filtering.
+  // leading entries may be NULL due to filtering. Buffers that were not
+  // filtered yet are taken once the completed ones run out.
   bool apply_closure_to_completed_buffer(SATBBufferClosure* cl);
 
 #ifndef PRODUCT
@@ -134,10 +134,12 @@ void VM_G1IncCollectionPause::doit() {
     // attempt_allocation_humongous(). Retrying the GC, in this case,
     // will cause the requesting thread to spin inside collect() until the
     // just started marking cycle is complete - which may be a while. So
-    // we do NOT retry the GC.
+    // we do NOT retry the GC. The same holds for a periodic collection:
+    // the cycle that is already in progress will uncommit memory too.
     if (!res) {
       assert(_word_size == 0, "Concurrent Full GC/Humongous Object IM shouldn't be allocating");
-      if (_gc_cause != GCCause::_g1_humongous_allocation) {
+      if (_gc_cause != GCCause::_g1_humongous_allocation &&
+          _gc_cause != GCCause::_g1_periodic_collection) {
         _should_retry_gc = true;
       }
       return;
@@ -24,6 +24,7 @@
 
 #include "precompiled.hpp"
 #include "gc_implementation/concurrentMarkSweep/concurrentMarkSweepGeneration.hpp"
+#include "gc_implementation/g1/g1StringDedup.hpp"
 #include "gc_implementation/parNew/parNewGeneration.hpp"
 #include "gc_implementation/parNew/parOopClosures.inline.hpp"
 #include "gc_implementation/shared/adaptiveSizePolicy.hpp"
@@ -74,6 +75,7 @@ ParScanThreadState::ParScanThreadState(Space* to_space_,
   _overflow_stack(overflow_stacks_ ? overflow_stacks_ + thread_num_ : NULL),
   _ageTable(false), // false ==> not the global age table, no perf data.
   _to_space_alloc_buffer(desired_plab_sz_),
+  _to_space_plab_stats(desired_plab_sz_),
   _to_space_closure(gen_, this), _old_gen_closure(gen_, this),
   _to_space_root_closure(gen_, this), _old_gen_root_closure(gen_, this),
   _older_gen_closure(gen_, this),
@@ -229,11 +231,13 @@ HeapWord* ParScanThreadState::alloc_in_to_space_slow(size_t word_sz) {
   if (!_to_space_full) {
     ParGCAllocBuffer* const plab = to_space_alloc_buffer();
     Space*            const sp   = to_space();
+    size_t buf_size = _to_space_plab_stats.desired_sz();
     if (word_sz * 100 <
-        ParallelGCBufferWastePct * plab->word_sz()) {
+        ParallelGCBufferWastePct * buf_size) {
       // Is small enough; abandon this buffer and start a new one.
+      _to_space_plab_stats.record_retire(plab->words_remaining());
       plab->retire(false, false);
-      size_t buf_size = plab->word_sz();
+      buf_size = _to_space_plab_stats.desired_sz();
       HeapWord* buf_space = sp->par_allocate(buf_size);
       if (buf_space == NULL) {
         const size_t min_bytes =
@@ -250,6 +254,7 @@ HeapWord* ParScanThreadState::alloc_in_to_space_slow(size_t word_sz) {
       if (buf_space != NULL) {
         plab->set_word_size(buf_size);
         plab->set_buf(buf_space);
+        _to_space_plab_stats.record_buffer(buf_size);
         record_survivor_plab(buf_space, buf_size);
         obj = plab->allocate_aligned(word_sz, SurvivorAlignmentInBytes);
         // Note that we cannot compare buf_size < word_sz below
@@ -267,6 +272,9 @@ HeapWord* ParScanThreadState::alloc_in_to_space_slow(size_t word_sz) {
     } else {
       // Too large; allocate the object individually.
       obj = sp->par_allocate(word_sz);
+      if (obj != NULL) {
+        _to_space_plab_stats.record_direct_allocation(word_sz);
+      }
     }
   }
   return obj;
@@ -309,6 +317,7 @@ public:
   inline ParScanThreadState& thread_state(int i);
 
   void trace_promotion_failed(YoungGCTracer& gc_tracer);
+  void trace_plab_worker_stats(YoungGCTracer& gc_tracer);
   void reset(int active_workers, bool promotion_failed);
   void flush();
 
@@ -366,6 +375,53 @@ void ParScanThreadStateSet::trace_promotion_failed(YoungGCTracer& gc_tracer) {
   }
 }
 
+void ParScanThreadStateSet::trace_plab_worker_stats(YoungGCTracer& gc_tracer) {
+  for (int i = 0; i < length(); ++i) {
+    thread_state(i).to_space_plab_stats()->report(i, false /* tenured */, &gc_tracer);
+  }
+}
+
+void ParScanThreadState::preserve_mark_if_necessary(oop obj, markOop m) {
+  if (m->must_be_preserved_for_promotion_failure(obj)) {
+    _objs_with_preserved_marks.push(obj);
+    _preserved_marks_of_objs.push(m);
+  }
+}
+
+void ParScanThreadState::restore_preserved_marks() {
+  assert(_objs_with_preserved_marks.size() == _preserved_marks_of_objs.size(),
+         "should be the same");
+  while (!_objs_with_preserved_marks.is_empty()) {
+    oop obj   = _objs_with_preserved_marks.pop();
+    markOop m = _preserved_marks_of_objs.pop();
+    obj->set_mark(m);
+  }
+  _objs_with_preserved_marks.clear(true);
+  _preserved_marks_of_objs.clear(true);
+}
+
+// Restores the marks preserved by all the thread states, the workers
+// claiming thread states one at a time.
+class ParRestorePreservedMarksTask : public AbstractGangTask {
+  ParScanThreadStateSet* _state_set;
+  volatile jint          _next;
+
+ public:
+  ParRestorePreservedMarksTask(ParScanThreadStateSet* state_set) :
+    AbstractGangTask("ParNewGeneration restore preserved marks"),
+    _state_set(state_set), _next(0) {}
+
+  void work(uint worker_id) {
+    while (true) {
+      int i = Atomic::add(1, &_next) - 1;
+      if (!_state_set->is_valid(i)) {
+        return;
+      }
+      _state_set->thread_state(i).restore_preserved_marks();
+    }
+  }
+};
+
 void ParScanThreadStateSet::reset(int active_threads, bool promotion_failed)
 {
   _term.reset_for_reuse(active_threads);
@@ -890,6 +946,15 @@ void ParNewGeneration::handle_promotion_failed(GenCollectedHeap* gch, ParScanThr
   _promo_failure_scan_stack.clear(true); // Clear cached segments.
 
   remove_forwarding_pointers();
+  // The marks the workers preserved can only go back once all forwarding
+  // pointers are gone, but then in parallel.
+  ParRestorePreservedMarksTask restore_task(&thread_state_set);
+  FlexibleWorkGang* workers = gch->workers();
+  if (workers != NULL && workers->active_workers() > 1) {
+    workers->run_task(&restore_task);
+  } else {
+    restore_task.work(0);
+  }
   if (PrintGCDetails) {
     gclog_or_tty->print(" (promotion failed)");
   }
@@ -1026,6 +1091,14 @@ void ParNewGeneration::collect(bool   full,
                                               _gc_timer, gc_tracer.gc_id());
   }
   gc_tracer.report_gc_reference_stats(stats);
+  thread_state_set.trace_plab_worker_stats(gc_tracer);
+
+  if (G1StringDedup::is_enabled()) {
+    // Unlink dead deduplication candidates and table entries, and
+    // update the remaining ones to point to the copied objects.
+    G1StringDedup::unlink_or_oops_do(&is_alive, &keep_alive, true /* allow_resize_and_rehash */);
+  }
+
   if (!promotion_failed()) {
     // Swap the survivor spaces.
     eden()->clear(SpaceDecorator::Mangle);
@@ -1142,15 +1215,6 @@ bool ParNewGeneration::is_legal_forward_ptr(oop p) {
 }
 #endif
 
-void ParNewGeneration::preserve_mark_if_necessary(oop obj, markOop m) {
-  if (m->must_be_preserved_for_promotion_failure(obj)) {
-    // We should really have separate per-worker stacks, rather
-    // than use locking of a common pair of stacks.
-    MutexLocker ml(ParGCRareEvent_lock);
-    preserve_mark(obj, m);
-  }
-}
-
 // Multiple GC threads may try to promote an object.  If the object
 // is successfully promoted, a forwarding pointer will be installed in
 // the object in the young generation.  This method claims the right
@@ -1207,7 +1271,7 @@ oop ParNewGeneration::copy_to_survivor_space_avoiding_promotion_undo(
       _promotion_failed = true;
       new_obj = old;
 
-      preserve_mark_if_necessary(old, m);
+      par_scan_state->preserve_mark_if_necessary(old, m);
       par_scan_state->register_promotion_failure(sz);
     }
 
@@ -1236,6 +1300,13 @@ oop ParNewGeneration::copy_to_survivor_space_avoiding_promotion_undo(
 #endif
 
   if (forward_ptr == NULL) {
+    if (G1StringDedup::is_enabled() && new_obj != old) {
+      G1StringDedup::enqueue_from_evacuation(true /* from_young */,
+                                             is_in_reserved(new_obj),
+                                             par_scan_state->thread_num(),
+                                             new_obj);
+    }
+
     oop obj_to_push = new_obj;
     if (par_scan_state->should_be_partially_scanned(obj_to_push, old)) {
       // Length field used as index of next element to be scanned.
@@ -1316,9 +1387,12 @@ oop ParNewGeneration::copy_to_survivor_space_with_undo(
 
   if (new_obj == NULL) {
     // Either to-space is full or we decided to promote
-    // try allocating obj tenured
-    new_obj = _next_gen->par_promote(par_scan_state->thread_num(),
+    // try allocating obj tenured, unless another thread has found
+    // that the old generation is full already.
+    if (!_promotion_failed) {
+      new_obj = _next_gen->par_promote(par_scan_state->thread_num(),
                                        old, m, sz);
+    }
 
     if (new_obj == NULL) {
       // promotion failed, forward to self
@@ -1332,7 +1406,7 @@ oop ParNewGeneration::copy_to_survivor_space_with_undo(
       _promotion_failed = true;
       failed_to_promote = true;
 
-      preserve_mark_if_necessary(old, m);
+      par_scan_state->preserve_mark_if_necessary(old, m);
       par_scan_state->register_promotion_failure(sz);
     }
   } else {
@@ -1364,6 +1438,13 @@ oop ParNewGeneration::copy_to_survivor_space_with_undo(
   }
 
   if (forward_ptr == NULL) {
+    if (G1StringDedup::is_enabled() && new_obj != old) {
+      G1StringDedup::enqueue_from_evacuation(true /* from_young */,
+                                             is_in_reserved(new_obj),
+                                             par_scan_state->thread_num(),
+                                             new_obj);
+    }
+
     oop obj_to_push = new_obj;
     if (par_scan_state->should_be_partially_scanned(obj_to_push, old)) {
       // Length field used as index of next element to be scanned.
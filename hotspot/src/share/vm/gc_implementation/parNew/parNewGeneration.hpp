@@ -65,6 +65,7 @@ class ParScanThreadState {
   Stack<oop, mtGC>* const _overflow_stack;
 
   ParGCAllocBuffer _to_space_alloc_buffer;
+  PLABWorkerStats  _to_space_plab_stats;
 
   ParScanWithoutBarrierClosure         _to_space_closure; // scan_without_gc_barrier
   ParScanWithBarrierClosure            _old_gen_closure; // scan_with_gc_barrier
@@ -110,6 +111,12 @@ class ParScanThreadState {
   // Stats for promotion failure
   PromotionFailedInfo _promotion_failed_info;
 
+  // The objects this thread forwarded to themselves whose marks must be
+  // restored, and those marks. They always have the same number of
+  // elements.
+  Stack<oop, mtGC>     _objs_with_preserved_marks;
+  Stack<markOop, mtGC> _preserved_marks_of_objs;
+
   // Timing numbers.
   double _start;
   double _start_strong_roots;
@@ -143,6 +150,10 @@ class ParScanThreadState {
     return &_to_space_alloc_buffer;
   }
 
+  PLABWorkerStats* to_space_plab_stats() {
+    return &_to_space_plab_stats;
+  }
+
   ParEvacuateFollowersClosure&      evacuate_followers_closure() { return _evacuate_followers; }
   DefNewGeneration::IsAliveClosure& is_alive_closure() { return _is_alive_closure; }
   ParScanWeakRefClosure&            scan_weak_ref_closure() { return _scan_weak_ref_closure; }
@@ -194,6 +205,12 @@ class ParScanThreadState {
   }
   void print_promotion_failure_size();
 
+  // Preserve the mark of "obj", if necessary, in preparation for its mark
+  // word being overwritten with a self-forwarding-pointer.
+  void preserve_mark_if_necessary(oop obj, markOop m);
+  // Put the preserved marks back, once the forwarding pointers are gone.
+  void restore_preserved_marks();
+
 #if TASKQUEUE_STATS
   TaskQueueStats & taskqueue_stats() const { return _work_queue->stats; }
 
@@ -339,10 +356,6 @@ class ParNewGeneration: public DefNewGeneration {
   static oop real_forwardee_slow(oop obj);
   static void waste_some_time();
 
-  // Preserve the mark of "obj", if necessary, in preparation for its mark
-  // word being overwritten with a self-forwarding-pointer.
-  void preserve_mark_if_necessary(oop obj, markOop m);
-
   void handle_promotion_failed(GenCollectedHeap* gch, ParScanThreadStateSet& thread_state_set, ParNewTracer& gc_tracer);
 
  protected:
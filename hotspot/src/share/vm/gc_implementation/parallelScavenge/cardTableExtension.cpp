@@ -30,6 +30,7 @@
 #include "gc_implementation/parallelScavenge/psYoungGen.hpp"
 #include "oops/oop.inline.hpp"
 #include "oops/oop.psgc.inline.hpp"
+#include "runtime/atomic.inline.hpp"
 #include "runtime/prefetch.inline.hpp"
 
 // Checks an individual oop for missing precise marks. Mark
@@ -132,9 +133,7 @@ class CheckForPreciseMarks : public OopClosure {
 void CardTableExtension::scavenge_contents_parallel(ObjectStartArray* start_array,
                                                     MutableSpace* sp,
                                                     HeapWord* space_top,
-                                                    PSPromotionManager* pm,
-                                                    uint stripe_number,
-                                                    uint stripe_total) {
+                                                    PSPromotionManager* pm) {
   int ssize = 128; // Naked constant!  Work unit = 64k.
   int dirty_card_count = 0;
 
@@ -144,14 +143,14 @@ void CardTableExtension::scavenge_contents_parallel(ObjectStartArray* start_arra
   jbyte* start_card = byte_for(sp->bottom());
   jbyte* end_card   = byte_for(sp_top - 1) + 1;
   oop* last_scanned = NULL; // Prevent scanning objects more than once
-  // The width of the stripe ssize*stripe_total must be
-  // consistent with the number of stripes so that the complete slice
-  // is covered.
-  size_t slice_width = ssize * stripe_total;
-  for (jbyte* slice = start_card; slice < end_card; slice += slice_width) {
-    jbyte* worker_start_card = slice + stripe_number * ssize;
+  // Claim stripes until they are all taken, so that threads that got
+  // stripes with few dirty cards take over the rest of the work.
+  while (true) {
+    jint stripe_number = Atomic::add(1, &_next_stripe) - 1;
+    jbyte* worker_start_card = start_card + (size_t) stripe_number * ssize;
     if (worker_start_card >= end_card)
       return; // We're done.
+    last_scanned = NULL;
 
     jbyte* worker_end_card = worker_start_card + ssize;
     if (worker_end_card > end_card)
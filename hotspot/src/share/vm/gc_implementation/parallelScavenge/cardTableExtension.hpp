@@ -43,6 +43,9 @@ class CardTableExtension : public CardTableModRefBS {
   void resize_update_committed_table(int changed_region, MemRegion new_region);
   void resize_update_covered_table(int changed_region, MemRegion new_region);
 
+  // Next stripe for scavenge_contents_parallel() to claim
+  volatile jint _next_stripe;
+
  protected:
 
   static void verify_all_young_refs_precise_helper(MemRegion mr);
@@ -54,18 +57,17 @@ class CardTableExtension : public CardTableModRefBS {
   };
 
   CardTableExtension(MemRegion whole_heap, int max_covered_regions) :
-    CardTableModRefBS(whole_heap, max_covered_regions) { }
+    CardTableModRefBS(whole_heap, max_covered_regions), _next_stripe(0) { }
 
   // Too risky for the 4/10/02 putback
   // BarrierSet::Name kind() { return BarrierSet::CardTableExtension; }
 
   // Scavenge support
+  void reset_stripe_claims() { _next_stripe = 0; }
   void scavenge_contents_parallel(ObjectStartArray* start_array,
                                   MutableSpace* sp,
                                   HeapWord* space_top,
-                                  PSPromotionManager* pm,
-                                  uint stripe_number,
-                                  uint stripe_total);
+                                  PSPromotionManager* pm);
 
   // Verification
   static void verify_all_young_refs_imprecise();
@@ -23,6 +23,8 @@
  */
 
 #include "precompiled.hpp"
+#include "gc_implementation/g1/g1NUMA.hpp"
+#include "gc_implementation/g1/g1StringDedup.hpp"
 #include "gc_implementation/parallelScavenge/adjoiningGenerations.hpp"
 #include "gc_implementation/parallelScavenge/adjoiningVirtualSpaces.hpp"
 #include "gc_implementation/parallelScavenge/cardTableExtension.hpp"
@@ -96,6 +98,14 @@ jint ParallelScavengeHeap::initialize() {
   double max_gc_pause_sec = ((double) MaxGCPauseMillis)/1000.0;
   double max_gc_minor_pause_sec = ((double) MaxGCMinorPauseMillis)/1000.0;
 
+  if (UseNUMA && PSOldGenNUMABinding && UseParallelOldGC) {
+    // The old gen binds its pages while the generations are made up,
+    // so the node information has to be available before that.
+    G1NUMA* numa = G1NUMA::create();
+    size_t page_size = UseLargePages ? os::large_page_size() : os::vm_page_size();
+    numa->set_region_info(ParallelCompactData::RegionSizeBytes, page_size);
+  }
+
   _gens = new AdjoiningGenerations(heap_rs, _collector_policy, generation_alignment());
 
   _old_gen = _gens->old_gen();
@@ -142,6 +152,13 @@ void ParallelScavengeHeap::post_initialize() {
     PSMarkSweep::initialize();
   }
   PSPromotionManager::initialize();
+  G1StringDedup::initialize();
+}
+
+void ParallelScavengeHeap::stop() {
+  if (G1StringDedup::is_enabled()) {
+    G1StringDedup::stop();
+  }
 }
 
 void ParallelScavengeHeap::update_counters() {
@@ -621,10 +638,16 @@ void ParallelScavengeHeap::print_on_error(outputStream* st) const {
 
 void ParallelScavengeHeap::gc_threads_do(ThreadClosure* tc) const {
   PSScavenge::gc_task_manager()->threads_do(tc);
+  if (G1StringDedup::is_enabled()) {
+    G1StringDedup::threads_do(tc);
+  }
 }
 
 void ParallelScavengeHeap::print_gc_threads_on(outputStream* st) const {
   PSScavenge::gc_task_manager()->print_threads_on(st);
+  if (G1StringDedup::is_enabled()) {
+    G1StringDedup::print_worker_threads_on(st);
+  }
 }
 
 void ParallelScavengeHeap::print_tracing_info() const {
@@ -106,6 +106,10 @@ class ParallelScavengeHeap : public CollectedHeap {
   virtual jint initialize();
 
   void post_initialize();
+
+  // Stop the string deduplication threads, if any, before shutdown.
+  virtual void stop();
+
   void update_counters();
 
   // The alignment used for the various areas
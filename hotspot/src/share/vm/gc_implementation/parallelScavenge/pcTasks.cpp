@@ -25,6 +25,7 @@
 #include "precompiled.hpp"
 #include "classfile/systemDictionary.hpp"
 #include "code/codeCache.hpp"
+#include "gc_implementation/g1/g1NUMA.hpp"
 #include "gc_implementation/parallelScavenge/pcTasks.hpp"
 #include "gc_implementation/parallelScavenge/psParallelCompact.hpp"
 #include "gc_implementation/shared/gcTimer.hpp"
@@ -215,6 +216,13 @@ void StealMarkingTask::do_it(GCTaskManager* manager, uint which) {
     ParCompactionManager::gc_thread_compaction_manager(which);
   PSParallelCompact::MarkAndPushClosure mark_and_push_closure(cm);
 
+  // Remember where this thread runs so that the compaction phase can
+  // hand it destination regions on the same node.
+  G1NUMA* numa = G1NUMA::numa();
+  if (numa != NULL) {
+    cm->set_numa_node_index(numa->index_of_current_thread());
+  }
+
   oop obj = NULL;
   ObjArrayTask task;
   int random_seed = 17;
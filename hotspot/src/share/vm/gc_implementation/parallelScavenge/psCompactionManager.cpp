@@ -55,7 +55,8 @@ int                   ParCompactionManager::_recycled_bottom = -1;
 ParCompactionManager::ParCompactionManager() :
     _action(CopyAndUpdate),
     _region_stack(NULL),
-    _region_stack_index((uint)max_uintx) {
+    _region_stack_index((uint)max_uintx),
+    _numa_node_index(0) {
 
   ParallelScavengeHeap* heap = (ParallelScavengeHeap*)Universe::heap();
   assert(heap->kind() == CollectedHeap::ParallelScavengeHeap, "Sanity");
@@ -90,6 +90,9 @@ private:
   // Index in _region_list for current _region_stack.
   uint _region_stack_index;
 
+  // NUMA node the owning GC thread was last seen running on.
+  uint _numa_node_index;
+
   // Indexes of recycled region stacks/overflow stacks
   // Stacks of regions to be compacted are embedded in the tasks doing
   // the compaction.  A thread that executes the task extracts the
@@ -147,6 +150,9 @@ private:
   uint region_stack_index() { return _region_stack_index; }
   void set_region_stack_index(uint v) { _region_stack_index = v; }
 
+  uint numa_node_index() const { return _numa_node_index; }
+  void set_numa_node_index(uint v) { _numa_node_index = v; }
+
   // Pop and push unique reusable stack index
   static int pop_recycled_stack_index();
   static void push_recycled_stack_index(uint v);
@@ -26,6 +26,7 @@
 #include "classfile/symbolTable.hpp"
 #include "classfile/systemDictionary.hpp"
 #include "code/codeCache.hpp"
+#include "gc_implementation/g1/g1StringDedup.hpp"
 #include "gc_implementation/parallelScavenge/parallelScavengeHeap.hpp"
 #include "gc_implementation/parallelScavenge/psAdaptiveSizePolicy.hpp"
 #include "gc_implementation/parallelScavenge/psMarkSweep.hpp"
@@ -569,6 +570,11 @@ void PSMarkSweep::mark_sweep_phase1(bool clear_all_softrefs) {
   // Delete entries for dead interned strings.
   StringTable::unlink(is_alive_closure());
 
+  // Delete entries for dead string deduplication candidates and table entries.
+  if (G1StringDedup::is_enabled()) {
+    G1StringDedup::unlink(is_alive_closure());
+  }
+
   // Clean up unreferenced symbols in symbol table.
   SymbolTable::unlink();
   _gc_tracer->report_object_count_after_gc(is_alive_closure());
@@ -632,6 +638,9 @@ void PSMarkSweep::mark_sweep_phase3() {
   CodeBlobToOopClosure adjust_from_blobs(adjust_pointer_closure(), CodeBlobToOopClosure::FixRelocations);
   CodeCache::blobs_do(&adjust_from_blobs);
   StringTable::oops_do(adjust_pointer_closure());
+  if (G1StringDedup::is_enabled()) {
+    G1StringDedup::oops_do(adjust_pointer_closure());
+  }
   ref_processor()->weak_oops_do(adjust_pointer_closure());
   PSScavenge::reference_processor()->weak_oops_do(adjust_pointer_closure());
 
@@ -23,10 +23,12 @@
  */
 
 #include "precompiled.hpp"
+#include "gc_implementation/g1/g1NUMA.hpp"
 #include "gc_implementation/parallelScavenge/parallelScavengeHeap.hpp"
 #include "gc_implementation/parallelScavenge/psAdaptiveSizePolicy.hpp"
 #include "gc_implementation/parallelScavenge/psMarkSweepDecorator.hpp"
 #include "gc_implementation/parallelScavenge/psOldGen.hpp"
+#include "gc_implementation/parallelScavenge/psParallelCompact.hpp"
 #include "gc_implementation/shared/spaceDecorator.hpp"
 #include "memory/cardTableModRefBS.hpp"
 #include "memory/gcLocker.inline.hpp"
@@ -134,9 +136,9 @@ void PSOldGen::initialize_work(const char* perf_data_name, int level) {
   if (_object_space == NULL)
     vm_exit_during_initialization("Could not allocate an old gen space");
 
-  object_space()->initialize(cmr,
-                             SpaceDecorator::Clear,
-                             SpaceDecorator::Mangle);
+  initialize_object_space(cmr, cmr.start(),
+                          SpaceDecorator::Clear,
+                          SpaceDecorator::Mangle);
 
   _object_mark_sweep = new PSMarkSweepDecorator(_object_space, start_array(), MarkSweepDeadRatio);
 
@@ -401,15 +403,66 @@ void PSOldGen::post_resize() {
   start_array()->set_covered_region(new_memregion);
   Universe::heap()->barrier_set()->resize_covered_region(new_memregion);
 
-  // ALWAYS do this last!!
-  object_space()->initialize(new_memregion,
-                             SpaceDecorator::DontClear,
-                             SpaceDecorator::DontMangle);
+  // ALWAYS do this last!! Only the newly committed part needs binding;
+  // it has not been touched yet.
+  initialize_object_space(new_memregion,
+                          MAX2(new_memregion.start(), object_space()->end()),
+                          SpaceDecorator::DontClear,
+                          SpaceDecorator::DontMangle);
 
   assert(new_word_size == heap_word_size(object_space()->capacity_in_bytes()),
     "Sanity");
 }
 
+// Stripes are numbered from the start of the heap rather than the
+// start of the generation so that a stripe keeps its node when the
+// boundary between the generations moves.
+static size_t numa_stripe_index(HeapWord* addr) {
+  HeapWord* heap_start = Universe::heap()->reserved_region().start();
+  return pointer_delta(addr, heap_start) >> ParallelCompactData::Log2RegionSize;
+}
+
+void PSOldGen::initialize_object_space(MemRegion mr, HeapWord* bind_start,
+                                       bool clear_space, bool mangle_space) {
+  MemRegion bind_mr(MIN2(bind_start, mr.end()), mr.end());
+  if (!numa_bind_pages(bind_mr)) {
+    object_space()->initialize(mr, clear_space, mangle_space);
+    return;
+  }
+  // Setting up the pages would make them global again with UseNUMA, so
+  // only pretouch the newly bound ones now that they are bound.
+  object_space()->initialize(mr, clear_space, mangle_space, MutableSpace::DontSetupPages);
+  if (AlwaysPreTouch) {
+    os::pretouch_memory((char*)bind_mr.start(), (char*)bind_mr.end());
+  }
+}
+
+bool PSOldGen::numa_bind_pages(MemRegion mr) {
+  G1NUMA* numa = G1NUMA::numa();
+  if (numa == NULL || !numa->is_enabled()) {
+    return false;
+  }
+  HeapWord* heap_start = Universe::heap()->reserved_region().start();
+  HeapWord* cur = mr.start();
+  while (cur < mr.end()) {
+    size_t stripe = numa_stripe_index(cur);
+    HeapWord* stripe_end = heap_start + ((stripe + 1) << ParallelCompactData::Log2RegionSize);
+    HeapWord* end = MIN2(stripe_end, mr.end());
+    numa->request_memory_on_node(cur, pointer_delta(end, cur, sizeof(char)),
+                                 (uint)stripe);
+    cur = end;
+  }
+  return true;
+}
+
+uint PSOldGen::numa_node_index_for(HeapWord* addr) {
+  G1NUMA* numa = G1NUMA::numa();
+  if (numa == NULL || !numa->is_enabled()) {
+    return 0;
+  }
+  return numa->preferred_node_index_for_index((uint)numa_stripe_index(addr));
+}
+
 size_t PSOldGen::gen_size_limit() {
   return _max_gen_size;
 }
@@ -98,6 +98,17 @@ class PSOldGen : public CHeapObj<mtGC> {
 
   void post_resize();
 
+  // With PSOldGenNUMABinding, bind the pages of mr to NUMA nodes in
+  // compaction region sized stripes. Returns whether it did; the space
+  // must then not set up its pages itself, which would make them global
+  // again.
+  bool numa_bind_pages(MemRegion mr);
+
+  // Initializes the object space to mr after binding the pages from
+  // bind_start on, the part not touched yet.
+  void initialize_object_space(MemRegion mr, HeapWord* bind_start,
+                               bool clear_space, bool mangle_space);
+
  public:
   // Initialize the generation.
   PSOldGen(ReservedSpace rs, size_t alignment,
@@ -122,6 +133,10 @@ class PSOldGen : public CHeapObj<mtGC> {
   // for a derived class.
   virtual size_t gen_size_limit();
 
+  // Index of the NUMA node the page holding addr was bound to by
+  // numa_bind_pages().  Only meaningful with PSOldGenNUMABinding.
+  static uint numa_node_index_for(HeapWord* addr);
+
   bool is_in(const void* p) const           {
     return _virtual_space->contains((void *)p);
   }
@@ -26,6 +26,8 @@
 #include "classfile/symbolTable.hpp"
 #include "classfile/systemDictionary.hpp"
 #include "code/codeCache.hpp"
+#include "gc_implementation/g1/g1NUMA.hpp"
+#include "gc_implementation/g1/g1StringDedup.hpp"
 #include "gc_implementation/parallelScavenge/gcTaskManager.hpp"
 #include "gc_implementation/parallelScavenge/parallelScavengeHeap.inline.hpp"
 #include "gc_implementation/parallelScavenge/pcTasks.hpp"
@@ -2431,6 +2433,11 @@ void PSParallelCompact::marking_phase(ParCompactionManager* cm,
   // Delete entries for dead interned strings.
   StringTable::unlink(is_alive_closure());
 
+  // Delete entries for dead string deduplication candidates and table entries.
+  if (G1StringDedup::is_enabled()) {
+    G1StringDedup::unlink(is_alive_closure());
+  }
+
   // Clean up unreferenced symbols in symbol table.
   SymbolTable::unlink();
   _gc_tracer.report_object_count_after_gc(is_alive_closure());
@@ -2472,6 +2479,9 @@ void PSParallelCompact::adjust_roots() {
   CodeBlobToOopClosure adjust_from_blobs(adjust_pointer_closure(), CodeBlobToOopClosure::FixRelocations);
   CodeCache::blobs_do(&adjust_from_blobs);
   StringTable::oops_do(adjust_pointer_closure());
+  if (G1StringDedup::is_enabled()) {
+    G1StringDedup::oops_do(adjust_pointer_closure());
+  }
   ref_processor()->weak_oops_do(adjust_pointer_closure());
   // Roots were visited so references into the young gen in roots
   // may have been scanned.  Process them also.
@@ -2480,6 +2490,60 @@ void PSParallelCompact::adjust_roots() {
   PSScavenge::reference_processor()->weak_oops_do(adjust_pointer_closure());
 }
 
+// Groups the compaction workers by the NUMA node they were seen on
+// during marking and hands out workers of a given node round-robin.
+// Inactive (no nodes) unless the old gen is bound to NUMA nodes.  This
+// relies on region list j being drained by worker j, which only holds
+// if all workers are active.
+class PSNUMARegionAssigner : public StackObj {
+  uint  _num_nodes;
+  uint* _workers;     // Worker ids, grouped by node.
+  uint* _node_start;  // Start of each node's group in _workers.
+  uint* _node_next;   // Next worker to use within each group.
+
+ public:
+  PSNUMARegionAssigner(uint task_count, bool all_workers_active) :
+    _num_nodes(0), _workers(NULL), _node_start(NULL), _node_next(NULL) {
+    G1NUMA* numa = G1NUMA::numa();
+    if (numa == NULL || !numa->is_enabled() || !all_workers_active) {
+      return;
+    }
+    _num_nodes = numa->num_active_nodes();
+    _workers = NEW_RESOURCE_ARRAY(uint, task_count);
+    _node_start = NEW_RESOURCE_ARRAY(uint, _num_nodes + 1);
+    _node_next = NEW_RESOURCE_ARRAY(uint, _num_nodes);
+    uint pos = 0;
+    for (uint node = 0; node < _num_nodes; node++) {
+      _node_start[node] = pos;
+      _node_next[node] = 0;
+      for (uint j = 0; j < task_count; j++) {
+        if (ParCompactionManager::manager_array(j)->numa_node_index() == node) {
+          _workers[pos++] = j;
+        }
+      }
+    }
+    _node_start[_num_nodes] = pos;
+  }
+
+  bool is_active() const { return _num_nodes > 0; }
+
+  // A worker on the given node, or fallback if there is none.
+  uint worker_for(uint node, uint fallback) {
+    if (node >= _num_nodes) {
+      return fallback;
+    }
+    uint count = _node_start[node + 1] - _node_start[node];
+    if (count == 0) {
+      return fallback;
+    }
+    uint worker = _workers[_node_start[node] + _node_next[node]];
+    if (++_node_next[node] == count) {
+      _node_next[node] = 0;
+    }
+    return worker;
+  }
+};
+
 void PSParallelCompact::enqueue_region_draining_tasks(GCTaskQueue* q,
                                                       uint parallel_gc_threads)
 {
@@ -2508,6 +2572,12 @@ void PSParallelCompact::enqueue_region_draining_tasks(GCTaskQueue* q,
 
   const ParallelCompactData& sd = PSParallelCompact::summary_data();
 
+  // With the old gen bound to nodes, fill each old gen destination region
+  // with a worker on that region's node.
+  ResourceMark rm;
+  PSNUMARegionAssigner numa_assigner(task_count,
+                                     gc_task_manager()->all_workers_active());
+
   size_t fillable_regions = 0;   // A count for diagnostic purposes.
   // A region index which corresponds to the tasks created above.
   // "which" must be 0 <= which < task_count
@@ -2526,7 +2596,12 @@ void PSParallelCompact::enqueue_region_draining_tasks(GCTaskQueue* q,
 
     for (size_t cur = end_region - 1; cur + 1 > beg_region; --cur) {
       if (sd.region(cur)->claim_unsafe()) {
-        ParCompactionManager::region_list_push(which, cur);
+        uint target = which;
+        if (numa_assigner.is_active() && id == old_space_id) {
+          uint node = PSOldGen::numa_node_index_for(sd.region_to_addr(cur));
+          target = numa_assigner.worker_for(node, which);
+        }
+        ParCompactionManager::region_list_push(target, cur);
 
         if (TraceParallelOldGCCompactionPhase && Verbose) {
           const size_t count_mod_8 = fillable_regions & 7;
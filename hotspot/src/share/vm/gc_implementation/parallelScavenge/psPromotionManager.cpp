@@ -61,9 +61,12 @@ void PSPromotionManager::initialize() {
   // Create and register the PSPromotionManager(s) for the worker threads.
   for(uint i=0; i<ParallelGCThreads; i++) {
     stack_array_depth()->register_queue(i, _manager_array[i].claimed_stack_depth());
+    _manager_array[i]._string_dedup_queue = i;
   }
   // The VMThread gets its own PSPromotionManager, which is not available
-  // for work stealing.
+  // for work stealing. It is never used while the worker threads are
+  // copying objects, so it can share the first string deduplication queue.
+  _manager_array[ParallelGCThreads]._string_dedup_queue = 0;
 }
 
 PSPromotionManager* PSPromotionManager::gc_thread_promotion_manager(int index) {
@@ -100,6 +103,8 @@ bool PSPromotionManager::post_scavenge(YoungGCTracer& gc_tracer) {
       promotion_failure_occurred = true;
     }
     manager->flush_labs();
+    manager->_young_plab_stats.report(i, false /* tenured */, &gc_tracer);
+    manager->_old_plab_stats.report(i, true /* tenured */, &gc_tracer);
   }
   return promotion_failure_occurred;
 }
@@ -176,6 +181,8 @@ PSPromotionManager::PSPromotionManager() {
   // let's choose 1.5x the chunk size
   _min_array_size_for_chunking = 3 * _array_chunk_size / 2;
 
+  _string_dedup_queue = 0;
+
   reset();
 }
 
@@ -190,10 +197,12 @@ void PSPromotionManager::reset() {
   // Do not prefill the LAB's, save heap wastage!
   HeapWord* lab_base = young_space()->top();
   _young_lab.initialize(MemRegion(lab_base, (size_t)0));
+  _young_plab_stats.reset(YoungPLABSize);
   _young_gen_is_full = false;
 
   lab_base = old_gen()->object_space()->top();
   _old_lab.initialize(MemRegion(lab_base, (size_t)0));
+  _old_plab_stats.reset(OldPLABSize);
   _old_gen_is_full = false;
 
   _promotion_failed_info.reset();
@@ -283,9 +292,11 @@ void PSPromotionManager::process_array_chunk(oop old) {
 
   int start;
   int const end = arrayOop(old)->length();
-  if (end > (int) _min_array_size_for_chunking) {
+  int const chunk_size = (int) array_chunk_size();
+  // Same 1.5x rule as _min_array_size_for_chunking, but for the current chunk size
+  if (end > chunk_size + chunk_size / 2) {
     // we'll chunk more
-    start = end - _array_chunk_size;
+    start = end - chunk_size;
     assert(start > 0, "invariant");
     arrayOop(old)->set_length(start);
     push_depth(mask_chunked_array_oop(old));
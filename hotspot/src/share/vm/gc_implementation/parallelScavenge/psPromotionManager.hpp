@@ -28,6 +28,7 @@
 #include "gc_implementation/parallelScavenge/psPromotionLAB.hpp"
 #include "gc_implementation/shared/gcTrace.hpp"
 #include "gc_implementation/shared/copyFailedInfo.hpp"
+#include "gc_implementation/shared/parGCAllocBuffer.hpp"
 #include "memory/allocation.hpp"
 #include "memory/padded.hpp"
 #include "utilities/globalDefinitions.hpp"
@@ -77,6 +78,8 @@ class PSPromotionManager VALUE_OBJ_CLASS_SPEC {
 
   PSYoungPromotionLAB                 _young_lab;
   PSOldPromotionLAB                   _old_lab;
+  PLABWorkerStats                     _young_plab_stats;
+  PLABWorkerStats                     _old_plab_stats;
   bool                                _young_gen_is_full;
   bool                                _old_gen_is_full;
 
@@ -89,8 +92,15 @@ class PSPromotionManager VALUE_OBJ_CLASS_SPEC {
   uint                                _array_chunk_size;
   uint                                _min_array_size_for_chunking;
 
+  // Maximum factor the array chunk size is scaled by with
+  // PSAdaptiveArrayScanChunk.
+  static const uint                   _max_array_chunk_scale = 8;
+
   PromotionFailedInfo                 _promotion_failed_info;
 
+  // Deduplication queue used when enqueuing string deduplication candidates.
+  uint                                _string_dedup_queue;
+
   // Accessors
   static PSOldGen* old_gen()         { return _old_gen; }
   static MutableSpace* young_space() { return _young_space; }
@@ -144,6 +154,9 @@ class PSPromotionManager VALUE_OBJ_CLASS_SPEC {
                                                     int start, int end);
   void process_array_chunk(oop old);
 
+  // Returns the number of array elements to scan in the next chunk.
+  inline uint array_chunk_size();
+
   template <class T> void push_depth(T* p) {
     claimed_stack_depth()->push(p);
   }
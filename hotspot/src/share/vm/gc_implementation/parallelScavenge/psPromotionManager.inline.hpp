@@ -25,6 +25,7 @@
 #ifndef SHARE_VM_GC_IMPLEMENTATION_PARALLELSCAVENGE_PSPROMOTIONMANAGER_INLINE_HPP
 #define SHARE_VM_GC_IMPLEMENTATION_PARALLELSCAVENGE_PSPROMOTIONMANAGER_INLINE_HPP
 
+#include "gc_implementation/g1/g1StringDedup.hpp"
 #include "gc_implementation/parallelScavenge/psOldGen.hpp"
 #include "gc_implementation/parallelScavenge/psPromotionManager.hpp"
 #include "gc_implementation/parallelScavenge/psPromotionLAB.inline.hpp"
@@ -37,6 +38,19 @@ inline PSPromotionManager* PSPromotionManager::manager_array(int index) {
   return &_manager_array[index];
 }
 
+inline uint PSPromotionManager::array_chunk_size() {
+  if (!PSAdaptiveArrayScanChunk) {
+    return _array_chunk_size;
+  }
+  // Scan small chunks while the local queue is shallow, so that the
+  // remainder of the array is pushed, and can be stolen by idle workers,
+  // as soon as possible. Scan larger chunks while there is plenty of
+  // other work on the queue, to lower the per chunk overhead.
+  uint depth = claimed_stack_depth()->size();
+  uint scale = 1 + depth / MAX2(_target_stack_size, 1u);
+  return _array_chunk_size * MIN2(scale, _max_array_chunk_scale);
+}
+
 template <class T>
 inline void PSPromotionManager::claim_or_forward_internal_depth(T* p) {
   if (p != NULL) { // XXX: error if p != NULL here
@@ -122,17 +136,29 @@ oop PSPromotionManager::copy_to_survivor_space(oop o) {
         new_obj = (oop) _young_lab.allocate(new_obj_size);
         if (new_obj == NULL && !_young_gen_is_full) {
           // Do we allocate directly, or flush and refill?
-          if (new_obj_size > (YoungPLABSize / 2)) {
+          size_t lab_size = _young_plab_stats.desired_sz();
+          if (new_obj_size > (lab_size / 2)) {
             // Allocate this object directly
             new_obj = (oop)young_space()->cas_allocate(new_obj_size);
+            if (new_obj != NULL) {
+              _young_plab_stats.record_direct_allocation(new_obj_size);
+            }
             promotion_trace_event(new_obj, o, new_obj_size, age, false, NULL);
           } else {
             // Flush and fill
+            _young_plab_stats.record_retire(pointer_delta(_young_lab.end(), _young_lab.top()));
             _young_lab.flush();
 
-            HeapWord* lab_base = young_space()->cas_allocate(YoungPLABSize);
+            lab_size = _young_plab_stats.desired_sz();
+            HeapWord* lab_base = young_space()->cas_allocate(lab_size);
+            if (lab_base == NULL && lab_size > YoungPLABSize) {
+              // A grown lab may no longer fit, fall back to the default size.
+              lab_size = YoungPLABSize;
+              lab_base = young_space()->cas_allocate(lab_size);
+            }
             if (lab_base != NULL) {
-              _young_lab.initialize(MemRegion(lab_base, YoungPLABSize));
+              _young_lab.initialize(MemRegion(lab_base, lab_size));
+              _young_plab_stats.record_buffer(lab_size);
               // Try the young lab allocation again.
               new_obj = (oop) _young_lab.allocate(new_obj_size);
               promotion_trace_event(new_obj, o, new_obj_size, age, false, &_young_lab);
@@ -158,15 +184,26 @@ oop PSPromotionManager::copy_to_survivor_space(oop o) {
       if (new_obj == NULL) {
         if (!_old_gen_is_full) {
           // Do we allocate directly, or flush and refill?
-          if (new_obj_size > (OldPLABSize / 2)) {
+          size_t lab_size = _old_plab_stats.desired_sz();
+          if (new_obj_size > (lab_size / 2)) {
             // Allocate this object directly
             new_obj = (oop)old_gen()->cas_allocate(new_obj_size);
+            if (new_obj != NULL) {
+              _old_plab_stats.record_direct_allocation(new_obj_size);
+            }
             promotion_trace_event(new_obj, o, new_obj_size, age, true, NULL);
           } else {
             // Flush and fill
+            _old_plab_stats.record_retire(pointer_delta(_old_lab.end(), _old_lab.top()));
             _old_lab.flush();
 
-            HeapWord* lab_base = old_gen()->cas_allocate(OldPLABSize);
+            lab_size = _old_plab_stats.desired_sz();
+            HeapWord* lab_base = old_gen()->cas_allocate(lab_size);
+            if (lab_base == NULL && lab_size > OldPLABSize) {
+              // A grown lab may no longer fit, fall back to the default size.
+              lab_size = OldPLABSize;
+              lab_base = old_gen()->cas_allocate(lab_size);
+            }
             if(lab_base != NULL) {
 #ifdef ASSERT
               // Delay the initialization of the promotion lab (plab).
@@ -175,7 +212,8 @@ oop PSPromotionManager::copy_to_survivor_space(oop o) {
                 os::sleep(Thread::current(), GCWorkerDelayMillis, false);
               }
 #endif
-              _old_lab.initialize(MemRegion(lab_base, OldPLABSize));
+              _old_lab.initialize(MemRegion(lab_base, lab_size));
+              _old_plab_stats.record_buffer(lab_size);
               // Try the old lab allocation again.
               new_obj = (oop) _old_lab.allocate(new_obj_size);
               promotion_trace_event(new_obj, o, new_obj_size, age, true, &_old_lab);
@@ -214,6 +252,13 @@ oop PSPromotionManager::copy_to_survivor_space(oop o) {
         assert(young_space()->contains(new_obj), "Attempt to push non-promoted obj");
       }
 
+      if (G1StringDedup::is_enabled()) {
+        G1StringDedup::enqueue_from_evacuation(true /* from_young */,
+                                               !new_obj_is_tenured,
+                                               _string_dedup_queue,
+                                               new_obj);
+      }
+
       // Do the size comparison first with new_obj_size, which we
       // already have. Hopefully, only a few objects are larger than
       // _min_array_size_for_chunking, and most of them will be arrays.
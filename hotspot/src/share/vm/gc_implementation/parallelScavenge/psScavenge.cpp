@@ -25,6 +25,7 @@
 #include "precompiled.hpp"
 #include "classfile/symbolTable.hpp"
 #include "code/codeCache.hpp"
+#include "gc_implementation/g1/g1StringDedup.hpp"
 #include "gc_implementation/parallelScavenge/cardTableExtension.hpp"
 #include "gc_implementation/parallelScavenge/gcTaskManager.hpp"
 #include "gc_implementation/parallelScavenge/parallelScavengeHeap.hpp"
@@ -385,6 +386,15 @@ bool PSScavenge::invoke_no_policy() {
 
     // Set the number of GC threads to be used in this collection
     gc_task_manager()->set_active_gang();
+    // Do not wake more workers than the bytes this scavenge is expected
+    // to copy keep busy.
+    size_t predicted_copied_bytes =
+      (size_t) (size_policy->avg_survived()->padded_average() +
+                size_policy->avg_promoted()->padded_average());
+    gc_task_manager()->set_active_workers(
+      AdaptiveSizePolicy::calc_active_workers_by_work(gc_task_manager()->active_workers(),
+                                                      predicted_copied_bytes,
+                                                      0 /* predicted_cards */));
     gc_task_manager()->task_idle_workers();
     // Get the active number of workers here and use that value
     // throughout the methods.
@@ -404,9 +414,10 @@ bool PSScavenge::invoke_no_policy() {
       if (!old_gen->object_space()->is_empty()) {
         // There are only old-to-young pointers if there are objects
         // in the old gen.
-        uint stripe_total = active_workers;
-        for(uint i=0; i < stripe_total; i++) {
-          q->enqueue(new OldToYoungRootsTask(old_gen, old_top, i, stripe_total));
+        CardTableExtension* card_table = (CardTableExtension*) heap->barrier_set();
+        card_table->reset_stripe_claims();
+        for(uint i=0; i < active_workers; i++) {
+          q->enqueue(new OldToYoungRootsTask(old_gen, old_top));
         }
       }
 
@@ -473,6 +484,14 @@ bool PSScavenge::invoke_no_policy() {
       StringTable::unlink_or_oops_do(&_is_alive_closure, &root_closure);
     }
 
+    if (G1StringDedup::is_enabled()) {
+      GCTraceTime tm("StringDedup", false, false, &_gc_timer, _gc_tracer.gc_id());
+      // Unlink dead deduplication candidates and table entries, and
+      // update the remaining ones to point to the copied objects.
+      PSScavengeRootsClosure root_closure(promotion_manager);
+      G1StringDedup::unlink_or_oops_do(&_is_alive_closure, &root_closure, true /* allow_resize_and_rehash */);
+    }
+
     // Finally, flush the promotion_manager's labs, and deallocate its stacks.
     promotion_failure_occurred = PSPromotionManager::post_scavenge(_gc_tracer);
     if (promotion_failure_occurred) {
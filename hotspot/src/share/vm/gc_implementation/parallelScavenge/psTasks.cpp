@@ -177,7 +177,6 @@ void OldToYoungRootsTask::do_it(GCTaskManager* manager, uint which) {
     "Should not be called is there is no work");
   assert(_gen != NULL, "Sanity");
   assert(_gen->object_space()->contains(_gen_top) || _gen_top == _gen->object_space()->top(), "Sanity");
-  assert(_stripe_number < ParallelGCThreads, "Sanity");
 
   {
     PSPromotionManager* pm = PSPromotionManager::gc_thread_promotion_manager(which);
@@ -189,9 +188,7 @@ void OldToYoungRootsTask::do_it(GCTaskManager* manager, uint which) {
     card_table->scavenge_contents_parallel(_gen->start_array(),
                                            _gen->object_space(),
                                            _gen_top,
-                                           pm,
-                                           _stripe_number,
-                                           _stripe_total);
+                                           pm);
 
     // Do the real work
     pm->drain_stacks(false);
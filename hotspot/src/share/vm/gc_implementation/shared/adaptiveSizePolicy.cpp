@@ -26,6 +26,7 @@
 #include "gc_implementation/shared/adaptiveSizePolicy.hpp"
 #include "gc_interface/gcCause.hpp"
 #include "memory/collectorPolicy.hpp"
+#include "runtime/os.hpp"
 #include "runtime/timer.hpp"
 #include "utilities/ostream.hpp"
 #include "utilities/workgroup.hpp"
@@ -112,6 +113,7 @@ int AdaptiveSizePolicy::calc_default_active_workers(uintx total_workers,
   uintx prev_active_workers = active_workers;
   uintx active_workers_by_JT = 0;
   uintx active_workers_by_heap_size = 0;
+  uintx active_workers_by_cpus = 0;
 
   // Always use at least min_workers but use up to
   // GCThreadsPerJavaThreads * application threads.
@@ -129,10 +131,16 @@ int AdaptiveSizePolicy::calc_default_active_workers(uintx total_workers,
   uintx max_active_workers =
     MAX2(active_workers_by_JT, active_workers_by_heap_size);
 
+  // Do not use more workers than there are processors available now.
+  // A container's CPU quota can shrink or grow while the VM runs.
+  active_workers_by_cpus =
+    MAX2((uintx) os::active_processor_count(), min_workers);
+
   // Limit the number of workers to the the number created,
   // (workers()).
-  new_active_workers = MIN2(max_active_workers,
-                                (uintx) total_workers);
+  new_active_workers = MIN3(max_active_workers,
+                            active_workers_by_cpus,
+                            (uintx) total_workers);
 
   // Increase GC workers instantly but decrease them more
   // slowly.
@@ -170,9 +178,11 @@ int AdaptiveSizePolicy::calc_default_active_workers(uintx total_workers,
      gclog_or_tty->print_cr("GCTaskManager::calc_default_active_workers() : "
        "active_workers(): %d  new_active_workers: %d  "
        "prev_active_workers: %d\n"
-       " active_workers_by_JT: %d  active_workers_by_heap_size: %d",
+       " active_workers_by_JT: %d  active_workers_by_heap_size: %d"
+       "  active_workers_by_cpus: %d",
        (int) active_workers, (int) new_active_workers, (int) prev_active_workers,
-       (int) active_workers_by_JT, (int) active_workers_by_heap_size);
+       (int) active_workers_by_JT, (int) active_workers_by_heap_size,
+       (int) active_workers_by_cpus);
   }
   assert(new_active_workers > 0, "Always need at least 1");
   return new_active_workers;
@@ -219,6 +229,37 @@ int AdaptiveSizePolicy::calc_active_conc_workers(uintx total_workers,
   }
 }
 
+uint AdaptiveSizePolicy::calc_active_workers_by_work(uint active_workers,
+                                                     size_t predicted_copied_bytes,
+                                                     size_t predicted_cards) {
+  if (!UseDynamicNumberOfGCThreads ||
+     (!FLAG_IS_DEFAULT(ParallelGCThreads) && !ForceDynamicNumberOfGCThreads) ||
+     (CopiedBytesPerGCThread == 0 && CardsPerGCThread == 0)) {
+    return active_workers;
+  }
+
+  size_t workers_by_bytes = 0;
+  if (CopiedBytesPerGCThread > 0) {
+    workers_by_bytes = predicted_copied_bytes / CopiedBytesPerGCThread + 1;
+  }
+  size_t workers_by_cards = 0;
+  if (CardsPerGCThread > 0) {
+    workers_by_cards = predicted_cards / CardsPerGCThread + 1;
+  }
+  uint new_active_workers =
+    (uint) MIN2(MAX2(workers_by_bytes, workers_by_cards), (size_t) active_workers);
+
+  if (TraceDynamicGCThreads) {
+    gclog_or_tty->print_cr("AdaptiveSizePolicy::calc_active_workers_by_work() : "
+      "active_workers: %u  new_active_workers: %u  "
+      "predicted_copied_bytes: " SIZE_FORMAT "  predicted_cards: " SIZE_FORMAT,
+      active_workers, new_active_workers,
+      predicted_copied_bytes, predicted_cards);
+  }
+  assert(new_active_workers > 0, "Always need at least 1");
+  return new_active_workers;
+}
+
 bool AdaptiveSizePolicy::tenuring_threshold_change() const {
   return decrement_tenuring_threshold_for_gc_cost() ||
          increment_tenuring_threshold_for_gc_cost() ||
@@ -367,6 +367,14 @@ class AdaptiveSizePolicy : public CHeapObj<mtGC> {
                                       uintx active_workers,
                                       uintx application_workers);
 
+  // Return the number of the active_workers chosen by calc_active_workers()
+  // that the work predicted for the next young collection keeps busy:
+  // one per CopiedBytesPerGCThread bytes to copy or per CardsPerGCThread
+  // cards to process, whichever asks for more, but at least one.
+  static uint calc_active_workers_by_work(uint active_workers,
+                                          size_t predicted_copied_bytes,
+                                          size_t predicted_cards);
+
   bool is_gc_cms_adaptive_size_policy() {
     return kind() == _gc_cms_adaptive_size_policy;
   }
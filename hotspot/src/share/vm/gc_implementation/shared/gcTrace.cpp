@@ -196,6 +196,11 @@ void YoungGCTracer::report_promotion_outside_plab_event(Klass* klass, size_t obj
   send_promotion_outside_plab_event(klass, obj_size, age, tenured);
 }
 
+void YoungGCTracer::report_plab_worker_stats(uint worker_id, bool tenured,
+                                             const PLABWorkerStats& stats) const {
+  send_plab_worker_stats_event(worker_id, tenured, stats);
+}
+
 void OldGCTracer::report_gc_end_impl(const Ticks& timestamp, TimePartitions* time_partitions) {
   assert_set_gc_id();
 
@@ -248,6 +253,13 @@ void G1NewTracer::report_evacuation_info(EvacuationInfo* info) {
   send_evacuation_info_event(info);
 }
 
+void G1NewTracer::report_pause_prediction(bool mixed, double predicted_ms,
+                                          double pause_ms, double target_ms) {
+  assert_set_gc_id();
+
+  send_pause_prediction_event(mixed, predicted_ms, pause_ms, target_ms);
+}
+
 void G1NewTracer::report_evacuation_failed(EvacuationFailedInfo& ef_info) {
   assert_set_gc_id();
 
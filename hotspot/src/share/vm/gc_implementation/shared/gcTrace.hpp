@@ -44,6 +44,7 @@ class EvacuationInfo;
 class GCHeapSummary;
 class MetaspaceChunkFreeListSummary;
 class MetaspaceSummary;
+class PLABWorkerStats;
 class PSHeapSummary;
 class ReferenceProcessorStats;
 class TimePartitions;
@@ -178,6 +179,8 @@ class YoungGCTracer : public GCTracer {
                                           size_t plab_size) const;
   void report_promotion_outside_plab_event(Klass* klass, size_t obj_size,
                                            uint age, bool tenured) const;
+  void report_plab_worker_stats(uint worker_id, bool tenured,
+                                const PLABWorkerStats& stats) const;
 
  private:
   void send_young_gc_event() const;
@@ -189,6 +192,8 @@ class YoungGCTracer : public GCTracer {
                                         size_t plab_size) const;
   void send_promotion_outside_plab_event(Klass* klass, size_t obj_size,
                                          uint age, bool tenured) const;
+  void send_plab_worker_stats_event(uint worker_id, bool tenured,
+                                    const PLABWorkerStats& stats) const;
 };
 
 class OldGCTracer : public GCTracer {
@@ -256,11 +261,15 @@ class G1NewTracer : public YoungGCTracer {
   void report_gc_end_impl(const Ticks& timestamp, TimePartitions* time_partitions);
   void report_evacuation_info(EvacuationInfo* info);
   void report_evacuation_failed(EvacuationFailedInfo& ef_info);
+  void report_pause_prediction(bool mixed, double predicted_ms,
+                               double pause_ms, double target_ms);
 
  private:
   void send_g1_young_gc_event();
   void send_evacuation_info_event(EvacuationInfo* info);
   void send_evacuation_failed_event(const EvacuationFailedInfo& ef_info) const;
+  void send_pause_prediction_event(bool mixed, double predicted_ms,
+                                   double pause_ms, double target_ms);
 };
 #endif
 
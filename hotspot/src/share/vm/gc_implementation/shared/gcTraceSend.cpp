@@ -29,6 +29,7 @@
 #include "gc_implementation/shared/gcTrace.hpp"
 #include "gc_implementation/shared/gcWhen.hpp"
 #include "gc_implementation/shared/copyFailedInfo.hpp"
+#include "gc_implementation/shared/parGCAllocBuffer.hpp"
 #include "runtime/os.hpp"
 #if INCLUDE_ALL_GCS
 #include "gc_implementation/g1/evacuationInfo.hpp"
@@ -147,6 +148,22 @@ void YoungGCTracer::send_promotion_outside_plab_event(Klass* klass, size_t obj_s
   }
 }
 
+void YoungGCTracer::send_plab_worker_stats_event(uint worker_id, bool tenured,
+                                                 const PLABWorkerStats& stats) const {
+  EventPLABWorkerStatistics e;
+  if (e.should_commit()) {
+    e.set_gcId(_shared_gc_info.gc_id().id());
+    e.set_workerId(worker_id);
+    e.set_tenured(tenured);
+    e.set_refills(stats.refills());
+    e.set_allocated(stats.allocated() * HeapWordSize);
+    e.set_wasted(stats.wasted() * HeapWordSize);
+    e.set_directAllocated(stats.direct_allocated() * HeapWordSize);
+    e.set_plabSize(stats.desired_sz() * HeapWordSize);
+    e.commit();
+  }
+}
+
 void OldGCTracer::send_old_gc_event() const {
   EventOldGarbageCollection e(UNTIMED);
   if (e.should_commit()) {
@@ -208,6 +225,19 @@ void G1MMUTracer::send_g1_mmu_event(double time_slice_ms, double gc_time_ms, dou
   }
 }
 
+void G1NewTracer::send_pause_prediction_event(bool mixed, double predicted_ms,
+                                              double pause_ms, double target_ms) {
+  EventG1PausePrediction e;
+  if (e.should_commit()) {
+    e.set_gcId(_shared_gc_info.gc_id().id());
+    e.set_mixed(mixed);
+    e.set_predictedPauseTime(predicted_ms);
+    e.set_pauseTime(pause_ms);
+    e.set_pauseTarget(target_ms);
+    e.commit();
+  }
+}
+
 void G1NewTracer::send_evacuation_info_event(EvacuationInfo* info) {
   EventEvacuationInformation e;
   if (e.should_commit()) {
@@ -39,7 +39,7 @@ inline void MarkSweep::mark_object(oop obj) {
   if (G1StringDedup::is_enabled()) {
     // We must enqueue the object before it is marked
     // as we otherwise can't read the object's age.
-    G1StringDedup::enqueue_from_mark(obj);
+    G1StringDedup::enqueue_from_mark(obj, 0 /* worker_id */);
   }
 #endif
   // some marks may contain information we need to preserve so we store them away
@@ -23,6 +23,7 @@
  */
 
 #include "precompiled.hpp"
+#include "gc_implementation/shared/gcTrace.hpp"
 #include "gc_implementation/shared/parGCAllocBuffer.hpp"
 #include "memory/sharedHeap.hpp"
 #include "oops/arrayOop.hpp"
@@ -132,6 +133,49 @@ void PLABStats::adjust_desired_plab_sz(uint no_of_gc_workers) {
   _unused    = 0;
 }
 
+void PLABWorkerStats::reset(size_t initial_sz) {
+  _initial_sz = initial_sz;
+  _desired_sz = initial_sz;
+  _allocated = 0;
+  _wasted = 0;
+  _direct_allocated = 0;
+  _refills = 0;
+}
+
+void PLABWorkerStats::adjust_desired_sz() {
+  if (!ResizePLABPerWorker || _allocated == 0) {
+    // Nothing but the initial, empty buffer has been retired.
+    return;
+  }
+  size_t sz;
+  if (_wasted * 100 > _allocated * TargetPLABWastePct) {
+    sz = _desired_sz / 2;
+  } else {
+    sz = _desired_sz * 2;
+  }
+  sz = MIN2(sz, _initial_sz * MaxGrowthFactor);
+  sz = MIN2(sz, ParGCAllocBuffer::max_size());
+  sz = MAX2(sz, ParGCAllocBuffer::min_size());
+  _desired_sz = align_object_size(sz);
+}
+
+void PLABWorkerStats::report(uint worker_id, bool tenured,
+                             YoungGCTracer* gc_tracer) const {
+  if (_refills == 0 && _direct_allocated == 0) {
+    return;
+  }
+  if (PrintPLAB) {
+    gclog_or_tty->print_cr(" (worker %u %s plab: refills = %u, "
+                           "allocated = " SIZE_FORMAT ", wasted = " SIZE_FORMAT ", "
+                           "direct = " SIZE_FORMAT ", plab_sz = " SIZE_FORMAT ")",
+                           worker_id, tenured ? "old" : "survivor", _refills,
+                           _allocated, _wasted, _direct_allocated, _desired_sz);
+  }
+  if (gc_tracer != NULL) {
+    gc_tracer->report_plab_worker_stats(worker_id, tenured, *this);
+  }
+}
+
 #ifndef PRODUCT
 void ParGCAllocBuffer::print() {
   gclog_or_tty->print("parGCAllocBuffer: _bottom: %p  _top: %p  _end: %p  _hard_end: %p"
@@ -33,6 +33,7 @@
 // Forward decl.
 
 class PLABStats;
+class YoungGCTracer;
 
 // A per-thread allocation buffer used during GC.
 class ParGCAllocBuffer: public CHeapObj<mtGC> {
@@ -217,6 +218,59 @@ class PLABStats VALUE_OBJ_CLASS_SPEC {
   }
 };
 
+// Per-worker PLAB sizing within a single pause.  A worker starts the
+// pause with the globally desired PLAB size and, with
+// ResizePLABPerWorker, picks the size of every further buffer from the
+// part of its earlier buffers it had to abandon: a worker that keeps
+// filling its buffers gets larger ones, a worker leaving half-empty
+// buffers behind gets smaller ones.  Not MT safe; owned by one worker.
+class PLABWorkerStats VALUE_OBJ_CLASS_SPEC {
+  size_t _initial_sz;       // desired size at the start of the pause
+  size_t _desired_sz;       // size of the next buffer
+  size_t _allocated;        // size of all buffers taken this pause
+  size_t _wasted;           // unused part of buffers retired before the end
+  size_t _direct_allocated; // allocated outside of buffers
+  uint   _refills;          // number of buffers taken this pause
+
+  // Limit on how far a worker may grow its buffers beyond the
+  // globally desired size within one pause.
+  static const size_t MaxGrowthFactor = 8;
+
+  void adjust_desired_sz();
+
+ public:
+  PLABWorkerStats(size_t initial_sz = 0) { reset(initial_sz); }
+
+  // Start a new pause with the given globally desired size.
+  void reset(size_t initial_sz);
+
+  size_t desired_sz() const     { return _desired_sz; }
+  size_t allocated() const      { return _allocated; }
+  size_t wasted() const         { return _wasted; }
+  size_t direct_allocated() const { return _direct_allocated; }
+  uint refills() const          { return _refills; }
+
+  // A new buffer of word_sz words has been taken.
+  void record_buffer(size_t word_sz) {
+    _allocated += word_sz;
+    _refills++;
+  }
+
+  // The current buffer is retired with unused words left in it to make
+  // room for a new one.  Recomputes the size of the next buffer.
+  void record_retire(size_t unused) {
+    _wasted += unused;
+    adjust_desired_sz();
+  }
+
+  void record_direct_allocation(size_t word_sz) {
+    _direct_allocated += word_sz;
+  }
+
+  // Print the statistics with PrintPLAB and send them to the tracer.
+  void report(uint worker_id, bool tenured, YoungGCTracer* gc_tracer) const;
+};
+
 class ParGCAllocBufferWithBOT: public ParGCAllocBuffer {
   BlockOffsetArrayContigSpace _bt;
   BlockOffsetSharedArray*     _bsa;
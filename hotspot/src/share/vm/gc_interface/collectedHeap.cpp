@@ -132,6 +132,19 @@ void CollectedHeap::unregister_nmethod(nmethod* nm) {
   assert_locked_or_safepoint(CodeCache_lock);
 }
 
+bool CollectedHeap::supports_object_pinning() const {
+  return false;
+}
+
+oop CollectedHeap::pin_object(JavaThread* thread, oop obj) {
+  ShouldNotReachHere();
+  return NULL;
+}
+
+void CollectedHeap::unpin_object(JavaThread* thread, oop obj) {
+  ShouldNotReachHere();
+}
+
 void CollectedHeap::trace_heap(GCWhen::Type when, GCTracer* gc_tracer) {
   const GCHeapSummary& heap_summary = create_heap_summary();
   gc_tracer->report_gc_heap_summary(when, heap_summary);
@@ -263,10 +276,24 @@ void CollectedHeap::check_for_valid_allocation_state() {
 
 HeapWord* CollectedHeap::allocate_from_tlab_slow(KlassHandle klass, Thread* thread, size_t size) {
 
+  // The heap sampler may have moved the end of the tlab in to the next
+  // sample point. Put it back and retry before treating the tlab as full.
+  if (thread->tlab().end_moved_for_sample()) {
+    thread->tlab().set_back_allocation_end();
+    HeapWord* obj = thread->tlab().allocate(size);
+    if (obj != NULL) {
+      sample_tlab_allocation(thread, obj, size);
+      return obj;
+    }
+  }
+
   // Retain tlab and allocate object in shared space if
   // the amount free in the tlab is too large to discard.
   if (thread->tlab().free() > thread->tlab().refill_waste_limit()) {
     thread->tlab().record_slow_allocation(size);
+    if (ThreadHeapSampler::enabled()) {
+      thread->tlab().set_sample_end();
+    }
     return NULL;
   }
 
@@ -300,9 +327,19 @@ HeapWord* CollectedHeap::allocate_from_tlab_slow(KlassHandle klass, Thread* thre
 #endif // ASSERT
   }
   thread->tlab().fill(obj, obj + size, new_tlab_size);
+  sample_tlab_allocation(thread, obj, size);
   return obj;
 }
 
+void CollectedHeap::sample_tlab_allocation(Thread* thread, HeapWord* obj, size_t size) {
+  if (ThreadHeapSampler::enabled()) {
+    ThreadLocalAllocBuffer& tlab = thread->tlab();
+    thread->heap_sampler().check_for_sampling(obj, size * HeapWordSize,
+                                              tlab.bytes_since_last_sample_point());
+    tlab.set_sample_end();
+  }
+}
+
 void CollectedHeap::flush_deferred_store_barrier(JavaThread* thread) {
   MemRegion deferred = thread->deferred_card_mark();
   if (!deferred.is_empty()) {
@@ -43,6 +43,7 @@
 class AdaptiveSizePolicy;
 class BarrierSet;
 class CollectorPolicy;
+class FlexibleWorkGang;
 class GCHeapSummary;
 class GCTimer;
 class GCTracer;
@@ -139,6 +140,11 @@ class CollectedHeap : public CHeapObj<mtInternal> {
   inline static HeapWord* allocate_from_tlab(KlassHandle klass, Thread* thread, size_t size);
   static HeapWord* allocate_from_tlab_slow(KlassHandle klass, Thread* thread, size_t size);
 
+  // Heap sampler support: count an allocation taken on the tlab slow
+  // path, and report the pending sample once the object is set up.
+  static void sample_tlab_allocation(Thread* thread, HeapWord* obj, size_t size);
+  inline static oop post_allocation_sample(HeapWord* obj, TRAPS);
+
   // Allocate an uninitialized block of the given size, or returns NULL if
   // this is impossible.
   inline static HeapWord* common_mem_allocate_noinit(KlassHandle klass, size_t size, TRAPS);
@@ -593,6 +599,20 @@ class CollectedHeap : public CHeapObj<mtInternal> {
   // Iterator for all GC threads (other than VM thread)
   virtual void gc_threads_do(ThreadClosure* tc) const = 0;
 
+  // The GC worker threads that may run the safepoint cleanup tasks in
+  // parallel, or NULL if the heap has none to lend.
+  virtual FlexibleWorkGang* get_safepoint_workers() { return NULL; }
+
+  // Parallel object iteration by the safepoint workers.  When supported,
+  // every worker calls object_iterate_parallel() with its id and together
+  // they visit each object once; the VM thread then calls
+  // object_iterate_parallel_done() once they have all finished.
+  virtual bool supports_object_iterate_parallel() const { return false; }
+  virtual void object_iterate_parallel(ObjectClosure* cl, uint worker_id, uint num_workers) {
+    ShouldNotReachHere();
+  }
+  virtual void object_iterate_parallel_done() {}
+
   // Print any relevant tracing info that flags imply.
   // Default implementation does nothing.
   virtual void print_tracing_info() const = 0;
@@ -605,6 +625,15 @@ class CollectedHeap : public CHeapObj<mtInternal> {
   virtual void register_nmethod(nmethod* nm);
   virtual void unregister_nmethod(nmethod* nm);
 
+  // Support for object pinning, used by the JNI Get*Critical() and
+  // Release*Critical() functions. A heap that supports it guarantees
+  // that a pinned object is not moved until it is unpinned, so that
+  // critical sections need not block garbage collection with the
+  // GC_locker. Pinning is only done by threads in the VM state.
+  virtual bool supports_object_pinning() const;
+  virtual oop pin_object(JavaThread* thread, oop obj);
+  virtual void unpin_object(JavaThread* thread, oop obj);
+
   void trace_heap_before_gc(GCTracer* gc_tracer);
   void trace_heap_after_gc(GCTracer* gc_tracer);
 
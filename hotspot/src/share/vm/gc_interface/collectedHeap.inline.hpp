@@ -150,6 +150,9 @@ HeapWord* CollectedHeap::common_mem_allocate_noinit(KlassHandle klass, size_t si
     assert(!HAS_PENDING_EXCEPTION,
            "Unexpected exception, will result in uninitialized storage");
     THREAD->incr_allocated_bytes(size * HeapWordSize);
+    if (ThreadHeapSampler::enabled()) {
+      THREAD->heap_sampler().check_for_sampling(result, size * HeapWordSize, 0);
+    }
 
     return result;
   }
@@ -197,6 +200,14 @@ HeapWord* CollectedHeap::allocate_from_tlab(KlassHandle klass, Thread* thread, s
   return allocate_from_tlab_slow(klass, thread, size);
 }
 
+oop CollectedHeap::post_allocation_sample(HeapWord* obj, TRAPS) {
+  ThreadHeapSampler& sampler = THREAD->heap_sampler();
+  if (sampler.sampled_object() != obj) {
+    return (oop)obj;
+  }
+  return sampler.report_sample((oop)obj, THREAD);
+}
+
 void CollectedHeap::init_obj(HeapWord* obj, size_t size) {
   assert(obj != NULL, "cannot initialize NULL object");
   const size_t hs = oopDesc::header_size();
@@ -212,7 +223,7 @@ oop CollectedHeap::obj_allocate(KlassHandle klass, int size, TRAPS) {
   HeapWord* obj = common_mem_allocate_init(klass, size, CHECK_NULL);
   post_allocation_setup_obj(klass, obj, size);
   NOT_PRODUCT(Universe::heap()->check_for_bad_heap_word_value(obj, size));
-  return (oop)obj;
+  return post_allocation_sample(obj, THREAD);
 }
 
 oop CollectedHeap::array_allocate(KlassHandle klass,
@@ -225,7 +236,7 @@ oop CollectedHeap::array_allocate(KlassHandle klass,
   HeapWord* obj = common_mem_allocate_init(klass, size, CHECK_NULL);
   post_allocation_setup_array(klass, obj, length);
   NOT_PRODUCT(Universe::heap()->check_for_bad_heap_word_value(obj, size));
-  return (oop)obj;
+  return post_allocation_sample(obj, THREAD);
 }
 
 oop CollectedHeap::array_allocate_nozero(KlassHandle klass,
@@ -242,7 +253,7 @@ oop CollectedHeap::array_allocate_nozero(KlassHandle klass,
   const size_t hs = oopDesc::header_size()+1;
   Universe::heap()->check_for_non_bad_heap_word_value(obj+hs, size-hs);
 #endif
-  return (oop)obj;
+  return post_allocation_sample(obj, THREAD);
 }
 
 inline void CollectedHeap::oop_iterate_no_header(OopClosure* cl) {
@@ -434,6 +434,52 @@
           if (THREAD->has_pending_exception()) goto label;         \
         }
 
+/*
+ * Field access quickening. A resolved getfield/putfield of a non-volatile
+ * field is rewritten to the matching _fast_Xgetfield/_fast_Xputfield,
+ * which skips the resolution check and the type dispatch. The fast codes
+ * post no JVMTI events, so nothing is rewritten when field watches or
+ * breakpoints may be set.
+ */
+#define REWRITE_AT_PC(val) *pc = (val);
+
+static inline bool can_quicken_field_access() {
+  return RewriteBytecodes &&
+         !JvmtiExport::can_post_field_access() &&
+         !JvmtiExport::can_post_field_modification() &&
+         !JvmtiExport::can_post_breakpoint();
+}
+
+static Bytecodes::Code fast_get_code(TosState tos_type) {
+  switch (tos_type) {
+    case atos: return Bytecodes::_fast_agetfield;
+    case btos: // fall through
+    case ztos: return Bytecodes::_fast_bgetfield;
+    case ctos: return Bytecodes::_fast_cgetfield;
+    case dtos: return Bytecodes::_fast_dgetfield;
+    case ftos: return Bytecodes::_fast_fgetfield;
+    case itos: return Bytecodes::_fast_igetfield;
+    case ltos: return Bytecodes::_fast_lgetfield;
+    case stos: return Bytecodes::_fast_sgetfield;
+    default:   ShouldNotReachHere(); return Bytecodes::_illegal;
+  }
+}
+
+static Bytecodes::Code fast_put_code(TosState tos_type) {
+  switch (tos_type) {
+    case atos: return Bytecodes::_fast_aputfield;
+    case btos: return Bytecodes::_fast_bputfield;
+    case ztos: return Bytecodes::_fast_zputfield;
+    case ctos: return Bytecodes::_fast_cputfield;
+    case dtos: return Bytecodes::_fast_dputfield;
+    case ftos: return Bytecodes::_fast_fputfield;
+    case itos: return Bytecodes::_fast_iputfield;
+    case ltos: return Bytecodes::_fast_lputfield;
+    case stos: return Bytecodes::_fast_sputfield;
+    default:   ShouldNotReachHere(); return Bytecodes::_illegal;
+  }
+}
+
 /*
  * BytecodeInterpreter::run(interpreterState istate)
  * BytecodeInterpreter::runWithChecks(interpreterState istate)
@@ -584,12 +630,12 @@ BytecodeInterpreter::run(interpreterState istate) {
 
 /* 0xC0 */ &&opc_checkcast,   &&opc_instanceof,     &&opc_monitorenter, &&opc_monitorexit,
 /* 0xC4 */ &&opc_wide,        &&opc_multianewarray, &&opc_ifnull,       &&opc_ifnonnull,
-/* 0xC8 */ &&opc_goto_w,      &&opc_jsr_w,          &&opc_breakpoint,   &&opc_default,
-/* 0xCC */ &&opc_default,     &&opc_default,        &&opc_default,      &&opc_default,
+/* 0xC8 */ &&opc_goto_w,      &&opc_jsr_w,          &&opc_breakpoint,   &&opc_fast_agetfield,
+/* 0xCC */ &&opc_fast_bgetfield,&&opc_fast_cgetfield, &&opc_fast_dgetfield, &&opc_fast_fgetfield,
 
-/* 0xD0 */ &&opc_default,     &&opc_default,        &&opc_default,      &&opc_default,
-/* 0xD4 */ &&opc_default,     &&opc_default,        &&opc_default,      &&opc_default,
-/* 0xD8 */ &&opc_default,     &&opc_default,        &&opc_default,      &&opc_default,
+/* 0xD0 */ &&opc_fast_igetfield,&&opc_fast_lgetfield, &&opc_fast_sgetfield, &&opc_fast_aputfield,
+/* 0xD4 */ &&opc_fast_bputfield,&&opc_fast_zputfield, &&opc_fast_cputfield, &&opc_fast_dputfield,
+/* 0xD8 */ &&opc_fast_fputfield,&&opc_fast_iputfield, &&opc_fast_lputfield, &&opc_fast_sputfield,
 /* 0xDC */ &&opc_default,     &&opc_default,        &&opc_default,      &&opc_default,
 
 /* 0xE0 */ &&opc_default,     &&opc_default,        &&opc_default,      &&opc_default,
@@ -2005,6 +2051,9 @@ run:
           } else {
             obj = (oop) STACK_OBJECT(-1);
             CHECK_NULL(obj);
+            if (!cache->is_volatile() && can_quicken_field_access()) {
+              REWRITE_AT_PC(fast_get_code(cache->flag_state()));
+            }
           }
 
           //
@@ -2120,6 +2169,9 @@ run:
             --count;
             obj = (oop) STACK_OBJECT(count);
             CHECK_NULL(obj);
+            if (!cache->is_volatile() && can_quicken_field_access()) {
+              REWRITE_AT_PC(fast_put_code(tos_type));
+            }
           }
 
           //
@@ -2176,6 +2228,104 @@ run:
           UPDATE_PC_AND_TOS_AND_CONTINUE(3, count);
         }
 
+      // Quickened getfield: the entry is resolved and the field is not
+      // volatile, so only the offset is needed.
+      CASE(_fast_agetfield):
+      CASE(_fast_bgetfield):
+      CASE(_fast_cgetfield):
+      CASE(_fast_dgetfield):
+      CASE(_fast_fgetfield):
+      CASE(_fast_igetfield):
+      CASE(_fast_lgetfield):
+      CASE(_fast_sgetfield): {
+        u2 index = Bytes::get_native_u2(pc+1);
+        ConstantPoolCacheEntry* cache = cp->entry_at(index);
+        int field_offset = cache->f2_as_index();
+        oop obj = (oop) STACK_OBJECT(-1);
+        CHECK_NULL(obj);
+        switch ((Bytecodes::Code)opcode) {
+          case Bytecodes::_fast_agetfield:
+            VERIFY_OOP(obj->obj_field(field_offset));
+            SET_STACK_OBJECT(obj->obj_field(field_offset), -1);
+            break;
+          case Bytecodes::_fast_bgetfield:
+            SET_STACK_INT(obj->byte_field(field_offset), -1);
+            break;
+          case Bytecodes::_fast_cgetfield:
+            SET_STACK_INT(obj->char_field(field_offset), -1);
+            break;
+          case Bytecodes::_fast_dgetfield:
+            SET_STACK_DOUBLE(obj->double_field(field_offset), 0);
+            MORE_STACK(1);
+            break;
+          case Bytecodes::_fast_fgetfield:
+            SET_STACK_FLOAT(obj->float_field(field_offset), -1);
+            break;
+          case Bytecodes::_fast_igetfield:
+            SET_STACK_INT(obj->int_field(field_offset), -1);
+            break;
+          case Bytecodes::_fast_lgetfield:
+            SET_STACK_LONG(obj->long_field(field_offset), 0);
+            MORE_STACK(1);
+            break;
+          default:
+            SET_STACK_INT(obj->short_field(field_offset), -1);
+            break;
+        }
+        UPDATE_PC_AND_CONTINUE(3);
+      }
+
+      // Quickened putfield, see above.
+      CASE(_fast_aputfield):
+      CASE(_fast_bputfield):
+      CASE(_fast_zputfield):
+      CASE(_fast_cputfield):
+      CASE(_fast_dputfield):
+      CASE(_fast_fputfield):
+      CASE(_fast_iputfield):
+      CASE(_fast_lputfield):
+      CASE(_fast_sputfield): {
+        u2 index = Bytes::get_native_u2(pc+1);
+        ConstantPoolCacheEntry* cache = cp->entry_at(index);
+        int field_offset = cache->f2_as_index();
+        bool two_slots = ((Bytecodes::Code)opcode == Bytecodes::_fast_dputfield ||
+                          (Bytecodes::Code)opcode == Bytecodes::_fast_lputfield);
+        int count = two_slots ? -3 : -2;
+        oop obj = (oop) STACK_OBJECT(count);
+        CHECK_NULL(obj);
+        switch ((Bytecodes::Code)opcode) {
+          case Bytecodes::_fast_aputfield:
+            VERIFY_OOP(STACK_OBJECT(-1));
+            obj->obj_field_put(field_offset, STACK_OBJECT(-1));
+            break;
+          case Bytecodes::_fast_bputfield:
+            obj->byte_field_put(field_offset, STACK_INT(-1));
+            break;
+          case Bytecodes::_fast_zputfield:
+            obj->byte_field_put(field_offset, (STACK_INT(-1) & 1));  // only store LSB
+            break;
+          case Bytecodes::_fast_cputfield:
+            obj->char_field_put(field_offset, STACK_INT(-1));
+            break;
+          case Bytecodes::_fast_dputfield:
+            obj->double_field_put(field_offset, STACK_DOUBLE(-1));
+            break;
+          case Bytecodes::_fast_fputfield:
+            obj->float_field_put(field_offset, STACK_FLOAT(-1));
+            break;
+          case Bytecodes::_fast_iputfield:
+            obj->int_field_put(field_offset, STACK_INT(-1));
+            break;
+          case Bytecodes::_fast_lputfield:
+            obj->long_field_put(field_offset, STACK_LONG(-1));
+            break;
+          default:
+            obj->short_field_put(field_offset, STACK_INT(-1));
+            break;
+        }
+        UPDATE_PC_AND_TOS_AND_CONTINUE(3, count);
+      }
+
       CASE(_new): {
         u2 index = Bytes::get_Java_u2(pc+1);
         ConstantPool* constants = istate->method()->constants();
@@ -286,6 +286,9 @@ class Bytecodes: AllStatic {
     // special handling of signature-polymorphic methods:
     _invokehandle         ,
 
+    // iinc followed by goto (added last to keep the numbering above):
+    _fast_iinc_goto       ,
+
     _shouldnotreachhere,      // For debugging
 
     // Platform specific JVM bytecodes
@@ -333,6 +333,7 @@ void Rewriter::maybe_rewrite_ldc(address bcp, int offset, bool is_wide,
 void Rewriter::scan_method(Method* method, bool reverse, bool* invokespecial_error) {
 
   int nof_jsrs = 0;
+  int nof_iinc_gotos = 0;
   bool has_monitor_bytecodes = false;
 
   {
@@ -391,6 +392,27 @@ void Rewriter::scan_method(Method* method, bool reverse, bool* invokespecial_err
           break;
         }
 
+        case Bytecodes::_iinc           : {
+#ifndef CC_INTERP
+          // Fuse an iinc with a directly following goto, the usual shape
+          // of a counted loop's back branch. The goto is left in place.
+          if (!reverse && RewriteFrequentPairs && !DumpSharedSpaces &&
+              prefix_length == 0 && bci + bc_length < code_length &&
+              bcp[bc_length] == Bytecodes::_goto &&
+              Bytecodes::is_defined(Bytecodes::_fast_iinc_goto)) {
+            (*bcp) = Bytecodes::_fast_iinc_goto;
+            nof_iinc_gotos++;
+          }
+#endif
+          break;
+        }
+        case Bytecodes::_fast_iinc_goto: {
+#ifndef CC_INTERP
+          (*bcp) = Bytecodes::_iinc;
+#endif
+          break;
+        }
+
         case Bytecodes::_invokespecial  : {
           rewrite_invokespecial(bcp, prefix_length+1, reverse, invokespecial_error);
           break;
@@ -458,6 +480,18 @@ void Rewriter::scan_method(Method* method, bool reverse, bool* invokespecial_err
         case Bytecodes::_monitorexit    : has_monitor_bytecodes = true; break;
       }
     }
+
+    // Rewriting jsrs may move code and widen a goto into a goto_w, which
+    // fast_iinc_goto does not expect; keep plain iincs in such methods.
+    if (nof_jsrs > 0 && nof_iinc_gotos > 0) {
+      for (int bci = 0; bci < code_length; bci += bc_length) {
+        address bcp = code_base + bci;
+        bc_length = Bytecodes::length_at(method, bcp);
+        if (*bcp == Bytecodes::_fast_iinc_goto) {
+          (*bcp) = Bytecodes::_iinc;
+        }
+      }
+    }
   }
 
   // Update access flags
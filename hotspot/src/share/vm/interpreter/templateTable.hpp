@@ -237,6 +237,9 @@ class TemplateTable: AllStatic {
 
   static void iinc();
   static void wide_iinc();
+#if defined(AMD64) || defined(AARCH64)
+  static void fast_iinc_goto();
+#endif
   static void convert();
   static void lcmp();
 
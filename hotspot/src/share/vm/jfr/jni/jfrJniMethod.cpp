@@ -44,6 +44,7 @@
 #include "jfr/instrumentation/jfrEventClassTransformer.hpp"
 #include "jfr/instrumentation/jfrJvmtiAgent.hpp"
 #include "jfr/leakprofiler/leakProfiler.hpp"
+#include "jfr/support/jfrEventThrottler.hpp"
 #include "jfr/utilities/jfrJavaLog.hpp"
 #include "jfr/utilities/jfrTimeConverter.hpp"
 #include "jfr/utilities/jfrTime.hpp"
@@ -177,6 +178,14 @@ NO_TRANSITION(jboolean, jfr_should_rotate_disk(JNIEnv* env, jobject jvm))
   return JfrChunkRotation::should_rotate() ? JNI_TRUE : JNI_FALSE;
 NO_TRANSITION_END
 
+NO_TRANSITION(jlong, jfr_get_flush_interval(JNIEnv* env, jobject jvm))
+  return JfrOptionSet::flush_interval();
+NO_TRANSITION_END
+
+NO_TRANSITION(jboolean, jfr_set_throttle(JNIEnv* env, jobject jvm, jlong event_type_id, jlong event_sample_size, jlong period_ms))
+  return JfrEventThrottler::set_throttle(event_type_id, event_sample_size, period_ms) ? JNI_TRUE : JNI_FALSE;
+NO_TRANSITION_END
+
 /*
  * JVM_ENTRY_NO_ENV entries
  *
@@ -243,6 +252,13 @@ JVM_ENTRY_NO_ENV(void, jfr_subscribe_log_level(JNIEnv* env, jobject jvm, jobject
  JfrJavaLog::subscribe_log_level(log_tag, id, thread);
 JVM_END
 
+JVM_ENTRY_NO_ENV(void, jfr_flush(JNIEnv* env, jobject jvm))
+  if (!JfrRecorder::is_recording()) {
+    return;
+  }
+  JfrRecorder::flush();
+JVM_END
+
 JVM_ENTRY_NO_ENV(void, jfr_set_output(JNIEnv* env, jobject jvm, jstring path))
   JfrRepository::set_chunk_path(path, thread);
 JVM_END
@@ -131,6 +131,12 @@ void JNICALL jfr_emit_old_object_samples(JNIEnv* env, jobject jvm, jlong cutoff_
 
 jboolean JNICALL jfr_should_rotate_disk(JNIEnv* env, jobject jvm);
 
+void JNICALL jfr_flush(JNIEnv* env, jobject jvm);
+
+jlong JNICALL jfr_get_flush_interval(JNIEnv* env, jobject jvm);
+
+jboolean JNICALL jfr_set_throttle(JNIEnv* env, jobject jvm, jlong event_type_id, jlong event_sample_size, jlong period_ms);
+
 
 #ifdef __cplusplus
 }
@@ -91,6 +91,27 @@ JfrJniMethodRegistration::JfrJniMethodRegistration(JNIEnv* env) {
       Thread::WXWriteFromExecSetter wx_write;
       if (true) tty->print_cr("RegisterNatives for JVM class failed!");
     }
+
+    // Streaming support, only registered if the class library declares it.
+    // Consumers call flush() to make the recorded events readable from the
+    // current chunk file; see JfrRecorderService::flush().
+    JNINativeMethod streaming_method[] = {
+      (char*)"flush", (char*)"()V", (void*)jfr_flush,
+      (char*)"getFlushInterval", (char*)"()J", (void*)jfr_get_flush_interval
+    };
+    const size_t streaming_method_array_length = sizeof(streaming_method) / sizeof(JNINativeMethod);
+    if (env->RegisterNatives(jfr_clz, streaming_method, (jint)streaming_method_array_length) != JNI_OK) {
+      env->ExceptionClear();
+    }
+
+    // Rate limiting of native events, see JfrEventThrottler.
+    JNINativeMethod throttle_method[] = {
+      (char*)"setThrottle", (char*)"(JJJ)Z", (void*)jfr_set_throttle
+    };
+    const size_t throttle_method_array_length = sizeof(throttle_method) / sizeof(JNINativeMethod);
+    if (env->RegisterNatives(jfr_clz, throttle_method, (jint)throttle_method_array_length) != JNI_OK) {
+      env->ExceptionClear();
+    }
     env->DeleteLocalRef(jfr_clz);
   }
 }
@@ -55,6 +55,11 @@ class BitSet : public CHeapObj<mtTracing> {
     return mark_obj((HeapWord*)obj);
   }
 
+  // returns true if this thread marked the object
+  bool par_mark_obj(oop obj) {
+    return _bits.par_set_bit(addr_to_bit((HeapWord*)obj));
+  }
+
   bool is_marked(const HeapWord* addr) const {
     return is_marked(addr_to_bit(addr));
   }
@@ -84,6 +84,17 @@ const Edge* EdgeQueue::element_at(size_t index) const {
   return (Edge*)_vmm->get(index);
 }
 
+void EdgeQueue::set_bottom(size_t index) {
+  assert(index >= _bottom_index, "invariant");
+  assert(index <= _top_index, "invariant");
+  _bottom_index = index;
+}
+
+size_t EdgeQueue::capacity() const {
+  assert(_vmm != NULL, "invariant");
+  return _vmm->reserved_size() / _vmm->aligned_datum_size_bytes();
+}
+
 size_t EdgeQueue::reserved_size() const {
   assert(_vmm != NULL, "invariant");
   return _vmm->reserved_size();
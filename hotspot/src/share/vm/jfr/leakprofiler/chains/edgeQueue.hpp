@@ -46,6 +46,7 @@ class EdgeQueue : public CHeapObj<mtTracing> {
   void add(const Edge* parent, const oop* ref);
   const Edge* remove() const;
   const Edge* element_at(size_t index) const;
+  void set_bottom(size_t index);
 
   size_t top() const;
   size_t bottom() const;
@@ -53,6 +54,7 @@ class EdgeQueue : public CHeapObj<mtTracing> {
   bool is_full() const;
 
   size_t reserved_size() const;
+  size_t capacity() const;
   size_t live_set() const;
   size_t sizeof_edge() const; // with alignments
 };
@@ -0,0 +1,305 @@
+/*
+* Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* This code is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License version 2 only, as
+* published by the Free Software Foundation.
+*
+* This code is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+* version 2 for more details (a copy is included in the LICENSE file that
+* accompanied this code).
+*
+* You should have received a copy of the GNU General Public License version
+* 2 along with this work; if not, write to the Free Software Foundation,
+* Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+*
+* Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+* or visit www.oracle.com if you need additional information or have any
+* questions.
+*
+*/
+
+#include "precompiled.hpp"
+#include "jfr/leakprofiler/chains/bitset.hpp"
+#include "jfr/leakprofiler/chains/dfsClosure.hpp"
+#include "jfr/leakprofiler/chains/edge.hpp"
+#include "jfr/leakprofiler/chains/edgeQueue.hpp"
+#include "jfr/leakprofiler/chains/edgeStore.hpp"
+#include "jfr/leakprofiler/chains/parallelBfs.hpp"
+#include "jfr/leakprofiler/utilities/granularTimer.hpp"
+#include "jfr/leakprofiler/utilities/unifiedOop.hpp"
+#include "memory/iterator.inline.hpp"
+#include "oops/oop.inline.hpp"
+#include "runtime/atomic.inline.hpp"
+#include "utilities/align.hpp"
+#include "utilities/growableArray.hpp"
+#include "utilities/workgroup.hpp"
+
+// frontier edges claimed at a time by a worker
+static const size_t claim_size = 64;
+// queue slots reserved at a time by a worker
+static const size_t reserve_size = 1024;
+// smaller frontiers are not worth starting the workers for
+static const size_t min_parallel_frontier = 4 * K;
+// frontier edges iterated by a worker between checks of the time budget
+static const size_t timer_granularity = 256;
+
+// The edges a worker discovered while processing the current frontier
+class ParallelBFSWorker : public CHeapObj<mtTracing> {
+ private:
+  GrowableArray<Edge>* _edges;
+  GrowableArray<Edge>* _leaks;
+  GrowableArray<const Edge*>* _overflow;
+  size_t _reserved;
+ public:
+  ParallelBFSWorker() :
+    _edges(new (ResourceObj::C_HEAP, mtTracing) GrowableArray<Edge>(reserve_size, true, mtTracing)),
+    _leaks(new (ResourceObj::C_HEAP, mtTracing) GrowableArray<Edge>(16, true, mtTracing)),
+    _overflow(new (ResourceObj::C_HEAP, mtTracing) GrowableArray<const Edge*>(16, true, mtTracing)),
+    _reserved(0) {}
+
+  ~ParallelBFSWorker() {
+    delete _edges;
+    delete _leaks;
+    delete _overflow;
+  }
+
+  GrowableArray<Edge>* edges() const { return _edges; }
+  GrowableArray<Edge>* leaks() const { return _leaks; }
+  GrowableArray<const Edge*>* overflow() const { return _overflow; }
+
+  bool has_reserved() const { return _reserved > 0; }
+  void set_reserved(size_t count) { _reserved = count; }
+
+  void add_edge(const Edge* parent, const oop* reference) {
+    assert(_reserved > 0, "invariant");
+    --_reserved;
+    _edges->append(Edge(parent, reference));
+  }
+
+  void add_overflow(const Edge* parent) {
+    if (_overflow->is_empty() || _overflow->top() != parent) {
+      _overflow->append(parent);
+    }
+  }
+
+  void clear() {
+    _edges->clear();
+    _leaks->clear();
+    _overflow->clear();
+    _reserved = 0;
+  }
+};
+
+class ParallelBFSClosure : public ExtendedOopClosure {
+ private:
+  ParallelBFS* const _bfs;
+  ParallelBFSWorker* const _worker;
+  const Edge* _current_parent;
+
+  void closure_impl(const oop* reference, const oop pointee) {
+    assert(reference != NULL, "invariant");
+    assert(UnifiedOop::dereference(reference) == pointee, "invariant");
+    if (!_worker->has_reserved()) {
+      if (!_bfs->reserve(reserve_size)) {
+        // leave the pointee unmarked for the depth-first search
+        if (!_bfs->_mark_bits->is_marked(pointee)) {
+          _worker->add_overflow(_current_parent);
+        }
+        return;
+      }
+      _worker->set_reserved(reserve_size);
+    }
+    if (!_bfs->_mark_bits->par_mark_obj(pointee)) {
+      return;
+    }
+    // is the pointee a sample object?
+    if (NULL == pointee->mark()) {
+      _worker->leaks()->append(Edge(_current_parent, reference));
+    }
+    _worker->add_edge(_current_parent, reference);
+  }
+
+ public:
+  ParallelBFSClosure(ParallelBFS* bfs, ParallelBFSWorker* worker) :
+    _bfs(bfs), _worker(worker), _current_parent(NULL) {}
+
+  void iterate(const Edge* parent) {
+    assert(parent != NULL, "invariant");
+    const oop pointee = parent->pointee();
+    assert(pointee != NULL, "invariant");
+    _current_parent = parent;
+    pointee->oop_iterate(this);
+  }
+
+  virtual void do_oop(oop* ref) {
+    assert(ref != NULL, "invariant");
+    assert(is_aligned(ref, HeapWordSize), "invariant");
+    const oop pointee = *ref;
+    if (pointee != NULL) {
+      closure_impl(ref, pointee);
+    }
+  }
+
+  virtual void do_oop(narrowOop* ref) {
+    assert(ref != NULL, "invariant");
+    assert(is_aligned(ref, sizeof(narrowOop)), "invariant");
+    const oop pointee = oopDesc::load_decode_heap_oop(ref);
+    if (pointee != NULL) {
+      closure_impl(UnifiedOop::encode(ref), pointee);
+    }
+  }
+};
+
+class ParallelBFSTask : public AbstractGangTask {
+ private:
+  ParallelBFS* const _bfs;
+ public:
+  ParallelBFSTask(ParallelBFS* bfs) : AbstractGangTask("Leak Profiler BFS"), _bfs(bfs) {}
+
+  void work(uint worker_id) {
+    _bfs->work(worker_id);
+  }
+};
+
+ParallelBFS::ParallelBFS(EdgeQueue* edge_queue, EdgeStore* edge_store, BitSet* mark_bits, FlexibleWorkGang* workers) :
+  _edge_queue(edge_queue),
+  _edge_store(edge_store),
+  _mark_bits(mark_bits),
+  _workers(workers),
+  _worker_state(NULL),
+  _nof_workers(MAX2(workers->total_workers(), 1U)),
+  _frontier_level(0),
+  _frontier_end(0),
+  _claimed(0),
+  _reserved(0),
+  _reservation_limit(0),
+  _expired(false) {
+  _worker_state = NEW_C_HEAP_ARRAY(ParallelBFSWorker*, _nof_workers, mtTracing);
+  for (uint i = 0; i < _nof_workers; ++i) {
+    _worker_state[i] = new ParallelBFSWorker();
+  }
+}
+
+ParallelBFS::~ParallelBFS() {
+  for (uint i = 0; i < _nof_workers; ++i) {
+    delete _worker_state[i];
+  }
+  FREE_C_HEAP_ARRAY(ParallelBFSWorker*, _worker_state, mtTracing);
+}
+
+void ParallelBFS::process() {
+  process_root_set();
+  while (!_expired && !_edge_queue->is_empty()) {
+    process_frontier();
+    if (!complete_frontier()) {
+      dfs_fallback();
+      return;
+    }
+    if (LogJFR && Verbose) tty->print_cr("Parallel BFS front: " SIZE_FORMAT " edges: " SIZE_FORMAT,
+                                         _frontier_level, _edge_queue->top() - _edge_queue->bottom());
+    ++_frontier_level;
+  }
+}
+
+void ParallelBFS::process_root_set() {
+  for (size_t idx = _edge_queue->bottom(); idx < _edge_queue->top(); ++idx) {
+    const Edge* edge = _edge_queue->element_at(idx);
+    assert(edge->parent() == NULL, "invariant");
+    const oop pointee = edge->pointee();
+    if (!_mark_bits->is_marked(pointee)) {
+      _mark_bits->mark_obj(pointee);
+      // is the pointee a sample object?
+      if (NULL == pointee->mark()) {
+        _edge_store->put_chain(edge, 1);
+      }
+    }
+  }
+}
+
+void ParallelBFS::process_frontier() {
+  assert(!_edge_queue->is_empty(), "invariant");
+  _frontier_end = _edge_queue->top();
+  _claimed = (intptr_t)_edge_queue->bottom();
+  _reserved = 0;
+  _reservation_limit = (intptr_t)(_edge_queue->capacity() - _edge_queue->top());
+  for (uint i = 0; i < _nof_workers; ++i) {
+    _worker_state[i]->clear();
+  }
+  if (_frontier_end - _edge_queue->bottom() < min_parallel_frontier) {
+    work(0);
+  } else {
+    ParallelBFSTask task(this);
+    _workers->run_task(&task);
+  }
+}
+
+// Appends the discovered edges to the queue and stores the chains
+// of the sample objects found, returns false if the queue overflowed.
+bool ParallelBFS::complete_frontier() {
+  bool overflow = false;
+  _edge_queue->set_bottom(_frontier_end);
+  for (uint i = 0; i < _nof_workers; ++i) {
+    ParallelBFSWorker* const worker = _worker_state[i];
+    const GrowableArray<Edge>* const leaks = worker->leaks();
+    for (int j = 0; j < leaks->length(); ++j) {
+      const Edge leak_edge = leaks->at(j);
+      _edge_store->put_chain(&leak_edge, _frontier_level + 2);
+    }
+    const GrowableArray<Edge>* const edges = worker->edges();
+    for (int j = 0; j < edges->length(); ++j) {
+      assert(!_edge_queue->is_full(), "invariant");
+      const Edge& edge = edges->at(j);
+      _edge_queue->add(edge.parent(), edge.reference());
+    }
+    overflow |= !worker->overflow()->is_empty();
+  }
+  return !overflow;
+}
+
+void ParallelBFS::dfs_fallback() {
+  if (LogJFR && Verbose) tty->print_cr("Parallel BFS front: " SIZE_FORMAT " filled edge queue", _frontier_level);
+  for (uint i = 0; i < _nof_workers; ++i) {
+    const GrowableArray<const Edge*>* const overflow = _worker_state[i]->overflow();
+    for (int j = 0; j < overflow->length(); ++j) {
+      DFSClosure::find_leaks_from_edge(_edge_store, _mark_bits, overflow->at(j));
+    }
+  }
+  while (!_edge_queue->is_empty()) {
+    const Edge* edge = _edge_queue->remove();
+    if (edge->pointee() != NULL) {
+      DFSClosure::find_leaks_from_edge(_edge_store, _mark_bits, edge);
+    }
+  }
+}
+
+void ParallelBFS::work(uint worker_id) {
+  assert(worker_id < _nof_workers, "invariant");
+  ParallelBFSClosure closure(this, _worker_state[worker_id]);
+  size_t iterated = 0;
+  while (true) {
+    const size_t start = (size_t)(Atomic::add_ptr((intptr_t)claim_size, &_claimed) - (intptr_t)claim_size);
+    if (start >= _frontier_end) {
+      return;
+    }
+    const size_t end = MIN2(start + claim_size, _frontier_end);
+    for (size_t idx = start; idx < end; ++idx) {
+      if (++iterated % timer_granularity == 0 && (_expired || GranularTimer::is_expired())) {
+        _expired = true;
+        return;
+      }
+      closure.iterate(_edge_queue->element_at(idx));
+    }
+  }
+}
+
+bool ParallelBFS::reserve(size_t count) {
+  if (_reserved >= _reservation_limit) {
+    return false;
+  }
+  const intptr_t reserved = Atomic::add_ptr((intptr_t)count, &_reserved);
+  return reserved <= _reservation_limit;
+}
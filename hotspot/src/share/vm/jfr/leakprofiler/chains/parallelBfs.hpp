@@ -0,0 +1,77 @@
+/*
+* Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* This code is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License version 2 only, as
+* published by the Free Software Foundation.
+*
+* This code is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+* version 2 for more details (a copy is included in the LICENSE file that
+* accompanied this code).
+*
+* You should have received a copy of the GNU General Public License version
+* 2 along with this work; if not, write to the Free Software Foundation,
+* Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+*
+* Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+* or visit www.oracle.com if you need additional information or have any
+* questions.
+*
+*/
+
+#ifndef SHARE_VM_JFR_LEAKPROFILER_CHAINS_PARALLELBFS_HPP
+#define SHARE_VM_JFR_LEAKPROFILER_CHAINS_PARALLELBFS_HPP
+
+#include "memory/allocation.hpp"
+
+class BitSet;
+class EdgeQueue;
+class EdgeStore;
+class FlexibleWorkGang;
+class ParallelBFSWorker;
+
+// Class responsible for iterating the heap breadth-first on a worker gang,
+// one frontier at a time.
+//
+// The workers claim chunks of the current frontier from the edge queue and
+// claim the objects they reach by marking them in parallel. The edges they
+// discover are kept per worker and appended to the queue once the frontier
+// is done, so the edge queue and the edge store are only updated by the
+// calling thread. Queue slots are reserved up front: a worker that cannot
+// reserve any leaves the remaining references of its parent to a final
+// depth-first search, as BFSClosure does when the queue fills up.
+class ParallelBFS : public StackObj {
+  friend class ParallelBFSClosure;
+  friend class ParallelBFSTask;
+ private:
+  EdgeQueue* _edge_queue;
+  EdgeStore* _edge_store;
+  BitSet* _mark_bits;
+  FlexibleWorkGang* _workers;
+  ParallelBFSWorker** _worker_state;
+  uint _nof_workers;
+  size_t _frontier_level;
+  size_t _frontier_end;
+  volatile intptr_t _claimed;
+  volatile intptr_t _reserved;
+  intptr_t _reservation_limit;
+  volatile bool _expired;
+
+  void process_root_set();
+  void process_frontier();
+  bool complete_frontier();
+  void dfs_fallback();
+
+  void work(uint worker_id);
+  bool reserve(size_t count);
+
+ public:
+  ParallelBFS(EdgeQueue* edge_queue, EdgeStore* edge_store, BitSet* mark_bits, FlexibleWorkGang* workers);
+  ~ParallelBFS();
+  void process();
+};
+
+#endif // SHARE_VM_JFR_LEAKPROFILER_CHAINS_PARALLELBFS_HPP
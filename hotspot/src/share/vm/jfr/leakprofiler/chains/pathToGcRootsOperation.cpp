@@ -35,6 +35,7 @@
 #include "jfr/leakprofiler/chains/rootSetClosure.hpp"
 #include "jfr/leakprofiler/chains/edgeStore.hpp"
 #include "jfr/leakprofiler/chains/objectSampleMarker.hpp"
+#include "jfr/leakprofiler/chains/parallelBfs.hpp"
 #include "jfr/leakprofiler/chains/pathToGcRootsOperation.hpp"
 #include "jfr/leakprofiler/checkpoint/eventEmitter.hpp"
 #include "jfr/leakprofiler/checkpoint/objectSampleCheckpoint.hpp"
@@ -46,6 +47,7 @@
 #include "oops/oop.inline.hpp"
 #include "runtime/safepoint.hpp"
 #include "utilities/globalDefinitions.hpp"
+#include "utilities/workgroup.hpp"
 
 PathToGcRootsOperation::PathToGcRootsOperation(ObjectSampler* sampler, EdgeStore* edge_store, int64_t cutoff, bool emit_all) :
   _sampler(sampler),_edge_store(edge_store), _cutoff_ticks(cutoff), _emit_all(emit_all) {}
@@ -120,7 +122,14 @@ void PathToGcRootsOperation::doit() {
     // to avoid walking sideways over roots
     DFSClosure::find_leaks_from_root_set(_edge_store, &mark_bits);
   } else {
-    bfs.process();
+    // The workers of the heap can be borrowed at this safepoint
+    FlexibleWorkGang* const workers = Universe::heap()->get_safepoint_workers();
+    if (workers != NULL && workers->active_workers() > 1) {
+      ParallelBFS parallel_bfs(&edge_queue, _edge_store, &mark_bits, workers);
+      parallel_bfs.process();
+    } else {
+      bfs.process();
+    }
   }
   GranularTimer::stop();
   log_edge_queue_summary(edge_queue);
@@ -55,6 +55,12 @@ const JfrTicks& GranularTimer::end_time() {
   return _finish_time_ticks;
 }
 
+// Can be called by several threads, the granularity is up to the caller
+bool GranularTimer::is_expired() {
+  assert(_granularity != 0, "GranularTimer::is_expired must be called after GranularTimer::start");
+  return _finished || JfrTicks::now() > _finish_time_ticks;
+}
+
 bool GranularTimer::is_finished() {
   assert(_granularity != 0, "GranularTimer::is_finished must be called after GranularTimer::start");
   if (--_counter == 0) {
@@ -420,6 +420,37 @@ TRACE_REQUEST_FUNC(ThreadAllocationStatistics) {
   }
 }
 
+TRACE_REQUEST_FUNC(ThreadResourceUsage) {
+  ResourceMark rm;
+  ThreadUsageSnapshot snapshot;
+  GrowableArray<traceid> thread_ids(Threads::number_of_threads());
+  JfrTicks time_stamp = JfrTicks::now();
+  {
+    // Collect the usage of all threads in one pass while holding threads lock
+    MutexLockerEx ml(Threads_lock);
+    snapshot.collect();
+    for (int i = 0; i < snapshot.length(); i++) {
+      thread_ids.append(JFR_THREAD_ID(snapshot.at(i)->_thread));
+    }
+  }
+  // Write the usage to buffer.
+  for (int i = 0; i < snapshot.length(); i++) {
+    const ThreadUsage* usage = snapshot.at(i);
+    EventThreadResourceUsage event(UNTIMED);
+    event.set_thread(thread_ids.at(i));
+    event.set_cpuTime(usage->_cpu_time);
+    event.set_userTime(usage->_user_time);
+    event.set_allocated(usage->_allocated_bytes);
+    event.set_blockedCount(usage->_blocked_count);
+    event.set_blockedTime(usage->_blocked_time);
+    event.set_waitedCount(usage->_waited_count);
+    event.set_waitedTime(usage->_waited_time);
+    event.set_safepointTime(usage->_safepoint_time);
+    event.set_endtime(time_stamp);
+    event.commit();
+  }
+}
+
 /**
  *  PhysicalMemory event represents:
  *
@@ -556,6 +587,36 @@ TRACE_REQUEST_FUNC(CompilerStatistics) {
   event.commit();
 }
 
+TRACE_REQUEST_FUNC(CompileQueueStatistics) {
+  for (int level = CompLevel_simple; level <= CompLevel_full_optimization; level++) {
+    CompileQueue* queue = CompileBroker::compile_queue(level);
+    if (queue == NULL) {
+      continue;
+    }
+    int queued;
+    jlong count;
+    Tickspan total, peak;
+    {
+      MutexLocker ml(queue->lock());
+      queued = queue->queued_count(level);
+      count = queue->wait_count(level);
+      total = queue->total_wait_time(level);
+      peak = queue->peak_wait_time(level);
+    }
+    if (queued == 0 && count == 0) {
+      // Level not used in this configuration
+      continue;
+    }
+    EventCompileQueueStatistics event;
+    event.set_compileLevel((u2)level);
+    event.set_queueSize(queued);
+    event.set_dequeuedCount(count);
+    event.set_totalWaitTime(total);
+    event.set_peakWaitTime(peak);
+    event.commit();
+  }
+}
+
 TRACE_REQUEST_FUNC(CompilerConfiguration) {
   EventCompilerConfiguration event;
   event.set_threadCount(CICompilerCount);
@@ -564,25 +625,67 @@ TRACE_REQUEST_FUNC(CompilerConfiguration) {
 }
 
 TRACE_REQUEST_FUNC(CodeCacheStatistics) {
-  EventCodeCacheStatistics event;
-  event.set_codeBlobType((u1)0/*bt*/); // XXX
-  event.set_startAddress((u8)CodeCache::low_bound());
-  event.set_reservedTopAddress((u8)CodeCache::high_bound());
-  event.set_entryCount(CodeCache::nof_blobs());
-  event.set_methodCount(CodeCache::nof_nmethods());
-  event.set_adaptorCount(CodeCache::nof_adapters());
-  event.set_unallocatedCapacity(CodeCache::unallocated_capacity());
-  event.set_fullCount(CodeCache::get_codemem_full_count());
-  event.commit();
+  // One event for each code heap with SegmentedCodeCache, otherwise one for
+  // the single heap of type All. The blob counts are for the whole code cache.
+  for (int bt = 0; bt < CodeBlobType::NumTypes; ++bt) {
+    if ((bt == CodeBlobType::All) == SegmentedCodeCache) {
+      continue;
+    }
+    CodeHeap* heap = CodeCache::get_code_heap_for_type(bt);
+    if (heap == NULL) {
+      continue;
+    }
+    EventCodeCacheStatistics event;
+    event.set_codeBlobType((u1)bt);
+    event.set_startAddress((u8)heap->low_boundary());
+    event.set_reservedTopAddress((u8)heap->high_boundary());
+    event.set_entryCount(CodeCache::nof_blobs());
+    event.set_methodCount(CodeCache::nof_nmethods());
+    event.set_adaptorCount(CodeCache::nof_adapters());
+    event.set_unallocatedCapacity(heap->unallocated_capacity());
+    event.set_fullCount(CodeCache::get_codemem_full_count());
+    event.commit();
+  }
+}
+
+static u8 code_heap_size(int code_blob_type) {
+  CodeHeap* heap = SegmentedCodeCache ? CodeCache::get_code_heap_for_type(code_blob_type) : NULL;
+  return heap != NULL ? (u8)heap->max_capacity() : 0;
+}
+
+TRACE_REQUEST_FUNC(CodeCacheFragmentation) {
+  for (int bt = 0; bt < CodeBlobType::NumTypes; ++bt) {
+    if ((bt == CodeBlobType::All) == SegmentedCodeCache) {
+      continue;
+    }
+    CodeHeap* heap = CodeCache::get_code_heap_for_type(bt);
+    if (heap == NULL) {
+      continue;
+    }
+    size_t free_blocks, largest_free, free_size, tail;
+    {
+      MutexLockerEx ml(CodeCache_lock, Mutex::_no_safepoint_check_flag);
+      heap->freelist_statistics(&free_blocks, &largest_free);
+      free_size = heap->freelist_capacity();
+      tail = heap->unallocated_capacity() - free_size;
+    }
+    EventCodeCacheFragmentation event;
+    event.set_codeBlobType((u1)bt);
+    event.set_freeBlockCount(free_blocks);
+    event.set_freeBlockSize(free_size);
+    event.set_largestFreeBlock(largest_free);
+    event.set_unallocatedTail(tail);
+    event.commit();
+  }
 }
 
 TRACE_REQUEST_FUNC(CodeCacheConfiguration) {
   EventCodeCacheConfiguration event;
   event.set_initialSize(InitialCodeCacheSize);
   event.set_reservedSize(ReservedCodeCacheSize);
-  event.set_nonNMethodSize(0/*NonNMethodCodeHeapSize*/); // XXX
-  event.set_profiledSize(0/*ProfiledCodeHeapSize*/); // XXX
-  event.set_nonProfiledSize(0/*NonProfiledCodeHeapSize*/); // XXX
+  event.set_nonNMethodSize(code_heap_size(CodeBlobType::NonNMethod));
+  event.set_profiledSize(code_heap_size(CodeBlobType::MethodProfiled));
+  event.set_nonProfiledSize(code_heap_size(CodeBlobType::MethodNonProfiled));
   event.set_expansionSize(CodeCacheExpansionSize);
   event.set_minBlockLength(CodeCacheMinBlockLength);
   event.set_startAddress((u8)CodeCache::low_bound());
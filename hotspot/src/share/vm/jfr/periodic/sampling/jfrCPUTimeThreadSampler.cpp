@@ -0,0 +1,265 @@
+/*
+* Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* This code is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License version 2 only, as
+* published by the Free Software Foundation.
+*
+* This code is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+* version 2 for more details (a copy is included in the LICENSE file that
+* accompanied this code).
+*
+* You should have received a copy of the GNU General Public License version
+* 2 along with this work; if not, write to the Free Software Foundation,
+* Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+*
+* Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+* or visit www.oracle.com if you need additional information or have any
+* questions.
+*
+*/
+
+#include "precompiled.hpp"
+#include "classfile/javaClasses.hpp"
+#include "jfr/jfrEvents.hpp"
+#include "jfr/periodic/sampling/jfrCallTrace.hpp"
+#include "jfr/periodic/sampling/jfrCPUTimeThreadSampler.hpp"
+#include "jfr/recorder/checkpoint/types/traceid/jfrTraceIdEpoch.hpp"
+#include "jfr/recorder/service/jfrOptionSet.hpp"
+#include "jfr/recorder/stacktrace/jfrStackTraceRepository.hpp"
+#include "jfr/support/jfrThreadId.hpp"
+#include "jfr/support/jfrThreadLocal.hpp"
+#include "jfr/utilities/jfrTime.hpp"
+#include "runtime/frame.inline.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/orderAccess.inline.hpp"
+#include "runtime/os.hpp"
+#include "runtime/thread.inline.hpp"
+
+// The thread sampler drains the buffers at this interval. Each buffer
+// holds the samples of a thread for a little more than one interval when
+// its CPU timer fires every millisecond.
+static const size_t drain_interval_ms = 10;
+static const juint samples_per_thread = 16;
+
+//
+// Single producer, single consumer ring of stack traces. The producer is
+// the signal handler on the owning thread, the consumer is the thread
+// sampler. Frames hold trace ids and line numbers and no Method*, a sample
+// stays valid across class unloading; it is dropped if the trace id epoch
+// has changed by the time it is drained.
+//
+class JfrCPUTimeSampleBuffer : public JfrCHeapObj {
+ private:
+  struct Sample {
+    JfrTicks _ticks;
+    u4 _nr_of_frames;
+    unsigned int _hash;
+    bool _reached_root;
+    u1 _epoch;
+  };
+  Sample _samples[samples_per_thread];
+  JfrStackFrame* const _frames;
+  const u4 _max_frames;
+  volatile juint _head;
+  volatile juint _tail;
+
+  JfrStackFrame* frames_at(juint index) const {
+    return _frames + (index % samples_per_thread) * _max_frames;
+  }
+
+ public:
+  JfrCPUTimeSampleBuffer(u4 max_frames) :
+    _frames(NEW_C_HEAP_ARRAY(JfrStackFrame, samples_per_thread * max_frames, mtTracing)),
+    _max_frames(max_frames),
+    _head(0),
+    _tail(0) {}
+
+  ~JfrCPUTimeSampleBuffer() {
+    FREE_C_HEAP_ARRAY(JfrStackFrame, _frames, mtTracing);
+  }
+
+  // by the consumer, drops the samples not yet drained
+  void discard() {
+    OrderAccess::release_store(&_tail, OrderAccess::load_acquire(&_head));
+  }
+
+  void record(JavaThread* jt, void* ucontext, bool in_java);
+  uint drain(JavaThread* jt, EventExecutionSample* events, uint max_events);
+};
+
+// In signal context
+void JfrCPUTimeSampleBuffer::record(JavaThread* jt, void* ucontext, bool in_java) {
+  const juint head = _head;
+  if (head - OrderAccess::load_acquire(&_tail) >= samples_per_thread) {
+    // full, not drained in time
+    return;
+  }
+  const JfrTicks now = JfrTicks::now();
+  JfrGetCallTrace trace(in_java, jt);
+  frame topframe;
+  if (!trace.get_topframe(ucontext, topframe)) {
+    return;
+  }
+  JfrStackTrace stacktrace(frames_at(head), _max_frames);
+  if (!stacktrace.record_thread(*jt, topframe)) {
+    return;
+  }
+  Sample& sample = _samples[head % samples_per_thread];
+  sample._ticks = now;
+  sample._nr_of_frames = stacktrace._nr_of_frames;
+  sample._hash = stacktrace._hash;
+  sample._reached_root = stacktrace._reached_root;
+  sample._epoch = JfrTraceIdEpoch::epoch();
+  OrderAccess::release_store(&_head, head + 1);
+}
+
+uint JfrCPUTimeSampleBuffer::drain(JavaThread* jt, EventExecutionSample* events, uint max_events) {
+  assert(Threads_lock->owned_by_self(), "invariant");
+  const juint head = OrderAccess::load_acquire(&_head);
+  juint tail = _tail;
+  uint count = 0;
+  for (; tail != head && count < max_events; ++tail) {
+    const Sample& sample = _samples[tail % samples_per_thread];
+    if (sample._epoch != JfrTraceIdEpoch::epoch()) {
+      // the methods were tagged for a chunk already written
+      continue;
+    }
+    JfrStackTrace stacktrace(frames_at(tail), _max_frames);
+    stacktrace._nr_of_frames = sample._nr_of_frames;
+    stacktrace._hash = sample._hash;
+    stacktrace._reached_root = sample._reached_root;
+    stacktrace._lineno = true;
+    const traceid id = JfrStackTraceRepository::add(stacktrace);
+    if (id == 0) {
+      continue;
+    }
+    EventExecutionSample* const event = &events[count++];
+    event->set_starttime(sample._ticks);
+    event->set_endtime(sample._ticks);
+    event->set_sampledThread(JFR_THREAD_ID(jt));
+    event->set_state(java_lang_Thread::get_thread_status(jt->threadObj()));
+    event->set_stackTrace(id);
+  }
+  OrderAccess::release_store(&_tail, tail);
+  return count;
+}
+
+// Serializes arming and disarming timers with draining and thread exit.
+static Mutex* const timer_lock = new Mutex(Mutex::leaf, "JFR CPU time sampler", true);
+static volatile jlong interval_nanos = 0;
+
+static void sample_current_thread(Thread* thread, void* ucontext) {
+  if (!thread->is_Java_thread()) {
+    return;
+  }
+  JavaThread* const jt = (JavaThread*)thread;
+  JfrCPUTimeSampleBuffer* const buffer = jt->jfr_thread_local()->cpu_time_samples();
+  if (buffer == NULL || jt->is_exiting() || jt->in_deopt_handler()) {
+    return;
+  }
+  // like the suspending sampler, skip threads in transition
+  // or in the VM, whose stacks may be in flux
+  switch (jt->thread_state()) {
+    case _thread_in_Java:
+      buffer->record(jt, ucontext, true);
+      break;
+    case _thread_in_native:
+      buffer->record(jt, ucontext, false);
+      break;
+    default:
+      break;
+  }
+}
+
+static void arm(JavaThread* jt, jlong interval) {
+  assert(timer_lock->owned_by_self(), "invariant");
+  os::delete_thread_cpu_timer(jt);
+  JfrThreadLocal* const tl = jt->jfr_thread_local();
+  if (tl->cpu_time_samples() != NULL) {
+    // samples left over from an earlier interval may be from an older
+    // trace id epoch that the current one no longer tells apart
+    tl->cpu_time_samples()->discard();
+  }
+  if (interval == 0 || jt->is_hidden_from_external_view() || jt->is_Compiler_thread()) {
+    return;
+  }
+  if (tl->cpu_time_samples() == NULL) {
+    tl->set_cpu_time_samples(new JfrCPUTimeSampleBuffer(JfrOptionSet::stackdepth()));
+  }
+  if (!os::create_thread_cpu_timer(jt, interval)) {
+    if (LogJFR && Verbose) tty->print_cr("Failed to create CPU time timer for thread");
+  }
+}
+
+bool JfrCPUTimeThreadSampling::set_interval(size_t period_millis) {
+  if (period_millis > 0 && !os::init_thread_cpu_timers(&sample_current_thread)) {
+    return false;
+  }
+  const jlong interval = (jlong)period_millis * NANOSECS_PER_MILLISEC;
+  MutexLocker tlock(Threads_lock);
+  MutexLockerEx lock(timer_lock, Mutex::_no_safepoint_check_flag);
+  if (interval == interval_nanos) {
+    return true;
+  }
+  interval_nanos = interval;
+  for (JavaThread* jt = Threads::first(); jt != NULL; jt = jt->next()) {
+    arm(jt, interval);
+  }
+  if (LogJFR) tty->print_cr("CPU time sampling interval " SIZE_FORMAT " ms", period_millis);
+  return true;
+}
+
+bool JfrCPUTimeThreadSampling::is_active() {
+  return interval_nanos > 0;
+}
+
+size_t JfrCPUTimeThreadSampling::drain_interval_millis() {
+  return drain_interval_ms;
+}
+
+void JfrCPUTimeThreadSampling::drain() {
+  static const uint max_events = 64;
+  EventExecutionSample events[max_events];
+  uint count;
+  do {
+    count = 0;
+    {
+      MonitorLockerEx tlock(Threads_lock, Mutex::_allow_vm_block_flag);
+      MutexLockerEx lock(timer_lock, Mutex::_no_safepoint_check_flag);
+      for (JavaThread* jt = Threads::first(); jt != NULL && count < max_events; jt = jt->next()) {
+        JfrCPUTimeSampleBuffer* const buffer = jt->jfr_thread_local()->cpu_time_samples();
+        if (buffer != NULL) {
+          count += buffer->drain(jt, &events[count], max_events - count);
+        }
+      }
+    }
+    for (uint i = 0; i < count; ++i) {
+      events[i].commit();
+    }
+  } while (count == max_events);
+}
+
+void JfrCPUTimeThreadSampling::on_javathread_start(JavaThread* jt) {
+  assert(jt == Thread::current(), "invariant");
+  if (is_active()) {
+    MutexLockerEx lock(timer_lock, Mutex::_no_safepoint_check_flag);
+    arm(jt, interval_nanos);
+  }
+}
+
+void JfrCPUTimeThreadSampling::on_javathread_exit(JavaThread* jt) {
+  JfrThreadLocal* const tl = jt->jfr_thread_local();
+  MutexLockerEx lock(timer_lock, Mutex::_no_safepoint_check_flag);
+  JfrCPUTimeSampleBuffer* const buffer = tl->cpu_time_samples();
+  if (buffer == NULL) {
+    return;
+  }
+  os::delete_thread_cpu_timer(jt);
+  // a signal still pending for this thread sees no buffer
+  tl->set_cpu_time_samples(NULL);
+  delete buffer;
+}
@@ -0,0 +1,59 @@
+/*
+* Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* This code is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License version 2 only, as
+* published by the Free Software Foundation.
+*
+* This code is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+* version 2 for more details (a copy is included in the LICENSE file that
+* accompanied this code).
+*
+* You should have received a copy of the GNU General Public License version
+* 2 along with this work; if not, write to the Free Software Foundation,
+* Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+*
+* Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+* or visit www.oracle.com if you need additional information or have any
+* questions.
+*
+*/
+
+#ifndef SHARE_VM_JFR_PERIODIC_SAMPLING_JFRCPUTIMETHREADSAMPLER_HPP
+#define SHARE_VM_JFR_PERIODIC_SAMPLING_JFRCPUTIMETHREADSAMPLER_HPP
+
+#include "memory/allocation.hpp"
+
+class JavaThread;
+
+//
+// Execution sampling driven by per-thread CPU time timers
+// (FlightRecorderOptions=cpu-time-sampling=true).
+//
+// Each Java thread has a timer that signals it after every sampling
+// interval of CPU time it has used. The signal handler records the stack
+// trace of the interrupted thread, resolving methods to trace ids and
+// line numbers, into a small per-thread buffer. The thread sampler drains
+// the buffers and commits the ExecutionSample events. Threads are sampled
+// in proportion to the CPU they use, without suspending them and at any
+// point in Java or native code, not only where they happen to be when the
+// sampler comes around.
+//
+class JfrCPUTimeThreadSampling : AllStatic {
+ public:
+  // arms the timers of all Java threads, or disarms them with 0; returns
+  // false if CPU time timers are not available on this platform
+  static bool set_interval(size_t period_millis);
+  static bool is_active();
+  // called by the thread sampler
+  static void drain();
+  static size_t drain_interval_millis();
+
+  static void on_javathread_start(JavaThread* jt);
+  static void on_javathread_exit(JavaThread* jt);
+};
+
+#endif // SHARE_VM_JFR_PERIODIC_SAMPLING_JFRCPUTIMETHREADSAMPLER_HPP
@@ -26,6 +26,7 @@
 #include "jfr/jfrEvents.hpp"
 #include "jfr/recorder/jfrRecorder.hpp"
 #include "jfr/periodic/sampling/jfrCallTrace.hpp"
+#include "jfr/periodic/sampling/jfrCPUTimeThreadSampler.hpp"
 #include "jfr/periodic/sampling/jfrThreadSampler.hpp"
 #include "jfr/recorder/service/jfrOptionSet.hpp"
 #include "jfr/recorder/stacktrace/jfrStackTraceRepository.hpp"
@@ -255,7 +256,6 @@ bool JfrThreadSampleClosure::sample_thread_in_java(JavaThread* thread, JfrStackF
   }
   EventExecutionSample *event = &_events[_added_java - 1];
   traceid id = JfrStackTraceRepository::add(sampler.stacktrace());
-  assert(id != 0, "Stacktrace id should not be 0");
   event->set_stackTrace(id);
   return true;
 }
@@ -275,7 +275,6 @@ bool JfrThreadSampleClosure::sample_thread_in_native(JavaThread* thread, JfrStac
   }
   EventNativeMethodSample *event = &_events_native[_added_native - 1];
   traceid id = JfrStackTraceRepository::add(cb.stacktrace());
-  assert(id != 0, "Stacktrace id should not be 0");
   event->set_stackTrace(id);
   return true;
 }
@@ -518,7 +517,11 @@ void JfrThreadSampler::run() {
     }
 
     if ((next_j - sleep_to_next) <= 0) {
-      task_stacktrace(JAVA_SAMPLE, &_last_thread_java);
+      if (JfrCPUTimeThreadSampling::is_active()) {
+        JfrCPUTimeThreadSampling::drain();
+      } else {
+        task_stacktrace(JAVA_SAMPLE, &_last_thread_java);
+      }
       last_java_ms = get_monotonic_ms();
     }
     if ((next_n - sleep_to_next) <= 0) {
@@ -630,6 +633,10 @@ void JfrThreadSampling::set_sampling_interval(bool java_interval, size_t period)
   }
   if (java_interval) {
     interval_java = period;
+    if (JfrOptionSet::cpu_time_sampling() && JfrCPUTimeThreadSampling::set_interval(period) && period > 0) {
+      // Java samples are taken by the CPU time timers, the sampler drains them
+      interval_java = JfrCPUTimeThreadSampling::drain_interval_millis();
+    }
   } else {
     interval_native = period;
   }
@@ -403,3 +403,7 @@ bool JfrRecorder::is_recording() {
 void JfrRecorder::stop_recording() {
   _post_box->post(MSG_STOP);
 }
+
+void JfrRecorder::flush() {
+  _post_box->post(MSG_FLUSH);
+}
@@ -66,6 +66,7 @@ class JfrRecorder : public JfrCHeapObj {
   static void start_recording();
   static bool is_recording();
   static void stop_recording();
+  static void flush();
   static bool is_shutting_down() { return _shutting_down; }
   static void set_is_shutting_down() { _shutting_down = true; }
 };
@@ -38,7 +38,8 @@ JfrChunkState::JfrChunkState() :
   _start_nanos(0),
   _previous_start_ticks(0),
   _previous_start_nanos(0),
-  _previous_checkpoint_offset(0) {}
+  _previous_checkpoint_offset(0),
+  _generation(0) {}
 
 JfrChunkState::~JfrChunkState() {
   reset();
@@ -50,6 +51,7 @@ void JfrChunkState::reset() {
     _path = NULL;
   }
   set_previous_checkpoint_offset(0);
+  _generation = 0;
 }
 
 void JfrChunkState::set_previous_checkpoint_offset(int64_t offset) {
@@ -68,6 +70,25 @@ int64_t JfrChunkState::previous_start_nanos() const {
   return _previous_start_nanos;
 }
 
+int64_t JfrChunkState::start_ticks() const {
+  return _start_ticks;
+}
+
+int64_t JfrChunkState::start_nanos() const {
+  return _start_nanos;
+}
+
+// generation of the chunk header, 0 until the chunk is first flushed
+u1 JfrChunkState::generation() const {
+  return _generation;
+}
+
+// skips 0, which marks a complete chunk, and 0xff, which guards updates
+u1 JfrChunkState::next_generation() {
+  _generation = (_generation >= 0xfe) ? 1 : _generation + 1;
+  return _generation;
+}
+
 void JfrChunkState::update_start_ticks() {
   _start_ticks = JfrTicks::now();
 }
@@ -37,6 +37,7 @@ class JfrChunkState : public JfrCHeapObj {
   int64_t _previous_start_ticks;
   int64_t _previous_start_nanos;
   int64_t _previous_checkpoint_offset;
+  u1 _generation;
 
   void update_start_ticks();
   void update_start_nanos();
@@ -50,7 +51,11 @@ class JfrChunkState : public JfrCHeapObj {
   void set_previous_checkpoint_offset(int64_t offset);
   int64_t previous_start_ticks() const;
   int64_t previous_start_nanos() const;
+  int64_t start_ticks() const;
+  int64_t start_nanos() const;
   int64_t last_chunk_duration() const;
+  u1 generation() const;
+  u1 next_generation();
   void update_time_to_now();
   void set_path(const char* path);
   const char* path() const;
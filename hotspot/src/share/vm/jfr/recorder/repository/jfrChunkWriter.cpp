@@ -27,22 +27,75 @@
 #include "jfr/recorder/repository/jfrChunkWriter.hpp"
 #include "jfr/recorder/service/jfrOptionSet.hpp"
 #include "jfr/utilities/jfrTime.hpp"
+#include "jfr/utilities/jfrTimeConverter.hpp"
 #include "jfr/utilities/jfrTypes.hpp"
+#include "jfrfiles/jfrTypes.hpp"
+#include "runtime/arguments.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/os.hpp"
-#include "runtime/os.hpp"
 
 static const u2 JFR_VERSION_MAJOR = 2;
 static const u2 JFR_VERSION_MINOR = 0;
 static const size_t MAGIC_LEN = 4;
 static const size_t FILEHEADER_SLOT_SIZE = 8;
 static const size_t CHUNK_SIZE_OFFSET = 8;
+// The high byte of the capabilities field is the generation of the header.
+// It is 0 in a complete chunk. A chunk being recorded that has been flushed
+// has a generation from 1 to 254, and 0xff while its header is updated.
+static const size_t GENERATION_OFFSET = CHUNK_SIZE_OFFSET + (7 * FILEHEADER_SLOT_SIZE);
+static const u1 COMPLETE = 0;
+static const u1 GUARD = 0xff;
+// capability bits
+static const u4 COMPRESSED_INTEGERS = 1;
+static const u4 COMPRESSED_EVENTS = 2;
+// smaller writes gain too little to be worth a compressed block
+static const size_t MIN_COMPRESSED_SIZE = 1 * K;
+// the sizes in a compressed block header are padded and hold 28 bits
+static const size_t MAX_COMPRESSED_SIZE = ((1 << 28) - 1) - (2 * sizeof(u4) + sizeof(u8));
+
+typedef size_t (JNICALL *GZipBound_t)(size_t in_len, jint level, char** pmsg);
+typedef size_t (JNICALL *GZipFully_t)(char* in_buf, size_t in_len, char* out_buf,
+                                      size_t out_len, jint level, char** pmsg);
+
+static GZipBound_t _gzip_bound = NULL;
+static GZipFully_t _gzip_fully = NULL;
+
+static bool load_zip_library() {
+  // the zip library has been loaded by the class loader already
+  char path[JVM_MAXPATHLEN];
+  char ebuf[1024];
+  void* handle = NULL;
+  if (os::dll_build_name(path, sizeof(path), Arguments::get_dll_dir(), "zip")) {
+    handle = os::dll_load(path, ebuf, sizeof ebuf);
+  }
+  if (handle == NULL) {
+    return false;
+  }
+  _gzip_bound = CAST_TO_FN_PTR(GZipBound_t, os::dll_lookup(handle, "ZIP_GZip_Bound"));
+  _gzip_fully = CAST_TO_FN_PTR(GZipFully_t, os::dll_lookup(handle, "ZIP_GZip_Fully"));
+  return _gzip_bound != NULL && _gzip_fully != NULL;
+}
 
-JfrChunkWriter::JfrChunkWriter() : JfrChunkWriterBase(NULL), _chunkstate(NULL) {}
+JfrChunkWriter::JfrChunkWriter() : JfrChunkWriterBase(NULL),
+  _chunkstate(NULL),
+  _compressed(NULL),
+  _compressed_capacity(0),
+  _compression_level(0) {}
+
+JfrChunkWriter::~JfrChunkWriter() {
+  if (_compressed != NULL) {
+    JfrCHeapObj::free(_compressed, _compressed_capacity);
+  }
+}
 
 bool JfrChunkWriter::initialize() {
   assert(_chunkstate == NULL, "invariant");
   _chunkstate = new JfrChunkState();
+  _compression_level = JfrOptionSet::compression_level();
+  if (_compression_level > 0 && !load_zip_library()) {
+    warning("Flight Recorder event compression is disabled, the zip library does not support it");
+    _compression_level = 0;
+  }
   return _chunkstate != NULL;
 }
 
@@ -67,15 +120,23 @@ bool JfrChunkWriter::open() {
     // u8 chunk duration nanos
     // u8 chunk start ticks
     this->be_write(JfrTime::frequency());
-    // chunk capabilities, CompressedIntegers etc
-    this->be_write((u4)JfrOptionSet::compressed_integers() ? 1 : 0);
+    // chunk capabilities, CompressedIntegers etc, the high byte is the generation
+    this->be_write((JfrOptionSet::compressed_integers() ? COMPRESSED_INTEGERS : 0) |
+                   (_compression_level > 0 ? COMPRESSED_EVENTS : 0));
     _chunkstate->reset();
   }
   return is_open;
 }
 
 size_t JfrChunkWriter::close(int64_t metadata_offset) {
+  const bool flushed = _chunkstate->generation() != COMPLETE;
+  if (flushed) {
+    this->write_be_at_offset(GUARD, GENERATION_OFFSET);
+  }
   write_header(metadata_offset);
+  if (flushed) {
+    this->write_be_at_offset(COMPLETE, GENERATION_OFFSET);
+  }
   this->flush();
   this->close_fd();
   return (size_t)size_written();
@@ -97,6 +158,78 @@ void JfrChunkWriter::write_header(int64_t metadata_offset) {
   this->write_be_at_offset(_chunkstate->previous_start_ticks(), CHUNK_SIZE_OFFSET + (5 * FILEHEADER_SLOT_SIZE));
 }
 
+// Makes everything written so far readable by consumers tailing the chunk
+// file. The data is written out before the header that covers it, and the
+// header is guarded while it is updated: a reader that sees the same
+// generation, other than the guard, before and after reading the header
+// has read a consistent one.
+void JfrChunkWriter::flush_chunk(int64_t metadata_offset) {
+  assert(this->is_valid(), "invariant");
+  this->flush();
+  this->write_be_at_offset(GUARD, GENERATION_OFFSET);
+  write_header_in_progress(metadata_offset);
+  this->write_be_at_offset(_chunkstate->next_generation(), GENERATION_OFFSET);
+}
+
+// the chunk is still being recorded, it started at the current start time
+void JfrChunkWriter::write_header_in_progress(int64_t metadata_offset) {
+  assert(this->is_valid(), "invariant");
+  const int64_t now_nanos = (int64_t)(os::javaTimeMillis() * JfrTimeConverter::NANOS_PER_MILLISEC);
+  this->write_be_at_offset((jlong)size_written(), CHUNK_SIZE_OFFSET);
+  this->write_be_at_offset(_chunkstate->previous_checkpoint_offset(), CHUNK_SIZE_OFFSET + (1 * FILEHEADER_SLOT_SIZE));
+  this->write_be_at_offset((jlong)metadata_offset, CHUNK_SIZE_OFFSET + (2 * FILEHEADER_SLOT_SIZE));
+  this->write_be_at_offset(_chunkstate->start_nanos(), CHUNK_SIZE_OFFSET + (3 * FILEHEADER_SLOT_SIZE));
+  this->write_be_at_offset(now_nanos - _chunkstate->start_nanos(), CHUNK_SIZE_OFFSET + (4 * FILEHEADER_SLOT_SIZE));
+  this->write_be_at_offset(_chunkstate->start_ticks(), CHUNK_SIZE_OFFSET + (5 * FILEHEADER_SLOT_SIZE));
+}
+
+// Compresses the data into the scratch buffer, returns the compressed
+// size or 0 if the data is better written as it is.
+size_t JfrChunkWriter::compress_events(const u1* data, size_t size) {
+  assert(_compression_level > 0, "invariant");
+  char* msg = NULL;
+  const size_t bound = _gzip_bound(size, _compression_level, &msg);
+  if (bound == 0) {
+    return 0;
+  }
+  if (bound > _compressed_capacity) {
+    u1* const buffer = JfrCHeapObj::new_array<u1>(bound);
+    if (buffer == NULL) {
+      return 0;
+    }
+    if (_compressed != NULL) {
+      JfrCHeapObj::free(_compressed, _compressed_capacity);
+    }
+    _compressed = buffer;
+    _compressed_capacity = bound;
+  }
+  const size_t compressed_size = _gzip_fully((char*)data, size, (char*)_compressed,
+                                             _compressed_capacity, _compression_level, &msg);
+  return compressed_size < size ? compressed_size : 0;
+}
+
+// Writes out the events of a storage buffer. With compression enabled
+// they are framed as a single EVENT_COMPRESSED event: a padded u4 size,
+// the event type, the padded u4 size of the original data, followed by
+// the data as a gzip member. Readers that do not know the type skip it
+// using the size. Checkpoint and metadata events are never compressed.
+void JfrChunkWriter::write_events(const u1* data, size_t size) {
+  assert(data != NULL, "invariant");
+  if (_compression_level > 0 && size >= MIN_COMPRESSED_SIZE && size <= MAX_COMPRESSED_SIZE) {
+    const size_t compressed_size = compress_events(data, size);
+    if (compressed_size > 0) {
+      const int64_t size_offset = this->reserve(sizeof(u4));
+      this->write<u8>(EVENT_COMPRESSED);
+      this->write_padded_at_offset((u4)size, this->reserve(sizeof(u4)));
+      const int64_t header_size = this->current_offset() - size_offset;
+      this->write_padded_at_offset((u4)(header_size + compressed_size), size_offset);
+      this->write_unbuffered(_compressed, compressed_size);
+      return;
+    }
+  }
+  this->write_unbuffered(data, size);
+}
+
 void JfrChunkWriter::set_chunk_path(const char* chunk_path) {
   _chunkstate->set_path(chunk_path);
 }
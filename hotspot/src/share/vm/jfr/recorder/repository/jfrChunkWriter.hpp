@@ -39,15 +39,23 @@ class JfrChunkWriter : public JfrChunkWriterBase {
   friend class JfrRepository;
  private:
   JfrChunkState* _chunkstate;
+  u1* _compressed;
+  size_t _compressed_capacity;
+  jint _compression_level;
 
   bool open();
   size_t close(int64_t metadata_offset);
+  void flush_chunk(int64_t metadata_offset);
   void write_header(int64_t metadata_offset);
+  void write_header_in_progress(int64_t metadata_offset);
   void set_chunk_path(const char* chunk_path);
+  size_t compress_events(const u1* data, size_t size);
 
  public:
   JfrChunkWriter();
+  ~JfrChunkWriter();
   bool initialize();
+  void write_events(const u1* data, size_t size);
   int64_t size_written() const;
   int64_t previous_checkpoint_offset() const;
   void set_previous_checkpoint_offset(int64_t offset);
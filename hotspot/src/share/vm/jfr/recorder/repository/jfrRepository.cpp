@@ -167,3 +167,7 @@ bool JfrRepository::open_chunk(bool vm_error /* false */) {
 size_t JfrRepository::close_chunk(int64_t metadata_offset) {
   return _chunkwriter->close(metadata_offset);
 }
+
+void JfrRepository::flush_chunk(int64_t metadata_offset) {
+  _chunkwriter->flush_chunk(metadata_offset);
+}
@@ -27,6 +27,7 @@
 
 #include "jfr/recorder/jfrEventSetting.inline.hpp"
 #include "jfr/recorder/stacktrace/jfrStackTraceRepository.hpp"
+#include "jfr/support/jfrEventThrottler.hpp"
 #include "jfr/utilities/jfrTime.hpp"
 #include "jfr/utilities/jfrTypes.hpp"
 #include "jfr/writers/jfrNativeEventWriter.hpp"
@@ -88,7 +89,7 @@ class JfrEvent {
     } else if (_end_time == 0) {
       set_endtime(JfrTicks::now());
     }
-    if (should_write()) {
+    if (should_write() && JfrEventThrottler::accept(T::eventId)) {
       write_event();
       DEBUG_ONLY(_verifier.set_committed();)
     }
@@ -102,6 +102,15 @@ void JfrOptionSet::set_old_object_queue_size(jlong value) {
   _old_object_queue_size = value;
 }
 
+// milliseconds between flushes of the current chunk, 0 if disabled
+jlong JfrOptionSet::flush_interval() {
+  return _flush_interval;
+}
+
+void JfrOptionSet::set_flush_interval(jlong millis) {
+  _flush_interval = millis;
+}
+
 u4 JfrOptionSet::stackdepth() {
   return _stack_depth;
 }
@@ -142,6 +151,22 @@ void JfrOptionSet::set_sample_protection(jboolean protection) {
 }
 #endif
 
+bool JfrOptionSet::cpu_time_sampling() {
+  return _cpu_time_sampling == JNI_TRUE;
+}
+
+void JfrOptionSet::set_cpu_time_sampling(jboolean value) {
+  _cpu_time_sampling = value;
+}
+
+jint JfrOptionSet::compression_level() {
+  return _compression_level;
+}
+
+void JfrOptionSet::set_compression_level(jint level) {
+  _compression_level = level;
+}
+
 bool JfrOptionSet::compressed_integers() {
   // Set this to false for debugging purposes.
   return true;
@@ -170,6 +195,9 @@ const char* const default_sample_threads = "true";
 const char* const default_stack_depth = "64";
 const char* const default_retransform = "true";
 const char* const default_old_object_queue_size = "256";
+const char* const default_flush_interval = "0";
+const char* const default_cpu_time_sampling = "false";
+const char* const default_compression_level = "0";
 DEBUG_ONLY(const char* const default_sample_protection = "false";)
 
 // statics
@@ -222,6 +250,27 @@ static DCmdArgument<jlong> _dcmd_old_object_queue_size (
   false,
   default_old_object_queue_size);
 
+static DCmdArgument<NanoTimeArgument> _dcmd_flush_interval(
+  "flush-interval",
+  "Interval at which recorded data is flushed to the current disk chunk, 0 to flush only on rotation",
+  "NANOTIME",
+  false,
+  default_flush_interval);
+
+static DCmdArgument<bool> _dcmd_cpu_time_sampling(
+  "cpu-time-sampling",
+  "Take execution samples on per-thread CPU time timers instead of suspending threads (Linux only, false by default)",
+  "BOOLEAN",
+  false,
+  default_cpu_time_sampling);
+
+static DCmdArgument<jlong> _dcmd_compression_level(
+  "compression-level",
+  "Compress recorded events in the disk chunks at the given level, 1 (fastest) to 9, 0 to disable",
+  "JINT",
+  false,
+  default_compression_level);
+
 static DCmdArgument<bool> _dcmd_sample_threads(
   "samplethreads",
   "Thread sampling enable / disable (only sampling when event enabled and sampling enabled)",
@@ -265,6 +314,9 @@ static void register_parser_options() {
   _parser.add_dcmd_option(&_dcmd_sample_threads);
   _parser.add_dcmd_option(&_dcmd_retransform);
   _parser.add_dcmd_option(&_dcmd_old_object_queue_size);
+  _parser.add_dcmd_option(&_dcmd_flush_interval);
+  _parser.add_dcmd_option(&_dcmd_cpu_time_sampling);
+  _parser.add_dcmd_option(&_dcmd_compression_level);
   DEBUG_ONLY(_parser.add_dcmd_option(&_dcmd_sample_protection);)
 }
 
@@ -303,9 +355,12 @@ jlong JfrOptionSet::_thread_buffer_size = 0;
 jlong JfrOptionSet::_memory_size = 0;
 jlong JfrOptionSet::_num_global_buffers = 0;
 jlong JfrOptionSet::_old_object_queue_size = 0;
+jlong JfrOptionSet::_flush_interval = 0;
 u4 JfrOptionSet::_stack_depth = STACK_DEPTH_DEFAULT;
 jboolean JfrOptionSet::_sample_threads = JNI_TRUE;
 jboolean JfrOptionSet::_retransform = JNI_TRUE;
+jboolean JfrOptionSet::_cpu_time_sampling = JNI_FALSE;
+jint JfrOptionSet::_compression_level = 0;
 #ifdef ASSERT
 jboolean JfrOptionSet::_sample_protection = JNI_FALSE;
 #else
@@ -321,6 +376,16 @@ bool JfrOptionSet::initialize(Thread* thread) {
     set_retransform(_dcmd_retransform.value());
   }
   set_old_object_queue_size(_dcmd_old_object_queue_size.value());
+  set_cpu_time_sampling(_dcmd_cpu_time_sampling.value());
+  const jlong level = _dcmd_compression_level.value();
+  if (level < 0 || level > 9) {
+    tty->print_cr("compression-level must be between 0 and 9");
+    return false;
+  }
+  set_compression_level((jint)level);
+  const jlong flush_nanos = _dcmd_flush_interval.value()._nanotime;
+  // round up so that sub-millisecond intervals do not disable flushing
+  set_flush_interval(flush_nanos <= 0 ? 0 : MAX2(flush_nanos / NANOSECS_PER_MILLISEC, (jlong)1));
   return adjust_memory_options();
 }
 
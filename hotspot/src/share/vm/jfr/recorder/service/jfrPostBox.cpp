@@ -33,7 +33,8 @@
                              (MSGBIT(MSG_STOP))   |          \
                              (MSGBIT(MSG_START))  |          \
                              (MSGBIT(MSG_CLONE_IN_MEMORY)) | \
-                             (MSGBIT(MSG_VM_ERROR))          \
+                             (MSGBIT(MSG_VM_ERROR)) |        \
+                             (MSGBIT(MSG_FLUSH))             \
                            )
 
 static JfrPostBox* _instance = NULL;
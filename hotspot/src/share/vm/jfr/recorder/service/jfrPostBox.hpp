@@ -41,6 +41,7 @@ enum JFR_Msg {
   MSG_SHUTDOWN,
   MSG_VM_ERROR,
   MSG_DEADBUFFER,
+  MSG_FLUSH,
   MSG_NO_OF_MSGS
 };
 
@@ -54,6 +55,7 @@ enum JFR_Msg {
  *  MSG_STOP (2)            ; MSGBIT(MSG_STOP) == (1 << 0x2) == 0x4
  *  MSG_ROTATE (3)          ; MSGBIT(MSG_ROTATE) == (1 << 0x3) == 0x8
  *  MSG_VM_ERROR (8)        ; MSGBIT(MSG_VM_ERROR) == (1 << 8) == 0x100
+ *  MSG_FLUSH (10)          ; MSGBIT(MSG_FLUSH) == (1 << 10) == 0x400
  *
  *  Asynchronous messages (posting thread returns immediately upon deposit):
  *
@@ -46,6 +46,7 @@
 #include "memory/resourceArea.hpp"
 #include "runtime/atomic.hpp"
 #include "runtime/handles.inline.hpp"
+#include "runtime/interfaceSupport.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/orderAccess.hpp"
 #include "runtime/os.hpp"
@@ -267,7 +268,6 @@ void JfrRecorderService::clear() {
 }
 
 void JfrRecorderService::pre_safepoint_clear() {
-  _stack_trace_repository.clear();
   _string_pool.clear();
   _storage.clear();
 }
@@ -514,6 +514,51 @@ void JfrRecorderService::post_safepoint_write() {
   assert(!_chunkwriter.is_valid(), "invariant");
 }
 
+//
+// flush sequence
+//
+//   lock metadata descriptor ->
+//     lock stream lock ->
+//       write non-safepoint dependent types ->
+//         write stack trace checkpoint ->
+//           write string pool checkpoint ->
+//             write storage ->
+//               write checkpoints ->
+//                 write metadata event ->
+//                   write chunk header ->
+//                     release stream lock
+//
+// Publishes the events recorded so far in the current chunk, without the
+// safepoint and the epoch shift of a rotation. The type set is epoch
+// relative and only written when the chunk is finalized, so the classes and
+// methods tagged in the current epoch are resolvable only after rotation.
+//
+void JfrRecorderService::flush() {
+  RotationLock rl(Thread::current());
+  if (rl.not_acquired()) {
+    return;
+  }
+  if (!is_recording() || !_chunkwriter.is_valid()) {
+    // nothing on disk to flush to
+    return;
+  }
+  ResourceMark rm;
+  HandleMark hm;
+  assert(Thread::current()->is_Java_thread(), "invariant");
+  {
+    // a Java thread updating the metadata descriptor may need a safepoint
+    ThreadBlockInVM transition((JavaThread*)Thread::current());
+    JfrMetadataEvent::lock();
+  }
+  MutexLockerEx stream_lock(JfrStream_lock, Mutex::_no_safepoint_check_flag);
+  _checkpoint_manager.write_types();
+  write_stacktrace_checkpoint(_stack_trace_repository, _chunkwriter, false);
+  write_stringpool_checkpoint(_string_pool, _chunkwriter);
+  _storage.write();
+  _checkpoint_manager.write();
+  _repository.flush_chunk(write_metadata_event(_chunkwriter));
+}
+
 void JfrRecorderService::vm_error_rotation() {
   if (_chunkwriter.is_valid()) {
     finalize_current_chunk_on_vm_error();
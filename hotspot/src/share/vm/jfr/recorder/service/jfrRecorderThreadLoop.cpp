@@ -24,12 +24,26 @@
 
 #include "precompiled.hpp"
 #include "jfr/recorder/jfrRecorder.hpp"
+#include "jfr/recorder/service/jfrOptionSet.hpp"
 #include "jfr/recorder/service/jfrPostBox.hpp"
 #include "jfr/recorder/service/jfrRecorderService.hpp"
 #include "jfr/recorder/service/jfrRecorderThread.hpp"
 #include "runtime/mutexLocker.hpp"
+#include "runtime/os.hpp"
 #include "runtime/thread.inline.hpp"
 
+// true if a flush is requested or the flush interval has elapsed
+static bool should_flush(int msgs, jlong* last_flush_nanos) {
+  const jlong interval = JfrOptionSet::flush_interval();
+  const jlong now = os::javaTimeNanos();
+  if ((msgs & MSGBIT(MSG_FLUSH)) != 0 ||
+      (interval > 0 && now - *last_flush_nanos >= interval * NANOSECS_PER_MILLISEC)) {
+    *last_flush_nanos = now;
+    return true;
+  }
+  return false;
+}
+
 //
 // Entry point for "JFR Recorder Thread" message loop.
 // The recorder thread executes service requests collected from the message system.
@@ -48,13 +62,15 @@ void recorderthread_entry(JavaThread* thread, Thread* unused) {
   {
     bool done = false;
     int msgs = 0;
+    jlong last_flush_nanos = os::javaTimeNanos();
     JfrRecorderService service;
     MutexLockerEx msg_lock(JfrMsg_lock);
 
     // JFR MESSAGE LOOP PROCESSING - BEGIN
     while (!done) {
       if (post_box.is_empty()) {
-        JfrMsg_lock->wait(false);
+        // wake up to flush the current chunk, 0 waits for the next message
+        JfrMsg_lock->wait(false, JfrOptionSet::flush_interval());
       }
       msgs = post_box.collect();
       JfrMsg_lock->unlock();
@@ -71,6 +87,8 @@ void recorderthread_entry(JavaThread* thread, Thread* unused) {
         service.start();
       } else if (ROTATE) {
         service.rotate(msgs);
+      } else if (should_flush(msgs, &last_flush_nanos)) {
+        service.flush();
       }
       JfrMsg_lock->lock();
       post_box.notify_waiters();
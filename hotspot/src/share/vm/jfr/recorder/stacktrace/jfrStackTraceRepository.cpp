@@ -30,7 +30,9 @@
 #include "jfr/recorder/stacktrace/jfrStackTraceRepository.hpp"
 #include "jfr/utilities/jfrTypes.hpp"
 #include "memory/allocation.inline.hpp"
+#include "runtime/atomic.inline.hpp"
 #include "runtime/mutexLocker.hpp"
+#include "runtime/orderAccess.inline.hpp"
 #include "runtime/os.hpp"
 #include "runtime/safepoint.hpp"
 #include "runtime/task.hpp"
@@ -100,9 +102,14 @@ void JfrStackTraceRepository::destroy() {
   _instance = NULL;
 }
 
-JfrStackTraceRepository::JfrStackTraceRepository() : _next_id(0), _entries(0) {
-  memset(_table, 0, sizeof(_table));
+// Upper bound on the memory held by the table between two chunk rotations.
+// Once reached, stack traces not already in the table are not recorded.
+static const size_t max_size_in_bytes = 64 * M;
+
+JfrStackTraceRepository::JfrStackTraceRepository() : _next_id(0), _entries(0), _size_in_bytes(0) {
+  memset((void*)_table, 0, sizeof(_table));
 }
+
 class JfrFrameType : public JfrSerializer {
  public:
   void serialize(JfrCheckpointWriter& writer) {
@@ -122,11 +129,9 @@ bool JfrStackTraceRepository::initialize() {
   return JfrSerializer::register_serializer(TYPE_FRAMETYPE, false, true, new JfrFrameType());
 }
 
-size_t JfrStackTraceRepository::clear() {
-  MutexLockerEx lock(JfrStacktrace_lock, Mutex::_no_safepoint_check_flag);
-  if (_entries == 0) {
-    return 0;
-  }
+size_t JfrStackTraceRepository::clear_table() {
+  assert(SafepointSynchronize::is_at_safepoint(), "invariant");
+  assert(JfrStacktrace_lock->owned_by_self(), "invariant");
   for (u4 i = 0; i < TABLE_SIZE; ++i) {
     JfrStackTraceRepository::StackTrace* stacktrace = _table[i];
     while (stacktrace != NULL) {
@@ -135,41 +140,78 @@ size_t JfrStackTraceRepository::clear() {
       stacktrace = next;
     }
   }
-  memset(_table, 0, sizeof(_table));
+  memset((void*)_table, 0, sizeof(_table));
   const size_t processed = _entries;
   _entries = 0;
+  _size_in_bytes = 0;
   return processed;
 }
 
-traceid JfrStackTraceRepository::add_trace(const JfrStackTrace& stacktrace) {
+size_t JfrStackTraceRepository::clear() {
   MutexLockerEx lock(JfrStacktrace_lock, Mutex::_no_safepoint_check_flag);
-  const size_t index = stacktrace._hash % TABLE_SIZE;
-  const StackTrace* table_entry = _table[index];
+  return _entries > 0 ? clear_table() : 0;
+}
 
-  while (table_entry != NULL) {
-    if (table_entry->equals(stacktrace)) {
-      return table_entry->id();
+const JfrStackTraceRepository::StackTrace* JfrStackTraceRepository::lookup(const JfrStackTrace& stacktrace,
+                                                                          const StackTrace* entry,
+                                                                          const StackTrace* end) {
+  while (entry != end) {
+    if (entry->equals(stacktrace)) {
+      return entry;
     }
-    table_entry = table_entry->next();
+    entry = entry->next();
+  }
+  return NULL;
+}
+
+// Lock-free lookup and insert. A new entry is pushed onto the head of its
+// bucket; if some other thread pushed first, only the entries it added need
+// to be searched for a duplicate before trying again. Ids of entries that
+// lost such a race are not reused.
+traceid JfrStackTraceRepository::add_trace(const JfrStackTrace& stacktrace) {
+  const size_t index = stacktrace._hash % TABLE_SIZE;
+  StackTrace* head = (StackTrace*)OrderAccess::load_ptr_acquire(&_table[index]);
+  const StackTrace* found = lookup(stacktrace, head, NULL);
+  if (found != NULL) {
+    return found->id();
   }
 
   if (!stacktrace.have_lineno()) {
     return 0;
   }
 
-  traceid id = ++_next_id;
-  _table[index] = new StackTrace(id, stacktrace, _table[index]);
-  ++_entries;
+  if (_size_in_bytes >= max_size_in_bytes) {
+    // evicted at the next chunk rotation
+    return 0;
+  }
+
+  const traceid id = (traceid)Atomic::add((jlong)1, &_next_id);
+  StackTrace* const entry = new StackTrace(id, stacktrace, head);
+  while (true) {
+    StackTrace* const current = (StackTrace*)Atomic::cmpxchg_ptr(entry, &_table[index], head);
+    if (current == head) {
+      break;
+    }
+    found = lookup(stacktrace, current, head);
+    if (found != NULL) {
+      delete entry;
+      return found->id();
+    }
+    head = current;
+    entry->set_next(head);
+  }
+  Atomic::inc(&_entries);
+  Atomic::add_ptr((intptr_t)entry->size(), (volatile intptr_t*)&_size_in_bytes);
   return id;
 }
 
+// Returns 0 if the table is full and the stack trace is not already in it.
 traceid JfrStackTraceRepository::add(const JfrStackTrace& stacktrace) {
   traceid tid = instance().add_trace(stacktrace);
-  if (tid == 0) {
+  if (tid == 0 && !stacktrace.have_lineno()) {
     stacktrace.resolve_linenos();
     tid = instance().add_trace(stacktrace);
   }
-  assert(tid != 0, "invariant");
   return tid;
 }
 
@@ -218,27 +260,25 @@ bool JfrStackTraceRepository::fill_stacktrace_for(JavaThread* thread, JfrStackTr
   return stacktrace->record_safe(thread, skip, true);
 }
 
+// Serializes the entries not yet written. Entries added concurrently may
+// or may not be seen and are written the next time around. With clear, the
+// whole table is evicted, which is only done at a safepoint.
 size_t JfrStackTraceRepository::write_impl(JfrChunkWriter& sw, bool clear) {
   MutexLockerEx lock(JfrStacktrace_lock, Mutex::_no_safepoint_check_flag);
   assert(_entries > 0, "invariant");
   int count = 0;
   for (u4 i = 0; i < TABLE_SIZE; ++i) {
-    JfrStackTraceRepository::StackTrace* stacktrace = _table[i];
+    const StackTrace* stacktrace = (StackTrace*)OrderAccess::load_ptr_acquire(&_table[i]);
     while (stacktrace != NULL) {
-      JfrStackTraceRepository::StackTrace* next = stacktrace->next();
       if (stacktrace->should_write()) {
         stacktrace->write(sw);
         ++count;
       }
-      if (clear) {
-        delete stacktrace;
-      }
-      stacktrace = next;
+      stacktrace = stacktrace->next();
     }
   }
   if (clear) {
-    memset(_table, 0, sizeof(_table));
-    _entries = 0;
+    clear_table();
   }
   return count;
 }
@@ -62,6 +62,7 @@ class JfrStackFrame {
 };
 
 class JfrStackTrace : public StackObj {
+  friend class JfrCPUTimeSampleBuffer;
   friend class JfrStackTraceRepository;
  private:
   JfrStackFrame* _frames;
@@ -118,6 +119,8 @@ class JfrStackTraceRepository : public JfrCHeapObj {
     ~StackTrace();
     traceid id() const { return _id; }
     StackTrace* next() const { return _next; }
+    void set_next(StackTrace* next) { _next = next; }
+    size_t size() const { return sizeof(StackTrace) + _nr_of_frames * sizeof(JfrStackFrame); }
     void write(JfrChunkWriter& cw) const;
     void write(JfrCheckpointWriter& cpw) const;
     bool equals(const JfrStackTrace& rhs) const;
@@ -125,11 +128,16 @@ class JfrStackTraceRepository : public JfrCHeapObj {
 
  private:
   static const u4 TABLE_SIZE = 2053;
-  StackTrace* _table[TABLE_SIZE];
-  traceid _next_id;
-  u4 _entries;
+  // Entries are pushed onto the bucket lists without locking and are only
+  // unlinked and freed at a safepoint, when no thread can be adding.
+  StackTrace* volatile _table[TABLE_SIZE];
+  volatile jlong _next_id;
+  volatile jint _entries;
+  volatile size_t _size_in_bytes;
 
   traceid add_trace(const JfrStackTrace& stacktrace);
+  static const StackTrace* lookup(const JfrStackTrace& stacktrace, const StackTrace* entry, const StackTrace* end);
+  size_t clear_table();
   static traceid add(const JfrStackTrace* stacktrace, JavaThread* thread);
   traceid record_for(JavaThread* thread, int skip, JfrStackFrame* frames, u4 max_frames);
 
@@ -576,7 +576,7 @@ BufferPtr JfrStorage::provision_large(BufferPtr cur, const u1* const cur_pos, si
   return store_buffer_to_thread_local(buffer, t->jfr_thread_local(), native);
 }
 
-typedef UnBufferedWriteToChunk<JfrBuffer> WriteOperation;
+typedef EventWriteToChunk<JfrBuffer> WriteOperation;
 typedef MutexedWriteOp<WriteOperation> MutexedWriteOperation;
 typedef ConcurrentWriteOp<WriteOperation> ConcurrentWriteOperation;
 typedef ConcurrentWriteOpExcludeRetired<WriteOperation> ThreadLocalConcurrentWriteOperation;
@@ -61,6 +61,18 @@ class UnBufferedWriteToChunk {
   size_t processed() { return _processed; }
 };
 
+template <typename T>
+class EventWriteToChunk {
+ private:
+  JfrChunkWriter& _writer;
+  size_t _processed;
+ public:
+  typedef T Type;
+  EventWriteToChunk(JfrChunkWriter& writer) : _writer(writer), _processed(0) {}
+  bool write(Type* t, const u1* data, size_t size);
+  size_t processed() { return _processed; }
+};
+
 template <typename T>
 class DefaultDiscarder {
  private:
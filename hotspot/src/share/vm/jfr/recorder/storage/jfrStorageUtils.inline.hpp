@@ -35,6 +35,13 @@ inline bool UnBufferedWriteToChunk<T>::write(T* t, const u1* data, size_t size)
   return true;
 }
 
+template <typename T>
+inline bool EventWriteToChunk<T>::write(T* t, const u1* data, size_t size) {
+  _writer.write_events(data, size);
+  _processed += size;
+  return true;
+}
+
 template <typename T>
 inline bool DefaultDiscarder<T>::discard(T* t, const u1* data, size_t size) {
   _processed += size;
@@ -0,0 +1,163 @@
+/*
+* Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* This code is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License version 2 only, as
+* published by the Free Software Foundation.
+*
+* This code is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+* version 2 for more details (a copy is included in the LICENSE file that
+* accompanied this code).
+*
+* You should have received a copy of the GNU General Public License version
+* 2 along with this work; if not, write to the Free Software Foundation,
+* Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+*
+* Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+* or visit www.oracle.com if you need additional information or have any
+* questions.
+*
+*/
+
+#include "precompiled.hpp"
+#include "jfr/support/jfrEventThrottler.hpp"
+#include "jfr/utilities/jfrTime.hpp"
+#include "jfr/utilities/jfrTimeConverter.hpp"
+#include "jfr/utilities/jfrTryLock.hpp"
+#include "runtime/atomic.inline.hpp"
+#include "runtime/orderAccess.inline.hpp"
+#include "runtime/os.hpp"
+
+// windows per period, a period with fewer samples has one window per sample
+static const jlong windows_per_period = 10;
+// number of past windows the population average roughly spans
+static const double window_lookback_count = 25.0;
+
+JfrSamplerWindow::JfrSamplerWindow() :
+  _measured_population_size(0),
+  _projected_population_size(0),
+  _sampling_interval(1),
+  _end_ticks(0) {}
+
+bool JfrSamplerWindow::sample() {
+  const intptr_t ordinal = Atomic::add_ptr(1, &_measured_population_size);
+  return ordinal <= _projected_population_size && ordinal % _sampling_interval == 0;
+}
+
+intptr_t JfrSamplerWindow::population_size() const {
+  return _measured_population_size;
+}
+
+intptr_t JfrSamplerWindow::sample_size() const {
+  return MIN2(population_size(), _projected_population_size) / _sampling_interval;
+}
+
+JfrEventThrottler* volatile JfrEventThrottler::_throttlers[MaxJfrEventId] = { NULL };
+
+JfrEventThrottler::JfrEventThrottler() :
+  _active_window(&_windows[0]),
+  _lock(0),
+  _sample_size(-1),
+  _period_millis(0),
+  _avg_population_size(0),
+  _sample_debt(0) {}
+
+bool JfrEventThrottler::sample() {
+  JfrSamplerWindow* const window = (JfrSamplerWindow*)OrderAccess::load_ptr_acquire(&_active_window);
+  const jlong now = JfrTicks::now().value();
+  if (window->is_expired(now)) {
+    // the thread that gets the lock sets up the next window, the
+    // commits racing with it are not sampled
+    JfrTryLock lock(&_lock);
+    if (lock.has_lock() && window == _active_window) {
+      rotate(window, now);
+    }
+    return _sample_size < 0;
+  }
+  return _sample_size < 0 || window->sample();
+}
+
+// Projects the population of the next window from a moving average and
+// picks the sampling interval that spreads the window's samples over it.
+// Samples the expired window fell short of are carried over, up to one
+// window's worth.
+void JfrEventThrottler::rotate(JfrSamplerWindow* expired, jlong now) {
+  assert(_lock == 1, "invariant");
+  JfrSamplerWindow* const next = (expired == &_windows[0]) ? &_windows[1] : &_windows[0];
+  jlong window_samples = _sample_size;
+  jlong window_millis = _period_millis;
+  if (_sample_size >= windows_per_period) {
+    window_samples = _sample_size / windows_per_period;
+    window_millis = _period_millis / windows_per_period;
+  }
+  window_millis = MAX2(window_millis, (jlong)1);
+
+  const intptr_t population = expired->population_size();
+  if (expired->_end_ticks != 0) {
+    _avg_population_size += (population - _avg_population_size) / window_lookback_count;
+    _sample_debt = MIN2((intptr_t)window_samples,
+                        MAX2((intptr_t)window_samples - expired->sample_size(), (intptr_t)0));
+  } else {
+    // first window, no history yet
+    _avg_population_size = 0;
+    _sample_debt = 0;
+  }
+
+  const intptr_t samples = (intptr_t)MAX2(window_samples, (jlong)0) + _sample_debt;
+  intptr_t interval = 1;
+  if (samples > 0 && _avg_population_size > samples) {
+    interval = (intptr_t)(_avg_population_size / samples);
+  }
+  next->_sampling_interval = interval;
+  next->_projected_population_size = samples * interval;
+  next->_measured_population_size = 0;
+  next->_end_ticks = now + JfrTimeConverter::nanos_to_countertime(window_millis * NANOSECS_PER_MILLISEC);
+  OrderAccess::release_store_ptr(&_active_window, next);
+}
+
+void JfrEventThrottler::configure(jlong sample_size, jlong period_millis) {
+  while (true) {
+    JfrTryLock lock(&_lock);
+    if (lock.has_lock()) {
+      _sample_size = sample_size;
+      _period_millis = MAX2(period_millis, (jlong)1);
+      // start over with the new rate at the next commit
+      _windows[0]._end_ticks = 0;
+      _windows[1]._end_ticks = 0;
+      _active_window = &_windows[0];
+      return;
+    }
+    os::yield();
+  }
+}
+
+bool JfrEventThrottler::set_throttle(jlong id, jlong sample_size, jlong period_millis) {
+  if (id < NUM_RESERVED_EVENTS || id >= MaxJfrEventId) {
+    return false;
+  }
+  const JfrEventId event_id = (JfrEventId)id;
+  JfrEventThrottler* throttler = _throttlers[event_id];
+  if (throttler == NULL) {
+    if (sample_size < 0) {
+      // not throttled
+      return true;
+    }
+    throttler = new JfrEventThrottler();
+    if (throttler == NULL) {
+      return false;
+    }
+    throttler->configure(sample_size, period_millis);
+    if (Atomic::cmpxchg_ptr(throttler, &_throttlers[event_id], NULL) != NULL) {
+      // lost the race, configure the installed one
+      delete throttler;
+      throttler = _throttlers[event_id];
+    } else {
+      return true;
+    }
+  }
+  throttler->configure(sample_size, period_millis);
+  return true;
+}
@@ -0,0 +1,82 @@
+/*
+* Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* This code is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License version 2 only, as
+* published by the Free Software Foundation.
+*
+* This code is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+* version 2 for more details (a copy is included in the LICENSE file that
+* accompanied this code).
+*
+* You should have received a copy of the GNU General Public License version
+* 2 along with this work; if not, write to the Free Software Foundation,
+* Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+*
+* Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+* or visit www.oracle.com if you need additional information or have any
+* questions.
+*
+*/
+
+#ifndef SHARE_VM_JFR_SUPPORT_JFREVENTTHROTTLER_HPP
+#define SHARE_VM_JFR_SUPPORT_JFREVENTTHROTTLER_HPP
+
+#include "jfr/utilities/jfrAllocation.hpp"
+#include "jfrfiles/jfrEventIds.hpp"
+
+//
+// Rate limits a high-frequency native event to a target number of events
+// per period. Time is divided into windows; in each window every n-th
+// commit is accepted, where n is chosen from a moving average of the
+// number of commits in past windows, and no more than the window's share
+// of the period's samples are accepted.
+//
+class JfrSamplerWindow : public JfrCHeapObj {
+  friend class JfrEventThrottler;
+ private:
+  volatile intptr_t _measured_population_size;
+  intptr_t _projected_population_size;
+  intptr_t _sampling_interval;
+  jlong _end_ticks;
+
+  JfrSamplerWindow();
+  bool is_expired(jlong now) const { return now >= _end_ticks; }
+  bool sample();
+  intptr_t population_size() const;
+  intptr_t sample_size() const;
+};
+
+class JfrEventThrottler : public JfrCHeapObj {
+ private:
+  JfrSamplerWindow _windows[2];
+  JfrSamplerWindow* volatile _active_window;
+  volatile int _lock;
+  jlong _sample_size;             // per period, < 0 to accept all events
+  jlong _period_millis;
+  double _avg_population_size;    // per window
+  intptr_t _sample_debt;          // samples the last window fell short
+
+  static JfrEventThrottler* volatile _throttlers[MaxJfrEventId];
+
+  JfrEventThrottler();
+  bool sample();
+  void rotate(JfrSamplerWindow* expired, jlong now);
+  void configure(jlong sample_size, jlong period_millis);
+
+ public:
+  // sample_size events per period_millis, a negative sample_size removes
+  // the throttle; only native events can be throttled
+  static bool set_throttle(jlong id, jlong sample_size, jlong period_millis);
+
+  // called in the commit path of the event
+  static bool accept(JfrEventId event_id) {
+    JfrEventThrottler* const throttler = _throttlers[event_id];
+    return throttler == NULL || throttler->sample();
+  }
+};
+
+#endif // SHARE_VM_JFR_SUPPORT_JFREVENTTHROTTLER_HPP
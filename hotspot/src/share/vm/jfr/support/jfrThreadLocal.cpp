@@ -26,6 +26,7 @@
 #include "jfr/jfrEvents.hpp"
 #include "jfr/jni/jfrJavaSupport.hpp"
 #include "jfr/periodic/jfrThreadCPULoadEvent.hpp"
+#include "jfr/periodic/sampling/jfrCPUTimeThreadSampler.hpp"
 #include "jfr/recorder/jfrRecorder.hpp"
 #include "jfr/recorder/checkpoint/jfrCheckpointManager.hpp"
 #include "jfr/recorder/checkpoint/types/traceid/jfrTraceId.inline.hpp"
@@ -45,6 +46,7 @@ JfrThreadLocal::JfrThreadLocal() :
   _native_buffer(NULL),
   _shelved_buffer(NULL),
   _stackframes(NULL),
+  _cpu_time_samples(NULL),
   _trace_id(JfrTraceId::assign_thread_id()),
   _thread_cp(),
   _data_lost(0),
@@ -89,6 +91,9 @@ void JfrThreadLocal::on_start(Thread* t) {
       send_java_thread_start_event((JavaThread*)t);
     }
   }
+  if (t->is_Java_thread()) {
+    JfrCPUTimeThreadSampling::on_javathread_start((JavaThread*)t);
+  }
 }
 
 static void send_java_thread_end_events(traceid id, JavaThread* jt) {
@@ -132,6 +137,9 @@ void JfrThreadLocal::on_exit(Thread* t) {
       send_java_thread_end_events(tl->thread_id(), (JavaThread*)t);
     }
   }
+  if (t->is_Java_thread()) {
+    JfrCPUTimeThreadSampling::on_javathread_exit((JavaThread*)t);
+  }
   release(tl, Thread::current()); // because it could be that Thread::current() != t
 }
 
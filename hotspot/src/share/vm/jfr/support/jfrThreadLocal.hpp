@@ -30,6 +30,7 @@
 
 class JavaThread;
 class JfrBuffer;
+class JfrCPUTimeSampleBuffer;
 class JfrStackFrame;
 class Thread;
 
@@ -40,6 +41,7 @@ class JfrThreadLocal {
   mutable JfrBuffer* _native_buffer;
   JfrBuffer* _shelved_buffer;
   mutable JfrStackFrame* _stackframes;
+  JfrCPUTimeSampleBuffer* volatile _cpu_time_samples;
   mutable traceid _trace_id;
   JfrCheckpointBlobHandle _thread_cp;
   u8 _data_lost;
@@ -115,6 +117,14 @@ class JfrThreadLocal {
 
   u4 stackdepth() const;
 
+  JfrCPUTimeSampleBuffer* cpu_time_samples() const {
+    return _cpu_time_samples;
+  }
+
+  void set_cpu_time_samples(JfrCPUTimeSampleBuffer* buffer) {
+    _cpu_time_samples = buffer;
+  }
+
   void set_stackdepth(u4 depth) {
     _stackdepth = depth;
   }
@@ -25,17 +25,15 @@
 #include "precompiled.hpp"
 #include "jfr/utilities/jfrTime.hpp"
 #include "runtime/os.hpp"
-#if defined(X86) && !defined(ZERO)
-#include "rdtsc_x86.hpp"
-#endif
+#include "utilities/fastTimeCounter.hpp"
 
 bool JfrTime::_ft_enabled = false;
 
 bool JfrTime::initialize() {
   static bool initialized = false;
   if (!initialized) {
-#if defined(X86) && !defined(ZERO)
-    _ft_enabled = Rdtsc::initialize();
+#ifdef FAST_TIME_COUNTER
+    _ft_enabled = FastTimeCounter::initialize();
 #else
     _ft_enabled = false;
 #endif
@@ -45,8 +43,8 @@ bool JfrTime::initialize() {
 }
 
 bool JfrTime::is_ft_supported() {
-#if defined(X86) && !defined(ZERO)
-  return Rdtsc::is_supported();
+#ifdef FAST_TIME_COUNTER
+  return FastTimeCounter::is_supported();
 #else
   return false;
 #endif
@@ -54,16 +52,16 @@ bool JfrTime::is_ft_supported() {
 
 
 const void* JfrTime::time_function() {
-#if defined(X86) && !defined(ZERO)
-  return _ft_enabled ? (const void*)Rdtsc::elapsed_counter : (const void*)os::elapsed_counter;
+#ifdef FAST_TIME_COUNTER
+  return _ft_enabled ? (const void*)FastTimeCounter::elapsed_counter : (const void*)os::elapsed_counter;
 #else
   return (const void*)os::elapsed_counter;
 #endif
 }
 
 jlong JfrTime::frequency() {
-#if defined(X86) && !defined(ZERO)
-  return _ft_enabled ? Rdtsc::frequency() : os::elapsed_frequency();
+#ifdef FAST_TIME_COUNTER
+  return _ft_enabled ? FastTimeCounter::frequency() : os::elapsed_frequency();
 #else
   return os::elapsed_frequency();
 #endif
@@ -33,6 +33,7 @@
 #include "runtime/os.hpp"
 #include "runtime/task.hpp"
 #include "runtime/threadCritical.hpp"
+#include "runtime/threadLocalStorage.hpp"
 #include "services/memTracker.hpp"
 #include "utilities/ostream.hpp"
 
@@ -231,11 +232,21 @@ void trace_heap_free(void* p) {
 
 // MT-safe pool of chunks to reduce malloc/free thrashing
 // NB: not using Mutex because pools are used before Threads are initialized
+// Besides the global list of a ChunkPool, threads that are not Java
+// threads, and compiler threads, keep one chunk of each standard size for
+// themselves. They are few, long lived and grow their resource areas all
+// the time, and would otherwise keep contending on ThreadCritical. The
+// thread caches are bounded and so not cleaned.
 class ChunkPool: public CHeapObj<mtInternal> {
   Chunk*       _first;        // first cached Chunk; its first word points to next chunk
   size_t       _num_chunks;   // number of unused chunks in pool
   size_t       _num_used;     // number of chunks currently checked out
   const size_t _size;         // size of each chunk (must be uniform)
+  const int    _cache_index;  // slot in Thread::cached_chunks(), or -1
+
+  enum {
+    num_huge_pools = 5        // 64K to 1M
+  };
 
   // Our four static pools
   static ChunkPool* _large_pool;
@@ -243,6 +254,22 @@ class ChunkPool: public CHeapObj<mtInternal> {
   static ChunkPool* _small_pool;
   static ChunkPool* _tiny_pool;
 
+  // Pools for the power of two sizes Chunk::huge_size_for() returns
+  static ChunkPool* _huge_pools[num_huge_pools];
+
+  // The thread whose cache to use, or NULL
+  Thread* cache_thread() const {
+    if (_cache_index < 0 || !ThreadLocalStorage::is_initialized()) {
+      return NULL;
+    }
+    Thread* thread = ThreadLocalStorage::thread();
+    if (thread == NULL || !thread->chunk_cache_enabled() ||
+        (thread->is_Java_thread() && !thread->is_Compiler_thread())) {
+      return NULL;
+    }
+    return thread;
+  }
+
   // return first element or null
   void* get_first() {
     Chunk* c = _first;
@@ -255,11 +282,19 @@ class ChunkPool: public CHeapObj<mtInternal> {
 
  public:
   // All chunks in a ChunkPool has the same size
-   ChunkPool(size_t size) : _size(size) { _first = NULL; _num_chunks = _num_used = 0; }
+   ChunkPool(size_t size, int cache_index = -1) : _size(size), _cache_index(cache_index) {
+     _first = NULL; _num_chunks = _num_used = 0;
+   }
 
   // Allocate a new chunk from the pool (might expand the pool)
   _NOINLINE_ void* allocate(size_t bytes, AllocFailType alloc_failmode) {
     assert(bytes == _size, "bad size");
+    Thread* thread = cache_thread();
+    if (thread != NULL && thread->cached_chunks()[_cache_index] != NULL) {
+      Chunk* c = thread->cached_chunks()[_cache_index];
+      thread->cached_chunks()[_cache_index] = NULL;
+      return c;
+    }
     void* p = NULL;
     // No VM lock can be taken inside ThreadCritical lock, so os::malloc
     // should be done outside ThreadCritical lock due to NMT
@@ -277,6 +312,11 @@ class ChunkPool: public CHeapObj<mtInternal> {
   // Return a chunk to the pool
   void free(Chunk* chunk) {
     assert(chunk->length() + Chunk::aligned_overhead_size() == _size, "bad size");
+    Thread* thread = cache_thread();
+    if (thread != NULL && thread->cached_chunks()[_cache_index] == NULL) {
+      thread->cached_chunks()[_cache_index] = chunk;
+      return;
+    }
     ThreadCritical tc;
     _num_used--;
 
@@ -323,19 +363,45 @@ class ChunkPool: public CHeapObj<mtInternal> {
   static ChunkPool* small_pool()  { assert(_small_pool  != NULL, "must be initialized"); return _small_pool;  }
   static ChunkPool* tiny_pool()   { assert(_tiny_pool   != NULL, "must be initialized"); return _tiny_pool;   }
 
+  // The pool for chunks of the given length, or NULL if they are not pooled
+  static ChunkPool* pool_for(size_t length) {
+    switch (length) {
+     case Chunk::size:        return large_pool();
+     case Chunk::medium_size: return medium_pool();
+     case Chunk::init_size:   return small_pool();
+     case Chunk::tiny_size:   return tiny_pool();
+     default: {
+       size_t bytes = length + Chunk::slack;
+       if (length < (size_t) Chunk::huge_min_size || length > (size_t) Chunk::huge_max_size ||
+           !is_power_of_2((intptr_t) bytes)) {
+         return NULL;
+       }
+       return _huge_pools[log2_intptr(bytes) - log2_intptr((uintptr_t) Chunk::huge_min_size + Chunk::slack)];
+     }
+    }
+  }
+
   static void initialize() {
-    _large_pool  = new ChunkPool(Chunk::size        + Chunk::aligned_overhead_size());
-    _medium_pool = new ChunkPool(Chunk::medium_size + Chunk::aligned_overhead_size());
-    _small_pool  = new ChunkPool(Chunk::init_size   + Chunk::aligned_overhead_size());
-    _tiny_pool   = new ChunkPool(Chunk::tiny_size   + Chunk::aligned_overhead_size());
+    _large_pool  = new ChunkPool(Chunk::size        + Chunk::aligned_overhead_size(), 3);
+    _medium_pool = new ChunkPool(Chunk::medium_size + Chunk::aligned_overhead_size(), 2);
+    _small_pool  = new ChunkPool(Chunk::init_size   + Chunk::aligned_overhead_size(), 1);
+    _tiny_pool   = new ChunkPool(Chunk::tiny_size   + Chunk::aligned_overhead_size(), 0);
+    size_t length = Chunk::huge_min_size;
+    for (int i = 0; i < num_huge_pools; i++) {
+      _huge_pools[i] = new ChunkPool(length + Chunk::aligned_overhead_size());
+      length = (length + Chunk::slack) * 2 - Chunk::slack;
+    }
   }
 
   static void clean() {
-    enum { BlocksToKeep = 5 };
+    enum { BlocksToKeep = 5, HugeBlocksToKeep = 1 };
      _tiny_pool->free_all_but(BlocksToKeep);
      _small_pool->free_all_but(BlocksToKeep);
      _medium_pool->free_all_but(BlocksToKeep);
      _large_pool->free_all_but(BlocksToKeep);
+     for (int i = 0; i < num_huge_pools; i++) {
+       _huge_pools[i]->free_all_but(HugeBlocksToKeep);
+     }
   }
 };
 
@@ -343,6 +409,7 @@ ChunkPool* ChunkPool::_large_pool  = NULL;
 ChunkPool* ChunkPool::_medium_pool = NULL;
 ChunkPool* ChunkPool::_small_pool  = NULL;
 ChunkPool* ChunkPool::_tiny_pool   = NULL;
+ChunkPool* ChunkPool::_huge_pools[ChunkPool::num_huge_pools];
 
 void chunkpool_init() {
   ChunkPool::initialize();
@@ -378,30 +445,36 @@ void* Chunk::operator new (size_t requested_size, AllocFailType alloc_failmode,
   // expect requested_size but if sizeof(Chunk) doesn't match isn't proper size we must align it.
   assert(ARENA_ALIGN(requested_size) == aligned_overhead_size(), "Bad alignment");
   size_t bytes = ARENA_ALIGN(requested_size) + length;
-  switch (length) {
-   case Chunk::size:        return ChunkPool::large_pool()->allocate(bytes, alloc_failmode);
-   case Chunk::medium_size: return ChunkPool::medium_pool()->allocate(bytes, alloc_failmode);
-   case Chunk::init_size:   return ChunkPool::small_pool()->allocate(bytes, alloc_failmode);
-   case Chunk::tiny_size:   return ChunkPool::tiny_pool()->allocate(bytes, alloc_failmode);
-   default: {
-     void* p = os::malloc(bytes, mtChunk, CALLER_PC);
-     if (p == NULL && alloc_failmode == AllocFailStrategy::EXIT_OOM) {
-       vm_exit_out_of_memory(bytes, OOM_MALLOC_ERROR, "Chunk::new");
-     }
-     return p;
-   }
+  ChunkPool* pool = ChunkPool::pool_for(length);
+  if (pool != NULL) {
+    return pool->allocate(bytes, alloc_failmode);
+  }
+  void* p = os::malloc(bytes, mtChunk, CALLER_PC);
+  if (p == NULL && alloc_failmode == AllocFailStrategy::EXIT_OOM) {
+    vm_exit_out_of_memory(bytes, OOM_MALLOC_ERROR, "Chunk::new");
   }
+  return p;
 }
 
 void Chunk::operator delete(void* p) {
   Chunk* c = (Chunk*)p;
-  switch (c->length()) {
-   case Chunk::size:        ChunkPool::large_pool()->free(c); break;
-   case Chunk::medium_size: ChunkPool::medium_pool()->free(c); break;
-   case Chunk::init_size:   ChunkPool::small_pool()->free(c); break;
-   case Chunk::tiny_size:   ChunkPool::tiny_pool()->free(c); break;
-   default:                 os::free(c, mtChunk);
+  ChunkPool* pool = ChunkPool::pool_for(c->length());
+  if (pool != NULL) {
+    pool->free(c);
+  } else {
+    os::free(c, mtChunk);
+  }
+}
+
+size_t Chunk::huge_size_for(size_t x) {
+  if (x > (size_t) huge_max_size) {
+    return x;
+  }
+  size_t length = huge_min_size;
+  while (length < x) {
+    length = (length + slack) * 2 - slack;
   }
+  return length;
 }
 
 Chunk::Chunk(size_t length) : _len(length) {
@@ -553,7 +626,9 @@ void Arena::signal_out_of_memory(size_t sz, const char* whence) const {
 // Grow a new Chunk
 void* Arena::grow(size_t x, AllocFailType alloc_failmode) {
   // Get minimal required size.  Either real big, or even bigger for giant objs
-  size_t len = MAX2(x, (size_t) Chunk::size);
+  // Either the default size or, for big objects, one of the pooled
+  // larger sizes if there is one
+  size_t len = x <= (size_t) Chunk::size ? (size_t) Chunk::size : Chunk::huge_size_for(x);
 
   Chunk *k = _chunk;            // Get filled-up chunk address
   _chunk = new (alloc_failmode, len) Chunk(len);
@@ -341,7 +341,13 @@ class Chunk: CHeapObj<mtChunk> {
     init_size  =  1*K  - slack, // Size of first chunk (normal aka small)
     medium_size= 10*K  - slack, // Size of medium-sized chunk
     size       = 32*K  - slack, // Default size of an Arena chunk (following the first)
-    non_pool_size = init_size + 32 // An initial size which is not one of above
+    non_pool_size = init_size + 32, // An initial size which is not one of above
+    // Chunks for larger allocations are rounded up to a power of two
+    // minus slack between these sizes, so that they can be pooled too
+    huge_min_size = 64*K - slack,
+    huge_max_size = 1*M  - slack,
+    // Number of pooled sizes a thread keeps a chunk of, see ChunkPool
+    num_thread_cached_sizes = 4
   };
 
   void chop();                  // Chop this chunk
@@ -349,6 +355,9 @@ class Chunk: CHeapObj<mtChunk> {
   static size_t aligned_overhead_size(void) { return ARENA_ALIGN(sizeof(Chunk)); }
   static size_t aligned_overhead_size(size_t byte_size) { return ARENA_ALIGN(byte_size); }
 
+  // Length of the chunk to allocate for x bytes larger than Chunk::size
+  static size_t huge_size_for(size_t x);
+
   size_t length() const         { return _len;  }
   Chunk* next() const           { return _next;  }
   void set_next(Chunk* n)       { _next = n;  }
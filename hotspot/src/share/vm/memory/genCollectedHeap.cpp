@@ -58,6 +58,7 @@
 #if INCLUDE_ALL_GCS
 #include "gc_implementation/concurrentMarkSweep/concurrentMarkSweepThread.hpp"
 #include "gc_implementation/concurrentMarkSweep/vmCMSOperations.hpp"
+#include "gc_implementation/g1/g1StringDedup.hpp"
 #endif // INCLUDE_ALL_GCS
 #if INCLUDE_JFR
 #include "jfr/jfr.hpp"
@@ -226,6 +227,22 @@ void GenCollectedHeap::post_initialize() {
                                  old_gen->capacity(),
                                  def_new_gen->from()->capacity());
   policy->initialize_gc_policy_counters();
+
+#if INCLUDE_ALL_GCS
+  // String deduplication relies on ParNew to enqueue candidates and
+  // to process the deduplication queue and table during young GCs.
+  if (UseConcMarkSweepGC && UseParNewGC) {
+    G1StringDedup::initialize();
+  }
+#endif // INCLUDE_ALL_GCS
+}
+
+void GenCollectedHeap::stop() {
+#if INCLUDE_ALL_GCS
+  if (G1StringDedup::is_enabled()) {
+    G1StringDedup::stop();
+  }
+#endif // INCLUDE_ALL_GCS
 }
 
 void GenCollectedHeap::ref_processing_init() {
@@ -1224,6 +1241,9 @@ void GenCollectedHeap::gc_threads_do(ThreadClosure* tc) const {
   if (UseConcMarkSweepGC) {
     ConcurrentMarkSweepThread::threads_do(tc);
   }
+  if (G1StringDedup::is_enabled()) {
+    G1StringDedup::threads_do(tc);
+  }
 #endif // INCLUDE_ALL_GCS
 }
 
@@ -1235,6 +1255,9 @@ void GenCollectedHeap::print_gc_threads_on(outputStream* st) const {
   if (UseConcMarkSweepGC) {
     ConcurrentMarkSweepThread::print_all_on(st);
   }
+  if (G1StringDedup::is_enabled()) {
+    G1StringDedup::print_worker_threads_on(st);
+  }
 #endif // INCLUDE_ALL_GCS
 }
 
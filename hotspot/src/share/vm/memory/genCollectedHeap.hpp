@@ -127,6 +127,9 @@ public:
   // Does operations required after initialization has been done.
   void post_initialize();
 
+  // Stop the string deduplication threads, if any, before shutdown.
+  virtual void stop();
+
   // Initialize ("weak") refs processing support
   virtual void ref_processing_init();
 
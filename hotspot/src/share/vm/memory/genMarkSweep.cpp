@@ -51,6 +51,10 @@
 #include "runtime/vmThread.hpp"
 #include "utilities/copy.hpp"
 #include "utilities/events.hpp"
+#include "utilities/macros.hpp"
+#if INCLUDE_ALL_GCS
+#include "gc_implementation/g1/g1StringDedup.hpp"
+#endif // INCLUDE_ALL_GCS
 
 void GenMarkSweep::invoke_at_safepoint(int level, ReferenceProcessor* rp, bool clear_all_softrefs) {
   guarantee(level == 1, "We always collect both old and young.");
@@ -240,6 +244,13 @@ void GenMarkSweep::mark_sweep_phase1(int level,
   // Delete entries for dead interned strings.
   StringTable::unlink(&is_alive);
 
+#if INCLUDE_ALL_GCS
+  // Delete entries for dead string deduplication candidates and table entries.
+  if (G1StringDedup::is_enabled()) {
+    G1StringDedup::unlink(&is_alive);
+  }
+#endif // INCLUDE_ALL_GCS
+
   // Clean up unreferenced symbols in symbol table.
   SymbolTable::unlink();
 
@@ -303,6 +314,12 @@ void GenMarkSweep::mark_sweep_phase3(int level) {
 
   gch->gen_process_weak_roots(&adjust_pointer_closure);
 
+#if INCLUDE_ALL_GCS
+  if (G1StringDedup::is_enabled()) {
+    G1StringDedup::oops_do(&adjust_pointer_closure);
+  }
+#endif // INCLUDE_ALL_GCS
+
   adjust_marks();
   GenAdjustPointersClosure blk;
   gch->generation_iterate(&blk, true);
@@ -25,6 +25,7 @@
 #include "precompiled.hpp"
 #include "memory/heap.hpp"
 #include "oops/oop.inline.hpp"
+#include "runtime/mutexLocker.hpp"
 #include "runtime/os.hpp"
 #include "services/memTracker.hpp"
 
@@ -35,7 +36,8 @@ size_t CodeHeap::header_size() {
 
 // Implementation of Heap
 
-CodeHeap::CodeHeap() {
+CodeHeap::CodeHeap(const char* name) {
+  _name                         = name;
   _number_of_committed_segments = 0;
   _number_of_reserved_segments  = 0;
   _segment_size                 = 0;
@@ -90,29 +92,49 @@ void CodeHeap::on_code_mapping(char* base, size_t size) {
 bool CodeHeap::reserve(size_t reserved_size, size_t committed_size,
                        size_t segment_size) {
   assert(reserved_size >= committed_size, "reserved < committed");
-  assert(segment_size >= sizeof(FreeBlock), "segment size is too small");
-  assert(is_power_of_2(segment_size), "segment_size must be a power of 2");
-
-  _segment_size      = segment_size;
-  _log2_segment_size = exact_log2(segment_size);
 
   // Reserve and initialize space for _memory.
   size_t page_size = os::vm_page_size();
-  if (os::can_execute_large_page_memory()) {
+  if (UseLargePagesInCodeCache && os::can_execute_large_page_memory()) {
     page_size = os::page_size_for_region_unaligned(reserved_size, 8);
   }
 
   const size_t granularity = os::vm_allocation_granularity();
   const size_t r_align = MAX2(page_size, granularity);
   const size_t r_size = align_size_up(reserved_size, r_align);
-  const size_t c_size = align_size_up(committed_size, page_size);
 
   const size_t rs_align = page_size == (size_t) os::vm_page_size() ? 0 :
     MAX2(page_size, granularity);
   ReservedCodeSpace rs(r_size, rs_align, rs_align > 0);
-  os::trace_page_sizes("code heap", committed_size, reserved_size, page_size,
+  return reserve(rs, committed_size, segment_size);
+}
+
+// Initializes the heap in the given reserved space, which may be a part
+// of a larger reservation shared with other code heaps.
+bool CodeHeap::reserve(ReservedSpace rs, size_t committed_size,
+                       size_t segment_size) {
+  assert(rs.size() >= committed_size, "reserved < committed");
+  assert(segment_size >= sizeof(FreeBlock), "segment size is too small");
+  assert(is_power_of_2(segment_size), "segment_size must be a power of 2");
+
+  _segment_size      = segment_size;
+  _log2_segment_size = exact_log2(segment_size);
+
+  size_t page_size = os::vm_page_size();
+  if (UseLargePagesInCodeCache && os::can_execute_large_page_memory()) {
+    page_size = os::page_size_for_region_unaligned(rs.size(), 8);
+  }
+
+  const size_t granularity = os::vm_allocation_granularity();
+  const size_t c_size = align_size_up(committed_size, page_size);
+
+  os::trace_page_sizes(_name, committed_size, rs.size(), page_size,
                        rs.base(), rs.size());
-  if (!_memory.initialize(rs, c_size)) {
+  // Commit in small pages too unless the code cache may use large ones;
+  // the granularity otherwise follows the size of the reservation.
+  const size_t commit_granularity = UseLargePagesInCodeCache ?
+    os::page_size_for_region_unaligned(rs.size(), 1) : os::vm_page_size();
+  if (!_memory.initialize_with_granularity(rs, c_size, commit_granularity)) {
     return false;
   }
 
@@ -319,6 +341,18 @@ size_t CodeHeap::allocated_capacity() const {
   return segments_to_size(_next_segment - _freelist_segments);
 }
 
+void CodeHeap::freelist_statistics(size_t* block_count, size_t* largest_block) const {
+  assert_locked_or_safepoint(CodeCache_lock);
+  size_t count = 0;
+  size_t largest = 0;
+  for (FreeBlock* b = _freelist; b != NULL; b = b->link()) {
+    count++;
+    largest = MAX2(largest, b->length());
+  }
+  *block_count = count;
+  *largest_block = segments_to_size(largest);
+}
+
 // Returns size of the unallocated heap block
 size_t CodeHeap::heap_unallocated_capacity() const {
   // Total number of segments - number currently used
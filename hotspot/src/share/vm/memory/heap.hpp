@@ -93,6 +93,8 @@ class CodeHeap : public CHeapObj<mtCode> {
   FreeBlock*   _freelist;
   size_t       _freelist_segments;               // No. of segments in freelist
 
+  const char*  _name;                            // Name of the CodeHeap
+
   // Helper functions
   size_t   size_to_segments(size_t size) const { return (size + _segment_size - 1) >> _log2_segment_size; }
   size_t   segments_to_size(size_t number_of_segments) const { return number_of_segments << _log2_segment_size; }
@@ -122,10 +124,11 @@ class CodeHeap : public CHeapObj<mtCode> {
   void on_code_mapping(char* base, size_t size);
 
  public:
-  CodeHeap();
+  CodeHeap(const char* name = "CodeHeap");
 
   // Heap extents
   bool  reserve(size_t reserved_size, size_t committed_size, size_t segment_size);
+  bool  reserve(ReservedSpace rs, size_t committed_size, size_t segment_size);
   void  release();                               // releases all allocated memory
   bool  expand_by(size_t size);                  // expands commited memory by size
   void  shrink_by(size_t size);                  // shrinks commited memory by size
@@ -158,6 +161,11 @@ class CodeHeap : public CHeapObj<mtCode> {
   size_t max_capacity() const;
   size_t allocated_capacity() const;
   size_t unallocated_capacity() const            { return max_capacity() - allocated_capacity(); }
+  size_t freelist_capacity() const               { return segments_to_size(_freelist_segments); }
+  // Number of blocks on the freelist and size of the largest one (caller must hold CodeCache_lock)
+  void   freelist_statistics(size_t* block_count, size_t* largest_block) const;
+
+  const char* name() const                       { return _name; }
 
 private:
   size_t heap_unallocated_capacity() const;
@@ -28,9 +28,13 @@
 #include "memory/genCollectedHeap.hpp"
 #include "memory/heapInspection.hpp"
 #include "memory/resourceArea.hpp"
+#include "runtime/mutexLocker.hpp"
 #include "runtime/os.hpp"
+#include "runtime/safepoint.hpp"
+#include "runtime/thread.inline.hpp"
 #include "utilities/globalDefinitions.hpp"
 #include "utilities/macros.hpp"
+#include "utilities/workgroup.hpp"
 #if INCLUDE_ALL_GCS
 #include "gc_implementation/parallelScavenge/parallelScavengeHeap.hpp"
 #endif // INCLUDE_ALL_GCS
@@ -189,6 +193,39 @@ bool KlassInfoTable::record_instance(const oop obj) {
   }
 }
 
+class KlassInfoTableMergeClosure : public KlassInfoClosure {
+ private:
+  KlassInfoTable* _dest;
+  size_t          _missed_count;
+ public:
+  KlassInfoTableMergeClosure(KlassInfoTable* dest) : _dest(dest), _missed_count(0) {}
+
+  void do_cinfo(KlassInfoEntry* cie) {
+    if (!_dest->merge_entry(cie)) {
+      _missed_count += cie->count();
+    }
+  }
+
+  size_t missed_count() const { return _missed_count; }
+};
+
+bool KlassInfoTable::merge_entry(const KlassInfoEntry* cie) {
+  KlassInfoEntry* elt = lookup(cie->klass());
+  if (elt == NULL) {
+    return false;
+  }
+  elt->set_count(elt->count() + cie->count());
+  elt->set_words(elt->words() + cie->words());
+  _size_of_instances_in_words += cie->words();
+  return true;
+}
+
+size_t KlassInfoTable::merge(KlassInfoTable* table) {
+  KlassInfoTableMergeClosure cl(this);
+  table->iterate(&cl);
+  return cl.missed_count();
+}
+
 void KlassInfoTable::iterate(KlassInfoClosure* cic) {
   assert(_size == 0 || _buckets != NULL, "Allocation failure should have been caught");
   for (int index = 0; index < _size; index++) {
@@ -332,6 +369,7 @@ void KlassInfoHisto::print_class_stats(outputStream* st,
       sz._inst_count = e->count();
       sz._inst_bytes = HeapWordSize * e->words();
       k->collect_statistics(&sz);
+      sz._inst_padding_bytes = sz._inst_padding * sz._inst_count;
       sz._total_bytes = sz._ro_bytes + sz._rw_bytes;
 
       if (pass == 1) {
@@ -380,6 +418,7 @@ void KlassInfoHisto::print_class_stats(outputStream* st,
   }
 
   sz_sum._inst_size = 0;
+  sz_sum._inst_padding = 0;
 
   if (csv_format) {
     st->print(",");
@@ -400,6 +439,7 @@ void KlassInfoHisto::print_class_stats(outputStream* st,
           switch (c) {
           case KlassSizeStats::_index_inst_size:
           case KlassSizeStats::_index_inst_count:
+          case KlassSizeStats::_index_inst_padding:
           case KlassSizeStats::_index_method_count:
 PRAGMA_DIAG_PUSH
 PRAGMA_FORMAT_NONLITERAL_IGNORED_INTERNAL
@@ -483,11 +523,59 @@ class RecordInstanceClosure : public ObjectClosure {
   }
 };
 
+// Walks the heap with the safepoint workers, each recording into a table
+// of its own that is merged into the shared one when it is done.
+class ParHeapInspectTask : public AbstractGangTask {
+ private:
+  KlassInfoTable*    _shared_cit;
+  BoolObjectClosure* _filter;
+  uint               _num_workers;
+  size_t             _missed_count;
+  Mutex              _mutex;
+
+ public:
+  ParHeapInspectTask(KlassInfoTable* shared_cit, BoolObjectClosure* filter, uint num_workers) :
+    AbstractGangTask("Parallel Heap Inspection"),
+    _shared_cit(shared_cit), _filter(filter), _num_workers(num_workers), _missed_count(0),
+    _mutex(Mutex::leaf, "Parallel heap inspection lock", false) {}
+
+  size_t missed_count() const { return _missed_count; }
+
+  void work(uint worker_id) {
+    KlassInfoTable cit(false);
+    if (cit.allocation_failed()) {
+      // Record straight into the shared table, keeping the others out
+      MutexLockerEx ml(&_mutex, Mutex::_no_safepoint_check_flag);
+      RecordInstanceClosure ric(_shared_cit, _filter);
+      Universe::heap()->object_iterate_parallel(&ric, worker_id, _num_workers);
+      _missed_count += ric.missed_count();
+      return;
+    }
+    RecordInstanceClosure ric(&cit, _filter);
+    Universe::heap()->object_iterate_parallel(&ric, worker_id, _num_workers);
+
+    MutexLockerEx ml(&_mutex, Mutex::_no_safepoint_check_flag);
+    _missed_count += ric.missed_count() + _shared_cit->merge(&cit);
+  }
+};
+
 size_t HeapInspection::populate_table(KlassInfoTable* cit, BoolObjectClosure *filter) {
   ResourceMark rm;
 
+  // The workers can only be borrowed by the VM thread at a safepoint
+  CollectedHeap* heap = Universe::heap();
+  FlexibleWorkGang* workers = heap->get_safepoint_workers();
+  if (ParallelHeapInspection && workers != NULL && workers->active_workers() > 1 &&
+      heap->supports_object_iterate_parallel() &&
+      SafepointSynchronize::is_at_safepoint() && Thread::current()->is_VM_thread()) {
+    ParHeapInspectTask task(cit, filter, workers->active_workers());
+    workers->run_task(&task);
+    heap->object_iterate_parallel_done();
+    return task.missed_count();
+  }
+
   RecordInstanceClosure ric(cit, filter);
-  Universe::heap()->object_iterate(&ric);
+  heap->object_iterate(&ric);
   return ric.missed_count();
 }
 
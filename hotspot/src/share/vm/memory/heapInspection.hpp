@@ -56,6 +56,13 @@
         "java.lang.Class, whose InstBytes also includes the slots " \
         "used to store static fields. InstBytes is not counted in " \
         "ROAll, RWAll or Total") \
+    f(inst_padding, InstPadding, \
+        "Bytes of each object instance of the Java class that hold " \
+        "neither the object header nor a nonstatic field, that is " \
+        "alignment gaps between the fields and padding at the end") \
+    f(inst_padding_bytes, InstPaddingBytes, \
+        "InstPadding * InstCount. InstPaddingBytes is not counted in " \
+        "ROAll, RWAll or Total") \
     f(mirror_bytes, Mirror, \
         "Size of the Klass::java_mirror() object") \
     f(klass_bytes, KlassBytes, \
@@ -251,6 +258,10 @@ class KlassInfoTable: public StackObj {
   KlassInfoTable(bool need_class_stats);
   ~KlassInfoTable();
   bool record_instance(const oop obj);
+  // Adds the counts of table to this one; returns the number of
+  // instances that could not be added for lack of C-heap.
+  size_t merge(KlassInfoTable* table);
+  bool merge_entry(const KlassInfoEntry* cie);
   void iterate(KlassInfoClosure* cic);
   bool allocation_failed() { return _buckets == NULL; }
   size_t size_of_instances_in_words() const;
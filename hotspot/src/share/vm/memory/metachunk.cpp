@@ -55,11 +55,12 @@ Metachunk::Metachunk(size_t word_size,
                      VirtualSpaceNode* container)
     : Metabase<Metachunk>(word_size),
     _top(NULL),
-    _container(container)
+    _container(container),
+    _is_tagged_free(false),
+    _is_payload_released(false)
 {
   _top = initial_top();
 #ifdef ASSERT
-  set_is_tagged_free(false);
   size_t data_word_size = pointer_delta(end(),
                                         _top,
                                         sizeof(MetaWord));
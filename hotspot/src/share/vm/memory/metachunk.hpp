@@ -102,7 +102,12 @@ class Metachunk : public Metabase<Metachunk> {
   // Current allocation top.
   MetaWord* _top;
 
-  DEBUG_ONLY(bool _is_tagged_free;)
+  // Set while the chunk is on one of the ChunkManager free lists.
+  bool _is_tagged_free;
+
+  // Set when the pages of the free chunk past its header have been
+  // given back to the OS.  Cleared when the chunk is reused.
+  bool _is_payload_released;
 
   MetaWord* initial_top() const { return (MetaWord*)this + overhead(); }
   MetaWord* top() const         { return _top; }
@@ -138,10 +143,11 @@ class Metachunk : public Metabase<Metachunk> {
   size_t used_word_size() const;
   size_t free_word_size() const;
 
-#ifdef ASSERT
-  bool is_tagged_free() { return _is_tagged_free; }
+  bool is_tagged_free() const { return _is_tagged_free; }
   void set_is_tagged_free(bool v) { _is_tagged_free = v; }
-#endif
+
+  bool is_payload_released() const { return _is_payload_released; }
+  void set_is_payload_released(bool v) { _is_payload_released = v; }
 
   bool contains(const void* ptr) { return bottom() <= ptr && ptr < _top; }
 
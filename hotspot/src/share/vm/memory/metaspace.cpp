@@ -32,6 +32,7 @@
 #include "memory/gcLocker.hpp"
 #include "memory/metachunk.hpp"
 #include "memory/metaspace.hpp"
+#include "memory/metaspaceAllocationBuffer.hpp"
 #include "memory/metaspaceGCThresholdUpdater.hpp"
 #include "memory/metaspaceShared.hpp"
 #include "memory/metaspaceTracer.hpp"
@@ -43,6 +44,7 @@
 #include "runtime/java.hpp"
 #include "runtime/mutex.hpp"
 #include "runtime/orderAccess.inline.hpp"
+#include "runtime/thread.hpp"
 #include "services/memTracker.hpp"
 #include "services/memoryService.hpp"
 #include "utilities/copy.hpp"
@@ -369,6 +371,16 @@ class VirtualSpaceNode : public CHeapObj<mtClass> {
   // in the node from any freelist.
   void purge(ChunkManager* chunk_manager);
 
+  // Merge runs of adjacent free specialized and small chunks in this
+  // node into medium chunks, so that memory freed by many small class
+  // loaders can be reused by a loader that needs medium chunks.
+  void coalesce_free_chunks(ChunkManager* chunk_manager);
+
+  // Give the pages of the free chunks in this node back to the OS.  The
+  // memory stays committed and is faulted in again on reuse.  Returns
+  // the number of bytes released.
+  size_t release_free_chunk_memory();
+
   // If an allocation doesn't fit in the current node a new node is created.
   // Allocate chunks out of the remaining committed space in this node
   // to avoid wasting that memory.
@@ -461,6 +473,85 @@ void VirtualSpaceNode::purge(ChunkManager* chunk_manager) {
   }
 }
 
+void VirtualSpaceNode::coalesce_free_chunks(ChunkManager* chunk_manager) {
+  const size_t medium_word_size = chunk_manager->free_chunks(MediumIndex)->size();
+  Metachunk* run_start = NULL;
+  size_t run_word_size = 0;
+
+  Metachunk* chunk = first_chunk();
+  Metachunk* invalid_chunk = (Metachunk*) top();
+  while (chunk < invalid_chunk ) {
+    size_t word_size = chunk->word_size();
+    MetaWord* next = ((MetaWord*)chunk) + word_size;
+    bool mergeable = chunk->is_tagged_free() && word_size < medium_word_size;
+    if (!mergeable || run_word_size + word_size > medium_word_size) {
+      // The run cannot be extended to exactly a medium chunk.
+      run_start = NULL;
+      run_word_size = 0;
+    }
+    if (mergeable) {
+      if (run_start == NULL) {
+        run_start = chunk;
+      }
+      run_word_size += word_size;
+      if (run_word_size == medium_word_size) {
+        // Take the chunks of the run off their free lists and put a
+        // single medium chunk covering them on the medium list.
+        MetaWord* run_end = ((MetaWord*)run_start) + run_word_size;
+        Metachunk* c = run_start;
+        while ((MetaWord*)c < run_end) {
+          MetaWord* c_next = ((MetaWord*)c) + c->word_size();
+          chunk_manager->remove_chunk(c);
+          c = (Metachunk*) c_next;
+        }
+        Metachunk* merged = ::new (run_start) Metachunk(medium_word_size, this);
+        merged->set_is_tagged_free(true);
+        chunk_manager->free_chunks(MediumIndex)->return_chunk_at_head(merged);
+        chunk_manager->inc_free_chunks_total(medium_word_size);
+        if (TraceMetadataChunkAllocation && Verbose) {
+          gclog_or_tty->print_cr("VirtualSpaceNode::coalesce_free_chunks: merged "
+                                 PTR_FORMAT " size " SIZE_FORMAT,
+                                 merged, medium_word_size);
+        }
+        run_start = NULL;
+        run_word_size = 0;
+      }
+    }
+    chunk = (Metachunk*) next;
+  }
+}
+
+size_t VirtualSpaceNode::release_free_chunk_memory() {
+  // Large pages cannot be given back piecewise.
+  if (is_pre_committed() || UseLargePagesInMetaspace) {
+    return 0;
+  }
+  const size_t page_size = os::vm_page_size();
+  size_t released = 0;
+
+  Metachunk* chunk = first_chunk();
+  Metachunk* invalid_chunk = (Metachunk*) top();
+  while (chunk < invalid_chunk ) {
+    MetaWord* next = ((MetaWord*)chunk) + chunk->word_size();
+    if (chunk->is_tagged_free() && !chunk->is_payload_released()) {
+      // Keep the chunk header, including the tree links of a humongous
+      // chunk in the dictionary; the walk over the node and the free
+      // lists need it.
+      size_t header_bytes = MAX2(Metachunk::overhead() * BytesPerWord,
+                                 sizeof(TreeChunk<Metachunk, FreeList<Metachunk> >));
+      char* start = (char*)align_ptr_up((char*)chunk->bottom() + header_bytes, page_size);
+      char* end = (char*)align_ptr_down(next, page_size);
+      if (start < end) {
+        os::free_memory(start, pointer_delta(end, start, 1), page_size);
+        chunk->set_is_payload_released(true);
+        released += pointer_delta(end, start, 1);
+      }
+    }
+    chunk = (Metachunk*) next;
+  }
+  return released;
+}
+
 #ifdef ASSERT
 uint VirtualSpaceNode::container_count_slow() {
   uint count = 0;
@@ -1123,6 +1214,23 @@ void VirtualSpaceList::purge(ChunkManager* chunk_manager) {
       prev_vsl = vsl;
     }
   }
+
+  if (MetaspaceElasticChunks) {
+    // Nodes that are still in use may hold many free chunks after class
+    // unloading.  Merge them and give their pages back to the OS.
+    size_t released = 0;
+    VirtualSpaceListIterator iter(virtual_space_list());
+    while (iter.repeat()) {
+      VirtualSpaceNode* vsl = iter.get_next();
+      vsl->coalesce_free_chunks(chunk_manager);
+      released += vsl->release_free_chunk_memory();
+    }
+    if (TraceMetadataChunkAllocation && released > 0) {
+      gclog_or_tty->print_cr("VirtualSpaceList::purge: released " SIZE_FORMAT
+                             "K of free %s Metaspace chunks to the OS",
+                             released / K, is_class() ? "class" : "non-class");
+    }
+  }
 #ifdef ASSERT
   if (purged_vsl != NULL) {
     // List should be stable enough to use an iterator here.
@@ -1865,11 +1973,10 @@ Metachunk* ChunkManager::free_chunks_get(size_t word_size) {
   // Remove it from the links to this freelist
   chunk->set_next(NULL);
   chunk->set_prev(NULL);
-#ifdef ASSERT
   // Chunk is no longer on any freelist. Setting to false make container_count_slow()
-  // work.
+  // and the chunk coalescing work.
   chunk->set_is_tagged_free(false);
-#endif
+  chunk->set_is_payload_released(false);
   chunk->container()->inc_container_count();
 
   slow_locked_verify();
@@ -2088,8 +2195,18 @@ size_t SpaceManager::calc_chunk_size(size_t word_size) {
   // once a medium chunk has been allocated, no more small
   // chunks will be allocated.
   size_t chunk_word_size;
-  if (chunks_in_use(MediumIndex) == NULL &&
-      sum_count_in_chunks_in_use(SmallIndex) < _small_chunk_limit) {
+  bool use_small_chunk;
+  if (MetaspaceElasticChunks) {
+    // Size the chunk after what this manager has taken so far: a class
+    // loader keeps getting small chunks until its chunks add up to a
+    // medium chunk, instead of after a fixed number of small chunks.
+    use_small_chunk = chunks_in_use(MediumIndex) == NULL &&
+                      allocated_chunks_words() + small_chunk_size() <= medium_chunk_size();
+  } else {
+    use_small_chunk = chunks_in_use(MediumIndex) == NULL &&
+                      sum_count_in_chunks_in_use(SmallIndex) < _small_chunk_limit;
+  }
+  if (use_small_chunk) {
     chunk_word_size = (size_t) small_chunk_size();
     if (word_size + Metachunk::overhead() > small_chunk_size()) {
       chunk_word_size = medium_chunk_size();
@@ -2266,7 +2383,7 @@ void ChunkManager::return_chunks(ChunkIndex index, Metachunk* chunks) {
     // Capture the next link before it is changed
     // by the call to return_chunk_at_head();
     Metachunk* next = cur->next();
-    DEBUG_ONLY(cur->set_is_tagged_free(true);)
+    cur->set_is_tagged_free(true);
     list->return_chunk_at_head(cur);
     cur = next;
   }
@@ -2337,9 +2454,7 @@ SpaceManager::~SpaceManager() {
   Metachunk* humongous_chunks = chunks_in_use(HumongousIndex);
 
   while (humongous_chunks != NULL) {
-#ifdef ASSERT
     humongous_chunks->set_is_tagged_free(true);
-#endif
     if (TraceMetadataChunkAllocation && Verbose) {
       gclog_or_tty->print(PTR_FORMAT " (" SIZE_FORMAT ") ",
                           humongous_chunks,
@@ -3200,6 +3315,15 @@ void Metaspace::ergo_initialize() {
     FLAG_SET_ERGO(bool, UseLargePagesInMetaspace, false);
   }
 
+#ifdef LINUX
+  // Transparent huge pages are committed in place and only backed when
+  // touched, so klass metadata and the class space can use them as well.
+  if (UseLargePages && UseTransparentHugePages &&
+      FLAG_IS_DEFAULT(UseLargePagesInMetaspace)) {
+    FLAG_SET_ERGO(bool, UseLargePagesInMetaspace, true);
+  }
+#endif
+
   size_t page_size = os::vm_page_size();
   if (UseLargePages && UseLargePagesInMetaspace) {
     page_size = os::large_page_size();
@@ -3621,8 +3745,14 @@ MetaWord* Metaspace::allocate(ClassLoaderData* loader_data, size_t word_size,
 
   MetadataType mdtype = (type == MetaspaceObj::ClassType) ? ClassType : NonClassType;
 
-  // Try to allocate metadata.
-  MetaWord* result = loader_data->metaspace_non_null()->allocate(word_size, mdtype);
+  // Try to allocate metadata, first from the thread's allocation buffer.
+  MetaWord* result = NULL;
+  if (mdtype == NonClassType) {
+    result = allocate_from_buffer(THREAD, loader_data, word_size);
+  }
+  if (result == NULL) {
+    result = loader_data->metaspace_non_null()->allocate(word_size, mdtype);
+  }
 
   if (result == NULL) {
     tracer()->report_metaspace_allocation_failure(loader_data, word_size, type, mdtype);
@@ -3647,6 +3777,73 @@ MetaWord* Metaspace::allocate(ClassLoaderData* loader_data, size_t word_size,
   return result;
 }
 
+MetaWord* Metaspace::allocate_from_buffer(Thread* thread, ClassLoaderData* loader_data,
+                                          size_t word_size) {
+  MetaspaceAllocationBuffer& mab = thread->metaspace_alloc_buffer();
+  if (mab.loader_data() != loader_data) {
+    return NULL;
+  }
+
+  Metaspace* ms = loader_data->metaspace_non_null();
+  size_t raw_word_size = ms->vsm()->get_raw_word_size(word_size);
+  MetaWord* result = mab.allocate(raw_word_size);
+  if (result != NULL) {
+    return result;
+  }
+
+  // Large requests go straight to the SpaceManager rather than throwing
+  // away most of a buffer.
+  size_t buffer_words = align_size_down(MetaspaceAllocationBufferSize, BytesPerWord) / BytesPerWord;
+  if (raw_word_size > buffer_words / 4) {
+    return NULL;
+  }
+
+  mab.retire();
+  MetaWord* block = ms->allocate(buffer_words, NonClassType);
+  if (block == NULL) {
+    // Let the caller retry the exact size and trigger a GC if needed.
+    return NULL;
+  }
+  mab.fill(block, buffer_words);
+  return mab.allocate(raw_word_size);
+}
+
+void MetaspaceAllocationBuffer::retire() {
+  size_t remaining = free_words();
+  if (remaining > 0) {
+    assert(_loader_data != NULL, "only a bound buffer holds a block");
+    // Blocks too small for the free list dictionary become dark matter.
+    _loader_data->metaspace_non_null()->deallocate(_top, remaining, false);
+  }
+  _top = _end = NULL;
+}
+
+void MetaspaceAllocationBuffer::bind(ClassLoaderData* loader_data) {
+  retire();
+  _loader_data = loader_data;
+}
+
+MetaspaceAllocationBufferMark::MetaspaceAllocationBufferMark(Thread* thread,
+                                                             ClassLoaderData* loader_data) :
+  _thread(thread), _saved_loader_data(NULL),
+  _active(UseMetaspaceAllocationBuffers && !DumpSharedSpaces) {
+  if (_active) {
+    MetaspaceAllocationBuffer& mab = _thread->metaspace_alloc_buffer();
+    _saved_loader_data = mab.loader_data();
+    if (_saved_loader_data != loader_data) {
+      mab.bind(loader_data);
+    }
+  }
+}
+
+MetaspaceAllocationBufferMark::~MetaspaceAllocationBufferMark() {
+  if (_active) {
+    // Always hand back the remainder so a finished class definition does
+    // not pin unused metaspace in its loader.
+    _thread->metaspace_alloc_buffer().bind(_saved_loader_data);
+  }
+}
+
 size_t Metaspace::class_chunk_size(size_t word_size) {
   assert(using_class_space(), "Has to use class space");
   return class_vsm()->calc_chunk_size(word_size);
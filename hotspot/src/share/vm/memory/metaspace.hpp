@@ -66,6 +66,7 @@ class MetaWord;
 class Mutex;
 class outputStream;
 class SpaceManager;
+class Thread;
 class VirtualSpaceList;
 
 // Metaspaces each have a  SpaceManager and allocations
@@ -149,6 +150,11 @@ class Metaspace : public CHeapObj<mtClass> {
   //   allocate(ClassLoaderData*, size_t, bool, MetadataType, TRAPS)
   MetaWord* allocate(size_t word_size, MetadataType mdtype);
 
+  // Bump allocate from the thread's MetaspaceAllocationBuffer if it is
+  // bound to loader_data, refilling it from vsm() when it runs dry.
+  static MetaWord* allocate_from_buffer(Thread* thread, ClassLoaderData* loader_data,
+                                        size_t word_size);
+
   // Virtual Space lists for both classes and other metadata
   static VirtualSpaceList* _space_list;
   static VirtualSpaceList* _class_space_list;
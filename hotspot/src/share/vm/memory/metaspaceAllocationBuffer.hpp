@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_MEMORY_METASPACEALLOCATIONBUFFER_HPP
+#define SHARE_VM_MEMORY_METASPACEALLOCATIONBUFFER_HPP
+
+#include "memory/allocation.hpp"
+#include "utilities/globalDefinitions.hpp"
+
+class ClassLoaderData;
+class Thread;
+
+// MetaspaceAllocationBuffer: the Metaspace analog of a TLAB.
+//
+// While a thread parses a class file it binds its buffer to the defining
+// ClassLoaderData.  Non-class metadata for that loader is then bump
+// allocated from a block carved out of the loader's SpaceManager, so the
+// SpaceManager lock is taken once per refill instead of once per
+// MetadataFactory allocation.  When the buffer is unbound the unused
+// remainder is handed back to the SpaceManager's block free list.
+class MetaspaceAllocationBuffer VALUE_OBJ_CLASS_SPEC {
+  ClassLoaderData* _loader_data;                // loader the buffer is bound to, or NULL
+  MetaWord*        _top;                        // address after last allocation
+  MetaWord*        _end;                        // end of the current block
+
+ public:
+  MetaspaceAllocationBuffer() : _loader_data(NULL), _top(NULL), _end(NULL) {}
+
+  ClassLoaderData* loader_data() const { return _loader_data; }
+  size_t free_words() const            { return pointer_delta(_end, _top, sizeof(MetaWord)); }
+
+  // Bump allocate word_size words, or return NULL if they do not fit.
+  MetaWord* allocate(size_t word_size) {
+    if (free_words() >= word_size) {
+      MetaWord* result = _top;
+      _top += word_size;
+      return result;
+    }
+    return NULL;
+  }
+
+  // Install a freshly allocated block of word_size words.
+  void fill(MetaWord* start, size_t word_size) {
+    assert(_top == _end, "retire the old block first");
+    _top = start;
+    _end = start + word_size;
+  }
+
+  // Return the unused remainder to the bound loader's SpaceManager.
+  void retire();
+
+  // Retire the current block and bind the buffer to loader_data,
+  // which may be NULL.
+  void bind(ClassLoaderData* loader_data);
+};
+
+// Binds the current thread's MetaspaceAllocationBuffer to a loader for
+// the duration of a class definition and restores the previous binding,
+// which a nested class load may have interrupted, on exit.
+class MetaspaceAllocationBufferMark : public StackObj {
+  Thread*          _thread;
+  ClassLoaderData* _saved_loader_data;
+  bool             _active;
+
+ public:
+  MetaspaceAllocationBufferMark(Thread* thread, ClassLoaderData* loader_data);
+  ~MetaspaceAllocationBufferMark();
+};
+
+#endif // SHARE_VM_MEMORY_METASPACEALLOCATIONBUFFER_HPP
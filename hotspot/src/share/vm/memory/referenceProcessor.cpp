@@ -104,7 +104,10 @@ ReferenceProcessor::ReferenceProcessor(MemRegion span,
   _enqueuing_is_done(false),
   _is_alive_non_header(is_alive_non_header),
   _processing_is_mt(mt_processing),
-  _next_id(0)
+  _next_id(0),
+  _phase1_time_ms(0.0),
+  _phase2_time_ms(0.0),
+  _phase3_time_ms(0.0)
 {
   _span = span;
   _discovery_is_atomic = atomic_discovery;
@@ -214,6 +217,10 @@ ReferenceProcessorStats ReferenceProcessor::process_discovered_references(
 
   bool trace_time = PrintGCDetails && PrintReferenceGC;
 
+  _phase1_time_ms = 0.0;
+  _phase2_time_ms = 0.0;
+  _phase3_time_ms = 0.0;
+
   // Soft references
   size_t soft_count = 0;
   {
@@ -272,7 +279,13 @@ ReferenceProcessorStats ReferenceProcessor::process_discovered_references(
     process_phaseJNI(is_alive, keep_alive, complete_gc);
   }
 
-  return ReferenceProcessorStats(soft_count, weak_count, final_count, phantom_count);
+  if (trace_time) {
+    gclog_or_tty->print(", [Ref Phases: phase1 %.3f ms, phase2 %.3f ms, phase3 %.3f ms]",
+                        _phase1_time_ms, _phase2_time_ms, _phase3_time_ms);
+  }
+
+  return ReferenceProcessorStats(soft_count, weak_count, final_count, phantom_count,
+                                 _phase1_time_ms, _phase2_time_ms, _phase3_time_ms);
 }
 
 #ifndef PRODUCT
@@ -738,9 +751,9 @@ public:
                     OopClosure& keep_alive,
                     VoidClosure& complete_gc)
   {
-    Thread* thr = Thread::current();
-    int refs_list_index = ((WorkerThread*)thr)->id();
-    _ref_processor.process_phase1(_refs_lists[refs_list_index], _policy,
+    // Index by task number rather than worker id: balance_queues()
+    // may have moved the Ref's into the first n queues.
+    _ref_processor.process_phase1(_refs_lists[i], _policy,
                                   &is_alive, &keep_alive, &complete_gc);
   }
 private:
@@ -911,17 +924,41 @@ ReferenceProcessor::process_discovered_reflist(
   // of the test.
   bool must_balance = _discovery_is_mt;
 
-  if ((mt_processing && ParallelRefProcBalancingEnabled) ||
-      must_balance) {
-    balance_queues(refs_lists);
-  }
-
   size_t total_list_count = total_count(refs_lists);
 
+  // Only use as many queues as the number of discovered references
+  // warrants; the remaining workers find their queues empty and just
+  // help out by stealing. The queues must then be balanced into the
+  // first ergo_num_q ones.
+  uint saved_num_q = _num_q;
+  if (mt_processing) {
+    uint ergo_num_q = ergo_proc_queue_count(total_list_count);
+    if (ergo_num_q < _num_q) {
+      _num_q = ergo_num_q;
+      must_balance = true;
+    }
+  }
+
   if (PrintReferenceGC && PrintGCDetails) {
     gclog_or_tty->print(", %u refs", total_list_count);
+    if (mt_processing) {
+      gclog_or_tty->print(", %u queues", _num_q);
+    }
   }
 
+  if (total_list_count == 0) {
+    // Nothing to do; skip the phases and their task start-up costs.
+    _num_q = saved_num_q;
+    return 0;
+  }
+
+  if ((mt_processing && ParallelRefProcBalancingEnabled) ||
+      must_balance) {
+    balance_queues(refs_lists);
+  }
+
+  double phase_start = os::elapsedTime();
+
   // Phase 1 (soft refs only):
   // . Traverse the list and remove any SoftReferences whose
   //   referents are not alive, but that should be kept alive for
@@ -942,6 +979,10 @@ ReferenceProcessor::process_discovered_reflist(
            "Policy must be specified for soft references.");
   }
 
+  double phase_end = os::elapsedTime();
+  _phase1_time_ms += (phase_end - phase_start) * MILLIUNITS;
+  phase_start = phase_end;
+
   // Phase 2:
   // . Traverse the list and remove any refs whose referents are alive.
   if (mt_processing) {
@@ -953,6 +994,10 @@ ReferenceProcessor::process_discovered_reflist(
     }
   }
 
+  phase_end = os::elapsedTime();
+  _phase2_time_ms += (phase_end - phase_start) * MILLIUNITS;
+  phase_start = phase_end;
+
   // Phase 3:
   // . Traverse the list and process referents as appropriate.
   if (mt_processing) {
@@ -965,9 +1010,20 @@ ReferenceProcessor::process_discovered_reflist(
     }
   }
 
+  _phase3_time_ms += (os::elapsedTime() - phase_start) * MILLIUNITS;
+
+  _num_q = saved_num_q;
   return total_list_count;
 }
 
+uint ReferenceProcessor::ergo_proc_queue_count(size_t total_refs) const {
+  if (ReferencesPerThread == 0) {
+    return _num_q;
+  }
+  size_t wanted = (total_refs + ReferencesPerThread - 1) / ReferencesPerThread;
+  return (uint)MIN2(MAX2(wanted, (size_t)1), (size_t)_num_q);
+}
+
 void ReferenceProcessor::clean_up_discovered_references() {
   // loop over the lists
   for (uint i = 0; i < _max_num_q * number_of_subclasses_of_ref(); i++) {
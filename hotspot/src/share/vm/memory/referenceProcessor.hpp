@@ -256,6 +256,12 @@ class ReferenceProcessor : public CHeapObj<mtGC> {
   // The maximum MT'ness degree of the queues below
   uint             _max_num_q;
 
+  // Time spent in each processing phase, summed over the reference
+  // types, by the current process_discovered_references call.
+  double           _phase1_time_ms;
+  double           _phase2_time_ms;
+  double           _phase3_time_ms;
+
   // Master array of discovered oops
   DiscoveredList* _discovered_refs;
 
@@ -291,6 +297,10 @@ class ReferenceProcessor : public CHeapObj<mtGC> {
                                     VoidClosure*                 complete_gc,
                                     AbstractRefProcTaskExecutor* task_executor);
 
+  // The number of queues to process total_refs references in: one per
+  // ReferencesPerThread references, but at least one and at most _num_q.
+  uint ergo_proc_queue_count(size_t total_refs) const;
+
   void process_phaseJNI(BoolObjectClosure* is_alive,
                         OopClosure*        keep_alive,
                         VoidClosure*       complete_gc);
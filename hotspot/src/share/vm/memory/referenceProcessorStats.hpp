@@ -30,28 +30,43 @@
 class ReferenceProcessor;
 
 // ReferenceProcessorStats contains statistics about how many references that
-// have been traversed when processing references during garbage collection.
+// have been traversed when processing references during garbage collection,
+// and how long each of the processing phases took in total over all
+// reference types.
 class ReferenceProcessorStats {
   size_t _soft_count;
   size_t _weak_count;
   size_t _final_count;
   size_t _phantom_count;
 
+  double _phase1_time_ms;
+  double _phase2_time_ms;
+  double _phase3_time_ms;
+
  public:
   ReferenceProcessorStats() :
     _soft_count(0),
     _weak_count(0),
     _final_count(0),
-    _phantom_count(0) {}
+    _phantom_count(0),
+    _phase1_time_ms(0.0),
+    _phase2_time_ms(0.0),
+    _phase3_time_ms(0.0) {}
 
   ReferenceProcessorStats(size_t soft_count,
                           size_t weak_count,
                           size_t final_count,
-                          size_t phantom_count) :
+                          size_t phantom_count,
+                          double phase1_time_ms = 0.0,
+                          double phase2_time_ms = 0.0,
+                          double phase3_time_ms = 0.0) :
     _soft_count(soft_count),
     _weak_count(weak_count),
     _final_count(final_count),
-    _phantom_count(phantom_count)
+    _phantom_count(phantom_count),
+    _phase1_time_ms(phase1_time_ms),
+    _phase2_time_ms(phase2_time_ms),
+    _phase3_time_ms(phase3_time_ms)
   {}
 
   size_t soft_count() const {
@@ -69,5 +84,17 @@ class ReferenceProcessorStats {
   size_t phantom_count() const {
     return _phantom_count;
   }
+
+  double phase1_time_ms() const {
+    return _phase1_time_ms;
+  }
+
+  double phase2_time_ms() const {
+    return _phase2_time_ms;
+  }
+
+  double phase3_time_ms() const {
+    return _phase3_time_ms;
+  }
 };
 #endif
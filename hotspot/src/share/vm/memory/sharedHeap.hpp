@@ -209,6 +209,8 @@ public:
  public:
   FlexibleWorkGang* workers() const { return _workers; }
 
+  virtual FlexibleWorkGang* get_safepoint_workers() { return _workers; }
+
   // The functions below are helper functions that a subclass of
   // "SharedHeap" can use in the implementation of its virtual
   // functions.
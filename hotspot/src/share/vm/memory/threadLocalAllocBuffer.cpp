@@ -23,6 +23,7 @@
  */
 
 #include "precompiled.hpp"
+#include "jfr/jfrEvents.hpp"
 #include "memory/genCollectedHeap.hpp"
 #include "memory/resourceArea.hpp"
 #include "memory/threadLocalAllocBuffer.inline.hpp"
@@ -56,6 +57,7 @@ void ThreadLocalAllocBuffer::accumulate_statistics_before_gc() {
   // Publish new stats if some allocation occurred.
   if (global_stats()->allocation() != 0) {
     global_stats()->publish();
+    global_stats()->send_event();
     if (PrintTLAB) {
       global_stats()->print();
     }
@@ -94,7 +96,7 @@ void ThreadLocalAllocBuffer::accumulate_statistics() {
     }
     global_stats()->update_allocating_threads();
     global_stats()->update_number_of_refills(_number_of_refills);
-    global_stats()->update_allocation(_number_of_refills * desired_size());
+    global_stats()->update_allocation(allocated_in_refills());
     global_stats()->update_gc_waste(_gc_waste);
     global_stats()->update_slow_refill_waste(_slow_refill_waste);
     global_stats()->update_fast_refill_waste(_fast_refill_waste);
@@ -105,6 +107,7 @@ void ThreadLocalAllocBuffer::accumulate_statistics() {
            "tlab stats == 0");
   }
   global_stats()->update_slow_allocations(_slow_allocations);
+  global_stats()->update_grows(_number_of_grows);
 }
 
 // Fills the current tlab with a dummy filler array to create
@@ -126,6 +129,7 @@ void ThreadLocalAllocBuffer::make_parsable(bool retire) {
       set_top(NULL);
       set_pf_top(NULL);
       set_end(NULL);
+      _allocation_end = NULL;
     }
   }
   assert(!(retire || ZeroTLAB)  ||
@@ -162,12 +166,42 @@ void ThreadLocalAllocBuffer::resize() {
   set_refill_waste_limit(initial_refill_waste_limit());
 }
 
+void ThreadLocalAllocBuffer::grow_within_cycle() {
+  assert(ElasticTLAB && ResizeTLAB, "Should not call this otherwise");
+  // resize() sized this tlab so that the thread needs about
+  // target_refills() of them until the next GC. A thread that gets
+  // through a whole batch of refills allocates faster than its
+  // history predicted, so double the size instead of waiting for
+  // the next GC to catch up with the new allocation rate.
+  if (_number_of_refills - _refills_before_grow < (unsigned)target_refills()) {
+    return;
+  }
+  size_t new_size = align_object_size(MIN2(desired_size() * 2, max_size()));
+  if (new_size <= desired_size()) {
+    return;
+  }
+  _allocated_before_grow = allocated_in_refills();
+  _refills_before_grow = _number_of_refills;
+  _number_of_grows++;
+
+  if (PrintTLAB && Verbose) {
+    gclog_or_tty->print("TLAB grow: thread: " INTPTR_FORMAT " [id: %2d]"
+                        " refills %d desired_size: " SIZE_FORMAT " -> " SIZE_FORMAT "\n",
+                        myThread(), myThread()->osthread()->thread_id(),
+                        _number_of_refills, desired_size(), new_size);
+  }
+  set_desired_size(new_size);
+}
+
 void ThreadLocalAllocBuffer::initialize_statistics() {
-    _number_of_refills = 0;
-    _fast_refill_waste = 0;
-    _slow_refill_waste = 0;
-    _gc_waste          = 0;
-    _slow_allocations  = 0;
+    _number_of_refills     = 0;
+    _fast_refill_waste     = 0;
+    _slow_refill_waste     = 0;
+    _gc_waste              = 0;
+    _slow_allocations      = 0;
+    _number_of_grows       = 0;
+    _refills_before_grow   = 0;
+    _allocated_before_grow = 0;
 }
 
 void ThreadLocalAllocBuffer::fill(HeapWord* start,
@@ -177,6 +211,9 @@ void ThreadLocalAllocBuffer::fill(HeapWord* start,
   if (PrintTLAB && Verbose) {
     print_stats("fill");
   }
+  if (ElasticTLAB && ResizeTLAB) {
+    grow_within_cycle();
+  }
   assert(top <= start + new_size - alignment_reserve(), "size too small");
   initialize(start, top, start + new_size - alignment_reserve());
 
@@ -191,6 +228,7 @@ void ThreadLocalAllocBuffer::initialize(HeapWord* start,
   set_top(top);
   set_pf_top(top);
   set_end(end);
+  _allocation_end = NULL;
   invariants();
 }
 
@@ -212,6 +250,7 @@ void ThreadLocalAllocBuffer::initialize() {
   }
 
   set_refill_waste_limit(initial_refill_waste_limit());
+  _bytes_since_last_sample_point = 0;
 
   initialize_statistics();
 }
@@ -256,26 +295,46 @@ size_t ThreadLocalAllocBuffer::initial_desired_size() {
 void ThreadLocalAllocBuffer::print_stats(const char* tag) {
   Thread* thrd = myThread();
   size_t waste = _gc_waste + _slow_refill_waste + _fast_refill_waste;
-  size_t alloc = _number_of_refills * _desired_size;
+  size_t alloc = allocated_in_refills();
   double waste_percent = alloc == 0 ? 0.0 :
                       100.0 * waste / alloc;
   size_t tlab_used  = Universe::heap()->tlab_used(thrd);
   gclog_or_tty->print("TLAB: %s thread: " INTPTR_FORMAT " [id: %2d]"
                       " desired_size: " SIZE_FORMAT "KB"
                       " slow allocs: %d  refill waste: " SIZE_FORMAT "B"
-                      " alloc:%8.5f %8.0fKB refills: %d waste %4.1f%% gc: %dB"
+                      " alloc:%8.5f %8.0fKB refills: %d grows: %d waste %4.1f%% gc: %dB"
                       " slow: %dB fast: %dB\n",
                       tag, thrd, thrd->osthread()->thread_id(),
                       _desired_size / (K / HeapWordSize),
                       _slow_allocations, _refill_waste_limit * HeapWordSize,
                       _allocation_fraction.average(),
                       _allocation_fraction.average() * tlab_used / K,
-                      _number_of_refills, waste_percent,
+                      _number_of_refills, _number_of_grows, waste_percent,
                       _gc_waste * HeapWordSize,
                       _slow_refill_waste * HeapWordSize,
                       _fast_refill_waste * HeapWordSize);
 }
 
+void ThreadLocalAllocBuffer::set_sample_end() {
+  if (end() == NULL) {
+    return;
+  }
+  set_back_allocation_end();
+  size_t words_remaining = pointer_delta(end(), top());
+  size_t bytes_until_sample = myThread()->heap_sampler().bytes_until_sample();
+  size_t words_until_sample = bytes_until_sample / HeapWordSize;
+
+  if (words_remaining > words_until_sample) {
+    _allocation_end = end();
+    set_end(top() + words_until_sample);
+    _bytes_since_last_sample_point = bytes_until_sample;
+  } else {
+    // The sample point is beyond this tlab; count the rest of the tlab
+    // at the next refill.
+    _bytes_since_last_sample_point = words_remaining * HeapWordSize;
+  }
+}
+
 void ThreadLocalAllocBuffer::verify() {
   HeapWord* p = start();
   HeapWord* t = top();
@@ -354,6 +413,14 @@ GlobalTLABStats::GlobalTLABStats() :
     cname = PerfDataManager::counter_name("tlab", "maxSlowAlloc");
     _perf_max_slow_allocations =
       PerfDataManager::create_variable(SUN_GC, cname, PerfData::U_None, CHECK);
+
+    cname = PerfDataManager::counter_name("tlab", "grows");
+    _perf_grows =
+      PerfDataManager::create_variable(SUN_GC, cname, PerfData::U_None, CHECK);
+
+    cname = PerfDataManager::counter_name("tlab", "maxGrows");
+    _perf_max_grows =
+      PerfDataManager::create_variable(SUN_GC, cname, PerfData::U_None, CHECK);
   }
 }
 
@@ -371,6 +438,8 @@ void GlobalTLABStats::initialize() {
   _max_fast_refill_waste   = 0;
   _total_slow_allocations  = 0;
   _max_slow_allocations    = 0;
+  _total_grows             = 0;
+  _max_grows               = 0;
 }
 
 void GlobalTLABStats::publish() {
@@ -388,6 +457,25 @@ void GlobalTLABStats::publish() {
     _perf_max_fast_refill_waste->set_value(_max_fast_refill_waste);
     _perf_slow_allocations     ->set_value(_total_slow_allocations);
     _perf_max_slow_allocations ->set_value(_max_slow_allocations);
+    _perf_grows                ->set_value(_total_grows);
+    _perf_max_grows            ->set_value(_max_grows);
+  }
+}
+
+void GlobalTLABStats::send_event() {
+  EventTLABStatistics e;
+  if (e.should_commit()) {
+    e.set_allocatingThreads(_allocating_threads);
+    e.set_refills(_total_refills);
+    e.set_maxRefills(_max_refills);
+    e.set_allocated(_total_allocation * HeapWordSize);
+    e.set_gcWaste(_total_gc_waste * HeapWordSize);
+    e.set_slowRefillWaste(_total_slow_refill_waste * HeapWordSize);
+    e.set_fastRefillWaste(_total_fast_refill_waste * HeapWordSize);
+    e.set_slowAllocations(_total_slow_allocations);
+    e.set_maxSlowAllocations(_max_slow_allocations);
+    e.set_grows(_total_grows);
+    e.commit();
   }
 }
 
@@ -396,13 +484,14 @@ void GlobalTLABStats::print() {
   double waste_percent = _total_allocation == 0 ? 0.0 :
                          100.0 * waste / _total_allocation;
   gclog_or_tty->print("TLAB totals: thrds: %d  refills: %d max: %d"
-                      " slow allocs: %d max %d waste: %4.1f%%"
+                      " slow allocs: %d max %d grows: %d max %d waste: %4.1f%%"
                       " gc: " SIZE_FORMAT "B max: " SIZE_FORMAT "B"
                       " slow: " SIZE_FORMAT "B max: " SIZE_FORMAT "B"
                       " fast: " SIZE_FORMAT "B max: " SIZE_FORMAT "B\n",
                       _allocating_threads,
                       _total_refills, _max_refills,
                       _total_slow_allocations, _max_slow_allocations,
+                      _total_grows, _max_grows,
                       waste_percent,
                       _total_gc_waste * HeapWordSize,
                       _max_gc_waste * HeapWordSize,
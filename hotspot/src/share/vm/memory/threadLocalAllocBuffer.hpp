@@ -43,6 +43,8 @@ private:
   HeapWord* _top;                                // address after last allocation
   HeapWord* _pf_top;                             // allocation prefetch watermark
   HeapWord* _end;                                // allocation end (excluding alignment_reserve)
+  HeapWord* _allocation_end;                     // real end if the heap sampler moved _end, else NULL
+  size_t    _bytes_since_last_sample_point;      // bytes handed out between two heap sampler checks
   size_t    _desired_size;                       // desired size   (including alignment_reserve)
   size_t    _refill_waste_limit;                 // hold onto tlab if free() is larger than this
   size_t    _allocated_before_last_gc;           // total bytes allocated up until the last gc
@@ -55,6 +57,9 @@ private:
   unsigned  _slow_refill_waste;
   unsigned  _gc_waste;
   unsigned  _slow_allocations;
+  unsigned  _number_of_grows;                    // in-cycle growths (ElasticTLAB)
+  unsigned  _refills_before_grow;                // refills done before the last growth
+  size_t    _allocated_before_grow;              // tlab words handed out before the last growth
 
   AdaptiveWeightedAverage _allocation_fraction;  // fraction of eden allocated in tlabs
 
@@ -81,7 +86,14 @@ private:
   // Resize based on amount of allocation, etc.
   void resize();
 
-  void invariants() const { assert(top() >= start() && top() <= end(), "invalid tlab"); }
+  // Grow desired_size() if this thread used up its expected number of
+  // refills before the next GC.
+  void grow_within_cycle();
+
+  void invariants() const {
+    assert(top() >= start() && top() <= end(), "invalid tlab");
+    assert(_allocation_end == NULL || end() <= _allocation_end, "invalid sample end");
+  }
 
   void initialize(HeapWord* start, HeapWord* top, HeapWord* end);
 
@@ -96,6 +108,14 @@ private:
   int slow_refill_waste() const { return _slow_refill_waste; }
   int gc_waste() const          { return _gc_waste; }
   int slow_allocations() const  { return _slow_allocations; }
+  int number_of_grows() const   { return _number_of_grows; }
+
+  // Words handed out in tlabs since the last GC. The fast refill
+  // paths in generated code only bump _number_of_refills, so this is
+  // derived from the refill count and the desired size in effect.
+  size_t allocated_in_refills() const {
+    return _allocated_before_grow + (_number_of_refills - _refills_before_grow) * desired_size();
+  }
 
   static GlobalTLABStats* _global_stats;
   static GlobalTLABStats* global_stats() { return _global_stats; }
@@ -111,7 +131,8 @@ public:
 
   HeapWord* start() const                        { return _start; }
   HeapWord* end() const                          { return _end; }
-  HeapWord* hard_end() const                     { return _end + alignment_reserve(); }
+  HeapWord* allocation_end() const               { return _allocation_end != NULL ? _allocation_end : _end; }
+  HeapWord* hard_end() const                     { return allocation_end() + alignment_reserve(); }
   HeapWord* top() const                          { return _top; }
   HeapWord* pf_top() const                       { return _pf_top; }
   size_t desired_size() const                    { return _desired_size; }
@@ -142,6 +163,15 @@ public:
   // Record slow allocation
   inline void record_slow_allocation(size_t obj_size);
 
+  // Heap sampler support
+  // Move end() in to the next sample point of the thread if that is
+  // inside this tlab, so the allocation reaching it takes the slow path.
+  void set_sample_end();
+  // Undo set_sample_end().
+  void set_back_allocation_end()                 { if (_allocation_end != NULL) { _end = _allocation_end; _allocation_end = NULL; } }
+  bool end_moved_for_sample() const              { return _allocation_end != NULL; }
+  size_t bytes_since_last_sample_point() const   { return _bytes_since_last_sample_point; }
+
   // Initialization at startup
   static void startup_initialization();
 
@@ -165,6 +195,7 @@ public:
   // Code generation support
   static ByteSize start_offset()                 { return byte_offset_of(ThreadLocalAllocBuffer, _start); }
   static ByteSize end_offset()                   { return byte_offset_of(ThreadLocalAllocBuffer, _end  ); }
+  static ByteSize allocation_end_offset()        { return byte_offset_of(ThreadLocalAllocBuffer, _allocation_end ); }
   static ByteSize top_offset()                   { return byte_offset_of(ThreadLocalAllocBuffer, _top  ); }
   static ByteSize pf_top_offset()                { return byte_offset_of(ThreadLocalAllocBuffer, _pf_top  ); }
   static ByteSize size_offset()                  { return byte_offset_of(ThreadLocalAllocBuffer, _desired_size ); }
@@ -195,6 +226,8 @@ private:
   size_t   _max_fast_refill_waste;
   unsigned _total_slow_allocations;
   unsigned _max_slow_allocations;
+  unsigned _total_grows;
+  unsigned _max_grows;
 
   PerfVariable* _perf_allocating_threads;
   PerfVariable* _perf_total_refills;
@@ -208,6 +241,8 @@ private:
   PerfVariable* _perf_max_fast_refill_waste;
   PerfVariable* _perf_slow_allocations;
   PerfVariable* _perf_max_slow_allocations;
+  PerfVariable* _perf_grows;
+  PerfVariable* _perf_max_grows;
 
   AdaptiveWeightedAverage _allocating_threads_avg;
 
@@ -220,6 +255,9 @@ public:
   // Write all perf counters to the perf_counters
   void publish();
 
+  // Report the counters through the TLABStatistics event
+  void send_event();
+
   void print();
 
   // Accessors
@@ -259,6 +297,10 @@ public:
     _total_slow_allocations += value;
     _max_slow_allocations    = MAX2(_max_slow_allocations, value);
   }
+  void update_grows(unsigned value) {
+    _total_grows += value;
+    _max_grows    = MAX2(_max_grows, value);
+  }
 };
 
 #endif // SHARE_VM_MEMORY_THREADLOCALALLOCBUFFER_HPP
@@ -920,6 +920,11 @@ void Universe::print_compressed_oops_mode(outputStream* st) {
     st->print(", Oop shift amount: %d", Universe::narrow_oop_shift());
   }
 
+  if (ObjectAlignmentInBytes != HeapWordsPerLong * HeapWordSize) {
+    st->print(", Object alignment: " INTX_FORMAT "%s", ObjectAlignmentInBytes,
+              FLAG_IS_ERGO(ObjectAlignmentInBytes) ? " (ergonomic)" : "");
+  }
+
   st->cr();
 }
 
@@ -618,7 +618,7 @@ void ConstantPoolCache::adjust_method_entries(InstanceKlass* holder, bool * trac
       entry->initialize_entry(entry->constant_pool_index());
       continue;
     }
-    Method* new_method = holder->method_with_idnum(old_method->orig_method_idnum());
+    Method* new_method = old_method->method_holder()->method_with_idnum(old_method->orig_method_idnum());
 
     assert(new_method != NULL, "method_with_idnum() should not be NULL");
     assert(old_method != new_method, "sanity check");
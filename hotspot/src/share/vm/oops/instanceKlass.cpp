@@ -29,6 +29,7 @@
 #include "classfile/verifier.hpp"
 #include "classfile/vmSymbols.hpp"
 #include "compiler/compileBroker.hpp"
+#include "compiler/compileDecisionCache.hpp"
 #include "gc_implementation/shared/markSweep.inline.hpp"
 #include "gc_interface/collectedHeap.inline.hpp"
 #include "interpreter/oopMapCache.hpp"
@@ -54,6 +55,7 @@
 #include "prims/jvmtiThreadState.hpp"
 #include "prims/methodComparator.hpp"
 #include "runtime/fieldDescriptor.hpp"
+#include "runtime/fieldType.hpp"
 #include "runtime/handles.inline.hpp"
 #include "runtime/javaCalls.hpp"
 #include "runtime/mutexLocker.hpp"
@@ -305,6 +307,8 @@ InstanceKlass::InstanceKlass(int vtable_len,
   set_oop_map_cache(NULL);
   set_jni_ids(NULL);
   set_osr_nmethods_head(NULL);
+  _itable_cache = NULL;
+  _verification_cache_entry = NULL;
   set_breakpoints(NULL);
   init_previous_versions();
   set_generic_signature_index(0);
@@ -946,6 +950,9 @@ void InstanceKlass::initialize_impl(instanceKlassHandle this_oop, TRAPS) {
     { ResourceMark rm(THREAD);
       debug_only(this_oop->vtable()->verify(tty, true);)
     }
+    if (CompileDecisionCache::is_enabled()) {
+      CompileDecisionCache::class_initialized(this_oop(), THREAD);
+    }
   }
   else {
     // Step 10 and 11
@@ -2450,6 +2457,7 @@ void InstanceKlass::remove_unshareable_info() {
     unlink_class();
   }
   init_implementor();
+  _itable_cache = NULL;
 
   constants()->remove_unshareable_info();
 
@@ -2919,12 +2927,13 @@ void InstanceKlass::adjust_default_methods(InstanceKlass* holder, bool* trace_na
   if (default_methods() != NULL) {
     for (int index = 0; index < default_methods()->length(); index ++) {
       Method* old_method = default_methods()->at(index);
-      if (old_method == NULL || old_method->method_holder() != holder || !old_method->is_old()) {
+      if (old_method == NULL || (holder != NULL && old_method->method_holder() != holder) ||
+          !old_method->is_old()) {
         continue; // skip uninteresting entries
       }
       assert(!old_method->is_deleted(), "default methods may not be deleted");
 
-      Method* new_method = holder->method_with_idnum(old_method->orig_method_idnum());
+      Method* new_method = old_method->method_holder()->method_with_idnum(old_method->orig_method_idnum());
 
       assert(new_method != NULL, "method_with_idnum() should not be NULL");
       assert(old_method != new_method, "sanity check");
@@ -3378,6 +3387,21 @@ void InstanceKlass::collect_statistics(KlassSizeStats *sz) const {
   Klass::collect_statistics(sz);
 
   sz->_inst_size  = HeapWordSize * size_helper();
+  if (!is_interface()) {
+    julong field_bytes = 0;
+    for (InstanceKlass* k = const_cast<InstanceKlass*>(this); k != NULL; k = k->superklass()) {
+      for (AllFieldStream fs(k); !fs.done(); fs.next()) {
+        if (!fs.access_flags().is_static()) {
+          BasicType type = FieldType::basic_type(fs.signature());
+          field_bytes += (type == T_OBJECT || type == T_ARRAY) ? heapOopSize : type2aelembytes(type);
+        }
+      }
+    }
+    julong used_bytes = instanceOopDesc::base_offset_in_bytes() + field_bytes;
+    if (sz->_inst_size > used_bytes) {
+      sz->_inst_padding = sz->_inst_size - used_bytes;
+    }
+  }
   sz->_vtab_bytes = HeapWordSize * align_object_offset(vtable_length());
   sz->_itab_bytes = HeapWordSize * align_object_offset(itable_length());
   sz->_nonstatic_oopmap_bytes = HeapWordSize *
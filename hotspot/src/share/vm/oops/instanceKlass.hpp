@@ -138,6 +138,7 @@ class OopMapBlock VALUE_OBJ_CLASS_SPEC {
 };
 
 struct JvmtiCachedClassFileData;
+class VerificationCacheEntry;
 
 class InstanceKlass: public Klass {
   friend class VMStructs;
@@ -255,6 +256,7 @@ class InstanceKlass: public Klass {
   jmethodID*      _methods_jmethod_ids;  // jmethodIDs corresponding to method_idnum, or NULL if none
   nmethodBucket*  _dependencies;         // list of dependent nmethods
   nmethod*        _osr_nmethods_head;    // Head of list of on-stack replacement nmethods for this class
+  itableOffsetEntry* volatile _itable_cache; // Itable entry last found by a megamorphic interface call
   BreakpointInfo* _breakpoints;          // bpt lists, managed by Method*
   // Linked instanceKlasses of previous versions
   InstanceKlass* _previous_versions;
@@ -262,6 +264,9 @@ class InstanceKlass: public Klass {
   // JVMTI: cached class file, before retransformable agent modified it in CFLH
   JvmtiCachedClassFileData* _cached_class_file;
 
+  // Entry for the bytes of this class in the verification cache, or NULL
+  VerificationCacheEntry* _verification_cache_entry;
+
   volatile u2     _idnum_allocated_count;         // JNI/JVMTI: increments with the addition of methods, old ids don't change
 
   // Class states are defined as ClassState (see above).
@@ -718,6 +723,9 @@ class InstanceKlass: public Klass {
   jint get_cached_class_file_len();
   unsigned char * get_cached_class_file_bytes();
 
+  VerificationCacheEntry* verification_cache_entry() const { return _verification_cache_entry; }
+  void set_verification_cache_entry(VerificationCacheEntry* entry) { _verification_cache_entry = entry; }
+
   // JVMTI: Support for caching of field indices, types, and offsets
   void set_jvmti_cached_class_field_map(JvmtiCachedClassFieldMap* descriptor) {
     _jvmti_cached_class_field_map = descriptor;
@@ -850,6 +858,7 @@ class InstanceKlass: public Klass {
   static ByteSize init_state_offset()  { return in_ByteSize(offset_of(InstanceKlass, _init_state)); }
   JFR_ONLY(DEFINE_KLASS_TRACE_ID_OFFSET;)
   static ByteSize init_thread_offset() { return in_ByteSize(offset_of(InstanceKlass, _init_thread)); }
+  static ByteSize itable_cache_offset() { return in_ByteSize(offset_of(InstanceKlass, _itable_cache)); }
 
   // subclass/subinterface checks
   bool implements_interface(Klass* k) const;
@@ -982,12 +982,14 @@ void klassVtable::adjust_method_entries(InstanceKlass* holder, bool * trace_name
   int prn_enabled = 0;
   for (int index = 0; index < length(); index++) {
     Method* old_method = unchecked_method_at(index);
-    if (old_method == NULL || old_method->method_holder() != holder || !old_method->is_old()) {
+    if (old_method == NULL || (holder != NULL && old_method->method_holder() != holder) ||
+        !old_method->is_old()) {
       continue; // skip uninteresting entries
     }
     assert(!old_method->is_deleted(), "vtable methods may not be deleted");
 
-    Method* new_method = holder->method_with_idnum(old_method->orig_method_idnum());
+    // Old methods keep the redefined class as their holder
+    Method* new_method = old_method->method_holder()->method_with_idnum(old_method->orig_method_idnum());
 
     assert(new_method != NULL, "method_with_idnum() should not be NULL");
     assert(old_method != new_method, "sanity check");
@@ -1325,12 +1327,13 @@ void klassItable::adjust_method_entries(InstanceKlass* holder, bool * trace_name
   itableMethodEntry* ime = method_entry(0);
   for (int i = 0; i < _size_method_table; i++, ime++) {
     Method* old_method = ime->method();
-    if (old_method == NULL || old_method->method_holder() != holder || !old_method->is_old()) {
+    if (old_method == NULL || (holder != NULL && old_method->method_holder() != holder) ||
+        !old_method->is_old()) {
       continue; // skip uninteresting entries
     }
     assert(!old_method->is_deleted(), "itable methods may not be deleted");
 
-    Method* new_method = holder->method_with_idnum(old_method->orig_method_idnum());
+    Method* new_method = old_method->method_holder()->method_with_idnum(old_method->orig_method_idnum());
 
     assert(new_method != NULL, "method_with_idnum() should not be NULL");
     assert(old_method != new_method, "sanity check");
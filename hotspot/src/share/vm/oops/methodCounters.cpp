@@ -23,12 +23,81 @@
  */
 #include "precompiled.hpp"
 #include "oops/methodCounters.hpp"
+#include "runtime/atomic.inline.hpp"
+#include "runtime/orderAccess.inline.hpp"
 #include "runtime/thread.inline.hpp"
 
 MethodCounters* MethodCounters::allocate(ClassLoaderData* loader_data, TRAPS) {
   return new(loader_data, size(), false, MetaspaceObj::MethodCountersType, THREAD) MethodCounters();
 }
 
+void MethodCounters::deallocate_contents(ClassLoaderData* loader_data) {
+#ifdef TIERED
+  if (_invocation_stripes_block != NULL) {
+    FREE_C_HEAP_ARRAY(char, _invocation_stripes_block, mtInternal);
+    _invocation_stripes_block = NULL;
+    _invocation_stripes = NULL;
+  }
+#endif
+}
+
+static volatile jint _next_invocation_stripe = 0;
+
+intptr_t MethodCounters::next_invocation_stripe() {
+  juint n = (juint)Atomic::add(1, &_next_invocation_stripe);
+  return (intptr_t)(n % invocation_stripe_count) * invocation_stripe_stride;
+}
+
+int MethodCounters::drain_invocation_stripes(address base) {
+  int count = 0;
+  for (int i = 0; i < invocation_stripe_count; i++) {
+    volatile jint* stripe = (volatile jint*)(base + i * invocation_stripe_stride);
+    // Racing increments may be lost or counted twice; counts are only
+    // approximate anyway
+    jint value = *stripe;
+    if (value != 0) {
+      value = Atomic::xchg(0, stripe);
+      count += (int)((juint)value >> InvocationCounter::count_shift);
+    }
+  }
+  return count;
+}
+
+#ifdef TIERED
+address MethodCounters::ensure_invocation_stripes() {
+  address stripes = (address)OrderAccess::load_ptr_acquire(&_invocation_stripes);
+  if (stripes != NULL) {
+    return stripes;
+  }
+  size_t bytes = (invocation_stripe_count + 1) * invocation_stripe_stride;
+  char* block = NEW_C_HEAP_ARRAY_RETURN_NULL(char, bytes, mtInternal);
+  if (block == NULL) {
+    return NULL;
+  }
+  memset(block, 0, bytes);
+  if (Atomic::cmpxchg_ptr(block, &_invocation_stripes_block, (char*)NULL) != NULL) {
+    // Another thread got there first; its stripes may not be published yet
+    FREE_C_HEAP_ARRAY(char, block, mtInternal);
+    return (address)OrderAccess::load_ptr_acquire(&_invocation_stripes);
+  }
+  stripes = (address)align_ptr_up(block, invocation_stripe_stride);
+  OrderAccess::release_store_ptr(&_invocation_stripes, stripes);
+  return stripes;
+}
+
+void MethodCounters::fold_invocation_stripes() {
+  address stripes = ensure_invocation_stripes();
+  if (stripes == NULL) {
+    return;
+  }
+  int count = drain_invocation_stripes(stripes);
+  InvocationCounter* c = invocation_counter();
+  if (count > 0 && !c->carry()) {
+    c->set(c->state(), MIN2(c->count() + count, (int)InvocationCounter::count_limit - 1));
+  }
+}
+#endif
+
 void MethodCounters::clear_counters() {
   invocation_counter()->reset();
   backedge_counter()->reset();
@@ -42,6 +42,12 @@ class MethodCounters: public MetaspaceObj {
   u1                _highest_comp_level;          // Highest compile level this method has ever seen.
   u1                _highest_osr_comp_level;      // Same for OSR level
   jlong             _prev_time;                   // Previous time the rate was acquired
+
+  // With UseStripedInvocationCounters: invocation counts not yet folded
+  // into _invocation_counter, one cache line per stripe, or NULL until
+  // the method first notifies the policy
+  address volatile  _invocation_stripes;
+  char* volatile    _invocation_stripes_block;    // _invocation_stripes before alignment
 #endif
 
   MethodCounters() : _interpreter_invocation_count(0),
@@ -51,7 +57,9 @@ class MethodCounters: public MetaspaceObj {
                    , _rate(0),
                      _highest_comp_level(0),
                      _highest_osr_comp_level(0),
-                     _prev_time(0)
+                     _prev_time(0),
+                     _invocation_stripes(NULL),
+                     _invocation_stripes_block(NULL)
 #endif
   {
     invocation_counter()->init();
@@ -61,7 +69,7 @@ class MethodCounters: public MetaspaceObj {
  public:
   static MethodCounters* allocate(ClassLoaderData* loader_data, TRAPS);
 
-  void deallocate_contents(ClassLoaderData* loader_data) {}
+  void deallocate_contents(ClassLoaderData* loader_data);
   DEBUG_ONLY(bool on_stack() { return false; })  // for template
 
   static int size() { return sizeof(MethodCounters) / wordSize; }
@@ -129,5 +137,38 @@ class MethodCounters: public MetaspaceObj {
     return offset_of(MethodCounters, _interpreter_invocation_count);
   }
 
+  // Striped invocation counting. Interpreted and tier 2 code add
+  // InvocationCounter::count_increment to the stripe of the invoking
+  // thread instead of to the shared _invocation_counter, and call the
+  // policy when the stripe reaches a multiple of the notification
+  // frequency as they would for the shared counter. The policy folds all
+  // stripes into _invocation_counter before it looks at the counts. Each
+  // thread always uses the same stripe, so a method called from many
+  // threads no longer bounces one cache line between all of them.
+  enum {
+    invocation_stripe_count  = 8,
+    invocation_stripe_stride = DEFAULT_CACHE_LINE_SIZE
+  };
+
+  // Byte offset of the stripe for the next thread created
+  static intptr_t next_invocation_stripe();
+
+  // Counts accumulated in the stripes at base, which are reset
+  static int drain_invocation_stripes(address base);
+
+#ifdef TIERED
+  // Allocates the stripes if there are none yet; NULL if that fails
+  address ensure_invocation_stripes();
+  // Adds the counts in the stripes to the invocation counter
+  void fold_invocation_stripes();
+
+  static ByteSize invocation_stripes_offset() {
+    return byte_offset_of(MethodCounters, _invocation_stripes);
+  }
+#else
+  address ensure_invocation_stripes()            { return NULL; }
+  void fold_invocation_stripes()                 { }
+#endif
+
 };
 #endif //SHARE_VM_OOPS_METHODCOUNTERS_HPP
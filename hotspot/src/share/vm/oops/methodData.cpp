@@ -1178,6 +1178,9 @@ void MethodData::init() {
   assert(sizeof(_trap_hist) % sizeof(HeapWord) == 0, "align");
   Copy::zero_to_words((HeapWord*) &_trap_hist,
                       sizeof(_trap_hist) / sizeof(HeapWord));
+  assert(sizeof(_recompile_hist) % sizeof(HeapWord) == 0, "align");
+  Copy::zero_to_words((HeapWord*) &_recompile_hist,
+                      sizeof(_recompile_hist) / sizeof(HeapWord));
 }
 
 // Get a measure of how much mileage the method has on it.
@@ -2076,6 +2076,10 @@ private:
     intptr_t _align;
     u1 _array[_trap_hist_limit];
   } _trap_hist;
+  union {
+    intptr_t _align;
+    u1 _array[_trap_hist_limit];
+  } _recompile_hist;                // trap-induced recompiles, by reason
 
   // Support for interprocedural escape analysis, from Thomas Kotzmann.
   intx              _eflags;          // flags on escape information
@@ -2417,6 +2421,17 @@ public:
   void inc_overflow_recompile_count() {
     _nof_overflow_recompiles += 1;
   }
+  uint recompile_count(int reason) const {
+    assert((uint)reason < _trap_hist_limit, "oob");
+    return _recompile_hist._array[reason];
+  }
+  void inc_recompile_count(int reason) {
+    // Saturating; only used to scale back trap limits.
+    if ((uint)reason < _trap_hist_limit &&
+        _recompile_hist._array[reason] < _trap_hist_mask) {
+      _recompile_hist._array[reason] += 1;
+    }
+  }
   uint decompile_count() const {
     return _nof_decompiles;
   }
@@ -88,14 +88,16 @@ void ObjArrayKlass::objarray_follow_contents(ParCompactionManager* cm, oop obj,
   T* const beg = base + beg_index;
   T* const end = base + end_index;
 
+  // Push the continuation first so that other workers can steal the
+  // remainder of a large array while this one scans the current stride.
+  if (end_index < len) {
+    cm->push_objarray(a, end_index);
+  }
+
   // Push the non-NULL elements of the next stride on the marking stack.
   for (T* e = beg; e < end; e++) {
     PSParallelCompact::mark_and_push<T>(cm, e);
   }
-
-  if (end_index < len) {
-    cm->push_objarray(a, end_index); // Push the continuation.
-  }
 }
 #endif // INCLUDE_ALL_GCS
 
@@ -103,9 +103,32 @@ static bool is_unboxing_method(ciMethod* callee_method, Compile* C) {
   return C->eliminate_boxing() && callee_method->is_unboxing_method();
 }
 
+/**
+ *  Count the call's arguments which are constants at the call site.
+ */
+static int constant_argument_count(ciMethod* callee_method, JVMState* jvms,
+                                   int& arg_count) {
+  arg_count = 0;
+  if (jvms == NULL || jvms->map() == NULL) {
+    return 0;
+  }
+  int constants = 0;
+  for (int i = 0; i < callee_method->arg_size(); i++) {
+    Node* arg = jvms->map()->argument(jvms, i);
+    if (arg->is_top()) {
+      continue; // second half of a long or double
+    }
+    arg_count++;
+    if (arg->is_Con()) {
+      constants++;
+    }
+  }
+  return constants;
+}
+
 // positive filter: should callee be inlined?
 bool InlineTree::should_inline(ciMethod* callee_method, ciMethod* caller_method,
-                               int caller_bci, ciCallProfile& profile,
+                               int caller_bci, JVMState* jvms, ciCallProfile& profile,
                                WarmCallInfo* wci_result) {
   // Allows targeted inlining
   if (callee_method->should_inline()) {
@@ -180,6 +203,17 @@ bool InlineTree::should_inline(ciMethod* callee_method, ciMethod* caller_method,
       return false;
     }
   }
+  // Constant arguments usually fold away part of the callee once it is
+  // parsed, so at hot sites its bytecode size overstates its final cost.
+  if (size > max_inline_size && max_inline_size > default_max_inline_size &&
+      InlineConstantArgumentBonus > 0) {
+    int arg_count = 0;
+    int constants = constant_argument_count(callee_method, jvms, arg_count);
+    if (constants > 0) {
+      max_inline_size += (max_inline_size * InlineConstantArgumentBonus * constants) /
+                         (100 * arg_count);
+    }
+  }
   if (size > max_inline_size) {
     if (max_inline_size > default_max_inline_size) {
       set_msg("hot method too big");
@@ -326,7 +360,7 @@ bool InlineTree::try_to_inline(ciMethod* callee_method, ciMethod* caller_method,
   }
 
   _forced_inline = false; // Reset
-  if (!should_inline(callee_method, caller_method, caller_bci, profile,
+  if (!should_inline(callee_method, caller_method, caller_bci, jvms, profile,
                      wci_result)) {
     return false;
   }
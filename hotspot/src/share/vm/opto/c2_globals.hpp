@@ -103,6 +103,11 @@
   product(bool, AlignVector, true,                                          \
           "Perform vector store/load alignment in loop")                    \
                                                                             \
+  product(intx, VectorAlignTripCountLimit, 256,                             \
+          "Do not spend pre-loop iterations aligning a vectorized main "    \
+          "loop whose known or profiled trip count is below this limit, "   \
+          "if misaligned vectors are allowed. Zero always aligns")          \
+                                                                            \
   product(intx, NumberOfLoopInstrToAlign, 4,                                \
           "Number of first instructions in a loop to align")                \
                                                                             \
@@ -324,6 +329,9 @@
   product(bool, UseSuperWord, true,                                         \
           "Transform scalar operations into superword operations")          \
                                                                             \
+  product(bool, SuperWordReductions, true,                                  \
+          "Enable reductions support in superword.")                        \
+                                                                            \
   develop(bool, SuperWordRTDepCheck, false,                                 \
           "Enable runtime dependency checks.")                              \
                                                                             \
@@ -339,6 +347,11 @@
   product_pd(intx, ConditionalMoveLimit,                                    \
           "Limit of ops to make speculative when using CMOVE")              \
                                                                             \
+  product(bool, UseProfiledConditionalMove, true,                           \
+          "Scale ConditionalMoveLimit up to twice its value by the "        \
+          "entropy of the profiled branch, so that unpredictable branches " \
+          "are converted to CMOVE more readily")                            \
+                                                                            \
   /* Set BranchOnRegister == false. See 4965987. */                         \
   product(bool, BranchOnRegister, false,                                    \
           "Use Sparc V9 branch-on-register opcodes")                        \
@@ -369,6 +382,17 @@
   product(bool, UseOnlyInlinedBimorphic, true,                              \
           "Don't use BimorphicInlining if can't inline a second method")    \
                                                                             \
+  product(bool, UsePolymorphicInlining, true,                               \
+          "Profiling based guarded inlining for more than two receivers")   \
+                                                                            \
+  product(intx, PolymorphicInliningLimit, 4,                                \
+          "Maximum number of receivers inlined at a polymorphic call site " \
+          "(at most 4)")                                                    \
+                                                                            \
+  product(intx, PolymorphicInliningMinPercent, 10,                          \
+          "% of all profiled receivers a receiver type needs to be "        \
+          "inlined at a polymorphic call site")                             \
+                                                                            \
   product(bool, InsertMemBarAfterArraycopy, true,                           \
           "Insert memory barrier after arraycopy call")                     \
                                                                             \
@@ -509,7 +533,7 @@
   product(bool, OptimizeStringConcat, true,                                 \
           "Optimize the construction of Strings by StringBuilder")          \
                                                                             \
-  notproduct(bool, PrintOptimizeStringConcat, false,                        \
+  diagnostic(bool, PrintOptimizeStringConcat, false,                        \
           "Print information about transformations performed on Strings")   \
                                                                             \
   product(intx, ValueSearchLimit, 1000,                                     \
@@ -653,6 +677,13 @@
   product(intx, LiveNodeCountInliningCutoff, 40000,                         \
           "max number of live nodes in a method")                           \
                                                                             \
+  product(bool, PrioritizeLateInlines, true,                                \
+          "Revisit post parse inlining candidates hottest call site first") \
+                                                                            \
+  product(intx, InlineConstantArgumentBonus, 50,                            \
+          "Percentage by which the hot call site size limit grows when "    \
+          "all arguments are constants, pro rata for fewer constants")      \
+                                                                            \
   diagnostic(bool, OptimizeExpensiveOps, true,                              \
           "Find best control for expensive operations")                     \
                                                                             \
@@ -674,6 +705,10 @@
   product(bool, UseMontgomerySquareIntrinsic, false,                        \
           "Enables intrinsification of BigInteger.montgomerySquare()")      \
                                                                             \
+  product(bool, UseVectorizedMismatchIntrinsic, false,                      \
+          "Enables intrinsification of Arrays.equals() for byte, short, "   \
+          "int and long arrays")                                            \
+                                                                            \
   product(bool, UseTypeSpeculation, true,                                   \
           "Speculatively propagate types from profiles")                    \
                                                                             \
@@ -300,6 +300,20 @@ macro(URShiftVL)
 macro(AndV)
 macro(OrV)
 macro(XorV)
+macro(VectorCastI2F)
+macro(VectorCastF2I)
+macro(AddReductionVI)
+macro(AddReductionVL)
+macro(AddReductionVF)
+macro(AddReductionVD)
+macro(MulReductionVI)
+macro(MulReductionVF)
+macro(MulReductionVD)
+macro(AndReductionV)
+macro(OrReductionV)
+macro(XorReductionV)
+macro(MinReductionV)
+macro(MaxReductionV)
 macro(LoadVector)
 macro(StoreVector)
 macro(Pack)
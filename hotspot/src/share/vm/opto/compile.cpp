@@ -1991,6 +1991,17 @@ void Compile::inline_boxing_calls(PhaseIterGVN& igvn) {
   }
 }
 
+// Profiled execution count of a late inlining candidate's call site.
+static int late_inline_call_site_count(CallGenerator* cg) {
+  CallStaticJavaNode* call = cg->call_node();
+  JVMState* jvms = (call != NULL) ? call->jvms() : NULL;
+  if (jvms == NULL || !jvms->has_method()) {
+    return 0;
+  }
+  ciCallProfile profile = jvms->method()->call_profile_at_bci(jvms->bci());
+  return jvms->method()->scale_count(MAX2(profile.count(), 0));
+}
+
 void Compile::inline_incrementally_one(PhaseIterGVN& igvn) {
   assert(IncrementalInline, "incremental inlining should be on");
   PhaseGVN* gvn = initial_gvn();
@@ -1999,19 +2010,41 @@ void Compile::inline_incrementally_one(PhaseIterGVN& igvn) {
   for_igvn()->clear();
   gvn->replace_with(&igvn);
 
-  int i = 0;
+  if (PrioritizeLateInlines) {
+    // Spend the live node budget on the hottest call sites first rather
+    // than in discovery order. Candidates found while inlining one are
+    // still queued at its position.
+    while (_late_inlines.length() > 0 && !inlining_progress()) {
+      int best = 0;
+      int best_count = late_inline_call_site_count(_late_inlines.at(0));
+      for (int k = 1; k < _late_inlines.length(); k++) {
+        int count = late_inline_call_site_count(_late_inlines.at(k));
+        if (count > best_count) {
+          best = k;
+          best_count = count;
+        }
+      }
+      CallGenerator* cg = _late_inlines.at(best);
+      _late_inlines.remove_at(best);
+      _late_inlines_pos = best;
+      cg->do_late_inline();
+      if (failing())  return;
+    }
+  } else {
+    int i = 0;
 
-  for (; i <_late_inlines.length() && !inlining_progress(); i++) {
-    CallGenerator* cg = _late_inlines.at(i);
-    _late_inlines_pos = i+1;
-    cg->do_late_inline();
-    if (failing())  return;
-  }
-  int j = 0;
-  for (; i < _late_inlines.length(); i++, j++) {
-    _late_inlines.at_put(j, _late_inlines.at(i));
+    for (; i <_late_inlines.length() && !inlining_progress(); i++) {
+      CallGenerator* cg = _late_inlines.at(i);
+      _late_inlines_pos = i+1;
+      cg->do_late_inline();
+      if (failing())  return;
+    }
+    int j = 0;
+    for (; i < _late_inlines.length(); i++, j++) {
+      _late_inlines.at_put(j, _late_inlines.at(i));
+    }
+    _late_inlines.trunc_to(j);
   }
-  _late_inlines.trunc_to(j);
 
   {
     ResourceMark rm;
@@ -2345,6 +2378,7 @@ void Compile::Code_Gen() {
   {
     TracePhase t2("matcher", &_t_matcher, true);
     matcher.match();
+    end_phase(PHASE_MATCHING, 2);
   }
   // In debug mode can dump m._nodes.dump() for mapping of ideal to machine
   // nodes.  Mapping is only valid at the root of each matched subtree.
@@ -2384,6 +2418,7 @@ void Compile::Code_Gen() {
     if (failing()) {
       return;
     }
+    end_phase(PHASE_REGISTER_ALLOCATION, 2);
   }
 
   // Prior to register allocation we kept empty basic blocks in case the
@@ -636,6 +636,15 @@ class Compile : public Phase {
   }
 
   void print_method(CompilerPhaseType cpt, int level = 1) {
+#ifndef PRODUCT
+    if (_printer) _printer->print_method(this, CompilerPhaseTypeHelper::to_string(cpt), level);
+#endif
+    end_phase(cpt, level);
+  }
+
+  // Ends the current stage of the compilation without printing the
+  // graph, so that its time shows up as a CompilerPhase event.
+  void end_phase(CompilerPhaseType cpt, int level = 1) {
     EventCompilerPhase event;
     if (event.should_commit()) {
       event.set_starttime(C->_latest_stage_start_counter);
@@ -644,11 +653,6 @@ class Compile : public Phase {
       event.set_phaseLevel(level);
       event.commit();
     }
-
-
-#ifndef PRODUCT
-    if (_printer) _printer->print_method(this, CompilerPhaseTypeHelper::to_string(cpt), level);
-#endif
     C->_latest_stage_start_counter.stamp();
   }
 
@@ -286,6 +286,52 @@ CallGenerator* Compile::call_generator(ciMethod* callee, int vtable_index, bool
             }
           }
         }
+      } else if (UsePolymorphicInlining && morphism != 1 && morphism != 2 &&
+                 speculative_receiver_type == NULL && profile.has_receiver(1)) {
+        // No major receiver: guard and inline each frequent receiver,
+        // most frequent first. Receivers whose method is not inlined
+        // don't earn a type check and are dispatched virtually.
+        const int max_receivers = (int)MIN2(PolymorphicInliningLimit, (intx)ciCallProfile::MorphismLimit);
+        ciKlass*       klasses[ciCallProfile::MorphismLimit];
+        ciMethod*      methods[ciCallProfile::MorphismLimit];
+        CallGenerator* hit_cgs[ciCallProfile::MorphismLimit];
+        int            counts[ciCallProfile::MorphismLimit];
+        int n = 0;
+        for (int i = 0; i < max_receivers && profile.has_receiver(i); i++) {
+          // Receivers are sorted by count, so the rest are rarer still.
+          if (100.*profile.receiver_prob(i) < (float)PolymorphicInliningMinPercent)  break;
+          ciMethod* m = callee->resolve_invoke(jvms->method()->holder(), profile.receiver(i));
+          if (m == NULL)  continue;
+          CallGenerator* cg = this->call_generator(m, vtable_index, !call_does_dispatch,
+                                                   jvms, allow_inline, prof_factor);
+          if (cg == NULL || !cg->is_inline())  continue;
+          klasses[n] = profile.receiver(i);
+          methods[n] = m;
+          hit_cgs[n] = cg;
+          counts[n]  = profile.receiver_count(i);
+          n++;
+        }
+        if (n >= 2) {
+          CallGenerator* miss_cg;
+          if (n == morphism && !too_many_traps(caller, bci, Deoptimization::Reason_bimorphic)) {
+            // Every receiver seen so far is covered by a guard.
+            miss_cg = CallGenerator::for_uncommon_trap(callee, Deoptimization::Reason_bimorphic,
+                                                       Deoptimization::Action_maybe_recompile);
+          } else {
+            miss_cg = CallGenerator::for_virtual_call(callee, vtable_index);
+          }
+          // Each guard is only reached by calls that missed the previous
+          // ones, so its probability is relative to the remaining count.
+          for (int i = n - 1; i >= 0 && miss_cg != NULL; i--) {
+            int reaching = profile.count();
+            for (int j = 0; j < i; j++)  reaching -= counts[j];
+            float hit_prob = (n == morphism && i == n - 1) ? PROB_MAX :
+                             MIN2((float)counts[i] / (float)MAX2(reaching, 1), PROB_MAX);
+            trace_type_profile(C, jvms->method(), jvms->depth() - 1, jvms->bci(), methods[i], klasses[i], site_count, counts[i]);
+            miss_cg = CallGenerator::for_predicted_call(klasses[i], miss_cg, hit_cgs[i], hit_prob);
+          }
+          if (miss_cg != NULL)  return miss_cg;
+        }
       }
     }
   }
@@ -328,6 +374,9 @@ bool Compile::should_delay_string_inlining(ciMethod* call_method, JVMState* jvms
       case vmIntrinsics::_StringBuilder_append_char:
       case vmIntrinsics::_StringBuilder_append_int:
       case vmIntrinsics::_StringBuilder_append_String:
+      case vmIntrinsics::_StringBuilder_append_long:
+      case vmIntrinsics::_StringBuilder_append_boolean:
+      case vmIntrinsics::_StringBuilder_append_char_array:
       case vmIntrinsics::_StringBuilder_toString:
       case vmIntrinsics::_StringBuffer_void:
       case vmIntrinsics::_StringBuffer_int:
@@ -335,6 +384,9 @@ bool Compile::should_delay_string_inlining(ciMethod* call_method, JVMState* jvms
       case vmIntrinsics::_StringBuffer_append_char:
       case vmIntrinsics::_StringBuffer_append_int:
       case vmIntrinsics::_StringBuffer_append_String:
+      case vmIntrinsics::_StringBuffer_append_long:
+      case vmIntrinsics::_StringBuffer_append_boolean:
+      case vmIntrinsics::_StringBuffer_append_char_array:
       case vmIntrinsics::_StringBuffer_toString:
       case vmIntrinsics::_Integer_toString:
         return true;
@@ -802,7 +802,7 @@ void ConnectionGraph::add_call_node(CallNode* call) {
     add_java_object(call, es);
     PointsToNode* ptn = ptnode_adr(call_idx);
     if (!scalar_replaceable && ptn->scalar_replaceable()) {
-      ptn->set_scalar_replaceable(false);
+      set_not_scalar_replaceable(ptn, "array's length is not constant or too big");
     }
   } else if (call->is_CallStaticJava()) {
     // Call nodes could be different types:
@@ -833,7 +833,7 @@ void ConnectionGraph::add_call_node(CallNode* call) {
       assert(strncmp(name, "_multianewarray", 15) == 0, "TODO: add failed case check");
       // Returns a newly allocated unescaped object.
       add_java_object(call, PointsToNode::NoEscape);
-      ptnode_adr(call_idx)->set_scalar_replaceable(false);
+      set_not_scalar_replaceable(ptnode_adr(call_idx), "multi-dimensional array");
     } else if (meth->is_boxing_method()) {
       // Returns boxing object
       PointsToNode::EscapeState es;
@@ -855,7 +855,7 @@ void ConnectionGraph::add_call_node(CallNode* call) {
         // Mark it as NoEscape so that objects referenced by
         // it's fields will be marked as NoEscape at least.
         add_java_object(call, PointsToNode::NoEscape);
-        ptnode_adr(call_idx)->set_scalar_replaceable(false);
+        set_not_scalar_replaceable(ptnode_adr(call_idx), "allocated by a callee");
       } else {
         // Determine whether any arguments are returned.
         const TypeTuple* d = call->tf()->domain();
@@ -948,6 +948,7 @@ void ConnectionGraph::process_call_arguments(CallNode *call) {
                  (strcmp(call->as_CallLeaf()->_name, "g1_wb_pre")  == 0 ||
                   strcmp(call->as_CallLeaf()->_name, "g1_wb_post") == 0 ||
                   strcmp(call->as_CallLeaf()->_name, "updateBytesCRC32") == 0 ||
+                  strcmp(call->as_CallLeaf()->_name, "updateBytesAdler32") == 0 ||
                   strcmp(call->as_CallLeaf()->_name, "aescrypt_encryptBlock") == 0 ||
                   strcmp(call->as_CallLeaf()->_name, "aescrypt_decryptBlock") == 0 ||
                   strcmp(call->as_CallLeaf()->_name, "cipherBlockChaining_encryptAESCrypt") == 0 ||
@@ -963,6 +964,7 @@ void ConnectionGraph::process_call_arguments(CallNode *call) {
                   strcmp(call->as_CallLeaf()->_name, "multiplyToLen") == 0 ||
                   strcmp(call->as_CallLeaf()->_name, "squareToLen") == 0 ||
                   strcmp(call->as_CallLeaf()->_name, "mulAdd") == 0 ||
+                  strcmp(call->as_CallLeaf()->_name, "vectorizedMismatch") == 0 ||
                   strcmp(call->as_CallLeaf()->_name, "montgomery_multiply") == 0 ||
                   strcmp(call->as_CallLeaf()->_name, "montgomery_square") == 0)
                  ))) {
@@ -1611,6 +1613,18 @@ int ConnectionGraph::find_init_values(JavaObjectNode* pta, PointsToNode* init_va
   return new_edges;
 }
 
+// Clear scalar_replaceable state and report the reason.
+void ConnectionGraph::set_not_scalar_replaceable(PointsToNode* ptn, const char* reason) {
+#ifndef PRODUCT
+  if (PrintEliminateAllocations && ptn->scalar_replaceable() &&
+      ptn->escape_state() == PointsToNode::NoEscape) {
+    tty->print("EA: NotScalar (%s)", reason);
+    ptn->ideal_node()->dump();
+  }
+#endif
+  ptn->set_scalar_replaceable(false);
+}
+
 // Adjust scalar_replaceable state after Connection Graph is built.
 void ConnectionGraph::adjust_scalar_replaceable_state(JavaObjectNode* jobj) {
   // Search for non-escaping objects which are not scalar replaceable
@@ -1627,7 +1641,7 @@ void ConnectionGraph::adjust_scalar_replaceable_state(JavaObjectNode* jobj) {
       assert(field->is_oop() && field->scalar_replaceable() &&
              field->fields_escape_state() == PointsToNode::NoEscape, "sanity");
       if (field->offset() == Type::OffsetBot) {
-        jobj->set_scalar_replaceable(false);
+        set_not_scalar_replaceable(jobj, "stored at unknown offset");
         return;
       }
       // 2. An object is not scalar replaceable if the field into which it is
@@ -1636,7 +1650,7 @@ void ConnectionGraph::adjust_scalar_replaceable_state(JavaObjectNode* jobj) {
         for (BaseIterator i(field); i.has_next(); i.next()) {
           PointsToNode* base = i.get();
           if (base == null_obj) {
-            jobj->set_scalar_replaceable(false);
+            set_not_scalar_replaceable(jobj, "stored into field with potentially null base");
             return;
           }
         }
@@ -1648,8 +1662,8 @@ void ConnectionGraph::adjust_scalar_replaceable_state(JavaObjectNode* jobj) {
       PointsToNode* ptn = j.get();
       if (ptn->is_JavaObject() && ptn != jobj) {
         // Mark all objects.
-        jobj->set_scalar_replaceable(false);
-         ptn->set_scalar_replaceable(false);
+        set_not_scalar_replaceable(jobj, "merged with other object");
+        set_not_scalar_replaceable(ptn, "merged with other object");
       }
     }
     if (!jobj->scalar_replaceable()) {
@@ -1665,7 +1679,7 @@ void ConnectionGraph::adjust_scalar_replaceable_state(JavaObjectNode* jobj) {
     // 4. An object is not scalar replaceable if it has a field with unknown
     // offset (array's element is accessed in loop).
     if (offset == Type::OffsetBot) {
-      jobj->set_scalar_replaceable(false);
+      set_not_scalar_replaceable(jobj, "field access at unknown offset");
       return;
     }
     // 5. Currently an object is not scalar replaceable if a LoadStore node
@@ -1674,7 +1688,7 @@ void ConnectionGraph::adjust_scalar_replaceable_state(JavaObjectNode* jobj) {
     Node* n = field->ideal_node();
     for (DUIterator_Fast imax, i = n->fast_outs(imax); i < imax; i++) {
       if (n->fast_out(i)->is_LoadStore()) {
-        jobj->set_scalar_replaceable(false);
+        set_not_scalar_replaceable(jobj, "field accessed by LoadStore");
         return;
       }
     }
@@ -1703,8 +1717,8 @@ void ConnectionGraph::adjust_scalar_replaceable_state(JavaObjectNode* jobj) {
         // this field's base by now.
         if (base->is_JavaObject() && base != jobj) {
           // Mark all bases.
-          jobj->set_scalar_replaceable(false);
-          base->set_scalar_replaceable(false);
+          set_not_scalar_replaceable(jobj, "field has multiple bases");
+          set_not_scalar_replaceable(base, "field has multiple bases");
         }
       }
     }
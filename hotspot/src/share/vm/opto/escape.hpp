@@ -456,6 +456,10 @@ private:
   // Adjust scalar_replaceable state after Connection Graph is built.
   void adjust_scalar_replaceable_state(JavaObjectNode* jobj);
 
+  // Clear scalar_replaceable state, reporting the reason with
+  // PrintEliminateAllocations.
+  void set_not_scalar_replaceable(PointsToNode* ptn, const char* reason);
+
   // Optimize ideal graph.
   void optimize_ideal_graph(GrowableArray<Node*>& ptr_cmp_worklist,
                             GrowableArray<Node*>& storestore_worklist);
@@ -3867,6 +3867,138 @@ void GraphKit::write_barrier_post(Node* oop_store,
 }
 
 // G1 pre/post barriers
+
+// The SATB pre-barrier only has to log the previous value of a field; if
+// that is the null the object was allocated with, there is nothing to log,
+// whether marking was running at the allocation or started afterwards. So
+// walk the memory state of the field back to the allocation and elide the
+// barrier if nothing on the way can have stored to it.
+//
+// Stores to other fields and objects are stepped over as MemNode does.
+// Calls are stepped over too as long as the object never escaped to them:
+// a call can only store into an object it can reach, and an object that
+// was neither passed to a call nor stored anywhere is reachable only from
+// this method. The object lies above TAMS if marking started since, and
+// its fields never become part of the snapshot either way.
+bool GraphKit::g1_can_remove_pre_barrier(PhaseTransform* phase, Node* adr,
+                                         BasicType bt, uint adr_idx) {
+  intptr_t offset = 0;
+  Node* base = AddPNode::Ideal_base_and_offset(adr, phase, offset);
+  AllocateNode* alloc = AllocateNode::Ideal_allocation(base, phase);
+
+  if (offset == Type::OffsetBot) {
+    return false; // cannot unalias unless there are precise offsets
+  }
+  if (alloc == NULL) {
+    return false; // no allocation found
+  }
+
+  intptr_t size_in_bytes = type2aelembytes(bt);
+  int escape_checked = -1; // not yet
+
+  Node* mem = memory(adr_idx); // start searching here...
+
+  for (int cnt = 0; cnt < 50; cnt++) {
+    if (mem->is_Store()) {
+      Node* st_adr = mem->in(MemNode::Address);
+      intptr_t st_offset = 0;
+      Node* st_base = AddPNode::Ideal_base_and_offset(st_adr, phase, st_offset);
+
+      if (st_base == NULL) {
+        break; // inscrutable pointer
+      }
+      if (st_base == base && st_offset == offset) {
+        break; // a store to our field
+      }
+      if (st_offset != offset && st_offset != Type::OffsetBot) {
+        const int MAX_STORE = BytesPerLong;
+        if (st_offset >= offset + size_in_bytes ||
+            st_offset <= offset - MAX_STORE ||
+            st_offset <= offset - mem->as_Store()->memory_size()) {
+          // The offsets are provably independent
+          mem = mem->in(MemNode::Memory);
+          continue;
+        }
+      }
+      if (st_base != base &&
+          MemNode::detect_ptr_independence(base, alloc, st_base,
+                                           AllocateNode::Ideal_allocation(st_base, phase),
+                                           phase)) {
+        // The bases are provably independent
+        mem = mem->in(MemNode::Memory);
+        continue;
+      }
+    } else if (mem->is_Proj() && mem->in(0)->is_Initialize()) {
+      InitializeNode* st_init = mem->in(0)->as_Initialize();
+      if (st_init->allocation() == alloc) {
+        // Nothing but the zeroing may have stored there
+        Node* captured_store = st_init->find_captured_store(offset, type2aelembytes(T_OBJECT), phase);
+        return captured_store == NULL || captured_store == st_init->zero_memory();
+      }
+      if (st_init->allocation() != NULL) {
+        // Another allocation only initializes its own object
+        mem = st_init->in(TypeFunc::Memory);
+        if (mem->is_MergeMem()) {
+          mem = mem->as_MergeMem()->memory_at(adr_idx);
+        }
+        continue;
+      }
+    } else if (mem->is_Proj() && mem->in(0)->is_Call()) {
+      if (escape_checked < 0) {
+        escape_checked = g1_new_object_may_escape(base) ? 0 : 1;
+      }
+      if (escape_checked == 1) {
+        mem = mem->in(0)->in(TypeFunc::Memory);
+        if (mem->is_MergeMem()) {
+          mem = mem->as_MergeMem()->memory_at(adr_idx);
+        }
+        continue;
+      }
+    }
+
+    // Unless there is an explicit 'continue', we must bail out here,
+    // because 'mem' is an inscrutable memory state (e.g., a phi).
+    break;
+  }
+
+  return false;
+}
+
+// Conservative: anything but loads from and stores into the object, or
+// it being debug info at a safepoint, counts as an escape.
+bool GraphKit::g1_new_object_may_escape(Node* obj) {
+  for (DUIterator_Fast imax, i = obj->fast_outs(imax); i < imax; i++) {
+    Node* use = obj->fast_out(i);
+    if (use->is_AddP()) {
+      if (use->in(AddPNode::Base) != obj || g1_new_object_may_escape(use)) {
+        return true;
+      }
+    } else if (use->is_Load()) {
+      if (use->in(MemNode::Address) != obj) {
+        return true;
+      }
+    } else if (use->is_Store()) {
+      if (use->in(MemNode::ValueIn) == obj) {
+        return true;
+      }
+    } else if (use->is_SafePoint()) {
+      if (use->is_Call()) {
+        // Arguments escape; the debug info after them does not
+        CallNode* call = use->as_Call();
+        uint parms_end = call->tf()->domain()->cnt();
+        for (uint j = TypeFunc::Parms; j < parms_end && j < call->req(); j++) {
+          if (call->in(j) == obj) {
+            return true;
+          }
+        }
+      }
+    } else if (!use->is_Cmp()) {
+      return true;
+    }
+  }
+  return false;
+}
+
 void GraphKit::g1_write_barrier_pre(bool do_load,
                                     Node* obj,
                                     Node* adr,
@@ -3885,6 +4017,11 @@ void GraphKit::g1_write_barrier_pre(bool do_load,
     assert(adr != NULL, "where are loading from?");
     assert(pre_val == NULL, "loaded already?");
     assert(val_type != NULL, "need a type");
+
+    if (use_ReduceInitialCardMarks() &&
+        g1_can_remove_pre_barrier(&_gvn, adr, bt, alias_idx)) {
+      return;
+    }
   } else {
     // In this case both val_type and alias_idx are unused.
     assert(pre_val != NULL, "must be loaded already");
@@ -317,6 +317,11 @@ class GraphKit : public Phase {
   Node* MulI(Node* l, Node* r)                { return _gvn.transform(new (C) MulINode(l, r));       }
   Node* DivI(Node* ctl, Node* l, Node* r)     { return _gvn.transform(new (C) DivINode(ctl, l, r));  }
 
+  Node* AddL(Node* l, Node* r)                { return _gvn.transform(new (C) AddLNode(l, r));       }
+  Node* SubL(Node* l, Node* r)                { return _gvn.transform(new (C) SubLNode(l, r));       }
+  Node* MulL(Node* l, Node* r)                { return _gvn.transform(new (C) MulLNode(l, r));       }
+  Node* DivL(Node* ctl, Node* l, Node* r)     { return _gvn.transform(new (C) DivLNode(ctl, l, r));  }
+
   Node* AndI(Node* l, Node* r)                { return _gvn.transform(new (C) AndINode(l, r));       }
   Node* OrI(Node* l, Node* r)                 { return _gvn.transform(new (C) OrINode(l, r));        }
   Node* XorI(Node* l, Node* r)                { return _gvn.transform(new (C) XorINode(l, r));       }
@@ -328,6 +333,8 @@ class GraphKit : public Phase {
   Node* RShiftI(Node* l, Node* r)             { return _gvn.transform(new (C) RShiftINode(l, r));    }
   Node* URShiftI(Node* l, Node* r)            { return _gvn.transform(new (C) URShiftINode(l, r));   }
 
+  Node* LShiftL(Node* l, Node* r)             { return _gvn.transform(new (C) LShiftLNode(l, r));    }
+
   Node* CmpI(Node* l, Node* r)                { return _gvn.transform(new (C) CmpINode(l, r));       }
   Node* CmpL(Node* l, Node* r)                { return _gvn.transform(new (C) CmpLNode(l, r));       }
   Node* CmpP(Node* l, Node* r)                { return _gvn.transform(new (C) CmpPNode(l, r));       }
@@ -795,6 +802,12 @@ class GraphKit : public Phase {
                     Node* index, Node* index_adr,
                     Node* buffer, const TypeFunc* tf);
 
+  // Whether the field at adr of an object this method allocated can only
+  // hold the null it was allocated with, so no pre-barrier is needed
+  bool g1_can_remove_pre_barrier(PhaseTransform* phase, Node* adr, BasicType bt, uint adr_idx);
+  // Whether the object this method allocated may have been handed to a call
+  static bool g1_new_object_may_escape(Node* obj);
+
   public:
   // Helper function to round double arguments before a call
   void round_double_arguments(ciMethod* dest_method);
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 1999, 2019, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 1999, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -207,6 +207,7 @@ class LibraryCallKit : public GraphKit {
   Node* round_double_node(Node* n);
   bool runtime_math(const TypeFunc* call_type, address funcAddr, const char* funcName);
   bool inline_math_native(vmIntrinsics::ID id);
+  bool inline_strict_math_native(vmIntrinsics::ID id);
   bool inline_trig(vmIntrinsics::ID id);
   bool inline_math(vmIntrinsics::ID id);
   template <typename OverflowOp>
@@ -251,6 +252,7 @@ class LibraryCallKit : public GraphKit {
   bool inline_native_getLength();
   bool inline_array_copyOf(bool is_copyOfRange);
   bool inline_array_equals();
+  bool inline_array_equals_mismatch(BasicType elem_bt);
   void copy_to_clone(Node* obj, Node* alloc_obj, Node* obj_size, bool is_array, bool card_mark);
   bool inline_native_clone(bool is_virtual);
   bool inline_native_Reflection_getCallerClass();
@@ -328,6 +330,8 @@ class LibraryCallKit : public GraphKit {
   bool inline_updateCRC32();
   bool inline_updateBytesCRC32();
   bool inline_updateByteBufferCRC32();
+  bool inline_updateBytesAdler32();
+  bool inline_updateByteBufferAdler32();
   bool inline_multiplyToLen();
   bool inline_squareToLen();
   bool inline_mulAdd();
@@ -379,6 +383,10 @@ CallGenerator* Compile::make_vm_intrinsic(ciMethod* m, bool is_virtual) {
     case vmIntrinsics::_compareTo:
     case vmIntrinsics::_equals:
     case vmIntrinsics::_equalsC:
+    case vmIntrinsics::_equalsB:
+    case vmIntrinsics::_equalsS:
+    case vmIntrinsics::_equalsI:
+    case vmIntrinsics::_equalsJ:
     case vmIntrinsics::_getAndAddInt:
     case vmIntrinsics::_getAndAddLong:
     case vmIntrinsics::_getAndSetInt:
@@ -398,6 +406,17 @@ CallGenerator* Compile::make_vm_intrinsic(ciMethod* m, bool is_virtual) {
   int predicates = 0;
   bool does_virtual_dispatch = false;
 
+  switch (id) {
+  case vmIntrinsics::_compareTo:
+  case vmIntrinsics::_indexOf:
+  case vmIntrinsics::_equals:
+    // The String intrinsics assume a char[] value array
+    if (java_lang_String::has_coder_field())  return NULL;
+    break;
+  default:
+    break;
+  }
+
   switch (id) {
   case vmIntrinsics::_compareTo:
     if (!SpecialStringCompareTo)  return NULL;
@@ -414,6 +433,13 @@ CallGenerator* Compile::make_vm_intrinsic(ciMethod* m, bool is_virtual) {
     if (!SpecialArraysEquals)  return NULL;
     if (!Matcher::match_rule_supported(Op_AryEq))  return NULL;
     break;
+  case vmIntrinsics::_equalsB:
+  case vmIntrinsics::_equalsS:
+  case vmIntrinsics::_equalsI:
+  case vmIntrinsics::_equalsJ:
+    if (!SpecialArraysEquals)  return NULL;
+    if (!UseVectorizedMismatchIntrinsic)  return NULL;
+    break;
   case vmIntrinsics::_arraycopy:
     if (!InlineArrayCopy)  return NULL;
     break;
@@ -590,6 +616,21 @@ CallGenerator* Compile::make_vm_intrinsic(ciMethod* m, bool is_virtual) {
     if (!UseCRC32Intrinsics) return NULL;
     break;
 
+  case vmIntrinsics::_updateBytesAdler32:
+  case vmIntrinsics::_updateByteBufferAdler32:
+    if (!UseAdler32Intrinsics) return NULL;
+    break;
+
+  case vmIntrinsics::_strict_dsin:
+  case vmIntrinsics::_strict_dcos:
+  case vmIntrinsics::_strict_dtan:
+  case vmIntrinsics::_strict_dlog:
+  case vmIntrinsics::_strict_dlog10:
+  case vmIntrinsics::_strict_dpow:
+  case vmIntrinsics::_strict_dexp:
+    if (!UseStrictMathIntrinsics) return NULL;
+    break;
+
   case vmIntrinsics::_incrementExactI:
   case vmIntrinsics::_addExactI:
     if (!Matcher::match_rule_supported(Op_OverflowAddI) || !UseMathExactIntrinsics) return NULL;
@@ -638,8 +679,9 @@ CallGenerator* Compile::make_vm_intrinsic(ciMethod* m, bool is_virtual) {
     if (!InlineThreadNatives)  return NULL;
   }
 
-  // -XX:-InlineMathNatives disables natives from the Math,Float and Double classes.
+  // -XX:-InlineMathNatives disables natives from the Math,StrictMath,Float and Double classes.
   if (m->holder()->name() == ciSymbol::java_lang_Math() ||
+      m->holder()->name() == ciSymbol::java_lang_StrictMath() ||
       m->holder()->name() == ciSymbol::java_lang_Float() ||
       m->holder()->name() == ciSymbol::java_lang_Double()) {
     if (!InlineMathNatives)  return NULL;
@@ -787,6 +829,14 @@ bool LibraryCallKit::try_to_inline(int predicate) {
   case vmIntrinsics::_dlog10:
   case vmIntrinsics::_dpow:                     return inline_math_native(intrinsic_id());
 
+  case vmIntrinsics::_strict_dsin:
+  case vmIntrinsics::_strict_dcos:
+  case vmIntrinsics::_strict_dtan:
+  case vmIntrinsics::_strict_dlog:
+  case vmIntrinsics::_strict_dlog10:
+  case vmIntrinsics::_strict_dpow:
+  case vmIntrinsics::_strict_dexp:              return inline_strict_math_native(intrinsic_id());
+
   case vmIntrinsics::_min:
   case vmIntrinsics::_max:                      return inline_min_max(intrinsic_id());
 
@@ -907,6 +957,10 @@ bool LibraryCallKit::try_to_inline(int predicate) {
   case vmIntrinsics::_copyOf:                   return inline_array_copyOf(false);
   case vmIntrinsics::_copyOfRange:              return inline_array_copyOf(true);
   case vmIntrinsics::_equalsC:                  return inline_array_equals();
+  case vmIntrinsics::_equalsB:                  return inline_array_equals_mismatch(T_BYTE);
+  case vmIntrinsics::_equalsS:                  return inline_array_equals_mismatch(T_SHORT);
+  case vmIntrinsics::_equalsI:                  return inline_array_equals_mismatch(T_INT);
+  case vmIntrinsics::_equalsJ:                  return inline_array_equals_mismatch(T_LONG);
   case vmIntrinsics::_clone:                    return inline_native_clone(intrinsic()->is_virtual());
 
   case vmIntrinsics::_isAssignableFrom:         return inline_native_subtype_check();
@@ -987,6 +1041,11 @@ bool LibraryCallKit::try_to_inline(int predicate) {
   case vmIntrinsics::_updateByteBufferCRC32:
     return inline_updateByteBufferCRC32();
 
+  case vmIntrinsics::_updateBytesAdler32:
+    return inline_updateBytesAdler32();
+  case vmIntrinsics::_updateByteBufferAdler32:
+    return inline_updateByteBufferAdler32();
+
   case vmIntrinsics::_profileBoolean:
     return inline_profileBoolean();
 
@@ -1371,6 +1430,96 @@ bool LibraryCallKit::inline_array_equals() {
   return true;
 }
 
+//------------------------------inline_array_equals_mismatch-------------------
+// Arrays.equals() of byte, short, int and long arrays. The identity, null
+// and length checks are done inline; the contents are compared by the
+// vectorizedMismatch stub, which returns the index of the first mismatching
+// element or -1.
+bool LibraryCallKit::inline_array_equals_mismatch(BasicType elem_bt) {
+  address stubAddr = StubRoutines::vectorizedMismatch();
+  if (stubAddr == NULL) {
+    return false; // Intrinsic's stub is not implemented on this platform
+  }
+  const char* stubName = "vectorizedMismatch";
+
+  assert(callee()->signature()->size() == 2, "equals has 2 parameters");
+
+  Node* a = argument(0);
+  Node* b = argument(1);
+
+  // paths (plus control) merge
+  RegionNode* region = new (C) RegionNode(6);
+  Node* phi = new (C) PhiNode(region, TypeInt::BOOL);
+
+  // same array (or both null)?
+  Node* cmp = _gvn.transform(new (C) CmpPNode(a, b));
+  Node* bol = _gvn.transform(new (C) BoolNode(cmp, BoolTest::eq));
+
+  Node* if_eq = generate_slow_guard(bol, NULL);
+  if (if_eq != NULL) {
+    phi->init_req(2, intcon(1));
+    region->init_req(2, if_eq);
+  }
+
+  // exactly one of them null?
+  if (!stopped()) {
+    Node* null_ctl = top();
+    a = null_check_oop(a, &null_ctl);
+    if (null_ctl != top()) {
+      phi->init_req(3, intcon(0));
+      region->init_req(3, null_ctl);
+    }
+  }
+  if (!stopped()) {
+    Node* null_ctl = top();
+    b = null_check_oop(b, &null_ctl);
+    if (null_ctl != top()) {
+      phi->init_req(4, intcon(0));
+      region->init_req(4, null_ctl);
+    }
+  }
+
+  if (!stopped()) {
+    Node* a_len = load_array_length(a);
+    Node* b_len = load_array_length(b);
+
+    // Check for a.length != b.length
+    Node* cmp = _gvn.transform(new (C) CmpINode(a_len, b_len));
+    Node* bol = _gvn.transform(new (C) BoolNode(cmp, BoolTest::ne));
+    Node* if_ne = generate_slow_guard(bol, NULL);
+    if (if_ne != NULL) {
+      phi->init_req(5, intcon(0));
+      region->init_req(5, if_ne);
+    }
+
+    // Check for length == 0 is done by the stub.
+
+    if (!stopped()) {
+      Node* a_start = array_element_address(a, intcon(0), elem_bt);
+      Node* b_start = array_element_address(b, intcon(0), elem_bt);
+      Node* scale = intcon(exact_log2(type2aelembytes(elem_bt)));
+
+      Node* call = make_runtime_call(RC_LEAF|RC_NO_FP,
+                                     OptoRuntime::vectorizedMismatch_Type(),
+                                     stubAddr, stubName, TypeAryPtr::get_array_body_type(elem_bt),
+                                     a_start, b_start, a_len, scale);
+      Node* mismatch = _gvn.transform(new (C) ProjNode(call, TypeFunc::Parms));
+
+      // -1 (no mismatch) >>> 31 is 1, any index >>> 31 is 0
+      Node* equals = _gvn.transform(new (C) URShiftINode(mismatch, intcon(BitsPerInt - 1)));
+      phi->init_req(1, equals);
+      region->init_req(1, control());
+    }
+  }
+
+  // post merge
+  set_control(_gvn.transform(region));
+  record_for_igvn(region);
+
+  set_result(_gvn.transform(phi));
+  return true;
+}
+
 // Java version of String.indexOf(constant string)
 // class StringDecl {
 //   StringDecl(char[] ca) {
@@ -2098,6 +2247,37 @@ bool LibraryCallKit::inline_math_native(vmIntrinsics::ID id) {
   }
 }
 
+//--------------------------inline_strict_math_native--------------------------
+// StrictMath results must be bit-for-bit those of fdlibm, so the
+// hardware instructions used by inline_math_native are never an option.
+// The routines in sharedRuntimeTrans.cpp and sharedRuntimeTrig.cpp are
+// ports of the same fdlibm code libjava uses; calling them as leaf
+// routines saves the JNI transition and lets the call be scheduled
+// like any other math runtime call.
+bool LibraryCallKit::inline_strict_math_native(vmIntrinsics::ID id) {
+#define FN_PTR(f) CAST_FROM_FN_PTR(address, f)
+  switch (id) {
+  case vmIntrinsics::_strict_dsin:
+    return runtime_math(OptoRuntime::Math_D_D_Type(),  FN_PTR(SharedRuntime::dsin),   "STRICT_SIN");
+  case vmIntrinsics::_strict_dcos:
+    return runtime_math(OptoRuntime::Math_D_D_Type(),  FN_PTR(SharedRuntime::dcos),   "STRICT_COS");
+  case vmIntrinsics::_strict_dtan:
+    return runtime_math(OptoRuntime::Math_D_D_Type(),  FN_PTR(SharedRuntime::dtan),   "STRICT_TAN");
+  case vmIntrinsics::_strict_dlog:
+    return runtime_math(OptoRuntime::Math_D_D_Type(),  FN_PTR(SharedRuntime::dlog),   "STRICT_LOG");
+  case vmIntrinsics::_strict_dlog10:
+    return runtime_math(OptoRuntime::Math_D_D_Type(),  FN_PTR(SharedRuntime::dlog10), "STRICT_LOG10");
+  case vmIntrinsics::_strict_dexp:
+    return runtime_math(OptoRuntime::Math_D_D_Type(),  FN_PTR(SharedRuntime::dexp),   "STRICT_EXP");
+  case vmIntrinsics::_strict_dpow:
+    return runtime_math(OptoRuntime::Math_DD_D_Type(), FN_PTR(SharedRuntime::dpow),   "STRICT_POW");
+  default:
+    fatal_unexpected_iid(id);
+    return false;
+  }
+#undef FN_PTR
+}
+
 static bool is_simple_name(Node* n) {
   return (n->req() == 1         // constant
           || (n->is_Type() && n->as_Type()->type()->singleton())
@@ -6311,6 +6491,89 @@ bool LibraryCallKit::inline_updateByteBufferCRC32() {
   return true;
 }
 
+/**
+ * Calculate Adler32 for byte[] array.
+ * int java.util.zip.Adler32.updateBytes(int adler, byte[] buf, int off, int len)
+ */
+bool LibraryCallKit::inline_updateBytesAdler32() {
+  assert(UseAdler32Intrinsics, "need Adler32 intrinsic support");
+  assert(callee()->signature()->size() == 4, "updateBytes has 4 parameters");
+
+  address stubAddr = StubRoutines::updateBytesAdler32();
+  if (stubAddr == NULL) {
+    return false; // Intrinsic's stub is not implemented on this platform
+  }
+  const char *stubName = "updateBytesAdler32";
+
+  // no receiver since it is static method
+  Node* adler   = argument(0); // type: int
+  Node* src     = argument(1); // type: oop
+  Node* offset  = argument(2); // type: int
+  Node* length  = argument(3); // type: int
+
+  const Type* src_type = src->Value(&_gvn);
+  const TypeAryPtr* top_src = src_type->isa_aryptr();
+  if (top_src  == NULL || top_src->klass()  == NULL) {
+    // failed array check
+    return false;
+  }
+
+  // Figure out the size and type of the elements we will be copying.
+  BasicType src_elem = src_type->isa_aryptr()->klass()->as_array_klass()->element_type()->basic_type();
+  if (src_elem != T_BYTE) {
+    return false;
+  }
+
+  // 'src_start' points to src array + scaled offset
+  Node* src_start = array_element_address(src, offset, src_elem);
+
+  // We assume that range check is done by caller.
+
+  // Call the stub.
+  Node* call = make_runtime_call(RC_LEAF|RC_NO_FP, OptoRuntime::updateBytesAdler32_Type(),
+                                 stubAddr, stubName, TypePtr::BOTTOM,
+                                 adler, src_start, length);
+  Node* result = _gvn.transform(new (C) ProjNode(call, TypeFunc::Parms));
+  set_result(result);
+  return true;
+}
+
+/**
+ * Calculate Adler32 for ByteBuffer.
+ * int java.util.zip.Adler32.updateByteBuffer(int adler, long buf, int off, int len)
+ */
+bool LibraryCallKit::inline_updateByteBufferAdler32() {
+  assert(UseAdler32Intrinsics, "need Adler32 intrinsic support");
+  assert(callee()->signature()->size() == 5, "updateByteBuffer has 4 parameters and one is long");
+
+  address stubAddr = StubRoutines::updateBytesAdler32();
+  if (stubAddr == NULL) {
+    return false; // Intrinsic's stub is not implemented on this platform
+  }
+  const char *stubName = "updateBytesAdler32";
+
+  // no receiver since it is static method
+  Node* adler   = argument(0); // type: int
+  Node* src     = argument(1); // type: long
+  Node* offset  = argument(3); // type: int
+  Node* length  = argument(4); // type: int
+
+  src = ConvL2X(src);  // adjust Java long to machine word
+  Node* base = _gvn.transform(new (C) CastX2PNode(src));
+  offset = ConvI2X(offset);
+
+  // 'src_start' points to src array + scaled offset
+  Node* src_start = basic_plus_adr(top(), base, offset);
+
+  // Call the stub.
+  Node* call = make_runtime_call(RC_LEAF|RC_NO_FP, OptoRuntime::updateBytesAdler32_Type(),
+                                 stubAddr, stubName, TypePtr::BOTTOM,
+                                 adler, src_start, length);
+  Node* result = _gvn.transform(new (C) ProjNode(call, TypeFunc::Parms));
+  set_result(result);
+  return true;
+}
+
 //----------------------------inline_reference_get----------------------------
 // public T java.lang.ref.Reference.get();
 bool LibraryCallKit::inline_reference_get() {
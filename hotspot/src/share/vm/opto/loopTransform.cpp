@@ -34,6 +34,7 @@
 #include "opto/rootnode.hpp"
 #include "opto/runtime.hpp"
 #include "opto/subnode.hpp"
+#include "opto/vectornode.hpp"
 
 //------------------------------is_loop_exit-----------------------------------
 // Given an IfNode, return the loop-exiting projection or NULL if both
@@ -1190,6 +1191,50 @@ bool IdealLoopTree::is_invariant(Node* n) const {
 }
 
 
+//------------------------------mark_reductions--------------------------------
+// Flag the arithmetic nodes which accumulate into a loop phi.  The flag is
+// copied by the clones made during unrolling, so SuperWord can later pack
+// the chain of unrolled reductions into a single reduction node.
+void PhaseIdealLoop::mark_reductions(IdealLoopTree *loop) {
+  if (!UseSuperWord || !SuperWordReductions) return;
+
+  CountedLoopNode* loop_head = loop->_head->as_CountedLoop();
+  if (loop_head->unrolled_count() > 1) return;
+
+  Node* trip_phi = loop_head->phi();
+  for (DUIterator_Fast imax, i = loop_head->fast_outs(imax); i < imax; i++) {
+    Node* phi = loop_head->fast_out(i);
+    if (!phi->is_Phi() || phi->outcnt() == 0 || phi == trip_phi) continue;
+    // Only definitions which are computed inside the loop
+    Node* def_node = phi->in(LoopNode::LoopBackControl);
+    if (def_node == NULL || def_node->is_reduction() || !has_ctrl(def_node)) continue;
+    Node* n_ctrl = get_ctrl(def_node);
+    if (n_ctrl == NULL || !loop->is_member(get_loop(n_ctrl))) continue;
+    // Does it have a reduction counterpart?
+    int opc = def_node->Opcode();
+    if (opc == ReductionNode::opcode(opc, def_node->bottom_type()->basic_type())) continue;
+    // The phi must feed the operation ...
+    bool ok = false;
+    for (uint j = 1; j < def_node->req(); j++) {
+      if (def_node->in(j) == phi) {
+        ok = true;
+        break;
+      }
+    }
+    // ... and the result must not be used inside the loop except by the phi.
+    for (DUIterator_Fast jmax, j = def_node->fast_outs(jmax); ok && j < jmax; j++) {
+      Node* u = def_node->fast_out(j);
+      if (u != phi && loop->is_member(get_loop(ctrl_or_self(u)))) {
+        ok = false;
+      }
+    }
+    if (ok) {
+      def_node->add_flag(Node::Flag_is_reduction);
+      loop_head->mark_has_reductions();
+    }
+  }
+}
+
 //------------------------------do_unroll--------------------------------------
 // Unroll the loop body one step - make each trip do 2 iterations.
 void PhaseIdealLoop::do_unroll( IdealLoopTree *loop, Node_List &old_new, bool adjust_min_trip ) {
@@ -1215,6 +1260,9 @@ void PhaseIdealLoop::do_unroll( IdealLoopTree *loop, Node_List &old_new, bool ad
   // if rounds of unroll,optimize are making progress
   loop_head->set_node_count_before_unroll(loop->_body.size());
 
+  // Reductions must be identified before the body is cloned.
+  mark_reductions(loop);
+
   Node *ctrl  = loop_head->in(LoopNode::EntryControl);
   Node *limit = loop_head->limit();
   Node *init  = loop_head->init_trip();
@@ -1677,7 +1725,8 @@ bool PhaseIdealLoop::is_scaled_iv(Node* exp, Node* iv, int* p_scale) {
 }
 
 //-----------------------------is_scaled_iv_plus_offset------------------------------
-// Return true if exp is a simple induction variable expression: k1*iv + (invar + k2)
+// Return true if exp is a simple induction variable expression: k1*iv + (invar + k2),
+// possibly multiplied or shifted by a constant as a whole.
 bool PhaseIdealLoop::is_scaled_iv_plus_offset(Node* exp, Node* iv, int* p_scale, Node** p_offset, int depth) {
   if (is_scaled_iv(exp, iv, p_scale)) {
     if (p_offset != NULL) {
@@ -1715,6 +1764,30 @@ bool PhaseIdealLoop::is_scaled_iv_plus_offset(Node* exp, Node* iv, int* p_scale,
         return true;
       }
     }
+  } else if ((opc == Op_MulI || opc == Op_LShiftI) && exp->in(2)->is_Con() && depth < 2) {
+    // (k1*iv + offset) * k3, as in a[(i + 1) * 3], is k1*k3*iv + offset*k3.
+    // Both forms wrap around the same way, so range checks on either are
+    // the same.
+    Node* offset2 = NULL;
+    if (is_scaled_iv_plus_offset(exp->in(1), iv, p_scale,
+                                 p_offset != NULL ? &offset2 : NULL, depth+1)) {
+      jint k3 = exp->in(2)->get_int();
+      if (opc == Op_LShiftI) {
+        k3 = (jint)((juint)1 << (k3 & (BitsPerJavaInteger - 1)));
+      }
+      if (p_scale != NULL) {
+        *p_scale = java_multiply(*p_scale, k3);
+      }
+      if (p_offset != NULL) {
+        Node* ctrl_off2 = get_ctrl(offset2);
+        Node* con_k3 = _igvn.intcon(k3);
+        set_ctrl(con_k3, C->root());
+        Node* offset = new (C) MulINode(offset2, con_k3);
+        register_new_node(offset, ctrl_off2);
+        *p_offset = offset;
+      }
+      return true;
+    }
   } else if (opc == Op_SubI) {
     if (is_scaled_iv(exp->in(1), iv, p_scale)) {
       if (p_offset != NULL) {
@@ -591,7 +591,18 @@ Node *PhaseIdealLoop::conditional_move( Node *region ) {
   float infrequent_prob = PROB_UNLIKELY_MAG(3);
   // Ignore cost and blocks frequency if CMOVE can be moved outside the loop.
   if (used_inside_loop) {
-    if (cost >= ConditionalMoveLimit) return NULL; // Too much goo
+    // A branch the profile shows going both ways often is mispredicted
+    // often, which is worth more speculative work.  The binary entropy
+    // of its probability is 1.0 for a 50/50 branch and 0.0 for one that
+    // always goes the same way.
+    float cost_limit = (float)ConditionalMoveLimit;
+    if (UseProfiledConditionalMove && iff->_fcnt != COUNT_UNKNOWN &&
+        iff->_prob > 0.0f && iff->_prob < 1.0f) {
+      float p = iff->_prob;
+      float entropy = -(p * ::log(p) + (1.0f - p) * ::log(1.0f - p)) / ::log(2.0f);
+      cost_limit *= 1.0f + entropy;
+    }
+    if (cost >= cost_limit) return NULL; // Too much goo
 
     // BlockLayoutByFrequency optimization moves infrequent branch
     // from hot path. No point in CMOV'ing in such case (110 is used
@@ -703,7 +703,8 @@ public:
     Flag_avoid_back_to_back_after    = Flag_avoid_back_to_back_before << 1,
     Flag_has_call                    = Flag_avoid_back_to_back_after << 1,
     Flag_is_expensive                = Flag_has_call << 1,
-    _max_flags = (Flag_is_expensive << 1) - 1 // allow flags combination
+    Flag_is_reduction                = Flag_is_expensive << 1,
+    _max_flags = (Flag_is_reduction << 1) - 1 // allow flags combination
   };
 
 private:
@@ -728,6 +729,10 @@ protected:
 public:
   const jushort class_id() const { return _class_id; }
 
+  // Loop optimizations mark and unmark reduction candidates after construction.
+  void add_flag(jushort fl) { init_flags(fl); }
+  void remove_flag(jushort fl) { clear_flag(fl); }
+
   const jushort flags() const { return _flags; }
 
   // Return a dense integer opcode number
@@ -880,6 +885,9 @@ public:
   bool is_macro() const { return (_flags & Flag_is_macro) != 0; }
   // The node is expensive: the best control is set during loop opts
   bool is_expensive() const { return (_flags & Flag_is_expensive) != 0 && in(0) != NULL; }
+  // The node is a loop carried reduction: its result flows back into a phi
+  // of the loop head and is not otherwise used inside the loop.
+  bool is_reduction() const { return (_flags & Flag_is_reduction) != 0; }
 
 //----------------- Optimization
 
@@ -304,7 +304,7 @@ void Parse::do_new() {
 
   // Keep track of whether opportunities exist for StringBuilder
   // optimizations.
-  if (OptimizeStringConcat &&
+  if (OptimizeStringConcat && !java_lang_String::has_coder_field() &&
       (klass == C->env()->StringBuilder_klass() ||
        klass == C->env()->StringBuffer_klass())) {
     C->set_has_stringbuilder(true);
@@ -51,6 +51,8 @@ enum CompilerPhaseType {
   PHASE_BEFORE_MATCHING,
   PHASE_INCREMENTAL_INLINE,
   PHASE_INCREMENTAL_BOXING_INLINE,
+  PHASE_MATCHING,
+  PHASE_REGISTER_ALLOCATION,
   PHASE_END,
   PHASE_FAILURE,
 
@@ -86,6 +88,8 @@ class CompilerPhaseTypeHelper {
       case PHASE_BEFORE_MATCHING:            return "Before Matching";
       case PHASE_INCREMENTAL_INLINE:         return "Incremental Inline";
       case PHASE_INCREMENTAL_BOXING_INLINE:  return "Incremental Boxing Inline";
+      case PHASE_MATCHING:                   return "Matching";
+      case PHASE_REGISTER_ALLOCATION:        return "Register Allocation";
       case PHASE_END:                        return "End";
       case PHASE_FAILURE:                    return "Failure";
       default:
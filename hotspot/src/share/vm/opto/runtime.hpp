@@ -309,12 +309,14 @@ private:
   static const TypeFunc* squareToLen_Type();
 
   static const TypeFunc* mulAdd_Type();
+  static const TypeFunc* vectorizedMismatch_Type();
   static const TypeFunc* montgomeryMultiply_Type();
   static const TypeFunc* montgomerySquare_Type();
 
   static const TypeFunc* ghash_processBlocks_Type();
 
   static const TypeFunc* updateBytesCRC32_Type();
+  static const TypeFunc* updateBytesAdler32_Type();
 
   // leaf on stack replacement interpreter accessor types
   static const TypeFunc* osr_end_Type();
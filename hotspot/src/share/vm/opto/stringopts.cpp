@@ -61,7 +61,10 @@ class StringConcat : public ResourceObj {
     StringMode,
     IntMode,
     CharMode,
-    StringNullCheckMode
+    StringNullCheckMode,
+    LongMode,
+    BooleanMode,
+    CharArrayMode       // char[] that needs a null check
   };
 
   StringConcat(PhaseStringOpts* stringopts, CallStaticJavaNode* end):
@@ -127,6 +130,15 @@ class StringConcat : public ResourceObj {
   void push_char(Node* value) {
     push(value, CharMode);
   }
+  void push_long(Node* value) {
+    push(value, LongMode);
+  }
+  void push_boolean(Node* value) {
+    push(value, BooleanMode);
+  }
+  void push_char_array(Node* value) {
+    push(value, CharArrayMode);
+  }
 
   static bool is_SB_toString(Node* call) {
     if (call->is_CallStaticJava()) {
@@ -414,14 +426,23 @@ StringConcat* PhaseStringOpts::build_candidate(CallStaticJavaNode* call) {
   ciSymbol* string_sig;
   ciSymbol* int_sig;
   ciSymbol* char_sig;
+  ciSymbol* long_sig;
+  ciSymbol* boolean_sig;
+  ciSymbol* char_array_sig;
   if (m->holder() == C->env()->StringBuilder_klass()) {
     string_sig = ciSymbol::String_StringBuilder_signature();
     int_sig = ciSymbol::int_StringBuilder_signature();
     char_sig = ciSymbol::char_StringBuilder_signature();
+    long_sig = ciSymbol::long_StringBuilder_signature();
+    boolean_sig = ciSymbol::boolean_StringBuilder_signature();
+    char_array_sig = ciSymbol::char_array_StringBuilder_signature();
   } else if (m->holder() == C->env()->StringBuffer_klass()) {
     string_sig = ciSymbol::String_StringBuffer_signature();
     int_sig = ciSymbol::int_StringBuffer_signature();
     char_sig = ciSymbol::char_StringBuffer_signature();
+    long_sig = ciSymbol::long_StringBuffer_signature();
+    boolean_sig = ciSymbol::boolean_StringBuffer_signature();
+    char_array_sig = ciSymbol::char_array_StringBuffer_signature();
   } else {
     return NULL;
   }
@@ -535,13 +556,34 @@ StringConcat* PhaseStringOpts::build_candidate(CallStaticJavaNode* call) {
                cnode->method()->name() == ciSymbol::append_name() &&
                (cnode->method()->signature()->as_symbol() == string_sig ||
                 cnode->method()->signature()->as_symbol() == char_sig ||
-                cnode->method()->signature()->as_symbol() == int_sig)) {
-      sc->add_control(cnode);
+                cnode->method()->signature()->as_symbol() == int_sig ||
+                cnode->method()->signature()->as_symbol() == long_sig ||
+                cnode->method()->signature()->as_symbol() == boolean_sig ||
+                cnode->method()->signature()->as_symbol() == char_array_sig)) {
       Node* arg = cnode->in(TypeFunc::Parms + 1);
+      if (cnode->method()->signature()->as_symbol() == char_array_sig &&
+          _gvn->type(arg) == TypePtr::NULL_PTR) {
+        // append((char[]) null) throws exception.
+#ifndef PRODUCT
+        if (PrintOptimizeStringConcat) {
+          tty->print("giving up because append(null char[]) throws exception ");
+          cnode->jvms()->dump_spec(tty); tty->cr();
+        }
+#endif
+        return NULL;
+      }
+      sc->add_control(cnode);
       if (cnode->method()->signature()->as_symbol() == int_sig) {
         sc->push_int(arg);
       } else if (cnode->method()->signature()->as_symbol() == char_sig) {
         sc->push_char(arg);
+      } else if (cnode->method()->signature()->as_symbol() == long_sig) {
+        // The long takes two argument slots but only the first is used
+        sc->push_long(arg);
+      } else if (cnode->method()->signature()->as_symbol() == boolean_sig) {
+        sc->push_boolean(arg);
+      } else if (cnode->method()->signature()->as_symbol() == char_array_sig) {
+        sc->push_char_array(arg);
       } else {
         if (arg->is_Proj() && arg->in(0)->is_CallStaticJava()) {
           CallStaticJavaNode* csj = arg->in(0)->as_CallStaticJava();
@@ -584,7 +626,10 @@ StringConcat* PhaseStringOpts::build_candidate(CallStaticJavaNode* call) {
 PhaseStringOpts::PhaseStringOpts(PhaseGVN* gvn, Unique_Node_List*):
   Phase(StringOpts),
   _gvn(gvn),
-  _visited(Thread::current()->resource_area()) {
+  _visited(Thread::current()->resource_area()),
+  _num_candidates(0),
+  _num_built(0),
+  _num_fused(0) {
 
   assert(OptimizeStringConcat, "shouldn't be here");
 
@@ -607,10 +652,12 @@ PhaseStringOpts::PhaseStringOpts(PhaseGVN* gvn, Unique_Node_List*):
   // construction.
   GrowableArray<StringConcat*> concats;
   Node_List toStrings = collect_toString_calls();
+  _num_candidates = toStrings.size();
   while (toStrings.size() > 0) {
     StringConcat* sc = build_candidate(toStrings.pop()->as_CallStaticJava());
     if (sc != NULL) {
       concats.push(sc);
+      _num_built++;
     }
   }
 
@@ -664,9 +711,18 @@ PhaseStringOpts::PhaseStringOpts(PhaseGVN* gvn, Unique_Node_List*):
   for (int c = 0; c < concats.length(); c++) {
     StringConcat* sc = concats.at(c);
     replace_string_concat(sc);
+    _num_fused++;
   }
 
   remove_dead_nodes();
+
+  if (PrintOptimizeStringConcat && _num_candidates > 0) {
+    ttyLocker ttyl;
+    tty->print("StringConcat: fused %d of %d toString calls into %d strings in ",
+               _num_built, _num_candidates, _num_fused);
+    C->method()->print_short_name(tty);
+    tty->cr();
+  }
 }
 
 void PhaseStringOpts::record_dead_node(Node* dead) {
@@ -1372,6 +1428,280 @@ void PhaseStringOpts::int_getChars(GraphKit& kit, Node* arg, Node* char_array, N
   }
 }
 
+// The long versions work on the negated value, which unlike the absolute
+// value always exists, so Long.MIN_VALUE needs no special case.
+Node* PhaseStringOpts::long_stringSize(GraphKit& kit, Node* arg) {
+  // int d = (x < 0) ? 1 : 0;
+  // if (x >= 0) x = -x;
+  Node* x;
+  Node* sign_size;
+  {
+    IfNode* iff = kit.create_and_map_if(kit.control(),
+                                        __ Bool(__ CmpL(arg, __ longcon(0)), BoolTest::lt),
+                                        PROB_FAIR, COUNT_UNKNOWN);
+    RegionNode *r = new (C) RegionNode(3);
+    kit.gvn().set_type(r, Type::CONTROL);
+    x = new (C) PhiNode(r, TypeLong::LONG);
+    kit.gvn().set_type(x, TypeLong::LONG);
+    sign_size = new (C) PhiNode(r, TypeInt::INT);
+    kit.gvn().set_type(sign_size, TypeInt::INT);
+    r->init_req(1, __ IfTrue(iff));
+    x->init_req(1, arg);
+    sign_size->init_req(1, __ intcon(1));
+    r->init_req(2, __ IfFalse(iff));
+    x->init_req(2, __ SubL(__ longcon(0), arg));
+    sign_size->init_req(2, __ intcon(0));
+    kit.set_control(r);
+    C->record_for_igvn(r);
+    C->record_for_igvn(x);
+    C->record_for_igvn(sign_size);
+  }
+
+  // long p = -10;
+  // for (int i = 1; i < 19; i++) {
+  //   if (x > p)
+  //     return i + d;
+  //   p = 10 * p;
+  // }
+  // return 19 + d;
+
+  // Add loop predicate first.
+  kit.add_predicate();
+
+  RegionNode *final_merge = new (C) RegionNode(3);
+  kit.gvn().set_type(final_merge, Type::CONTROL);
+  Node* final_size = new (C) PhiNode(final_merge, TypeInt::INT);
+  kit.gvn().set_type(final_size, TypeInt::INT);
+
+  RegionNode *loop = new (C) RegionNode(3);
+  loop->init_req(1, kit.control());
+  kit.gvn().set_type(loop, Type::CONTROL);
+  Node *index = new (C) PhiNode(loop, TypeInt::INT);
+  index->init_req(1, __ intcon(1));
+  kit.gvn().set_type(index, TypeInt::INT);
+  Node *p = new (C) PhiNode(loop, TypeLong::LONG);
+  p->init_req(1, __ longcon(-10));
+  kit.gvn().set_type(p, TypeLong::LONG);
+  kit.set_control(loop);
+
+  IfNode* iff = kit.create_and_map_if(kit.control(),
+                                      __ Bool(__ CmpL(x, p), BoolTest::gt),
+                                      PROB_FAIR, COUNT_UNKNOWN);
+  final_merge->init_req(1, __ IfTrue(iff));
+  final_size->init_req(1, index);
+
+  kit.set_control(__ IfFalse(iff));
+  IfNode* iff2 = kit.create_and_map_if(kit.control(),
+                                       __ Bool(__ CmpI(index, __ intcon(18)), BoolTest::lt),
+                                       PROB_LIKELY_MAG(3), COUNT_UNKNOWN);
+  loop->init_req(2, __ IfTrue(iff2));
+  index->init_req(2, __ AddI(index, __ intcon(1)));
+  p->init_req(2, __ MulL(p, __ longcon(10)));
+  final_merge->init_req(2, __ IfFalse(iff2));
+  final_size->init_req(2, __ intcon(19));
+
+  C->record_for_igvn(loop);
+  C->record_for_igvn(index);
+  C->record_for_igvn(p);
+
+  kit.set_control(final_merge);
+  C->record_for_igvn(final_merge);
+  C->record_for_igvn(final_size);
+
+  return __ AddI(final_size, sign_size);
+}
+
+void PhaseStringOpts::long_getChars(GraphKit& kit, Node* arg, Node* char_array, Node* start, Node* end) {
+  // Simplified version of Long.getChars
+
+  // int charPos = index;
+  Node* charPos = end;
+
+  // char sign = 0;
+  // if (i < 0) {
+  //     sign = '-';
+  // } else {
+  //     i = -i;
+  // }
+  Node* i;
+  Node* sign;
+  {
+    IfNode* iff = kit.create_and_map_if(kit.control(),
+                                        __ Bool(__ CmpL(arg, __ longcon(0)), BoolTest::lt),
+                                        PROB_FAIR, COUNT_UNKNOWN);
+
+    RegionNode *merge = new (C) RegionNode(3);
+    kit.gvn().set_type(merge, Type::CONTROL);
+    i = new (C) PhiNode(merge, TypeLong::LONG);
+    kit.gvn().set_type(i, TypeLong::LONG);
+    sign = new (C) PhiNode(merge, TypeInt::INT);
+    kit.gvn().set_type(sign, TypeInt::INT);
+
+    merge->init_req(1, __ IfTrue(iff));
+    i->init_req(1, arg);
+    sign->init_req(1, __ intcon('-'));
+    merge->init_req(2, __ IfFalse(iff));
+    i->init_req(2, __ SubL(__ longcon(0), arg));
+    sign->init_req(2, __ intcon(0));
+
+    kit.set_control(merge);
+
+    C->record_for_igvn(merge);
+    C->record_for_igvn(i);
+    C->record_for_igvn(sign);
+  }
+
+  // for (;;) {
+  //     q = i / 10;
+  //     r = ((q << 3) + (q << 1)) - i;  // r = (q*10)-i ...
+  //     buf [--charPos] = digits [r];
+  //     i = q;
+  //     if (i == 0) break;
+  // }
+
+  {
+    // Add loop predicate first.
+    kit.add_predicate();
+
+    RegionNode *head = new (C) RegionNode(3);
+    head->init_req(1, kit.control());
+    kit.gvn().set_type(head, Type::CONTROL);
+    Node *i_phi = new (C) PhiNode(head, TypeLong::LONG);
+    i_phi->init_req(1, i);
+    kit.gvn().set_type(i_phi, TypeLong::LONG);
+    charPos = PhiNode::make(head, charPos);
+    kit.gvn().set_type(charPos, TypeInt::INT);
+    Node *mem = PhiNode::make(head, kit.memory(char_adr_idx), Type::MEMORY, TypeAryPtr::CHARS);
+    kit.gvn().set_type(mem, Type::MEMORY);
+    kit.set_control(head);
+    kit.set_memory(mem, char_adr_idx);
+
+    Node* q = __ DivL(NULL, i_phi, __ longcon(10));
+    Node* r = __ ConvL2I(__ SubL(__ AddL(__ LShiftL(q, __ intcon(3)),
+                                         __ LShiftL(q, __ intcon(1))), i_phi));
+    Node* m1 = __ SubI(charPos, __ intcon(1));
+    Node* ch = __ AddI(r, __ intcon('0'));
+
+    Node* st = __ store_to_memory(kit.control(), kit.array_element_address(char_array, m1, T_CHAR),
+                                  ch, T_CHAR, char_adr_idx, MemNode::unordered);
+
+
+    IfNode* iff = kit.create_and_map_if(head, __ Bool(__ CmpL(q, __ longcon(0)), BoolTest::ne),
+                                        PROB_FAIR, COUNT_UNKNOWN);
+    Node* ne = __ IfTrue(iff);
+    Node* eq = __ IfFalse(iff);
+
+    head->init_req(2, ne);
+    mem->init_req(2, st);
+    i_phi->init_req(2, q);
+    charPos->init_req(2, m1);
+
+    charPos = m1;
+
+    kit.set_control(eq);
+    kit.set_memory(st, char_adr_idx);
+
+    C->record_for_igvn(head);
+    C->record_for_igvn(mem);
+    C->record_for_igvn(i_phi);
+    C->record_for_igvn(charPos);
+  }
+
+  {
+    // if (sign != 0) {
+    //     buf [--charPos] = sign;
+    // }
+    RegionNode *final_merge = new (C) RegionNode(3);
+    kit.gvn().set_type(final_merge, Type::CONTROL);
+    Node *final_mem = PhiNode::make(final_merge, kit.memory(char_adr_idx), Type::MEMORY, TypeAryPtr::CHARS);
+    kit.gvn().set_type(final_mem, Type::MEMORY);
+
+    IfNode* iff = kit.create_and_map_if(kit.control(),
+                                        __ Bool(__ CmpI(sign, __ intcon(0)), BoolTest::ne),
+                                        PROB_FAIR, COUNT_UNKNOWN);
+
+    final_merge->init_req(2, __ IfFalse(iff));
+    final_mem->init_req(2, kit.memory(char_adr_idx));
+
+    kit.set_control(__ IfTrue(iff));
+    if (kit.stopped()) {
+      final_merge->init_req(1, C->top());
+      final_mem->init_req(1, C->top());
+    } else {
+      Node* m1 = __ SubI(charPos, __ intcon(1));
+      Node* st = __ store_to_memory(kit.control(), kit.array_element_address(char_array, m1, T_CHAR),
+                                    sign, T_CHAR, char_adr_idx, MemNode::unordered);
+
+      final_merge->init_req(1, kit.control());
+      final_mem->init_req(1, st);
+    }
+
+    kit.set_control(final_merge);
+    kit.set_memory(final_mem, char_adr_idx);
+
+    C->record_for_igvn(final_merge);
+    C->record_for_igvn(final_mem);
+  }
+}
+
+Node* PhaseStringOpts::boolean_stringSize(GraphKit& kit, Node* arg) {
+  // b ? 4 : 5
+  RegionNode *r = new (C) RegionNode(3);
+  kit.gvn().set_type(r, Type::CONTROL);
+  Node *size = new (C) PhiNode(r, TypeInt::INT);
+  kit.gvn().set_type(size, TypeInt::INT);
+  IfNode* iff = kit.create_and_map_if(kit.control(),
+                                      __ Bool(__ CmpI(arg, __ intcon(0)), BoolTest::ne),
+                                      PROB_FAIR, COUNT_UNKNOWN);
+  r->init_req(1, __ IfTrue(iff));
+  size->init_req(1, __ intcon(4));
+  r->init_req(2, __ IfFalse(iff));
+  size->init_req(2, __ intcon(5));
+  kit.set_control(r);
+  C->record_for_igvn(r);
+  C->record_for_igvn(size);
+  return size;
+}
+
+void PhaseStringOpts::boolean_getChars(GraphKit& kit, Node* arg, Node* char_array, Node* start) {
+  RegionNode *final_merge = new (C) RegionNode(3);
+  kit.gvn().set_type(final_merge, Type::CONTROL);
+  Node *final_mem = PhiNode::make(final_merge, kit.memory(char_adr_idx), Type::MEMORY, TypeAryPtr::CHARS);
+  kit.gvn().set_type(final_mem, Type::MEMORY);
+
+  IfNode* iff = kit.create_and_map_if(kit.control(),
+                                      __ Bool(__ CmpI(arg, __ intcon(0)), BoolTest::ne),
+                                      PROB_FAIR, COUNT_UNKNOWN);
+  Node* old_mem = kit.memory(char_adr_idx);
+
+  kit.set_control(__ IfTrue(iff));
+  if (kit.stopped()) {
+    final_merge->init_req(1, C->top());
+    final_mem->init_req(1, C->top());
+  } else {
+    store_chars(kit, "true", char_array, start);
+    final_merge->init_req(1, kit.control());
+    final_mem->init_req(1, kit.memory(char_adr_idx));
+  }
+
+  kit.set_control(__ IfFalse(iff));
+  kit.set_memory(old_mem, char_adr_idx);
+  if (kit.stopped()) {
+    final_merge->init_req(2, C->top());
+    final_mem->init_req(2, C->top());
+  } else {
+    store_chars(kit, "false", char_array, start);
+    final_merge->init_req(2, kit.control());
+    final_mem->init_req(2, kit.memory(char_adr_idx));
+  }
+
+  kit.set_control(final_merge);
+  kit.set_memory(final_mem, char_adr_idx);
+
+  C->record_for_igvn(final_merge);
+  C->record_for_igvn(final_mem);
+}
+
 
 Node* PhaseStringOpts::copy_string(GraphKit& kit, Node* str, Node* char_array, Node* start) {
   Node* string = str;
@@ -1394,20 +1724,36 @@ Node* PhaseStringOpts::copy_string(GraphKit& kit, Node* str, Node* char_array, N
       start = __ AddI(start, __ intcon(1));
     }
   } else {
-    Node* src_ptr = kit.array_element_address(value, offset, T_CHAR);
-    Node* dst_ptr = kit.array_element_address(char_array, start, T_CHAR);
-    Node* c = count;
-    Node* extra = NULL;
+    start = copy_chars(kit, value, offset, count, char_array, start);
+  }
+  return start;
+}
+
+
+Node* PhaseStringOpts::copy_chars(GraphKit& kit, Node* src_array, Node* src_offset, Node* count,
+                                  Node* char_array, Node* start) {
+  Node* src_ptr = kit.array_element_address(src_array, src_offset, T_CHAR);
+  Node* dst_ptr = kit.array_element_address(char_array, start, T_CHAR);
+  Node* c = count;
+  Node* extra = NULL;
 #ifdef _LP64
-    c = __ ConvI2L(c);
-    extra = C->top();
+  c = __ ConvI2L(c);
+  extra = C->top();
 #endif
-    Node* call = kit.make_runtime_call(GraphKit::RC_LEAF|GraphKit::RC_NO_FP,
-                                       OptoRuntime::fast_arraycopy_Type(),
-                                       CAST_FROM_FN_PTR(address, StubRoutines::jshort_disjoint_arraycopy()),
-                                       "jshort_disjoint_arraycopy", TypeAryPtr::CHARS,
-                                       src_ptr, dst_ptr, c, extra);
-    start = __ AddI(start, count);
+  Node* call = kit.make_runtime_call(GraphKit::RC_LEAF|GraphKit::RC_NO_FP,
+                                     OptoRuntime::fast_arraycopy_Type(),
+                                     CAST_FROM_FN_PTR(address, StubRoutines::jshort_disjoint_arraycopy()),
+                                     "jshort_disjoint_arraycopy", TypeAryPtr::CHARS,
+                                     src_ptr, dst_ptr, c, extra);
+  return __ AddI(start, count);
+}
+
+
+Node* PhaseStringOpts::store_chars(GraphKit& kit, const char* s, Node* char_array, Node* start) {
+  for (const char* p = s; *p != '\0'; p++) {
+    __ store_to_memory(kit.control(), kit.array_element_address(char_array, start, T_CHAR),
+                       __ intcon(*p), T_CHAR, char_adr_idx, MemNode::unordered);
+    start = __ AddI(start, __ intcon(1));
   }
   return start;
 }
@@ -1552,6 +1898,37 @@ void PhaseStringOpts::replace_string_concat(StringConcat* sc) {
         length = __ AddI(length, __ intcon(1));
         break;
       }
+      case StringConcat::LongMode:
+      case StringConcat::BooleanMode: {
+        Node* string_size = sc->mode(argi) == StringConcat::LongMode ?
+                            long_stringSize(kit, arg) : boolean_stringSize(kit, arg);
+
+        // accumulate total
+        length = __ AddI(length, string_size);
+
+        // Cache this value for the use by long_getChars
+        string_sizes->init_req(argi, string_size);
+        break;
+      }
+      case StringConcat::CharArrayMode: {
+        const Type* type = kit.gvn().type(arg);
+        assert(type != TypePtr::NULL_PTR, "missing check");
+        if (!type->higher_equal(TypePtr::NOTNULL)) {
+          // Null check with uncommon trap since append(char[]) throws
+          // exception for null, like for StringNullCheckMode.
+          Node* p = __ Bool(__ CmpP(arg, kit.null()), BoolTest::ne);
+          IfNode* iff = kit.create_and_map_if(kit.control(), p, PROB_MIN, COUNT_UNKNOWN);
+          overflow->add_req(__ IfFalse(iff));
+          Node* notnull = __ IfTrue(iff);
+          kit.set_control(notnull); // set control for the cast_not_null
+          arg = kit.cast_not_null(arg, false);
+          sc->set_argument(argi, arg);
+        }
+        Node* count = kit.load_array_length(arg);
+        length = __ AddI(length, count);
+        string_sizes->init_req(argi, count);
+        break;
+      }
       default:
         ShouldNotReachHere();
     }
@@ -1619,6 +1996,22 @@ void PhaseStringOpts::replace_string_concat(StringConcat* sc) {
           start = __ AddI(start, __ intcon(1));
           break;
         }
+        case StringConcat::LongMode: {
+          Node* end = __ AddI(start, string_sizes->in(argi));
+          // getChars words backwards so pass the ending point as well as the start
+          long_getChars(kit, arg, char_array, start, end);
+          start = end;
+          break;
+        }
+        case StringConcat::BooleanMode: {
+          boolean_getChars(kit, arg, char_array, start);
+          start = __ AddI(start, string_sizes->in(argi));
+          break;
+        }
+        case StringConcat::CharArrayMode: {
+          start = copy_chars(kit, arg, __ intcon(0), string_sizes->in(argi), char_array, start);
+          break;
+        }
         default:
           ShouldNotReachHere();
       }
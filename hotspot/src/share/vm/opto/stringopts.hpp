@@ -48,6 +48,11 @@ class PhaseStringOpts : public Phase {
   // A set for use by various stages
   VectorSet _visited;
 
+  // Statistics for PrintOptimizeStringConcat
+  int _num_candidates;  // toString calls looked at
+  int _num_built;       // of them that can be replaced
+  int _num_fused;       // concats replaced, after stacking
+
   // Collect a list of all SB.toString calls
   Node_List collect_toString_calls();
 
@@ -67,9 +72,25 @@ class PhaseStringOpts : public Phase {
   // Copy the characters representing value into char_array starting at start
   void int_getChars(GraphKit& kit, Node* value, Node* char_array, Node* start, Node* end);
 
+  // Same for long values
+  Node* long_stringSize(GraphKit& kit, Node* value);
+  void long_getChars(GraphKit& kit, Node* value, Node* char_array, Node* start, Node* end);
+
+  // Same for boolean values, which are "true" or "false"
+  Node* boolean_stringSize(GraphKit& kit, Node* value);
+  void boolean_getChars(GraphKit& kit, Node* value, Node* char_array, Node* start);
+
   // Copy of the contents of the String str into char_array starting at index start.
   Node* copy_string(GraphKit& kit, Node* str, Node* char_array, Node* start);
 
+  // Copy count chars of src_array starting at src_offset into char_array
+  // starting at index start.
+  Node* copy_chars(GraphKit& kit, Node* src_array, Node* src_offset, Node* count,
+                   Node* char_array, Node* start);
+
+  // Store the characters of a C string into char_array starting at index start.
+  Node* store_chars(GraphKit& kit, const char* s, Node* char_array, Node* start);
+
   // Clean up any leftover nodes
   void record_dead_node(Node* node);
   void remove_dead_nodes();
@@ -680,7 +680,7 @@ bool SuperWord::stmts_can_pack(Node* s1, Node* s2, int align) {
   }
 
   if (isomorphic(s1, s2)) {
-    if (independent(s1, s2)) {
+    if (independent(s1, s2) || reduction(s1, s2)) {
       if (!exists_at(s1, 0) && !exists_at(s2, 1)) {
         if (!s1->is_Mem() || are_adjacent_refs(s1, s2)) {
           int s1_align = alignment(s1);
@@ -758,6 +758,20 @@ bool SuperWord::independent(Node* s1, Node* s2) {
   return independent_path(shallow, deep);
 }
 
+//------------------------------reduction---------------------------
+// Is s1 a reduction which directly feeds the reduction s2?  Such pairs are
+// dependent but can still be packed: the pack is an ordered chain.
+bool SuperWord::reduction(Node* s1, Node* s2) {
+  if (!s1->is_reduction() || !s2->is_reduction()) return false;
+  if (depth(s1) + 1 != depth(s2)) return false;
+  for (DUIterator_Fast imax, i = s1->fast_outs(imax); i < imax; i++) {
+    if (s1->fast_out(i) == s2) {
+      return true;
+    }
+  }
+  return false;
+}
+
 //------------------------------independent_path------------------------------
 // Helper for independent
 bool SuperWord::independent_path(Node* shallow, Node* deep, uint dp) {
@@ -899,6 +913,20 @@ bool SuperWord::follow_def_uses(Node_List* p) {
 //---------------------------opnd_positions_match-------------------------
 // Is the use of d1 in u1 at the same operand position as d2 in u2?
 bool SuperWord::opnd_positions_match(Node* d1, Node* u1, Node* d2, Node* u2) {
+  if (u1->is_reduction() && u2->is_reduction()) {
+    // Keep the accumulated value (the loop phi or the previous reduction)
+    // in the first operand so that reductions line up with each other.
+    Node* first = u1->in(2);
+    if (first->is_Phi() || first->is_reduction()) {
+      u1->swap_edges(1, 2);
+    }
+    first = u2->in(2);
+    if (first->is_Phi() || first->is_reduction()) {
+      u2->swap_edges(1, 2);
+    }
+    return true;
+  }
+
   uint ct = u1->req();
   if (ct != u2->req()) return false;
   uint i1 = 0;
@@ -1108,6 +1136,14 @@ void SuperWord::filter_packs() {
 // Can code be generated for pack p?
 bool SuperWord::implemented(Node_List* p) {
   Node* p0 = p->at(0);
+  if (p0->is_reduction()) {
+    BasicType bt = p0->bottom_type()->basic_type();
+    // Length 2 reductions of INT/LONG do not offer performance benefits
+    if ((bt == T_INT || bt == T_LONG) && p->size() == 2) {
+      return false;
+    }
+    return ReductionNode::implemented(p0->Opcode(), p->size(), bt);
+  }
   return VectorNode::implemented(p0->Opcode(), p->size(), velt_basic_type(p0));
 }
 
@@ -1142,6 +1178,13 @@ bool SuperWord::profitable(Node_List* p) {
     if (!is_vector_use(p0, i))
       return false;
   }
+  if (p0->is_reduction() && !reduction_chain(p)) {
+    // Not a chain of reductions over a packed input, do not try again.
+    for (uint i = 0; i < p->size(); i++) {
+      p->at(i)->remove_flag(Node::Flag_is_reduction);
+    }
+    return false;
+  }
   if (VectorNode::is_shift(p0)) {
     // For now, return false if shift count is vector or not scalar promotion
     // case (different shift counts) because it is not supported yet.
@@ -1152,6 +1195,13 @@ bool SuperWord::profitable(Node_List* p) {
     if (!same_inputs(p, 2))
       return false;
   }
+  if (VectorNode::is_convert(p0)) {
+    // The input must be a vector with elements of the same size; a
+    // scalar would be promoted to a vector of the result type.
+    Node_List* in_pk = my_pack(p0->in(1));
+    if (in_pk == NULL || data_size(in_pk->at(0)) != data_size(p0))
+      return false;
+  }
   if (!p0->is_Store()) {
     // For now, return false if not all uses are vector.
     // Later, implement ExtractNode and allow non-vector uses (maybe
@@ -1163,6 +1213,12 @@ bool SuperWord::profitable(Node_List* p) {
         for (uint k = 0; k < use->req(); k++) {
           Node* n = use->in(k);
           if (def == n) {
+            // The last reduction feeds the loop phi and uses after the loop
+            if (def->is_reduction() &&
+                ((use->is_Phi() && use->in(0) == lpt()->_head) ||
+                 !lpt()->is_member(_phase->get_loop(_phase->ctrl_or_self(use))))) {
+              continue;
+            }
             if (!is_vector_use(use, k)) {
               return false;
             }
@@ -1174,6 +1230,28 @@ bool SuperWord::profitable(Node_List* p) {
   return true;
 }
 
+//------------------------------reduction_chain---------------------------
+// Is reduction pack p an ordered chain, each member accumulating into its
+// predecessor, over a vector operand whose members line up with ours?
+bool SuperWord::reduction_chain(Node_List* p) {
+  Node* p0 = p->at(0);
+  Node_List* in2_pk = my_pack(p0->in(2));
+  if (in2_pk == NULL || in2_pk->size() != p->size()) {
+    return false;
+  }
+  for (uint i = 0; i < p->size(); i++) {
+    Node* pi = p->at(i);
+    Node* di = in2_pk->at(i);
+    if (!pi->is_reduction() || pi->in(2) != di || alignment(pi) != alignment(di)) {
+      return false;
+    }
+    if (i > 0 && pi->in(1) != p->at(i-1)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 //------------------------------schedule---------------------------
 // Adjust the memory graph for the packed operations
 void SuperWord::schedule() {
@@ -1395,8 +1473,12 @@ void SuperWord::output() {
 
   // MUST ENSURE main loop's initial value is properly aligned:
   //  (iv_initial_value + min_iv_offset) % vector_width_in_bytes() == 0
+  // unless misaligned vectors are allowed and the loop is too short to
+  // amortize the extra scalar iterations.
 
-  align_initial_loop_index(align_to_ref());
+  if (pre_loop_align_profitable()) {
+    align_initial_loop_index(align_to_ref());
+  }
 
   // Insert extract (unpack) operations for scalar uses
   for (int i = 0; i < _packset.length(); i++) {
@@ -1445,6 +1527,17 @@ void SuperWord::output() {
         const TypePtr* atyp = n->adr_type();
         vn = StoreVectorNode::make(C, opc, ctl, mem, adr, atyp, val, vlen);
         vlen_in_bytes = vn->as_StoreVector()->memory_size();
+      } else if (n->is_reduction()) {
+        // The scalar input of the first reduction is retained and the
+        // second operands are combined into a vector.
+        Node* in1 = low_adr->in(1);
+        Node* in2 = vector_opd(p, 2);
+        vn = ReductionNode::make(C, opc, NULL, in1, in2, n->bottom_type()->basic_type());
+        if (in2->is_Load()) {
+          vlen_in_bytes = in2->as_LoadVector()->memory_size();
+        } else {
+          vlen_in_bytes = in2->as_Vector()->length_in_bytes();
+        }
       } else if (n->req() == 3) {
         // Promote operands to vector
         Node* in1 = vector_opd(p, 1);
@@ -1457,6 +1550,10 @@ void SuperWord::output() {
         }
         vn = VectorNode::make(C, opc, in1, in2, vlen, velt_basic_type(n));
         vlen_in_bytes = vn->as_Vector()->length_in_bytes();
+      } else if (VectorNode::is_convert(n)) {
+        Node* in = vector_opd(p, 1);
+        vn = VectorNode::make(C, opc, in, NULL, vlen, velt_basic_type(n));
+        vlen_in_bytes = vn->as_Vector()->length_in_bytes();
       } else {
         ShouldNotReachHere();
       }
@@ -1570,6 +1667,8 @@ Node* SuperWord::vector_opd(Node_List* p, int opd_idx) {
 // use with an extract operation.
 void SuperWord::insert_extracts(Node_List* p) {
   if (p->at(0)->is_Store()) return;
+  // A reduction produces a scalar which replaces the whole pack.
+  if (p->at(0)->is_reduction()) return;
   assert(_n_idx_list.is_empty(), "empty (node,index) list");
 
   // Inspect each use of each pack member.  For each use that is
@@ -1616,6 +1715,8 @@ void SuperWord::insert_extracts(Node_List* p) {
 bool SuperWord::is_vector_use(Node* use, int u_idx) {
   Node_List* u_pk = my_pack(use);
   if (u_pk == NULL) return false;
+  // Operands of reductions are verified by reduction_chain().
+  if (use->is_reduction()) return true;
   Node* def = use->in(u_idx);
   Node_List* d_pk = my_pack(def);
   if (d_pk == NULL) {
@@ -2206,6 +2307,28 @@ void SuperWord::align_initial_loop_index(MemNode* align_to_ref) {
   pre_opaq->set_req(1, constrained);
 }
 
+//----------------------------pre_loop_align_profitable---------------------------
+// Aligning the main loop costs up to a vector's worth of scalar pre-loop
+// iterations.  It is required when the hardware can not access misaligned
+// vectors; otherwise it is skipped for loops which are known or profiled to
+// be short, where those iterations would dominate the vector work.
+bool SuperWord::pre_loop_align_profitable() {
+  if (!Matcher::misaligned_vectors_ok() || VectorAlignTripCountLimit <= 0) {
+    return true;
+  }
+  CountedLoopNode* cl = lp()->as_CountedLoop();
+  float trip_cnt = cl->has_exact_trip_count() ? (float)cl->trip_count() : cl->profile_trip_cnt();
+  if (trip_cnt == COUNT_UNKNOWN || trip_cnt >= (float)VectorAlignTripCountLimit) {
+    return true;
+  }
+#ifndef PRODUCT
+  if (TraceSuperWord) {
+    tty->print_cr("SuperWord: no pre-loop alignment, trip count %f", trip_cnt);
+  }
+#endif
+  return false;
+}
+
 //----------------------------get_pre_loop_end---------------------------
 // Find pre loop end from main loop.  Returns null if none.
 CountedLoopEndNode* SuperWord::get_pre_loop_end(CountedLoopNode* cl) {
@@ -366,6 +366,8 @@ class SuperWord : public ResourceObj {
   bool independent(Node* s1, Node* s2);
   // Helper for independent
   bool independent_path(Node* shallow, Node* deep, uint dp=0);
+  // Is s1 a reduction which directly feeds the reduction s2?
+  bool reduction(Node* s1, Node* s2);
   void set_alignment(Node* s1, Node* s2, int align);
   int data_size(Node* s);
   // Extend packset by following use->def and def->use links from pack members.
@@ -401,6 +403,8 @@ class SuperWord : public ResourceObj {
   bool implemented(Node_List* p);
   // For pack p, are all operands and all uses (with in the block) vector?
   bool profitable(Node_List* p);
+  // Is reduction pack p an ordered chain over a matching vector operand?
+  bool reduction_chain(Node_List* p);
   // If a use of pack p is not a vector use, then replace the use with an extract operation.
   void insert_extracts(Node_List* p);
   // Is use->in(u_idx) a vector use?
@@ -435,6 +439,8 @@ class SuperWord : public ResourceObj {
   // Adjust pre-loop limit so that in main loop, a load/store reference
   // to align_to_ref will be a position zero in the vector.
   void align_initial_loop_index(MemNode* align_to_ref);
+  // Is it worth running extra pre-loop iterations to align the main loop?
+  bool pre_loop_align_profitable();
   // Find pre loop end from main loop.  Returns null if none.
   CountedLoopEndNode* get_pre_loop_end(CountedLoopNode *cl);
   // Is the use of d1 in u1 at the same operand position as d2 in u2?
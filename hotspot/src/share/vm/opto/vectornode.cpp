@@ -138,6 +138,12 @@ int VectorNode::opcode(int sopc, BasicType bt) {
   case Op_XorI:
   case Op_XorL:
     return Op_XorV;
+  case Op_ConvI2F:
+    assert(bt == T_FLOAT, "must be");
+    return Op_VectorCastI2F;
+  case Op_ConvF2I:
+    // The result may have been narrowed for a store to a smaller type
+    return bt == T_INT ? Op_VectorCastF2I : 0;
 
   case Op_LoadB:
   case Op_LoadUB:
@@ -185,6 +191,15 @@ bool VectorNode::is_shift(Node* n) {
   return false;
 }
 
+bool VectorNode::is_convert(Node* n) {
+  switch (n->Opcode()) {
+  case Op_ConvI2F:
+  case Op_ConvF2I:
+    return true;
+  }
+  return false;
+}
+
 // Check if input is loop invariant vector.
 bool VectorNode::is_invariant_vector(Node* n) {
   // Only Replicate vector nodes are loop invariant for now.
@@ -292,6 +307,9 @@ VectorNode* VectorNode::make(Compile* C, int opc, Node* n1, Node* n2, uint vlen,
   case Op_AndV: return new (C) AndVNode(n1, n2, vt);
   case Op_OrV:  return new (C) OrVNode (n1, n2, vt);
   case Op_XorV: return new (C) XorVNode(n1, n2, vt);
+
+  case Op_VectorCastI2F: return new (C) VectorCastI2FNode(n1, vt);
+  case Op_VectorCastF2I: return new (C) VectorCastF2INode(n1, vt);
   }
   fatal(err_msg_res("Missed vector creation for '%s'", NodeClassNames[vopc]));
   return NULL;
@@ -442,3 +460,106 @@ Node* ExtractNode::make(Compile* C, Node* v, uint position, BasicType bt) {
   return NULL;
 }
 
+
+//------------------------------ReductionNode-----------------------------------
+
+// Return the reduction operator for the specified scalar operation
+// or the scalar opcode itself if there is none.
+int ReductionNode::opcode(int opc, BasicType bt) {
+  int vopc = opc;
+  switch (opc) {
+  case Op_AddI:
+    if (bt == T_INT) vopc = Op_AddReductionVI;
+    break;
+  case Op_AddL:
+    assert(bt == T_LONG, "must be");
+    vopc = Op_AddReductionVL;
+    break;
+  case Op_AddF:
+    assert(bt == T_FLOAT, "must be");
+    vopc = Op_AddReductionVF;
+    break;
+  case Op_AddD:
+    assert(bt == T_DOUBLE, "must be");
+    vopc = Op_AddReductionVD;
+    break;
+  case Op_MulI:
+    if (bt == T_INT) vopc = Op_MulReductionVI;
+    break;
+  case Op_MulF:
+    assert(bt == T_FLOAT, "must be");
+    vopc = Op_MulReductionVF;
+    break;
+  case Op_MulD:
+    assert(bt == T_DOUBLE, "must be");
+    vopc = Op_MulReductionVD;
+    break;
+  case Op_AndI:
+    if (bt == T_INT) vopc = Op_AndReductionV;
+    break;
+  case Op_AndL:
+    assert(bt == T_LONG, "must be");
+    vopc = Op_AndReductionV;
+    break;
+  case Op_OrI:
+    if (bt == T_INT) vopc = Op_OrReductionV;
+    break;
+  case Op_OrL:
+    assert(bt == T_LONG, "must be");
+    vopc = Op_OrReductionV;
+    break;
+  case Op_XorI:
+    if (bt == T_INT) vopc = Op_XorReductionV;
+    break;
+  case Op_XorL:
+    assert(bt == T_LONG, "must be");
+    vopc = Op_XorReductionV;
+    break;
+  case Op_MinI:
+    if (bt == T_INT) vopc = Op_MinReductionV;
+    break;
+  case Op_MaxI:
+    if (bt == T_INT) vopc = Op_MaxReductionV;
+    break;
+  default:
+    break;
+  }
+  return vopc;
+}
+
+// Return the appropriate reduction node.
+ReductionNode* ReductionNode::make(Compile* C, int opc, Node *ctrl, Node* n1, Node* n2, BasicType bt) {
+  int vopc = opcode(opc, bt);
+  // This method should not be called for unimplemented vectors.
+  guarantee(vopc != opc, err_msg_res("Vector for '%s' is not implemented", NodeClassNames[opc]));
+
+  const Type* t = Type::get_const_basic_type(bt);
+  switch (vopc) {
+  case Op_AddReductionVI: return new (C) AddReductionVINode(ctrl, n1, n2, t);
+  case Op_AddReductionVL: return new (C) AddReductionVLNode(ctrl, n1, n2, t);
+  case Op_AddReductionVF: return new (C) AddReductionVFNode(ctrl, n1, n2, t);
+  case Op_AddReductionVD: return new (C) AddReductionVDNode(ctrl, n1, n2, t);
+  case Op_MulReductionVI: return new (C) MulReductionVINode(ctrl, n1, n2, t);
+  case Op_MulReductionVF: return new (C) MulReductionVFNode(ctrl, n1, n2, t);
+  case Op_MulReductionVD: return new (C) MulReductionVDNode(ctrl, n1, n2, t);
+  case Op_AndReductionV:  return new (C) AndReductionVNode (ctrl, n1, n2, t);
+  case Op_OrReductionV:   return new (C) OrReductionVNode  (ctrl, n1, n2, t);
+  case Op_XorReductionV:  return new (C) XorReductionVNode (ctrl, n1, n2, t);
+  case Op_MinReductionV:  return new (C) MinReductionVNode (ctrl, n1, n2, t);
+  case Op_MaxReductionV:  return new (C) MaxReductionVNode (ctrl, n1, n2, t);
+  }
+  fatal(err_msg_res("Missed vector creation for '%s'", NodeClassNames[vopc]));
+  return NULL;
+}
+
+// Also used to check if the code generator
+// supports the reduction operation.
+bool ReductionNode::implemented(int opc, uint vlen, BasicType bt) {
+  if (is_java_primitive(bt) &&
+      (vlen > 1) && is_power_of_2(vlen) &&
+      Matcher::vector_size_supported(bt, vlen)) {
+    int vopc = ReductionNode::opcode(opc, bt);
+    return vopc != opc && Matcher::match_rule_supported(vopc);
+  }
+  return false;
+}
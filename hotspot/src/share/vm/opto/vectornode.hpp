@@ -59,6 +59,7 @@ class VectorNode : public TypeNode {
   static int  opcode(int opc, BasicType bt);
   static bool implemented(int opc, uint vlen, BasicType bt);
   static bool is_shift(Node* n);
+  static bool is_convert(Node* n);
   static bool is_invariant_vector(Node* n);
   // [Start, end) half-open range defining which operands are vectors
   static void vector_operands(Node* n, uint* start, uint* end);
@@ -349,6 +350,141 @@ class XorVNode : public VectorNode {
   virtual int Opcode() const;
 };
 
+//===========================Vector=Conversions================================
+// Only between elements of the same size, so that the input and the result
+// have the same number of lanes in the same vector register size.
+
+//------------------------------VectorCastI2FNode------------------------------
+// Vector convert int to float
+class VectorCastI2FNode : public VectorNode {
+ public:
+  VectorCastI2FNode(Node* in, const TypeVect* vt) : VectorNode(in,vt) {}
+  virtual int Opcode() const;
+};
+
+//------------------------------VectorCastF2INode------------------------------
+// Vector convert float to int, with Java semantics for NaN and out of
+// range values
+class VectorCastF2INode : public VectorNode {
+ public:
+  VectorCastF2INode(Node* in, const TypeVect* vt) : VectorNode(in,vt) {}
+  virtual int Opcode() const;
+};
+
+//===========================Vector=Reductions=================================
+
+//------------------------------ReductionNode----------------------------------
+// Perform reduction of a vector: fold the lanes of vector in2, in lane
+// order, into the scalar in1 and produce a scalar of the same type.
+class ReductionNode : public TypeNode {
+ public:
+  ReductionNode(Node *ctrl, Node* in1, Node* in2, const Type* t) : TypeNode(t, 3) {
+    init_req(0, ctrl);
+    init_req(1, in1);
+    init_req(2, in2);
+  }
+
+  static ReductionNode* make(Compile* C, int opc, Node *ctrl, Node* in1, Node* in2, BasicType bt);
+  static int  opcode(int opc, BasicType bt);
+  static bool implemented(int opc, uint vlen, BasicType bt);
+};
+
+//------------------------------AddReductionVINode-----------------------------
+// Vector add int as a reduction
+class AddReductionVINode : public ReductionNode {
+ public:
+  AddReductionVINode(Node *ctrl, Node* in1, Node* in2, const Type* t) : ReductionNode(ctrl, in1, in2, t) {}
+  virtual int Opcode() const;
+};
+
+//------------------------------AddReductionVLNode-----------------------------
+// Vector add long as a reduction
+class AddReductionVLNode : public ReductionNode {
+ public:
+  AddReductionVLNode(Node *ctrl, Node* in1, Node* in2, const Type* t) : ReductionNode(ctrl, in1, in2, t) {}
+  virtual int Opcode() const;
+};
+
+//------------------------------AddReductionVFNode-----------------------------
+// Vector add float as a reduction
+class AddReductionVFNode : public ReductionNode {
+ public:
+  AddReductionVFNode(Node *ctrl, Node* in1, Node* in2, const Type* t) : ReductionNode(ctrl, in1, in2, t) {}
+  virtual int Opcode() const;
+};
+
+//------------------------------AddReductionVDNode-----------------------------
+// Vector add double as a reduction
+class AddReductionVDNode : public ReductionNode {
+ public:
+  AddReductionVDNode(Node *ctrl, Node* in1, Node* in2, const Type* t) : ReductionNode(ctrl, in1, in2, t) {}
+  virtual int Opcode() const;
+};
+
+//------------------------------MulReductionVINode-----------------------------
+// Vector multiply int as a reduction
+class MulReductionVINode : public ReductionNode {
+ public:
+  MulReductionVINode(Node *ctrl, Node* in1, Node* in2, const Type* t) : ReductionNode(ctrl, in1, in2, t) {}
+  virtual int Opcode() const;
+};
+
+//------------------------------MulReductionVFNode-----------------------------
+// Vector multiply float as a reduction
+class MulReductionVFNode : public ReductionNode {
+ public:
+  MulReductionVFNode(Node *ctrl, Node* in1, Node* in2, const Type* t) : ReductionNode(ctrl, in1, in2, t) {}
+  virtual int Opcode() const;
+};
+
+//------------------------------MulReductionVDNode-----------------------------
+// Vector multiply double as a reduction
+class MulReductionVDNode : public ReductionNode {
+ public:
+  MulReductionVDNode(Node *ctrl, Node* in1, Node* in2, const Type* t) : ReductionNode(ctrl, in1, in2, t) {}
+  virtual int Opcode() const;
+};
+
+//------------------------------AndReductionVNode------------------------------
+// Vector and integer as a reduction
+class AndReductionVNode : public ReductionNode {
+ public:
+  AndReductionVNode(Node *ctrl, Node* in1, Node* in2, const Type* t) : ReductionNode(ctrl, in1, in2, t) {}
+  virtual int Opcode() const;
+};
+
+//------------------------------OrReductionVNode-------------------------------
+// Vector or integer as a reduction
+class OrReductionVNode : public ReductionNode {
+ public:
+  OrReductionVNode(Node *ctrl, Node* in1, Node* in2, const Type* t) : ReductionNode(ctrl, in1, in2, t) {}
+  virtual int Opcode() const;
+};
+
+//------------------------------XorReductionVNode------------------------------
+// Vector xor integer as a reduction
+class XorReductionVNode : public ReductionNode {
+ public:
+  XorReductionVNode(Node *ctrl, Node* in1, Node* in2, const Type* t) : ReductionNode(ctrl, in1, in2, t) {}
+  virtual int Opcode() const;
+};
+
+//------------------------------MinReductionVNode------------------------------
+// Vector min int as a reduction
+class MinReductionVNode : public ReductionNode {
+ public:
+  MinReductionVNode(Node *ctrl, Node* in1, Node* in2, const Type* t) : ReductionNode(ctrl, in1, in2, t) {}
+  virtual int Opcode() const;
+};
+
+//------------------------------MaxReductionVNode------------------------------
+// Vector max int as a reduction
+class MaxReductionVNode : public ReductionNode {
+ public:
+  MaxReductionVNode(Node *ctrl, Node* in1, Node* in2, const Type* t) : ReductionNode(ctrl, in1, in2, t) {}
+  virtual int Opcode() const;
+};
+
 //================================= M E M O R Y ===============================
 
 //------------------------------LoadVectorNode---------------------------------
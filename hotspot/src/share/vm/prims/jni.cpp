@@ -3261,7 +3261,13 @@ JNI_QUICK_ENTRY(const jchar*, jni_GetStringChars(
     /* JNI Specification states return NULL on OOM */
     if (buf != NULL) {
       if (s_len > 0) {
-        memcpy(buf, s_value->char_at_addr(s_offset), sizeof(jchar)*s_len);
+        if (java_lang_String::is_latin1(s)) {
+          for (int i = 0; i < s_len; i++) {
+            buf[i] = java_lang_String::char_at(s_value, true, i + s_offset);
+          }
+        } else {
+          memcpy(buf, s_value->char_at_addr(s_offset), sizeof(jchar)*s_len);
+        }
       }
       buf[s_len] = 0;
       //%note jni_5
@@ -4209,7 +4215,13 @@ JNI_ENTRY(void, jni_GetStringRegion(JNIEnv *env, jstring string, jsize start, js
     if (len > 0) {
       int s_offset = java_lang_String::offset(s);
       typeArrayOop s_value = java_lang_String::value(s);
-      memcpy(buf, s_value->char_at_addr(s_offset+start), sizeof(jchar)*len);
+      if (java_lang_String::is_latin1(s)) {
+        for (int i = 0; i < len; i++) {
+          buf[i] = java_lang_String::char_at(s_value, true, s_offset + start + i);
+        }
+      } else {
+        memcpy(buf, s_value->char_at_addr(s_offset+start), sizeof(jchar)*len);
+      }
     }
   }
 JNI_END
@@ -4252,6 +4264,27 @@ JNI_ENTRY(void, jni_GetStringUTFRegion(JNIEnv *env, jstring string, jsize start,
 JNI_END
 
 
+// A heap that can pin objects keeps the object of a critical section in
+// place instead of holding off garbage collection with the GC_locker.
+static oop lock_gc_or_pin_object(JavaThread* thread, jobject obj) {
+  if (Universe::heap()->supports_object_pinning()) {
+    const oop o = JNIHandles::resolve_non_null(obj);
+    return Universe::heap()->pin_object(thread, o);
+  } else {
+    GC_locker::lock_critical(thread);
+    return JNIHandles::resolve_non_null(obj);
+  }
+}
+
+static void unlock_gc_or_unpin_object(JavaThread* thread, jobject obj) {
+  if (Universe::heap()->supports_object_pinning()) {
+    const oop o = JNIHandles::resolve_non_null(obj);
+    Universe::heap()->unpin_object(thread, o);
+  } else {
+    GC_locker::unlock_critical(thread);
+  }
+}
+
 JNI_ENTRY(void*, jni_GetPrimitiveArrayCritical(JNIEnv *env, jarray array, jboolean *isCopy))
   JNIWrapper("GetPrimitiveArrayCritical");
 #ifndef USDT2
@@ -4260,11 +4293,10 @@ JNI_ENTRY(void*, jni_GetPrimitiveArrayCritical(JNIEnv *env, jarray array, jboole
  HOTSPOT_JNI_GETPRIMITIVEARRAYCRITICAL_ENTRY(
                                              env, array, (uintptr_t *) isCopy);
 #endif /* USDT2 */
-  GC_locker::lock_critical(thread);
   if (isCopy != NULL) {
     *isCopy = JNI_FALSE;
   }
-  oop a = JNIHandles::resolve_non_null(array);
+  oop a = lock_gc_or_pin_object(thread, array);
   assert(a->is_array(), "just checking");
   BasicType type;
   if (a->is_objArray()) {
@@ -4291,8 +4323,8 @@ JNI_ENTRY(void, jni_ReleasePrimitiveArrayCritical(JNIEnv *env, jarray array, voi
   HOTSPOT_JNI_RELEASEPRIMITIVEARRAYCRITICAL_ENTRY(
                                                   env, array, carray, mode);
 #endif /* USDT2 */
-  // The array, carray and mode arguments are ignored
-  GC_locker::unlock_critical(thread);
+  // The carray and mode arguments are ignored
+  unlock_gc_or_unpin_object(thread, array);
 #ifndef USDT2
   DTRACE_PROBE(hotspot_jni, ReleasePrimitiveArrayCritical__return);
 #else /* USDT2 */
@@ -4310,13 +4342,44 @@ JNI_ENTRY(const jchar*, jni_GetStringCritical(JNIEnv *env, jstring string, jbool
   HOTSPOT_JNI_GETSTRINGCRITICAL_ENTRY(
                                       env, string, (uintptr_t *) isCopy);
 #endif /* USDT2 */
-  GC_locker::lock_critical(thread);
   if (isCopy != NULL) {
     *isCopy = JNI_FALSE;
   }
-  oop s = JNIHandles::resolve_non_null(string);
+  oop s;
+  typeArrayOop s_value;
+  if (java_lang_String::is_latin1(JNIHandles::resolve_non_null(string))) {
+    // Latin-1 contents have no jchar representation to hand out, so
+    // return an inflated copy; ReleaseStringCritical frees it.
+    s = JNIHandles::resolve_non_null(string);
+    s_value = java_lang_String::value(s);
+    int s_len = java_lang_String::length(s);
+    jchar* buf = NEW_C_HEAP_ARRAY(jchar, s_len + 1, mtInternal);
+    for (int i = 0; i < s_len; i++) {
+      buf[i] = java_lang_String::char_at(s_value, true, i);
+    }
+    buf[s_len] = 0;
+    if (isCopy != NULL) {
+      *isCopy = JNI_TRUE;
+    }
+#ifndef USDT2
+    DTRACE_PROBE1(hotspot_jni, GetStringCritical__return, buf);
+#else /* USDT2 */
+    HOTSPOT_JNI_GETSTRINGCRITICAL_RETURN(
+                                         (uint16_t *) buf);
+#endif /* USDT2 */
+    return buf;
+  }
+  if (Universe::heap()->supports_object_pinning()) {
+    // The characters live in the value array, so that is what must
+    // stay in place.
+    s = JNIHandles::resolve_non_null(string);
+    s_value = typeArrayOop(Universe::heap()->pin_object(thread, java_lang_String::value(s)));
+  } else {
+    GC_locker::lock_critical(thread);
+    s = JNIHandles::resolve_non_null(string);
+    s_value = java_lang_String::value(s);
+  }
   int s_len = java_lang_String::length(s);
-  typeArrayOop s_value = java_lang_String::value(s);
   int s_offset = java_lang_String::offset(s);
   const jchar* ret;
   if (s_len > 0) {
@@ -4342,8 +4405,21 @@ JNI_ENTRY(void, jni_ReleaseStringCritical(JNIEnv *env, jstring str, const jchar
   HOTSPOT_JNI_RELEASESTRINGCRITICAL_ENTRY(
                                           env, str, (uint16_t *) chars);
 #endif /* USDT2 */
-  // The str and chars arguments are ignored
-  GC_locker::unlock_critical(thread);
+  if (java_lang_String::is_latin1(JNIHandles::resolve_non_null(str))) {
+    // Inflated copy made by GetStringCritical
+    FREE_C_HEAP_ARRAY(jchar, chars, mtInternal);
+  } else if (Universe::heap()->supports_object_pinning()) {
+    // String deduplication may have replaced the value array of the
+    // string meanwhile, so the pinned array is found from the chars.
+    oop s = JNIHandles::resolve_non_null(str);
+    int s_offset = java_lang_String::length(s) > 0 ? java_lang_String::offset(s) : 0;
+    address s_value = (address) chars - s_offset * sizeof(jchar) -
+                      arrayOopDesc::base_offset_in_bytes(T_CHAR);
+    Universe::heap()->unpin_object(thread, (oop) s_value);
+  } else {
+    // The str and chars arguments are ignored
+    GC_locker::unlock_critical(thread);
+  }
 #ifndef USDT2
   DTRACE_PROBE(hotspot_jni, ReleaseStringCritical__return);
 #else /* USDT2 */
@@ -5089,6 +5165,7 @@ _JNI_IMPORT_OR_EXPORT_ jint JNICALL JNI_GetDefaultJavaVMInitArgs(void *args_) {
 #include "gc_implementation/g1/heapRegionRemSet.hpp"
 #endif
 #include "memory/guardedMemory.hpp"
+#include "utilities/internalVMBenchmarks.hpp"
 #include "utilities/quickSort.hpp"
 #include "utilities/ostream.hpp"
 #if INCLUDE_VM_STRUCTS
@@ -5112,6 +5189,7 @@ void TestNewSize_test();
 void TestKlass_test();
 void Test_linked_list();
 void TestResourcehash_test();
+void TestOpenAddressingHashtable_test();
 void TestChunkedList_test();
 #if INCLUDE_ALL_GCS
 void TestOldFreeSpaceCalculation_test();
@@ -5145,6 +5223,7 @@ void execute_internal_vm_tests() {
     run_unit_test(TestNewSize_test());
     run_unit_test(TestKlass_test());
     run_unit_test(TestResourcehash_test());
+    run_unit_test(TestOpenAddressingHashtable_test());
     run_unit_test(Test_linked_list());
     run_unit_test(TestChunkedList_test());
     run_unit_test(ObjectMonitor::sanity_checks());
@@ -5167,6 +5246,12 @@ void execute_internal_vm_tests() {
   }
 }
 
+void execute_internal_vm_benchmarks() {
+  if (ExecuteInternalVMBenchmarks) {
+    InternalVMBenchmarks::run_all();
+  }
+}
+
 #undef run_unit_test
 
 #endif
@@ -5268,6 +5353,7 @@ _JNI_IMPORT_OR_EXPORT_ jint JNICALL JNI_CreateJavaVM(JavaVM **vm, void **penv, v
     // functions in order to properly handle error conditions.
     CALL_TEST_FUNC_WITH_WRAPPER_IF_NEEDED(test_error_handler);
     CALL_TEST_FUNC_WITH_WRAPPER_IF_NEEDED(execute_internal_vm_tests);
+    CALL_TEST_FUNC_WITH_WRAPPER_IF_NEEDED(execute_internal_vm_benchmarks);
 #endif
 
     // Since this is not a JVM_ENTRY we have to set the thread state manually before leaving.
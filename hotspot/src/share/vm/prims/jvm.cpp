@@ -372,6 +372,17 @@ JVM_ENTRY(jobject, JVM_InitProperties(JNIEnv *env, jobject properties))
     }
   }
 
+  // Convert -XX:ReflectionInflationThreshold= to the
+  // sun.reflect.inflationThreshold property read by ReflectionFactory.
+  // An explicit -D setting wins.
+  if (ReflectionInflationThreshold >= 0 &&
+      Arguments::get_property("sun.reflect.inflationThreshold") == NULL) {
+    char as_chars[32];
+    jio_snprintf(as_chars, sizeof(as_chars), INTX_FORMAT,
+                 MIN2(ReflectionInflationThreshold, (intx)max_jint));
+    PUTPROP(props, "sun.reflect.inflationThreshold", as_chars);
+  }
+
   // JVM monitoring and management support
   // Add the sun.management.compiler property for the compiler's name
   {
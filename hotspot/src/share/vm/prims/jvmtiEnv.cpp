@@ -1708,6 +1708,16 @@ JvmtiEnv::ForceGarbageCollection() {
 } /* end ForceGarbageCollection */
 
 
+jvmtiError
+JvmtiEnv::SetHeapSamplingInterval(jint sampling_interval) {
+  if (sampling_interval < 0) {
+    return JVMTI_ERROR_ILLEGAL_ARGUMENT;
+  }
+  ThreadHeapSampler::set_sampling_interval((size_t)sampling_interval);
+  return JVMTI_ERROR_NONE;
+} /* end SetHeapSamplingInterval */
+
+
   //
   // Heap (1.0) functions
   //
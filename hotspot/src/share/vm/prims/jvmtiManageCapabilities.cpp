@@ -136,6 +136,9 @@ jvmtiCapabilities JvmtiManageCapabilities::init_onload_capabilities() {
   // jc.can_get_monitor_info = 1;
   jc.can_tag_objects = 1;                 // TODO: this should have been removed
   jc.can_generate_object_free_events = 1; // TODO: this should have been removed
+  // Onload only: FastTLABRefill has to be off before the compiler stubs
+  // are generated, see update().
+  jc.can_generate_sampled_object_alloc_events = 1;
   return jc;
 }
 
@@ -329,6 +332,12 @@ void JvmtiManageCapabilities::update() {
     RewriteFrequentPairs = false;
   }
 
+  // The heap sampler moves the end of the tlab in to the next sample
+  // point, which the inline tlab refill in generated code does not know.
+  if (avail.can_generate_sampled_object_alloc_events) {
+    FastTLABRefill = false;
+  }
+
   // If can_redefine_classes is enabled in the onload phase then we know that the
   // dependency information recorded by the compiler is complete.
   if ((avail.can_redefine_classes || avail.can_retransform_classes) &&
@@ -452,6 +461,8 @@ void JvmtiManageCapabilities:: print(const jvmtiCapabilities* cap) {
     tty->print_cr("can_generate_resource_exhaustion_heap_events");
   if (cap->can_generate_resource_exhaustion_threads_events)
     tty->print_cr("can_generate_resource_exhaustion_threads_events");
+  if (cap->can_generate_sampled_object_alloc_events)
+    tty->print_cr("can_generate_sampled_object_alloc_events");
 }
 
 #endif
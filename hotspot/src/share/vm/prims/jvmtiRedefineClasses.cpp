@@ -192,6 +192,10 @@ void VM_RedefineClasses::doit() {
   HandleMark hm(thread);   // make sure any handles created are deleted
                            // before the stack walk again.
 
+  // Deoptimize all compiled code that depends on the redefined classes
+  // with a single pass over the thread stacks.
+  flush_dependent_code(thread);
+
   for (int i = 0; i < _class_count; i++) {
     redefine_single_class(_class_defs[i].klass, _scratch_classes[i], thread);
     ClassLoaderData* cld = _scratch_classes[i]->class_loader_data();
@@ -201,6 +205,22 @@ void VM_RedefineClasses::doit() {
     _scratch_classes[i] = NULL;
   }
 
+  // Adjust constantpool caches and vtables for all classes that
+  // reference methods of the evolved classes. This has to be done after
+  // all classes are redefined and all their old methods are marked as
+  // old, and walks the loaded classes once for the whole batch.
+  {
+    RC_TIMER_START(_timer_rsc_phase2);
+    ResourceMark rm(thread);
+    InstanceKlass** classes = NEW_RESOURCE_ARRAY(InstanceKlass*, _class_count);
+    for (int i = 0; i < _class_count; i++) {
+      classes[i] = InstanceKlass::cast(get_ik(_class_defs[i].klass));
+    }
+    AdjustCpoolCacheAndVtable adjust_cpool_cache_and_vtable(thread, classes, _class_count);
+    ClassLoaderDataGraph::classes_do(&adjust_cpool_cache_and_vtable);
+    RC_TIMER_STOP(_timer_rsc_phase2);
+  }
+
   // Disable any dependent concurrent compilations
   SystemDictionary::notice_modification();
 
@@ -3374,13 +3394,41 @@ void VM_RedefineClasses::set_new_constant_pool(
 // use the ClassLoaderDataGraph::classes_do() facility and this helper
 // to fix up these pointers.
 
+VM_RedefineClasses::AdjustCpoolCacheAndVtable::AdjustCpoolCacheAndVtable(
+    Thread* t, InstanceKlass** classes, int class_count) :
+  _thread(t), _classes(classes), _class_count(class_count),
+  _adjust_all_tables(false), _redefined_Object(false), _all_user_defined(true) {
+  for (int i = 0; i < class_count; i++) {
+    InstanceKlass* the_class = classes[i];
+    if (the_class->is_interface() ||
+        the_class == SystemDictionary::misc_Unsafe_klass()) {
+      _adjust_all_tables = true;
+    }
+    if (the_class == SystemDictionary::Object_klass()) {
+      _redefined_Object = true;
+    }
+    if (the_class->class_loader() == NULL) {
+      _all_user_defined = false;
+    }
+  }
+}
+
+bool VM_RedefineClasses::AdjustCpoolCacheAndVtable::has_redefined_super(
+    InstanceKlass* ik, bool subclass_only) const {
+  for (int i = 0; i < _class_count; i++) {
+    if (subclass_only ? ik->is_subclass_of(_classes[i]) : ik->is_subtype_of(_classes[i])) {
+      return true;
+    }
+  }
+  return false;
+}
+
 // Adjust cpools and vtables closure
 void VM_RedefineClasses::AdjustCpoolCacheAndVtable::do_klass(Klass* k) {
 
   // This is a very busy routine. We don't want too much tracing
   // printed out.
   bool trace_name_printed = false;
-  InstanceKlass *the_class = InstanceKlass::cast(_the_class_oop);
 
   // Very noisy: only enable this call if you are trying to determine
   // that a specific class gets found by this routine.
@@ -3389,10 +3437,10 @@ void VM_RedefineClasses::AdjustCpoolCacheAndVtable::do_klass(Klass* k) {
   //   ("adjust check: name=%s", k->external_name()));
   // trace_name_printed = true;
 
-  // If the class being redefined is java.lang.Object, we need to fix all
-  // array class vtables also
-  if (k->oop_is_array() && _the_class_oop == SystemDictionary::Object_klass()) {
-    k->vtable()->adjust_method_entries(the_class, &trace_name_printed);
+  // If java.lang.Object was redefined, we need to fix all array class
+  // vtables also
+  if (k->oop_is_array() && _redefined_Object) {
+    k->vtable()->adjust_method_entries(NULL, &trace_name_printed);
 
   } else if (k->oop_is_instance()) {
     HandleMark hm(_thread);
@@ -3407,19 +3455,17 @@ void VM_RedefineClasses::AdjustCpoolCacheAndVtable::do_klass(Klass* k) {
     // loaded by a user-defined class loader. Note: a user-defined
     // class loader can delegate to the bootstrap class loader.
     //
-    // If the current class being redefined has a user-defined class
-    // loader as its defining class loader, then we can skip all
-    // classes loaded by the bootstrap class loader.
-    bool is_user_defined =
-           InstanceKlass::cast(_the_class_oop)->class_loader() != NULL;
-    if (is_user_defined && ik->class_loader() == NULL) {
+    // If all redefined classes have a user-defined class loader as
+    // their defining class loader, then we can skip all classes
+    // loaded by the bootstrap class loader.
+    if (_all_user_defined && ik->class_loader() == NULL) {
       return;
     }
 
-    // Fix the vtable embedded in the_class and subclasses of the_class,
-    // if one exists. We discard scratch_class and we don't keep an
-    // InstanceKlass around to hold obsolete methods so we don't have
-    // any other InstanceKlass embedded vtables to update. The vtable
+    // Fix the vtable embedded in the redefined classes and their
+    // subclasses, if one exists. We discard scratch_class and we don't
+    // keep an InstanceKlass around to hold obsolete methods so we don't
+    // have any other InstanceKlass embedded vtables to update. The vtable
     // holds the Method*s for virtual (but not final) methods.
     // Default methods, or concrete methods in interfaces are stored
     // in the vtable, so if an interface changes we need to check
@@ -3430,55 +3476,42 @@ void VM_RedefineClasses::AdjustCpoolCacheAndVtable::do_klass(Klass* k) {
     // This must be done after we adjust the default_methods and
     // default_vtable_indices for methods already in the vtable.
     // If redefining Unsafe, walk all the vtables looking for entries.
-    if (ik->vtable_length() > 0 && (_the_class_oop->is_interface()
-        || _the_class_oop == SystemDictionary::misc_Unsafe_klass()
-        || ik->is_subtype_of(_the_class_oop))) {
+    if (ik->vtable_length() > 0 &&
+        (_adjust_all_tables || has_redefined_super(ik, false))) {
       // ik->vtable() creates a wrapper object; rm cleans it up
       ResourceMark rm(_thread);
 
-      ik->vtable()->adjust_method_entries(the_class, &trace_name_printed);
-      ik->adjust_default_methods(the_class, &trace_name_printed);
+      ik->vtable()->adjust_method_entries(NULL, &trace_name_printed);
+      ik->adjust_default_methods(NULL, &trace_name_printed);
     }
 
     // If the current class has an itable and we are either redefining an
-    // interface or if the current class is a subclass of the_class, then
-    // we potentially have to fix the itable. If we are redefining an
-    // interface, then we have to call adjust_method_entries() for
-    // every InstanceKlass that has an itable since there isn't a
+    // interface or if the current class is a subclass of a redefined
+    // class, then we potentially have to fix the itable. If we are
+    // redefining an interface, then we have to call adjust_method_entries()
+    // for every InstanceKlass that has an itable since there isn't a
     // subclass relationship between an interface and an InstanceKlass.
     // If redefining Unsafe, walk all the itables looking for entries.
-    if (ik->itable_length() > 0 && (_the_class_oop->is_interface()
-        || _the_class_oop == SystemDictionary::misc_Unsafe_klass()
-        || ik->is_subclass_of(_the_class_oop))) {
+    if (ik->itable_length() > 0 &&
+        (_adjust_all_tables || has_redefined_super(ik, true))) {
       // ik->itable() creates a wrapper object; rm cleans it up
       ResourceMark rm(_thread);
 
-      ik->itable()->adjust_method_entries(the_class, &trace_name_printed);
+      ik->itable()->adjust_method_entries(NULL, &trace_name_printed);
     }
 
     // The constant pools in other classes (other_cp) can refer to
-    // methods in the_class. We have to update method information in
-    // other_cp's cache. If other_cp has a previous version, then we
-    // have to repeat the process for each previous version. The
-    // constant pool cache holds the Method*s for non-virtual
-    // methods and for virtual, final methods.
+    // methods in the redefined classes. We have to update method
+    // information in other_cp's cache. If other_cp has a previous
+    // version, then we have to repeat the process for each previous
+    // version. The constant pool cache holds the Method*s for
+    // non-virtual methods and for virtual, final methods.
     //
-    // Special case: if the current class is the_class, then new_cp
-    // has already been attached to the_class and old_cp has already
-    // been added as a previous version. The new_cp doesn't have any
-    // cached references to old methods so it doesn't need to be
-    // updated. We can simply start with the previous version(s) in
-    // that case.
-    constantPoolHandle other_cp;
-    ConstantPoolCache* cp_cache;
-
-    if (ik != _the_class_oop) {
-      // this klass' constant pool cache may need adjustment
-      other_cp = constantPoolHandle(ik->constants());
-      cp_cache = other_cp->cache();
-      if (cp_cache != NULL) {
-        cp_cache->adjust_method_entries(the_class, &trace_name_printed);
-      }
+    // The new constant pool of a redefined class has no resolved
+    // entries yet, so adjusting it finds nothing to do.
+    ConstantPoolCache* cp_cache = ik->constants()->cache();
+    if (cp_cache != NULL) {
+      cp_cache->adjust_method_entries(NULL, &trace_name_printed);
     }
 
     // the previous versions' constant pool caches may need adjustment
@@ -3487,7 +3520,7 @@ void VM_RedefineClasses::AdjustCpoolCacheAndVtable::do_klass(Klass* k) {
          pv_node = pv_node->previous_versions()) {
       cp_cache = pv_node->constants()->cache();
       if (cp_cache != NULL) {
-        cp_cache->adjust_method_entries(pv_node, &trace_name_printed);
+        cp_cache->adjust_method_entries(NULL, &trace_name_printed);
       }
     }
   }
@@ -3789,13 +3822,31 @@ void VM_RedefineClasses::transfer_old_native_function_registrations(instanceKlas
 // subsequent calls to RedefineClasses need only throw away code
 // that depends on the class.
 //
-void VM_RedefineClasses::flush_dependent_code(instanceKlassHandle k_h, TRAPS) {
+void VM_RedefineClasses::flush_dependent_code(TRAPS) {
   assert_locked_or_safepoint(Compile_lock);
 
   // All dependencies have been recorded from startup or this is a second or
   // subsequent use of RedefineClasses
   if (JvmtiExport::all_dependencies_are_recorded()) {
-    Universe::flush_evol_dependents_on(k_h);
+    if (CodeCache::number_of_nmethods_with_dependencies() == 0) return;
+
+    // Mark the code of all redefined classes first, so that the thread
+    // stacks are walked only once for the whole batch.
+    int marked = 0;
+    for (int i = 0; i < _class_count; i++) {
+      instanceKlassHandle k_h(THREAD, get_ik(_class_defs[i].klass));
+      marked += CodeCache::mark_for_evol_deoptimization(k_h);
+    }
+    if (marked > 0) {
+      ResourceMark rm(THREAD);
+      DeoptimizationMarker dm;
+
+      // Deoptimize all activations depending on marked nmethods
+      Deoptimization::deoptimize_dependents();
+
+      // Make the dependent methods not entrant
+      CodeCache::make_marked_nmethods_not_entrant();
+    }
   } else {
     CodeCache::mark_all_nmethods_for_deoptimization();
 
@@ -3885,17 +3936,14 @@ void VM_RedefineClasses::swap_annotations(instanceKlassHandle the_class,
 
 
 // Install the redefinition of a class:
-//    - house keeping (flushing breakpoints and caches, deoptimizing
-//      dependent compiled code)
+//    - house keeping (flushing breakpoints and caches)
 //    - replacing parts in the_class with parts from scratch_class
 //    - adding a weak reference to track the obsolete but interesting
 //      parts of the_class
-//    - adjusting constant pool caches and vtables in other classes
-//      that refer to methods in the_class. These adjustments use the
-//      ClassLoaderDataGraph::classes_do() facility which only allows
-//      a helper method to be specified. The interesting parameters
-//      that we would like to pass to the helper method are saved in
-//      static global fields in the VM operation.
+//
+// Deoptimizing dependent code and adjusting the constant pool caches
+// and vtables of other classes that refer to methods in the_class are
+// done once for all redefined classes by doit().
 void VM_RedefineClasses::redefine_single_class(jclass the_jclass,
        Klass* scratch_class_oop, TRAPS) {
 
@@ -3909,9 +3957,6 @@ void VM_RedefineClasses::redefine_single_class(jclass the_jclass,
   JvmtiBreakpoints& jvmti_breakpoints = JvmtiCurrentBreakpoints::get_jvmti_breakpoints();
   jvmti_breakpoints.clearall_in_class_at_safepoint(the_class());
 
-  // Deoptimize all compiled code that depends on this class
-  flush_dependent_code(the_class, THREAD);
-
   _old_methods = the_class->methods();
   _new_methods = scratch_class->methods();
   _the_class_oop = the_class();
@@ -4112,11 +4157,6 @@ void VM_RedefineClasses::redefine_single_class(jclass the_jclass,
   RC_TIMER_STOP(_timer_rsc_phase1);
   RC_TIMER_START(_timer_rsc_phase2);
 
-  // Adjust constantpool caches and vtables for all classes
-  // that reference methods of the evolved class.
-  AdjustCpoolCacheAndVtable adjust_cpool_cache_and_vtable(THREAD);
-  ClassLoaderDataGraph::classes_do(&adjust_cpool_cache_and_vtable);
-
   // JSR-292 support
   MemberNameTable* mnt = the_class->member_names();
   if (mnt != NULL) {
@@ -488,7 +488,7 @@ class VM_RedefineClasses: public VM_Operation {
          instanceKlassHandle scratch_class,
          constantPoolHandle scratch_cp, int scratch_cp_length, TRAPS);
 
-  void flush_dependent_code(instanceKlassHandle k_h, TRAPS);
+  void flush_dependent_code(TRAPS);
 
   // lock classes to redefine since constant pool merging isn't thread safe.
   void lock_classes();
@@ -504,14 +504,22 @@ class VM_RedefineClasses: public VM_Operation {
     void do_klass(Klass* k);
   };
 
-  // Unevolving classes may point to methods of the_class directly
-  // from their constant pool caches, itables, and/or vtables. We
-  // use the ClassLoaderDataGraph::classes_do() facility and this helper
-  // to fix up these pointers.
+  // Unevolving classes may point to methods of the redefined classes
+  // directly from their constant pool caches, itables, and/or vtables.
+  // We use the ClassLoaderDataGraph::classes_do() facility and this
+  // helper to fix up these pointers for all redefined classes at once.
   class AdjustCpoolCacheAndVtable : public KlassClosure {
     Thread* _thread;
+    InstanceKlass** _classes;         // the redefined classes
+    int _class_count;
+    bool _adjust_all_tables;          // an interface or Unsafe was redefined
+    bool _redefined_Object;           // java.lang.Object was redefined
+    bool _all_user_defined;           // no boot loader class was redefined
+
+    // is ik a subtype (or subclass, for itables) of a redefined class
+    bool has_redefined_super(InstanceKlass* ik, bool subclass_only) const;
    public:
-    AdjustCpoolCacheAndVtable(Thread* t) : _thread(t) {}
+    AdjustCpoolCacheAndVtable(Thread* t, InstanceKlass** classes, int class_count);
     void do_klass(Klass* k);
   };
 
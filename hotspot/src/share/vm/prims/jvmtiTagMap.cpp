@@ -53,26 +53,17 @@
 
 // JvmtiTagHashmapEntry
 //
-// Each entry encapsulates a reference to the tagged object
-// and the tag value. In addition an entry includes a next pointer which
-// is used to chain entries together.
+// A slot of the hashmap: the tagged object and the tag value. Slots are
+// stored inline in the table. A NULL object marks a free slot and the
+// deleted_object() sentinel a slot whose entry has been removed.
 
-class JvmtiTagHashmapEntry : public CHeapObj<mtInternal> {
+class JvmtiTagHashmapEntry VALUE_OBJ_CLASS_SPEC {
  private:
+  friend class JvmtiTagHashmap;
   friend class JvmtiTagMap;
 
   oop _object;                          // tagged object
   jlong _tag;                           // the tag
-  JvmtiTagHashmapEntry* _next;          // next on the list
-
-  inline void init(oop object, jlong tag) {
-    _object = object;
-    _tag = tag;
-    _next = NULL;
-  }
-
-  // constructor
-  JvmtiTagHashmapEntry(oop object, jlong tag)         { init(object, tag); }
 
  public:
 
@@ -80,29 +71,22 @@ class JvmtiTagHashmapEntry : public CHeapObj<mtInternal> {
   inline oop object() const                           { return _object; }
   inline oop* object_addr()                           { return &_object; }
   inline jlong tag() const                            { return _tag; }
-
-  inline void set_tag(jlong tag) {
-    assert(tag != 0, "can't be zero");
-    _tag = tag;
-  }
-
-  inline JvmtiTagHashmapEntry* next() const             { return _next; }
-  inline void set_next(JvmtiTagHashmapEntry* next)      { _next = next; }
 };
 
 
 // JvmtiTagHashmap
 //
-// A hashmap is essentially a table of pointers to entries. Entries
-// are hashed to a location, or position in the table, and then
-// chained from that location. The "key" for hashing is address of
-// the object, or oop. The "value" is the tag value.
+// An open addressing hashmap with linear probing. The "key" for hashing
+// is address of the object, or oop. The "value" is the tag value. The
+// entries live in the table itself, so looking up a tag touches one or
+// two cache lines and a GC walks one flat array instead of chasing a
+// chain of separately allocated entries.
 //
-// A hashmap maintains a count of the number entries in the hashmap
-// and resizes if the number of entries exceeds a given threshold.
-// The threshold is specified as a percentage of the size - for
-// example a threshold of 0.75 will trigger the hashmap to resize
-// if the number of entries is >75% of table size.
+// Removed entries leave a tombstone behind so that the probe sequences
+// of other entries stay intact. A hashmap maintains a count of the
+// entries and tombstones, and when together they exceed three quarters
+// of the table the table is rebuilt: twice as large if more than half of
+// it is in use, at the same size otherwise.
 //
 // A hashmap provides functions for adding, removing, and finding
 // entries. It also provides a function to iterate over all entries
@@ -113,259 +97,201 @@ class JvmtiTagHashmap : public CHeapObj<mtInternal> {
   friend class JvmtiTagMap;
 
   enum {
-    small_trace_threshold  = 10000,                  // threshold for tracing
+    initial_size = 4096,                        // must be a power of 2
+    max_size = 1 << 30,
+
+    small_trace_threshold  = 10000,             // threshold for tracing
     medium_trace_threshold = 100000,
     large_trace_threshold  = 1000000,
     initial_trace_threshold = small_trace_threshold
   };
 
-  static int _sizes[];                  // array of possible hashmap sizes
-  int _size;                            // actual size of the table
-  int _size_index;                      // index into size table
-
+  int _size;                            // actual size of the table, a power of 2
   int _entry_count;                     // number of entries in the hashmap
-
-  float _load_factor;                   // load factor as a % of the size
+  int _deleted_count;                   // number of tombstones in the table
   int _resize_threshold;                // computed threshold to trigger resizing.
-  bool _resizing_enabled;               // indicates if hashmap can resize
 
   int _trace_threshold;                 // threshold for trace messages
 
-  JvmtiTagHashmapEntry** _table;        // the table of entries.
+  JvmtiTagHashmapEntry* _table;         // the table of entries.
 
   // private accessors
   int resize_threshold() const                  { return _resize_threshold; }
   int trace_threshold() const                   { return _trace_threshold; }
 
-  // initialize the hashmap
-  void init(int size_index=0, float load_factor=4.0f) {
-    int initial_size =  _sizes[size_index];
-    _size_index = size_index;
-    _size = initial_size;
-    _entry_count = 0;
-    if (TraceJVMTIObjectTagging) {
-      _trace_threshold = initial_trace_threshold;
-    } else {
-      _trace_threshold = -1;
-    }
-    _load_factor = load_factor;
-    _resize_threshold = (int)(_load_factor * _size);
-    _resizing_enabled = true;
-    size_t s = initial_size * sizeof(JvmtiTagHashmapEntry*);
-    _table = (JvmtiTagHashmapEntry**)os::malloc(s, mtInternal);
-    if (_table == NULL) {
-      vm_exit_out_of_memory(s, OOM_MALLOC_ERROR,
-        "unable to allocate initial hashtable for jvmti object tags");
-    }
-    for (int i=0; i<initial_size; i++) {
-      _table[i] = NULL;
+  // marks a slot whose entry was removed
+  static oop deleted_object()                   { return cast_to_oop((intptr_t)1); }
+  static bool is_free(oop o)                    { return o == NULL || o == deleted_object(); }
+
+  static JvmtiTagHashmapEntry* allocate_table(int size) {
+    JvmtiTagHashmapEntry* table = NEW_C_HEAP_ARRAY(JvmtiTagHashmapEntry, size, mtInternal);
+    for (int i = 0; i < size; i++) {
+      table[i]._object = NULL;
+      table[i]._tag = 0;
     }
+    return table;
   }
 
-  // hash a given key (oop) with the specified size
-  static unsigned int hash(oop key, int size) {
-    // shift right to get better distribution (as these bits will be zero
-    // with aligned addresses)
-    unsigned int addr = (unsigned int)(cast_from_oop<intptr_t>(key));
+  // hash a given key (oop). The table size is a power of 2, so the
+  // address bits are mixed to spread aligned objects over all slots.
+  static unsigned int hash(oop key) {
+    uintptr_t addr = cast_from_oop<uintptr_t>(key) >> LogMinObjAlignmentInBytes;
 #ifdef _LP64
-    return (addr >> 3) % size;
-#else
-    return (addr >> 2) % size;
+    addr ^= addr >> 32;
 #endif
+    unsigned int h = (unsigned int)addr * 0x9E3779B1u;
+    return h ^ (h >> 16);
+  }
+
+  // index of the entry for key, or -1 if the key is not in the hashmap
+  int lookup(oop key) const {
+    int mask = _size - 1;
+    int i = hash(key) & mask;
+    for (;;) {
+      oop o = _table[i]._object;
+      if (o == key) {
+        return i;
+      }
+      if (o == NULL) {
+        return -1;
+      }
+      i = (i + 1) & mask;
+    }
   }
 
-  // hash a given key (oop)
-  unsigned int hash(oop key) {
-    return hash(key, _size);
-  }
-
-  // resize the hashmap - allocates a large table and re-hashes
-  // all entries into the new table.
-  void resize() {
-    int new_size_index = _size_index+1;
-    int new_size = _sizes[new_size_index];
-    if (new_size < 0) {
-      // hashmap already at maximum capacity
-      return;
+  // store an entry that is known not to be in the hashmap
+  void insert(oop key, jlong tag) {
+    int mask = _size - 1;
+    int i = hash(key) & mask;
+    while (!is_free(_table[i]._object)) {
+      i = (i + 1) & mask;
     }
-
-    // allocate new table
-    size_t s = new_size * sizeof(JvmtiTagHashmapEntry*);
-    JvmtiTagHashmapEntry** new_table = (JvmtiTagHashmapEntry**)os::malloc(s, mtInternal);
-    if (new_table == NULL) {
-      warning("unable to allocate larger hashtable for jvmti object tags");
-      set_resizing_enabled(false);
-      return;
+    if (_table[i]._object == deleted_object()) {
+      _deleted_count--;
     }
+    _table[i]._object = key;
+    _table[i]._tag = tag;
+    _entry_count++;
+  }
 
-    // initialize new table
-    int i;
-    for (i=0; i<new_size; i++) {
-      new_table[i] = NULL;
-    }
+  // rebuild the table with the given size, dropping all tombstones
+  void rehash(int new_size) {
+    JvmtiTagHashmapEntry* old_table = _table;
+    int old_size = _size;
 
-    // rehash all entries into the new table
-    for (i=0; i<_size; i++) {
-      JvmtiTagHashmapEntry* entry = _table[i];
-      while (entry != NULL) {
-        JvmtiTagHashmapEntry* next = entry->next();
-        oop key = entry->object();
-        assert(key != NULL, "jni weak reference cleared!!");
-        unsigned int h = hash(key, new_size);
-        JvmtiTagHashmapEntry* anchor = new_table[h];
-        if (anchor == NULL) {
-          new_table[h] = entry;
-          entry->set_next(NULL);
-        } else {
-          entry->set_next(anchor);
-          new_table[h] = entry;
-        }
-        entry = next;
+    _table = allocate_table(new_size);
+    _size = new_size;
+    _entry_count = 0;
+    _deleted_count = 0;
+    for (int i = 0; i < old_size; i++) {
+      oop o = old_table[i]._object;
+      if (!is_free(o)) {
+        insert(o, old_table[i]._tag);
       }
     }
-
-    // free old table and update settings.
-    os::free((void*)_table);
-    _table = new_table;
-    _size_index = new_size_index;
-    _size = new_size;
+    FREE_C_HEAP_ARRAY(JvmtiTagHashmapEntry, old_table, mtInternal);
 
     // compute new resize threshold
-    _resize_threshold = (int)(_load_factor * _size);
+    _resize_threshold = _size / 4 * 3;
   }
 
+  // grow the table, or only purge the tombstones if it is mostly free
+  void resize() {
+    int new_size = _size;
+    if (_entry_count > _size / 2 && _size < max_size) {
+      new_size = _size * 2;
+    }
+    rehash(new_size);
+  }
 
-  // internal remove function - remove an entry at a given position in the
-  // table.
-  inline void remove(JvmtiTagHashmapEntry* prev, int pos, JvmtiTagHashmapEntry* entry) {
+  // internal remove function - remove the entry at a given position in
+  // the table.
+  inline void remove_at(int pos) {
     assert(pos >= 0 && pos < _size, "out of range");
-    if (prev == NULL) {
-      _table[pos] = entry->next();
-    } else {
-      prev->set_next(entry->next());
-    }
+    assert(!is_free(_table[pos]._object), "no entry to remove");
+    _table[pos]._object = deleted_object();
+    _table[pos]._tag = 0;
     assert(_entry_count > 0, "checking");
     _entry_count--;
+    _deleted_count++;
   }
 
-  // resizing switch
-  bool is_resizing_enabled() const          { return _resizing_enabled; }
-  void set_resizing_enabled(bool enable)    { _resizing_enabled = enable; }
-
   // debugging
   void print_memory_usage();
   void compute_next_trace_threshold();
 
  public:
 
-  // create a JvmtiTagHashmap of a preferred size and optionally a load factor.
-  // The preferred size is rounded down to an actual size.
-  JvmtiTagHashmap(int size, float load_factor=0.0f) {
-    int i=0;
-    while (_sizes[i] < size) {
-      if (_sizes[i] < 0) {
-        assert(i > 0, "sanity check");
-        i--;
-        break;
-      }
-      i++;
-    }
-
-    // if a load factor is specified then use it, otherwise use default
-    if (load_factor > 0.01f) {
-      init(i, load_factor);
-    } else {
-      init(i);
-    }
-  }
-
   // create a JvmtiTagHashmap with default settings
   JvmtiTagHashmap() {
-    init();
+    _size = initial_size;
+    _entry_count = 0;
+    _deleted_count = 0;
+    _resize_threshold = _size / 4 * 3;
+    if (TraceJVMTIObjectTagging) {
+      _trace_threshold = initial_trace_threshold;
+    } else {
+      _trace_threshold = -1;
+    }
+    _table = allocate_table(_size);
   }
 
   // release table when JvmtiTagHashmap destroyed
   ~JvmtiTagHashmap() {
     if (_table != NULL) {
-      os::free((void*)_table);
+      FREE_C_HEAP_ARRAY(JvmtiTagHashmapEntry, _table, mtInternal);
       _table = NULL;
     }
   }
 
   // accessors
   int size() const                              { return _size; }
-  JvmtiTagHashmapEntry** table() const          { return _table; }
   int entry_count() const                       { return _entry_count; }
 
-  // find an entry in the hashmap, returns NULL if not found.
-  inline JvmtiTagHashmapEntry* find(oop key) {
-    unsigned int h = hash(key);
-    JvmtiTagHashmapEntry* entry = _table[h];
-    while (entry != NULL) {
-      if (entry->object() == key) {
-         return entry;
-      }
-      entry = entry->next();
-    }
-    return NULL;
+  // returns the tag of the given object, or 0 if it is not tagged
+  inline jlong find(oop key) const {
+    int pos = lookup(key);
+    return pos < 0 ? 0 : _table[pos]._tag;
   }
 
-
   // add a new entry to hashmap
-  inline void add(oop key, JvmtiTagHashmapEntry* entry) {
+  inline void add(oop key, jlong tag) {
     assert(key != NULL, "checking");
-    assert(find(key) == NULL, "duplicate detected");
-    unsigned int h = hash(key);
-    JvmtiTagHashmapEntry* anchor = _table[h];
-    if (anchor == NULL) {
-      _table[h] = entry;
-      entry->set_next(NULL);
-    } else {
-      entry->set_next(anchor);
-      _table[h] = entry;
-    }
+    assert(tag != 0, "can't be zero");
+    assert(lookup(key) < 0, "duplicate detected");
+    insert(key, tag);
 
-    _entry_count++;
     if (trace_threshold() > 0 && entry_count() >= trace_threshold()) {
       assert(TraceJVMTIObjectTagging, "should only get here when tracing");
       print_memory_usage();
       compute_next_trace_threshold();
     }
 
-    // if the number of entries exceed the threshold then resize
-    if (entry_count() > resize_threshold() && is_resizing_enabled()) {
+    // if the entries and tombstones exceed the threshold then resize
+    if (_entry_count + _deleted_count > resize_threshold()) {
       resize();
     }
   }
 
-  // remove an entry with the given key.
-  inline JvmtiTagHashmapEntry* remove(oop key) {
-    unsigned int h = hash(key);
-    JvmtiTagHashmapEntry* entry = _table[h];
-    JvmtiTagHashmapEntry* prev = NULL;
-    while (entry != NULL) {
-      if (key == entry->object()) {
-        break;
+  // tag, retag or, with a zero tag, untag an object
+  inline void set_tag(oop key, jlong tag) {
+    int pos = lookup(key);
+    if (pos < 0) {
+      if (tag != 0) {
+        add(key, tag);
       }
-      prev = entry;
-      entry = entry->next();
-    }
-    if (entry != NULL) {
-      remove(prev, h, entry);
+    } else if (tag == 0) {
+      remove_at(pos);
+    } else {
+      _table[pos]._tag = tag;
     }
-    return entry;
   }
 
-  // iterate over all entries in the hashmap
+  // iterate over all entries in the hashmap. The closure must not add or
+  // remove entries.
   void entry_iterate(JvmtiTagHashmapEntryClosure* closure);
 };
 
-// possible hashmap sizes - odd primes that roughly double in size.
-// To avoid excessive resizing the odd primes from 4801-76831 and
-// 76831-307261 have been removed. The list must be terminated by -1.
-int JvmtiTagHashmap::_sizes[] =  { 4801, 76831, 307261, 614563, 1228891,
-    2457733, 4915219, 9830479, 19660831, 39321619, 78643219, -1 };
-
 
 // A supporting class for iterating over all entries in Hashmap
 class JvmtiTagHashmapEntryClosure {
@@ -377,16 +303,9 @@ class JvmtiTagHashmapEntryClosure {
 // iterate over all entries in the hashmap
 void JvmtiTagHashmap::entry_iterate(JvmtiTagHashmapEntryClosure* closure) {
   for (int i=0; i<_size; i++) {
-    JvmtiTagHashmapEntry* entry = _table[i];
-    JvmtiTagHashmapEntry* prev = NULL;
-    while (entry != NULL) {
-      // obtain the next entry before invoking do_entry - this is
-      // necessary because do_entry may remove the entry from the
-      // hashmap.
-      JvmtiTagHashmapEntry* next = entry->next();
-      closure->do_entry(entry);
-      entry = next;
-     }
+    if (!is_free(_table[i]._object)) {
+      closure->do_entry(&_table[i]);
+    }
   }
 }
 
@@ -395,9 +314,8 @@ void JvmtiTagHashmap::print_memory_usage() {
   intptr_t p = (intptr_t)this;
   tty->print("[JvmtiTagHashmap @ " INTPTR_FORMAT, p);
 
-  // table + entries in KB
-  int hashmap_usage = (size()*sizeof(JvmtiTagHashmapEntry*) +
-    entry_count()*sizeof(JvmtiTagHashmapEntry))/K;
+  // table in KB
+  int hashmap_usage = (int)((size()*sizeof(JvmtiTagHashmapEntry))/K);
 
   int weak_globals_usage = (int)(JNIHandles::weak_global_handle_memory_usage()/K);
   tty->print_cr(", %d entries (%d KB) <JNI weak globals: %d KB>]",
@@ -420,9 +338,7 @@ void JvmtiTagHashmap::compute_next_trace_threshold() {
 // create a JvmtiTagMap
 JvmtiTagMap::JvmtiTagMap(JvmtiEnv* env) :
   _env(env),
-  _lock(Mutex::nonleaf+2, "JvmtiTagMap._lock", false),
-  _free_entries(NULL),
-  _free_entries_count(0)
+  _lock(Mutex::nonleaf+2, "JvmtiTagMap._lock", false)
 {
   assert(JvmtiThreadState_lock->is_locked(), "sanity check");
   assert(((JvmtiEnvBase *)env)->tag_map() == NULL, "tag map already exists for environment");
@@ -441,59 +357,9 @@ JvmtiTagMap::~JvmtiTagMap() {
   // also being destroryed.
   ((JvmtiEnvBase *)_env)->set_tag_map(NULL);
 
-  JvmtiTagHashmapEntry** table = _hashmap->table();
-  for (int j = 0; j < _hashmap->size(); j++) {
-    JvmtiTagHashmapEntry* entry = table[j];
-    while (entry != NULL) {
-      JvmtiTagHashmapEntry* next = entry->next();
-      delete entry;
-      entry = next;
-    }
-  }
-
   // finally destroy the hashmap
   delete _hashmap;
   _hashmap = NULL;
-
-  // remove any entries on the free list
-  JvmtiTagHashmapEntry* entry = _free_entries;
-  while (entry != NULL) {
-    JvmtiTagHashmapEntry* next = entry->next();
-    delete entry;
-    entry = next;
-  }
-  _free_entries = NULL;
-}
-
-// create a hashmap entry
-// - if there's an entry on the (per-environment) free list then this
-// is returned. Otherwise an new entry is allocated.
-JvmtiTagHashmapEntry* JvmtiTagMap::create_entry(oop ref, jlong tag) {
-  assert(Thread::current()->is_VM_thread() || is_locked(), "checking");
-  JvmtiTagHashmapEntry* entry;
-  if (_free_entries == NULL) {
-    entry = new JvmtiTagHashmapEntry(ref, tag);
-  } else {
-    assert(_free_entries_count > 0, "mismatched _free_entries_count");
-    _free_entries_count--;
-    entry = _free_entries;
-    _free_entries = entry->next();
-    entry->init(ref, tag);
-  }
-  return entry;
-}
-
-// destroy an entry by returning it to the free list
-void JvmtiTagMap::destroy_entry(JvmtiTagHashmapEntry* entry) {
-  assert(SafepointSynchronize::is_at_safepoint() || is_locked(), "checking");
-  // limit the size of the free list
-  if (_free_entries_count >= max_free_entries) {
-    delete entry;
-  } else {
-    entry->set_next(_free_entries);
-    _free_entries = entry;
-    _free_entries_count++;
-  }
 }
 
 // returns the tag map for the given environments. If the tag map
@@ -528,12 +394,7 @@ bool JvmtiTagMap::is_empty() {
 // not tagged
 //
 static inline jlong tag_for(JvmtiTagMap* tag_map, oop o) {
-  JvmtiTagHashmapEntry* entry = tag_map->hashmap()->find(o);
-  if (entry == NULL) {
-    return 0;
-  } else {
-    return entry->tag();
-  }
+  return tag_map->hashmap()->find(o);
 }
 
 
@@ -555,7 +416,7 @@ class CallbackWrapper : public StackObj {
  private:
   JvmtiTagMap* _tag_map;
   JvmtiTagHashmap* _hashmap;
-  JvmtiTagHashmapEntry* _entry;
+  jlong _old_obj_tag;
   oop _o;
   jlong _obj_size;
   jlong _obj_tag;
@@ -566,7 +427,7 @@ class CallbackWrapper : public StackObj {
 
   // invoked post-callback to tag, untag, or update the tag of an object
   void inline post_callback_tag_update(oop o, JvmtiTagHashmap* hashmap,
-                                       JvmtiTagHashmapEntry* entry, jlong obj_tag);
+                                       jlong old_obj_tag, jlong obj_tag);
  public:
   CallbackWrapper(JvmtiTagMap* tag_map, oop o) {
     assert(Thread::current()->is_VM_thread() || tag_map->is_locked(),
@@ -581,10 +442,9 @@ class CallbackWrapper : public StackObj {
     // record the context
     _tag_map = tag_map;
     _hashmap = tag_map->hashmap();
-    _entry = _hashmap->find(_o);
 
     // get object tag
-    _obj_tag = (_entry == NULL) ? 0 : _entry->tag();
+    _obj_tag = _old_obj_tag = _hashmap->find(_o);
 
     // get the class and the class's tag value
     assert(SystemDictionary::Class_klass()->oop_is_instanceMirror(), "Is not?");
@@ -593,7 +453,7 @@ class CallbackWrapper : public StackObj {
   }
 
   ~CallbackWrapper() {
-    post_callback_tag_update(_o, _hashmap, _entry, _obj_tag);
+    post_callback_tag_update(_o, _hashmap, _old_obj_tag, _obj_tag);
   }
 
   inline jlong* obj_tag_p()                     { return &_obj_tag; }
@@ -605,31 +465,17 @@ class CallbackWrapper : public StackObj {
 
 
 // callback post-callback to tag, untag, or update the tag of an object
+//
+// The object is looked up again rather than remembered by position, as
+// another wrapper may have added or removed an entry in the meantime.
 void inline CallbackWrapper::post_callback_tag_update(oop o,
                                                       JvmtiTagHashmap* hashmap,
-                                                      JvmtiTagHashmapEntry* entry,
+                                                      jlong old_obj_tag,
                                                       jlong obj_tag) {
-  if (entry == NULL) {
-    if (obj_tag != 0) {
-      // callback has tagged the object
-      assert(Thread::current()->is_VM_thread(), "must be VMThread");
-      entry = tag_map()->create_entry(o, obj_tag);
-      hashmap->add(o, entry);
-    }
-  } else {
-    // object was previously tagged - the callback may have untagged
-    // the object or changed the tag value
-    if (obj_tag == 0) {
-
-      JvmtiTagHashmapEntry* entry_removed = hashmap->remove(o);
-      assert(entry_removed == entry, "checking");
-      tag_map()->destroy_entry(entry);
-
-    } else {
-      if (obj_tag != entry->tag()) {
-         entry->set_tag(obj_tag);
-      }
-    }
+  if (obj_tag != old_obj_tag) {
+    // callback has tagged or untagged the object, or changed the tag value
+    assert(old_obj_tag != 0 || Thread::current()->is_VM_thread(), "must be VMThread");
+    hashmap->set_tag(o, obj_tag);
   }
 }
 
@@ -652,8 +498,8 @@ class TwoOopCallbackWrapper : public CallbackWrapper {
  private:
   bool _is_reference_to_self;
   JvmtiTagHashmap* _referrer_hashmap;
-  JvmtiTagHashmapEntry* _referrer_entry;
   oop _referrer;
+  jlong _referrer_old_obj_tag;
   jlong _referrer_obj_tag;
   jlong _referrer_klass_tag;
   jlong* _referrer_tag_p;
@@ -674,10 +520,9 @@ class TwoOopCallbackWrapper : public CallbackWrapper {
       _referrer = referrer;
       // record the context
       _referrer_hashmap = tag_map->hashmap();
-      _referrer_entry = _referrer_hashmap->find(_referrer);
 
       // get object tag
-      _referrer_obj_tag = (_referrer_entry == NULL) ? 0 : _referrer_entry->tag();
+      _referrer_obj_tag = _referrer_old_obj_tag = _referrer_hashmap->find(_referrer);
       _referrer_tag_p = &_referrer_obj_tag;
 
       // get referrer class tag.
@@ -689,7 +534,7 @@ class TwoOopCallbackWrapper : public CallbackWrapper {
     if (!is_reference_to_self()){
       post_callback_tag_update(_referrer,
                                _referrer_hashmap,
-                               _referrer_entry,
+                               _referrer_old_obj_tag,
                                _referrer_obj_tag);
     }
   }
@@ -713,29 +558,8 @@ void JvmtiTagMap::set_tag(jobject object, jlong tag) {
   // resolve the object
   oop o = JNIHandles::resolve_non_null(object);
 
-  // see if the object is already tagged
-  JvmtiTagHashmap* hashmap = _hashmap;
-  JvmtiTagHashmapEntry* entry = hashmap->find(o);
-
-  // if the object is not already tagged then we tag it
-  if (entry == NULL) {
-    if (tag != 0) {
-      entry = create_entry(o, tag);
-      hashmap->add(o, entry);
-    } else {
-      // no-op
-    }
-  } else {
-    // if the object is already tagged then we either update
-    // the tag (if a new tag value has been provided)
-    // or remove the object if the new tag value is 0.
-    if (tag == 0) {
-      hashmap->remove(o);
-      destroy_entry(entry);
-    } else {
-      entry->set_tag(tag);
-    }
-  }
+  // tag the object, update its tag, or untag it if the new tag value is 0
+  _hashmap->set_tag(o, tag);
 }
 
 // get the tag for an object
@@ -3106,7 +2930,10 @@ inline bool VM_HeapWalkOperation::collect_stack_roots(JavaThread* java_thread,
             if (last_entry_frame != NULL) {
               // JNI locals for the entry frame
               assert(last_entry_frame->is_entry_frame(), "checking");
-              last_entry_frame->entry_frame_call_wrapper()->handles()->oops_do(blk);
+              JNIHandleBlock* handles = last_entry_frame->entry_frame_call_wrapper()->handles();
+              if (handles != NULL) {
+                handles->oops_do(blk);
+              }
             }
           }
         }
@@ -3304,87 +3131,69 @@ void JvmtiTagMap::do_weak_oops(BoolObjectClosure* is_alive, OopClosure* f) {
 
   JvmtiTagHashmap* hashmap = this->hashmap();
 
-  // reenable sizing (if disabled)
-  hashmap->set_resizing_enabled(true);
-
   // if the hashmap is empty then we can skip it
   if (hashmap->_entry_count == 0) {
     return;
   }
 
-  // now iterate through each entry in the table
+  // now iterate through each entry in the table. Entries of objects that
+  // moved are taken out and added back once all oops have been processed,
+  // as adding them during the walk could make the walk visit them again.
 
-  JvmtiTagHashmapEntry** table = hashmap->table();
+  JvmtiTagHashmapEntry* table = hashmap->_table;
   int size = hashmap->size();
 
-  JvmtiTagHashmapEntry* delayed_add = NULL;
+  GrowableArray<JvmtiTagHashmapEntry>* moved_entries = NULL;
 
   for (int pos = 0; pos < size; ++pos) {
-    JvmtiTagHashmapEntry* entry = table[pos];
-    JvmtiTagHashmapEntry* prev = NULL;
-
-    while (entry != NULL) {
-      JvmtiTagHashmapEntry* next = entry->next();
+    JvmtiTagHashmapEntry* entry = &table[pos];
+    oop o = entry->object();
+    if (JvmtiTagHashmap::is_free(o)) {
+      continue;
+    }
 
-      oop* obj = entry->object_addr();
+    // has object been GC'ed
+    if (!is_alive->do_object_b(o)) {
+      // grab the tag
+      jlong tag = entry->tag();
+      guarantee(tag != 0, "checking");
 
-      // has object been GC'ed
-      if (!is_alive->do_object_b(entry->object())) {
-        // grab the tag
-        jlong tag = entry->tag();
-        guarantee(tag != 0, "checking");
+      // remove GC'ed entry from hashmap
+      hashmap->remove_at(pos);
 
-        // remove GC'ed entry from hashmap and return the
-        // entry to the free list
-        hashmap->remove(prev, pos, entry);
-        destroy_entry(entry);
+      // post the event to the profiler
+      if (post_object_free) {
+        JvmtiExport::post_object_free(env(), tag);
+      }
 
-        // post the event to the profiler
-        if (post_object_free) {
-          JvmtiExport::post_object_free(env(), tag);
-        }
+      ++freed;
+    } else {
+      f->do_oop(entry->object_addr());
 
-        ++freed;
-      } else {
-        f->do_oop(entry->object_addr());
-        oop new_oop = entry->object();
-
-        // if the object has moved then re-hash it and move its
-        // entry to its new location.
-        unsigned int new_pos = JvmtiTagHashmap::hash(new_oop, size);
-        if (new_pos != (unsigned int)pos) {
-          if (prev == NULL) {
-            table[pos] = next;
-          } else {
-            prev->set_next(next);
-          }
-          if (new_pos < (unsigned int)pos) {
-            entry->set_next(table[new_pos]);
-            table[new_pos] = entry;
-          } else {
-            // Delay adding this entry to it's new position as we'd end up
-            // hitting it again during this iteration.
-            entry->set_next(delayed_add);
-            delayed_add = entry;
-          }
-          moved++;
-        } else {
-          // object didn't move
-          prev = entry;
+      // if the object has moved then its entry must be re-hashed
+      if (entry->object() != o) {
+        if (moved_entries == NULL) {
+          moved_entries = new (ResourceObj::C_HEAP, mtInternal) GrowableArray<JvmtiTagHashmapEntry>(64, true);
         }
+        moved_entries->append(*entry);
+        hashmap->remove_at(pos);
+        moved++;
       }
-
-      entry = next;
     }
   }
 
   // Re-add all the entries which were kept aside
-  while (delayed_add != NULL) {
-    JvmtiTagHashmapEntry* next = delayed_add->next();
-    unsigned int pos = JvmtiTagHashmap::hash(delayed_add->object(), size);
-    delayed_add->set_next(table[pos]);
-    table[pos] = delayed_add;
-    delayed_add = next;
+  if (moved_entries != NULL) {
+    for (int i = 0; i < moved_entries->length(); i++) {
+      JvmtiTagHashmapEntry* entry = moved_entries->adr_at(i);
+      hashmap->insert(entry->object(), entry->tag());
+    }
+    delete moved_entries;
+  }
+
+  // drop the tombstones if they make up a large part of the table
+  if (hashmap->_entry_count + hashmap->_deleted_count > hashmap->resize_threshold()) {
+    hashmap->resize();
   }
 
   // stats
@@ -42,17 +42,10 @@ class JvmtiTagHashmapEntryClosure;
 class JvmtiTagMap :  public CHeapObj<mtInternal> {
  private:
 
-  enum{
-    max_free_entries = 4096         // maximum number of free entries per env
-  };
-
   JvmtiEnv*             _env;                       // the jvmti environment
   Mutex                 _lock;                      // lock for this tag map
   JvmtiTagHashmap*      _hashmap;                   // the hashmap
 
-  JvmtiTagHashmapEntry* _free_entries;              // free list for this environment
-  int _free_entries_count;                          // number of entries on the free list
-
   // create a tag map
   JvmtiTagMap(JvmtiEnv* env);
 
@@ -72,10 +65,6 @@ class JvmtiTagMap :  public CHeapObj<mtInternal> {
 
   JvmtiTagHashmap* hashmap() { return _hashmap; }
 
-  // create/destroy entries
-  JvmtiTagHashmapEntry* create_entry(oop ref, jlong tag);
-  void destroy_entry(JvmtiTagHashmapEntry* entry);
-
   // returns true if the hashmaps are empty
   bool is_empty();
 
@@ -32,6 +32,7 @@
 #include "memory/allocation.inline.hpp"
 #include "prims/jni.h"
 #include "prims/jvm.h"
+#include "prims/unsafeMemory.hpp"
 #include "runtime/globals.hpp"
 #include "runtime/interfaceSupport.hpp"
 #include "runtime/prefetch.inline.hpp"
@@ -614,7 +615,7 @@ UNSAFE_ENTRY(jlong, Unsafe_AllocateMemory(JNIEnv *env, jobject unsafe, jlong siz
     return 0;
   }
   sz = round_to(sz, HeapWordSize);
-  void* x = os::malloc(sz, mtInternal);
+  void* x = UseUnsafeMemoryArena ? UnsafeMemory::allocate(sz) : os::malloc(sz, mtInternal);
   if (x == NULL) {
     THROW_0(vmSymbols::java_lang_OutOfMemoryError());
   }
@@ -630,11 +631,22 @@ UNSAFE_ENTRY(jlong, Unsafe_ReallocateMemory(JNIEnv *env, jobject unsafe, jlong a
     THROW_0(vmSymbols::java_lang_IllegalArgumentException());
   }
   if (sz == 0) {
-    os::free(p);
+    if (UseUnsafeMemoryArena) {
+      if (p != NULL) {
+        UnsafeMemory::free(p);
+      }
+    } else {
+      os::free(p);
+    }
     return 0;
   }
   sz = round_to(sz, HeapWordSize);
-  void* x = (p == NULL) ? os::malloc(sz, mtInternal) : os::realloc(p, sz, mtInternal);
+  void* x;
+  if (UseUnsafeMemoryArena) {
+    x = (p == NULL) ? UnsafeMemory::allocate(sz) : UnsafeMemory::reallocate(p, sz);
+  } else {
+    x = (p == NULL) ? os::malloc(sz, mtInternal) : os::realloc(p, sz, mtInternal);
+  }
   if (x == NULL) {
     THROW_0(vmSymbols::java_lang_OutOfMemoryError());
   }
@@ -647,7 +659,11 @@ UNSAFE_ENTRY(void, Unsafe_FreeMemory(JNIEnv *env, jobject unsafe, jlong addr))
   if (p == NULL) {
     return;
   }
-  os::free(p);
+  if (UseUnsafeMemoryArena) {
+    UnsafeMemory::free(p);
+  } else {
+    os::free(p);
+  }
 UNSAFE_END
 
 UNSAFE_ENTRY(void, Unsafe_SetMemory(JNIEnv *env, jobject unsafe, jlong addr, jlong size, jbyte value))
@@ -707,6 +723,60 @@ UNSAFE_ENTRY(void, Unsafe_CopyMemory2(JNIEnv *env, jobject unsafe, jobject srcOb
   Copy::conjoint_memory_atomic(src, dst, sz);
 UNSAFE_END
 
+UNSAFE_ENTRY(void, Unsafe_CopySwapMemory(JNIEnv *env, jobject unsafe, jobject srcObj, jlong srcOffset, jobject dstObj, jlong dstOffset, jlong size, jlong elemSize))
+  UnsafeWrapper("Unsafe_CopySwapMemory");
+  if (size == 0) {
+    return;
+  }
+  size_t sz = (size_t)size;
+  size_t esz = (size_t)elemSize;
+  if (sz != (julong)size || size < 0 ||
+      (esz != 2 && esz != 4 && esz != 8) || sz % esz != 0) {
+    THROW(vmSymbols::java_lang_IllegalArgumentException());
+  }
+  oop srcp = JNIHandles::resolve(srcObj);
+  oop dstp = JNIHandles::resolve(dstObj);
+  if (dstp != NULL && !dstp->is_typeArray()) {
+    // Same restriction as copyMemory: swapping oops makes no sense.
+    THROW(vmSymbols::java_lang_IllegalArgumentException());
+  }
+  void* src = index_oop_from_field_offset_long(srcp, srcOffset);
+  void* dst = index_oop_from_field_offset_long(dstp, dstOffset);
+  Copy::conjoint_swap(src, dst, sz, esz);
+UNSAFE_END
+
+// Compare length elements of (1 << log2scale) bytes each and return the
+// index of the first element that differs, or -1 if the ranges are equal.
+// Both ranges are scanned a word at a time; only the word holding the
+// mismatch is examined bytewise.
+UNSAFE_ENTRY(jint, Unsafe_VectorizedMismatch(JNIEnv *env, jobject unsafe, jobject aObj, jlong aOffset, jobject bObj, jlong bOffset, jint length, jint log2scale))
+  UnsafeWrapper("Unsafe_VectorizedMismatch");
+  if (length < 0 || log2scale < 0 || log2scale > LogBytesPerLong) {
+    THROW_(vmSymbols::java_lang_IllegalArgumentException(), -1);
+  }
+  oop ap = JNIHandles::resolve(aObj);
+  oop bp = JNIHandles::resolve(bObj);
+  address a = (address)index_oop_from_field_offset_long(ap, aOffset);
+  address b = (address)index_oop_from_field_offset_long(bp, bOffset);
+  size_t bytes = (size_t)length << log2scale;
+
+  size_t i = 0;
+  for (; i + BytesPerLong <= bytes; i += BytesPerLong) {
+    julong x, y;
+    memcpy(&x, a + i, BytesPerLong);
+    memcpy(&y, b + i, BytesPerLong);
+    if (x != y) {
+      break;
+    }
+  }
+  for (; i < bytes; i++) {
+    if (a[i] != b[i]) {
+      return (jint)(i >> log2scale);
+    }
+  }
+  return -1;
+UNSAFE_END
+
 
 ////// Random queries
 
@@ -1690,6 +1760,11 @@ JNINativeMethod memcopy_methods_15[] = {
     {CC "copyMemory",         CC "(" ADR ADR "J)V",          FN_PTR(Unsafe_CopyMemory)}
 };
 
+JNINativeMethod memcopy_methods_bulk[] = {
+    {CC "copySwapMemory0",    CC "(" OBJ "J" OBJ "JJJ)V",      FN_PTR(Unsafe_CopySwapMemory)},
+    {CC "vectorizedMismatch", CC "(" OBJ "J" OBJ "JII)I",      FN_PTR(Unsafe_VectorizedMismatch)}
+};
+
 JNINativeMethod anonk_methods[] = {
     {CC "defineAnonymousClass", CC "(" DAC_Args ")" CLS,      FN_PTR(Unsafe_DefineAnonymousClass)},
 };
@@ -1792,6 +1867,9 @@ JVM_ENTRY(void, JVM_RegisterUnsafeMethods(JNIEnv *env, jclass unsafecls))
       }
     }
 
+    // Byte-swapping copy and bulk compare, present only in class libraries that declare them
+    register_natives("bulk memory methods", env, unsafecls, memcopy_methods_bulk, sizeof(memcopy_methods_bulk)/sizeof(JNINativeMethod));
+
     // Unsafe.defineAnonymousClass
     if (EnableInvokeDynamic) {
       register_natives("1.7 define anonymous class method", env, unsafecls, anonk_methods, sizeof(anonk_methods)/sizeof(JNINativeMethod));
@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+#include "precompiled.hpp"
+#include "prims/unsafeMemory.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/os.hpp"
+#include "runtime/thread.hpp"
+
+// In front of every block; two words to keep the alignment of malloc
+struct UnsafeMemoryHeader {
+  intptr_t _size_class;   // or large_block
+  intptr_t _slab;         // the UnsafeMemorySlab a class block was carved from
+};
+
+// In front of the blocks of every slab
+struct UnsafeMemorySlab {
+  UnsafeMemorySlab* _next;    // links the slabs a trim frees
+  intptr_t          _blocks;  // number of blocks carved from the slab
+  intptr_t          _free;    // of those, the ones on the global list
+  intptr_t          _unused;  // keeps the blocks two-word aligned
+};
+
+static const intptr_t large_block = -1;
+
+// Global free lists, linked through the first word after the header
+static void* _global_free[UnsafeMemory::num_classes];
+static uint  _global_count[UnsafeMemory::num_classes];
+// The global count at which the class is trimmed next
+static uint  _global_trim_at[UnsafeMemory::num_classes];
+
+static size_t class_size(int size_class) {
+  return (size_t)1 << (UnsafeMemory::min_class_shift + size_class);
+}
+
+static uint blocks_per_slab(int size_class) {
+  return (uint)(UnsafeMemory::slab_size / class_size(size_class));
+}
+
+// Blocks of a class a thread keeps, at least two and otherwise an eighth
+// of thread_cache_size
+static uint thread_cache_limit(int size_class) {
+  return (uint)MAX2((size_t)2, UnsafeMemory::thread_cache_size / 8 / class_size(size_class));
+}
+
+// Free blocks of a class kept globally before its free slabs are returned
+static uint global_cache_limit(int size_class) {
+  return (uint)(UnsafeMemory::global_cache_size / class_size(size_class));
+}
+
+static int size_class_for(size_t size) {
+  size_t needed = size + sizeof(UnsafeMemoryHeader);
+  if (needed > (size_t)UnsafeMemory::max_class_size) {
+    return (int)large_block;
+  }
+  int size_class = 0;
+  while (class_size(size_class) < needed) {
+    size_class++;
+  }
+  return size_class;
+}
+
+static UnsafeMemoryHeader* header_of(void* p) {
+  return (UnsafeMemoryHeader*)p - 1;
+}
+
+static UnsafeMemorySlab* slab_of(void* block) {
+  return (UnsafeMemorySlab*)((UnsafeMemoryHeader*)block)->_slab;
+}
+
+static void*& next_free(void* block) {
+  return *(void**)((UnsafeMemoryHeader*)block + 1);
+}
+
+static UnsafeMemoryCache* thread_cache() {
+  Thread* thread = Thread::current();
+  if (thread->unsafe_memory_cache() == NULL) {
+    thread->set_unsafe_memory_cache(new UnsafeMemoryCache());
+  }
+  return thread->unsafe_memory_cache();
+}
+
+// Moves up to n blocks of the class from the global list to the cache.
+// If the global list is empty, a new slab is carved: n blocks go to the
+// cache and the rest to the global list.
+bool UnsafeMemory::refill(UnsafeMemoryCache* cache, int size_class, uint n) {
+  size_t size = class_size(size_class);
+  {
+    MutexLockerEx ml(UnsafeMemory_lock, Mutex::_no_safepoint_check_flag);
+    while (n > 0 && _global_free[size_class] != NULL) {
+      void* block = _global_free[size_class];
+      _global_free[size_class] = next_free(block);
+      _global_count[size_class]--;
+      next_free(block) = cache->_free[size_class];
+      cache->_free[size_class] = block;
+      cache->_count[size_class]++;
+      cache->_bytes += size;
+      n--;
+    }
+  }
+  if (cache->_free[size_class] != NULL) {
+    return true;
+  }
+  UnsafeMemorySlab* slab = (UnsafeMemorySlab*)os::malloc(sizeof(UnsafeMemorySlab) + UnsafeMemory::slab_size, mtInternal);
+  if (slab == NULL) {
+    return false;
+  }
+  slab->_next = NULL;
+  slab->_blocks = blocks_per_slab(size_class);
+  slab->_free = 0;
+  char* blocks = (char*)(slab + 1);
+  MutexLockerEx ml(UnsafeMemory_lock, Mutex::_no_safepoint_check_flag);
+  for (intptr_t i = 0; i < slab->_blocks; i++) {
+    void* block = blocks + i * size;
+    ((UnsafeMemoryHeader*)block)->_size_class = size_class;
+    ((UnsafeMemoryHeader*)block)->_slab = (intptr_t)slab;
+    if (n > 0) {
+      next_free(block) = cache->_free[size_class];
+      cache->_free[size_class] = block;
+      cache->_count[size_class]++;
+      cache->_bytes += size;
+      n--;
+    } else {
+      next_free(block) = _global_free[size_class];
+      _global_free[size_class] = block;
+      _global_count[size_class]++;
+    }
+  }
+  return true;
+}
+
+// Moves all but keep blocks of the class from the cache to the global list
+void UnsafeMemory::release(UnsafeMemoryCache* cache, int size_class, uint keep) {
+  size_t size = class_size(size_class);
+  MutexLockerEx ml(UnsafeMemory_lock, Mutex::_no_safepoint_check_flag);
+  while (cache->_count[size_class] > keep) {
+    void* block = cache->_free[size_class];
+    cache->_free[size_class] = next_free(block);
+    cache->_count[size_class]--;
+    cache->_bytes -= size;
+    next_free(block) = _global_free[size_class];
+    _global_free[size_class] = block;
+    _global_count[size_class]++;
+  }
+  if (_global_count[size_class] > MAX2(global_cache_limit(size_class), _global_trim_at[size_class])) {
+    trim(size_class);
+  }
+}
+
+// Returns the slabs of the class whose blocks are all on the global list
+// to the OS. Partly used slabs stay, so the next trim waits until another
+// slab's worth of blocks has been released.
+void UnsafeMemory::trim(int size_class) {
+  assert_lock_strong(UnsafeMemory_lock);
+  for (void* block = _global_free[size_class]; block != NULL; block = next_free(block)) {
+    slab_of(block)->_free = 0;
+  }
+  for (void* block = _global_free[size_class]; block != NULL; block = next_free(block)) {
+    slab_of(block)->_free++;
+  }
+  UnsafeMemorySlab* freed = NULL;
+  void** link = &_global_free[size_class];
+  while (*link != NULL) {
+    void* block = *link;
+    UnsafeMemorySlab* slab = slab_of(block);
+    if (slab->_free == slab->_blocks) {
+      // Seen for the first time; -1 marks it for its other blocks
+      slab->_free = -1;
+      slab->_next = freed;
+      freed = slab;
+    }
+    if (slab->_free == -1) {
+      *link = next_free(block);
+      _global_count[size_class]--;
+    } else {
+      link = &next_free(block);
+    }
+  }
+  while (freed != NULL) {
+    UnsafeMemorySlab* next = freed->_next;
+    os::free(freed);
+    freed = next;
+  }
+  _global_trim_at[size_class] = _global_count[size_class] + blocks_per_slab(size_class);
+}
+
+void* UnsafeMemory::allocate(size_t size) {
+  int size_class = size_class_for(size);
+  if (size_class == large_block) {
+    UnsafeMemoryHeader* block = (UnsafeMemoryHeader*)os::malloc(size + sizeof(UnsafeMemoryHeader), mtInternal);
+    if (block == NULL) {
+      return NULL;
+    }
+    block->_size_class = large_block;
+    return block + 1;
+  }
+  UnsafeMemoryCache* cache = thread_cache();
+  if (cache->_free[size_class] == NULL &&
+      !refill(cache, size_class, thread_cache_limit(size_class) / 2)) {
+    return NULL;
+  }
+  void* block = cache->_free[size_class];
+  cache->_free[size_class] = next_free(block);
+  cache->_count[size_class]--;
+  cache->_bytes -= class_size(size_class);
+  return (UnsafeMemoryHeader*)block + 1;
+}
+
+void UnsafeMemory::free(void* p) {
+  UnsafeMemoryHeader* block = header_of(p);
+  int size_class = (int)block->_size_class;
+  if (size_class == large_block) {
+    os::free(block);
+    return;
+  }
+  assert(size_class >= 0 && size_class < num_classes, "not an Unsafe memory block");
+  UnsafeMemoryCache* cache = thread_cache();
+  next_free(block) = cache->_free[size_class];
+  cache->_free[size_class] = block;
+  cache->_count[size_class]++;
+  cache->_bytes += class_size(size_class);
+  uint limit = thread_cache_limit(size_class);
+  if (cache->_count[size_class] > limit) {
+    release(cache, size_class, limit / 2);
+  } else if (cache->_bytes > (size_t)thread_cache_size) {
+    // Blocks of many classes add up; give them all back
+    for (int i = 0; i < num_classes; i++) {
+      if (cache->_count[i] > 0) {
+        release(cache, i, 0);
+      }
+    }
+  }
+}
+
+void* UnsafeMemory::reallocate(void* p, size_t size) {
+  UnsafeMemoryHeader* block = header_of(p);
+  int size_class = (int)block->_size_class;
+  if (size_class == large_block && size_class_for(size) == large_block) {
+    block = (UnsafeMemoryHeader*)os::realloc(block, size + sizeof(UnsafeMemoryHeader), mtInternal);
+    return (block == NULL) ? NULL : block + 1;
+  }
+  size_t old_size = (size_class == large_block) ? size
+                                                : class_size(size_class) - sizeof(UnsafeMemoryHeader);
+  if (size_class != large_block && size <= old_size && size_class_for(size) == size_class) {
+    return p;
+  }
+  void* q = allocate(size);
+  if (q != NULL) {
+    // A large block is only copied into a class when it shrinks
+    memcpy(q, p, MIN2(size, old_size));
+    free(p);
+  }
+  return q;
+}
+
+void UnsafeMemory::flush_thread_cache(Thread* thread) {
+  UnsafeMemoryCache* cache = thread->unsafe_memory_cache();
+  if (cache == NULL) {
+    return;
+  }
+  for (int i = 0; i < num_classes; i++) {
+    if (cache->_count[i] > 0) {
+      release(cache, i, 0);
+    }
+  }
+  thread->set_unsafe_memory_cache(NULL);
+  delete cache;
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+#ifndef SHARE_VM_PRIMS_UNSAFEMEMORY_HPP
+#define SHARE_VM_PRIMS_UNSAFEMEMORY_HPP
+
+#include "memory/allocation.hpp"
+
+class Thread;
+class UnsafeMemoryCache;
+
+// Serves Unsafe.allocateMemory, and so NIO direct buffers, when
+// UseUnsafeMemoryArena is set. Requests of up to max_class_size bytes,
+// header included, are rounded up to a power of two size class and served
+// from free lists: first the calling thread's, then global ones, then
+// blocks carved from new slabs. Short lived buffers are thus mostly reused
+// by the thread that frees them, without a malloc call or a lock, and do
+// not fragment the C heap. Larger requests go to os::malloc.
+//
+// Every block starts with a header naming its class and slab, so any
+// thread can free it. A thread keeps at most thread_cache_size bytes of
+// free blocks, and gives them to the global lists when it exits. Once
+// more than global_cache_size bytes of a class are free globally, the
+// slabs all of whose blocks are free are returned to the OS.
+class UnsafeMemory : AllStatic {
+ public:
+  enum {
+    min_class_shift   = 5,               // 32 bytes
+    num_classes       = 12,              // up to 64K
+    max_class_size    = 1 << (min_class_shift + num_classes - 1),
+    slab_size         = 256*K,
+    thread_cache_size = 256*K,           // free bytes a thread keeps
+    global_cache_size = 4*slab_size      // free bytes kept per class
+  };
+
+ private:
+  static bool refill(UnsafeMemoryCache* cache, int size_class, uint n);
+  static void release(UnsafeMemoryCache* cache, int size_class, uint keep);
+  static void trim(int size_class);
+
+ public:
+  static void* allocate(size_t size);
+  static void* reallocate(void* p, size_t size);
+  static void  free(void* p);
+
+  // Returns the blocks a dying thread kept to the global lists
+  static void flush_thread_cache(Thread* thread);
+};
+
+// The free blocks a thread keeps for itself, per size class
+class UnsafeMemoryCache : public CHeapObj<mtInternal> {
+  friend class UnsafeMemory;
+ private:
+  void*  _free[UnsafeMemory::num_classes];
+  uint   _count[UnsafeMemory::num_classes];
+  size_t _bytes;
+
+ public:
+  UnsafeMemoryCache() : _bytes(0) {
+    for (int i = 0; i < UnsafeMemory::num_classes; i++) {
+      _free[i] = NULL;
+      _count[i] = 0;
+    }
+  }
+};
+
+#endif // SHARE_VM_PRIMS_UNSAFEMEMORY_HPP
@@ -938,7 +938,7 @@ WB_END
 
 int WhiteBox::get_blob_type(const CodeBlob* code) {
   guarantee(WhiteBoxAPI, "internal testing API :: WhiteBox has to be enabled");
-  return CodeBlobType::All;;
+  return CodeCache::get_code_blob_type(code);
 }
 
 struct CodeBlobStub {
@@ -1024,7 +1024,10 @@ CodeBlob* WhiteBox::allocate_code_blob(int size, int blob_type) {
   }
   {
     MutexLockerEx mu(CodeCache_lock, Mutex::_no_safepoint_check_flag);
-    blob = (BufferBlob*) CodeCache::allocate(full_size);
+    if (!CodeCache::heap_available(blob_type)) {
+      blob_type = CodeBlobType::NonNMethod;
+    }
+    blob = (BufferBlob*) CodeCache::allocate(full_size, blob_type);
     ::new (blob) BufferBlob("WB::DummyBlob", full_size);
   }
   // Track memory usage statistic after releasing CodeCache_lock
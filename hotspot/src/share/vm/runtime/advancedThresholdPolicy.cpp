@@ -24,9 +24,51 @@
 
 #include "precompiled.hpp"
 #include "runtime/advancedThresholdPolicy.hpp"
+#include "runtime/os_perf.hpp"
 #include "runtime/simpleThresholdPolicy.inline.hpp"
+#include "runtime/task.hpp"
 
 #ifdef TIERED
+
+volatile int AdvancedThresholdPolicy::_cpu_load_state = AdvancedThresholdPolicy::CPULoadNormal;
+
+// Samples the CPU load for TieredCPULoadFeedback in the WatcherThread.
+class TieredCPULoadSamplerTask : public PeriodicTask {
+  CPUPerformanceInterface* _cpu_perf;
+ public:
+  TieredCPULoadSamplerTask(int interval_time, CPUPerformanceInterface* cpu_perf) :
+    PeriodicTask(interval_time), _cpu_perf(cpu_perf) {}
+
+  void task() {
+    double jvm_user, jvm_kernel, system_total;
+    if (_cpu_perf->cpu_loads_process(&jvm_user, &jvm_kernel, &system_total) != OS_OK) {
+      return;
+    }
+    // The loads are fractions of all the CPUs of the machine.  In a
+    // container with a CPU quota the VM can be saturated while the
+    // machine is not, so also scale the VM's own load to its share.
+    double share = (double)os::processor_count() / os::active_processor_count();
+    double load = MAX2(system_total, (jvm_user + jvm_kernel) * share);
+    AdvancedThresholdPolicy::update_cpu_load(MIN2(load, 1.0));
+  }
+};
+
+void AdvancedThresholdPolicy::update_cpu_load(double load) {
+  int state = CPULoadNormal;
+  if (load * 100 >= TieredCPUSaturatedPercent) {
+    state = CPULoadSaturated;
+  } else if (load * 100 < TieredCPUIdlePercent) {
+    state = CPULoadIdle;
+  }
+  if (state != _cpu_load_state) {
+    _cpu_load_state = state;
+    if (PrintTieredEvents) {
+      ttyLocker tty_lock;
+      tty->print_cr("%lf: [cpu-load load=%.2lf state=%s]", os::elapsedTime(), load,
+                    state == CPULoadSaturated ? "saturated" : (state == CPULoadIdle ? "idle" : "normal"));
+    }
+  }
+}
 // Print an event.
 void AdvancedThresholdPolicy::print_specific(EventType type, methodHandle mh, methodHandle imh,
                                              int bci, CompLevel level) {
@@ -71,6 +113,19 @@ void AdvancedThresholdPolicy::initialize() {
 
   set_increase_threshold_at_ratio();
   set_start_time(os::javaTimeMillis());
+
+  if (TieredCPULoadFeedback) {
+    CPUPerformanceInterface* cpu_perf = new CPUPerformanceInterface();
+    if (cpu_perf->initialize()) {
+      int interval = MIN2(MAX2((int)TieredCPULoadSampleInterval, (int)PeriodicTask::min_interval),
+                          (int)PeriodicTask::max_interval - 1);
+      interval -= interval % PeriodicTask::interval_gran;
+      TieredCPULoadSamplerTask* task = new TieredCPULoadSamplerTask(interval, cpu_perf);
+      task->enroll();
+    } else {
+      delete cpu_perf;
+    }
+  }
 }
 
 // update_rate() is called from select_task() while holding a compile queue lock.
@@ -160,39 +215,60 @@ bool AdvancedThresholdPolicy::is_method_profiled(Method* method) {
   return false;
 }
 
-// Called with the queue locked and with at least one element
+// Recompute the event rate and the scheduling priority of a queued task.
+// Returns false if the task has gone stale and was removed from the queue.
+bool AdvancedThresholdPolicy::update_task_priority(jlong t, CompileQueue* compile_queue, CompileTask* task) {
+  Method* method = task->method();
+  update_rate(t, method);
+  // If a method has been stale for some time, remove it from the queue.
+  // The last task is always kept so that we have something to return.
+  if (compile_queue->size() > 1 && is_stale(t, TieredCompileTaskTimeout, method) && !is_old(method)) {
+    if (PrintTieredEvents) {
+      print_event(REMOVE_FROM_QUEUE, method, method, task->osr_bci(), (CompLevel)task->comp_level());
+    }
+    compile_queue->remove_and_mark_stale(task);
+    method->clear_queued_for_compilation();
+    return false;
+  }
+  compile_queue->update_priority(task, method->highest_comp_level(), weight(method));
+  return true;
+}
+
+// Called with the queue locked and with at least one element.
+//
+// The queue keeps its tasks ordered by the priority (see compare_methods())
+// computed the last time we looked at them, so instead of recomputing the
+// rate of every queued method on each call we only refresh the task at the
+// top until it stays there. Priorities only go stale as methods heat up or
+// cool down, so every TieredCompileTaskTimeout milliseconds all tasks are
+// reranked, which also prunes the stale ones.
 CompileTask* AdvancedThresholdPolicy::select_task(CompileQueue* compile_queue) {
-  CompileTask *max_task = NULL;
-  Method* max_method = NULL;
   jlong t = os::javaTimeMillis();
-  // Iterate through the queue and find a method with a maximum rate.
-  for (CompileTask* task = compile_queue->first(); task != NULL;) {
-    CompileTask* next_task = task->next();
-    Method* method = task->method();
-    update_rate(t, method);
-    if (max_task == NULL) {
-      max_task = task;
-      max_method = method;
-    } else {
-      // If a method has been stale for some time, remove it from the queue.
-      if (is_stale(t, TieredCompileTaskTimeout, method) && !is_old(method)) {
-        if (PrintTieredEvents) {
-          print_event(REMOVE_FROM_QUEUE, method, method, task->osr_bci(), (CompLevel)task->comp_level());
-        }
-        compile_queue->remove_and_mark_stale(task);
-        method->clear_queued_for_compilation();
-        task = next_task;
-        continue;
-      }
+  if (t - compile_queue->last_priority_refresh() >= TieredCompileTaskTimeout) {
+    compile_queue->set_last_priority_refresh(t);
+    for (CompileTask* task = compile_queue->first(); task != NULL;) {
+      CompileTask* next_task = task->next();
+      update_task_priority(t, compile_queue, task);
+      task = next_task;
+    }
+  }
 
-      // Select a method with a higher rate
-      if (compare_methods(method, max_method)) {
-        max_task = task;
-        max_method = method;
-      }
+  // Refresh the top task until it keeps its place. Tasks added since the
+  // last call are ranked first, so each of them is looked at here once.
+  // A refreshed task can only lose its place to another one, which bounds
+  // the number of iterations by the size of the queue.
+  CompileTask* max_task = NULL;
+  for (int i = compile_queue->size(); i > 0; i--) {
+    CompileTask* task = compile_queue->highest_priority();
+    if (update_task_priority(t, compile_queue, task) && compile_queue->highest_priority() == task) {
+      max_task = task;
+      break;
     }
-    task = next_task;
   }
+  if (max_task == NULL) {
+    max_task = compile_queue->highest_priority();
+  }
+  Method* max_method = max_task->method();
 
   if (max_task->comp_level() == CompLevel_full_profile && TieredStopAtLevel > CompLevel_full_profile
       && is_method_profiled(max_method)) {
@@ -230,6 +306,16 @@ double AdvancedThresholdPolicy::threshold_scale(CompLevel level, int feedback_k)
       k *= exp(current_reverse_free_ratio - _increase_threshold_at_ratio);
     }
   }
+
+  // Keep C2 from competing with the application for saturated CPUs,
+  // and use idle ones to reach peak performance sooner.
+  if (TieredCPULoadFeedback) {
+    if (_cpu_load_state == CPULoadSaturated && level == CompLevel_full_optimization) {
+      k *= 2;
+    } else if (_cpu_load_state == CPULoadIdle) {
+      k /= 2;
+    }
+  }
   return k;
 }
 
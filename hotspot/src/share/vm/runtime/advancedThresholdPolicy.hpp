@@ -190,6 +190,8 @@ class AdvancedThresholdPolicy : public SimpleThresholdPolicy {
   // Compute event rate for a given method. The rate is the number of event (invocations + backedges)
   // per millisecond.
   inline void update_rate(jlong t, Method* m);
+  // Update the rate and the queue priority of a task, removing it if it is stale.
+  bool update_task_priority(jlong t, CompileQueue* compile_queue, CompileTask* task);
   // Compute threshold scaling coefficient
   inline double threshold_scale(CompLevel level, int feedback_k);
   // If a method is old enough and is still in the interpreter we would want to
@@ -203,6 +205,12 @@ class AdvancedThresholdPolicy : public SimpleThresholdPolicy {
 
   double _increase_threshold_at_ratio;
 
+public:
+  // CPU load as last sampled for TieredCPULoadFeedback
+  enum CPULoadState { CPULoadIdle, CPULoadNormal, CPULoadSaturated };
+private:
+  static volatile int _cpu_load_state;
+
 protected:
   void print_specific(EventType type, methodHandle mh, methodHandle imh, int bci, CompLevel level);
 
@@ -224,6 +232,10 @@ public:
   virtual void initialize();
   virtual bool should_not_inline(ciEnv* env, ciMethod* callee);
 
+  // Called periodically with the load, from 0.0 to 1.0, of the CPUs
+  // available to the VM.
+  static void update_cpu_load(double load);
+
 };
 
 #endif // TIERED
@@ -1547,7 +1547,16 @@ void Arguments::set_use_compressed_oops() {
     }
 #endif //  _WIN64
   } else {
-    if (UseCompressedOops && !FLAG_IS_DEFAULT(UseCompressedOops)) {
+    bool want_compressed_oops = UseCompressedOops;
+#if !defined(COMPILER1) || defined(TIERED)
+    want_compressed_oops = want_compressed_oops || FLAG_IS_DEFAULT(UseCompressedOops);
+#endif
+    if (want_compressed_oops && select_object_alignment_for_compressed_oops(max_heap_size)) {
+      // A larger shift covers the heap; keep compressed oops.
+      if (FLAG_IS_DEFAULT(UseCompressedOops)) {
+        FLAG_SET_ERGO(bool, UseCompressedOops, true);
+      }
+    } else if (UseCompressedOops && !FLAG_IS_DEFAULT(UseCompressedOops)) {
       warning("Max heap size too large for Compressed Oops");
       FLAG_SET_DEFAULT(UseCompressedOops, false);
       FLAG_SET_DEFAULT(UseCompressedClassPointers, false);
@@ -1558,6 +1567,48 @@ void Arguments::set_use_compressed_oops() {
 }
 
 
+// Try to raise ObjectAlignmentInBytes, up to MaxErgoObjectAlignmentInBytes,
+// so that a heap of max_heap_size can still be addressed with compressed
+// oops (each doubling of the alignment doubles the encodable range). Only
+// done when the user has not chosen an alignment. Returns true and leaves
+// the alignment values updated if a suitable alignment was found.
+bool Arguments::select_object_alignment_for_compressed_oops(size_t max_heap_size) {
+#ifdef _LP64
+  if (!FLAG_IS_DEFAULT(ObjectAlignmentInBytes) || RequireSharedSpaces) {
+    return false;
+  }
+  intx alignment = ObjectAlignmentInBytes;
+  for (intx align = alignment * 2; align <= MaxErgoObjectAlignmentInBytes; align *= 2) {
+    if (align >= os::vm_page_size() ||
+        (!FLAG_IS_DEFAULT(SurvivorAlignmentInBytes) && SurvivorAlignmentInBytes < align)) {
+      break;
+    }
+    uint64_t encoding_max = (uint64_t(max_juint) + 1) << exact_log2(align);
+    if (max_heap_size <= encoding_max - (OopEncodingHeapMax - max_heap_for_compressed_oops())) {
+      FLAG_SET_ERGO(intx, ObjectAlignmentInBytes, align);
+      set_object_alignment();
+      if (FLAG_IS_DEFAULT(SurvivorAlignmentInBytes)) {
+        // verify_object_alignment() defaulted it to the old alignment.
+        SurvivorAlignmentInBytes = align;
+      }
+      if (PrintCompressedOopsMode || PrintGCDetails) {
+        // Objects are padded to the new alignment: on average half of the
+        // extra alignment is wasted per object.
+        jio_fprintf(defaultStream::output_stream(),
+                    "Compressed Oops: ObjectAlignmentInBytes set to " INTX_FORMAT
+                    " for a maximum heap of " SIZE_FORMAT "M (encodable: " SIZE_FORMAT "M), "
+                    "estimated padding overhead " INTX_FORMAT " bytes per object on average, "
+                    INTX_FORMAT " at most\n",
+                    align, max_heap_size / M, (size_t)OopEncodingHeapMax / M,
+                    (align - alignment) / 2, align - alignment);
+      }
+      return true;
+    }
+  }
+#endif // _LP64
+  return false;
+}
+
 // NOTE: set_use_compressed_klass_ptrs() must be called after calling
 // set_use_compressed_oops().
 void Arguments::set_use_compressed_klass_ptrs() {
@@ -1731,6 +1782,14 @@ void Arguments::set_g1_gc_flags() {
     FLAG_SET_DEFAULT(MarkStackSizeMax, 128 * TASKQUEUE_SIZE);
   }
 
+  // With ReferencesPerThread sizing the number of queues used to the
+  // discovered lists, parallel reference processing no longer costs
+  // anything for applications with few references, so enable it.
+  if (FLAG_IS_DEFAULT(ParallelRefProcEnabled) &&
+      ParallelGCThreads > 1 && ReferencesPerThread > 0) {
+    FLAG_SET_DEFAULT(ParallelRefProcEnabled, true);
+  }
+
   if (FLAG_IS_DEFAULT(GCTimeRatio) || GCTimeRatio == 0) {
     // In G1, we want the default GC overhead goal to be higher than
     // say in PS. So we set it here to 10%. Otherwise the heap might
@@ -2362,6 +2421,12 @@ bool Arguments::check_vm_args_consistency() {
   status = status && verify_interval(SymbolTableSize, minimumSymbolTableSize,
     (max_uintx / SymbolTable::bucket_size()), "SymbolTable size");
 
+  status = status && verify_min_value(SymbolAndStringTableLoadFactor, 1,
+                                      "SymbolAndStringTableLoadFactor");
+
+  status = status && verify_min_value(PreloadClassThreads, 1,
+                                      "PreloadClassThreads");
+
   {
     // Using "else if" below to avoid printing two error messages if min > max.
     // This will also prevent us from reporting both min>100 and max>100 at the
@@ -2494,8 +2559,15 @@ bool Arguments::check_vm_args_consistency() {
                                        "G1ConcRSHotCardLimit");
     status = status && verify_interval(G1ConcRSLogCacheSize, 0, 27,
                                        "G1ConcRSLogCacheSize");
+    if (G1ConcRSHotCardAgingInterval > 0) {
+      // The aging epoch takes the top two bits of each card count
+      status = status && verify_interval(G1ConcRSHotCardLimit, 0, 63,
+                                         "G1ConcRSHotCardLimit");
+    }
     status = status && verify_interval(StringDeduplicationAgeThreshold, 1, markOopDesc::max_age,
                                        "StringDeduplicationAgeThreshold");
+    status = status && verify_min_value((intx)StringDeduplicationThreads, 1,
+                                        "StringDeduplicationThreads");
   }
   if (UseConcMarkSweepGC) {
     status = status && verify_min_value(CMSOldPLABNumRefills, 1, "CMSOldPLABNumRefills");
@@ -2682,6 +2754,13 @@ bool Arguments::check_vm_args_consistency() {
     warning("Reserved Stack Area not supported on this platform");
   }
 #endif
+
+#ifndef SUPPORT_THREAD_LOCAL_POLL
+  if (ThreadLocalHandshakes) {
+    FLAG_SET_CMDLINE(bool, ThreadLocalHandshakes, false);
+    warning("Thread-local handshakes not supported on this platform");
+  }
+#endif
   return status;
 }
 
@@ -4254,6 +4333,12 @@ jint Arguments::apply_ergo() {
     CommandLineFlags::printSetFlags(tty);
   }
 
+  // Biased locking is off by default: stack locking needs no safepoint to
+  // hand a lock to another thread, while revoking a bias usually does.
+  if (FLAG_IS_CMDLINE(UseBiasedLocking) && UseBiasedLocking) {
+    warning("Option UseBiasedLocking was deprecated and will likely be removed in a future release.");
+  }
+
   // Apply CPU specific policy for the BiasedLocking
   if (UseBiasedLocking) {
     if (!VM_Version::use_biased_locking() &&
@@ -4267,6 +4352,11 @@ jint Arguments::apply_ergo() {
   }
 #endif
 
+  // The async deflater finds the monitors to deflate on the in-use lists.
+  if (AsyncDeflateIdleMonitors && !MonitorInUseLists) {
+    FLAG_SET_ERGO(bool, MonitorInUseLists, true);
+  }
+
   // set PauseAtExit if the gamma launcher was used and a debugger is attached
   // but only if not already set on the commandline
   if (Arguments::created_by_gamma_launcher() && os::is_debugger_attached()) {
@@ -4291,8 +4381,10 @@ jint Arguments::adjust_after_os() {
     // platforms when UseNUMA is set to ON. NUMA-aware collectors
     // such as the parallel collector for Linux and Solaris will
     // interleave old gen and survivor spaces on top of NUMA
-    // allocation policy for the eden space.
-    // Non NUMA-aware collectors such as CMS, G1 and Serial-GC on
+    // allocation policy for the eden space. G1 on Linux binds each
+    // heap region to a node right after committing it, overriding
+    // the interleaving for the Java heap.
+    // Non NUMA-aware collectors such as CMS and Serial-GC on
     // all platforms and ParallelGC on Windows will interleave all
     // of the heap spaces across NUMA nodes.
     if (FLAG_IS_DEFAULT(UseNUMAInterleaving)) {
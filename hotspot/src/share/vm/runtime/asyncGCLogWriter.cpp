@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "prims/jvm.h"
+#include "runtime/asyncGCLogWriter.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/orderAccess.inline.hpp"
+#include "runtime/os.hpp"
+#include "utilities/ostream.hpp"
+
+AsyncGCLogWriter* volatile AsyncGCLogWriter::_writer = NULL;
+gcLogFileStream* AsyncGCLogWriter::_stream = NULL;
+char*   AsyncGCLogWriter::_buffers[2] = { NULL, NULL };
+size_t  AsyncGCLogWriter::_used[2] = { 0, 0 };
+size_t  AsyncGCLogWriter::_line_start[2] = { 0, 0 };
+int     AsyncGCLogWriter::_active = 0;
+volatile int AsyncGCLogWriter::_buffer_lock = 0;
+size_t  AsyncGCLogWriter::_dropped = 0;
+bool    AsyncGCLogWriter::_dropping = false;
+bool    AsyncGCLogWriter::_detached = false;
+volatile bool AsyncGCLogWriter::_should_terminate = false;
+
+AsyncGCLogWriter::AsyncGCLogWriter() : NamedThread() {
+  set_name("Async GC Log Writer");
+}
+
+void AsyncGCLogWriter::initialize(gcLogFileStream* stream) {
+  assert(UseAsyncGCLog, "only used with UseAsyncGCLog");
+  assert(_stream == NULL, "initialized more than once");
+  _buffers[0] = NEW_C_HEAP_ARRAY(char, AsyncGCLogBufferSize, mtInternal);
+  _buffers[1] = NEW_C_HEAP_ARRAY(char, AsyncGCLogBufferSize, mtInternal);
+  _stream = stream;
+}
+
+void AsyncGCLogWriter::start() {
+  if (_stream == NULL) {
+    // No -Xloggc file, or it could not be opened.
+    return;
+  }
+  assert(writer() == NULL, "we can only start one AsyncGCLogWriter");
+
+  AsyncGCLogWriter* writer = new AsyncGCLogWriter();
+  if (!os::create_thread(writer, os::watcher_thread)) {
+    warning("Cannot create the async GC log writer thread, "
+            "the GC log is written synchronously");
+    return;
+  }
+  OrderAccess::release_store_ptr(&_writer, writer);
+  os::start_thread(writer);
+}
+
+void AsyncGCLogWriter::stop() {
+  if (!is_running()) {
+    return;
+  }
+
+  {
+    MutexLocker ml(AsyncGCLog_lock);
+    _should_terminate = true;
+    AsyncGCLog_lock->notify();
+  }
+
+  // The writer writes out what is left before it terminates.
+  MutexLocker mu(Terminator_lock);
+  while (is_running()) {
+    Terminator_lock->wait();
+  }
+}
+
+void AsyncGCLogWriter::run() {
+  assert(this == writer(), "just checking");
+
+  this->record_stack_base_and_size();
+  this->initialize_thread_local_storage();
+  this->initialize_named_thread();
+
+  {
+    MutexLockerEx ml(AsyncGCLog_lock, Mutex::_no_safepoint_check_flag);
+    while (!_should_terminate) {
+      AsyncGCLog_lock->wait(Mutex::_no_safepoint_check_flag, flush_interval);
+      flush();
+    }
+
+    // Write out the rest with the spin lock held: producers that come
+    // later wait for it, and then write to the file directly, so their
+    // output neither gets lost in the buffers nor overtakes it.
+    Thread::SpinAcquire(&_buffer_lock, "AsyncGCLogBuffer");
+    _detached = true;
+    write_buffer(_active, _dropped);
+    Thread::SpinRelease(&_buffer_lock);
+  }
+
+  // Signal that it is terminated
+  {
+    MutexLockerEx mu(Terminator_lock, Mutex::_no_safepoint_check_flag);
+    _writer = NULL;
+    Terminator_lock->notify();
+  }
+
+  // Thread destructor usually does this..
+  ThreadLocalStorage::set_thread(NULL);
+}
+
+bool AsyncGCLogWriter::enqueue(const char* s, size_t len) {
+  Thread::SpinAcquire(&_buffer_lock, "AsyncGCLogBuffer");
+  if (_detached) {
+    Thread::SpinRelease(&_buffer_lock);
+    return false;
+  }
+  if (_dropping) {
+    // The start of the line was dropped, so drop up to its end too.
+    const char* nl = (const char*)memchr(s, '\n', len);
+    if (nl == NULL) {
+      len = 0;
+    } else {
+      _dropped++;
+      _dropping = false;
+      len -= nl + 1 - s;
+      s = nl + 1;
+    }
+  }
+  if (len > 0) {
+    size_t used = _used[_active];
+    if (len <= AsyncGCLogBufferSize - used) {
+      memcpy(_buffers[_active] + used, s, len);
+      _used[_active] = used + len;
+      for (size_t i = len; i > 0; i--) {
+        if (s[i - 1] == '\n') {
+          _line_start[_active] = used + i;
+          break;
+        }
+      }
+    } else {
+      // Drop the lines in s, together with the buffered start of the
+      // first one. Each line is counted when its end is seen.
+      _used[_active] = _line_start[_active];
+      for (size_t i = 0; i < len; i++) {
+        if (s[i] == '\n') {
+          _dropped++;
+        }
+      }
+      _dropping = s[len - 1] != '\n';
+    }
+  }
+  Thread::SpinRelease(&_buffer_lock);
+  return true;
+}
+
+void AsyncGCLogWriter::flush() {
+  assert(AsyncGCLog_lock->owned_by_self(), "AsyncGCLog_lock required");
+
+  // Producers only ever touch the active buffer, so once the buffers
+  // are swapped the filled one can be written without the spin lock.
+  // The unfinished line, if any, moves to the new active buffer.
+  Thread::SpinAcquire(&_buffer_lock, "AsyncGCLogBuffer");
+  int filled = _active;
+  _active = 1 - filled;
+  assert(_used[_active] == 0, "must have been written out");
+  size_t line_start = _line_start[filled];
+  size_t tail = _used[filled] - line_start;
+  memcpy(_buffers[_active], _buffers[filled] + line_start, tail);
+  _used[_active] = tail;
+  _line_start[_active] = 0;
+  _used[filled] = line_start;
+  size_t dropped = _dropped;
+  _dropped = 0;
+  Thread::SpinRelease(&_buffer_lock);
+
+  write_buffer(filled, dropped);
+}
+
+void AsyncGCLogWriter::write_buffer(int index, size_t dropped) {
+  if (_used[index] > 0) {
+    _stream->write_direct(_buffers[index], _used[index]);
+    _used[index] = 0;
+  }
+  _line_start[index] = 0;
+  if (dropped > 0) {
+    char msg[64];
+    jio_snprintf(msg, sizeof(msg),
+                 "[" SIZE_FORMAT " GC log messages dropped]\n", dropped);
+    _stream->write_direct(msg, strlen(msg));
+  }
+  _stream->flush();
+}
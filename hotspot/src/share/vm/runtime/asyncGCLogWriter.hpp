@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_RUNTIME_ASYNCGCLOGWRITER_HPP
+#define SHARE_VM_RUNTIME_ASYNCGCLOGWRITER_HPP
+
+#include "runtime/thread.hpp"
+
+class gcLogFileStream;
+
+// AsyncGCLogWriter takes the file I/O of the -Xloggc stream off the
+// threads that produce GC and safepoint log output (UseAsyncGCLog).
+// Producers copy their output into the active one of two buffers under
+// a spin lock that is only held for the copy, and never wait for the
+// log device.  Output is buffered and dropped in whole lines: if the
+// active buffer is full, the line being written is dropped and counted,
+// including the part of it that did fit.  The writer thread periodically
+// swaps the buffers and writes the complete lines of the filled one to
+// the file, followed by a note with the number of dropped lines.  An
+// unfinished line is moved over to the other buffer and written once it
+// is complete.  Buffers are written with AsyncGCLog_lock held, so
+// log rotation at a safepoint drains the buffers first and skips a
+// size-triggered rotation while the writer is blocked on the device.
+
+class AsyncGCLogWriter : public NamedThread {
+ private:
+  static AsyncGCLogWriter* volatile _writer;
+  static gcLogFileStream* _stream;
+  static char*   _buffers[2];
+  static size_t  _used[2];
+  static size_t  _line_start[2];        // start of the unfinished line
+  static int     _active;
+  static volatile int _buffer_lock;
+  static size_t  _dropped;              // lines dropped since the last flush
+  static bool    _dropping;             // dropping the rest of a line
+  static bool    _detached;             // the final flush has been done
+  static volatile bool _should_terminate;
+
+  enum SomeConstants {
+    flush_interval = 20                 // writer wake up interval in milliseconds
+  };
+
+  AsyncGCLogWriter();
+
+  // Write out the filled buffer and the dropped lines note.
+  static void write_buffer(int index, size_t dropped);
+
+ public:
+  virtual void run();
+
+  // Called when the -Xloggc stream has been opened; no output is
+  // buffered until start() has created the writer thread.
+  static void initialize(gcLogFileStream* stream);
+  static void start();
+  static void stop();
+
+  static bool is_running()              { return _writer != NULL; }
+  static AsyncGCLogWriter* writer()     { return _writer; }
+
+  // Copy output into the active buffer, or drop the line it belongs to
+  // if it does not fit.  Returns false, without buffering the output, once
+  // the writer has done its final flush; the caller then writes directly.
+  static bool enqueue(const char* s, size_t len);
+
+  // Write out the buffered output.  Requires AsyncGCLog_lock.
+  static void flush();
+};
+
+#endif // SHARE_VM_RUNTIME_ASYNCGCLOGWRITER_HPP
@@ -27,6 +27,8 @@
 #include "oops/markOop.hpp"
 #include "runtime/basicLock.hpp"
 #include "runtime/biasedLocking.hpp"
+#include "runtime/handshake.hpp"
+#include "runtime/safepointMechanism.hpp"
 #include "runtime/task.hpp"
 #include "runtime/vframe.hpp"
 #include "runtime/vmThread.hpp"
@@ -541,6 +543,73 @@ public:
 };
 
 
+// Revokes the bias of a single object through a handshake with the thread
+// the object is biased toward, so that only that thread is stopped.
+class RevokeOneBias : public ThreadClosure {
+protected:
+  Handle _obj;
+  JavaThread* _biased_locker;
+  BiasedLocking::Condition _status_code;
+  traceid _biased_locker_id;
+  bool _executed;
+
+public:
+  RevokeOneBias(Handle obj, JavaThread* biased_locker)
+    : _obj(obj)
+    , _biased_locker(biased_locker)
+    , _status_code(BiasedLocking::NOT_BIASED)
+    , _biased_locker_id(0)
+    , _executed(false) {}
+
+  void do_thread(Thread* target) {
+    assert(target == _biased_locker, "Wrong thread");
+
+    oop o = _obj();
+    markOop mark = o->mark();
+    markOop prototype = o->klass()->prototype_header();
+
+    // The bias may have changed since the handshake was requested, in
+    // which case the caller falls back to the safepoint revocation.
+    if (!mark->has_bias_pattern() ||
+        !prototype->has_bias_pattern() ||
+        mark->biased_locker() != _biased_locker ||
+        mark->bias_epoch() != prototype->bias_epoch()) {
+      return;
+    }
+
+    // The biased thread is either executing this itself or is kept in a
+    // safe state by the handshake, so its stack can be walked and the
+    // object header updated without racing with the owner. Passing it as
+    // the requesting thread skips the liveness check, the handshake
+    // guarantees the thread is on the threads list.
+    ResourceMark rm;
+    HandleMark hm;
+    if (TraceBiasedLocking) {
+      tty->date_stamp(TraceBiasedLockingDateStamp, "", ": ");
+      tty->print_cr("Revoking bias with thread-local handshake:");
+    }
+    _status_code = revoke_bias(o, false, false, _biased_locker, NULL);
+    _biased_locker->set_cached_monitor_info(NULL);
+#if INCLUDE_JFR
+    _biased_locker_id = JFR_THREAD_ID(_biased_locker);
+#endif // INCLUDE_JFR
+    _executed = true;
+  }
+
+  bool executed() const {
+    return _executed;
+  }
+
+  BiasedLocking::Condition status_code() const {
+    return _status_code;
+  }
+
+  traceid biased_locker() const {
+    return _biased_locker_id;
+  }
+};
+
+
 class VM_BulkRevokeBias : public VM_RevokeBias {
 private:
   bool _bulk_rebias;
@@ -658,6 +727,25 @@ BiasedLocking::Condition BiasedLocking::revoke_and_rebias(Handle obj, bool attem
       }
       return cond;
     } else {
+      JavaThread* biased_locker = mark->biased_locker();
+      if (SafepointMechanism::uses_thread_local_poll() && biased_locker != NULL) {
+        EventBiasedLockRevocation event;
+        RevokeOneBias revoke(obj, biased_locker);
+        bool alive = Handshake::execute(&revoke, biased_locker);
+        if (alive && revoke.executed()) {
+          if (event.should_commit() && revoke.status_code() != NOT_BIASED) {
+            event.set_lockClass(k);
+            // No safepoint was needed for the revocation
+            event.set_safepointId(0);
+            event.set_previousOwner(revoke.biased_locker());
+            event.commit();
+          }
+          return revoke.status_code();
+        }
+        // The biased thread has exited or the bias changed in the
+        // meantime, the safepoint revocation below handles both cases.
+      }
+
       EventBiasedLockRevocation event;
       VM_RevokeBias revoke(&obj, (JavaThread*) THREAD);
       VMThread::execute(&revoke);
@@ -1579,8 +1579,19 @@ JRT_ENTRY(void, Deoptimization::uncommon_trap_inner(JavaThread* thread, jint tra
       DeoptReason per_bc_reason = reason_recorded_per_bytecode_if_any(reason);
       if (per_bc_reason != Reason_none) {
         // Now take action based on the partially known per-BCI history.
+        // A BCI which already caused recompiles for this reason backs
+        // off exponentially, so that a site which keeps trapping after
+        // each recompile does not drive the method through a storm of
+        // recompilations toward PerBytecodeRecompilationCutoff.
+        uint trap_limit = (uint)PerBytecodeTrapLimit;
+        if (maybe_prior_recompile && PerBytecodeTrapLimitBackoff > 0) {
+          uint backoff = MIN2(trap_mdo->recompile_count(reason),
+                              (uint)PerBytecodeTrapLimitBackoff);
+          // The trap count saturates, so a higher limit would never be hit
+          trap_limit = MIN2(trap_limit << backoff, MethodData::trap_count_limit());
+        }
         if (maybe_prior_trap
-            && this_trap_count >= (uint)PerBytecodeTrapLimit) {
+            && this_trap_count >= trap_limit) {
           // If there are too many traps at this BCI, force a recompile.
           // This will allow the compiler to see the limit overflow, and
           // take corrective action, if possible.  The compiler generally
@@ -1647,6 +1658,11 @@ JRT_ENTRY(void, Deoptimization::uncommon_trap_inner(JavaThread* thread, jint tra
           pdata->set_trap_state(tstate1);
       }
 
+      if (trap_mdo != NULL) {
+        // Record why the method is being recompiled.
+        trap_mdo->inc_recompile_count(reason);
+      }
+
 #if INCLUDE_RTM_OPT
       // Restart collecting RTM locking abort statistic if the method
       // is recompiled for a reason other than RTM state change.
@@ -48,7 +48,7 @@ class Deoptimization : AllStatic {
     Reason_class_check,           // saw unexpected object class (@bci)
     Reason_array_check,           // saw unexpected array class (aastore @bci)
     Reason_intrinsic,             // saw unexpected operand to intrinsic (@bci)
-    Reason_bimorphic,             // saw unexpected object class in bimorphic inlining (@bci)
+    Reason_bimorphic,             // saw unexpected object class in bi- or polymorphic inlining (@bci)
 
     Reason_unloaded,              // unloaded class or constant pool entry
     Reason_uninitialized,         // bad class state (uninitialized)
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 1997, 2019, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 1997, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -543,6 +543,11 @@ class CommandLineFlags {
   lp64_product(intx, ObjectAlignmentInBytes, 8,                             \
           "Default object alignment in bytes, 8 is minimum")                \
                                                                             \
+  lp64_product(intx, MaxErgoObjectAlignmentInBytes, 32,                     \
+          "Largest object alignment ergonomics may select to keep "         \
+          "compressed oops enabled for a heap beyond the 8-byte-aligned "   \
+          "limit; 8 disables the selection")                                \
+                                                                            \
   product(bool, AssumeMP, false,                                            \
           "Instruct the VM to assume multiple processors are available")    \
                                                                             \
@@ -583,6 +588,10 @@ class CommandLineFlags {
           "Use large page memory in metaspace. "                            \
           "Only used if UseLargePages is enabled.")                         \
                                                                             \
+  product(bool, UseLargePagesInCodeCache, true,                             \
+          "Use large page memory for the code cache. "                      \
+          "Only used if UseLargePages is enabled.")                         \
+                                                                            \
   develop(bool, TracePageSizes, false,                                      \
           "Trace page size selection and usage")                            \
                                                                             \
@@ -595,6 +604,11 @@ class CommandLineFlags {
   product(uintx, NUMAInterleaveGranularity, 2*M,                            \
           "Granularity to use for NUMA interleaving on Windows OS")         \
                                                                             \
+  product(bool, PSOldGenNUMABinding, false,                                 \
+          "With UseNUMA and ParallelOldGC, bind old generation pages to "   \
+          "NUMA nodes in compaction region sized stripes instead of "       \
+          "interleaving them, and compact into each stripe on its node")    \
+                                                                            \
   product(bool, ForceNUMA, false,                                           \
           "Force NUMA optimizations on single-node/UMA systems")            \
                                                                             \
@@ -701,6 +715,10 @@ class CommandLineFlags {
   product(bool, UseInlineCaches, true,                                      \
           "Use Inline Caches for virtual calls ")                           \
                                                                             \
+  product(bool, UseItableCache, true,                                       \
+          "Let megamorphic interface calls remember in the receiver "       \
+          "class the itable entry they found last (x86_64 only)")           \
+                                                                            \
   develop(bool, InlineArrayCopy, true,                                      \
           "Inline arraycopy native that is known to be part of "            \
           "base library DLL")                                               \
@@ -727,6 +745,10 @@ class CommandLineFlags {
   product(bool, CriticalJNINatives, true,                                   \
           "Check for critical JNI entry points")                            \
                                                                             \
+  product(bool, LazyJNIHandleBlocks, true,                                  \
+          "Let a call from the VM into Java reuse the caller's JNI local "  \
+          "handle block when it is empty instead of allocating one")        \
+                                                                            \
   product(bool, UseLegacyJNINameEscaping, false,                            \
           "Use the original JNI name escaping scheme")                      \
                                                                             \
@@ -754,6 +776,13 @@ class CommandLineFlags {
   product(bool, UseCRC32Intrinsics, false,                                  \
           "use intrinsics for java.util.zip.CRC32")                         \
                                                                             \
+  product(bool, UseAdler32Intrinsics, false,                                \
+          "use intrinsics for java.util.zip.Adler32")                       \
+                                                                            \
+  product(bool, UseStrictMathIntrinsics, true,                              \
+          "call the VM's fdlibm routines directly for the StrictMath "      \
+          "exp, log, log10, pow, sin, cos and tan natives")                 \
+                                                                            \
   develop(bool, TraceCallFixup, false,                                      \
           "Trace all call fixups")                                          \
                                                                             \
@@ -795,6 +824,15 @@ class CommandLineFlags {
   product(bool, FailOverToOldVerifier, true,                                \
           "Fail over to old verifier when split verifier fails")            \
                                                                             \
+  product(bool, UseVerificationCache, false,                                \
+          "Do not verify a class file again if the same bytes passed the "  \
+          "split verifier before and the classes it depends on still "      \
+          "check out the same way")                                         \
+                                                                            \
+  product(uintx, VerificationCacheSize, 64*K,                               \
+          "Maximum number of class files remembered by the verification "   \
+          "cache")                                                          \
+                                                                            \
   develop(bool, ShowSafepointMsgs, false,                                   \
           "Show message about safepoint synchronization")                   \
                                                                             \
@@ -805,6 +843,10 @@ class CommandLineFlags {
   diagnostic(bool, AbortVMOnSafepointTimeout, false,                        \
           "Abort upon failure to reach safepoint (see SafepointTimeout)")   \
                                                                             \
+  product(bool, ThreadLocalHandshakes, false,                               \
+          "Use thread-local polls so that the VM thread can execute an "    \
+          "operation on a single Java thread without a global safepoint")   \
+                                                                            \
   /* 50 retries * (5 * current_retry_count) millis = ~6.375 seconds */      \
   /* typically, at most a few retries are needed */                         \
   product(intx, SuspendRetryCount, 50,                                      \
@@ -952,6 +994,15 @@ class CommandLineFlags {
   manageable(bool, HeapDumpOnOutOfMemoryError, false,                       \
           "Dump heap to file when java.lang.OutOfMemoryError is thrown")    \
                                                                             \
+  manageable(uintx, HeapDumpGzipLevel, 0,                                   \
+          "When HeapDumpOnOutOfMemoryError is on, the gzip compression "    \
+          "level (1-9) of the dump file, which then gets a .gz suffix. "    \
+          "0 writes an uncompressed dump")                                  \
+                                                                            \
+  product(bool, ParallelHeapInspection, true,                               \
+          "Use the safepoint worker threads to build class histograms "     \
+          "when the heap supports parallel object iteration")               \
+                                                                            \
   manageable(ccstr, HeapDumpPath, NULL,                                     \
           "When HeapDumpOnOutOfMemoryError is on, the path (filename or "   \
           "directory) of the dump file (defaults to java_pid<pid>.hprof "   \
@@ -976,6 +1027,10 @@ class CommandLineFlags {
   product(ccstr, NativeMemoryTracking, "off",                               \
           "Native memory tracking options")                                 \
                                                                             \
+  product(uintx, NMTDetailSampleInterval, 1,                                \
+          "With NativeMemoryTracking=detail, record the call stack of "     \
+          "only every Nth malloc and scale the malloc site numbers by N")   \
+                                                                            \
   diagnostic(bool, PrintNMTStatistics, false,                               \
           "Print native memory tracking summary data if it is on")          \
                                                                             \
@@ -1110,6 +1165,10 @@ class CommandLineFlags {
   product(bool, ClassUnloadingWithConcurrentMark, true,                     \
           "Do unloading of classes with a concurrent marking cycle")        \
                                                                             \
+  product(bool, ConcurrentClassLoaderDataPurge, false,                      \
+          "Delete the class loader data of unloaded class loaders "         \
+          "concurrently after a G1 or CMS cycle instead of in a pause")     \
+                                                                            \
   develop(bool, DisableStartThread, false,                                  \
           "Disable starting of additional Java threads "                    \
           "(for debugging only)")                                           \
@@ -1133,6 +1192,14 @@ class CommandLineFlags {
           "loadClass() even for class loaders registering "                 \
           "as parallel capable")                                            \
                                                                             \
+  product(ccstr, PreloadClassList, NULL,                                    \
+          "Load and link the classes named in the specified file, in the "  \
+          "format written by DumpLoadedClassList, on background threads "   \
+          "during startup")                                                 \
+                                                                            \
+  product(uintx, PreloadClassThreads, 2,                                    \
+          "Number of threads used to load the classes in PreloadClassList") \
+                                                                            \
   product(bool, AllowParallelDefineClass, false,                            \
           "Allow parallel defineClass requests for class loaders "          \
           "registering as parallel capable")                                \
@@ -1177,6 +1244,24 @@ class CommandLineFlags {
                                                                             \
   product(bool, MonitorInUseLists, false, "Track Monitors for Deflation")   \
                                                                             \
+  product(bool, AsyncDeflateIdleMonitors, false,                            \
+          "Deflate idle monitors in the service thread instead of "         \
+          "at safepoints. Implies MonitorInUseLists")                       \
+                                                                            \
+  product(intx, AsyncDeflationInterval, 250,                                \
+          "Async deflate idle monitors every so many milliseconds when "    \
+          "MonitorUsedDeflationThreshold is exceeded (0 means check only "  \
+          "at safepoints)")                                                 \
+                                                                            \
+  product(intx, MonitorUsedDeflationThreshold, 90,                          \
+          "Percentage of used monitors before triggering async deflation "  \
+          "of idle monitors (0 is off). The check is performed every "      \
+          "AsyncDeflationInterval milliseconds")                            \
+                                                                            \
+  product(bool, AdaptiveMonitorSpinning, true,                              \
+          "Limit the number of threads spinning on a contended monitor "    \
+          "by the number of processors available to the process")           \
+                                                                            \
   product(intx, SyncFlags, 0, "(Unsafe, Unstable) Experimental Sync flags") \
                                                                             \
   product(intx, SyncVerbose, 0, "(Unstable)")                               \
@@ -1271,6 +1356,10 @@ class CommandLineFlags {
   product(bool, LazyBootClassLoader, true,                                  \
           "Enable/disable lazy opening of boot class path entries")         \
                                                                             \
+  product(bool, UseClassPathPackageIndex, true,                             \
+          "Skip boot class path jar files that contain no entry in the "    \
+          "package of the class being loaded")                              \
+                                                                            \
   product(bool, UseXMMForArrayCopy, false,                                  \
           "Use SSE2 MOVQ instruction for Arraycopy")                        \
                                                                             \
@@ -1281,6 +1370,12 @@ class CommandLineFlags {
   product(bool, CompactFields, true,                                        \
           "Allocate nonstatic fields in gaps between previous fields")      \
                                                                             \
+  experimental(bool, DenseFieldLayout, false,                               \
+          "Allocate nonstatic fields largest first into every alignment "   \
+          "gap of the object, including the gaps left by superclasses, "    \
+          "before appending them after the superclass fields. Not used "    \
+          "for classes with @Contended fields in their hierarchy")          \
+                                                                            \
   notproduct(bool, PrintFieldLayout, false,                                 \
           "Print field layout for each class")                              \
                                                                             \
@@ -1293,8 +1388,8 @@ class CommandLineFlags {
   product(bool, RestrictContended, true,                                    \
           "Restrict @Contended to trusted classes")                         \
                                                                             \
-  product(bool, UseBiasedLocking, true,                                     \
-          "Enable biased locking in JVM")                                   \
+  product(bool, UseBiasedLocking, false,                                    \
+          "(Deprecated) Enable biased locking in JVM")                      \
                                                                             \
   product(intx, BiasedLockingStartupDelay, 4000,                            \
           "Number of milliseconds to wait before enabling biased locking")  \
@@ -1483,6 +1578,15 @@ class CommandLineFlags {
           "Size of heap (bytes) per GC thread used in calculating the "     \
           "number of GC threads")                                           \
                                                                             \
+  product(uintx, CopiedBytesPerGCThread, 4*M,                               \
+          "With UseDynamicNumberOfGCThreads, bytes a young collection is "  \
+          "predicted to copy per active GC thread (0 = not used)")          \
+                                                                            \
+  product(uintx, CardsPerGCThread, 64*K,                                    \
+          "With UseDynamicNumberOfGCThreads, remembered set cards a young " \
+          "collection is predicted to process per active GC thread "        \
+          "(0 = not used)")                                                 \
+                                                                            \
   product(bool, TraceDynamicGCThreads, false,                               \
           "Trace the dynamic GC thread usage")                              \
                                                                             \
@@ -1583,6 +1687,10 @@ class CommandLineFlags {
   product(bool, ResizePLAB, true,                                           \
           "Dynamically resize (survivor space) promotion LAB's")            \
                                                                             \
+  product(bool, ResizePLABPerWorker, false,                                 \
+          "Resize each GC worker's promotion LAB's during a young "         \
+          "collection based on the space it has wasted so far")             \
+                                                                            \
   product(bool, PrintPLAB, false,                                           \
           "Print (survivor space) promotion LAB's sizing decisions")        \
                                                                             \
@@ -1619,6 +1727,12 @@ class CommandLineFlags {
           "Number of blocks to attempt to claim when refilling CMS LAB's "  \
           "for parallel GC")                                                \
                                                                             \
+  product(uintx, CMSLargeOldPLABSize, 16*K,                                 \
+          "Size (in words) of the per-thread buffer that medium sized "     \
+          "objects, too large for the indexed free lists but at most an "   \
+          "eighth of this size, are promoted into without taking the "      \
+          "dictionary lock (0 = promote them from the dictionary)")         \
+                                                                            \
   product(uintx, OldPLABWeight, 50,                                         \
           "Percentage (0-100) used to weight the current sample when "      \
           "computing exponentially decaying average for resizing "          \
@@ -1657,6 +1771,10 @@ class CommandLineFlags {
   product(bool, AlwaysPreTouch, false,                                      \
           "Force all freshly committed pages to be pre-touched")            \
                                                                             \
+  product(uintx, NonTemporalZeroingThreshold, 1*M,                          \
+          "Zero blocks of at least this many bytes with stores that "       \
+          "bypass the caches, where supported (x86_64). 0 disables them")   \
+                                                                            \
   product_pd(uintx, CMSYoungGenPerWorker,                                   \
           "The maximum size of young gen chosen by default per GC worker "  \
           "thread available")                                               \
@@ -1809,6 +1927,11 @@ class CommandLineFlags {
           "(Temporary, subject to experimentation) "                        \
           "Maximum time in abortable preclean (in milliseconds)")           \
                                                                             \
+  product(uintx, CMSPrecleanRemarkTargetMillis, 0,                          \
+          "If > 0, end abortable preclean as soon as the dirty cards left " \
+          "predict a remark card rescan shorter than this (in "             \
+          "milliseconds). CMSMaxAbortablePrecleanTime still bounds it")     \
+                                                                            \
   product(uintx, CMSAbortablePrecleanMinWorkPerIteration, 100,              \
           "(Temporary, subject to experimentation) "                        \
           "Nominal minimum work per abortable preclean iteration")          \
@@ -1845,6 +1968,11 @@ class CommandLineFlags {
           "Always record eden chunks used for the parallel initial mark "   \
           "or remark of eden")                                              \
                                                                             \
+  product(bool, CMSBalancedEdenChunks, false,                               \
+          "Record eden chunks at every TLAB boundary crossing a "           \
+          "CMSSamplingGrain step, without locking, and merge them into "    \
+          "evenly sized tasks for the parallel initial mark or remark")     \
+                                                                            \
   product(bool, CMSPrintEdenSurvivorChunks, false,                          \
           "Print the eden and the survivor chunks used for the parallel "   \
           "initial mark or remark of the eden/survivor spaces")             \
@@ -1968,6 +2096,11 @@ class CommandLineFlags {
   product(bool, ParallelRefProcEnabled, false,                              \
           "Enable parallel reference processing whenever possible")         \
                                                                             \
+  product(uintx, ReferencesPerThread, 1000,                                 \
+          "Ergonomically limit the number of reference queues, and so "     \
+          "of busy workers, used in parallel reference processing to one "  \
+          "per this many discovered references (0 = use all queues)")       \
+                                                                            \
   product(bool, ParallelRefProcBalancingEnabled, true,                      \
           "Enable balancing of reference processing queues")                \
                                                                             \
@@ -2036,6 +2169,10 @@ class CommandLineFlags {
   develop(uintx, PromotionFailureALotInterval, 5,                           \
           "Total collections between promotion failures alot")              \
                                                                             \
+  product(bool, UseOWSTTaskTerminator, true,                                \
+          "Terminate parallel work stealing with a single spinning thread " \
+          "that wakes the waiting ones only when enough work is visible")   \
+                                                                            \
   experimental(uintx, WorkStealingSleepMillis, 1,                           \
           "Sleep time when sleep is used for yields")                       \
                                                                             \
@@ -2075,11 +2212,35 @@ class CommandLineFlags {
   notproduct(bool, VerboseInternalVMTests, false,                           \
           "Turn on logging for internal VM tests.")                         \
                                                                             \
+  notproduct(bool, ExecuteInternalVMBenchmarks, false,                      \
+          "Run micro-benchmarks of internal VM data structures at startup") \
+                                                                            \
+  notproduct(ccstr, InternalVMBenchmarkFilter, NULL,                        \
+          "Only run the internal VM benchmarks whose name contains this "   \
+          "string")                                                         \
+                                                                            \
+  notproduct(uintx, InternalVMBenchmarkThreads, 0,                          \
+          "Number of threads running the internal VM benchmarks "           \
+          "(0 means the number of active processors)")                      \
+                                                                            \
+  notproduct(uintx, InternalVMBenchmarkBatches, 2000,                       \
+          "Number of timed batches each thread runs per internal VM "       \
+          "benchmark")                                                      \
+                                                                            \
   product_pd(bool, UseTLAB, "Use thread-local object allocation")           \
                                                                             \
   product_pd(bool, ResizeTLAB,                                              \
           "Dynamically resize TLAB size for threads")                       \
                                                                             \
+  product(bool, ElasticTLAB, false,                                         \
+          "Grow the TLAB of a thread that uses up its expected number of "  \
+          "refills before the next GC, up to the maximum TLAB size")        \
+                                                                            \
+  product(uintx, HeapSamplingInterval, 512*K,                               \
+          "Average number of bytes a thread allocates between two samples " \
+          "of the heap sampler (JVMTI SampledObjectAlloc and JFR "          \
+          "ObjectAllocationSample events)")                                 \
+                                                                            \
   product(bool, ZeroTLAB, false,                                            \
           "Zero out the newly created TLAB")                                \
                                                                             \
@@ -2531,6 +2692,13 @@ class CommandLineFlags {
           "GC log file size, requires UseGCLogFileRotation. "               \
           "Set to 0 to only trigger rotation via jcmd")                     \
                                                                             \
+  product(bool, UseAsyncGCLog, false,                                       \
+          "Write the -Xloggc file from a separate thread. Log output "      \
+          "that does not fit in the buffer is dropped and counted")         \
+                                                                            \
+  product(uintx, AsyncGCLogBufferSize, 2*M,                                 \
+          "Size in bytes of each of the two buffers used by UseAsyncGCLog") \
+                                                                            \
   /* JVMTI heap profiling */                                                \
                                                                             \
   diagnostic(bool, TraceJVMTIObjectTagging, false,                          \
@@ -2584,6 +2752,28 @@ class CommandLineFlags {
   product(intx, CICompilerCount, CI_COMPILER_COUNT,                         \
           "Number of compiler threads to run")                              \
                                                                             \
+  product(bool, UseDynamicNumberOfCompilerThreads, true,                    \
+          "Dynamically choose the number of parallel compiler threads, "    \
+          "starting more of them as the compile queues grow, up to "        \
+          "CICompilerCount")                                                \
+                                                                            \
+  diagnostic(bool, ReduceNumberOfCompilerThreads, true,                     \
+          "Reduce the number of parallel compiler threads when they are "   \
+          "not used")                                                       \
+                                                                            \
+  diagnostic(bool, TraceCompilerThreads, false,                             \
+          "Trace creation and removal of compiler threads")                 \
+                                                                            \
+  product(ccstr, DumpCompileDecisionFile, NULL,                             \
+          "At exit, write the methods that have been compiled at the "      \
+          "highest tier to this file, in the compile line format of "       \
+          "ReplayDataFile")                                                 \
+                                                                            \
+  product(ccstr, CompileDecisionFile, NULL,                                 \
+          "Compile the methods listed in this file (see "                   \
+          "DumpCompileDecisionFile) in the background as soon as their "    \
+          "classes are initialized")                                        \
+                                                                            \
   product(intx, CompilationPolicyChoice, 0,                                 \
           "which compilation policy (0/1)")                                 \
                                                                             \
@@ -2629,6 +2819,21 @@ class CommandLineFlags {
           "Print the break down of clean up tasks performed during "        \
           "safepoint")                                                      \
                                                                             \
+  product(intx, ParallelSafepointCleanupThreshold, 64,                      \
+          "Minimum number of Java threads for running the safepoint "       \
+          "cleanup tasks in parallel on the GC worker threads "             \
+          "(0 is off)")                                                     \
+                                                                            \
+  product(intx, SafepointHistorySize, 32,                                   \
+          "Number of recent safepoints whose time to safepoint, cleanup "   \
+          "and operation times are kept for the VM.safepoint_history "      \
+          "diagnostic command (0 is off)")                                  \
+                                                                            \
+  product(intx, SafepointStragglerCount, 3,                                 \
+          "Number of threads that were the last to reach a safepoint "      \
+          "whose time to safepoint and last Java frame are recorded "       \
+          "(at most 8)")                                                    \
+                                                                            \
   product(bool, Inline, true,                                               \
           "Enable inlining")                                                \
                                                                             \
@@ -3027,6 +3232,11 @@ class CommandLineFlags {
           "The maximum number of lines in the stack trace for Java "        \
           "exceptions (0 means all)")                                       \
                                                                             \
+  product(intx, BacktraceCacheSize, 8,                                      \
+          "Number of recent exception backtraces each thread keeps for "    \
+          "sharing with exceptions thrown from an identical stack "         \
+          "(0 disables the cache)")                                         \
+                                                                            \
   NOT_EMBEDDED(diagnostic(intx, GuaranteedSafepointInterval, 1000,          \
           "Guarantee a safepoint (at least) every so many milliseconds "    \
           "(0 means none)"))                                                \
@@ -3038,6 +3248,11 @@ class CommandLineFlags {
   product(intx, SafepointTimeoutDelay, 10000,                               \
           "Delay in milliseconds for option SafepointTimeout")              \
                                                                             \
+  product(uintx, VMOperationCoalescingBudget, 0,                            \
+          "Milliseconds a safepoint may spend running queued VM "           \
+          "operations coalesced into it before leaving the rest to the "    \
+          "next safepoint (0 means no limit)")                              \
+                                                                            \
   product(intx, NmethodSweepFraction, 16,                                   \
           "Number of invocations of sweeper to cover all nmethods")         \
                                                                             \
@@ -3171,7 +3386,7 @@ class CommandLineFlags {
           "If non-zero, maximum number of words that malloc/realloc can "   \
           "allocate (for testing only)")                                    \
                                                                             \
-  product(intx, TypeProfileWidth,     2,                                    \
+  product(intx, TypeProfileWidth,     4,                                    \
           "Number of receiver types to record in call/cast profile")        \
                                                                             \
   develop(intx, BciProfileWidth,      2,                                    \
@@ -3192,6 +3407,10 @@ class CommandLineFlags {
   product(intx, PerBytecodeTrapLimit,  4,                                   \
           "Limit on traps (of one kind) at a particular BCI")               \
                                                                             \
+  product(intx, PerBytecodeTrapLimitBackoff, 5,                             \
+          "Max doublings of PerBytecodeTrapLimit at a BCI which already "   \
+          "caused recompiles for the same reason (0 => no backoff)")        \
+                                                                            \
   experimental(intx, SpecTrapLimitExtraEntries,  3,                         \
           "Extra method data trap entries for speculation")                 \
                                                                             \
@@ -3303,6 +3522,20 @@ class CommandLineFlags {
   product(uintx, MaxMetaspaceExpansion, ScaleForWordSize(4*M),              \
           "The maximum expansion of Metaspace without full GC (in bytes)")  \
                                                                             \
+  product(bool, MetaspaceElasticChunks, true,                               \
+          "After class unloading merge adjacent free Metaspace chunks "     \
+          "into medium chunks, give the memory of free chunks back to "     \
+          "the OS, and size new chunks after a class loader's usage")       \
+                                                                            \
+  product(bool, UseMetaspaceAllocationBuffers, true,                        \
+          "Allocate the metadata of a class being parsed from a "           \
+          "thread-local buffer instead of locking the class loader's "      \
+          "metaspace for every allocation")                                 \
+                                                                            \
+  product(uintx, MetaspaceAllocationBufferSize, ScaleForWordSize(4*K),      \
+          "Size of the thread-local metaspace allocation buffer "           \
+          "(in bytes)")                                                     \
+                                                                            \
   product(uintx, QueuedAllocationWarningCount, 0,                           \
           "Number of times an allocation that queues behind a GC "          \
           "will retry before printing a warning")                           \
@@ -3367,6 +3600,10 @@ class CommandLineFlags {
   product(bool, PSChunkLargeArrays, true,                                   \
           "Process large arrays in chunks")                                 \
                                                                             \
+  product(bool, PSAdaptiveArrayScanChunk, true,                             \
+          "Scale the size of the chunks large arrays are scanned in by "    \
+          "the depth of the scanning thread's task queue")                  \
+                                                                            \
   product(uintx, GCDrainStackTargetSize, 64,                                \
           "Number of entries we will try to leave on the stack "            \
           "during parallel gc")                                             \
@@ -3426,6 +3663,31 @@ class CommandLineFlags {
   product_pd(uintx, ReservedCodeCacheSize,                                  \
           "Reserved code cache size (in bytes) - maximum code cache size")  \
                                                                             \
+  product(bool, SegmentedCodeCache, false,                                  \
+          "Divide the code cache into separate code heaps for non-method "  \
+          "code, profiled methods and non-profiled methods")                \
+                                                                            \
+  product(uintx, NonNMethodCodeHeapSize, 0,                                 \
+          "Size of the code heap for non-method code (in bytes) when "      \
+          "SegmentedCodeCache is on (0 means computed ergonomically)")      \
+                                                                            \
+  product(uintx, ProfiledCodeHeapSize, 0,                                   \
+          "Size of the code heap for profiled methods (in bytes) when "     \
+          "SegmentedCodeCache is on (0 means computed ergonomically)")      \
+                                                                            \
+  product(uintx, NonProfiledCodeHeapSize, 0,                                \
+          "Size of the code heap for non-profiled methods (in bytes) when " \
+          "SegmentedCodeCache is on (0 means computed ergonomically)")      \
+                                                                            \
+  product(uintx, HotCodeHeapSize, 0,                                        \
+          "Size of a code heap reserved for the fully optimized code of "   \
+          "hot methods (in bytes) when SegmentedCodeCache is on (0 means "  \
+          "no hot code heap)")                                              \
+                                                                            \
+  product(intx, HotCodeThreshold, 100000,                                   \
+          "Sum of invocation and backedge counts at compile time from "     \
+          "which the code of a method is placed in the hot code heap")      \
+                                                                            \
   product(uintx, CodeCacheMinimumFreeSpace, 500*K,                          \
           "When less than X space left, we stop compiling")                 \
                                                                             \
@@ -3641,6 +3903,11 @@ class CommandLineFlags {
   product(intx, Tier0InvokeNotifyFreqLog, 7,                                \
           "Interpreter (tier 0) invocation notification frequency")         \
                                                                             \
+  product(bool, UseStripedInvocationCounters, false,                        \
+          "Count invocations in the interpreter and at tier 2 in one of "   \
+          "several per-method stripes chosen by thread, folded into the "   \
+          "method's invocation counter when the policy is notified")        \
+                                                                            \
   product(intx, Tier2InvokeNotifyFreqLog, 11,                               \
           "C1 without MDO (tier 2) invocation notification frequency")      \
                                                                             \
@@ -3711,6 +3978,23 @@ class CommandLineFlags {
           "Tier 4 thresholds will increase twofold when C2 queue size "     \
           "reaches this amount per compiler thread")                        \
                                                                             \
+  product(bool, TieredCPULoadFeedback, true,                                \
+          "Double tier 4 thresholds while the CPUs available to the VM "    \
+          "are saturated and halve tier 3 and 4 thresholds while they "     \
+          "are idle")                                                       \
+                                                                            \
+  product(intx, TieredCPULoadSampleInterval, 200,                           \
+          "Interval in milliseconds between CPU load samples for "          \
+          "TieredCPULoadFeedback")                                          \
+                                                                            \
+  product(intx, TieredCPUSaturatedPercent, 90,                              \
+          "CPU load percentage at or above which TieredCPULoadFeedback "    \
+          "considers the CPUs saturated")                                   \
+                                                                            \
+  product(intx, TieredCPUIdlePercent, 25,                                   \
+          "CPU load percentage below which TieredCPULoadFeedback "          \
+          "considers the CPUs idle")                                        \
+                                                                            \
   product(intx, TieredCompileTaskTimeout, 50,                               \
           "Kill compile task if method was not used within "                \
           "given timeout in milliseconds")                                  \
@@ -3775,6 +4059,13 @@ class CommandLineFlags {
           "constructors generated for serialization, so can not be enabled "\
           "in product.")                                                    \
                                                                             \
+  product(intx, ReflectionInflationThreshold, -1,                           \
+          "Number of Method.invoke and Constructor.newInstance calls that " \
+          "go through the VM before a bytecode accessor class is "          \
+          "generated, passed on as sun.reflect.inflationThreshold. A "      \
+          "large value keeps Metaspace from growing with every reflected "  \
+          "method. Negative values keep the class library default")         \
+                                                                            \
   product(bool, ReflectionWrapResolutionErrors, true,                       \
           "Temporary flag for transition to AbstractMethodError wrapped "   \
           "in InvocationTargetException. See 6531596")                      \
@@ -3787,6 +4078,11 @@ class CommandLineFlags {
   product(uintx, MaxDirectMemorySize, 0,                                    \
           "Maximum total size of NIO direct-buffer allocations")            \
                                                                             \
+  product(bool, UseUnsafeMemoryArena, false,                                \
+          "Serve small Unsafe.allocateMemory requests, such as those of "   \
+          "direct buffers, from size classed free lists cached per "        \
+          "thread instead of malloc")                                       \
+                                                                            \
   /* temporary developer defined flags  */                                  \
                                                                             \
   diagnostic(bool, UseNewCode, false,                                       \
@@ -3855,6 +4151,10 @@ class CommandLineFlags {
   manageable(bool, PrintConcurrentLocks, false,                             \
           "Print java.util.concurrent locks in thread dump")                \
                                                                             \
+  manageable(bool, ProfileVMLocks, false,                                   \
+          "Count acquisitions, contended acquisitions and blocked time "    \
+          "of the VM's internal locks. See jcmd VM.lock_stats")             \
+                                                                            \
   product(bool, TransmitErrorReport, false,                                 \
           "Enable error report transmission on erroneous termination")      \
                                                                             \
@@ -3918,6 +4218,10 @@ class CommandLineFlags {
   diagnostic(bool, PrintMethodHandleStubs, false,                           \
           "Print generated stub code for method handles")                   \
                                                                             \
+  product(bool, CacheMethodHandleInvokers, true,                            \
+          "Cache the linkage of MethodHandle.invoke and invokeExact call "  \
+          "sites whose method type only uses system classes")               \
+                                                                            \
   develop(bool, TraceMethodHandles, false,                                  \
           "trace internal method handle operations")                        \
                                                                             \
@@ -3947,6 +4251,14 @@ class CommandLineFlags {
   diagnostic(bool, PauseAtExit, false,                                      \
           "Pause and wait for keypress on exit if a debugger is attached")  \
                                                                             \
+  product(bool, UsePerfMap, false,                                          \
+          "Keep /tmp/perf-<pid>.map up to date with the methods and stubs " \
+          "in the code cache, for perf and other native profilers")        \
+                                                                            \
+  product(intx, PerfMapFlushInterval, 1000,                                 \
+          "Milliseconds between writes of newly installed code to the "     \
+          "perf map")                                                       \
+                                                                            \
   product(bool, ExtendedDTraceProbes,    false,                             \
           "Enable performance-impacting dtrace probes")                     \
                                                                             \
@@ -3971,6 +4283,18 @@ class CommandLineFlags {
   experimental(uintx, SymbolTableSize, defaultSymbolTableSize,              \
           "Number of buckets in the JVM internal Symbol table")             \
                                                                             \
+  product(bool, ResizeSymbolAndStringTables, true,                          \
+          "Grow the symbol and string tables at a safepoint when their "    \
+          "average bucket length exceeds SymbolAndStringTableLoadFactor")   \
+                                                                            \
+  product(uintx, SymbolAndStringTableLoadFactor, 4,                         \
+          "Average number of entries per bucket above which the symbol "    \
+          "and string tables are grown")                                    \
+                                                                            \
+  product(bool, CompactStrings, false,                                      \
+          "Store Latin-1 strings with one byte per character when "         \
+          "java.lang.String has a coder field")                             \
+                                                                            \
   product(bool, UseStringDeduplication, false,                              \
           "Use string deduplication")                                       \
                                                                             \
@@ -3981,6 +4305,10 @@ class CommandLineFlags {
           "A string must reach this age (or be promoted to an old region) " \
           "to be considered for deduplication")                             \
                                                                             \
+  product(uintx, StringDeduplicationThreads, 1,                             \
+          "Number of threads used for concurrent string deduplication. "    \
+          "Limited to the number of parallel GC threads")                   \
+                                                                            \
   diagnostic(bool, StringDeduplicationResizeALot, false,                    \
           "Force table resize every time the table is scanned")             \
                                                                             \
@@ -4014,10 +4342,14 @@ class CommandLineFlags {
           "Dump the names all loaded classes, that could be stored into "   \
           "the CDS archive, in the specified file")                         \
                                                                             \
+  product(bool, DumpLoadedAppClasses, false,                                \
+          "Also write the classes defined by the system class loader to "   \
+          "DumpLoadedClassList, for use with PreloadClassList")             \
+                                                                            \
   product(ccstr, SharedClassListFile, NULL,                                 \
           "Override the default CDS class list")                            \
                                                                             \
-  diagnostic(ccstr, SharedArchiveFile, NULL,                                \
+  product(ccstr, SharedArchiveFile, NULL,                                   \
           "Override the default location of the CDS archive file")          \
                                                                             \
   product(ccstr, ExtraSharedClassListFile, NULL,                            \
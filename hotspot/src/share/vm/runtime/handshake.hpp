@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_RUNTIME_HANDSHAKE_HPP
+#define SHARE_VM_RUNTIME_HANDSHAKE_HPP
+
+#include "memory/allocation.hpp"
+
+class HandshakeOperation;
+class JavaThread;
+class Semaphore;
+class Thread;
+class ThreadClosure;
+
+// A handshake operation is a callback that is executed for each JavaThread
+// while that thread is in a safepoint safe state. The callback is executed
+// either by the thread itself or by the VM thread while keeping the thread
+// in a blocked state. A handshake can be performed with a single
+// JavaThread as well, in which case no other thread is stopped.
+//
+// Without ThreadLocalHandshakes the operation is executed at a safepoint.
+class Handshake : AllStatic {
+ public:
+  // Execution of handshake operation
+  static void execute(ThreadClosure* thread_cl);
+  // Returns false if the target thread is no longer alive
+  static bool execute(ThreadClosure* thread_cl, JavaThread* target);
+};
+
+// The HandshakeState keeps track of an ongoing handshake for one JavaThread.
+// The VM thread and the JavaThread are serialized with the semaphore making
+// sure the operation is only done by either the VM thread on behalf of the
+// JavaThread or by the JavaThread itself. The semaphore is held by pointer
+// so that thread.hpp does not pull in the shared Semaphore, which clashes
+// with the os-local ones in some os_<os>.cpp files.
+class HandshakeState VALUE_OBJ_CLASS_SPEC {
+  HandshakeOperation* volatile _operation;
+
+  Semaphore* _semaphore;
+  bool _thread_in_process_handshake;
+  Thread* volatile _active_handshaker;
+
+  void clear_handshake(JavaThread* thread);
+  void process_self_inner(JavaThread* thread);
+  bool vmthread_can_process_handshake(JavaThread* target);
+  bool claim_handshake_for_vmthread();
+
+ public:
+  HandshakeState();
+  ~HandshakeState();
+
+  void set_operation(JavaThread* thread, HandshakeOperation* op);
+
+  bool has_operation() const { return _operation != NULL; }
+
+  void cancel(JavaThread* thread);
+
+  void process_by_self(JavaThread* thread) {
+    if (!_thread_in_process_handshake) {
+      _thread_in_process_handshake = true;
+      process_self_inner(thread);
+      _thread_in_process_handshake = false;
+    }
+  }
+
+  void process_by_vmthread(JavaThread* target);
+
+  // The thread currently executing an operation on behalf of this thread
+  Thread* active_handshaker() const { return _active_handshaker; }
+};
+
+#endif // SHARE_VM_RUNTIME_HANDSHAKE_HPP
@@ -25,6 +25,7 @@
 #include "precompiled.hpp"
 #include "classfile/symbolTable.hpp"
 #include "code/icBuffer.hpp"
+#include "code/perfMap.hpp"
 #include "gc_interface/collectedHeap.hpp"
 #include "interpreter/bytecodes.hpp"
 #include "memory/universe.hpp"
@@ -98,6 +99,9 @@ jint init_globals() {
   bytecodes_init();
   classLoader_init();
   codeCache_init();
+  if (UsePerfMap) {
+    PerfMap::initialize(); // before any code is generated
+  }
   VM_Version_init();
   os_init_globals();
   stubRoutines_init1();
@@ -27,7 +27,9 @@
 #include "classfile/symbolTable.hpp"
 #include "classfile/systemDictionary.hpp"
 #include "code/codeCache.hpp"
+#include "code/perfMap.hpp"
 #include "compiler/compileBroker.hpp"
+#include "compiler/compileDecisionCache.hpp"
 #include "compiler/compilerOracle.hpp"
 #include "interpreter/bytecodeHistogram.hpp"
 #include "jfr/jfrEvents.hpp"
@@ -45,6 +47,7 @@
 #include "oops/symbol.hpp"
 #include "prims/jvmtiExport.hpp"
 #include "runtime/arguments.hpp"
+#include "runtime/asyncGCLogWriter.hpp"
 #include "runtime/biasedLocking.hpp"
 #include "runtime/compilationPolicy.hpp"
 #include "runtime/deoptimization.hpp"
@@ -273,7 +276,6 @@ void print_statistics() {
     nmethod::print_statistics();
     SharedRuntime::print_statistics();
 #endif //COMPILER1
-    os::print_statistics();
   }
 
   if (PrintLockStatistics || PrintPreciseBiasedLockingStatistics || PrintPreciseRTMLockingStatistics) {
@@ -373,6 +375,8 @@ void print_statistics() {
   if (PrintNMTStatistics) {
     MemTracker::final_report(tty);
   }
+
+  os::print_statistics();
 }
 
 #else // PRODUCT MODE STATISTICS
@@ -405,6 +409,8 @@ void print_statistics() {
   if (PrintNMTStatistics) {
     MemTracker::final_report(tty);
   }
+
+  os::print_statistics();
 }
 
 #endif
@@ -498,6 +504,9 @@ void before_exit(JavaThread * thread) {
   if (PeriodicTask::num_tasks() > 0)
     WatcherThread::stop();
 
+  // Write out the code installed since the last flush
+  PerfMap::flush();
+
   // Print statistics gathered (profiling ...)
   if (Arguments::has_profile()) {
     FlatProfiler::disengage();
@@ -524,6 +533,12 @@ void before_exit(JavaThread * thread) {
     BytecodeHistogram::print();
   }
 
+#if defined(COMPILER1) || defined(COMPILER2) || defined(SHARK)
+  if (DumpCompileDecisionFile != NULL) {
+    CompileDecisionCache::dump();
+  }
+#endif
+
   if (JvmtiExport::should_post_thread_life()) {
     JvmtiExport::post_thread_end(thread);
   }
@@ -549,6 +564,9 @@ void before_exit(JavaThread * thread) {
   print_statistics();
   Universe::heap()->print_tracing_info();
 
+  // Write out the buffered GC log; later output goes to the file directly.
+  AsyncGCLogWriter::stop();
+
   { MutexLocker ml(BeforeExit_lock);
     _before_exit_status = BEFORE_EXIT_DONE;
     BeforeExit_lock->notify_all();
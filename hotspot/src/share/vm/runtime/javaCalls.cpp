@@ -57,8 +57,18 @@ JavaCallWrapper::JavaCallWrapper(methodHandle callee_method, Handle receiver, Ja
   _result   = result;
 
   // Allocate handle block for Java code. This must be done before we change thread_state to _thread_in_Java_or_stub,
-  // since it can potentially block.
-  JNIHandleBlock* new_handles = JNIHandleBlock::allocate_block(thread);
+  // since it can potentially block. If the caller has no live local handles its block is
+  // reused instead; the callee's handles are dropped again on return.
+  JNIHandleBlock* new_handles = NULL;
+  _shared_handles = NULL;
+  _shared_capacity = 0;
+  if (LazyJNIHandleBlocks && thread->active_handles() != NULL &&
+      thread->active_handles()->is_unused()) {
+    _shared_handles = thread->active_handles();
+    _shared_capacity = _shared_handles->get_planned_capacity();
+  } else {
+    new_handles = JNIHandleBlock::allocate_block(thread);
+  }
 
   // After this, we are official in JavaCode. This needs to be done before we change any of the thread local
   // info, since we cannot find oops before the new information is set up completely.
@@ -84,7 +94,7 @@ JavaCallWrapper::JavaCallWrapper(methodHandle callee_method, Handle receiver, Ja
 #endif // CHECK_UNHANDLED_OOPS
 
   _thread       = (JavaThread *)thread;
-  _handles      = _thread->active_handles();    // save previous handle block & Java frame linkage
+  _handles      = _shared_handles == NULL ? _thread->active_handles() : NULL; // save previous handle block & Java frame linkage
 
   // For the profiler, the last_Java_frame information in thread must always be in
   // legal state. We have no last Java frame if last_Java_sp == NULL so
@@ -95,7 +105,11 @@ JavaCallWrapper::JavaCallWrapper(methodHandle callee_method, Handle receiver, Ja
   _thread->frame_anchor()->clear();
 
   debug_only(_thread->inc_java_call_counter());
-  _thread->set_active_handles(new_handles);     // install new handle block and reset Java frame linkage
+  if (_shared_handles == NULL) {
+    _thread->set_active_handles(new_handles);   // install new handle block and reset Java frame linkage
+  } else {
+    _shared_handles->set_planned_capacity(JNIHandleBlock::block_size_in_oops);
+  }
 
   assert (_thread->thread_state() != _thread_in_native, "cannot set native pc to NULL");
 
@@ -119,7 +133,26 @@ JavaCallWrapper::~JavaCallWrapper() {
 
   // restore previous handle block & Java frame linkage
   JNIHandleBlock *_old_handles = _thread->active_handles();
-  _thread->set_active_handles(_handles);
+  if (_shared_handles == NULL) {
+    _thread->set_active_handles(_handles);
+  } else {
+    // Drop the callee's handles. Blocks of local frames it pushed and never
+    // popped are chained to the shared block; unhook them so only they get
+    // released below.
+    if (_old_handles == _shared_handles) {
+      _old_handles = NULL;
+    } else {
+      JNIHandleBlock* frame = _old_handles;
+      while (frame->pop_frame_link() != _shared_handles) {
+        frame = frame->pop_frame_link();
+        assert(frame != NULL, "shared handle block must be on the pop frame chain");
+      }
+      frame->set_pop_frame_link(NULL);
+    }
+    _shared_handles->clear();
+    _shared_handles->set_planned_capacity(_shared_capacity);
+    _thread->set_active_handles(_shared_handles);
+  }
 
   _thread->frame_anchor()->zap();
 
@@ -143,13 +176,18 @@ JavaCallWrapper::~JavaCallWrapper() {
 
   // Release handles after we are marked as being inside the VM again, since this
   // operation might block
-  JNIHandleBlock::release_block(_old_handles, _thread);
+  if (_old_handles != NULL) {
+    JNIHandleBlock::release_block(_old_handles, _thread);
+  }
 }
 
 
 void JavaCallWrapper::oops_do(OopClosure* f) {
   f->do_oop((oop*)&_receiver);
-  handles()->oops_do(f);
+  // A shared block is the thread's active one and is visited through it.
+  if (handles() != NULL) {
+    handles()->oops_do(f);
+  }
 }
 
 
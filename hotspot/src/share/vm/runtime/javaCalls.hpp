@@ -58,7 +58,9 @@ class JavaCallWrapper: StackObj {
   friend class VMStructs;
  private:
   JavaThread*      _thread;                 // the thread to which this call belongs
-  JNIHandleBlock*  _handles;                // the saved handle block
+  JNIHandleBlock*  _handles;                // the saved handle block, NULL if shared with the call
+  JNIHandleBlock*  _shared_handles;         // the caller's unused block the call runs on, or NULL
+  size_t           _shared_capacity;        // planned capacity of _shared_handles to restore
   Method*          _callee_method;          // to be able to collect arguments if entry frame is top frame
   oop              _receiver;               // the receiver of the call (if a non-static call)
 
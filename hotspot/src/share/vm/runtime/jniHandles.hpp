@@ -118,6 +118,7 @@ class JNIHandles : AllStatic {
 class JNIHandleBlock : public CHeapObj<mtInternal> {
   friend class VMStructs;
   friend class CppInterpreter;
+  friend class JavaCallWrapper;
 
  private:
   enum SomeConstants {
@@ -165,6 +166,9 @@ class JNIHandleBlock : public CHeapObj<mtInternal> {
   static JNIHandleBlock* allocate_block(Thread* thread = NULL);
   static void release_block(JNIHandleBlock* block, Thread* thread = NULL);
 
+  // True if no handles are live in this block or in any frame pushed on it.
+  bool is_unused() const                          { return _top == 0 && _pop_frame_link == NULL; }
+
   // JNI PushLocalFrame/PopLocalFrame support
   JNIHandleBlock* pop_frame_link() const          { return _pop_frame_link; }
   void set_pop_frame_link(JNIHandleBlock* block)  { _pop_frame_link = block; }
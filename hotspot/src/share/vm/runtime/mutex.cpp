@@ -899,6 +899,22 @@ int Monitor::IWait (Thread * Self, jlong timo) {
 // sneaking or dependence on any any clever invariants or subtle implementation properties
 // of Mutex-Monitor and instead directly address the underlying design flaw.
 
+// Called by the new owner.  contended_start is the javaTimeNanos() at
+// which the fast path failed, or 0 if it succeeded.
+void Monitor::record_acquisition (jlong contended_start) {
+  _acquisitions++ ;
+  if (contended_start != 0) {
+    _contended_acquisitions++ ;
+    _blocked_nanos += os::javaTimeNanos() - contended_start ;
+  }
+}
+
+void Monitor::reset_statistics() {
+  _acquisitions = 0 ;
+  _contended_acquisitions = 0 ;
+  _blocked_nanos = 0 ;
+}
+
 void Monitor::lock (Thread * Self) {
 #ifdef CHECK_UNHANDLED_OOPS
   // Clear unhandled oops so we get a crash right away.  Only clear for non-vm
@@ -912,15 +928,18 @@ void Monitor::lock (Thread * Self) {
   assert (_owner != Self              , "invariant") ;
   assert (_OnDeck != Self->_MutexEvent, "invariant") ;
 
+  jlong contended_start = 0 ;
   if (TryFast()) {
  Exeunt:
     assert (ILocked(), "invariant") ;
     assert (owner() == NULL, "invariant");
     set_owner (Self);
+    if (ProfileVMLocks) record_acquisition (contended_start) ;
     return ;
   }
 
   // The lock is contended ...
+  if (ProfileVMLocks) contended_start = os::javaTimeNanos() ;
 
   bool can_sneak = Self->is_VM_thread() && SafepointSynchronize::is_at_safepoint();
   if (can_sneak && _owner == NULL) {
@@ -959,9 +978,14 @@ void Monitor::lock() {
 
 void Monitor::lock_without_safepoint_check (Thread * Self) {
   assert (_owner != Self, "invariant") ;
-  ILock (Self) ;
+  jlong contended_start = 0 ;
+  if (!TryFast()) {
+    if (ProfileVMLocks) contended_start = os::javaTimeNanos() ;
+    ILock (Self) ;
+  }
   assert (_owner == NULL, "invariant");
   set_owner (Self);
+  if (ProfileVMLocks) record_acquisition (contended_start) ;
 }
 
 void Monitor::lock_without_safepoint_check () {
@@ -991,6 +1015,7 @@ bool Monitor::try_lock() {
     // We got the lock
     assert (_owner == NULL, "invariant");
     set_owner (Self);
+    if (ProfileVMLocks) record_acquisition (0) ;
     return true;
   }
   return false;
@@ -1168,6 +1193,7 @@ void Monitor::ClearMonitor (Monitor * m, const char *name) {
   m->_OnDeck            = NULL ;
   m->_WaitSet           = NULL ;
   m->_WaitLock[0]       = 0 ;
+  m->reset_statistics() ;
 }
 
 Monitor::Monitor() { ClearMonitor(this); }
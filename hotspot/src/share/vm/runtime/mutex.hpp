@@ -129,6 +129,11 @@ class Monitor : public CHeapObj<mtInternal> {
   ParkEvent * volatile  _WaitSet ;       // LL of ParkEvents
   volatile bool     _snuck;              // Used for sneaky locking (evil).
   int NotifyCount ;                      // diagnostic assist
+  // Contention statistics, maintained under ProfileVMLocks.  Only the
+  // owner updates them, so plain increments suffice.
+  jlong _acquisitions ;                  // total number of acquisitions
+  jlong _contended_acquisitions ;        // acquisitions that missed the fast path
+  jlong _blocked_nanos ;                 // time spent acquiring when contended
   char _name[MONITOR_NAME_LEN];          // Name of mutex
 
   // Debugging fields for naming, deadlock detection, etc. (some only used in debug mode)
@@ -169,6 +174,7 @@ class Monitor : public CHeapObj<mtInternal> {
    void ILock (Thread * Self) ;
    int  IWait (Thread * Self, jlong timo);
    int  ILocked () ;
+   void record_acquisition (jlong contended_start) ;
 
  protected:
    static void ClearMonitor (Monitor * m, const char* name = NULL) ;
@@ -214,6 +220,11 @@ class Monitor : public CHeapObj<mtInternal> {
 
   void print_on_error(outputStream* st) const;
 
+  jlong acquisitions() const                 { return _acquisitions; }
+  jlong contended_acquisitions() const       { return _contended_acquisitions; }
+  jlong blocked_nanos() const                { return _blocked_nanos; }
+  void reset_statistics();
+
   #ifndef PRODUCT
     void print_on(outputStream* st) const;
     void print() const                      { print_on(tty); }
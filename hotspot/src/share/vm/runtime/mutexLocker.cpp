@@ -28,6 +28,7 @@
 #include "runtime/thread.inline.hpp"
 #include "runtime/threadLocalStorage.hpp"
 #include "runtime/vmThread.hpp"
+#include "utilities/quickSort.hpp"
 
 // Mutexes used in the VM (see comment in mutexLocker.hpp):
 //
@@ -57,6 +58,9 @@ Mutex*   AdapterHandlerLibrary_lock   = NULL;
 Mutex*   SignatureHandlerLibrary_lock = NULL;
 Mutex*   VtableStubs_lock             = NULL;
 Mutex*   SymbolTable_lock             = NULL;
+Mutex*   VerificationCache_lock       = NULL;
+Mutex*   UnsafeMemory_lock            = NULL;
+Mutex*   PerfMap_lock                 = NULL;
 Mutex*   StringTable_lock             = NULL;
 Monitor* StringDedupQueue_lock        = NULL;
 Mutex*   StringDedupTable_lock        = NULL;
@@ -89,6 +93,7 @@ Mutex*   Compile_lock                 = NULL;
 Monitor* MethodCompileQueue_lock      = NULL;
 Monitor* CompileThread_lock           = NULL;
 Mutex*   CompileTaskAlloc_lock        = NULL;
+Mutex*   CompileDecision_lock         = NULL;
 Mutex*   CompileStatistics_lock       = NULL;
 Mutex*   MultiArray_lock              = NULL;
 Monitor* Terminator_lock              = NULL;
@@ -100,6 +105,8 @@ Mutex*   ProfilePrint_lock            = NULL;
 Mutex*   ExceptionCache_lock          = NULL;
 Monitor* ObjAllocPost_lock            = NULL;
 Mutex*   OsrList_lock                 = NULL;
+Monitor* AsyncGCLog_lock              = NULL;
+Mutex*   SafepointHistory_lock        = NULL;
 #ifndef PRODUCT
 Mutex*   FullGCALot_lock              = NULL;
 #endif
@@ -232,10 +239,15 @@ void mutex_init() {
   def(JNIHandleBlockFreeList_lock  , Mutex  , leaf,        true ); // handles are used by VM thread
   def(SignatureHandlerLibrary_lock , Mutex  , leaf,        false);
   def(SymbolTable_lock             , Mutex  , leaf+2,      true );
+  def(VerificationCache_lock       , Mutex  , leaf,        true );
+  def(UnsafeMemory_lock            , Mutex  , leaf,        true );
+  def(PerfMap_lock                 , Mutex  , leaf,        true );
   def(StringTable_lock             , Mutex  , leaf,        true );
   def(ProfilePrint_lock            , Mutex  , leaf,        false); // serial profile printing
   def(ExceptionCache_lock          , Mutex  , leaf,        false); // serial profile printing
   def(OsrList_lock                 , Mutex  , leaf,        true );
+  def(SafepointHistory_lock        , Mutex  , leaf,        true ); // taken by the VM thread at safepoints
+  def(AsyncGCLog_lock              , Monitor, leaf+1,      true ); // locks the GCLogFile lock
   def(Debug1_lock                  , Mutex  , leaf,        true );
 #ifndef PRODUCT
   def(FullGCALot_lock              , Mutex  , leaf,        false); // a lock to make FullGCALot MT safe
@@ -271,6 +283,7 @@ void mutex_init() {
 
   def(CompiledIC_lock              , Mutex  , nonleaf+2,   false); // locks VtableStubs_lock, InlineCacheBuffer_lock
   def(CompileTaskAlloc_lock        , Mutex  , nonleaf+2,   true );
+  def(CompileDecision_lock         , Mutex  , leaf,        true );
   def(CompileStatistics_lock       , Mutex  , nonleaf+2,   false);
   def(MultiArray_lock              , Mutex  , nonleaf+2,   false); // locks SymbolTable_lock
 
@@ -335,3 +348,43 @@ void print_owned_locks_on_error(outputStream* st) {
   }
   if (none) st->print_cr("None");
 }
+
+static int compare_blocked_nanos(Monitor* const& a, Monitor* const& b) {
+  if (a->blocked_nanos() != b->blocked_nanos()) {
+    return a->blocked_nanos() > b->blocked_nanos() ? -1 : 1;
+  }
+  if (a->contended_acquisitions() != b->contended_acquisitions()) {
+    return a->contended_acquisitions() > b->contended_acquisitions() ? -1 : 1;
+  }
+  return 0;
+}
+
+void print_lock_statistics(outputStream* st, bool reset) {
+  if (!ProfileVMLocks) {
+    st->print_cr("Lock statistics are not collected, enable them with "
+                 "-XX:+ProfileVMLocks or jcmd VM.set_flag ProfileVMLocks true");
+  }
+  // The counters are read racily; a snapshot is good enough for profiling.
+  Monitor* sorted[MAX_NUM_MUTEX];
+  for (int i = 0; i < _num_mutex; i++) {
+    sorted[i] = _mutex_array[i];
+  }
+  QuickSort::sort<Monitor*>(sorted, _num_mutex, compare_blocked_nanos, false);
+
+  st->print_cr("%-32s %14s %14s %14s %12s", "Lock", "Acquired", "Contended",
+               "Blocked (ms)", "Avg (us)");
+  for (int i = 0; i < _num_mutex; i++) {
+    Monitor* m = sorted[i];
+    jlong acquired  = m->acquisitions();
+    jlong contended = m->contended_acquisitions();
+    jlong blocked   = m->blocked_nanos();
+    if (acquired == 0) continue;
+    st->print_cr("%-32s " INT64_FORMAT_W(14) " " INT64_FORMAT_W(14) " %14.3f %12.3f",
+                 m->name(), acquired, contended,
+                 (double)blocked / NANOSECS_PER_MILLISEC,
+                 contended == 0 ? 0.0 : (double)blocked / contended / 1000.0);
+    if (reset) {
+      m->reset_statistics();
+    }
+  }
+}
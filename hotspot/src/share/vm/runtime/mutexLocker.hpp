@@ -65,6 +65,9 @@ extern Mutex*   AdapterHandlerLibrary_lock;      // a lock on the AdapterHandler
 extern Mutex*   SignatureHandlerLibrary_lock;    // a lock on the SignatureHandlerLibrary
 extern Mutex*   VtableStubs_lock;                // a lock on the VtableStubs
 extern Mutex*   SymbolTable_lock;                // a lock on the symbol table
+extern Mutex*   VerificationCache_lock;          // a lock on the verification cache
+extern Mutex*   UnsafeMemory_lock;               // a lock on the global free lists of UnsafeMemory
+extern Mutex*   PerfMap_lock;                    // a lock on the perf map buffer and file
 extern Mutex*   StringTable_lock;                // a lock on the interned string table
 extern Monitor* StringDedupQueue_lock;           // a lock on the string deduplication queue
 extern Mutex*   StringDedupTable_lock;           // a lock on the string deduplication table
@@ -108,6 +111,7 @@ extern Mutex*   Compile_lock;                    // a lock held when Compilation
 extern Monitor* MethodCompileQueue_lock;         // a lock held when method compilations are enqueued, dequeued
 extern Monitor* CompileThread_lock;              // a lock held by compile threads during compilation system initialization
 extern Mutex*   CompileTaskAlloc_lock;           // a lock held when CompileTasks are allocated
+extern Mutex*   CompileDecision_lock;            // a lock held when looking up recorded compile decisions
 extern Mutex*   CompileStatistics_lock;          // a lock held when updating compilation statistics
 extern Mutex*   MultiArray_lock;                 // a lock used to guard allocation of multi-dim arrays
 extern Monitor* Terminator_lock;                 // a lock used to guard termination of the vm
@@ -118,6 +122,8 @@ extern Monitor* ProfileVM_lock;                  // a lock used for profiling th
 extern Mutex*   ProfilePrint_lock;               // a lock used to serialize the printing of profiles
 extern Mutex*   ExceptionCache_lock;             // a lock used to synchronize exception cache updates
 extern Mutex*   OsrList_lock;                    // a lock used to serialize access to OSR queues
+extern Monitor* AsyncGCLog_lock;                 // held while the buffered GC log is written out
+extern Mutex*   SafepointHistory_lock;           // protects the ring buffer of recent safepoint records
 
 #ifndef PRODUCT
 extern Mutex*   FullGCALot_lock;                 // a lock to make FullGCALot MT safe
@@ -179,6 +185,10 @@ extern Mutex*   UnsafeJlong_lock;                // provides Unsafe atomic updat
 // by fatal error handler.
 void print_owned_locks_on_error(outputStream* st);
 
+// Print the ProfileVMLocks statistics of the VM's global locks, most
+// blocked time first, and optionally reset them afterwards.
+void print_lock_statistics(outputStream* st, bool reset);
+
 char *lock_name(Mutex *mutex);
 
 class MutexLocker: StackObj {
@@ -184,7 +184,28 @@ static int Knob_MoveNotifyee       = 2 ;       // notify() - disposition of noti
 static int Knob_QMode              = 0 ;       // EntryList-cxq policy - queue discipline
 static volatile int InitDone       = 0 ;
 
-#define TrySpin TrySpin_VaryDuration
+#define TrySpin TrySpin_Profiled
+
+// With AdaptiveMonitorSpinning the number of concurrent spinners is
+// bounded by the processors available to the process, which may be far
+// fewer than the processors in the machine when running in a container.
+// os::active_processor_count() reads the container limits, so the value
+// is cached and only refreshed every SpinCPUsRefreshMillis.
+static const jlong  SpinCPUsRefreshMillis = 20 ;
+static volatile int   SpinCPUs            = 0 ;
+static volatile jlong SpinCPUsStamp       = 0 ;
+
+static int available_spin_cpus() {
+  const jlong now = os::javaTimeMillis() ;
+  int cpus = SpinCPUs ;
+  if (cpus == 0 || now - SpinCPUsStamp > SpinCPUsRefreshMillis) {
+    // Racy, but benign: concurrent refreshes store equivalent values.
+    cpus = os::active_processor_count() ;
+    SpinCPUs = cpus ;
+    SpinCPUsStamp = now ;
+  }
+  return cpus ;
+}
 
 // -----------------------------------------------------------------------------
 // Theory of operations -- Monitors lists, thread residency, etc:
@@ -318,7 +339,7 @@ bool ObjectMonitor::try_enter(Thread* THREAD) {
   }
 }
 
-void ATTR ObjectMonitor::enter(TRAPS) {
+bool ATTR ObjectMonitor::enter(TRAPS) {
   // The following code is ordered to check the most common cases first
   // and to reduce RTS->RTO cache line upgrades on SPARC and IA32 processors.
   Thread * const Self = THREAD ;
@@ -330,13 +351,13 @@ void ATTR ObjectMonitor::enter(TRAPS) {
      assert (_recursions == 0   , "invariant") ;
      assert (_owner      == Self, "invariant") ;
      // CONSIDER: set or assert OwnerIsThread == 1
-     return ;
+     return true ;
   }
 
   if (cur == Self) {
      // TODO-FIXME: check for integer overflow!  BUGID 6557169.
      _recursions ++ ;
-     return ;
+     return true ;
   }
 
   if (Self->is_lock_owned ((address)cur)) {
@@ -346,12 +367,13 @@ void ATTR ObjectMonitor::enter(TRAPS) {
     // a full-fledged "Thread *".
     _owner = Self ;
     OwnerIsThread = 1 ;
-    return ;
+    return true ;
   }
 
   // We've encountered genuine contention.
   assert (Self->_Stalled == 0, "invariant") ;
   Self->_Stalled = intptr_t(this) ;
+  _contended_enters ++ ;
 
   // Try one round of spinning *before* enqueueing Self
   // and before going through the awkward and expensive state
@@ -363,7 +385,8 @@ void ATTR ObjectMonitor::enter(TRAPS) {
      assert (_recursions == 0    , "invariant") ;
      assert (((oop)(object()))->mark() == markOopDesc::encode(this), "invariant") ;
      Self->_Stalled = 0 ;
-     return ;
+     _acquired_nanos = os::javaTimeNanos() ;
+     return true ;
   }
 
   assert (_owner != Self          , "invariant") ;
@@ -372,13 +395,27 @@ void ATTR ObjectMonitor::enter(TRAPS) {
   JavaThread * jt = (JavaThread *) Self ;
   assert (!SafepointSynchronize::is_at_safepoint(), "invariant") ;
   assert (jt->thread_state() != _thread_blocked   , "invariant") ;
-  assert (this->object() != NULL  , "invariant") ;
-  assert (_count >= 0, "invariant") ;
 
   // Prevent deflation at STW-time.  See deflate_idle_monitors() and is_busy().
   // Ensure the object-monitor relationship remains stable while there's contention.
   Atomic::inc_ptr(&_count);
 
+  if (is_being_async_deflated()) {
+    // The async deflater won the race for this monitor, so it cannot be
+    // entered any more.  Help restore the object's header in case the
+    // deflater has not done so yet and let the caller re-inflate.
+    Atomic::dec_ptr(&_count);
+    Self->_Stalled = 0 ;
+    const oop obj = (oop) object();
+    if (obj != NULL) {
+      install_displaced_markword_in_object(obj);
+    }
+    return false ;
+  }
+
+  assert (this->object() != NULL  , "invariant") ;
+  assert (_count > 0, "invariant") ;
+
   JFR_ONLY(JfrConditionalFlushWithStacktrace<EventJavaMonitorEnter> flush(jt);)
   EventJavaMonitorEnter event;
   if (event.should_commit()) {
@@ -386,6 +423,8 @@ void ATTR ObjectMonitor::enter(TRAPS) {
     event.set_address((uintptr_t)(this->object_addr()));
   }
 
+  const jlong blocked_start = os::javaTimeNanos() ;
+
   { // Change java thread status to indicate blocked on monitor enter.
     JavaThreadBlockedOnMonitorEnterState jtbmes(jt, this);
 
@@ -449,6 +488,11 @@ void ATTR ObjectMonitor::enter(TRAPS) {
   assert (_succ  != Self       , "invariant") ;
   assert (((oop)(object()))->mark() == markOopDesc::encode(this), "invariant") ;
 
+  // Only the owner updates the blocking part of the profile.
+  _acquired_nanos = os::javaTimeNanos() ;
+  _blocked_nanos += _acquired_nanos - blocked_start ;
+  _blocked_enters ++ ;
+
   // The thread -- now the owner -- is back in vm mode.
   // Report the glorious news via TI,DTrace and jvmstat.
   // The probe effect is non-trivial.  All the reportage occurs
@@ -474,12 +518,33 @@ void ATTR ObjectMonitor::enter(TRAPS) {
 
   if (event.should_commit()) {
     event.set_previousOwner((uintptr_t)_previous_owner_tid);
+    const int attempts = _spin_attempts ;
+    event.set_contendedEnters((unsigned)_contended_enters);
+    event.set_spinSuccessRate(attempts > 0 ? (float)_spin_acquires / attempts : 0.0f);
+    event.set_averageWaitTime(_blocked_nanos / _blocked_enters);
+    event.set_averageHoldTime(_hold_samples > 0 ? _hold_nanos / _hold_samples : 0);
     event.commit();
   }
 
   if (ObjectMonitor::_sync_ContendedLockAttempts != NULL) {
      ObjectMonitor::_sync_ContendedLockAttempts->inc() ;
   }
+  return true ;
+}
+
+// The object refers to this monitor and the monitor has been claimed by
+// the async deflater: swing the object's mark back to the displaced
+// header.  Both the deflater and any thread that loses a race against it
+// may do this; only the first CAS succeeds.
+void ObjectMonitor::install_displaced_markword_in_object(const oop obj) {
+  assert(AsyncDeflateIdleMonitors, "sanity");
+  markOop dmw = header();
+  assert(dmw != NULL && dmw->is_neutral(),
+         err_msg("must have a neutral displaced header: " INTPTR_FORMAT, p2i(dmw)));
+  markOop mark = obj->mark();
+  if (mark == markOopDesc::encode(this)) {
+    obj->cas_set_mark(dmw, mark);
+  }
 }
 
 
@@ -505,13 +570,33 @@ int ObjectMonitor::TryLock (Thread * Self) {
    }
 }
 
+// TryLock() for a thread that keeps the monitor from being deflated,
+// i.e. a contender holding a _count reference or a reentering waiter.
+// If the async deflater has claimed the owner field it is bound to back
+// out, so the caller may take the monitor over from the deflater.  The
+// deflater notices the failed owner restore and drops the extra
+// contention count added here on its behalf.
+
+int ObjectMonitor::TryLockContended (Thread * Self) {
+   int status = TryLock (Self) ;
+   if (status == 0 && AsyncDeflateIdleMonitors && _owner == DEFLATER_MARKER) {
+      if (Atomic::cmpxchg_ptr (Self, &_owner, DEFLATER_MARKER) == DEFLATER_MARKER) {
+         assert (_recursions == 0, "invariant") ;
+         Atomic::inc_ptr(&_count) ;
+         return 1 ;
+      }
+      return -1 ;
+   }
+   return status ;
+}
+
 void ATTR ObjectMonitor::EnterI (TRAPS) {
     Thread * Self = THREAD ;
     assert (Self->is_Java_thread(), "invariant") ;
     assert (((JavaThread *) Self)->thread_state() == _thread_blocked   , "invariant") ;
 
     // Try the lock - TATAS
-    if (TryLock (Self) > 0) {
+    if (TryLockContended (Self) > 0) {
         assert (_succ != Self              , "invariant") ;
         assert (_owner == Self             , "invariant") ;
         assert (_Responsible != Self       , "invariant") ;
@@ -619,7 +704,7 @@ void ATTR ObjectMonitor::EnterI (TRAPS) {
 
     for (;;) {
 
-        if (TryLock (Self) > 0) break ;
+        if (TryLockContended (Self) > 0) break ;
         assert (_owner != Self, "invariant") ;
 
         if ((SyncFlags & 2) && _Responsible == NULL) {
@@ -638,7 +723,7 @@ void ATTR ObjectMonitor::EnterI (TRAPS) {
             Self->_ParkEvent->park() ;
         }
 
-        if (TryLock(Self) > 0) break ;
+        if (TryLockContended (Self) > 0) break ;
 
         // The lock is still contested.
         // Keep a tally of the # of futile wakeups.
@@ -769,7 +854,7 @@ void ATTR ObjectMonitor::ReenterI (Thread * Self, ObjectWaiter * SelfNode) {
         guarantee (v == ObjectWaiter::TS_ENTER || v == ObjectWaiter::TS_CXQ, "invariant") ;
         assert    (_owner != Self, "invariant") ;
 
-        if (TryLock (Self) > 0) break ;
+        if (TryLockContended (Self) > 0) break ;
         if (TrySpin (Self) > 0) break ;
 
         TEVENT (Wait Reentry - parking) ;
@@ -802,7 +887,7 @@ void ATTR ObjectMonitor::ReenterI (Thread * Self, ObjectWaiter * SelfNode) {
         // Try again, but just so we distinguish between futile wakeups and
         // successful wakeups.  The following test isn't algorithmically
         // necessary, but it helps us maintain sensible statistics.
-        if (TryLock(Self) > 0) break ;
+        if (TryLockContended (Self) > 0) break ;
 
         // The lock is still contested.
         // Keep a tally of the # of futile wakeups.
@@ -990,6 +1075,13 @@ void ATTR ObjectMonitor::exit(bool not_suspended, TRAPS) {
      return ;
    }
 
+   if (_acquired_nanos != 0) {
+     // Sample the hold time of a contended acquisition.
+     _hold_nanos += os::javaTimeNanos() - _acquired_nanos ;
+     _hold_samples ++ ;
+     _acquired_nanos = 0 ;
+   }
+
    // Invariant: after setting Responsible=null an thread must execute
    // a MEMBAR or other serializing instruction before fetching EntryList|cxq.
    if ((SyncFlags & 4) == 0) {
@@ -1400,16 +1492,19 @@ intptr_t ObjectMonitor::complete_exit(TRAPS) {
 
 // reenter() enters a lock and sets recursion count
 // complete_exit/reenter operate as a wait without waiting
-void ObjectMonitor::reenter(intptr_t recursions, TRAPS) {
+bool ObjectMonitor::reenter(intptr_t recursions, TRAPS) {
    Thread * const Self = THREAD;
    assert(Self->is_Java_thread(), "Must be Java thread!");
    JavaThread *jt = (JavaThread *)THREAD;
 
    guarantee(_owner != Self, "reenter already owner");
-   enter (THREAD);       // enter the monitor
+   if (!enter (THREAD)) {  // enter the monitor
+     // Deflated concurrently; the caller has to re-inflate and retry.
+     return false;
+   }
    guarantee (_recursions == 0, "reenter recursion");
    _recursions = recursions;
-   return;
+   return true;
 }
 
 
@@ -2018,6 +2113,16 @@ int (*ObjectMonitor::SpinCallbackFunction)(intptr_t, int) = NULL ;
 // Spinning: Fixed frequency (100%), vary duration
 
 
+// Counts spin attempts and successes for the contention profile.
+int ObjectMonitor::TrySpin_Profiled (Thread * Self) {
+    _spin_attempts ++ ;
+    const int acquired = TrySpin_VaryDuration (Self) ;
+    if (acquired > 0) {
+       _spin_acquires ++ ;
+    }
+    return acquired ;
+}
+
 int ObjectMonitor::TrySpin_VaryDuration (Thread * Self) {
 
     // Dumb, brutal spin.  Good for comparative measurements against adaptive spinning.
@@ -2070,6 +2175,15 @@ int ObjectMonitor::TrySpin_VaryDuration (Thread * Self) {
     }
 
     int MaxSpin = Knob_MaxSpinners ;
+    if (MaxSpin < 0 && AdaptiveMonitorSpinning) {
+       // Keep one processor for the owner.  Spinning is futile if
+       // the owner can't run concurrently with this thread.
+       MaxSpin = available_spin_cpus() - 2 ;
+       if (MaxSpin < 0) {
+          TEVENT (Spin abort -- no spare processors) ;
+          return 0 ;
+       }
+    }
     if (MaxSpin >= 0) {
        if (_Spinner > MaxSpin) {
           TEVENT (Spin abort -- too many spinners) ;
@@ -2164,7 +2278,7 @@ int ObjectMonitor::TrySpin_VaryDuration (Thread * Self) {
             if (sss && _succ == Self) {
                _succ = NULL ;
             }
-            if (MaxSpin > 0) Adjust (&_Spinner, -1) ;
+            if (MaxSpin >= 0) Adjust (&_Spinner, -1) ;
 
             // Increase _SpinDuration :
             // The spin was successful (profitable) so we tend toward
@@ -70,6 +70,12 @@ class ObjectWaiter : public StackObj {
 
 // It is also used as RawMonitor by the JVMTI
 
+// When -XX:+AsyncDeflateIdleMonitors is in effect, the service thread
+// deflates idle monitors while Java threads keep running.  It claims a
+// monitor by installing DEFLATER_MARKER as the owner and then by driving
+// _count negative; a monitor whose _count is negative is being (or has
+// been) deflated and must not be entered.  See deflate_monitor_using_JT().
+#define DEFLATER_MARKER reinterpret_cast<void*>(-1)
 
 class ObjectMonitor {
  public:
@@ -115,6 +121,12 @@ class ObjectMonitor {
     return _count|_waiters|intptr_t(_owner)|intptr_t(_cxq)|intptr_t(_EntryList ) ;
   }
 
+  // True once an async deflater has won the race for this monitor.
+  bool      is_being_async_deflated() const;
+  // Restore the object's mark from this monitor's displaced header if
+  // the object still refers to this monitor.
+  void      install_displaced_markword_in_object(const oop obj);
+
   intptr_t  is_entered(Thread* current) const;
 
   void*     owner() const;
@@ -152,6 +164,7 @@ class ObjectMonitor {
     _SpinClock    = 0 ;
     OwnerIsThread = 0 ;
     _previous_owner_tid = 0;
+    clear_contention_profile();
   }
 
   ~ObjectMonitor() {
@@ -175,6 +188,18 @@ private:
     _SpinFreq      = 0 ;
     _SpinClock     = 0 ;
     OwnerIsThread  = 0 ;
+    clear_contention_profile();
+  }
+
+  void clear_contention_profile() {
+    _contended_enters  = 0 ;
+    _blocked_enters    = 0 ;
+    _spin_attempts     = 0 ;
+    _spin_acquires     = 0 ;
+    _blocked_nanos     = 0 ;
+    _acquired_nanos    = 0 ;
+    _hold_nanos        = 0 ;
+    _hold_samples      = 0 ;
   }
 
 public:
@@ -186,6 +211,7 @@ public:
   bool      check(TRAPS);       // true if the thread owns the monitor.
   void      check_slow(TRAPS);
   void      clear();
+  void      clear_using_JT();
   static void sanity_checks();  // public for -XX:+ExecuteInternalVMTests
                                 // in PRODUCT for -XX:SyncKnobs=Verbose=1
 #ifndef PRODUCT
@@ -194,7 +220,9 @@ public:
 #endif
 
   bool      try_enter (TRAPS) ;
-  void      enter(TRAPS);
+  // Returns false if the monitor was deflated concurrently; the caller
+  // must then re-inflate the object and try again.
+  bool      enter(TRAPS);
   void      exit(bool not_suspended, TRAPS);
   void      wait(jlong millis, bool interruptable, TRAPS);
   void      notify(TRAPS);
@@ -202,7 +230,7 @@ public:
 
 // Use the following at your own risk
   intptr_t  complete_exit(TRAPS);
-  void      reenter(intptr_t recursions, TRAPS);
+  bool      reenter(intptr_t recursions, TRAPS);
 
  private:
   void      AddWaiter (ObjectWaiter * waiter) ;
@@ -214,10 +242,12 @@ public:
   void      ReenterI (Thread * Self, ObjectWaiter * SelfNode) ;
   void      UnlinkAfterAcquire (Thread * Self, ObjectWaiter * SelfNode) ;
   int       TryLock (Thread * Self) ;
+  int       TryLockContended (Thread * Self) ;
   int       NotRunnable (Thread * Self, Thread * Owner) ;
   int       TrySpin_Fixed (Thread * Self) ;
   int       TrySpin_VaryFrequency (Thread * Self) ;
   int       TrySpin_VaryDuration  (Thread * Self) ;
+  int       TrySpin_Profiled (Thread * Self) ;
   void      ctAsserts () ;
   void      ExitEpilog (Thread * Self, ObjectWaiter * Wakee) ;
   bool      ExitSuspendEquivalent (JavaThread * Self) ;
@@ -261,6 +291,19 @@ public:
   volatile int _SpinDuration ;
   volatile intptr_t _SpinState ;    // MCS/CLH list of spinners
 
+  // Contention profile, reported with the JavaMonitorEnter event.
+  // Only the contended paths update it.  The counters bumped by
+  // threads that don't own the monitor are updated without atomics
+  // and may lose increments; they are statistics, not invariants.
+  volatile int   _contended_enters ; // enters that found the monitor owned
+  volatile int   _blocked_enters ;   // contended enters that had to block
+  volatile int   _spin_attempts ;
+  volatile int   _spin_acquires ;    // spins that acquired the monitor
+  volatile jlong _blocked_nanos ;    // time spent blocked in enter()
+  jlong          _acquired_nanos ;   // owner: when a contended enter acquired the monitor, 0 otherwise
+  jlong          _hold_nanos ;       // owner: time held after contended enters
+  int            _hold_samples ;
+
   // TODO-FIXME: _count, _waiters and _recursions should be of
   // type int, or int32_t but not intptr_t.  There's no reason
   // to use 64-bit fields for these variables on a 64-bit JVM.
@@ -68,6 +68,23 @@ inline void ObjectMonitor::clear() {
   _object = NULL;
 }
 
+// Used by the async deflater.  _header is left in place so that a racing
+// FastHashCode() or enter() can still restore the object's mark, and
+// _owner and _count keep their deflation values until the monitor is
+// handed out again by omAlloc().
+inline void ObjectMonitor::clear_using_JT() {
+  assert(_owner == DEFLATER_MARKER, "Fatal logic error in ObjectMonitor owner!");
+  assert(_count < 0, "Fatal logic error in ObjectMonitor count!");
+  assert(_waiters == 0, "Fatal logic error in ObjectMonitor waiters!");
+  assert(_recursions == 0, "Fatal logic error in ObjectMonitor recursions!");
+
+  _object = NULL;
+}
+
+inline bool ObjectMonitor::is_being_async_deflated() const {
+  return AsyncDeflateIdleMonitors && _count < 0;
+}
+
 
 inline void* ObjectMonitor::object() const {
   return _object;
@@ -115,6 +115,7 @@ class os: AllStatic {
  private:
   static OSThread*          _starting_thread;
   static address            _polling_page;
+  static address            _armed_polling_page;
   static volatile int32_t * _mem_serialize_page;
   static uintptr_t          _serialize_page_mask;
  public:
@@ -397,7 +398,14 @@ class os: AllStatic {
   // OS interface to polling page
   static address get_polling_page()             { return _polling_page; }
   static void    set_polling_page(address page) { _polling_page = page; }
-  static bool    is_poll_address(address addr)  { return addr >= _polling_page && addr < (_polling_page + os::vm_page_size()); }
+  static bool    is_poll_address(address addr)  {
+    return (addr >= _polling_page && addr < (_polling_page + os::vm_page_size())) ||
+           (_armed_polling_page != NULL &&
+            addr >= _armed_polling_page && addr < (_armed_polling_page + os::vm_page_size()));
+  }
+  // Always protected page read by a thread armed for a handshake, see SafepointMechanism
+  static address get_armed_polling_page()       { return _armed_polling_page; }
+  static void    set_armed_polling_page(address page) { _armed_polling_page = page; }
   static void    make_polling_page_unreadable();
   static void    make_polling_page_readable();
 
@@ -963,6 +971,16 @@ class os: AllStatic {
     bool _done;
   };
 
+  // Per-thread CPU time timers. Once init_thread_cpu_timers() has installed
+  // a handler, a thread with a timer is interrupted by a signal each time it
+  // has used interval_nanos of CPU time, and the handler is called on that
+  // thread in signal context. Not supported everywhere, in which case
+  // init_thread_cpu_timers() returns false.
+  typedef void (*ThreadCPUTimerHandler)(Thread* thread, void* ucontext);
+  static bool init_thread_cpu_timers(ThreadCPUTimerHandler handler);
+  static bool create_thread_cpu_timer(Thread* thread, jlong interval_nanos);
+  static void delete_thread_cpu_timer(Thread* thread);
+
   // If the JVM is running in W^X mode, enable write or execute access to
   // writeable and executable pages. No-op otherwise.
   static inline void current_thread_enable_wx(WXMode mode) {
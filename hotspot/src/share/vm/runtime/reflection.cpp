@@ -927,8 +927,9 @@ oop Reflection::invoke(instanceKlassHandle klass, methodHandle reflected_method,
     }
     // target klass is receiver's klass
     target_klass = KlassHandle(THREAD, receiver->klass());
-    // no need to resolve if method is private or <init>
-    if (reflected_method->is_private() || reflected_method->name() == vmSymbols::object_initializer_name()) {
+    // no need to resolve if method is private, <init>, or cannot be overridden
+    if (reflected_method->is_private() || reflected_method->name() == vmSymbols::object_initializer_name() ||
+        (!reflected_method->method_holder()->is_interface() && reflected_method->can_be_statically_bound())) {
       method = reflected_method;
     } else {
       // resolve based on the receiver
@@ -1060,7 +1061,9 @@ oop Reflection::invoke(instanceKlassHandle klass, methodHandle reflected_method,
     } else {
       if (arg != NULL) {
         Klass* k = java_lang_Class::as_Klass(type_mirror);
-        if (!arg->is_a(k)) {
+        // Every argument is an Object; skip the subtype check for the
+        // common untyped parameter.
+        if (k != SystemDictionary::Object_klass() && !arg->is_a(k)) {
           THROW_MSG_0(vmSymbols::java_lang_IllegalArgumentException(), "argument type mismatch");
         }
       }
@@ -23,6 +23,7 @@
  */
 
 #include "precompiled.hpp"
+#include "classfile/javaClasses.hpp"
 #include "classfile/symbolTable.hpp"
 #include "classfile/systemDictionary.hpp"
 #include "code/codeCache.hpp"
@@ -33,6 +34,7 @@
 #include "gc_interface/collectedHeap.hpp"
 #include "interpreter/interpreter.hpp"
 #include "jfr/jfrEvents.hpp"
+#include "jfr/support/jfrThreadId.hpp"
 #include "memory/resourceArea.hpp"
 #include "memory/universe.inline.hpp"
 #include "oops/oop.inline.hpp"
@@ -45,15 +47,20 @@
 #include "runtime/orderAccess.inline.hpp"
 #include "runtime/osThread.hpp"
 #include "runtime/safepoint.hpp"
+#include "runtime/safepointHistory.hpp"
+#include "runtime/safepointMechanism.inline.hpp"
 #include "runtime/signature.hpp"
 #include "runtime/stubCodeGenerator.hpp"
 #include "runtime/stubRoutines.hpp"
 #include "runtime/sweeper.hpp"
 #include "runtime/synchronizer.hpp"
 #include "runtime/thread.inline.hpp"
+#include "runtime/vframe.hpp"
 #include "services/runtimeService.hpp"
+#include "services/threadService.hpp"
 #include "utilities/events.hpp"
 #include "utilities/macros.hpp"
+#include "utilities/workgroup.hpp"
 #ifdef TARGET_ARCH_x86
 # include "nativeInst_x86.hpp"
 # include "vmreg_x86.inline.hpp"
@@ -80,6 +87,7 @@
 #endif
 #if INCLUDE_ALL_GCS
 #include "gc_implementation/concurrentMarkSweep/concurrentMarkSweepThread.hpp"
+#include "gc_implementation/g1/g1StringDedup.hpp"
 #include "gc_implementation/shared/suspendibleThreadSet.hpp"
 #endif // INCLUDE_ALL_GCS
 #ifdef COMPILER1
@@ -155,6 +163,35 @@ static void post_safepoint_end_event(EventSafepointEnd* event) {
   }
 }
 
+static void post_safepoint_straggler_event(JavaThread* thread, const Tickspan& time_to_safepoint,
+                                           const Method* method, int bci) {
+  EventSafepointStraggler event;
+  if (event.should_commit()) {
+    set_current_safepoint_id(&event);
+    event.set_straggler(JFR_THREAD_ID(thread));
+    event.set_timeToSafepoint(time_to_safepoint);
+    event.set_method(method);
+    event.set_bci(bci);
+    event.commit();
+  }
+}
+
+static void post_safepoint_summary_event(const SafepointRecord* rec,
+                                         const Tickspan& time_to_safepoint,
+                                         const Tickspan& cleanup_time,
+                                         const Tickspan& operation_time) {
+  EventSafepointSummary event;
+  if (event.should_commit()) {
+    event.set_safepointId(rec->_safepoint_id);
+    event.set_operation(rec->_operation);
+    event.set_totalThreadCount(rec->_thread_count);
+    event.set_timeToSafepoint(time_to_safepoint);
+    event.set_cleanupTime(cleanup_time);
+    event.set_operationTime(operation_time);
+    event.commit();
+  }
+}
+
 // --------------------------------------------------------------------------------------------------
 // Implementation of Safepoint begin/end
 
@@ -163,10 +200,18 @@ volatile int  SafepointSynchronize::_waiting_to_block = 0;
 volatile int SafepointSynchronize::_safepoint_counter = 0;
 int SafepointSynchronize::_current_jni_active_count = 0;
 long  SafepointSynchronize::_end_of_last_safepoint = 0;
+bool  SafepointSynchronize::_track_time_to_safepoint = false;
+Ticks SafepointSynchronize::_sync_begin_ticks;
 static volatile int PageArmed = 0 ;        // safepoint polling page is RO|RW vs PROT_NONE
 static volatile int TryingToBlock = 0 ;    // proximate value -- for advisory use only
 static bool timeout_error_printed = false;
 
+// The record of the safepoint in progress; published to the
+// SafepointHistory and JFR at the end of the safepoint.
+static SafepointRecord current_record;
+static Ticks           sync_end_ticks;
+static Ticks           cleanup_end_ticks;
+
 // Roll all threads forward to a safepoint and suspend them all
 void SafepointSynchronize::begin() {
   EventSafepointBegin begin_event;
@@ -183,7 +228,10 @@ void SafepointSynchronize::begin() {
     // In the future we should investigate whether CMS can use the
     // more-general mechanism below.  DLD (01/05).
     ConcurrentMarkSweepThread::synchronize(false);
-  } else if (UseG1GC) {
+  }
+  if (UseG1GC || G1StringDedup::is_enabled()) {
+    // The string deduplication threads use the suspendible thread
+    // set with all collectors that support string deduplication.
     SuspendibleThreadSet::synchronize();
   }
 #endif // INCLUDE_ALL_GCS
@@ -264,6 +312,10 @@ void SafepointSynchronize::begin() {
   EventSafepointStateSynchronization sync_event;
   int initial_running = 0;
 
+  _track_time_to_safepoint = SafepointHistory::is_enabled() || EventSafepointStraggler::is_enabled();
+  _sync_begin_ticks = Ticks::now();
+  current_record._timestamp_millis = os::javaTimeMillis();
+
   _state            = _synchronizing;
   OrderAccess::fence();
 
@@ -485,6 +537,13 @@ void SafepointSynchronize::begin() {
     update_statistics_on_sync_end(os::javaTimeNanos());
   }
 
+  sync_end_ticks = Ticks::now();
+  current_record._safepoint_id = safepoint_counter();
+  current_record._thread_count = nof_threads;
+  if (_track_time_to_safepoint) {
+    record_stragglers();
+  }
+
   // Call stuff that needs to be run when a safepoint is just about to be completed
   {
     EventSafepointCleanup cleanup_event;
@@ -493,6 +552,7 @@ void SafepointSynchronize::begin() {
       post_safepoint_cleanup_event(&cleanup_event);
     }
   }
+  cleanup_end_ticks = Ticks::now();
 
   if (PrintSafepointStatistics) {
     // Record how much time spend on the above cleanup tasks
@@ -522,6 +582,8 @@ void SafepointSynchronize::end() {
     end_statistics(os::javaTimeNanos());
   }
 
+  record_safepoint_end(Ticks::now());
+
 #ifdef ASSERT
   // A pending_exception cannot be installed during a safepoint.  The threads
   // may install an async exception after they come back from a safepoint into
@@ -587,10 +649,11 @@ void SafepointSynchronize::end() {
   }
 #if INCLUDE_ALL_GCS
   // If there are any concurrent GC threads resume them.
+  if (UseG1GC || G1StringDedup::is_enabled()) {
+    SuspendibleThreadSet::desynchronize();
+  }
   if (UseConcMarkSweepGC) {
     ConcurrentMarkSweepThread::desynchronize(false);
-  } else if (UseG1GC) {
-    SuspendibleThreadSet::desynchronize();
   }
 #endif // INCLUDE_ALL_GCS
   // record this time so VMThread can keep track how much time has elasped
@@ -604,83 +667,272 @@ void SafepointSynchronize::end() {
 bool SafepointSynchronize::is_cleanup_needed() {
   // Need a safepoint if some inline cache buffers is non-empty
   if (!InlineCacheBuffer::is_empty()) return true;
+  // or if the symbol or string table is to be grown
+  if (SymbolTable::needs_resizing() || StringTable::needs_resizing()) return true;
   return false;
 }
 
 
 
-// Various cleaning tasks that should be done periodically at safepoints
-void SafepointSynchronize::do_cleanup_tasks() {
-  {
-    const char* name = "deflating idle monitors";
-    EventSafepointCleanupTask event;
-    TraceTime t1(name, TraceSafepointCleanupTime);
-    ObjectSynchronizer::deflate_idle_monitors();
-    if (event.should_commit()) {
-      post_safepoint_cleanup_task_event(&event, name);
-    }
-  }
+static const char* const cleanup_task_names[SafepointSynchronize::SAFEPOINT_CLEANUP_NUM_TASKS] = {
+  "deflating idle monitors",
+  "updating inline caches",
+  "compilation policy safepoint handler",
+  "mark nmethods",
+  "rehashing or resizing symbol table",
+  "rehashing or resizing string table",
+  "purging class loader data graph"
+};
 
-  {
-    const char* name = "updating inline caches";
-    EventSafepointCleanupTask event;
-    TraceTime t2(name, TraceSafepointCleanupTime);
-    InlineCacheBuffer::update_inline_caches();
-    if (event.should_commit()) {
-      post_safepoint_cleanup_task_event(&event, name);
+const char* SafepointSynchronize::cleanup_task_name(SafepointCleanupTasks task) {
+  assert(task >= 0 && task < SAFEPOINT_CLEANUP_NUM_TASKS, "invalid task");
+  return cleanup_task_names[task];
+}
+
+// Times one cleanup task for TraceSafepointCleanupTime, JFR and the
+// current safepoint record.  The times of the monitor deflation and
+// nmethod marking tasks are summed over all the threads taking part in them.
+class SafepointCleanupTaskTimer : public StackObj {
+ private:
+  SafepointSynchronize::SafepointCleanupTasks _task;
+  EventSafepointCleanupTask                   _event;
+  TraceTime                                   _timer;
+  Ticks                                       _start;
+
+ public:
+  SafepointCleanupTaskTimer(SafepointSynchronize::SafepointCleanupTasks task) :
+    _task(task),
+    _timer(SafepointSynchronize::cleanup_task_name(task), TraceSafepointCleanupTime),
+    _start(Ticks::now()) { }
+
+  ~SafepointCleanupTaskTimer() {
+    Tickspan elapsed = Ticks::now() - _start;
+    Atomic::add((jlong)elapsed.nanoseconds(), &current_record._cleanup_task_nanos[_task]);
+    if (_event.should_commit()) {
+      post_safepoint_cleanup_task_event(&_event, SafepointSynchronize::cleanup_task_name(_task));
     }
   }
-  {
-    const char* name = "compilation policy safepoint handler";
-    EventSafepointCleanupTask event;
-    TraceTime t3(name, TraceSafepointCleanupTime);
-    CompilationPolicy::policy()->do_safepoint_work();
-    if (event.should_commit()) {
-      post_safepoint_cleanup_task_event(&event, name);
+};
+
+// The cleanup tasks, run either by the VM thread alone or by the GC
+// worker gang.  Every task is claimed by one thread, except that all
+// threads help deflating the per-thread monitor in-use lists and
+// walking the thread stacks for the nmethod sweeper.
+class ParallelSPCleanupTask : public AbstractGangTask {
+ private:
+  SubTasksDone            _subtasks;
+  DeflateMonitorCounters* _counters;
+  CodeBlobClosure*        _nmethod_cl;     // sweeper stack marking, or NULL
+  JavaThread* volatile    _next_thread;    // next thread whose monitors are to be deflated
+  JavaThread* volatile    _next_nmethod_thread; // next thread whose stack is to be marked
+
+  static JavaThread* claim_next_thread(JavaThread* volatile* next) {
+    JavaThread* cur = *next;
+    while (cur != NULL) {
+      JavaThread* prev = (JavaThread*)Atomic::cmpxchg_ptr(cur->next(), next, cur);
+      if (prev == cur) {
+        return cur;
+      }
+      cur = prev;
     }
+    return NULL;
   }
 
-  {
-    const char* name = "mark nmethods";
-    EventSafepointCleanupTask event;
-    TraceTime t4(name, TraceSafepointCleanupTime);
-    NMethodSweeper::mark_active_nmethods();
-    if (event.should_commit()) {
-      post_safepoint_cleanup_task_event(&event, name);
-    }
+ public:
+  ParallelSPCleanupTask(uint num_workers, DeflateMonitorCounters* counters,
+                        CodeBlobClosure* nmethod_cl) :
+    AbstractGangTask("Parallel Safepoint Cleanup"),
+    _subtasks(SafepointSynchronize::SAFEPOINT_CLEANUP_NUM_TASKS),
+    _counters(counters),
+    _nmethod_cl(nmethod_cl),
+    _next_thread(Threads::first()),
+    _next_nmethod_thread(nmethod_cl != NULL ? Threads::first() : NULL) {
+    _subtasks.set_n_threads(num_workers);
   }
 
-  if (SymbolTable::needs_rehashing()) {
-    const char* name = "rehashing symbol table";
-    EventSafepointCleanupTask event;
-    TraceTime t5(name, TraceSafepointCleanupTime);
-    SymbolTable::rehash_table();
-    if (event.should_commit()) {
-      post_safepoint_cleanup_task_event(&event, name);
+  void work(uint worker_id) {
+    if (!_subtasks.is_task_claimed(SafepointSynchronize::SAFEPOINT_CLEANUP_DEFLATE_MONITORS)) {
+      SafepointCleanupTaskTimer t(SafepointSynchronize::SAFEPOINT_CLEANUP_DEFLATE_MONITORS);
+      ObjectSynchronizer::deflate_idle_monitors(_counters);
+    }
+
+    if (MonitorInUseLists && !AsyncDeflateIdleMonitors && _next_thread != NULL) {
+      SafepointCleanupTaskTimer t(SafepointSynchronize::SAFEPOINT_CLEANUP_DEFLATE_MONITORS);
+      JavaThread* thread;
+      while ((thread = claim_next_thread(&_next_thread)) != NULL) {
+        ObjectSynchronizer::deflate_thread_local_monitors(thread, _counters);
+      }
+    }
+
+    if (!_subtasks.is_task_claimed(SafepointSynchronize::SAFEPOINT_CLEANUP_UPDATE_INLINE_CACHES)) {
+      SafepointCleanupTaskTimer t(SafepointSynchronize::SAFEPOINT_CLEANUP_UPDATE_INLINE_CACHES);
+      InlineCacheBuffer::update_inline_caches();
+    }
+
+    if (!_subtasks.is_task_claimed(SafepointSynchronize::SAFEPOINT_CLEANUP_COMPILATION_POLICY)) {
+      SafepointCleanupTaskTimer t(SafepointSynchronize::SAFEPOINT_CLEANUP_COMPILATION_POLICY);
+      CompilationPolicy::policy()->do_safepoint_work();
+    }
+
+    if (_next_nmethod_thread != NULL) {
+      SafepointCleanupTaskTimer t(SafepointSynchronize::SAFEPOINT_CLEANUP_MARK_NMETHODS);
+      JavaThread* thread;
+      while ((thread = claim_next_thread(&_next_nmethod_thread)) != NULL) {
+        thread->nmethods_do(_nmethod_cl);
+      }
     }
-  }
 
-  if (StringTable::needs_rehashing()) {
-    const char* name = "rehashing string table";
-    EventSafepointCleanupTask event;
-    TraceTime t6(name, TraceSafepointCleanupTime);
-    StringTable::rehash_table();
-    if (event.should_commit()) {
-      post_safepoint_cleanup_task_event(&event, name);
+    if (!_subtasks.is_task_claimed(SafepointSynchronize::SAFEPOINT_CLEANUP_SYMBOL_TABLE_REHASH)) {
+      if (SymbolTable::needs_rehashing() || SymbolTable::needs_resizing()) {
+        SafepointCleanupTaskTimer t(SafepointSynchronize::SAFEPOINT_CLEANUP_SYMBOL_TABLE_REHASH);
+        if (SymbolTable::needs_rehashing()) {
+          SymbolTable::rehash_table();
+        }
+        if (SymbolTable::needs_resizing()) {
+          SymbolTable::resize_table();
+        }
+      }
+    }
+
+    if (!_subtasks.is_task_claimed(SafepointSynchronize::SAFEPOINT_CLEANUP_STRING_TABLE_REHASH)) {
+      if (StringTable::needs_rehashing() || StringTable::needs_resizing()) {
+        SafepointCleanupTaskTimer t(SafepointSynchronize::SAFEPOINT_CLEANUP_STRING_TABLE_REHASH);
+        if (StringTable::needs_rehashing()) {
+          StringTable::rehash_table();
+        }
+        if (StringTable::needs_resizing()) {
+          StringTable::resize_table();
+        }
+      }
+    }
+
+    if (!_subtasks.is_task_claimed(SafepointSynchronize::SAFEPOINT_CLEANUP_CLD_PURGE)) {
+      // CMS delays purging the CLDG until the beginning of the next safepoint and to
+      // make sure concurrent sweep is done
+      SafepointCleanupTaskTimer t(SafepointSynchronize::SAFEPOINT_CLEANUP_CLD_PURGE);
+      ClassLoaderDataGraph::purge_if_needed();
     }
+
+    _subtasks.all_tasks_completed();
+  }
+};
+
+// Various cleaning tasks that should be done periodically at safepoints.
+// They are handed to the GC worker threads when there are enough Java
+// threads to make the monitor deflation worth splitting up, or when one
+// of the tables is to be rehashed or resized.
+void SafepointSynchronize::do_cleanup_tasks() {
+  for (int i = 0; i < SAFEPOINT_CLEANUP_NUM_TASKS; i++) {
+    current_record._cleanup_task_nanos[i] = 0;
+  }
+
+  DeflateMonitorCounters deflate_counters;
+  ObjectSynchronizer::prepare_deflate_idle_monitors(&deflate_counters);
+  CodeBlobClosure* nmethod_cl = NMethodSweeper::prepare_mark_active_nmethods();
+
+  CollectedHeap* heap = Universe::heap();
+  assert(heap != NULL, "heap not initialized yet?");
+  FlexibleWorkGang* workers = heap->get_safepoint_workers();
+  if (workers != NULL && workers->active_workers() > 1 && ParallelSafepointCleanupThreshold > 0 &&
+      (Threads::number_of_threads() >= ParallelSafepointCleanupThreshold ||
+       SymbolTable::needs_rehashing() || StringTable::needs_rehashing() ||
+       SymbolTable::needs_resizing() || StringTable::needs_resizing())) {
+    ParallelSPCleanupTask cleanup(workers->active_workers(), &deflate_counters, nmethod_cl);
+    workers->run_task(&cleanup);
+  } else {
+    ParallelSPCleanupTask cleanup(1, &deflate_counters, nmethod_cl);
+    cleanup.work(0);
   }
 
+  ObjectSynchronizer::finish_deflate_idle_monitors(&deflate_counters);
+
   // rotate log files?
   if (UseGCLogFileRotation) {
     TraceTime t8("rotating gc logs", TraceSafepointCleanupTime);
     gclog_or_tty->rotate_log(false);
   }
+}
 
-  {
-    // CMS delays purging the CLDG until the beginning of the next safepoint and to
-    // make sure concurrent sweep is done
-    TraceTime t7("purging class loader data graph", TraceSafepointCleanupTime);
-    ClassLoaderDataGraph::purge_if_needed();
+// Records the threads that took the longest to reach this safepoint, and
+// the Java frame each of them stopped in.  All threads are stopped, so
+// their stacks can be walked.
+void SafepointSynchronize::record_stragglers() {
+  assert(is_at_safepoint(), "must be at safepoint");
+  assert(Thread::current()->is_VM_thread(), "Only VM thread may record stragglers");
+
+  SafepointRecord* rec = &current_record;
+  int max = MIN2((int)SafepointStragglerCount, (int)SafepointRecord::max_stragglers);
+  JavaThread* slowest[SafepointRecord::max_stragglers];
+  int n = 0;
+
+  // Keep the max slowest threads, slowest first
+  for (JavaThread* cur = Threads::first(); cur != NULL; cur = cur->next()) {
+    ThreadSafepointState* state = cur->safepoint_state();
+    if (!state->has_reached_safepoint()) {
+      continue;
+    }
+    uint64_t t = state->time_to_safepoint().nanoseconds();
+    int i = n;
+    while (i > 0 && slowest[i - 1]->safepoint_state()->time_to_safepoint().nanoseconds() < t) {
+      if (i < max) {
+        slowest[i] = slowest[i - 1];
+      }
+      i--;
+    }
+    if (i < max) {
+      slowest[i] = cur;
+      if (n < max) {
+        n++;
+      }
+    }
+  }
+
+  ResourceMark rm;
+  for (int i = 0; i < n; i++) {
+    JavaThread* thread = slowest[i];
+    Tickspan time_to_safepoint = thread->safepoint_state()->time_to_safepoint();
+    SafepointStragglerRecord* s = &rec->_stragglers[i];
+    s->_time_to_safepoint_nanos = (jlong)time_to_safepoint.nanoseconds();
+    oop thread_obj = thread->threadObj();
+    s->_java_tid = thread_obj != NULL ? java_lang_Thread::thread_id(thread_obj) : -1;
+    jio_snprintf(s->_thread_name, sizeof(s->_thread_name), "%s", thread->get_thread_name());
+
+    Method* method = NULL;
+    int bci = -1;
+    s->_frame[0] = '\0';
+    if (thread->has_last_Java_frame()) {
+      vframeStream vfst(thread);
+      if (!vfst.at_end()) {
+        method = vfst.method();
+        bci = vfst.bci();
+        jio_snprintf(s->_frame, sizeof(s->_frame), "%s@%d", method->name_and_sig_as_C_string(), bci);
+      }
+    }
+    post_safepoint_straggler_event(thread, time_to_safepoint, method, bci);
+  }
+  rec->_straggler_count = n;
+}
+
+// Completes the record of this safepoint and publishes it.
+void SafepointSynchronize::record_safepoint_end(const Ticks& operation_end) {
+  SafepointRecord* rec = &current_record;
+  Tickspan time_to_safepoint = sync_end_ticks - _sync_begin_ticks;
+  Tickspan cleanup_time = cleanup_end_ticks - sync_end_ticks;
+  Tickspan operation_time = operation_end - cleanup_end_ticks;
+
+  rec->_time_to_safepoint_nanos = (jlong)time_to_safepoint.nanoseconds();
+  rec->_cleanup_nanos = (jlong)cleanup_time.nanoseconds();
+  rec->_operation_nanos = (jlong)operation_time.nanoseconds();
+  VM_Operation* op = VMThread::vm_operation();
+  jio_snprintf(rec->_operation, sizeof(rec->_operation), "%s",
+               (op != NULL) ? op->name() : "no vm operation");
+  if (!_track_time_to_safepoint) {
+    rec->_straggler_count = 0;
+  }
+
+  post_safepoint_summary_event(rec, time_to_safepoint, cleanup_time, operation_time);
+  if (SafepointHistory::is_enabled()) {
+    SafepointHistory::record(rec);
   }
 }
 
@@ -760,6 +1012,7 @@ void SafepointSynchronize::block(JavaThread *thread) {
 
   JavaThreadState state = thread->thread_state();
   thread->frame_anchor()->make_walkable(thread);
+  jlong start_ticks;
 
   // Check that we have a valid thread_state at this point
   switch(state) {
@@ -783,6 +1036,9 @@ void SafepointSynchronize::block(JavaThread *thread) {
         assert(_waiting_to_block > 0, "sanity check");
         _waiting_to_block--;
         thread->safepoint_state()->set_has_called_back(true);
+        if (_track_time_to_safepoint) {
+          thread->safepoint_state()->record_reached_safepoint();
+        }
 
         DEBUG_ONLY(thread->set_visited_for_critical_count(true));
         if (thread->in_critical()) {
@@ -807,7 +1063,9 @@ void SafepointSynchronize::block(JavaThread *thread) {
 
       // We now try to acquire the threads lock. Since this lock is hold by the VM thread during
       // the entire safepoint, the threads will all line up here during the safepoint.
+      start_ticks = os::elapsed_counter();
       Threads_lock->lock_without_safepoint_check();
+      thread->get_thread_stat()->safepoint_blocked(os::elapsed_counter() - start_ticks);
       // restore original state. This is important if the thread comes from compiled code, so it
       // will continue to execute with the _thread_in_Java state.
       thread->set_thread_state(state);
@@ -836,7 +1094,9 @@ void SafepointSynchronize::block(JavaThread *thread) {
       // so it can see that it is at a safepoint.
 
       // Block until the safepoint operation is completed.
+      start_ticks = os::elapsed_counter();
       Threads_lock->lock_without_safepoint_check();
+      thread->get_thread_stat()->safepoint_blocked(os::elapsed_counter() - start_ticks);
 
       // Restore state
       thread->set_thread_state(state);
@@ -879,7 +1139,10 @@ void SafepointSynchronize::block(JavaThread *thread) {
 void SafepointSynchronize::handle_polling_page_exception(JavaThread *thread) {
   assert(thread->is_Java_thread(), "polling reference encountered by VM thread");
   assert(thread->thread_state() == _thread_in_Java, "should come from Java code");
-  assert(SafepointSynchronize::is_synchronizing(), "polling encountered outside safepoint synchronization");
+  // The VM thread may already have executed and disarmed a handshake
+  // operation on behalf of this thread by the time it gets here.
+  assert(SafepointSynchronize::is_synchronizing() || SafepointMechanism::uses_thread_local_poll(),
+         "polling encountered outside safepoint synchronization");
 
   Thread::WXWriteFromExecSetter wx_write;
 
@@ -949,6 +1212,7 @@ ThreadSafepointState::ThreadSafepointState(JavaThread *thread) {
   _type   = _running;
   _has_called_back = false;
   _at_poll_safepoint = false;
+  _has_reached_safepoint = false;
 }
 
 void ThreadSafepointState::create(JavaThread *thread) {
@@ -1027,6 +1291,9 @@ void ThreadSafepointState::roll_forward(suspend_type type) {
   switch(_type) {
     case _at_safepoint:
       SafepointSynchronize::signal_thread_at_safepoint();
+      if (SafepointSynchronize::track_time_to_safepoint()) {
+        record_reached_safepoint();
+      }
       DEBUG_ONLY(_thread->set_visited_for_critical_count(true));
       if (_thread->in_critical()) {
         // Notice that this thread is in a critical section
@@ -1059,6 +1326,13 @@ void ThreadSafepointState::restart() {
   }
   _type = _running;
   set_has_called_back(false);
+  _has_reached_safepoint = false;
+}
+
+void ThreadSafepointState::record_reached_safepoint() {
+  assert(SafepointSynchronize::is_synchronizing(), "only while synchronizing");
+  _reached_safepoint_ticks = Ticks::now();
+  _has_reached_safepoint = true;
 }
 
 
@@ -1132,7 +1406,7 @@ void ThreadSafepointState::handle_polling_page_exception() {
     }
 
     // Block the thread
-    SafepointSynchronize::block(thread());
+    SafepointMechanism::block_if_requested(thread());
 
     // restore oop result, if any
     if (return_oop) {
@@ -1148,7 +1422,7 @@ void ThreadSafepointState::handle_polling_page_exception() {
     assert(real_return_addr == caller_fr.pc(), "must match");
 
     // Block the thread
-    SafepointSynchronize::block(thread());
+    SafepointMechanism::block_if_requested(thread());
     set_at_poll_safepoint(false);
 
     // If we have a pending async exception deoptimize the frame
@@ -1187,6 +1461,7 @@ jlong  SafepointSynchronize::_safepoint_begin_time = 0;
 int    SafepointSynchronize::_cur_stat_index = 0;
 julong SafepointSynchronize::_safepoint_reasons[VM_Operation::VMOp_Terminating];
 julong SafepointSynchronize::_coalesced_vmop_count = 0;
+julong SafepointSynchronize::_coalesced_vmops[VM_Operation::VMOp_Terminating];
 jlong  SafepointSynchronize::_max_sync_time = 0;
 jlong  SafepointSynchronize::_max_vmop_time = 0;
 float  SafepointSynchronize::_ts_of_current_safepoint = 0.0f;
@@ -1206,7 +1481,7 @@ static void print_header() {
     tty->print("page_armed ");
   }
 
-  tty->print_cr("page_trap_count");
+  tty->print_cr("page_trap_count coalesced");
 }
 
 void SafepointSynchronize::deferred_initialize_stat() {
@@ -1253,6 +1528,7 @@ void SafepointSynchronize::begin_statistics(int nof_threads, int nof_running) {
   spstat->_nof_total_threads = nof_threads;
   spstat->_nof_initial_running_threads = nof_running;
   spstat->_nof_threads_hit_page_trap = 0;
+  spstat->_nof_coalesced_vmops = 0;
 
   // Records the start time of spinning. The real time spent on spinning
   // will be adjusted when spin is done. Same trick is applied for time
@@ -1314,6 +1590,13 @@ void SafepointSynchronize::update_statistics_on_cleanup_end(jlong end_time) {
   cleanup_end_time = end_time;
 }
 
+void SafepointSynchronize::inc_vmop_coalesced_count(int vmop_type) {
+  assert(is_at_safepoint(), "only coalesced at a safepoint");
+  _coalesced_vmop_count++;
+  _coalesced_vmops[vmop_type]++;
+  _safepoint_stats[_cur_stat_index]._nof_coalesced_vmops++;
+}
+
 void SafepointSynchronize::end_statistics(jlong vmop_end_time) {
   SafepointStats *spstat = &_safepoint_stats[_cur_stat_index];
 
@@ -1372,7 +1655,9 @@ void SafepointSynchronize::print_statistics() {
     if (need_to_track_page_armed_status) {
       tty->print(INT32_FORMAT "         ", sstats->_page_armed);
     }
-    tty->print_cr(INT32_FORMAT "   ", sstats->_nof_threads_hit_page_trap);
+    tty->print_cr(INT32_FORMAT_W(15) INT32_FORMAT_W(10),
+                  sstats->_nof_threads_hit_page_trap,
+                  sstats->_nof_coalesced_vmops);
   }
 }
 
@@ -1407,10 +1692,13 @@ void SafepointSynchronize::print_stat_on_exit() {
                  DeferPollingPageLoopCount);
   }
 
+  // Safepoints each VM operation started, and how many more of it ran
+  // at a safepoint started by another one
   for (int index = 0; index < VM_Operation::VMOp_Terminating; index++) {
-    if (_safepoint_reasons[index] != 0) {
-      tty->print_cr("%-26s" UINT64_FORMAT_W(10), VM_Operation::name(index),
-                    _safepoint_reasons[index]);
+    if (_safepoint_reasons[index] != 0 || _coalesced_vmops[index] != 0) {
+      tty->print_cr("%-26s" UINT64_FORMAT_W(10) UINT64_FORMAT_W(10) " coalesced",
+                    VM_Operation::name(index),
+                    _safepoint_reasons[index], _coalesced_vmops[index]);
     }
   }
 
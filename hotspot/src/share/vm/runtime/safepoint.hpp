@@ -32,6 +32,7 @@
 #include "runtime/mutexLocker.hpp"
 #include "runtime/os.hpp"
 #include "utilities/ostream.hpp"
+#include "utilities/ticks.hpp"
 
 //
 // Safepoint synchronization
@@ -75,6 +76,19 @@ class SafepointSynchronize : AllStatic {
     _blocking_timeout = 1
   };
 
+  // The enums are listed in the order of the tasks when done serially.
+  enum SafepointCleanupTasks {
+    SAFEPOINT_CLEANUP_DEFLATE_MONITORS,
+    SAFEPOINT_CLEANUP_UPDATE_INLINE_CACHES,
+    SAFEPOINT_CLEANUP_COMPILATION_POLICY,
+    SAFEPOINT_CLEANUP_MARK_NMETHODS,
+    SAFEPOINT_CLEANUP_SYMBOL_TABLE_REHASH,
+    SAFEPOINT_CLEANUP_STRING_TABLE_REHASH,
+    SAFEPOINT_CLEANUP_CLD_PURGE,
+    // Leave this one last.
+    SAFEPOINT_CLEANUP_NUM_TASKS
+  };
+
   typedef struct {
     float  _time_stamp;                        // record when the current safepoint occurs in seconds
     int    _vmop_type;                         // type of VM operation triggers the safepoint
@@ -88,6 +102,7 @@ class SafepointSynchronize : AllStatic {
     jlong  _time_to_do_cleanups;               // total time in millis spent in performing cleanups
     jlong  _time_to_sync;                      // total time in millis spent in getting to _synchronized
     jlong  _time_to_exec_vmop;                 // total time in millis spent in vm operation itself
+    int    _nof_coalesced_vmops;               // number of queued vm operations run at the same safepoint
   } SafepointStats;
 
  private:
@@ -112,6 +127,7 @@ private:
   static int              _cur_stat_index;           // current index to the above array
   static julong           _safepoint_reasons[];      // safepoint count for each VM op
   static julong           _coalesced_vmop_count;     // coalesced vmop count
+  static julong           _coalesced_vmops[];        // coalesced count for each VM op
   static jlong            _max_sync_time;            // maximum sync time in nanos
   static jlong            _max_vmop_time;            // maximum vm operation time in nanos
   static float            _ts_of_current_safepoint;  // time stamp of current safepoint in seconds
@@ -129,6 +145,13 @@ private:
   // For debug long safepoint
   static void print_safepoint_timeout(SafepointTimeoutReason timeout_reason);
 
+  // Time-to-safepoint tracking for the safepoint history and JFR
+  static bool  _track_time_to_safepoint;       // record when each thread reached the safepoint
+  static Ticks _sync_begin_ticks;              // when _state became _synchronizing
+
+  static void record_stragglers();
+  static void record_safepoint_end(const Ticks& operation_end);
+
 public:
 
   // Main entry points
@@ -172,6 +195,10 @@ public:
   }
   static bool is_cleanup_needed();
   static void do_cleanup_tasks();
+  static const char* cleanup_task_name(SafepointCleanupTasks task);
+
+  static bool  track_time_to_safepoint()         { return _track_time_to_safepoint; }
+  static const Ticks& sync_begin_ticks()         { return _sync_begin_ticks; }
 
   // debugging
   static void print_state()                                PRODUCT_RETURN;
@@ -179,7 +206,7 @@ public:
 
   static void deferred_initialize_stat();
   static void print_stat_on_exit();
-  inline static void inc_vmop_coalesced_count() { _coalesced_vmop_count++; }
+  static void inc_vmop_coalesced_count(int vmop_type);
 
   static void set_is_at_safepoint()                        { _state = _synchronized; }
   static void set_is_not_at_safepoint()                    { _state = _not_synchronized; }
@@ -210,6 +237,9 @@ class ThreadSafepointState: public CHeapObj<mtThread> {
   volatile suspend_type          _type;
   JavaThreadState                _orig_thread_state;
 
+  // When the thread stopped or was found safe; valid if _has_reached_safepoint
+  bool                           _has_reached_safepoint;
+  Ticks                          _reached_safepoint_ticks;
 
  public:
   ThreadSafepointState(JavaThread *thread);
@@ -225,6 +255,13 @@ class ThreadSafepointState: public CHeapObj<mtThread> {
   bool         is_running() const     { return (_type==_running); }
   JavaThreadState orig_thread_state() const { return _orig_thread_state; }
 
+  // Time-to-safepoint tracking (see SafepointSynchronize::record_stragglers())
+  void         record_reached_safepoint();
+  bool         has_reached_safepoint() const  { return _has_reached_safepoint; }
+  Tickspan     time_to_safepoint() const {
+    return _reached_safepoint_ticks - SafepointSynchronize::sync_begin_ticks();
+  }
+
   // Support for safepoint timeout (debugging)
   bool has_called_back() const                   { return _has_called_back; }
   void set_has_called_back(bool val)             { _has_called_back = val; }
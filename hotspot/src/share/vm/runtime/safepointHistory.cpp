@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "memory/allocation.inline.hpp"
+#include "memory/resourceArea.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/safepointHistory.hpp"
+
+SafepointRecord* SafepointHistory::_records = NULL;
+jlong            SafepointHistory::_count   = 0;
+
+static double nanos_to_millis(jlong nanos) {
+  return (double)nanos / NANOSECS_PER_MILLISEC;
+}
+
+void SafepointRecord::print_on(outputStream* st) const {
+  st->print_cr("Safepoint %d at " INT64_FORMAT " ms: %s, %d threads",
+               _safepoint_id, _timestamp_millis, _operation, _thread_count);
+  st->print_cr("  time to safepoint %.3f ms, cleanup %.3f ms, operation %.3f ms",
+               nanos_to_millis(_time_to_safepoint_nanos),
+               nanos_to_millis(_cleanup_nanos),
+               nanos_to_millis(_operation_nanos));
+  for (int i = 0; i < SafepointSynchronize::SAFEPOINT_CLEANUP_NUM_TASKS; i++) {
+    if (_cleanup_task_nanos[i] > 0) {
+      SafepointSynchronize::SafepointCleanupTasks task = (SafepointSynchronize::SafepointCleanupTasks)i;
+      st->print_cr("    %-40s %.3f ms", SafepointSynchronize::cleanup_task_name(task),
+                   nanos_to_millis(_cleanup_task_nanos[i]));
+    }
+  }
+  for (int i = 0; i < _straggler_count; i++) {
+    const SafepointStragglerRecord* s = &_stragglers[i];
+    st->print_cr("  straggler \"%s\" tid=" INT64_FORMAT " reached after %.3f ms%s%s",
+                 s->_thread_name, s->_java_tid, nanos_to_millis(s->_time_to_safepoint_nanos),
+                 s->_frame[0] != '\0' ? " in " : "", s->_frame);
+  }
+}
+
+void SafepointHistory::record(const SafepointRecord* rec) {
+  assert(is_enabled(), "should not be called");
+  MutexLockerEx ml(SafepointHistory_lock, Mutex::_no_safepoint_check_flag);
+  if (_records == NULL) {
+    _records = NEW_C_HEAP_ARRAY(SafepointRecord, SafepointHistorySize, mtInternal);
+  }
+  _records[_count % SafepointHistorySize] = *rec;
+  _count++;
+}
+
+void SafepointHistory::print_on(outputStream* st) {
+  if (!is_enabled()) {
+    st->print_cr("Safepoint history is disabled (-XX:SafepointHistorySize=0).");
+    return;
+  }
+  ResourceMark rm;
+  SafepointRecord* copy = NEW_RESOURCE_ARRAY(SafepointRecord, SafepointHistorySize);
+  int n = 0;
+  jlong total;
+  {
+    // Copy out under the lock and print without it; the VM thread takes
+    // the lock at the end of every safepoint.
+    MutexLockerEx ml(SafepointHistory_lock, Mutex::_no_safepoint_check_flag);
+    total = _count;
+    jlong first = MAX2(_count - (jlong)SafepointHistorySize, (jlong)0);
+    for (jlong i = first; i < _count; i++) {
+      copy[n++] = _records[i % SafepointHistorySize];
+    }
+  }
+  st->print_cr("Last %d of " INT64_FORMAT " safepoints:", n, total);
+  for (int i = 0; i < n; i++) {
+    copy[i].print_on(st);
+  }
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_RUNTIME_SAFEPOINTHISTORY_HPP
+#define SHARE_VM_RUNTIME_SAFEPOINTHISTORY_HPP
+
+#include "memory/allocation.hpp"
+#include "runtime/safepoint.hpp"
+#include "utilities/ostream.hpp"
+
+// A thread that was among the last to reach a safepoint, with the Java
+// frame it stopped in.
+struct SafepointStragglerRecord {
+  enum {
+    thread_name_length = 64,
+    frame_length       = 256
+  };
+  jlong _java_tid;                         // java.lang.Thread.tid, or -1
+  jlong _time_to_safepoint_nanos;          // from the start of synchronization
+  char  _thread_name[thread_name_length];
+  char  _frame[frame_length];              // "Klass.method(sig)@bci", or empty
+};
+
+// What a single safepoint cost, from the start of synchronization to the
+// end of the VM operation.
+struct SafepointRecord {
+  enum {
+    max_stragglers   = 8,
+    operation_length = 64
+  };
+  int   _safepoint_id;
+  jlong _timestamp_millis;                 // os::javaTimeMillis() at the start
+  char  _operation[operation_length];
+  int   _thread_count;
+  jlong _time_to_safepoint_nanos;
+  jlong _cleanup_nanos;
+  jlong _cleanup_task_nanos[SafepointSynchronize::SAFEPOINT_CLEANUP_NUM_TASKS];
+  jlong _operation_nanos;
+  int   _straggler_count;
+  SafepointStragglerRecord _stragglers[max_stragglers];
+
+  void print_on(outputStream* st) const;
+};
+
+// The last SafepointHistorySize safepoint records, kept for the
+// VM.safepoint_history diagnostic command.
+class SafepointHistory : AllStatic {
+ private:
+  static SafepointRecord* _records;        // ring buffer, allocated on first use
+  static jlong            _count;          // records published so far
+
+ public:
+  static bool is_enabled()                 { return SafepointHistorySize > 0; }
+
+  // Called by the VM thread at the end of each safepoint
+  static void record(const SafepointRecord* rec);
+
+  static void print_on(outputStream* st);
+};
+
+#endif // SHARE_VM_RUNTIME_SAFEPOINTHISTORY_HPP
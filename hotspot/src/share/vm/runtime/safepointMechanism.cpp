@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "runtime/os.hpp"
+#include "runtime/safepointMechanism.inline.hpp"
+
+void* SafepointMechanism::_poll_armed_value = NULL;
+void* SafepointMechanism::_poll_disarmed_value = NULL;
+
+void SafepointMechanism::initialize() {
+  assert(os::get_polling_page() != NULL, "polling page must be set up by os::init_2()");
+  _poll_disarmed_value = os::get_polling_page();
+  _poll_armed_value = os::get_polling_page();
+
+  if (uses_thread_local_poll()) {
+    // A thread armed for a handshake reads this page, which is never
+    // readable, so that only the armed thread traps.
+    const size_t page_size = os::vm_page_size();
+    char* armed_page = os::reserve_memory(page_size, NULL, page_size);
+    guarantee(armed_page != NULL, "failed to reserve thread local polling page");
+    os::commit_memory_or_exit(armed_page, page_size, false,
+                              "Unable to commit thread local polling page");
+    guarantee(os::protect_memory(armed_page, page_size, os::MEM_PROT_NONE),
+              "failed to protect thread local polling page");
+    os::set_armed_polling_page((address)armed_page);
+
+    _poll_armed_value = reinterpret_cast<void*>(reinterpret_cast<intptr_t>(armed_page) | poll_bit());
+
+#ifndef PRODUCT
+    if (Verbose && PrintMiscellaneous) {
+      tty->print("[SafePoint Thread Local Polling address: " INTPTR_FORMAT "]\n", (intptr_t)armed_page);
+    }
+#endif
+  }
+}
+
+void SafepointMechanism::initialize_header(JavaThread* thread) {
+  disarm_local_poll(thread);
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_RUNTIME_SAFEPOINTMECHANISM_HPP
+#define SHARE_VM_RUNTIME_SAFEPOINTMECHANISM_HPP
+
+#include "memory/allocation.hpp"
+#include "runtime/globals.hpp"
+#include "utilities/globalDefinitions.hpp"
+
+class JavaThread;
+class Thread;
+
+// This is the abstracted interface for the safepoint implementation.
+//
+// Every JavaThread has a polling word (Thread::_polling_page) which
+// compiled code, the template interpreter and the native wrappers read
+// instead of the global polling page when ThreadLocalHandshakes is on.
+// The disarmed value is the global polling page, so a global safepoint
+// still stops every thread by protecting that page. Arming a single
+// thread points its word at a permanently protected page with the poll
+// bit set, so that only this thread traps and calls back into the VM.
+class SafepointMechanism : public AllStatic {
+  static void* _poll_armed_value;
+  static void* _poll_disarmed_value;
+
+  static void* poll_armed_value()                 { return _poll_armed_value; }
+  static void* poll_disarmed_value()              { return _poll_disarmed_value; }
+
+  static inline bool global_poll();
+
+ public:
+  static intptr_t poll_bit()                      { return 1; }
+
+  static bool uses_thread_local_poll()            { return ThreadLocalHandshakes; }
+
+  // Call this method to see if this thread has been armed for a handshake.
+  static inline bool local_poll_armed(JavaThread* thread);
+
+  // Call this method to see if this thread should block for a safepoint
+  // or process a pending handshake.
+  static inline bool should_block(JavaThread* thread);
+
+  // Blocks a thread until safepoint is completed and processes a pending
+  // handshake operation of the thread, if any.
+  static inline void block_if_requested(JavaThread* thread);
+
+  // Caller is responsible for using a memory barrier if needed.
+  static inline void arm_local_poll(JavaThread* thread);
+  static inline void disarm_local_poll(JavaThread* thread);
+
+  // Setup the selected safepoint mechanism
+  static void initialize();
+  static void initialize_header(JavaThread* thread);
+};
+
+#endif // SHARE_VM_RUNTIME_SAFEPOINTMECHANISM_HPP
@@ -27,6 +27,7 @@
 #include "runtime/javaCalls.hpp"
 #include "runtime/serviceThread.hpp"
 #include "runtime/mutexLocker.hpp"
+#include "runtime/synchronizer.hpp"
 #include "prims/jvmtiImpl.hpp"
 #include "services/allocationContextService.hpp"
 #include "services/gcNotifier.hpp"
@@ -35,6 +36,9 @@
 #if INCLUDE_CRS
 #include "services/connectedRuntime.hpp"
 #endif
+#if INCLUDE_ALL_GCS
+#include "gc_implementation/g1/g1PeriodicGC.hpp"
+#endif // INCLUDE_ALL_GCS
 
 ServiceThread* ServiceThread::_instance = NULL;
 
@@ -91,9 +95,13 @@ void ServiceThread::service_thread_entry(JavaThread* jt, TRAPS) {
     bool has_gc_notification_event = false;
     bool has_dcmd_notification_event = false;
     bool acs_notify = false;
+    bool deflate_idle_monitors = false;
 #if INCLUDE_CRS
     bool crs_notify = false;
 #endif // INCLUDE_CRS
+#if INCLUDE_ALL_GCS
+    bool g1_periodic_gc = false;
+#endif // INCLUDE_ALL_GCS
     JvmtiDeferredEvent jvmti_event;
     {
       // Need state transition ThreadBlockInVM so that this thread
@@ -111,11 +119,19 @@ void ServiceThread::service_thread_entry(JavaThread* jt, TRAPS) {
              !(has_jvmti_events = JvmtiDeferredEventQueue::has_events()) &&
               !(has_gc_notification_event = GCNotifier::has_event()) &&
               !(has_dcmd_notification_event = DCmdFactory::has_pending_jmx_notification()) &&
-             !(acs_notify = AllocationContextService::should_notify())
-              CRS_ONLY(&& !(crs_notify = ConnectedRuntime::should_notify_java()))) {
+             !(acs_notify = AllocationContextService::should_notify()) &&
+             !(deflate_idle_monitors = ObjectSynchronizer::is_async_deflation_needed())
+              CRS_ONLY(&& !(crs_notify = ConnectedRuntime::should_notify_java()))
+#if INCLUDE_ALL_GCS
+              && !(g1_periodic_gc = UseG1GC && G1PeriodicGC::has_pending_request())
+#endif // INCLUDE_ALL_GCS
+             ) {
         // wait until one of the sensors has pending requests, or there is a
-        // pending JVMTI event or JMX GC notification to post
-        Service_lock->wait(Mutex::_no_safepoint_check_flag);
+        // pending JVMTI event, JMX GC notification or periodic G1 collection
+        // request to post.  With async monitor deflation wake up periodically
+        // to check the monitor usage.
+        Service_lock->wait(Mutex::_no_safepoint_check_flag,
+                           AsyncDeflateIdleMonitors ? AsyncDeflationInterval : 0);
       }
 
       if (has_jvmti_events) {
@@ -148,6 +164,16 @@ void ServiceThread::service_thread_entry(JavaThread* jt, TRAPS) {
       ConnectedRuntime::notify_java(CHECK);
     }
 #endif // INCLUDE_CRS
+
+#if INCLUDE_ALL_GCS
+    if (g1_periodic_gc) {
+      G1PeriodicGC::do_pending_request();
+    }
+#endif // INCLUDE_ALL_GCS
+
+    if (deflate_idle_monitors) {
+      ObjectSynchronizer::deflate_idle_monitors_using_JT();
+    }
   }
 }
 
@@ -26,6 +26,7 @@
 #include "classfile/systemDictionary.hpp"
 #include "classfile/vmSymbols.hpp"
 #include "code/compiledIC.hpp"
+#include "code/perfMap.hpp"
 #include "code/scopeDesc.hpp"
 #include "code/vtableStubs.hpp"
 #include "compiler/abstractCompiler.hpp"
@@ -168,6 +169,8 @@ int SharedRuntime::_nof_interface_calls = 0;
 int SharedRuntime::_nof_optimized_interface_calls = 0;
 int SharedRuntime::_nof_inlined_interface_calls = 0;
 int SharedRuntime::_nof_megamorphic_interface_calls = 0;
+int SharedRuntime::_nof_itable_cache_hits = 0;
+int SharedRuntime::_nof_itable_cache_misses = 0;
 int SharedRuntime::_nof_removable_exceptions = 0;
 
 int SharedRuntime::_new_instance_ctr=0;
@@ -2085,6 +2088,8 @@ void SharedRuntime::print_call_statistics(int comp_total) {
   tty->print_cr("\t  %9d  (%3.0f%%)   optimized        ", _nof_optimized_interface_calls, percent(_nof_optimized_interface_calls, _nof_interface_calls));
   tty->print_cr("\t  %9d  (%3.0f%%)   monomorphic      ", mono_i, percent(mono_i, _nof_interface_calls));
   tty->print_cr("\t  %9d  (%3.0f%%)   megamorphic      ", _nof_megamorphic_interface_calls, percent(_nof_megamorphic_interface_calls, _nof_interface_calls));
+  int itable_lookups = _nof_itable_cache_hits + _nof_itable_cache_misses;
+  tty->print_cr("\t    %9d  (%3.0f%%) itable cache hits", _nof_itable_cache_hits, percent(_nof_itable_cache_hits, itable_lookups));
   tty->print_cr("\t%9d   (%4.1f%%) static/special calls", _nof_static_calls, percent(_nof_static_calls, total));
   tty->print_cr("\t  %9d  (%3.0f%%)   inlined          ", _nof_inlined_static_calls, percent(_nof_inlined_static_calls, _nof_static_calls));
   tty->cr();
@@ -2566,6 +2571,7 @@ AdapterHandlerEntry* AdapterHandlerLibrary::get_adapter(methodHandle method) {
                  fingerprint->as_string(),
                  new_adapter->content_begin());
     Forte::register_stub(blob_id, new_adapter->content_begin(),new_adapter->content_end());
+    PerfMap::record_stub(blob_id, new_adapter->content_begin(), new_adapter->content_end());
 
     if (JvmtiExport::should_post_dynamic_code_generated()) {
       JvmtiExport::post_dynamic_code_generated(blob_id, new_adapter->content_begin(), new_adapter->content_end());
@@ -2972,21 +2978,20 @@ JRT_LEAF(intptr_t*, SharedRuntime::OSR_migration_begin( JavaThread *thread) )
   assert( fr.is_interpreted_frame(), "" );
   assert( fr.interpreter_frame_expression_stack_size()==0, "only handle empty stacks" );
 
-  // Figure out how many monitors are active.
-  int active_monitor_count = 0;
-  for( BasicObjectLock *kptr = fr.interpreter_frame_monitor_end();
-       kptr < fr.interpreter_frame_monitor_begin();
-       kptr = fr.next_monitor_in_interpreter_frame(kptr) ) {
-    if( kptr->obj() != NULL ) active_monitor_count++;
-  }
+  // Size the buffer for every monitor slot, so that the locals and the
+  // active monitors are collected in a single pass over the frame.
+  BasicObjectLock* monitor_end = fr.interpreter_frame_monitor_end();
+  BasicObjectLock* monitor_begin = fr.interpreter_frame_monitor_begin();
+  int monitor_slots = (int)(pointer_delta(monitor_begin, monitor_end, wordSize) /
+                            frame::interpreter_frame_monitor_size());
 
   // QQQ we could place number of active monitors in the array so that compiled code
   // could double check it.
 
   Method* moop = fr.interpreter_frame_method();
   int max_locals = moop->max_locals();
-  // Allocate temp buffer, 1 word per local & 2 per active monitor
-  int buf_size_words = max_locals + active_monitor_count*2;
+  // Allocate temp buffer, 1 word per local & 2 per monitor slot
+  int buf_size_words = max_locals + monitor_slots*2;
   intptr_t *buf = NEW_C_HEAP_ARRAY(intptr_t,buf_size_words, mtCode);
 
   // Copy the locals.  Order is preserved so that loading of longs works.
@@ -2998,8 +3003,8 @@ JRT_LEAF(intptr_t*, SharedRuntime::OSR_migration_begin( JavaThread *thread) )
 
   // Inflate locks.  Copy the displaced headers.  Be careful, there can be holes.
   int i = max_locals;
-  for( BasicObjectLock *kptr2 = fr.interpreter_frame_monitor_end();
-       kptr2 < fr.interpreter_frame_monitor_begin();
+  for( BasicObjectLock *kptr2 = monitor_end;
+       kptr2 < monitor_begin;
        kptr2 = fr.next_monitor_in_interpreter_frame(kptr2) ) {
     if( kptr2->obj() != NULL) {         // Avoid 'holes' in the monitor array
       BasicLock *lock = kptr2->lock();
@@ -3011,7 +3016,7 @@ JRT_LEAF(intptr_t*, SharedRuntime::OSR_migration_begin( JavaThread *thread) )
       buf[i++] = cast_from_oop<intptr_t>(kptr2->obj());
     }
   }
-  assert( i - max_locals == active_monitor_count*2, "found the expected number of monitors" );
+  assert( i <= buf_size_words, "found more monitors than slots" );
 
   return buf;
 JRT_END
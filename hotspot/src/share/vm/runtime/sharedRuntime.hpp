@@ -578,6 +578,8 @@ class SharedRuntime: AllStatic {
   static int     _nof_optimized_interface_calls; // total # of statically-bound interface calls
   static int     _nof_inlined_interface_calls;   // total # of inlined interface calls
   static int     _nof_megamorphic_interface_calls;// total # of megamorphic interface calls
+  static int     _nof_itable_cache_hits;         // megamorphic interface calls that hit UseItableCache
+  static int     _nof_itable_cache_misses;       // megamorphic interface calls that missed it
   // stats for runtime exceptions
   static int     _nof_removable_exceptions;      // total # of exceptions that could be replaced by branches due to inlining
 
@@ -591,6 +593,8 @@ class SharedRuntime: AllStatic {
   static address nof_optimized_interface_calls_addr()   { return (address)&_nof_optimized_interface_calls; }
   static address nof_inlined_interface_calls_addr()     { return (address)&_nof_inlined_interface_calls; }
   static address nof_megamorphic_interface_calls_addr() { return (address)&_nof_megamorphic_interface_calls; }
+  static address nof_itable_cache_hits_addr()           { return (address)&_nof_itable_cache_hits; }
+  static address nof_itable_cache_misses_addr()         { return (address)&_nof_itable_cache_misses; }
   static void print_call_statistics(int comp_total);
   static void print_statistics();
   static void print_ic_miss_histogram();
@@ -156,6 +156,9 @@ void SimpleThresholdPolicy::set_carry_if_necessary(InvocationCounter *counter) {
 void SimpleThresholdPolicy::handle_counter_overflow(Method* method) {
   MethodCounters *mcs = method->method_counters();
   if (mcs != NULL) {
+    if (UseStripedInvocationCounters) {
+      mcs->fold_invocation_stripes();
+    }
     set_carry_if_necessary(mcs->invocation_counter());
     set_carry_if_necessary(mcs->backedge_counter());
   }
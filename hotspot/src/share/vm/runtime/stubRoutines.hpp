@@ -216,9 +216,12 @@ class StubRoutines: AllStatic {
   static address _updateBytesCRC32;
   static address _crc_table_adr;
 
+  static address _updateBytesAdler32;
+
   static address _multiplyToLen;
   static address _squareToLen;
   static address _mulAdd;
+  static address _vectorizedMismatch;
   static address _montgomeryMultiply;
   static address _montgomerySquare;
 
@@ -381,9 +384,12 @@ class StubRoutines: AllStatic {
   static address updateBytesCRC32()    { return _updateBytesCRC32; }
   static address crc_table_addr()      { return _crc_table_adr; }
 
+  static address updateBytesAdler32()  { return _updateBytesAdler32; }
+
   static address multiplyToLen()       {return _multiplyToLen; }
   static address squareToLen()         {return _squareToLen; }
   static address mulAdd()              {return _mulAdd; }
+  static address vectorizedMismatch()  { return _vectorizedMismatch; }
   static address montgomeryMultiply()  { return _montgomeryMultiply; }
   static address montgomerySquare()    { return _montgomerySquare; }
 
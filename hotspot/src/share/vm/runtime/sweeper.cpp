@@ -142,6 +142,7 @@ int      NMethodSweeper::_zombified_count              = 0;    // Nof. nmethods
 int      NMethodSweeper::_marked_for_reclamation_count = 0;    // Nof. nmethods marked for reclaim in current sweep
 
 volatile bool NMethodSweeper::_should_sweep            = true; // Indicates if we should invoke the sweeper
+volatile bool NMethodSweeper::_swept_since_stack_scan  = false; // A sweep fraction ran since the last hotness scan
 volatile int  NMethodSweeper::_sweep_fractions_left    = 0;    // Nof. invocations left until we are completed with this pass
 volatile int  NMethodSweeper::_sweep_started           = 0;    // Flag to control conc sweeper
 volatile int  NMethodSweeper::_bytes_changed           = 0;    // Counts the total nmethod size if the nmethod changed from:
@@ -193,19 +194,40 @@ int NMethodSweeper::hotness_counter_reset_val() {
   }
   return _hotness_counter_reset_val;
 }
+
+// The fill ratio that drives flushing of nm.  With SegmentedCodeCache it is
+// the ratio of the code heap holding nm; profiled code is also flushed when
+// the non-profiled heap fills up, so that it is evicted before C2 code.
+double NMethodSweeper::reverse_free_ratio_for(nmethod* nm) {
+  if (!SegmentedCodeCache) {
+    return CodeCache::reverse_free_ratio();
+  }
+  int code_blob_type = CodeCache::get_code_blob_type(nm);
+  double ratio = CodeCache::reverse_free_ratio(code_blob_type);
+  if (code_blob_type == CodeBlobType::MethodProfiled) {
+    ratio = MAX2(ratio, CodeCache::reverse_free_ratio(CodeBlobType::MethodNonProfiled));
+  }
+  return ratio;
+}
 bool NMethodSweeper::sweep_in_progress() {
   return (_current != NULL);
 }
 
-// Scans the stacks of all Java threads and marks activations of not-entrant methods.
-// No need to synchronize access, since 'mark_active_nmethods' is always executed at a
-// safepoint.
-void NMethodSweeper::mark_active_nmethods() {
+// Returns the closure that marks activations of not-entrant methods, or only
+// resets hotness counters, when applied to the stacks of all Java threads.
+// The safepoint cleanup applies it, possibly from several worker threads;
+// both closures only store values that are the same for all threads.
+// No need to synchronize access, since this is always executed at a safepoint.
+// The marking is not done with Handshake::execute: without the opt-in,
+// x86_64-only ThreadLocalHandshakes a handshake is a safepoint anyway, and
+// can_convert_to_zombie() relies on a traversal seeing every stack at the
+// same point, which per-thread handshakes from a compiler thread do not give.
+CodeBlobClosure* NMethodSweeper::prepare_mark_active_nmethods() {
   assert(SafepointSynchronize::is_at_safepoint(), "must be executed at a safepoint");
   // If we do not want to reclaim not-entrant or zombie methods there is no need
   // to scan stacks
   if (!MethodFlushing) {
-    return;
+    return NULL;
   }
 
   // Increase time so that we can estimate when to invoke the sweeper again.
@@ -223,14 +245,18 @@ void NMethodSweeper::mark_active_nmethods() {
     if (PrintMethodFlushing) {
       tty->print_cr("### Sweep: stack traversal %d", _traversals);
     }
-    Threads::nmethods_do(&mark_activation_closure);
-
-  } else {
-    // Only set hotness counter
-    Threads::nmethods_do(&set_hotness_closure);
+    _swept_since_stack_scan = false;
+    return &mark_activation_closure;
   }
 
-  OrderAccess::storestore();
+  // Hotness counters are only decremented and read by sweep fractions, so
+  // the stacks need not be walked again until one has run.
+  if (!_swept_since_stack_scan) {
+    return NULL;
+  }
+  // Only set hotness counter
+  _swept_since_stack_scan = false;
+  return &set_hotness_closure;
 }
 /**
  * This function invokes the sweeper if at least one of the three conditions is met:
@@ -294,6 +320,8 @@ void NMethodSweeper::possibly_sweep() {
 #endif
 
     if (_sweep_fractions_left > 0) {
+      // Set first, so that safepoints the fraction yields to scan the stacks
+      _swept_since_stack_scan = true;
       sweep_code_cache();
       _sweep_fractions_left--;
     }
@@ -602,7 +630,7 @@ int NMethodSweeper::process_nmethod(nmethod *nm) {
         // ReservedCodeCacheSize
         int reset_val = hotness_counter_reset_val();
         int time_since_reset = reset_val - nm->hotness_counter();
-        double threshold = -reset_val + (CodeCache::reverse_free_ratio() * NmethodSweepActivity);
+        double threshold = -reset_val + (reverse_free_ratio_for(nm) * NmethodSweepActivity);
         // The less free space in the code cache we have - the bigger reverse_free_ratio() is.
         // I.e., 'threshold' increases with lower available space in the code cache and a higher
         // NmethodSweepActivity. If the current hotness counter - which decreases from its initial
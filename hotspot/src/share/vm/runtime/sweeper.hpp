@@ -26,18 +26,23 @@
 #define SHARE_VM_RUNTIME_SWEEPER_HPP
 
 #include "utilities/ticks.hpp"
+
+class CodeBlobClosure;
+
 // An NmethodSweeper is an incremental cleaner for:
 //    - cleanup inline caches
 //    - reclamation of nmethods
 // Removing nmethods from the code cache includes two operations
 //  1) mark active nmethods
-//     Is done in 'mark_active_nmethods()'. This function is called at a
-//     safepoint and marks all nmethods that are active on a thread's stack.
+//     Is set up by 'prepare_mark_active_nmethods()'. This function is called at
+//     a safepoint and returns the closure that the safepoint cleanup applies,
+//     possibly in parallel, to the stack of every Java thread to mark the
+//     nmethods that are active on it.
 //  2) sweep nmethods
 //     Is done in sweep_code_cache(). This function is the only place in the
 //     sweeper where memory is reclaimed. Note that sweep_code_cache() is not
 //     called at a safepoint. However, sweep_code_cache() stops executing if
-//     another thread requests a safepoint. Consequently, 'mark_active_nmethods()'
+//     another thread requests a safepoint. Consequently, stack marking
 //     and sweep_code_cache() cannot execute at the same time.
 //     To reclaim memory, nmethods are first marked as 'not-entrant'. Methods can
 //     be made not-entrant by (i) the sweeper, (ii) deoptimization, (iii) dependency
@@ -67,6 +72,7 @@ class NMethodSweeper : public AllStatic {
   static volatile int  _sweep_fractions_left;       // Nof. invocations left until we are completed with this pass
   static volatile int  _sweep_started;              // Flag to control conc sweeper
   static volatile bool _should_sweep;               // Indicates if we should invoke the sweeper
+  static volatile bool _swept_since_stack_scan;     // A sweep fraction ran since the last hotness scan
   static volatile int  _bytes_changed;              // Counts the total nmethod size if the nmethod changed from:
                                                     //   1) alive       -> not_entrant
                                                     //   2) not_entrant -> zombie
@@ -105,10 +111,11 @@ class NMethodSweeper : public AllStatic {
   static void report_events();
 #endif
 
-  static void mark_active_nmethods();      // Invoked at the end of each safepoint
+  static CodeBlobClosure* prepare_mark_active_nmethods(); // Invoked at each safepoint, NULL if no stack scan is needed
   static void possibly_sweep();            // Compiler threads call this to sweep
 
   static int hotness_counter_reset_val();
+  static double reverse_free_ratio_for(nmethod* nm);
   static void report_state_change(nmethod* nm);
   static void possibly_enable_sweeper();
   static void print();   // Printing/debugging
@@ -30,11 +30,13 @@
 #include "oops/oop.inline.hpp"
 #include "runtime/biasedLocking.hpp"
 #include "runtime/handles.inline.hpp"
+#include "runtime/handshake.hpp"
 #include "runtime/interfaceSupport.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/objectMonitor.hpp"
 #include "runtime/objectMonitor.inline.hpp"
 #include "runtime/osThread.hpp"
+#include "runtime/safepointMechanism.inline.hpp"
 #include "runtime/stubRoutines.hpp"
 #include "runtime/synchronizer.hpp"
 #include "runtime/thread.inline.hpp"
@@ -157,8 +159,32 @@ int ObjectSynchronizer::gOmInUseCount = 0;
 static volatile intptr_t ListLock = 0 ;      // protects global monitor free-list cache
 static volatile int MonitorFreeCount  = 0 ;      // # on gFreeList
 static volatile int MonitorPopulation = 0 ;      // # Extant -- in circulation
+// Monitors deflated by the async deflater wait here, protected by ListLock,
+// until every thread has passed a safepoint.  See deflate_idle_monitors().
+static ObjectMonitor * gWaitListHead = NULL ;
+static ObjectMonitor * gWaitListTail = NULL ;
+static int MonitorWaitCount = 0 ;               // # on gWaitList
+static jlong LastAsyncDeflationMillis = 0 ;
 #define CHAINMARKER (cast_to_oop<intptr_t>(-1))
 
+// Serializes a thread's updates of its omInUseList with the async deflater,
+// which unlinks deflated monitors from the lists of running threads.
+class OmInUseListLocker : public StackObj {
+ private:
+  Thread* _thread;
+ public:
+  OmInUseListLocker(Thread* thread) : _thread(AsyncDeflateIdleMonitors ? thread : NULL) {
+    if (_thread != NULL) {
+      Thread::SpinAcquire(&_thread->omInUseListLock, "omInUseListLock");
+    }
+  }
+  ~OmInUseListLocker() {
+    if (_thread != NULL) {
+      Thread::SpinRelease(&_thread->omInUseListLock);
+    }
+  }
+};
+
 // -----------------------------------------------------------------------------
 //  Fast Monitor Enter/Exit
 // This the fast monitor enter. The interpreter and compiler use
@@ -258,7 +284,10 @@ void ObjectSynchronizer::slow_enter(Handle obj, BasicLock* lock, TRAPS) {
   // must be non-zero to avoid looking like a re-entrant lock,
   // and must not look locked either.
   lock->set_displaced_header(markOopDesc::unused_mark());
-  ObjectSynchronizer::inflate(THREAD, obj())->enter(THREAD);
+  // An async deflation of the monitor makes enter() fail; re-inflate.
+  while (!ObjectSynchronizer::inflate(THREAD, obj())->enter(THREAD)) {
+    TEVENT (slow_enter: retry after async deflation) ;
+  }
 }
 
 // This routine is used to handle interpreter/compiler slow case
@@ -301,9 +330,10 @@ void ObjectSynchronizer::reenter(Handle obj, intptr_t recursion, TRAPS) {
     assert(!obj->mark()->has_bias_pattern(), "biases should be revoked by now");
   }
 
-  ObjectMonitor* monitor = ObjectSynchronizer::inflate(THREAD, obj());
-
-  monitor->reenter(recursion, THREAD);
+  // An async deflation of the monitor makes reenter() fail; re-inflate.
+  while (!ObjectSynchronizer::inflate(THREAD, obj())->reenter(recursion, THREAD)) {
+    TEVENT (reenter: retry after async deflation) ;
+  }
 }
 // -----------------------------------------------------------------------------
 // JNI locks on java objects
@@ -316,7 +346,9 @@ void ObjectSynchronizer::jni_enter(Handle obj, TRAPS) { // possible entry from j
     assert(!obj->mark()->has_bias_pattern(), "biases should be revoked by now");
   }
   THREAD->set_current_pending_monitor_is_from_java(false);
-  ObjectSynchronizer::inflate(THREAD, obj())->enter(THREAD);
+  while (!ObjectSynchronizer::inflate(THREAD, obj())->enter(THREAD)) {
+    TEVENT (jni_enter: retry after async deflation) ;
+  }
   THREAD->set_current_pending_monitor_is_from_java(true);
 }
 
@@ -649,22 +681,43 @@ intptr_t ObjectSynchronizer::FastHashCode (Thread * Self, oop obj) {
       return hash;
     }
     hash = get_next_hash(Self, obj);  // allocate a new hash code
-    temp = mark->copy_set_hash(hash); // merge the hash code into header
-    // use (machine word version) atomic operation to install the hash
-    test = (markOop) Atomic::cmpxchg_ptr(temp, obj->mark_addr(), mark);
-    if (test == mark) {
-      return hash;
+    for (;;) {
+      temp = mark->copy_set_hash(hash); // merge the hash code into header
+      // use (machine word version) atomic operation to install the hash
+      test = (markOop) Atomic::cmpxchg_ptr(temp, obj->mark_addr(), mark);
+      if (test == mark) {
+        return hash;
+      }
+      // If the header is still neutral, another thread hashed the
+      // object first, or locked and unlocked it meanwhile. Neither
+      // needs a monitor, so take its hash or try again.
+      if (!test->is_neutral()) {
+        break;
+      }
+      if (test->hash() != 0) {
+        return test->hash();
+      }
+      mark = test;
     }
-    // If atomic operation failed, we must inflate the header
-    // into heavy weight monitor. We could add more code here
-    // for fast path, but it does not worth the complexity.
+    // The object got locked meanwhile, so we must inflate the header
+    // into heavy weight monitor to install the hash.
   } else if (mark->has_monitor()) {
     monitor = mark->monitor();
     temp = monitor->header();
     assert (temp->is_neutral(), "invariant") ;
     hash = temp->hash();
     if (hash) {
-      return hash;
+      if (!AsyncDeflateIdleMonitors) {
+        return hash;
+      }
+      // The header read may race with the async deflater restoring it
+      // into the object; only trust it if the monitor is not going away,
+      // otherwise take the slow path below.
+      OrderAccess::fence();
+      if (!monitor->is_being_async_deflated()) {
+        return hash;
+      }
+      monitor->install_displaced_markword_in_object(obj);
     }
     // Skip to the following code to reduce code size
   } else if (Self->is_lock_owned((address)mark->locker())) {
@@ -685,28 +738,41 @@ intptr_t ObjectSynchronizer::FastHashCode (Thread * Self, oop obj) {
     // correctly.
   }
 
-  // Inflate the monitor to set hash code
-  monitor = ObjectSynchronizer::inflate(Self, obj);
-  // Load displaced header and check it has hash code
-  mark = monitor->header();
-  assert (mark->is_neutral(), "invariant") ;
-  hash = mark->hash();
-  if (hash == 0) {
-    hash = get_next_hash(Self, obj);
-    temp = mark->copy_set_hash(hash); // merge hash code into header
-    assert (temp->is_neutral(), "invariant") ;
-    test = (markOop) Atomic::cmpxchg_ptr(temp, monitor, mark);
-    if (test != mark) {
-      // The only update to the header in the monitor (outside GC)
-      // is install the hash code. If someone add new usage of
-      // displaced header, please update this code
-      hash = test->hash();
-      assert (test->is_neutral(), "invariant") ;
-      assert (hash != 0, "Trivial unexpected object/monitor header usage.");
+  for (;;) {
+    // Inflate the monitor to set hash code
+    monitor = ObjectSynchronizer::inflate(Self, obj);
+    // Load displaced header and check it has hash code
+    mark = monitor->header();
+    assert (mark->is_neutral(), "invariant") ;
+    hash = mark->hash();
+    if (hash == 0) {
+      hash = get_next_hash(Self, obj);
+      temp = mark->copy_set_hash(hash); // merge hash code into header
+      assert (temp->is_neutral(), "invariant") ;
+      test = (markOop) Atomic::cmpxchg_ptr(temp, monitor, mark);
+      if (test != mark) {
+        // The only update to the header in the monitor (outside GC)
+        // is install the hash code. If someone add new usage of
+        // displaced header, please update this code
+        hash = test->hash();
+        assert (test->is_neutral(), "invariant") ;
+        assert (hash != 0, "Trivial unexpected object/monitor header usage.");
+      }
     }
+    if (AsyncDeflateIdleMonitors) {
+      // The async deflater may have restored the object's header from
+      // the monitor before the hash was installed in it.  If the monitor
+      // is being deflated, make sure the header is restored and retry
+      // against the restored (or re-inflated) header.
+      OrderAccess::fence();
+      if (monitor->is_being_async_deflated()) {
+        monitor->install_displaced_markword_in_object(obj);
+        continue;
+      }
+    }
+    // We finally get the hash
+    return hash;
   }
-  // We finally get the hash
-  return hash;
 }
 
 // Deprecated -- use FastHashCode() instead.
@@ -778,7 +844,7 @@ ObjectSynchronizer::LockOwnership ObjectSynchronizer::query_lock_ownership
   // not at a safepoint.
   if (mark->has_monitor()) {
     void * owner = mark->monitor()->_owner ;
-    if (owner == NULL) return owner_none ;
+    if (owner == NULL || owner == DEFLATER_MARKER) return owner_none ;
     return (owner == self ||
             self->is_lock_owned((address)owner)) ? owner_self : owner_other;
   }
@@ -814,6 +880,9 @@ JavaThread* ObjectSynchronizer::get_lock_owner(Handle h_obj, bool doLock) {
     ObjectMonitor* monitor = mark->monitor();
     assert(monitor != NULL, "monitor should be non-null");
     owner = (address) monitor->owner();
+    if (owner == (address) DEFLATER_MARKER) {
+      owner = NULL;
+    }
   }
 
   if (owner != NULL) {
@@ -916,6 +985,13 @@ static void InduceScavenge (Thread * Self, const char * Whence) {
   // of active monitors passes the specified threshold.
   // TODO: assert thread state is reasonable
 
+  if (AsyncDeflateIdleMonitors) {
+    // The service thread notices the request, see is_async_deflation_needed(),
+    // and deflates without a safepoint.
+    ForceMonitorScavenge = 1 ;
+    return ;
+  }
+
   if (ForceMonitorScavenge == 0 && Atomic::xchg (1, &ForceMonitorScavenge) == 0) {
     if (ObjectMonitor::Knob_Verbose) {
       ::printf ("Monitor scavenge - Induced STW @%s (%d)\n", Whence, ForceMonitorScavenge) ;
@@ -972,6 +1048,7 @@ ObjectMonitor * ATTR ObjectSynchronizer::omAlloc (Thread * Self) {
            // CONSIDER: set m->FreeNext = BAD -- diagnostic hygiene
            guarantee (m->object() == NULL, "invariant") ;
            if (MonitorInUseLists) {
+             OmInUseListLocker ioul(Self);
              m->FreeNext = Self->omInUseList;
              Self->omInUseList = m;
              Self->omInUseCount ++;
@@ -997,6 +1074,13 @@ ObjectMonitor * ATTR ObjectSynchronizer::omAlloc (Thread * Self) {
                 ObjectMonitor * take = gFreeList ;
                 gFreeList = take->FreeNext ;
                 guarantee (take->object() == NULL, "invariant") ;
+                if (take->owner() == DEFLATER_MARKER) {
+                  // Deflated by the async deflater.  No thread refers to
+                  // it any more, so clear the deflation state.
+                  guarantee (take->count() < 0, "invariant") ;
+                  take->set_owner(NULL) ;
+                  take->set_count(0) ;
+                }
                 guarantee (!take->is_busy(), "invariant") ;
                 take->Recycle() ;
                 omRelease (Self, take, false) ;
@@ -1087,6 +1171,7 @@ void ObjectSynchronizer::omRelease (Thread * Self, ObjectMonitor * m, bool fromP
 
     // Remove from omInUseList
     if (MonitorInUseLists && fromPerThreadAlloc) {
+      OmInUseListLocker ioul(Self);
       ObjectMonitor* curmidinuse = NULL;
       for (ObjectMonitor* mid = Self->omInUseList; mid != NULL; ) {
        if (m == mid) {
@@ -1233,7 +1318,9 @@ ObjectMonitor * ATTR ObjectSynchronizer::inflate (Thread * Self, oop object) {
       if (mark->has_monitor()) {
           ObjectMonitor * inf = mark->monitor() ;
           assert (inf->header()->is_neutral(), "invariant");
-          assert (inf->object() == object, "invariant") ;
+          // An async deflation may have cleared the object already; the
+          // caller notices when it tries to use the monitor.
+          assert (AsyncDeflateIdleMonitors || inf->object() == object, "invariant") ;
           assert (ObjectSynchronizer::verify_objmon_isinpool(inf), "monitor is invalid");
           return inf ;
       }
@@ -1524,8 +1611,43 @@ int ObjectSynchronizer::walk_monitor_list(ObjectMonitor** listheadp,
   return deflatedcount;
 }
 
-void ObjectSynchronizer::deflate_idle_monitors() {
+void ObjectSynchronizer::prepare_deflate_idle_monitors(DeflateMonitorCounters* counters) {
+  counters->nInuse = 0 ;            // currently associated with objects
+  counters->nInCirculation = 0 ;    // extant
+  counters->nScavenged = 0 ;        // reclaimed
+}
+
+// Deflate the idle monitors that are not on the in-use list of a live
+// thread: those on gOmInUseList, or all extant monitors without
+// -XX:+MonitorInUseLists.  The per-thread lists are handled by
+// deflate_thread_local_monitors(), possibly in parallel with this.
+void ObjectSynchronizer::deflate_idle_monitors(DeflateMonitorCounters* counters) {
   assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
+
+  if (AsyncDeflateIdleMonitors) {
+    // Idle monitors are deflated by the service thread, see
+    // deflate_idle_monitors_using_JT().  Every thread has passed this
+    // safepoint since the monitors on the wait list were deflated, so no
+    // thread can still refer to them and they can be reused.
+    Thread::muxAcquire (&ListLock, "deflate_idle_monitors: wait list") ;
+    if (gWaitListHead != NULL) {
+      guarantee (gWaitListTail != NULL && MonitorWaitCount > 0, "invariant") ;
+      gWaitListTail->FreeNext = gFreeList ;
+      gFreeList = gWaitListHead ;
+      MonitorFreeCount += MonitorWaitCount ;
+      gWaitListHead = NULL ;
+      gWaitListTail = NULL ;
+      MonitorWaitCount = 0 ;
+    }
+    Thread::muxRelease (&ListLock) ;
+
+    if (is_async_deflation_needed()) {
+      MutexLockerEx ml(Service_lock, Mutex::_no_safepoint_check_flag);
+      Service_lock->notify_all();
+    }
+    return;
+  }
+
   int nInuse = 0 ;              // currently associated with objects
   int nInCirculation = 0 ;      // extant
   int nScavenged = 0 ;          // reclaimed
@@ -1541,16 +1663,6 @@ void ObjectSynchronizer::deflate_idle_monitors() {
   Thread::muxAcquire (&ListLock, "scavenge - return") ;
 
   if (MonitorInUseLists) {
-    int inUse = 0;
-    for (JavaThread* cur = Threads::first(); cur != NULL; cur = cur->next()) {
-      nInCirculation+= cur->omInUseCount;
-      int deflatedcount = walk_monitor_list(cur->omInUseList_addr(), &FreeHead, &FreeTail);
-      cur->omInUseCount-= deflatedcount;
-      // verifyInUse(cur);
-      nScavenged += deflatedcount;
-      nInuse += cur->omInUseCount;
-     }
-
    // For moribund threads, scan gOmInUseList
    if (gOmInUseList) {
      nInCirculation += gOmInUseCount;
@@ -1595,15 +1707,6 @@ void ObjectSynchronizer::deflate_idle_monitors() {
 
   // Consider: audit gFreeList to ensure that MonitorFreeCount and list agree.
 
-  if (ObjectMonitor::Knob_Verbose) {
-    ::printf ("Deflate: InCirc=%d InUse=%d Scavenged=%d ForceMonitorScavenge=%d : pop=%d free=%d\n",
-        nInCirculation, nInuse, nScavenged, ForceMonitorScavenge,
-        MonitorPopulation, MonitorFreeCount) ;
-    ::fflush(stdout) ;
-  }
-
-  ForceMonitorScavenge = 0;    // Reset
-
   // Move the scavenged monitors back to the global free list.
   if (FreeHead != NULL) {
      guarantee (FreeTail != NULL && nScavenged > 0, "invariant") ;
@@ -1614,8 +1717,60 @@ void ObjectSynchronizer::deflate_idle_monitors() {
   }
   Thread::muxRelease (&ListLock) ;
 
-  if (ObjectMonitor::_sync_Deflations != NULL) ObjectMonitor::_sync_Deflations->inc(nScavenged) ;
-  if (ObjectMonitor::_sync_MonExtant  != NULL) ObjectMonitor::_sync_MonExtant ->set_value(nInCirculation);
+  Atomic::add(nInuse, &counters->nInuse);
+  Atomic::add(nInCirculation, &counters->nInCirculation);
+  Atomic::add(nScavenged, &counters->nScavenged);
+}
+
+// Deflate the idle monitors on the in-use list of a live thread.  The
+// lists of different threads can be deflated in parallel: a thread on
+// the thread list cannot be running omFlush() at a safepoint.
+void ObjectSynchronizer::deflate_thread_local_monitors(Thread* thread, DeflateMonitorCounters* counters) {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
+  if (!MonitorInUseLists || AsyncDeflateIdleMonitors) {
+    return;
+  }
+
+  ObjectMonitor * FreeHead = NULL ;  // Local SLL of scavenged monitors
+  ObjectMonitor * FreeTail = NULL ;
+
+  int nInCirculation = thread->omInUseCount;
+  int deflatedcount = walk_monitor_list(thread->omInUseList_addr(), &FreeHead, &FreeTail);
+  thread->omInUseCount -= deflatedcount;
+  // verifyInUse(thread);
+
+  Atomic::add(nInCirculation, &counters->nInCirculation);
+  Atomic::add(thread->omInUseCount, &counters->nInuse);
+  Atomic::add(deflatedcount, &counters->nScavenged);
+
+  if (FreeHead != NULL) {
+    guarantee (FreeTail != NULL && deflatedcount > 0, "invariant") ;
+    assert (FreeTail->FreeNext == NULL, "invariant") ;
+    // Move the scavenged monitors back to the global free list.
+    Thread::muxAcquire (&ListLock, "deflate_thread_local_monitors") ;
+    FreeTail->FreeNext = gFreeList ;
+    gFreeList = FreeHead ;
+    MonitorFreeCount += deflatedcount;
+    Thread::muxRelease (&ListLock) ;
+  }
+}
+
+void ObjectSynchronizer::finish_deflate_idle_monitors(DeflateMonitorCounters* counters) {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
+
+  if (!AsyncDeflateIdleMonitors) {
+    if (ObjectMonitor::Knob_Verbose) {
+      ::printf ("Deflate: InCirc=%d InUse=%d Scavenged=%d ForceMonitorScavenge=%d : pop=%d free=%d\n",
+          counters->nInCirculation, counters->nInuse, counters->nScavenged, ForceMonitorScavenge,
+          MonitorPopulation, MonitorFreeCount) ;
+      ::fflush(stdout) ;
+    }
+
+    ForceMonitorScavenge = 0;    // Reset
+
+    if (ObjectMonitor::_sync_Deflations != NULL) ObjectMonitor::_sync_Deflations->inc(counters->nScavenged) ;
+    if (ObjectMonitor::_sync_MonExtant  != NULL) ObjectMonitor::_sync_MonExtant ->set_value(counters->nInCirculation);
+  }
 
   // TODO: Add objectMonitor leak detection.
   // Audit/inventory the objectMonitors -- make sure they're all accounted for.
@@ -1623,6 +1778,259 @@ void ObjectSynchronizer::deflate_idle_monitors() {
   GVars.stwCycle ++ ;
 }
 
+// -----------------------------------------------------------------------------
+// Async deflation of idle monitors
+//
+// With -XX:+AsyncDeflateIdleMonitors the service thread deflates idle
+// monitors while Java threads are running.  The protocol has two steps:
+//
+// 1) The deflater CASes DEFLATER_MARKER into the owner field of an idle
+//    monitor.  A monitor owned by DEFLATER_MARKER cannot be acquired by
+//    the uncontended paths in the interpreter, compiled code or enter().
+// 2) The deflater CASes _count from 0 to -max_jint.  enter() increments
+//    _count before it blocks on a monitor, so a successful CAS proves that
+//    no thread is contending for the monitor and a thread that increments
+//    _count afterwards sees a negative value and retries with a freshly
+//    inflated monitor.
+//
+// If a thread starts contending between the two steps the deflater backs
+// out; the contender may also take the monitor over from DEFLATER_MARKER,
+// see ObjectMonitor::TryLockContended().  Deflated monitors keep their
+// displaced header so that racing threads can restore the object's mark,
+// and are not reused until every thread has passed a handshake or a
+// safepoint.
+
+bool ObjectSynchronizer::is_async_deflation_needed() {
+  if (!AsyncDeflateIdleMonitors) {
+    return false;
+  }
+  if (ForceMonitorScavenge != 0) {
+    // MonitorBound has been exceeded, see InduceScavenge().
+    return true;
+  }
+  if (MonitorUsedDeflationThreshold <= 0 || MonitorPopulation == 0) {
+    return false;
+  }
+  if (os::javaTimeMillis() - LastAsyncDeflationMillis < AsyncDeflationInterval) {
+    return false;
+  }
+  jlong monitors_used = MonitorPopulation - MonitorFreeCount;
+  return monitors_used * 100 / MonitorPopulation > MonitorUsedDeflationThreshold;
+}
+
+// Back out of a deflation attempt after step 1 of the protocol.
+void ObjectSynchronizer::restore_owner_after_failed_deflation(ObjectMonitor* mid) {
+  if (Atomic::cmpxchg_ptr(NULL, &mid->_owner, DEFLATER_MARKER) != DEFLATER_MARKER) {
+    // A contending thread took the monitor over from us and added an
+    // extra contention count on our behalf.
+    Atomic::dec_ptr(&mid->_count);
+    return;
+  }
+  // An exiting owner does not wake a successor if the deflater appears to
+  // own the monitor.  Act as a transient owner so that exit() hands the
+  // monitor to one of the stranded threads.
+  OrderAccess::fence();
+  if ((mid->_cxq != NULL || mid->_EntryList != NULL) && mid->_succ == NULL) {
+    Thread* self = Thread::current();
+    if (Atomic::cmpxchg_ptr(self, &mid->_owner, NULL) == NULL) {
+      TEVENT (deflate_monitor_using_JT - wake stranded entrant) ;
+      mid->exit(true, self);
+    }
+  }
+}
+
+// Deflate a single monitor without a safepoint.
+// Return true if deflated, false if in use
+bool ObjectSynchronizer::deflate_monitor_using_JT(ObjectMonitor* mid,
+                                                  ObjectMonitor** FreeHeadp, ObjectMonitor** FreeTailp) {
+  assert(AsyncDeflateIdleMonitors, "sanity");
+  assert(JavaThread::current()->thread_state() == _thread_in_vm, "must be in VM");
+
+  oop obj = (oop) mid->object();
+  if (obj == NULL || obj->mark() != markOopDesc::encode(mid)) {
+    // Free, not yet published by the inflating thread, or about to be
+    // released after a lost inflation race.
+    return false;
+  }
+  if (mid->is_busy()) {
+    return false;
+  }
+
+  if (Atomic::cmpxchg_ptr(DEFLATER_MARKER, &mid->_owner, NULL) != NULL) {
+    // Somebody acquired the monitor after the is_busy() check.
+    return false;
+  }
+
+  // A waiter holds on to the monitor without a contention count, a
+  // contender holds a count.
+  if (mid->_waiters != 0 ||
+      Atomic::cmpxchg_ptr((intptr_t) -max_jint, &mid->_count, (intptr_t) 0) != 0) {
+    restore_owner_after_failed_deflation(mid);
+    return false;
+  }
+
+  // The monitor is deflated.  Entering threads queue up only after they
+  // have incremented _count, so the queues must be empty.
+  guarantee (mid->_owner == DEFLATER_MARKER, "invariant") ;
+  guarantee (mid->_cxq == NULL && mid->_EntryList == NULL, "invariant") ;
+  guarantee (mid->_waiters == 0 && mid->_WaitSet == NULL, "invariant") ;
+
+  TEVENT (deflate_monitor_using_JT - scavenge) ;
+  if (TraceMonitorInflation) {
+    if (obj->is_instance()) {
+      ResourceMark rm;
+      tty->print_cr("Async deflating object " INTPTR_FORMAT " , mark " INTPTR_FORMAT " , type %s",
+                    (void *) obj, (intptr_t) obj->mark(), obj->klass()->external_name());
+    }
+  }
+
+  // Restore the header back to obj.  Threads that lose the race against
+  // the deflater may have done so already.
+  mid->install_displaced_markword_in_object(obj);
+  mid->clear_using_JT();
+
+  // Move the object to the working free list defined by FreeHead,FreeTail.
+  if (*FreeHeadp == NULL) *FreeHeadp = mid;
+  if (*FreeTailp != NULL) {
+    ObjectMonitor * prevtail = *FreeTailp;
+    assert(prevtail->FreeNext == NULL, "cleaned up deflated?");
+    prevtail->FreeNext = mid;
+  }
+  *FreeTailp = mid;
+  return true;
+}
+
+// Caller holds the lock protecting the list: the thread's omInUseListLock
+// or, for gOmInUseList, ListLock.
+int ObjectSynchronizer::walk_monitor_list_using_JT(ObjectMonitor** listheadp,
+                                                   ObjectMonitor** FreeHeadp, ObjectMonitor** FreeTailp) {
+  ObjectMonitor* mid;
+  ObjectMonitor* next;
+  ObjectMonitor* curmidinuse = NULL;
+  int deflatedcount = 0;
+
+  for (mid = *listheadp; mid != NULL; ) {
+    if (deflate_monitor_using_JT(mid, FreeHeadp, FreeTailp)) {
+      // extract from the in-use list
+      if (mid == *listheadp) {
+        *listheadp = mid->FreeNext;
+      } else if (curmidinuse != NULL) {
+        curmidinuse->FreeNext = mid->FreeNext;
+      }
+      next = mid->FreeNext;
+      mid->FreeNext = NULL;  // This mid is current tail in the FreeHead list
+      mid = next;
+      deflatedcount++;
+    } else {
+      curmidinuse = mid;
+      mid = mid->FreeNext;
+    }
+  }
+  return deflatedcount;
+}
+
+// No-op handshake: once every thread has executed it, no thread can
+// still refer to a monitor deflated before the handshake.
+class DeflatedMonitorsHandshakeClosure : public ThreadClosure {
+ public:
+  void do_thread(Thread* thread) {}
+};
+
+void ObjectSynchronizer::deflate_idle_monitors_using_JT() {
+  assert(AsyncDeflateIdleMonitors, "sanity");
+  JavaThread* self = JavaThread::current();
+  int nInCirculation = 0 ;      // extant
+  int nScavenged = 0 ;          // reclaimed
+
+  ObjectMonitor * FreeHead = NULL ;  // Local SLL of scavenged monitors
+  ObjectMonitor * FreeTail = NULL ;
+
+  TEVENT (deflate_idle_monitors_using_JT) ;
+
+  // Threads_lock keeps the scanned threads alive: a thread hands its
+  // in-use list over to gOmInUseList only after it has been removed from
+  // the thread list.  The lock is dropped to let a pending VM operation,
+  // which may need the lock to start a safepoint, or a pending handshake
+  // proceed, and the scan resumes with the next thread.
+  int resume_index = 0;
+  bool done = false;
+  while (!done) {
+    {
+      MutexLocker ml(Threads_lock);
+      done = true;
+      int index = 0;
+      for (JavaThread* cur = Threads::first(); cur != NULL; cur = cur->next(), index++) {
+        if (index < resume_index) {
+          continue;
+        }
+        Thread::SpinAcquire(&cur->omInUseListLock, "omInUseListLock");
+        nInCirculation += cur->omInUseCount;
+        int deflatedcount = walk_monitor_list_using_JT(cur->omInUseList_addr(), &FreeHead, &FreeTail);
+        cur->omInUseCount -= deflatedcount;
+        Thread::SpinRelease(&cur->omInUseListLock);
+        nScavenged += deflatedcount;
+        resume_index = index + 1;
+        if (VMThread::vm_operation() != NULL || SafepointMechanism::should_block(self)) {
+          done = false;
+          break;
+        }
+      }
+    }
+    if (!done) {
+      ThreadBlockInVM tbivm(self);
+    }
+  }
+
+  // For moribund threads, scan gOmInUseList
+  Thread::muxAcquire (&ListLock, "deflate_idle_monitors_using_JT") ;
+  if (gOmInUseList != NULL) {
+    nInCirculation += gOmInUseCount;
+    int deflatedcount = walk_monitor_list_using_JT((ObjectMonitor **)&gOmInUseList, &FreeHead, &FreeTail);
+    gOmInUseCount -= deflatedcount;
+    nScavenged += deflatedcount;
+  }
+  Thread::muxRelease (&ListLock) ;
+
+  if (FreeHead != NULL) {
+    guarantee (FreeTail != NULL && nScavenged > 0, "invariant") ;
+    assert (FreeTail->FreeNext == NULL, "invariant") ;
+    if (SafepointMechanism::uses_thread_local_poll()) {
+      // Wait until no thread can refer to the deflated monitors any more
+      // and return them to the global free list.
+      DeflatedMonitorsHandshakeClosure hs_cl;
+      Handshake::execute(&hs_cl);
+      Thread::muxAcquire (&ListLock, "deflate_idle_monitors_using_JT: free") ;
+      FreeTail->FreeNext = gFreeList ;
+      gFreeList = FreeHead ;
+      MonitorFreeCount += nScavenged;
+      Thread::muxRelease (&ListLock) ;
+    } else {
+      // The next safepoint returns them to the global free list.
+      Thread::muxAcquire (&ListLock, "deflate_idle_monitors_using_JT: wait") ;
+      FreeTail->FreeNext = gWaitListHead ;
+      if (gWaitListTail == NULL) {
+        gWaitListTail = FreeTail ;
+      }
+      gWaitListHead = FreeHead ;
+      MonitorWaitCount += nScavenged ;
+      Thread::muxRelease (&ListLock) ;
+    }
+  }
+
+  if (ObjectMonitor::Knob_Verbose) {
+    ::printf ("Async deflate: InCirc=%d Scavenged=%d ForceMonitorScavenge=%d : pop=%d free=%d\n",
+        nInCirculation, nScavenged, ForceMonitorScavenge,
+        MonitorPopulation, MonitorFreeCount) ;
+    ::fflush(stdout) ;
+  }
+
+  LastAsyncDeflationMillis = os::javaTimeMillis();
+  ForceMonitorScavenge = 0;    // Reset
+
+  if (ObjectMonitor::_sync_Deflations != NULL) ObjectMonitor::_sync_Deflations->inc(nScavenged) ;
+  if (ObjectMonitor::_sync_MonExtant  != NULL) ObjectMonitor::_sync_MonExtant ->set_value(nInCirculation);
+}
+
 // Monitor cleanup on JavaThread::exit
 
 // Iterate through monitor cache and attempt to release thread's monitors
@@ -34,6 +34,12 @@
 
 class ObjectMonitor;
 
+struct DeflateMonitorCounters {
+  volatile int nInuse;              // currently associated with objects
+  volatile int nInCirculation;      // extant
+  volatile int nScavenged;          // reclaimed
+};
+
 class ObjectSynchronizer : AllStatic {
   friend class VMStructs;
  public:
@@ -112,12 +118,27 @@ class ObjectSynchronizer : AllStatic {
   // GC: we current use aggressive monitor deflation policy
   // Basically we deflate all monitors that are not busy.
   // An adaptive profile-based deflation policy could be used if needed
-  static void deflate_idle_monitors();
+  // The per-thread lists may be deflated in parallel between the prepare
+  // and finish steps.  See SafepointSynchronize::do_cleanup_tasks().
+  static void prepare_deflate_idle_monitors(DeflateMonitorCounters* counters);
+  static void deflate_idle_monitors(DeflateMonitorCounters* counters);
+  static void deflate_thread_local_monitors(Thread* thread, DeflateMonitorCounters* counters);
+  static void finish_deflate_idle_monitors(DeflateMonitorCounters* counters);
   static int walk_monitor_list(ObjectMonitor** listheadp,
                                ObjectMonitor** FreeHeadp,
                                ObjectMonitor** FreeTailp);
   static bool deflate_monitor(ObjectMonitor* mid, oop obj, ObjectMonitor** FreeHeadp,
                               ObjectMonitor** FreeTailp);
+
+  // -XX:+AsyncDeflateIdleMonitors: deflate idle monitors in the service
+  // thread while Java threads are running.
+  static bool is_async_deflation_needed();
+  static void deflate_idle_monitors_using_JT();
+  static int walk_monitor_list_using_JT(ObjectMonitor** listheadp,
+                                        ObjectMonitor** FreeHeadp,
+                                        ObjectMonitor** FreeTailp);
+  static bool deflate_monitor_using_JT(ObjectMonitor* mid, ObjectMonitor** FreeHeadp,
+                                       ObjectMonitor** FreeTailp);
   static void oops_do(OopClosure* f);
 
   // debugging
@@ -136,6 +157,8 @@ class ObjectSynchronizer : AllStatic {
   static ObjectMonitor * volatile gOmInUseList; // for moribund thread, so monitors they inflated still get scanned
   static int gOmInUseCount;
 
+  static void restore_owner_after_failed_deflation(ObjectMonitor* mid);
+
 };
 
 // ObjectLocker enforced balanced locking and can never thrown an
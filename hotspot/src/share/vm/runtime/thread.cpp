@@ -24,11 +24,13 @@
 
 #include "precompiled.hpp"
 #include "classfile/classLoader.hpp"
+#include "classfile/classPreloader.hpp"
 #include "classfile/javaClasses.hpp"
 #include "classfile/systemDictionary.hpp"
 #include "classfile/vmSymbols.hpp"
 #include "code/scopeDesc.hpp"
 #include "compiler/compileBroker.hpp"
+#include "compiler/compileDecisionCache.hpp"
 #include "interpreter/interpreter.hpp"
 #include "interpreter/linkResolver.hpp"
 #include "interpreter/oopMapCache.hpp"
@@ -39,6 +41,7 @@
 #include "memory/oopFactory.hpp"
 #include "memory/universe.inline.hpp"
 #include "oops/instanceKlass.hpp"
+#include "oops/methodCounters.hpp"
 #include "oops/objArrayOop.hpp"
 #include "oops/oop.inline.hpp"
 #include "oops/symbol.hpp"
@@ -46,7 +49,9 @@
 #include "prims/jvmtiExport.hpp"
 #include "prims/jvmtiThreadState.hpp"
 #include "prims/privilegedStack.hpp"
+#include "prims/unsafeMemory.hpp"
 #include "runtime/arguments.hpp"
+#include "runtime/asyncGCLogWriter.hpp"
 #include "runtime/biasedLocking.hpp"
 #include "runtime/deoptimization.hpp"
 #include "runtime/fprofiler.hpp"
@@ -62,6 +67,7 @@
 #include "runtime/orderAccess.inline.hpp"
 #include "runtime/osThread.hpp"
 #include "runtime/safepoint.hpp"
+#include "runtime/safepointMechanism.inline.hpp"
 #include "runtime/sharedRuntime.hpp"
 #include "runtime/statSampler.hpp"
 #include "runtime/stubRoutines.hpp"
@@ -230,6 +236,11 @@ Thread::Thread() {
 
   // allocated data structures
   set_osthread(NULL);
+  for (int i = 0; i < Chunk::num_thread_cached_sizes; i++) {
+    _cached_chunks[i] = NULL;
+  }
+  _chunk_cache_enabled = true;
+  _unsafe_memory_cache = NULL;
   set_resource_area(new (mtThread)ResourceArea());
   DEBUG_ONLY(_current_resource_mark = NULL;)
   set_handle_area(new (mtThread) HandleArea(NULL));
@@ -264,6 +275,7 @@ Thread::Thread() {
   omFreeProvision = 32 ;
   omInUseList = NULL ;
   omInUseCount = 0 ;
+  omInUseListLock = 0 ;
 
 #ifdef ASSERT
   _visited_for_critical_count = false;
@@ -271,6 +283,7 @@ Thread::Thread() {
 
   _SR_lock = new Monitor(Mutex::suspend_resume, "SR_lock", true);
   _suspend_flags = 0;
+  _polling_page = NULL;
 
   // thread-specific hashCode stream generator state - Marsaglia shift-xor form
   _hashStateX = os::random() ;
@@ -278,6 +291,10 @@ Thread::Thread() {
   _hashStateZ = 0x8767 ;    // (int)(3579807591LL & 0xffff) ;
   _hashStateW = 273326509 ;
 
+  // xorshift state must never be zero
+  _profile_sample_seed = (juint) os::random() | 1;
+  _invocation_counter_stripe = MethodCounters::next_invocation_stripe();
+
   _OnTrap   = 0 ;
   _schedctl = NULL ;
   _Stalled  = 0 ;
@@ -348,6 +365,15 @@ void Thread::record_stack_base_and_size() {
 }
 
 
+void Thread::flush_chunk_cache() {
+  _chunk_cache_enabled = false;
+  for (int i = 0; i < Chunk::num_thread_cached_sizes; i++) {
+    Chunk* c = _cached_chunks[i];
+    _cached_chunks[i] = NULL;
+    delete c;
+  }
+}
+
 Thread::~Thread() {
   // Reclaim the objectmonitors from the omFreeList of the moribund thread.
   ObjectSynchronizer::omFlush (this) ;
@@ -384,6 +410,10 @@ Thread::~Thread() {
   delete handle_area();
   delete metadata_handles();
 
+  // Return the chunks this thread kept to the global pools
+  flush_chunk_cache();
+  UnsafeMemory::flush_thread_cache(this);
+
   // osthread() can be NULL, if creation of thread failed.
   if (osthread() != NULL) os::free_thread(osthread());
 
@@ -1497,6 +1527,7 @@ void JavaThread::initialize() {
   _in_deopt_handler = 0;
   _doing_unsafe_access = false;
   _stack_guard_state = stack_guard_unused;
+  SafepointMechanism::initialize_header(this);
   _reserved_stack_activation = NULL;  // stack base not known yet
   (void)const_cast<oop&>(_exception_oop = oop(NULL));
   _exception_pc  = 0;
@@ -1515,6 +1546,7 @@ void JavaThread::initialize() {
   _pending_jni_exception_check_fn = NULL;
   _do_not_unlock_if_synchronized = false;
   _cached_monitor_info = NULL;
+  _backtrace_cache = NULL;
   _parker = Parker::Allocate(this) ;
 
 #ifndef PRODUCT
@@ -1658,6 +1690,11 @@ JavaThread::~JavaThread() {
   Parker::Release(_parker);
   _parker = NULL ;
 
+  if (_backtrace_cache != NULL) {
+    delete _backtrace_cache;
+    _backtrace_cache = NULL;
+  }
+
   // Free any remaining  previous UnrollBlock
   vframeArray* old_array = vframe_array_last();
 
@@ -2450,11 +2487,9 @@ void JavaThread::check_safepoint_and_suspend_for_native_trans(JavaThread *thread
     }
   }
 
-  if (SafepointSynchronize::do_call_back()) {
-    // If we are safepointing, then block the caller which may not be
-    // the same as the target thread (see above).
-    SafepointSynchronize::block(curJT);
-  }
+  // If we are safepointing, then block the caller which may not be
+  // the same as the target thread (see above).
+  SafepointMechanism::block_if_requested(curJT);
 
   if (thread->is_deopt_suspend()) {
     thread->clear_deopt_suspend();
@@ -3340,6 +3375,7 @@ CompilerThread::CompilerThread(CompileQueue* queue, CompilerCounters* counters)
   _buffer_blob = NULL;
   _scanned_nmethod = NULL;
   _compiler = NULL;
+  _idle_start = 0;
 
   // Compiler uses resource area for compilation, let's bias it to mtCompiler
   resource_area()->bias_to(mtCompiler);
@@ -3474,6 +3510,10 @@ jint Threads::create_vm(JavaVMInitArgs* args, bool* canTryAgain) {
   jint os_init_2_result = os::init_2();
   if (os_init_2_result != JNI_OK) return os_init_2_result;
 
+  SafepointMechanism::initialize();
+
+  ThreadHeapSampler::initialize();
+
   jint adjust_after_os_result = Arguments::adjust_after_os();
   if (adjust_after_os_result != JNI_OK) return adjust_after_os_result;
 
@@ -3573,6 +3613,11 @@ jint Threads::create_vm(JavaVMInitArgs* args, bool* canTryAgain) {
     }
   }
 
+  // Buffer the GC log from now on; the VM has not collected yet.
+  if (UseAsyncGCLog) {
+    AsyncGCLogWriter::start();
+  }
+
   assert (Universe::is_fully_initialized(), "not initialized");
   if (VerifyDuringStartup) {
     // Make sure we're starting with a clean slate.
@@ -3696,6 +3741,13 @@ jint Threads::create_vm(JavaVMInitArgs* args, bool* canTryAgain) {
     vm_exit_during_initialization(Handle(THREAD, PENDING_EXCEPTION));
   }
 
+  // Start loading the startup classes in the background. Preloading is
+  // only an optimization, so a failure to start it is ignored.
+  if (PreloadClassList != NULL) {
+    ClassPreloader::initialize(THREAD);
+    CLEAR_PENDING_EXCEPTION;
+  }
+
 #if INCLUDE_ALL_GCS
   // Support for ConcurrentMarkSweep. This should be cleaned up
   // and better encapsulated. The ugly nested if test would go away
@@ -3746,6 +3798,13 @@ jint Threads::create_vm(JavaVMInitArgs* args, bool* canTryAgain) {
   // initialize compiler(s)
 #if defined(COMPILER1) || defined(COMPILER2) || defined(SHARK)
   CompileBroker::compilation_init();
+
+  // Compile the methods recorded by an earlier run as their classes get
+  // initialized. This is only an optimization, so errors are ignored.
+  if (CompileDecisionFile != NULL) {
+    CompileDecisionCache::initialize(THREAD);
+    CLEAR_PENDING_EXCEPTION;
+  }
 #endif
 
   if (EnableInvokeDynamic) {
@@ -4252,6 +4311,12 @@ void Threads::remove(JavaThread* p) {
     }
     ThreadService::remove_thread(p, daemon);
 
+    // A handshake operation still pending for this thread would never be
+    // executed by the VM thread once the thread is off the list.
+    if (p->has_handshake()) {
+      p->cancel_handshake();
+    }
+
     // Make sure that safepoint code disregard this thread. This is needed since
     // the thread might mess around with locks after this point. This can cause it
     // to do callbacks into the safepoint code. However, the safepoint code is not aware
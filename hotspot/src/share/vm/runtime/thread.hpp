@@ -26,11 +26,13 @@
 #define SHARE_VM_RUNTIME_THREAD_HPP
 
 #include "memory/allocation.hpp"
+#include "memory/metaspaceAllocationBuffer.hpp"
 #include "memory/threadLocalAllocBuffer.hpp"
 #include "oops/oop.hpp"
 #include "prims/jni.h"
 #include "prims/jvmtiExport.hpp"
 #include "runtime/frame.hpp"
+#include "runtime/handshake.hpp"
 #include "runtime/javaFrameAnchor.hpp"
 #include "runtime/jniHandles.hpp"
 #include "runtime/mutexLocker.hpp"
@@ -39,6 +41,7 @@
 #include "runtime/park.hpp"
 #include "runtime/safepoint.hpp"
 #include "runtime/stubRoutines.hpp"
+#include "runtime/threadHeapSampler.hpp"
 #include "runtime/threadLocalStorage.hpp"
 #include "runtime/thread_ext.hpp"
 #include "runtime/unhandledOops.hpp"
@@ -63,6 +66,7 @@ class ThreadSafepointState;
 class ThreadProfiler;
 
 class JvmtiThreadState;
+class BacktraceCache;
 class JvmtiGetLoadedClassesClosure;
 class ThreadStatistics;
 class ConcurrentLocksDump;
@@ -85,6 +89,7 @@ class ThreadClosure;
 class IdealGraphPrinter;
 
 class Metadata;
+class UnsafeMemoryCache;
 template <class T, MEMFLAGS F> class ChunkedList;
 typedef ChunkedList<Metadata*, mtInternal> MetadataOnStackBuffer;
 
@@ -208,6 +213,10 @@ class Thread: public ThreadShadow {
   // overloaded for async exception checking in check_special_condition_for_native_trans.
   volatile uint32_t _suspend_flags;
 
+  // Thread local polling word, read by the safepoint polls when
+  // ThreadLocalHandshakes is on (see SafepointMechanism)
+  volatile void* _polling_page;
+
  private:
   int _num_nested_signal;
 
@@ -262,6 +271,12 @@ class Thread: public ThreadShadow {
   ThreadLocalAllocBuffer _tlab;                 // Thread-local eden
   jlong _allocated_bytes;                       // Cumulative number of bytes allocated on
                                                 // the Java heap
+  ThreadHeapSampler _heap_sampler;              // For the sampling heap profiler
+  MetaspaceAllocationBuffer _metaspace_alloc_buffer; // Thread-local class metadata
+  juint _profile_sample_seed;                   // Xorshift state for sampled call
+                                                // profiling in C1 code
+  intptr_t _invocation_counter_stripe;          // Byte offset of the invocation counter
+                                                // stripe this thread counts in
 
   // Thread-local buffer used by MetadataOnStackMark.
   MetadataOnStackBuffer* _metadata_on_stack_buffer;
@@ -288,6 +303,7 @@ class Thread: public ThreadShadow {
   int omFreeProvision;                          // reload chunk size
   ObjectMonitor* omInUseList;                   // SLL to track monitors in circulation
   int omInUseCount;                             // length of omInUseList
+  volatile int omInUseListLock;                 // serializes omInUseList updates with the async deflater
 
 #ifdef ASSERT
  private:
@@ -419,6 +435,15 @@ class Thread: public ThreadShadow {
   ResourceArea* resource_area() const            { return _resource_area; }
   void set_resource_area(ResourceArea* area)     { _resource_area = area; }
 
+  // Chunk cache, see ChunkPool
+  Chunk** cached_chunks()                        { return _cached_chunks; }
+  bool chunk_cache_enabled() const               { return _chunk_cache_enabled; }
+  void flush_chunk_cache();
+
+  // Free Unsafe memory blocks, see UnsafeMemory
+  UnsafeMemoryCache* unsafe_memory_cache() const { return _unsafe_memory_cache; }
+  void set_unsafe_memory_cache(UnsafeMemoryCache* cache) { _unsafe_memory_cache = cache; }
+
   OSThread* osthread() const                     { return _osthread;   }
   void set_osthread(OSThread* thread)            { _osthread = thread; }
 
@@ -437,6 +462,8 @@ class Thread: public ThreadShadow {
 
   // Thread-Local Allocation Buffer (TLAB) support
   ThreadLocalAllocBuffer& tlab()                 { return _tlab; }
+  ThreadHeapSampler& heap_sampler()              { return _heap_sampler; }
+  MetaspaceAllocationBuffer& metaspace_alloc_buffer() { return _metaspace_alloc_buffer; }
   void initialize_tlab() {
     if (UseTLAB) {
       tlab().initialize();
@@ -445,6 +472,10 @@ class Thread: public ThreadShadow {
 
   jlong allocated_bytes()               { return _allocated_bytes; }
   void set_allocated_bytes(jlong value) { _allocated_bytes = value; }
+
+  // Thread local safepoint and handshake polling
+  inline volatile void* get_polling_page();
+  inline void set_polling_page(void* poll_value);
   void incr_allocated_bytes(jlong size) { _allocated_bytes += size; }
   inline jlong cooked_allocated_bytes();
 
@@ -540,6 +571,13 @@ protected:
   // Thread local resource area for temporary allocation within the VM
   ResourceArea* _resource_area;
 
+  // Arena chunks of the standard sizes kept by this thread for reuse,
+  // so that growing its arenas does not always go to the global pools
+  Chunk* _cached_chunks[Chunk::num_thread_cached_sizes];
+  bool   _chunk_cache_enabled;
+
+  UnsafeMemoryCache* _unsafe_memory_cache;
+
   DEBUG_ONLY(ResourceMark* _current_resource_mark;)
 
   // Thread local handle area for allocation of handles within the VM
@@ -623,6 +661,7 @@ protected:
 
   TLAB_FIELD_OFFSET(start)
   TLAB_FIELD_OFFSET(end)
+  TLAB_FIELD_OFFSET(allocation_end)
   TLAB_FIELD_OFFSET(top)
   TLAB_FIELD_OFFSET(pf_top)
   TLAB_FIELD_OFFSET(size)                   // desired_size
@@ -634,6 +673,9 @@ protected:
 #undef TLAB_FIELD_OFFSET
 
   static ByteSize allocated_bytes_offset()       { return byte_offset_of(Thread, _allocated_bytes ); }
+  static ByteSize polling_page_offset()          { return byte_offset_of(Thread, _polling_page ); }
+  static ByteSize profile_sample_seed_offset()   { return byte_offset_of(Thread, _profile_sample_seed ); }
+  static ByteSize invocation_counter_stripe_offset() { return byte_offset_of(Thread, _invocation_counter_stripe ); }
 
   JFR_ONLY(DEFINE_THREAD_LOCAL_OFFSET_JFR;)
 
@@ -936,6 +978,7 @@ class JavaThread: public Thread {
  private:
   ThreadSafepointState *_safepoint_state;        // Holds information about a thread during a safepoint
   address               _saved_exception_pc;     // Saved pc of instruction where last implicit exception happened
+  HandshakeState        _handshake;              // Pending thread-local handshake operation, if any
 
   // JavaThread termination support
   enum TerminatedTypes {
@@ -1150,6 +1193,32 @@ class JavaThread: public Thread {
   void set_terminated_value()                    { _terminated = _thread_terminated; }
   void block_if_vm_exited();
 
+  // Thread-local handshake support
+  void set_handshake_operation(HandshakeOperation* op) {
+    _handshake.set_operation(this, op);
+  }
+
+  bool has_handshake() const {
+    return _handshake.has_operation();
+  }
+
+  void cancel_handshake() {
+    _handshake.cancel(this);
+  }
+
+  void handshake_process_by_self() {
+    _handshake.process_by_self(this);
+  }
+
+  void handshake_process_by_vmthread() {
+    _handshake.process_by_vmthread(this);
+  }
+
+  // True if th is this thread or is executing a handshake operation on its behalf
+  bool is_handshake_safe_for(Thread* th) const {
+    return _handshake.active_handshaker() == th || this == th;
+  }
+
   bool doing_unsafe_access()                     { return _doing_unsafe_access; }
   void set_doing_unsafe_access(bool val)         { _doing_unsafe_access = val; }
 
@@ -1865,6 +1934,13 @@ public:
   GrowableArray<MonitorInfo*>* cached_monitor_info() { return _cached_monitor_info; }
   void set_cached_monitor_info(GrowableArray<MonitorInfo*>* info) { _cached_monitor_info = info; }
 
+  // Recently filled in exception backtraces, see java_lang_Throwable
+private:
+  BacktraceCache* _backtrace_cache;
+public:
+  BacktraceCache* backtrace_cache() const            { return _backtrace_cache; }
+  void set_backtrace_cache(BacktraceCache* cache)    { _backtrace_cache = cache; }
+
   // clearing/querying jni attach status
   bool is_attaching_via_jni() const { return _jni_attach_state == _attaching_via_jni; }
   bool has_attached_via_jni() const { return is_attaching_via_jni() || _jni_attach_state == _attached_via_jni; }
@@ -1938,6 +2014,7 @@ class CompilerThread : public JavaThread {
 
   nmethod*          _scanned_nmethod;  // nmethod being scanned by the sweeper
   AbstractCompiler* _compiler;
+  jlong             _idle_start;       // time (in ms) the thread last became idle
 
  public:
 
@@ -1955,6 +2032,10 @@ class CompilerThread : public JavaThread {
   CompileQueue* queue()        const             { return _queue; }
   CompilerCounters* counters() const             { return _counters; }
 
+  // Idle time tracking for UseDynamicNumberOfCompilerThreads
+  void          start_idle_timer()               { _idle_start = os::javaTimeMillis(); }
+  jlong         idle_time_millis() const         { return os::javaTimeMillis() - _idle_start; }
+
   // Get/set the thread's compilation environment.
   ciEnv*        env()                            { return _env; }
   void          set_env(ciEnv* env)              { _env = env; }
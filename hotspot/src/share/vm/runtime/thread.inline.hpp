@@ -59,6 +59,14 @@ inline jlong Thread::cooked_allocated_bytes() {
   return allocated_bytes;
 }
 
+inline volatile void* Thread::get_polling_page() {
+  return OrderAccess::load_ptr_acquire(&_polling_page);
+}
+
+inline void Thread::set_polling_page(void* poll_value) {
+  OrderAccess::release_store_ptr(&_polling_page, poll_value);
+}
+
 #if defined(PPC64) || defined (AARCH64)
 inline JavaThreadState JavaThread::thread_state() const    {
   return (JavaThreadState) OrderAccess::load_acquire((volatile jint*)&_thread_state);
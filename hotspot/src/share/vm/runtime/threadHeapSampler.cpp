@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "jfr/jfrEvents.hpp"
+#include "prims/jvmtiExport.hpp"
+#include "runtime/handles.inline.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/thread.inline.hpp"
+#include "runtime/threadHeapSampler.hpp"
+
+volatile size_t ThreadHeapSampler::_sampling_interval = 0;
+
+void ThreadHeapSampler::initialize() {
+  _sampling_interval = HeapSamplingInterval;
+}
+
+ThreadHeapSampler::ThreadHeapSampler() :
+  _bytes_until_sample(0), _sample_step(0), _sampled_object(NULL), _sampled_weight(0) {
+  // Seed each thread differently so that threads allocating in lock
+  // step do not sample the same allocations.
+  _rnd = (uint64_t)(uintptr_t)this;
+  if (_rnd == 0) {
+    _rnd = 1;
+  }
+  pick_next_sample(0);
+}
+
+bool ThreadHeapSampler::enabled() {
+  // Generated code that refills a tlab inline does not know that the
+  // heap sampler may have moved the end of the tlab. Taking the JVMTI
+  // capability turns FastTLABRefill off; JFR has to run without it.
+  COMPILER1_PRESENT(if (UseTLAB && FastTLABRefill) return false;)
+  return JvmtiExport::should_post_sampled_object_alloc() ||
+         EventObjectAllocationSample::is_enabled();
+}
+
+// Pick the distance to the next sample from an exponential
+// distribution with a mean of sampling_interval() bytes, so that the
+// samples do not lock step with a periodic allocation pattern.
+void ThreadHeapSampler::pick_next_sample(size_t overflow_bytes) {
+  const size_t interval = sampling_interval();
+  if (interval <= 1) {
+    // Sample every allocation.
+    _sample_step = interval;
+    _bytes_until_sample = interval;
+    return;
+  }
+
+  // 48 bit linear congruential generator (the drand48 constants).
+  const uint64_t PrngMult = 0x5DEECE66DULL;
+  const uint64_t PrngAdd  = 0xB;
+  const int      PrngBits = 48;
+  _rnd = (PrngMult * _rnd + PrngAdd) & right_n_bits(PrngBits);
+
+  // Take the top 26 bits as a uniform value in (0, 1] and put it
+  // through the inverse of the exponential distribution function.
+  const int UniformBits = 26;
+  double u = ((double)(_rnd >> (PrngBits - UniformBits)) + 1.0) / (double)(1 << UniformBits);
+  double step = -log(u) * (double)interval + 1.0;
+  _sample_step = (size_t)MIN2(step, (double)(max_uintx / 2));
+
+  // Take the bytes by which the last allocation went past the sample
+  // point off the next distance to keep the mean interval.
+  _bytes_until_sample = _sample_step;
+  if (overflow_bytes > 0 && _bytes_until_sample > overflow_bytes) {
+    _bytes_until_sample -= overflow_bytes;
+  }
+}
+
+void ThreadHeapSampler::check_for_sampling(HeapWord* obj, size_t size_in_bytes, size_t bytes_before) {
+  size_t total_bytes = bytes_before + size_in_bytes;
+  if (total_bytes < _bytes_until_sample) {
+    _bytes_until_sample -= total_bytes;
+    return;
+  }
+  _sampled_object = obj;
+  _sampled_weight = _sample_step;
+  pick_next_sample(total_bytes - _bytes_until_sample);
+}
+
+oop ThreadHeapSampler::report_sample(oop obj, Thread* thread) {
+  assert(_sampled_object == (HeapWord*)obj, "not the pending sample");
+  _sampled_object = NULL;
+
+  EventObjectAllocationSample event;
+  if (event.should_commit()) {
+    event.set_objectClass(obj->klass());
+    event.set_weight(_sampled_weight);
+    event.commit();
+  }
+
+  // The agent callback may call back into the VM, so only post from a
+  // Java thread that does not hold VM locks the callback could need.
+  if (JvmtiExport::should_post_sampled_object_alloc() &&
+      thread->is_Java_thread() && !thread->is_Compiler_thread() &&
+      ((JavaThread*)thread)->thread_state() == _thread_in_vm &&
+      Compile_lock->owner() != thread &&
+      MultiArray_lock->owner() != thread) {
+    Handle h(thread, obj);
+    JvmtiExport::post_sampled_object_alloc((JavaThread*)thread, h());
+    return h();
+  }
+  return obj;
+}
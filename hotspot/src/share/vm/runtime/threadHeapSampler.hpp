@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_RUNTIME_THREADHEAPSAMPLER_HPP
+#define SHARE_VM_RUNTIME_THREADHEAPSAMPLER_HPP
+
+#include "memory/allocation.hpp"
+#include "oops/oopsHierarchy.hpp"
+
+class Thread;
+
+// ThreadHeapSampler: per-thread state of the sampling heap profiler.
+//            Each thread counts down a randomized number of allocated
+//            bytes. The allocation that uses up the count is reported
+//            through the JVMTI SampledObjectAlloc and the JFR
+//            ObjectAllocationSample events. TLAB allocations are caught
+//            by moving the end of the TLAB in to the next sample point
+//            (see ThreadLocalAllocBuffer::set_sample_end()). The
+//            interpreter does not fall back to the shared eden when
+//            the end was moved, so the runtime sees the crossing.
+class ThreadHeapSampler VALUE_OBJ_CLASS_SPEC {
+ private:
+  size_t    _bytes_until_sample;   // bytes left until the next sample
+  size_t    _sample_step;          // bytes between the last sample and the next one
+  uint64_t  _rnd;                  // state of the random number generator
+  HeapWord* _sampled_object;       // allocation picked but not reported yet
+  size_t    _sampled_weight;       // bytes the pending sample stands for
+
+  // Mean number of bytes between two samples, shared by all threads.
+  static volatile size_t _sampling_interval;
+
+  void pick_next_sample(size_t overflow_bytes);
+
+ public:
+  ThreadHeapSampler();
+
+  // Take the sampling interval from HeapSamplingInterval. Called
+  // after argument parsing, before any agent is loaded.
+  static void initialize();
+
+  static size_t sampling_interval()              { return _sampling_interval; }
+  // Threads pick up a new interval at their next sample.
+  static void set_sampling_interval(size_t interval) { _sampling_interval = interval; }
+
+  // True if a JVMTI agent or JFR wants samples and the end of the
+  // tlab may be moved.
+  static bool enabled();
+
+  size_t bytes_until_sample() const              { return _bytes_until_sample; }
+  HeapWord* sampled_object() const               { return _sampled_object; }
+
+  // Count an allocation of size_in_bytes at obj, plus the
+  // bytes_before bytes handed out by the tlab since the last check.
+  // obj becomes the pending sample if it reaches the sample point.
+  void check_for_sampling(HeapWord* obj, size_t size_in_bytes, size_t bytes_before);
+
+  // Report the pending sample obj, which is now initialized. Posting
+  // the JVMTI event may safepoint, so the possibly moved object is
+  // returned.
+  oop report_sample(oop obj, Thread* thread);
+};
+
+#endif // SHARE_VM_RUNTIME_THREADHEAPSAMPLER_HPP
@@ -822,9 +822,11 @@ typedef TwoOopHashtable<Symbol*, mtClass>     SymbolTwoOopHashtable;
      static_field(StubRoutines,                _ghash_processBlocks,                          address)                               \
      static_field(StubRoutines,                _updateBytesCRC32,                             address)                               \
      static_field(StubRoutines,                _crc_table_adr,                                address)                               \
+     static_field(StubRoutines,                _updateBytesAdler32,                           address)                               \
      static_field(StubRoutines,                _multiplyToLen,                                address)                               \
      static_field(StubRoutines,                _squareToLen,                                  address)                               \
      static_field(StubRoutines,                _mulAdd,                                       address)                               \
+     static_field(StubRoutines,                _vectorizedMismatch,                           address)                               \
                                                                                                                                      \
   /*****************/                                                                                                                \
   /* SharedRuntime */                                                                                                                \
@@ -2012,6 +2014,21 @@ typedef TwoOopHashtable<Symbol*, mtClass>     SymbolTwoOopHashtable;
   declare_c2_type(AndVNode, VectorNode)                                   \
   declare_c2_type(OrVNode, VectorNode)                                    \
   declare_c2_type(XorVNode, VectorNode)                                   \
+  declare_c2_type(VectorCastI2FNode, VectorNode)                          \
+  declare_c2_type(VectorCastF2INode, VectorNode)                          \
+  declare_c2_type(ReductionNode, TypeNode)                                \
+  declare_c2_type(AddReductionVINode, ReductionNode)                      \
+  declare_c2_type(AddReductionVLNode, ReductionNode)                      \
+  declare_c2_type(AddReductionVFNode, ReductionNode)                      \
+  declare_c2_type(AddReductionVDNode, ReductionNode)                      \
+  declare_c2_type(MulReductionVINode, ReductionNode)                      \
+  declare_c2_type(MulReductionVFNode, ReductionNode)                      \
+  declare_c2_type(MulReductionVDNode, ReductionNode)                      \
+  declare_c2_type(AndReductionVNode, ReductionNode)                       \
+  declare_c2_type(OrReductionVNode, ReductionNode)                        \
+  declare_c2_type(XorReductionVNode, ReductionNode)                       \
+  declare_c2_type(MinReductionVNode, ReductionNode)                       \
+  declare_c2_type(MaxReductionVNode, ReductionNode)                       \
   declare_c2_type(LoadVectorNode, LoadNode)                               \
   declare_c2_type(StoreVectorNode, StoreNode)                             \
   declare_c2_type(ReplicateBNode, VectorNode)                             \
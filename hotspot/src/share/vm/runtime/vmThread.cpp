@@ -96,6 +96,23 @@ void VMOperationQueue::queue_add_back(int prio, VM_Operation *op) {
   insert(_queue[prio]->prev(), op);
 }
 
+// Inserts a NULL terminated list, as returned by queue_drain, at the front
+void VMOperationQueue::queue_add_front_list(int prio, VM_Operation *list) {
+  VM_Operation* last = list;
+  while (last->next() != NULL) {
+    last = last->next();
+  }
+  // Insert from the back so that the operations keep their order; the
+  // head may still link back to an operation that was evaluated already
+  VM_Operation* op = last;
+  while (op != NULL) {
+    VM_Operation* prev = (op == list) ? NULL : op->prev();
+    _queue_length[prio]++;
+    insert(_queue[prio], op);
+    op = prev;
+  }
+}
+
 
 void VMOperationQueue::unlink(VM_Operation* q) {
   assert(q->next()->prev() == q && q->prev()->next() == q, "sanity check");
@@ -356,7 +373,7 @@ void VMThread::wait_for_vm_thread_exit() {
   }
 }
 
-static void post_vm_operation_event(EventExecuteVMOperation* event, VM_Operation* op) {
+static void post_vm_operation_event(EventExecuteVMOperation* event, VM_Operation* op, bool coalesced) {
   assert(event != NULL, "invariant");
   assert(event->should_commit(), "invariant");
   assert(op != NULL, "invariant");
@@ -370,10 +387,11 @@ static void post_vm_operation_event(EventExecuteVMOperation* event, VM_Operation
   // This is because the caller thread could have exited already.
   event->set_caller(is_concurrent ? 0 : JFR_THREAD_ID(op->calling_thread()));
   event->set_safepointId(evaluate_at_safepoint ? SafepointSynchronize::safepoint_counter() : 0);
+  event->set_coalesced(coalesced);
   event->commit();
 }
 
-void VMThread::evaluate_operation(VM_Operation* op) {
+void VMThread::evaluate_operation(VM_Operation* op, bool coalesced) {
   ResourceMark rm;
 
   {
@@ -390,7 +408,7 @@ void VMThread::evaluate_operation(VM_Operation* op) {
     EventExecuteVMOperation event;
     op->evaluate();
     if (event.should_commit()) {
-      post_vm_operation_event(&event, op);
+      post_vm_operation_event(&event, op, coalesced);
     }
 
 #ifndef USDT2
@@ -504,24 +522,38 @@ void VMThread::loop() {
         _vm_queue->set_drain_list(safepoint_ops); // ensure ops can be scanned
 
         SafepointSynchronize::begin();
+        const jlong coalescing_start = os::javaTimeNanos();
+        bool over_budget = false;
         evaluate_operation(_cur_vm_operation);
         // now process all queued safepoint ops, iteratively draining
-        // the queue until there are none left
+        // the queue until there are none left or they have taken longer
+        // than VMOperationCoalescingBudget
         do {
           _cur_vm_operation = safepoint_ops;
-          if (_cur_vm_operation != NULL) {
-            do {
-              EventMark em("Executing coalesced safepoint VM operation: %s", _cur_vm_operation->name());
-              // evaluate_operation deletes the op object so we have
-              // to grab the next op now
-              VM_Operation* next = _cur_vm_operation->next();
-              _vm_queue->set_drain_list(next);
-              evaluate_operation(_cur_vm_operation);
-              _cur_vm_operation = next;
-              if (PrintSafepointStatistics) {
-                SafepointSynchronize::inc_vmop_coalesced_count();
-              }
-            } while (_cur_vm_operation != NULL);
+          while (_cur_vm_operation != NULL) {
+            if (VMOperationCoalescingBudget > 0 &&
+                os::javaTimeNanos() - coalescing_start >
+                  (jlong) VMOperationCoalescingBudget * NANOSECS_PER_MILLISEC) {
+              // Leave the rest to the next safepoint rather than keep
+              // the Java threads stopped
+              MutexLockerEx mu_queue(VMOperationQueue_lock,
+                                     Mutex::_no_safepoint_check_flag);
+              _vm_queue->set_drain_list(NULL);
+              _vm_queue->requeue_at_safepoint_priority(_cur_vm_operation);
+              _cur_vm_operation = NULL;
+              over_budget = true;
+              break;
+            }
+            EventMark em("Executing coalesced safepoint VM operation: %s", _cur_vm_operation->name());
+            if (PrintSafepointStatistics) {
+              SafepointSynchronize::inc_vmop_coalesced_count(_cur_vm_operation->type());
+            }
+            // evaluate_operation deletes the op object so we have
+            // to grab the next op now
+            VM_Operation* next = _cur_vm_operation->next();
+            _vm_queue->set_drain_list(next);
+            evaluate_operation(_cur_vm_operation, true);
+            _cur_vm_operation = next;
           }
           // There is a chance that a thread enqueued a safepoint op
           // since we released the op-queue lock and initiated the safepoint.
@@ -533,7 +565,7 @@ void VMThread::loop() {
           // that simply means the op will wait for the next major cycle of the
           // VMThread - just as it would if the GC thread lost the race for
           // the lock.
-          if (_vm_queue->peek_at_safepoint_priority()) {
+          if (!over_budget && _vm_queue->peek_at_safepoint_priority()) {
             // must hold lock while draining queue
             MutexLockerEx mu_queue(VMOperationQueue_lock,
                                      Mutex::_no_safepoint_check_flag);
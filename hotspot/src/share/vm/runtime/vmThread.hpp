@@ -59,6 +59,7 @@ class VMOperationQueue : public CHeapObj<mtInternal> {
   bool queue_empty                (int prio);
   void queue_add_front            (int prio, VM_Operation *op);
   void queue_add_back             (int prio, VM_Operation *op);
+  void queue_add_front_list       (int prio, VM_Operation *list);
   VM_Operation* queue_remove_front(int prio);
   void queue_oops_do(int queue, OopClosure* f);
   void drain_list_oops_do(OopClosure* f);
@@ -75,6 +76,9 @@ class VMOperationQueue : public CHeapObj<mtInternal> {
   VM_Operation* remove_next_at_safepoint_priority()   { return queue_remove_front(SafepointPriority); }
   VM_Operation* drain_at_safepoint_priority() { return queue_drain(SafepointPriority); }
   void set_drain_list(VM_Operation* list) { _drain_list = list; }
+  // Puts back drained operations that were not evaluated, ahead of the
+  // ones queued since
+  void requeue_at_safepoint_priority(VM_Operation* list) { queue_add_front_list(SafepointPriority, list); }
   bool peek_at_safepoint_priority() { return queue_peek(SafepointPriority); }
 
   // GC support
@@ -100,7 +104,7 @@ class VMThread: public NamedThread {
   static Monitor * _terminate_lock;
   static PerfCounter* _perf_accumulated_vm_operation_time;
 
-  void evaluate_operation(VM_Operation* op);
+  void evaluate_operation(VM_Operation* op, bool coalesced = false);
  public:
   // Constructor
   VMThread();
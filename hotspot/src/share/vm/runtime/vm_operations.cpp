@@ -309,6 +309,14 @@ void VM_ThreadDump::doit() {
     concurrent_locks.dump_at_safepoint();
   }
 
+  // Collect the owners of the inflated monitors once for all threads
+  ObjectMonitorsByOwner owned_monitors;
+  ObjectMonitorsByOwner* monitors = NULL;
+  if (_with_locked_monitors) {
+    ObjectSynchronizer::monitors_iterate(&owned_monitors);
+    monitors = &owned_monitors;
+  }
+
   if (_num_threads == 0) {
     // Snapshot all live threads
     for (JavaThread* jt = Threads::first(); jt != NULL; jt = jt->next()) {
@@ -321,7 +329,7 @@ void VM_ThreadDump::doit() {
       if (_with_locked_synchronizers) {
         tcl = concurrent_locks.thread_concurrent_locks(jt);
       }
-      ThreadSnapshot* ts = snapshot_thread(jt, tcl);
+      ThreadSnapshot* ts = snapshot_thread(jt, tcl, monitors);
       _result->add_thread_snapshot(ts);
     }
   } else {
@@ -350,15 +358,16 @@ void VM_ThreadDump::doit() {
       if (_with_locked_synchronizers) {
         tcl = concurrent_locks.thread_concurrent_locks(jt);
       }
-      ThreadSnapshot* ts = snapshot_thread(jt, tcl);
+      ThreadSnapshot* ts = snapshot_thread(jt, tcl, monitors);
       _result->add_thread_snapshot(ts);
     }
   }
 }
 
-ThreadSnapshot* VM_ThreadDump::snapshot_thread(JavaThread* java_thread, ThreadConcurrentLocks* tcl) {
+ThreadSnapshot* VM_ThreadDump::snapshot_thread(JavaThread* java_thread, ThreadConcurrentLocks* tcl,
+                                               ObjectMonitorsByOwner* monitors) {
   ThreadSnapshot* snapshot = new ThreadSnapshot(java_thread);
-  snapshot->dump_stack_at_safepoint(_max_depth, _with_locked_monitors);
+  snapshot->dump_stack_at_safepoint(_max_depth, _with_locked_monitors, monitors);
   snapshot->set_concurrent_locks(tcl);
   return snapshot;
 }
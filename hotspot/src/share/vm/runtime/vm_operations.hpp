@@ -46,6 +46,9 @@
   template(FindDeadlocks)                         \
   template(ForceSafepoint)                        \
   template(ForceAsyncSafepoint)                   \
+  template(HandshakeFallback)                     \
+  template(HandshakeOneThread)                    \
+  template(HandshakeAllThreads)                   \
   template(Deoptimize)                            \
   template(DeoptimizeFrame)                       \
   template(DeoptimizeAll)                         \
@@ -349,6 +352,7 @@ class VM_FindDeadlocks: public VM_Operation {
 class ThreadDumpResult;
 class ThreadSnapshot;
 class ThreadConcurrentLocks;
+class ObjectMonitorsByOwner;
 
 class VM_ThreadDump : public VM_Operation {
  private:
@@ -359,7 +363,8 @@ class VM_ThreadDump : public VM_Operation {
   bool                           _with_locked_monitors;
   bool                           _with_locked_synchronizers;
 
-  ThreadSnapshot* snapshot_thread(JavaThread* java_thread, ThreadConcurrentLocks* tcl);
+  ThreadSnapshot* snapshot_thread(JavaThread* java_thread, ThreadConcurrentLocks* tcl,
+                                  ObjectMonitorsByOwner* monitors);
 
  public:
   VM_ThreadDump(ThreadDumpResult* result,
@@ -24,9 +24,12 @@
 
 #include "precompiled.hpp"
 #include "classfile/classLoaderStats.hpp"
+#include "code/perfMap.hpp"
 #include "gc_implementation/shared/vmGCOperations.hpp"
 #include "runtime/javaCalls.hpp"
+#include "runtime/mutexLocker.hpp"
 #include "runtime/os.hpp"
+#include "runtime/safepointHistory.hpp"
 #include "services/diagnosticArgument.hpp"
 #include "services/diagnosticCommand.hpp"
 #include "services/diagnosticFramework.hpp"
@@ -63,6 +66,9 @@ void DCmdRegistrant::register_dcmds(){
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<ThreadDumpDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<RotateGCLogDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<ClassLoaderStatsDCmd>(full_export, true, false));
+  DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<SafepointHistoryDCmd>(full_export, true, false));
+  DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<LockStatsDCmd>(full_export, true, false));
+  DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<PerfMapDCmd>(full_export, true, false));
 
   // Enhanced JMX Agent Support
   // These commands won't be exported via the DiagnosticCommandMBean until an
@@ -339,17 +345,30 @@ HeapDumpDCmd::HeapDumpDCmd(outputStream* output, bool heap) :
                            DCmdWithParser(output, heap),
   _filename("filename","Name of the dump file", "STRING",true),
   _all("-all", "Dump all objects, including unreachable objects",
-       "BOOLEAN", false, "false") {
+       "BOOLEAN", false, "false"),
+  _gzip("-gz", "If specified, the heap dump is written in gzipped format "
+        "using the given compression level. 1 (recommended) is the fastest, "
+        "9 the strongest compression.", "INT", false) {
   _dcmdparser.add_dcmd_option(&_all);
+  _dcmdparser.add_dcmd_option(&_gzip);
   _dcmdparser.add_dcmd_argument(&_filename);
 }
 
 void HeapDumpDCmd::execute(DCmdSource source, TRAPS) {
+  int level = 0;
+  if (_gzip.is_set()) {
+    if (_gzip.value() < 1 || _gzip.value() > 9) {
+      output()->print_cr("Compression level out of range (1-9): " JLONG_FORMAT, _gzip.value());
+      return;
+    }
+    level = (int)_gzip.value();
+  }
+
   // Request a full GC before heap dump if _all is false
   // This helps reduces the amount of unreachable objects in the dump
   // and makes it easier to browse.
   HeapDumper dumper(!_all.value() /* request GC if _all is false*/);
-  int res = dumper.dump(_filename.value());
+  int res = dumper.dump(_filename.value(), level);
   if (res == 0) {
     output()->print_cr("Heap dump file created");
   } else {
@@ -736,3 +755,33 @@ void RotateGCLogDCmd::execute(DCmdSource source, TRAPS) {
     output()->print_cr("Target VM does not support GC log file rotation.");
   }
 }
+
+void SafepointHistoryDCmd::execute(DCmdSource source, TRAPS) {
+  SafepointHistory::print_on(output());
+}
+
+void PerfMapDCmd::execute(DCmdSource source, TRAPS) {
+  PerfMap::rewrite(output());
+}
+
+LockStatsDCmd::LockStatsDCmd(outputStream* output, bool heap) :
+                             DCmdWithParser(output, heap),
+  _reset("-reset", "Reset the statistics after printing them",
+         "BOOLEAN", false, "false") {
+  _dcmdparser.add_dcmd_option(&_reset);
+}
+
+void LockStatsDCmd::execute(DCmdSource source, TRAPS) {
+  print_lock_statistics(output(), _reset.value());
+}
+
+int LockStatsDCmd::num_arguments() {
+  ResourceMark rm;
+  LockStatsDCmd* dcmd = new LockStatsDCmd(NULL, false);
+  if (dcmd != NULL) {
+    DCmdMark mark(dcmd);
+    return dcmd->_dcmdparser.num_arguments();
+  } else {
+    return 0;
+  }
+}
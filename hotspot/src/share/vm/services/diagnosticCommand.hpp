@@ -245,6 +245,7 @@ class HeapDumpDCmd : public DCmdWithParser {
 protected:
   DCmdArgument<char*> _filename;
   DCmdArgument<bool>  _all;
+  DCmdArgument<jlong> _gzip;
 public:
   HeapDumpDCmd(outputStream* output, bool heap);
   static const char* name() {
@@ -441,4 +442,62 @@ public:
   }
 };
 
+class SafepointHistoryDCmd : public DCmd {
+public:
+  SafepointHistoryDCmd(outputStream* output, bool heap) : DCmd(output, heap) {}
+  static const char* name() { return "VM.safepoint_history"; }
+  static const char* description() {
+    return "Print the time to safepoint, cleanup and operation time of the "
+           "recent safepoints, with the threads that were slowest to stop.";
+  }
+  static const char* impact() { return "Low"; }
+  virtual void execute(DCmdSource source, TRAPS);
+  static int num_arguments() { return 0; }
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+                        "monitor", NULL};
+    return p;
+  }
+};
+
+class PerfMapDCmd : public DCmd {
+public:
+  PerfMapDCmd(outputStream* output, bool heap) : DCmd(output, heap) {}
+  static const char* name() { return "Compiler.perfmap"; }
+  static const char* description() {
+    return "Rewrite /tmp/perf-<pid>.map from the code cache, dropping "
+           "methods flushed since. Requires -XX:+UsePerfMap.";
+  }
+  static const char* impact() {
+    return "Low: Depends on the code cache size";
+  }
+  virtual void execute(DCmdSource source, TRAPS);
+  static int num_arguments() { return 0; }
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+                        "monitor", NULL};
+    return p;
+  }
+};
+
+class LockStatsDCmd : public DCmdWithParser {
+protected:
+  DCmdArgument<bool> _reset;
+public:
+  LockStatsDCmd(outputStream* output, bool heap);
+  static const char* name() { return "VM.lock_stats"; }
+  static const char* description() {
+    return "Print acquisition and contention statistics of the VM's internal "
+           "locks, most blocked time first. Requires -XX:+ProfileVMLocks.";
+  }
+  static const char* impact() { return "Low"; }
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+                        "monitor", NULL};
+    return p;
+  }
+  static int num_arguments();
+  virtual void execute(DCmdSource source, TRAPS);
+};
+
 #endif // SHARE_VM_SERVICES_DIAGNOSTICCOMMAND_HPP
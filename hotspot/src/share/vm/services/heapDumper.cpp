@@ -31,6 +31,8 @@
 #include "memory/genCollectedHeap.hpp"
 #include "memory/universe.hpp"
 #include "oops/objArrayKlass.hpp"
+#include "runtime/arguments.hpp"
+#include "runtime/atomic.inline.hpp"
 #include "runtime/javaCalls.hpp"
 #include "runtime/jniHandles.hpp"
 #include "runtime/reflectionUtils.hpp"
@@ -41,6 +43,7 @@
 #include "services/threadService.hpp"
 #include "utilities/ostream.hpp"
 #include "utilities/macros.hpp"
+#include "utilities/workgroup.hpp"
 #if INCLUDE_ALL_GCS
 #include "gc_implementation/parallelScavenge/parallelScavengeHeap.hpp"
 #endif // INCLUDE_ALL_GCS
@@ -366,12 +369,274 @@ enum {
   INITIAL_CLASS_COUNT = 200
 };
 
+// Compresses a dump into a single gzip member, the way pigz does. The dump
+// is cut into chunks that are deflated independently, so that the heap's
+// safepoint workers can compress them in parallel. Each chunk is primed
+// with the end of the chunk before it as dictionary and ends with a sync
+// flush, so the compressed chunks concatenate into one deflate stream, and
+// their CRCs are combined for the gzip trailer. The deflater lives in the
+// zip library of the JDK.
+
+typedef size_t (JNICALL *GZipBlockBound_t)(size_t in_len, jint level, char** pmsg);
+typedef size_t (JNICALL *GZipBlock_t)(char* dict, size_t dict_len, char* in_buf, size_t in_len,
+                                      char* out_buf, size_t out_len, jint level, jboolean last,
+                                      jint* crc, char** pmsg);
+typedef jint (JNICALL *CRC32Combine_t)(jint crc1, jint crc2, jlong len2);
+
+class DumpCompressor : public CHeapObj<mtInternal> {
+ public:
+  enum {
+    header_size  = 10,
+    end_max_size = 32     // final empty block and trailer
+  };
+
+ private:
+  enum {
+    dict_size = 32*K      // the deflate window
+  };
+
+  struct Chunk {
+    char*  _in;
+    size_t _in_capacity;
+    size_t _in_len;
+    char*  _out;
+    size_t _out_capacity;
+    size_t _out_len;
+    jint   _crc;
+    char*  _msg;
+  };
+
+  static GZipBlockBound_t _gzip_block_bound;
+  static GZipBlock_t      _gzip_block;
+  static CRC32Combine_t   _crc32_combine;
+
+  int    _level;
+  uint   _num_chunks;     // chunks compressed together, one per worker
+  uint   _pending;        // chunks added since the last compress()
+  Chunk* _chunks;
+  char*  _dict;           // end of the chunks compressed so far
+  size_t _dict_len;
+  jint   _crc;            // of the chunks compressed so far
+  julong _length;         // of the chunks compressed so far
+
+  void save_dict(const Chunk* c);
+
+ public:
+  // looks up the deflater, returns an error message if it is not available
+  static const char* load_library();
+
+  DumpCompressor(int level);
+  ~DumpCompressor();
+
+  // copies the next chunk of the dump, returns true if all chunks are
+  // in use and compress() must be called
+  bool add_chunk(const char* buf, size_t len);
+
+  // compresses the pending chunks, returns an error message on failure
+  const char* compress();
+  void compress_chunk(uint i);
+
+  uint pending() const                  { return _pending; }
+  const char* output(uint i) const      { return _chunks[i]._out; }
+  size_t output_length(uint i) const    { return _chunks[i]._out_len; }
+  void clear()                          { _pending = 0; }
+
+  // the gzip header, header_size bytes
+  static void header(u1* buf);
+
+  // ends the deflate stream and writes the gzip trailer, at most
+  // end_max_size bytes; returns their length, or 0 with *msg set
+  size_t end(u1* buf, char** msg);
+};
+
+GZipBlockBound_t DumpCompressor::_gzip_block_bound = NULL;
+GZipBlock_t      DumpCompressor::_gzip_block = NULL;
+CRC32Combine_t   DumpCompressor::_crc32_combine = NULL;
+
+const char* DumpCompressor::load_library() {
+  if (_gzip_block == NULL) {
+    // the zip library has been loaded by the class loader already
+    char path[JVM_MAXPATHLEN];
+    char ebuf[1024];
+    void* handle = NULL;
+    if (os::dll_build_name(path, sizeof(path), Arguments::get_dll_dir(), "zip")) {
+      handle = os::dll_load(path, ebuf, sizeof ebuf);
+    }
+    if (handle == NULL) {
+      return "Cannot load the zip library for compression";
+    }
+    GZipBlockBound_t bound = CAST_TO_FN_PTR(GZipBlockBound_t, os::dll_lookup(handle, "ZIP_GZip_Block_Bound"));
+    GZipBlock_t block = CAST_TO_FN_PTR(GZipBlock_t, os::dll_lookup(handle, "ZIP_GZip_Block"));
+    CRC32Combine_t combine = CAST_TO_FN_PTR(CRC32Combine_t, os::dll_lookup(handle, "ZIP_CRC32_Combine"));
+    if (bound == NULL || block == NULL || combine == NULL) {
+      return "The zip library does not support gzip compression";
+    }
+    _gzip_block_bound = bound;
+    _crc32_combine = combine;
+    _gzip_block = block;
+  }
+  return NULL;
+}
+
+DumpCompressor::DumpCompressor(int level) :
+  _level(level), _pending(0), _dict_len(0), _crc(0), _length(0) {
+  FlexibleWorkGang* workers = Universe::heap()->get_safepoint_workers();
+  _num_chunks = (workers == NULL) ? 1 : MAX2(workers->active_workers(), 1U);
+  _chunks = NEW_C_HEAP_ARRAY(Chunk, _num_chunks, mtInternal);
+  memset(_chunks, 0, _num_chunks * sizeof(Chunk));
+  _dict = NEW_C_HEAP_ARRAY(char, dict_size, mtInternal);
+}
+
+DumpCompressor::~DumpCompressor() {
+  for (uint i = 0; i < _num_chunks; i++) {
+    if (_chunks[i]._in != NULL)  os::free(_chunks[i]._in);
+    if (_chunks[i]._out != NULL) os::free(_chunks[i]._out);
+  }
+  FREE_C_HEAP_ARRAY(Chunk, _chunks, mtInternal);
+  FREE_C_HEAP_ARRAY(char, _dict, mtInternal);
+}
+
+bool DumpCompressor::add_chunk(const char* buf, size_t len) {
+  assert(_pending < _num_chunks, "compress() not called");
+  Chunk* c = &_chunks[_pending++];
+  if (c->_in_capacity < len) {
+    if (c->_in != NULL) os::free(c->_in);
+    c->_in = (char*)os::malloc(len, mtInternal);
+    c->_in_capacity = (c->_in == NULL) ? 0 : len;
+  }
+  if (c->_in != NULL) {
+    memcpy(c->_in, buf, len);
+    c->_in_len = len;
+  } else {
+    c->_in_len = 0;
+    c->_msg = (char*)"Out of memory for compression";
+  }
+  return _pending == _num_chunks;
+}
+
+void DumpCompressor::compress_chunk(uint i) {
+  Chunk* c = &_chunks[i];
+  if (c->_msg != NULL) {
+    return;
+  }
+  size_t bound = (*_gzip_block_bound)(c->_in_len, _level, &c->_msg);
+  if (bound == 0) {
+    return;
+  }
+  if (c->_out_capacity < bound) {
+    if (c->_out != NULL) os::free(c->_out);
+    c->_out = (char*)os::malloc(bound, mtInternal);
+    c->_out_capacity = (c->_out == NULL) ? 0 : bound;
+    if (c->_out == NULL) {
+      c->_msg = (char*)"Out of memory for compression";
+      return;
+    }
+  }
+  // The dictionary only has to be some end of the data before the chunk
+  char* dict = _dict;
+  size_t dict_len = _dict_len;
+  if (i > 0) {
+    const Chunk* prev = &_chunks[i - 1];
+    dict_len = MIN2(prev->_in_len, (size_t)dict_size);
+    dict = prev->_in + prev->_in_len - dict_len;
+  }
+  c->_out_len = (*_gzip_block)(dict, dict_len, c->_in, c->_in_len, c->_out, c->_out_capacity,
+                               _level, JNI_FALSE, &c->_crc, &c->_msg);
+}
+
+class DumpCompressTask : public AbstractGangTask {
+ private:
+  DumpCompressor* _compressor;
+  volatile jint   _next_chunk;
+
+ public:
+  DumpCompressTask(DumpCompressor* compressor) :
+    AbstractGangTask("Heap Dump Compression"),
+    _compressor(compressor), _next_chunk(0) { }
+
+  void work(uint worker_id) {
+    jint i;
+    while ((i = Atomic::add(1, &_next_chunk) - 1) < (jint)_compressor->pending()) {
+      _compressor->compress_chunk((uint)i);
+    }
+  }
+};
+
+const char* DumpCompressor::compress() {
+  // the workers can only be borrowed at a safepoint
+  FlexibleWorkGang* workers = Universe::heap()->get_safepoint_workers();
+  if (workers != NULL && _pending > 1 &&
+      SafepointSynchronize::is_at_safepoint() && Thread::current()->is_VM_thread()) {
+    DumpCompressTask task(this);
+    workers->run_task(&task);
+  } else {
+    for (uint i = 0; i < _pending; i++) {
+      compress_chunk(i);
+    }
+  }
+  for (uint i = 0; i < _pending; i++) {
+    if (_chunks[i]._msg != NULL) {
+      return _chunks[i]._msg;
+    }
+  }
+  for (uint i = 0; i < _pending; i++) {
+    const Chunk* c = &_chunks[i];
+    _crc = (*_crc32_combine)(_crc, c->_crc, (jlong)c->_in_len);
+    _length += c->_in_len;
+  }
+  if (_pending > 0) {
+    save_dict(&_chunks[_pending - 1]);
+  }
+  return NULL;
+}
+
+// keeps the last dict_size bytes compressed as dictionary for the next chunk
+void DumpCompressor::save_dict(const Chunk* c) {
+  if (c->_in_len >= (size_t)dict_size) {
+    memcpy(_dict, c->_in + c->_in_len - dict_size, dict_size);
+    _dict_len = dict_size;
+  } else {
+    size_t keep = MIN2(_dict_len, dict_size - c->_in_len);
+    memmove(_dict, _dict + _dict_len - keep, keep);
+    memcpy(_dict + keep, c->_in, c->_in_len);
+    _dict_len = keep + c->_in_len;
+  }
+}
+
+void DumpCompressor::header(u1* buf) {
+  static const u1 gzip_header[header_size] = {
+    0x1f, 0x8b,              // magic
+    8,                       // deflate
+    0,                       // no flags
+    0, 0, 0, 0,              // no modification time
+    0,                       // no extra flags
+    255                      // unknown OS
+  };
+  memcpy(buf, gzip_header, header_size);
+}
+
+size_t DumpCompressor::end(u1* buf, char** msg) {
+  jint crc;
+  size_t len = (*_gzip_block)(NULL, 0, NULL, 0, (char*)buf, end_max_size - 8,
+                              _level, JNI_TRUE, &crc, msg);
+  if (len == 0) {
+    return 0;
+  }
+  // CRC-32 and length of the uncompressed data, little endian
+  for (int i = 0; i < 4; i++) {
+    buf[len + i]     = (u1)((juint)_crc >> (8 * i));
+    buf[len + 4 + i] = (u1)(_length >> (8 * i));
+  }
+  return len + 8;
+}
+
 // Supports I/O operations on a dump file
 
 class DumpWriter : public StackObj {
  private:
   enum {
-    io_buffer_size  = 8*M
+    io_buffer_size  = 8*M,
+    gzip_chunk_size = 1*M     // also the size of segments in compressed dumps
   };
 
   int _fd;              // file descriptor (-1 if dump file not open)
@@ -382,6 +647,12 @@ class DumpWriter : public StackObj {
   size_t _pos;
 
   jlong _dump_start;
+  bool _dump_length_fixed;      // length of the current record already written
+
+  DumpCompressor* _compressor;  // compressor for gzipped dumps, or NULL
+  size_t _chunk_size;
+  julong _bytes_compressed;     // number of uncompressed bytes of the dump
+                                // handed to the compressor
 
   char* _error;   // error message when I/O fails
 
@@ -398,8 +669,15 @@ class DumpWriter : public StackObj {
   // all I/O go through this function
   void write_internal(void* s, size_t len);
 
+  // compressed dumps are written through these
+  void write_buffered(void* s, size_t len);
+  void flush_chunk();
+  void write_compressed();
+  void write_compressed_end();
+  bool dump_length_pending() const { return _dump_start >= 0 && !_dump_length_fixed; }
+
  public:
-  DumpWriter(const char* path);
+  DumpWriter(const char* path, int gzip_level = 0);
   ~DumpWriter();
 
   void close();
@@ -410,6 +688,16 @@ class DumpWriter : public StackObj {
   void set_dump_start(jlong pos);
   julong current_record_length();
 
+  bool is_compressed() const            { return _compressor != NULL; }
+
+  // the size a compressed dump is cut into segments at
+  size_t chunk_size() const             { return _chunk_size; }
+
+  // writes the final length of the current record at its start, so that
+  // a compressed dump can stream the rest of the record
+  void fix_dump_length(u4 len);
+  bool dump_length_fixed() const        { return _dump_length_fixed; }
+
   // total number of bytes written to the disk
   julong bytes_written() const          { return _bytes_written; }
 
@@ -425,6 +713,9 @@ class DumpWriter : public StackObj {
   jlong current_offset();
   void seek_to_offset(jlong pos);
 
+  // overwrites the u4 written at the given offset
+  void write_u4_at(jlong offset, u4 x);
+
   // writer functions
   void write_raw(void* s, size_t len);
   void write_u1(u1 x)                   { write_raw((void*)&x, 1); }
@@ -437,10 +728,10 @@ class DumpWriter : public StackObj {
   void write_id(u4 x);
 };
 
-DumpWriter::DumpWriter(const char* path) {
+DumpWriter::DumpWriter(const char* path, int gzip_level) {
   // try to allocate an I/O buffer of io_buffer_size. If there isn't
   // sufficient memory then reduce size until we can allocate something.
-  _size = io_buffer_size;
+  _size = (gzip_level > 0) ? gzip_chunk_size : io_buffer_size;
   do {
     _buffer = (char*)os::malloc(_size, mtInternal);
     if (_buffer == NULL) {
@@ -452,11 +743,32 @@ DumpWriter::DumpWriter(const char* path) {
   _error = NULL;
   _bytes_written = 0L;
   _dump_start = (jlong)-1;
+  _dump_length_fixed = false;
+  _compressor = NULL;
+  _chunk_size = _size;
+  _bytes_compressed = 0L;
+  _fd = -1;
+
+  if (gzip_level > 0) {
+    // compressed dumps are always buffered
+    const char* msg = (_buffer == NULL) ? "Out of memory for the dump buffer"
+                                        : DumpCompressor::load_library();
+    if (msg != NULL) {
+      set_error(msg);
+      return;
+    }
+    _compressor = new DumpCompressor(gzip_level);
+  }
+
   _fd = os::create_binary_file(path, false);    // don't replace existing file
 
   // if the open failed we record the error
   if (_fd < 0) {
     _error = (char*)os::strdup(strerror(errno));
+  } else if (is_compressed()) {
+    u1 header[DumpCompressor::header_size];
+    DumpCompressor::header(header);
+    write_internal(header, sizeof(header));
   }
 }
 
@@ -467,6 +779,7 @@ DumpWriter::~DumpWriter() {
   }
   if (_buffer != NULL) os::free(_buffer);
   if (_error != NULL) os::free(_error);
+  if (_compressor != NULL) delete _compressor;
 }
 
 // closes dump file (if open)
@@ -474,6 +787,11 @@ void DumpWriter::close() {
   // flush and close dump file
   if (is_open()) {
     flush();
+    if (is_compressed()) {
+      write_compressed_end();
+    }
+  }
+  if (is_open()) {
     ::close(file_descriptor());
     set_file_descriptor(-1);
   }
@@ -482,13 +800,14 @@ void DumpWriter::close() {
 // sets the dump starting position
 void DumpWriter::set_dump_start(jlong pos) {
   _dump_start = pos;
+  _dump_length_fixed = false;
 }
 
 julong DumpWriter::current_record_length() {
   if (is_open()) {
     // calculate the size of the dump record
-    julong dump_end = bytes_written() + bytes_unwritten();
-    assert(dump_end == (size_t)current_offset(), "checking");
+    julong dump_end = (julong)current_offset();
+    assert(is_compressed() || dump_end == bytes_written() + bytes_unwritten(), "checking");
     julong dump_len = dump_end - dump_start() - 4;
     return dump_len;
   }
@@ -521,6 +840,11 @@ void DumpWriter::write_internal(void* s, size_t len) {
 // write raw bytes
 void DumpWriter::write_raw(void* s, size_t len) {
   if (is_open()) {
+    if (is_compressed()) {
+      write_buffered(s, len);
+      return;
+    }
+
     // flush buffer to make room
     if ((position() + len) >= buffer_size()) {
       flush();
@@ -539,13 +863,93 @@ void DumpWriter::write_raw(void* s, size_t len) {
 
 // flush any buffered bytes to the file
 void DumpWriter::flush() {
-  if (is_open() && position() > 0) {
+  if (is_compressed()) {
+    flush_chunk();
+    if (is_open() && _compressor->pending() > 0) {
+      write_compressed();
+    }
+  } else if (is_open() && position() > 0) {
     write_internal(buffer(), position());
     set_position(0);
   }
 }
 
+// A compressed dump cannot seek back to fix up the length of a record, so
+// everything is written through the buffer and the buffer grows, rather
+// than being flushed, until the length of the current record is known.
+void DumpWriter::write_buffered(void* s, size_t len) {
+  const char* pos = (const char*)s;
+  while (len > 0 && is_open()) {
+    if (position() == buffer_size()) {
+      if (dump_length_pending()) {
+        size_t new_size = MAX2(buffer_size() * 2, position() + len);
+        char* new_buffer = (char*)os::realloc(buffer(), new_size, mtInternal);
+        if (new_buffer == NULL) {
+          set_error("Out of memory for the dump buffer");
+          ::close(file_descriptor());
+          set_file_descriptor(-1);
+          return;
+        }
+        _buffer = new_buffer;
+        _size = new_size;
+      } else {
+        flush_chunk();
+      }
+    }
+    size_t n = MIN2(len, buffer_size() - position());
+    memcpy(buffer() + position(), pos, n);
+    set_position(position() + n);
+    pos += n;
+    len -= n;
+  }
+}
+
+// hands the buffered bytes to the compressor as the next chunk
+void DumpWriter::flush_chunk() {
+  if (is_open() && position() > 0) {
+    _bytes_compressed += position();
+    bool full = _compressor->add_chunk(buffer(), position());
+    set_position(0);
+    if (full) {
+      write_compressed();
+    }
+  }
+}
+
+// compresses the pending chunks and writes them to the file in order
+void DumpWriter::write_compressed() {
+  const char* msg = _compressor->compress();
+  if (msg != NULL) {
+    set_error(msg);
+    ::close(file_descriptor());
+    set_file_descriptor(-1);
+  }
+  for (uint i = 0; i < _compressor->pending() && is_open(); i++) {
+    write_internal((void*)_compressor->output(i), _compressor->output_length(i));
+  }
+  _compressor->clear();
+}
+
+// ends the compressed stream, once everything has been written
+void DumpWriter::write_compressed_end() {
+  assert(position() == 0 && _compressor->pending() == 0, "must have been flushed");
+  u1 end[DumpCompressor::end_max_size];
+  char* msg = NULL;
+  size_t len = _compressor->end(end, &msg);
+  if (len == 0) {
+    set_error(msg);
+    ::close(file_descriptor());
+    set_file_descriptor(-1);
+    return;
+  }
+  write_internal(end, len);
+}
+
 jlong DumpWriter::current_offset() {
+  if (is_compressed()) {
+    // the offset into the uncompressed dump
+    return is_open() ? (jlong)(_bytes_compressed + position()) : (jlong)-1;
+  }
   if (is_open()) {
     // the offset is the file offset plus whatever we have buffered
     jlong offset = os::current_file_offset(file_descriptor());
@@ -558,6 +962,7 @@ jlong DumpWriter::current_offset() {
 
 void DumpWriter::seek_to_offset(jlong off) {
   assert(off >= 0, "bad offset");
+  assert(!is_compressed(), "cannot seek in a compressed dump");
 
   // need to flush before seeking
   flush();
@@ -587,6 +992,29 @@ void DumpWriter::write_u8(u8 x) {
   write_raw((void*)&v, 8);
 }
 
+void DumpWriter::write_u4_at(jlong offset, u4 x) {
+  if (is_compressed()) {
+    // the offset is still buffered
+    assert(offset >= (jlong)_bytes_compressed &&
+           offset + 4 <= current_offset(), "offset not buffered");
+    Bytes::put_Java_u4((address)(buffer() + (offset - _bytes_compressed)), x);
+  } else {
+    jlong end = current_offset();
+    seek_to_offset(offset);
+    write_u4(x);
+    // adjust the total size written to keep the bytes written correct.
+    adjust_bytes_written(-((jlong) sizeof(u4)));
+    // seek to the end so we can continue
+    seek_to_offset(end);
+  }
+}
+
+void DumpWriter::fix_dump_length(u4 len) {
+  assert(dump_length_pending(), "no dump record or length already fixed");
+  write_u4_at(dump_start(), len);
+  _dump_length_fixed = true;
+}
+
 void DumpWriter::write_objectID(oop o) {
   address a = (address)o;
 #ifdef _LP64
@@ -1121,6 +1549,17 @@ int DumperSupport::calculate_array_max_length(DumpWriter* writer, arrayOop array
     warning("cannot dump array of type %s[] with length %d; truncating to length %d",
             type2name_tab[type], array->length(), length);
   }
+
+  // A compressed dump buffers the current segment until its length is
+  // known. Arrays larger than a segment get a segment of their own, whose
+  // length is known up front, so that they can be streamed instead.
+  if (writer->is_compressed() && header_size + length_in_bytes > writer->chunk_size()) {
+    if (current_record_length > 0) {
+      write_current_dump_record_length(writer);
+      write_dump_header(writer);
+    }
+    writer->fix_dump_length((u4)(header_size + length_in_bytes));
+  }
   return length;
 }
 
@@ -1553,7 +1992,6 @@ void DumperSupport::write_dump_header(DumpWriter* writer) {
 // fixes up the length of the current dump record
 void DumperSupport::write_current_dump_record_length(DumpWriter* writer) {
   if (writer->is_open()) {
-    julong dump_end = writer->bytes_written() + writer->bytes_unwritten();
     julong dump_len = writer->current_record_length();
 
     // record length must fit in a u4
@@ -1561,16 +1999,11 @@ void DumperSupport::write_current_dump_record_length(DumpWriter* writer) {
       warning("record is too large");
     }
 
-    // seek to the dump start and fix-up the length
+    // fix-up the length at the dump start
     assert(writer->dump_start() >= 0, "no dump start recorded");
-    writer->seek_to_offset(writer->dump_start());
-    writer->write_u4((u4)dump_len);
-
-    // adjust the total size written to keep the bytes written correct.
-    writer->adjust_bytes_written(-((jlong) sizeof(u4)));
-
-    // seek to dump end so we can continue
-    writer->seek_to_offset(dump_end);
+    if (!writer->dump_length_fixed()) {
+      writer->write_u4_at(writer->dump_start(), (u4)dump_len);
+    }
 
     // no current dump record
     writer->set_dump_start((jlong)-1);
@@ -1583,7 +2016,9 @@ void VM_HeapDumper::check_segment_length() {
   if (writer()->is_open()) {
     julong dump_len = writer()->current_record_length();
 
-    if (dump_len > 2UL*G) {
+    // compressed dumps hold the current segment in memory
+    julong max_len = writer()->is_compressed() ? (julong)writer()->chunk_size() : 2UL*G;
+    if (dump_len > max_len) {
       DumperSupport::write_current_dump_record_length(writer());
       DumperSupport::write_dump_header(writer());
     }
@@ -1709,7 +2144,10 @@ int VM_HeapDumper::do_thread(JavaThread* java_thread, u4 thread_serial_num) {
             if (last_entry_frame != NULL) {
               // JNI locals for the entry frame
               assert(last_entry_frame->is_entry_frame(), "checking");
-              last_entry_frame->entry_frame_call_wrapper()->handles()->oops_do(&blk);
+              JNIHandleBlock* handles = last_entry_frame->entry_frame_call_wrapper()->handles();
+              if (handles != NULL) {
+                handles->oops_do(&blk);
+              }
             }
           }
         }
@@ -1862,6 +2300,9 @@ void VM_HeapDumper::doit() {
   // fixes up the length of the dump record and writes the HPROF_HEAP_DUMP_END record.
   DumperSupport::end_of_dump(writer());
 
+  // compress the last chunks while the workers can still be used
+  writer()->flush();
+
   // Now we clear the global variables, so that a future dumper might run.
   clear_global_dumper();
   clear_global_writer();
@@ -1923,8 +2364,9 @@ void VM_HeapDumper::dump_stack_traces() {
 
 // dump the heap to given path.
 PRAGMA_FORMAT_NONLITERAL_IGNORED_EXTERNAL
-int HeapDumper::dump(const char* path) {
+int HeapDumper::dump(const char* path, int gzip_level) {
   assert(path != NULL && strlen(path) > 0, "path missing");
+  assert(gzip_level >= 0 && gzip_level <= 9, "invalid compression level");
 
   // print message in interactive case
   if (print_to_tty()) {
@@ -1933,7 +2375,7 @@ int HeapDumper::dump(const char* path) {
   }
 
   // create the dump writer. If the file can be opened then bail
-  DumpWriter writer(path);
+  DumpWriter writer(path, gzip_level);
   if (!writer.is_open()) {
     set_error(writer.error());
     if (print_to_tty()) {
@@ -2025,7 +2467,7 @@ void HeapDumper::dump_heap(bool oome) {
   const int max_digit_chars = 20;
 
   const char* dump_file_name = "java_pid";
-  const char* dump_file_ext  = ".hprof";
+  const char* dump_file_ext  = (HeapDumpGzipLevel > 0) ? ".hprof.gz" : ".hprof";
 
   // The dump file defaults to java_pid<pid>.hprof in the current working
   // directory. HeapDumpPath=<file> can be used to specify an alternative
@@ -2093,6 +2535,6 @@ void HeapDumper::dump_heap(bool oome) {
   HeapDumper dumper(false /* no GC before heap dump */,
                     true  /* send to tty */,
                     oome  /* pass along out-of-memory-error flag */);
-  dumper.dump(my_path);
+  dumper.dump(my_path, (int)MIN2(HeapDumpGzipLevel, (uintx)9));
   os::free(my_path);
 }
@@ -71,7 +71,8 @@ class HeapDumper : public StackObj {
   ~HeapDumper();
 
   // dumps the heap to the specified file, returns 0 if success.
-  int dump(const char* path);
+  // A gzip_level from 1 to 9 writes a gzip compressed file.
+  int dump(const char* path, int gzip_level = 0);
 
   // returns error message (resource allocated), or NULL if no error
   char* error_as_C_string() const;
@@ -36,6 +36,8 @@
 
 volatile bool LowMemoryDetector::_enabled_for_collected_pools = false;
 volatile jint LowMemoryDetector::_disabled_count = 0;
+MemoryPool** LowMemoryDetector::_threshold_pools = NULL;
+volatile int LowMemoryDetector::_num_threshold_pools = 0;
 
 bool LowMemoryDetector::has_pending_requests() {
   assert(Service_lock->owned_by_self(), "Must own Service_lock");
@@ -81,9 +83,9 @@ void LowMemoryDetector::detect_low_memory() {
   MutexLockerEx ml(Service_lock, Mutex::_no_safepoint_check_flag);
 
   bool has_pending_requests = false;
-  int num_memory_pools = MemoryService::num_memory_pools();
-  for (int i = 0; i < num_memory_pools; i++) {
-    MemoryPool* pool = MemoryService::get_memory_pool(i);
+  int num_threshold_pools = OrderAccess::load_acquire(&_num_threshold_pools);
+  for (int i = 0; i < num_threshold_pools; i++) {
+    MemoryPool* pool = _threshold_pools[i];
     SensorInfo* sensor = pool->usage_sensor();
     if (sensor != NULL &&
         pool->usage_threshold()->is_high_threshold_supported() &&
@@ -145,17 +147,24 @@ void LowMemoryDetector::detect_after_gc_memory(MemoryPool* pool) {
   }
 }
 
-// recompute enabled flag
+// recompute enabled flag and the pools to check
 void LowMemoryDetector::recompute_enabled_for_collected_pools() {
-  bool enabled = false;
+  MutexLocker ml(Management_lock);
   int num_memory_pools = MemoryService::num_memory_pools();
+  if (_threshold_pools == NULL) {
+    // The pools are all created during startup
+    _threshold_pools = NEW_C_HEAP_ARRAY(MemoryPool*, num_memory_pools, mtInternal);
+  }
+  bool enabled = false;
+  int n = 0;
   for (int i=0; i<num_memory_pools; i++) {
     MemoryPool* pool = MemoryService::get_memory_pool(i);
-    if (pool->is_collected_pool() && is_enabled(pool)) {
-      enabled = true;
-      break;
+    if (is_enabled(pool)) {
+      _threshold_pools[n++] = pool;
+      enabled = enabled || pool->is_collected_pool();
     }
   }
+  OrderAccess::release_store(&_num_threshold_pools, n);
   _enabled_for_collected_pools = enabled;
 }
 
@@ -26,6 +26,7 @@
 #define SHARE_VM_SERVICES_LOWMEMORYDETECTOR_HPP
 
 #include "memory/allocation.hpp"
+#include "runtime/orderAccess.inline.hpp"
 #include "services/memoryPool.hpp"
 #include "services/memoryService.hpp"
 
@@ -219,6 +220,13 @@ private:
   // > 0 if temporary disabed
   static volatile jint _disabled_count;
 
+  // The pools that had a usage sensor and a high usage threshold when the
+  // thresholds last changed, so that checking them does not visit every
+  // pool. Entries are only rewritten by recompute_enabled_for_collected_pools();
+  // a reader racing with it may see a stale pool, which is_enabled() weeds out.
+  static MemoryPool** _threshold_pools;
+  static volatile int _num_threshold_pools;
+
   static void check_memory_usage();
   static bool has_pending_requests();
   static bool temporary_disabled() { return _disabled_count > 0; }
@@ -259,9 +267,9 @@ public:
     if (!is_enabled_for_collected_pools()) {
       return;
     }
-    int num_memory_pools = MemoryService::num_memory_pools();
-    for (int i=0; i<num_memory_pools; i++) {
-      MemoryPool* pool = MemoryService::get_memory_pool(i);
+    int num_threshold_pools = OrderAccess::load_acquire(&_num_threshold_pools);
+    for (int i = 0; i < num_threshold_pools; i++) {
+      MemoryPool* pool = _threshold_pools[i];
 
       // if low memory detection is enabled then check if the
       // current used exceeds the high threshold
@@ -47,6 +47,7 @@ class MallocSite : public AllocationSite<MemoryCounter> {
 
   void allocate(size_t size)      { data()->allocate(size);   }
   void deallocate(size_t size)    { data()->deallocate(size); }
+  void scale(size_t factor)       { data()->scale(factor);    }
 
   // Memory allocated from this code path
   size_t size()  const { return peek()->size(); }
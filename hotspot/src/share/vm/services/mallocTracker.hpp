@@ -77,6 +77,12 @@ class MemoryCounter VALUE_OBJ_CLASS_SPEC {
     }
   }
 
+  // Not atomic, only used on copies of sampled counters.
+  inline void scale(size_t factor) {
+    _count *= factor;
+    _size  *= factor;
+  }
+
   inline size_t count() const { return _count; }
   inline size_t size()  const { return _size;  }
   DEBUG_ONLY(inline size_t peak_count() const { return _peak_count; })
@@ -243,15 +249,17 @@ class MallocHeader VALUE_OBJ_CLASS_SPEC {
   size_t           _size      : 64;
   size_t           _flags     : 8;
   size_t           _pos_idx   : 16;
-  size_t           _bucket_idx: 40;
-#define MAX_MALLOCSITE_TABLE_SIZE right_n_bits(40)
+  size_t           _bucket_idx: 39;
+  size_t           _has_site  : 1;
+#define MAX_MALLOCSITE_TABLE_SIZE right_n_bits(39)
 #define MAX_BUCKET_LENGTH         right_n_bits(16)
 #else
   size_t           _size      : 32;
   size_t           _flags     : 8;
   size_t           _pos_idx   : 8;
-  size_t           _bucket_idx: 16;
-#define MAX_MALLOCSITE_TABLE_SIZE  right_n_bits(16)
+  size_t           _bucket_idx: 15;
+  size_t           _has_site  : 1;
+#define MAX_MALLOCSITE_TABLE_SIZE  right_n_bits(15)
 #define MAX_BUCKET_LENGTH          right_n_bits(8)
 #endif  // _LP64
 
@@ -269,11 +277,15 @@ class MallocHeader VALUE_OBJ_CLASS_SPEC {
     if (level == NMT_detail) {
       size_t bucket_idx;
       size_t pos_idx;
-      if (record_malloc_site(stack, size, &bucket_idx, &pos_idx, flags)) {
+      _has_site = 0;
+      // Mallocs whose stack was not sampled are only counted in the summary.
+      if ((NMTDetailSampleInterval <= 1 || !stack.is_empty()) &&
+          record_malloc_site(stack, size, &bucket_idx, &pos_idx, flags)) {
         assert(bucket_idx <= MAX_MALLOCSITE_TABLE_SIZE, "Overflow bucket index");
         assert(pos_idx <= MAX_BUCKET_LENGTH, "Overflow bucket position index");
         _bucket_idx = bucket_idx;
         _pos_idx = pos_idx;
+        _has_site = 1;
       }
     }
 
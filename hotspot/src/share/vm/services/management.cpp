@@ -729,6 +729,8 @@ JVM_ENTRY(void, jmm_SetPoolSensor(JNIEnv* env, jobject obj, jmmThresholdType typ
     case JMM_USAGE_THRESHOLD_LOW:
       // have only one sensor for threshold high and low
       mpool->set_usage_sensor_obj(sensor_h);
+      // the pool may now need checking
+      LowMemoryDetector::recompute_enabled_for_collected_pools();
       break;
     case JMM_COLLECTION_USAGE_THRESHOLD_HIGH:
     case JMM_COLLECTION_USAGE_THRESHOLD_LOW:
@@ -2385,10 +2387,63 @@ JVM_ENTRY(void, jmm_GetThreadCpuTimesWithKind(JNIEnv *env, jlongArray ids,
 JVM_END
 
 
+// Gets the resource usage of a set of threads in a single pass over the
+// thread list. For the thread ID at index i of the given array, the
+// JMM_THREAD_USAGE_FIELDS elements of the usage array starting at
+// i * JMM_THREAD_USAGE_FIELDS are filled in as described by
+// jmmThreadUsageField; they are -1 if the thread does not exist or
+// has terminated.
+JVM_ENTRY(void, jmm_GetThreadResourceUsage(JNIEnv *env, jlongArray ids,
+                                           jlongArray usageArray))
+  // Check if threads is null
+  if (ids == NULL || usageArray == NULL) {
+    THROW(vmSymbols::java_lang_NullPointerException());
+  }
+
+  ResourceMark rm(THREAD);
+  typeArrayOop ta = typeArrayOop(JNIHandles::resolve_non_null(ids));
+  typeArrayHandle ids_ah(THREAD, ta);
+
+  typeArrayOop ua = typeArrayOop(JNIHandles::resolve_non_null(usageArray));
+  typeArrayHandle usageArray_h(THREAD, ua);
+
+  // validate the thread id array
+  validate_thread_id_array(ids_ah, CHECK);
+
+  // usageArray must hold the fields for each of the given thread IDs
+  int num_threads = ids_ah->length();
+  if ((jlong)num_threads * JMM_THREAD_USAGE_FIELDS != usageArray_h->length()) {
+    THROW_MSG(vmSymbols::java_lang_IllegalArgumentException(),
+              "The length of the given long array does not match the length of "
+              "the given array of thread IDs times the number of usage fields");
+  }
+
+  ThreadUsageSnapshot snapshot;
+  MutexLockerEx ml(Threads_lock);
+  snapshot.collect();
+  for (int i = 0; i < num_threads; i++) {
+    const ThreadUsage* usage = snapshot.find(ids_ah->long_at(i));
+    const int base = i * JMM_THREAD_USAGE_FIELDS;
+    if (usage == NULL) {
+      for (int j = 0; j < JMM_THREAD_USAGE_FIELDS; j++) {
+        usageArray_h->long_at_put(base + j, -1);
+      }
+      continue;
+    }
+    usageArray_h->long_at_put(base + JMM_THREAD_USAGE_CPU_TIME, usage->_cpu_time);
+    usageArray_h->long_at_put(base + JMM_THREAD_USAGE_USER_TIME, usage->_user_time);
+    usageArray_h->long_at_put(base + JMM_THREAD_USAGE_ALLOCATED_BYTES, usage->_allocated_bytes);
+    usageArray_h->long_at_put(base + JMM_THREAD_USAGE_BLOCKED_COUNT, usage->_blocked_count);
+    usageArray_h->long_at_put(base + JMM_THREAD_USAGE_BLOCKED_TIME, usage->_blocked_time);
+    usageArray_h->long_at_put(base + JMM_THREAD_USAGE_WAITED_COUNT, usage->_waited_count);
+    usageArray_h->long_at_put(base + JMM_THREAD_USAGE_WAITED_TIME, usage->_waited_time);
+    usageArray_h->long_at_put(base + JMM_THREAD_USAGE_SAFEPOINT_TIME, usage->_safepoint_time);
+  }
+JVM_END
 
 #if INCLUDE_MANAGEMENT
 const struct jmmInterface_1_ jmm_interface = {
-  NULL,
+  jmm_GetThreadResourceUsage,
   jmm_GetOneThreadAllocatedMemory,
   jmm_GetVersion,
   jmm_GetOptionalSupport,
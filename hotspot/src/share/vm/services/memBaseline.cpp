@@ -94,8 +94,13 @@ class MallocAllocationSiteWalker : public MallocSiteWalker {
   }
 
   bool do_malloc_site(const MallocSite* site) {
-    if (site->size() >= MemBaseline::SIZE_THRESHOLD) {
-      if (_malloc_sites.add(*site) != NULL) {
+    // Only every NMTDetailSampleInterval-th malloc was recorded.
+    MallocSite scaled_site = *site;
+    if (NMTDetailSampleInterval > 1) {
+      scaled_site.scale(NMTDetailSampleInterval);
+    }
+    if (scaled_site.size() >= MemBaseline::SIZE_THRESHOLD) {
+      if (_malloc_sites.add(scaled_site) != NULL) {
         _count++;
         return true;
       } else {
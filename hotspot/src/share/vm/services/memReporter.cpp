@@ -185,6 +185,10 @@ void MemDetailReporter::report_detail() {
   // Start detail report
   outputStream* out = output();
   out->print_cr("Details:\n");
+  if (NMTDetailSampleInterval > 1) {
+    out->print_cr("Malloc sites are sampled every " UINTX_FORMAT " mallocs "
+                  "and their numbers are estimates.\n", NMTDetailSampleInterval);
+  }
 
   report_malloc_sites();
   report_virtual_memory_allocation_sites();
@@ -38,6 +38,7 @@
 
 volatile NMT_TrackingLevel MemTracker::_tracking_level = NMT_unknown;
 NMT_TrackingLevel MemTracker::_cmdline_tracking_level = NMT_unknown;
+intx MemTracker::_sample_countdown = 0;
 
 MemBaseline MemTracker::_baseline;
 Mutex*      MemTracker::_query_lock = NULL;
@@ -33,6 +33,8 @@
 
 #define CURRENT_PC   NativeCallStack::empty_stack()
 #define CALLER_PC    NativeCallStack::empty_stack()
+#define UNSAMPLED_CURRENT_PC  NativeCallStack::empty_stack()
+#define UNSAMPLED_CALLER_PC   NativeCallStack::empty_stack()
 
 class Tracker : public StackObj {
  public:
@@ -82,10 +84,20 @@ class MemTracker : AllStatic {
 
 extern volatile bool NMT_stack_walkable;
 
-#define CURRENT_PC ((MemTracker::tracking_level() == NMT_detail && NMT_stack_walkable) ? \
+// With NMTDetailSampleInterval > 1, CURRENT_PC and CALLER_PC only walk the
+// stack for every Nth call, and mallocs with an empty stack do not go into
+// the malloc site table. Virtual memory is reserved rarely enough that it is
+// always recorded with UNSAMPLED_CURRENT_PC or UNSAMPLED_CALLER_PC.
+#define CURRENT_PC ((MemTracker::tracking_level() == NMT_detail && NMT_stack_walkable && \
+                     MemTracker::sample_stack()) ?                                      \
                     NativeCallStack(0, true) : NativeCallStack::empty_stack())
-#define CALLER_PC  ((MemTracker::tracking_level() == NMT_detail && NMT_stack_walkable) ?  \
+#define CALLER_PC  ((MemTracker::tracking_level() == NMT_detail && NMT_stack_walkable && \
+                     MemTracker::sample_stack()) ?                                      \
                     NativeCallStack(1, true) : NativeCallStack::empty_stack())
+#define UNSAMPLED_CURRENT_PC ((MemTracker::tracking_level() == NMT_detail && NMT_stack_walkable) ? \
+                              NativeCallStack(0, true) : NativeCallStack::empty_stack())
+#define UNSAMPLED_CALLER_PC  ((MemTracker::tracking_level() == NMT_detail && NMT_stack_walkable) ? \
+                              NativeCallStack(1, true) : NativeCallStack::empty_stack())
 
 class MemBaseline;
 class Mutex;
@@ -126,6 +138,16 @@ class MemTracker : AllStatic {
   // any memory.
   static void init();
 
+  // Whether the stack of the current malloc should be walked,
+  // true for every NMTDetailSampleInterval-th call. The countdown
+  // is racy on purpose, a lost update only moves the next sample.
+  static inline bool sample_stack() {
+    if (NMTDetailSampleInterval <= 1) return true;
+    if (--_sample_countdown > 0) return false;
+    _sample_countdown = (intx)NMTDetailSampleInterval;
+    return true;
+  }
+
   // Shutdown native memory tracking
   static void shutdown();
 
@@ -251,7 +273,7 @@ class MemTracker : AllStatic {
     if (addr != NULL) {
       // uses thread stack malloc slot for book keeping number of threads
       MallocMemorySummary::record_malloc(0, mtThreadStack);
-      record_virtual_memory_reserve_and_commit(addr, size, CALLER_PC, mtThreadStack);
+      record_virtual_memory_reserve_and_commit(addr, size, UNSAMPLED_CALLER_PC, mtThreadStack);
     }
   }
 
@@ -309,6 +331,8 @@ class MemTracker : AllStatic {
   static bool                         _is_nmt_env_valid;
   // command line tracking level
   static NMT_TrackingLevel            _cmdline_tracking_level;
+  // calls left until the next sampled malloc stack
+  static intx                         _sample_countdown;
   // Stored baseline
   static MemBaseline      _baseline;
   // Query lock
@@ -30,7 +30,9 @@
 #include "oops/instanceKlass.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/handles.inline.hpp"
+#include "runtime/handshake.hpp"
 #include "runtime/init.hpp"
+#include "runtime/safepointMechanism.hpp"
 #include "runtime/thread.hpp"
 #include "runtime/vframe.hpp"
 #include "runtime/thread.inline.hpp"
@@ -238,6 +240,31 @@ void ThreadService::remove_thread_dump(ThreadDumpResult* dump) {
   assert(found, "The threaddump result to be removed must exist.");
 }
 
+// Fills in the stack trace of a snapshot while the target thread is
+// stopped by a handshake.
+class ThreadStackTraceHandshake : public ThreadClosure {
+  Handle _thread_obj;
+  ThreadSnapshot* _snapshot;
+
+ public:
+  ThreadStackTraceHandshake(Handle thread_obj, ThreadSnapshot* snapshot)
+    : _thread_obj(thread_obj), _snapshot(snapshot) {}
+
+  void do_thread(Thread* th) {
+    JavaThread* jt = (JavaThread*) th;
+    // The JavaThread may have been replaced by a new one at the same
+    // address since it was looked up from the java.lang.Thread.
+    if (jt->threadObj() != _thread_obj() ||
+        jt->is_exiting() ||
+        jt->is_hidden_from_external_view()) {
+      return;
+    }
+    ThreadStackTrace* stacktrace = new ThreadStackTrace(jt, false /* with locked monitors */);
+    _snapshot->set_stack_trace(stacktrace);
+    stacktrace->dump_stack_at_safepoint(-1 /* entire stack */);
+  }
+};
+
 // Dump stack trace of threads specified in the given threads array.
 // Returns StackTraceElement[][] each element is the stack trace of a thread in
 // the corresponding entry in the given threads array
@@ -247,13 +274,34 @@ Handle ThreadService::dump_stack_traces(GrowableArray<instanceHandle>* threads,
   assert(num_threads > 0, "just checking");
 
   ThreadDumpResult dump_result;
-  VM_ThreadDump op(&dump_result,
-                   threads,
-                   num_threads,
-                   -1,    /* entire stack */
-                   false, /* with locked monitors */
-                   false  /* with locked synchronizers */);
-  VMThread::execute(&op);
+  if (SafepointMechanism::uses_thread_local_poll()) {
+    // Stop one thread at a time instead of all of them. The snapshots
+    // stay registered in dump_result so the collected frames are GC roots.
+    for (int i = 0; i < num_threads; i++) {
+      ThreadSnapshot* snapshot = new ThreadSnapshot();
+      dump_result.add_thread_snapshot(snapshot);
+
+      instanceHandle th = threads->at(i);
+      if (th() == NULL) {
+        continue;
+      }
+      JavaThread* jt = java_lang_Thread::thread(th());
+      if (jt == NULL) {
+        // thread not alive
+        continue;
+      }
+      ThreadStackTraceHandshake cl(th, snapshot);
+      Handshake::execute(&cl, jt);
+    }
+  } else {
+    VM_ThreadDump op(&dump_result,
+                     threads,
+                     num_threads,
+                     -1,    /* entire stack */
+                     false, /* with locked monitors */
+                     false  /* with locked synchronizers */);
+    VMThread::execute(&op);
+  }
 
   // Allocate the resulting StackTraceElement[][] object
 
@@ -532,6 +580,24 @@ public:
   }
 };
 
+void ObjectMonitorsByOwner::do_monitor(ObjectMonitor* mid) {
+  Thread* owner = (Thread*) mid->owner();
+  if (owner == NULL) {
+    return;
+  }
+  GrowableArray<oop>** list = _table.get(owner);
+  if (list == NULL) {
+    _table.put(owner, new GrowableArray<oop>(INITIAL_ARRAY_SIZE));
+    list = _table.get(owner);
+  }
+  (*list)->append((oop) mid->object());
+}
+
+GrowableArray<oop>* ObjectMonitorsByOwner::owned_by(Thread* thread) const {
+  GrowableArray<oop>** list = _table.get(thread);
+  return list != NULL ? *list : NULL;
+}
+
 ThreadStackTrace::ThreadStackTrace(JavaThread* t, bool with_locked_monitors) {
   _thread = t;
   _frames = new (ResourceObj::C_HEAP, mtInternal) GrowableArray<StackFrameInfo*>(INITIAL_ARRAY_SIZE, true);
@@ -554,8 +620,9 @@ ThreadStackTrace::~ThreadStackTrace() {
   }
 }
 
-void ThreadStackTrace::dump_stack_at_safepoint(int maxDepth) {
-  assert(SafepointSynchronize::is_at_safepoint(), "all threads are stopped");
+void ThreadStackTrace::dump_stack_at_safepoint(int maxDepth, ObjectMonitorsByOwner* monitors) {
+  assert(SafepointSynchronize::is_at_safepoint() || _thread->is_handshake_safe_for(Thread::current()),
+         "all threads are stopped");
 
   if (_thread->has_last_Java_frame()) {
     RegisterMap reg_map(_thread);
@@ -579,8 +646,19 @@ void ThreadStackTrace::dump_stack_at_safepoint(int maxDepth) {
   if (_with_locked_monitors) {
     // Iterate inflated monitors and find monitors locked by this thread
     // not found in the stack
-    InflatedMonitorsClosure imc(_thread, this);
-    ObjectSynchronizer::monitors_iterate(&imc);
+    if (monitors != NULL) {
+      GrowableArray<oop>* owned = monitors->owned_by(_thread);
+      int length = (owned != NULL ? owned->length() : 0);
+      for (int i = 0; i < length; i++) {
+        oop object = owned->at(i);
+        if (!is_owned_monitor_on_stack(object)) {
+          add_jni_locked_monitor(object);
+        }
+      }
+    } else {
+      InflatedMonitorsClosure imc(_thread, this);
+      ObjectSynchronizer::monitors_iterate(&imc);
+    }
   }
 }
 
@@ -763,11 +841,85 @@ ThreadStatistics::ThreadStatistics() {
   _contended_enter_count = 0;
   _monitor_wait_count = 0;
   _sleep_count = 0;
+  _safepoint_ticks = 0;
+  _snapshot_cpu_time = 0;
+  _snapshot_user_time = 0;
   _count_pending_reset = false;
   _timer_pending_reset = false;
   memset((void*) _perf_recursion_counts, 0, sizeof(_perf_recursion_counts));
 }
 
+ThreadUsageSnapshot::ThreadUsageSnapshot() : _sorted(false) {
+  _usage = new GrowableArray<ThreadUsage>(Threads::number_of_threads());
+}
+
+void ThreadUsageSnapshot::collect() {
+  assert_locked_or_safepoint(Threads_lock);
+  assert(_usage->is_empty(), "collected once");
+  for (JavaThread* jt = Threads::first(); jt != NULL; jt = jt->next()) {
+    ThreadUsage usage;
+    collect(jt, &usage);
+    _usage->append(usage);
+  }
+}
+
+jlong ThreadUsageSnapshot::ticks_to_nanos(jlong ticks) {
+  return (jlong)((double)ticks * NANOSECS_PER_SEC / os::elapsed_frequency());
+}
+
+void ThreadUsageSnapshot::collect(JavaThread* thread, ThreadUsage* usage) {
+  ThreadStatistics* const stat = thread->get_thread_stat();
+  const oop tobj = thread->threadObj();
+  usage->_thread = thread;
+  usage->_thread_id = tobj != NULL ? java_lang_Thread::thread_id(tobj) : 0;
+
+  usage->_cpu_time = -1;
+  usage->_user_time = -1;
+  if (os::is_thread_cpu_time_supported()) {
+    const jlong cpu_time = os::thread_cpu_time(thread, true);
+    if (cpu_time != stat->_snapshot_cpu_time) {
+      // the user time is expensive to read on some platforms
+      stat->_snapshot_cpu_time = cpu_time;
+      stat->_snapshot_user_time = os::thread_cpu_time(thread, false);
+    }
+    usage->_cpu_time = cpu_time;
+    usage->_user_time = stat->_snapshot_user_time;
+  }
+  usage->_allocated_bytes = thread->cooked_allocated_bytes();
+
+  const bool timed = ThreadService::is_thread_monitoring_contention();
+  usage->_blocked_count = stat->contended_enter_count();
+  usage->_blocked_time = timed ? ticks_to_nanos(stat->contended_enter_ticks()) : -1;
+  usage->_waited_count = stat->monitor_wait_count() + stat->sleep_count();
+  usage->_waited_time = timed ? ticks_to_nanos(stat->monitor_wait_ticks() + stat->sleep_ticks()) : -1;
+  usage->_safepoint_time = ticks_to_nanos(stat->safepoint_ticks());
+}
+
+static int compare_thread_id(ThreadUsage* a, ThreadUsage* b) {
+  return a->_thread_id < b->_thread_id ? -1 : (a->_thread_id > b->_thread_id ? 1 : 0);
+}
+
+const ThreadUsage* ThreadUsageSnapshot::find(jlong thread_id) {
+  if (!_sorted) {
+    _usage->sort(compare_thread_id);
+    _sorted = true;
+  }
+  int low = 0;
+  int high = _usage->length() - 1;
+  while (low <= high) {
+    const int mid = (low + high) / 2;
+    const ThreadUsage* const usage = _usage->adr_at(mid);
+    if (usage->_thread_id < thread_id) {
+      low = mid + 1;
+    } else if (usage->_thread_id > thread_id) {
+      high = mid - 1;
+    } else {
+      return usage;
+    }
+  }
+  return NULL;
+}
+
 ThreadSnapshot::ThreadSnapshot(JavaThread* thread) {
   _thread = thread;
   _threadObj = thread->threadObj();
@@ -834,9 +986,10 @@ ThreadSnapshot::~ThreadSnapshot() {
   delete _concurrent_locks;
 }
 
-void ThreadSnapshot::dump_stack_at_safepoint(int max_depth, bool with_locked_monitors) {
+void ThreadSnapshot::dump_stack_at_safepoint(int max_depth, bool with_locked_monitors,
+                                             ObjectMonitorsByOwner* monitors) {
   _stack_trace = new ThreadStackTrace(_thread, with_locked_monitors);
-  _stack_trace->dump_stack_at_safepoint(max_depth);
+  _stack_trace->dump_stack_at_safepoint(max_depth, monitors);
 }
 
 
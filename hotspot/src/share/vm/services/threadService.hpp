@@ -34,6 +34,8 @@
 #include "runtime/perfData.hpp"
 #include "services/management.hpp"
 #include "services/serviceUtil.hpp"
+#include "utilities/growableArray.hpp"
+#include "utilities/resourceHash.hpp"
 
 class OopClosure;
 class ThreadDumpResult;
@@ -41,6 +43,7 @@ class ThreadStackTrace;
 class ThreadSnapshot;
 class StackFrameInfo;
 class ThreadConcurrentLocks;
+class ObjectMonitorsByOwner;
 class DeadlockCycle;
 
 // VM monitoring and management support for the thread and
@@ -129,6 +132,12 @@ private:
   jlong        _sleep_count;
   elapsedTimer _sleep_timer;
 
+  // Updated by the owning thread when it blocks for a safepoint
+  jlong        _safepoint_ticks;
+
+  // CPU times as of the last ThreadUsageSnapshot, guarded by the Threads_lock
+  jlong        _snapshot_cpu_time;
+  jlong        _snapshot_user_time;
 
   // These two reset flags are set to true when another thread
   // requests to reset the statistics.  The actual statistics
@@ -166,6 +175,7 @@ public:
   jlong monitor_wait_ticks()               { return (_timer_pending_reset ? 0 : _monitor_wait_timer.active_ticks()); }
   jlong sleep_count()                      { return (_count_pending_reset ? 0 : _sleep_count); }
   jlong sleep_ticks()                      { return (_timer_pending_reset ? 0 : _sleep_timer.active_ticks()); }
+  jlong safepoint_ticks()                  { return _safepoint_ticks; }
 
   void monitor_wait()                      { check_and_reset_count(); _monitor_wait_count++; }
   void monitor_wait_begin()                { check_and_reset_timer(); _monitor_wait_timer.start(); }
@@ -179,11 +189,57 @@ public:
   void contended_enter_begin()             { check_and_reset_timer(); _contended_enter_timer.start(); }
   void contended_enter_end()               { _contended_enter_timer.stop(); check_and_reset_timer(); }
 
+  void safepoint_blocked(jlong ticks)      { _safepoint_ticks += ticks; }
+
   void reset_count_stat()                  { _count_pending_reset = true; }
   void reset_time_stat()                   { _timer_pending_reset = true; }
 
   int* perf_recursion_counts_addr()        { return _perf_recursion_counts; }
   elapsedTimer* perf_timers_addr()         { return _perf_timers; }
+
+  friend class ThreadUsageSnapshot;
+};
+
+// Resource usage of a thread. Times are in nanoseconds,
+// -1 if they are not measured.
+class ThreadUsage VALUE_OBJ_CLASS_SPEC {
+ public:
+  JavaThread* _thread;       // only valid while the Threads_lock is held
+  jlong       _thread_id;    // java.lang.Thread id, 0 if not yet attached
+  jlong       _cpu_time;
+  jlong       _user_time;
+  jlong       _allocated_bytes;
+  jlong       _blocked_count;
+  jlong       _blocked_time;
+  jlong       _waited_count;
+  jlong       _waited_time;
+  jlong       _safepoint_time;
+};
+
+// Collects the resource usage of all live Java threads in a single pass
+// over the thread list. The user time is only read again for threads
+// that have used CPU since the previous snapshot, so idle threads cost
+// a single clock read.
+class ThreadUsageSnapshot : public StackObj {
+ private:
+  GrowableArray<ThreadUsage>* _usage;
+  bool                        _sorted;
+
+  static jlong ticks_to_nanos(jlong ticks);
+  static void  collect(JavaThread* thread, ThreadUsage* usage);
+
+ public:
+  ThreadUsageSnapshot();
+
+  // The caller must hold the Threads_lock
+  void collect();
+
+  int length() const                       { return _usage->length(); }
+  const ThreadUsage* at(int i) const       { return _usage->adr_at(i); }
+
+  // The usage of the thread with the given java.lang.Thread id,
+  // NULL if there is none. The snapshot is sorted on first use.
+  const ThreadUsage* find(jlong thread_id);
 };
 
 // Thread snapshot to represent the thread state and statistics
@@ -240,8 +296,10 @@ public:
   ThreadStackTrace* get_stack_trace()     { return _stack_trace; }
   ThreadConcurrentLocks* get_concurrent_locks()     { return _concurrent_locks; }
 
-  void        dump_stack_at_safepoint(int max_depth, bool with_locked_monitors);
+  void        dump_stack_at_safepoint(int max_depth, bool with_locked_monitors,
+                                      ObjectMonitorsByOwner* monitors = NULL);
   void        set_concurrent_locks(ThreadConcurrentLocks* l) { _concurrent_locks = l; }
+  void        set_stack_trace(ThreadStackTrace* st)           { _stack_trace = st; }
   void        oops_do(OopClosure* f);
   void        metadata_do(void f(Metadata*));
 };
@@ -264,7 +322,7 @@ class ThreadStackTrace : public CHeapObj<mtInternal> {
   int             get_stack_depth()     { return _depth; }
 
   void            add_stack_frame(javaVFrame* jvf);
-  void            dump_stack_at_safepoint(int max_depth);
+  void            dump_stack_at_safepoint(int max_depth, ObjectMonitorsByOwner* monitors = NULL);
   Handle          allocate_fill_stack_trace_element_array(TRAPS);
   void            oops_do(OopClosure* f);
   void            metadata_do(void f(Metadata*));
@@ -275,6 +333,23 @@ class ThreadStackTrace : public CHeapObj<mtInternal> {
   void            add_jni_locked_monitor(oop object) { _jni_locked_monitors->append(object); }
 };
 
+// The objects of the inflated monitors grouped by owning thread. Filled in
+// a single pass over the monitor cache so that dumping the locked monitors
+// of many threads does not walk the whole cache once per thread.
+// Resource allocated; only valid at the safepoint it was filled in.
+class ObjectMonitorsByOwner : public MonitorClosure {
+ private:
+  typedef ResourceHashtable<Thread*, GrowableArray<oop>*, primitive_hash<Thread*>,
+                            primitive_equals<Thread*>, 1031> OwnerTable;
+  OwnerTable _table;
+
+ public:
+  ObjectMonitorsByOwner() : _table() {}
+
+  void do_monitor(ObjectMonitor* mid);
+  GrowableArray<oop>* owned_by(Thread* thread) const;
+};
+
 // StackFrameInfo for keeping Method* and bci during
 // stack walking for later construction of StackTraceElement[]
 // Java instances
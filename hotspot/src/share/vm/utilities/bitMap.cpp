@@ -26,6 +26,7 @@
 #include "memory/allocation.inline.hpp"
 #include "utilities/bitMap.inline.hpp"
 #include "utilities/copy.hpp"
+#include "utilities/population_count.hpp"
 #ifdef TARGET_OS_FAMILY_linux
 # include "os_linux.inline.hpp"
 #endif
@@ -504,16 +505,7 @@ void BitMap::init_pop_count_table() {
 }
 
 BitMap::idx_t BitMap::num_set_bits(bm_word_t w) {
-  idx_t bits = 0;
-
-  while (w != 0) {
-    while ((w & 1) == 0) {
-      w >>= 1;
-    }
-    bits++;
-    w >>= 1;
-  }
-  return bits;
+  return population_count(w);
 }
 
 BitMap::idx_t BitMap::num_set_bits_from_table(unsigned char c) {
@@ -522,19 +514,32 @@ BitMap::idx_t BitMap::num_set_bits_from_table(unsigned char c) {
 }
 
 BitMap::idx_t BitMap::count_one_bits() const {
-  init_pop_count_table(); // If necessary.
   idx_t sum = 0;
-  typedef unsigned char uchar;
   for (idx_t i = 0; i < size_in_words(); i++) {
-    bm_word_t w = map()[i];
-    for (size_t j = 0; j < sizeof(bm_word_t); j++) {
-      sum += num_set_bits_from_table(uchar(w & 255));
-      w >>= 8;
-    }
+    sum += population_count(map()[i]);
   }
   return sum;
 }
 
+BitMap::idx_t BitMap::count_one_bits(idx_t beg, idx_t end) const {
+  verify_range(beg, end);
+  if (beg == end) {
+    return 0;
+  }
+  idx_t beg_word = word_index(beg);
+  idx_t end_word = word_index(end - 1);
+  bm_word_t end_mask = bit_in_word(end) != 0 ? bit_mask(end) - 1 : (bm_word_t)AllBits;
+  bm_word_t first = map(beg_word) & ~(bit_mask(beg) - 1);
+  if (beg_word == end_word) {
+    return population_count(first & end_mask);
+  }
+  idx_t sum = population_count(first);
+  for (idx_t i = beg_word + 1; i < end_word; i++) {
+    sum += population_count(map(i));
+  }
+  return sum + population_count(map(end_word) & end_mask);
+}
+
 void BitMap::print_on_error(outputStream* st, const char* prefix) const {
   st->print_cr("%s[" PTR_FORMAT ", " PTR_FORMAT ")",
       prefix, p2i(map()), p2i((char*)map() + (size() >> LogBitsPerByte)));
@@ -98,6 +98,8 @@ class BitMap VALUE_OBJ_CLASS_SPEC {
   // Ranges spanning entire words.
   void      set_range_of_words         (idx_t beg, idx_t end);
   void      clear_range_of_words       (idx_t beg, idx_t end);
+  // Index of the first nonzero word in [beg, end), or end.
+  idx_t     find_nonzero_word          (idx_t beg, idx_t end) const;
   void      set_large_range_of_words   (idx_t beg, idx_t end);
   void      clear_large_range_of_words (idx_t beg, idx_t end);
 
@@ -236,6 +238,8 @@ class BitMap VALUE_OBJ_CLASS_SPEC {
 
   // Returns the number of bits set in the bitmap.
   idx_t count_one_bits() const;
+  // Returns the number of bits set in the range [beg, end).
+  idx_t count_one_bits(idx_t beg, idx_t end) const;
 
   // Set operations.
   void set_union(BitMap bits);
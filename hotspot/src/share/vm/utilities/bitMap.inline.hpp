@@ -27,6 +27,7 @@
 
 #include "runtime/atomic.inline.hpp"
 #include "utilities/bitMap.hpp"
+#include "utilities/count_trailing_zeros.hpp"
 
 #ifdef ASSERT
 inline void BitMap::verify_index(idx_t index) const {
@@ -135,8 +136,9 @@ inline void BitMap::set_range_of_words(idx_t beg, idx_t end) {
 
 
 inline void BitMap::clear_range_of_words(idx_t beg, idx_t end) {
-  bm_word_t* map = _map;
-  for (idx_t i = beg; i < end; ++i) map[i] = 0;
+  if (end > beg) {
+    memset(_map + beg, 0, (end - beg) * sizeof(bm_word_t));
+  }
 }
 
 
@@ -157,6 +159,21 @@ inline void BitMap::par_clear_range(idx_t beg, idx_t end, RangeSizeHint hint) {
   }
 }
 
+inline BitMap::idx_t BitMap::find_nonzero_word(idx_t beg, idx_t end) const {
+  const bm_word_t* words = map();
+  idx_t index = beg;
+  // Long zero runs are common in sparse mark bitmaps; test them four
+  // words at a time, which the compiler can also vectorize.
+  for (; index + 4 <= end; index += 4) {
+    if ((words[index] | words[index + 1] | words[index + 2] | words[index + 3]) != NoBits) {
+      break;
+    }
+  }
+  for (; index < end && words[index] == NoBits; index++) {
+  }
+  return index;
+}
+
 inline BitMap::idx_t
 BitMap::get_next_one_offset_inline(idx_t l_offset, idx_t r_offset) const {
   assert(l_offset <= size(), "BitMap index out of bounds");
@@ -175,9 +192,7 @@ BitMap::get_next_one_offset_inline(idx_t l_offset, idx_t r_offset) const {
   idx_t res = map(index) >> pos;
   if (res != (uintptr_t)NoBits) {
     // find the position of the 1-bit
-    for (; !(res & 1); res_offset++) {
-      res = res >> 1;
-    }
+    res_offset += count_trailing_zeros(res);
 
 #ifdef ASSERT
     // In the following assert, if r_offset is not bitamp word aligned,
@@ -205,17 +220,12 @@ BitMap::get_next_one_offset_inline(idx_t l_offset, idx_t r_offset) const {
     return MIN2(res_offset, r_offset);
   }
   // skip over all word length 0-bit runs
-  for (index++; index < r_index; index++) {
-    res = map(index);
-    if (res != (uintptr_t)NoBits) {
-      // found a 1, return the offset
-      for (res_offset = bit_index(index); !(res & 1); res_offset++) {
-        res = res >> 1;
-      }
-      assert(res & 1, "tautology; see loop condition");
-      assert(res_offset >= l_offset, "just checking");
-      return MIN2(res_offset, r_offset);
-    }
+  index = find_nonzero_word(index + 1, r_index);
+  if (index < r_index) {
+    // found a 1, return the offset
+    res_offset = bit_index(index) + count_trailing_zeros(map(index));
+    assert(res_offset >= l_offset, "just checking");
+    return MIN2(res_offset, r_offset);
   }
   return r_offset;
 }
@@ -239,9 +249,7 @@ BitMap::get_next_zero_offset_inline(idx_t l_offset, idx_t r_offset) const {
 
   if (res != (uintptr_t)AllBits) {
     // find the position of the 0-bit
-    for (; res & 1; res_offset++) {
-      res = res >> 1;
-    }
+    res_offset += count_trailing_zeros(~res);
     assert(res_offset >= l_offset, "just checking");
     return MIN2(res_offset, r_offset);
   }
@@ -250,11 +258,7 @@ BitMap::get_next_zero_offset_inline(idx_t l_offset, idx_t r_offset) const {
     res = map(index);
     if (res != (uintptr_t)AllBits) {
       // found a 0, return the offset
-      for (res_offset = index << LogBitsPerWord; res & 1;
-           res_offset++) {
-        res = res >> 1;
-      }
-      assert(!(res & 1), "tautology; see loop condition");
+      res_offset = bit_index(index) + count_trailing_zeros(~res);
       assert(res_offset >= l_offset, "just checking");
       return MIN2(res_offset, r_offset);
     }
@@ -280,25 +284,18 @@ BitMap::get_next_one_offset_inline_aligned_right(idx_t l_offset,
   idx_t res = map(index) >> bit_in_word(res_offset);
   if (res != (uintptr_t)NoBits) {
     // find the position of the 1-bit
-    for (; !(res & 1); res_offset++) {
-      res = res >> 1;
-    }
+    res_offset += count_trailing_zeros(res);
     assert(res_offset >= l_offset &&
            res_offset < r_offset, "just checking");
     return res_offset;
   }
   // skip over all word length 0-bit runs
-  for (index++; index < r_index; index++) {
-    res = map(index);
-    if (res != (uintptr_t)NoBits) {
-      // found a 1, return the offset
-      for (res_offset = bit_index(index); !(res & 1); res_offset++) {
-        res = res >> 1;
-      }
-      assert(res & 1, "tautology; see loop condition");
-      assert(res_offset >= l_offset && res_offset < r_offset, "just checking");
-      return res_offset;
-    }
+  index = find_nonzero_word(index + 1, r_index);
+  if (index < r_index) {
+    // found a 1, return the offset
+    res_offset = bit_index(index) + count_trailing_zeros(map(index));
+    assert(res_offset >= l_offset && res_offset < r_offset, "just checking");
+    return res_offset;
   }
   return r_offset;
 }
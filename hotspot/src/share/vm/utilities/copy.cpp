@@ -236,6 +236,24 @@ void Copy::conjoint_swap(const void* src, void* dst, size_t byte_count, size_t e
   CopySwap::conjoint_swap_if_needed<true>(src, dst, byte_count, elem_size);
 }
 
+// Store count copies of value starting at dst, one aligned T at a time.
+// The loop is unrolled so the compiler can pair adjacent stores into wide
+// vector stores; those never split an aligned T, so each unit stays atomic.
+template <typename T>
+static void fill_units_atomic(address dst, size_t count, T value) {
+  T* to = (T*) dst;
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    to[i + 0] = value;
+    to[i + 1] = value;
+    to[i + 2] = value;
+    to[i + 3] = value;
+  }
+  for (; i < count; i++) {
+    to[i] = value;
+  }
+}
+
 // Fill bytes; larger units are filled atomically if everything is aligned.
 void Copy::fill_to_memory_atomic(void* to, size_t size, jubyte value) {
   address dst = (address) to;
@@ -247,27 +265,18 @@ void Copy::fill_to_memory_atomic(void* to, size_t size, jubyte value) {
       fill += fill << 16;
       fill += fill << 32;
     }
-    //Copy::fill_to_jlongs_atomic((jlong*) dst, size / sizeof(jlong));
-    for (uintptr_t off = 0; off < size; off += sizeof(jlong)) {
-      *(jlong*)(dst + off) = fill;
-    }
+    fill_units_atomic<jlong>(dst, size / sizeof(jlong), fill);
   } else if (bits % sizeof(jint) == 0) {
     jint fill = (juint)( (jubyte)value ); // zero-extend
     if (fill != 0) {
       fill += fill << 8;
       fill += fill << 16;
     }
-    //Copy::fill_to_jints_atomic((jint*) dst, size / sizeof(jint));
-    for (uintptr_t off = 0; off < size; off += sizeof(jint)) {
-      *(jint*)(dst + off) = fill;
-    }
+    fill_units_atomic<jint>(dst, size / sizeof(jint), fill);
   } else if (bits % sizeof(jshort) == 0) {
     jshort fill = (jushort)( (jubyte)value ); // zero-extend
     fill += fill << 8;
-    //Copy::fill_to_jshorts_atomic((jshort*) dst, size / sizeof(jshort));
-    for (uintptr_t off = 0; off < size; off += sizeof(jshort)) {
-      *(jshort*)(dst + off) = fill;
-    }
+    fill_units_atomic<jshort>(dst, size / sizeof(jshort), fill);
   } else {
     // Not aligned, so no need to be atomic.
     Copy::fill_to_bytes(dst, size, value);
@@ -29,6 +29,7 @@
 #include "memory/allocation.inline.hpp"
 #include "utilities/elfFuncDescTable.hpp"
 #include "utilities/elfSymbolTable.hpp"
+#include "utilities/quickSort.hpp"
 
 ElfSymbolTable::ElfSymbolTable(FILE* file, Elf_Shdr shdr) {
   assert(file, "null file handle");
@@ -36,6 +37,11 @@ ElfSymbolTable::ElfSymbolTable(FILE* file, Elf_Shdr shdr) {
   m_next = NULL;
   m_file = file;
   m_status = NullDecoder::no_error;
+  m_index = NULL;
+  m_index_length = 0;
+  m_index_max_size = 0;
+  m_index_built = false;
+  memset(m_lookup_cache, 0, sizeof(m_lookup_cache));
 
   // try to load the string table
   long cur_offset = ftell(file);
@@ -64,11 +70,97 @@ ElfSymbolTable::~ElfSymbolTable() {
     os::free(m_symbols);
   }
 
+  if (m_index != NULL) {
+    os::free(m_index);
+  }
+
   if (m_next != NULL) {
     delete m_next;
   }
 }
 
+int ElfSymbolTable::compare_func_symbols(const FuncSymbol& a, const FuncSymbol& b) {
+  if (a.start != b.start) {
+    return a.start < b.start ? -1 : 1;
+  }
+  return 0;
+}
+
+void ElfSymbolTable::build_index(ElfFuncDescTable* funcDescTable) {
+  assert(m_symbols != NULL, "symbols must be loaded");
+  m_index_built = true;
+
+  int count = m_shdr.sh_size / sizeof(Elf_Sym);
+  int length = 0;
+  for (int index = 0; index < count; index++) {
+    if (STT_FUNC == ELF_ST_TYPE(m_symbols[index].st_info) && m_symbols[index].st_size > 0) {
+      length++;
+    }
+  }
+  if (length == 0) {
+    return;
+  }
+  // call malloc so we can fall back to the linear scan if allocation fails.
+  FuncSymbol* symbols = (FuncSymbol*)os::malloc(length * sizeof(FuncSymbol), mtInternal);
+  if (symbols == NULL) {
+    return;
+  }
+  int i = 0;
+  for (int index = 0; index < count; index++) {
+    Elf_Sym* sym = &m_symbols[index];
+    if (STT_FUNC == ELF_ST_TYPE(sym->st_info) && sym->st_size > 0) {
+      if (funcDescTable != NULL && funcDescTable->get_index() == sym->st_shndx) {
+        // We need to go another step trough the function descriptor table (currently PPC64 only)
+        symbols[i].start = funcDescTable->lookup(sym->st_value);
+      } else {
+        symbols[i].start = (address)sym->st_value;
+      }
+      symbols[i].size = (Elf_Word)sym->st_size;
+      symbols[i].name = sym->st_name;
+      m_index_max_size = MAX2(m_index_max_size, symbols[i].size);
+      i++;
+    }
+  }
+  QuickSort::sort<FuncSymbol>(symbols, length, compare_func_symbols, false);
+  m_index = symbols;
+  m_index_length = length;
+}
+
+bool ElfSymbolTable::lookup_in_index(address addr, int* posIndex, int* offset) {
+  CachedLookup* cached = &m_lookup_cache[((uintptr_t)addr >> 2) % lookup_cache_size];
+  if (cached->addr == addr && addr != NULL) {
+    *posIndex = cached->name;
+    *offset = cached->offset;
+    return true;
+  }
+
+  // find the last symbol starting at or below addr
+  int lo = 0;
+  int hi = m_index_length - 1;
+  int last = -1;
+  while (lo <= hi) {
+    int mid = lo + (hi - lo) / 2;
+    if (m_index[mid].start <= addr) {
+      last = mid;
+      lo = mid + 1;
+    } else {
+      hi = mid - 1;
+    }
+  }
+  // symbols can overlap, so also look at the earlier ones that are close enough
+  for (int i = last; i >= 0 && (size_t)(addr - m_index[i].start) < m_index_max_size; i--) {
+    if ((size_t)(addr - m_index[i].start) < m_index[i].size) {
+      *offset = (int)(addr - m_index[i].start);
+      *posIndex = m_index[i].name;
+      cached->addr = addr;
+      cached->name = *posIndex;
+      cached->offset = *offset;
+      return true;
+    }
+  }
+  return false;
+}
+
 bool ElfSymbolTable::lookup(address addr, int* stringtableIndex, int* posIndex, int* offset, ElfFuncDescTable* funcDescTable) {
   assert(stringtableIndex, "null string table index pointer");
   assert(posIndex, "null string table offset pointer");
@@ -81,7 +173,16 @@ bool ElfSymbolTable::lookup(address addr, int* stringtableIndex, int* posIndex,
   size_t  sym_size = sizeof(Elf_Sym);
   assert((m_shdr.sh_size % sym_size) == 0, "check size");
   int count = m_shdr.sh_size / sym_size;
-  if (m_symbols != NULL) {
+  if (m_symbols != NULL && !m_index_built) {
+    build_index(funcDescTable);
+  }
+  if (m_index != NULL) {
+    if (lookup_in_index(addr, posIndex, offset)) {
+      *stringtableIndex = m_shdr.sh_link;
+      return true;
+    }
+    return false;
+  } else if (m_symbols != NULL) {
     for (int index = 0; index < count; index ++) {
       if (STT_FUNC == ELF_ST_TYPE(m_symbols[index].st_info)) {
         Elf_Word st_size = m_symbols[index].st_size;
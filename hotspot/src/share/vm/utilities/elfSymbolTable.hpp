@@ -35,8 +35,9 @@
 /*
  * symbol table object represents a symbol section in an elf file.
  * Whenever possible, it will load all symbols from the corresponding section
- * of the elf file into memory. Otherwise, it will walk the section in file
- * to look up the symbol that nearest the given address.
+ * of the elf file into memory, and on the first lookup build an index of the
+ * function symbols sorted by address to binary search in. Otherwise, it will
+ * walk the section in file to look up the symbol that nearest the given address.
  */
 class ElfSymbolTable: public CHeapObj<mtInternal> {
   friend class ElfFile;
@@ -49,6 +50,33 @@ class ElfSymbolTable: public CHeapObj<mtInternal> {
 
   NullDecoder::decoder_status get_status() { return m_status; };
 
+ private:
+  // A function symbol in the sorted index
+  struct FuncSymbol {
+    address    start;
+    Elf_Word   size;
+    Elf_Word   name;
+  };
+
+  // Direct mapped cache of recent lookups, as the same frames tend to be
+  // decoded over and over (NMT detail reports, hs_err stacks)
+  struct CachedLookup {
+    address    addr;
+    int        name;
+    int        offset;
+  };
+  static const int lookup_cache_size = 64;
+
+  void build_index(ElfFuncDescTable* funcDescTable);
+  bool lookup_in_index(address addr, int* posIndex, int* offset);
+  static int compare_func_symbols(const FuncSymbol& a, const FuncSymbol& b);
+
+  FuncSymbol*         m_index;
+  int                 m_index_length;
+  Elf_Word            m_index_max_size;  // of the symbols in the index
+  bool                m_index_built;
+  CachedLookup        m_lookup_cache[lookup_cache_size];
+
  protected:
   ElfSymbolTable*  m_next;
 
@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_UTILITIES_FASTTIMECOUNTER_HPP
+#define SHARE_VM_UTILITIES_FASTTIMECOUNTER_HPP
+
+#include "utilities/macros.hpp"
+
+// The hardware time stamp counter behind the fast unordered time sources:
+// the tsc on x86 and the virtual counter CNTVCT_EL0 on aarch64. When the
+// platform has one, FAST_TIME_COUNTER is defined and FastTimeCounter
+// names its interface class.
+#if defined(X86) && !defined(ZERO)
+#include "rdtsc_x86.hpp"
+#define FAST_TIME_COUNTER
+typedef Rdtsc FastTimeCounter;
+#elif defined(AARCH64) && !defined(ZERO)
+#include "cntvct_aarch64.hpp"
+#define FAST_TIME_COUNTER
+typedef Cntvct FastTimeCounter;
+#endif
+
+#endif // SHARE_VM_UTILITIES_FASTTIMECOUNTER_HPP
@@ -35,7 +35,8 @@
 // This is a generic hashtable, designed to be used for the symbol
 // and string tables.
 //
-// It is implemented as an open hash table with a fixed number of buckets.
+// It is implemented as an open hash table with a fixed number of buckets,
+// which may be changed at a safepoint with resize().
 //
 // %note:
 //  - TableEntrys are allocated in blocks to reduce the space overhead.
@@ -246,6 +247,11 @@ public:
 
   int number_of_entries() { return _number_of_entries; }
 
+  // Relink all entries into new_size buckets, keeping their hash values.
+  // Must be called at a safepoint, since readers walk the buckets without
+  // a lock.  Returns false if the new buckets could not be allocated.
+  bool resize(int new_size);
+
   void verify() PRODUCT_RETURN;
 };
 
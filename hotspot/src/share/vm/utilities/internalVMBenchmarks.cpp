@@ -0,0 +1,616 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+
+#ifndef PRODUCT
+
+#include "memory/allocation.inline.hpp"
+#include "memory/resourceArea.hpp"
+#include "oops/markOop.hpp"
+#include "oops/methodCounters.hpp"
+#include "runtime/atomic.inline.hpp"
+#include "runtime/globals.hpp"
+#include "runtime/os.hpp"
+#include "utilities/bitMap.inline.hpp"
+#include "utilities/chunkedList.hpp"
+#include "utilities/growableArray.hpp"
+#include "utilities/internalVMBenchmarks.hpp"
+#include "utilities/openAddressingHashtable.hpp"
+#include "utilities/ostream.hpp"
+#include "utilities/quickSort.hpp"
+#include "utilities/resourceHash.hpp"
+#include "utilities/taskqueue.hpp"
+#include "utilities/workgroup.hpp"
+
+// Per-worker state, padded so that workers do not share cache lines.
+class BenchmarkWorker VALUE_OBJ_CLASS_SPEC {
+ public:
+  julong    _random;
+  uintptr_t _sink;       // consumes results so the work is not optimized away
+  DEFINE_PAD_MINUS_SIZE(0, DEFAULT_CACHE_LINE_SIZE, sizeof(julong) + sizeof(uintptr_t));
+
+  // xorshift64*
+  julong next_random() {
+    _random ^= _random >> 12;
+    _random ^= _random << 25;
+    _random ^= _random >> 27;
+    return _random * CONST64(2685821657736338717);
+  }
+};
+
+class WorkerLocalBenchmark : public InternalVMBenchmark {
+ protected:
+  BenchmarkWorker* _workers;
+  uint             _num_workers;
+
+ public:
+  WorkerLocalBenchmark() : _workers(NULL), _num_workers(0) {}
+
+  virtual void setup(uint num_workers) {
+    _num_workers = num_workers;
+    _workers = NEW_C_HEAP_ARRAY(BenchmarkWorker, num_workers, mtInternal);
+    for (uint i = 0; i < num_workers; i++) {
+      _workers[i]._random = CONST64(0x9E3779B97F4A7C15) * (i + 1);
+      _workers[i]._sink = 0;
+    }
+  }
+
+  virtual void teardown() {
+    FREE_C_HEAP_ARRAY(BenchmarkWorker, _workers, mtInternal);
+    _workers = NULL;
+  }
+};
+
+// Owner push and pop plus steals from the other workers' queues.
+class TaskQueueBenchmark : public WorkerLocalBenchmark {
+  typedef GenericTaskQueue<size_t, mtInternal> BenchmarkTaskQueue;
+  typedef GenericTaskQueueSet<BenchmarkTaskQueue, mtInternal> BenchmarkTaskQueueSet;
+
+  BenchmarkTaskQueue**   _queues;
+  BenchmarkTaskQueueSet* _queue_set;
+  int*                   _seeds;
+
+ public:
+  const char* name() const { return "taskqueue"; }
+
+  void setup(uint num_workers) {
+    WorkerLocalBenchmark::setup(num_workers);
+    _queue_set = new BenchmarkTaskQueueSet(num_workers);
+    _queues = NEW_C_HEAP_ARRAY(BenchmarkTaskQueue*, num_workers, mtInternal);
+    _seeds = NEW_C_HEAP_ARRAY(int, num_workers, mtInternal);
+    for (uint i = 0; i < num_workers; i++) {
+      _queues[i] = new BenchmarkTaskQueue();
+      _queues[i]->initialize();
+      _queue_set->register_queue(i, _queues[i]);
+      _seeds[i] = 17 + i;
+    }
+  }
+
+  void teardown() {
+    for (uint i = 0; i < _num_workers; i++) {
+      delete _queues[i];
+    }
+    FREE_C_HEAP_ARRAY(int, _seeds, mtInternal);
+    FREE_C_HEAP_ARRAY(BenchmarkTaskQueue*, _queues, mtInternal);
+    delete _queue_set;
+    WorkerLocalBenchmark::teardown();
+  }
+
+  void run_batch(uint worker_id, uint ops) {
+    BenchmarkTaskQueue* queue = _queues[worker_id];
+    uintptr_t sink = 0;
+    volatile size_t local;
+    size_t stolen;
+    for (uint i = 0; i < ops; i++) {
+      if (!queue->push(i)) {
+        queue->pop_local(local);
+        sink += local;
+        queue->push(i);
+      }
+    }
+    for (uint i = 0; i < ops / 2; i++) {
+      if (queue->pop_local(local)) {
+        sink += local;
+      }
+    }
+    for (uint i = 0; i < ops / 2; i++) {
+      if (_queue_set->steal(worker_id, &_seeds[worker_id], stolen)) {
+        sink += stolen;
+      } else if (queue->pop_local(local)) {
+        sink += local;
+      }
+    }
+    _workers[worker_id]._sink += sink;
+  }
+};
+
+// Random concurrent sets and clears on a shared bitmap.
+class BitMapBenchmark : public WorkerLocalBenchmark {
+  static const BitMap::idx_t map_size = 1024 * 1024;
+
+  BitMap _map;
+
+ public:
+  const char* name() const { return "bitmap"; }
+
+  void setup(uint num_workers) {
+    WorkerLocalBenchmark::setup(num_workers);
+    _map.resize(map_size, false /* in_resource_area */);
+  }
+
+  void teardown() {
+    _map.resize(0, false /* in_resource_area */);
+    WorkerLocalBenchmark::teardown();
+  }
+
+  void run_batch(uint worker_id, uint ops) {
+    BenchmarkWorker* worker = &_workers[worker_id];
+    uintptr_t sink = 0;
+    for (uint i = 0; i < ops; i++) {
+      julong r = worker->next_random();
+      BitMap::idx_t index = (BitMap::idx_t)(r >> 32) & (map_size - 1);
+      if (_map.at(index) != ((r & 1) != 0)) {
+        sink += _map.par_at_put(index, (r & 1) != 0) ? 1 : 0;
+      }
+    }
+    worker->_sink += sink;
+  }
+};
+
+// Searches for the next set bit, and counts set bits, in a sparse bitmap
+// like the mark bitmap of a region with few live objects.
+class BitMapSearchBenchmark : public WorkerLocalBenchmark {
+  static const BitMap::idx_t map_size = 1024 * 1024;
+  static const BitMap::idx_t count_range = 4096;
+
+  BitMap _map;
+
+ public:
+  const char* name() const { return "bitmap_search"; }
+
+  void setup(uint num_workers) {
+    WorkerLocalBenchmark::setup(num_workers);
+    _map.resize(map_size, false /* in_resource_area */);
+    // About one bit in a thousand
+    for (BitMap::idx_t i = 0; i < map_size / 1024; i++) {
+      _map.set_bit((BitMap::idx_t)(_workers[0].next_random() >> 32) & (map_size - 1));
+    }
+  }
+
+  void teardown() {
+    _map.resize(0, false /* in_resource_area */);
+    WorkerLocalBenchmark::teardown();
+  }
+
+  void run_batch(uint worker_id, uint ops) {
+    BenchmarkWorker* worker = &_workers[worker_id];
+    uintptr_t sink = 0;
+    for (uint i = 0; i < ops; i++) {
+      julong r = worker->next_random();
+      BitMap::idx_t beg = (BitMap::idx_t)(r >> 32) & (map_size - 1);
+      if ((r & 15) == 0) {
+        sink += _map.count_one_bits(beg, MIN2(beg + count_range, map_size));
+      } else {
+        sink += _map.get_next_one_offset(beg, map_size);
+      }
+    }
+    worker->_sink += sink;
+  }
+};
+
+// Mixed put, get and remove on a thread-local hashtable, shared by the
+// benchmarks of the different hashtable implementations.
+template <class TABLE>
+static uintptr_t hashtable_batch(TABLE* table, BenchmarkWorker* worker, uint ops) {
+  uintptr_t sink = 0;
+  for (uint i = 0; i < ops; i++) {
+    julong r = worker->next_random();
+    uintptr_t key = (uintptr_t)(r >> 32) & 4095;
+    if ((r & 3) == 0) {
+      sink += table->remove(key) ? 1 : 0;
+    } else {
+      uintptr_t* value = table->get(key);
+      if (value != NULL) {
+        sink += *value;
+      } else {
+        table->put(key, i);
+      }
+    }
+  }
+  return sink;
+}
+
+class ResourceHashtableBenchmark : public WorkerLocalBenchmark {
+  typedef ResourceHashtable<uintptr_t, uintptr_t,
+                            primitive_hash<uintptr_t>, primitive_equals<uintptr_t>,
+                            1024, ResourceObj::C_HEAP, mtInternal> BenchmarkTable;
+
+  BenchmarkTable** _tables;
+
+ public:
+  const char* name() const { return "resourcehash"; }
+
+  void setup(uint num_workers) {
+    WorkerLocalBenchmark::setup(num_workers);
+    _tables = NEW_C_HEAP_ARRAY(BenchmarkTable*, num_workers, mtInternal);
+    for (uint i = 0; i < num_workers; i++) {
+      _tables[i] = new (ResourceObj::C_HEAP, mtInternal) BenchmarkTable();
+    }
+  }
+
+  void teardown() {
+    for (uint i = 0; i < _num_workers; i++) {
+      delete _tables[i];
+    }
+    FREE_C_HEAP_ARRAY(BenchmarkTable*, _tables, mtInternal);
+    WorkerLocalBenchmark::teardown();
+  }
+
+  void run_batch(uint worker_id, uint ops) {
+    BenchmarkWorker* worker = &_workers[worker_id];
+    worker->_sink += hashtable_batch(_tables[worker_id], worker, ops);
+  }
+};
+
+class OpenAddressingHashtableBenchmark : public WorkerLocalBenchmark {
+  typedef OpenAddressingHashtable<uintptr_t, uintptr_t> BenchmarkTable;
+
+  BenchmarkTable** _tables;
+
+ public:
+  const char* name() const { return "openhash"; }
+
+  void setup(uint num_workers) {
+    WorkerLocalBenchmark::setup(num_workers);
+    _tables = NEW_C_HEAP_ARRAY(BenchmarkTable*, num_workers, mtInternal);
+    for (uint i = 0; i < num_workers; i++) {
+      _tables[i] = new BenchmarkTable(1024);
+    }
+  }
+
+  void teardown() {
+    for (uint i = 0; i < _num_workers; i++) {
+      delete _tables[i];
+    }
+    FREE_C_HEAP_ARRAY(BenchmarkTable*, _tables, mtInternal);
+    WorkerLocalBenchmark::teardown();
+  }
+
+  void run_batch(uint worker_id, uint ops) {
+    BenchmarkWorker* worker = &_workers[worker_id];
+    worker->_sink += hashtable_batch(_tables[worker_id], worker, ops);
+  }
+};
+
+// Fill and scan of a thread-local ChunkedList.
+class ChunkedListBenchmark : public WorkerLocalBenchmark {
+  typedef ChunkedList<uintptr_t, mtInternal> BenchmarkList;
+
+  BenchmarkList** _lists;
+
+ public:
+  const char* name() const { return "chunkedlist"; }
+
+  void setup(uint num_workers) {
+    WorkerLocalBenchmark::setup(num_workers);
+    _lists = NEW_C_HEAP_ARRAY(BenchmarkList*, num_workers, mtInternal);
+    for (uint i = 0; i < num_workers; i++) {
+      _lists[i] = new BenchmarkList();
+    }
+  }
+
+  void teardown() {
+    for (uint i = 0; i < _num_workers; i++) {
+      delete _lists[i];
+    }
+    FREE_C_HEAP_ARRAY(BenchmarkList*, _lists, mtInternal);
+    WorkerLocalBenchmark::teardown();
+  }
+
+  void run_batch(uint worker_id, uint ops) {
+    BenchmarkList* list = _lists[worker_id];
+    uintptr_t sink = 0;
+    for (uint i = 0; i < ops; i++) {
+      if (list->is_full()) {
+        for (size_t j = 0; j < list->size(); j++) {
+          sink += list->at(j);
+        }
+        list->clear();
+      }
+      list->push(i);
+    }
+    _workers[worker_id]._sink += sink;
+  }
+};
+
+// Growing a resource allocated GrowableArray and searching it.
+class GrowableArrayBenchmark : public WorkerLocalBenchmark {
+ public:
+  const char* name() const { return "growablearray"; }
+
+  void run_batch(uint worker_id, uint ops) {
+    ResourceMark rm;
+    GrowableArray<int> array(8);
+    uintptr_t sink = 0;
+    for (uint i = 0; i < ops; i++) {
+      array.append((int)i);
+    }
+    for (uint i = 0; i < ops; i += 16) {
+      sink += array.find((int)(ops - i - 1));
+    }
+    _workers[worker_id]._sink += sink + array.length();
+  }
+};
+
+// Variable sized allocations released by a ResourceMark.
+class ResourceAreaBenchmark : public WorkerLocalBenchmark {
+ public:
+  const char* name() const { return "resourcearea"; }
+
+  void run_batch(uint worker_id, uint ops) {
+    BenchmarkWorker* worker = &_workers[worker_id];
+    ResourceMark rm;
+    uintptr_t sink = 0;
+    for (uint i = 0; i < ops; i++) {
+      size_t size = 8 + (size_t)((worker->next_random() >> 32) & 511);
+      char* p = NEW_RESOURCE_ARRAY(char, size);
+      p[0] = (char)i;
+      sink += (uintptr_t)p[0];
+    }
+    worker->_sink += sink;
+  }
+};
+
+// Atomic::add on a counter shared by all workers.
+class AtomicAddBenchmark : public WorkerLocalBenchmark {
+  volatile jint _counter;
+
+ public:
+  AtomicAddBenchmark() : _counter(0) {}
+
+  const char* name() const { return "atomic-add-shared"; }
+
+  void run_batch(uint worker_id, uint ops) {
+    jint sink = 0;
+    for (uint i = 0; i < ops; i++) {
+      sink += Atomic::add(1, &_counter);
+    }
+    _workers[worker_id]._sink += (uintptr_t)sink;
+  }
+};
+
+// Invocation counting as the interpreter does it: a plain increment and a
+// check for the notification, by all workers on one counter or each on
+// its stripe of a MethodCounters-like block.
+class InvocationCounterBenchmark : public WorkerLocalBenchmark {
+  const bool _striped;
+  char*      _block;
+  address    _stripes;
+
+  static size_t stripes_size() {
+    return MethodCounters::invocation_stripe_count * MethodCounters::invocation_stripe_stride;
+  }
+
+ public:
+  InvocationCounterBenchmark(bool striped) : _striped(striped), _block(NULL), _stripes(NULL) {}
+
+  const char* name() const {
+    return _striped ? "invocation-counter-striped" : "invocation-counter-shared";
+  }
+
+  void setup(uint num_workers) {
+    WorkerLocalBenchmark::setup(num_workers);
+    _block = NEW_C_HEAP_ARRAY(char, stripes_size() + MethodCounters::invocation_stripe_stride, mtInternal);
+    _stripes = (address)align_ptr_up(_block, MethodCounters::invocation_stripe_stride);
+    memset(_stripes, 0, stripes_size());
+  }
+
+  void teardown() {
+    FREE_C_HEAP_ARRAY(char, _block, mtInternal);
+    _block = NULL;
+    WorkerLocalBenchmark::teardown();
+  }
+
+  void run_batch(uint worker_id, uint ops) {
+    uint stripe = _striped ? worker_id % MethodCounters::invocation_stripe_count : 0;
+    volatile juint* counter = (volatile juint*)(_stripes + stripe * MethodCounters::invocation_stripe_stride);
+    const juint mask = right_n_bits(Tier0InvokeNotifyFreqLog) << InvocationCounter::count_shift;
+    uintptr_t sink = 0;
+    for (uint i = 0; i < ops; i++) {
+      juint value = *counter + InvocationCounter::count_increment;
+      *counter = value;
+      if ((value & mask) == 0) {
+        // The policy folds the stripes when notified
+        sink += _striped ? MethodCounters::drain_invocation_stripes(_stripes) : value;
+      }
+    }
+    _workers[worker_id]._sink += sink;
+  }
+};
+
+// Atomic::cmpxchg_ptr on a worker-local word, the uncontended cost.
+class AtomicCmpxchgBenchmark : public WorkerLocalBenchmark {
+ public:
+  const char* name() const { return "atomic-cmpxchg-local"; }
+
+  void run_batch(uint worker_id, uint ops) {
+    volatile intptr_t* dest = (volatile intptr_t*)&_workers[worker_id]._sink;
+    for (uint i = 0; i < ops; i++) {
+      intptr_t old_value = *dest;
+      Atomic::cmpxchg_ptr(old_value + 1, dest, old_value);
+    }
+  }
+};
+
+// Building and decoding mark words.
+class MarkOopBenchmark : public WorkerLocalBenchmark {
+ public:
+  const char* name() const { return "markoop"; }
+
+  void run_batch(uint worker_id, uint ops) {
+    BenchmarkWorker* worker = &_workers[worker_id];
+    uintptr_t sink = 0;
+    for (uint i = 0; i < ops; i++) {
+      julong r = worker->next_random();
+      markOop mark = markOopDesc::prototype()->copy_set_hash((intptr_t)(r & markOopDesc::hash_mask));
+      mark = mark->set_age(i & markOopDesc::age_mask);
+      sink += mark->hash() + mark->age();
+      if (mark->is_neutral() && !mark->has_bias_pattern()) {
+        sink++;
+      }
+    }
+    worker->_sink += sink;
+  }
+};
+
+class InternalVMBenchmarkTask : public AbstractGangTask {
+  InternalVMBenchmark* _benchmark;
+  uint                 _batches;
+  jlong*               _latencies;   // [worker][batch] in nanoseconds
+  jlong*               _start;
+  jlong*               _end;
+  WorkGangBarrierSync  _barrier;
+
+ public:
+  InternalVMBenchmarkTask(InternalVMBenchmark* benchmark, uint num_workers, uint batches) :
+    AbstractGangTask("Internal VM benchmark"),
+    _benchmark(benchmark),
+    _batches(batches),
+    _barrier(num_workers, "Internal VM benchmark barrier") {
+    _latencies = NEW_C_HEAP_ARRAY(jlong, (size_t)num_workers * batches, mtInternal);
+    _start = NEW_C_HEAP_ARRAY(jlong, num_workers, mtInternal);
+    _end = NEW_C_HEAP_ARRAY(jlong, num_workers, mtInternal);
+  }
+
+  ~InternalVMBenchmarkTask() {
+    FREE_C_HEAP_ARRAY(jlong, _latencies, mtInternal);
+    FREE_C_HEAP_ARRAY(jlong, _start, mtInternal);
+    FREE_C_HEAP_ARRAY(jlong, _end, mtInternal);
+  }
+
+  jlong* latencies() const { return _latencies; }
+  jlong start(uint worker_id) const { return _start[worker_id]; }
+  jlong end(uint worker_id) const { return _end[worker_id]; }
+
+  void work(uint worker_id) {
+    const uint ops = InternalVMBenchmarks::ops_per_batch;
+    for (uint i = 0; i < MAX2(_batches / 10, 1u); i++) {
+      _benchmark->run_batch(worker_id, ops);
+    }
+    // Start the measured phase together so contention is representative.
+    _barrier.enter();
+    jlong* latencies = _latencies + (size_t)worker_id * _batches;
+    jlong start = os::javaTimeNanos();
+    jlong last = start;
+    for (uint i = 0; i < _batches; i++) {
+      _benchmark->run_batch(worker_id, ops);
+      jlong now = os::javaTimeNanos();
+      latencies[i] = now - last;
+      last = now;
+    }
+    _start[worker_id] = start;
+    _end[worker_id] = last;
+  }
+};
+
+static int compare_jlong(jlong a, jlong b) {
+  return a < b ? -1 : (a > b ? 1 : 0);
+}
+
+void InternalVMBenchmarks::run(InternalVMBenchmark* benchmark, WorkGang* gang) {
+  const uint num_workers = gang->total_workers();
+  const uint batches = MAX2((uint)InternalVMBenchmarkBatches, 1u);
+  InternalVMBenchmarkTask task(benchmark, num_workers, batches);
+
+  benchmark->setup(num_workers);
+  gang->run_task(&task);
+  benchmark->teardown();
+
+  jlong start = task.start(0);
+  jlong end = task.end(0);
+  for (uint i = 1; i < num_workers; i++) {
+    start = MIN2(start, task.start(i));
+    end = MAX2(end, task.end(i));
+  }
+  const double total_ops = (double)num_workers * batches * ops_per_batch;
+  const double mops = total_ops * 1000.0 / (double)MAX2(end - start, (jlong)1);
+
+  const int count = (int)((size_t)num_workers * batches);
+  jlong* latencies = task.latencies();
+  QuickSort::sort<jlong>(latencies, count, compare_jlong, false);
+  const double scale = 1.0 / ops_per_batch;
+  tty->print_cr("%-22s %10.2f Mops/s  ns/op p50 %8.1f  p90 %8.1f  p99 %8.1f  p99.9 %8.1f  max %8.1f",
+                benchmark->name(), mops,
+                latencies[(count - 1) / 2] * scale,
+                latencies[(int)((count - 1) * 0.90)] * scale,
+                latencies[(int)((count - 1) * 0.99)] * scale,
+                latencies[(int)((count - 1) * 0.999)] * scale,
+                latencies[count - 1] * scale);
+}
+
+void InternalVMBenchmarks::run_all() {
+  uint num_workers = (uint)InternalVMBenchmarkThreads;
+  if (num_workers == 0) {
+    num_workers = (uint)os::active_processor_count();
+  }
+  // The gang threads cannot be terminated and stay idle once done.
+  WorkGang* gang = new WorkGang("Internal VM benchmark workers", num_workers, false, false);
+  if (gang == NULL || !gang->initialize_workers()) {
+    warning("Could not create the internal VM benchmark workers");
+    return;
+  }
+
+  TaskQueueBenchmark taskqueue;
+  BitMapBenchmark bitmap;
+  BitMapSearchBenchmark bitmap_search;
+  ResourceHashtableBenchmark resourcehash;
+  OpenAddressingHashtableBenchmark openhash;
+  ChunkedListBenchmark chunkedlist;
+  GrowableArrayBenchmark growablearray;
+  ResourceAreaBenchmark resourcearea;
+  AtomicAddBenchmark atomic_add;
+  AtomicCmpxchgBenchmark atomic_cmpxchg;
+  InvocationCounterBenchmark invocation_counter_shared(false);
+  InvocationCounterBenchmark invocation_counter_striped(true);
+  MarkOopBenchmark markoop;
+  InternalVMBenchmark* benchmarks[] = {
+    &taskqueue, &bitmap, &bitmap_search, &resourcehash, &openhash, &chunkedlist, &growablearray,
+    &resourcearea, &atomic_add, &atomic_cmpxchg, &invocation_counter_shared,
+    &invocation_counter_striped, &markoop
+  };
+
+  tty->print_cr("Running internal VM benchmarks on %u threads, " UINTX_FORMAT " batches of %u operations",
+                num_workers, InternalVMBenchmarkBatches, ops_per_batch);
+  for (size_t i = 0; i < ARRAY_SIZE(benchmarks); i++) {
+    if (InternalVMBenchmarkFilter != NULL &&
+        strstr(benchmarks[i]->name(), InternalVMBenchmarkFilter) == NULL) {
+      continue;
+    }
+    run(benchmarks[i], gang);
+  }
+  tty->print_cr("Internal VM benchmarks done");
+}
+
+#endif // !PRODUCT
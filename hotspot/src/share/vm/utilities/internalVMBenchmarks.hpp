@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_UTILITIES_INTERNALVMBENCHMARKS_HPP
+#define SHARE_VM_UTILITIES_INTERNALVMBENCHMARKS_HPP
+
+#include "memory/allocation.hpp"
+
+#ifndef PRODUCT
+
+class WorkGang;
+
+// A micro-benchmark of a VM-internal building block. The harness calls
+// run_batch() repeatedly on each worker thread of a gang and measures
+// each batch, so an implementation should do ops_per_batch operations of
+// similar cost per call and keep all shared state set up in setup().
+class InternalVMBenchmark VALUE_OBJ_CLASS_SPEC {
+ public:
+  virtual const char* name() const = 0;
+  virtual void setup(uint num_workers) {}
+  virtual void teardown() {}
+  virtual void run_batch(uint worker_id, uint ops) = 0;
+};
+
+// Runs the internal VM benchmarks selected by InternalVMBenchmarkFilter
+// on InternalVMBenchmarkThreads threads and prints the throughput and
+// the per-operation latency percentiles of each to tty.
+class InternalVMBenchmarks : AllStatic {
+ private:
+  static void run(InternalVMBenchmark* benchmark, WorkGang* gang);
+
+ public:
+  static const uint ops_per_batch = 256;
+
+  static void run_all();
+};
+
+#endif // !PRODUCT
+
+#endif // SHARE_VM_UTILITIES_INTERNALVMBENCHMARKS_HPP
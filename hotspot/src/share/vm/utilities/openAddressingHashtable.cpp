@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "utilities/debug.hpp"
+#include "utilities/openAddressingHashtable.hpp"
+
+#ifndef PRODUCT
+
+/////////////// Unit tests ///////////////
+
+class TestOpenAddressingHashtable : public AllStatic {
+  typedef uintptr_t K;
+  typedef uintptr_t V;
+
+  static unsigned bad_hash(const K& k) {
+    return 1;
+  }
+
+  class CountingIter {
+   public:
+    uintptr_t _count;
+    uintptr_t _sum;
+    CountingIter() : _count(0), _sum(0) {}
+    bool do_entry(K const& k, V const& v) {
+      assert(k * 3 == v, "wrong value");
+      _count++;
+      _sum += k;
+      return true; // continue iteration
+    }
+  };
+
+  template<unsigned (*HASH)(K const&)>
+  static void test_table(bool concurrent_readers) {
+    const uintptr_t n = 5000;
+    OpenAddressingHashtable<K, V, HASH> table(4, concurrent_readers);
+
+    // Grows through several resizes
+    for (uintptr_t i = 0; i < n; i++) {
+      assert(table.put(i, i * 3), "new entry");
+    }
+    assert(table.number_of_entries() == n, "wrong count");
+    for (uintptr_t i = 0; i < n; i++) {
+      V* v = table.get(i);
+      assert(v != NULL && *v == i * 3, "lookup failed");
+    }
+    assert(!table.contains(n), "not added");
+
+    // Replacing does not add
+    assert(!table.put(7, 21), "existing entry");
+
+    // Removes and re-adds every other entry, reusing deleted slots or
+    // triggering same-size resizes
+    for (uintptr_t i = 0; i < n; i += 2) {
+      assert(table.remove(i), "present");
+      assert(!table.remove(i), "already removed");
+    }
+    for (uintptr_t i = 0; i < n; i++) {
+      assert(table.contains(i) == ((i & 1) == 1), "wrong contents after remove");
+    }
+    for (uintptr_t i = 0; i < n; i += 2) {
+      assert(table.put(i, i * 3), "new entry");
+    }
+    assert(table.number_of_entries() == n, "wrong count");
+
+    CountingIter it;
+    table.iterate(&it);
+    assert(it._count == n, "each entry once");
+    assert(it._sum == n * (n - 1) / 2, "each entry once");
+
+    table.purge_retired();
+    for (uintptr_t i = 0; i < n; i++) {
+      assert(table.contains(i), "lost entry");
+    }
+  }
+
+ public:
+  static void run_tests() {
+    test_table<primitive_hash<K> >(false);
+    test_table<primitive_hash<K> >(true);
+    test_table<bad_hash>(false);
+  }
+};
+
+void TestOpenAddressingHashtable_test() {
+  TestOpenAddressingHashtable::run_tests();
+}
+
+#endif // not PRODUCT
@@ -0,0 +1,347 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_UTILITIES_OPENADDRESSINGHASHTABLE_HPP
+#define SHARE_VM_UTILITIES_OPENADDRESSINGHASHTABLE_HPP
+
+#include "memory/allocation.hpp"
+#include "memory/allocation.inline.hpp"
+#include "runtime/orderAccess.inline.hpp"
+#include "utilities/resourceHash.hpp"
+
+// A hash table with open addressing and linear probing. The hash, key and
+// value of an entry sit next to each other in one array, so a lookup
+// usually touches a single cache line instead of following a chain of
+// separately allocated entries as BasicHashtable does.
+//
+// K and V must be trivially copyable and no larger than a word (pointers,
+// integers) for the concurrent readers described below.
+//
+// The table grows incrementally: when it gets too full a new array of
+// twice the size is allocated, and each later put() or remove() moves a
+// few entries over from the old one, so no single update pays for the
+// whole rehash. Lookups consult both arrays while a resize is under way.
+//
+// Updates must be serialized by the caller. If the table is created with
+// concurrent_readers, get() and contains() may run without that lock:
+// entries are published with release stores, freed slots are not reused
+// until the next resize, and retired arrays are only freed by
+// purge_retired(), which the owner calls when no reader can be running
+// (for example at a safepoint).
+template<
+    typename K, typename V,
+    unsigned (*HASH)  (K const&)           = primitive_hash<K>,
+    bool     (*EQUALS)(K const&, K const&) = primitive_equals<K>,
+    MEMFLAGS MEM_TYPE = mtInternal
+    >
+class OpenAddressingHashtable : public CHeapObj<MEM_TYPE> {
+ private:
+  // Slot states are encoded in the stored hash
+  static const juint empty_hash   = 0;
+  static const juint deleted_hash = 1;
+
+  // Number of old slots moved per update while resizing
+  static const juint migrate_step = 8;
+
+  class Slot VALUE_OBJ_CLASS_SPEC {
+   public:
+    volatile juint _hash;
+    K              _key;
+    V              _value;
+  };
+
+  class Table : public CHeapObj<MEM_TYPE> {
+   public:
+    juint  _capacity;  // power of two
+    juint  _shift;     // 32 - log2(_capacity)
+    juint  _used;      // live and deleted slots
+    juint  _live;
+    Slot*  _slots;
+    Table* _next_retired;
+
+    Table(juint capacity) : _capacity(capacity), _used(0), _live(0), _next_retired(NULL) {
+      assert(is_power_of_2(capacity), "must be a power of two");
+      _shift = 32 - log2_intptr((uintptr_t) capacity);
+      _slots = NEW_C_HEAP_ARRAY(Slot, capacity, MEM_TYPE);
+      memset(_slots, 0, capacity * sizeof(Slot));
+    }
+
+    ~Table() {
+      FREE_C_HEAP_ARRAY(Slot, _slots, MEM_TYPE);
+    }
+
+    // Fibonacci hashing spreads keys whose hashes differ only in the
+    // high bits, such as aligned addresses.
+    juint index_for(juint hash) const {
+      return _shift == 32 ? 0 : (hash * 2654435769U) >> _shift;
+    }
+
+    juint next_index(juint index) const {
+      return (index + 1) & (_capacity - 1);
+    }
+
+    Slot* find(juint hash, K const& key) const {
+      juint index = index_for(hash);
+      for (juint probes = 0; probes < _capacity; probes++) {
+        Slot* slot = &_slots[index];
+        juint h = OrderAccess::load_acquire(&slot->_hash);
+        if (h == empty_hash) {
+          return NULL;
+        }
+        if (h == hash && EQUALS(key, slot->_key)) {
+          return slot;
+        }
+        index = next_index(index);
+      }
+      return NULL;
+    }
+
+    // Claims a slot for a key known to be absent.
+    Slot* claim(juint hash, bool reuse_deleted) {
+      juint index = index_for(hash);
+      while (true) {
+        Slot* slot = &_slots[index];
+        if (slot->_hash == empty_hash) {
+          _used++;
+          return slot;
+        }
+        if (reuse_deleted && slot->_hash == deleted_hash) {
+          return slot;
+        }
+        index = next_index(index);
+      }
+    }
+
+    bool needs_resize() const {
+      return _used >= _capacity - (_capacity >> 2);
+    }
+  };
+
+  Table* volatile _table;
+  Table* volatile _old_table;       // being migrated into _table, or NULL
+  juint           _migrate_index;   // next slot of _old_table to move
+  juint           _number_of_entries;
+  volatile juint  _resize_epoch;    // bumped when a resize starts or ends
+  Table*          _retired;
+  const bool      _concurrent_readers;
+
+  static juint capacity_for(juint requested) {
+    juint capacity = 4;
+    while (capacity < requested) {
+      capacity <<= 1;
+    }
+    return capacity;
+  }
+
+  static juint hash_for(K const& key) {
+    juint hash = HASH(key);
+    return hash <= deleted_hash ? hash + 2 : hash;
+  }
+
+  static void publish(Slot* slot, juint hash, K const& key, V const& value) {
+    slot->_key = key;
+    slot->_value = value;
+    OrderAccess::release_store(&slot->_hash, hash);
+  }
+
+  void retire(Table* table) {
+    if (_concurrent_readers) {
+      table->_next_retired = _retired;
+      _retired = table;
+    } else {
+      delete table;
+    }
+  }
+
+  void insert(Table* table, juint hash, K const& key, V const& value) {
+    Slot* slot = table->claim(hash, !_concurrent_readers);
+    table->_live++;
+    publish(slot, hash, key, value);
+  }
+
+  void start_resize() {
+    Table* table = _table;
+    assert(_old_table == NULL, "only one resize at a time");
+    // Only grow when most of the used slots are live, otherwise a table
+    // of the same size is enough to get rid of the deleted ones.
+    juint capacity = table->_live >= (table->_capacity >> 1) ? table->_capacity * 2 : table->_capacity;
+    Table* new_table = new Table(capacity);
+    OrderAccess::release_store(&_resize_epoch, _resize_epoch + 1);
+    OrderAccess::release_store_ptr(&_old_table, table);
+    OrderAccess::release_store_ptr(&_table, new_table);
+    _migrate_index = 0;
+  }
+
+  void migrate_some() {
+    Table* old_table = _old_table;
+    if (old_table == NULL) {
+      return;
+    }
+    juint end = MIN2(_migrate_index + migrate_step, old_table->_capacity);
+    for (juint i = _migrate_index; i < end; i++) {
+      Slot* slot = &old_table->_slots[i];
+      if (slot->_hash > deleted_hash) {
+        // Left in place so that readers probing the old table still find it
+        insert(_table, slot->_hash, slot->_key, slot->_value);
+      }
+    }
+    _migrate_index = end;
+    if (end == old_table->_capacity) {
+      OrderAccess::release_store_ptr(&_old_table, (Table*) NULL);
+      OrderAccess::release_store(&_resize_epoch, _resize_epoch + 1);
+      retire(old_table);
+    }
+  }
+
+  // Removes the entry from the old table, returning whether it was there.
+  bool remove_old(juint hash, K const& key) {
+    Table* old_table = _old_table;
+    if (old_table == NULL) {
+      return false;
+    }
+    Slot* slot = old_table->find(hash, key);
+    if (slot == NULL) {
+      return false;
+    }
+    OrderAccess::release_store(&slot->_hash, deleted_hash);
+    return true;
+  }
+
+ public:
+  OpenAddressingHashtable(juint initial_capacity = 256, bool concurrent_readers = false) :
+    _old_table(NULL), _migrate_index(0), _number_of_entries(0), _resize_epoch(0),
+    _retired(NULL), _concurrent_readers(concurrent_readers) {
+    _table = new Table(capacity_for(initial_capacity));
+  }
+
+  ~OpenAddressingHashtable() {
+    delete _table;
+    if (_old_table != NULL) {
+      delete _old_table;
+    }
+    purge_retired();
+  }
+
+  V* get(K const& key) const {
+    juint hash = hash_for(key);
+    while (true) {
+      juint epoch = OrderAccess::load_acquire((volatile juint*) &_resize_epoch);
+      Table* old_table = (Table*) OrderAccess::load_ptr_acquire(&_old_table);
+      Table* table = (Table*) OrderAccess::load_ptr_acquire(&_table);
+      Slot* slot = table->find(hash, key);
+      if (slot == NULL && old_table != NULL) {
+        slot = old_table->find(hash, key);
+      }
+      // A miss is only trustworthy if no resize started or finished
+      // while we were looking.
+      if (slot != NULL || OrderAccess::load_acquire((volatile juint*) &_resize_epoch) == epoch) {
+        return slot != NULL ? &slot->_value : NULL;
+      }
+    }
+  }
+
+  bool contains(K const& key) const {
+    return get(key) != NULL;
+  }
+
+  // Inserts or replaces a value. Returns true if a new entry was added.
+  bool put(K const& key, V const& value) {
+    juint hash = hash_for(key);
+    migrate_some();
+    Slot* slot = _table->find(hash, key);
+    if (slot != NULL) {
+      slot->_value = value;
+      return false;
+    }
+    bool existed = remove_old(hash, key);
+    if (_old_table == NULL && _table->needs_resize()) {
+      start_resize();
+    }
+    insert(_table, hash, key, value);
+    if (!existed) {
+      _number_of_entries++;
+    }
+    return !existed;
+  }
+
+  bool remove(K const& key) {
+    juint hash = hash_for(key);
+    migrate_some();
+    bool removed = remove_old(hash, key);
+    Slot* slot = _table->find(hash, key);
+    if (slot != NULL) {
+      OrderAccess::release_store(&slot->_hash, deleted_hash);
+      _table->_live--;
+      removed = true;
+    }
+    if (removed) {
+      _number_of_entries--;
+    }
+    return removed;
+  }
+
+  juint number_of_entries() const {
+    return _number_of_entries;
+  }
+
+  // Frees the arrays replaced by resizing. With concurrent readers the
+  // caller must make sure that none is running.
+  void purge_retired() {
+    while (_retired != NULL) {
+      Table* next = _retired->_next_retired;
+      delete _retired;
+      _retired = next;
+    }
+  }
+
+  // ITER contains bool do_entry(K const&, V const&), which will be
+  // called for each entry in the table.  If do_entry() returns false,
+  // the iteration is cancelled. The table must not change meanwhile.
+  template<class ITER>
+  void iterate(ITER* iter) const {
+    Table* table = _table;
+    for (juint i = 0; i < table->_capacity; i++) {
+      Slot* slot = &table->_slots[i];
+      if (slot->_hash > deleted_hash) {
+        if (!iter->do_entry(slot->_key, slot->_value)) {
+          return;
+        }
+      }
+    }
+    Table* old_table = _old_table;
+    if (old_table != NULL) {
+      // Entries already moved into the new table are still in the old one
+      for (juint i = 0; i < old_table->_capacity; i++) {
+        Slot* slot = &old_table->_slots[i];
+        if (slot->_hash > deleted_hash && table->find(slot->_hash, slot->_key) == NULL) {
+          if (!iter->do_entry(slot->_key, slot->_value)) {
+            return;
+          }
+        }
+      }
+    }
+  }
+};
+
+#endif // SHARE_VM_UTILITIES_OPENADDRESSINGHASHTABLE_HPP
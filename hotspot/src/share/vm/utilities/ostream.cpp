@@ -27,6 +27,7 @@
 #include "gc_implementation/shared/gcId.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/arguments.hpp"
+#include "runtime/asyncGCLogWriter.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/os.hpp"
 #include "runtime/vmThread.hpp"
@@ -831,6 +832,9 @@ gcLogFileStream::gcLogFileStream(const char* file_name) : _file_lock(NULL) {
     if (UseGCLogFileRotation) {
       _file_lock = new Mutex(Mutex::leaf, "GCLogFile");
     }
+    if (UseAsyncGCLog) {
+      AsyncGCLogWriter::initialize(this);
+    }
   } else {
     warning("Cannot open file %s due to %s\n", _file_name, strerror(errno));
     _need_close = false;
@@ -838,6 +842,20 @@ gcLogFileStream::gcLogFileStream(const char* file_name) : _file_lock(NULL) {
 }
 
 void gcLogFileStream::write(const char* s, size_t len) {
+  if (_file != NULL) {
+    // Hand the output to the async writer, except for the writes the
+    // VMThread makes while rotating the log.
+    Thread* thread = ThreadLocalStorage::thread();
+    if (!AsyncGCLogWriter::is_running() || thread == NULL ||
+        (thread->is_VM_thread() && ((VMThread* )thread)->is_gclog_reentry()) ||
+        !AsyncGCLogWriter::enqueue(s, len)) {
+      write_direct(s, len);
+    }
+  }
+  update_position(s, len);
+}
+
+void gcLogFileStream::write_direct(const char* s, size_t len) {
   if (_file != NULL) {
     // we can't use Thread::current() here because thread may be NULL
     // in early stage(ostream_init_log)
@@ -858,7 +876,6 @@ void gcLogFileStream::write(const char* s, size_t len) {
       _bytes_written += count;
     }
   }
-  update_position(s, len);
 }
 
 // rotate_log must be called from VMThread at a safepoint. In case need change parameters
@@ -868,6 +885,10 @@ void gcLogFileStream::write(const char* s, size_t len) {
 // no mutator threads run concurrently with the VMThread, and GC threads that run
 // concurrently with the VMThread are synchronized in write and rotate_log via _file_lock.
 // rotate_log can write log entries, so write supports reentry for it.
+// With UseAsyncGCLog the buffered output is written out first, so that
+// it ends up in the file it belongs to. If the writer is busy, which
+// may mean the log device is stalled, a rotation that is not forced is
+// left to a later safepoint.
 void gcLogFileStream::rotate_log(bool force, outputStream* out) {
  #ifdef ASSERT
    Thread *thread = Thread::current();
@@ -876,6 +897,16 @@ void gcLogFileStream::rotate_log(bool force, outputStream* out) {
           "Must be VMThread at safepoint");
  #endif
 
+  bool async = AsyncGCLogWriter::is_running();
+  if (async) {
+    if (force) {
+      AsyncGCLog_lock->lock_without_safepoint_check();
+    } else if (!AsyncGCLog_lock->try_lock()) {
+      return;
+    }
+    AsyncGCLogWriter::flush();
+  }
+
   VMThread* vmthread = VMThread::vm_thread();
   {
     // nop if _file_lock is NULL.
@@ -884,6 +915,10 @@ void gcLogFileStream::rotate_log(bool force, outputStream* out) {
     rotate_log_impl(force, out);
     vmthread->set_gclog_reentry(false);
   }
+
+  if (async) {
+    AsyncGCLog_lock->unlock();
+  }
 }
 
 void gcLogFileStream::rotate_log_impl(bool force, outputStream* out) {
@@ -248,6 +248,8 @@ class gcLogFileStream : public fileStream {
   gcLogFileStream(const char* file_name);
   ~gcLogFileStream();
   virtual void write(const char* c, size_t len);
+  // Write to the file even if UseAsyncGCLog buffers the output.
+  void write_direct(const char* c, size_t len);
   virtual void rotate_log(bool force, outputStream* out = NULL);
   void dump_loggc_header();
 
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_UTILITIES_POPULATION_COUNT_HPP
+#define SHARE_VM_UTILITIES_POPULATION_COUNT_HPP
+
+#include "utilities/globalDefinitions.hpp"
+
+// unsigned population_count(uintx x)
+// Return the number of set bits in x.
+
+inline unsigned population_count(uintx x) {
+#if defined(TARGET_COMPILER_gcc)
+  return __builtin_popcountl(x);
+#else
+  // Sum the bits of each byte, then add up the bytes with a multiply
+  const uintx all_ones = ~(uintx)0;
+  x -= (x >> 1) & (all_ones / 3);
+  x = (x & (all_ones / 15 * 3)) + ((x >> 2) & (all_ones / 15 * 3));
+  x = (x + (x >> 4)) & (all_ones / 255 * 15);
+  return (unsigned)((x * (all_ones / 255)) >> (BitsPerWord - BitsPerByte));
+#endif
+}
+
+#endif // SHARE_VM_UTILITIES_POPULATION_COUNT_HPP
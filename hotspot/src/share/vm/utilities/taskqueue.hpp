@@ -56,6 +56,8 @@ public:
     pop_slow,         // subset of taskqueue pops that were done slow-path
     steal_attempt,    // number of taskqueue steal attempts
     steal,            // number of taskqueue steals
+    steal_last,       // subset of steals taken from the last victim queue
+    steal_empty,      // steal attempts that found both sampled queues empty
     overflow,         // number of overflow pushes
     overflow_max_len, // max length of overflow stack
     last_stat_id
@@ -68,6 +70,8 @@ public:
   inline void record_pop()      { ++_stats[pop]; }
   inline void record_pop_slow() { record_pop(); ++_stats[pop_slow]; }
   inline void record_steal(bool success);
+  inline void record_steal_last()  { ++_stats[steal_last]; }
+  inline void record_steal_empty() { ++_stats[steal_empty]; }
   inline void record_overflow(size_t new_length);
 
   TaskQueueStats & operator +=(const TaskQueueStats & addend);
@@ -157,6 +161,12 @@ protected:
   // Add paddings to reduce false-sharing cache contention between _bottom and _age
   DEFINE_PAD_MINUS_SIZE(0, DEFAULT_CACHE_LINE_SIZE, sizeof(uint));
   volatile Age _age;
+  // Keep the owner-only state below off the cache line stealers update
+  DEFINE_PAD_MINUS_SIZE(1, DEFAULT_CACHE_LINE_SIZE, sizeof(Age));
+
+  // The queue the owner of this queue last stole from successfully, or
+  // InvalidQueueId.  Only accessed by the owner.
+  uint _last_stolen_queue_id;
 
   // These both operate mod N.
   static uint increment_index(uint ind) {
@@ -193,7 +203,9 @@ protected:
   }
 
 public:
-  TaskQueueSuper() : _bottom(0), _age() {}
+  enum { InvalidQueueId = max_juint };
+
+  TaskQueueSuper() : _bottom(0), _age(), _last_stolen_queue_id(InvalidQueueId) {}
 
   // Return true if the TaskQueue contains/does not contain any tasks.
   bool peek()     const { return _bottom != _age.top(); }
@@ -215,6 +227,11 @@ public:
     _age.set(0);
   }
 
+  uint last_stolen_queue_id() const          { return _last_stolen_queue_id; }
+  bool is_last_stolen_queue_id_valid() const { return _last_stolen_queue_id != InvalidQueueId; }
+  void set_last_stolen_queue_id(uint id)     { _last_stolen_queue_id = id; }
+  void invalidate_last_stolen_queue_id()     { _last_stolen_queue_id = InvalidQueueId; }
+
   // Maximum number of elements allowed in the queue.  This is two less
   // than the actual queue size, for somewhat complicated reasons.
   uint max_elems() const { return N - 2; }
@@ -503,6 +520,8 @@ protected:
 public:
   // Returns "true" if some TaskQueue in the set contains a task.
   virtual bool peek() = 0;
+  // Returns an estimate of the number of tasks in the TaskQueues of the set.
+  virtual size_t tasks() = 0;
 };
 
 template <MEMFLAGS F> class TaskQueueSetSuperImpl: public CHeapObj<F>, public TaskQueueSetSuper {
@@ -539,6 +558,7 @@ public:
   bool steal(uint queue_num, int* seed, E& t);
 
   bool peek();
+  size_t tasks();
 };
 
 template<class T, MEMFLAGS F> void
@@ -567,15 +587,43 @@ GenericTaskQueueSet<T, F>::steal(uint queue_num, int* seed, E& t) {
 template<class T, MEMFLAGS F> bool
 GenericTaskQueueSet<T, F>::steal_best_of_2(uint queue_num, int* seed, E& t) {
   if (_n > 2) {
+    T* const local_queue = _queues[queue_num];
+    // A queue that had work to steal last time likely still has some, so
+    // sample it against a random one instead of two random queues.
     uint k1 = queue_num;
-    while (k1 == queue_num) k1 = TaskQueueSetSuper::randomParkAndMiller(seed) % _n;
+    if (local_queue->is_last_stolen_queue_id_valid()) {
+      k1 = local_queue->last_stolen_queue_id();
+      assert(k1 != queue_num, "Should not be the same");
+    } else {
+      while (k1 == queue_num) k1 = TaskQueueSetSuper::randomParkAndMiller(seed) % _n;
+    }
     uint k2 = queue_num;
     while (k2 == queue_num || k2 == k1) k2 = TaskQueueSetSuper::randomParkAndMiller(seed) % _n;
-    // Sample both and try the larger.
+    // Sample both and try the larger; don't touch either if both are empty.
     uint sz1 = _queues[k1]->size();
     uint sz2 = _queues[k2]->size();
-    if (sz2 > sz1) return _queues[k2]->pop_global(t);
-    else return _queues[k1]->pop_global(t);
+    uint sel_k = T::InvalidQueueId;
+    bool suc = false;
+    if (sz2 > sz1) {
+      sel_k = k2;
+      suc = _queues[k2]->pop_global(t);
+    } else if (sz1 > 0) {
+      sel_k = k1;
+      suc = _queues[k1]->pop_global(t);
+    } else {
+      TASKQUEUE_STATS_ONLY(local_queue->stats.record_steal_empty());
+    }
+    if (suc) {
+#if TASKQUEUE_STATS
+      if (sel_k == local_queue->last_stolen_queue_id()) {
+        local_queue->stats.record_steal_last();
+      }
+#endif
+      local_queue->set_last_stolen_queue_id(sel_k);
+    } else {
+      local_queue->invalidate_last_stolen_queue_id();
+    }
+    return suc;
   } else if (_n == 2) {
     // Just try the other one.
     uint k = (queue_num + 1) % 2;
@@ -596,6 +644,15 @@ bool GenericTaskQueueSet<T, F>::peek() {
   return false;
 }
 
+template<class T, MEMFLAGS F>
+size_t GenericTaskQueueSet<T, F>::tasks() {
+  size_t n = 0;
+  for (uint j = 0; j < _n; j++) {
+    n += _queues[j]->size();
+  }
+  return n;
+}
+
 // When to terminate from the termination protocol.
 class TerminatorTerminator: public CHeapObj<mtInternal> {
 public:
@@ -607,6 +664,11 @@ public:
 
 #undef TRACESPINNING
 
+// With UseOWSTTaskTerminator the terminator follows the "Optimized Work
+// Stealing Threads" protocol: of the threads offering termination only one,
+// the spin master, spins and peeks at the queues; the others wait on
+// _blocker until the spin master sees enough tasks for them to steal.
+
 class ParallelTaskTerminator: public StackObj {
 private:
   int _n_threads;
@@ -615,6 +677,10 @@ private:
   int _offered_termination;
   char _pad_after[DEFAULT_CACHE_LINE_SIZE];
 
+  // Protocol state for UseOWSTTaskTerminator; _blocker is NULL otherwise.
+  Monitor* _blocker;
+  Thread* volatile _spin_master;
+
 #ifdef TRACESPINNING
   static uint _total_yields;
   static uint _total_spins;
@@ -622,6 +688,14 @@ private:
 #endif
 
   bool peek_in_queue_set();
+
+  bool offer_termination_owst(TerminatorTerminator* terminator);
+  // Spin, yield and sleep as the spin master until all threads offered
+  // termination (returns true) or there is work to do (returns false).
+  bool do_spin_master_work(TerminatorTerminator* terminator);
+  bool exit_termination(size_t tasks, TerminatorTerminator* terminator) {
+    return tasks > 0 || (terminator != NULL && terminator->should_exit_termination());
+  }
 protected:
   virtual void yield();
   void sleep(uint millis);
@@ -631,6 +705,7 @@ public:
   // "n_threads" is the number of threads to be terminated.  "queue_set" is a
   // queue sets of work queues of other threads.
   ParallelTaskTerminator(int n_threads, TaskQueueSetSuper* queue_set);
+  ~ParallelTaskTerminator();
 
   // The current thread has no work, and is ready to terminate if everyone
   // else is.  If returns "true", all threads are terminated.  If returns
@@ -24,12 +24,9 @@
 
 #include "precompiled.hpp"
 #include "runtime/os.hpp"
+#include "utilities/fastTimeCounter.hpp"
 #include "utilities/ticks.hpp"
 
-#if defined(X86) && !defined(ZERO)
-#include "rdtsc_x86.hpp"
-#endif
-
 template <typename TimeSource, const int unit>
 inline double conversion(typename TimeSource::Type& value) {
   return (double)value * ((double)unit / (double)TimeSource::frequency());
@@ -61,10 +58,10 @@ uint64_t ElapsedCounterSource::nanoseconds(Type value) {
 }
 
 uint64_t FastUnorderedElapsedCounterSource::frequency() {
-#if defined(X86) && !defined(ZERO)
-  static bool valid_rdtsc = Rdtsc::initialize();
+#ifdef FAST_TIME_COUNTER
+  static bool valid_rdtsc = FastTimeCounter::initialize();
   if (valid_rdtsc) {
-    static const uint64_t freq = (uint64_t)Rdtsc::frequency();
+    static const uint64_t freq = (uint64_t)FastTimeCounter::frequency();
     return freq;
   }
 #endif
@@ -73,10 +70,10 @@ uint64_t FastUnorderedElapsedCounterSource::frequency() {
 }
 
 FastUnorderedElapsedCounterSource::Type FastUnorderedElapsedCounterSource::now() {
-#if defined(X86) && !defined(ZERO)
-  static bool valid_rdtsc = Rdtsc::initialize();
+#ifdef FAST_TIME_COUNTER
+  static bool valid_rdtsc = FastTimeCounter::initialize();
   if (valid_rdtsc) {
-    return Rdtsc::elapsed_counter();
+    return FastTimeCounter::elapsed_counter();
   }
 #endif
   return os::elapsed_counter();
@@ -105,15 +102,15 @@ uint64_t CompositeElapsedCounterSource::frequency() {
 CompositeElapsedCounterSource::Type CompositeElapsedCounterSource::now() {
   CompositeTime ct;
   ct.val1 = ElapsedCounterSource::now();
-#if defined(X86) && !defined(ZERO)
+#ifdef FAST_TIME_COUNTER
   static bool initialized = false;
   static bool valid_rdtsc = false;
   if (!initialized) {
-    valid_rdtsc = Rdtsc::initialize();
+    valid_rdtsc = FastTimeCounter::initialize();
     initialized = true;
   }
   if (valid_rdtsc) {
-    ct.val2 = Rdtsc::elapsed_counter();
+    ct.val2 = FastTimeCounter::elapsed_counter();
   }
 #endif
   return ct;
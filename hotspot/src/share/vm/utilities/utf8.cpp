@@ -146,16 +146,16 @@ static u_char* utf8_write(u_char* base, jchar ch) {
 }
 
 void UTF8::convert_to_unicode(const char* utf8_str, jchar* unicode_str, int unicode_length) {
-  unsigned char ch;
+  // A string has at least as many bytes as characters, so scanning
+  // unicode_length bytes for the ASCII prefix stays inside it.
+  int index = ascii_prefix_length((const unsigned char*) utf8_str, unicode_length);
   const char *ptr = utf8_str;
-  int index = 0;
 
   /* ASCII case loop optimization */
-  for (; index < unicode_length; index++) {
-    if((ch = ptr[0]) > 0x7F) { break; }
-    unicode_str[index] = ch;
-    ptr = (const char *)(ptr + 1);
+  for (int i = 0; i < index; i++) {
+    unicode_str[i] = (unsigned char) ptr[i];
   }
+  ptr += index;
 
   for (; index < unicode_length; index++) {
     ptr = UTF8::next(ptr, &unicode_str[index]);
@@ -306,19 +306,68 @@ jint UTF8::get_supplementary_character(const unsigned char* str) {
                  + ((str[4] & 0x0f) << 6)  + (str[5] & 0x3f);
 }
 
+int UTF8::ascii_prefix_length(const unsigned char* str, int length) {
+  // Check eight bytes at a time.  A word has no byte with the high bit
+  // set if (w & high) == 0, and then it has no zero byte if
+  // ((w - low) & ~w & high) == 0.
+  const julong low  = CONST64(0x0101010101010101);
+  const julong high = CONST64(0x8080808080808080);
+  int i = 0;
+  for (; i + (int)sizeof(julong) <= length; i += sizeof(julong)) {
+    julong w;
+    memcpy(&w, str + i, sizeof(julong));  // the buffer need not be aligned
+    if (((w | ((w - low) & ~w)) & high) != 0) {
+      break;
+    }
+  }
+  while (i < length && str[i] != 0 && str[i] < 128) {
+    i++;
+  }
+  return i;
+}
+
 
 //-------------------------------------------------------------------------------------
 
 
+bool UNICODE::is_latin1(const jchar* base, int length) {
+  for (int index = 0; index < length; index++) {
+    if (base[index] > 0xff) {
+      return false;
+    }
+  }
+  return true;
+}
+
 int UNICODE::utf8_size(jchar c) {
   if ((0x0001 <= c) && (c <= 0x007F)) return 1;
   if (c <= 0x07FF) return 2;
   return 3;
 }
 
+int UNICODE::ascii_prefix_length(const jchar* base, int length) {
+  // Check four characters at a time, as UTF8::ascii_prefix_length does
+  // eight bytes.
+  const julong low  = CONST64(0x0001000100010001);
+  const julong high = CONST64(0x8000800080008000);
+  const julong non_ascii = CONST64(0xFF80FF80FF80FF80);
+  int i = 0;
+  for (; i + 4 <= length; i += 4) {
+    julong w;
+    memcpy(&w, base + i, sizeof(julong));  // the buffer need not be aligned
+    if ((w & non_ascii) != 0 || ((w - low) & ~w & high) != 0) {
+      break;
+    }
+  }
+  while (i < length && base[i] != 0 && base[i] <= 0x7F) {
+    i++;
+  }
+  return i;
+}
+
 int UNICODE::utf8_length(jchar* base, int length) {
-  int result = 0;
-  for (int index = 0; index < length; index++) {
+  int result = ascii_prefix_length(base, length);
+  for (int index = result; index < length; index++) {
     jchar c = base[index];
     if ((0x0001 <= c) && (c <= 0x007F)) result += 1;
     else if (c <= 0x07FF) result += 2;
@@ -327,11 +376,22 @@ int UNICODE::utf8_length(jchar* base, int length) {
   return result;
 }
 
+// Narrows the leading ASCII characters of a unicode string, at most
+// limit of them, and returns their number.
+static int narrow_ascii_prefix(const jchar* base, int limit, u_char* buf) {
+  int ascii = UNICODE::ascii_prefix_length(base, limit);
+  for (int index = 0; index < ascii; index++) {
+    buf[index] = (u_char) base[index];
+  }
+  return ascii;
+}
+
 char* UNICODE::as_utf8(jchar* base, int length) {
   int utf8_len = utf8_length(base, length);
   u_char* result = NEW_RESOURCE_ARRAY(u_char, utf8_len + 1);
-  u_char* p = result;
-  for (int index = 0; index < length; index++) {
+  int ascii = narrow_ascii_prefix(base, length, result);
+  u_char* p = result + ascii;
+  for (int index = ascii; index < length; index++) {
     p = utf8_write(p, base[index]);
   }
   *p = '\0';
@@ -340,9 +400,11 @@ char* UNICODE::as_utf8(jchar* base, int length) {
 }
 
 char* UNICODE::as_utf8(jchar* base, int length, char* buf, int buflen) {
-  u_char* p = (u_char*)buf;
+  // Leave room for the terminating '\0'
+  int ascii = narrow_ascii_prefix(base, MIN2(length, buflen - 1), (u_char*)buf);
+  u_char* p = (u_char*)buf + ascii;
   u_char* end = (u_char*)buf + buflen;
-  for (int index = 0; index < length; index++) {
+  for (int index = ascii; index < length; index++) {
     jchar c = base[index];
     if (p + utf8_size(c) >= end) break;      // string is truncated
     p = utf8_write(p, base[index]);
@@ -352,7 +414,9 @@ char* UNICODE::as_utf8(jchar* base, int length, char* buf, int buflen) {
 }
 
 void UNICODE::convert_to_utf8(const jchar* base, int length, char* utf8_buffer) {
-  for(int index = 0; index < length; index++) {
+  int ascii = narrow_ascii_prefix(base, length, (u_char*)utf8_buffer);
+  utf8_buffer += ascii;
+  for(int index = ascii; index < length; index++) {
     utf8_buffer = (char*)utf8_write((u_char*)utf8_buffer, base[index]);
   }
   *utf8_buffer = '\0';
@@ -65,6 +65,10 @@ class UTF8 : AllStatic {
   static bool   equal(const jbyte* base1, int length1, const jbyte* base2,int length2);
   static bool   is_supplementary_character(const unsigned char* str);
   static jint   get_supplementary_character(const unsigned char* str);
+
+  // returns the length of the leading run of ascii characters other
+  // than 0, which need no further checks to be legal
+  static int    ascii_prefix_length(const unsigned char* str, int length);
 };
 
 
@@ -76,9 +80,16 @@ class UTF8 : AllStatic {
 
 class UNICODE : AllStatic {
  public:
+  // returns true if every character of the unicode string fits in Latin-1
+  static bool is_latin1(const jchar* base, int length);
+
   // returns the utf8 size of a unicode character
   static int utf8_size(jchar c);
 
+  // returns the length of the leading run of ascii characters other
+  // than 0, which take one byte each in utf8
+  static int ascii_prefix_length(const jchar* base, int length);
+
   // returns the utf8 length of a unicode string
   static int utf8_length(jchar* base, int length);
 
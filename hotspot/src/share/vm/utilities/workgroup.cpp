@@ -48,6 +48,8 @@ AbstractWorkGang::AbstractWorkGang(const char* name,
                          /* allow_vm_block */ are_GC_task_threads);
   assert(monitor() != NULL, "Failed to allocate monitor");
   _terminate = false;
+  _gang_workers = NULL;
+  _created_workers = 0;
   _task = NULL;
   _sequence_number = 0;
   _started_workers = 0;
@@ -84,26 +86,47 @@ bool WorkGang::initialize_workers() {
     vm_exit_out_of_memory(0, OOM_MALLOC_ERROR, "Cannot create GangWorker array.");
     return false;
   }
+  uint initial_workers = total_workers();
+  if (UseDynamicNumberOfGCThreads) {
+    initial_workers = MIN2(active_workers(), total_workers());
+  }
+  return add_workers(initial_workers, true /* initializing */) == initial_workers;
+}
+
+uint WorkGang::add_workers(uint n, bool initializing) {
+  assert(gang_workers() != NULL, "Workers not initialized");
+  assert(n <= total_workers(), "Trying to create more workers than there are");
   os::ThreadType worker_type;
   if (are_ConcurrentGC_threads()) {
     worker_type = os::cgc_thread;
   } else {
     worker_type = os::pgc_thread;
   }
-  for (uint worker = 0; worker < total_workers(); worker += 1) {
+  for (uint worker = created_workers(); worker < n; worker += 1) {
     GangWorker* new_worker = allocate_worker(worker);
     assert(new_worker != NULL, "Failed to allocate GangWorker");
-    _gang_workers[worker] = new_worker;
     if (new_worker == NULL || !os::create_thread(new_worker, worker_type)) {
-      vm_exit_out_of_memory(0, OOM_MALLOC_ERROR,
-              "Cannot create worker GC thread. Out of system resources.");
-      return false;
+      if (initializing) {
+        vm_exit_out_of_memory(0, OOM_MALLOC_ERROR,
+                "Cannot create worker GC thread. Out of system resources.");
+      }
+      if (TraceDynamicGCThreads) {
+        gclog_or_tty->print_cr("Cannot create worker %u of work gang %s, "
+                               "continuing with %u workers",
+                               worker, name(), worker);
+      }
+      delete new_worker;
+      break;
     }
+    _gang_workers[worker] = new_worker;
+    // Publish the worker before starting it, so that it is found by
+    // threads_do() and friends.
+    OrderAccess::release_store(&_created_workers, worker + 1);
     if (!DisableStartThread) {
       os::start_thread(new_worker);
     }
   }
-  return true;
+  return created_workers();
 }
 
 AbstractWorkGang::~AbstractWorkGang() {
@@ -111,7 +134,7 @@ AbstractWorkGang::~AbstractWorkGang() {
     tty->print_cr("Destructing work gang %s", name());
   }
   stop();   // stop all the workers
-  for (uint worker = 0; worker < total_workers(); worker += 1) {
+  for (uint worker = 0; worker < created_workers(); worker += 1) {
     delete gang_worker(worker);
   }
   delete gang_workers();
@@ -122,7 +145,7 @@ GangWorker* AbstractWorkGang::gang_worker(uint i) const {
   // Array index bounds checking.
   GangWorker* result = NULL;
   assert(gang_workers() != NULL, "No workers for indexing");
-  assert(((i >= 0) && (i < total_workers())), "Worker index out of bounds");
+  assert(((i >= 0) && (i < created_workers())), "Worker index out of bounds");
   result = _gang_workers[i];
   assert(result != NULL, "Indexing to null worker");
   return result;
@@ -177,6 +200,21 @@ void FlexibleWorkGang::run_task(AbstractGangTask* task) {
   WorkGang::run_task(task, (uint) active_workers());
 }
 
+void FlexibleWorkGang::set_active_workers(uint v) {
+  assert(v <= _total_workers,
+         "Trying to set more workers active than there are");
+  _active_workers = MIN2(v, _total_workers);
+  assert(v != 0, "Trying to set active workers to 0");
+  _active_workers = MAX2(1U, _active_workers);
+  assert(UseDynamicNumberOfGCThreads || _active_workers == _total_workers,
+         "Unless dynamic should use total workers");
+  // Before initialize_workers() the workers are created there.
+  if (gang_workers() != NULL) {
+    _active_workers = MIN2(_active_workers,
+                           add_workers(_active_workers, false /* initializing */));
+  }
+}
+
 void AbstractWorkGang::stop() {
   // Tell all workers to terminate, then wait for them to become inactive.
   MutexLockerEx ml(monitor(), Mutex::_no_safepoint_check_flag);
@@ -214,7 +252,7 @@ void AbstractWorkGang::internal_note_finish() {
 }
 
 void AbstractWorkGang::print_worker_threads_on(outputStream* st) const {
-  uint    num_thr = total_workers();
+  uint    num_thr = created_workers();
   for (uint i = 0; i < num_thr; i++) {
     gang_worker(i)->print_on(st);
     st->cr();
@@ -223,7 +261,7 @@ void AbstractWorkGang::print_worker_threads_on(outputStream* st) const {
 
 void AbstractWorkGang::threads_do(ThreadClosure* tc) const {
   assert(tc != NULL, "Null ThreadClosure");
-  uint num_thr = total_workers();
+  uint num_thr = created_workers();
   for (uint i = 0; i < num_thr; i++) {
     tc->do_thread(gang_worker(i));
   }
@@ -144,6 +144,9 @@ protected:
   // The array of worker threads for this gang.
   // This is only needed for cleaning up.
   GangWorker** _gang_workers;
+  // The number of workers created so far.  With UseDynamicNumberOfGCThreads
+  // a FlexibleWorkGang creates its workers only once they become active.
+  volatile uint _created_workers;
   // The task for this gang.
   AbstractGangTask* _task;
   // A sequence number for the current task.
@@ -163,6 +166,9 @@ public:
   virtual uint active_workers() const {
     return _total_workers;
   }
+  uint created_workers() const {
+    return OrderAccess::load_acquire(const_cast<volatile juint*>(&_created_workers));
+  }
   bool terminate() const {
     return _terminate;
   }
@@ -254,7 +260,13 @@ public:
   // Initialize workers in the gang.  Return true if initialization
   // succeeded. The type of the worker can be overridden in a derived
   // class with the appropriate implementation of allocate_worker().
+  // Only the initially active workers are created if the others can be
+  // added later by add_workers().
   bool initialize_workers();
+  // Create workers so that at least n of them exist.  Returns the number
+  // of workers created, which is less than n only if thread creation
+  // failed after initialization.
+  uint add_workers(uint n, bool initializing);
 };
 
 // Class GangWorker:
@@ -325,15 +337,8 @@ class FlexibleWorkGang: public WorkGang {
     _active_workers(UseDynamicNumberOfGCThreads ? 1U : ParallelGCThreads) {}
   // Accessors for fields
   virtual uint active_workers() const { return _active_workers; }
-  void set_active_workers(uint v) {
-    assert(v <= _total_workers,
-           "Trying to set more workers active than there are");
-    _active_workers = MIN2(v, _total_workers);
-    assert(v != 0, "Trying to set active workers to 0");
-    _active_workers = MAX2(1U, _active_workers);
-    assert(UseDynamicNumberOfGCThreads || _active_workers == _total_workers,
-           "Unless dynamic should use total workers");
-  }
+  // Also creates the workers needed for v of them to be active.
+  void set_active_workers(uint v);
   virtual void run_task(AbstractGangTask* task);
   virtual bool needs_more_workers() const {
     return _started_workers < _active_workers;
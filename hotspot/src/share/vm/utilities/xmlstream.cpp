@@ -390,6 +390,8 @@ void xmlStream::method(methodHandle method) {
     for (uint reason = 0; reason < mdo->trap_reason_limit(); reason++) {
       cnt = mdo->trap_count(reason);
       if (cnt != 0)  print(" %s_traps='%d'", Deoptimization::trap_reason_name(reason), cnt);
+      cnt = mdo->recompile_count(reason);
+      if (cnt != 0)  print(" %s_recompiles='%d'", Deoptimization::trap_reason_name(reason), cnt);
     }
     cnt = mdo->overflow_trap_count();
     if (cnt != 0)  print(" overflow_traps='%d'", cnt);
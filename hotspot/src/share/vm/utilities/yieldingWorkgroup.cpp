@@ -111,6 +111,12 @@ NOTE: we can always create a new gang per each iteration
  */
 /////////////////////
 void YieldingFlexibleWorkGang::start_task(YieldingFlexibleGangTask* new_task) {
+  // Create the workers the task may use before binding it to the gang.
+  uint requested_size = new_task->requested_size();
+  add_workers(requested_size != 0 ? MIN2(requested_size, total_workers())
+                                  : active_workers(),
+              false /* initializing */);
+
   MutexLockerEx ml(monitor(), Mutex::_no_safepoint_check_flag);
   assert(task() == NULL, "Gang currently tied to a task");
   assert(new_task != NULL, "Null task");
@@ -119,13 +125,13 @@ void YieldingFlexibleWorkGang::start_task(YieldingFlexibleGangTask* new_task) {
   new_task->set_gang(this);  // Establish 2-way binding to support yielding
   _sequence_number++;
 
-  uint requested_size = new_task->requested_size();
   assert(requested_size >= 0, "Should be non-negative");
   if (requested_size != 0) {
     _active_workers = MIN2(requested_size, total_workers());
   } else {
     _active_workers = active_workers();
   }
+  _active_workers = MIN2(_active_workers, created_workers());
   new_task->set_actual_size(_active_workers);
   new_task->set_for_termination(_active_workers);
 
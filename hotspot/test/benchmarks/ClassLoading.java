@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+/**
+ * Defines, links and initializes copies of a class in fresh class
+ * loaders, which includes parsing and verifying it each time.
+ */
+public class ClassLoading extends Workload {
+
+    public static void main(String[] args) throws Exception {
+        String name = CompileThroughput.Kernel.class.getName();
+        byte[] bytes = classBytes(CompileThroughput.Kernel.class);
+        for (int i = 0; i < 500; i++) {
+            Class.forName(name, true, new IsolatingLoader(name, bytes));
+        }
+        int count = scaled(10_000);
+        long start = System.nanoTime();
+        for (int i = 0; i < count; i++) {
+            Class.forName(name, true, new IsolatingLoader(name, bytes));
+        }
+        report("classload.rate", count / seconds(System.nanoTime() - start), "classes/s");
+    }
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+import java.lang.management.CompilationMXBean;
+import java.lang.management.ManagementFactory;
+import java.util.ArrayList;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.function.IntUnaryOperator;
+
+/**
+ * Warms up many copies of the same small set of methods, each copy in a
+ * class of its own, until they have been compiled at every tier, and
+ * reports the time the JIT compilers spent and the wall clock time.
+ */
+public class CompileThroughput extends Workload {
+
+    public static class Kernel implements IntUnaryOperator {
+        private final Map<Integer, String> map = new HashMap<>();
+        private final List<Integer> list = new ArrayList<>();
+
+        private int arithmetic(int x) {
+            int r = x;
+            for (int i = 0; i < 32; i++) {
+                r = r * 31 + (r >>> 7) ^ i;
+            }
+            return r;
+        }
+
+        private int strings(int x) {
+            StringBuilder sb = new StringBuilder();
+            sb.append("k").append(x & 1023).append('-').append(x >>> 20);
+            return sb.toString().hashCode();
+        }
+
+        private int collections(int x) {
+            map.put(x & 255, "v");
+            list.add(x);
+            if (list.size() > 64) {
+                list.clear();
+            }
+            return map.size() + list.size();
+        }
+
+        private int arrays(int x) {
+            int[] a = new int[16];
+            for (int i = 0; i < a.length; i++) {
+                a[i] = x + i;
+            }
+            int sum = 0;
+            for (int v : a) {
+                sum += v;
+            }
+            return sum;
+        }
+
+        @Override
+        public int applyAsInt(int x) {
+            return arithmetic(x) + strings(x) + collections(x) + arrays(x);
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        byte[] bytes = classBytes(Kernel.class);
+        int copies = scaled(200);
+        IntUnaryOperator[] kernels = new IntUnaryOperator[copies];
+        for (int i = 0; i < copies; i++) {
+            Class<?> c = Class.forName(Kernel.class.getName(), true,
+                                       new IsolatingLoader(Kernel.class.getName(), bytes));
+            kernels[i] = (IntUnaryOperator) c.newInstance();
+        }
+
+        CompilationMXBean compilation = ManagementFactory.getCompilationMXBean();
+        long compileTimeBefore = compilation.getTotalCompilationTime();
+        long start = System.nanoTime();
+        int sink = 0;
+        // Enough calls for tier 4 with the default thresholds
+        for (int round = 0; round < 30_000; round++) {
+            for (IntUnaryOperator k : kernels) {
+                sink += k.applyAsInt(round);
+            }
+        }
+        long elapsed = System.nanoTime() - start;
+        report("compile.wall", elapsed / 1e6, "ms");
+        if (compilation.isCompilationTimeMonitoringSupported()) {
+            report("compile.jit_time", compilation.getTotalCompilationTime() - compileTimeBefore, "ms");
+        }
+        if (sink == 42) {
+            System.out.println();
+        }
+    }
+}
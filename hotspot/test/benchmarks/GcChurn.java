@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+import java.util.Random;
+
+/**
+ * Allocation of short lived byte arrays of random sizes, with a live set
+ * of about 40% of the heap whose entries keep being replaced, so that old
+ * objects die too. Together with the GC log metrics this gives young,
+ * mixed and old collection pauses for each collector, and ends with one
+ * full collection.
+ */
+public class GcChurn extends Workload {
+
+    private static final int MIN_SIZE = 16;
+    private static final int MAX_SIZE = 2048;
+
+    public static void main(String[] args) {
+        Random random = new Random(SEED);
+        long averageSize = (MIN_SIZE + MAX_SIZE) / 2 + 16;
+        int liveSlots = (int) (Runtime.getRuntime().maxMemory() * 2 / 5 / averageSize);
+        Object[] live = new Object[liveSlots];
+        for (int i = 0; i < liveSlots; i++) {
+            live[i] = new byte[MIN_SIZE + random.nextInt(MAX_SIZE - MIN_SIZE)];
+        }
+
+        long allocations = scaled(20_000_000L);
+        long allocated = 0;
+        long start = System.nanoTime();
+        for (long i = 0; i < allocations; i++) {
+            byte[] array = new byte[MIN_SIZE + random.nextInt(MAX_SIZE - MIN_SIZE)];
+            allocated += array.length;
+            if ((i & 15) == 0) {
+                live[random.nextInt(liveSlots)] = array;
+            }
+        }
+        long elapsed = System.nanoTime() - start;
+        report("gc.allocation_rate", allocated / (1024.0 * 1024.0) / seconds(elapsed), "MB/s");
+
+        start = System.nanoTime();
+        System.gc();
+        report("gc.system_gc", (System.nanoTime() - start) / 1e6, "ms");
+        if (live[random.nextInt(liveSlots)] == null) {
+            throw new AssertionError();
+        }
+    }
+}
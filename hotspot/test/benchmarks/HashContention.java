@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+/**
+ * Identity hash codes of objects that other threads hash at the same
+ * time, or that have been used as locks: racing to install the hash in
+ * the header, and hashing biased-locked objects, which needs the bias
+ * revoked first.
+ */
+public class HashContention extends Workload {
+
+    private static volatile int sink;
+
+    private static Object[] newObjects(int count) {
+        Object[] objects = new Object[count];
+        for (int i = 0; i < count; i++) {
+            objects[i] = new Object();
+        }
+        return objects;
+    }
+
+    private static int hashAll(Object[] objects) {
+        int sum = 0;
+        for (Object o : objects) {
+            sum += System.identityHashCode(o);
+        }
+        return sum;
+    }
+
+    private static void lockAll(Object[] objects) {
+        for (Object o : objects) {
+            synchronized (o) {
+                sink++;
+            }
+        }
+    }
+
+    // Runs hashAll on the same objects in numThreads threads started
+    // together, and returns the elapsed time in nanoseconds.
+    private static long hashConcurrently(final Object[] objects, int numThreads) throws Exception {
+        Thread[] threads = new Thread[numThreads];
+        for (int i = 0; i < numThreads; i++) {
+            threads[i] = new Thread(() -> sink += hashAll(objects), "hasher-" + i);
+        }
+        long start = System.nanoTime();
+        for (Thread t : threads) {
+            t.start();
+        }
+        for (Thread t : threads) {
+            t.join();
+        }
+        return System.nanoTime() - start;
+    }
+
+    public static void main(String[] args) throws Exception {
+        for (int i = 0; i < 20; i++) {
+            sink += hashAll(newObjects(100_000));
+        }
+
+        int count = scaled(5_000_000);
+        Object[] objects = newObjects(count);
+        long start = System.nanoTime();
+        sink += hashAll(objects);
+        report("hash.uncontended", (double) (System.nanoTime() - start) / count, "ns");
+
+        int numThreads = Math.max(4, Runtime.getRuntime().availableProcessors());
+        objects = newObjects(count);
+        long elapsed = hashConcurrently(objects, numThreads);
+        report("hash.racing", (double) count * numThreads / seconds(elapsed), "ops/s");
+
+        // Objects locked by another thread are biased towards it, unless
+        // biased locking is off or not yet enabled.
+        final Object[] locked = newObjects(scaled(1_000_000));
+        Thread locker = new Thread(() -> lockAll(locked), "locker");
+        locker.start();
+        locker.join();
+        start = System.nanoTime();
+        sink += hashAll(locked);
+        report("hash.locked", (double) (System.nanoTime() - start) / locked.length, "ns");
+    }
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+/**
+ * Cost of calls from compiled Java code into native code: StrictMath.sin
+ * is a plain JNI method in the class library, Thread.holdsLock also
+ * enters the VM.
+ */
+public class JniTransition extends Workload {
+
+    private static double sink;
+
+    private static double nativeCalls(int count) {
+        double sum = 0;
+        for (int i = 0; i < count; i++) {
+            sum += StrictMath.sin(i);
+        }
+        return sum;
+    }
+
+    private static int vmCalls(Object lock, int count) {
+        int held = 0;
+        for (int i = 0; i < count; i++) {
+            if (Thread.holdsLock(lock)) {
+                held++;
+            }
+        }
+        return held;
+    }
+
+    public static void main(String[] args) {
+        Object lock = new Object();
+        for (int i = 0; i < 20; i++) {
+            sink += nativeCalls(100_000) + vmCalls(lock, 100_000);
+        }
+
+        int count = scaled(20_000_000);
+        long start = System.nanoTime();
+        sink += nativeCalls(count);
+        report("jni.native_call", (double) (System.nanoTime() - start) / count, "ns");
+
+        start = System.nanoTime();
+        sink += vmCalls(lock, count);
+        report("jni.vm_entry", (double) (System.nanoTime() - start) / count, "ns");
+    }
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+import java.lang.reflect.Method;
+
+/**
+ * Cost of calls from native code into Java. Method.invoke goes through
+ * the native method accessor, a JNI call into the VM that calls the
+ * target through a JavaCallWrapper, as long as the suite's config sets
+ * sun.reflect.inflationThreshold high enough to keep it from generating
+ * bytecode instead.
+ */
+public class JniUpcall extends Workload {
+
+    private static int sink;
+
+    public static int target(int i) {
+        return i & 0xff;
+    }
+
+    private static int upcalls(Method m, int count) throws Exception {
+        int sum = 0;
+        for (int i = 0; i < count; i++) {
+            sum += (Integer) m.invoke(null, i);
+        }
+        return sum;
+    }
+
+    public static void main(String[] args) throws Exception {
+        Method m = JniUpcall.class.getMethod("target", int.class);
+        for (int i = 0; i < 20; i++) {
+            sink += upcalls(m, 100_000);
+        }
+
+        int count = scaled(5_000_000);
+        long start = System.nanoTime();
+        sink += upcalls(m, count);
+        report("jni.upcall", (double) (System.nanoTime() - start) / count, "ns");
+    }
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+/**
+ * Synchronized increments of a shared counter: by one thread, which
+ * measures uncontended locking, and by several threads at once, which
+ * measures monitor inflation, spinning and parking.
+ */
+public class MonitorContention extends Workload {
+
+    private static final Object lock = new Object();
+    private static long counter;
+
+    private static void increment(long count) {
+        for (long i = 0; i < count; i++) {
+            synchronized (lock) {
+                counter++;
+            }
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        increment(1_000_000);
+
+        long count = scaled(50_000_000L);
+        long start = System.nanoTime();
+        increment(count);
+        report("monitor.uncontended", (double) (System.nanoTime() - start) / count, "ns");
+
+        int numThreads = Math.max(4, Runtime.getRuntime().availableProcessors());
+        final long perThread = scaled(2_000_000L);
+        Thread[] threads = new Thread[numThreads];
+        for (int i = 0; i < numThreads; i++) {
+            threads[i] = new Thread(() -> increment(perThread), "contender-" + i);
+        }
+        start = System.nanoTime();
+        for (Thread t : threads) {
+            t.start();
+        }
+        for (Thread t : threads) {
+            t.join();
+        }
+        report("monitor.contended", perThread * numThreads / seconds(System.nanoTime() - start), "ops/s");
+    }
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+import java.io.File;
+import java.io.RandomAccessFile;
+import java.net.InetAddress;
+import java.net.InetSocketAddress;
+import java.nio.ByteBuffer;
+import java.nio.channels.FileChannel;
+import java.nio.channels.ServerSocketChannel;
+import java.nio.channels.SocketChannel;
+
+/**
+ * Throughput of NIO channels with direct buffers: a loopback socket and
+ * a file written and read back.
+ */
+public class NioThroughput extends Workload {
+
+    private static final int BUFFER_SIZE = 64 * 1024;
+    private static final double MB = 1024.0 * 1024.0;
+
+    private static double socket(final long bytes) throws Exception {
+        try (ServerSocketChannel server = ServerSocketChannel.open()) {
+            server.bind(new InetSocketAddress(InetAddress.getLoopbackAddress(), 0));
+            final SocketChannel client = SocketChannel.open(server.getLocalAddress());
+            Thread writer = new Thread(() -> {
+                try {
+                    ByteBuffer buffer = ByteBuffer.allocateDirect(BUFFER_SIZE);
+                    for (long written = 0; written < bytes; ) {
+                        buffer.clear();
+                        written += client.write(buffer);
+                    }
+                    client.close();
+                } catch (Exception e) {
+                    throw new RuntimeException(e);
+                }
+            });
+            long start = System.nanoTime();
+            writer.start();
+            long read = 0;
+            try (SocketChannel channel = server.accept()) {
+                ByteBuffer buffer = ByteBuffer.allocateDirect(BUFFER_SIZE);
+                int n;
+                while ((n = channel.read(buffer)) >= 0) {
+                    read += n;
+                    buffer.clear();
+                }
+            }
+            writer.join();
+            return read / MB / seconds(System.nanoTime() - start);
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        socket(64L * 1024 * 1024);
+        report("nio.socket", socket(scaled(2L * 1024 * 1024 * 1024)), "MB/s");
+
+        File file = File.createTempFile("perfsuite", ".dat");
+        file.deleteOnExit();
+        long bytes = scaled(512L * 1024 * 1024);
+        ByteBuffer buffer = ByteBuffer.allocateDirect(BUFFER_SIZE);
+        try (FileChannel channel = new RandomAccessFile(file, "rw").getChannel()) {
+            long start = System.nanoTime();
+            for (long written = 0; written < bytes; ) {
+                buffer.clear();
+                written += channel.write(buffer);
+            }
+            channel.force(false);
+            report("nio.file_write", bytes / MB / seconds(System.nanoTime() - start), "MB/s");
+
+            channel.position(0);
+            start = System.nanoTime();
+            long read = 0;
+            int n;
+            while ((n = channel.read(buffer)) >= 0) {
+                read += n;
+                buffer.clear();
+            }
+            report("nio.file_read", read / MB / seconds(System.nanoTime() - start), "MB/s");
+        }
+        file.delete();
+    }
+}
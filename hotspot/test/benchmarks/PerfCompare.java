@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+import java.io.File;
+import java.io.IOException;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.util.LinkedHashMap;
+import java.util.Map;
+
+/**
+ * Compares two results files of PerfSuite, for example of two builds, or
+ * of the same build on two ports.
+ *
+ *     java PerfCompare <baseline results> <results> [<threshold percent>]
+ *
+ * A metric regressed if it got worse by more than the threshold, 5% by
+ * default, and its whole range over the runs lies beyond the range of the
+ * baseline, so that noisy metrics are not reported. Exits with 1 if any
+ * metric regressed.
+ */
+public class PerfCompare {
+
+    private static class Result {
+        final double median;
+        final String unit;
+        final double min;
+        final double max;
+
+        Result(String[] words) {
+            median = Double.parseDouble(words[2]);
+            unit = words[3];
+            min = Double.parseDouble(words[4]);
+            max = Double.parseDouble(words[5]);
+        }
+    }
+
+    private static Map<String, Result> read(File file, Map<String, String> header) throws IOException {
+        Map<String, Result> results = new LinkedHashMap<>();
+        for (String line : Files.readAllLines(file.toPath(), StandardCharsets.UTF_8)) {
+            if (line.startsWith("# ")) {
+                String[] words = line.substring(2).split(" ", 2);
+                header.put(words[0], words.length > 1 ? words[1] : "");
+                continue;
+            }
+            String[] words = line.trim().split("\\s+");
+            if (words.length == 6) {
+                results.put(words[0] + " " + words[1], new Result(words));
+            }
+        }
+        return results;
+    }
+
+    private static boolean higherIsBetter(String unit) {
+        return unit.endsWith("/s");
+    }
+
+    public static void main(String[] args) throws Exception {
+        if (args.length < 2) {
+            System.err.println("Usage: PerfCompare <baseline results> <results> [<threshold percent>]");
+            System.exit(2);
+        }
+        double threshold = args.length > 2 ? Double.parseDouble(args[2]) : 5;
+        Map<String, String> baseHeader = new LinkedHashMap<>();
+        Map<String, String> newHeader = new LinkedHashMap<>();
+        Map<String, Result> base = read(new File(args[0]), baseHeader);
+        Map<String, Result> results = read(new File(args[1]), newHeader);
+
+        for (String key : new String[] { "vm", "platform", "processors", "vmoptions" }) {
+            String a = baseHeader.get(key);
+            String b = newHeader.get(key);
+            System.out.println(String.format("%-11s %s", key, a));
+            if (a != null && !a.equals(b)) {
+                System.out.println(String.format("%-11s %s (differs)", "", b));
+            }
+        }
+        if (baseHeader.containsKey("platform") && !baseHeader.get("platform").equals(newHeader.get("platform"))) {
+            System.out.println("Note: comparing across platforms, only relative changes are meaningful");
+        }
+        System.out.println();
+
+        int regressions = 0;
+        int improvements = 0;
+        for (Map.Entry<String, Result> e : results.entrySet()) {
+            Result b = base.get(e.getKey());
+            Result r = e.getValue();
+            if (b == null || !b.unit.equals(r.unit)) {
+                System.out.println(String.format("%-70s %12s %12.3f %-8s   new", e.getKey(), "", r.median, r.unit));
+                continue;
+            }
+            String verdict = "";
+            double change = b.median == 0 ? 0 : (r.median - b.median) * 100 / b.median;
+            if (!r.unit.equals("count")) {
+                boolean higherIsBetter = higherIsBetter(r.unit);
+                double worse = higherIsBetter ? -change : change;
+                boolean separated = higherIsBetter ? r.max < b.min : r.min > b.max;
+                boolean improvedSeparated = higherIsBetter ? r.min > b.max : r.max < b.min;
+                if (worse > threshold && separated) {
+                    verdict = "REGRESSION";
+                    regressions++;
+                } else if (-worse > threshold && improvedSeparated) {
+                    verdict = "improved";
+                    improvements++;
+                }
+            }
+            System.out.println(String.format("%-70s %12.3f %12.3f %-8s %+7.1f%% %s",
+                                             e.getKey(), b.median, r.median, r.unit, change, verdict));
+        }
+        for (String key : base.keySet()) {
+            if (!results.containsKey(key)) {
+                System.out.println(String.format("%-70s missing", key));
+            }
+        }
+        System.out.println();
+        System.out.println(regressions + " regressions, " + improvements + " improvements beyond " +
+                           threshold + "%");
+        System.exit(regressions > 0 ? 1 : 0);
+    }
+}
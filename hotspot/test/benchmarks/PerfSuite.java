@@ -0,0 +1,379 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+import java.io.BufferedReader;
+import java.io.File;
+import java.io.IOException;
+import java.io.InputStreamReader;
+import java.io.PrintWriter;
+import java.lang.reflect.Method;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.time.Duration;
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.Date;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Locale;
+import java.util.Map;
+import java.util.regex.Matcher;
+import java.util.regex.Pattern;
+
+/**
+ * Runs the workloads of the performance suite and collects their metrics
+ * into one results file, which PerfCompare compares with the results of
+ * another build or port.
+ *
+ *     java PerfSuite -suite <suite file> -output <dir>
+ *                    [-vmoptions "<flags>"] [-only <workload>] [-nojfr]
+ *
+ * The suite file has lines
+ *
+ *     iterations <n>
+ *     scale <factor>
+ *     config <name> <JVM flags>
+ *     run <workload> <config> ...
+ *
+ * Every workload runs in a new JVM, the one running PerfSuite, with the
+ * flags of each of its configs and the -vmoptions, the given number of
+ * times. Besides the metrics the workload reports itself, the metrics of
+ * each run include pause times by kind and safepoint stop times from its
+ * GC log and, if the JVM has the flight recorder, the count and duration
+ * of GC, safepoint, compilation and monitor events from its recording.
+ * The results file has the median, minimum and maximum over the runs of
+ * every metric.
+ */
+public class PerfSuite {
+
+    private static final String[] JFR_EVENTS = {
+        "jdk.GarbageCollection", "jdk.SafepointBegin", "jdk.Compilation", "jdk.JavaMonitorEnter"
+    };
+
+    private static final Pattern STOPPED =
+        Pattern.compile("Total time for which application threads were stopped: ([0-9.]+) seconds");
+    private static final Pattern PAUSE_SECS = Pattern.compile(", ([0-9.]+) secs\\]");
+
+    private int iterations = 3;
+    private String scale = "1";
+    private final Map<String, String> configs = new LinkedHashMap<>();
+    private final List<String[]> runs = new ArrayList<>();
+    private File output;
+    private String vmOptions = "";
+    private String only;
+    private boolean useJfr = true;
+    private boolean failed;
+
+    private static class Samples {
+        final String unit;
+        final List<Double> values = new ArrayList<>();
+
+        Samples(String unit) {
+            this.unit = unit;
+        }
+    }
+
+    private void readSuite(File file) throws IOException {
+        for (String line : Files.readAllLines(file.toPath(), StandardCharsets.UTF_8)) {
+            line = line.trim();
+            if (line.isEmpty() || line.startsWith("#")) {
+                continue;
+            }
+            String[] words = line.split("\\s+", 3);
+            switch (words[0]) {
+                case "iterations":
+                    iterations = Integer.parseInt(words[1]);
+                    break;
+                case "scale":
+                    scale = words[1];
+                    break;
+                case "config":
+                    configs.put(words[1], words.length > 2 ? words[2] : "");
+                    break;
+                case "run":
+                    runs.add(line.split("\\s+"));
+                    break;
+                default:
+                    throw new IllegalArgumentException("Bad suite line: " + line);
+            }
+        }
+    }
+
+    private static String java() {
+        return System.getProperty("java.home") + File.separator + "bin" + File.separator + "java";
+    }
+
+    private static List<String> split(String flags) {
+        List<String> result = new ArrayList<>();
+        for (String flag : flags.trim().split("\\s+")) {
+            if (!flag.isEmpty()) {
+                result.add(flag);
+            }
+        }
+        return result;
+    }
+
+    // Whether this JVM can make flight recordings and read them back
+    private boolean jfrAvailable() throws Exception {
+        try {
+            Class.forName("jdk.jfr.consumer.RecordingFile");
+        } catch (ClassNotFoundException e) {
+            return false;
+        }
+        File recording = new File(output, "probe.jfr");
+        Process p = new ProcessBuilder(java(), "-XX:StartFlightRecording=dumponexit=true,filename=" + recording, "-version")
+            .redirectErrorStream(true).redirectOutput(new File(output, "probe.log")).start();
+        return p.waitFor() == 0 && recording.exists();
+    }
+
+    private void runOnce(String workload, String config, int iteration,
+                         Map<String, Samples> metrics) throws Exception {
+        String prefix = workload + "." + config + "." + iteration;
+        File gcLog = new File(output, prefix + ".gc.log");
+        File recording = new File(output, prefix + ".jfr");
+        List<String> command = new ArrayList<>();
+        command.add(java());
+        command.addAll(split(configs.get(config)));
+        command.addAll(split(vmOptions));
+        command.add("-Xloggc:" + gcLog);
+        command.add("-XX:+PrintGCDetails");
+        command.add("-XX:+PrintGCApplicationStoppedTime");
+        if (useJfr) {
+            command.add("-XX:StartFlightRecording=settings=profile,dumponexit=true,filename=" + recording);
+        }
+        command.add("-Dperfsuite.scale=" + scale);
+        command.add("-cp");
+        command.add(System.getProperty("java.class.path"));
+        command.add(workload);
+
+        System.out.println("Running " + workload + " with " + config + ", iteration " + iteration);
+        Process p = new ProcessBuilder(command).redirectErrorStream(true).start();
+        try (BufferedReader in = new BufferedReader(new InputStreamReader(p.getInputStream()));
+             PrintWriter log = new PrintWriter(new File(output, prefix + ".log"))) {
+            String line;
+            while ((line = in.readLine()) != null) {
+                log.println(line);
+                String[] words = line.split(" ");
+                if (words.length == 4 && words[0].equals("metric")) {
+                    add(metrics, words[1], Double.parseDouble(words[2]), words[3]);
+                }
+            }
+        }
+        int exitCode = p.waitFor();
+        if (exitCode != 0) {
+            System.out.println("FAILED: " + workload + " with " + config + " exited with " + exitCode);
+            failed = true;
+            return;
+        }
+        addGcLogMetrics(gcLog, metrics);
+        if (useJfr) {
+            addJfrMetrics(recording, metrics);
+        }
+    }
+
+    private static void add(Map<String, Samples> metrics, String name, double value, String unit) {
+        Samples samples = metrics.get(name);
+        if (samples == null) {
+            samples = new Samples(unit);
+            metrics.put(name, samples);
+        }
+        samples.values.add(value);
+    }
+
+    private static void addSummary(Map<String, Samples> metrics, String name, List<Double> millis) {
+        add(metrics, name + ".count", millis.size(), "count");
+        if (millis.isEmpty()) {
+            return;
+        }
+        Collections.sort(millis);
+        double total = 0;
+        for (double ms : millis) {
+            total += ms;
+        }
+        add(metrics, name + ".total", total, "ms");
+        add(metrics, name + ".p50", millis.get(millis.size() / 2), "ms");
+        add(metrics, name + ".p99", millis.get((millis.size() - 1) * 99 / 100), "ms");
+        add(metrics, name + ".max", millis.get(millis.size() - 1), "ms");
+    }
+
+    // The kind of collection a GC log line with PrintGCDetails is about,
+    // or null if it is not about a pause
+    private static String pauseKind(String line) {
+        if (line.contains("[Full GC")) {
+            return "full";
+        }
+        if (!line.contains("[GC")) {
+            return null;
+        }
+        if (line.contains("(mixed)")) {
+            return "mixed";
+        }
+        if (line.contains("Initial Mark") || line.contains("Remark") || line.contains("[GC remark") ||
+            line.contains("[GC cleanup")) {
+            return "remark";
+        }
+        return "young";
+    }
+
+    private static void addGcLogMetrics(File gcLog, Map<String, Samples> metrics) throws IOException {
+        Map<String, List<Double>> pauses = new LinkedHashMap<>();
+        for (String kind : new String[] { "young", "mixed", "remark", "full" }) {
+            pauses.put(kind, new ArrayList<Double>());
+        }
+        List<Double> stopped = new ArrayList<>();
+        for (String line : Files.readAllLines(gcLog.toPath(), StandardCharsets.UTF_8)) {
+            Matcher m = STOPPED.matcher(line);
+            if (m.find()) {
+                stopped.add(Double.parseDouble(m.group(1)) * 1000);
+                continue;
+            }
+            String kind = pauseKind(line);
+            if (kind == null) {
+                continue;
+            }
+            // The pause time of the whole collection is the last one on the line
+            m = PAUSE_SECS.matcher(line);
+            String secs = null;
+            while (m.find()) {
+                secs = m.group(1);
+            }
+            if (secs != null) {
+                pauses.get(kind).add(Double.parseDouble(secs) * 1000);
+            }
+        }
+        for (Map.Entry<String, List<Double>> e : pauses.entrySet()) {
+            addSummary(metrics, "gclog.pause." + e.getKey(), e.getValue());
+        }
+        addSummary(metrics, "gclog.safepoint_stopped", stopped);
+    }
+
+    // Uses reflection so that the suite builds for JVMs without the
+    // flight recorder as well
+    private static void addJfrMetrics(File recording, Map<String, Samples> metrics) throws Exception {
+        Class<?> recordingFile = Class.forName("jdk.jfr.consumer.RecordingFile");
+        Method readAllEvents = recordingFile.getMethod("readAllEvents", Path.class);
+        Map<String, List<Double>> durations = new LinkedHashMap<>();
+        for (String name : JFR_EVENTS) {
+            durations.put(name, new ArrayList<Double>());
+        }
+        for (Object event : (List<?>) readAllEvents.invoke(null, recording.toPath())) {
+            Class<?> eventClass = Class.forName("jdk.jfr.consumer.RecordedEvent");
+            Object type = eventClass.getMethod("getEventType").invoke(event);
+            String name = (String) type.getClass().getMethod("getName").invoke(type);
+            List<Double> list = durations.get(name);
+            if (list == null) {
+                continue;
+            }
+            Duration duration = (Duration) eventClass.getMethod("getDuration").invoke(event);
+            double ms = duration.toNanos() / 1e6;
+            list.add(ms);
+            if (name.equals("jdk.GarbageCollection")) {
+                // Pauses by collector, e.g. G1New or ParallelOld
+                String collector = (String) eventClass.getMethod("getString", String.class).invoke(event, "name");
+                String key = "jdk.GarbageCollection." + collector;
+                if (!durations.containsKey(key)) {
+                    durations.put(key, new ArrayList<Double>());
+                }
+                durations.get(key).add(ms);
+            }
+        }
+        for (Map.Entry<String, List<Double>> e : durations.entrySet()) {
+            addSummary(metrics, "jfr." + e.getKey().substring("jdk.".length()), e.getValue());
+        }
+    }
+
+    private void run(PrintWriter results) throws Exception {
+        for (String[] run : runs) {
+            String workload = run[1];
+            if (only != null && !only.equals(workload)) {
+                continue;
+            }
+            for (int i = 2; i < run.length; i++) {
+                String config = run[i];
+                if (!configs.containsKey(config)) {
+                    throw new IllegalArgumentException("Unknown config " + config + " for " + workload);
+                }
+                Map<String, Samples> metrics = new LinkedHashMap<>();
+                for (int iteration = 0; iteration < iterations; iteration++) {
+                    runOnce(workload, config, iteration, metrics);
+                }
+                for (Map.Entry<String, Samples> e : metrics.entrySet()) {
+                    List<Double> values = e.getValue().values;
+                    Collections.sort(values);
+                    results.println(String.format(Locale.ROOT, "%s.%s %s %.3f %s %.3f %.3f",
+                                                  workload, config, e.getKey(),
+                                                  values.get(values.size() / 2), e.getValue().unit,
+                                                  values.get(0), values.get(values.size() - 1)));
+                }
+                results.flush();
+            }
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        PerfSuite suite = new PerfSuite();
+        File suiteFile = null;
+        for (int i = 0; i < args.length; i++) {
+            switch (args[i]) {
+                case "-suite":     suiteFile = new File(args[++i]); break;
+                case "-output":    suite.output = new File(args[++i]); break;
+                case "-vmoptions": suite.vmOptions = args[++i]; break;
+                case "-only":      suite.only = args[++i]; break;
+                case "-nojfr":     suite.useJfr = false; break;
+                default:
+                    throw new IllegalArgumentException("Unknown option " + args[i]);
+            }
+        }
+        if (suiteFile == null || suite.output == null) {
+            System.err.println("Usage: PerfSuite -suite <file> -output <dir> " +
+                               "[-vmoptions \"<flags>\"] [-only <workload>] [-nojfr]");
+            System.exit(2);
+        }
+        suite.readSuite(suiteFile);
+        suite.output.mkdirs();
+        if (suite.useJfr && !suite.jfrAvailable()) {
+            System.out.println("No flight recorder, running without JFR metrics");
+            suite.useJfr = false;
+        }
+
+        File resultsFile = new File(suite.output, "results.txt");
+        try (PrintWriter results = new PrintWriter(resultsFile, "UTF-8")) {
+            results.println("# perfsuite results " + new Date());
+            results.println("# vm " + System.getProperty("java.vm.name") + " " +
+                            System.getProperty("java.vm.version"));
+            results.println("# platform " + System.getProperty("os.name") + " " +
+                            System.getProperty("os.arch"));
+            results.println("# processors " + Runtime.getRuntime().availableProcessors());
+            results.println("# vmoptions " + suite.vmOptions);
+            results.println("# <workload>.<config> <metric> <median> <unit> <min> <max>");
+            suite.run(results);
+        }
+        System.out.println("Results in " + resultsFile);
+        if (suite.failed) {
+            System.exit(1);
+        }
+    }
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+/**
+ * Time to bring all threads to a safepoint and back while other threads
+ * run compiled loops and allocate. Each sample is a thread dump, which is
+ * a safepoint operation; the GC log metrics of the run give the time the
+ * threads were actually stopped.
+ */
+public class SafepointLatency extends Workload {
+
+    private static volatile boolean done;
+    private static volatile long sink;
+
+    private static void spin() {
+        while (!done) {
+            long x = 0;
+            for (int i = 0; i < 1_000_000; i++) {
+                x += i ^ (x >>> 3);
+            }
+            sink = x;
+            Object[] garbage = new Object[16];
+            sink += garbage.length;
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        int numThreads = Math.max(2, Runtime.getRuntime().availableProcessors() / 2);
+        Thread[] threads = new Thread[numThreads];
+        for (int i = 0; i < numThreads; i++) {
+            threads[i] = new Thread(SafepointLatency::spin, "spinner-" + i);
+            threads[i].setDaemon(true);
+            threads[i].start();
+        }
+
+        for (int i = 0; i < 200; i++) {
+            Thread.getAllStackTraces();
+        }
+        long[] samples = new long[scaled(2000)];
+        for (int i = 0; i < samples.length; i++) {
+            long start = System.nanoTime();
+            Thread.getAllStackTraces();
+            samples[i] = System.nanoTime() - start;
+            Thread.sleep(1);
+        }
+        done = true;
+        for (Thread t : threads) {
+            t.join();
+        }
+        reportLatencies("safepoint.thread_dump", samples);
+    }
+}
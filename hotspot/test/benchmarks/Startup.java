@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+import java.io.File;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
+
+/**
+ * Time for a JVM to start, run an empty main method and exit, with the
+ * shared class data archive in its default setting and with it turned
+ * off. Only the JVM started by this workload is timed, and it does not
+ * get the flags this one was started with.
+ */
+public class Startup extends Workload {
+
+    public static class Hello {
+        public static void main(String[] args) {
+        }
+    }
+
+    private static double medianStartup(String share, int runs) throws Exception {
+        String java = System.getProperty("java.home") + File.separator + "bin" + File.separator + "java";
+        List<String> command = new ArrayList<>();
+        command.add(java);
+        command.add(share);
+        command.add("-cp");
+        command.add(System.getProperty("java.class.path"));
+        command.add(Hello.class.getName());
+        long[] samples = new long[runs];
+        for (int i = 0; i < runs; i++) {
+            long start = System.nanoTime();
+            Process p = new ProcessBuilder(command).inheritIO().start();
+            if (p.waitFor() != 0) {
+                throw new RuntimeException("JVM failed to start with " + share);
+            }
+            samples[i] = System.nanoTime() - start;
+        }
+        Arrays.sort(samples);
+        return samples[runs / 2] / 1e6;
+    }
+
+    public static void main(String[] args) throws Exception {
+        int runs = scaled(20);
+        report("startup.cds_auto", medianStartup("-Xshare:auto", runs), "ms");
+        report("startup.cds_off", medianStartup("-Xshare:off", runs), "ms");
+    }
+}
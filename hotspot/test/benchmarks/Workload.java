@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+import java.io.ByteArrayOutputStream;
+import java.io.IOException;
+import java.io.InputStream;
+import java.util.Arrays;
+import java.util.Locale;
+
+/**
+ * Base class of the workloads of the performance suite. Each workload
+ * runs in a JVM of its own started by PerfSuite, and reports its metrics
+ * on standard output as lines of the form
+ *
+ *     metric <name> <value> <unit>
+ *
+ * Metrics with a unit ending in "/s" are better when higher, those in
+ * "count" are informational, and all others are better when lower.
+ *
+ * Workloads are deterministic given the same JVM flags: random numbers
+ * come from a fixed seed, and the amount of work only depends on the
+ * perfsuite.scale system property.
+ */
+public abstract class Workload {
+
+    protected static final long SEED = 42;
+
+    private static final double SCALE =
+        Double.parseDouble(System.getProperty("perfsuite.scale", "1"));
+
+    protected static int scaled(int n) {
+        return (int) Math.max(1, Math.round(n * SCALE));
+    }
+
+    protected static long scaled(long n) {
+        return Math.max(1, Math.round(n * SCALE));
+    }
+
+    protected static void report(String name, double value, String unit) {
+        System.out.println(String.format(Locale.ROOT, "metric %s %.3f %s", name, value, unit));
+    }
+
+    // Reports the median, 99th percentile and maximum of the samples,
+    // which are in nanoseconds, in microseconds.
+    protected static void reportLatencies(String name, long[] samples) {
+        long[] sorted = samples.clone();
+        Arrays.sort(sorted);
+        report(name + ".p50", sorted[sorted.length / 2] / 1000.0, "us");
+        report(name + ".p99", sorted[(int) ((sorted.length - 1) * 99L / 100)] / 1000.0, "us");
+        report(name + ".max", sorted[sorted.length - 1] / 1000.0, "us");
+    }
+
+    protected static double seconds(long nanos) {
+        return nanos / 1e9;
+    }
+
+    protected static byte[] classBytes(Class<?> c) throws IOException {
+        String resource = c.getName().replace('.', '/') + ".class";
+        try (InputStream in = c.getClassLoader().getResourceAsStream(resource)) {
+            ByteArrayOutputStream out = new ByteArrayOutputStream();
+            byte[] buffer = new byte[8192];
+            int n;
+            while ((n = in.read(buffer)) > 0) {
+                out.write(buffer, 0, n);
+            }
+            return out.toByteArray();
+        }
+    }
+
+    /**
+     * Defines its own copy of one class from the given bytes, so that
+     * every loader gives a distinct class to load, link and compile.
+     */
+    protected static class IsolatingLoader extends ClassLoader {
+        private final String name;
+        private final byte[] bytes;
+
+        IsolatingLoader(String name, byte[] bytes) {
+            super(IsolatingLoader.class.getClassLoader());
+            this.name = name;
+            this.bytes = bytes;
+        }
+
+        @Override
+        protected Class<?> loadClass(String n, boolean resolve) throws ClassNotFoundException {
+            if (!n.equals(name)) {
+                return super.loadClass(n, resolve);
+            }
+            synchronized (getClassLoadingLock(n)) {
+                Class<?> c = findLoadedClass(n);
+                if (c == null) {
+                    c = defineClass(n, bytes, 0, bytes.length);
+                }
+                return c;
+            }
+        }
+    }
+}
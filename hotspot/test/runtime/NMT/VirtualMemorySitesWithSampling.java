@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary Virtual memory regions keep their call sites when NMT detail
+ *          samples malloc stacks
+ * @library /testlibrary
+ * @run main/othervm -XX:NativeMemoryTracking=detail -XX:NMTDetailSampleInterval=1000000 VirtualMemorySitesWithSampling
+ */
+
+import com.oracle.java.testlibrary.*;
+
+public class VirtualMemorySitesWithSampling {
+
+    public static void main(String args[]) throws Exception {
+        String pid = Integer.toString(ProcessTools.getProcessId());
+        ProcessBuilder pb = new ProcessBuilder();
+        pb.command(new String[] { JDKToolFinder.getJDKTool("jcmd"), pid, "VM.native_memory", "detail"});
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        output.shouldHaveExitValue(0);
+        output.shouldContain("Malloc sites are sampled every 1000000 mallocs");
+
+        // Reservations are recorded with their stacks regardless of the
+        // malloc sampling: the Java heap, the thread stacks and, with
+        // UsePerfData, the perf memory mapped by the platform code.
+        output.shouldMatch("[0-9]+KB for Java Heap from\\s+\\[0x\\p{XDigit}+\\]");
+        output.shouldMatch("for Thread Stack from\\s+\\[0x\\p{XDigit}+\\]");
+        output.shouldMatch("reserved and committed [0-9]+KB for Internal from\\s+\\[0x\\p{XDigit}+\\]");
+    }
+}
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary Check the results of calls into leaf, critical and array
+ *          critical natives, and of upcalls from native code with and
+ *          without live local handles, with and without LazyJNIHandleBlocks
+ * @run main/othervm/native -XX:+CriticalJNINatives -XX:+LazyJNIHandleBlocks TestCallPaths
+ * @run main/othervm/native -XX:+CriticalJNINatives -XX:-LazyJNIHandleBlocks TestCallPaths
+ */
+
+public class TestCallPaths {
+    static {
+        System.loadLibrary("TestCallPaths");
+    }
+
+    static native int mix(int a, int b);
+    static native int criticalMix(int a, int b);
+    static native int criticalSum(int[] array);
+    static native int upcalls(int count);
+    static native int upcallsWithLocal(Object obj, int count);
+    static native int upcallsReturningObjects(int count);
+    static native int upcallsLeakingFrames(Object obj, int count);
+    static native int upcallsThrowing(int count);
+    static native int leakFrame(int i);
+
+    static final int CALLS = 200000;
+    static final int UPCALLS = 50000;
+    static final int GC_INTERVAL = 10000;
+
+    static volatile Object sink;
+
+    // Allocates, and collects now and then, so that the handles of the
+    // calling native have to be found and updated by the GC.
+    static int callback(int i) {
+        sink = new int[16];
+        if (i % GC_INTERVAL == 0) {
+            System.gc();
+        }
+        return i & 0xff;
+    }
+
+    static Integer boxed(int i) {
+        callback(i);
+        return new Integer(i);
+    }
+
+    static int leakingCallback(int i) {
+        callback(i);
+        return leakFrame(i);
+    }
+
+    static int throwingCallback(int i) {
+        callback(i);
+        if (i % 7 == 0) {
+            throw new IllegalStateException("thrown for " + i);
+        }
+        return i;
+    }
+
+    static int expected(int a, int b) {
+        return (a * 31) ^ b;
+    }
+
+    static void check(String what, int actual, int expected) {
+        if (actual != expected) {
+            throw new RuntimeException(what + " returned " + actual + ", expected " + expected);
+        }
+    }
+
+    static void testDownCalls() {
+        int acc = 0;
+        for (int i = 0; i < CALLS; i++) {
+            int r = mix(i, acc);
+            check("mix(" + i + ")", r, expected(i, acc));
+            acc = r;
+        }
+        acc = 0;
+        for (int i = 0; i < CALLS; i++) {
+            int r = criticalMix(i, acc);
+            check("criticalMix(" + i + ")", r, expected(i, acc));
+            acc = r;
+        }
+    }
+
+    // The arrays are pinned while other threads allocate and collect.
+    static void testArrayCriticalCalls() throws InterruptedException {
+        Thread allocator = new Thread() {
+            public void run() {
+                for (int i = 0; i < UPCALLS; i++) {
+                    callback(i + 1);
+                }
+            }
+        };
+        allocator.start();
+        int[] array = new int[1024];
+        int sum = 0;
+        for (int i = 0; i < CALLS / 10; i++) {
+            array[i % array.length] += i;
+            sum += i;
+            check("criticalSum", criticalSum(array), sum);
+        }
+        allocator.join();
+    }
+
+    static void testUpcalls() {
+        int sum = 0;
+        for (int i = 0; i < UPCALLS; i++) {
+            sum += i & 0xff;
+        }
+        check("upcalls", upcalls(UPCALLS), sum);
+        check("upcallsWithLocal", upcallsWithLocal(new Object(), UPCALLS), sum);
+        check("upcallsLeakingFrames", upcallsLeakingFrames(new Object(), UPCALLS), sum);
+
+        int boxedSum = 0;
+        for (int i = 0; i < UPCALLS; i++) {
+            boxedSum += i;
+        }
+        check("upcallsReturningObjects", upcallsReturningObjects(UPCALLS), boxedSum);
+        check("upcallsThrowing", upcallsThrowing(UPCALLS), (UPCALLS + 6) / 7);
+    }
+
+    public static void main(String[] args) throws Exception {
+        testDownCalls();
+        testArrayCriticalCalls();
+        testUpcalls();
+    }
+}
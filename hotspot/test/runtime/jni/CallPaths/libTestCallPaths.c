@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include <jni.h>
+
+/*
+ * Leaf native: no oop arguments, does only a few cycles of work.
+ */
+JNIEXPORT jint JNICALL
+Java_TestCallPaths_mix(JNIEnv *env, jclass clazz, jint a, jint b) {
+  return (a * 31) ^ b;
+}
+
+/*
+ * The same function as a critical native without array arguments, which
+ * is called as a leaf without the GC locker.
+ */
+JNIEXPORT jint JNICALL
+JavaCritical_TestCallPaths_criticalMix(jint a, jint b) {
+  return (a * 31) ^ b;
+}
+
+JNIEXPORT jint JNICALL
+Java_TestCallPaths_criticalMix(JNIEnv *env, jclass clazz, jint a, jint b) {
+  /* Only reached if the critical entry was not used. */
+  return (a * 31) ^ b;
+}
+
+/*
+ * A critical native with an array argument, which still pins the array.
+ */
+JNIEXPORT jint JNICALL
+JavaCritical_TestCallPaths_criticalSum(jint length, jint* elems) {
+  jint sum = 0;
+  jint i;
+  for (i = 0; i < length; i++) {
+    sum += elems[i];
+  }
+  return sum;
+}
+
+JNIEXPORT jint JNICALL
+Java_TestCallPaths_criticalSum(JNIEnv *env, jclass clazz, jintArray array) {
+  jint length = (*env)->GetArrayLength(env, array);
+  jint* elems = (jint*)(*env)->GetPrimitiveArrayCritical(env, array, NULL);
+  jint sum = JavaCritical_TestCallPaths_criticalSum(length, elems);
+  (*env)->ReleasePrimitiveArrayCritical(env, array, elems, JNI_ABORT);
+  return sum;
+}
+
+/*
+ * Calls the static int(int) method name count times and returns the sum
+ * of the results, or -1 if an upcall threw.
+ */
+static jint call_back(JNIEnv *env, jclass clazz, const char* name, jint count) {
+  jmethodID mid = (*env)->GetStaticMethodID(env, clazz, name, "(I)I");
+  jint sum = 0;
+  jint i;
+  if (mid == NULL) {
+    return -1;
+  }
+  for (i = 0; i < count; i++) {
+    sum += (*env)->CallStaticIntMethod(env, clazz, mid, i);
+    if ((*env)->ExceptionCheck(env)) {
+      return -1;
+    }
+  }
+  return sum;
+}
+
+/*
+ * Upcalls while this native has no local handles, so that each one can
+ * run on this native's handle block.
+ */
+JNIEXPORT jint JNICALL
+Java_TestCallPaths_upcalls(JNIEnv *env, jclass clazz, jint count) {
+  return call_back(env, clazz, "callback", count);
+}
+
+/*
+ * Upcalls while a local reference is live. Returns -2 if the reference
+ * no longer refers to obj afterwards.
+ */
+JNIEXPORT jint JNICALL
+Java_TestCallPaths_upcallsWithLocal(JNIEnv *env, jclass clazz, jobject obj, jint count) {
+  jobject local = (*env)->NewLocalRef(env, obj);
+  jint sum = call_back(env, clazz, "callback", count);
+  if (!(*env)->IsSameObject(env, local, obj)) {
+    return -2;
+  }
+  return sum;
+}
+
+/*
+ * Upcalls returning objects, which become local references of this
+ * native after each upcall. The first one is kept; returns the sum of
+ * the values, or -2 if the first one changed.
+ */
+JNIEXPORT jint JNICALL
+Java_TestCallPaths_upcallsReturningObjects(JNIEnv *env, jclass clazz, jint count) {
+  jmethodID boxed = (*env)->GetStaticMethodID(env, clazz, "boxed", "(I)Ljava/lang/Integer;");
+  jclass integer = (*env)->FindClass(env, "java/lang/Integer");
+  jmethodID int_value = (integer == NULL) ? NULL : (*env)->GetMethodID(env, integer, "intValue", "()I");
+  jobject first = NULL;
+  jint sum = 0;
+  jint i;
+  if (boxed == NULL || int_value == NULL) {
+    return -1;
+  }
+  for (i = 0; i < count; i++) {
+    jobject o = (*env)->CallStaticObjectMethod(env, clazz, boxed, i);
+    if ((*env)->ExceptionCheck(env)) {
+      return -1;
+    }
+    sum += (*env)->CallIntMethod(env, o, int_value);
+    if (first == NULL) {
+      first = o;
+    } else {
+      (*env)->DeleteLocalRef(env, o);
+    }
+  }
+  if (first != NULL && (*env)->CallIntMethod(env, first, int_value) != 0) {
+    return -2;
+  }
+  return sum;
+}
+
+/*
+ * Pushes a local frame and returns without popping it.
+ */
+JNIEXPORT jint JNICALL
+Java_TestCallPaths_leakFrame(JNIEnv *env, jclass clazz, jint i) {
+  if ((*env)->PushLocalFrame(env, 4) != 0) {
+    return -1;
+  }
+  (*env)->NewLocalRef(env, clazz);
+  return i & 0xff;
+}
+
+/*
+ * Upcalls into Java code that leaves local frames pushed, while a local
+ * reference of this native is live. Returns -2 if the reference no longer
+ * refers to obj afterwards.
+ */
+JNIEXPORT jint JNICALL
+Java_TestCallPaths_upcallsLeakingFrames(JNIEnv *env, jclass clazz, jobject obj, jint count) {
+  jobject local = (*env)->NewLocalRef(env, obj);
+  jint sum = call_back(env, clazz, "leakingCallback", count);
+  if (!(*env)->IsSameObject(env, local, obj)) {
+    return -2;
+  }
+  return sum;
+}
+
+/*
+ * Upcalls of which some throw. Returns the number of exceptions seen.
+ */
+JNIEXPORT jint JNICALL
+Java_TestCallPaths_upcallsThrowing(JNIEnv *env, jclass clazz, jint count) {
+  jmethodID mid = (*env)->GetStaticMethodID(env, clazz, "throwingCallback", "(I)I");
+  jint thrown = 0;
+  jint i;
+  if (mid == NULL) {
+    return -1;
+  }
+  for (i = 0; i < count; i++) {
+    (*env)->CallStaticIntMethod(env, clazz, mid, i);
+    if ((*env)->ExceptionCheck(env)) {
+      (*env)->ExceptionClear(env);
+      thrown++;
+    }
+  }
+  return thrown;
+}
@@ -122,6 +122,20 @@ enum {
 
 #define JMM_THREAD_STATE_FLAG_MASK  0xFFF00000
 
+/* Per-thread fields filled in by GetThreadResourceUsage, in this order.  */
+/* Times are in nanoseconds, -1 if not measured or the thread is gone.   */
+typedef enum {
+  JMM_THREAD_USAGE_CPU_TIME          = 0,  /* user and system CPU time */
+  JMM_THREAD_USAGE_USER_TIME         = 1,  /* user CPU time */
+  JMM_THREAD_USAGE_ALLOCATED_BYTES   = 2,  /* bytes allocated in the Java heap */
+  JMM_THREAD_USAGE_BLOCKED_COUNT     = 3,  /* contended monitor enters */
+  JMM_THREAD_USAGE_BLOCKED_TIME      = 4,  /* time blocked on monitor enter, if contention monitoring is enabled */
+  JMM_THREAD_USAGE_WAITED_COUNT      = 5,  /* Object.wait and Thread.sleep calls */
+  JMM_THREAD_USAGE_WAITED_TIME       = 6,  /* time waited, if contention monitoring is enabled */
+  JMM_THREAD_USAGE_SAFEPOINT_TIME    = 7,  /* time blocked for safepoints */
+  JMM_THREAD_USAGE_FIELDS            = 8
+} jmmThreadUsageField;
+
 typedef enum {
   JMM_STAT_PEAK_THREAD_COUNT         = 801,
   JMM_STAT_THREAD_CONTENTION_COUNT   = 802,
@@ -218,7 +232,10 @@ typedef struct {
 } dcmdArgInfo;
 
 typedef struct jmmInterface_1_ {
-  void*        reserved1;
+  void         (JNICALL *GetThreadResourceUsage)
+                                                 (JNIEnv *env,
+                                                  jlongArray ids,
+                                                  jlongArray usage);
   jlong        (JNICALL *GetOneThreadAllocatedMemory)
                                                  (JNIEnv *env,
                                                   jlong thread_id);
@@ -77,6 +77,7 @@ readBytes(JNIEnv *env, jobject this, jbyteArray bytes,
     jint nread;
     char stackBuf[BUF_SIZE];
     char *buf = NULL;
+    char *heapBuf = NULL;
     FD fd;
 
     if (IS_NULL(bytes)) {
@@ -92,10 +93,14 @@ readBytes(JNIEnv *env, jobject this, jbyteArray bytes,
     if (len == 0) {
         return 0;
     } else if (len > BUF_SIZE) {
-        buf = malloc(len);
+        buf = getThreadBuffer(len);
         if (buf == NULL) {
-            JNU_ThrowOutOfMemoryError(env, NULL);
-            return 0;
+            buf = malloc(len);
+            if (buf == NULL) {
+                JNU_ThrowOutOfMemoryError(env, NULL);
+                return 0;
+            }
+            heapBuf = buf;
         }
     } else {
         buf = stackBuf;
@@ -116,8 +121,8 @@ readBytes(JNIEnv *env, jobject this, jbyteArray bytes,
         }
     }
 
-    if (buf != stackBuf) {
-        free(buf);
+    if (heapBuf != NULL) {
+        free(heapBuf);
     }
     return nread;
 }
@@ -149,6 +154,7 @@ writeBytes(JNIEnv *env, jobject this, jbyteArray bytes,
     jint n;
     char stackBuf[BUF_SIZE];
     char *buf = NULL;
+    char *heapBuf = NULL;
     FD fd;
 
     if (IS_NULL(bytes)) {
@@ -164,10 +170,14 @@ writeBytes(JNIEnv *env, jobject this, jbyteArray bytes,
     if (len == 0) {
         return;
     } else if (len > BUF_SIZE) {
-        buf = malloc(len);
+        buf = getThreadBuffer(len);
         if (buf == NULL) {
-            JNU_ThrowOutOfMemoryError(env, NULL);
-            return;
+            buf = malloc(len);
+            if (buf == NULL) {
+                JNU_ThrowOutOfMemoryError(env, NULL);
+                return;
+            }
+            heapBuf = buf;
         }
     } else {
         buf = stackBuf;
@@ -196,8 +206,8 @@ writeBytes(JNIEnv *env, jobject this, jbyteArray bytes,
             len -= n;
         }
     }
-    if (buf != stackBuf) {
-        free(buf);
+    if (heapBuf != NULL) {
+        free(heapBuf);
     }
 }
 
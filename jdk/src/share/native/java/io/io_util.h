@@ -56,6 +56,20 @@ void fileOpen(JNIEnv *env, jobject this, jstring path, jfieldID fid, int flags);
 void throwFileNotFoundException(JNIEnv *env, jstring path);
 size_t getLastErrorString(char *buf, size_t len);
 
+/*
+ * The largest buffer kept per thread by getThreadBuffer.
+ */
+#define THREAD_BUFFER_MAX (256 * 1024)
+
+/*
+ * Returns a native buffer of at least len bytes that belongs to the
+ * calling thread and is reused by its later calls, so that large reads
+ * and writes do not malloc and free on every call. Returns NULL if len
+ * is larger than THREAD_BUFFER_MAX or memory is short; the caller then
+ * allocates its own. The buffer is freed when the thread exits.
+ */
+char* getThreadBuffer(size_t len);
+
 /*
  * Macros for managing platform strings.  The typical usage pattern is:
  *
@@ -32,6 +32,8 @@
 #include "jlong.h"
 #include <zlib.h>
 
+#include "zip_checksum.h"
+
 #include "java_util_zip_Adler32.h"
 
 JNIEXPORT jint JNICALL
@@ -40,7 +42,7 @@ Java_java_util_zip_Adler32_update(JNIEnv *env, jclass cls, jint adler, jint b)
     Bytef buf[1];
 
     buf[0] = (Bytef)b;
-    return adler32(adler, buf, 1);
+    return ZIP_adler32_update(adler, buf, 1);
 }
 
 JNIEXPORT jint JNICALL
@@ -49,7 +51,7 @@ Java_java_util_zip_Adler32_updateBytes(JNIEnv *env, jclass cls, jint adler,
 {
     Bytef *buf = (*env)->GetPrimitiveArrayCritical(env, b, 0);
     if (buf) {
-        adler = adler32(adler, buf + off, len);
+        adler = ZIP_adler32_update(adler, buf + off, len);
         (*env)->ReleasePrimitiveArrayCritical(env, b, buf, 0);
     }
     return adler;
@@ -62,7 +64,7 @@ Java_java_util_zip_Adler32_updateByteBuffer(JNIEnv *env, jclass cls, jint adler,
 {
     Bytef *buf = (Bytef *)jlong_to_ptr(address);
     if (buf) {
-        adler = adler32(adler, buf + off, len);
+        adler = ZIP_adler32_update(adler, buf + off, len);
     }
     return adler;
 }
@@ -31,6 +31,8 @@
 #include "jni_util.h"
 #include <zlib.h>
 
+#include "zip_checksum.h"
+
 #include "java_util_zip_CRC32.h"
 
 JNIEXPORT jint JNICALL
@@ -39,7 +41,7 @@ Java_java_util_zip_CRC32_update(JNIEnv *env, jclass cls, jint crc, jint b)
     Bytef buf[1];
 
     buf[0] = (Bytef)b;
-    return crc32(crc, buf, 1);
+    return ZIP_crc32_update(crc, buf, 1);
 }
 
 JNIEXPORT jint JNICALL
@@ -48,7 +50,7 @@ Java_java_util_zip_CRC32_updateBytes(JNIEnv *env, jclass cls, jint crc,
 {
     Bytef *buf = (*env)->GetPrimitiveArrayCritical(env, b, 0);
     if (buf) {
-        crc = crc32(crc, buf + off, len);
+        crc = ZIP_crc32_update(crc, buf + off, len);
         (*env)->ReleasePrimitiveArrayCritical(env, b, buf, 0);
     }
     return crc;
@@ -57,7 +59,7 @@ Java_java_util_zip_CRC32_updateBytes(JNIEnv *env, jclass cls, jint crc,
 JNIEXPORT jint JNICALL
 ZIP_CRC32(jint crc, const jbyte *buf, jint len)
 {
-    return crc32(crc, (Bytef*)buf, len);
+    return ZIP_crc32_update(crc, (Bytef*)buf, len);
 }
 
 JNIEXPORT jint JNICALL
@@ -66,7 +68,7 @@ Java_java_util_zip_CRC32_updateByteBuffer(JNIEnv *env, jclass cls, jint crc,
 {
     Bytef *buf = (Bytef *)jlong_to_ptr(address);
     if (buf) {
-        crc = crc32(crc, buf + off, len);
+        crc = ZIP_crc32_update(crc, buf + off, len);
     }
     return crc;
 }
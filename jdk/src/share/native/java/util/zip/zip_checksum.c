@@ -0,0 +1,435 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * Accelerated CRC-32 and Adler-32 checksums for java.util.zip.
+ *
+ * The CRC-32 kernels fold the input with carry-less multiplication
+ * (PCLMULQDQ) or use the AArch64 CRC32 instructions; the Adler-32
+ * kernels keep per-lane byte sums and weighted sums in vector registers
+ * and reduce modulo 65521 once every NMAX bytes. Inputs too short for a
+ * kernel, and the tail left after one, are handed to zlib.
+ */
+
+#include <stdint.h>
+
+#include "zip_checksum.h"
+
+#define BASE 65521U     /* largest prime smaller than 65536 */
+#define NMAX 5552       /* bytes that can be summed before s2 overflows */
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__clang__) || __GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+#define ZIP_CHECKSUM_X86
+#include <cpuid.h>
+#include <emmintrin.h>
+#include <smmintrin.h>
+#include <tmmintrin.h>
+#include <wmmintrin.h>
+#endif
+
+#if defined(__GNUC__) && !defined(__clang__) && defined(__aarch64__) && defined(__linux__)
+#define ZIP_CHECKSUM_AARCH64
+#include <arm_neon.h>
+#include <sys/auxv.h>
+#ifndef HWCAP_CRC32
+#define HWCAP_CRC32 (1 << 7)
+#endif
+#endif
+
+typedef uLong (*checksum_fn)(uLong, const Bytef *, size_t);
+
+/* Portable versions; zlib takes a uInt length */
+static uLong
+zlib_crc32(uLong crc, const Bytef *buf, size_t len)
+{
+    while (len > 0) {
+        uInt n = len > 0x40000000 ? 0x40000000 : (uInt)len;
+        crc = crc32(crc, buf, n);
+        buf += n;
+        len -= n;
+    }
+    return crc;
+}
+
+static uLong
+zlib_adler32(uLong adler, const Bytef *buf, size_t len)
+{
+    while (len > 0) {
+        uInt n = len > 0x40000000 ? 0x40000000 : (uInt)len;
+        adler = adler32(adler, buf, n);
+        buf += n;
+        len -= n;
+    }
+    return adler;
+}
+
+#ifdef ZIP_CHECKSUM_X86
+
+/*
+ * Folding constants for the bit-reflected polynomial 0x04C11DB7, as
+ * derived in "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ
+ * Instruction" (Intel, 2009): x^(4*128+32), x^(4*128-32), x^(128+32),
+ * x^(128-32), x^64 mod P(x), then P(x) and the Barrett constant mu.
+ */
+#define CRC32_K1 0x0154442bd4LL
+#define CRC32_K2 0x01c6e41596LL
+#define CRC32_K3 0x01751997d0LL
+#define CRC32_K4 0x00ccaa009eLL
+#define CRC32_K5 0x0163cd6124LL
+#define CRC32_P  0x01db710641LL
+#define CRC32_MU 0x01f7011641LL
+
+/*
+ * Folds len bytes (a multiple of 16, at least 64) into the pre-inverted
+ * CRC register c and returns the new register value.
+ */
+__attribute__((target("pclmul,sse4.1")))
+static uint32_t
+crc32_pclmul(uint32_t c, const Bytef *buf, size_t len)
+{
+    __m128i x0, x1, x2, x3, x4, x5, x6, x7, x8;
+    const __m128i mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+
+    x1 = _mm_loadu_si128((const __m128i *)(buf + 0x00));
+    x2 = _mm_loadu_si128((const __m128i *)(buf + 0x10));
+    x3 = _mm_loadu_si128((const __m128i *)(buf + 0x20));
+    x4 = _mm_loadu_si128((const __m128i *)(buf + 0x30));
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int)c));
+    buf += 64;
+    len -= 64;
+
+    /* Fold four 128-bit lanes in parallel, 64 bytes at a time */
+    x0 = _mm_set_epi64x(CRC32_K2, CRC32_K1);
+    while (len >= 64) {
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+        x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+        x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x5),
+                           _mm_loadu_si128((const __m128i *)(buf + 0x00)));
+        x2 = _mm_xor_si128(_mm_xor_si128(x2, x6),
+                           _mm_loadu_si128((const __m128i *)(buf + 0x10)));
+        x3 = _mm_xor_si128(_mm_xor_si128(x3, x7),
+                           _mm_loadu_si128((const __m128i *)(buf + 0x20)));
+        x4 = _mm_xor_si128(_mm_xor_si128(x4, x8),
+                           _mm_loadu_si128((const __m128i *)(buf + 0x30)));
+        buf += 64;
+        len -= 64;
+    }
+
+    /* Fold the four lanes into one */
+    x0 = _mm_set_epi64x(CRC32_K4, CRC32_K3);
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+    /* Fold the remaining 16-byte blocks */
+    while (len >= 16) {
+        x2 = _mm_loadu_si128((const __m128i *)buf);
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+        buf += 16;
+        len -= 16;
+    }
+
+    /* Reduce 128 bits to 64, then to 32 */
+    x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+    x0 = _mm_set_epi64x(0, CRC32_K5);
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, mask32);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    /* Barrett reduction to the final 32-bit remainder */
+    x0 = _mm_set_epi64x(CRC32_MU, CRC32_P);
+    x2 = _mm_and_si128(x1, mask32);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x10);
+    x2 = _mm_and_si128(x2, mask32);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+    return (uint32_t)_mm_extract_epi32(x1, 1);
+}
+
+static uLong
+crc32_x86(uLong crc, const Bytef *buf, size_t len)
+{
+    if (len >= 64) {
+        size_t n = len & ~(size_t)15;
+        crc = ~crc32_pclmul(~(uint32_t)crc, buf, n) & 0xffffffffUL;
+        buf += n;
+        len -= n;
+    }
+    return zlib_crc32(crc, buf, len);
+}
+
+__attribute__((target("ssse3")))
+static uLong
+adler32_ssse3(uLong adler, const Bytef *buf, size_t len)
+{
+    uint32_t s1 = adler & 0xffff;
+    uint32_t s2 = (adler >> 16) & 0xffff;
+    size_t blocks = len / 32;
+
+    const __m128i tap1 = _mm_setr_epi8(32, 31, 30, 29, 28, 27, 26, 25,
+                                       24, 23, 22, 21, 20, 19, 18, 17);
+    const __m128i tap2 = _mm_setr_epi8(16, 15, 14, 13, 12, 11, 10, 9,
+                                       8, 7, 6, 5, 4, 3, 2, 1);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ones = _mm_set1_epi16(1);
+
+    len -= blocks * 32;
+    while (blocks > 0) {
+        unsigned n = NMAX / 32;
+        __m128i v_ps, v_s1, v_s2;
+        if (n > blocks) {
+            n = (unsigned)blocks;
+        }
+        blocks -= n;
+
+        /* v_ps accumulates s1 before each block; it is scaled by 32 below */
+        v_ps = _mm_set_epi32(0, 0, 0, (int)(s1 * n));
+        v_s2 = _mm_set_epi32(0, 0, 0, (int)s2);
+        v_s1 = _mm_setzero_si128();
+        do {
+            const __m128i bytes1 = _mm_loadu_si128((const __m128i *)buf);
+            const __m128i bytes2 = _mm_loadu_si128((const __m128i *)(buf + 16));
+            v_ps = _mm_add_epi32(v_ps, v_s1);
+            v_s1 = _mm_add_epi32(v_s1, _mm_sad_epu8(bytes1, zero));
+            v_s2 = _mm_add_epi32(v_s2,
+                       _mm_madd_epi16(_mm_maddubs_epi16(bytes1, tap1), ones));
+            v_s1 = _mm_add_epi32(v_s1, _mm_sad_epu8(bytes2, zero));
+            v_s2 = _mm_add_epi32(v_s2,
+                       _mm_madd_epi16(_mm_maddubs_epi16(bytes2, tap2), ones));
+            buf += 32;
+        } while (--n);
+        v_s2 = _mm_add_epi32(v_s2, _mm_slli_epi32(v_ps, 5));
+
+        /* Horizontal sums */
+        v_s1 = _mm_add_epi32(v_s1, _mm_shuffle_epi32(v_s1, _MM_SHUFFLE(2, 3, 0, 1)));
+        v_s1 = _mm_add_epi32(v_s1, _mm_shuffle_epi32(v_s1, _MM_SHUFFLE(1, 0, 3, 2)));
+        s1 += (uint32_t)_mm_cvtsi128_si32(v_s1);
+        v_s2 = _mm_add_epi32(v_s2, _mm_shuffle_epi32(v_s2, _MM_SHUFFLE(2, 3, 0, 1)));
+        v_s2 = _mm_add_epi32(v_s2, _mm_shuffle_epi32(v_s2, _MM_SHUFFLE(1, 0, 3, 2)));
+        s2 = (uint32_t)_mm_cvtsi128_si32(v_s2);
+
+        s1 %= BASE;
+        s2 %= BASE;
+    }
+    return zlib_adler32(((uLong)s2 << 16) | s1, buf, len);
+}
+
+static checksum_fn
+select_crc32(void)
+{
+    unsigned int eax, ebx, ecx, edx;
+    if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) &&
+        (ecx & bit_PCLMUL) != 0 && (ecx & bit_SSE4_1) != 0) {
+        return crc32_x86;
+    }
+    return zlib_crc32;
+}
+
+static checksum_fn
+select_adler32(void)
+{
+    unsigned int eax, ebx, ecx, edx;
+    if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & bit_SSSE3) != 0) {
+        return adler32_ssse3;
+    }
+    return zlib_adler32;
+}
+
+#elif defined(ZIP_CHECKSUM_AARCH64)
+
+#pragma GCC push_options
+#pragma GCC target("+crc")
+#include <arm_acle.h>
+
+static uLong
+crc32_armv8(uLong crc, const Bytef *buf, size_t len)
+{
+    uint32_t c = ~(uint32_t)crc;
+
+    while (len > 0 && ((uintptr_t)buf & 7) != 0) {
+        c = __crc32b(c, *buf++);
+        len--;
+    }
+    while (len >= 32) {
+        const uint64_t *p = (const uint64_t *)buf;
+        c = __crc32d(c, p[0]);
+        c = __crc32d(c, p[1]);
+        c = __crc32d(c, p[2]);
+        c = __crc32d(c, p[3]);
+        buf += 32;
+        len -= 32;
+    }
+    while (len >= 8) {
+        c = __crc32d(c, *(const uint64_t *)buf);
+        buf += 8;
+        len -= 8;
+    }
+    while (len > 0) {
+        c = __crc32b(c, *buf++);
+        len--;
+    }
+    return ~c & 0xffffffffUL;
+}
+
+#pragma GCC pop_options
+
+static uLong
+adler32_neon(uLong adler, const Bytef *buf, size_t len)
+{
+    uint32_t s1 = adler & 0xffff;
+    uint32_t s2 = (adler >> 16) & 0xffff;
+    size_t blocks = len / 32;
+
+    static const uint16_t taps[32] = {
+        32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17,
+        16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1
+    };
+
+    len -= blocks * 32;
+    while (blocks > 0) {
+        unsigned n = NMAX / 32;
+        uint32x4_t v_s1, v_s2;
+        uint16x8_t col1, col2, col3, col4;
+        uint32x2_t sum1, sum2, s1s2;
+        if (n > blocks) {
+            n = (unsigned)blocks;
+        }
+        blocks -= n;
+
+        /* v_s2 accumulates s1 before each block; it is scaled by 32 below */
+        v_s2 = vsetq_lane_u32(s1 * n, vdupq_n_u32(0), 3);
+        v_s1 = vdupq_n_u32(0);
+        col1 = col2 = col3 = col4 = vdupq_n_u16(0);
+        do {
+            const uint8x16_t bytes1 = vld1q_u8(buf);
+            const uint8x16_t bytes2 = vld1q_u8(buf + 16);
+            v_s2 = vaddq_u32(v_s2, v_s1);
+            v_s1 = vpadalq_u16(v_s1, vpadalq_u8(vpaddlq_u8(bytes1), bytes2));
+            col1 = vaddw_u8(col1, vget_low_u8(bytes1));
+            col2 = vaddw_u8(col2, vget_high_u8(bytes1));
+            col3 = vaddw_u8(col3, vget_low_u8(bytes2));
+            col4 = vaddw_u8(col4, vget_high_u8(bytes2));
+            buf += 32;
+        } while (--n);
+
+        /* Weight the column sums by their distance from the block end */
+        v_s2 = vshlq_n_u32(v_s2, 5);
+        v_s2 = vmlal_u16(v_s2, vget_low_u16(col1),  vld1_u16(taps + 0));
+        v_s2 = vmlal_u16(v_s2, vget_high_u16(col1), vld1_u16(taps + 4));
+        v_s2 = vmlal_u16(v_s2, vget_low_u16(col2),  vld1_u16(taps + 8));
+        v_s2 = vmlal_u16(v_s2, vget_high_u16(col2), vld1_u16(taps + 12));
+        v_s2 = vmlal_u16(v_s2, vget_low_u16(col3),  vld1_u16(taps + 16));
+        v_s2 = vmlal_u16(v_s2, vget_high_u16(col3), vld1_u16(taps + 20));
+        v_s2 = vmlal_u16(v_s2, vget_low_u16(col4),  vld1_u16(taps + 24));
+        v_s2 = vmlal_u16(v_s2, vget_high_u16(col4), vld1_u16(taps + 28));
+
+        /* Horizontal sums */
+        sum1 = vpadd_u32(vget_low_u32(v_s1), vget_high_u32(v_s1));
+        sum2 = vpadd_u32(vget_low_u32(v_s2), vget_high_u32(v_s2));
+        s1s2 = vpadd_u32(sum1, sum2);
+        s1 += vget_lane_u32(s1s2, 0);
+        s2 += vget_lane_u32(s1s2, 1);
+
+        s1 %= BASE;
+        s2 %= BASE;
+    }
+    return zlib_adler32(((uLong)s2 << 16) | s1, buf, len);
+}
+
+static checksum_fn
+select_crc32(void)
+{
+    if ((getauxval(AT_HWCAP) & HWCAP_CRC32) != 0) {
+        return crc32_armv8;
+    }
+    return zlib_crc32;
+}
+
+static checksum_fn
+select_adler32(void)
+{
+    /* Advanced SIMD is mandatory on AArch64 */
+    return adler32_neon;
+}
+
+#else
+
+static checksum_fn
+select_crc32(void)
+{
+    return zlib_crc32;
+}
+
+static checksum_fn
+select_adler32(void)
+{
+    return zlib_adler32;
+}
+
+#endif
+
+/*
+ * The selected implementation is cached on first use. Racing threads
+ * compute the same answer, so an unsynchronized store is harmless.
+ */
+static volatile checksum_fn crc32_impl = NULL;
+static volatile checksum_fn adler32_impl = NULL;
+
+uLong
+ZIP_crc32_update(uLong crc, const Bytef *buf, size_t len)
+{
+    checksum_fn fn = crc32_impl;
+    if (fn == NULL) {
+        crc32_impl = fn = select_crc32();
+    }
+    return (*fn)(crc, buf, len);
+}
+
+uLong
+ZIP_adler32_update(uLong adler, const Bytef *buf, size_t len)
+{
+    checksum_fn fn = adler32_impl;
+    if (fn == NULL) {
+        adler32_impl = fn = select_adler32();
+    }
+    return (*fn)(adler, buf, len);
+}
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * Accelerated CRC-32 and Adler-32 checksums for java.util.zip
+ */
+
+#ifndef _ZIP_CHECKSUM_H_
+#define _ZIP_CHECKSUM_H_
+
+#include <stddef.h>
+#include <zlib.h>
+
+/*
+ * Drop-in replacements for zlib's crc32() and adler32(). The first call
+ * selects an implementation for the running CPU (PCLMULQDQ/SSSE3 on x86,
+ * the CRC32 and NEON instructions on AArch64); anything else, including
+ * short inputs, is handed to zlib so the results are always identical.
+ */
+uLong ZIP_crc32_update(uLong crc, const Bytef *buf, size_t len);
+uLong ZIP_adler32_update(uLong adler, const Bytef *buf, size_t len);
+
+#endif /* !_ZIP_CHECKSUM_H_ */
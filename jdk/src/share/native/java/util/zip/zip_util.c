@@ -513,6 +513,7 @@ freeCEN(jzfile *zip)
 {
     free(zip->entries); zip->entries = NULL;
     free(zip->table);   zip->table   = NULL;
+    zip->tablelen = 0;
     freeMetaNames(zip);
 }
 
@@ -546,7 +547,7 @@ readCEN(jzfile *zip, jint knownTotal)
     /* Following are unsigned 32-bit */
     jlong endpos, end64pos, cenpos, cenlen, cenoff;
     /* Following are unsigned 16-bit */
-    jint total, tablelen, i, j;
+    jint total, i;
     unsigned char *cenbuf = NULL;
     unsigned char *cenend;
     unsigned char *cp;
@@ -557,7 +558,6 @@ readCEN(jzfile *zip, jint knownTotal)
     unsigned char endbuf[ENDHDR];
     jint endhdrlen = ENDHDR;
     jzcell *entries;
-    jint *table;
 
     /* Clear previous zip error */
     zip->msg = NULL;
@@ -586,7 +586,11 @@ readCEN(jzfile *zip, jint knownTotal)
 
     if (cenlen > endpos)
         ZIP_FORMAT_ERROR("invalid END header (bad central directory size)");
+    /* Entry cells keep 32-bit offsets into the central directory */
+    if (cenlen > (jlong)0xffffffffU)
+        ZIP_FORMAT_ERROR("invalid END header (central directory size too large)");
     cenpos = endpos - cenlen;
+    zip->cenpos = cenpos;
 
     /* Get position of first local file (LOC) header, taking into
      * account that there may be a stub prefixed to the zip file. */
@@ -656,21 +660,16 @@ readCEN(jzfile *zip, jint knownTotal)
      * the Zip64 enabled.
      */
     total = (knownTotal != -1) ? knownTotal : total;
-    entries  = zip->entries  = calloc(total, sizeof(entries[0]));
-    tablelen = zip->tablelen = ((total/2) | 1); // Odd -> fewer collisions
-    table    = zip->table    = malloc(tablelen * sizeof(table[0]));
-    /* According to ISO C it is perfectly legal for malloc to return zero
-     * if called with a zero argument. We check this for 'entries' but not
-     * for 'table' because 'tablelen' can't be zero (see computation above). */
-    if ((entries == NULL && total != 0) || table == NULL) goto Catch;
-    for (j = 0; j < tablelen; j++)
-        table[j] = ZIP_ENDCHAIN;
+    entries = zip->entries = calloc(total, sizeof(entries[0]));
+    /* According to ISO C it is perfectly legal for calloc to return zero
+     * if called with a zero argument. The name index is not built here;
+     * see buildIndex(). */
+    if (entries == NULL && total != 0) goto Catch;
 
     /* Iterate through the entries in the central directory */
     for (i = 0, cp = cenbuf; cp <= cenend - CENHDR; i++, cp += CENSIZE(cp)) {
         /* Following are unsigned 16-bit */
         jint method, nlen;
-        unsigned int hsh;
 
         if (i >= total) {
             /* This will only happen if the zip file has an incorrect
@@ -697,14 +696,9 @@ readCEN(jzfile *zip, jint knownTotal)
             if (addMetaName(zip, (char *)cp+CENHDR, nlen) != 0)
                 goto Catch;
 
-        /* Record the CEN offset and the name hash in our hash cell. */
-        entries[i].cenpos = cenpos + (cp - cenbuf);
+        /* Record the CEN offset and the name hash in our entry cell. */
+        entries[i].cenoff = (unsigned int)(cp - cenbuf);
         entries[i].hash = hashN((char *)cp+CENHDR, nlen);
-
-        /* Add the entry to the hash table */
-        hsh = entries[i].hash % tablelen;
-        entries[i].next = table[hsh];
-        table[hsh] = i;
     }
     if (cp != cenend)
         ZIP_FORMAT_ERROR("invalid CEN header (bad header size)");
@@ -996,14 +990,15 @@ newEntry(jzfile *zip, jzcell *zc, AccessHint accessHint)
 
 #ifdef USE_MMAP
     if (zip->usemmap) {
-        cen = (char*) zip->maddr + zc->cenpos - zip->offset;
+        cen = (char*) zip->maddr + zip->cenpos + zc->cenoff - zip->offset;
     } else
 #endif
     {
         if (accessHint == ACCESS_RANDOM)
-            cen = readCENHeader(zip, zc->cenpos, AMPLE_CEN_HEADER_SIZE);
+            cen = readCENHeader(zip, zip->cenpos + zc->cenoff,
+                                AMPLE_CEN_HEADER_SIZE);
         else
-            cen = sequentialAccessReadCENHeader(zip, zc->cenpos);
+            cen = sequentialAccessReadCENHeader(zip, zip->cenpos + zc->cenoff);
         if (cen == NULL) goto Catch;
     }
 
@@ -1137,6 +1132,71 @@ jboolean equals(char* name1, int len1, char* name2, int len2) {
     return JNI_TRUE;
 }
 
+/*
+ * Returns the first index slot probed for a name hash. The name hash is
+ * mixed first since its low bits alone select the slot.
+ */
+static unsigned int
+indexSlot(jzfile *zip, unsigned int hsh)
+{
+    hsh ^= hsh >> 16;
+    hsh *= 0x85ebca6bU;
+    hsh ^= hsh >> 13;
+    return hsh & (unsigned int)(zip->tablelen - 1);
+}
+
+/*
+ * Builds the open-addressed name index over the entry cells. The index
+ * has at least twice as many slots as entries, so probe sequences stay
+ * short and mostly within one cache line; since it is only needed for
+ * lookups by name it is built on the first such lookup. Entries are
+ * inserted last to first so that, as before, the last of several
+ * entries with the same name is found.
+ * Returns 0 on success or -1 if out of memory.
+ * The ZIP lock should be held here.
+ */
+static int
+buildIndex(jzfile *zip)
+{
+    jint tablelen = 1;
+    jint *table;
+    jint i;
+
+    while (tablelen < zip->total * 2)
+        tablelen <<= 1;
+    if ((table = malloc(tablelen * sizeof(table[0]))) == NULL)
+        return -1;
+    for (i = 0; i < tablelen; i++)
+        table[i] = ZIP_ENDCHAIN;
+
+    zip->table = table;
+    zip->tablelen = tablelen;
+    for (i = zip->total - 1; i >= 0; i--) {
+        unsigned int slot = indexSlot(zip, zip->entries[i].hash);
+        while (table[slot] != ZIP_ENDCHAIN)
+            slot = (slot + 1) & (unsigned int)(tablelen - 1);
+        table[slot] = i;
+    }
+    return 0;
+}
+
+/*
+ * Returns the entry index at probe position *slot and advances *slot,
+ * or returns ZIP_ENDCHAIN at the end of the probe sequence. Without an
+ * index (it could not be allocated) every entry is visited in turn.
+ */
+static jint
+nextCandidate(jzfile *zip, unsigned int *slot)
+{
+    jint idx;
+    if (zip->table == NULL) {
+        return (*slot < (unsigned int)zip->total) ? (jint)(*slot)++ : ZIP_ENDCHAIN;
+    }
+    idx = zip->table[*slot];
+    *slot = (*slot + 1) & (unsigned int)(zip->tablelen - 1);
+    return idx;
+}
+
 /*
  * Returns the zip entry corresponding to the specified name, or
  * NULL if not found.
@@ -1147,6 +1207,7 @@ jzentry *
 ZIP_GetEntry2(jzfile *zip, char *name, jint ulen, jboolean addSlash)
 {
     unsigned int hsh = hashN(name, ulen);
+    unsigned int slot;
     jint idx;
     jzentry *ze = 0;
 
@@ -1155,7 +1216,10 @@ ZIP_GetEntry2(jzfile *zip, char *name, jint ulen, jboolean addSlash)
         goto Finally;
     }
 
-    idx = zip->table[hsh % zip->tablelen];
+    if (zip->table == NULL) {
+        buildIndex(zip);
+    }
+    slot = (zip->table != NULL) ? indexSlot(zip, hsh) : 0;
 
     /*
      * This while loop is an optimization where a double lookup
@@ -1176,10 +1240,10 @@ ZIP_GetEntry2(jzfile *zip, char *name, jint ulen, jboolean addSlash)
         ze = 0;
 
         /*
-         * Search down the target hash chain for a cell whose
-         * 32 bit hash matches the hashed name.
+         * Probe the index for a cell whose 32 bit hash matches
+         * the hashed name.
          */
-        while (idx != ZIP_ENDCHAIN) {
+        while ((idx = nextCandidate(zip, &slot)) != ZIP_ENDCHAIN) {
             jzcell *zc = &zip->entries[idx];
 
             if (zc->hash == hsh) {
@@ -1204,7 +1268,6 @@ ZIP_GetEntry2(jzfile *zip, char *name, jint ulen, jboolean addSlash)
                 }
                 ze = 0;
             }
-            idx = zc->next;
         }
 
         /* Entry found, return it */
@@ -1226,7 +1289,7 @@ ZIP_GetEntry2(jzfile *zip, char *name, jint ulen, jboolean addSlash)
         name[ulen++] = '/';
         name[ulen] = '\0';
         hsh = hash_append(hsh, '/');
-        idx = zip->table[hsh % zip->tablelen];
+        slot = (zip->table != NULL) ? indexSlot(zip, hsh) : 0;
         addSlash = JNI_FALSE;
     }
 
@@ -1252,6 +1315,41 @@ ZIP_GetNextEntry(jzfile *zip, jint n)
     return result;
 }
 
+/*
+ * Calls f with the name of every entry, in central directory order,
+ * without allocating a jzentry for each. The name is not NUL-terminated
+ * and is only valid for the duration of the call; f is called with the
+ * ZIP lock held and must not call back into this zip file.
+ * Returns the number of entries visited, or -1 if a CEN header could
+ * not be read.
+ */
+jint JNICALL
+ZIP_ForEachEntryName(jzfile *zip,
+                     void (*f)(const char *name, jint nlen, void *context),
+                     void *context)
+{
+    jint i;
+    ZIP_Lock(zip);
+    for (i = 0; i < zip->total; i++) {
+        jlong cenpos = zip->cenpos + zip->entries[i].cenoff;
+        char *cen;
+#ifdef USE_MMAP
+        if (zip->usemmap) {
+            cen = (char*) zip->maddr + cenpos - zip->offset;
+        } else
+#endif
+        {
+            if ((cen = sequentialAccessReadCENHeader(zip, cenpos)) == NULL) {
+                i = -1;
+                break;
+            }
+        }
+        (*f)(cen + CENHDR, CENNAM(cen), context);
+    }
+    ZIP_Unlock(zip);
+    return i;
+}
+
 /*
  * Locks the specified zip file for reading.
  */
@@ -1512,3 +1610,194 @@ ZIP_ReadEntry(jzfile *zip, jzentry *entry, unsigned char *buf, char *entryname)
 
     return JNI_TRUE;
 }
+
+/*
+ * These functions are used by the runtime system to write gzip compressed
+ * heap dumps. The dump is compressed in independent chunks, each of which
+ * becomes a complete gzip member, so that chunks can be compressed in
+ * parallel and simply concatenated in the output file.
+ */
+
+/*
+ * Returns an upper bound on the size of the gzip member ZIP_GZip_Fully
+ * produces for inLen bytes at the given level, or 0 with *pmsg set.
+ */
+JNIEXPORT size_t JNICALL
+ZIP_GZip_Bound(size_t inLen, jint level, char **pmsg)
+{
+    z_stream strm;
+    size_t bound;
+
+    *pmsg = 0; /* Reset error message */
+
+    memset(&strm, 0, sizeof(z_stream));
+    /* 16 + MAX_WBITS selects the gzip header and trailer */
+    if (deflateInit2(&strm, level, Z_DEFLATED, 16 + MAX_WBITS, 8,
+                     Z_DEFAULT_STRATEGY) != Z_OK) {
+        *pmsg = "gzipBound: cannot initialize deflater";
+        return 0;
+    }
+    bound = (size_t)deflateBound(&strm, (uLong)inLen);
+    /* deflateBound assumes a single call, allow for splitting large inputs */
+    bound += (inLen / UINT_MAX + 1) * 64;
+    deflateEnd(&strm);
+    return bound;
+}
+
+/*
+ * Compresses inLen bytes at inBuf into a single gzip member at outBuf,
+ * which has room for outLen bytes. Returns the size of the member, or 0
+ * with *pmsg set.
+ */
+JNIEXPORT size_t JNICALL
+ZIP_GZip_Fully(char *inBuf, size_t inLen, char *outBuf, size_t outLen,
+               jint level, char **pmsg)
+{
+    z_stream strm;
+    int err;
+
+    *pmsg = 0; /* Reset error message */
+
+    memset(&strm, 0, sizeof(z_stream));
+    if (deflateInit2(&strm, level, Z_DEFLATED, 16 + MAX_WBITS, 8,
+                     Z_DEFAULT_STRATEGY) != Z_OK) {
+        *pmsg = "gzipFully: cannot initialize deflater";
+        return 0;
+    }
+
+    strm.next_in = (Bytef *)inBuf;
+    strm.next_out = (Bytef *)outBuf;
+    do {
+        /* avail_in and avail_out are only 32 bits wide */
+        size_t in = (size_t)((char *)strm.next_in - inBuf);
+        size_t out = (size_t)((char *)strm.next_out - outBuf);
+        strm.avail_in = (uInt)(inLen - in > UINT_MAX ? UINT_MAX : inLen - in);
+        strm.avail_out = (uInt)(outLen - out > UINT_MAX ? UINT_MAX : outLen - out);
+        err = deflate(&strm, inLen - in > UINT_MAX ? Z_NO_FLUSH : Z_FINISH);
+    } while (err == Z_OK && (size_t)((char *)strm.next_out - outBuf) < outLen);
+
+    if (err != Z_STREAM_END) {
+        *pmsg = "gzipFully: output buffer too small";
+        deflateEnd(&strm);
+        return 0;
+    }
+    deflateEnd(&strm);
+    return (size_t)((char *)strm.next_out - outBuf);
+}
+
+/*
+ * These functions compress a single gzip member in parallel, the way pigz
+ * does. The input is cut into blocks that are deflated independently into
+ * raw deflate data. Each block is primed with up to 32K of the input that
+ * precedes it as dictionary, and all but the last end with a sync flush,
+ * which leaves them on a byte boundary. So the compressed blocks concatenate
+ * into one deflate stream that loses little to the split. The caller writes
+ * the gzip header, and a trailer with the CRC-32s of the blocks combined by
+ * ZIP_CRC32_Combine.
+ */
+
+/*
+ * Returns an upper bound on the size of the data ZIP_GZip_Block produces
+ * for inLen bytes at the given level, or 0 with *pmsg set.
+ */
+JNIEXPORT size_t JNICALL
+ZIP_GZip_Block_Bound(size_t inLen, jint level, char **pmsg)
+{
+    z_stream strm;
+    size_t bound;
+
+    *pmsg = 0; /* Reset error message */
+
+    memset(&strm, 0, sizeof(z_stream));
+    if (deflateInit2(&strm, level, Z_DEFLATED, -MAX_WBITS, 8,
+                     Z_DEFAULT_STRATEGY) != Z_OK) {
+        *pmsg = "gzipBlockBound: cannot initialize deflater";
+        return 0;
+    }
+    bound = (size_t)deflateBound(&strm, (uLong)inLen);
+    /* the sync flush adds an empty stored block, and large inputs are split */
+    bound += 5 + (inLen / UINT_MAX + 1) * 64;
+    deflateEnd(&strm);
+    return bound;
+}
+
+/*
+ * Deflates inLen bytes at inBuf into outBuf, which has room for outLen
+ * bytes, as the next block of a deflate stream. dict points to the dictLen
+ * bytes of input right before inBuf, at most 32K. The block ends with a
+ * sync flush, or ends the stream if last is set. Stores the CRC-32 of the
+ * input in *crc and returns the size of the block, or 0 with *pmsg set.
+ */
+JNIEXPORT size_t JNICALL
+ZIP_GZip_Block(char *dict, size_t dictLen, char *inBuf, size_t inLen,
+               char *outBuf, size_t outLen, jint level, jboolean last,
+               jint *crc, char **pmsg)
+{
+    z_stream strm;
+    uLong sum;
+    size_t n;
+    int err;
+
+    *pmsg = 0; /* Reset error message */
+
+    memset(&strm, 0, sizeof(z_stream));
+    if (deflateInit2(&strm, level, Z_DEFLATED, -MAX_WBITS, 8,
+                     Z_DEFAULT_STRATEGY) != Z_OK) {
+        *pmsg = "gzipBlock: cannot initialize deflater";
+        return 0;
+    }
+    if (dictLen > 0 &&
+        deflateSetDictionary(&strm, (Bytef *)dict, (uInt)dictLen) != Z_OK) {
+        *pmsg = "gzipBlock: cannot set dictionary";
+        deflateEnd(&strm);
+        return 0;
+    }
+
+    strm.next_in = (Bytef *)inBuf;
+    strm.next_out = (Bytef *)outBuf;
+    do {
+        /* avail_in and avail_out are only 32 bits wide */
+        size_t in = (size_t)((char *)strm.next_in - inBuf);
+        size_t out = (size_t)((char *)strm.next_out - outBuf);
+        int more = inLen - in > UINT_MAX;
+        if (out == outLen) {
+            err = Z_BUF_ERROR;
+            break;
+        }
+        strm.avail_in = (uInt)(more ? UINT_MAX : inLen - in);
+        strm.avail_out = (uInt)(outLen - out > UINT_MAX ? UINT_MAX : outLen - out);
+        err = deflate(&strm, more ? Z_NO_FLUSH : (last ? Z_FINISH : Z_SYNC_FLUSH));
+        /* a flush is complete when it did not fill the output */
+        if (err == Z_OK && !more && !last &&
+            strm.avail_in == 0 && strm.avail_out != 0) {
+            break;
+        }
+    } while (err == Z_OK);
+
+    if (err != (last ? Z_STREAM_END : Z_OK)) {
+        *pmsg = "gzipBlock: output buffer too small";
+        deflateEnd(&strm);
+        return 0;
+    }
+    deflateEnd(&strm);
+
+    sum = crc32(0L, Z_NULL, 0);
+    for (n = 0; n < inLen; ) {
+        uInt len = (uInt)(inLen - n > UINT_MAX ? UINT_MAX : inLen - n);
+        sum = crc32(sum, (Bytef *)inBuf + n, len);
+        n += len;
+    }
+    *crc = (jint)sum;
+    return (size_t)((char *)strm.next_out - outBuf);
+}
+
+/*
+ * Returns the CRC-32 of two pieces of data from their CRC-32s and the
+ * length of the second one.
+ */
+JNIEXPORT jint JNICALL
+ZIP_CRC32_Combine(jint crc1, jint crc2, jlong len2)
+{
+    return (jint)crc32_combine((uLong)(unsigned int)crc1,
+                               (uLong)(unsigned int)crc2, (z_off_t)len2);
+}
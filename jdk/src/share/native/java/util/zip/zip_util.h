@@ -171,16 +171,17 @@ typedef struct jzentry {  /* Zip file entry */
 } jzentry;
 
 /*
- * In-memory hash table cell.
+ * In-memory entry cell.
  * In a typical system we have a *lot* of these, as we have one for
  * every entry in every active JAR.
  * Note that in order to save space we don't keep the name in memory,
- * but merely remember a 32 bit hash.
+ * but merely remember a 32 bit hash, and the header position is kept
+ * relative to the start of the central directory.
  */
 typedef struct jzcell {
     unsigned int hash;    /* 32 bit hashcode on name */
-    unsigned int next;    /* hash chain: index into jzfile->entries */
-    jlong cenpos;         /* Offset of central directory file header */
+    unsigned int cenoff;  /* Offset of central directory file header
+                             from jzfile->cenpos */
 } jzcell;
 
 typedef struct cencache {
@@ -219,10 +220,12 @@ typedef struct jzfile {   /* Zip file */
     char *comment;        /* zip file comment */
     jint clen;            /* length of the zip file comment */
     char *msg;            /* zip error message */
-    jzcell *entries;      /* array of hash cells */
+    jzcell *entries;      /* array of entry cells, in CEN order */
     jint total;           /* total number of entries */
-    jint *table;          /* Hash chain heads: indexes into entries */
-    jint tablelen;        /* number of hash heads */
+    jlong cenpos;         /* position of the central directory */
+    jint *table;          /* open-addressed name index: indexes into
+                             entries, built on the first lookup */
+    jint tablelen;        /* number of index slots (a power of two) */
     struct jzfile *next;  /* next zip file in search list */
     jzentry *cache;       /* we cache the most recently freed jzentry */
     /* Information on metadata names in META-INF directory */
@@ -234,7 +237,7 @@ typedef struct jzfile {   /* Zip file */
 } jzfile;
 
 /*
- * Index representing end of hash chain
+ * Index representing an empty index slot, which ends a probe sequence
  */
 #define ZIP_ENDCHAIN ((jint)-1)
 
@@ -272,4 +275,26 @@ jint ZIP_Read(jzfile *zip, jzentry *entry, jlong pos, void *buf, jint len);
 void ZIP_FreeEntry(jzfile *zip, jzentry *ze);
 jlong ZIP_GetEntryDataOffset(jzfile *zip, jzentry *entry);
 jzentry * ZIP_GetEntry2(jzfile *zip, char *name, jint ulen, jboolean addSlash);
+jint JNICALL
+ZIP_ForEachEntryName(jzfile *zip,
+                     void (*f)(const char *name, jint nlen, void *context),
+                     void *context);
+
+size_t JNICALL
+ZIP_GZip_Bound(size_t inLen, jint level, char **pmsg);
+
+size_t JNICALL
+ZIP_GZip_Fully(char *inBuf, size_t inLen, char *outBuf, size_t outLen,
+               jint level, char **pmsg);
+
+size_t JNICALL
+ZIP_GZip_Block_Bound(size_t inLen, jint level, char **pmsg);
+
+size_t JNICALL
+ZIP_GZip_Block(char *dict, size_t dictLen, char *inBuf, size_t inLen,
+               char *outBuf, size_t outLen, jint level, jboolean last,
+               jint *crc, char **pmsg);
+
+jint JNICALL
+ZIP_CRC32_Combine(jint crc1, jint crc2, jlong len2);
 #endif /* !_ZIP_H_ */
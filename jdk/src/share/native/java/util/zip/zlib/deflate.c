@@ -1302,6 +1302,12 @@ local void lm_init (s)
 /* For 80x86 and 680x0, an optimized version will be provided in match.asm or
  * match.S. The code will be functionally equivalent.
  */
+#if !defined(NO_LONGEST_MATCH_WORD) && defined(__GNUC__) && \
+    (defined(__x86_64__) || defined(__aarch64__)) && \
+    defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#  define LONGEST_MATCH_WORD
+#endif
+
 local uInt longest_match(s, cur_match)
     deflate_state *s;
     IPos cur_match;                             /* current match */
@@ -1410,6 +1416,30 @@ local uInt longest_match(s, cur_match)
         scan += 2, match++;
         Assert(*scan == *match, "match[2]?");
 
+#ifdef LONGEST_MATCH_WORD
+        /* Compare eight bytes at a time and locate the first mismatching
+         * byte from the trailing zero count of the XOR. Only full words
+         * before strend are loaded, so no byte past window+strstart+257 is
+         * read; the resulting length is the same as the byte loop below.
+         */
+        scan++, match++;
+        for (;;) {
+            unsigned long long sw, mw;
+            if (scan + 8 > strend) {
+                while (scan < strend && *scan == *match) {
+                    scan++, match++;
+                }
+                break;
+            }
+            zmemcpy(&sw, scan, 8);
+            zmemcpy(&mw, match, 8);
+            if (sw != mw) {
+                scan += __builtin_ctzll(sw ^ mw) >> 3;
+                break;
+            }
+            scan += 8, match += 8;
+        }
+#else
         /* We check for insufficient lookahead only every 8th comparison;
          * the 256th check will be made at strstart+258.
          */
@@ -1419,6 +1449,7 @@ local uInt longest_match(s, cur_match)
                  *++scan == *++match && *++scan == *++match &&
                  *++scan == *++match && *++scan == *++match &&
                  scan < strend);
+#endif
 
         Assert(scan <= s->window+(unsigned)(s->window_size-1), "wild scan");
 
@@ -36,6 +36,15 @@
 #  pragma message("Assembler code may have bugs -- use at your own risk")
 #else
 
+/* Matches copied from the output at a distance of at least INFLATE_CHUNK
+   bytes are moved a chunk at a time when there is room for the copy to run
+   up to INFLATE_CHUNK-1 bytes past its end. Define NO_INFLATE_CHUNK_COPY to
+   keep the byte-at-a-time copy.
+ */
+#ifndef NO_INFLATE_CHUNK_COPY
+#  define INFLATE_CHUNK 8
+#endif
+
 /*
    Decode literal, length, and distance codes and write out the resulting
    literal and match bytes until either not enough input or output is
@@ -274,6 +283,21 @@ unsigned start;         /* inflate()'s starting value for strm->avail_out */
                 }
                 else {
                     from = out - dist;          /* copy direct from output */
+#ifdef INFLATE_CHUNK
+                    /* Each chunk's source ends at or before its destination,
+                       and 257 + (end - out) bytes of output are available */
+                    if (dist >= INFLATE_CHUNK &&
+                        len + (INFLATE_CHUNK - 1) <= 257 + (unsigned)(end - out)) {
+                        unsigned char FAR *stop = out + len;
+                        do {
+                            zmemcpy(out, from, INFLATE_CHUNK);
+                            out += INFLATE_CHUNK;
+                            from += INFLATE_CHUNK;
+                        } while (out < stop);
+                        out = stop;
+                        continue;
+                    }
+#endif
                     do {                        /* minimum length is three */
                         *out++ = *from++;
                         *out++ = *from++;
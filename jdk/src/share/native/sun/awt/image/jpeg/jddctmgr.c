@@ -23,6 +23,7 @@
 #include "jinclude.h"
 #include "jpeglib.h"
 #include "jdct.h"               /* Private declarations for DCT subsystem */
+#include "jsimd.h"
 
 
 /*
@@ -121,7 +122,10 @@ start_pass (j_decompress_ptr cinfo)
       switch (cinfo->dct_method) {
 #ifdef DCT_ISLOW_SUPPORTED
       case JDCT_ISLOW:
-        method_ptr = jpeg_idct_islow;
+        if (jsimd_can_idct_islow())
+          method_ptr = jsimd_idct_islow;
+        else
+          method_ptr = jpeg_idct_islow;
         method = JDCT_ISLOW;
         break;
 #endif
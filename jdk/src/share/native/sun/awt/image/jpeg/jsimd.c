@@ -0,0 +1,381 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * jsimd.c
+ *
+ * SSE4.1 versions of jpeg_idct_islow() and the YCbCr->RGB color
+ * converter, selected at run time by cpuid.  Both do the same 32-bit
+ * integer arithmetic as the portable code, lane for lane, including the
+ * zero-column and zero-row shortcuts and the wrap-around of the IDCT
+ * range-limit table, so decoded images are bit-identical.  On other
+ * compilers and architectures the jsimd_can_* queries return FALSE.
+ */
+
+#define JPEG_INTERNALS
+#include "jinclude.h"
+#include "jpeglib.h"
+#include "jdct.h"               /* Private declarations for DCT subsystem */
+#include "jsimd.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__clang__) || __GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9)) && \
+    BITS_IN_JSAMPLE == 8
+#define JSIMD_SSE41
+#include <cpuid.h>
+#include <smmintrin.h>
+#endif
+
+#ifdef JSIMD_SSE41
+
+#define SIMD_TARGET __attribute__((target("sse4.1")))
+
+LOCAL(int)
+have_sse41 (void)
+{
+  static int result = -1;
+  if (result < 0) {
+    unsigned int eax, ebx, ecx, edx;
+    result = (__get_cpuid(1, &eax, &ebx, &ecx, &edx) &&
+              (ecx & bit_SSE4_1) != 0) ? 1 : 0;
+  }
+  return result;
+}
+
+
+/**************** Accurate integer inverse DCT **************/
+
+/* Same scaling and constants as jidctint.c */
+
+#define CONST_BITS  13
+#define PASS1_BITS  2
+
+#define FIX_0_298631336  2446
+#define FIX_0_390180644  3196
+#define FIX_0_541196100  4433
+#define FIX_0_765366865  6270
+#define FIX_0_899976223  7373
+#define FIX_1_175875602  9633
+#define FIX_1_501321110  12299
+#define FIX_1_847759065  15137
+#define FIX_1_961570560  16069
+#define FIX_2_053119869  16819
+#define FIX_2_562915447  20995
+#define FIX_3_072711026  25172
+
+#define MULC(v,c)     _mm_mullo_epi32(v, _mm_set1_epi32(c))
+#define DESCALE4(v,n) _mm_srai_epi32(_mm_add_epi32(v, _mm_set1_epi32(1 << ((n)-1))), n)
+
+#define TRANSPOSE4(r0,r1,r2,r3) { \
+    __m128i t0 = _mm_unpacklo_epi32(r0, r1); \
+    __m128i t1 = _mm_unpacklo_epi32(r2, r3); \
+    __m128i t2 = _mm_unpackhi_epi32(r0, r1); \
+    __m128i t3 = _mm_unpackhi_epi32(r2, r3); \
+    r0 = _mm_unpacklo_epi64(t0, t1); \
+    r1 = _mm_unpackhi_epi64(t0, t1); \
+    r2 = _mm_unpacklo_epi64(t2, t3); \
+    r3 = _mm_unpackhi_epi64(t2, t3); \
+  }
+
+/*
+ * One-dimensional IDCT of four independent lanes, as in the column and
+ * row loops of jpeg_idct_islow(); the outputs are not yet descaled.
+ */
+
+SIMD_TARGET static inline void
+idct_1d (__m128i v[DCTSIZE])
+{
+  __m128i tmp0, tmp1, tmp2, tmp3, tmp10, tmp11, tmp12, tmp13;
+  __m128i z1, z2, z3, z4, z5;
+
+  /* Even part */
+  z2 = v[2];
+  z3 = v[6];
+  z1 = MULC(_mm_add_epi32(z2, z3), FIX_0_541196100);
+  tmp2 = _mm_add_epi32(z1, MULC(z3, - FIX_1_847759065));
+  tmp3 = _mm_add_epi32(z1, MULC(z2, FIX_0_765366865));
+
+  tmp0 = _mm_slli_epi32(_mm_add_epi32(v[0], v[4]), CONST_BITS);
+  tmp1 = _mm_slli_epi32(_mm_sub_epi32(v[0], v[4]), CONST_BITS);
+
+  tmp10 = _mm_add_epi32(tmp0, tmp3);
+  tmp13 = _mm_sub_epi32(tmp0, tmp3);
+  tmp11 = _mm_add_epi32(tmp1, tmp2);
+  tmp12 = _mm_sub_epi32(tmp1, tmp2);
+
+  /* Odd part */
+  tmp0 = v[7];
+  tmp1 = v[5];
+  tmp2 = v[3];
+  tmp3 = v[1];
+
+  z1 = _mm_add_epi32(tmp0, tmp3);
+  z2 = _mm_add_epi32(tmp1, tmp2);
+  z3 = _mm_add_epi32(tmp0, tmp2);
+  z4 = _mm_add_epi32(tmp1, tmp3);
+  z5 = MULC(_mm_add_epi32(z3, z4), FIX_1_175875602);
+
+  tmp0 = MULC(tmp0, FIX_0_298631336);
+  tmp1 = MULC(tmp1, FIX_2_053119869);
+  tmp2 = MULC(tmp2, FIX_3_072711026);
+  tmp3 = MULC(tmp3, FIX_1_501321110);
+  z1 = MULC(z1, - FIX_0_899976223);
+  z2 = MULC(z2, - FIX_2_562915447);
+  z3 = MULC(z3, - FIX_1_961570560);
+  z4 = MULC(z4, - FIX_0_390180644);
+
+  z3 = _mm_add_epi32(z3, z5);
+  z4 = _mm_add_epi32(z4, z5);
+
+  tmp0 = _mm_add_epi32(tmp0, _mm_add_epi32(z1, z3));
+  tmp1 = _mm_add_epi32(tmp1, _mm_add_epi32(z2, z4));
+  tmp2 = _mm_add_epi32(tmp2, _mm_add_epi32(z2, z3));
+  tmp3 = _mm_add_epi32(tmp3, _mm_add_epi32(z1, z4));
+
+  /* Final output stage */
+  v[0] = _mm_add_epi32(tmp10, tmp3);
+  v[7] = _mm_sub_epi32(tmp10, tmp3);
+  v[1] = _mm_add_epi32(tmp11, tmp2);
+  v[6] = _mm_sub_epi32(tmp11, tmp2);
+  v[2] = _mm_add_epi32(tmp12, tmp1);
+  v[5] = _mm_sub_epi32(tmp12, tmp1);
+  v[3] = _mm_add_epi32(tmp13, tmp0);
+  v[4] = _mm_sub_epi32(tmp13, tmp0);
+}
+
+/*
+ * Perform dequantization and inverse DCT on one block of coefficients.
+ * Pass 1 handles four columns per lane group and pass 2 four rows, with
+ * the workspace transposed in between.
+ */
+
+SIMD_TARGET GLOBAL(void)
+jsimd_idct_islow (j_decompress_ptr cinfo, jpeg_component_info * compptr,
+                  JCOEFPTR coef_block,
+                  JSAMPARRAY output_buf, JDIMENSION output_col)
+{
+  ISLOW_MULT_TYPE * quantptr = (ISLOW_MULT_TYPE *) compptr->dct_table;
+  const __m128i zero = _mm_setzero_si128();
+  __m128i ws[DCTSIZE][2];       /* workspace rows, columns 0-3 and 4-7 */
+  __m128i v[DCTSIZE];
+  int half, group, k;
+
+  /* Pass 1: process columns from input, store into work array. */
+  for (half = 0; half < 2; half++) {
+    __m128i acbits = zero;
+    __m128i dcval, allzero;
+    for (k = 0; k < DCTSIZE; k++) {
+      __m128i coef = _mm_cvtepi16_epi32(
+          _mm_loadl_epi64((const __m128i *) (coef_block + DCTSIZE*k + 4*half)));
+      __m128i quant = _mm_loadu_si128(
+          (const __m128i *) (quantptr + DCTSIZE*k + 4*half));
+      if (k > 0)
+        acbits = _mm_or_si128(acbits, coef);
+      v[k] = _mm_mullo_epi32(coef, quant);
+    }
+    /* Columns whose AC terms are all zero take the DC shortcut */
+    allzero = _mm_cmpeq_epi32(acbits, zero);
+    dcval = _mm_slli_epi32(v[0], PASS1_BITS);
+    idct_1d(v);
+    for (k = 0; k < DCTSIZE; k++) {
+      ws[k][half] = _mm_blendv_epi8(DESCALE4(v[k], CONST_BITS-PASS1_BITS),
+                                    dcval, allzero);
+    }
+  }
+
+  /* Pass 2: process rows from work array, store into output array. */
+  for (group = 0; group < 2; group++) {
+    const __m128i mask = _mm_set1_epi32(RANGE_MASK);
+    const __m128i wrap = _mm_set1_epi32((RANGE_MASK + 1) / 2);
+    const __m128i bias = _mm_set1_epi32((RANGE_MASK + 1) / 2 - CENTERJSAMPLE);
+    __m128i acbits, dcval, allzero;
+
+    for (k = 0; k < 4; k++) {
+      v[k] = ws[4*group + k][0];
+      v[k + 4] = ws[4*group + k][1];
+    }
+    TRANSPOSE4(v[0], v[1], v[2], v[3]);
+    TRANSPOSE4(v[4], v[5], v[6], v[7]);
+
+    /* Rows whose AC terms are all zero take the DC shortcut */
+    acbits = _mm_or_si128(_mm_or_si128(_mm_or_si128(v[1], v[2]),
+                                       _mm_or_si128(v[3], v[4])),
+                          _mm_or_si128(_mm_or_si128(v[5], v[6]), v[7]));
+    allzero = _mm_cmpeq_epi32(acbits, zero);
+    dcval = DESCALE4(v[0], PASS1_BITS+3);
+    idct_1d(v);
+
+    for (k = 0; k < DCTSIZE; k++) {
+      __m128i x = _mm_blendv_epi8(DESCALE4(v[k], CONST_BITS+PASS1_BITS+3),
+                                  dcval, allzero);
+      /* range_limit[x & RANGE_MASK]: wrap into [-512, 511], recenter,
+       * and let the packs below saturate to [0, MAXJSAMPLE] */
+      v[k] = _mm_sub_epi32(_mm_xor_si128(_mm_and_si128(x, mask), wrap), bias);
+    }
+
+    TRANSPOSE4(v[0], v[1], v[2], v[3]);
+    TRANSPOSE4(v[4], v[5], v[6], v[7]);
+    for (k = 0; k < 4; k++) {
+      __m128i row = _mm_packs_epi32(v[k], v[k + 4]);
+      _mm_storel_epi64((__m128i *) (output_buf[4*group + k] + output_col),
+                       _mm_packus_epi16(row, row));
+    }
+  }
+}
+
+GLOBAL(int)
+jsimd_can_idct_islow (void)
+{
+  if (DCTSIZE != 8 || sizeof(ISLOW_MULT_TYPE) != 4 || sizeof(JCOEF) != 2 ||
+      sizeof(JSAMPLE) != 1)
+    return FALSE;
+  return have_sse41();
+}
+
+
+/**************** YCbCr -> RGB conversion **************/
+
+/* Same fixed-point constants as jdcolor.c */
+
+#define SCALEBITS       16
+#define ONE_HALF        ((INT32) 1 << (SCALEBITS-1))
+#define FIX(x)          ((INT32) ((x) * (1L<<SCALEBITS) + 0.5))
+
+SIMD_TARGET GLOBAL(void)
+jsimd_ycc_rgb_convert (j_decompress_ptr cinfo,
+                       JSAMPIMAGE input_buf, JDIMENSION input_row,
+                       JSAMPARRAY output_buf, int num_rows)
+{
+  JDIMENSION num_cols = cinfo->output_width;
+  const __m128i center = _mm_set1_epi32(CENTERJSAMPLE);
+  const __m128i half = _mm_set1_epi32(ONE_HALF);
+  const __m128i cr_r = _mm_set1_epi32((int) FIX(1.40200));
+  const __m128i cb_b = _mm_set1_epi32((int) FIX(1.77200));
+  const __m128i cr_g = _mm_set1_epi32((int) - FIX(0.71414));
+  const __m128i cb_g = _mm_set1_epi32((int) - FIX(0.34414));
+  JSAMPLE rbuf[8], gbuf[8], bbuf[8];
+
+  while (--num_rows >= 0) {
+    JSAMPROW inptr0 = input_buf[0][input_row];
+    JSAMPROW inptr1 = input_buf[1][input_row];
+    JSAMPROW inptr2 = input_buf[2][input_row];
+    JSAMPROW outptr = *output_buf++;
+    JDIMENSION col = 0;
+    SHIFT_TEMPS
+    input_row++;
+
+    for (; col + 8 <= num_cols; col += 8) {
+      __m128i y8 = _mm_loadl_epi64((const __m128i *) (inptr0 + col));
+      __m128i cb8 = _mm_loadl_epi64((const __m128i *) (inptr1 + col));
+      __m128i cr8 = _mm_loadl_epi64((const __m128i *) (inptr2 + col));
+      __m128i r[2], g[2], b[2];
+      int h, i;
+
+      for (h = 0; h < 2; h++) {
+        __m128i y = _mm_cvtepu8_epi32(y8);
+        __m128i cb = _mm_sub_epi32(_mm_cvtepu8_epi32(cb8), center);
+        __m128i cr = _mm_sub_epi32(_mm_cvtepu8_epi32(cr8), center);
+        r[h] = _mm_add_epi32(y, _mm_srai_epi32(
+                   _mm_add_epi32(_mm_mullo_epi32(cr, cr_r), half), SCALEBITS));
+        g[h] = _mm_add_epi32(y, _mm_srai_epi32(
+                   _mm_add_epi32(_mm_add_epi32(_mm_mullo_epi32(cb, cb_g), half),
+                                 _mm_mullo_epi32(cr, cr_g)), SCALEBITS));
+        b[h] = _mm_add_epi32(y, _mm_srai_epi32(
+                   _mm_add_epi32(_mm_mullo_epi32(cb, cb_b), half), SCALEBITS));
+        y8 = _mm_srli_si128(y8, 4);
+        cb8 = _mm_srli_si128(cb8, 4);
+        cr8 = _mm_srli_si128(cr8, 4);
+      }
+      /* The saturating packs do the range limiting */
+      r[0] = _mm_packs_epi32(r[0], r[1]);
+      g[0] = _mm_packs_epi32(g[0], g[1]);
+      b[0] = _mm_packs_epi32(b[0], b[1]);
+      _mm_storel_epi64((__m128i *) rbuf, _mm_packus_epi16(r[0], r[0]));
+      _mm_storel_epi64((__m128i *) gbuf, _mm_packus_epi16(g[0], g[0]));
+      _mm_storel_epi64((__m128i *) bbuf, _mm_packus_epi16(b[0], b[0]));
+      for (i = 0; i < 8; i++) {
+        outptr[RGB_RED] = rbuf[i];
+        outptr[RGB_GREEN] = gbuf[i];
+        outptr[RGB_BLUE] = bbuf[i];
+        outptr += RGB_PIXELSIZE;
+      }
+    }
+
+    for (; col < num_cols; col++) {
+      JSAMPLE * range_limit = cinfo->sample_range_limit;
+      int y  = GETJSAMPLE(inptr0[col]);
+      INT32 cb = GETJSAMPLE(inptr1[col]) - CENTERJSAMPLE;
+      INT32 cr = GETJSAMPLE(inptr2[col]) - CENTERJSAMPLE;
+      outptr[RGB_RED] =   range_limit[y + (int)
+          RIGHT_SHIFT(FIX(1.40200) * cr + ONE_HALF, SCALEBITS)];
+      outptr[RGB_GREEN] = range_limit[y + (int)
+          RIGHT_SHIFT((- FIX(0.34414)) * cb + ONE_HALF +
+                      (- FIX(0.71414)) * cr, SCALEBITS)];
+      outptr[RGB_BLUE] =  range_limit[y + (int)
+          RIGHT_SHIFT(FIX(1.77200) * cb + ONE_HALF, SCALEBITS)];
+      outptr += RGB_PIXELSIZE;
+    }
+  }
+}
+
+GLOBAL(int)
+jsimd_can_ycc_rgb (void)
+{
+  if (sizeof(JSAMPLE) != 1)
+    return FALSE;
+  return have_sse41();
+}
+
+#else /* !JSIMD_SSE41 */
+
+GLOBAL(int)
+jsimd_can_idct_islow (void)
+{
+  return FALSE;
+}
+
+GLOBAL(void)
+jsimd_idct_islow (j_decompress_ptr cinfo, jpeg_component_info * compptr,
+                  JCOEFPTR coef_block,
+                  JSAMPARRAY output_buf, JDIMENSION output_col)
+{
+  jpeg_idct_islow(cinfo, compptr, coef_block, output_buf, output_col);
+}
+
+GLOBAL(int)
+jsimd_can_ycc_rgb (void)
+{
+  return FALSE;
+}
+
+GLOBAL(void)
+jsimd_ycc_rgb_convert (j_decompress_ptr cinfo,
+                       JSAMPIMAGE input_buf, JDIMENSION input_row,
+                       JSAMPARRAY output_buf, int num_rows)
+{
+  ERREXIT(cinfo, JERR_NOT_COMPILED);
+}
+
+#endif /* JSIMD_SSE41 */
@@ -0,0 +1,362 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#include "jni.h"
+#include "GlyphImageCache.h"
+
+/*
+ * The cache is split into NUM_SHARDS independently locked shards, each
+ * with its own hash table, LRU list and an equal part of the size
+ * limit, so that threads rendering different glyphs rarely contend for
+ * the same lock.  A lock is held only for the table walk and for
+ * copying one image in or out; rasterization happens outside of it.
+ */
+#define NUM_SHARDS          16
+#define BUCKETS_PER_SHARD   1024
+#define DEFAULT_CACHE_KB    4096
+
+#ifdef _WIN32
+typedef SRWLOCK CacheLock;
+#define CACHE_LOCK_INIT     SRWLOCK_INIT
+#define CacheLock_Lock(l)   AcquireSRWLockExclusive(l)
+#define CacheLock_Unlock(l) ReleaseSRWLockExclusive(l)
+#else
+typedef pthread_mutex_t CacheLock;
+#define CACHE_LOCK_INIT     PTHREAD_MUTEX_INITIALIZER
+#define CacheLock_Lock(l)   pthread_mutex_lock(l)
+#define CacheLock_Unlock(l) pthread_mutex_unlock(l)
+#endif
+
+#define CACHE_LOCK_INIT4 \
+    CACHE_LOCK_INIT, CACHE_LOCK_INIT, CACHE_LOCK_INIT, CACHE_LOCK_INIT
+
+typedef struct _CacheEntry CacheEntry;
+
+struct _CacheEntry {
+    // next entry in the same hash bucket
+    CacheEntry    *nextInBucket;
+    // neighbours in the shard's LRU list, most recently used first
+    CacheEntry    *prev;
+    CacheEntry    *next;
+    GlyphImageKey key;
+    unsigned int  hash;
+    size_t        size;
+    // the image bytes follow the entry
+    GlyphInfo     glyph;
+};
+
+typedef struct {
+    CacheEntry    *buckets[BUCKETS_PER_SHARD];
+    CacheEntry    *head;
+    CacheEntry    *tail;
+    size_t        bytes;
+    jlong         entries;
+    jlong         hits;
+    jlong         misses;
+    jlong         evictions;
+} CacheShard;
+
+static CacheLock shardLocks[NUM_SHARDS] = {
+    CACHE_LOCK_INIT4, CACHE_LOCK_INIT4, CACHE_LOCK_INIT4, CACHE_LOCK_INIT4
+};
+static CacheShard shards[NUM_SHARDS];
+
+static CacheLock globalLock = CACHE_LOCK_INIT;
+static jlong lastFontID = 0;
+
+/* limit per shard in bytes, (size_t) -1 until the config is read */
+static volatile size_t shardLimit = (size_t) -1;
+
+static void
+printStats(void)
+{
+    GlyphImageCacheStats stats;
+    jlong lookups;
+
+    GlyphImageCache_GetStats(&stats);
+    lookups = stats.hits + stats.misses;
+    fprintf(stderr,
+            "Glyph image cache: %lld hits, %lld misses (%.1f%% hit rate), "
+            "%lld evictions, %lld entries, %lld bytes\n",
+            (long long) stats.hits, (long long) stats.misses,
+            lookups > 0 ? 100.0 * stats.hits / lookups : 0.0,
+            (long long) stats.evictions, (long long) stats.entries,
+            (long long) stats.bytes);
+}
+
+static size_t
+getShardLimit(void)
+{
+    if (shardLimit == (size_t) -1) {
+        CacheLock_Lock(&globalLock);
+        if (shardLimit == (size_t) -1) {
+            char *env = getenv("J2D_GLYPH_CACHE_SIZE");
+            long kb = DEFAULT_CACHE_KB;
+
+            if (env != NULL) {
+                kb = atol(env);
+                if (kb < 0) {
+                    kb = 0;
+                }
+            }
+            if (kb > 0 && getenv("J2D_GLYPH_CACHE_STATS") != NULL) {
+                atexit(printStats);
+            }
+            shardLimit = ((size_t) kb * 1024) / NUM_SHARDS;
+        }
+        CacheLock_Unlock(&globalLock);
+    }
+    return shardLimit;
+}
+
+static unsigned int
+hashKey(const GlyphImageKey *key)
+{
+    const jint *p = (const jint *) key;
+    unsigned int h = 2166136261u;
+    size_t i;
+
+    for (i = 0; i < sizeof(GlyphImageKey) / sizeof(jint); i++) {
+        h = (h ^ (unsigned int) p[i]) * 16777619u;
+    }
+    h ^= h >> 15;
+    h *= 0x2c1b3c6du;
+    h ^= h >> 12;
+    return h;
+}
+
+#define SHARD_INDEX(h)  (((h) >> 24) % NUM_SHARDS)
+#define BUCKET_INDEX(h) ((h) & (BUCKETS_PER_SHARD - 1))
+
+static size_t
+imageSize(const GlyphInfo *glyph)
+{
+    return (glyph->image == NULL) ?
+        0 : (size_t) glyph->rowBytes * glyph->height;
+}
+
+static CacheEntry *
+findEntry(CacheShard *shard, const GlyphImageKey *key, unsigned int h)
+{
+    CacheEntry *e = shard->buckets[BUCKET_INDEX(h)];
+
+    while (e != NULL) {
+        if (e->hash == h && memcmp(&e->key, key, sizeof(*key)) == 0) {
+            return e;
+        }
+        e = e->nextInBucket;
+    }
+    return NULL;
+}
+
+static void
+unlinkLRU(CacheShard *shard, CacheEntry *e)
+{
+    if (e->prev != NULL) {
+        e->prev->next = e->next;
+    } else {
+        shard->head = e->next;
+    }
+    if (e->next != NULL) {
+        e->next->prev = e->prev;
+    } else {
+        shard->tail = e->prev;
+    }
+}
+
+static void
+linkLRUHead(CacheShard *shard, CacheEntry *e)
+{
+    e->prev = NULL;
+    e->next = shard->head;
+    if (shard->head != NULL) {
+        shard->head->prev = e;
+    } else {
+        shard->tail = e;
+    }
+    shard->head = e;
+}
+
+static void
+removeEntry(CacheShard *shard, CacheEntry *e)
+{
+    CacheEntry **pp = &shard->buckets[BUCKET_INDEX(e->hash)];
+
+    while (*pp != e) {
+        pp = &(*pp)->nextInBucket;
+    }
+    *pp = e->nextInBucket;
+    unlinkLRU(shard, e);
+    shard->bytes -= e->size;
+    shard->entries--;
+}
+
+jlong
+GlyphImageCache_FontID(jlong dataHash)
+{
+    jlong id;
+
+    if (dataHash != 0) {
+        // non-negative ids identify the font data
+        return (dataHash < 0) ? ~dataHash : dataHash;
+    }
+    // negative ids are unique to one scaler
+    CacheLock_Lock(&globalLock);
+    id = -(++lastFontID);
+    CacheLock_Unlock(&globalLock);
+    return id;
+}
+
+GlyphInfo *
+GlyphImageCache_Lookup(const GlyphImageKey *key)
+{
+    unsigned int h;
+    CacheShard *shard;
+    CacheLock *lock;
+    CacheEntry *e;
+    GlyphInfo *glyph = NULL;
+
+    if (getShardLimit() == 0) {
+        return NULL;
+    }
+
+    h = hashKey(key);
+    shard = &shards[SHARD_INDEX(h)];
+    lock = &shardLocks[SHARD_INDEX(h)];
+
+    CacheLock_Lock(lock);
+    e = findEntry(shard, key, h);
+    if (e != NULL) {
+        size_t isize = e->size - sizeof(CacheEntry);
+
+        glyph = (GlyphInfo *) malloc(sizeof(GlyphInfo) + isize);
+        if (glyph != NULL) {
+            *glyph = e->glyph;
+            if (isize != 0) {
+                glyph->image = (UInt8 *) glyph + sizeof(GlyphInfo);
+                memcpy(glyph->image, e + 1, isize);
+            }
+            if (shard->head != e) {
+                unlinkLRU(shard, e);
+                linkLRUHead(shard, e);
+            }
+            shard->hits++;
+        }
+    } else {
+        shard->misses++;
+    }
+    CacheLock_Unlock(lock);
+
+    return glyph;
+}
+
+void
+GlyphImageCache_Add(const GlyphImageKey *key, const GlyphInfo *glyph)
+{
+    size_t limit = getShardLimit();
+    size_t isize = imageSize(glyph);
+    size_t size = sizeof(CacheEntry) + isize;
+    unsigned int h;
+    CacheShard *shard;
+    CacheLock *lock;
+    CacheEntry *e, *evicted = NULL;
+
+    if (size > limit) {
+        return;
+    }
+    e = (CacheEntry *) malloc(size);
+    if (e == NULL) {
+        return;
+    }
+
+    h = hashKey(key);
+    e->key = *key;
+    e->hash = h;
+    e->size = size;
+    e->glyph = *glyph;
+    e->glyph.cellInfo = NULL;
+    e->glyph.managed = UNMANAGED_GLYPH;
+    e->glyph.image = NULL;
+    if (isize != 0) {
+        memcpy(e + 1, glyph->image, isize);
+    }
+
+    shard = &shards[SHARD_INDEX(h)];
+    lock = &shardLocks[SHARD_INDEX(h)];
+
+    CacheLock_Lock(lock);
+    if (findEntry(shard, key, h) != NULL) {
+        // another thread got here first
+        CacheLock_Unlock(lock);
+        free(e);
+        return;
+    }
+    e->nextInBucket = shard->buckets[BUCKET_INDEX(h)];
+    shard->buckets[BUCKET_INDEX(h)] = e;
+    linkLRUHead(shard, e);
+    shard->bytes += size;
+    shard->entries++;
+    while (shard->bytes > limit) {
+        CacheEntry *victim = shard->tail;
+        removeEntry(shard, victim);
+        victim->next = evicted;
+        evicted = victim;
+        shard->evictions++;
+    }
+    CacheLock_Unlock(lock);
+
+    while (evicted != NULL) {
+        CacheEntry *next = evicted->next;
+        free(evicted);
+        evicted = next;
+    }
+}
+
+JNIEXPORT void JNICALL
+GlyphImageCache_GetStats(GlyphImageCacheStats *stats)
+{
+    int i;
+
+    memset(stats, 0, sizeof(*stats));
+    for (i = 0; i < NUM_SHARDS; i++) {
+        CacheLock_Lock(&shardLocks[i]);
+        stats->hits      += shards[i].hits;
+        stats->misses    += shards[i].misses;
+        stats->evictions += shards[i].evictions;
+        stats->entries   += shards[i].entries;
+        stats->bytes     += (jlong) shards[i].bytes;
+        CacheLock_Unlock(&shardLocks[i]);
+    }
+}
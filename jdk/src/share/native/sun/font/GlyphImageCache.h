@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#ifndef GlyphImageCache_h_Included
+#define GlyphImageCache_h_Included
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "jni.h"
+#include "fontscalerdefs.h"
+
+/*
+ * Process-wide cache of rasterized glyph images.
+ *
+ * Each FileFontStrike keeps its own glyph images, so every strike that
+ * is created for a font, size, transform and rendering mode rasterizes
+ * its glyphs again - for example after the strike was collected, or
+ * when the same font file was loaded by Font.createFont more than once.
+ * The scaler consults this cache before it asks the rasterizer for an
+ * image and adds every image it produces to it.
+ *
+ * The cache owns its copies; a lookup hands out a freshly malloc'ed
+ * GlyphInfo that the caller frees as before, so the Java side
+ * ownership of glyph images is unchanged.  Entries are evicted in least
+ * recently used order once the cache exceeds its size limit.
+ *
+ * The size limit in kilobytes is read from the J2D_GLYPH_CACHE_SIZE
+ * environment variable (default 4096, 0 disables the cache).  If
+ * J2D_GLYPH_CACHE_STATS is set the hit and miss counts are printed to
+ * stderr when the process exits.
+ */
+
+typedef struct {
+    jlong  fontID;      /* see GlyphImageCache_FontID */
+    jint   glyphCode;
+    jint   ptsz;        /* size in 26.6 points */
+    jint   xx, xy, yx, yy; /* 16.16 glyph transform */
+    jint   aaType;
+    jint   fmType;
+    jint   flags;       /* bold, italic, embedded bitmaps, ... */
+} GlyphImageKey;
+
+typedef struct {
+    jlong  hits;
+    jlong  misses;
+    jlong  evictions;
+    jlong  entries;
+    jlong  bytes;
+} GlyphImageCacheStats;
+
+/*
+ * Returns an identifier for a font.  Fonts loaded from identical data
+ * get the same identifier when dataHash is non-zero; otherwise a
+ * process-unique identifier is handed out.
+ */
+jlong
+GlyphImageCache_FontID(jlong dataHash);
+
+/*
+ * Returns a copy of the cached image for the key, or NULL if there is
+ * none.  The copy is an UNMANAGED_GLYPH and belongs to the caller.
+ */
+GlyphInfo *
+GlyphImageCache_Lookup(const GlyphImageKey *key);
+
+/*
+ * Stores a copy of glyph under the key.  The glyph is not retained.
+ */
+void
+GlyphImageCache_Add(const GlyphImageKey *key, const GlyphInfo *glyph);
+
+JNIEXPORT void JNICALL
+GlyphImageCache_GetStats(GlyphImageCacheStats *stats);
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif /* GlyphImageCache_h_Included */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2003, 2013, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2003, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -133,12 +133,14 @@ typedef struct TTLayoutTableCacheEntry {
 typedef struct TTLayoutTableCache {
   TTLayoutTableCacheEntry entries[LAYOUTCACHE_ENTRIES];
   void* kernPairs;
+  void* shapingCache; /* recent nativeLayout results, see SunLayoutEngine */
 } TTLayoutTableCache;
 
 #include "sunfontids.h"
 
 JNIEXPORT extern TTLayoutTableCache* newLayoutTableCache();
 JNIEXPORT extern void freeLayoutTableCache(TTLayoutTableCache* ltc);
+JNIEXPORT extern void freeShapingCache(void* cache);
 
 /* If font is malformed then scaler context created by particular scaler
  * will be replaced by null scaler context.
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2007, 2019, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2007, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -44,8 +44,11 @@
 #include FT_LCD_FILTER_H
 #include FT_MODULE_H
 #include FT_BITMAP_H
+#include FT_TRUETYPE_TABLES_H
+#include FT_TRUETYPE_TAGS_H
 
 #include "fontscaler.h"
+#include "GlyphImageCache.h"
 
 #define  ftFixed1  (FT_Fixed) (1 << 16)
 #define  FloatToFTFixed(f) (FT_Fixed)((f) * (float)(ftFixed1))
@@ -83,6 +86,7 @@ typedef struct {
     TTLayoutTableCache* layoutTables;
 
     EmboldenGlyphSlotFunc* EmboldenGlyphSlot;
+    jlong fontID;     /* identifies the font in the glyph image cache */
 } FTScalerInfo;
 
 typedef struct FTScalerContext {
@@ -320,6 +324,7 @@ int FreetypeVersionCheck(FTScalerInfo *scalerInfo, FT_Int majorVersion,
 }
 
 static void EmboldenGlyphSlot(FT_GlyphSlot slot);
+static jlong fontDataHash(FTScalerInfo *scalerInfo, jint type);
 
 /*
  * Class:     sun_font_FreetypeFontScaler
@@ -447,9 +452,50 @@ Java_sun_font_FreetypeFontScaler_initNativeScaler(
         return 0;
     }
 
+    scalerInfo->fontID =
+        GlyphImageCache_FontID(fontDataHash(scalerInfo, type));
+
     return ptr_to_jlong(scalerInfo);
 }
 
+/* Fonts loaded more than once from the same data (e.g. Font.createFont
+   called repeatedly on one file) should share glyph images in the
+   glyph image cache, so the font is identified by its data: the whole
+   file for Type1 fonts, which is in memory anyway, and the whole-file
+   checksum from the 'head' table for sfnt fonts. Returns 0 if there is
+   no usable identity. */
+static jlong fontDataHash(FTScalerInfo *scalerInfo, jint type) {
+    FT_Face face = scalerInfo->face;
+    unsigned long long h = 0xcbf29ce484222325ULL;
+    FT_Byte head[12];
+    FT_ULong len = sizeof(head);
+    unsigned i;
+
+#define MIX(v) h = (h ^ (unsigned long long) (v)) * 0x100000001b3ULL
+
+    if (type == TYPE1_FROM_JAVA) {
+        for (i = 0; i < scalerInfo->fontDataLength; i++) {
+            MIX(scalerInfo->fontData[i]);
+        }
+    } else if (FT_IS_SFNT(face) &&
+               FT_Load_Sfnt_Table(face, TTAG_head, 0, head, &len) == 0 &&
+               len == sizeof(head)) {
+        MIX(((FT_UInt32) head[8] << 24) | (head[9] << 16) |
+            (head[10] << 8) | head[11]);
+    } else {
+        return 0;
+    }
+    MIX(type);
+    MIX(scalerInfo->fileSize);
+    MIX(face->face_index);
+    MIX(face->num_glyphs);
+    MIX(face->units_per_EM);
+
+#undef MIX
+
+    return (jlong) h;
+}
+
 static double euclidianDistance(double a, double b) {
     if (a < 0) a=-a;
     if (b < 0) b=-b;
@@ -901,6 +947,7 @@ static jlong
     int glyph_index;
     int renderFlags = FT_LOAD_DEFAULT, target;
     FT_GlyphSlot ftglyph;
+    GlyphImageKey key;
 
     FTScalerContext* context =
         (FTScalerContext*) jlong_to_ptr(pScalerContext);
@@ -911,6 +958,26 @@ static jlong
         return ptr_to_jlong(getNullGlyphImage());
     }
 
+    if (renderImage) {
+        memset(&key, 0, sizeof(key));
+        key.fontID = scalerInfo->fontID;
+        key.glyphCode = glyphCode;
+        key.ptsz = context->ptsz;
+        key.xx = (jint) context->transform.xx;
+        key.xy = (jint) context->transform.xy;
+        key.yx = (jint) context->transform.yx;
+        key.yy = (jint) context->transform.yy;
+        key.aaType = context->aaType;
+        key.fmType = context->fmType;
+        key.flags = (context->doBold ? 1 : 0) |
+                    (context->doItalize ? 2 : 0) |
+                    (context->useSbits ? 4 : 0);
+        glyphInfo = GlyphImageCache_Lookup(&key);
+        if (glyphInfo != NULL) {
+            return ptr_to_jlong(glyphInfo);
+        }
+    }
+
     error = setupFTContext(env, font2D, scalerInfo, context);
     if (error) {
         invalidateJavaScaler(env, scaler, scalerInfo);
@@ -1078,10 +1145,14 @@ static jlong
             glyphInfo->rowBytes *=3;
         } else {
             free(glyphInfo);
-            glyphInfo = getNullGlyphImage();
+            return ptr_to_jlong(getNullGlyphImage());
         }
     }
 
+    if (renderImage) {
+        GlyphImageCache_Add(&key, glyphInfo);
+    }
+
     return ptr_to_jlong(glyphInfo);
 }
 
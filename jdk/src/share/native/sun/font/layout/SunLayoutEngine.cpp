@@ -26,6 +26,7 @@
 
 #include <jni_util.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "FontInstanceAdapter.h"
 #include "LayoutEngine.h"
@@ -53,6 +54,182 @@ static jfieldID gvdIndicesFID = 0;
 #define TYPO_RTL 0x80000000
 #define TYPO_MASK 0x7
 
+/*
+ * Shaping cache.
+ *
+ * Applications that lay out the same labels over and over shape each of
+ * them from scratch through the OpenType tables.  Every font keeps the
+ * results of its most recent nativeLayout calls in a small direct-mapped
+ * table hanging off its TTLayoutTableCache, so it goes away with the
+ * font.  A result is reused only when every input to the layout is the
+ * same: the strike (held weakly, so it supplies the advances), the
+ * transform, script, language, layout flags, the text and run offsets,
+ * and the start point.  Glyphs and char indices are stored without
+ * gmask and baseIndex, which are applied when they are copied out.
+ */
+#define SHAPING_CACHE_SIZE      256   /* entries per font, power of 2 */
+#define SHAPING_CACHE_MAX_CHARS 256   /* longer runs are not cached */
+
+struct ShapingResult {
+    le_int32 glyphCount;
+    /* followed by glyphCount glyphs, glyphCount char indices and
+       (glyphCount + 1) * 2 positions */
+
+    le_uint32* glyphs() const { return (le_uint32*)(this + 1); }
+    le_int32* indices() const { return (le_int32*)(glyphs() + glyphCount); }
+    float* positions() const { return (float*)(indices() + glyphCount); }
+
+    static size_t sizeFor(le_int32 glyphCount) {
+        return sizeof(ShapingResult) +
+            glyphCount * (sizeof(le_uint32) + sizeof(le_int32)) +
+            (glyphCount + 1) * 2 * sizeof(float);
+    }
+};
+
+struct ShapingKey {
+    float mat[4];
+    jint script;
+    jint lang;
+    jint typoFlags;
+    jint offset;      /* start - min */
+    jint count;       /* limit - start */
+    jint len;         /* max - min */
+    jfloat x;
+    jfloat y;
+};
+
+struct ShapingEntry {
+    jweak strike;
+    le_uint32 hash;
+    ShapingKey key;
+    ShapingResult* result;
+    /* followed by key.len chars */
+
+    jchar* chars() const { return (jchar*)(this + 1); }
+};
+
+struct ShapingCache {
+    ShapingEntry* entries[SHAPING_CACHE_SIZE];
+};
+
+static JavaVM* jvm = NULL;
+static jobject shapingCacheLock = NULL;
+
+static le_uint32 hashRun(const ShapingKey* key, const jchar* chars) {
+    const unsigned char* p = (const unsigned char*)key;
+    le_uint32 h = 2166136261u;
+    size_t i;
+    for (i = 0; i < sizeof(ShapingKey); i++) {
+        h = (h ^ p[i]) * 16777619u;
+    }
+    for (i = 0; i < (size_t)key->len; i++) {
+        h = (h ^ chars[i]) * 16777619u;
+    }
+    return h ^ (h >> 16);
+}
+
+static void deleteEntry(JNIEnv* env, ShapingEntry* entry) {
+    if (env != NULL) {
+        env->DeleteWeakGlobalRef(entry->strike);
+    }
+    free(entry->result);
+    free(entry);
+}
+
+/*
+ * Returns a copy of the cached result for the run, or NULL.
+ */
+static ShapingResult* lookupShaping(JNIEnv* env, TTLayoutTableCache* ltc,
+                                    jobject strike, const ShapingKey* key,
+                                    const jchar* chars, le_uint32 hash) {
+    ShapingResult* copy = NULL;
+    if (env->MonitorEnter(shapingCacheLock) != JNI_OK) {
+        return NULL;
+    }
+    ShapingCache* cache = (ShapingCache*)ltc->shapingCache;
+    if (cache != NULL) {
+        ShapingEntry* entry = cache->entries[hash & (SHAPING_CACHE_SIZE - 1)];
+        if (entry != NULL && entry->hash == hash &&
+            memcmp(&entry->key, key, sizeof(ShapingKey)) == 0 &&
+            memcmp(entry->chars(), chars, key->len * sizeof(jchar)) == 0 &&
+            env->IsSameObject(entry->strike, strike))
+        {
+            size_t size = ShapingResult::sizeFor(entry->result->glyphCount);
+            copy = (ShapingResult*)malloc(size);
+            if (copy != NULL) {
+                memcpy(copy, entry->result, size);
+            }
+        }
+    }
+    env->MonitorExit(shapingCacheLock);
+    return copy;
+}
+
+/*
+ * Stores the result for the run.  The cache takes ownership of result
+ * in either case.
+ */
+static void storeShaping(JNIEnv* env, TTLayoutTableCache* ltc,
+                         jobject strike, const ShapingKey* key,
+                         const jchar* chars, le_uint32 hash,
+                         ShapingResult* result) {
+    ShapingEntry* entry =
+        (ShapingEntry*)malloc(sizeof(ShapingEntry) + key->len * sizeof(jchar));
+    if (entry == NULL) {
+        free(result);
+        return;
+    }
+    entry->strike = env->NewWeakGlobalRef(strike);
+    if (entry->strike == NULL) {
+        free(entry);
+        free(result);
+        return;
+    }
+    entry->hash = hash;
+    entry->key = *key;
+    entry->result = result;
+    memcpy(entry->chars(), chars, key->len * sizeof(jchar));
+
+    ShapingEntry* old = NULL;
+    if (env->MonitorEnter(shapingCacheLock) != JNI_OK) {
+        deleteEntry(env, entry);
+        return;
+    }
+    if (ltc->shapingCache == NULL) {
+        ltc->shapingCache = calloc(1, sizeof(ShapingCache));
+    }
+    ShapingCache* cache = (ShapingCache*)ltc->shapingCache;
+    if (cache != NULL) {
+        ShapingEntry** slot = &cache->entries[hash & (SHAPING_CACHE_SIZE - 1)];
+        old = *slot;
+        *slot = entry;
+    } else {
+        old = entry;
+    }
+    env->MonitorExit(shapingCacheLock);
+
+    if (old != NULL) {
+        deleteEntry(env, old);
+    }
+}
+
+/*
+ * Called by freeLayoutTableCache when the font goes away.
+ */
+JNIEXPORT void freeShapingCache(void* ptr) {
+    ShapingCache* cache = (ShapingCache*)ptr;
+    JNIEnv* env = NULL;
+    if (jvm != NULL) {
+        jvm->GetEnv((void**)&env, JNI_VERSION_1_2);
+    }
+    for (int i = 0; i < SHAPING_CACHE_SIZE; i++) {
+        if (cache->entries[i] != NULL) {
+            deleteEntry(env, cache->entries[i]);
+        }
+    }
+    free(cache);
+}
+
 JNIEXPORT void JNICALL
 Java_sun_font_SunLayoutEngine_initGVIDs
     (JNIEnv *env, jclass cls) {
@@ -63,9 +240,21 @@ Java_sun_font_SunLayoutEngine_initGVIDs
     CHECK_NULL(gvdGlyphsFID = env->GetFieldID(gvdClass, "_glyphs", "[I"));
     CHECK_NULL(gvdPositionsFID = env->GetFieldID(gvdClass, "_positions", "[F"));
     gvdIndicesFID = env->GetFieldID(gvdClass, "_indices", "[I");
+
+    // the shaping cache stays disabled if any of this fails
+    if (env->GetJavaVM(&jvm) == 0) {
+        jclass objClass = env->FindClass("java/lang/Object");
+        if (objClass != NULL) {
+            jobject lock = env->AllocObject(objClass);
+            if (lock != NULL) {
+                shapingCacheLock = env->NewGlobalRef(lock);
+            }
+        }
+        env->ExceptionClear();
+    }
 }
 
-int putGV(JNIEnv* env, jint gmask, jint baseIndex, jobject gvdata, const LayoutEngine* engine, int glyphCount) {
+int putGV(JNIEnv* env, jint gmask, jint baseIndex, jobject gvdata, const ShapingResult* result) {
     int count = env->GetIntField(gvdata, gvdCountFID);
     if (count < 0) {
       JNU_ThrowInternalError(env, "count negative");
@@ -78,6 +267,7 @@ int putGV(JNIEnv* env, jint gmask, jint baseIndex, jobject gvdata, const LayoutE
       return 0;
     }
     jint capacity = env->GetArrayLength(glyphArray);
+    int glyphCount = result->glyphCount;
     if (count + glyphCount > capacity) {
       JNU_ThrowArrayIndexOutOfBoundsException(env, "");
       return 0;
@@ -103,10 +293,14 @@ int putGV(JNIEnv* env, jint gmask, jint baseIndex, jobject gvdata, const LayoutE
       if (positions) {
         jint* indices = (jint*)env->GetPrimitiveArrayCritical(inxArray, NULL);
         if (indices) {
-          LEErrorCode status = (LEErrorCode)0;
-          engine->getGlyphs(glyphs + count, gmask, status);
-          engine->getGlyphPositions(positions + (count * 2), status);
-          engine->getCharIndices((le_int32*)(indices + count), baseIndex, status);
+          const le_uint32* rglyphs = result->glyphs();
+          const le_int32* rindices = result->indices();
+          for (int i = 0; i < glyphCount; i++) {
+            glyphs[count + i] = rglyphs[i] | gmask;
+            indices[count + i] = rindices[i] + baseIndex;
+          }
+          memcpy(positions + (count * 2), result->positions(),
+                 (glyphCount + 1) * 2 * sizeof(float));
 
           countDelta = glyphCount;
 
@@ -143,13 +337,6 @@ JNIEXPORT void JNICALL Java_sun_font_SunLayoutEngine_nativeLayout
     //  fprintf(stderr, "nl font: %x strike: %x script: %d\n", font2d, strike, script); fflush(stderr);
   float mat[4];
   env->GetFloatArrayRegion(matrix, 0, 4, mat);
-  FontInstanceAdapter fia(env, font2d, strike, mat, 72, 72, (le_int32) upem, (TTLayoutTableCache *) layoutTables);
-  LEErrorCode success = LE_NO_ERROR;
-  LayoutEngine *engine = LayoutEngine::layoutEngineFactory(&fia, script, lang, typo_flags & TYPO_MASK, success);
-  if (engine == NULL) {
-    env->SetIntField(gvdata, gvdCountFID, -1); // flag failure
-    return;
-  }
 
   if (min < 0) min = 0; if (max < min) max = min; /* defensive coding */
   // have to copy, yuck, since code does upcalls now.  this will be soooo slow
@@ -172,28 +359,86 @@ JNIEXPORT void JNICALL Java_sun_font_SunLayoutEngine_nativeLayout
 
   jfloat x, y;
   getFloat(env, pt, x, y);
-  jboolean rtl = (typo_flags & TYPO_RTL) != 0;
-  int glyphCount = engine->layoutChars(chars, start - min, limit - start, len, rtl, x, y, success);
-    // fprintf(stderr, "sle nl len %d -> gc: %d\n", len, glyphCount); fflush(stderr);
-
-  engine->getGlyphPosition(glyphCount, x, y, success);
-
-   // fprintf(stderr, "layout glyphs: %d x: %g y: %g\n", glyphCount, x, y); fflush(stderr);
-   if (LE_FAILURE(success)) {
-       env->SetIntField(gvdata, gvdCountFID, -1); // flag failure
-   } else {
-      if (putGV(env, gmask, baseIndex, gvdata, engine, glyphCount)) {
-          if (!(env->ExceptionCheck())) {
+
+  TTLayoutTableCache* ltc = (TTLayoutTableCache *) layoutTables;
+  jboolean useCache = shapingCacheLock != NULL && ltc != NULL &&
+                      strike != NULL && len <= SHAPING_CACHE_MAX_CHARS &&
+                      !env->ExceptionCheck();
+  ShapingKey key;
+  le_uint32 hash = 0;
+  ShapingResult* result = NULL;
+  if (useCache) {
+    memset(&key, 0, sizeof(key));
+    memcpy(key.mat, mat, sizeof(mat));
+    key.script = script;
+    key.lang = lang;
+    key.typoFlags = typo_flags;
+    key.offset = start - min;
+    key.count = limit - start;
+    key.len = len;
+    key.x = x;
+    key.y = y;
+    hash = hashRun(&key, chars);
+    result = lookupShaping(env, ltc, strike, &key, chars, hash);
+  }
+
+  jboolean cached = result != NULL;
+  if (!cached) {
+    FontInstanceAdapter fia(env, font2d, strike, mat, 72, 72, (le_int32) upem, ltc);
+    LEErrorCode success = LE_NO_ERROR;
+    LayoutEngine *engine = LayoutEngine::layoutEngineFactory(&fia, script, lang, typo_flags & TYPO_MASK, success);
+    if (engine == NULL) {
+      env->SetIntField(gvdata, gvdCountFID, -1); // flag failure
+      if (chars != buffer) {
+        free(chars);
+      }
+      return;
+    }
+
+    jboolean rtl = (typo_flags & TYPO_RTL) != 0;
+    int glyphCount = engine->layoutChars(chars, start - min, limit - start, len, rtl, x, y, success);
+      // fprintf(stderr, "sle nl len %d -> gc: %d\n", len, glyphCount); fflush(stderr);
+
+    if (LE_SUCCESS(success) && glyphCount >= 0) {
+      result = (ShapingResult*)malloc(ShapingResult::sizeFor(glyphCount));
+      if (result != NULL) {
+        result->glyphCount = glyphCount;
+        engine->getGlyphs(result->glyphs(), 0, success);
+        engine->getGlyphPositions(result->positions(), success);
+        engine->getCharIndices(result->indices(), 0, success);
+      }
+    }
+
+    if (LE_FAILURE(success) || result == NULL) {
+      env->SetIntField(gvdata, gvdCountFID, -1); // flag failure
+      free(result);
+      result = NULL;
+    }
+
+    delete engine;
+  }
+
+  if (result != NULL) {
+    float* positions = result->positions();
+    x = positions[result->glyphCount * 2];
+    y = positions[result->glyphCount * 2 + 1];
+
+     // fprintf(stderr, "layout glyphs: %d x: %g y: %g\n", result->glyphCount, x, y); fflush(stderr);
+    if (putGV(env, gmask, baseIndex, gvdata, result)) {
+      if (!(env->ExceptionCheck())) {
         // !!! hmmm, could use current value in positions array of GVData...
         putFloat(env, pt, x, y);
       }
-   }
-   }
+    }
+
+    if (useCache && !cached && !env->ExceptionCheck()) {
+      storeShaping(env, ltc, strike, &key, chars, hash, result);
+    } else {
+      free(result);
+    }
+  }
 
   if (chars != buffer) {
     free(chars);
   }
-
-  delete engine;
-
 }
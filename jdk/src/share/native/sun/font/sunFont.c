@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2007, 2013, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2007, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -357,6 +357,7 @@ JNIEXPORT void freeLayoutTableCache(TTLayoutTableCache* ltc) {
       if(ltc->entries[i].ptr) free (ltc->entries[i].ptr);
     }
     if (ltc->kernPairs) free(ltc->kernPairs);
+    if (ltc->shapingCache) freeShapingCache(ltc->shapingCache);
     free(ltc);
   }
 }
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2007, 2013, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2007, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -26,6 +26,10 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <memory.h>
+#ifndef _WIN32
+#include <pthread.h>
+#include <unistd.h>
+#endif
 #include "sun_java2d_cmm_lcms_LCMS.h"
 #include "jni_util.h"
 #include "Trace.h"
@@ -89,6 +93,14 @@ cmsInt32Number TransportValue32(cmsInt32Number Value)
 
 #define ERR_MSG_SIZE 256
 
+/*
+ * Large images are converted in horizontal stripes on several threads.
+ * Each stripe covers at least STRIPE_MIN_PIXELS pixels, and at most
+ * MAX_STRIPES stripes are used for one conversion.
+ */
+#define STRIPE_MIN_PIXELS (64 * 1024)
+#define MAX_STRIPES 8
+
 #ifdef _MSC_VER
 # ifndef snprintf
 #       define snprintf  _snprintf
@@ -562,6 +574,161 @@ void releaseILData (JNIEnv *env, void* pData, jint dataType,
     }
 }
 
+typedef struct convertStripe_s {
+    cmsHTRANSFORM trans;
+    char* inputRow;
+    char* outputRow;
+    int srcNextRowOffset;
+    int dstNextRowOffset;
+    int width;
+    int rows;
+    jboolean atOnce;
+} convertStripe_t, *convertStripe_p;
+
+static void convertStripe(convertStripe_p s) {
+    char* inputRow = s->inputRow;
+    char* outputRow = s->outputRow;
+    int i;
+
+    if (s->atOnce) {
+        cmsDoTransform(s->trans, inputRow, outputRow, s->width * s->rows);
+    } else {
+        for (i = 0; i < s->rows; i++) {
+            cmsDoTransform(s->trans, inputRow, outputRow, s->width);
+            inputRow += s->srcNextRowOffset;
+            outputRow += s->dstNextRowOffset;
+        }
+    }
+}
+
+#ifndef _WIN32
+static void* convertStripeThread(void* arg) {
+    convertStripe((convertStripe_p)arg);
+    return NULL;
+}
+#endif
+
+/*
+ * Returns the number of stripes to use for a conversion of the given
+ * size. The transform itself is reentrant: transforms keep no state
+ * that is modified while pixels are converted.
+ */
+static int getStripeCount(int width, int height) {
+#ifdef _WIN32
+    return 1;
+#else
+    static int maxStripes = 0;
+    jlong pixels = (jlong)width * height;
+    int n;
+
+    if (maxStripes == 0) {
+        long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+        maxStripes = (ncpu < 1) ? 1 : (ncpu > MAX_STRIPES ? MAX_STRIPES
+                                                          : (int)ncpu);
+    }
+    n = (int)(pixels / STRIPE_MIN_PIXELS);
+    if (n > maxStripes) {
+        n = maxStripes;
+    }
+    return (n < 1) ? 1 : n;
+#endif
+}
+
+/* Bytes per pixel of a chunky (non planar) format */
+static int getPixelBytes(cmsUInt32Number format) {
+    int bytes = T_BYTES(format);
+
+    // For double, the T_BYTES field is zero
+    if (bytes == 0) {
+        bytes = sizeof(cmsFloat64Number);
+    }
+    return bytes * (T_CHANNELS(format) + T_EXTRA(format));
+}
+
+/*
+ * Converts the image, splitting it into stripes that are converted on
+ * separate threads when the image is large enough. Whole-image layouts
+ * are split by pixels, the other layouts by rows.
+ */
+static void convertImage(cmsHTRANSFORM sTrans, char* inputRow,
+                         char* outputRow, int srcNextRowOffset,
+                         int dstNextRowOffset, int width, int height,
+                         jboolean atOnce) {
+    convertStripe_t stripes[MAX_STRIPES];
+#ifndef _WIN32
+    pthread_t threads[MAX_STRIPES];
+    int started[MAX_STRIPES];
+#endif
+    cmsUInt32Number inFormat = cmsGetTransformInputFormat(sTrans);
+    cmsUInt32Number outFormat = cmsGetTransformOutputFormat(sTrans);
+    int count, units, unit, perStripe, extra, i;
+    int inStep, outStep;
+
+    if (atOnce) {
+        if (T_PLANAR(inFormat) || T_PLANAR(outFormat)) {
+            count = 1;
+        } else {
+            count = getStripeCount(width, height);
+        }
+        units = width * height;
+        inStep = getPixelBytes(inFormat);
+        outStep = getPixelBytes(outFormat);
+    } else {
+        count = getStripeCount(width, height);
+        units = height;
+        inStep = srcNextRowOffset;
+        outStep = dstNextRowOffset;
+    }
+    if (count > units) {
+        count = units;
+    }
+
+    stripes[0].trans = sTrans;
+    stripes[0].inputRow = inputRow;
+    stripes[0].outputRow = outputRow;
+    stripes[0].srcNextRowOffset = srcNextRowOffset;
+    stripes[0].dstNextRowOffset = dstNextRowOffset;
+    stripes[0].atOnce = atOnce;
+
+    if (count <= 1) {
+        stripes[0].width = atOnce ? units : width;
+        stripes[0].rows = atOnce ? 1 : height;
+        convertStripe(&stripes[0]);
+        return;
+    }
+
+    perStripe = units / count;
+    extra = units % count;
+    unit = 0;
+    for (i = 0; i < count; i++) {
+        int n = perStripe + (i < extra ? 1 : 0);
+
+        stripes[i] = stripes[0];
+        stripes[i].inputRow = inputRow + (size_t)unit * inStep;
+        stripes[i].outputRow = outputRow + (size_t)unit * outStep;
+        stripes[i].width = atOnce ? n : width;
+        stripes[i].rows = atOnce ? 1 : n;
+        unit += n;
+    }
+
+#ifndef _WIN32
+    // The first stripe is converted on the calling thread. A stripe whose
+    // thread can not be started is converted there as well.
+    for (i = 1; i < count; i++) {
+        started[i] = (pthread_create(&threads[i], NULL, convertStripeThread,
+                                     &stripes[i]) == 0);
+    }
+    convertStripe(&stripes[0]);
+    for (i = 1; i < count; i++) {
+        if (started[i]) {
+            pthread_join(threads[i], NULL);
+        } else {
+            convertStripe(&stripes[i]);
+        }
+    }
+#endif
+}
+
 /*
  * Class:     sun_java2d_cmm_lcms_LCMS
  * Method:    colorConvert
@@ -573,7 +740,7 @@ JNIEXPORT void JNICALL Java_sun_java2d_cmm_lcms_LCMS_colorConvert
     cmsHTRANSFORM sTrans = NULL;
     int srcDType, dstDType;
     int srcOffset, srcNextRowOffset, dstOffset, dstNextRowOffset;
-    int width, height, i;
+    int width, height;
     void* inputBuffer;
     void* outputBuffer;
     char* inputRow;
@@ -620,15 +787,9 @@ JNIEXPORT void JNICALL Java_sun_java2d_cmm_lcms_LCMS_colorConvert
     inputRow = (char*)inputBuffer + srcOffset;
     outputRow = (char*)outputBuffer + dstOffset;
 
-    if (srcAtOnce && dstAtOnce) {
-        cmsDoTransform(sTrans, inputRow, outputRow, width * height);
-    } else {
-        for (i = 0; i < height; i++) {
-            cmsDoTransform(sTrans, inputRow, outputRow, width);
-            inputRow += srcNextRowOffset;
-            outputRow += dstNextRowOffset;
-        }
-    }
+    convertImage(sTrans, inputRow, outputRow, srcNextRowOffset,
+                 dstNextRowOffset, width, height,
+                 (jboolean)(srcAtOnce && dstAtOnce));
 
     releaseILData(env, inputBuffer, srcDType, srcData);
     releaseILData(env, outputBuffer, dstDType, dstData);
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2000, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2000, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -24,9 +24,30 @@
  */
 
 #include "GraphicsPrimitiveMgr.h"
+#include "ParallelRender.h"
 
 #include "sun_java2d_loops_FillRect.h"
 
+typedef struct {
+    SurfaceDataRasInfo  *pRasInfo;
+    NativePrimitive     *pPrim;
+    CompositeInfo       *pCompInfo;
+    jint                pixel;
+} FillRectArgs;
+
+static void
+fillRectBand(void *pArg, jint y1, jint y2)
+{
+    FillRectArgs *pArgs = (FillRectArgs *) pArg;
+    SurfaceDataRasInfo *pRasInfo = pArgs->pRasInfo;
+
+    (*pArgs->pPrim->funcs.fillrect)(pRasInfo,
+                                    pRasInfo->bounds.x1, y1,
+                                    pRasInfo->bounds.x2, y2,
+                                    pArgs->pixel, pArgs->pPrim,
+                                    pArgs->pCompInfo);
+}
+
 /*
  * Class:     sun_java2d_loops_FillRect
  * Method:    FillRect
@@ -78,10 +99,16 @@ Java_sun_java2d_loops_FillRect_FillRect
     {
         sdOps->GetRasInfo(env, sdOps, &rasInfo);
         if (rasInfo.rasBase) {
-            (*pPrim->funcs.fillrect)(&rasInfo,
-                                     rasInfo.bounds.x1, rasInfo.bounds.y1,
-                                     rasInfo.bounds.x2, rasInfo.bounds.y2,
-                                     pixel, pPrim, &compInfo);
+            FillRectArgs args;
+            args.pRasInfo = &rasInfo;
+            args.pPrim = pPrim;
+            args.pCompInfo = &compInfo;
+            args.pixel = pixel;
+            ParallelRender_RunBands(fillRectBand, &args,
+                                    rasInfo.bounds.y1, rasInfo.bounds.y2,
+                                    ParallelRender_GetBandCount(
+                                        rasInfo.bounds.x2 - rasInfo.bounds.x1,
+                                        rasInfo.bounds.y2 - rasInfo.bounds.y1));
         }
         SurfaceData_InvokeRelease(env, sdOps, &rasInfo);
     }
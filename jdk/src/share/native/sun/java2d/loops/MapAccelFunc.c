@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2003, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2003, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -23,7 +23,90 @@
  * questions.
  */
 
+#include <stdio.h>
+#include <stdlib.h>
+
 #include "GraphicsPrimitiveMgr.h"
+#include "sse2_Loops.h"
+
+#ifdef J2D_SSE2_LOOPS
+
+typedef struct {
+    AnyFunc  *func_c;
+    AnyFunc  *func_sse2;
+} AnyFunc_pair;
+
+#define DEF_FUNC(x)    \
+    void x();
+
+#define ADD_FUNC(x)    \
+    { (AnyFunc *) & x, (AnyFunc *) & SSE2_FUNC(x) }
+
+DEF_FUNC(IntArgbToIntArgbPreSrcOverMaskBlit)
+DEF_FUNC(IntArgbPreToIntArgbPreSrcOverMaskBlit)
+DEF_FUNC(IntArgbToIntRgbSrcOverMaskBlit)
+DEF_FUNC(IntArgbPreToIntRgbSrcOverMaskBlit)
+DEF_FUNC(IntArgbPreSrcOverMaskFill)
+DEF_FUNC(IntRgbSrcOverMaskFill)
+DEF_FUNC(IntArgbToByteGrayConvert)
+DEF_FUNC(ByteGrayToIntArgbConvert)
+DEF_FUNC(ByteGrayToIntArgbPreConvert)
+
+static AnyFunc_pair sse2_func_pair_array[] = {
+    ADD_FUNC(IntArgbToIntArgbPreSrcOverMaskBlit),
+    ADD_FUNC(IntArgbPreToIntArgbPreSrcOverMaskBlit),
+    ADD_FUNC(IntArgbToIntRgbSrcOverMaskBlit),
+    ADD_FUNC(IntArgbPreToIntRgbSrcOverMaskBlit),
+    ADD_FUNC(IntArgbPreSrcOverMaskFill),
+    ADD_FUNC(IntRgbSrcOverMaskFill),
+    ADD_FUNC(IntArgbToByteGrayConvert),
+    ADD_FUNC(ByteGrayToIntArgbConvert),
+    /* ByteGray pixels are opaque, so IntArgbPre stores the same value */
+    { (AnyFunc *) & ByteGrayToIntArgbPreConvert,
+      (AnyFunc *) & SSE2_FUNC(ByteGrayToIntArgbConvert) },
+};
+
+#define NUM_SSE2_FUNCS sizeof(sse2_func_pair_array)/sizeof(AnyFunc_pair)
+
+static int initialized;
+static int usesse2;
+
+/*
+ * This function returns a pointer to the SSE2 version of the
+ * indicated C function if there is one and the CPU supports it.
+ * Setting the environment variable J2D_USE_SSE2_LOOPS to "false"
+ * keeps the C loops.
+ */
+AnyFunc *MapAccelFunction(AnyFunc *c_func) {
+    jint i;
+
+    if (!initialized) {
+        usesse2 = sse2Supported();
+        if (usesse2) {
+            char *sse2_env = getenv("J2D_USE_SSE2_LOOPS");
+            if (sse2_env != 0) {
+                switch (*sse2_env) {
+                case 'F':
+                    fprintf(stderr, "SSE2 loops disabled\n");
+                case 'f':
+                    usesse2 = JNI_FALSE;
+                    break;
+                }
+            }
+        }
+        initialized = 1;
+    }
+    if (usesse2) {
+        for (i = 0; i < NUM_SSE2_FUNCS; i++) {
+            if (sse2_func_pair_array[i].func_c == c_func) {
+                return sse2_func_pair_array[i].func_sse2;
+            }
+        }
+    }
+    return c_func;
+}
+
+#else /* J2D_SSE2_LOOPS */
 
 /*
  * This is a dummy function that satisfies the MapAccelFunction
@@ -35,3 +118,5 @@
 AnyFunc *MapAccelFunction(AnyFunc *c_func) {
     return c_func;
 }
+
+#endif /* J2D_SSE2_LOOPS */
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include <stdlib.h>
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#include "ParallelRender.h"
+
+/*
+ * Each band covers at least BAND_MIN_PIXELS pixels so that the thread
+ * start-up cost stays small next to the work, and no operation uses
+ * more than MAX_BANDS bands.
+ */
+#define BAND_MIN_PIXELS (128 * 1024)
+#define MAX_BANDS       64
+
+#ifndef _WIN32
+
+typedef struct {
+    BandFunc    *pFunc;
+    void        *pArg;
+    jint        y1;
+    jint        y2;
+} BandInfo;
+
+static void *
+runBand(void *arg)
+{
+    BandInfo *pBand = (BandInfo *) arg;
+
+    (*pBand->pFunc)(pBand->pArg, pBand->y1, pBand->y2);
+    return NULL;
+}
+
+static jint
+getMaxBands(void)
+{
+    static jint maxBands = 0;
+
+    if (maxBands == 0) {
+        char *env = getenv("J2D_RENDER_THREADS");
+        jint n = 1;
+
+        if (env != NULL) {
+            long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+            n = atoi(env);
+            if (n > ncpu) {
+                n = (jint) ncpu;
+            }
+            if (n > MAX_BANDS) {
+                n = MAX_BANDS;
+            }
+            if (n < 1) {
+                n = 1;
+            }
+        }
+        maxBands = n;
+    }
+    return maxBands;
+}
+
+#endif /* !_WIN32 */
+
+jint
+ParallelRender_GetBandCount(jint width, jint height)
+{
+#ifdef _WIN32
+    return 1;
+#else
+    jint maxBands = getMaxBands();
+    jlong n;
+
+    if (maxBands <= 1 || width <= 0 || height <= 1) {
+        return 1;
+    }
+    n = (((jlong) width) * height) / BAND_MIN_PIXELS;
+    if (n > maxBands) {
+        n = maxBands;
+    }
+    if (n > height) {
+        n = height;
+    }
+    return (n < 1) ? 1 : (jint) n;
+#endif
+}
+
+void
+ParallelRender_RunBands(BandFunc *pFunc, void *pArg,
+                        jint y1, jint y2, jint numBands)
+{
+#ifndef _WIN32
+    BandInfo bands[MAX_BANDS];
+    pthread_t threads[MAX_BANDS];
+    jboolean started[MAX_BANDS];
+    jint height = y2 - y1;
+    jint perBand, extra, y, i;
+
+    if (numBands > MAX_BANDS) {
+        numBands = MAX_BANDS;
+    }
+    if (numBands > height) {
+        numBands = height;
+    }
+    if (numBands > 1) {
+        perBand = height / numBands;
+        extra = height % numBands;
+        y = y1;
+        for (i = 0; i < numBands; i++) {
+            bands[i].pFunc = pFunc;
+            bands[i].pArg = pArg;
+            bands[i].y1 = y;
+            y += perBand + (i < extra ? 1 : 0);
+            bands[i].y2 = y;
+        }
+        for (i = 1; i < numBands; i++) {
+            started[i] =
+                (pthread_create(&threads[i], NULL, runBand, &bands[i]) == 0);
+        }
+        runBand(&bands[0]);
+        for (i = 1; i < numBands; i++) {
+            if (started[i]) {
+                pthread_join(threads[i], NULL);
+            } else {
+                /* Could not start a thread; do that band here */
+                runBand(&bands[i]);
+            }
+        }
+        return;
+    }
+#endif
+    (*pFunc)(pArg, y1, y2);
+}
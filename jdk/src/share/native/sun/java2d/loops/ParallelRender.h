@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#ifndef ParallelRender_h_Included
+#define ParallelRender_h_Included
+
+#include "jni.h"
+
+/*
+ * Optional multi-threaded execution of the software loops.
+ *
+ * A primitive that touches a large area of the destination can split
+ * the rows it visits into horizontal bands and have them processed on
+ * worker threads.  The call returns only after every band is done, so
+ * primitives still complete in the order Graphics2D issues them.  Each
+ * band writes a disjoint set of destination rows and the loops keep no
+ * state outside their arguments, so the result is the same as a serial
+ * run.
+ *
+ * The mode is off unless the environment variable J2D_RENDER_THREADS
+ * is set to the maximum number of threads (including the caller) that
+ * a primitive may use.
+ */
+
+/* Processes destination rows y1 <= y < y2 for the given argument. */
+typedef void (BandFunc)(void *pArg, jint y1, jint y2);
+
+/*
+ * Returns the number of bands an operation covering width*height
+ * destination pixels should be split into; 1 means run it serially.
+ */
+extern jint ParallelRender_GetBandCount(jint width, jint height);
+
+/*
+ * Calls pFunc for numBands consecutive bands covering rows y1 to y2,
+ * running all but the first on worker threads, and waits for them.
+ */
+extern void ParallelRender_RunBands(BandFunc *pFunc, void *pArg,
+                                    jint y1, jint y2, jint numBands);
+
+#endif /* ParallelRender_h_Included */
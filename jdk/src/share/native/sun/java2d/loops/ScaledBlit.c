@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2001, 2013, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2001, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -28,6 +28,7 @@
 #include "jni_util.h"
 #include "GraphicsPrimitiveMgr.h"
 #include "Region.h"
+#include "ParallelRender.h"
 
 #include "sun_java2d_loops_ScaledBlit.h"
 
@@ -257,6 +258,120 @@ refine(jint intorigin, jdouble dblorigin, jint tilesize,
     return dstloc;
 }
 
+typedef struct {
+    void                *pSrc;
+    SurfaceDataRasInfo  *pSrcInfo;
+    SurfaceDataRasInfo  *pDstInfo;
+    NativePrimitive     *pPrim;
+    CompositeInfo       *pCompInfo;
+    SurfaceDataBounds   span;
+    jint                sxinc, syinc, shift;
+    jint                idx1, idy1;
+    jdouble             ddx1, ddy1;
+    jdouble             scalex, scaley;
+    jint                tilesize;
+    jboolean            onetile;
+} ScaleSpanArgs;
+
+/*
+ * Calls the scaling loop for the rows y1 <= y < y2 of the current clip
+ * span.  The loops start their dither pattern at pDstInfo->bounds.y1
+ * on every call, so a call that starts at a row a serial call would
+ * have reached part way through is given bounds shifted by the rows
+ * skipped, which keeps the output identical however the span is split.
+ */
+static void
+scaleSpan(void *pArg, jint y1, jint y2)
+{
+    ScaleSpanArgs *pArgs = (ScaleSpanArgs *) pArg;
+    SurfaceDataRasInfo dstInfo = *pArgs->pDstInfo;
+    SurfaceDataBounds *pSpan = &pArgs->span;
+    jint idx1 = pArgs->idx1;
+    jint idy1 = pArgs->idy1;
+    jint sxinc = pArgs->sxinc;
+    jint syinc = pArgs->syinc;
+    jint tilesize = pArgs->tilesize;
+    void *pDst;
+
+    if (pArgs->onetile) {
+        jint tsxloc = (jint) SRCLOC(idx1, pArgs->ddx1, pArgs->scalex);
+        jint tsyloc = (jint) SRCLOC(idy1, pArgs->ddy1, pArgs->scaley);
+
+        if (y1 > idy1) {
+            tsyloc += syinc * (y1 - idy1);
+        }
+        if (pSpan->x1 > idx1) {
+            tsxloc += sxinc * (pSpan->x1 - idx1);
+        }
+
+        dstInfo.bounds.y1 += y1 - pSpan->y1;
+        pDst = PtrCoord(dstInfo.rasBase,
+                        pSpan->x1, dstInfo.pixelStride,
+                        y1, dstInfo.scanStride);
+        (*pArgs->pPrim->funcs.scaledblit)(pArgs->pSrc, pDst,
+                                          pSpan->x2-pSpan->x1, y2-y1,
+                                          tsxloc, tsyloc,
+                                          sxinc, syinc, pArgs->shift,
+                                          pArgs->pSrcInfo, &dstInfo,
+                                          pArgs->pPrim, pArgs->pCompInfo);
+    } else {
+        /* Break each clip span into tiles for better accuracy. */
+        jint tilex, tiley;
+        jint sxloc, syloc;
+        jint x1, ty1, x2, ty2;
+
+        for (tiley = TILESTART(y1, idy1, tilesize);
+             tiley < y2;
+             tiley += tilesize)
+        {
+            /* Clip span to Y range of current tile */
+            ty1 = tiley;
+            ty2 = tiley + tilesize;
+            if (ty1 < pSpan->y1) ty1 = pSpan->y1;
+            if (ty2 > y2) ty2 = y2;
+            dstInfo.bounds.y1 = pArgs->pDstInfo->bounds.y1;
+            if (ty1 < y1) {
+                dstInfo.bounds.y1 += y1 - ty1;
+                ty1 = y1;
+            }
+
+            /* Find scaled source coordinate of first pixel */
+            syloc = (jint) SRCLOC(tiley, pArgs->ddy1, pArgs->scaley);
+            if (ty1 > tiley) {
+                syloc += syinc * (ty1 - tiley);
+            }
+
+            for (tilex = TILESTART(pSpan->x1, idx1, tilesize);
+                 tilex < pSpan->x2;
+                 tilex += tilesize)
+            {
+                /* Clip span to X range of current tile */
+                x1 = tilex;
+                x2 = tilex + tilesize;
+                if (x1 < pSpan->x1) x1 = pSpan->x1;
+                if (x2 > pSpan->x2) x2 = pSpan->x2;
+
+                /* Find scaled source coordinate of first pixel */
+                sxloc = (jint) SRCLOC(tilex, pArgs->ddx1, pArgs->scalex);
+                if (x1 > tilex) {
+                    sxloc += sxinc * (x1 - tilex);
+                }
+
+                pDst = PtrCoord(dstInfo.rasBase,
+                                x1, dstInfo.pixelStride,
+                                ty1, dstInfo.scanStride);
+                (*pArgs->pPrim->funcs.scaledblit)(pArgs->pSrc, pDst,
+                                                  x2-x1, ty2-ty1,
+                                                  sxloc, syloc,
+                                                  sxinc, syinc, pArgs->shift,
+                                                  pArgs->pSrcInfo, &dstInfo,
+                                                  pArgs->pPrim,
+                                                  pArgs->pCompInfo);
+            }
+        }
+    }
+}
+
 /*
  * Class:     sun_java2d_loops_ScaledBlit
  * Method:    Scale
@@ -434,92 +549,39 @@ Java_sun_java2d_loops_ScaledBlit_Scale
         srcOps->GetRasInfo(env, srcOps, &srcInfo);
         dstOps->GetRasInfo(env, dstOps, &dstInfo);
         if (srcInfo.rasBase && dstInfo.rasBase) {
-            SurfaceDataBounds span;
             void *pSrc = PtrCoord(srcInfo.rasBase,
                                   sx1, srcInfo.pixelStride,
                                   sy1, srcInfo.scanStride);
 
             Region_IntersectBounds(&clipInfo, &dstInfo.bounds);
-            Region_StartIteration(env, &clipInfo);
-            if (tilesize >= (ddx2 - ddx1) &&
-                tilesize >= (ddy2 - ddy1))
-            {
-                /* Do everything in one tile */
-                jint sxloc = (jint) SRCLOC(idx1, ddx1, scalex);
-                jint syloc = (jint) SRCLOC(idy1, ddy1, scaley);
-                while (Region_NextIteration(&clipInfo, &span)) {
-                    jint tsxloc = sxloc;
-                    jint tsyloc = syloc;
-                    void *pDst;
+            ScaleSpanArgs args;
 
-                    if (span.y1 > idy1) {
-                        tsyloc += syinc * (span.y1 - idy1);
-                    }
-                    if (span.x1 > idx1) {
-                        tsxloc += sxinc * (span.x1 - idx1);
-                    }
+            args.pSrc = pSrc;
+            args.pSrcInfo = &srcInfo;
+            args.pDstInfo = &dstInfo;
+            args.pPrim = pPrim;
+            args.pCompInfo = &compInfo;
+            args.sxinc = sxinc;
+            args.syinc = syinc;
+            args.shift = shift;
+            args.idx1 = idx1;
+            args.idy1 = idy1;
+            args.ddx1 = ddx1;
+            args.ddy1 = ddy1;
+            args.scalex = scalex;
+            args.scaley = scaley;
+            args.tilesize = tilesize;
+            /* Do everything in one tile if it covers the operation */
+            args.onetile = (tilesize >= (ddx2 - ddx1) &&
+                            tilesize >= (ddy2 - ddy1));
 
-                    pDst = PtrCoord(dstInfo.rasBase,
-                                    span.x1, dstInfo.pixelStride,
-                                    span.y1, dstInfo.scanStride);
-                    (*pPrim->funcs.scaledblit)(pSrc, pDst,
-                                               span.x2-span.x1, span.y2-span.y1,
-                                               tsxloc, tsyloc,
-                                               sxinc, syinc, shift,
-                                               &srcInfo, &dstInfo,
-                                               pPrim, &compInfo);
-                }
-            } else {
-                /* Break each clip span into tiles for better accuracy. */
-                while (Region_NextIteration(&clipInfo, &span)) {
-                    jint tilex, tiley;
-                    jint sxloc, syloc;
-                    jint x1, y1, x2, y2;
-                    void *pDst;
-
-                    for (tiley = TILESTART(span.y1, idy1, tilesize);
-                         tiley < span.y2;
-                         tiley += tilesize)
-                    {
-                        /* Clip span to Y range of current tile */
-                        y1 = tiley;
-                        y2 = tiley + tilesize;
-                        if (y1 < span.y1) y1 = span.y1;
-                        if (y2 > span.y2) y2 = span.y2;
-
-                        /* Find scaled source coordinate of first pixel */
-                        syloc = (jint) SRCLOC(tiley, ddy1, scaley);
-                        if (y1 > tiley) {
-                            syloc += syinc * (y1 - tiley);
-                        }
-
-                        for (tilex = TILESTART(span.x1, idx1, tilesize);
-                             tilex < span.x2;
-                             tilex += tilesize)
-                        {
-                            /* Clip span to X range of current tile */
-                            x1 = tilex;
-                            x2 = tilex + tilesize;
-                            if (x1 < span.x1) x1 = span.x1;
-                            if (x2 > span.x2) x2 = span.x2;
-
-                            /* Find scaled source coordinate of first pixel */
-                            sxloc = (jint) SRCLOC(tilex, ddx1, scalex);
-                            if (x1 > tilex) {
-                                sxloc += sxinc * (x1 - tilex);
-                            }
-
-                            pDst = PtrCoord(dstInfo.rasBase,
-                                            x1, dstInfo.pixelStride,
-                                            y1, dstInfo.scanStride);
-                            (*pPrim->funcs.scaledblit)(pSrc, pDst, x2-x1, y2-y1,
-                                                       sxloc, syloc,
-                                                       sxinc, syinc, shift,
-                                                       &srcInfo, &dstInfo,
-                                                       pPrim, &compInfo);
-                        }
-                    }
-                }
+            Region_StartIteration(env, &clipInfo);
+            while (Region_NextIteration(&clipInfo, &args.span)) {
+                ParallelRender_RunBands(scaleSpan, &args,
+                                        args.span.y1, args.span.y2,
+                                        ParallelRender_GetBandCount(
+                                            args.span.x2 - args.span.x1,
+                                            args.span.y2 - args.span.y1));
             }
             Region_EndIteration(env, &clipInfo);
         }
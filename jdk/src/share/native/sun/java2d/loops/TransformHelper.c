@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2004, 2014, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2004, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -29,6 +29,7 @@
 
 #include "GraphicsPrimitiveMgr.h"
 #include "Region.h"
+#include "ParallelRender.h"
 
 #include "sun_java2d_loops_TransformHelper.h"
 #include "java_awt_image_AffineTransformOp.h"
@@ -241,6 +242,108 @@ calculateEdges(jint *pEdges,
     }
 }
 
+typedef struct {
+    SurfaceDataRasInfo  *pSrcInfo;
+    SurfaceDataRasInfo  *pDstInfo;
+    NativePrimitive     *pMaskBlitPrim;
+    CompositeInfo       *pCompInfo;
+    TransformHelperFunc *pHelperFunc;
+    TransformInterpFunc *pInterpFunc;
+    jint                *pEdges;
+    SurfaceDataBounds   span;
+    jint                maxlinepix;
+    jlong               xbase, ybase;
+    jlong               dxdxlong, dydxlong;
+    jlong               dxdylong, dydylong;
+} TransformRowsArgs;
+
+/*
+ * Transforms the rows y1 <= y < y2 of the current clip span, one
+ * scanline at a time, using a private intermediate buffer so that
+ * separate bands of a span can be processed concurrently.
+ */
+static void
+transformRows(void *pArg, jint y1, jint y2)
+{
+    TransformRowsArgs *pArgs = (TransformRowsArgs *) pArg;
+    SurfaceDataRasInfo *pDstInfo = pArgs->pDstInfo;
+    SurfaceDataBounds *pSpan = &pArgs->span;
+    jint *pEdges = pArgs->pEdges;
+    jint maxlinepix = pArgs->maxlinepix;
+    jlong dxdxlong = pArgs->dxdxlong;
+    jlong dydxlong = pArgs->dydxlong;
+    jlong rowxlong, rowylong;
+    jint dx1, dx2, dy1;
+    void *pDst;
+    union {
+        jlong align;
+        jint data[LINE_SIZE];
+    } rgb;
+
+    dy1 = y1;
+    rowxlong = pArgs->xbase + (dy1 - pDstInfo->bounds.y1) * pArgs->dxdylong;
+    rowylong = pArgs->ybase + (dy1 - pDstInfo->bounds.y1) * pArgs->dydylong;
+
+    while (dy1 < y2) {
+        jlong xlong, ylong;
+
+        /* Note - process at most one scanline at a time. */
+
+        dx1 = pEdges[(dy1 - pDstInfo->bounds.y1) * 2 + 2];
+        dx2 = pEdges[(dy1 - pDstInfo->bounds.y1) * 2 + 3];
+        if (dx1 < pSpan->x1) dx1 = pSpan->x1;
+        if (dx2 > pSpan->x2) dx2 = pSpan->x2;
+
+        /* All pixels from dx1 to dx2 have centers in bounds */
+        while (dx1 < dx2) {
+            /* Can process at most one buffer full at a time */
+            jint numpix = dx2 - dx1;
+            if (numpix > maxlinepix) {
+                numpix = maxlinepix;
+            }
+
+            xlong =
+                rowxlong + ((dx1 - pDstInfo->bounds.x1) * dxdxlong);
+            ylong =
+                rowylong + ((dx1 - pDstInfo->bounds.x1) * dydxlong);
+
+            /* Get IntArgbPre pixel data from source */
+            (*pArgs->pHelperFunc)(pArgs->pSrcInfo,
+                                  rgb.data, numpix,
+                                  xlong, dxdxlong,
+                                  ylong, dydxlong);
+
+            /* Interpolate result pixels if needed */
+            if (pArgs->pInterpFunc) {
+                (*pArgs->pInterpFunc)(rgb.data, numpix,
+                                      FractOfLong(xlong-LongOneHalf),
+                                      FractOfLong(dxdxlong),
+                                      FractOfLong(ylong-LongOneHalf),
+                                      FractOfLong(dydxlong));
+            }
+
+            /* Store/Composite interpolated pixels into dest */
+            pDst = PtrCoord(pDstInfo->rasBase,
+                            dx1, pDstInfo->pixelStride,
+                            dy1, pDstInfo->scanStride);
+            (*pArgs->pMaskBlitPrim->funcs.maskblit)(pDst, rgb.data,
+                                                    0, 0, 0,
+                                                    numpix, 1,
+                                                    pDstInfo, pArgs->pSrcInfo,
+                                                    pArgs->pMaskBlitPrim,
+                                                    pArgs->pCompInfo);
+
+            /* Increment to next buffer worth of input pixels */
+            dx1 += maxlinepix;
+        }
+
+        /* Increment to next scanline */
+        rowxlong += pArgs->dxdylong;
+        rowylong += pArgs->dydylong;
+        dy1++;
+    }
+}
+
 static void
 Transform_SafeHelper(JNIEnv *env,
                      SurfaceDataOps *srcOps,
@@ -440,7 +543,7 @@ Java_sun_java2d_loops_TransformHelper_Transform
                                  &clipInfo, &itxInfo, rgb.data, pEdges,
                                  dxoff, dyoff, sx2-sx1, sy2-sy1);
         } else {
-            SurfaceDataBounds span;
+            TransformRowsArgs args;
             jlong dxdxlong, dydxlong;
             jlong dxdylong, dydylong;
             jlong xbase, ybase;
@@ -455,74 +558,28 @@ Java_sun_java2d_loops_TransformHelper_Transform
             calculateEdges(pEdges, &dstInfo.bounds, &itxInfo,
                            xbase, ybase, sx2-sx1, sy2-sy1);
 
-            Region_StartIteration(env, &clipInfo);
-            while (Region_NextIteration(&clipInfo, &span)) {
-                jlong rowxlong, rowylong;
-                void *pDst;
-
-                dy1 = span.y1;
-                dy2 = span.y2;
-                rowxlong = xbase + (dy1 - dstInfo.bounds.y1) * dxdylong;
-                rowylong = ybase + (dy1 - dstInfo.bounds.y1) * dydylong;
-
-                while (dy1 < dy2) {
-                    jlong xlong, ylong;
-
-                    /* Note - process at most one scanline at a time. */
-
-                    dx1 = pEdges[(dy1 - dstInfo.bounds.y1) * 2 + 2];
-                    dx2 = pEdges[(dy1 - dstInfo.bounds.y1) * 2 + 3];
-                    if (dx1 < span.x1) dx1 = span.x1;
-                    if (dx2 > span.x2) dx2 = span.x2;
-
-                    /* All pixels from dx1 to dx2 have centers in bounds */
-                    while (dx1 < dx2) {
-                        /* Can process at most one buffer full at a time */
-                        jint numpix = dx2 - dx1;
-                        if (numpix > maxlinepix) {
-                            numpix = maxlinepix;
-                        }
-
-                        xlong =
-                            rowxlong + ((dx1 - dstInfo.bounds.x1) * dxdxlong);
-                        ylong =
-                            rowylong + ((dx1 - dstInfo.bounds.x1) * dydxlong);
-
-                        /* Get IntArgbPre pixel data from source */
-                        (*pHelperFunc)(&srcInfo,
-                                       rgb.data, numpix,
-                                       xlong, dxdxlong,
-                                       ylong, dydxlong);
-
-                        /* Interpolate result pixels if needed */
-                        if (pInterpFunc) {
-                            (*pInterpFunc)(rgb.data, numpix,
-                                           FractOfLong(xlong-LongOneHalf),
-                                           FractOfLong(dxdxlong),
-                                           FractOfLong(ylong-LongOneHalf),
-                                           FractOfLong(dydxlong));
-                        }
-
-                        /* Store/Composite interpolated pixels into dest */
-                        pDst = PtrCoord(dstInfo.rasBase,
-                                        dx1, dstInfo.pixelStride,
-                                        dy1, dstInfo.scanStride);
-                        (*pMaskBlitPrim->funcs.maskblit)(pDst, rgb.data,
-                                                         0, 0, 0,
-                                                         numpix, 1,
-                                                         &dstInfo, &srcInfo,
-                                                         pMaskBlitPrim,
-                                                         &compInfo);
-
-                        /* Increment to next buffer worth of input pixels */
-                        dx1 += maxlinepix;
-                    }
+            args.pSrcInfo = &srcInfo;
+            args.pDstInfo = &dstInfo;
+            args.pMaskBlitPrim = pMaskBlitPrim;
+            args.pCompInfo = &compInfo;
+            args.pHelperFunc = pHelperFunc;
+            args.pInterpFunc = pInterpFunc;
+            args.pEdges = pEdges;
+            args.maxlinepix = maxlinepix;
+            args.xbase = xbase;
+            args.ybase = ybase;
+            args.dxdxlong = dxdxlong;
+            args.dydxlong = dydxlong;
+            args.dxdylong = dxdylong;
+            args.dydylong = dydylong;
 
-                    /* Increment to next scanline */
-                    rowxlong += dxdylong;
-                    rowylong += dydylong;
-                    dy1++;
-                }
+            Region_StartIteration(env, &clipInfo);
+            while (Region_NextIteration(&clipInfo, &args.span)) {
+                ParallelRender_RunBands(transformRows, &args,
+                                        args.span.y1, args.span.y2,
+                                        ParallelRender_GetBandCount(
+                                            args.span.x2 - args.span.x1,
+                                            args.span.y2 - args.span.y1));
             }
             Region_EndIteration(env, &clipInfo);
         }
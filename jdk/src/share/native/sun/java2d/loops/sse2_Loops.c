@@ -0,0 +1,498 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * SSE2 versions of the SrcOver MaskBlit and MaskFill loops for the
+ * IntArgbPre and IntRgb destinations and of the IntArgb <-> ByteGray
+ * conversions.  Pixels are widened to 16-bit lanes, two per register,
+ * and every multiply is the exact MUL8 of AlphaMath.c, so results are
+ * bit-identical to the loops generated from AlphaMacros.h and
+ * LoopMacros.h.  Pixel groups the vector code cannot reproduce (the
+ * component sums of an invalid premultiplied source can exceed 255 and
+ * spill into the neighbouring field) and row tails are handled by
+ * scalar code that mirrors the macros.
+ */
+
+#include <string.h>
+
+#include "sse2_Loops.h"
+
+#ifdef J2D_SSE2_LOOPS
+
+#include <cpuid.h>
+#include <emmintrin.h>
+
+#include "LoopMacros.h"
+
+#define SSE2_TARGET __attribute__((target("sse2")))
+
+jboolean sse2Supported(void)
+{
+    unsigned int eax, ebx, ecx, edx;
+
+    return (__get_cpuid(1, &eax, &ebx, &ecx, &edx) &&
+            (edx & bit_SSE2) != 0) ? JNI_TRUE : JNI_FALSE;
+}
+
+/* MUL8(a, b) == ((a * b + 128) + ((a * b + 128) >> 8)) >> 8 for 0..255 */
+SSE2_TARGET static inline __m128i
+mul8(__m128i a, __m128i b)
+{
+    __m128i t = _mm_add_epi16(_mm_mullo_epi16(a, b), _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+}
+
+/* Copy the alpha lane of each of the two pixels into its color lanes */
+SSE2_TARGET static inline __m128i
+spreadAlpha(__m128i v)
+{
+    return _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, 0xff), 0xff);
+}
+
+/* Widen four mask bytes to two registers of per-pixel lanes */
+SSE2_TARGET static inline void
+loadMask4(const jubyte *pMask, __m128i *lo, __m128i *hi)
+{
+    jint m;
+    __m128i v;
+
+    memcpy(&m, pMask, sizeof(m));
+    v = _mm_unpacklo_epi8(_mm_cvtsi32_si128(m), _mm_setzero_si128());
+    v = _mm_unpacklo_epi16(v, v);
+    *lo = _mm_unpacklo_epi32(v, v);
+    *hi = _mm_unpackhi_epi32(v, v);
+}
+
+/*
+ * One pixel of DEFINE_SRCOVER_MASKBLIT with the 4ByteArgb strategy.
+ * pathA already includes the extra alpha.
+ */
+static inline void
+srcOverPixel(jint *pDst, jint srcPix, jint pathA,
+             jboolean srcPre, jboolean dstRgb)
+{
+    jint resA = MUL8(pathA, ((juint) srcPix) >> 24);
+    jint srcF, resR, resG, resB;
+
+    if (resA == 0) {
+        return;
+    }
+    srcF = srcPre ? pathA : resA;
+    resR = (srcPix >> 16) & 0xff;
+    resG = (srcPix >>  8) & 0xff;
+    resB = (srcPix >>  0) & 0xff;
+    if (resA < 0xff) {
+        jint dstPix = pDst[0];
+        jint dstF = 0xff - resA;
+        jint dstA = dstRgb ? 0xff : ((juint) dstPix) >> 24;
+        dstA = MUL8(dstF, dstA);
+        if (dstRgb) {
+            dstF = dstA;
+        }
+        resA += dstA;
+        resR = MUL8(dstF, (dstPix >> 16) & 0xff) + MUL8(srcF, resR);
+        resG = MUL8(dstF, (dstPix >>  8) & 0xff) + MUL8(srcF, resG);
+        resB = MUL8(dstF, (dstPix >>  0) & 0xff) + MUL8(srcF, resB);
+    } else if (srcF < 0xff) {
+        resR = MUL8(srcF, resR);
+        resG = MUL8(srcF, resG);
+        resB = MUL8(srcF, resB);
+    }
+    if (dstRgb) {
+        pDst[0] = (((resR << 8) | resG) << 8) | resB;
+    } else {
+        pDst[0] = (((((resA << 8) | resR) << 8) | resG) << 8) | resB;
+    }
+}
+
+/*
+ * Two pixels of srcOverPixel() in 16-bit lanes.  Returns the result
+ * lanes and, in *pResA, the per-pixel result alpha before the
+ * destination contribution (zero means the pixel is left alone).
+ */
+SSE2_TARGET static inline __m128i
+srcOver2(__m128i s, __m128i d, __m128i pathA, __m128i *pResA,
+         jboolean srcPre, jboolean dstRgb)
+{
+    const __m128i alphaLanes = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+    __m128i resA = mul8(pathA, spreadAlpha(s));
+    __m128i srcF = srcPre ? pathA : resA;
+    __m128i dstF = _mm_sub_epi16(_mm_set1_epi16(0xff), resA);
+    __m128i srcT;
+
+    if (dstRgb) {
+        d = _mm_or_si128(d, _mm_and_si128(alphaLanes, _mm_set1_epi16(0xff)));
+    }
+    srcT = mul8(srcF, s);
+    srcT = _mm_or_si128(_mm_andnot_si128(alphaLanes, srcT),
+                        _mm_and_si128(alphaLanes, resA));
+    *pResA = resA;
+    return _mm_add_epi16(mul8(dstF, d), srcT);
+}
+
+SSE2_TARGET static inline void
+srcOverMaskBlit(void *dstBase, void *srcBase,
+                jubyte *pMask, jint maskOff, jint maskScan,
+                jint width, jint height,
+                SurfaceDataRasInfo *pDstInfo,
+                SurfaceDataRasInfo *pSrcInfo,
+                CompositeInfo *pCompInfo,
+                jboolean srcPre, jboolean dstRgb)
+{
+    jint extraA = (jint)(pCompInfo->details.extraAlpha * 255.0 + 0.5);
+    jint srcScan = pSrcInfo->scanStride;
+    jint dstScan = pDstInfo->scanStride;
+    jint *pSrc = (jint *) srcBase;
+    jint *pDst = (jint *) dstBase;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i max = _mm_set1_epi16(0xff);
+    const __m128i vExtraA = _mm_set1_epi16((short) extraA);
+    const __m128i rgbMask = _mm_set1_epi32(0x00ffffff);
+
+    if (pMask) {
+        pMask += maskOff;
+    }
+    do {
+        jint x = 0;
+
+        /*
+         * The C loop finishes each pixel before loading the next, so
+         * a row whose source and destination overlap by less than a
+         * vector must stay scalar.
+         */
+        if (pSrc == pDst ||
+            (jubyte *) pSrc >= (jubyte *) (pDst + width) ||
+            (jubyte *) pDst >= (jubyte *) (pSrc + width))
+        {
+            for (; x + 4 <= width; x += 4) {
+                __m128i pathLo, pathHi, resALo, resAHi;
+                __m128i s, d, outLo, outHi, skip, res;
+
+                if (pMask) {
+                    jint m;
+                    memcpy(&m, pMask + x, sizeof(m));
+                    if (m == 0) {
+                        continue;
+                    }
+                    loadMask4(pMask + x, &pathLo, &pathHi);
+                    pathLo = mul8(pathLo, vExtraA);
+                    pathHi = mul8(pathHi, vExtraA);
+                } else {
+                    pathLo = pathHi = vExtraA;
+                }
+                s = _mm_loadu_si128((const __m128i *) (pSrc + x));
+                d = _mm_loadu_si128((const __m128i *) (pDst + x));
+                outLo = srcOver2(_mm_unpacklo_epi8(s, zero),
+                                 _mm_unpacklo_epi8(d, zero),
+                                 pathLo, &resALo, srcPre, dstRgb);
+                outHi = srcOver2(_mm_unpackhi_epi8(s, zero),
+                                 _mm_unpackhi_epi8(d, zero),
+                                 pathHi, &resAHi, srcPre, dstRgb);
+                if (_mm_movemask_epi8(_mm_or_si128(_mm_cmpgt_epi16(outLo, max),
+                                                   _mm_cmpgt_epi16(outHi, max))))
+                {
+                    jint i;
+                    for (i = x; i < x + 4; i++) {
+                        jint pathA = pMask ? MUL8(pMask[i], extraA) : extraA;
+                        if (pathA) {
+                            srcOverPixel(pDst + i, pSrc[i], pathA,
+                                         srcPre, dstRgb);
+                        }
+                    }
+                    continue;
+                }
+                res = _mm_packus_epi16(outLo, outHi);
+                if (dstRgb) {
+                    res = _mm_and_si128(res, rgbMask);
+                }
+                skip = _mm_packs_epi16(_mm_cmpeq_epi16(resALo, zero),
+                                       _mm_cmpeq_epi16(resAHi, zero));
+                res = _mm_or_si128(_mm_and_si128(skip, d),
+                                   _mm_andnot_si128(skip, res));
+                _mm_storeu_si128((__m128i *) (pDst + x), res);
+            }
+        }
+        for (; x < width; x++) {
+            jint pathA = pMask ? pMask[x] : 0xff;
+            if (pathA) {
+                srcOverPixel(pDst + x, pSrc[x], MUL8(pathA, extraA),
+                             srcPre, dstRgb);
+            }
+        }
+        pSrc = PtrAddBytes(pSrc, srcScan);
+        pDst = PtrAddBytes(pDst, dstScan);
+        if (pMask) {
+            pMask += maskScan;
+        }
+    } while (--height > 0);
+}
+
+#define DEFINE_SSE2_SRCOVER_MASKBLIT(SRC, DST, SRCPRE, DSTRGB) \
+SSE2_TARGET void SSE2_FUNC(NAME_SRCOVER_MASKBLIT(SRC, DST)) \
+    (void *dstBase, void *srcBase, \
+     jubyte *pMask, jint maskOff, jint maskScan, \
+     jint width, jint height, \
+     SurfaceDataRasInfo *pDstInfo, \
+     SurfaceDataRasInfo *pSrcInfo, \
+     NativePrimitive *pPrim, \
+     CompositeInfo *pCompInfo) \
+{ \
+    srcOverMaskBlit(dstBase, srcBase, pMask, maskOff, maskScan, \
+                    width, height, pDstInfo, pSrcInfo, pCompInfo, \
+                    SRCPRE, DSTRGB); \
+}
+
+DEFINE_SSE2_SRCOVER_MASKBLIT(IntArgb, IntArgbPre, JNI_FALSE, JNI_FALSE)
+DEFINE_SSE2_SRCOVER_MASKBLIT(IntArgbPre, IntArgbPre, JNI_TRUE, JNI_FALSE)
+DEFINE_SSE2_SRCOVER_MASKBLIT(IntArgb, IntRgb, JNI_FALSE, JNI_TRUE)
+DEFINE_SSE2_SRCOVER_MASKBLIT(IntArgbPre, IntRgb, JNI_TRUE, JNI_TRUE)
+
+/*
+ * DEFINE_SRCOVER_MASKFILL with the 4ByteArgb strategy.  The fill color
+ * is premultiplied once, so no component sum can exceed 255 and every
+ * pixel can be done in vector lanes.
+ */
+SSE2_TARGET static inline void
+srcOverMaskFill(void *rasBase,
+                jubyte *pMask, jint maskOff, jint maskScan,
+                jint width, jint height,
+                jint fgColor,
+                SurfaceDataRasInfo *pRasInfo,
+                jboolean dstRgb)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i max = _mm_set1_epi16(0xff);
+    const __m128i alphaLanes = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+    const __m128i rgbMask = _mm_set1_epi32(0x00ffffff);
+    jint rasScan = pRasInfo->scanStride;
+    jint *pRas = (jint *) rasBase;
+    jint srcA = ((juint) fgColor) >> 24;
+    jint srcR = (fgColor >> 16) & 0xff;
+    jint srcG = (fgColor >>  8) & 0xff;
+    jint srcB = (fgColor >>  0) & 0xff;
+    __m128i src;
+
+    if (srcA != 0xff) {
+        if (srcA == 0) {
+            return;
+        }
+        srcR = MUL8(srcA, srcR);
+        srcG = MUL8(srcA, srcG);
+        srcB = MUL8(srcA, srcB);
+    }
+    src = _mm_set_epi16((short) srcA, (short) srcR, (short) srcG, (short) srcB,
+                        (short) srcA, (short) srcR, (short) srcG, (short) srcB);
+
+    if (pMask) {
+        pMask += maskOff;
+    }
+    do {
+        jint x = 0;
+        for (; x < width; x += 4) {
+            jint n = width - x;
+            jint pix[4];
+            jubyte path[4];
+            jint *p = pRas + x;
+            __m128i pathLo, pathHi, resLo, resHi, d, dLo, dHi, out;
+
+            if (n < 4) {
+                /* Pad the row tail; padded pixels get a zero path */
+                memset(path, 0, sizeof(path));
+                memset(pix, 0, sizeof(pix));
+                memcpy(path, pMask ? pMask + x : (jubyte *) "\377\377\377",
+                       n);
+                memcpy(pix, p, n * sizeof(jint));
+                p = pix;
+            } else if (pMask) {
+                memcpy(path, pMask + x, sizeof(path));
+            } else {
+                memset(path, 0xff, sizeof(path));
+            }
+            {
+                jint m;
+                memcpy(&m, path, sizeof(m));
+                if (m == 0) {
+                    continue;
+                }
+            }
+            loadMask4(path, &pathLo, &pathHi);
+            d = _mm_loadu_si128((const __m128i *) p);
+            dLo = _mm_unpacklo_epi8(d, zero);
+            dHi = _mm_unpackhi_epi8(d, zero);
+            if (dstRgb) {
+                dLo = _mm_or_si128(dLo, _mm_and_si128(alphaLanes, max));
+                dHi = _mm_or_si128(dHi, _mm_and_si128(alphaLanes, max));
+            }
+            resLo = mul8(pathLo, src);
+            resHi = mul8(pathHi, src);
+            resLo = _mm_add_epi16(resLo,
+                                  mul8(_mm_sub_epi16(max, spreadAlpha(resLo)),
+                                       dLo));
+            resHi = _mm_add_epi16(resHi,
+                                  mul8(_mm_sub_epi16(max, spreadAlpha(resHi)),
+                                       dHi));
+            out = _mm_packus_epi16(resLo, resHi);
+            if (dstRgb) {
+                out = _mm_and_si128(out, rgbMask);
+            }
+            if (pMask || n < 4) {
+                __m128i skip = _mm_packs_epi16(_mm_cmpeq_epi16(pathLo, zero),
+                                               _mm_cmpeq_epi16(pathHi, zero));
+                out = _mm_or_si128(_mm_and_si128(skip, d),
+                                   _mm_andnot_si128(skip, out));
+            }
+            _mm_storeu_si128((__m128i *) p, out);
+            if (n < 4) {
+                memcpy(pRas + x, pix, n * sizeof(jint));
+            }
+        }
+        pRas = PtrAddBytes(pRas, rasScan);
+        if (pMask) {
+            pMask += maskScan;
+        }
+    } while (--height > 0);
+}
+
+#define DEFINE_SSE2_SRCOVER_MASKFILL(TYPE, DSTRGB) \
+SSE2_TARGET void SSE2_FUNC(NAME_SRCOVER_MASKFILL(TYPE)) \
+    (void *rasBase, \
+     jubyte *pMask, jint maskOff, jint maskScan, \
+     jint width, jint height, \
+     jint fgColor, \
+     SurfaceDataRasInfo *pRasInfo, \
+     NativePrimitive *pPrim, \
+     CompositeInfo *pCompInfo) \
+{ \
+    srcOverMaskFill(rasBase, pMask, maskOff, maskScan, \
+                    width, height, fgColor, pRasInfo, DSTRGB); \
+}
+
+DEFINE_SSE2_SRCOVER_MASKFILL(IntArgbPre, JNI_FALSE)
+DEFINE_SSE2_SRCOVER_MASKFILL(IntRgb, JNI_TRUE)
+
+/*
+ * IntArgb (and IntRgb, IntArgbBm) to ByteGray:
+ * gray = (77*r + 150*g + 29*b + 128) / 256, as ComposeByteGrayFrom3ByteRgb.
+ */
+SSE2_TARGET void
+SSE2_FUNC(IntArgbToByteGrayConvert)(void *srcBase, void *dstBase,
+                                    juint width, juint height,
+                                    SurfaceDataRasInfo *pSrcInfo,
+                                    SurfaceDataRasInfo *pDstInfo,
+                                    NativePrimitive *pPrim,
+                                    CompositeInfo *pCompInfo)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i weights = _mm_set_epi16(0, 77, 150, 29, 0, 77, 150, 29);
+    const __m128i round = _mm_set1_epi32(128);
+    jint srcScan = pSrcInfo->scanStride;
+    jint dstScan = pDstInfo->scanStride;
+    jint *pSrc = (jint *) srcBase;
+    jubyte *pDst = (jubyte *) dstBase;
+
+    do {
+        juint x = 0;
+        for (; x + 8 <= width; x += 8) {
+            __m128i s0 = _mm_loadu_si128((const __m128i *) (pSrc + x));
+            __m128i s1 = _mm_loadu_si128((const __m128i *) (pSrc + x + 4));
+            /* b*29 + g*150 and r*77 for each pixel, then their sum */
+            __m128i p0 = _mm_madd_epi16(_mm_unpacklo_epi8(s0, zero), weights);
+            __m128i p1 = _mm_madd_epi16(_mm_unpackhi_epi8(s0, zero), weights);
+            __m128i p2 = _mm_madd_epi16(_mm_unpacklo_epi8(s1, zero), weights);
+            __m128i p3 = _mm_madd_epi16(_mm_unpackhi_epi8(s1, zero), weights);
+            __m128i g0 = _mm_add_epi32(
+                _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(p0),
+                                                _mm_castsi128_ps(p1),
+                                                _MM_SHUFFLE(2, 0, 2, 0))),
+                _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(p0),
+                                                _mm_castsi128_ps(p1),
+                                                _MM_SHUFFLE(3, 1, 3, 1))));
+            __m128i g1 = _mm_add_epi32(
+                _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(p2),
+                                                _mm_castsi128_ps(p3),
+                                                _MM_SHUFFLE(2, 0, 2, 0))),
+                _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(p2),
+                                                _mm_castsi128_ps(p3),
+                                                _MM_SHUFFLE(3, 1, 3, 1))));
+            __m128i g;
+            g0 = _mm_srli_epi32(_mm_add_epi32(g0, round), 8);
+            g1 = _mm_srli_epi32(_mm_add_epi32(g1, round), 8);
+            g = _mm_packs_epi32(g0, g1);
+            _mm_storel_epi64((__m128i *) (pDst + x), _mm_packus_epi16(g, g));
+        }
+        for (; x < width; x++) {
+            jint argb = pSrc[x];
+            jint r = (argb >> 16) & 0xff;
+            jint g = (argb >>  8) & 0xff;
+            jint b = (argb >>  0) & 0xff;
+            pDst[x] = (jubyte) (((77 * r) + (150 * g) + (29 * b) + 128) / 256);
+        }
+        pSrc = PtrAddBytes(pSrc, srcScan);
+        pDst = PtrAddBytes(pDst, dstScan);
+    } while (--height > 0);
+}
+
+/* ByteGray to IntArgb (and IntArgbPre): 0xff000000 | gray * 0x010101 */
+SSE2_TARGET void
+SSE2_FUNC(ByteGrayToIntArgbConvert)(void *srcBase, void *dstBase,
+                                    juint width, juint height,
+                                    SurfaceDataRasInfo *pSrcInfo,
+                                    SurfaceDataRasInfo *pDstInfo,
+                                    NativePrimitive *pPrim,
+                                    CompositeInfo *pCompInfo)
+{
+    const __m128i ones = _mm_set1_epi8((char) 0xff);
+    jint srcScan = pSrcInfo->scanStride;
+    jint dstScan = pDstInfo->scanStride;
+    jubyte *pSrc = (jubyte *) srcBase;
+    jint *pDst = (jint *) dstBase;
+
+    do {
+        juint x = 0;
+        for (; x + 16 <= width; x += 16) {
+            __m128i g = _mm_loadu_si128((const __m128i *) (pSrc + x));
+            __m128i gg = _mm_unpacklo_epi8(g, g);
+            __m128i ga = _mm_unpacklo_epi8(g, ones);
+            _mm_storeu_si128((__m128i *) (pDst + x),
+                             _mm_unpacklo_epi16(gg, ga));
+            _mm_storeu_si128((__m128i *) (pDst + x + 4),
+                             _mm_unpackhi_epi16(gg, ga));
+            gg = _mm_unpackhi_epi8(g, g);
+            ga = _mm_unpackhi_epi8(g, ones);
+            _mm_storeu_si128((__m128i *) (pDst + x + 8),
+                             _mm_unpacklo_epi16(gg, ga));
+            _mm_storeu_si128((__m128i *) (pDst + x + 12),
+                             _mm_unpackhi_epi16(gg, ga));
+        }
+        for (; x < width; x++) {
+            jint gray = pSrc[x];
+            pDst[x] = (((((0xff << 8) | gray) << 8) | gray) << 8) | gray;
+        }
+        pSrc = PtrAddBytes(pSrc, srcScan);
+        pDst = PtrAddBytes(pDst, dstScan);
+    } while (--height > 0);
+}
+
+#endif /* J2D_SSE2_LOOPS */
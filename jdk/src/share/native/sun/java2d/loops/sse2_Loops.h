@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#ifndef sse2_Loops_h_Included
+#define sse2_Loops_h_Included
+
+#include "GraphicsPrimitiveMgr.h"
+
+/*
+ * SSE2 versions of the most heavily used software loops.  They are
+ * substituted for the macro-generated C loops by MapAccelFunction()
+ * when the CPU supports SSE2, and produce bit-identical results.
+ */
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && \
+    !defined(J2D_NO_SSE2_LOOPS)
+#define J2D_SSE2_LOOPS
+#endif
+
+#ifdef J2D_SSE2_LOOPS
+
+#define SSE2_FUNC(x)        SSE2_FUNC_NAME(x)
+#define SSE2_FUNC_NAME(x)   x ## _SSE2
+
+extern jboolean sse2Supported(void);
+
+MaskBlitFunc SSE2_FUNC(IntArgbToIntArgbPreSrcOverMaskBlit);
+MaskBlitFunc SSE2_FUNC(IntArgbPreToIntArgbPreSrcOverMaskBlit);
+MaskBlitFunc SSE2_FUNC(IntArgbToIntRgbSrcOverMaskBlit);
+MaskBlitFunc SSE2_FUNC(IntArgbPreToIntRgbSrcOverMaskBlit);
+MaskFillFunc SSE2_FUNC(IntArgbPreSrcOverMaskFill);
+MaskFillFunc SSE2_FUNC(IntRgbSrcOverMaskFill);
+BlitFunc     SSE2_FUNC(IntArgbToByteGrayConvert);
+BlitFunc     SSE2_FUNC(ByteGrayToIntArgbConvert);
+
+#endif /* J2D_SSE2_LOOPS */
+
+#endif /* sse2_Loops_h_Included */
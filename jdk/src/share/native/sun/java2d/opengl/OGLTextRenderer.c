@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2003, 2013, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2003, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -42,10 +42,13 @@
 
 /**
  * The following constants define the inner and outer bounds of the
- * accelerated glyph cache.
+ * accelerated glyph cache.  Once the cache is full, each new glyph
+ * evicts an older one and forces a flush of the vertex cache, so the
+ * cache is sized to hold the working set of a text-heavy frame
+ * (1024 cells).
  */
-#define OGLTR_CACHE_WIDTH       512
-#define OGLTR_CACHE_HEIGHT      512
+#define OGLTR_CACHE_WIDTH       1024
+#define OGLTR_CACHE_HEIGHT      1024
 #define OGLTR_CACHE_CELL_WIDTH  32
 #define OGLTR_CACHE_CELL_HEIGHT 32
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2007, 2012, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2007, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -30,9 +30,12 @@
 #include "OGLContext.h"
 
 /**
- * Constants that control the size of the vertex cache.
+ * Constants that control the size of the vertex cache.  Every flush of
+ * the cache is one glDrawArrays() call, so the cache holds enough
+ * vertices (2048 quads) for a full screen of glyphs or mask tiles to go
+ * out in a handful of draw calls.
  */
-#define OGLVC_MAX_INDEX         1024
+#define OGLVC_MAX_INDEX         8192
 
 /**
  * Constants that control the size of the texture tile cache used for
@@ -43,8 +46,8 @@
 #define OGLVC_MASK_CACHE_TILE_SIZE \
    (OGLVC_MASK_CACHE_TILE_WIDTH * OGLVC_MASK_CACHE_TILE_HEIGHT)
 
-#define OGLVC_MASK_CACHE_WIDTH_IN_TILES   8
-#define OGLVC_MASK_CACHE_HEIGHT_IN_TILES  4
+#define OGLVC_MASK_CACHE_WIDTH_IN_TILES   16
+#define OGLVC_MASK_CACHE_HEIGHT_IN_TILES  16
 
 #define OGLVC_MASK_CACHE_WIDTH_IN_TEXELS \
    (OGLVC_MASK_CACHE_TILE_WIDTH * OGLVC_MASK_CACHE_WIDTH_IN_TILES)
@@ -52,6 +52,13 @@
 #define ECL_THIRTY_TWO_BIT
 #endif
 
+/* Use the 64-bit limb P-256 and P-384 point multiplication in
+ * ecp_nist64.c when the compiler provides 128-bit products. */
+#if defined(ECL_SIXTY_FOUR_BIT) && defined(__SIZEOF_INT128__) && \
+        !defined(_KERNEL) && !defined(ECL_NO_NIST64)
+#define ECL_USE_NIST64
+#endif
+
 #define ECL_CURVE_DIGITS(curve_size_in_bits) \
         (((curve_size_in_bits)+(sizeof(mp_digit)*8-1))/(sizeof(mp_digit)*8))
 #define ECL_BITS (sizeof(mp_digit)*8)
@@ -286,6 +293,9 @@ mp_err ec_group_set_gfp224(ECGroup *group, ECCurveName);
 mp_err ec_group_set_gfp256(ECGroup *group, ECCurveName);
 mp_err ec_group_set_gfp384(ECGroup *group, ECCurveName);
 mp_err ec_group_set_gfp521(ECGroup *group, ECCurveName);
+#ifdef ECL_USE_NIST64
+mp_err ec_group_set_nist64(ECGroup *group, ECCurveName);
+#endif
 mp_err ec_group_set_gf2m163(ECGroup *group, ECCurveName name);
 mp_err ec_group_set_gf2m193(ECGroup *group, ECCurveName name);
 mp_err ec_group_set_gf2m233(ECGroup *group, ECCurveName name);
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2007, 2011, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2007, 2026, Oracle and/or its affiliates. All rights reserved.
  * Use is subject to license terms.
  *
  * This library is free software; you can redistribute it and/or
@@ -302,6 +302,13 @@ ecgroup_fromNameAndHex(const ECCurveName name,
                         if (group == NULL) { res = MP_UNDEF; goto CLEANUP; }
                         MP_CHECKOK(ec_group_set_gfp256(group, name));
                         break;
+                case ECCurve_SECG_PRIME_384R1:
+                        group =
+                                ECGroup_consGFp(&irr, &curvea, &curveb, &genx, &geny,
+                                                                &order, params->cofactor);
+                        if (group == NULL) { res = MP_UNDEF; goto CLEANUP; }
+                        MP_CHECKOK(ec_group_set_gfp384(group, name));
+                        break;
                 case ECCurve_SECG_PRIME_521R1:
                         group =
                                 ECGroup_consGFp(&irr, &curvea, &curveb, &genx, &geny,
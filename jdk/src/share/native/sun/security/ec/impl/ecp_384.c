@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2007, 2011, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2007, 2026, Oracle and/or its affiliates. All rights reserved.
  * Use is subject to license terms.
  *
  * This library is free software; you can redistribute it and/or
@@ -289,6 +289,9 @@ ec_group_set_gfp384(ECGroup *group, ECCurveName name)
                 group->meth->field_mod = &ec_GFp_nistp384_mod;
                 group->meth->field_mul = &ec_GFp_nistp384_mul;
                 group->meth->field_sqr = &ec_GFp_nistp384_sqr;
+#ifdef ECL_USE_NIST64
+                return ec_group_set_nist64(group, name);
+#endif
         }
         return MP_OKAY;
 }
@@ -0,0 +1,867 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * Use is subject to license terms.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/* *********************************************************************
+ *
+ * Point multiplication for the NIST P-256 and P-384 curves using field
+ * elements held in a fixed number of 64-bit limbs.
+ *
+ * Field elements are kept in Montgomery form with R = 2^(64 * limbs).
+ * Products use unsigned __int128, so this file is only compiled in when
+ * ECL_USE_NIST64 is defined (see ecl-priv.h).  Points use Jacobian
+ * coordinates and the formulas for a = -3 from the Explicit-Formulas
+ * Database (dbl-2001-b, add-2007-bl, madd-2007-bl).
+ *
+ * Scalar multiplication uses 4-bit fixed windows.  Every window performs
+ * the same sequence of operations and table entries are read with masked
+ * loads over the whole row, so the running time and the memory access
+ * pattern do not depend on the scalar.  The base point uses a table of
+ * (1..15) * 16^i * G in affine form that is built once per process.
+ * Nothing is allocated on the heap after that table has been built.
+ *
+ *********************************************************************** */
+
+#include "ecp.h"
+#include "mpi.h"
+#include "mplogic.h"
+#include "mpi-priv.h"
+#ifndef _KERNEL
+#include <stdlib.h>
+#include <string.h>
+#endif
+
+#ifdef ECL_USE_NIST64
+
+/* Maximum number of limbs of a field element (P-384) */
+#define NIST64_MAX_LIMBS        6
+/* Number of non-zero entries per window */
+#define NIST64_WINDOW_ENTRIES   15
+
+typedef unsigned __int128 nist64_dword;
+
+typedef struct {
+        mp_digit x[NIST64_MAX_LIMBS];
+        mp_digit y[NIST64_MAX_LIMBS];
+} nist64_aff;
+
+typedef struct {
+        mp_digit x[NIST64_MAX_LIMBS];
+        mp_digit y[NIST64_MAX_LIMBS];
+        mp_digit z[NIST64_MAX_LIMBS];
+} nist64_jac;
+
+typedef struct {
+        /* number of limbs and of 4-bit windows of a scalar */
+        int limbs;
+        int windows;
+        /* the prime, -p^-1 mod 2^64, R mod p, R^2 mod p and p - 2 */
+        mp_digit p[NIST64_MAX_LIMBS];
+        mp_digit n0;
+        mp_digit one[NIST64_MAX_LIMBS];
+        mp_digit rr[NIST64_MAX_LIMBS];
+        mp_digit pm2[NIST64_MAX_LIMBS];
+        /* base point table, windows * NIST64_WINDOW_ENTRIES entries */
+        nist64_aff *base;
+} nist64_curve;
+
+/* Curve contexts, built on first use and never freed */
+static nist64_curve *nist64_p256 = NULL;
+static nist64_curve *nist64_p384 = NULL;
+
+/* Returns all ones if x is zero, zero otherwise. */
+static mp_digit
+nist64_mask_zero(mp_digit x)
+{
+        return (mp_digit)0 - (((x | ((mp_digit)0 - x)) >> (ECL_BITS - 1)) ^ 1);
+}
+
+/* r = (mask & a) | (~mask & r) */
+static void
+nist64_select(mp_digit *r, const mp_digit *a, mp_digit mask, int limbs)
+{
+        int i;
+
+        for (i = 0; i < limbs; i++) {
+                r[i] = (a[i] & mask) | (r[i] & ~mask);
+        }
+}
+
+static mp_digit
+nist64_is_zero(const mp_digit *a, int limbs)
+{
+        mp_digit acc = 0;
+        int i;
+
+        for (i = 0; i < limbs; i++) {
+                acc |= a[i];
+        }
+        return nist64_mask_zero(acc);
+}
+
+/* r = a + b mod p for n limbs.  Like the other _n functions this is
+ * inlined into its wrapper with a constant n. */
+static inline void
+nist64_add_n(const nist64_curve *c, mp_digit *r, const mp_digit *a,
+                         const mp_digit *b, const int n)
+{
+        mp_digit t[NIST64_MAX_LIMBS], s[NIST64_MAX_LIMBS];
+        mp_digit carry = 0, borrow = 0, mask;
+        nist64_dword uv;
+        int i;
+
+        for (i = 0; i < n; i++) {
+                uv = (nist64_dword)a[i] + b[i] + carry;
+                t[i] = (mp_digit)uv;
+                carry = (mp_digit)(uv >> 64);
+        }
+        /* subtract p once if (carry:t) >= p */
+        for (i = 0; i < n; i++) {
+                uv = (nist64_dword)t[i] - c->p[i] - borrow;
+                s[i] = (mp_digit)uv;
+                borrow = (mp_digit)(uv >> 64) & 1;
+        }
+        mask = (mp_digit)0 - (carry | (borrow ^ 1));
+        for (i = 0; i < n; i++) {
+                r[i] = (s[i] & mask) | (t[i] & ~mask);
+        }
+}
+
+/* r = a - b mod p for n limbs. */
+static inline void
+nist64_sub_n(const nist64_curve *c, mp_digit *r, const mp_digit *a,
+                         const mp_digit *b, const int n)
+{
+        mp_digit t[NIST64_MAX_LIMBS];
+        mp_digit borrow = 0, carry = 0, mask;
+        nist64_dword uv;
+        int i;
+
+        for (i = 0; i < n; i++) {
+                uv = (nist64_dword)a[i] - b[i] - borrow;
+                t[i] = (mp_digit)uv;
+                borrow = (mp_digit)(uv >> 64) & 1;
+        }
+        /* add p back if the subtraction wrapped */
+        mask = (mp_digit)0 - borrow;
+        for (i = 0; i < n; i++) {
+                uv = (nist64_dword)t[i] + (c->p[i] & mask) + carry;
+                r[i] = (mp_digit)uv;
+                carry = (mp_digit)(uv >> 64);
+        }
+}
+
+static void
+nist64_add(const nist64_curve *c, mp_digit *r, const mp_digit *a,
+                   const mp_digit *b)
+{
+        if (c->limbs == 4) {
+                nist64_add_n(c, r, a, b, 4);
+        } else {
+                nist64_add_n(c, r, a, b, NIST64_MAX_LIMBS);
+        }
+}
+
+static void
+nist64_sub(const nist64_curve *c, mp_digit *r, const mp_digit *a,
+                   const mp_digit *b)
+{
+        if (c->limbs == 4) {
+                nist64_sub_n(c, r, a, b, 4);
+        } else {
+                nist64_sub_n(c, r, a, b, NIST64_MAX_LIMBS);
+        }
+}
+
+/* Montgomery product r = a * b / R mod p for n limbs: the full product
+ * followed by n word-by-word reduction steps.  r may alias a or b. */
+static inline void
+nist64_mul_n(const nist64_curve *c, mp_digit *r, const mp_digit *a,
+                         const mp_digit *b, const int n)
+{
+        mp_digit t[2 * NIST64_MAX_LIMBS];
+        mp_digit s[NIST64_MAX_LIMBS];
+        mp_digit carry, hi, borrow, mask;
+        nist64_dword uv;
+        int i, j;
+
+        for (i = 0; i < n; i++) {
+                t[i] = 0;
+        }
+        for (i = 0; i < n; i++) {
+                carry = 0;
+                for (j = 0; j < n; j++) {
+                        uv = (nist64_dword)a[j] * b[i] + t[i + j] + carry;
+                        t[i + j] = (mp_digit)uv;
+                        carry = (mp_digit)(uv >> 64);
+                }
+                t[i + n] = carry;
+        }
+
+        hi = 0;
+        for (i = 0; i < n; i++) {
+                mp_digit m = t[i] * c->n0;
+
+                carry = 0;
+                for (j = 0; j < n; j++) {
+                        uv = (nist64_dword)m * c->p[j] + t[i + j] + carry;
+                        t[i + j] = (mp_digit)uv;
+                        carry = (mp_digit)(uv >> 64);
+                }
+                uv = (nist64_dword)t[i + n] + carry + hi;
+                t[i + n] = (mp_digit)uv;
+                hi = (mp_digit)(uv >> 64);
+        }
+
+        /* (hi:t[n..2n-1]) < 2p; subtract p once if needed */
+        borrow = 0;
+        for (i = 0; i < n; i++) {
+                uv = (nist64_dword)t[n + i] - c->p[i] - borrow;
+                s[i] = (mp_digit)uv;
+                borrow = (mp_digit)(uv >> 64) & 1;
+        }
+        mask = (mp_digit)0 - (hi | (borrow ^ 1));
+        for (i = 0; i < n; i++) {
+                r[i] = (s[i] & mask) | (t[n + i] & ~mask);
+        }
+}
+
+static void
+nist64_mul(const nist64_curve *c, mp_digit *r, const mp_digit *a,
+                   const mp_digit *b)
+{
+        if (c->limbs == 4) {
+                nist64_mul_n(c, r, a, b, 4);
+        } else {
+                nist64_mul_n(c, r, a, b, NIST64_MAX_LIMBS);
+        }
+}
+
+static void
+nist64_sqr(const nist64_curve *c, mp_digit *r, const mp_digit *a)
+{
+        nist64_mul(c, r, a, a);
+}
+
+/* r = a^(p-2) = a^-1 mod p.  The exponent is public, so the sequence of
+ * operations does not depend on a. */
+static void
+nist64_inv(const nist64_curve *c, mp_digit *r, const mp_digit *a)
+{
+        mp_digit t[NIST64_MAX_LIMBS];
+        int i;
+
+        memcpy(t, c->one, sizeof(t));
+        for (i = c->limbs * ECL_BITS - 1; i >= 0; i--) {
+                nist64_sqr(c, t, t);
+                if ((c->pm2[i / ECL_BITS] >> (i % ECL_BITS)) & 1) {
+                        nist64_mul(c, t, t, a);
+                }
+        }
+        memcpy(r, t, sizeof(t));
+}
+
+/* r = 2p.  Correct for the point at infinity (z = 0). */
+static void
+nist64_pt_dbl(const nist64_curve *c, nist64_jac *r, const nist64_jac *p)
+{
+        mp_digit delta[NIST64_MAX_LIMBS], gamma[NIST64_MAX_LIMBS];
+        mp_digit beta[NIST64_MAX_LIMBS], alpha[NIST64_MAX_LIMBS];
+        mp_digit t0[NIST64_MAX_LIMBS], t1[NIST64_MAX_LIMBS];
+
+        nist64_sqr(c, delta, p->z);
+        nist64_sqr(c, gamma, p->y);
+        nist64_mul(c, beta, p->x, gamma);
+        /* alpha = 3 * (x - delta) * (x + delta) */
+        nist64_sub(c, t0, p->x, delta);
+        nist64_add(c, t1, p->x, delta);
+        nist64_mul(c, t0, t0, t1);
+        nist64_add(c, alpha, t0, t0);
+        nist64_add(c, alpha, alpha, t0);
+        /* z3 = (y + z)^2 - gamma - delta */
+        nist64_add(c, t0, p->y, p->z);
+        nist64_sqr(c, t0, t0);
+        nist64_sub(c, t0, t0, gamma);
+        nist64_sub(c, r->z, t0, delta);
+        /* x3 = alpha^2 - 8 * beta */
+        nist64_add(c, beta, beta, beta);
+        nist64_add(c, beta, beta, beta);
+        nist64_sqr(c, t0, alpha);
+        nist64_add(c, t1, beta, beta);
+        nist64_sub(c, r->x, t0, t1);
+        /* y3 = alpha * (4 * beta - x3) - 8 * gamma^2 */
+        nist64_sub(c, t0, beta, r->x);
+        nist64_mul(c, t0, alpha, t0);
+        nist64_sqr(c, gamma, gamma);
+        nist64_add(c, gamma, gamma, gamma);
+        nist64_add(c, gamma, gamma, gamma);
+        nist64_add(c, gamma, gamma, gamma);
+        nist64_sub(c, r->y, t0, gamma);
+}
+
+/* r = p + q for p != q.  If p = -q the result has z = 0.  The result is
+ * wrong if either input is the point at infinity or if p = q; callers
+ * handle those cases. */
+static void
+nist64_pt_add(const nist64_curve *c, nist64_jac *r, const nist64_jac *p,
+                          const nist64_jac *q)
+{
+        mp_digit z1z1[NIST64_MAX_LIMBS], z2z2[NIST64_MAX_LIMBS];
+        mp_digit u1[NIST64_MAX_LIMBS], u2[NIST64_MAX_LIMBS];
+        mp_digit s1[NIST64_MAX_LIMBS], s2[NIST64_MAX_LIMBS];
+        mp_digit h[NIST64_MAX_LIMBS], i[NIST64_MAX_LIMBS];
+        mp_digit j[NIST64_MAX_LIMBS], rr[NIST64_MAX_LIMBS];
+        mp_digit v[NIST64_MAX_LIMBS], t0[NIST64_MAX_LIMBS];
+
+        nist64_sqr(c, z1z1, p->z);
+        nist64_sqr(c, z2z2, q->z);
+        nist64_mul(c, u1, p->x, z2z2);
+        nist64_mul(c, u2, q->x, z1z1);
+        nist64_mul(c, s1, p->y, q->z);
+        nist64_mul(c, s1, s1, z2z2);
+        nist64_mul(c, s2, q->y, p->z);
+        nist64_mul(c, s2, s2, z1z1);
+        nist64_sub(c, h, u2, u1);
+        nist64_add(c, i, h, h);
+        nist64_sqr(c, i, i);
+        nist64_mul(c, j, h, i);
+        nist64_sub(c, rr, s2, s1);
+        nist64_add(c, rr, rr, rr);
+        nist64_mul(c, v, u1, i);
+        /* z3 = ((z1 + z2)^2 - z1z1 - z2z2) * h */
+        nist64_add(c, t0, p->z, q->z);
+        nist64_sqr(c, t0, t0);
+        nist64_sub(c, t0, t0, z1z1);
+        nist64_sub(c, t0, t0, z2z2);
+        nist64_mul(c, r->z, t0, h);
+        /* x3 = rr^2 - j - 2 * v */
+        nist64_sqr(c, t0, rr);
+        nist64_sub(c, t0, t0, j);
+        nist64_sub(c, t0, t0, v);
+        nist64_sub(c, r->x, t0, v);
+        /* y3 = rr * (v - x3) - 2 * s1 * j */
+        nist64_sub(c, t0, v, r->x);
+        nist64_mul(c, t0, rr, t0);
+        nist64_mul(c, s1, s1, j);
+        nist64_add(c, s1, s1, s1);
+        nist64_sub(c, r->y, t0, s1);
+}
+
+/* r = p + q where q is affine, with the same restrictions as
+ * nist64_pt_add. */
+static void
+nist64_pt_madd(const nist64_curve *c, nist64_jac *r, const nist64_jac *p,
+                           const nist64_aff *q)
+{
+        mp_digit z1z1[NIST64_MAX_LIMBS], u2[NIST64_MAX_LIMBS];
+        mp_digit s2[NIST64_MAX_LIMBS], h[NIST64_MAX_LIMBS];
+        mp_digit hh[NIST64_MAX_LIMBS], i[NIST64_MAX_LIMBS];
+        mp_digit j[NIST64_MAX_LIMBS], rr[NIST64_MAX_LIMBS];
+        mp_digit v[NIST64_MAX_LIMBS], t0[NIST64_MAX_LIMBS];
+
+        nist64_sqr(c, z1z1, p->z);
+        nist64_mul(c, u2, q->x, z1z1);
+        nist64_mul(c, s2, q->y, p->z);
+        nist64_mul(c, s2, s2, z1z1);
+        nist64_sub(c, h, u2, p->x);
+        nist64_sqr(c, hh, h);
+        nist64_add(c, i, hh, hh);
+        nist64_add(c, i, i, i);
+        nist64_mul(c, j, h, i);
+        nist64_sub(c, rr, s2, p->y);
+        nist64_add(c, rr, rr, rr);
+        nist64_mul(c, v, p->x, i);
+        /* z3 = (z1 + h)^2 - z1z1 - hh */
+        nist64_add(c, t0, p->z, h);
+        nist64_sqr(c, t0, t0);
+        nist64_sub(c, t0, t0, z1z1);
+        nist64_sub(c, t0, t0, hh);
+        /* y1 is still needed below, so z3 is stored last */
+        /* x3 = rr^2 - j - 2 * v */
+        nist64_sqr(c, u2, rr);
+        nist64_sub(c, u2, u2, j);
+        nist64_sub(c, u2, u2, v);
+        nist64_sub(c, u2, u2, v);
+        /* y3 = rr * (v - x3) - 2 * y1 * j */
+        nist64_sub(c, v, v, u2);
+        nist64_mul(c, v, rr, v);
+        nist64_mul(c, j, p->y, j);
+        nist64_add(c, j, j, j);
+        nist64_sub(c, r->y, v, j);
+        memcpy(r->x, u2, sizeof(r->x));
+        memcpy(r->z, t0, sizeof(r->z));
+}
+
+/* acc = acc + t unless skip is all ones.  If acc is the point at
+ * infinity the result is t. */
+static void
+nist64_accumulate(const nist64_curve *c, nist64_jac *acc, const nist64_jac *t,
+                                  mp_digit skip)
+{
+        nist64_jac sum;
+        mp_digit acc_inf = nist64_is_zero(acc->z, c->limbs);
+
+        nist64_pt_add(c, &sum, acc, t);
+        nist64_select(sum.x, t->x, acc_inf, c->limbs);
+        nist64_select(sum.y, t->y, acc_inf, c->limbs);
+        nist64_select(sum.z, t->z, acc_inf, c->limbs);
+        nist64_select(acc->x, sum.x, ~skip, c->limbs);
+        nist64_select(acc->y, sum.y, ~skip, c->limbs);
+        nist64_select(acc->z, sum.z, ~skip, c->limbs);
+}
+
+/* Same as nist64_accumulate for an affine t. */
+static void
+nist64_accumulate_aff(const nist64_curve *c, nist64_jac *acc,
+                                          const nist64_aff *t, mp_digit skip)
+{
+        nist64_jac sum;
+        mp_digit acc_inf = nist64_is_zero(acc->z, c->limbs);
+
+        nist64_pt_madd(c, &sum, acc, t);
+        nist64_select(sum.x, t->x, acc_inf, c->limbs);
+        nist64_select(sum.y, t->y, acc_inf, c->limbs);
+        nist64_select(sum.z, c->one, acc_inf, c->limbs);
+        nist64_select(acc->x, sum.x, ~skip, c->limbs);
+        nist64_select(acc->y, sum.y, ~skip, c->limbs);
+        nist64_select(acc->z, sum.z, ~skip, c->limbs);
+}
+
+/* Returns the 4-bit window i of the scalar k. */
+static int
+nist64_window(const mp_digit *k, int i)
+{
+        return (int)((k[i / (ECL_BITS / 4)] >> ((i % (ECL_BITS / 4)) * 4)) & 0xf);
+}
+
+/* r = k * G using the base point table. */
+static void
+nist64_mul_base(const nist64_curve *c, const mp_digit *k, nist64_jac *r)
+{
+        nist64_aff t;
+        int i, j;
+
+        memset(r, 0, sizeof(*r));
+        for (i = 0; i < c->windows; i++) {
+                const nist64_aff *row = c->base + i * NIST64_WINDOW_ENTRIES;
+                int d = nist64_window(k, i);
+
+                memset(&t, 0, sizeof(t));
+                for (j = 0; j < NIST64_WINDOW_ENTRIES; j++) {
+                        mp_digit mask = nist64_mask_zero((mp_digit)(d ^ (j + 1)));
+                        nist64_select(t.x, row[j].x, mask, c->limbs);
+                        nist64_select(t.y, row[j].y, mask, c->limbs);
+                }
+                nist64_accumulate_aff(c, r, &t, nist64_mask_zero((mp_digit)d));
+        }
+}
+
+/* r = k * p for an affine point p of order n. */
+static void
+nist64_mul_point(const nist64_curve *c, const mp_digit *k,
+                                 const nist64_aff *p, nist64_jac *r)
+{
+        nist64_jac table[NIST64_WINDOW_ENTRIES];
+        nist64_jac t;
+        int i, j;
+
+        /* table[j] = (j + 1) * p */
+        memset(&table[0], 0, sizeof(table[0]));
+        memcpy(table[0].x, p->x, sizeof(table[0].x));
+        memcpy(table[0].y, p->y, sizeof(table[0].y));
+        memcpy(table[0].z, c->one, sizeof(table[0].z));
+        for (j = 1; j < NIST64_WINDOW_ENTRIES; j++) {
+                if (j & 1) {
+                        nist64_pt_dbl(c, &table[j], &table[j / 2]);
+                } else {
+                        nist64_pt_madd(c, &table[j], &table[j - 1], p);
+                }
+        }
+
+        memset(r, 0, sizeof(*r));
+        for (i = c->windows - 1; i >= 0; i--) {
+                int d = nist64_window(k, i);
+
+                nist64_pt_dbl(c, r, r);
+                nist64_pt_dbl(c, r, r);
+                nist64_pt_dbl(c, r, r);
+                nist64_pt_dbl(c, r, r);
+                memset(&t, 0, sizeof(t));
+                for (j = 0; j < NIST64_WINDOW_ENTRIES; j++) {
+                        mp_digit mask = nist64_mask_zero((mp_digit)(d ^ (j + 1)));
+                        nist64_select(t.x, table[j].x, mask, c->limbs);
+                        nist64_select(t.y, table[j].y, mask, c->limbs);
+                        nist64_select(t.z, table[j].z, mask, c->limbs);
+                }
+                nist64_accumulate(c, r, &t, nist64_mask_zero((mp_digit)d));
+        }
+}
+
+/* Converts n Jacobian points with z != 0 to affine form using a single
+ * inversion.  scratch must hold n field elements. */
+static void
+nist64_to_affine_batch(const nist64_curve *c, nist64_aff *r,
+                                           const nist64_jac *p, mp_digit (*scratch)[NIST64_MAX_LIMBS],
+                                           int n)
+{
+        mp_digit inv[NIST64_MAX_LIMBS], zi[NIST64_MAX_LIMBS];
+        mp_digit zi2[NIST64_MAX_LIMBS];
+        int i;
+
+        /* scratch[i] = z[0] * ... * z[i] */
+        memcpy(scratch[0], p[0].z, sizeof(scratch[0]));
+        for (i = 1; i < n; i++) {
+                nist64_mul(c, scratch[i], scratch[i - 1], p[i].z);
+        }
+        nist64_inv(c, inv, scratch[n - 1]);
+        for (i = n - 1; i >= 0; i--) {
+                if (i > 0) {
+                        nist64_mul(c, zi, inv, scratch[i - 1]);
+                        nist64_mul(c, inv, inv, p[i].z);
+                } else {
+                        memcpy(zi, inv, sizeof(zi));
+                }
+                nist64_sqr(c, zi2, zi);
+                nist64_mul(c, r[i].x, p[i].x, zi2);
+                nist64_mul(c, zi2, zi2, zi);
+                nist64_mul(c, r[i].y, p[i].y, zi2);
+        }
+}
+
+/* Loads a non-negative mp_int of at most c->limbs digits. */
+static mp_err
+nist64_load(const nist64_curve *c, const mp_int *a, mp_digit *r)
+{
+        int i;
+
+        if ((MP_SIGN(a) == MP_NEG) || (MP_USED(a) > (mp_size)c->limbs)) {
+                return MP_RANGE;
+        }
+        for (i = 0; i < c->limbs; i++) {
+                r[i] = (i < (int)MP_USED(a)) ? MP_DIGIT(a, i) : 0;
+        }
+        return MP_OKAY;
+}
+
+/* Loads a field element in [0, p) and converts it to Montgomery form. */
+static mp_err
+nist64_load_fe(const nist64_curve *c, const mp_int *a, mp_digit *r)
+{
+        mp_err res;
+        int i;
+
+        if ((res = nist64_load(c, a, r)) != MP_OKAY) {
+                return res;
+        }
+        for (i = c->limbs - 1; i >= 0; i--) {
+                if (r[i] != c->p[i]) {
+                        break;
+                }
+        }
+        if ((i < 0) || (r[i] > c->p[i])) {
+                return MP_RANGE;
+        }
+        nist64_mul(c, r, r, c->rr);
+        return MP_OKAY;
+}
+
+static mp_err
+nist64_store(const nist64_curve *c, const mp_digit *a, mp_int *r)
+{
+        mp_err res = MP_OKAY;
+        int i;
+
+        MP_CHECKOK(s_mp_pad(r, c->limbs));
+        MP_SIGN(r) = MP_ZPOS;
+        MP_USED(r) = c->limbs;
+        for (i = 0; i < c->limbs; i++) {
+                MP_DIGIT(r, i) = a[i];
+        }
+        s_mp_clamp(r);
+  CLEANUP:
+        return res;
+}
+
+/* Converts p to affine form and stores it.  The point at infinity is
+ * stored as (0, 0). */
+static mp_err
+nist64_store_point(const nist64_curve *c, const nist64_jac *p, mp_int *rx,
+                                   mp_int *ry)
+{
+        mp_err res = MP_OKAY;
+        mp_digit zi[NIST64_MAX_LIMBS], zi2[NIST64_MAX_LIMBS];
+        mp_digit x[NIST64_MAX_LIMBS], y[NIST64_MAX_LIMBS];
+        mp_digit one[NIST64_MAX_LIMBS];
+
+        memset(one, 0, sizeof(one));
+        one[0] = 1;
+        nist64_inv(c, zi, p->z);
+        nist64_sqr(c, zi2, zi);
+        nist64_mul(c, x, p->x, zi2);
+        nist64_mul(c, zi2, zi2, zi);
+        nist64_mul(c, y, p->y, zi2);
+        /* leave Montgomery form; an inverse of zero is zero */
+        nist64_mul(c, x, x, one);
+        nist64_mul(c, y, y, one);
+        MP_CHECKOK(nist64_store(c, x, rx));
+        MP_CHECKOK(nist64_store(c, y, ry));
+  CLEANUP:
+        return res;
+}
+
+/* Builds the context of the curve of group, including the base point
+ * table.  Returns NULL if memory can not be allocated. */
+static nist64_curve *
+nist64_curve_new(const ECGroup *group, int limbs)
+{
+        nist64_curve *c;
+        nist64_jac *row = NULL;
+        mp_digit (*scratch)[NIST64_MAX_LIMBS] = NULL;
+        nist64_jac q;
+        mp_digit inv;
+        int i, j;
+
+        c = (nist64_curve *) malloc(sizeof(nist64_curve));
+        if (c == NULL) {
+                return NULL;
+        }
+        memset(c, 0, sizeof(*c));
+        c->limbs = limbs;
+        c->windows = limbs * ECL_BITS / 4;
+        for (i = 0; i < limbs; i++) {
+                c->p[i] = MP_DIGIT(&group->meth->irr, i);
+        }
+        /* n0 = -p^-1 mod 2^64 by Newton iteration */
+        inv = 1;
+        for (i = 0; i < 6; i++) {
+                inv *= 2 - c->p[0] * inv;
+        }
+        c->n0 = (mp_digit)0 - inv;
+        /* R mod p = 2^(64 * limbs) - p, as p > 2^(64 * limbs - 1) */
+        for (i = 0; i < limbs; i++) {
+                c->one[i] = ~c->p[i];
+        }
+        c->one[0] += 1;
+        /* R^2 mod p by doubling R mod p 64 * limbs times */
+        memcpy(c->rr, c->one, sizeof(c->rr));
+        for (i = 0; i < limbs * ECL_BITS; i++) {
+                nist64_add(c, c->rr, c->rr, c->rr);
+        }
+        memcpy(c->pm2, c->p, sizeof(c->pm2));
+        c->pm2[0] -= 2;
+
+        c->base = (nist64_aff *) malloc(c->windows * NIST64_WINDOW_ENTRIES *
+                                                                        sizeof(nist64_aff));
+        row = (nist64_jac *) malloc(c->windows * NIST64_WINDOW_ENTRIES *
+                                                                sizeof(nist64_jac));
+        scratch = malloc(c->windows * NIST64_WINDOW_ENTRIES *
+                                         sizeof(scratch[0]));
+        if ((c->base == NULL) || (row == NULL) || (scratch == NULL)) {
+                goto FAIL;
+        }
+
+        /* q = 16^i * G; row i holds (1..15) * q */
+        memset(&q, 0, sizeof(q));
+        if ((nist64_load_fe(c, &group->genx, q.x) != MP_OKAY) ||
+                (nist64_load_fe(c, &group->geny, q.y) != MP_OKAY)) {
+                goto FAIL;
+        }
+        memcpy(q.z, c->one, sizeof(q.z));
+        for (i = 0; i < c->windows; i++) {
+                nist64_jac *r = row + i * NIST64_WINDOW_ENTRIES;
+
+                r[0] = q;
+                nist64_pt_dbl(c, &r[1], &q);
+                for (j = 2; j < NIST64_WINDOW_ENTRIES; j++) {
+                        nist64_pt_add(c, &r[j], &r[j - 1], &q);
+                }
+                nist64_pt_dbl(c, &q, &r[7]);
+        }
+        nist64_to_affine_batch(c, c->base, row, scratch,
+                                                   c->windows * NIST64_WINDOW_ENTRIES);
+        free(row);
+        free(scratch);
+        return c;
+
+  FAIL:
+        free(row);
+        free(scratch);
+        free(c->base);
+        free(c);
+        return NULL;
+}
+
+/* Returns the context for group, building it on first use. */
+static nist64_curve *
+nist64_curve_get(const ECGroup *group, nist64_curve **slot, int limbs)
+{
+        nist64_curve *c = __atomic_load_n(slot, __ATOMIC_ACQUIRE);
+
+        if (c == NULL) {
+                nist64_curve *expected = NULL;
+
+                c = nist64_curve_new(group, limbs);
+                if (c == NULL) {
+                        return NULL;
+                }
+                if (!__atomic_compare_exchange_n(slot, &expected, c, 0,
+                                                                                 __ATOMIC_ACQ_REL,
+                                                                                 __ATOMIC_ACQUIRE)) {
+                        /* another thread published its context first */
+                        free(c->base);
+                        free(c);
+                        c = expected;
+                }
+        }
+        return c;
+}
+
+/* Computes R = nP.  Input and output are not field-encoded (the group
+ * uses GFMethod_consGFp). */
+static mp_err
+ec_GFp_nist64_pt_mul(const mp_int *n, const mp_int *px, const mp_int *py,
+                                         mp_int *rx, mp_int *ry, const ECGroup *group,
+                                         int timing)
+{
+        const nist64_curve *c = (const nist64_curve *) group->extra1;
+        mp_digit k[NIST64_MAX_LIMBS];
+        nist64_aff p;
+        nist64_jac r;
+        mp_err res = MP_OKAY;
+
+        memset(&p, 0, sizeof(p));
+        MP_CHECKOK(nist64_load(c, n, k));
+        MP_CHECKOK(nist64_load_fe(c, px, p.x));
+        MP_CHECKOK(nist64_load_fe(c, py, p.y));
+        nist64_mul_point(c, k, &p, &r);
+        MP_CHECKOK(nist64_store_point(c, &r, rx, ry));
+  CLEANUP:
+        return res;
+}
+
+/* Computes R = nG. */
+static mp_err
+ec_GFp_nist64_base_mul(const mp_int *n, mp_int *rx, mp_int *ry,
+                                           const ECGroup *group)
+{
+        const nist64_curve *c = (const nist64_curve *) group->extra1;
+        mp_digit k[NIST64_MAX_LIMBS];
+        nist64_jac r;
+        mp_err res = MP_OKAY;
+
+        MP_CHECKOK(nist64_load(c, n, k));
+        nist64_mul_base(c, k, &r);
+        MP_CHECKOK(nist64_store_point(c, &r, rx, ry));
+  CLEANUP:
+        return res;
+}
+
+/* Computes R = k1 * G + k2 * P.  Allows k1 = NULL or { k2, P } = NULL.
+ * Only used with public scalars when both are given (signature
+ * verification), so the final addition may branch. */
+static mp_err
+ec_GFp_nist64_pts_mul(const mp_int *k1, const mp_int *k2, const mp_int *px,
+                                          const mp_int *py, mp_int *rx, mp_int *ry,
+                                          const ECGroup *group, int timing)
+{
+        const nist64_curve *c = (const nist64_curve *) group->extra1;
+        mp_digit k[NIST64_MAX_LIMBS];
+        nist64_aff p;
+        nist64_jac r1, r2;
+        mp_err res = MP_OKAY;
+
+        ARGCHK(group != NULL, MP_BADARG);
+        ARGCHK(!((k1 == NULL)
+                         && ((k2 == NULL) || (px == NULL)
+                                 || (py == NULL))), MP_BADARG);
+
+        /* if some arguments are not defined used ECPoint_mul */
+        if (k1 == NULL) {
+                return ECPoint_mul(group, k2, px, py, rx, ry, timing);
+        } else if ((k2 == NULL) || (px == NULL) || (py == NULL)) {
+                return ECPoint_mul(group, k1, NULL, NULL, rx, ry, timing);
+        }
+
+        memset(&p, 0, sizeof(p));
+        MP_CHECKOK(nist64_load(c, k1, k));
+        nist64_mul_base(c, k, &r1);
+        MP_CHECKOK(nist64_load(c, k2, k));
+        MP_CHECKOK(nist64_load_fe(c, px, p.x));
+        MP_CHECKOK(nist64_load_fe(c, py, p.y));
+        nist64_mul_point(c, k, &p, &r2);
+
+        if (nist64_is_zero(r1.z, c->limbs)) {
+                r1 = r2;
+        } else if (!nist64_is_zero(r2.z, c->limbs)) {
+                nist64_jac sum;
+
+                nist64_pt_add(c, &sum, &r1, &r2);
+                if (nist64_is_zero(sum.z, c->limbs)) {
+                        /* r1 = r2 or r1 = -r2 */
+                        nist64_jac d;
+
+                        nist64_pt_dbl(c, &d, &r1);
+                        nist64_mul(c, sum.x, r1.y, r2.z);
+                        nist64_mul(c, sum.x, sum.x, r2.z);
+                        nist64_mul(c, sum.x, sum.x, r2.z);
+                        nist64_mul(c, sum.y, r2.y, r1.z);
+                        nist64_mul(c, sum.y, sum.y, r1.z);
+                        nist64_mul(c, sum.y, sum.y, r1.z);
+                        if (memcmp(sum.x, sum.y, c->limbs * sizeof(mp_digit)) == 0) {
+                                sum = d;
+                        } else {
+                                memset(&sum, 0, sizeof(sum));
+                        }
+                }
+                r1 = sum;
+        }
+        MP_CHECKOK(nist64_store_point(c, &r1, rx, ry));
+  CLEANUP:
+        return res;
+}
+
+/* Wire in 64-bit limb point multiplication for P-256 and P-384.  The
+ * group must have been constructed with ECGroup_consGFp.  Leaves the
+ * group unchanged if the curve context can not be built. */
+mp_err
+ec_group_set_nist64(ECGroup *group, ECCurveName name)
+{
+        nist64_curve *c = NULL;
+
+        if ((group->meth->field_enc != NULL) || (group->extra1 != NULL)) {
+                return MP_OKAY;
+        }
+        if (name == ECCurve_NIST_P256) {
+                c = nist64_curve_get(group, &nist64_p256, 4);
+        } else if (name == ECCurve_NIST_P384) {
+                c = nist64_curve_get(group, &nist64_p384, 6);
+        }
+        if (c != NULL) {
+                group->extra1 = c;
+                group->point_mul = &ec_GFp_nist64_pt_mul;
+                group->base_point_mul = &ec_GFp_nist64_base_mul;
+                group->points_mul = &ec_GFp_nist64_pts_mul;
+        }
+        return MP_OKAY;
+}
+
+#endif /* ECL_USE_NIST64 */
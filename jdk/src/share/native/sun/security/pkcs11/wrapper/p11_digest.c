@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2003, 2019, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2003, 2026, Oracle and/or its affiliates. All rights reserved.
  */
 
 /* Copyright  (c) 2002 Graz University of Technology. All rights reserved.
@@ -123,9 +123,8 @@ JNIEXPORT jint JNICALL Java_sun_security_pkcs11_wrapper_PKCS11_C_1DigestSingle
 
     if (jInLen > MAX_STACK_BUFFER_LEN) {
         /* always use single part op, even for large data */
-        bufP = (CK_BYTE_PTR) malloc((size_t)jInLen);
+        bufP = getScratchBuffer(env, jInLen);
         if (bufP == NULL) {
-            throwOutOfMemoryError(env, 0);
             goto cleanup;
         }
     }
@@ -143,7 +142,7 @@ JNIEXPORT jint JNICALL Java_sun_security_pkcs11_wrapper_PKCS11_C_1DigestSingle
     }
 cleanup:
     freeCKMechanismPtr(ckpMechanism);
-    if (bufP != BUF) { free(bufP); }
+    if (bufP != BUF) { releaseScratchBuffer(bufP); }
 
     return ckDigestLength;
 }
@@ -185,9 +184,8 @@ JNIEXPORT void JNICALL Java_sun_security_pkcs11_wrapper_PKCS11_C_1DigestUpdate
         bufP = BUF;
     } else {
         bufLen = min(MAX_HEAP_BUFFER_LEN, jInLen);
-        bufP = (CK_BYTE_PTR) malloc((size_t)bufLen);
+        bufP = getScratchBuffer(env, bufLen);
         if (bufP == NULL) {
-            throwOutOfMemoryError(env, 0);
             return;
         }
     }
@@ -196,12 +194,12 @@ JNIEXPORT void JNICALL Java_sun_security_pkcs11_wrapper_PKCS11_C_1DigestUpdate
         jsize chunkLen = min(bufLen, jInLen);
         (*env)->GetByteArrayRegion(env, jIn, jInOfs, chunkLen, (jbyte *)bufP);
         if ((*env)->ExceptionCheck(env)) {
-            if (bufP != BUF) { free(bufP); }
+            if (bufP != BUF) { releaseScratchBuffer(bufP); }
             return;
         }
         rv = (*ckpFunctions->C_DigestUpdate)(ckSessionHandle, bufP, chunkLen);
         if (ckAssertReturnValueOK(env, rv) != CK_ASSERT_OK) {
-            if (bufP != BUF) { free(bufP); }
+            if (bufP != BUF) { releaseScratchBuffer(bufP); }
             return;
         }
         jInOfs += chunkLen;
@@ -209,7 +207,7 @@ JNIEXPORT void JNICALL Java_sun_security_pkcs11_wrapper_PKCS11_C_1DigestUpdate
     }
 
     if (bufP != BUF) {
-        free(bufP);
+        releaseScratchBuffer(bufP);
     }
 }
 #endif
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2003, 2019, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2003, 2026, Oracle and/or its affiliates. All rights reserved.
  */
 
 /* Copyright  (c) 2002 Graz University of Technology. All rights reserved.
@@ -128,7 +128,7 @@ JNIEXPORT jbyteArray JNICALL Java_sun_security_pkcs11_wrapper_PKCS11_C_1Sign
     TRACE0("DEBUG: C_Sign\n");
 
     ckSessionHandle = jLongToCKULong(jSessionHandle);
-    jByteArrayToCKByteArray(env, jData, &ckpData, &ckDataLength);
+    jByteArrayToScratchBuffer(env, jData, &ckpData, &ckDataLength);
     if ((*env)->ExceptionCheck(env)) {
         return NULL;
     }
@@ -149,7 +149,7 @@ JNIEXPORT jbyteArray JNICALL Java_sun_security_pkcs11_wrapper_PKCS11_C_1Sign
         TRACE1("DEBUG C_Sign: signature length = %lu\n", ckSignatureLength);
     }
 
-    free(ckpData);
+    releaseScratchBuffer(ckpData);
     if (bufP != BUF) { free(bufP); }
 
     TRACE0("FINISHED\n");
@@ -192,9 +192,8 @@ JNIEXPORT void JNICALL Java_sun_security_pkcs11_wrapper_PKCS11_C_1SignUpdate
         bufP = BUF;
     } else {
         bufLen = min(MAX_HEAP_BUFFER_LEN, jInLen);
-        bufP = (CK_BYTE_PTR) malloc((size_t)bufLen);
+        bufP = getScratchBuffer(env, bufLen);
         if (bufP == NULL) {
-            throwOutOfMemoryError(env, 0);
             return;
         }
     }
@@ -214,7 +213,7 @@ JNIEXPORT void JNICALL Java_sun_security_pkcs11_wrapper_PKCS11_C_1SignUpdate
     }
 
 cleanup:
-    if (bufP != BUF) { free(bufP); }
+    if (bufP != BUF) { releaseScratchBuffer(bufP); }
 
     return;
 }
@@ -342,9 +341,8 @@ JNIEXPORT jint JNICALL Java_sun_security_pkcs11_wrapper_PKCS11_C_1SignRecover
         inBufP = INBUF;
         ckSignatureLength = MAX_STACK_BUFFER_LEN;
     } else {
-        inBufP = (CK_BYTE_PTR) malloc((size_t)jInLen);
+        inBufP = getScratchBuffer(env, jInLen);
         if (inBufP == NULL) {
-            throwOutOfMemoryError(env, 0);
             return 0;
         }
         ckSignatureLength = jInLen;
@@ -369,7 +367,7 @@ JNIEXPORT jint JNICALL Java_sun_security_pkcs11_wrapper_PKCS11_C_1SignRecover
         (*env)->SetByteArrayRegion(env, jOut, jOutOfs, ckSignatureLength, (jbyte *)outBufP);
     }
 cleanup:
-    if (inBufP != INBUF) { free(inBufP); }
+    if (inBufP != INBUF) { releaseScratchBuffer(inBufP); }
     if (outBufP != OUTBUF) { free(outBufP); }
 
     return ckSignatureLength;
@@ -447,12 +445,12 @@ JNIEXPORT void JNICALL Java_sun_security_pkcs11_wrapper_PKCS11_C_1Verify
 
     ckSessionHandle = jLongToCKULong(jSessionHandle);
 
-    jByteArrayToCKByteArray(env, jData, &ckpData, &ckDataLength);
+    jByteArrayToScratchBuffer(env, jData, &ckpData, &ckDataLength);
     if ((*env)->ExceptionCheck(env)) {
         return;
     }
 
-    jByteArrayToCKByteArray(env, jSignature, &ckpSignature, &ckSignatureLength);
+    jByteArrayToScratchBuffer(env, jSignature, &ckpSignature, &ckSignatureLength);
     if ((*env)->ExceptionCheck(env)) {
         goto cleanup;
     }
@@ -461,8 +459,8 @@ JNIEXPORT void JNICALL Java_sun_security_pkcs11_wrapper_PKCS11_C_1Verify
     rv = (*ckpFunctions->C_Verify)(ckSessionHandle, ckpData, ckDataLength, ckpSignature, ckSignatureLength);
 
 cleanup:
-    free(ckpData);
-    free(ckpSignature);
+    releaseScratchBuffer(ckpData);
+    releaseScratchBuffer(ckpSignature);
 
     ckAssertReturnValueOK(env, rv);
 }
@@ -503,9 +501,8 @@ JNIEXPORT void JNICALL Java_sun_security_pkcs11_wrapper_PKCS11_C_1VerifyUpdate
         bufP = BUF;
     } else {
         bufLen = min(MAX_HEAP_BUFFER_LEN, jInLen);
-        bufP = (CK_BYTE_PTR) malloc((size_t)bufLen);
+        bufP = getScratchBuffer(env, bufLen);
         if (bufP == NULL) {
-            throwOutOfMemoryError(env, 0);
             goto cleanup;
         }
     }
@@ -526,7 +523,7 @@ JNIEXPORT void JNICALL Java_sun_security_pkcs11_wrapper_PKCS11_C_1VerifyUpdate
     }
 
 cleanup:
-    if (bufP != BUF) { free(bufP); }
+    if (bufP != BUF) { releaseScratchBuffer(bufP); }
 }
 #endif
 
@@ -640,9 +637,8 @@ JNIEXPORT jint JNICALL Java_sun_security_pkcs11_wrapper_PKCS11_C_1VerifyRecover
         inBufP = INBUF;
         ckDataLength = MAX_STACK_BUFFER_LEN;
     } else {
-        inBufP = (CK_BYTE_PTR) malloc((size_t)jInLen);
+        inBufP = getScratchBuffer(env, jInLen);
         if (inBufP == NULL) {
-            throwOutOfMemoryError(env, 0);
             return 0;
         }
         ckDataLength = jInLen;
@@ -669,7 +665,7 @@ JNIEXPORT jint JNICALL Java_sun_security_pkcs11_wrapper_PKCS11_C_1VerifyRecover
     }
 
 cleanup:
-    if (inBufP != INBUF) { free(inBufP); }
+    if (inBufP != INBUF) { releaseScratchBuffer(inBufP); }
     if (outBufP != OUTBUF) { free(outBufP); }
 
     return ckDataLength;
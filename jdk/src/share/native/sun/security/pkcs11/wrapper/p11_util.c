@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2003, 2019, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2003, 2026, Oracle and/or its affiliates. All rights reserved.
  */
 
 /* Copyright  (c) 2002 Graz University of Technology. All rights reserved.
@@ -566,6 +566,123 @@ void jByteArrayToCKByteArray(JNIEnv *env, const jbyteArray jArray, CK_BYTE_PTR *
     }
 }
 
+/*
+ * The scratch buffer of a thread is used instead of malloc for data that
+ * does not fit into a stack buffer. It grows up to MAX_HEAP_BUFFER_LEN bytes,
+ * is reused by later calls on the same thread and is freed when the thread
+ * exits. The data follows the header.
+ */
+typedef struct ScratchBuffer {
+    CK_ULONG size;
+    CK_BBOOL inUse;
+} ScratchBuffer;
+
+#define SCRATCH_DATA(s) ((CK_BYTE_PTR) ((s) + 1))
+
+/*
+ * returns a buffer of at least len bytes which has to be released with
+ * releaseScratchBuffer after use. The scratch buffer of the calling thread
+ * is returned if it is free and len is at most MAX_HEAP_BUFFER_LEN,
+ * otherwise memory is allocated. Throws OutOfMemoryError and returns
+ * NULL if no memory is available.
+ *
+ * @param env - used to call JNI functions
+ * @param len - the number of bytes needed
+ * @return - the buffer
+ */
+CK_BYTE_PTR getScratchBuffer(JNIEnv *env, CK_ULONG len)
+{
+    ScratchBuffer *scratch;
+    ScratchBuffer *grown;
+    CK_ULONG size;
+    CK_BYTE_PTR bufP;
+
+    if (len <= MAX_HEAP_BUFFER_LEN) {
+        scratch = (ScratchBuffer *) getThreadScratch();
+        if (scratch != NULL && scratch->inUse) {
+            /* nested use, fall through to malloc */
+        } else if (scratch != NULL && scratch->size >= len) {
+            scratch->inUse = TRUE;
+            return SCRATCH_DATA(scratch);
+        } else {
+            /* grow in powers of two to avoid reallocating for every size */
+            size = 2 * MAX_STACK_BUFFER_LEN;
+            while (size < len) {
+                size <<= 1;
+            }
+            grown = (ScratchBuffer *) malloc(sizeof(ScratchBuffer) + (size_t)size);
+            if (grown != NULL) {
+                grown->size = size;
+                grown->inUse = TRUE;
+                if (setThreadScratch(grown)) {
+                    free(scratch);
+                    return SCRATCH_DATA(grown);
+                }
+                free(grown);
+            }
+        }
+    }
+
+    bufP = (CK_BYTE_PTR) malloc((size_t)(len > 0 ? len : 1));
+    if (bufP == NULL) {
+        throwOutOfMemoryError(env, 0);
+    }
+    return bufP;
+}
+
+/*
+ * releases a buffer returned by getScratchBuffer or jByteArrayToScratchBuffer.
+ *
+ * @param bufP - the buffer, may be NULL
+ */
+void releaseScratchBuffer(CK_BYTE_PTR bufP)
+{
+    ScratchBuffer *scratch;
+
+    if (bufP == NULL) {
+        return;
+    }
+    scratch = (ScratchBuffer *) getThreadScratch();
+    if (scratch != NULL && bufP == SCRATCH_DATA(scratch)) {
+        scratch->inUse = FALSE;
+    } else {
+        free(bufP);
+    }
+}
+
+/*
+ * converts a jbyteArray to a CK_BYTE array like jByteArrayToCKByteArray,
+ * but copies the data into a buffer from getScratchBuffer. The buffer has
+ * to be released with releaseScratchBuffer after use!
+ *
+ * @param env - used to call JNI functions to get the array information
+ * @param jArray - the Java array to convert
+ * @param ckpArray - the reference, where the pointer to the new CK_BYTE array will be stored
+ * @param ckpLength - the reference, where the array length will be stored
+ */
+void jByteArrayToScratchBuffer(JNIEnv *env, const jbyteArray jArray, CK_BYTE_PTR *ckpArray, CK_ULONG_PTR ckpLength)
+{
+    if (sizeof(CK_BYTE) != sizeof(jbyte)) {
+        jByteArrayToCKByteArray(env, jArray, ckpArray, ckpLength);
+        return;
+    }
+    *ckpArray = NULL_PTR;
+    if(jArray == NULL) {
+        *ckpLength = 0L;
+        return;
+    }
+    *ckpLength = (*env)->GetArrayLength(env, jArray);
+    *ckpArray = getScratchBuffer(env, *ckpLength);
+    if (*ckpArray == NULL) {
+        return;
+    }
+    (*env)->GetByteArrayRegion(env, jArray, 0, *ckpLength, (jbyte *) *ckpArray);
+    if ((*env)->ExceptionCheck(env)) {
+        releaseScratchBuffer(*ckpArray);
+        *ckpArray = NULL_PTR;
+    }
+}
+
 /*
  * converts a jlongArray to a CK_ULONG array. The allocated memory has to be freed after use!
  *
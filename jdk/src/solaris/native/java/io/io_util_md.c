@@ -39,6 +39,8 @@
 #include "jvm.h"
 #include "io_util.h"
 #include "io_util_md.h"
+#include <pthread.h>
+#include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
 
@@ -230,3 +232,53 @@ getLastErrorString(char *buf, size_t len)
     getErrorString(errno, buf, len);
     return strlen(buf);
 }
+
+/*
+ * Per-thread buffers for getThreadBuffer, freed by the key destructor
+ * when the thread exits. The capacity is stored in front of the data.
+ */
+static pthread_key_t threadBufferKey;
+static pthread_once_t threadBufferOnce = PTHREAD_ONCE_INIT;
+static int threadBufferKeyValid = 0;
+
+static void
+createThreadBufferKey(void)
+{
+    threadBufferKeyValid = (pthread_key_create(&threadBufferKey, free) == 0);
+}
+
+char*
+getThreadBuffer(size_t len)
+{
+    size_t *buf;
+    size_t capacity;
+
+    if (len > THREAD_BUFFER_MAX) {
+        return NULL;
+    }
+    pthread_once(&threadBufferOnce, createThreadBufferKey);
+    if (!threadBufferKeyValid) {
+        return NULL;
+    }
+    buf = (size_t *)pthread_getspecific(threadBufferKey);
+    if (buf == NULL || buf[0] < len) {
+        /* Grow in powers of two so a few sizes do not cause reallocations */
+        capacity = 16 * 1024;
+        while (capacity < len) {
+            capacity <<= 1;
+        }
+        free(buf);
+        buf = (size_t *)malloc(sizeof(size_t) + capacity);
+        if (buf != NULL) {
+            buf[0] = capacity;
+        }
+        if (pthread_setspecific(threadBufferKey, buf) != 0) {
+            free(buf);
+            return NULL;
+        }
+        if (buf == NULL) {
+            return NULL;
+        }
+    }
+    return (char *)(buf + 1);
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2014, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2014, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -29,6 +29,9 @@
 #include <netinet/tcp.h>
 #include <netinet/in.h>
 #endif
+#ifdef __linux__
+#include <linux/filter.h>
+#endif
 
 #include "net_util.h"
 #include "jdk_net_SocketFlow.h"
@@ -350,14 +353,14 @@ static jboolean flowSupported0() {
 #define SOCK_OPT_NAME_KEEPIDLE_STR "TCP_KEEPALIVE"
 #endif
 
-static jint socketOptionSupported(jint sockopt) {
+static jint socketOptionSupported(jint level, jint sockopt) {
     jint one = 1;
     jint rv, s;
     s = socket(PF_INET, SOCK_STREAM, IPPROTO_TCP);
     if (s < 0) {
         return 0;
     }
-    rv = setsockopt(s, SOCK_OPT_LEVEL, sockopt, (void *) &one, sizeof (one));
+    rv = setsockopt(s, level, sockopt, (void *) &one, sizeof (one));
     if (rv != 0 && errno == ENOPROTOOPT) {
         rv = 0;
     } else {
@@ -451,8 +454,9 @@ JNIEXPORT jboolean JNICALL Java_sun_net_ExtendedOptionsImpl_flowSupported
  */
 JNIEXPORT jboolean JNICALL Java_sun_net_ExtendedOptionsImpl_keepAliveOptionsSupported
 (JNIEnv *env, jobject unused) {
-    return socketOptionSupported(SOCK_OPT_NAME_KEEPIDLE) && socketOptionSupported(TCP_KEEPCNT)
-            && socketOptionSupported(TCP_KEEPINTVL);
+    return socketOptionSupported(SOCK_OPT_LEVEL, SOCK_OPT_NAME_KEEPIDLE)
+            && socketOptionSupported(SOCK_OPT_LEVEL, TCP_KEEPCNT)
+            && socketOptionSupported(SOCK_OPT_LEVEL, TCP_KEEPINTVL);
 }
 
 #else
@@ -534,3 +538,188 @@ JNIEXPORT jint JNICALL Java_sun_net_ExtendedOptionsImpl_getTcpKeepAliveIntvl
     return getTcpSocketOption(env, fileDesc, TCP_KEEPINTVL, SOCK_OPT_LEVEL,
                               "get option TCP_KEEPINTVL failed");
 }
+
+/*
+ * SO_REUSEPORT lets several listening sockets bind the same address and
+ * port, each with its own accept queue, and the kernel spreads incoming
+ * connections over them. SO_INCOMING_CPU and the reuseport steering
+ * program below are Linux only: with setReusePortCpuDispatch the
+ * listener that receives a connection is chosen by the CPU that handled
+ * the connection's packets, so an acceptor thread pinned to a CPU gets
+ * the connections whose network processing already ran there.
+ */
+#if defined(__linux__) || defined(MACOSX)
+
+#ifdef __linux__
+#ifndef SO_REUSEPORT
+#define SO_REUSEPORT 15
+#endif
+#ifndef SO_INCOMING_CPU
+#define SO_INCOMING_CPU 49
+#endif
+#ifndef SO_ATTACH_REUSEPORT_CBPF
+#define SO_ATTACH_REUSEPORT_CBPF 51
+#endif
+#endif /* __linux__ */
+
+#define REUSEPORT_SUPPORTED 1
+
+#endif
+
+#ifdef REUSEPORT_SUPPORTED
+
+/*
+ * Class:     sun_net_ExtendedOptionsImpl
+ * Method:    reusePortSupported
+ * Signature: ()Z
+ */
+JNIEXPORT jboolean JNICALL Java_sun_net_ExtendedOptionsImpl_reusePortSupported
+(JNIEnv *env, jobject unused) {
+    return socketOptionSupported(SOL_SOCKET, SO_REUSEPORT);
+}
+
+/*
+ * Class:     sun_net_ExtendedOptionsImpl
+ * Method:    setReusePort
+ * Signature: (Ljava/io/FileDescriptor;Z)V
+ */
+JNIEXPORT void JNICALL Java_sun_net_ExtendedOptionsImpl_setReusePort
+(JNIEnv *env, jobject unused, jobject fileDesc, jboolean on) {
+    setTcpSocketOption(env, fileDesc, on ? 1 : 0, SO_REUSEPORT, SOL_SOCKET,
+                       "set option SO_REUSEPORT failed");
+}
+
+/*
+ * Class:     sun_net_ExtendedOptionsImpl
+ * Method:    getReusePort
+ * Signature: (Ljava/io/FileDescriptor;)Z
+ */
+JNIEXPORT jboolean JNICALL Java_sun_net_ExtendedOptionsImpl_getReusePort
+(JNIEnv *env, jobject unused, jobject fileDesc) {
+    return getTcpSocketOption(env, fileDesc, SO_REUSEPORT, SOL_SOCKET,
+                              "get option SO_REUSEPORT failed") > 0;
+}
+
+#else /* REUSEPORT_SUPPORTED */
+
+JNIEXPORT jboolean JNICALL Java_sun_net_ExtendedOptionsImpl_reusePortSupported
+(JNIEnv *env, jobject unused) {
+    return JNI_FALSE;
+}
+
+JNIEXPORT void JNICALL Java_sun_net_ExtendedOptionsImpl_setReusePort
+(JNIEnv *env, jobject unused, jobject fileDesc, jboolean on) {
+    JNU_ThrowByName(env, "java/lang/UnsupportedOperationException",
+        "unsupported socket option");
+}
+
+JNIEXPORT jboolean JNICALL Java_sun_net_ExtendedOptionsImpl_getReusePort
+(JNIEnv *env, jobject unused, jobject fileDesc) {
+    JNU_ThrowByName(env, "java/lang/UnsupportedOperationException",
+        "unsupported socket option");
+    return JNI_FALSE;
+}
+
+#endif /* REUSEPORT_SUPPORTED */
+
+#ifdef __linux__
+
+/*
+ * Class:     sun_net_ExtendedOptionsImpl
+ * Method:    incomingCpuSupported
+ * Signature: ()Z
+ */
+JNIEXPORT jboolean JNICALL Java_sun_net_ExtendedOptionsImpl_incomingCpuSupported
+(JNIEnv *env, jobject unused) {
+    return socketOptionSupported(SOL_SOCKET, SO_INCOMING_CPU);
+}
+
+/*
+ * Class:     sun_net_ExtendedOptionsImpl
+ * Method:    setIncomingCpu
+ * Signature: (Ljava/io/FileDescriptor;I)V
+ */
+JNIEXPORT void JNICALL Java_sun_net_ExtendedOptionsImpl_setIncomingCpu
+(JNIEnv *env, jobject unused, jobject fileDesc, jint cpu) {
+    setTcpSocketOption(env, fileDesc, cpu, SO_INCOMING_CPU, SOL_SOCKET,
+                       "set option SO_INCOMING_CPU failed");
+}
+
+/*
+ * Class:     sun_net_ExtendedOptionsImpl
+ * Method:    getIncomingCpu
+ * Signature: (Ljava/io/FileDescriptor;)I
+ */
+JNIEXPORT jint JNICALL Java_sun_net_ExtendedOptionsImpl_getIncomingCpu
+(JNIEnv *env, jobject unused, jobject fileDesc) {
+    return getTcpSocketOption(env, fileDesc, SO_INCOMING_CPU, SOL_SOCKET,
+                              "get option SO_INCOMING_CPU failed");
+}
+
+/*
+ * Class:     sun_net_ExtendedOptionsImpl
+ * Method:    setReusePortCpuDispatch
+ * Signature: (Ljava/io/FileDescriptor;I)V
+ *
+ * Attaches a steering program to the SO_REUSEPORT group of the given
+ * socket that hands a new connection to listener (cpu % groupSize),
+ * listeners being numbered in the order they were bound.
+ */
+JNIEXPORT void JNICALL Java_sun_net_ExtendedOptionsImpl_setReusePortCpuDispatch
+(JNIEnv *env, jobject unused, jobject fileDesc, jint groupSize) {
+    int fd = getFD(env, fileDesc);
+
+    if (fd < 0) {
+        NET_ERROR(env, JNU_JAVANETPKG "SocketException", "socket closed");
+        return;
+    }
+    if (groupSize <= 0) {
+        JNU_ThrowIllegalArgumentException(env, "group size must be positive");
+        return;
+    } else {
+        struct sock_filter code[] = {
+            /* A = current cpu */
+            { BPF_LD  | BPF_W | BPF_ABS, 0, 0, SKF_AD_OFF + SKF_AD_CPU },
+            /* A = A % groupSize */
+            { BPF_ALU | BPF_MOD | BPF_K, 0, 0, (__u32) groupSize },
+            /* return A */
+            { BPF_RET | BPF_A, 0, 0, 0 }
+        };
+        struct sock_fprog prog;
+        jint rv;
+
+        prog.len = sizeof(code) / sizeof(code[0]);
+        prog.filter = code;
+        rv = setsockopt(fd, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF,
+                        &prog, sizeof(prog));
+        handleError(env, rv, "set option SO_ATTACH_REUSEPORT_CBPF failed");
+    }
+}
+
+#else /* __linux__ */
+
+JNIEXPORT jboolean JNICALL Java_sun_net_ExtendedOptionsImpl_incomingCpuSupported
+(JNIEnv *env, jobject unused) {
+    return JNI_FALSE;
+}
+
+JNIEXPORT void JNICALL Java_sun_net_ExtendedOptionsImpl_setIncomingCpu
+(JNIEnv *env, jobject unused, jobject fileDesc, jint cpu) {
+    JNU_ThrowByName(env, "java/lang/UnsupportedOperationException",
+        "unsupported socket option");
+}
+
+JNIEXPORT jint JNICALL Java_sun_net_ExtendedOptionsImpl_getIncomingCpu
+(JNIEnv *env, jobject unused, jobject fileDesc) {
+    JNU_ThrowByName(env, "java/lang/UnsupportedOperationException",
+        "unsupported socket option");
+    return -1;
+}
+
+JNIEXPORT void JNICALL Java_sun_net_ExtendedOptionsImpl_setReusePortCpuDispatch
+(JNIEnv *env, jobject unused, jobject fileDesc, jint groupSize) {
+    JNU_ThrowByName(env, "java/lang/UnsupportedOperationException",
+        "unsupported socket option");
+}
+
+#endif /* __linux__ */
@@ -100,6 +100,7 @@ Java_java_net_SocketInputStream_socketRead0(JNIEnv *env, jobject this,
 {
     char BUF[MAX_BUFFER_LEN];
     char *bufP;
+    char *heapBufP = NULL;
     jint fd, nread;
 
     if (IS_NULL(fdObj)) {
@@ -119,17 +120,24 @@ Java_java_net_SocketInputStream_socketRead0(JNIEnv *env, jobject this,
     }
 
     /*
-     * If the read is greater than our stack allocated buffer then
-     * we allocate from the heap (up to a limit)
+     * If the read is greater than our stack allocated buffer then we
+     * use the thread's reusable buffer, or allocate from the heap (up
+     * to a limit) if there is none.
      */
     if (len > MAX_BUFFER_LEN) {
-        if (len > MAX_HEAP_BUFFER_LEN) {
-            len = MAX_HEAP_BUFFER_LEN;
+        if (len > NET_THREAD_BUFFER_MAX) {
+            len = NET_THREAD_BUFFER_MAX;
         }
-        bufP = (char *)malloc((size_t)len);
+        bufP = NET_GetThreadBuffer((size_t)len);
         if (bufP == NULL) {
-            bufP = BUF;
-            len = MAX_BUFFER_LEN;
+            if (len > MAX_HEAP_BUFFER_LEN) {
+                len = MAX_HEAP_BUFFER_LEN;
+            }
+            bufP = heapBufP = (char *)malloc((size_t)len);
+            if (bufP == NULL) {
+                bufP = BUF;
+                len = MAX_BUFFER_LEN;
+            }
         }
     } else {
         bufP = BUF;
@@ -155,8 +163,8 @@ Java_java_net_SocketInputStream_socketRead0(JNIEnv *env, jobject this,
                 JNU_ThrowByName(env, JNU_JAVAIOPKG "InterruptedIOException",
                             "Operation interrupted");
             }
-            if (bufP != BUF) {
-                free(bufP);
+            if (heapBufP != NULL) {
+                free(heapBufP);
             }
             return -1;
         }
@@ -167,8 +175,8 @@ Java_java_net_SocketInputStream_socketRead0(JNIEnv *env, jobject this,
     if (timeout) {
         nread = NET_ReadWithTimeout(env, fd, bufP, len, timeout);
         if ((*env)->ExceptionCheck(env)) {
-            if (bufP != BUF) {
-                free(bufP);
+            if (heapBufP != NULL) {
+                free(heapBufP);
             }
             return nread;
         }
@@ -205,8 +213,8 @@ Java_java_net_SocketInputStream_socketRead0(JNIEnv *env, jobject this,
         (*env)->SetByteArrayRegion(env, data, off, nread, (jbyte *)bufP);
     }
 
-    if (bufP != BUF) {
-        free(bufP);
+    if (heapBufP != NULL) {
+        free(heapBufP);
     }
     return nread;
 }
@@ -33,6 +33,7 @@
 #include <netdb.h>
 #include <stdlib.h>
 #include <dlfcn.h>
+#include <pthread.h>
 #include <sys/time.h>
 
 #ifndef _ALLBSD_SOURCE
@@ -291,6 +292,54 @@ NET_ThrowNew(JNIEnv *env, int errorNumber, char *msg) {
 }
 
 
+/*
+ * The capacity of a per-thread buffer is stored in front of its data.
+ */
+static pthread_key_t threadBufferKey;
+static pthread_once_t threadBufferOnce = PTHREAD_ONCE_INIT;
+static int threadBufferKeyValid = 0;
+
+static void
+createThreadBufferKey(void)
+{
+    threadBufferKeyValid = (pthread_key_create(&threadBufferKey, free) == 0);
+}
+
+char*
+NET_GetThreadBuffer(size_t len)
+{
+    size_t *buf;
+    size_t capacity;
+
+    if (len > NET_THREAD_BUFFER_MAX) {
+        return NULL;
+    }
+    pthread_once(&threadBufferOnce, createThreadBufferKey);
+    if (!threadBufferKeyValid) {
+        return NULL;
+    }
+    buf = (size_t *)pthread_getspecific(threadBufferKey);
+    if (buf == NULL || buf[0] < len) {
+        capacity = MAX_BUFFER_LEN * 2;
+        while (capacity < len) {
+            capacity <<= 1;
+        }
+        free(buf);
+        buf = (size_t *)malloc(sizeof(size_t) + capacity);
+        if (buf != NULL) {
+            buf[0] = capacity;
+        }
+        if (pthread_setspecific(threadBufferKey, buf) != 0) {
+            free(buf);
+            return NULL;
+        }
+        if (buf == NULL) {
+            return NULL;
+        }
+    }
+    return (char *)(buf + 1);
+}
+
 jfieldID
 NET_GetFileDescriptorID(JNIEnv *env)
 {
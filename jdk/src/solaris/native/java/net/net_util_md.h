@@ -163,6 +163,15 @@ extern jint NET_Wait(JNIEnv *env, jint fd, jint flags, jint timeout);
 #define MAX_HEAP_BUFFER_LEN 65536
 #endif
 
+/*
+ * Largest read done through the per-thread buffer of NET_GetThreadBuffer,
+ * which is reused by the thread's later reads and freed when it exits.
+ * Returns NULL if len is larger or no memory is available.
+ */
+#define NET_THREAD_BUFFER_MAX (256 * 1024)
+
+extern char* NET_GetThreadBuffer(size_t len);
+
 #ifdef AF_INET6
 
 #define SOCKADDR        union { \
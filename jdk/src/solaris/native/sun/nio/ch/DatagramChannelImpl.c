@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2001, 2012, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2001, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -39,6 +39,17 @@
 #include <netinet/in.h>
 #endif
 
+#ifdef __linux__
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <netinet/udp.h>
+#if defined(__NR_recvmmsg) && defined(__NR_sendmmsg)
+#define HAVE_MMSG 1
+#endif
+#endif
+
 #include "net_util.h"
 #include "net_util_md.h"
 #include "nio.h"
@@ -141,6 +152,46 @@ Java_sun_nio_ch_DatagramChannelImpl_disconnect0(JNIEnv *env, jobject this,
 
 }
 
+/*
+ * Sets the sender field of the DatagramChannelImpl to the address in sa
+ * and returns it, or returns NULL with an exception pending.
+ *
+ * If the source address and port match the cached address
+ * and port in DatagramChannelImpl then we don't need to
+ * create InetAddress and InetSocketAddress objects.
+ */
+static jobject
+updateSender(JNIEnv *env, jobject this, struct sockaddr *sa)
+{
+    jobject senderAddr = (*env)->GetObjectField(env, this, dci_senderAddrID);
+    if (senderAddr != NULL) {
+        if (!NET_SockaddrEqualsInetAddress(env, sa, senderAddr)) {
+            senderAddr = NULL;
+        } else {
+            jint port = (*env)->GetIntField(env, this, dci_senderPortID);
+            if (port != NET_GetPortFromSockaddr(sa)) {
+                senderAddr = NULL;
+            }
+        }
+    }
+    if (senderAddr == NULL) {
+        jobject isa = NULL;
+        int port = 0;
+        jobject ia = NET_SockaddrToInetAddress(env, sa, &port);
+        if (ia != NULL) {
+            isa = (*env)->NewObject(env, isa_class, isa_ctorID, ia, port);
+        }
+        CHECK_NULL_RETURN(isa, NULL);
+
+        (*env)->SetObjectField(env, this, dci_senderAddrID, ia);
+        (*env)->SetIntField(env, this, dci_senderPortID,
+                            NET_GetPortFromSockaddr(sa));
+        (*env)->SetObjectField(env, this, dci_senderID, isa);
+        return isa;
+    }
+    return (*env)->GetObjectField(env, this, dci_senderID);
+}
+
 JNIEXPORT jint JNICALL
 Java_sun_nio_ch_DatagramChannelImpl_receive0(JNIEnv *env, jobject this,
                                              jobject fdo, jlong address,
@@ -152,7 +203,6 @@ Java_sun_nio_ch_DatagramChannelImpl_receive0(JNIEnv *env, jobject this,
     socklen_t sa_len = SOCKADDR_LEN;
     jboolean retry = JNI_FALSE;
     jint n = 0;
-    jobject senderAddr;
 
     if (len > MAX_PACKET_LEN) {
         len = MAX_PACKET_LEN;
@@ -182,37 +232,8 @@ Java_sun_nio_ch_DatagramChannelImpl_receive0(JNIEnv *env, jobject this,
         }
     } while (retry == JNI_TRUE);
 
-    /*
-     * If the source address and port match the cached address
-     * and port in DatagramChannelImpl then we don't need to
-     * create InetAddress and InetSocketAddress objects.
-     */
-    senderAddr = (*env)->GetObjectField(env, this, dci_senderAddrID);
-    if (senderAddr != NULL) {
-        if (!NET_SockaddrEqualsInetAddress(env, (struct sockaddr *)&sa,
-                                           senderAddr)) {
-            senderAddr = NULL;
-        } else {
-            jint port = (*env)->GetIntField(env, this, dci_senderPortID);
-            if (port != NET_GetPortFromSockaddr((struct sockaddr *)&sa)) {
-                senderAddr = NULL;
-            }
-        }
-    }
-    if (senderAddr == NULL) {
-        jobject isa = NULL;
-        int port = 0;
-        jobject ia = NET_SockaddrToInetAddress(env, (struct sockaddr *)&sa, &port);
-        if (ia != NULL) {
-            isa = (*env)->NewObject(env, isa_class, isa_ctorID, ia, port);
-        }
-        CHECK_NULL_RETURN(isa, IOS_THROWN);
-
-        (*env)->SetObjectField(env, this, dci_senderAddrID, ia);
-        (*env)->SetIntField(env, this, dci_senderPortID,
-                            NET_GetPortFromSockaddr((struct sockaddr *)&sa));
-        (*env)->SetObjectField(env, this, dci_senderID, isa);
-    }
+    CHECK_NULL_RETURN(updateSender(env, this, (struct sockaddr *)&sa),
+                      IOS_THROWN);
     return n;
 }
 
@@ -253,3 +274,377 @@ Java_sun_nio_ch_DatagramChannelImpl_send0(JNIEnv *env, jobject this,
     }
     return n;
 }
+
+/*
+ * Batch receive and send.
+ *
+ * On Linux receiveMany0 and sendMany0 move up to count datagrams in one
+ * recvmmsg/sendmmsg system call. The caller allocates a native scratch
+ * area of batchScratchSize0(count) bytes once and passes it to every
+ * call, so the message headers, socket addresses and control buffers
+ * are not allocated per call. Where the kernel supports UDP generic
+ * segmentation offload a single large buffer may be sent as a train of
+ * segmentSize datagrams, and with UDP_GRO enabled (setGRO0) a received
+ * buffer may hold several coalesced datagrams of the reported segment
+ * size. batchSupported0 returns false when the system calls are not
+ * available, in which case the caller falls back to receive0/send0.
+ */
+
+#ifdef HAVE_MMSG
+
+#ifndef SOL_UDP
+#define SOL_UDP 17
+#endif
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+#ifndef UDP_GRO
+#define UDP_GRO 104
+#endif
+
+#ifndef MSG_WAITFORONE
+#define MSG_WAITFORONE 0x10000
+#endif
+
+/* Maximum number of datagrams per call, the kernel's UIO_MAXIOV */
+#define MAX_BATCH 1024
+
+/* same layout as struct mmsghdr, which older headers do not define */
+struct nio_mmsghdr {
+    struct msghdr msg_hdr;
+    unsigned int msg_len;
+};
+
+typedef SOCKADDR batch_sockaddr;
+
+typedef union {
+    struct cmsghdr align;
+    char buf[CMSG_SPACE(sizeof(int))];
+} batch_control;
+
+/*
+ * The kernel wants the message headers in a contiguous array, so the
+ * scratch area for count messages holds count headers followed by the
+ * iovecs, control buffers and socket addresses that they point to.
+ */
+#define BATCH_ENTRY_SIZE \
+    (sizeof(struct nio_mmsghdr) + sizeof(struct iovec) + \
+     sizeof(batch_sockaddr) + sizeof(batch_control))
+
+typedef struct {
+    struct nio_mmsghdr *hdrs;
+    struct iovec *iovs;
+    batch_sockaddr *addrs;
+    batch_control *controls;
+} batch_msgs;
+
+static void
+initBatch(batch_msgs *b, void *scratch, int count)
+{
+    b->hdrs = (struct nio_mmsghdr *)scratch;
+    b->iovs = (struct iovec *)(b->hdrs + count);
+    b->controls = (batch_control *)(b->iovs + count);
+    b->addrs = (batch_sockaddr *)(b->controls + count);
+}
+
+#endif /* HAVE_MMSG */
+
+JNIEXPORT jboolean JNICALL
+Java_sun_nio_ch_DatagramChannelImpl_batchSupported0(JNIEnv *env, jclass clazz)
+{
+#ifdef HAVE_MMSG
+    /* an invalid fd gives EBADF if the calls exist and ENOSYS if not */
+    if (syscall(__NR_recvmmsg, -1, NULL, 0, 0, NULL) < 0 && errno == ENOSYS) {
+        return JNI_FALSE;
+    }
+    if (syscall(__NR_sendmmsg, -1, NULL, 0, 0) < 0 && errno == ENOSYS) {
+        return JNI_FALSE;
+    }
+    return JNI_TRUE;
+#else
+    return JNI_FALSE;
+#endif
+}
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_DatagramChannelImpl_batchScratchSize0(JNIEnv *env, jclass clazz,
+                                                      jint count)
+{
+#ifdef HAVE_MMSG
+    if (count < 0) {
+        count = 0;
+    } else if (count > MAX_BATCH) {
+        count = MAX_BATCH;
+    }
+    return count * (jint)BATCH_ENTRY_SIZE;
+#else
+    return 0;
+#endif
+}
+
+JNIEXPORT jboolean JNICALL
+Java_sun_nio_ch_DatagramChannelImpl_setGRO0(JNIEnv *env, jclass clazz,
+                                            jobject fdo, jboolean on)
+{
+#ifdef HAVE_MMSG
+    jint fd = fdval(env, fdo);
+    int arg = (on == JNI_TRUE) ? 1 : 0;
+
+    if (setsockopt(fd, SOL_UDP, UDP_GRO, &arg, sizeof(arg)) < 0) {
+        if (errno == ENOPROTOOPT) {
+            return JNI_FALSE;
+        }
+        handleSocketError(env, errno);
+        return JNI_FALSE;
+    }
+    return JNI_TRUE;
+#else
+    return JNI_FALSE;
+#endif
+}
+
+/*
+ * Receives up to count datagrams into the buffers at addresses[i] of
+ * capacity lengths[i]. On return lengths[i] holds the number of bytes
+ * received, senders[i] the source address and, if segmentSizes is not
+ * null, segmentSizes[i] the GRO segment size or 0. Returns the number
+ * of datagrams received or an IOStatus code.
+ */
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_DatagramChannelImpl_receiveMany0(JNIEnv *env, jobject this,
+                                                 jobject fdo,
+                                                 jlongArray addresses,
+                                                 jintArray lengths,
+                                                 jintArray segmentSizes,
+                                                 jobjectArray senders,
+                                                 jint count, jlong scratch,
+                                                 jboolean connected)
+{
+#ifdef HAVE_MMSG
+    jint fd = fdval(env, fdo);
+    batch_msgs msgs;
+    jlong *addrs;
+    jint *lens;
+    jint *segs = NULL;
+    jboolean retry = JNI_FALSE;
+    int i, n;
+
+    if (count > MAX_BATCH) {
+        count = MAX_BATCH;
+    }
+    if (count <= 0) {
+        return 0;
+    }
+    initBatch(&msgs, jlong_to_ptr(scratch), count);
+
+    addrs = (*env)->GetLongArrayElements(env, addresses, NULL);
+    CHECK_NULL_RETURN(addrs, IOS_THROWN);
+    lens = (*env)->GetIntArrayElements(env, lengths, NULL);
+    if (lens == NULL) {
+        (*env)->ReleaseLongArrayElements(env, addresses, addrs, JNI_ABORT);
+        return IOS_THROWN;
+    }
+
+    for (i = 0; i < count; i++) {
+        struct msghdr *mh = &msgs.hdrs[i].msg_hdr;
+        jint len = lens[i];
+        if (len > MAX_PACKET_LEN) {
+            len = MAX_PACKET_LEN;
+        }
+        memset(&msgs.hdrs[i], 0, sizeof(msgs.hdrs[i]));
+        msgs.iovs[i].iov_base = jlong_to_ptr(addrs[i]);
+        msgs.iovs[i].iov_len = len;
+        mh->msg_iov = &msgs.iovs[i];
+        mh->msg_iovlen = 1;
+        mh->msg_name = &msgs.addrs[i];
+        mh->msg_namelen = SOCKADDR_LEN;
+        if (segmentSizes != NULL) {
+            mh->msg_control = msgs.controls[i].buf;
+            mh->msg_controllen = sizeof(msgs.controls[i].buf);
+        }
+    }
+    (*env)->ReleaseLongArrayElements(env, addresses, addrs, JNI_ABORT);
+
+    do {
+        retry = JNI_FALSE;
+        n = syscall(__NR_recvmmsg, fd, msgs.hdrs, count, MSG_WAITFORONE, NULL);
+        if (n < 0) {
+            if (errno == ECONNREFUSED && connected == JNI_FALSE) {
+                retry = JNI_TRUE;
+                continue;
+            }
+            (*env)->ReleaseIntArrayElements(env, lengths, lens, JNI_ABORT);
+            if (errno == EWOULDBLOCK) {
+                return IOS_UNAVAILABLE;
+            }
+            if (errno == EINTR) {
+                return IOS_INTERRUPTED;
+            }
+            if (errno == ECONNREFUSED) {
+                JNU_ThrowByName(env, JNU_JAVANETPKG
+                                "PortUnreachableException", 0);
+                return IOS_THROWN;
+            }
+            return handleSocketError(env, errno);
+        }
+    } while (retry == JNI_TRUE);
+
+    for (i = 0; i < n; i++) {
+        lens[i] = (jint)msgs.hdrs[i].msg_len;
+    }
+    (*env)->ReleaseIntArrayElements(env, lengths, lens, 0);
+
+    if (segmentSizes != NULL) {
+        segs = (*env)->GetIntArrayElements(env, segmentSizes, NULL);
+        CHECK_NULL_RETURN(segs, IOS_THROWN);
+        for (i = 0; i < n; i++) {
+            struct msghdr *mh = &msgs.hdrs[i].msg_hdr;
+            struct cmsghdr *cmsg;
+            segs[i] = 0;
+            for (cmsg = CMSG_FIRSTHDR(mh); cmsg != NULL;
+                 cmsg = CMSG_NXTHDR(mh, cmsg)) {
+                if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO) {
+                    int size;
+                    memcpy(&size, CMSG_DATA(cmsg), sizeof(size));
+                    segs[i] = size;
+                }
+            }
+        }
+        (*env)->ReleaseIntArrayElements(env, segmentSizes, segs, 0);
+    }
+
+    for (i = 0; i < n; i++) {
+        jobject isa = updateSender(env, this,
+                                   (struct sockaddr *)&msgs.addrs[i]);
+        CHECK_NULL_RETURN(isa, IOS_THROWN);
+        (*env)->SetObjectArrayElement(env, senders, i, isa);
+        (*env)->DeleteLocalRef(env, isa);
+        if ((*env)->ExceptionCheck(env)) {
+            return IOS_THROWN;
+        }
+    }
+    return n;
+#else
+    return IOS_UNSUPPORTED;
+#endif
+}
+
+/*
+ * Sends up to count datagrams from the buffers at addresses[i] of
+ * lengths[i] bytes to destAddresses[i]:destPorts[i], or to the connected
+ * peer when destAddresses is null. If segmentSize is positive each
+ * buffer is split by the kernel into datagrams of that size (UDP GSO).
+ * Returns the number of datagrams sent or an IOStatus code.
+ */
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_DatagramChannelImpl_sendMany0(JNIEnv *env, jobject this,
+                                              jboolean preferIPv6, jobject fdo,
+                                              jlongArray addresses,
+                                              jintArray lengths,
+                                              jobjectArray destAddresses,
+                                              jintArray destPorts,
+                                              jint count, jlong scratch,
+                                              jint segmentSize)
+{
+#ifdef HAVE_MMSG
+    jint fd = fdval(env, fdo);
+    batch_msgs msgs;
+    jlong *addrs;
+    jint *lens;
+    jint *ports = NULL;
+    int i, n;
+
+    if (count > MAX_BATCH) {
+        count = MAX_BATCH;
+    }
+    if (count <= 0) {
+        return 0;
+    }
+    initBatch(&msgs, jlong_to_ptr(scratch), count);
+
+    addrs = (*env)->GetLongArrayElements(env, addresses, NULL);
+    CHECK_NULL_RETURN(addrs, IOS_THROWN);
+    lens = (*env)->GetIntArrayElements(env, lengths, NULL);
+    if (lens == NULL) {
+        (*env)->ReleaseLongArrayElements(env, addresses, addrs, JNI_ABORT);
+        return IOS_THROWN;
+    }
+    if (destAddresses != NULL) {
+        ports = (*env)->GetIntArrayElements(env, destPorts, NULL);
+        if (ports == NULL) {
+            (*env)->ReleaseIntArrayElements(env, lengths, lens, JNI_ABORT);
+            (*env)->ReleaseLongArrayElements(env, addresses, addrs, JNI_ABORT);
+            return IOS_THROWN;
+        }
+    }
+
+    n = 0;
+    for (i = 0; i < count; i++) {
+        struct msghdr *mh = &msgs.hdrs[i].msg_hdr;
+        jint len = lens[i];
+        if (len > MAX_PACKET_LEN) {
+            len = MAX_PACKET_LEN;
+        }
+        memset(&msgs.hdrs[i], 0, sizeof(msgs.hdrs[i]));
+        msgs.iovs[i].iov_base = jlong_to_ptr(addrs[i]);
+        msgs.iovs[i].iov_len = len;
+        mh->msg_iov = &msgs.iovs[i];
+        mh->msg_iovlen = 1;
+        if (destAddresses != NULL) {
+            int sa_len = SOCKADDR_LEN;
+            jobject ia = (*env)->GetObjectArrayElement(env, destAddresses, i);
+            if (ia == NULL ||
+                NET_InetAddressToSockaddr(env, ia, ports[i],
+                                          (struct sockaddr *)&msgs.addrs[i],
+                                          &sa_len, preferIPv6) != 0) {
+                if (!(*env)->ExceptionCheck(env)) {
+                    JNU_ThrowNullPointerException(env, "destination address");
+                }
+                n = IOS_THROWN;
+                break;
+            }
+            (*env)->DeleteLocalRef(env, ia);
+            mh->msg_name = &msgs.addrs[i];
+            mh->msg_namelen = sa_len;
+        }
+        if (segmentSize > 0) {
+            struct cmsghdr *cmsg;
+            uint16_t size = (uint16_t)segmentSize;
+            mh->msg_control = msgs.controls[i].buf;
+            mh->msg_controllen = CMSG_SPACE(sizeof(uint16_t));
+            cmsg = CMSG_FIRSTHDR(mh);
+            cmsg->cmsg_level = SOL_UDP;
+            cmsg->cmsg_type = UDP_SEGMENT;
+            cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+            memcpy(CMSG_DATA(cmsg), &size, sizeof(size));
+        }
+    }
+
+    if (ports != NULL) {
+        (*env)->ReleaseIntArrayElements(env, destPorts, ports, JNI_ABORT);
+    }
+    (*env)->ReleaseIntArrayElements(env, lengths, lens, JNI_ABORT);
+    (*env)->ReleaseLongArrayElements(env, addresses, addrs, JNI_ABORT);
+    if (n == IOS_THROWN) {
+        return IOS_THROWN;
+    }
+
+    n = syscall(__NR_sendmmsg, fd, msgs.hdrs, count, 0);
+    if (n < 0) {
+        if (errno == EAGAIN) {
+            return IOS_UNAVAILABLE;
+        }
+        if (errno == EINTR) {
+            return IOS_INTERRUPTED;
+        }
+        if (errno == ECONNREFUSED) {
+            JNU_ThrowByName(env, JNU_JAVANETPKG "PortUnreachableException", 0);
+            return IOS_THROWN;
+        }
+        return handleSocketError(env, errno);
+    }
+    return n;
+#else
+    return IOS_UNSUPPORTED;
+#endif
+}
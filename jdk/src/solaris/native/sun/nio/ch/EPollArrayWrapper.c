@@ -31,8 +31,25 @@
 #include "sun_nio_ch_EPollArrayWrapper.h"
 
 #include <unistd.h>
+#include <stdint.h>
 #include <sys/time.h>
 #include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+/* Not defined by older headers; the kernel rejects it before 4.5 */
+#ifndef EPOLLEXCLUSIVE
+#define EPOLLEXCLUSIVE (1U << 28)
+#endif
+
+/*
+ * An entry of the update array passed to epollCtlBatch, written by the
+ * Java side as three consecutive ints.
+ */
+typedef struct {
+    jint fd;
+    jint opcode;
+    jint events;
+} epoll_update;
 
 #define RESTARTABLE(_cmd, _result) do { \
   do { \
@@ -129,6 +146,60 @@ Java_sun_nio_ch_EPollArrayWrapper_epollCtl(JNIEnv *env, jobject this, jint epfd,
     }
 }
 
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_EPollArrayWrapper_sizeofUpdate(JNIEnv* env, jclass this)
+{
+    return sizeof(epoll_update);
+}
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_EPollArrayWrapper_edgeTriggered(JNIEnv* env, jclass this)
+{
+    return EPOLLET;
+}
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_EPollArrayWrapper_exclusive(JNIEnv* env, jclass this)
+{
+    return EPOLLEXCLUSIVE;
+}
+
+/*
+ * Applies count updates from the epoll_update array at address, so that
+ * all pending registration changes of a poll cost one JNI transition.
+ * Errors are ignored as in epollCtl. EPOLLEXCLUSIVE can only be set with
+ * EPOLL_CTL_ADD, so a modify that requests it is done as delete and add.
+ * Returns the number of updates applied, which is less than count only
+ * if an exception is pending.
+ */
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_EPollArrayWrapper_epollCtlBatch(JNIEnv *env, jobject this, jint epfd,
+                                                jlong address, jint count)
+{
+    epoll_update *updates = (epoll_update *)jlong_to_ptr(address);
+    struct epoll_event event;
+    int i, res;
+
+    for (i = 0; i < count; i++) {
+        int opcode = (int)updates[i].opcode;
+        int fd = (int)updates[i].fd;
+
+        event.events = (uint32_t)updates[i].events;
+        event.data.fd = fd;
+
+        if (opcode == EPOLL_CTL_MOD && (event.events & EPOLLEXCLUSIVE) != 0) {
+            RESTARTABLE(epoll_ctl(epfd, EPOLL_CTL_DEL, fd, &event), res);
+            opcode = EPOLL_CTL_ADD;
+        }
+        RESTARTABLE(epoll_ctl(epfd, opcode, fd, &event), res);
+        if (res < 0 && errno != EBADF && errno != ENOENT && errno != EPERM) {
+            JNU_ThrowIOExceptionWithLastError(env, "epoll_ctl failed");
+            return i;
+        }
+    }
+    return count;
+}
+
 JNIEXPORT jint JNICALL
 Java_sun_nio_ch_EPollArrayWrapper_epollWait(JNIEnv *env, jobject this,
                                             jlong address, jint numfds,
@@ -149,6 +220,43 @@ Java_sun_nio_ch_EPollArrayWrapper_epollWait(JNIEnv *env, jobject this,
     return res;
 }
 
+/*
+ * An eventfd replaces the wakeup pipe: one descriptor instead of two,
+ * and repeated wakeups coalesce into one counter.
+ */
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_EPollArrayWrapper_eventfdCreate(JNIEnv *env, jclass this)
+{
+    int efd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (efd < 0) {
+        JNU_ThrowIOExceptionWithLastError(env, "eventfd failed");
+    }
+    return efd;
+}
+
+JNIEXPORT void JNICALL
+Java_sun_nio_ch_EPollArrayWrapper_eventfdSignal(JNIEnv *env, jclass this, jint efd)
+{
+    uint64_t one = 1;
+    int res;
+    RESTARTABLE(write(efd, &one, sizeof(one)), res);
+    /* EAGAIN means the counter is saturated and a wakeup is pending anyway */
+    if (res < 0 && errno != EAGAIN) {
+        JNU_ThrowIOExceptionWithLastError(env, "write to eventfd failed");
+    }
+}
+
+JNIEXPORT void JNICALL
+Java_sun_nio_ch_EPollArrayWrapper_eventfdDrain(JNIEnv *env, jclass this, jint efd)
+{
+    uint64_t value;
+    int res;
+    RESTARTABLE(read(efd, &value, sizeof(value)), res);
+    if (res < 0 && errno != EAGAIN) {
+        JNU_ThrowIOExceptionWithLastError(env, "read from eventfd failed");
+    }
+}
+
 JNIEXPORT void JNICALL
 Java_sun_nio_ch_EPollArrayWrapper_interrupt(JNIEnv *env, jobject this, jint fd)
 {
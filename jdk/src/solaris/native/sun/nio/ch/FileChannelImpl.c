@@ -29,7 +29,10 @@
 #include <sys/types.h>
 #include <unistd.h>
 
-#if defined(__linux__) || defined(__solaris__)
+#if defined(__linux__)
+#include <sys/sendfile.h>
+#include <sys/syscall.h>
+#elif defined(__solaris__)
 #include <sys/sendfile.h>
 #elif defined(_AIX)
 #include <sys/socket.h>
@@ -135,6 +138,129 @@ Java_sun_nio_ch_FileChannelImpl_close0(JNIEnv *env, jobject this, jobject fdo)
     }
 }
 
+#if defined(__linux__)
+
+/*
+ * In-kernel copy between two regular files, which reflink capable file
+ * systems can do by sharing extents. Returns -1 with errno set to
+ * ENOSYS when the kernel or the headers do not have copy_file_range.
+ */
+static jlong
+copy_file_range64(int srcFD, off64_t *srcOffset, int dstFD, off64_t *dstOffset, size_t count)
+{
+#if defined(__NR_copy_file_range)
+    return syscall(__NR_copy_file_range, srcFD, srcOffset, dstFD, dstOffset, count, 0);
+#else
+    errno = ENOSYS;
+    return -1;
+#endif
+}
+
+/* Converts the errno of a failed transfer into a status code */
+static jlong
+transfer_status(JNIEnv *env, jlong count)
+{
+    if (errno == EAGAIN)
+        return IOS_UNAVAILABLE;
+    if ((errno == EINVAL) && ((ssize_t)count >= 0))
+        return IOS_UNSUPPORTED_CASE;
+    if (errno == EINTR)
+        return IOS_INTERRUPTED;
+    JNU_ThrowIOExceptionWithLastError(env, "Transfer failed");
+    return IOS_THROWN;
+}
+
+/* Errors after which a plain copy may still succeed */
+static int
+copy_unsupported(int err)
+{
+    return err == ENOSYS || err == EXDEV || err == EINVAL ||
+           err == EOPNOTSUPP || err == EBADF;
+}
+
+/*
+ * Moves up to count bytes from srcFD, a socket or a pipe, to the file
+ * dstFD at dstOffset through a pipe, so the data never reaches user
+ * space. Everything read from srcFD is written before returning; an
+ * error during the write part is thrown since the data would be lost.
+ */
+static jlong
+splice_to_file(JNIEnv *env, int srcFD, int dstFD, off64_t *dstOffset, size_t count)
+{
+    int p[2];
+    jlong n, total = 0;
+
+    if (pipe2(p, O_CLOEXEC) < 0)
+        return IOS_UNSUPPORTED_CASE;
+
+    n = splice(srcFD, NULL, p[1], NULL, count, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+    if (n < 0) {
+        int err = errno;
+        close(p[0]);
+        close(p[1]);
+        errno = err;
+        if (copy_unsupported(err))
+            return IOS_UNSUPPORTED_CASE;
+        return transfer_status(env, count);
+    }
+    while (total < n) {
+        jlong w = splice(p[0], NULL, dstFD, dstOffset, (size_t)(n - total), SPLICE_F_MOVE);
+        if (w < 0 && errno == EINTR)
+            continue;
+        if (w <= 0) {
+            JNU_ThrowIOExceptionWithLastError(env, "Transfer failed");
+            total = IOS_THROWN;
+            break;
+        }
+        total += w;
+    }
+    close(p[0]);
+    close(p[1]);
+    return total;
+}
+
+#endif
+
+/*
+ * Transfers up to count bytes from srcFDO into the file dstFDO at
+ * position without copying through user space: copy_file_range when
+ * the source is a regular file and splice when it is a socket or a pipe.
+ * Returns IOS_UNSUPPORTED_CASE when the caller has to copy through a
+ * buffer instead.
+ */
+JNIEXPORT jlong JNICALL
+Java_sun_nio_ch_FileChannelImpl_transferFrom0(JNIEnv *env, jobject this,
+                                              jobject srcFDO, jobject dstFDO,
+                                              jlong position, jlong count)
+{
+#if defined(__linux__)
+    jint srcFD = fdval(env, srcFDO);
+    jint dstFD = fdval(env, dstFDO);
+    off64_t offset = (off64_t)position;
+    struct stat64 sb;
+    jlong n;
+
+    if (fstat64(srcFD, &sb) < 0)
+        return IOS_UNSUPPORTED_CASE;
+
+    if (S_ISREG(sb.st_mode)) {
+        n = copy_file_range64(srcFD, NULL, dstFD, &offset, (size_t)count);
+        if (n < 0) {
+            if (copy_unsupported(errno))
+                return IOS_UNSUPPORTED_CASE;
+            return transfer_status(env, count);
+        }
+        return n;
+    }
+    if (S_ISSOCK(sb.st_mode) || S_ISFIFO(sb.st_mode)) {
+        return splice_to_file(env, srcFD, dstFD, &offset, (size_t)count);
+    }
+    return IOS_UNSUPPORTED_CASE;
+#else
+    return IOS_UNSUPPORTED_CASE;
+#endif
+}
+
 JNIEXPORT jlong JNICALL
 Java_sun_nio_ch_FileChannelImpl_transferTo0(JNIEnv *env, jobject this,
                                             jobject srcFDO,
@@ -146,17 +272,31 @@ Java_sun_nio_ch_FileChannelImpl_transferTo0(JNIEnv *env, jobject this,
 
 #if defined(__linux__)
     off64_t offset = (off64_t)position;
-    jlong n = sendfile64(dstFD, srcFD, &offset, (size_t)count);
-    if (n < 0) {
-        if (errno == EAGAIN)
-            return IOS_UNAVAILABLE;
-        if ((errno == EINVAL) && ((ssize_t)count >= 0))
-            return IOS_UNSUPPORTED_CASE;
-        if (errno == EINTR) {
-            return IOS_INTERRUPTED;
+    struct stat64 sb;
+    jlong n;
+
+    if (fstat64(dstFD, &sb) == 0) {
+        if (S_ISREG(sb.st_mode)) {
+            /* file to file: let the file system copy or share the extents */
+            n = copy_file_range64(srcFD, &offset, dstFD, NULL, (size_t)count);
+            if (n >= 0)
+                return n;
+            if (!copy_unsupported(errno))
+                return transfer_status(env, count);
+            /* fall back to sendfile, which also handles regular files */
+        } else if (S_ISFIFO(sb.st_mode)) {
+            n = splice(srcFD, &offset, dstFD, NULL, (size_t)count,
+                       SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+            if (n >= 0)
+                return n;
+            if (!copy_unsupported(errno))
+                return transfer_status(env, count);
         }
-        JNU_ThrowIOExceptionWithLastError(env, "Transfer failed");
-        return IOS_THROWN;
+    }
+
+    n = sendfile64(dstFD, srcFD, &offset, (size_t)count);
+    if (n < 0) {
+        return transfer_status(env, count);
     }
     return n;
 #elif defined (__solaris__)
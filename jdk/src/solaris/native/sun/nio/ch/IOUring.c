@@ -0,0 +1,558 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * Native support for sun.nio.ch.IOUring, a thin wrapper over a Linux
+ * io_uring instance used by the io_uring asynchronous channel port.
+ *
+ * The Java side owns all synchronization: one thread at a time prepares
+ * submission queue entries and calls submit, and completions are copied
+ * out to a native array of io_uring_cqe structures whose layout is
+ * exposed by the cqe* functions below, in the same way EPoll exposes
+ * the epoll_event layout. When io_uring is not available at build or at
+ * run time isSupported returns false and the provider uses EPollPort.
+ */
+
+#include "jni.h"
+#include "jni_util.h"
+#include "jvm.h"
+#include "jlong.h"
+#include "nio.h"
+#include "nio_util.h"
+
+#include "sun_nio_ch_IOUring.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter) && defined(__NR_io_uring_register)
+#define HAVE_IO_URING 1
+#include <linux/io_uring.h>
+/* Need the 5.7 interface: IORING_OP_READ/WRITE, ACCEPT and fast poll */
+#ifndef IORING_FEAT_FAST_POLL
+#undef HAVE_IO_URING
+#endif
+#endif
+
+#ifdef HAVE_IO_URING
+
+typedef struct {
+    int fd;
+    unsigned features;
+
+    /* submission queue */
+    unsigned *sq_head;
+    unsigned *sq_tail;
+    unsigned *sq_mask;
+    unsigned *sq_array;
+    struct io_uring_sqe *sqes;
+    unsigned sqe_tail;          /* entries prepared but not yet published */
+    unsigned sq_entries;
+
+    /* completion queue */
+    unsigned *cq_head;
+    unsigned *cq_tail;
+    unsigned *cq_mask;
+    struct io_uring_cqe *cqes;
+
+    void *sq_ring;
+    size_t sq_ring_size;
+    void *cq_ring;
+    size_t cq_ring_size;
+    size_t sqes_size;
+} ring_t;
+
+static int io_uring_setup(unsigned entries, struct io_uring_params *p) {
+    return (int)syscall(__NR_io_uring_setup, entries, p);
+}
+
+static int io_uring_enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags) {
+    return (int)syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, NULL, 0);
+}
+
+static int io_uring_register(int fd, unsigned opcode, void *arg, unsigned nr_args) {
+    return (int)syscall(__NR_io_uring_register, fd, opcode, arg, nr_args);
+}
+
+static void unmap_rings(ring_t *ring) {
+    if (ring->sqes != NULL && ring->sqes != MAP_FAILED) {
+        munmap(ring->sqes, ring->sqes_size);
+    }
+    if (ring->cq_ring != NULL && ring->cq_ring != MAP_FAILED && ring->cq_ring != ring->sq_ring) {
+        munmap(ring->cq_ring, ring->cq_ring_size);
+    }
+    if (ring->sq_ring != NULL && ring->sq_ring != MAP_FAILED) {
+        munmap(ring->sq_ring, ring->sq_ring_size);
+    }
+}
+
+static int map_rings(ring_t *ring, struct io_uring_params *p) {
+    char *sq;
+    char *cq;
+
+    ring->sq_ring_size = p->sq_off.array + p->sq_entries * sizeof(unsigned);
+    ring->cq_ring_size = p->cq_off.cqes + p->cq_entries * sizeof(struct io_uring_cqe);
+    if (p->features & IORING_FEAT_SINGLE_MMAP) {
+        if (ring->cq_ring_size > ring->sq_ring_size) {
+            ring->sq_ring_size = ring->cq_ring_size;
+        }
+        ring->cq_ring_size = ring->sq_ring_size;
+    }
+
+    ring->sq_ring = mmap(NULL, ring->sq_ring_size, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQ_RING);
+    if (ring->sq_ring == MAP_FAILED) {
+        return -1;
+    }
+    if (p->features & IORING_FEAT_SINGLE_MMAP) {
+        ring->cq_ring = ring->sq_ring;
+    } else {
+        ring->cq_ring = mmap(NULL, ring->cq_ring_size, PROT_READ | PROT_WRITE,
+                             MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_CQ_RING);
+        if (ring->cq_ring == MAP_FAILED) {
+            return -1;
+        }
+    }
+    ring->sqes_size = p->sq_entries * sizeof(struct io_uring_sqe);
+    ring->sqes = mmap(NULL, ring->sqes_size, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES);
+    if (ring->sqes == MAP_FAILED) {
+        return -1;
+    }
+
+    sq = (char *)ring->sq_ring;
+    ring->sq_head = (unsigned *)(sq + p->sq_off.head);
+    ring->sq_tail = (unsigned *)(sq + p->sq_off.tail);
+    ring->sq_mask = (unsigned *)(sq + p->sq_off.ring_mask);
+    ring->sq_array = (unsigned *)(sq + p->sq_off.array);
+    ring->sq_entries = p->sq_entries;
+    ring->sqe_tail = *ring->sq_tail;
+
+    cq = (char *)ring->cq_ring;
+    ring->cq_head = (unsigned *)(cq + p->cq_off.head);
+    ring->cq_tail = (unsigned *)(cq + p->cq_off.tail);
+    ring->cq_mask = (unsigned *)(cq + p->cq_off.ring_mask);
+    ring->cqes = (struct io_uring_cqe *)(cq + p->cq_off.cqes);
+    return 0;
+}
+
+/*
+ * Returns the next free submission queue entry, cleared, or NULL if the
+ * submission queue is full and must be submitted first.
+ */
+static struct io_uring_sqe *next_sqe(ring_t *ring) {
+    unsigned head = __atomic_load_n(ring->sq_head, __ATOMIC_ACQUIRE);
+    struct io_uring_sqe *sqe;
+    if (ring->sqe_tail - head >= ring->sq_entries) {
+        return NULL;
+    }
+    sqe = &ring->sqes[ring->sqe_tail & *ring->sq_mask];
+    memset(sqe, 0, sizeof(*sqe));
+    return sqe;
+}
+
+/* Publishes the entry returned by the last next_sqe call */
+static void commit_sqe(ring_t *ring, struct io_uring_sqe *sqe) {
+    unsigned index = ring->sqe_tail & *ring->sq_mask;
+    ring->sq_array[index] = (unsigned)(sqe - ring->sqes);
+    ring->sqe_tail++;
+    __atomic_store_n(ring->sq_tail, ring->sqe_tail, __ATOMIC_RELEASE);
+}
+
+static jint prep(ring_t *ring, int opcode, jint fd, jlong address, jint len,
+                 jlong offset, jint bufIndex, jlong userData) {
+    struct io_uring_sqe *sqe = next_sqe(ring);
+    if (sqe == NULL) {
+        return IOS_UNAVAILABLE;
+    }
+    sqe->opcode = (__u8)opcode;
+    sqe->fd = (__s32)fd;
+    sqe->addr = (__u64)address;
+    sqe->len = (__u32)len;
+    sqe->off = (__u64)offset;
+    sqe->buf_index = (__u16)bufIndex;
+    sqe->user_data = (__u64)userData;
+    commit_sqe(ring, sqe);
+    return 0;
+}
+
+#endif /* HAVE_IO_URING */
+
+JNIEXPORT jboolean JNICALL
+Java_sun_nio_ch_IOUring_isSupported0(JNIEnv *env, jclass c)
+{
+#ifdef HAVE_IO_URING
+    struct io_uring_params p;
+    int fd;
+
+    memset(&p, 0, sizeof(p));
+    fd = io_uring_setup(1, &p);
+    if (fd < 0) {
+        /* ENOSYS: kernel too old, EPERM: disabled by sysctl or seccomp */
+        return JNI_FALSE;
+    }
+    close(fd);
+    /*
+     * Without fast poll socket reads and writes that would block are
+     * punted to kernel worker threads, which is no better than EPollPort.
+     */
+    return (p.features & IORING_FEAT_FAST_POLL) != 0 ? JNI_TRUE : JNI_FALSE;
+#else
+    return JNI_FALSE;
+#endif
+}
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IOUring_cqeSize(JNIEnv* env, jclass this)
+{
+#ifdef HAVE_IO_URING
+    return sizeof(struct io_uring_cqe);
+#else
+    return 0;
+#endif
+}
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IOUring_cqeUserDataOffset(JNIEnv* env, jclass this)
+{
+#ifdef HAVE_IO_URING
+    return offsetof(struct io_uring_cqe, user_data);
+#else
+    return 0;
+#endif
+}
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IOUring_cqeResOffset(JNIEnv* env, jclass this)
+{
+#ifdef HAVE_IO_URING
+    return offsetof(struct io_uring_cqe, res);
+#else
+    return 0;
+#endif
+}
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IOUring_iovecSize(JNIEnv* env, jclass this)
+{
+    return sizeof(struct iovec);
+}
+
+JNIEXPORT jlong JNICALL
+Java_sun_nio_ch_IOUring_create(JNIEnv *env, jclass c, jint entries)
+{
+#ifdef HAVE_IO_URING
+    struct io_uring_params p;
+    ring_t *ring = (ring_t *)calloc(1, sizeof(ring_t));
+    if (ring == NULL) {
+        JNU_ThrowOutOfMemoryError(env, "io_uring ring");
+        return 0;
+    }
+    memset(&p, 0, sizeof(p));
+    ring->fd = io_uring_setup((unsigned)entries, &p);
+    if (ring->fd < 0) {
+        JNU_ThrowIOExceptionWithLastError(env, "io_uring_setup failed");
+        free(ring);
+        return 0;
+    }
+    ring->features = p.features;
+    if (map_rings(ring, &p) != 0) {
+        JNU_ThrowIOExceptionWithLastError(env, "io_uring mmap failed");
+        unmap_rings(ring);
+        close(ring->fd);
+        free(ring);
+        return 0;
+    }
+    return ptr_to_jlong(ring);
+#else
+    JNU_ThrowIOException(env, "io_uring not supported");
+    return 0;
+#endif
+}
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IOUring_ringFd(JNIEnv *env, jclass c, jlong address)
+{
+#ifdef HAVE_IO_URING
+    ring_t *ring = (ring_t *)jlong_to_ptr(address);
+    return ring->fd;
+#else
+    return -1;
+#endif
+}
+
+/*
+ * The prep functions queue one submission queue entry and return 0, or
+ * IOS_UNAVAILABLE if the submission queue is full. The entries become
+ * visible to the kernel on the next submit.
+ */
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IOUring_prepRead(JNIEnv *env, jclass c, jlong ring, jint fd,
+                                 jlong address, jint len, jlong offset, jlong userData)
+{
+#ifdef HAVE_IO_URING
+    return prep((ring_t *)jlong_to_ptr(ring), IORING_OP_READ, fd, address, len, offset, 0, userData);
+#else
+    return IOS_UNAVAILABLE;
+#endif
+}
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IOUring_prepWrite(JNIEnv *env, jclass c, jlong ring, jint fd,
+                                  jlong address, jint len, jlong offset, jlong userData)
+{
+#ifdef HAVE_IO_URING
+    return prep((ring_t *)jlong_to_ptr(ring), IORING_OP_WRITE, fd, address, len, offset, 0, userData);
+#else
+    return IOS_UNAVAILABLE;
+#endif
+}
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IOUring_prepReadv(JNIEnv *env, jclass c, jlong ring, jint fd,
+                                  jlong iovecs, jint count, jlong offset, jlong userData)
+{
+#ifdef HAVE_IO_URING
+    return prep((ring_t *)jlong_to_ptr(ring), IORING_OP_READV, fd, iovecs, count, offset, 0, userData);
+#else
+    return IOS_UNAVAILABLE;
+#endif
+}
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IOUring_prepWritev(JNIEnv *env, jclass c, jlong ring, jint fd,
+                                   jlong iovecs, jint count, jlong offset, jlong userData)
+{
+#ifdef HAVE_IO_URING
+    return prep((ring_t *)jlong_to_ptr(ring), IORING_OP_WRITEV, fd, iovecs, count, offset, 0, userData);
+#else
+    return IOS_UNAVAILABLE;
+#endif
+}
+
+/*
+ * Read and write into a buffer registered with registerBuffers. The
+ * address range must lie within the registered buffer at bufIndex.
+ */
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IOUring_prepReadFixed(JNIEnv *env, jclass c, jlong ring, jint fd,
+                                      jlong address, jint len, jlong offset,
+                                      jint bufIndex, jlong userData)
+{
+#ifdef HAVE_IO_URING
+    return prep((ring_t *)jlong_to_ptr(ring), IORING_OP_READ_FIXED, fd, address, len, offset, bufIndex, userData);
+#else
+    return IOS_UNAVAILABLE;
+#endif
+}
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IOUring_prepWriteFixed(JNIEnv *env, jclass c, jlong ring, jint fd,
+                                       jlong address, jint len, jlong offset,
+                                       jint bufIndex, jlong userData)
+{
+#ifdef HAVE_IO_URING
+    return prep((ring_t *)jlong_to_ptr(ring), IORING_OP_WRITE_FIXED, fd, address, len, offset, bufIndex, userData);
+#else
+    return IOS_UNAVAILABLE;
+#endif
+}
+
+/*
+ * Accept a connection. The address and address length are filled in
+ * when sockaddr is not 0, sockaddrLen then points to a socklen_t.
+ */
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IOUring_prepAccept(JNIEnv *env, jclass c, jlong ring, jint fd,
+                                   jlong sockaddr, jlong sockaddrLen, jlong userData)
+{
+#ifdef HAVE_IO_URING
+    ring_t *r = (ring_t *)jlong_to_ptr(ring);
+    struct io_uring_sqe *sqe = next_sqe(r);
+    if (sqe == NULL) {
+        return IOS_UNAVAILABLE;
+    }
+    sqe->opcode = IORING_OP_ACCEPT;
+    sqe->fd = (__s32)fd;
+    sqe->addr = (__u64)sockaddr;
+    sqe->addr2 = (__u64)sockaddrLen;
+    sqe->accept_flags = SOCK_CLOEXEC;
+    sqe->user_data = (__u64)userData;
+    commit_sqe(r, sqe);
+    return 0;
+#else
+    return IOS_UNAVAILABLE;
+#endif
+}
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IOUring_prepConnect(JNIEnv *env, jclass c, jlong ring, jint fd,
+                                    jlong sockaddr, jint sockaddrLen, jlong userData)
+{
+#ifdef HAVE_IO_URING
+    /* For IORING_OP_CONNECT the address length is passed in the offset */
+    return prep((ring_t *)jlong_to_ptr(ring), IORING_OP_CONNECT, fd, sockaddr, 0, sockaddrLen, 0, userData);
+#else
+    return IOS_UNAVAILABLE;
+#endif
+}
+
+/* Cancels the request that was queued with the given user data */
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IOUring_prepCancel(JNIEnv *env, jclass c, jlong ring,
+                                   jlong targetUserData, jlong userData)
+{
+#ifdef HAVE_IO_URING
+    return prep((ring_t *)jlong_to_ptr(ring), IORING_OP_ASYNC_CANCEL, -1, targetUserData, 0, 0, 0, userData);
+#else
+    return IOS_UNAVAILABLE;
+#endif
+}
+
+/* A no-op request, completes immediately; used to wake up the waiter */
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IOUring_prepNop(JNIEnv *env, jclass c, jlong ring, jlong userData)
+{
+#ifdef HAVE_IO_URING
+    return prep((ring_t *)jlong_to_ptr(ring), IORING_OP_NOP, -1, 0, 0, 0, 0, userData);
+#else
+    return IOS_UNAVAILABLE;
+#endif
+}
+
+/*
+ * Submits all prepared entries in a single io_uring_enter call and, if
+ * minComplete is positive, waits until that many completions are
+ * available. Returns the number of entries submitted.
+ */
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IOUring_submit(JNIEnv *env, jclass c, jlong address, jint minComplete)
+{
+#ifdef HAVE_IO_URING
+    ring_t *ring = (ring_t *)jlong_to_ptr(address);
+    unsigned head = __atomic_load_n(ring->sq_head, __ATOMIC_ACQUIRE);
+    unsigned to_submit = ring->sqe_tail - head;
+    unsigned flags = (minComplete > 0) ? IORING_ENTER_GETEVENTS : 0;
+    int res;
+
+    if (to_submit == 0 && minComplete <= 0) {
+        return 0;
+    }
+    RESTARTABLE(io_uring_enter(ring->fd, to_submit, (unsigned)minComplete, flags), res);
+    if (res < 0) {
+        if (errno == EAGAIN || errno == EBUSY) {
+            /* completion queue overflow, caller must reap completions */
+            return 0;
+        }
+        JNU_ThrowIOExceptionWithLastError(env, "io_uring_enter failed");
+    }
+    return res;
+#else
+    JNU_ThrowIOException(env, "io_uring not supported");
+    return -1;
+#endif
+}
+
+/*
+ * Copies up to max completions into the io_uring_cqe array at address
+ * and releases them in the ring. Does not block. Returns the number of
+ * completions copied.
+ */
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IOUring_reap(JNIEnv *env, jclass c, jlong ring_address,
+                             jlong address, jint max)
+{
+#ifdef HAVE_IO_URING
+    ring_t *ring = (ring_t *)jlong_to_ptr(ring_address);
+    struct io_uring_cqe *out = (struct io_uring_cqe *)jlong_to_ptr(address);
+    unsigned head = *ring->cq_head;
+    unsigned tail = __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE);
+    unsigned mask = *ring->cq_mask;
+    jint n = 0;
+
+    while (head != tail && n < max) {
+        out[n++] = ring->cqes[head & mask];
+        head++;
+    }
+    __atomic_store_n(ring->cq_head, head, __ATOMIC_RELEASE);
+    return n;
+#else
+    return 0;
+#endif
+}
+
+/*
+ * Registers count iovecs at address as fixed buffers, typically the
+ * memory of direct buffers, so the kernel maps them once instead of on
+ * every request. Returns 0 or the errno value.
+ */
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IOUring_registerBuffers(JNIEnv *env, jclass c, jlong ring,
+                                        jlong address, jint count)
+{
+#ifdef HAVE_IO_URING
+    ring_t *r = (ring_t *)jlong_to_ptr(ring);
+    int res;
+    RESTARTABLE(io_uring_register(r->fd, IORING_REGISTER_BUFFERS,
+                                  jlong_to_ptr(address), (unsigned)count), res);
+    return (res == 0) ? 0 : errno;
+#else
+    return ENOSYS;
+#endif
+}
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IOUring_unregisterBuffers(JNIEnv *env, jclass c, jlong ring)
+{
+#ifdef HAVE_IO_URING
+    ring_t *r = (ring_t *)jlong_to_ptr(ring);
+    int res;
+    RESTARTABLE(io_uring_register(r->fd, IORING_UNREGISTER_BUFFERS, NULL, 0), res);
+    return (res == 0) ? 0 : errno;
+#else
+    return ENOSYS;
+#endif
+}
+
+JNIEXPORT void JNICALL
+Java_sun_nio_ch_IOUring_close0(JNIEnv *env, jclass c, jlong address)
+{
+#ifdef HAVE_IO_URING
+    ring_t *ring = (ring_t *)jlong_to_ptr(address);
+    int res;
+    unmap_rings(ring);
+    RESTARTABLE(close(ring->fd), res);
+    free(ring);
+#endif
+}
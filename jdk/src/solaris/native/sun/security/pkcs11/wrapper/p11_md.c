@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2003, 2014, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2003, 2026, Oracle and/or its affiliates. All rights reserved.
  */
 
 /* Copyright  (c) 2002 Graz University of Technology. All rights reserved.
@@ -64,11 +64,37 @@
 #include <assert.h>
 
 #include <dlfcn.h>
+#include <pthread.h>
 
 #include <jni.h>
 
 #include "sun_security_pkcs11_wrapper_PKCS11.h"
 
+static pthread_key_t scratchKey;
+static pthread_once_t scratchKeyOnce = PTHREAD_ONCE_INIT;
+static int scratchKeyCreated = 0;
+
+static void createScratchKey(void) {
+    scratchKeyCreated = (pthread_key_create(&scratchKey, free) == 0);
+}
+
+/*
+ * Returns the scratch buffer of the calling thread, or NULL if it has none.
+ */
+void *getThreadScratch(void) {
+    pthread_once(&scratchKeyOnce, createScratchKey);
+    return scratchKeyCreated ? pthread_getspecific(scratchKey) : NULL;
+}
+
+/*
+ * Sets the scratch buffer of the calling thread. Returns 0 if it can not
+ * be stored, in which case the caller remains responsible for freeing it.
+ */
+int setThreadScratch(void *scratch) {
+    pthread_once(&scratchKeyOnce, createScratchKey);
+    return scratchKeyCreated && (pthread_setspecific(scratchKey, scratch) == 0);
+}
+
 /*
  * Class:     sun_security_pkcs11_wrapper_PKCS11
  * Method:    connect
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2019, 2026, Oracle and/or its affiliates. All rights reserved.
  */
 
 /*
@@ -92,4 +92,9 @@ struct ModuleData {
 };
 typedef struct ModuleData ModuleData;
 
+/* Per-thread slot for the scratch buffer of p11_util.c. The value is
+ * freed with free() when the thread exits. */
+void *getThreadScratch(void);
+int setThreadScratch(void *scratch);
+
 #endif //H_P11MD
\ No newline at end of file
@@ -650,3 +650,13 @@ getLastErrorString(char *utf8_jvmErrorMsg, size_t cbErrorMsg)
     }
     return n;
 }
+
+/*
+ * Windows has no thread exit hook usable here on all supported releases,
+ * so callers fall back to allocating their own buffer.
+ */
+char*
+getThreadBuffer(size_t len)
+{
+    return NULL;
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2003, 2018, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2003, 2026, Oracle and/or its affiliates. All rights reserved.
  */
 
 /* Copyright  (c) 2002 Graz University of Technology. All rights reserved.
@@ -69,6 +69,48 @@
 
 #include "sun_security_pkcs11_wrapper_PKCS11.h"
 
+/* Fiber local storage index of the scratch buffer, allocated on first use */
+static volatile LONG scratchIndex = (LONG) FLS_OUT_OF_INDEXES;
+
+static VOID WINAPI freeScratch(PVOID scratch) {
+    free(scratch);
+}
+
+static DWORD getScratchIndex(void) {
+    DWORD index = (DWORD) scratchIndex;
+
+    if (index == FLS_OUT_OF_INDEXES) {
+        index = FlsAlloc(freeScratch);
+        if (index != FLS_OUT_OF_INDEXES) {
+            LONG prev = InterlockedCompareExchange(&scratchIndex, (LONG) index,
+                                                   (LONG) FLS_OUT_OF_INDEXES);
+            if (prev != (LONG) FLS_OUT_OF_INDEXES) {
+                /* another thread allocated the index first */
+                FlsFree(index);
+                index = (DWORD) prev;
+            }
+        }
+    }
+    return index;
+}
+
+/*
+ * Returns the scratch buffer of the calling thread, or NULL if it has none.
+ */
+void *getThreadScratch(void) {
+    DWORD index = getScratchIndex();
+    return (index != FLS_OUT_OF_INDEXES) ? FlsGetValue(index) : NULL;
+}
+
+/*
+ * Sets the scratch buffer of the calling thread. Returns 0 if it can not
+ * be stored, in which case the caller remains responsible for freeing it.
+ */
+int setThreadScratch(void *scratch) {
+    DWORD index = getScratchIndex();
+    return (index != FLS_OUT_OF_INDEXES) && FlsSetValue(index, scratch);
+}
+
 /*
  * Class:     sun_security_pkcs11_wrapper_PKCS11
  * Method:    connect